@@ -0,0 +1,156 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef ESP_TRACEPOINT_H_
+#define ESP_TRACEPOINT_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Compile-time identifiers of the static tracepoints. At most 32 identifiers
+ * can exist, since the set of enabled tracepoints is kept in a single 32-bit
+ * mask. Identifiers below ESP_TRACEPOINT_USER0 are pre-placed in IDF code,
+ * the remaining ones are free for use by the application.
+ */
+typedef enum {
+    ESP_TRACEPOINT_FLASH_ERASE_START = 0,   ///< flash erase entered (arg0 - address, arg1 - size)
+    ESP_TRACEPOINT_FLASH_ERASE_END,         ///< flash erase returned (arg0 - address, arg1 - esp_err_t result)
+    ESP_TRACEPOINT_FLASH_WRITE_START,       ///< flash write entered (arg0 - address, arg1 - size)
+    ESP_TRACEPOINT_FLASH_WRITE_END,         ///< flash write returned (arg0 - address, arg1 - esp_err_t result)
+    ESP_TRACEPOINT_FLASH_READ_START,        ///< flash read entered (arg0 - address, arg1 - size)
+    ESP_TRACEPOINT_FLASH_READ_END,          ///< flash read returned (arg0 - address, arg1 - esp_err_t result)
+    ESP_TRACEPOINT_SCHED_SWITCH,            ///< task switched in (arg0 - TCB address, arg1 - core ID)
+    ESP_TRACEPOINT_USER0,                   ///< free for application use
+    ESP_TRACEPOINT_USER1,                   ///< free for application use
+    ESP_TRACEPOINT_USER2,                   ///< free for application use
+    ESP_TRACEPOINT_USER3,                   ///< free for application use
+    ESP_TRACEPOINT_MAX                      ///< number of tracepoint IDs, must not exceed 32
+} esp_tracepoint_id_t;
+
+/**
+ * Fixed-size binary record produced by every tracepoint hit.
+ */
+typedef struct {
+    uint32_t id;    ///< esp_tracepoint_id_t value
+    uint32_t ts;    ///< timestamp in microseconds, esp_timer_get_time() truncated to 32 bits
+    uint32_t arg0;  ///< first tracepoint argument
+    uint32_t arg1;  ///< second tracepoint argument
+} esp_tracepoint_record_t;
+
+_Static_assert(sizeof(esp_tracepoint_record_t) == 16, "tracepoint record must stay 16 bytes");
+
+#if CONFIG_APPTRACE_TRACEPOINTS
+
+/** Bit mask of enabled tracepoint IDs, do not modify directly (see esp_tracepoint_enable) */
+extern volatile uint32_t esp_tracepoint_enabled_mask;
+
+/**
+ * @brief Emit a tracepoint record if the given tracepoint is enabled.
+ *
+ * When CONFIG_APPTRACE_TRACEPOINTS is disabled this compiles to nothing and
+ * the arguments are not evaluated. When enabled but the tracepoint is not,
+ * the cost is a single load and branch, so tracepoints can stay in hot code
+ * (ISRs, the scheduler, flash access) in production builds.
+ */
+#define ESP_TRACEPOINT(id, arg0, arg1) \
+    do { \
+        if (esp_tracepoint_enabled_mask & (1UL << (id))) { \
+            esp_tracepoint_record((id), (uint32_t)(arg0), (uint32_t)(arg1)); \
+        } \
+    } while (0)
+
+#else // CONFIG_APPTRACE_TRACEPOINTS
+
+#define ESP_TRACEPOINT(id, arg0, arg1) do {} while (0)
+
+#endif // CONFIG_APPTRACE_TRACEPOINTS
+
+/**
+ * @brief Enable the given tracepoint.
+ *
+ * All tracepoints start out disabled.
+ *
+ * @param id Tracepoint to enable.
+ */
+void esp_tracepoint_enable(esp_tracepoint_id_t id);
+
+/**
+ * @brief Disable the given tracepoint.
+ *
+ * @param id Tracepoint to disable.
+ */
+void esp_tracepoint_disable(esp_tracepoint_id_t id);
+
+/**
+ * @brief Store one record in the ring buffer of the current CPU.
+ *
+ * Called by the ESP_TRACEPOINT macro once the enabled check has passed,
+ * normally there is no need to call it directly. Safe to call from ISRs.
+ * If the ring is full the record is discarded and the drop counter is
+ * incremented.
+ *
+ * @param id   Tracepoint ID (esp_tracepoint_id_t value).
+ * @param arg0 First argument to store in the record.
+ * @param arg1 Second argument to store in the record.
+ */
+void esp_tracepoint_record(uint32_t id, uint32_t arg0, uint32_t arg1);
+
+/**
+ * @brief Pop accumulated records from the ring buffers.
+ *
+ * Drains the rings of all CPUs in turn. Intended for custom streamers
+ * (e.g. a UDP sender task); when tracing to host via JTAG use
+ * esp_tracepoint_flush instead. Must not be called concurrently from
+ * several tasks.
+ *
+ * @param records     Buffer to copy the records to.
+ * @param max_records Capacity of the buffer, in records.
+ *
+ * @return Number of records copied.
+ */
+size_t esp_tracepoint_read(esp_tracepoint_record_t *records, size_t max_records);
+
+/**
+ * @brief Send all accumulated records to the host via app_trace.
+ *
+ * @param tmo Timeout for the underlying esp_apptrace_write calls (in us).
+ *            Use ESP_APPTRACE_TMO_INFINITE to wait indefinitely.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NOT_SUPPORTED if CONFIG_APPTRACE_ENABLE is not set
+ *      - otherwise see esp_apptrace_write
+ */
+esp_err_t esp_tracepoint_flush(uint32_t tmo);
+
+/**
+ * @brief Get the number of records dropped because the ring of a CPU was full.
+ *
+ * @param cpu CPU number.
+ *
+ * @return Number of dropped records since startup.
+ */
+uint32_t esp_tracepoint_dropped_count(int cpu);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ESP_TRACEPOINT_H_
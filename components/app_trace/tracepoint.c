@@ -0,0 +1,131 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Static tracepoint facility: fixed-size binary records collected into
+// per-core ring buffers with interrupts disabled only on the local core.
+// Records are drained by a task, either to the host via app_trace
+// (esp_tracepoint_flush) or by a custom streamer (esp_tracepoint_read).
+
+#include "sdkconfig.h"
+
+#if CONFIG_APPTRACE_TRACEPOINTS
+
+#include "freertos/FreeRTOS.h"
+#include "esp_attr.h"
+#include "esp_timer.h"
+#include "hal/cpu_hal.h"
+#include "esp_tracepoint.h"
+#if CONFIG_APPTRACE_ENABLE
+#include "esp_app_trace.h"
+#endif
+
+_Static_assert(ESP_TRACEPOINT_MAX <= 32, "tracepoint IDs must fit in the 32-bit enable mask");
+
+#define TRACEPOINT_RING_RECORDS CONFIG_APPTRACE_TRACEPOINT_RING_RECORDS
+
+typedef struct {
+    esp_tracepoint_record_t records[TRACEPOINT_RING_RECORDS];
+    volatile uint32_t head;     // next slot to write; increments without wrapping
+    volatile uint32_t tail;     // next slot to read; only advanced by the reader
+    volatile uint32_t dropped;  // records discarded because the ring was full
+} tracepoint_ring_t;
+
+static tracepoint_ring_t s_ring[portNUM_PROCESSORS];
+
+static portMUX_TYPE s_mask_lock = portMUX_INITIALIZER_UNLOCKED;
+
+volatile uint32_t esp_tracepoint_enabled_mask = 0;
+
+void esp_tracepoint_enable(esp_tracepoint_id_t id)
+{
+    portENTER_CRITICAL(&s_mask_lock);
+    esp_tracepoint_enabled_mask |= 1UL << id;
+    portEXIT_CRITICAL(&s_mask_lock);
+}
+
+void esp_tracepoint_disable(esp_tracepoint_id_t id)
+{
+    portENTER_CRITICAL(&s_mask_lock);
+    esp_tracepoint_enabled_mask &= ~(1UL << id);
+    portEXIT_CRITICAL(&s_mask_lock);
+}
+
+void IRAM_ATTR esp_tracepoint_record(uint32_t id, uint32_t arg0, uint32_t arg1)
+{
+    // Each core only ever writes its own ring, so disabling interrupts on
+    // the local core is sufficient to serialize the producers.
+    uint32_t int_state = portENTER_CRITICAL_NESTED();
+    tracepoint_ring_t *ring = &s_ring[cpu_hal_get_core_id()];
+    uint32_t head = ring->head;
+    if (head - ring->tail < TRACEPOINT_RING_RECORDS) {
+        esp_tracepoint_record_t *rec = &ring->records[head % TRACEPOINT_RING_RECORDS];
+        rec->id = id;
+        rec->ts = (uint32_t) esp_timer_get_time();
+        rec->arg0 = arg0;
+        rec->arg1 = arg1;
+        ring->head = head + 1;
+    } else {
+        ring->dropped++;
+    }
+    portEXIT_CRITICAL_NESTED(int_state);
+}
+
+size_t esp_tracepoint_read(esp_tracepoint_record_t *records, size_t max_records)
+{
+    size_t total = 0;
+    for (int cpu = 0; cpu < portNUM_PROCESSORS; ++cpu) {
+        tracepoint_ring_t *ring = &s_ring[cpu];
+        while (total < max_records && ring->tail != ring->head) {
+            records[total++] = ring->records[ring->tail % TRACEPOINT_RING_RECORDS];
+            ring->tail++;
+        }
+    }
+    return total;
+}
+
+esp_err_t esp_tracepoint_flush(uint32_t tmo)
+{
+#if CONFIG_APPTRACE_ENABLE
+    esp_tracepoint_record_t buf[16];
+    size_t count;
+    while ((count = esp_tracepoint_read(buf, sizeof(buf) / sizeof(buf[0]))) > 0) {
+        esp_err_t res = esp_apptrace_write(ESP_APPTRACE_DEST_TRAX, buf, count * sizeof(buf[0]), tmo);
+        if (res != ESP_OK) {
+            return res;
+        }
+    }
+    return ESP_OK;
+#else
+    (void) tmo;
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+uint32_t esp_tracepoint_dropped_count(int cpu)
+{
+    if (cpu < 0 || cpu >= portNUM_PROCESSORS) {
+        return 0;
+    }
+    return s_ring[cpu].dropped;
+}
+
+// Referenced by the traceTASK_SWITCHED_IN hook in FreeRTOSConfig.h.
+// Runs on every context switch with interrupts disabled, so it only does
+// the two-instruction enabled check unless the tracepoint is turned on.
+void IRAM_ATTR esp_tracepoint_task_switched_in(void *tcb)
+{
+    ESP_TRACEPOINT(ESP_TRACEPOINT_SCHED_SWITCH, (uint32_t) tcb, cpu_hal_get_core_id());
+}
+
+#endif // CONFIG_APPTRACE_TRACEPOINTS
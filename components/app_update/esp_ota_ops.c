@@ -563,6 +563,24 @@ const esp_partition_t* esp_ota_get_running_partition(void)
     abort(); /* Partition table is invalid or corrupt */
 }
 
+esp_err_t esp_ota_verify_running_app(void)
+{
+    const esp_partition_t *running_partition = esp_ota_get_running_partition();
+    if (running_partition == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    esp_image_metadata_t data;
+    const esp_partition_pos_t part_pos = {
+        .offset = running_partition->address,
+        .size = running_partition->size,
+    };
+
+    if (esp_image_verify(ESP_IMAGE_VERIFY, &part_pos, &data) != ESP_OK) {
+        return ESP_ERR_OTA_VALIDATE_FAILED;
+    }
+    return ESP_OK;
+}
 
 const esp_partition_t* esp_ota_get_next_update_partition(const esp_partition_t *start_from)
 {
@@ -0,0 +1,282 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdkconfig.h"
+
+#ifdef CONFIG_APP_UPDATE_DELTA_OTA
+
+#include <string.h>
+#include <stdlib.h>
+#include <sys/param.h>
+#include <sys/queue.h>
+
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_partition.h"
+#include "esp_ota_ops.h"
+#include "esp_ota_patch.h"
+
+static const char *TAG = "esp_ota_patch";
+
+/* Patch stream opcodes */
+#define PATCH_OP_COPY  0x00
+#define PATCH_OP_DATA  0x01
+
+#define PATCH_HEADER_SIZE     12  /* magic + version + reserved + target_size */
+#define PATCH_COPY_ARGS_SIZE  8   /* src_offset + length */
+#define PATCH_DATA_ARGS_SIZE  4   /* length */
+
+/* Bounce buffer for COPY commands; reference data is read from flash in
+   pieces of this size and fed straight back into esp_ota_write() */
+#define PATCH_COPY_BUF_SIZE   256
+
+typedef enum {
+    PATCH_STATE_HEADER,  /* collecting the 12-byte stream header */
+    PATCH_STATE_OPCODE,  /* expecting the next command opcode */
+    PATCH_STATE_ARGS,    /* collecting the fixed arguments of a command */
+    PATCH_STATE_DATA,    /* consuming literal bytes of a DATA command */
+} patch_state_t;
+
+typedef struct patch_entry_ {
+    esp_ota_handle_t handle;
+    const esp_partition_t *src_part;
+    patch_state_t state;
+    uint8_t hold[PATCH_HEADER_SIZE];  /* accumulator for split headers/arguments */
+    size_t hold_len;
+    size_t hold_need;
+    uint8_t opcode;
+    uint32_t data_remaining;          /* literal bytes still owed by a DATA command */
+    uint32_t target_size;
+    uint32_t produced;                /* image bytes written out so far */
+    LIST_ENTRY(patch_entry_) entries;
+} patch_entry_t;
+
+static LIST_HEAD(patch_entries_head, patch_entry_) s_patch_entries_head =
+    LIST_HEAD_INITIALIZER(s_patch_entries_head);
+
+static patch_entry_t *get_patch_entry(esp_ota_handle_t handle)
+{
+    patch_entry_t *it;
+    for (it = LIST_FIRST(&s_patch_entries_head); it != NULL; it = LIST_NEXT(it, entries)) {
+        if (it->handle == handle) {
+            return it;
+        }
+    }
+    return NULL;
+}
+
+static void free_patch_entry(patch_entry_t *it)
+{
+    LIST_REMOVE(it, entries);
+    free(it);
+}
+
+static uint32_t read_le32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/* Write 'length' reconstructed bytes, failing if that would exceed target_size */
+static esp_err_t patch_emit(patch_entry_t *it, const void *data, uint32_t length)
+{
+    if (length > it->target_size - it->produced) {
+        ESP_LOGE(TAG, "patch output exceeds target size (%u)", it->target_size);
+        return ESP_ERR_OTA_PATCH_MALFORMED;
+    }
+    esp_err_t ret = esp_ota_write(it->handle, data, length);
+    if (ret == ESP_OK) {
+        it->produced += length;
+    }
+    return ret;
+}
+
+static esp_err_t patch_apply_copy(patch_entry_t *it, uint32_t src_offset, uint32_t length)
+{
+    uint8_t buf[PATCH_COPY_BUF_SIZE];
+
+    if (src_offset > it->src_part->size || length > it->src_part->size - src_offset) {
+        ESP_LOGE(TAG, "COPY range 0x%x+0x%x outside reference partition", src_offset, length);
+        return ESP_ERR_OTA_PATCH_MALFORMED;
+    }
+
+    while (length > 0) {
+        uint32_t chunk = MIN(length, sizeof(buf));
+        esp_err_t ret = esp_partition_read(it->src_part, src_offset, buf, chunk);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        ret = patch_emit(it, buf, chunk);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        src_offset += chunk;
+        length -= chunk;
+    }
+    return ESP_OK;
+}
+
+/* Consume input until 'hold' contains 'hold_need' bytes; returns true when complete */
+static bool patch_fill_hold(patch_entry_t *it, const uint8_t **data, size_t *size)
+{
+    size_t take = MIN(it->hold_need - it->hold_len, *size);
+    memcpy(&it->hold[it->hold_len], *data, take);
+    it->hold_len += take;
+    *data += take;
+    *size -= take;
+    return it->hold_len == it->hold_need;
+}
+
+esp_err_t esp_ota_patch_begin(const esp_partition_t *update_partition, const esp_partition_t *src_partition, esp_ota_handle_t *out_handle)
+{
+    if ((update_partition == NULL) || (out_handle == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (src_partition == NULL) {
+        src_partition = esp_ota_get_running_partition();
+    }
+    if (src_partition == NULL || src_partition == update_partition) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    patch_entry_t *new_entry = (patch_entry_t *) calloc(sizeof(patch_entry_t), 1);
+    if (new_entry == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    esp_ota_handle_t ota_handle;
+    esp_err_t ret = esp_ota_begin(update_partition, OTA_WITH_SEQUENTIAL_WRITES, &ota_handle);
+    if (ret != ESP_OK) {
+        free(new_entry);
+        return ret;
+    }
+
+    new_entry->handle = ota_handle;
+    new_entry->src_part = src_partition;
+    new_entry->state = PATCH_STATE_HEADER;
+    new_entry->hold_need = PATCH_HEADER_SIZE;
+    LIST_INSERT_HEAD(&s_patch_entries_head, new_entry, entries);
+
+    *out_handle = ota_handle;
+    return ESP_OK;
+}
+
+esp_err_t esp_ota_write_patch(esp_ota_handle_t handle, const void *data, size_t size)
+{
+    patch_entry_t *it = get_patch_entry(handle);
+    if (it == NULL || data == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const uint8_t *in = (const uint8_t *) data;
+    esp_err_t ret = ESP_OK;
+
+    while (size > 0 && ret == ESP_OK) {
+        switch (it->state) {
+        case PATCH_STATE_HEADER:
+            if (!patch_fill_hold(it, &in, &size)) {
+                break;
+            }
+            if (read_le32(&it->hold[0]) != ESP_OTA_PATCH_MAGIC || it->hold[4] != ESP_OTA_PATCH_VERSION) {
+                ESP_LOGE(TAG, "bad patch magic or version");
+                return ESP_ERR_OTA_PATCH_MALFORMED;
+            }
+            it->target_size = read_le32(&it->hold[8]);
+            it->state = PATCH_STATE_OPCODE;
+            it->hold_len = 0;
+            break;
+
+        case PATCH_STATE_OPCODE:
+            it->opcode = *in++;
+            size--;
+            if (it->opcode == PATCH_OP_COPY) {
+                it->hold_need = PATCH_COPY_ARGS_SIZE;
+            } else if (it->opcode == PATCH_OP_DATA) {
+                it->hold_need = PATCH_DATA_ARGS_SIZE;
+            } else {
+                ESP_LOGE(TAG, "unknown patch opcode 0x%02x", it->opcode);
+                return ESP_ERR_OTA_PATCH_MALFORMED;
+            }
+            it->state = PATCH_STATE_ARGS;
+            it->hold_len = 0;
+            break;
+
+        case PATCH_STATE_ARGS:
+            if (!patch_fill_hold(it, &in, &size)) {
+                break;
+            }
+            if (it->opcode == PATCH_OP_COPY) {
+                ret = patch_apply_copy(it, read_le32(&it->hold[0]), read_le32(&it->hold[4]));
+                it->state = PATCH_STATE_OPCODE;
+            } else {
+                it->data_remaining = read_le32(&it->hold[0]);
+                it->state = (it->data_remaining > 0) ? PATCH_STATE_DATA : PATCH_STATE_OPCODE;
+            }
+            it->hold_len = 0;
+            break;
+
+        case PATCH_STATE_DATA: {
+            uint32_t chunk = MIN(it->data_remaining, size);
+            ret = patch_emit(it, in, chunk);
+            in += chunk;
+            size -= chunk;
+            it->data_remaining -= chunk;
+            if (it->data_remaining == 0) {
+                it->state = PATCH_STATE_OPCODE;
+            }
+            break;
+        }
+        }
+    }
+    return ret;
+}
+
+esp_err_t esp_ota_patch_end(esp_ota_handle_t handle)
+{
+    patch_entry_t *it = get_patch_entry(handle);
+    if (it == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = ESP_OK;
+    if (it->state != PATCH_STATE_OPCODE || it->hold_len != 0) {
+        ESP_LOGE(TAG, "patch stream ended mid-command");
+        ret = ESP_ERR_OTA_PATCH_MALFORMED;
+    } else if (it->produced != it->target_size) {
+        ESP_LOGE(TAG, "patch produced %u bytes, expected %u", it->produced, it->target_size);
+        ret = ESP_ERR_OTA_PATCH_MALFORMED;
+    }
+    free_patch_entry(it);
+
+    /* esp_ota_end() frees the underlying handle whatever its outcome */
+    esp_err_t end_err = esp_ota_end(handle);
+    if (ret == ESP_OK) {
+        ret = end_err;
+    }
+    return ret;
+}
+
+esp_err_t esp_ota_patch_abort(esp_ota_handle_t handle)
+{
+    patch_entry_t *it = get_patch_entry(handle);
+    if (it == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    free_patch_entry(it);
+    /* Release the OTA handle; the validation result is irrelevant here */
+    esp_ota_end(handle);
+    return ESP_OK;
+}
+
+#endif // CONFIG_APP_UPDATE_DELTA_OTA
@@ -300,6 +300,23 @@ esp_err_t esp_ota_erase_last_boot_app_partition(void);
  */
 bool esp_ota_check_rollback_is_possible(void);
 
+/**
+ * @brief Re-verify the image of the currently running app partition.
+ *
+ * Runs the full image verification (checksums, SHA256 and, when enabled, the
+ * signature) over the running partition. Intended to be called from a low
+ * priority task after start-up when the bootloader was configured to skip
+ * validation (e.g. BOOTLOADER_SKIP_VALIDATE_IF_OTA_VALID or
+ * BOOTLOADER_SKIP_VALIDATE_IN_DEEP_SLEEP), so that flash corruption is still
+ * detected without paying the verification cost before the app is up.
+ *
+ * @return
+ *        - ESP_OK:                      The running image verified successfully.
+ *        - ESP_ERR_OTA_VALIDATE_FAILED: The image failed verification.
+ *        - ESP_ERR_NOT_FOUND:           The running partition could not be determined.
+ */
+esp_err_t esp_ota_verify_running_app(void);
+
 #if CONFIG_IDF_TARGET_ESP32S2 && (CONFIG_SECURE_BOOT_V2_ENABLED || __DOXYGEN__)
 
 /**
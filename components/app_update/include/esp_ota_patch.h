@@ -0,0 +1,142 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _OTA_PATCH_H
+#define _OTA_PATCH_H
+
+#include "esp_ota_ops.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @file esp_ota_patch.h
+ * @brief Delta (differential) OTA update support
+ *
+ * Instead of downloading a complete application image, the device downloads a
+ * patch stream that describes the new image as a mix of byte ranges copied
+ * from a reference partition (normally the currently running app) and literal
+ * data for the parts that changed. The new image is reconstructed on the fly
+ * while the patch is applied, so only the changed bytes travel over the
+ * network.
+ *
+ * Patch stream format (all multi-byte fields little-endian):
+ *
+ *     header:  uint32 magic        0x44505345 ("ESPD")
+ *              uint8  version      1
+ *              uint8  reserved[3]  must be zero
+ *              uint32 target_size  size of the reconstructed image in bytes
+ *
+ *     followed by a sequence of commands until target_size bytes have been
+ *     produced:
+ *
+ *     COPY:    uint8  opcode       0x00
+ *              uint32 src_offset   offset into the reference partition
+ *              uint32 length       bytes to copy
+ *
+ *     DATA:    uint8  opcode       0x01
+ *              uint32 length       bytes of literal data that follow
+ *              uint8  data[length]
+ *
+ * The stream can be fed to esp_ota_write_patch() in arbitrarily sized pieces;
+ * command boundaries do not have to align with call boundaries.
+ */
+
+#define ESP_OTA_PATCH_MAGIC    0x44505345  /*!< Patch stream magic, "ESPD" */
+#define ESP_OTA_PATCH_VERSION  1           /*!< Patch stream format version */
+
+#define ESP_ERR_OTA_PATCH_MALFORMED  (ESP_ERR_OTA_BASE + 0x10)  /*!< Error if the patch stream is corrupt or does not match the reference partition */
+
+#ifdef CONFIG_APP_UPDATE_DELTA_OTA
+
+/**
+ * @brief   Commence a delta OTA update writing to the specified partition.
+ *
+ * Wraps esp_ota_begin() and allocates the patch applier state. The returned
+ * handle must be fed the patch stream via esp_ota_write_patch() and finalised
+ * with esp_ota_patch_end(); do not mix it with plain esp_ota_write() calls.
+ *
+ * @param update_partition  Pointer to info for partition which will receive the reconstructed image.
+ * @param src_partition     Partition holding the reference image the patch was generated against,
+ *                          or NULL to use the currently running partition.
+ * @param out_handle        On success, returns a handle for the subsequent patch calls.
+ *
+ * @return
+ *    - ESP_OK: OTA operation commenced successfully.
+ *    - ESP_ERR_INVALID_ARG: update_partition or out_handle arguments were NULL, or the
+ *      update and reference partitions are the same.
+ *    - ESP_ERR_NO_MEM: Cannot allocate memory for the patch state.
+ *    - Any error esp_ota_begin() can return.
+ */
+esp_err_t esp_ota_patch_begin(const esp_partition_t *update_partition, const esp_partition_t *src_partition, esp_ota_handle_t *out_handle);
+
+/**
+ * @brief   Apply a piece of the patch stream to the partition being updated.
+ *
+ * Parses as much of the stream as the supplied bytes allow, reading COPY
+ * ranges from the reference partition and writing the reconstructed image
+ * through esp_ota_write(). Pieces may be of any size; partial command
+ * headers are buffered internally until completed by a later call.
+ *
+ * @param handle  Handle obtained from esp_ota_patch_begin().
+ * @param data    Patch stream data.
+ * @param size    Size of data buffer in bytes.
+ *
+ * @return
+ *    - ESP_OK: Data was parsed and any resulting image bytes written to flash successfully.
+ *    - ESP_ERR_INVALID_ARG: handle is invalid.
+ *    - ESP_ERR_OTA_PATCH_MALFORMED: The stream failed validation (bad magic or version,
+ *      a COPY range outside the reference partition, or more output than target_size).
+ *    - Any error esp_partition_read() or esp_ota_write() can return.
+ */
+esp_err_t esp_ota_write_patch(esp_ota_handle_t handle, const void *data, size_t size);
+
+/**
+ * @brief   Finish the delta OTA update and validate the reconstructed image.
+ *
+ * Checks that the patch stream was consumed completely and produced exactly
+ * target_size bytes, then calls esp_ota_end(). The patch state is released
+ * whatever the outcome; the handle becomes invalid.
+ *
+ * @param handle  Handle obtained from esp_ota_patch_begin().
+ *
+ * @return
+ *    - ESP_OK: Newly written OTA app image is valid.
+ *    - ESP_ERR_INVALID_ARG: handle is invalid.
+ *    - ESP_ERR_OTA_PATCH_MALFORMED: The stream ended mid-command or the reconstructed
+ *      image is not target_size bytes long.
+ *    - Any error esp_ota_end() can return.
+ */
+esp_err_t esp_ota_patch_end(esp_ota_handle_t handle);
+
+/**
+ * @brief   Abort a delta OTA update, freeing the patch state and the OTA handle.
+ *
+ * @param handle  Handle obtained from esp_ota_patch_begin().
+ *
+ * @return
+ *    - ESP_OK: Handle and patch state were freed successfully.
+ *    - ESP_ERR_INVALID_ARG: handle is invalid.
+ */
+esp_err_t esp_ota_patch_abort(esp_ota_handle_t handle);
+
+#endif // CONFIG_APP_UPDATE_DELTA_OTA
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _OTA_PATCH_H
@@ -0,0 +1,340 @@
+// Copyright 2021 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef _ESP_ASIO_LWIP_H_
+#define _ESP_ASIO_LWIP_H_
+
+//
+// ESP-IDF native completion backend for ASIO
+//
+// The portable ASIO reactor discovers socket readiness by scanning file
+// descriptors through the BSD select() emulation, which costs a full
+// round-trip into the lwIP socket layer per operation. The helpers below
+// bypass that scan:
+//
+//  * netconn_notifier bridges the lwIP netconn event callback straight into
+//    an asio::io_context, so readiness is posted from the tcpip thread the
+//    moment it occurs, and
+//  * pbuf_buffers/unique_pbuf expose a received pbuf chain as an ASIO buffer
+//    sequence, so the payload is consumed where the driver left it instead
+//    of being coalesced into a contiguous copy.
+//
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "esp_asio_config.h"
+#include "asio.hpp"
+
+#include "lwip/api.h"
+#include "lwip/pbuf.h"
+
+namespace esp {
+namespace asio_lwip {
+
+/**
+ * ConstBufferSequence view over a pbuf chain.
+ *
+ * Each pbuf in the chain becomes one asio::const_buffer, so the sequence can
+ * be handed to asio::buffer_copy(), scatter-gather writes or a codec without
+ * first flattening the chain. The view does not own the chain; keep the pbuf
+ * referenced (see unique_pbuf) for as long as the sequence is in use.
+ */
+class pbuf_buffers {
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = asio::const_buffer;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const asio::const_buffer *;
+        using reference = const asio::const_buffer &;
+
+        const_iterator() : p_(nullptr) {}
+        explicit const_iterator(const struct pbuf *p) : p_(p)
+        {
+            load();
+        }
+
+        reference operator*() const
+        {
+            return buf_;
+        }
+        pointer operator->() const
+        {
+            return &buf_;
+        }
+        const_iterator &operator++()
+        {
+            p_ = p_->next;
+            load();
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            const_iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+        bool operator==(const const_iterator &other) const
+        {
+            return p_ == other.p_;
+        }
+        bool operator!=(const const_iterator &other) const
+        {
+            return p_ != other.p_;
+        }
+
+    private:
+        void load()
+        {
+            if (p_) {
+                buf_ = asio::const_buffer(p_->payload, p_->len);
+            }
+        }
+
+        const struct pbuf *p_;
+        asio::const_buffer buf_;
+    };
+
+    explicit pbuf_buffers(const struct pbuf *p) : p_(p) {}
+
+    const_iterator begin() const
+    {
+        return const_iterator(p_);
+    }
+    const_iterator end() const
+    {
+        return const_iterator();
+    }
+    std::size_t size() const
+    {
+        return p_ ? p_->tot_len : 0;
+    }
+
+private:
+    const struct pbuf *p_;
+};
+
+/**
+ * Owning RAII wrapper around a pbuf chain received from lwIP.
+ *
+ * Keeps the chain referenced while handlers consume it through buffers() and
+ * releases it exactly once when the wrapper goes out of scope.
+ */
+class unique_pbuf {
+public:
+    unique_pbuf() : p_(nullptr) {}
+    explicit unique_pbuf(struct pbuf *p) : p_(p) {}
+    unique_pbuf(unique_pbuf &&other) : p_(other.release()) {}
+    unique_pbuf &operator=(unique_pbuf &&other)
+    {
+        reset(other.release());
+        return *this;
+    }
+    unique_pbuf(const unique_pbuf &) = delete;
+    unique_pbuf &operator=(const unique_pbuf &) = delete;
+
+    ~unique_pbuf()
+    {
+        reset();
+    }
+
+    void reset(struct pbuf *p = nullptr)
+    {
+        if (p_) {
+            pbuf_free(p_);
+        }
+        p_ = p;
+    }
+    struct pbuf *release()
+    {
+        struct pbuf *p = p_;
+        p_ = nullptr;
+        return p;
+    }
+    struct pbuf *get() const
+    {
+        return p_;
+    }
+    explicit operator bool() const
+    {
+        return p_ != nullptr;
+    }
+    pbuf_buffers buffers() const
+    {
+        return pbuf_buffers(p_);
+    }
+
+private:
+    struct pbuf *p_;
+};
+
+/**
+ * Fill a caller-provided array of mutable buffers with one entry per pbuf in
+ * the chain, for in-place decoding of received data.
+ *
+ * @return number of array entries used (at most max)
+ */
+inline std::size_t to_mutable_buffers(struct pbuf *p, asio::mutable_buffer *out, std::size_t max)
+{
+    std::size_t used = 0;
+    for (; p && used < max; p = p->next) {
+        out[used++] = asio::mutable_buffer(p->payload, p->len);
+    }
+    return used;
+}
+
+/**
+ * Bridges lwIP netconn readiness events into an asio::io_context.
+ *
+ * The lwIP event callback runs in the tcpip thread and only enqueues a
+ * completion through asio::post(); the user handler is then executed by
+ * whatever thread runs the io_context, so no handler ever blocks the network
+ * stack and the select() emulation is never entered.
+ *
+ * Lifetime: the handler may still be in flight inside the io_context after
+ * close(), so destroy the notifier from the io_context thread (or after the
+ * context has been stopped and drained).
+ */
+class netconn_notifier {
+public:
+    enum class event {
+        readable,   /*!< data or a pending connection has arrived */
+        writable,   /*!< send buffer space has become available */
+        error,      /*!< the connection entered an error state */
+    };
+
+    /** Handler invoked in io_context with the event and the length hint lwIP supplied */
+    using handler_type = std::function<void(event, std::size_t)>;
+
+    explicit netconn_notifier(asio::io_context &io) : io_(io), conn_(nullptr) {}
+    netconn_notifier(const netconn_notifier &) = delete;
+    netconn_notifier &operator=(const netconn_notifier &) = delete;
+
+    ~netconn_notifier()
+    {
+        close();
+    }
+
+    /**
+     * Create a netconn whose readiness events are posted into the io_context.
+     *
+     * @return ERR_OK on success, ERR_MEM if the netconn could not be created
+     */
+    err_t open(enum netconn_type type, handler_type handler)
+    {
+        conn_ = netconn_new_with_callback(type, &netconn_notifier::on_event);
+        if (conn_ == nullptr) {
+            return ERR_MEM;
+        }
+        handler_ = std::move(handler);
+        std::lock_guard<std::mutex> guard(registry_mutex());
+        registry()[conn_] = this;
+        return ERR_OK;
+    }
+
+    /**
+     * Take ownership of a netconn obtained elsewhere (typically from
+     * netconn_accept() on a listening notifier, which inherits the event
+     * callback). Events fired before adoption are dropped, so probe the
+     * connection once for data that may already be queued.
+     */
+    void adopt(struct netconn *conn, handler_type handler)
+    {
+        conn_ = conn;
+        handler_ = std::move(handler);
+        std::lock_guard<std::mutex> guard(registry_mutex());
+        registry()[conn_] = this;
+    }
+
+    /** Unregister and delete the underlying netconn */
+    void close()
+    {
+        if (conn_ == nullptr) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> guard(registry_mutex());
+            registry().erase(conn_);
+        }
+        netconn_delete(conn_);
+        conn_ = nullptr;
+    }
+
+    /** Underlying netconn, for the blocking data-path calls (netconn_recv etc.) */
+    struct netconn *native_handle()
+    {
+        return conn_;
+    }
+
+private:
+    static void on_event(struct netconn *conn, enum netconn_evt evt, u16_t len)
+    {
+        netconn_notifier *self;
+        {
+            std::lock_guard<std::mutex> guard(registry_mutex());
+            auto it = registry().find(conn);
+            if (it == registry().end()) {
+                // not adopted (yet): inherited callback of a fresh accept
+                return;
+            }
+            self = it->second;
+        }
+
+        event ev;
+        switch (evt) {
+        case NETCONN_EVT_RCVPLUS:
+            ev = event::readable;
+            break;
+        case NETCONN_EVT_SENDPLUS:
+            ev = event::writable;
+            break;
+        case NETCONN_EVT_ERROR:
+            ev = event::error;
+            break;
+        default:
+            // the MINUS events only matter to the select() emulation bookkeeping
+            return;
+        }
+
+        // runs in the tcpip thread: only queue the completion, never execute it here
+        asio::post(self->io_, [self, ev, len]() {
+            self->handler_(ev, len);
+        });
+    }
+
+    static std::unordered_map<struct netconn *, netconn_notifier *> &registry()
+    {
+        static std::unordered_map<struct netconn *, netconn_notifier *> reg;
+        return reg;
+    }
+    static std::mutex &registry_mutex()
+    {
+        static std::mutex m;
+        return m;
+    }
+
+    asio::io_context &io_;
+    struct netconn *conn_;
+    handler_type handler_;
+};
+
+} // namespace asio_lwip
+} // namespace esp
+
+#endif // _ESP_ASIO_LWIP_H_
@@ -74,6 +74,13 @@ static const char *TAG = "boot";
 
 static bool ota_has_initial_contents;
 
+#ifdef CONFIG_BOOTLOADER_SKIP_VALIDATE_IF_OTA_VALID
+/* OTA slot whose otadata entry is sealed ESP_OTA_IMG_VALID, i.e. the image
+   was fully verified at OTA time and confirmed by the app. INVALID_INDEX
+   if the selected slot is in any other state. */
+static int ota_sealed_valid_index = INVALID_INDEX;
+#endif
+
 static void load_image(const esp_image_metadata_t *image_data);
 static void unpack_load_app(const esp_image_metadata_t *data);
 static void set_cache_and_start_app(uint32_t drom_addr,
@@ -383,6 +390,12 @@ int bootloader_utility_get_selected_boot_partition(const bootloader_state_t *bs)
             }
 #endif // CONFIG_BOOTLOADER_APP_ANTI_ROLLBACK
 
+#ifdef CONFIG_BOOTLOADER_SKIP_VALIDATE_IF_OTA_VALID
+            if (otadata[active_otadata].ota_state == ESP_OTA_IMG_VALID) {
+                ota_sealed_valid_index = boot_index;
+            }
+#endif // CONFIG_BOOTLOADER_SKIP_VALIDATE_IF_OTA_VALID
+
         } else if (bs->factory.offset != 0) {
             ESP_LOGE(TAG, "ota data partition invalid, falling back to factory");
             boot_index = FACTORY_INDEX;
@@ -413,6 +426,27 @@ static bool try_load_partition(const esp_partition_pos_t *partition, esp_image_m
     return false;
 }
 
+#ifdef CONFIG_BOOTLOADER_SKIP_VALIDATE_IF_OTA_VALID
+/* Like try_load_partition, but skips checksum/SHA/signature validation.
+   Only used for the OTA slot whose otadata entry is sealed ESP_OTA_IMG_VALID;
+   a failure here falls through to the fully validated load. */
+static bool try_load_sealed_valid_partition(const esp_partition_pos_t *partition, esp_image_metadata_t *data)
+{
+    if (partition->size == 0) {
+        return false;
+    }
+#ifdef BOOTLOADER_BUILD
+    if (bootloader_load_image_no_verify(partition, data) == ESP_OK) {
+        ESP_LOGI(TAG, "Loaded app from partition at offset 0x%x (sealed valid, validation skipped)",
+                 partition->offset);
+        return true;
+    }
+#endif
+
+    return false;
+}
+#endif // CONFIG_BOOTLOADER_SKIP_VALIDATE_IF_OTA_VALID
+
 // ota_has_initial_contents flag is set if factory does not present in partition table and
 // otadata has initial content(0xFFFFFFFF), then set actual ota_seq.
 static void set_actual_ota_seq(const bootloader_state_t *bs, int index)
@@ -480,6 +514,13 @@ void bootloader_utility_load_boot_image(const bootloader_state_t *bs, int start_
             continue;
         }
         ESP_LOGD(TAG, TRY_LOG_FORMAT, index, part.offset, part.size);
+#ifdef CONFIG_BOOTLOADER_SKIP_VALIDATE_IF_OTA_VALID
+        if (index == ota_sealed_valid_index && check_anti_rollback(&part) &&
+                try_load_sealed_valid_partition(&part, &image_data)) {
+            set_actual_ota_seq(bs, index);
+            load_image(&image_data);
+        }
+#endif
         if (check_anti_rollback(&part) && try_load_partition(&part, &image_data)) {
             set_actual_ota_seq(bs, index);
             load_image(&image_data);
@@ -20,6 +20,7 @@
 
 #include "bt_common.h"
 #include "osi/allocator.h"
+#include "osi/pool.h"
 
 extern void *pvPortZalloc(size_t size);
 extern void vPortFree(void *pv);
@@ -256,5 +257,9 @@ void osi_free_func(void *ptr)
 #if HEAP_MEMORY_DEBUG
     osi_mem_dbg_clean(ptr, __func__, __LINE__);
 #endif
+    // blocks handed out by an osi_pool must go back to their pool
+    if (osi_pool_registry_release(ptr)) {
+        return;
+    }
     free(ptr);
 }
@@ -22,6 +22,7 @@
 #include <stddef.h>
 #include <stdlib.h>
 #include "esp_heap_caps.h"
+#include "osi/pool.h"
 
 char *osi_strdup(const char *str);
 
@@ -117,7 +118,9 @@ do {                                                    \
 do {                                                    \
     void *tmp_point = (void *)(ptr);                    \
     osi_mem_dbg_clean(tmp_point, __func__, __LINE__);   \
-    free(tmp_point);                                    \
+    if (!osi_pool_registry_release(tmp_point)) {        \
+        free(tmp_point);                                \
+    }                                                   \
 } while (0)
 
 #else
@@ -129,7 +132,7 @@ do {                                                    \
 #define osi_malloc(size)                  malloc((size))
 #define osi_calloc(size)                  calloc(1, (size))
 #endif /* #if HEAP_ALLOCATION_FROM_SPIRAM_FIRST */
-#define osi_free(p)                       free((p))
+#define osi_free(p)                       osi_free_func((p))
 
 #endif /* HEAP_MEMORY_DEBUG */
 
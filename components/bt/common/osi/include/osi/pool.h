@@ -0,0 +1,58 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _POOL_H_
+#define _POOL_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Fixed-size block pool for hot allocation paths (e.g. inbound HCI
+ * packets). Blocks come from one contiguous buffer allocated up front,
+ * so allocation and release are O(1) list operations with no heap
+ * traffic. Pools register themselves in a small global registry;
+ * osi_free() consults the registry, so pool blocks can be handed to
+ * code which frees them through the regular osi allocator macros.
+ */
+
+typedef struct osi_pool osi_pool_t;
+
+// Creates a pool of |block_count| blocks of |block_size| bytes each and
+// registers it for osi_free() interception. Returns NULL on failure.
+osi_pool_t *osi_pool_new(size_t block_size, size_t block_count);
+
+// Unregisters and destroys |pool|. All blocks must have been released.
+void osi_pool_destroy(osi_pool_t *pool);
+
+// Takes a block from |pool|. Returns NULL if the pool is exhausted;
+// the caller is expected to fall back to osi_malloc in that case.
+// The block contents are not zeroed.
+void *osi_pool_alloc(osi_pool_t *pool);
+
+// Usable size of each block in |pool|.
+size_t osi_pool_block_size(const osi_pool_t *pool);
+
+// Number of blocks of |pool| currently handed out.
+size_t osi_pool_in_use(const osi_pool_t *pool);
+
+// High watermark of blocks handed out simultaneously since creation.
+size_t osi_pool_max_in_use(const osi_pool_t *pool);
+
+// If |ptr| belongs to a registered pool, returns the block to its pool
+// and returns true. Returns false for pointers not owned by any pool
+// (the caller should then free them normally). Called from osi_free().
+bool osi_pool_registry_release(void *ptr);
+
+#endif /* _POOL_H_ */
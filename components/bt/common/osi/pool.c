@@ -0,0 +1,162 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <assert.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "osi/allocator.h"
+#include "osi/pool.h"
+
+#define OSI_POOL_REGISTRY_MAX 4
+
+typedef struct free_block {
+    struct free_block *next;
+} free_block_t;
+
+struct osi_pool {
+    uint8_t *buffer;        // contiguous backing storage
+    size_t block_size;      // usable bytes per block (4-byte aligned)
+    size_t block_count;
+    free_block_t *free_list;
+    size_t in_use;
+    size_t max_in_use;
+};
+
+static osi_pool_t *s_pool_registry[OSI_POOL_REGISTRY_MAX];
+static int s_pool_registry_count;
+static portMUX_TYPE s_pool_lock = portMUX_INITIALIZER_UNLOCKED;
+
+osi_pool_t *osi_pool_new(size_t block_size, size_t block_count)
+{
+    if (block_size == 0 || block_count == 0) {
+        return NULL;
+    }
+    // each block must be able to hold the free-list link and stay aligned
+    block_size = (block_size + 3) & ~(size_t)3;
+    if (block_size < sizeof(free_block_t)) {
+        block_size = sizeof(free_block_t);
+    }
+
+    osi_pool_t *pool = osi_calloc_func(sizeof(osi_pool_t));
+    if (pool == NULL) {
+        return NULL;
+    }
+    pool->buffer = osi_malloc_func(block_size * block_count);
+    if (pool->buffer == NULL) {
+        osi_free_func(pool);
+        return NULL;
+    }
+    pool->block_size = block_size;
+    pool->block_count = block_count;
+    for (size_t i = 0; i < block_count; i++) {
+        free_block_t *block = (free_block_t *)(pool->buffer + i * block_size);
+        block->next = pool->free_list;
+        pool->free_list = block;
+    }
+
+    portENTER_CRITICAL(&s_pool_lock);
+    bool registered = false;
+    if (s_pool_registry_count < OSI_POOL_REGISTRY_MAX) {
+        s_pool_registry[s_pool_registry_count++] = pool;
+        registered = true;
+    }
+    portEXIT_CRITICAL(&s_pool_lock);
+
+    if (!registered) {
+        osi_free_func(pool->buffer);
+        osi_free_func(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+void osi_pool_destroy(osi_pool_t *pool)
+{
+    if (pool == NULL) {
+        return;
+    }
+    portENTER_CRITICAL(&s_pool_lock);
+    for (int i = 0; i < s_pool_registry_count; i++) {
+        if (s_pool_registry[i] == pool) {
+            s_pool_registry[i] = s_pool_registry[--s_pool_registry_count];
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_pool_lock);
+
+    assert(pool->in_use == 0);
+    osi_free_func(pool->buffer);
+    osi_free_func(pool);
+}
+
+void *osi_pool_alloc(osi_pool_t *pool)
+{
+    if (pool == NULL) {
+        return NULL;
+    }
+    portENTER_CRITICAL(&s_pool_lock);
+    free_block_t *block = pool->free_list;
+    if (block != NULL) {
+        pool->free_list = block->next;
+        pool->in_use++;
+        if (pool->in_use > pool->max_in_use) {
+            pool->max_in_use = pool->in_use;
+        }
+    }
+    portEXIT_CRITICAL(&s_pool_lock);
+    return block;
+}
+
+size_t osi_pool_block_size(const osi_pool_t *pool)
+{
+    return pool ? pool->block_size : 0;
+}
+
+size_t osi_pool_in_use(const osi_pool_t *pool)
+{
+    return pool ? pool->in_use : 0;
+}
+
+size_t osi_pool_max_in_use(const osi_pool_t *pool)
+{
+    return pool ? pool->max_in_use : 0;
+}
+
+static bool pool_owns(const osi_pool_t *pool, const uint8_t *ptr)
+{
+    return ptr >= pool->buffer &&
+           ptr < pool->buffer + pool->block_size * pool->block_count;
+}
+
+bool osi_pool_registry_release(void *ptr)
+{
+    if (ptr == NULL || s_pool_registry_count == 0) {
+        return false;
+    }
+    bool released = false;
+    portENTER_CRITICAL(&s_pool_lock);
+    for (int i = 0; i < s_pool_registry_count; i++) {
+        osi_pool_t *pool = s_pool_registry[i];
+        if (pool_owns(pool, (const uint8_t *)ptr)) {
+            free_block_t *block = (free_block_t *)ptr;
+            block->next = pool->free_list;
+            pool->free_list = block;
+            pool->in_use--;
+            released = true;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_pool_lock);
+    return released;
+}
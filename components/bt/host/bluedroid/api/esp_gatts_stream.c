@@ -0,0 +1,247 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "string.h"
+#include "esp_gatt_defs.h"
+#include "esp_gatts_api.h"
+#include "esp_gatt_common_api.h"
+#include "esp_bt_main.h"
+#include "common/bt_target.h"
+#include "common/bt_trace.h"
+#include "common/bt_defs.h"
+#include "osi/allocator.h"
+#include "osi/fixed_queue.h"
+#include "osi/mutex.h"
+#include "stack/l2c_api.h"
+
+#if (GATTS_INCLUDED == TRUE && BLE_INCLUDED == TRUE && GATTS_NOTIFY_STREAM_INCLUDED == TRUE)
+
+/* One stream per connection; matches the usual number of concurrent links */
+#ifndef GATTS_NOTIFY_STREAM_MAX_CONNS
+#define GATTS_NOTIFY_STREAM_MAX_CONNS   3
+#endif
+
+typedef struct {
+    uint16_t len;
+    uint8_t value[0];
+} gatts_stream_buf_t;
+
+typedef struct {
+    bool in_use;
+    esp_gatt_if_t gatts_if;
+    uint16_t conn_id;
+    uint16_t attr_handle;
+    fixed_queue_t *queue;
+} gatts_stream_t;
+
+static gatts_stream_t s_streams[GATTS_NOTIFY_STREAM_MAX_CONNS];
+static osi_mutex_t s_stream_lock;
+static bool s_stream_lock_inited = false;
+
+static gatts_stream_t *gatts_stream_find(uint16_t conn_id)
+{
+    for (int i = 0; i < GATTS_NOTIFY_STREAM_MAX_CONNS; i++) {
+        if (s_streams[i].in_use && s_streams[i].conn_id == conn_id) {
+            return &s_streams[i];
+        }
+    }
+    return NULL;
+}
+
+/* Hand queued values to the stack until the controller's free buffer count is
+ * used up. Values left queued are sent on the next number-of-completed-packets
+ * event, i.e. right after a connection event drains some of the window. */
+static void gatts_stream_pump(gatts_stream_t *stream)
+{
+    gatts_stream_buf_t *buf;
+
+    while (esp_ble_get_cur_sendable_packets_num(stream->conn_id) > 0 &&
+            (buf = fixed_queue_try_peek_first(stream->queue)) != NULL) {
+        if (esp_ble_gatts_send_indicate(stream->gatts_if, stream->conn_id, stream->attr_handle,
+                                        buf->len, buf->value, false) != ESP_OK) {
+            /* Congested or disconnecting; keep the value for the next event */
+            break;
+        }
+        fixed_queue_dequeue(stream->queue, 0);
+        osi_free(buf);
+    }
+}
+
+/* Runs in the stack context whenever the controller reports completed packets
+ * on any link. Pumping a stream that has no credits or no data is cheap, so
+ * no per-link lookup is done here. */
+static void gatts_stream_nocp_cback(BD_ADDR bda)
+{
+    UNUSED(bda);
+
+    osi_mutex_lock(&s_stream_lock, OSI_MUTEX_MAX_TIMEOUT);
+    for (int i = 0; i < GATTS_NOTIFY_STREAM_MAX_CONNS; i++) {
+        if (s_streams[i].in_use) {
+            gatts_stream_pump(&s_streams[i]);
+        }
+    }
+    osi_mutex_unlock(&s_stream_lock);
+}
+
+esp_err_t esp_ble_gatts_notify_stream_start(esp_gatt_if_t gatts_if, uint16_t conn_id,
+                                            uint16_t attr_handle, uint16_t queue_len)
+{
+    gatts_stream_t *stream = NULL;
+
+    ESP_BLUEDROID_STATUS_CHECK(ESP_BLUEDROID_STATUS_ENABLED);
+
+    if (queue_len == 0 || attr_handle == ESP_GATT_ILLEGAL_HANDLE) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!s_stream_lock_inited) {
+        if (osi_mutex_new(&s_stream_lock) != 0) {
+            return ESP_ERR_NO_MEM;
+        }
+        s_stream_lock_inited = true;
+    }
+
+    osi_mutex_lock(&s_stream_lock, OSI_MUTEX_MAX_TIMEOUT);
+
+    if (gatts_stream_find(conn_id) != NULL) {
+        osi_mutex_unlock(&s_stream_lock);
+        LOG_ERROR("%s stream already active on conn_id %d", __func__, conn_id);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    for (int i = 0; i < GATTS_NOTIFY_STREAM_MAX_CONNS; i++) {
+        if (!s_streams[i].in_use) {
+            stream = &s_streams[i];
+            break;
+        }
+    }
+    if (stream == NULL) {
+        osi_mutex_unlock(&s_stream_lock);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    stream->queue = fixed_queue_new(queue_len);
+    if (stream->queue == NULL) {
+        osi_mutex_unlock(&s_stream_lock);
+        return ESP_ERR_NO_MEM;
+    }
+
+    if (!L2CA_RegForNoCPEvtByHandle(gatts_stream_nocp_cback, conn_id)) {
+        fixed_queue_free(stream->queue, NULL);
+        stream->queue = NULL;
+        osi_mutex_unlock(&s_stream_lock);
+        LOG_ERROR("%s no link for conn_id %d", __func__, conn_id);
+        return ESP_FAIL;
+    }
+
+    stream->gatts_if = gatts_if;
+    stream->conn_id = conn_id;
+    stream->attr_handle = attr_handle;
+    stream->in_use = true;
+
+    osi_mutex_unlock(&s_stream_lock);
+    return ESP_OK;
+}
+
+esp_err_t esp_ble_gatts_notify_stream_push(uint16_t conn_id, const uint8_t *value, uint16_t value_len)
+{
+    gatts_stream_t *stream;
+    gatts_stream_buf_t *buf;
+
+    ESP_BLUEDROID_STATUS_CHECK(ESP_BLUEDROID_STATUS_ENABLED);
+
+    if (value == NULL || value_len == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    osi_mutex_lock(&s_stream_lock, OSI_MUTEX_MAX_TIMEOUT);
+
+    stream = gatts_stream_find(conn_id);
+    if (stream == NULL) {
+        osi_mutex_unlock(&s_stream_lock);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (fixed_queue_length(stream->queue) >= fixed_queue_capacity(stream->queue)) {
+        /* Drain into the controller before rejecting the value */
+        gatts_stream_pump(stream);
+        if (fixed_queue_length(stream->queue) >= fixed_queue_capacity(stream->queue)) {
+            osi_mutex_unlock(&s_stream_lock);
+            return ESP_FAIL;
+        }
+    }
+
+    buf = osi_malloc(sizeof(gatts_stream_buf_t) + value_len);
+    if (buf == NULL) {
+        osi_mutex_unlock(&s_stream_lock);
+        return ESP_ERR_NO_MEM;
+    }
+    buf->len = value_len;
+    memcpy(buf->value, value, value_len);
+
+    fixed_queue_enqueue(stream->queue, buf, FIXED_QUEUE_MAX_TIMEOUT);
+    gatts_stream_pump(stream);
+
+    osi_mutex_unlock(&s_stream_lock);
+    return ESP_OK;
+}
+
+uint16_t esp_ble_gatts_notify_stream_pending(uint16_t conn_id)
+{
+    gatts_stream_t *stream;
+    uint16_t pending = 0;
+
+    if (!s_stream_lock_inited) {
+        return 0;
+    }
+
+    osi_mutex_lock(&s_stream_lock, OSI_MUTEX_MAX_TIMEOUT);
+    stream = gatts_stream_find(conn_id);
+    if (stream != NULL) {
+        pending = fixed_queue_length(stream->queue);
+    }
+    osi_mutex_unlock(&s_stream_lock);
+
+    return pending;
+}
+
+esp_err_t esp_ble_gatts_notify_stream_stop(uint16_t conn_id)
+{
+    gatts_stream_t *stream;
+
+    ESP_BLUEDROID_STATUS_CHECK(ESP_BLUEDROID_STATUS_ENABLED);
+
+    if (!s_stream_lock_inited) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    osi_mutex_lock(&s_stream_lock, OSI_MUTEX_MAX_TIMEOUT);
+
+    stream = gatts_stream_find(conn_id);
+    if (stream == NULL) {
+        osi_mutex_unlock(&s_stream_lock);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    /* The link may already be gone; deregistration failure is harmless then */
+    L2CA_RegForNoCPEvtByHandle(NULL, conn_id);
+
+    fixed_queue_free(stream->queue, osi_free_func);
+    memset(stream, 0, sizeof(gatts_stream_t));
+
+    osi_mutex_unlock(&s_stream_lock);
+    return ESP_OK;
+}
+
+#endif  /* GATTS_INCLUDED && BLE_INCLUDED && GATTS_NOTIFY_STREAM_INCLUDED */
@@ -578,6 +578,70 @@ esp_err_t esp_ble_gatts_close(esp_gatt_if_t gatts_if, uint16_t conn_id);
  */
 esp_err_t esp_ble_gatts_send_service_change_indication(esp_gatt_if_t gatts_if, esp_bd_addr_t remote_bda);
 
+/**
+ * @brief           Start notification streaming on a connection.
+ *                  A stream keeps an internal queue of values for one characteristic and
+ *                  sends them as GATT notifications, packing as many packets into each
+ *                  connection event as the controller's free buffer count allows. The
+ *                  queue is refilled into the controller each time a number-of-completed
+ *                  -packets event is received, so the radio is kept busy without the
+ *                  application pacing individual esp_ble_gatts_send_indicate calls.
+ *
+ * @param[in]       gatts_if: GATT server access interface
+ * @param[in]       conn_id - connection id to stream on.
+ * @param[in]       attr_handle - attribute handle the notifications are sent for.
+ * @param[in]       queue_len - maximum number of values buffered in the stream.
+ *
+ * @return
+ *                  - ESP_OK : success
+ *                  - other  : failed
+ *
+ */
+esp_err_t esp_ble_gatts_notify_stream_start(esp_gatt_if_t gatts_if, uint16_t conn_id,
+                                            uint16_t attr_handle, uint16_t queue_len);
+
+/**
+ * @brief           Queue one value on a notification stream. The value is copied.
+ *                  If the controller has free packet buffers the value (and any
+ *                  previously queued ones) is sent immediately, otherwise it is
+ *                  sent when the controller reports completed packets.
+ *
+ * @param[in]       conn_id - connection id the stream was started on.
+ * @param[in]       value: value to notify.
+ * @param[in]       value_len - value length, at most the current MTU minus 3.
+ *
+ * @return
+ *                  - ESP_OK : success
+ *                  - ESP_FAIL : the stream queue is full, retry later
+ *                  - other  : failed
+ *
+ */
+esp_err_t esp_ble_gatts_notify_stream_push(uint16_t conn_id, const uint8_t *value, uint16_t value_len);
+
+/**
+ * @brief           Get the number of values waiting in a notification stream queue.
+ *
+ * @param[in]       conn_id - connection id the stream was started on.
+ *
+ * @return          number of queued values, 0 if no stream is active.
+ *
+ */
+uint16_t esp_ble_gatts_notify_stream_pending(uint16_t conn_id);
+
+/**
+ * @brief           Stop notification streaming on a connection and discard any
+ *                  values still queued. Must be called when the connection is
+ *                  closed while a stream is active.
+ *
+ * @param[in]       conn_id - connection id the stream was started on.
+ *
+ * @return
+ *                  - ESP_OK : success
+ *                  - other  : failed
+ *
+ */
+esp_err_t esp_ble_gatts_notify_stream_stop(uint16_t conn_id);
+
 #ifdef __cplusplus
 }
 #endif
@@ -165,6 +165,11 @@
 #define GATTS_INCLUDED              FALSE
 #endif /* UC_BT_GATTS_ENABLE */
 
+/* Queue-fed GATT notification streaming (esp_ble_gatts_notify_stream_*) */
+#ifndef GATTS_NOTIFY_STREAM_INCLUDED
+#define GATTS_NOTIFY_STREAM_INCLUDED    TRUE
+#endif
+
 #if (UC_BT_GATTC_ENABLE)
 #define GATTC_INCLUDED              TRUE
 #else
@@ -897,6 +902,19 @@
 
 #define C2H_FLOW_CONTROL_INCLUDED TRUE
 
+/******************************************************************************
+**
+** HCI INBOUND PACKET POOL
+**
+** Preallocated fixed-size blocks for inbound HCI events and ACL data,
+** avoiding a heap allocation/free per packet on the hot receive path.
+**
+******************************************************************************/
+
+#ifndef HCI_PKT_POOL_INCLUDED
+#define HCI_PKT_POOL_INCLUDED TRUE
+#endif
+
 /******************************************************************************
 **
 ** L2CAP
@@ -20,6 +20,7 @@
 #include "common/bt_trace.h"
 #include "stack/bt_types.h"
 #include "osi/fixed_queue.h"
+#include "osi/pool.h"
 #include "hci/hci_hal.h"
 #include "hci/hci_internals.h"
 #include "hci/hci_layer.h"
@@ -34,6 +35,15 @@
 
 #define HCI_HAL_SERIAL_BUFFER_SIZE 1026
 #define HCI_BLE_EVENT 0x3e
+
+#if (HCI_PKT_POOL_INCLUDED == TRUE)
+// Most HCI events fit the small blocks; ACL blocks cover the largest packet.
+// Oversized packets (and pool exhaustion) fall back to the heap.
+#define HCI_PKT_POOL_EVT_BLOCK_SIZE (BT_HDR_SIZE + 68)
+#define HCI_PKT_POOL_EVT_BLOCK_NUM  20
+#define HCI_PKT_POOL_ACL_BLOCK_SIZE (BT_HDR_SIZE + HCI_HAL_SERIAL_BUFFER_SIZE)
+#define HCI_PKT_POOL_ACL_BLOCK_NUM  6
+#endif
 #define PACKET_TYPE_TO_INBOUND_INDEX(type) ((type) - 2)
 #define PACKET_TYPE_TO_INDEX(type) ((type) - 1)
 extern bool BTU_check_queue_is_congest(void);
@@ -57,10 +67,16 @@ typedef struct {
     size_t buffer_size;
     fixed_queue_t *rx_q;
     uint16_t adv_free_num;
+#if (HCI_PKT_POOL_INCLUDED == TRUE)
+    osi_pool_t *evt_pool;
+    osi_pool_t *acl_pool;
+#endif
 } hci_hal_env_t;
 
 
 static hci_hal_env_t hci_hal_env;
+// set while a rx drain is already posted to the thread, to coalesce wakeups
+static volatile int rx_drain_pending;
 static const hci_hal_t interface;
 static const hci_hal_callbacks_t *callbacks;
 static const esp_vhci_host_callback_t vhci_host_cb;
@@ -90,6 +106,12 @@ static void hci_hal_env_init(
         HCI_TRACE_ERROR("%s unable to create rx queue.\n", __func__);
     }
 
+#if (HCI_PKT_POOL_INCLUDED == TRUE)
+    // on pool creation failure the receive path simply falls back to the heap
+    hci_hal_env.evt_pool = osi_pool_new(HCI_PKT_POOL_EVT_BLOCK_SIZE, HCI_PKT_POOL_EVT_BLOCK_NUM);
+    hci_hal_env.acl_pool = osi_pool_new(HCI_PKT_POOL_ACL_BLOCK_SIZE, HCI_PKT_POOL_ACL_BLOCK_NUM);
+#endif
+
     return;
 }
 
@@ -97,6 +119,13 @@ static void hci_hal_env_deinit(void)
 {
     fixed_queue_free(hci_hal_env.rx_q, osi_free_func);
     hci_hal_env.rx_q = NULL;
+
+#if (HCI_PKT_POOL_INCLUDED == TRUE)
+    osi_pool_destroy(hci_hal_env.evt_pool);
+    hci_hal_env.evt_pool = NULL;
+    osi_pool_destroy(hci_hal_env.acl_pool);
+    hci_hal_env.acl_pool = NULL;
+#endif
 }
 
 static bool hal_open(const hci_hal_callbacks_t *upper_callbacks, void *task_thread)
@@ -167,6 +196,8 @@ static uint16_t transmit_data(serial_data_type_t type,
 // Internal functions
 static void hci_hal_h4_rx_handler(void *arg)
 {
+    // clear before draining: a packet arriving after this point posts again
+    __sync_lock_release(&rx_drain_pending);
     fixed_queue_process(hci_hal_env.rx_q);
 }
 
@@ -175,6 +206,23 @@ bool hci_hal_h4_task_post(uint32_t timeout)
     return osi_thread_post(hci_h4_thread, hci_hal_h4_rx_handler, NULL, 1, timeout);
 }
 
+uint16_t hci_hal_get_rx_queue_depth(void)
+{
+    return hci_hal_env.rx_q ? fixed_queue_length(hci_hal_env.rx_q) : 0;
+}
+
+void hci_hal_dump_stats(void)
+{
+    HCI_TRACE_WARNING("hal rx_q depth %d", hci_hal_get_rx_queue_depth());
+#if (HCI_PKT_POOL_INCLUDED == TRUE)
+    HCI_TRACE_WARNING("hal evt pool %d/%d (max %d), acl pool %d/%d (max %d)",
+                      osi_pool_in_use(hci_hal_env.evt_pool), HCI_PKT_POOL_EVT_BLOCK_NUM,
+                      osi_pool_max_in_use(hci_hal_env.evt_pool),
+                      osi_pool_in_use(hci_hal_env.acl_pool), HCI_PKT_POOL_ACL_BLOCK_NUM,
+                      osi_pool_max_in_use(hci_hal_env.acl_pool));
+#endif
+}
+
 #if (C2H_FLOW_CONTROL_INCLUDED == TRUE)
 static void hci_packet_complete(BT_HDR *packet){
     uint8_t type, num_handle;
@@ -337,7 +385,20 @@ static int host_recv_pkt_cb(uint8_t *data, uint16_t len)
     }
 
     pkt_size = BT_HDR_SIZE + len;
+#if (HCI_PKT_POOL_INCLUDED == TRUE)
+    pkt = NULL;
+    if (pkt_size <= osi_pool_block_size(hci_hal_env.evt_pool)) {
+        pkt = (BT_HDR *) osi_pool_alloc(hci_hal_env.evt_pool);
+    }
+    if (pkt == NULL && pkt_size <= osi_pool_block_size(hci_hal_env.acl_pool)) {
+        pkt = (BT_HDR *) osi_pool_alloc(hci_hal_env.acl_pool);
+    }
+    if (pkt == NULL) {
+        pkt = (BT_HDR *) osi_calloc(pkt_size);
+    }
+#else
     pkt = (BT_HDR *) osi_calloc(pkt_size);
+#endif
 
     if (!pkt) {
         HCI_TRACE_ERROR("%s couldn't aquire memory for inbound data buffer.\n", __func__);
@@ -346,9 +407,16 @@ static int host_recv_pkt_cb(uint8_t *data, uint16_t len)
     pkt->offset = 0;
     pkt->len = len;
     pkt->layer_specific = 0;
+    pkt->event = 0;
     memcpy(pkt->data, data, len);
     fixed_queue_enqueue(hci_hal_env.rx_q, pkt, FIXED_QUEUE_MAX_TIMEOUT);
-    hci_hal_h4_task_post(0);
+    // Coalesce wakeups: one post drains the whole queue, so while a drain
+    // is pending further packets do not need to wake the thread again
+    if (__sync_lock_test_and_set(&rx_drain_pending, 1) == 0) {
+        if (!hci_hal_h4_task_post(0)) {
+            __sync_lock_release(&rx_drain_pending);
+        }
+    }
 
 
     BTTRC_DUMP_BUFFER("Recv Pkt", pkt->data, len);
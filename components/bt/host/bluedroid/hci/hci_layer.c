@@ -140,6 +140,15 @@ bool hci_host_task_post(uint32_t timeout)
     return osi_thread_post(hci_host_thread, hci_host_thread_handler, NULL, 0, timeout);
 }
 
+void hci_debug_dump_stats(void)
+{
+    HCI_TRACE_WARNING("hci command_queue depth %d, packet_queue depth %d, credits %d",
+                      fixed_queue_length(hci_host_env.command_queue),
+                      fixed_queue_length(hci_host_env.packet_queue),
+                      hci_host_env.command_credits);
+    hci_hal_dump_stats();
+}
+
 static int hci_layer_init_env(void)
 {
     command_waiting_response_t *cmd_wait_q;
@@ -82,4 +82,10 @@ typedef struct hci_hal_t {
 // Gets the correct hal implementation, as compiled for.
 const hci_hal_t *hci_hal_h4_get_interface(void);
 
+// Current number of inbound packets waiting in the hal rx queue.
+uint16_t hci_hal_get_rx_queue_depth(void);
+
+// Logs the hal rx queue depth and the inbound packet pool usage.
+void hci_hal_dump_stats(void);
+
 #endif /* _HCI_HAL_H */
@@ -99,4 +99,8 @@ void hci_shut_down(void);
 
 bool hci_host_task_post(uint32_t timeout);
 
+// Logs the depths of the hci layer queues and of the hal below it,
+// for verifying stack overhead reductions on device.
+void hci_debug_dump_stats(void);
+
 #endif /* _HCI_LAYER_H_ */
@@ -1229,6 +1229,8 @@ extern UINT16 L2CA_GetDisconnectReason (BD_ADDR remote_bda, tBT_TRANSPORT transp
 
 extern BOOLEAN L2CA_CheckIsCongest(UINT16 fixed_cid, UINT16 handle);
 
+extern BOOLEAN L2CA_RegForNoCPEvtByHandle(tL2CA_NOCP_CB *p_cb, UINT16 handle);
+
 #define  L2CA_GET_ATT_NUM      0
 #define  L2CA_ADD_BTC_NUM      1
 #define  L2CA_DECREASE_BTC_NUM 2
@@ -1883,6 +1883,32 @@ UINT16 L2CA_GetCurFreePktBufferNum_LE(UINT16 conn_id)
     l2ble_update_att_acl_pkt_num(L2CA_GET_ATT_NUM, &param);
     return num;
 }
+
+/*******************************************************************************
+**
+** Function         L2CA_RegForNoCPEvtByHandle
+**
+** Description      Register callback for Number of Completed Packets event
+**                  on the link identified by its ACL handle. Pass NULL to
+**                  deregister.
+**
+** Returns          TRUE if the link exists, else FALSE
+**
+*******************************************************************************/
+BOOLEAN L2CA_RegForNoCPEvtByHandle(tL2CA_NOCP_CB *p_cb, UINT16 handle)
+{
+    tL2C_LCB        *p_lcb;
+
+    p_lcb = l2cu_find_lcb_by_handle (handle);
+
+    if (!p_lcb) {
+        return FALSE;
+    }
+
+    p_lcb->p_nocp_cb = p_cb;
+
+    return TRUE;
+}
 #endif
 
 /*******************************************************************************
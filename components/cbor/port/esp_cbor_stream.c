@@ -0,0 +1,259 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include "esp_cbor_stream.h"
+
+/* CBOR major types, shifted into the initial byte */
+#define CBOR_TYPE_UINT      0x00
+#define CBOR_TYPE_NEGINT    0x20
+#define CBOR_TYPE_BYTES     0x40
+#define CBOR_TYPE_TEXT      0x60
+#define CBOR_TYPE_ARRAY     0x80
+#define CBOR_TYPE_MAP       0xa0
+
+#define CBOR_FALSE          0xf4
+#define CBOR_TRUE           0xf5
+#define CBOR_NULL           0xf6
+#define CBOR_DOUBLE         0xfb
+#define CBOR_INDEF_ARRAY    0x9f
+#define CBOR_INDEF_MAP      0xbf
+#define CBOR_BREAK          0xff
+
+static esp_err_t stream_drain(esp_cbor_stream_t *enc)
+{
+    if (enc->used && !enc->failed) {
+        if (enc->cb(enc->buf, enc->used, enc->ctx) != 0) {
+            enc->failed = true;
+        }
+    }
+    enc->used = 0;
+    return enc->failed ? ESP_FAIL : ESP_OK;
+}
+
+static esp_err_t stream_write(esp_cbor_stream_t *enc, const uint8_t *data, size_t len)
+{
+    if (enc->failed) {
+        return ESP_FAIL;
+    }
+    while (len) {
+        size_t room = ESP_CBOR_STREAM_BUF_SIZE - enc->used;
+        size_t copy = (len < room) ? len : room;
+        memcpy(enc->buf + enc->used, data, copy);
+        enc->used += copy;
+        data += copy;
+        len -= copy;
+        if (enc->used == ESP_CBOR_STREAM_BUF_SIZE && stream_drain(enc) != ESP_OK) {
+            return ESP_FAIL;
+        }
+    }
+    return ESP_OK;
+}
+
+static esp_err_t stream_write_byte(esp_cbor_stream_t *enc, uint8_t byte)
+{
+    return stream_write(enc, &byte, 1);
+}
+
+/* Initial byte plus shortest big-endian argument for the given value */
+static esp_err_t stream_write_head(esp_cbor_stream_t *enc, uint8_t major, uint64_t value)
+{
+    uint8_t head[9];
+    size_t len;
+
+    if (value < 24) {
+        head[0] = major | (uint8_t)value;
+        len = 1;
+    } else if (value <= UINT8_MAX) {
+        head[0] = major | 24;
+        head[1] = (uint8_t)value;
+        len = 2;
+    } else if (value <= UINT16_MAX) {
+        head[0] = major | 25;
+        head[1] = (uint8_t)(value >> 8);
+        head[2] = (uint8_t)value;
+        len = 3;
+    } else if (value <= UINT32_MAX) {
+        head[0] = major | 26;
+        head[1] = (uint8_t)(value >> 24);
+        head[2] = (uint8_t)(value >> 16);
+        head[3] = (uint8_t)(value >> 8);
+        head[4] = (uint8_t)value;
+        len = 5;
+    } else {
+        head[0] = major | 27;
+        for (int i = 0; i < 8; i++) {
+            head[1 + i] = (uint8_t)(value >> (56 - 8 * i));
+        }
+        len = 9;
+    }
+    return stream_write(enc, head, len);
+}
+
+static esp_err_t stream_open_container(esp_cbor_stream_t *enc, uint8_t major, uint8_t indef_byte, size_t count)
+{
+    if (!enc || enc->failed) {
+        return ESP_FAIL;
+    }
+    if (enc->depth >= ESP_CBOR_STREAM_MAX_DEPTH) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    esp_err_t err;
+    if (count == ESP_CBOR_STREAM_INDEFINITE) {
+        enc->indef_mask |= 1u << enc->depth;
+        err = stream_write_byte(enc, indef_byte);
+    } else {
+        enc->indef_mask &= ~(1u << enc->depth);
+        err = stream_write_head(enc, major, count);
+    }
+    if (err == ESP_OK) {
+        enc->depth++;
+    }
+    return err;
+}
+
+esp_err_t esp_cbor_stream_init(esp_cbor_stream_t *enc, esp_cbor_write_cb_t write_cb, void *ctx)
+{
+    if (!enc || !write_cb) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    memset(enc, 0, sizeof(*enc));
+    enc->cb = write_cb;
+    enc->ctx = ctx;
+    return ESP_OK;
+}
+
+esp_err_t esp_cbor_stream_flush(esp_cbor_stream_t *enc)
+{
+    if (!enc) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return stream_drain(enc);
+}
+
+esp_err_t esp_cbor_stream_uint(esp_cbor_stream_t *enc, uint64_t value)
+{
+    if (!enc || enc->failed) {
+        return ESP_FAIL;
+    }
+    return stream_write_head(enc, CBOR_TYPE_UINT, value);
+}
+
+esp_err_t esp_cbor_stream_int(esp_cbor_stream_t *enc, int64_t value)
+{
+    if (!enc || enc->failed) {
+        return ESP_FAIL;
+    }
+    if (value < 0) {
+        return stream_write_head(enc, CBOR_TYPE_NEGINT, ~(uint64_t)value);
+    }
+    return stream_write_head(enc, CBOR_TYPE_UINT, (uint64_t)value);
+}
+
+esp_err_t esp_cbor_stream_bool(esp_cbor_stream_t *enc, bool value)
+{
+    if (!enc || enc->failed) {
+        return ESP_FAIL;
+    }
+    return stream_write_byte(enc, value ? CBOR_TRUE : CBOR_FALSE);
+}
+
+esp_err_t esp_cbor_stream_null(esp_cbor_stream_t *enc)
+{
+    if (!enc || enc->failed) {
+        return ESP_FAIL;
+    }
+    return stream_write_byte(enc, CBOR_NULL);
+}
+
+esp_err_t esp_cbor_stream_double(esp_cbor_stream_t *enc, double value)
+{
+    if (!enc || enc->failed) {
+        return ESP_FAIL;
+    }
+
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    uint8_t out[9];
+    out[0] = CBOR_DOUBLE;
+    for (int i = 0; i < 8; i++) {
+        out[1 + i] = (uint8_t)(bits >> (56 - 8 * i));
+    }
+    return stream_write(enc, out, sizeof(out));
+}
+
+esp_err_t esp_cbor_stream_text(esp_cbor_stream_t *enc, const char *str)
+{
+    if (!str) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return esp_cbor_stream_text_len(enc, str, strlen(str));
+}
+
+esp_err_t esp_cbor_stream_text_len(esp_cbor_stream_t *enc, const char *str, size_t len)
+{
+    if (!enc || enc->failed) {
+        return ESP_FAIL;
+    }
+    if (!str && len) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err = stream_write_head(enc, CBOR_TYPE_TEXT, len);
+    if (err == ESP_OK) {
+        err = stream_write(enc, (const uint8_t *)str, len);
+    }
+    return err;
+}
+
+esp_err_t esp_cbor_stream_bytes(esp_cbor_stream_t *enc, const uint8_t *data, size_t len)
+{
+    if (!enc || enc->failed) {
+        return ESP_FAIL;
+    }
+    if (!data && len) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err = stream_write_head(enc, CBOR_TYPE_BYTES, len);
+    if (err == ESP_OK) {
+        err = stream_write(enc, data, len);
+    }
+    return err;
+}
+
+esp_err_t esp_cbor_stream_open_array(esp_cbor_stream_t *enc, size_t count)
+{
+    return stream_open_container(enc, CBOR_TYPE_ARRAY, CBOR_INDEF_ARRAY, count);
+}
+
+esp_err_t esp_cbor_stream_open_map(esp_cbor_stream_t *enc, size_t count)
+{
+    return stream_open_container(enc, CBOR_TYPE_MAP, CBOR_INDEF_MAP, count);
+}
+
+esp_err_t esp_cbor_stream_close(esp_cbor_stream_t *enc)
+{
+    if (!enc || enc->failed) {
+        return ESP_FAIL;
+    }
+    if (enc->depth == 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    enc->depth--;
+    if (enc->indef_mask & (1u << enc->depth)) {
+        return stream_write_byte(enc, CBOR_BREAK);
+    }
+    return ESP_OK;
+}
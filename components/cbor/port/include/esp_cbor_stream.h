@@ -0,0 +1,151 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Streaming CBOR encoder
+ *
+ * The TinyCBOR encoder writes into one caller-provided flat buffer, which
+ * has to be sized for the worst-case message. This encoder instead stages
+ * output in a small internal buffer and flushes completed bytes through a
+ * write callback as encoding proceeds, so a CBOR payload of any size can
+ * be produced with constant memory and handed straight to a transport.
+ *
+ * Containers whose element count is known up front are encoded with
+ * definite lengths; pass ESP_CBOR_STREAM_INDEFINITE to use CBOR
+ * indefinite-length framing, which needs no length backpatching and is
+ * closed by a break byte when the container is closed.
+ */
+
+/** Internal staging buffer size; one callback per this many bytes */
+#define ESP_CBOR_STREAM_BUF_SIZE    64
+
+/** Maximum container nesting depth */
+#define ESP_CBOR_STREAM_MAX_DEPTH   32
+
+/** Container length for esp_cbor_stream_open_* when the count is unknown */
+#define ESP_CBOR_STREAM_INDEFINITE  SIZE_MAX
+
+/**
+ * @brief Output callback for the streaming encoder
+ *
+ * @param data chunk of encoded output
+ * @param len chunk length in bytes
+ * @param ctx user argument given to esp_cbor_stream_init()
+ *
+ * @return 0 to continue, any other value to abort encoding
+ */
+typedef int (*esp_cbor_write_cb_t)(const uint8_t *data, size_t len, void *ctx);
+
+/**
+ * @brief Streaming encoder state; initialize with esp_cbor_stream_init()
+ */
+typedef struct {
+    uint8_t buf[ESP_CBOR_STREAM_BUF_SIZE];
+    size_t used;
+    esp_cbor_write_cb_t cb;
+    void *ctx;
+    uint32_t indef_mask;        /*!< bit per depth: container is indefinite */
+    int depth;
+    bool failed;
+} esp_cbor_stream_t;
+
+/**
+ * @brief Initialize a streaming encoder
+ *
+ * @param enc encoder state to initialize
+ * @param write_cb receives the encoded output in chunks
+ * @param ctx user argument passed to the callback
+ *
+ * @return ESP_OK, or ESP_ERR_INVALID_ARG on NULL encoder or callback
+ */
+esp_err_t esp_cbor_stream_init(esp_cbor_stream_t *enc, esp_cbor_write_cb_t write_cb, void *ctx);
+
+/**
+ * @brief Flush any staged bytes to the callback
+ *
+ * Call once after the top-level item is complete. Encoding primitives
+ * flush automatically whenever the staging buffer fills.
+ *
+ * @return ESP_OK, or ESP_FAIL when the callback aborted or a previous
+ *         encoding call failed
+ */
+esp_err_t esp_cbor_stream_flush(esp_cbor_stream_t *enc);
+
+/** @brief Encode an unsigned integer */
+esp_err_t esp_cbor_stream_uint(esp_cbor_stream_t *enc, uint64_t value);
+
+/** @brief Encode a signed integer */
+esp_err_t esp_cbor_stream_int(esp_cbor_stream_t *enc, int64_t value);
+
+/** @brief Encode a boolean */
+esp_err_t esp_cbor_stream_bool(esp_cbor_stream_t *enc, bool value);
+
+/** @brief Encode a null */
+esp_err_t esp_cbor_stream_null(esp_cbor_stream_t *enc);
+
+/** @brief Encode a double-precision float */
+esp_err_t esp_cbor_stream_double(esp_cbor_stream_t *enc, double value);
+
+/** @brief Encode a NUL-terminated text string */
+esp_err_t esp_cbor_stream_text(esp_cbor_stream_t *enc, const char *str);
+
+/** @brief Encode a text string with explicit length */
+esp_err_t esp_cbor_stream_text_len(esp_cbor_stream_t *enc, const char *str, size_t len);
+
+/** @brief Encode a byte string */
+esp_err_t esp_cbor_stream_bytes(esp_cbor_stream_t *enc, const uint8_t *data, size_t len);
+
+/**
+ * @brief Open an array
+ *
+ * @param count element count, or ESP_CBOR_STREAM_INDEFINITE when unknown
+ *
+ * @return ESP_OK, ESP_ERR_NO_MEM at maximum nesting depth, or ESP_FAIL
+ */
+esp_err_t esp_cbor_stream_open_array(esp_cbor_stream_t *enc, size_t count);
+
+/**
+ * @brief Open a map
+ *
+ * @param count key/value pair count, or ESP_CBOR_STREAM_INDEFINITE when
+ *              unknown
+ *
+ * @return ESP_OK, ESP_ERR_NO_MEM at maximum nesting depth, or ESP_FAIL
+ */
+esp_err_t esp_cbor_stream_open_map(esp_cbor_stream_t *enc, size_t count);
+
+/**
+ * @brief Close the innermost open container
+ *
+ * Emits the break byte for indefinite-length containers; definite-length
+ * containers carry their count in the header and need no trailer.
+ *
+ * @return ESP_OK, ESP_ERR_INVALID_STATE with no container open, or ESP_FAIL
+ */
+esp_err_t esp_cbor_stream_close(esp_cbor_stream_t *enc);
+
+#ifdef __cplusplus
+}
+#endif
@@ -19,6 +19,8 @@
 #include "esp_log.h"
 #include "esp_console.h"
 #include "esp_system.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "linenoise/linenoise.h"
 #include "argtable3/argtable3.h"
 #include "sys/queue.h"
@@ -41,12 +43,21 @@ typedef struct cmd_item_ {
     char *hint;
     esp_console_cmd_func_t func;    //!< pointer to the command handler
     void *argtable;                 //!< optional pointer to arg table
+    uint32_t flags;                 //!< ESP_CONSOLE_CMD_FLAG_* values
+    uint32_t hash;                  //!< hash of the command name
     SLIST_ENTRY(cmd_item_) next;    //!< next command in the list
+    SLIST_ENTRY(cmd_item_) hash_next; //!< next command in the same hash bucket
 } cmd_item_t;
 
-/** linked list of command structures */
+/** linked list of command structures, in registration order (used by help,
+ *  completion and hints) */
 static SLIST_HEAD(cmd_list_, cmd_item_) s_cmd_list;
 
+/** hash buckets for command lookup by name; each item is linked both into
+ *  s_cmd_list and into one bucket */
+#define CMD_HASH_BUCKETS 16
+static SLIST_HEAD(cmd_hash_list_, cmd_item_) s_cmd_hash[CMD_HASH_BUCKETS];
+
 /** run-time configuration options */
 static esp_console_config_t s_config;
 
@@ -55,6 +66,16 @@ static char *s_tmp_line_buf;
 
 static const cmd_item_t *find_command_by_name(const char *name);
 
+/* FNV-1a, good enough to spread command names over the buckets */
+static uint32_t cmd_name_hash(const char *name)
+{
+    uint32_t hash = 2166136261u;
+    for (const unsigned char *p = (const unsigned char *) name; *p != 0; ++p) {
+        hash = (hash ^ *p) * 16777619u;
+    }
+    return hash;
+}
+
 esp_err_t esp_console_init(const esp_console_config_t *config)
 {
     if (!config) {
@@ -87,6 +108,9 @@ esp_err_t esp_console_deinit(void)
         free(it->hint);
         free(it);
     }
+    for (int i = 0; i < CMD_HASH_BUCKETS; ++i) {
+        SLIST_INIT(&s_cmd_hash[i]);
+    }
     return ESP_OK;
 }
 
@@ -109,6 +133,7 @@ esp_err_t esp_console_cmd_register(const esp_console_cmd_t *cmd)
     } else {
         // remove from list and free the old hint, because we will alloc new hint for the command
         SLIST_REMOVE(&s_cmd_list, item, cmd_item_, next);
+        SLIST_REMOVE(&s_cmd_hash[item->hash % CMD_HASH_BUCKETS], item, cmd_item_, hash_next);
         free(item->hint);
     }
     item->command = cmd->command;
@@ -132,6 +157,9 @@ esp_err_t esp_console_cmd_register(const esp_console_cmd_t *cmd)
     }
     item->argtable = cmd->argtable;
     item->func = cmd->func;
+    item->flags = cmd->flags;
+    item->hash = cmd_name_hash(cmd->command);
+    SLIST_INSERT_HEAD(&s_cmd_hash[item->hash % CMD_HASH_BUCKETS], item, hash_next);
     cmd_item_t *last = SLIST_FIRST(&s_cmd_list);
     if (last == NULL) {
         SLIST_INSERT_HEAD(&s_cmd_list, item, next);
@@ -179,10 +207,9 @@ static const cmd_item_t *find_command_by_name(const char *name)
 {
     const cmd_item_t *cmd = NULL;
     cmd_item_t *it;
-    int len = strlen(name);
-    SLIST_FOREACH(it, &s_cmd_list, next) {
-        if (strlen(it->command) == len &&
-                strcmp(name, it->command) == 0) {
+    uint32_t hash = cmd_name_hash(name);
+    SLIST_FOREACH(it, &s_cmd_hash[hash % CMD_HASH_BUCKETS], hash_next) {
+        if (it->hash == hash && strcmp(name, it->command) == 0) {
             cmd = it;
             break;
         }
@@ -190,6 +217,123 @@ static const cmd_item_t *find_command_by_name(const char *name)
     return cmd;
 }
 
+/** background command jobs */
+#define CONSOLE_JOB_COUNT           4
+#define CONSOLE_JOB_TASK_STACK      4096
+#define CONSOLE_JOB_TASK_PRIORITY   1
+
+typedef struct {
+    int id;                         //!< identifier reported to the user, 0 if slot unused
+    esp_console_job_state_t state;
+    int ret;                        //!< command return code, valid when state is DONE
+    char *line;                     //!< copy of the command line, owned by the job
+    esp_console_cmd_func_t func;
+    TaskHandle_t task;
+} console_job_t;
+
+static console_job_t s_jobs[CONSOLE_JOB_COUNT];
+static int s_next_job_id = 1;
+static portMUX_TYPE s_job_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static void console_job_task(void *arg)
+{
+    console_job_t *job = (console_job_t *) arg;
+    int ret = 1;
+    char **argv = (char **) calloc(s_config.max_cmdline_args, sizeof(char *));
+    // split a copy: job->line stays intact for the 'jobs' listing
+    char *line = strdup(job->line);
+    if (argv != NULL && line != NULL) {
+        size_t argc = esp_console_split_argv(line, argv,
+                                             s_config.max_cmdline_args);
+        ret = (*job->func)(argc, argv);
+    }
+    free(line);
+    free(argv);
+    portENTER_CRITICAL(&s_job_lock);
+    job->ret = ret;
+    job->state = ESP_CONSOLE_JOB_DONE;
+    job->task = NULL;
+    portEXIT_CRITICAL(&s_job_lock);
+    vTaskDelete(NULL);
+}
+
+static esp_err_t console_job_start(const cmd_item_t *cmd, const char *cmdline, int *job_id)
+{
+    console_job_t *job = NULL;
+    portENTER_CRITICAL(&s_job_lock);
+    for (int i = 0; i < CONSOLE_JOB_COUNT; ++i) {
+        if (s_jobs[i].id == 0 || s_jobs[i].state == ESP_CONSOLE_JOB_DONE) {
+            job = &s_jobs[i];
+            job->id = s_next_job_id++;
+            job->state = ESP_CONSOLE_JOB_RUNNING;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_job_lock);
+    if (job == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    free(job->line);
+    job->line = strdup(cmdline);
+    job->func = cmd->func;
+    if (job->line == NULL ||
+            xTaskCreate(console_job_task, "console_job", CONSOLE_JOB_TASK_STACK,
+                        job, CONSOLE_JOB_TASK_PRIORITY, &job->task) != pdPASS) {
+        free(job->line);
+        job->line = NULL;
+        job->id = 0;
+        return ESP_ERR_NO_MEM;
+    }
+    *job_id = job->id;
+    return ESP_OK;
+}
+
+esp_err_t esp_console_job_status(int job_id, esp_console_job_state_t *state, int *cmd_ret)
+{
+    esp_err_t err = ESP_ERR_NOT_FOUND;
+    portENTER_CRITICAL(&s_job_lock);
+    for (int i = 0; i < CONSOLE_JOB_COUNT; ++i) {
+        if (s_jobs[i].id == job_id && job_id != 0) {
+            if (state != NULL) {
+                *state = s_jobs[i].state;
+            }
+            if (cmd_ret != NULL && s_jobs[i].state == ESP_CONSOLE_JOB_DONE) {
+                *cmd_ret = s_jobs[i].ret;
+            }
+            err = ESP_OK;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_job_lock);
+    return err;
+}
+
+esp_err_t esp_console_job_cancel(int job_id)
+{
+    esp_err_t err = ESP_ERR_NOT_FOUND;
+    TaskHandle_t task = NULL;
+    portENTER_CRITICAL(&s_job_lock);
+    for (int i = 0; i < CONSOLE_JOB_COUNT; ++i) {
+        if (s_jobs[i].id == job_id && job_id != 0) {
+            if (s_jobs[i].state != ESP_CONSOLE_JOB_RUNNING) {
+                err = ESP_ERR_INVALID_STATE;
+                break;
+            }
+            task = s_jobs[i].task;
+            s_jobs[i].task = NULL;
+            s_jobs[i].state = ESP_CONSOLE_JOB_DONE;
+            s_jobs[i].ret = -1;
+            err = ESP_OK;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_job_lock);
+    if (task != NULL) {
+        vTaskDelete(task);
+    }
+    return err;
+}
+
 esp_err_t esp_console_run(const char *cmdline, int *cmd_ret)
 {
     if (s_tmp_line_buf == NULL) {
@@ -212,11 +356,49 @@ esp_err_t esp_console_run(const char *cmdline, int *cmd_ret)
         free(argv);
         return ESP_ERR_NOT_FOUND;
     }
+    if (cmd->flags & ESP_CONSOLE_CMD_FLAG_ASYNC) {
+        int job_id;
+        esp_err_t err = console_job_start(cmd, cmdline, &job_id);
+        if (err == ESP_OK) {
+            printf("Started background job %d\n", job_id);
+            *cmd_ret = 0;
+        } else {
+            printf("Job table full, command not started\n");
+        }
+        free(argv);
+        return err;
+    }
     *cmd_ret = (*cmd->func)(argc, argv);
     free(argv);
     return ESP_OK;
 }
 
+esp_err_t esp_console_run_multiple(const char *buffer, int *cmd_ret)
+{
+    char *copy = strdup(buffer);
+    if (copy == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    esp_err_t err = ESP_OK;
+    char *save_ptr = NULL;
+    for (char *line = strtok_r(copy, "\r\n", &save_ptr);
+            line != NULL;
+            line = strtok_r(NULL, "\r\n", &save_ptr)) {
+        while (*line == ' ' || *line == '\t') {
+            ++line;
+        }
+        if (*line == '\0' || *line == '#') {
+            continue;
+        }
+        err = esp_console_run(line, cmd_ret);
+        if (err != ESP_OK) {
+            break;
+        }
+    }
+    free(copy);
+    return err;
+}
+
 static int help_command(int argc, char **argv)
 {
     cmd_item_t *it;
@@ -255,3 +437,61 @@ esp_err_t esp_console_register_help_command(void)
     };
     return esp_console_cmd_register(&command);
 }
+
+static int jobs_command(int argc, char **argv)
+{
+    // snapshot under the lock, print outside of it (printf may block)
+    console_job_t jobs[CONSOLE_JOB_COUNT];
+    portENTER_CRITICAL(&s_job_lock);
+    memcpy(jobs, s_jobs, sizeof(jobs));
+    portEXIT_CRITICAL(&s_job_lock);
+    for (int i = 0; i < CONSOLE_JOB_COUNT; ++i) {
+        if (jobs[i].id == 0) {
+            continue;
+        }
+        if (jobs[i].state == ESP_CONSOLE_JOB_RUNNING) {
+            printf("[%d] running  %s\n", jobs[i].id, jobs[i].line);
+        } else {
+            printf("[%d] done (%d)  %s\n", jobs[i].id, jobs[i].ret, jobs[i].line);
+        }
+    }
+    return 0;
+}
+
+static int kill_command(int argc, char **argv)
+{
+    if (argc != 2) {
+        printf("Usage: kill <job>\n");
+        return 1;
+    }
+    int job_id = atoi(argv[1]);
+    esp_err_t err = esp_console_job_cancel(job_id);
+    if (err == ESP_ERR_NOT_FOUND) {
+        printf("No such job: %d\n", job_id);
+        return 1;
+    } else if (err == ESP_ERR_INVALID_STATE) {
+        printf("Job %d has already finished\n", job_id);
+        return 1;
+    }
+    return 0;
+}
+
+esp_err_t esp_console_register_job_commands(void)
+{
+    const esp_console_cmd_t jobs_cmd = {
+        .command = "jobs",
+        .help = "List background command jobs",
+        .func = &jobs_command
+    };
+    esp_err_t err = esp_console_cmd_register(&jobs_cmd);
+    if (err != ESP_OK) {
+        return err;
+    }
+    const esp_console_cmd_t kill_cmd = {
+        .command = "kill",
+        .help = "Cancel a running background job",
+        .hint = "<job>",
+        .func = &kill_command
+    };
+    return esp_console_cmd_register(&kill_cmd);
+}
@@ -175,8 +175,23 @@ typedef struct {
      * Only used for the duration of esp_console_cmd_register call.
      */
     void *argtable;
+    /**
+     * Combination of ESP_CONSOLE_CMD_FLAG_* values, 0 for default behavior.
+     */
+    uint32_t flags;
 } esp_console_cmd_t;
 
+/**
+ * @brief Run the command in a background job task instead of the caller
+ *
+ * esp_console_run starts a job and returns immediately, so the REPL stays
+ * responsive while the command executes. Use this for long-running
+ * diagnostic commands. Job state can be queried and jobs can be cancelled
+ * with esp_console_job_status/esp_console_job_cancel, or interactively with
+ * the commands registered by esp_console_register_job_commands.
+ */
+#define ESP_CONSOLE_CMD_FLAG_ASYNC (1 << 0)
+
 /**
  * @brief Register console command
  * @param cmd pointer to the command description; can point to a temporary value
@@ -200,6 +215,66 @@ esp_err_t esp_console_cmd_register(const esp_console_cmd_t *cmd);
  */
 esp_err_t esp_console_run(const char *cmdline, int *cmd_ret);
 
+/**
+ * @brief Run multiple command lines from one buffer
+ *
+ * Runs each line of the buffer (separated by '\n' or '\r') in order, as if
+ * entered into the REPL one by one. Empty lines and lines starting with '#'
+ * are skipped. This is intended for pasted command batches and small
+ * scripts, where going through the line editor for every line would be slow.
+ *
+ * @param buffer zero-terminated buffer with one command per line
+ * @param[out] cmd_ret return code of the last executed command (set if at least
+ *             one command was run)
+ * @return
+ *      - ESP_OK, if all non-empty lines were run
+ *      - ESP_ERR_NO_MEM, if the buffer copy could not be allocated
+ *      - the esp_console_run error of the first line that failed to run
+ */
+esp_err_t esp_console_run_multiple(const char *buffer, int *cmd_ret);
+
+/**
+ * @brief State of a background command job
+ */
+typedef enum {
+    ESP_CONSOLE_JOB_RUNNING,    //!< job task is still executing the command
+    ESP_CONSOLE_JOB_DONE,       //!< command returned; return code is available
+} esp_console_job_state_t;
+
+/**
+ * @brief Query a background command job
+ *
+ * Finished jobs stay queryable until their slot is reused by a new job.
+ *
+ * @param job_id job identifier printed when the job was started
+ * @param[out] state job state, may be NULL
+ * @param[out] cmd_ret command return code, valid when the job is done, may be NULL
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if no such job
+ */
+esp_err_t esp_console_job_status(int job_id, esp_console_job_state_t *state, int *cmd_ret);
+
+/**
+ * @brief Cancel a running background command job
+ *
+ * The job task is deleted forcefully; resources allocated by the command
+ * itself (heap, locks) are not released, so cancellation is meant for
+ * commands known to be safe to kill (polling diagnostics and the like).
+ *
+ * @param job_id job identifier printed when the job was started
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NOT_FOUND if no such job
+ *      - ESP_ERR_INVALID_STATE if the job has already finished
+ */
+esp_err_t esp_console_job_cancel(int job_id);
+
+/**
+ * @brief Register 'jobs' and 'kill' commands for interactive job control
+ *
+ * @return ESP_OK on success, ESP_ERR_NO_MEM if out of memory
+ */
+esp_err_t esp_console_register_job_commands(void);
+
 /**
  * @brief Split command line into arguments in place
  * @verbatim
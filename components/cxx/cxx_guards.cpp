@@ -98,7 +98,7 @@ static void wait_for_guard_obj(guard_t* g)
         /* Semaphore may have been given because some other guard object became ready.
          * Check the guard object we need and wait again if it is still pending.
          */
-    } while(g->pending);
+    } while(__atomic_load_n(&g->pending, __ATOMIC_ACQUIRE));
     s_static_init_waiting_count--;
 }
 
@@ -129,46 +129,75 @@ extern "C" int __cxa_guard_acquire(__guard* pg)
              */
             abort();
         }
-    } else {
-        if (s_static_init_mutex == NULL) {
-            static_init_prepare();
+        if (g->ready) {
+            return 0;
         }
+        g->pending = 1;
+        return 1;
+    }
 
-        /* We don't need to use double-checked locking pattern here, as the compiler
-         * must generate code to check if the first byte of *pg is non-zero, before
-         * calling __cxa_guard_acquire.
+    /* Uncontended fast path: claim the pending byte of the guard object
+     * itself with one atomic compare-and-swap, without creating or taking
+     * the global mutex. The compiler has already checked the ready byte
+     * inline before calling us (double-checked pattern per the ABI).
+     */
+    uint8_t expected = 0;
+    if (__atomic_compare_exchange_n(&g->pending, &expected, 1, false,
+                                    __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        if (__atomic_load_n(&g->ready, __ATOMIC_ACQUIRE) == 0) {
+            /* Claimed; current task can start doing static initialization */
+            return 1;
+        }
+        /* Initialization completed between the compiler's inline check of
+         * the ready byte and the CAS above. Undo the claim under the mutex
+         * so that any task which just saw pending == 1 gets woken up.
          */
+        if (s_static_init_mutex == NULL) {
+            static_init_prepare();
+        }
         auto result = xSemaphoreTake(s_static_init_mutex, portMAX_DELAY);
         assert(result);
-        if (g->pending) {
-            /* Another task is doing initialization at the moment; wait until it calls
-             * __cxa_guard_release or __cxa_guard_abort
-             */
-            wait_for_guard_obj(g);
-            /* At this point there are two scenarios:
-             * - the task which was doing static initialization has called __cxa_guard_release,
-             *   which means that g->ready is set. We need to return 0.
-             * - the task which was doing static initialization has called __cxa_guard_abort,
-             *   which means that g->ready is not set; we should acquire the guard and return 1,
-             *   same as for the case if we didn't have to wait.
-             * Note: actually the second scenario is unlikely to occur in the current
+        __atomic_store_n(&g->pending, 0, __ATOMIC_RELEASE);
+        signal_waiting_tasks();
+        result = xSemaphoreGive(s_static_init_mutex);
+        assert(result);
+        return 0;
+    }
+
+    /* Guard is pending: another task is doing initialization at the moment,
+     * take the slow path through the global mutex.
+     */
+    if (s_static_init_mutex == NULL) {
+        static_init_prepare();
+    }
+    auto result = xSemaphoreTake(s_static_init_mutex, portMAX_DELAY);
+    assert(result);
+    int ret;
+    while (true) {
+        if (__atomic_load_n(&g->ready, __ATOMIC_ACQUIRE)) {
+            /* Static initialization has been done by another task; nothing to do here */
+            ret = 0;
+            break;
+        }
+        expected = 0;
+        if (__atomic_compare_exchange_n(&g->pending, &expected, 1, false,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            /* The initializing task called __cxa_guard_abort; it is our
+             * turn to do the initialization, same as if we hadn't waited.
+             * Note: this scenario is unlikely to occur in the current
              * configuration because exception support is disabled.
              */
+            ret = 1;
+            break;
         }
+        /* Wait until the initializing task calls __cxa_guard_release or
+         * __cxa_guard_abort, then re-evaluate. The CAS may also lose to a
+         * task on the fast path which claimed the guard without the mutex.
+         */
+        wait_for_guard_obj(g);
     }
-    int ret;
-    if (g->ready) {
-        /* Static initialization has been done by another task; nothing to do here */
-        ret = 0;
-    } else {
-        /* Current task can start doing static initialization */
-        g->pending = 1;
-        ret = 1;
-    }
-    if (scheduler_started) {
-        auto result = xSemaphoreGive(s_static_init_mutex);
-        assert(result);
-    }
+    result = xSemaphoreGive(s_static_init_mutex);
+    assert(result);
     return ret;
 }
 
@@ -177,13 +206,21 @@ extern "C" void __cxa_guard_release(__guard* pg)
     guard_t* g = reinterpret_cast<guard_t*>(pg);
     const auto scheduler_started = xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED;
     if (scheduler_started) {
+        if (s_static_init_mutex == NULL) {
+            /* Guard was claimed on the mutex-less fast path */
+            static_init_prepare();
+        }
         auto result = xSemaphoreTake(s_static_init_mutex, portMAX_DELAY);
         assert(result);
     }
     assert(g->pending && "tried to release a guard which wasn't acquired");
-    g->pending = 0;
-    /* Initialization was successful */
-    g->ready = 1;
+    /* Initialization was successful. The ready byte must become visible
+     * before the pending byte is cleared, so that a task claiming the
+     * freed pending byte on the fast path observes ready == 1 and does
+     * not re-run the initialization.
+     */
+    __atomic_store_n(&g->ready, 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&g->pending, 0, __ATOMIC_RELEASE);
     if (scheduler_started) {
         /* Unblock the tasks waiting for static initialization to complete */
         signal_waiting_tasks();
@@ -197,12 +234,16 @@ extern "C" void __cxa_guard_abort(__guard* pg)
     guard_t* g = reinterpret_cast<guard_t*>(pg);
     const auto scheduler_started = xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED;
     if (scheduler_started) {
+        if (s_static_init_mutex == NULL) {
+            /* Guard was claimed on the mutex-less fast path */
+            static_init_prepare();
+        }
         auto result = xSemaphoreTake(s_static_init_mutex, portMAX_DELAY);
         assert(result);
     }
     assert(!g->ready && "tried to abort a guard which is ready");
     assert(g->pending && "tried to release a guard which is not acquired");
-    g->pending = 0;
+    __atomic_store_n(&g->pending, 0, __ATOMIC_RELEASE);
     if (scheduler_started) {
         /* Unblock the tasks waiting for static initialization to complete */
         signal_waiting_tasks();
@@ -26,6 +26,7 @@
 #include "hal/cpu_hal.h"
 #include "hal/cpu_ll.h"
 #include "driver/periph_ctrl.h"
+#include "esp_clk.h"
 #include "esp_rom_gpio.h"
 #include "freertos/FreeRTOS.h"
 #if SOC_DEDICATED_GPIO_SUPPORTED
@@ -359,6 +360,48 @@ void dedic_gpio_bundle_write(dedic_gpio_bundle_handle_t bundle, uint32_t mask, u
     cpu_ll_write_dedic_gpio_mask(bundle->out_mask & (mask << bundle->out_offset), value << bundle->out_offset);
 }
 
+// Cycles consumed by one iteration of the playback loop (write + pacing),
+// used to reject sample rates which the loop can not sustain
+#define DEDIC_GPIO_PATTERN_MIN_CYCLES_PER_SAMPLE (16)
+
+esp_err_t dedic_gpio_bundle_write_pattern(dedic_gpio_bundle_handle_t bundle, const dedic_gpio_pattern_config_t *config)
+{
+    esp_err_t ret_code = ESP_OK;
+    DEDIC_CHECK(bundle && config, "invalid argument", err, ESP_ERR_INVALID_ARG);
+    DEDIC_CHECK(config->pattern && config->sample_count > 0, "invalid pattern or sample count", err, ESP_ERR_INVALID_ARG);
+    DEDIC_CHECK(bundle->out_mask, "bundle has no output channel", err, ESP_ERR_INVALID_ARG);
+    uint32_t core_id = cpu_hal_get_core_id();
+    DEDIC_CHECK(core_id == bundle->core_id, "play pattern on wrong CPU", err, ESP_ERR_INVALID_ARG);
+    uint32_t cpu_freq_hz = esp_clk_cpu_freq();
+    DEDIC_CHECK(config->sample_rate_hz > 0 &&
+                config->sample_rate_hz <= cpu_freq_hz / DEDIC_GPIO_PATTERN_MIN_CYCLES_PER_SAMPLE,
+                "sample rate out of range", err, ESP_ERR_INVALID_ARG);
+
+    const uint32_t cycles_per_sample = cpu_freq_hz / config->sample_rate_hz;
+    const uint32_t out_mask = bundle->out_mask;
+    const uint32_t out_offset = bundle->out_offset;
+    const uint32_t *sample = config->pattern;
+    size_t remaining = config->sample_count;
+
+    if (config->flags.in_critical) {
+        portENTER_CRITICAL(&s_platform[core_id]->spinlock);
+    }
+    uint32_t deadline = cpu_ll_get_cycle_count();
+    while (remaining--) {
+        cpu_ll_write_dedic_gpio_mask(out_mask, (*sample++) << out_offset);
+        deadline += cycles_per_sample;
+        // signed comparison, so that cycle counter wrap around is handled
+        while ((int32_t)(cpu_ll_get_cycle_count() - deadline) < 0) {
+        }
+    }
+    if (config->flags.in_critical) {
+        portEXIT_CRITICAL(&s_platform[core_id]->spinlock);
+    }
+
+err:
+    return ret_code;
+}
+
 uint32_t dedic_gpio_bundle_read_out(dedic_gpio_bundle_handle_t bundle)
 {
     // For performace reasons, we don't want to check the validation of parameters here
@@ -0,0 +1,205 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "driver/i2s.h"
+#include "driver/adc.h"
+#include "driver/adc_continuous.h"
+
+static const char *ADC_CONT_TAG = "ADC_CONT";
+
+#define ADC_CONT_CHECK(a, str, ret_val) ({                                          \
+    if (!(a)) {                                                                     \
+        ESP_LOGE(ADC_CONT_TAG,"%s(%d): %s", __FUNCTION__, __LINE__, str);           \
+        return (ret_val);                                                           \
+    }                                                                               \
+})
+
+// The ESP32 digital controller feeds ADC data through I2S0 DMA
+#define ADC_CONT_I2S_PORT        (I2S_NUM_0)
+#define ADC_CONT_DMA_BUF_COUNT   (4)
+#define ADC_CONT_DMA_BUF_LEN_MAX (1024)
+#define ADC_CONT_TASK_STACK_SIZE (3072)
+
+// Data from the digital controller carries the channel number in the top
+// four bits of each 16-bit sample; the conversion result is the low 12 bits
+#define ADC_CONT_SAMPLE_MASK     (0x0FFF)
+
+typedef struct {
+    adc_continuous_config_t cfg;
+    uint16_t *raw_buf;          // block of raw samples read from I2S DMA
+    uint16_t *out_buf;          // filtered samples handed to the callback
+    int32_t iir_state;          // IIR filter accumulator, -1 when not seeded yet
+    TaskHandle_t task;
+    xSemaphoreHandle exit_sem;  // given by the capture task right before it exits
+    volatile bool run;
+} adc_continuous_obj_t;
+
+static adc_continuous_obj_t *s_adc_cont;
+
+static size_t adc_continuous_apply_filter(adc_continuous_obj_t *obj, size_t sample_count)
+{
+    const adc_continuous_config_t *cfg = &obj->cfg;
+    switch (cfg->filter_type) {
+    case ADC_CONTINUOUS_FILTER_IIR:
+        for (size_t i = 0; i < sample_count; i++) {
+            int32_t x = obj->raw_buf[i] & ADC_CONT_SAMPLE_MASK;
+            if (obj->iir_state < 0) {
+                obj->iir_state = x; // seed the filter with the first sample
+            } else {
+                obj->iir_state += (x - obj->iir_state) >> cfg->filter_arg;
+            }
+            obj->out_buf[i] = obj->iir_state;
+        }
+        return sample_count;
+    case ADC_CONTINUOUS_FILTER_AVERAGE: {
+        size_t out = 0;
+        for (size_t i = 0; i < sample_count; i += cfg->filter_arg) {
+            uint32_t sum = 0;
+            for (size_t j = 0; j < cfg->filter_arg; j++) {
+                sum += obj->raw_buf[i + j] & ADC_CONT_SAMPLE_MASK;
+            }
+            obj->out_buf[out++] = sum / cfg->filter_arg;
+        }
+        return out;
+    }
+    case ADC_CONTINUOUS_FILTER_NONE:
+    default:
+        for (size_t i = 0; i < sample_count; i++) {
+            obj->out_buf[i] = obj->raw_buf[i] & ADC_CONT_SAMPLE_MASK;
+        }
+        return sample_count;
+    }
+}
+
+static void adc_continuous_task(void *arg)
+{
+    adc_continuous_obj_t *obj = (adc_continuous_obj_t *)arg;
+    const size_t block_bytes = obj->cfg.samples_per_block * sizeof(uint16_t);
+    while (obj->run) {
+        size_t bytes_read = 0;
+        esp_err_t err = i2s_read(ADC_CONT_I2S_PORT, obj->raw_buf, block_bytes,
+                &bytes_read, portMAX_DELAY);
+        if (err != ESP_OK || bytes_read == 0) {
+            continue;
+        }
+        size_t out_count = adc_continuous_apply_filter(obj, bytes_read / sizeof(uint16_t));
+        if (obj->run) {
+            obj->cfg.callback(obj->out_buf, out_count, obj->cfg.callback_arg);
+        }
+    }
+    xSemaphoreGive(obj->exit_sem);
+    vTaskDelete(NULL);
+}
+
+esp_err_t adc_continuous_start(const adc_continuous_config_t *config)
+{
+    ADC_CONT_CHECK(config, "config is NULL", ESP_ERR_INVALID_ARG);
+    ADC_CONT_CHECK(config->callback, "callback is NULL", ESP_ERR_INVALID_ARG);
+    ADC_CONT_CHECK(config->adc_unit == ADC_UNIT_1, "only ADC1 supports the digital controller", ESP_ERR_INVALID_ARG);
+    ADC_CONT_CHECK(config->channel < ADC1_CHANNEL_MAX, "ADC1 channel error", ESP_ERR_INVALID_ARG);
+    ADC_CONT_CHECK(config->sample_rate_hz > 0, "sample rate error", ESP_ERR_INVALID_ARG);
+    ADC_CONT_CHECK(config->samples_per_block > 0, "samples per block error", ESP_ERR_INVALID_ARG);
+    if (config->filter_type == ADC_CONTINUOUS_FILTER_IIR) {
+        ADC_CONT_CHECK(config->filter_arg >= 1 && config->filter_arg <= 15, "IIR shift out of range", ESP_ERR_INVALID_ARG);
+    } else if (config->filter_type == ADC_CONTINUOUS_FILTER_AVERAGE) {
+        ADC_CONT_CHECK(config->filter_arg > 0 && config->samples_per_block % config->filter_arg == 0,
+                "average length must divide samples per block", ESP_ERR_INVALID_ARG);
+    }
+    ADC_CONT_CHECK(s_adc_cont == NULL, "continuous capture already running", ESP_ERR_INVALID_STATE);
+
+    adc_continuous_obj_t *obj = calloc(1, sizeof(adc_continuous_obj_t));
+    ADC_CONT_CHECK(obj, "no mem for capture object", ESP_ERR_NO_MEM);
+    obj->cfg = *config;
+    obj->iir_state = -1;
+    obj->raw_buf = malloc(config->samples_per_block * sizeof(uint16_t));
+    obj->out_buf = malloc(config->samples_per_block * sizeof(uint16_t));
+    obj->exit_sem = xSemaphoreCreateBinary();
+    esp_err_t err = ESP_ERR_NO_MEM;
+    if (!obj->raw_buf || !obj->out_buf || !obj->exit_sem) {
+        goto cleanup;
+    }
+
+    size_t dma_buf_len = config->samples_per_block;
+    if (dma_buf_len > ADC_CONT_DMA_BUF_LEN_MAX) {
+        dma_buf_len = ADC_CONT_DMA_BUF_LEN_MAX;
+    }
+    i2s_config_t i2s_config = {
+        .mode = I2S_MODE_MASTER | I2S_MODE_RX | I2S_MODE_ADC_BUILT_IN,
+        .sample_rate = config->sample_rate_hz,
+        .bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT,
+        .channel_format = I2S_CHANNEL_FMT_ONLY_LEFT,
+        .communication_format = I2S_COMM_FORMAT_STAND_MSB,
+        .intr_alloc_flags = 0,
+        .dma_buf_count = ADC_CONT_DMA_BUF_COUNT,
+        .dma_buf_len = dma_buf_len,
+    };
+    err = i2s_driver_install(ADC_CONT_I2S_PORT, &i2s_config, 0, NULL);
+    if (err != ESP_OK) {
+        ESP_LOGE(ADC_CONT_TAG, "i2s_driver_install failed (0x%x)", err);
+        goto cleanup;
+    }
+    err = i2s_set_adc_mode(config->adc_unit, config->channel);
+    if (err != ESP_OK) {
+        goto cleanup_i2s;
+    }
+    err = i2s_adc_enable(ADC_CONT_I2S_PORT);
+    if (err != ESP_OK) {
+        goto cleanup_i2s;
+    }
+
+    obj->run = true;
+    if (xTaskCreate(adc_continuous_task, "adc_cont", ADC_CONT_TASK_STACK_SIZE,
+            obj, config->task_priority, &obj->task) != pdPASS) {
+        i2s_adc_disable(ADC_CONT_I2S_PORT);
+        err = ESP_ERR_NO_MEM;
+        goto cleanup_i2s;
+    }
+    s_adc_cont = obj;
+    return ESP_OK;
+
+cleanup_i2s:
+    i2s_driver_uninstall(ADC_CONT_I2S_PORT);
+cleanup:
+    if (obj->exit_sem) {
+        vSemaphoreDelete(obj->exit_sem);
+    }
+    free(obj->raw_buf);
+    free(obj->out_buf);
+    free(obj);
+    return err;
+}
+
+esp_err_t adc_continuous_stop(void)
+{
+    ADC_CONT_CHECK(s_adc_cont, "continuous capture not running", ESP_ERR_INVALID_STATE);
+    adc_continuous_obj_t *obj = s_adc_cont;
+    // ask the task to exit; samples keep flowing, so the pending i2s_read
+    // completes and the run flag is observed
+    obj->run = false;
+    xSemaphoreTake(obj->exit_sem, portMAX_DELAY);
+    i2s_adc_disable(ADC_CONT_I2S_PORT);
+    i2s_driver_uninstall(ADC_CONT_I2S_PORT);
+    vSemaphoreDelete(obj->exit_sem);
+    free(obj->raw_buf);
+    free(obj->out_buf);
+    free(obj);
+    s_adc_cont = NULL;
+    return ESP_OK;
+}
@@ -0,0 +1,96 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "driver/adc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Filter applied to captured samples before delivery
+ */
+typedef enum {
+    ADC_CONTINUOUS_FILTER_NONE,    /*!< Deliver raw 12-bit samples */
+    ADC_CONTINUOUS_FILTER_IIR,     /*!< First order IIR low pass: y += (x - y) >> filter_arg */
+    ADC_CONTINUOUS_FILTER_AVERAGE, /*!< Average filter_arg consecutive samples into one output sample */
+} adc_continuous_filter_type_t;
+
+/**
+ * @brief Callback delivering one block of captured samples
+ *
+ * Called from the capture task for every completed block. Samples are 12-bit
+ * ADC values in the lower bits of each element.
+ *
+ * @param samples Pointer to the sample block; only valid during the callback
+ * @param sample_count Number of samples in the block
+ * @param arg User argument passed in adc_continuous_config_t
+ */
+typedef void (*adc_continuous_callback_t)(const uint16_t *samples, size_t sample_count, void *arg);
+
+/**
+ * @brief Configuration of continuous ADC capture
+ */
+typedef struct {
+    adc_unit_t adc_unit;        /*!< ADC unit, only ADC_UNIT_1 is supported for now */
+    adc1_channel_t channel;     /*!< ADC channel to sample */
+    uint32_t sample_rate_hz;    /*!< Sample rate of the digital controller, in Hz */
+    size_t samples_per_block;   /*!< Number of raw samples captured per block */
+    adc_continuous_filter_type_t filter_type; /*!< Filter applied before delivery */
+    uint32_t filter_arg;        /*!< IIR: right shift amount (1-15); AVERAGE: number of samples
+                                     averaged per output sample, must divide samples_per_block */
+    adc_continuous_callback_t callback; /*!< Callback invoked for every captured block */
+    void *callback_arg;         /*!< User argument passed to the callback */
+    UBaseType_t task_priority;  /*!< Priority of the capture task */
+} adc_continuous_config_t;
+
+/**
+ * @brief Start continuous ADC capture
+ *
+ * Routes ADC1 into the I2S0 digital controller and captures samples to DMA
+ * buffers in the background. A driver task reads completed DMA blocks, applies
+ * the configured filter and hands the samples to the callback, so high rate
+ * capture runs without per-sample CPU involvement or timer jitter.
+ *
+ * The attenuation of the sampled channel should be configured beforehand with
+ * adc1_config_channel_atten(). I2S0 is occupied while capture is running.
+ *
+ * @param config Capture configuration
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if the configuration is invalid
+ *     - ESP_ERR_INVALID_STATE if capture is already running
+ *     - ESP_ERR_NO_MEM if buffers or the capture task can not be allocated
+ */
+esp_err_t adc_continuous_start(const adc_continuous_config_t *config);
+
+/**
+ * @brief Stop continuous ADC capture and release I2S0
+ *
+ * Blocks until the capture task has exited; the callback is not invoked
+ * after this function returns.
+ *
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_STATE if capture is not running
+ */
+esp_err_t adc_continuous_stop(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <esp_types.h>
+#include <string.h>
 #include "esp_err.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/xtensa_api.h"
@@ -78,6 +79,12 @@ static gpio_context_t gpio_context = {
     .gpio_isr_func = NULL,
 };
 
+//Handlers registered with gpio_isr_priority_handler_add(). Kept in a static
+//DRAM table so the dispatch path does not go through the heap allocated
+//service table, and dispatched ahead of the regular per-pin handlers
+static DRAM_ATTR gpio_isr_func_t gpio_isr_priority_func[GPIO_NUM_MAX];
+static DRAM_ATTR uint32_t gpio_isr_priority_mask[2];
+
 esp_err_t gpio_pullup_en(gpio_num_t gpio_num)
 {
     GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
@@ -411,6 +418,17 @@ static inline void IRAM_ATTR gpio_isr_loop(uint32_t status, const uint32_t gpio_
     }
 }
 
+static inline void IRAM_ATTR gpio_isr_priority_loop(uint32_t status, const uint32_t gpio_num_start)
+{
+    //The mask guarantees that every set bit has a registered handler
+    while (status) {
+        int nbit = __builtin_ffs(status) - 1;
+        status &= ~(1 << nbit);
+        int gpio_num = gpio_num_start + nbit;
+        gpio_isr_priority_func[gpio_num].fn(gpio_isr_priority_func[gpio_num].args);
+    }
+}
+
 static void IRAM_ATTR gpio_intr_service(void *arg)
 {
     //GPIO intr process
@@ -422,17 +440,25 @@ static void IRAM_ATTR gpio_intr_service(void *arg)
     uint32_t gpio_intr_status;
     gpio_hal_get_intr_status(gpio_context.gpio_hal, gpio_context.isr_core_id, &gpio_intr_status);
 
-    if (gpio_intr_status) {
-        gpio_isr_loop(gpio_intr_status, 0);
-        gpio_hal_clear_intr_status(gpio_context.gpio_hal, gpio_intr_status);
-    }
-
     //read status1 to get interrupt status for GPIO32-39
     uint32_t gpio_intr_status_h;
     gpio_hal_get_intr_status_high(gpio_context.gpio_hal, gpio_context.isr_core_id, &gpio_intr_status_h);
 
+    //Dispatch priority handlers first, ahead of the regular per-pin handlers
+    if (gpio_intr_status & gpio_isr_priority_mask[0]) {
+        gpio_isr_priority_loop(gpio_intr_status & gpio_isr_priority_mask[0], 0);
+    }
+    if (gpio_intr_status_h & gpio_isr_priority_mask[1]) {
+        gpio_isr_priority_loop(gpio_intr_status_h & gpio_isr_priority_mask[1], 32);
+    }
+
+    if (gpio_intr_status) {
+        gpio_isr_loop(gpio_intr_status & ~gpio_isr_priority_mask[0], 0);
+        gpio_hal_clear_intr_status(gpio_context.gpio_hal, gpio_intr_status);
+    }
+
     if (gpio_intr_status_h) {
-        gpio_isr_loop(gpio_intr_status_h, 32);
+        gpio_isr_loop(gpio_intr_status_h & ~gpio_isr_priority_mask[1], 32);
         gpio_hal_clear_intr_status_high(gpio_context.gpio_hal, gpio_intr_status_h);
     }
 }
@@ -482,6 +508,35 @@ esp_err_t gpio_isr_handler_remove(gpio_num_t gpio_num)
     return ESP_OK;
 }
 
+esp_err_t gpio_isr_priority_handler_add(gpio_num_t gpio_num, gpio_isr_t isr_handler, void *args)
+{
+    GPIO_CHECK(gpio_context.gpio_isr_func != NULL, "GPIO isr service is not installed, call gpio_install_isr_service() first", ESP_ERR_INVALID_STATE);
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(isr_handler != NULL, "GPIO isr handler null", ESP_ERR_INVALID_ARG);
+    portENTER_CRITICAL(&gpio_context.gpio_spinlock);
+    gpio_intr_disable(gpio_num);
+    gpio_isr_priority_func[gpio_num].fn = isr_handler;
+    gpio_isr_priority_func[gpio_num].args = args;
+    //Set the mask bit last so the dispatcher only sees complete entries
+    gpio_isr_priority_mask[gpio_num / 32] |= (1 << (gpio_num % 32));
+    gpio_intr_enable_on_core (gpio_num, esp_intr_get_cpu(gpio_context.gpio_isr_handle));
+    portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_priority_handler_remove(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(gpio_context.gpio_isr_func != NULL, "GPIO isr service is not installed, call gpio_install_isr_service() first", ESP_ERR_INVALID_STATE);
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    portENTER_CRITICAL(&gpio_context.gpio_spinlock);
+    gpio_intr_disable(gpio_num);
+    gpio_isr_priority_mask[gpio_num / 32] &= ~(1 << (gpio_num % 32));
+    gpio_isr_priority_func[gpio_num].fn = NULL;
+    gpio_isr_priority_func[gpio_num].args = NULL;
+    portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
+    return ESP_OK;
+}
+
 void gpio_uninstall_isr_service(void)
 {
     if (gpio_context.gpio_isr_func == NULL) {
@@ -492,6 +547,8 @@ void gpio_uninstall_isr_service(void)
     free(gpio_context.gpio_isr_func);
     gpio_context.gpio_isr_func = NULL;
     gpio_context.isr_core_id = GPIO_ISR_CORE_ID_UNINIT;
+    memset(gpio_isr_priority_mask, 0, sizeof(gpio_isr_priority_mask));
+    memset(gpio_isr_priority_func, 0, sizeof(gpio_isr_priority_func));
     portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
     return;
 }
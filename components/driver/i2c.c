@@ -103,6 +103,8 @@ typedef struct {
     i2c_hw_cmd_t hw_cmd;
     uint8_t *data;     /*!< data address */
     uint8_t byte_cmd;  /*!< to save cmd for one byte command mode */
+    uint8_t *data_origin;    /*!< data address as encoded, the command processor advances `data` in place */
+    uint8_t byte_num_origin; /*!< byte count as encoded, to rewind the link for resubmission */
 } i2c_cmd_t;
 
 typedef struct i2c_cmd_link {
@@ -140,6 +142,9 @@ typedef struct {
 
     i2c_cmd_desc_t cmd_link;         /*!< I2C command link */
     QueueHandle_t cmd_evt_queue;     /*!< I2C command event queue */
+    QueueHandle_t trans_queue;       /*!< I2C async transaction queue, NULL when async mode is off */
+    TaskHandle_t trans_task;         /*!< Task draining trans_queue and running the completion callbacks */
+    xSemaphoreHandle trans_task_exit_sem; /*!< Given by the transaction task right before it deletes itself */
 #if CONFIG_SPIRAM_USE_MALLOC
     uint8_t *evt_queue_storage;      /*!< The buffer that will hold the items in the queue */
     int intr_alloc_flags;            /*!< Used to allocate the interrupt */
@@ -394,6 +399,9 @@ esp_err_t i2c_driver_delete(i2c_port_t i2c_num)
     I2C_CHECK(p_i2c_obj[i2c_num] != NULL, I2C_DRIVER_ERR_STR, ESP_FAIL);
 
     i2c_obj_t *p_i2c = p_i2c_obj[i2c_num];
+    if (p_i2c->trans_queue) {
+        i2c_master_async_queue_deinit(i2c_num);
+    }
     i2c_hal_disable_intr_mask(&(i2c_context[i2c_num].hal), I2C_LL_INTR_MASK);
     esp_intr_free(p_i2c->intr_handle);
     p_i2c->intr_handle = NULL;
@@ -915,6 +923,8 @@ static esp_err_t i2c_cmd_link_append(i2c_cmd_handle_t cmd_handle, i2c_cmd_t *cmd
         cmd_desc->cur = cmd_desc->cur->next;
     }
     memcpy((uint8_t *) &cmd_desc->cur->cmd, (uint8_t *) cmd, sizeof(i2c_cmd_t));
+    cmd_desc->cur->cmd.data_origin = cmd->data;
+    cmd_desc->cur->cmd.byte_num_origin = cmd->hw_cmd.byte_num;
     cmd_desc->cur->next = NULL;
     return ESP_OK;
 
@@ -922,6 +932,19 @@ err:
     return ESP_FAIL;
 }
 
+//Restore a command link to its as-encoded state. The command processor advances
+//the data pointers and byte counters of the nodes in place, so without this a
+//handle could only be sent once. Called on every submission, which makes a
+//pre-encoded handle resubmittable without being re-created.
+static void i2c_cmd_link_rewind(i2c_cmd_handle_t cmd_handle)
+{
+    i2c_cmd_desc_t *cmd = (i2c_cmd_desc_t *) cmd_handle;
+    for (i2c_cmd_link_t *it = cmd->head; it != NULL; it = it->next) {
+        it->cmd.data = it->cmd.data_origin;
+        it->cmd.hw_cmd.byte_num = it->cmd.byte_num_origin;
+    }
+}
+
 esp_err_t i2c_master_start(i2c_cmd_handle_t cmd_handle)
 {
     I2C_CHECK(cmd_handle != NULL, I2C_CMD_LINK_INIT_ERR_STR, ESP_ERR_INVALID_ARG);
@@ -1192,6 +1215,7 @@ esp_err_t i2c_master_cmd_begin(i2c_port_t i2c_num, i2c_cmd_handle_t cmd_handle,
     }
     i2c_reset_tx_fifo(i2c_num);
     i2c_reset_rx_fifo(i2c_num);
+    i2c_cmd_link_rewind(cmd_handle);
     i2c_cmd_desc_t *cmd = (i2c_cmd_desc_t *) cmd_handle;
     p_i2c->cmd_link.free = cmd->free;
     p_i2c->cmd_link.cur = cmd->cur;
@@ -1262,6 +1286,115 @@ esp_err_t i2c_master_cmd_begin(i2c_port_t i2c_num, i2c_cmd_handle_t cmd_handle,
     return ret;
 }
 
+#define I2C_TRANS_TASK_STACK_SIZE   (2048)   /*!< Stack of the async transaction task, it runs the user callbacks */
+#define I2C_TRANS_TASK_NAME_LEN     (16)
+
+typedef struct {
+    i2c_cmd_handle_t cmd_handle;     /*!< command link to execute, NULL is the queue shutdown marker */
+    i2c_master_cmd_cb_t done_cb;     /*!< completion callback, may be NULL */
+    void *cb_arg;                    /*!< user argument passed to done_cb */
+    TickType_t ticks_to_wait;        /*!< per transaction timeout */
+} i2c_async_trans_t;
+
+static void i2c_trans_task(void *arg)
+{
+    i2c_obj_t *p_i2c = (i2c_obj_t *) arg;
+    i2c_async_trans_t trans;
+    while (1) {
+        if (xQueueReceive(p_i2c->trans_queue, &trans, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        if (trans.cmd_handle == NULL) {
+            break;
+        }
+        esp_err_t err = i2c_master_cmd_begin(p_i2c->i2c_num, trans.cmd_handle, trans.ticks_to_wait);
+        if (trans.done_cb) {
+            trans.done_cb(p_i2c->i2c_num, err, trans.cb_arg);
+        }
+    }
+    xSemaphoreGive(p_i2c->trans_task_exit_sem);
+    vTaskDelete(NULL);
+}
+
+esp_err_t i2c_master_async_queue_init(i2c_port_t i2c_num, size_t queue_size, UBaseType_t task_priority)
+{
+    I2C_CHECK(i2c_num < I2C_NUM_MAX, I2C_NUM_ERROR_STR, ESP_ERR_INVALID_ARG);
+    I2C_CHECK(p_i2c_obj[i2c_num] != NULL, I2C_DRIVER_NOT_INSTALL_ERR_STR, ESP_ERR_INVALID_STATE);
+    I2C_CHECK(p_i2c_obj[i2c_num]->mode == I2C_MODE_MASTER, I2C_MASTER_MODE_ERR_STR, ESP_ERR_INVALID_STATE);
+    I2C_CHECK(p_i2c_obj[i2c_num]->trans_queue == NULL, "i2c async queue already initialized", ESP_ERR_INVALID_STATE);
+    I2C_CHECK(queue_size > 0, "i2c async queue size error", ESP_ERR_INVALID_ARG);
+
+    i2c_obj_t *p_i2c = p_i2c_obj[i2c_num];
+    p_i2c->trans_queue = xQueueCreate(queue_size, sizeof(i2c_async_trans_t));
+    p_i2c->trans_task_exit_sem = xSemaphoreCreateBinary();
+    if (p_i2c->trans_queue == NULL || p_i2c->trans_task_exit_sem == NULL) {
+        goto err;
+    }
+    char task_name[I2C_TRANS_TASK_NAME_LEN];
+    snprintf(task_name, sizeof(task_name), "i2c%d_trans", i2c_num);
+    if (xTaskCreate(i2c_trans_task, task_name, I2C_TRANS_TASK_STACK_SIZE, p_i2c,
+                    task_priority, &p_i2c->trans_task) != pdTRUE) {
+        goto err;
+    }
+    return ESP_OK;
+
+err:
+    if (p_i2c->trans_queue) {
+        vQueueDelete(p_i2c->trans_queue);
+        p_i2c->trans_queue = NULL;
+    }
+    if (p_i2c->trans_task_exit_sem) {
+        vSemaphoreDelete(p_i2c->trans_task_exit_sem);
+        p_i2c->trans_task_exit_sem = NULL;
+    }
+    return ESP_ERR_NO_MEM;
+}
+
+esp_err_t i2c_master_async_queue_deinit(i2c_port_t i2c_num)
+{
+    I2C_CHECK(i2c_num < I2C_NUM_MAX, I2C_NUM_ERROR_STR, ESP_ERR_INVALID_ARG);
+    I2C_CHECK(p_i2c_obj[i2c_num] != NULL, I2C_DRIVER_NOT_INSTALL_ERR_STR, ESP_ERR_INVALID_STATE);
+    I2C_CHECK(p_i2c_obj[i2c_num]->trans_queue != NULL, "i2c async queue not initialized", ESP_ERR_INVALID_STATE);
+
+    i2c_obj_t *p_i2c = p_i2c_obj[i2c_num];
+    //Ask the transaction task to exit once it has finished the transaction in progress.
+    i2c_async_trans_t trans = { 0 };
+    xQueueSend(p_i2c->trans_queue, &trans, portMAX_DELAY);
+    xSemaphoreTake(p_i2c->trans_task_exit_sem, portMAX_DELAY);
+    p_i2c->trans_task = NULL;
+    //Transactions queued behind the shutdown marker will not run, report them as cancelled.
+    while (xQueueReceive(p_i2c->trans_queue, &trans, 0) == pdTRUE) {
+        if (trans.cmd_handle != NULL && trans.done_cb) {
+            trans.done_cb(i2c_num, ESP_ERR_INVALID_STATE, trans.cb_arg);
+        }
+    }
+    vQueueDelete(p_i2c->trans_queue);
+    p_i2c->trans_queue = NULL;
+    vSemaphoreDelete(p_i2c->trans_task_exit_sem);
+    p_i2c->trans_task_exit_sem = NULL;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_cmd_begin_async(i2c_port_t i2c_num, i2c_cmd_handle_t cmd_handle, TickType_t ticks_to_wait,
+                                     i2c_master_cmd_cb_t done_cb, void *cb_arg)
+{
+    I2C_CHECK(i2c_num < I2C_NUM_MAX, I2C_NUM_ERROR_STR, ESP_ERR_INVALID_ARG);
+    I2C_CHECK(p_i2c_obj[i2c_num] != NULL, I2C_DRIVER_NOT_INSTALL_ERR_STR, ESP_ERR_INVALID_STATE);
+    I2C_CHECK(cmd_handle != NULL, I2C_CMD_LINK_INIT_ERR_STR, ESP_ERR_INVALID_ARG);
+    I2C_CHECK(p_i2c_obj[i2c_num]->trans_queue != NULL, "i2c async queue not initialized", ESP_ERR_INVALID_STATE);
+
+    i2c_async_trans_t trans = {
+        .cmd_handle = cmd_handle,
+        .done_cb = done_cb,
+        .cb_arg = cb_arg,
+        .ticks_to_wait = ticks_to_wait,
+    };
+    if (xQueueSend(p_i2c_obj[i2c_num]->trans_queue, &trans, 0) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    return ESP_OK;
+}
+
 int i2c_slave_write_buffer(i2c_port_t i2c_num, const uint8_t *data, int size, TickType_t ticks_to_wait)
 {
     I2C_CHECK(( i2c_num < I2C_NUM_MAX ), I2C_NUM_ERROR_STR, ESP_FAIL);
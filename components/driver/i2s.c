@@ -23,6 +23,7 @@
 #include "freertos/semphr.h"
 
 #include "soc/lldesc.h"
+#include "soc/soc_memory_layout.h"
 #include "driver/gpio.h"
 #include "driver/i2s.h"
 
@@ -71,6 +72,9 @@ typedef struct {
     SemaphoreHandle_t mux;
     xQueueHandle queue;
     lldesc_t **desc;
+    bool user_owned;                /*!< buffers are owned by the application (zero-copy mode), do not free them */
+    i2s_buffer_done_cb_t done_cb;   /*!< called from the ISR when the hardware finishes a buffer (zero-copy mode) */
+    void *done_cb_ctx;              /*!< user context passed to done_cb */
 } i2s_dma_t;
 
 /**
@@ -527,17 +531,24 @@ static void IRAM_ATTR i2s_intr_handler_default(void *arg)
 
     if ((status & I2S_INTR_OUT_EOF) && p_i2s->tx) {
         i2s_hal_get_out_eof_des_addr(&(p_i2s->hal), (uint32_t *)&finish_desc);
-        // All buffers are empty. This means we have an underflow on our hands.
-        if (xQueueIsQueueFullFromISR(p_i2s->tx->queue)) {
-            xQueueReceiveFromISR(p_i2s->tx->queue, &dummy, &high_priority_task_awoken);
-            // See if tx descriptor needs to be auto cleared:
-            // This will avoid any kind of noise that may get introduced due to transmission
-            // of previous data from tx descriptor on I2S line.
-            if (p_i2s->tx_desc_auto_clear == true) {
-                memset((void *) dummy, 0, p_i2s->tx->buf_size);
+        if (p_i2s->tx->user_owned) {
+            //zero-copy mode: hand the finished buffer back to the application instead of the internal queue
+            if (p_i2s->tx->done_cb) {
+                p_i2s->tx->done_cb(p_i2s->i2s_num, (void *)finish_desc->buf, p_i2s->tx->done_cb_ctx);
             }
+        } else {
+            // All buffers are empty. This means we have an underflow on our hands.
+            if (xQueueIsQueueFullFromISR(p_i2s->tx->queue)) {
+                xQueueReceiveFromISR(p_i2s->tx->queue, &dummy, &high_priority_task_awoken);
+                // See if tx descriptor needs to be auto cleared:
+                // This will avoid any kind of noise that may get introduced due to transmission
+                // of previous data from tx descriptor on I2S line.
+                if (p_i2s->tx_desc_auto_clear == true) {
+                    memset((void *) dummy, 0, p_i2s->tx->buf_size);
+                }
+            }
+            xQueueSendFromISR(p_i2s->tx->queue, (void*)(&finish_desc->buf), &high_priority_task_awoken);
         }
-        xQueueSendFromISR(p_i2s->tx->queue, (void*)(&finish_desc->buf), &high_priority_task_awoken);
         if (p_i2s->i2s_queue) {
             i2s_event.type = I2S_EVENT_TX_DONE;
             if (xQueueIsQueueFullFromISR(p_i2s->i2s_queue)) {
@@ -548,12 +559,19 @@ static void IRAM_ATTR i2s_intr_handler_default(void *arg)
     }
 
     if ((status & I2S_INTR_IN_SUC_EOF) && p_i2s->rx) {
-        // All buffers are full. This means we have an overflow.
         i2s_hal_get_in_eof_des_addr(&(p_i2s->hal), (uint32_t *)&finish_desc);
-        if (xQueueIsQueueFullFromISR(p_i2s->rx->queue)) {
-            xQueueReceiveFromISR(p_i2s->rx->queue, &dummy, &high_priority_task_awoken);
+        if (p_i2s->rx->user_owned) {
+            //zero-copy mode: hand the filled buffer to the application instead of the internal queue
+            if (p_i2s->rx->done_cb) {
+                p_i2s->rx->done_cb(p_i2s->i2s_num, (void *)finish_desc->buf, p_i2s->rx->done_cb_ctx);
+            }
+        } else {
+            // All buffers are full. This means we have an overflow.
+            if (xQueueIsQueueFullFromISR(p_i2s->rx->queue)) {
+                xQueueReceiveFromISR(p_i2s->rx->queue, &dummy, &high_priority_task_awoken);
+            }
+            xQueueSendFromISR(p_i2s->rx->queue, (void*)(&finish_desc->buf), &high_priority_task_awoken);
         }
-        xQueueSendFromISR(p_i2s->rx->queue, (void*)(&finish_desc->buf), &high_priority_task_awoken);
         if (p_i2s->i2s_queue) {
             i2s_event.type = I2S_EVENT_RX_DONE;
             if (p_i2s->i2s_queue && xQueueIsQueueFullFromISR(p_i2s->i2s_queue)) {
@@ -584,7 +602,8 @@ static esp_err_t i2s_destroy_dma_queue(i2s_port_t i2s_num, i2s_dma_t *dma)
         if (dma->desc && dma->desc[bux_idx]) {
             free(dma->desc[bux_idx]);
         }
-        if (dma->buf && dma->buf[bux_idx]) {
+        //in zero-copy mode the data buffers belong to the application
+        if (!dma->user_owned && dma->buf && dma->buf[bux_idx]) {
             free(dma->buf[bux_idx]);
         }
     }
@@ -1043,6 +1062,7 @@ esp_err_t i2s_write(i2s_port_t i2s_num, const void *src, size_t size, size_t *by
     I2S_CHECK((i2s_num < I2S_NUM_MAX), "i2s_num error", ESP_ERR_INVALID_ARG);
     I2S_CHECK((size < SOC_I2S_MAX_BUFFER_SIZE), "size is too large", ESP_ERR_INVALID_ARG);
     I2S_CHECK((p_i2s_obj[i2s_num]->tx), "tx NULL", ESP_ERR_INVALID_ARG);
+    I2S_CHECK((!p_i2s_obj[i2s_num]->tx->user_owned), "tx buffers are application-owned", ESP_ERR_INVALID_STATE);
     xSemaphoreTake(p_i2s_obj[i2s_num]->tx->mux, (portTickType)portMAX_DELAY);
 #ifdef CONFIG_PM_ENABLE
     esp_pm_lock_acquire(p_i2s_obj[i2s_num]->pm_lock);
@@ -1113,6 +1133,7 @@ esp_err_t i2s_write_expand(i2s_port_t i2s_num, const void *src, size_t size, siz
     I2S_CHECK((aim_bits * size < SOC_I2S_MAX_BUFFER_SIZE), "size is too large", ESP_ERR_INVALID_ARG);
     I2S_CHECK((aim_bits >= src_bits), "aim_bits mustn't be less than src_bits", ESP_ERR_INVALID_ARG);
     I2S_CHECK((p_i2s_obj[i2s_num]->tx), "tx NULL", ESP_ERR_INVALID_ARG);
+    I2S_CHECK((!p_i2s_obj[i2s_num]->tx->user_owned), "tx buffers are application-owned", ESP_ERR_INVALID_STATE);
     if (src_bits < I2S_BITS_PER_SAMPLE_8BIT || aim_bits < I2S_BITS_PER_SAMPLE_8BIT) {
         ESP_LOGE(I2S_TAG,"bits mustn't be less than 8, src_bits %d aim_bits %d", src_bits, aim_bits);
         return ESP_ERR_INVALID_ARG;
@@ -1174,6 +1195,7 @@ esp_err_t i2s_read(i2s_port_t i2s_num, void *dest, size_t size, size_t *bytes_re
     I2S_CHECK((i2s_num < I2S_NUM_MAX), "i2s_num error", ESP_ERR_INVALID_ARG);
     I2S_CHECK((size < SOC_I2S_MAX_BUFFER_SIZE), "size is too large", ESP_ERR_INVALID_ARG);
     I2S_CHECK((p_i2s_obj[i2s_num]->rx), "rx NULL", ESP_ERR_INVALID_ARG);
+    I2S_CHECK((!p_i2s_obj[i2s_num]->rx->user_owned), "rx buffers are application-owned", ESP_ERR_INVALID_STATE);
     xSemaphoreTake(p_i2s_obj[i2s_num]->rx->mux, (portTickType)portMAX_DELAY);
 #ifdef CONFIG_PM_ENABLE
     esp_pm_lock_acquire(p_i2s_obj[i2s_num]->pm_lock);
@@ -1203,3 +1225,50 @@ esp_err_t i2s_read(i2s_port_t i2s_num, void *dest, size_t size, size_t *bytes_re
     xSemaphoreGive(p_i2s_obj[i2s_num]->rx->mux);
     return ESP_OK;
 }
+
+static esp_err_t i2s_attach_user_buffers(i2s_port_t i2s_num, i2s_dma_t *dma, char *const bufs[], int buf_count, i2s_buffer_done_cb_t cb, void *user_ctx)
+{
+    I2S_CHECK((dma != NULL), "DMA not initialized", ESP_ERR_INVALID_STATE);
+    I2S_CHECK((bufs != NULL), "bufs NULL", ESP_ERR_INVALID_ARG);
+    I2S_CHECK((buf_count == p_i2s_obj[i2s_num]->dma_buf_count), "buf_count must match dma_buf_count", ESP_ERR_INVALID_ARG);
+    for (int i = 0; i < buf_count; i++) {
+        I2S_CHECK((bufs[i] != NULL && esp_ptr_dma_capable(bufs[i])), "buffers must be in DMA-capable memory", ESP_ERR_INVALID_ARG);
+    }
+
+    xSemaphoreTake(dma->mux, (portTickType)portMAX_DELAY);
+    bool was_user_owned = dma->user_owned;
+    for (int i = 0; i < buf_count; i++) {
+        char *old_buf = was_user_owned ? NULL : dma->buf[i];
+        I2S_ENTER_CRITICAL();
+        dma->buf[i] = bufs[i];
+        dma->desc[i]->buf = (uint8_t *)bufs[i];
+        I2S_EXIT_CRITICAL();
+        if (old_buf) {
+            free(old_buf);
+        }
+    }
+    I2S_ENTER_CRITICAL();
+    dma->user_owned = true;
+    dma->done_cb = cb;
+    dma->done_cb_ctx = user_ctx;
+    dma->curr_ptr = NULL;
+    dma->rw_pos = 0;
+    I2S_EXIT_CRITICAL();
+    xQueueReset(dma->queue);
+    xSemaphoreGive(dma->mux);
+    return ESP_OK;
+}
+
+esp_err_t i2s_set_tx_user_buffers(i2s_port_t i2s_num, char *const bufs[], int buf_count, i2s_buffer_done_cb_t cb, void *user_ctx)
+{
+    I2S_CHECK((i2s_num < I2S_NUM_MAX), "i2s_num error", ESP_ERR_INVALID_ARG);
+    I2S_CHECK((p_i2s_obj[i2s_num] != NULL), "Not initialized yet", ESP_ERR_INVALID_STATE);
+    return i2s_attach_user_buffers(i2s_num, p_i2s_obj[i2s_num]->tx, bufs, buf_count, cb, user_ctx);
+}
+
+esp_err_t i2s_set_rx_user_buffers(i2s_port_t i2s_num, char *const bufs[], int buf_count, i2s_buffer_done_cb_t cb, void *user_ctx)
+{
+    I2S_CHECK((i2s_num < I2S_NUM_MAX), "i2s_num error", ESP_ERR_INVALID_ARG);
+    I2S_CHECK((p_i2s_obj[i2s_num] != NULL), "Not initialized yet", ESP_ERR_INVALID_STATE);
+    return i2s_attach_user_buffers(i2s_num, p_i2s_obj[i2s_num]->rx, bufs, buf_count, cb, user_ctx);
+}
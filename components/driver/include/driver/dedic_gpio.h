@@ -102,6 +102,39 @@ esp_err_t dedic_gpio_get_in_mask(dedic_gpio_bundle_handle_t bundle, uint32_t *ma
  */
 void dedic_gpio_bundle_write(dedic_gpio_bundle_handle_t bundle, uint32_t mask, uint32_t value) IRAM_ATTR;
 
+/**
+ * @brief Type of Dedicated GPIO pattern playback configuration
+ */
+typedef struct {
+    const uint32_t *pattern; /*!< Array of bundle output values, one sample per element, low bit represents low member in the bundle */
+    size_t sample_count;     /*!< Number of samples in pattern */
+    uint32_t sample_rate_hz; /*!< Rate at which samples are written to the bundle, in Hz */
+    struct {
+        int in_critical: 1;  /*!< Run the playback loop inside a critical section, for jitter free timing */
+    } flags; /*!< Flags to control specific behaviour of pattern playback */
+} dedic_gpio_pattern_config_t;
+
+/**
+ * @brief Play a pattern buffer on the output channels of the given GPIO bundle
+ *
+ * Samples are written to the bundle back to back, paced by the CPU cycle counter,
+ * so the pattern timing doesn't depend on flash cache or compiler behaviour.
+ * The function blocks until the whole pattern has been written.
+ *
+ * @param[in] bundle Handle of GPIO bundle that returned from "dedic_gpio_new_bundle"
+ * @param[in] config Configuration of pattern playback
+ * @return
+ *      - ESP_OK: Play pattern successfully
+ *      - ESP_ERR_INVALID_ARG: Play pattern failed because of invalid argument
+ *
+ * @note This function must run on the CPU core the bundle was installed on.
+ * @note The sample rate is limited by the CPU frequency; a few CPU cycles per
+ *       sample are needed for the playback loop itself.
+ * @note With "in_critical" set, interrupts (including the scheduler tick) are
+ *       masked on the calling core for the whole pattern duration.
+ */
+esp_err_t dedic_gpio_bundle_write_pattern(dedic_gpio_bundle_handle_t bundle, const dedic_gpio_pattern_config_t *config);
+
 /**
  * @brief Read the value that output from the given GPIO bundle
  *
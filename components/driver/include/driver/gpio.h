@@ -329,6 +329,42 @@ esp_err_t gpio_isr_handler_add(gpio_num_t gpio_num, gpio_isr_t isr_handler, void
   */
 esp_err_t gpio_isr_handler_remove(gpio_num_t gpio_num);
 
+/**
+  * @brief Add a priority ISR handler for the corresponding GPIO pin.
+  *
+  * Priority handlers are kept in a static dispatch table and are called by the
+  * ISR service ahead of all handlers added with gpio_isr_handler_add(), using a
+  * find-first-set scan over the masked interrupt status word. Use this for pins
+  * that need minimal, deterministic interrupt response (e.g. encoder inputs).
+  *
+  * Call this function after using gpio_install_isr_service() to install the
+  * driver's GPIO ISR handler service. The same IRAM placement rules as for
+  * gpio_isr_handler_add() apply. To bypass the driver's dispatching entirely,
+  * register a raw ISR with gpio_isr_register() instead.
+  *
+  * @param gpio_num GPIO number
+  * @param isr_handler ISR handler function for the corresponding GPIO number.
+  * @param args parameter for ISR handler.
+  *
+  * @return
+  *     - ESP_OK Success
+  *     - ESP_ERR_INVALID_STATE Wrong state, the ISR service has not been initialized.
+  *     - ESP_ERR_INVALID_ARG Parameter error
+  */
+esp_err_t gpio_isr_priority_handler_add(gpio_num_t gpio_num, gpio_isr_t isr_handler, void *args);
+
+/**
+  * @brief Remove a priority ISR handler for the corresponding GPIO pin.
+  *
+  * @param gpio_num GPIO number
+  *
+  * @return
+  *     - ESP_OK Success
+  *     - ESP_ERR_INVALID_STATE Wrong state, the ISR service has not been initialized.
+  *     - ESP_ERR_INVALID_ARG Parameter error
+  */
+esp_err_t gpio_isr_priority_handler_remove(gpio_num_t gpio_num);
+
 /**
   * @brief Set GPIO pad drive capability
   *
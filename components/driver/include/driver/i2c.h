@@ -300,6 +300,78 @@ esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd_handle);
  */
 esp_err_t i2c_master_cmd_begin(i2c_port_t i2c_num, i2c_cmd_handle_t cmd_handle, TickType_t ticks_to_wait);
 
+/**
+ * @brief I2C transaction completion callback.
+ *
+ * @param i2c_num I2C port number the transaction ran on
+ * @param result Result of the transaction, the same codes i2c_master_cmd_begin() returns
+ * @param arg User argument given to i2c_master_cmd_begin_async()
+ */
+typedef void (*i2c_master_cmd_cb_t)(i2c_port_t i2c_num, esp_err_t result, void *arg);
+
+/**
+ * @brief Initialize the asynchronous transaction queue of an I2C port.
+ *        This creates a driver internal task that executes transactions queued with
+ *        i2c_master_cmd_begin_async() in submission order, so transactions on several
+ *        slaves can be in flight while the submitting task does other work.
+ *        @note
+ *        Only call this function in I2C master mode, after the driver is installed.
+ *
+ * @param i2c_num I2C port number
+ * @param queue_size Maximum number of transactions that can be pending at a time
+ * @param task_priority FreeRTOS priority of the internal transaction task. Completion
+ *                      callbacks run in this task's context.
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ *     - ESP_ERR_INVALID_STATE Driver not installed, not in master mode, or queue already initialized
+ *     - ESP_ERR_NO_MEM Queue or task allocation failed
+ */
+esp_err_t i2c_master_async_queue_init(i2c_port_t i2c_num, size_t queue_size, UBaseType_t task_priority);
+
+/**
+ * @brief Delete the asynchronous transaction queue of an I2C port.
+ *        Waits for the transaction in progress to finish. Transactions still pending in
+ *        the queue do not run; their callbacks are invoked with ESP_ERR_INVALID_STATE.
+ *        Called automatically by i2c_driver_delete() if the queue is still initialized.
+ *
+ * @param i2c_num I2C port number
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ *     - ESP_ERR_INVALID_STATE Driver not installed or queue not initialized
+ */
+esp_err_t i2c_master_async_queue_deinit(i2c_port_t i2c_num);
+
+/**
+ * @brief Queue an I2C transaction for asynchronous execution and return immediately.
+ *        The command link is executed by the driver's transaction task, then the completion
+ *        callback is invoked from that task. The command link and its data buffers must stay
+ *        valid (and must not be modified) until the callback has run. A command link may be
+ *        resubmitted as often as needed without being re-created: the driver rewinds it to
+ *        its as-encoded state on every submission, which removes the per-transaction
+ *        encoding cost for periodic transfers.
+ *        @note
+ *        Do not delete the command link from its own completion callback while more
+ *        submissions of the same handle are pending.
+ *
+ * @param i2c_num I2C port number
+ * @param cmd_handle I2C command handler
+ * @param ticks_to_wait maximum wait ticks for the transaction itself (as in i2c_master_cmd_begin())
+ * @param done_cb Completion callback, NULL if no notification is needed
+ * @param cb_arg User argument passed to the completion callback
+ *
+ * @return
+ *     - ESP_OK Transaction queued
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ *     - ESP_ERR_INVALID_STATE Driver not installed or async queue not initialized
+ *     - ESP_ERR_TIMEOUT The transaction queue is full
+ */
+esp_err_t i2c_master_cmd_begin_async(i2c_port_t i2c_num, i2c_cmd_handle_t cmd_handle, TickType_t ticks_to_wait,
+                                     i2c_master_cmd_cb_t done_cb, void *cb_arg);
+
 /**
  * @brief I2C slave write data to internal ringbuffer, when tx fifo empty, isr will fill the hardware
  *        fifo from the internal ringbuffer
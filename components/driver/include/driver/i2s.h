@@ -205,6 +205,70 @@ esp_err_t i2s_write_expand(i2s_port_t i2s_num, const void *src, size_t size, siz
  */
 esp_err_t i2s_read(i2s_port_t i2s_num, void *dest, size_t size, size_t *bytes_read, TickType_t ticks_to_wait);
 
+/**
+ * @brief Callback notifying that the hardware finished one DMA buffer (zero-copy mode).
+ *
+ * Runs in interrupt context: it must be short, IRAM-safe and may only use
+ * FromISR RTOS APIs.
+ *
+ * @param i2s_num   I2S port the buffer belongs to
+ * @param buf       The buffer the hardware just finished (sent for TX, filled for RX)
+ * @param user_ctx  Context pointer given when the buffers were registered
+ */
+typedef void (*i2s_buffer_done_cb_t)(i2s_port_t i2s_num, void *buf, void *user_ctx);
+
+/**
+ * @brief Let the application own the TX DMA buffers (zero-copy mode).
+ *
+ * Replaces the driver-allocated TX DMA buffers with buffers owned by the application.
+ * The hardware cycles through the registered buffers continuously (ping-pong when two
+ * buffers are used) and ``cb`` is called from the ISR each time one has been sent, so
+ * the application refills it in place. This eliminates the per-sample copy done by
+ * ``i2s_write`` and the buffering latency behind it; ``i2s_write`` and
+ * ``i2s_write_expand`` return ESP_ERR_INVALID_STATE once this mode is active.
+ *
+ * @note Call this while the driver is stopped (between ``i2s_stop`` and ``i2s_start``,
+ *       or before the first start). Each buffer must be in DMA-capable memory and hold
+ *       at least ``dma_buf_len`` samples in the configured frame format. The buffers
+ *       must stay valid until the driver is uninstalled; changing the clock or bit
+ *       width with ``i2s_set_clk`` discards the registration.
+ *
+ * @param i2s_num   I2S_NUM_0, I2S_NUM_1
+ * @param bufs      Array of DMA-capable buffers to cycle through
+ * @param buf_count Number of buffers, must equal the ``dma_buf_count`` the driver was installed with
+ * @param cb        Callback invoked from the ISR when a buffer has been sent, or NULL
+ * @param user_ctx  Context pointer passed to the callback
+ *
+ * @return
+ *     - ESP_OK                Success
+ *     - ESP_ERR_INVALID_ARG   Parameter error, or a buffer is not DMA-capable
+ *     - ESP_ERR_INVALID_STATE Driver not installed, or TX not enabled
+ */
+esp_err_t i2s_set_tx_user_buffers(i2s_port_t i2s_num, char *const bufs[], int buf_count, i2s_buffer_done_cb_t cb, void *user_ctx);
+
+/**
+ * @brief Let the application own the RX DMA buffers (zero-copy mode).
+ *
+ * Counterpart of ``i2s_set_tx_user_buffers`` for the receive direction: ``cb`` is
+ * called from the ISR each time the hardware has filled one of the registered buffers,
+ * and the application consumes the samples in place. ``i2s_read`` returns
+ * ESP_ERR_INVALID_STATE once this mode is active.
+ *
+ * @note See i2s_set_tx_user_buffers for the buffer requirements and lifetime rules.
+ *
+ * @param i2s_num   I2S_NUM_0, I2S_NUM_1
+ * @param bufs      Array of DMA-capable buffers to cycle through
+ * @param buf_count Number of buffers, must equal the ``dma_buf_count`` the driver was installed with
+ * @param cb        Callback invoked from the ISR when a buffer has been filled, or NULL
+ * @param user_ctx  Context pointer passed to the callback
+ *
+ * @return
+ *     - ESP_OK                Success
+ *     - ESP_ERR_INVALID_ARG   Parameter error, or a buffer is not DMA-capable
+ *     - ESP_ERR_INVALID_STATE Driver not installed, or RX not enabled
+ */
+esp_err_t i2s_set_rx_user_buffers(i2s_port_t i2s_num, char *const bufs[], int buf_count, i2s_buffer_done_cb_t cb, void *user_ctx);
+
 /**
  * @brief Set sample rate used for I2S RX and TX.
  *
@@ -418,6 +418,41 @@ esp_err_t ledc_set_fade_time_and_start(ledc_mode_t speed_mode, ledc_channel_t ch
  *     - ESP_FAIL Fade function init error
  */
 esp_err_t ledc_set_fade_step_and_start(ledc_mode_t speed_mode, ledc_channel_t channel, uint32_t target_duty, uint32_t scale, uint32_t cycle_num, ledc_fade_mode_t fade_mode);
+
+/**
+ * @brief One segment of a fade chain set with ledc_set_fade_chain_and_start()
+ */
+typedef struct {
+    uint32_t target_duty;   /*!< Duty at the end of the segment [0, (2**duty_resolution) - 1], must differ from the previous segment */
+    uint32_t time_ms;       /*!< Duration of the segment ( ms ) */
+} ledc_fade_segment_t;
+
+/**
+ * @brief A thread-safe API to set and start a chain of LEDC fade segments.
+ *
+ *        The segments are executed back-to-back by the fade hardware: when one segment reaches its
+ *        target duty, the fade ISR immediately programs the next one, without waking any task. A
+ *        piecewise-linear gamma ramp therefore costs one call to enqueue and a single completion
+ *        event for the whole chain, instead of one interrupt plus re-programming round trip per
+ *        linear piece.
+ * @note  Call ledc_fade_func_install() once before calling this function.
+ * @note  If a fade operation is running in progress on that channel, the driver would not allow it to be stopped.
+ *        Other duty operations will have to wait until the whole chain has finished.
+ * @param speed_mode Select the LEDC channel group with specified speed mode. Note that not all targets support high speed mode.
+ * @param channel LEDC channel index (0-7), select from ledc_channel_t
+ * @param segments Array of fade segments, executed in order starting from the current duty.
+ *        The segments are copied, so the array may live on the caller's stack.
+ * @param num_segments Number of segments, 1 to 64.
+ * @param fade_mode Choose blocking or non-blocking mode; LEDC_FADE_WAIT_DONE returns after the last segment.
+ * @return
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_STATE Fade function not installed.
+ *     - ESP_ERR_NO_MEM Not enough memory to copy the chain
+ *     - ESP_FAIL Fade function init error
+ */
+esp_err_t ledc_set_fade_chain_and_start(ledc_mode_t speed_mode, ledc_channel_t channel, const ledc_fade_segment_t *segments,
+                                        uint32_t num_segments, ledc_fade_mode_t fade_mode);
 #ifdef __cplusplus
 }
 #endif
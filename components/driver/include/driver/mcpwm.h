@@ -292,6 +292,55 @@ esp_err_t mcpwm_set_duty_in_us(mcpwm_unit_t mcpwm_num, mcpwm_timer_t timer_num,
  */
 esp_err_t mcpwm_set_duty_type(mcpwm_unit_t mcpwm_num, mcpwm_timer_t timer_num, mcpwm_generator_t gen, mcpwm_duty_type_t duty_type);
 
+/**
+ * @brief Stage a duty cycle into the unit's update group without writing it to hardware
+ *
+ * Staged values take effect together when mcpwm_update_group_commit() is called, so the duty of
+ * several timers (e.g. the three phases of a motor) can be changed in the same PWM period.
+ *
+ * @param mcpwm_num set MCPWM unit(0-1)
+ * @param timer_num set timer number(0-2) of MCPWM, each MCPWM unit has 3 timers
+ * @param gen set the generator(MCPWMXA/MCPWMXB), 'x' is operator number selected
+ * @param duty set duty cycle in %(i.e for 62.3% duty cycle, duty = 62.3) of each generator
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ */
+esp_err_t mcpwm_update_group_set_duty(mcpwm_unit_t mcpwm_num, mcpwm_timer_t timer_num, mcpwm_generator_t gen, float duty);
+
+/**
+ * @brief Stage a frequency into the unit's update group without writing it to hardware
+ *
+ * Staged values take effect together when mcpwm_update_group_commit() is called.
+ *
+ * @param mcpwm_num set MCPWM unit(0-1)
+ * @param timer_num set timer number(0-2) of MCPWM, each MCPWM unit has 3 timers
+ * @param frequency set the frequency in Hz of each timer
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ */
+esp_err_t mcpwm_update_group_set_frequency(mcpwm_unit_t mcpwm_num, mcpwm_timer_t timer_num, uint32_t frequency);
+
+/**
+ * @brief Write all staged duty cycles and frequencies of one unit to hardware at once
+ *
+ * All staged values are written inside a single critical section. Because comparator updates are
+ * latched by the hardware shadow registers at the period boundary, timers that have been
+ * synchronized with mcpwm_sync_enable() apply the whole group in the same PWM period, avoiding
+ * the current ripple caused by duty updates landing in different periods.
+ *
+ * @param mcpwm_num set MCPWM unit(0-1)
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ *     - ESP_ERR_INVALID_STATE MCPWM unit not initialized
+ */
+esp_err_t mcpwm_update_group_commit(mcpwm_unit_t mcpwm_num);
+
 /**
 * @brief Get frequency of timer
 *
@@ -611,6 +660,135 @@ uint32_t mcpwm_capture_signal_get_value(mcpwm_unit_t mcpwm_num, mcpwm_capture_si
  */
 uint32_t mcpwm_capture_signal_get_edge(mcpwm_unit_t mcpwm_num, mcpwm_capture_signal_t cap_sig);
 
+/**
+ * @brief One captured edge, as delivered by the capture stream
+ */
+typedef struct {
+    uint32_t cap_value; /*!<Captured counter value, counter uses APB_CLK*/
+    uint32_t cap_edge;  /*!<Edge that triggered the capture: 1 - positive edge, 2 - negtive edge*/
+} mcpwm_capture_event_t;
+
+/**
+ * @brief Enable streaming delivery of capture events
+ *
+ * Enables the capture signal like mcpwm_capture_enable() and additionally installs a
+ * driver-owned ISR that pushes every captured edge (timestamp and edge direction) into
+ * a ring buffer, so the application reads edges in batches with
+ * mcpwm_capture_stream_read() instead of servicing one interrupt per edge. The capture
+ * timestamps come from the 32-bit APB clock counter, giving 12.5 ns resolution at 80 MHz.
+ *
+ * @param mcpwm_num set MCPWM unit(0-1)
+ * @param cap_sig capture pin, which needs to be enabled
+ * @param cap_edge set capture edge, BIT(0) - negative edge, BIT(1) - positive edge
+ * @param num_of_pulse count time between rising/falling edge between 2 *(pulses mentioned), counter uses APB_CLK
+ * @param ring_entries capacity of the ring buffer, 2 to 4096, rounded up to a power of two.
+ *        When the ring is full further edges are dropped and counted as overruns.
+ *
+ * @note The stream allocates the MCPWM interrupt of the unit for itself, so it cannot be
+ *       combined with mcpwm_isr_register() on the same unit.
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ *     - ESP_ERR_INVALID_STATE Stream already enabled on this capture signal
+ *     - ESP_ERR_NO_MEM Not enough memory for the ring buffer
+ */
+esp_err_t mcpwm_capture_stream_enable(mcpwm_unit_t mcpwm_num, mcpwm_capture_signal_t cap_sig,
+                                      mcpwm_capture_on_edge_t cap_edge, uint32_t num_of_pulse, uint32_t ring_entries);
+
+/**
+ * @brief Read buffered capture events from the stream
+ *
+ * Copies up to max_events of the oldest pending events into the caller's buffer and
+ * removes them from the ring. Returns immediately; *num_events is 0 when no edge has
+ * been captured since the last read. Only one task may read a given stream.
+ *
+ * @param mcpwm_num set MCPWM unit(0-1)
+ * @param cap_sig capture pin the stream was enabled on
+ * @param events buffer to copy the events into
+ * @param max_events capacity of the events buffer
+ * @param num_events number of events actually copied
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ *     - ESP_ERR_INVALID_STATE Stream not enabled on this capture signal
+ */
+esp_err_t mcpwm_capture_stream_read(mcpwm_unit_t mcpwm_num, mcpwm_capture_signal_t cap_sig,
+                                    mcpwm_capture_event_t *events, uint32_t max_events, uint32_t *num_events);
+
+/**
+ * @brief Get the number of capture events dropped because the stream ring was full
+ *
+ * @param mcpwm_num set MCPWM unit(0-1)
+ * @param cap_sig capture pin the stream was enabled on
+ *
+ * @return
+ *     Number of dropped events since the stream was enabled
+ */
+uint32_t mcpwm_capture_stream_get_overrun_count(mcpwm_unit_t mcpwm_num, mcpwm_capture_signal_t cap_sig);
+
+/**
+ * @brief Disable the capture stream and release its ring buffer
+ *
+ * Also disables the capture signal, like mcpwm_capture_disable(). The MCPWM interrupt of
+ * the unit is freed once no capture stream is left enabled on it.
+ *
+ * @param mcpwm_num set MCPWM unit(0-1)
+ * @param cap_sig capture pin, which needs to be disabled
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ *     - ESP_ERR_INVALID_STATE Stream not enabled on this capture signal
+ */
+esp_err_t mcpwm_capture_stream_disable(mcpwm_unit_t mcpwm_num, mcpwm_capture_signal_t cap_sig);
+
+/**
+ * @brief Start repeating playback of a pre-computed duty table on one generator
+ *
+ * The driver converts the duty percentages to comparator ticks up front and loads one entry per
+ * PWM period from a minimal IRAM interrupt at the timer's zero event, so pre-computed commutation
+ * patterns play back without per-period work in application code. The table is played in a loop
+ * until mcpwm_duty_table_stop() is called. The duty table is copied into the driver, so the
+ * caller's buffer may be released after this call returns.
+ *
+ * @note The playback claims the MCPWM interrupt of the unit for the driver, so it cannot be used
+ *       together with mcpwm_isr_register() on the same unit.
+ * @note The table is converted with the PWM period valid at this call; restart the playback after
+ *       changing the frequency of the timer.
+ *
+ * @param mcpwm_num set MCPWM unit(0-1)
+ * @param timer_num set timer number(0-2) of MCPWM, each MCPWM unit has 3 timers
+ * @param gen set the generator(MCPWMXA/MCPWMXB), 'x' is operator number selected
+ * @param duty_table duty cycles in %(i.e for 62.3% duty cycle, duty = 62.3), one entry per PWM period
+ * @param table_len number of entries in duty_table, 1 to 4096
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ *     - ESP_ERR_INVALID_STATE Playback already running on this timer
+ *     - ESP_ERR_NO_MEM Out of memory for the converted table
+ */
+esp_err_t mcpwm_duty_table_start(mcpwm_unit_t mcpwm_num, mcpwm_timer_t timer_num, mcpwm_generator_t gen,
+                                 const float *duty_table, uint32_t table_len);
+
+/**
+ * @brief Stop the duty table playback on one timer
+ *
+ * The generator keeps running with the last duty loaded from the table. The MCPWM interrupt of
+ * the unit is freed once no capture stream or duty table is left enabled on it.
+ *
+ * @param mcpwm_num set MCPWM unit(0-1)
+ * @param timer_num set timer number(0-2) of MCPWM, each MCPWM unit has 3 timers
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ *     - ESP_ERR_INVALID_STATE Playback not running on this timer
+ */
+esp_err_t mcpwm_duty_table_stop(mcpwm_unit_t mcpwm_num, mcpwm_timer_t timer_num);
+
 /**
  * @brief Initialize sync submodule
  *
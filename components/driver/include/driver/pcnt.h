@@ -371,6 +371,124 @@ void pcnt_isr_service_uninstall(void);
  */
 esp_err_t pcnt_isr_handler_remove(pcnt_unit_t unit);
 
+/**
+ * @brief Enable driver-managed 64-bit accumulation for a unit.
+ *
+ * The driver enables the counter limit events of the unit and carries every
+ * overflow of the 16-bit hardware counter into a 64-bit accumulator from a
+ * minimal ISR, so applications read totals with pcnt_accum_get_count() and
+ * never have to handle overflow interrupts themselves. The counter limits
+ * configured in pcnt_unit_config() (counter_h_lim/counter_l_lim) define the
+ * carry size; at least one of them must be non-zero.
+ *
+ * @note pcnt_isr_service_install() must be called first. A per-unit handler
+ *       added with pcnt_isr_handler_add() keeps working alongside the
+ *       accumulation.
+ *
+ * @param unit PCNT unit number
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ *     - ESP_ERR_INVALID_STATE pcnt driver has not been initialized, ISR
+ *       service not installed, or no counter limit configured
+ */
+esp_err_t pcnt_accum_enable(pcnt_unit_t unit);
+
+/**
+ * @brief Disable accumulation for a unit.
+ *
+ * Also disables the counter limit events that pcnt_accum_enable() enabled.
+ *
+ * @param unit PCNT unit number
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ *     - ESP_ERR_INVALID_STATE accumulation not enabled on this unit
+ */
+esp_err_t pcnt_accum_disable(pcnt_unit_t unit);
+
+/**
+ * @brief Reset the accumulated count and the rate window of a unit to zero.
+ *
+ * The hardware counter is cleared as well.
+ *
+ * @param unit PCNT unit number
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ *     - ESP_ERR_INVALID_STATE accumulation not enabled on this unit
+ */
+esp_err_t pcnt_accum_clear(pcnt_unit_t unit);
+
+/**
+ * @brief Get the accumulated 64-bit count of a unit.
+ *
+ * The result is the sum of all carried overflows and the live hardware
+ * counter value.
+ *
+ * @param unit PCNT unit number
+ * @param count Pointer to accept the accumulated count
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ *     - ESP_ERR_INVALID_STATE accumulation not enabled on this unit
+ */
+esp_err_t pcnt_accum_get_count(pcnt_unit_t unit, int64_t *count);
+
+/**
+ * @brief Read the accumulated counts of several units in one coherent snapshot.
+ *
+ * All units are sampled inside a single critical section, so the returned
+ * values belong to the same instant even when the counters keep running.
+ *
+ * @param units Array of PCNT unit numbers to sample
+ * @param num_units Number of entries in units, 1 to PCNT_UNIT_MAX
+ * @param counts Array to accept one accumulated count per requested unit
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ *     - ESP_ERR_INVALID_STATE accumulation not enabled on one of the units
+ */
+esp_err_t pcnt_accum_snapshot(const pcnt_unit_t *units, uint32_t num_units, int64_t *counts);
+
+/**
+ * @brief Set the window of the pulse rate computation of a unit.
+ *
+ * Default window is 1000 ms.
+ *
+ * @param unit PCNT unit number
+ * @param window_ms Minimum time base of the rate computation in milliseconds
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ */
+esp_err_t pcnt_accum_set_rate_window(pcnt_unit_t unit, uint32_t window_ms);
+
+/**
+ * @brief Get the pulse rate of a unit in pulses per second.
+ *
+ * The rate is computed from the accumulated count over windows of at least
+ * the configured length: once the current window is older than the window
+ * time, the next call closes it and opens a new one. Calls within a window
+ * return the rate of the last completed window; before the first window
+ * completes the rate is 0.
+ *
+ * @param unit PCNT unit number
+ * @param rate_hz Pointer to accept the pulse rate in pulses per second
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ *     - ESP_ERR_INVALID_STATE accumulation not enabled on this unit
+ */
+esp_err_t pcnt_accum_get_rate(pcnt_unit_t unit, float *rate_hz);
+
 /**
  * @addtogroup pcnt-examples
  *
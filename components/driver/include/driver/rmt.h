@@ -171,6 +171,24 @@ typedef struct {
 */
 typedef void (*sample_to_rmt_t)(const void *src, rmt_item32_t *dest, size_t src_size, size_t wanted_num, size_t *translated_size, size_t *item_num);
 
+/**
+* @brief User callback function producing rmt format data (rmt_item32_t) on the fly.
+*
+*        The callback is called whenever the transmitter needs the next batch of items:
+*        once when the transmission is started and then from the driver ISR each time half
+*        of the channel's memory block has been sent out. It is called from an ISR, so the
+*        code should be short and efficient, and should be placed in IRAM if the driver
+*        interrupt was allocated with ESP_INTR_FLAG_IRAM.
+*
+* @param  channel RMT channel the data is produced for.
+* @param[out] dest Pointer to the buffer to fill with rmt format data.
+* @param  wanted_num The number of rmt format items requested.
+*
+* @return The number of items written to dest. Returning less than wanted_num (including 0)
+*         marks the end of the stream, transmission stops after the returned items.
+*/
+typedef size_t (*rmt_tx_encoder_t)(rmt_channel_t channel, rmt_item32_t *dest, size_t wanted_num, void *arg);
+
 /**
 * @brief Set RMT clock divider, channel clock is divided from source clock.
 *
@@ -777,6 +795,28 @@ esp_err_t rmt_translator_init(rmt_channel_t channel, sample_to_rmt_t fn);
 */
 esp_err_t rmt_write_sample(rmt_channel_t channel, const uint8_t *src, size_t src_size, bool wait_tx_done);
 
+/**
+* @brief Send a stream of rmt format data produced on the fly by an encoder callback.
+*
+*        Unlike rmt_write_items or rmt_write_sample, no buffer with the complete transmission
+*        has to exist up front: the encoder is asked for the next batch of items whenever half
+*        of the channel's memory block has been sent, so memory usage is bounded by the
+*        channel's memory block regardless of how long the sequence is. The stream ends when
+*        the encoder returns fewer items than requested.
+*
+* @param channel RMT channel.
+* @param encoder Encoder callback, see rmt_tx_encoder_t. Called from ISR context after the
+*        transmission has started.
+* @param arg User argument passed to the encoder on each call.
+* @param wait_tx_done Set true to wait until the whole stream has been sent out.
+*
+* @return
+*     - ESP_ERR_INVALID_ARG Parameter error
+*     - ESP_FAIL Send fail
+*     - ESP_OK Send success
+*/
+esp_err_t rmt_write_stream(rmt_channel_t channel, rmt_tx_encoder_t encoder, void *arg, bool wait_tx_done);
+
 /**
 * @brief Registers a callback that will be called when transmission ends.
 *
@@ -166,6 +166,54 @@ esp_err_t sdio_slave_recv(sdio_slave_buf_handle_t* handle_ret, uint8_t **out_add
  */
 uint8_t* sdio_slave_recv_get_buf(sdio_slave_buf_handle_t handle, size_t *len_o);
 
+/** Start streaming receive mode. The driver allocates and registers `buffer_num` receiving buffers of
+ *  `recv_buffer_size` each and keeps all of them loaded on the linked-list, re-loading every buffer as soon as
+ *  its data is consumed through ``sdio_slave_recv_stream_read``. The host keeps receiving buffer credits through
+ *  the existing receiving interrupt and needs no per-buffer handshake from the application.
+ *
+ * @param buffer_num Number of buffers in the streaming pool. More buffers let the host burst longer while the
+ *                   application is busy.
+ *
+ * @note While the stream is running the receiving path is owned by the driver; do not mix with
+ *       ``sdio_slave_recv_load_buf`` or ``sdio_slave_recv`` on application buffers.
+ *
+ * @return
+ *     - ESP_ERR_INVALID_STATE  if the driver is not initialized or a stream is already started
+ *     - ESP_ERR_INVALID_ARG    if buffer_num is not positive
+ *     - ESP_ERR_NO_MEM         if the buffers cannot be allocated
+ *     - ESP_OK if success
+ */
+esp_err_t sdio_slave_recv_stream_start(int buffer_num);
+
+/** Read received data as a byte stream, crossing buffer boundaries transparently.
+ *
+ * Waits up to `wait` for the first data to arrive, then copies out everything already received (up to `size`
+ * bytes) without blocking again. Buffers drained by the copy are handed straight back to the hardware.
+ *
+ * @param buffer Destination for the received data.
+ * @param size Capacity of the destination.
+ * @param[out] size_read Number of bytes actually copied.
+ * @param wait Time to wait for the first data.
+ *
+ * @return
+ *     - ESP_ERR_INVALID_STATE  if the stream is not started
+ *     - ESP_ERR_INVALID_ARG    if buffer or size_read is NULL
+ *     - ESP_ERR_TIMEOUT        if no data arrived before the timeout
+ *     - ESP_OK if success
+ */
+esp_err_t sdio_slave_recv_stream_read(uint8_t *buffer, size_t size, size_t *size_read, TickType_t wait);
+
+/** Stop streaming receive mode and release the streaming buffers. Data received but not yet read is discarded.
+ *
+ * @note Call ``sdio_slave_stop`` before stopping the stream so the hardware no longer owns the buffers, and
+ *       ``sdio_slave_reset`` afterwards if the driver will be started again.
+ *
+ * @return
+ *     - ESP_ERR_INVALID_STATE  if the stream is not started
+ *     - ESP_OK if success
+ */
+esp_err_t sdio_slave_recv_stream_stop(void);
+
 /*---------------------------------------------------------------------------
  *                  Send
  *--------------------------------------------------------------------------*/
@@ -75,6 +75,17 @@ typedef struct {
     uint32_t data[512 / 8 / sizeof(uint32_t)];  /*!< response data */
 } sdmmc_switch_func_rsp_t;
 
+/**
+ * SD/MMC scatter-gather data fragment
+ *
+ * Describes one buffer of a scatter-gather transfer. Each fragment must be
+ * word-aligned, DMA-capable, and a multiple of 4 bytes long.
+ */
+typedef struct {
+    void* data;                 /*!< pointer to the fragment buffer */
+    size_t size;                /*!< size of the fragment, in bytes */
+} sdmmc_sg_frag_t;
+
 /**
  * SD/MMC command information
  */
@@ -115,6 +126,10 @@ typedef struct {
 /** @endcond */
         esp_err_t error;            /*!< error returned from transfer */
         int timeout_ms;             /*!< response timeout, in milliseconds */
+        const sdmmc_sg_frag_t* sg_frags;    /*!< optional scatter-gather fragment list; when set,
+                                                 `data` must be NULL and `datalen` must be equal to
+                                                 the total size of all fragments */
+        size_t sg_frag_count;       /*!< number of entries in sg_frags */
 } sdmmc_command_t;
 
 /**
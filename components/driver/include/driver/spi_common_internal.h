@@ -588,6 +588,49 @@ spi_bus_lock_handle_t spi_bus_lock_get_parent(spi_bus_lock_dev_handle_t dev_hand
  */
 int spi_bus_lock_get_dev_id(spi_bus_lock_dev_handle_t dev_handle);
 
+/**
+ * @brief Contention statistics of one device on a bus lock.
+ *
+ * Collected when ``CONFIG_SPI_BUS_LOCK_STATS`` is enabled. Wait time is
+ * spent blocked in `spi_bus_lock_acquire_start`, hold time runs from a
+ * successful acquire to the matching `spi_bus_lock_acquire_end`.
+ */
+typedef struct {
+    uint32_t acquires;          ///< Successful acquisitions
+    uint32_t contended;         ///< Acquisitions that had to block
+    uint64_t total_wait_us;     ///< Accumulated blocked time
+    uint32_t max_wait_us;       ///< Longest single blocked time
+    uint64_t total_hold_us;     ///< Accumulated bus hold time
+    uint32_t max_hold_us;       ///< Longest single bus hold
+    uint32_t deferred_grants;   ///< Times the fair scheduler made this device wait one extra round
+} spi_bus_lock_stats_t;
+
+/**
+ * @brief Read the contention statistics of a device.
+ *
+ * @param dev_handle Handle to the device to query
+ * @param out_stats Output, statistics accumulated since registration or the last reset
+ * @return ESP_OK on success, ESP_ERR_NOT_SUPPORTED when ``CONFIG_SPI_BUS_LOCK_STATS``
+ *         is disabled
+ */
+esp_err_t spi_bus_lock_get_dev_stats(spi_bus_lock_dev_handle_t dev_handle, spi_bus_lock_stats_t *out_stats);
+
+/**
+ * @brief Reset the contention statistics of a device.
+ *
+ * @param dev_handle Handle to the device to reset
+ * @return ESP_OK on success, ESP_ERR_NOT_SUPPORTED when ``CONFIG_SPI_BUS_LOCK_STATS``
+ *         is disabled
+ */
+esp_err_t spi_bus_lock_reset_dev_stats(spi_bus_lock_dev_handle_t dev_handle);
+
+/**
+ * @brief Log the contention statistics of every device registered on a bus lock.
+ *
+ * @param lock Handle to the lock to dump
+ */
+void spi_bus_lock_dump_stats(spi_bus_lock_handle_t lock);
+
 /**
  * @brief The device request to touch bus registers. Can only be called by the acquiring processor.
  *
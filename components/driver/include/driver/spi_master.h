@@ -315,6 +315,108 @@ esp_err_t spi_device_polling_end(spi_device_handle_t handle, TickType_t ticks_to
 esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t *trans_desc);
 
 
+/**
+ * @brief Send a batch of transactions back-to-back, wait for all of them to complete.
+ *
+ * The bus is occupied for the whole batch (as if ``spi_device_acquire_bus`` was called
+ * around it) and the transactions are sent in the polling mode, so consecutive transfers
+ * follow each other at wire speed without a completion interrupt and task switch in
+ * between. Per-transaction ``pre_cb``/``post_cb`` callbacks are still invoked, from the
+ * calling task. Intended for bursts of transfers (e.g. camera reads) where the
+ * per-transaction ISR overhead would leave the bus idle between transfers.
+ *
+ * The whole batch is validated before any part of it is sent. If sending a transaction
+ * fails, the remaining ones are not sent and the error is returned.
+ *
+ * @note The calling task is occupied until the batch completes. If the bus was not
+ *      already acquired by this device, it is acquired and released internally.
+ *
+ * @param handle Device handle obtained using spi_host_add_dev
+ * @param trans_desc Array of pointers to the descriptions of the transactions to execute
+ * @param trans_num Number of transactions in the array
+ * @return
+ *         - ESP_ERR_INVALID_ARG   if a parameter is invalid
+ *         - ESP_ERR_INVALID_STATE if previous transactions are not finished
+ *         - ESP_OK                on success
+ */
+esp_err_t spi_device_transmit_batch(spi_device_handle_t handle, spi_transaction_t *trans_desc[], int trans_num);
+
+
+typedef struct spi_prepared_trans_t* spi_prepared_trans_handle_t;  ///< Handle for a prepared (precompiled) SPI transaction
+
+/**
+ * @brief Precompile a transaction so that it can be sent repeatedly with low overhead.
+ *
+ * The transaction-specific device configuration (command, address, dummy and data phase
+ * lengths, IO mode) is computed and validated once and stored in the returned handle.
+ * Submitting the prepared transaction with ``spi_device_queue_prepared_trans`` or
+ * ``spi_device_polling_transmit_prepared`` then skips the per-transaction validation and
+ * setup, which roughly halves the CPU overhead for workloads sending many
+ * identically-shaped transactions (e.g. display refresh).
+ *
+ * The shape of the transaction is frozen at prepare time: only the buffer pointers
+ * (``tx_buffer``/``rx_buffer``) and the buffer contents of ``trans_desc`` may be changed
+ * between submissions. ``trans_desc`` must stay valid until the prepared transaction is
+ * released.
+ *
+ * @note When the bus uses DMA, the buffers must be DMA-capable (and the rx buffer 32-bit
+ *      aligned): no temporary DMA buffer is allocated on this fast path, submission fails
+ *      with ESP_ERR_INVALID_ARG instead.
+ *
+ * @param handle Device handle obtained using spi_host_add_dev
+ * @param trans_desc Description of transaction to precompile
+ * @param[out] out_prepared Returned handle for the prepared transaction
+ * @return
+ *         - ESP_ERR_INVALID_ARG   if parameter is invalid
+ *         - ESP_ERR_NO_MEM        if allocating the prepared transaction failed
+ *         - ESP_OK                on success
+ */
+esp_err_t spi_device_prepare_trans(spi_device_handle_t handle, spi_transaction_t *trans_desc, spi_prepared_trans_handle_t *out_prepared);
+
+/**
+ * @brief Queue a prepared transaction for interrupt transaction execution.
+ *
+ * Same as ``spi_device_queue_trans``, but using a transaction precompiled by
+ * ``spi_device_prepare_trans``. Get the result by ``spi_device_get_trans_result``, which
+ * returns the ``trans_desc`` the transaction was prepared from.
+ *
+ * @param prepared Prepared transaction obtained using spi_device_prepare_trans
+ * @param ticks_to_wait Ticks to wait until there's room in the queue; use portMAX_DELAY to
+ *                      never time out.
+ * @return
+ *         - ESP_ERR_INVALID_ARG   if parameter is invalid, or a buffer is not DMA-capable
+ *         - ESP_ERR_TIMEOUT       if there was no room in the queue before ticks_to_wait expired
+ *         - ESP_ERR_INVALID_STATE if previous transactions are not finished
+ *         - ESP_OK                on success
+ */
+esp_err_t spi_device_queue_prepared_trans(spi_prepared_trans_handle_t prepared, TickType_t ticks_to_wait);
+
+/**
+ * @brief Send a prepared transaction in the polling mode, wait for it to complete, and return the result.
+ *
+ * Same as ``spi_device_polling_transmit``, but using a transaction precompiled by
+ * ``spi_device_prepare_trans``.
+ *
+ * @param prepared Prepared transaction obtained using spi_device_prepare_trans
+ * @return
+ *         - ESP_ERR_INVALID_ARG   if parameter is invalid, or a buffer is not DMA-capable
+ *         - ESP_ERR_INVALID_STATE if previous transactions are not finished
+ *         - ESP_OK                on success
+ */
+esp_err_t spi_device_polling_transmit_prepared(spi_prepared_trans_handle_t prepared);
+
+/**
+ * @brief Release a transaction prepared by ``spi_device_prepare_trans``.
+ *
+ * The prepared transaction must not be in flight when this is called.
+ *
+ * @param prepared Prepared transaction obtained using spi_device_prepare_trans
+ * @return
+ *         - ESP_ERR_INVALID_ARG   if parameter is invalid
+ *         - ESP_OK                on success
+ */
+esp_err_t spi_device_release_prepared_trans(spi_prepared_trans_handle_t prepared);
+
 /**
  * @brief Occupy the SPI bus for a device to do continuous transactions.
  *
@@ -62,6 +62,8 @@ typedef struct {
     slave_cb_t cb_buffer_rx;    ///< Callback when master writes to shared buffer
     slave_cb_t cb_cmd9;         ///< Callback when CMD9 received
     slave_cb_t cb_cmdA;         ///< Callback when CMDA received
+    slave_cb_t cb_ring_tx;      ///< Callback when the TX ring reaches its watermark, see `spi_slave_hd_ring_start`
+    slave_cb_t cb_ring_rx;      ///< Callback when the RX ring reaches its watermark, see `spi_slave_hd_ring_start`
     void* arg;                  ///< Argument indicating this SPI Slave HD peripheral instance
 } spi_slave_hd_callback_config_t;
 
@@ -142,6 +144,63 @@ esp_err_t spi_slave_hd_queue_trans(spi_host_device_t host_id, spi_slave_chan_t c
  */
 esp_err_t spi_slave_hd_get_trans_res(spi_host_device_t host_id, spi_slave_chan_t chan, spi_slave_hd_data_t** out_trans, TickType_t timeout);
 
+/**
+ * @brief Start continuous ring mode on a channel
+ *
+ * The driver cycles through the given descriptors forever: whenever a transfer finishes, the DMA
+ * is re-armed with the next descriptor directly from the ISR, so the master can clock an
+ * uninterrupted stream without the re-arm gaps of `spi_slave_hd_queue_trans`. Every `watermark`
+ * finished transfers the `cb_ring_tx`/`cb_ring_rx` callback (see
+ * `spi_slave_hd_callback_config_t`) is invoked from the ISR with the descriptor finished last,
+ * similar to an ADC DMA ring. For the RX channel the `trans_len` member of each descriptor is
+ * updated before the callback.
+ *
+ * The descriptor array and all data buffers stay owned by the hardware until the ring is stopped,
+ * and must remain valid. The `cb_sent`/`cb_recv` callbacks and the return queue read by
+ * `spi_slave_hd_get_trans_res` are not used for ring transfers; do not mix
+ * `spi_slave_hd_queue_trans` with an active ring on the same channel.
+ *
+ * @param host_id    Host to start the ring on
+ * @param chan       Channel to cycle, SPI_SLAVE_CHAN_TX or SPI_SLAVE_CHAN_RX
+ * @param trans      Array of data descriptors forming the ring
+ * @param trans_num  Number of descriptors in the array, at least 2
+ * @param watermark  Invoke the ring callback every this many finished transfers, 1 to `trans_num`
+ * @return
+ *  - ESP_OK: on success
+ *  - ESP_ERR_INVALID_ARG: invalid channel, watermark, or a buffer is not DMA capable or of invalid size
+ *  - ESP_ERR_INVALID_STATE: the driver is not initialized, or the ring is already started
+ */
+esp_err_t spi_slave_hd_ring_start(spi_host_device_t host_id, spi_slave_chan_t chan,
+                                  spi_slave_hd_data_t *trans, uint32_t trans_num, uint32_t watermark);
+
+/**
+ * @brief Stop the continuous ring mode on a channel
+ *
+ * A transfer already loaded into the DMA finishes normally (and still counts for the watermark),
+ * afterwards the channel falls back to the transaction queue.
+ *
+ * @param host_id   Host to stop the ring on
+ * @param chan      Channel to stop, SPI_SLAVE_CHAN_TX or SPI_SLAVE_CHAN_RX
+ * @return
+ *  - ESP_OK: on success
+ *  - ESP_ERR_INVALID_ARG: invalid channel
+ *  - ESP_ERR_INVALID_STATE: the driver is not initialized, or the ring is not started
+ */
+esp_err_t spi_slave_hd_ring_stop(spi_host_device_t host_id, spi_slave_chan_t chan);
+
+/**
+ * @brief Get the number of ring transfers finished since the ring was started
+ *
+ * Together with `trans_num` this tells the application which ring slots were rewritten, e.g. to
+ * find the slots to refill between two watermark callbacks.
+ *
+ * @param host_id   Host the ring runs on
+ * @param chan      Channel to query, SPI_SLAVE_CHAN_TX or SPI_SLAVE_CHAN_RX
+ * @return
+ *  Number of finished ring transfers, 0 when the driver or ring is not started
+ */
+uint32_t spi_slave_hd_ring_get_done_count(spi_host_device_t host_id, spi_slave_chan_t chan);
+
 /**
  * @brief Read the shared registers
  *
@@ -189,6 +189,51 @@ esp_err_t timer_get_alarm_value(timer_group_t group_num, timer_idx_t timer_num,
  */
 esp_err_t timer_set_alarm(timer_group_t group_num, timer_idx_t timer_num, timer_alarm_t alarm_en);
 
+/**
+ * @brief Program a schedule of several future alarms at once.
+ *
+ * The driver copies the given alarm values, arms the first one and advances the
+ * hardware alarm to the next entry from the alarm ISR, so a train of N precisely
+ * placed alarms costs one call instead of N re-programming round trips. The
+ * callback installed with timer_isr_callback_add() is invoked for every entry.
+ *
+ * @param group_num Timer group, 0 for TIMERG0 or 1 for TIMERG1
+ * @param timer_num Timer index, 0 for hw_timer[0] & 1 for hw_timer[1]
+ * @param alarm_values Array of absolute 64-bit alarm values, strictly increasing.
+ * @param num_alarms Number of entries in alarm_values, must be at least 1.
+ * @param repeat If true, the counter is reset to zero when the last entry fires
+ *        and the schedule restarts from the first entry, generating a repeating
+ *        frame with period alarm_values[num_alarms - 1]. Hardware auto reload
+ *        should be disabled in this mode. If false, the alarm is left disabled
+ *        after the last entry.
+ *
+ * @note The schedule assumes an up-counting timer. A pending schedule replaces
+ *       the plain alarm value set with timer_set_alarm_value(); clear it with
+ *       timer_clear_alarm_schedule() to return to single-alarm operation.
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ *     - ESP_ERR_NO_MEM Not enough memory to copy the schedule
+ */
+esp_err_t timer_set_alarm_schedule(timer_group_t group_num, timer_idx_t timer_num, const uint64_t *alarm_values,
+                                   uint32_t num_alarms, bool repeat);
+
+/**
+ * @brief Drop the alarm schedule armed with timer_set_alarm_schedule().
+ *
+ * Entries that have not fired yet are discarded; the alarm enable state and
+ * value are left as they are, so the caller can re-arm a plain alarm afterwards.
+ *
+ * @param group_num Timer group, 0 for TIMERG0 or 1 for TIMERG1
+ * @param timer_num Timer index, 0 for hw_timer[0] & 1 for hw_timer[1]
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ */
+esp_err_t timer_clear_alarm_schedule(timer_group_t group_num, timer_idx_t timer_num);
+
 /**
  * @brief Add ISR handle callback for the corresponding timer.
  *
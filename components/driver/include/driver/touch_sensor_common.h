@@ -165,6 +165,91 @@ uint32_t touch_pad_get_status(void);
  */
 bool touch_pad_meas_is_done(void);
 
+/**
+ * @brief Callback invoked by the continuous scan mode when the filtered value
+ *        of a pad moves by at least the configured change threshold.
+ * @note  Called from the esp_timer task context, not from an ISR.
+ * @param touch_num touch pad index
+ * @param value the new filtered reading of the pad
+ * @param arg user argument given in the scan configuration
+ */
+typedef void (*touch_pad_scan_cb_t)(touch_pad_t touch_num, uint32_t value, void *arg);
+
+/**
+ * @brief One snapshot of all scanned pads, as deposited into the result ring.
+ */
+typedef struct {
+    int64_t timestamp;                      /*!< Time of the scan, in microseconds since boot */
+    uint32_t values[TOUCH_PAD_MAX];         /*!< Filtered reading per pad; 0 for pads not in the scan mask */
+} touch_pad_scan_frame_t;
+
+/**
+ * @brief Continuous scan mode configuration.
+ */
+typedef struct {
+    uint16_t channel_mask;                  /*!< Bitmask of pads to scan, e.g. BIT(TOUCH_PAD_NUM5) */
+    uint32_t interval_ms;                   /*!< Scan interval in milliseconds */
+    uint32_t filter_factor;                 /*!< IIR filter coefficient k: out = (in + (k-1)*out)/k. 0 or 1 disables filtering */
+    uint32_t change_threshold;              /*!< Invoke the callback when a filtered value moves by at least this much.
+                                                 0 disables callbacks */
+    uint32_t ring_depth;                    /*!< Number of scan frames kept in the result ring, power of two.
+                                                 When full, the oldest frame is overwritten */
+    touch_pad_scan_cb_t callback;           /*!< Change callback, may be NULL */
+    void *callback_arg;                     /*!< Argument passed to the change callback */
+} touch_pad_scan_config_t;
+
+/**
+ * @brief Start hardware-timer-driven continuous scanning of the touch pads.
+ *
+ * Every interval_ms a periodic esp_timer reads all pads in channel_mask,
+ * applies the IIR filter, and deposits one frame into the result ring.
+ * Applications consume readings with touch_pad_scan_read() (batched history)
+ * or touch_pad_scan_get_latest(), and can track gestures purely from the
+ * change callbacks instead of running a polling task.
+ *
+ * @note The touch pads must already be initialized and configured
+ *       (touch_pad_init(), touch_pad_config(), FSM in timer mode) before
+ *       the scan is started.
+ *
+ * @param scan_config scan configuration, copied by this function
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if the configuration is invalid
+ *      - ESP_ERR_INVALID_STATE if a scan is already running
+ *      - ESP_ERR_NO_MEM if the result ring can not be allocated
+ */
+esp_err_t touch_pad_scan_start(const touch_pad_scan_config_t *scan_config);
+
+/**
+ * @brief Stop the continuous scan and release the result ring.
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_STATE if no scan is running
+ */
+esp_err_t touch_pad_scan_stop(void);
+
+/**
+ * @brief Drain accumulated scan frames from the result ring, oldest first.
+ *
+ * If the consumer has fallen more than ring_depth frames behind, the
+ * overwritten frames are silently skipped.
+ *
+ * @param frames destination array
+ * @param max_frames capacity of the destination array
+ * @return number of frames copied, 0 if no scan is running or no new frames
+ */
+size_t touch_pad_scan_read(touch_pad_scan_frame_t *frames, size_t max_frames);
+
+/**
+ * @brief Get the most recent scan frame without consuming ring entries.
+ * @param frame destination for the frame
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_STATE if no scan is running or no frame was captured yet
+ *      - ESP_ERR_INVALID_ARG if frame is NULL
+ */
+esp_err_t touch_pad_scan_get_latest(touch_pad_scan_frame_t *frame);
+
 #ifdef __cplusplus
 }
 #endif
@@ -74,6 +74,8 @@ extern "C" {
 
 #define TWAI_IO_UNUSED                   ((gpio_num_t) -1)   /**< Marks GPIO as unused in TWAI configuration */
 
+#define TWAI_RX_FILTER_NUM_MAX           (4)     /**< Maximum number of RX routing filters that can be added */
+
 /* ----------------------- Enum and Struct Definitions ---------------------- */
 
 /**
@@ -119,6 +121,20 @@ typedef struct {
     uint32_t bus_error_count;       /**< Number of instances a bus error has occurred */
 } twai_status_info_t;
 
+/**
+ * @brief   Structure for configuration of an RX routing filter
+ *
+ * Received messages whose identifier matches the filter (i.e., all identifier
+ * bits selected by the mask are equal) are routed to the filter's own queue
+ * instead of the main RX queue.
+ */
+typedef struct {
+    uint32_t identifier;            /**< Identifier to match against */
+    uint32_t mask;                  /**< Bit mask of identifier bits that must match. Set to all ones to match a single identifier */
+    bool extd;                      /**< True to match Extended Frame Format (29bit ID), false for Standard Frame Format (11bit ID) */
+    uint32_t queue_len;             /**< Number of messages the filter's queue can hold */
+} twai_rx_filter_config_t;
+
 /* ------------------------------ Public API -------------------------------- */
 
 /**
@@ -225,6 +241,35 @@ esp_err_t twai_stop(void);
  */
 esp_err_t twai_transmit(const twai_message_t *message, TickType_t ticks_to_wait);
 
+/**
+ * @brief   Transmit multiple TWAI messages back to back
+ *
+ * This function queues multiple messages for transmission in a single call.
+ * Queued messages are chained directly out of the TX queue by the driver's
+ * interrupt handler, thus the messages are transmitted back to back without
+ * returning to task context in between. If the TX queue fills up, this function
+ * will block until space becomes available or until it times out, in which case
+ * the remaining messages are not queued. This function can only be called when
+ * the TWAI driver is in the running state and cannot be called under Listen
+ * Only Mode.
+ *
+ * @param[in]   message_count   Number of messages to transmit
+ * @param[in]   messages        Array of message_count messages to transmit
+ * @param[out]  messages_queued Number of messages successfully queued. Set to NULL if unused
+ * @param[in]   ticks_to_wait   Number of FreeRTOS ticks to block on the TX queue per message
+ *
+ * @note    This function requires the TX queue to be enabled (TX queue
+ *          length > 0 in configuration)
+ *
+ * @return
+ *      - ESP_OK: All messages successfully queued/initiated
+ *      - ESP_ERR_INVALID_ARG: Arguments are invalid
+ *      - ESP_ERR_TIMEOUT: Timed out waiting for space on TX queue
+ *      - ESP_ERR_INVALID_STATE: TWAI driver is not in running state, or is not installed
+ *      - ESP_ERR_NOT_SUPPORTED: Listen Only Mode does not support transmissions, or TX queue is disabled
+ */
+esp_err_t twai_transmit_multiple(const twai_message_t *messages, size_t message_count, size_t *messages_queued, TickType_t ticks_to_wait);
+
 /**
  * @brief   Receive a TWAI message
  *
@@ -246,6 +291,73 @@ esp_err_t twai_transmit(const twai_message_t *message, TickType_t ticks_to_wait)
  */
 esp_err_t twai_receive(twai_message_t *message, TickType_t ticks_to_wait);
 
+/**
+ * @brief   Add an RX routing filter
+ *
+ * This function adds a routing filter with its own receive queue. Received
+ * messages matching the filter are routed to that queue by the driver's
+ * interrupt handler and can be read using twai_receive_filtered(); they will
+ * not appear on the main RX queue. Filters are evaluated in the order they
+ * were added, and messages matching no filter are delivered to the main RX
+ * queue as usual. Up to TWAI_RX_FILTER_NUM_MAX filters can be added.
+ *
+ * @note    The TWAI controller has a single hardware acceptance filter
+ *          (configured during installation). Routing filters are applied in
+ *          software to messages that pass the hardware filter.
+ *
+ * @note    The RX_QUEUE_FULL alert is also raised when a filter's queue
+ *          overflows, and such messages count towards rx_missed_count.
+ *
+ * @param[in]   filter_config   Routing filter configuration
+ * @param[out]  filter_handle   Handle of the added filter
+ *
+ * @return
+ *      - ESP_OK: Filter successfully added
+ *      - ESP_ERR_INVALID_ARG: Arguments are invalid
+ *      - ESP_ERR_NO_MEM: Insufficient memory for the filter's queue
+ *      - ESP_ERR_NOT_FOUND: All filter slots are occupied
+ *      - ESP_ERR_INVALID_STATE: TWAI driver is not installed
+ */
+esp_err_t twai_add_rx_filter(const twai_rx_filter_config_t *filter_config, int *filter_handle);
+
+/**
+ * @brief   Remove an RX routing filter
+ *
+ * This function removes a previously added routing filter, freeing its queue.
+ * Any unread messages on the filter's queue are discarded.
+ *
+ * @warning The application must ensure that no tasks are blocked on the
+ *          filter's queue (i.e., in twai_receive_filtered()) when this
+ *          function is called.
+ *
+ * @param[in]   filter_handle   Handle of the filter to remove
+ *
+ * @return
+ *      - ESP_OK: Filter successfully removed
+ *      - ESP_ERR_INVALID_ARG: Filter handle is invalid
+ *      - ESP_ERR_INVALID_STATE: TWAI driver is not installed
+ */
+esp_err_t twai_remove_rx_filter(int filter_handle);
+
+/**
+ * @brief   Receive a TWAI message from a routing filter's queue
+ *
+ * This function receives a message from the queue of a routing filter added
+ * with twai_add_rx_filter(). This function will block if there are no messages
+ * in the filter's queue.
+ *
+ * @param[in]   filter_handle   Handle of the filter to receive from
+ * @param[out]  message         Received message
+ * @param[in]   ticks_to_wait   Number of FreeRTOS ticks to block on the filter's queue
+ *
+ * @return
+ *      - ESP_OK: Message successfully received from the filter's queue
+ *      - ESP_ERR_TIMEOUT: Timed out waiting for message
+ *      - ESP_ERR_INVALID_ARG: Arguments are invalid
+ *      - ESP_ERR_INVALID_STATE: TWAI driver is not installed
+ */
+esp_err_t twai_receive_filtered(int filter_handle, twai_message_t *message, TickType_t ticks_to_wait);
+
 /**
  * @brief   Read TWAI driver alerts
  *
@@ -864,6 +864,53 @@ esp_err_t uart_set_loop_back(uart_port_t uart_num, bool loop_back_en);
   */
 void uart_set_always_rx_timeout(uart_port_t uart_num, bool always_rx_timeout_en);
 
+/**
+  * @brief Switch UART reception to DMA (UHCI) mode. (ESP32 only)
+  *
+  * In this mode the UHCI DMA engine moves received data from the UART FIFO into
+  * a chain of DMA buffers and raises one interrupt per completed buffer (or per
+  * idle period on the line), instead of one interrupt per RX FIFO threshold.
+  * This keeps the CPU cost of multi-megabaud streams close to zero. Completed
+  * buffers are delivered through the driver's RX ring buffer, so `uart_read_bytes()`,
+  * `uart_get_buffered_data_len()` and the UART_DATA events work as usual.
+  *
+  * @note There is only one UHCI unit available for this purpose, so RX DMA can be
+  *       enabled on at most one UART port at a time.
+  * @note Pattern detection and `uart_intr_config()` RX thresholds have no effect
+  *       while DMA mode is active. If the RX ring buffer is full, a completed DMA
+  *       buffer is dropped and a UART_BUFFER_FULL event is sent.
+  *
+  * @param uart_num UART port number. The driver must already be installed on this port.
+  * @param dma_buf_count Number of DMA buffers, at least 2.
+  * @param dma_buf_len Size of each DMA buffer in bytes, a multiple of 4, at most 4092.
+  *                    A completed buffer is delivered as one unit, so smaller buffers
+  *                    lower the delivery latency and larger ones lower the interrupt rate.
+  *
+  * @return
+  *     - ESP_OK on success
+  *     - ESP_ERR_INVALID_ARG Parameter error
+  *     - ESP_ERR_INVALID_STATE Driver not installed, or the UHCI unit is already in use
+  *     - ESP_ERR_NO_MEM Not enough DMA capable memory
+  *     - ESP_ERR_NOT_SUPPORTED The target has no UHCI support in this driver
+  */
+esp_err_t uart_enable_rx_dma(uart_port_t uart_num, int dma_buf_count, int dma_buf_len);
+
+/**
+  * @brief Switch UART reception back from DMA (UHCI) mode to the default
+  *        interrupt driven mode and free the DMA buffers.
+  *
+  * Called automatically by `uart_driver_delete()` if RX DMA is still enabled.
+  *
+  * @param uart_num UART port number on which `uart_enable_rx_dma()` was called.
+  *
+  * @return
+  *     - ESP_OK on success
+  *     - ESP_ERR_INVALID_ARG Parameter error
+  *     - ESP_ERR_INVALID_STATE RX DMA is not enabled on this port
+  *     - ESP_ERR_NOT_SUPPORTED The target has no UHCI support in this driver
+  */
+esp_err_t uart_disable_rx_dma(uart_port_t uart_num);
+
 #ifdef __cplusplus
 }
 #endif
@@ -34,6 +34,13 @@ static const char* LEDC_TAG = "ledc";
     }
 #define LEDC_ARG_CHECK(a, param) LEDC_CHECK(a, param " argument is invalid", ESP_ERR_INVALID_ARG)
 
+//One pre-computed fade segment of a chain, consumed by the fade ISR
+typedef struct {
+    uint32_t target_duty;
+    int cycle_num;
+    int scale;
+} ledc_fade_chain_seg_t;
+
 typedef struct {
     ledc_mode_t speed_mode;
     ledc_duty_direction_t direction;
@@ -46,6 +53,9 @@ typedef struct {
 #if CONFIG_SPIRAM_USE_MALLOC
     StaticQueue_t ledc_fade_sem_storage;
 #endif
+    ledc_fade_chain_seg_t *chain;   //segment queue of the running chain, NULL if never used
+    uint32_t chain_len;             //number of segments in chain
+    volatile uint32_t chain_next;   //next segment to load, == chain_len when no chain is pending
 } ledc_fade_t;
 
 typedef struct {
@@ -69,6 +79,7 @@ static portMUX_TYPE ledc_spinlock = portMUX_INITIALIZER_UNLOCKED;
 #define SLOW_CLK_CYC_CALIBRATE    (13)
 #define LEDC_FADE_TOO_SLOW_STR    "LEDC FADE TOO SLOW"
 #define LEDC_FADE_TOO_FAST_STR    "LEDC FADE TOO FAST"
+#define LEDC_FADE_CHAIN_SEG_MAX   (64)
 
 static const char *LEDC_NOT_INIT = "LEDC is not initialized";
 static const char *LEDC_FADE_SERVICE_ERR_STR = "LEDC fade service not installed";
@@ -587,11 +598,23 @@ void IRAM_ATTR ledc_fade_isr(void* arg)
             uint32_t duty_cur = 0;
             ledc_hal_get_duty(&(p_ledc_obj[speed_mode]->ledc_hal), channel, &duty_cur);
             if (duty_cur == s_ledc_fade_rec[speed_mode][channel]->target_duty) {
-                xSemaphoreGiveFromISR(s_ledc_fade_rec[speed_mode][channel]->ledc_fade_sem, &HPTaskAwoken);
-                if (HPTaskAwoken == pdTRUE) {
-                    portYIELD_FROM_ISR();
+                if (s_ledc_fade_rec[speed_mode][channel]->chain != NULL
+                    && s_ledc_fade_rec[speed_mode][channel]->chain_next < s_ledc_fade_rec[speed_mode][channel]->chain_len) {
+                    //Load the next pre-computed segment of the chain and fall through to the
+                    //re-programming below; the fade semaphore is given at the end of the chain only.
+                    const ledc_fade_chain_seg_t *seg = &s_ledc_fade_rec[speed_mode][channel]->chain[s_ledc_fade_rec[speed_mode][channel]->chain_next++];
+                    s_ledc_fade_rec[speed_mode][channel]->target_duty = seg->target_duty;
+                    s_ledc_fade_rec[speed_mode][channel]->cycle_num = seg->cycle_num;
+                    s_ledc_fade_rec[speed_mode][channel]->scale = seg->scale;
+                    s_ledc_fade_rec[speed_mode][channel]->direction = seg->target_duty > duty_cur ?
+                            LEDC_DUTY_DIR_INCREASE : LEDC_DUTY_DIR_DECREASE;
+                } else {
+                    xSemaphoreGiveFromISR(s_ledc_fade_rec[speed_mode][channel]->ledc_fade_sem, &HPTaskAwoken);
+                    if (HPTaskAwoken == pdTRUE) {
+                        portYIELD_FROM_ISR();
+                    }
+                    continue;
                 }
-                continue;
             }
             uint32_t duty_tar = s_ledc_fade_rec[speed_mode][channel]->target_duty;
             int scale = s_ledc_fade_rec[speed_mode][channel]->scale;
@@ -641,6 +664,10 @@ static esp_err_t ledc_fade_channel_deinit(ledc_mode_t speed_mode, ledc_channel_t
             vSemaphoreDelete(s_ledc_fade_rec[speed_mode][channel]->ledc_fade_sem);
             s_ledc_fade_rec[speed_mode][channel]->ledc_fade_sem = NULL;
         }
+        if (s_ledc_fade_rec[speed_mode][channel]->chain) {
+            heap_caps_free(s_ledc_fade_rec[speed_mode][channel]->chain);
+            s_ledc_fade_rec[speed_mode][channel]->chain = NULL;
+        }
         free(s_ledc_fade_rec[speed_mode][channel]);
         s_ledc_fade_rec[speed_mode][channel] = NULL;
     }
@@ -693,6 +720,8 @@ static esp_err_t _ledc_set_fade_with_step(ledc_mode_t speed_mode, ledc_channel_t
     s_ledc_fade_rec[speed_mode][channel]->target_duty = target_duty;
     s_ledc_fade_rec[speed_mode][channel]->cycle_num = cycle_num;
     s_ledc_fade_rec[speed_mode][channel]->scale = scale;
+    //A plain fade disarms any chain segments left over from a previous chain
+    s_ledc_fade_rec[speed_mode][channel]->chain_next = s_ledc_fade_rec[speed_mode][channel]->chain_len;
     int step_num = 0;
     int dir = LEDC_DUTY_DIR_DECREASE;
     if (scale > 0) {
@@ -894,3 +923,90 @@ esp_err_t ledc_set_fade_step_and_start(ledc_mode_t speed_mode, ledc_channel_t ch
     _ledc_op_lock_release(speed_mode, channel);
     return ESP_OK;
 }
+
+esp_err_t ledc_set_fade_chain_and_start(ledc_mode_t speed_mode, ledc_channel_t channel, const ledc_fade_segment_t *segments,
+                                        uint32_t num_segments, ledc_fade_mode_t fade_mode)
+{
+    LEDC_ARG_CHECK(speed_mode < LEDC_SPEED_MODE_MAX, "speed_mode");
+    LEDC_ARG_CHECK(channel < LEDC_CHANNEL_MAX, "channel");
+    LEDC_ARG_CHECK(fade_mode < LEDC_FADE_MAX, "fade_mode");
+    LEDC_ARG_CHECK(segments != NULL, "segments");
+    LEDC_ARG_CHECK((num_segments > 0) && (num_segments <= LEDC_FADE_CHAIN_SEG_MAX), "num_segments");
+    LEDC_CHECK(p_ledc_obj[speed_mode] != NULL, LEDC_NOT_INIT, ESP_ERR_INVALID_STATE);
+    LEDC_CHECK(ledc_fade_channel_init_check(speed_mode, channel) == ESP_OK , LEDC_FADE_INIT_ERROR_STR, ESP_FAIL);
+    for (uint32_t i = 0; i < num_segments; i++) {
+        LEDC_ARG_CHECK(segments[i].target_duty <= ledc_get_max_duty(speed_mode, channel), "target_duty");
+        LEDC_ARG_CHECK(segments[i].time_ms > 0, "time_ms");
+    }
+
+    //The chain is read from the fade ISR, keep it in internal memory
+    ledc_fade_chain_seg_t *chain = (ledc_fade_chain_seg_t *) heap_caps_calloc(num_segments, sizeof(ledc_fade_chain_seg_t),
+                                                                              MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (chain == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    _ledc_op_lock_acquire(speed_mode, channel);
+    _ledc_fade_hw_acquire(speed_mode, channel);
+
+    //Pre-compute scale and cycle count of every segment here, so the fade ISR only has to
+    //copy them into the channel record when it chains to the next segment. Each segment
+    //starts at the target duty of the previous one, so the step parameters are fully
+    //determined before the chain starts.
+    ledc_timer_t timer_sel;
+    ledc_hal_get_channel_timer(&(p_ledc_obj[speed_mode]->ledc_hal), channel, &timer_sel);
+    uint32_t freq = ledc_get_freq(speed_mode, timer_sel);
+    uint32_t duty_prev = 0;
+    ledc_hal_get_duty(&(p_ledc_obj[speed_mode]->ledc_hal), channel, &duty_prev);
+    for (uint32_t i = 0; i < num_segments; i++) {
+        uint32_t duty_tar = segments[i].target_duty;
+        uint32_t duty_delta = duty_tar > duty_prev ? duty_tar - duty_prev : duty_prev - duty_tar;
+        if (duty_delta == 0) {
+            //the fade hardware can only chain on a duty change
+            _ledc_fade_hw_release(speed_mode, channel);
+            _ledc_op_lock_release(speed_mode, channel);
+            heap_caps_free(chain);
+            LEDC_ARG_CHECK(false, "chain segment duty");
+        }
+        int total_cycles = segments[i].time_ms * freq / 1000;
+        if (total_cycles == 0) {
+            ESP_LOGW(LEDC_TAG, LEDC_FADE_TOO_FAST_STR);
+            total_cycles = 1;
+        }
+        int scale, cycle_num;
+        if (total_cycles > duty_delta) {
+            scale = 1;
+            cycle_num = total_cycles / duty_delta;
+            if (cycle_num > LEDC_DUTY_NUM_MAX) {
+                ESP_LOGW(LEDC_TAG, LEDC_FADE_TOO_SLOW_STR);
+                cycle_num = LEDC_DUTY_NUM_MAX;
+            }
+        } else {
+            cycle_num = 1;
+            scale = duty_delta / total_cycles;
+            if (scale > LEDC_DUTY_SCALE_MAX) {
+                ESP_LOGW(LEDC_TAG, LEDC_FADE_TOO_FAST_STR);
+                scale = LEDC_DUTY_SCALE_MAX;
+            }
+        }
+        chain[i].target_duty = duty_tar;
+        chain[i].cycle_num = cycle_num;
+        chain[i].scale = scale;
+        duty_prev = duty_tar;
+    }
+
+    //Program the first segment into the hardware; the remaining ones are armed below and
+    //loaded back-to-back by the fade ISR, with one completion event for the whole chain.
+    _ledc_set_fade_with_step(speed_mode, channel, chain[0].target_duty, chain[0].scale, chain[0].cycle_num);
+    ledc_fade_chain_seg_t *old_chain = s_ledc_fade_rec[speed_mode][channel]->chain;
+    s_ledc_fade_rec[speed_mode][channel]->chain = chain;
+    s_ledc_fade_rec[speed_mode][channel]->chain_len = num_segments;
+    s_ledc_fade_rec[speed_mode][channel]->chain_next = 1;
+    heap_caps_free(old_chain);
+    _ledc_fade_start(speed_mode, channel, fade_mode);
+    if (fade_mode == LEDC_FADE_WAIT_DONE) {
+        _ledc_fade_hw_release(speed_mode, channel);
+    }
+    _ledc_op_lock_release(speed_mode, channel);
+    return ESP_OK;
+}
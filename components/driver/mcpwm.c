@@ -54,7 +54,13 @@ static const char *MCPWM_TAG = "MCPWM";
 #define MCPWM_GPIO_ERROR        "MCPWM GPIO NUM ERROR"
 #define MCPWM_GEN_ERROR         "MCPWM GENERATOR ERROR"
 #define MCPWM_DB_ERROR          "MCPWM DEADTIME TYPE ERROR"
+#define MCPWM_CAP_SIG_ERROR     "MCPWM CAPTURE SIGNAL ERROR"
+#define MCPWM_CAP_RING_ERROR    "MCPWM CAPTURE RING SIZE ERROR"
+#define MCPWM_CAP_STREAM_ERROR  "MCPWM CAPTURE STREAM STATE ERROR"
+#define MCPWM_DUTY_TABLE_ERROR  "MCPWM DUTY TABLE STATE ERROR"
+#define MCPWM_DUTY_TABLE_LEN_ERROR "MCPWM DUTY TABLE LENGTH ERROR"
 
+#define MCPWM_CAP_SIG_NUM 3       //Capture signals per MCPWM unit
 #define MCPWM_CLK_PRESCL 15       //MCPWM clock prescale
 #define TIMER_CLK_PRESCALE 9      //MCPWM timer prescales
 #define MCPWM_CLK (MCPWM_BASE_CLK/(MCPWM_CLK_PRESCL +1))
@@ -245,6 +251,69 @@ esp_err_t mcpwm_set_duty_type(mcpwm_unit_t mcpwm_num, mcpwm_timer_t timer_num, m
 }
 
 
+typedef struct {
+    float duty[SOC_MCPWM_TIMER_NUM][SOC_MCPWM_GENERATOR_NUM];
+    uint32_t freq[SOC_MCPWM_TIMER_NUM];
+    uint8_t duty_staged[SOC_MCPWM_TIMER_NUM];   //bitmask, BIT(gen) set when a duty is staged
+    uint8_t freq_staged;                        //bitmask, BIT(timer) set when a frequency is staged
+} mcpwm_update_group_t;
+
+static mcpwm_update_group_t s_update_group[SOC_MCPWM_PERIPH_NUM];
+
+esp_err_t mcpwm_update_group_set_duty(mcpwm_unit_t mcpwm_num, mcpwm_timer_t timer_num, mcpwm_generator_t gen, float duty)
+{
+    MCPWM_GEN_CHECK(mcpwm_num, timer_num, gen);
+
+    mcpwm_critical_enter(mcpwm_num);
+    s_update_group[mcpwm_num].duty[timer_num][gen] = duty;
+    s_update_group[mcpwm_num].duty_staged[timer_num] |= BIT(gen);
+    mcpwm_critical_exit(mcpwm_num);
+    return ESP_OK;
+}
+
+esp_err_t mcpwm_update_group_set_frequency(mcpwm_unit_t mcpwm_num, mcpwm_timer_t timer_num, uint32_t frequency)
+{
+    MCPWM_TIMER_CHECK(mcpwm_num, timer_num);
+
+    mcpwm_critical_enter(mcpwm_num);
+    s_update_group[mcpwm_num].freq[timer_num] = frequency;
+    s_update_group[mcpwm_num].freq_staged |= BIT(timer_num);
+    mcpwm_critical_exit(mcpwm_num);
+    return ESP_OK;
+}
+
+esp_err_t mcpwm_update_group_commit(mcpwm_unit_t mcpwm_num)
+{
+    MCPWM_CHECK(mcpwm_num < SOC_MCPWM_PERIPH_NUM, MCPWM_UNIT_NUM_ERROR, ESP_ERR_INVALID_ARG);
+    MCPWM_CHECK(context[mcpwm_num].hal.dev != NULL, MCPWM_DRIVER_INIT_ERROR, ESP_ERR_INVALID_STATE);
+    mcpwm_hal_context_t *hal = &context[mcpwm_num].hal;
+    mcpwm_update_group_t *group = &s_update_group[mcpwm_num];
+
+    //all staged values are written inside one critical section, so the shadow registers of
+    //every timer latch them on the same (synchronized) period boundary
+    mcpwm_critical_enter(mcpwm_num);
+    for (int timer_num = 0; timer_num < SOC_MCPWM_TIMER_NUM; timer_num++) {
+        //the driver currently always use the timer x for operator x
+        const int op = timer_num;
+        if (group->freq_staged & BIT(timer_num)) {
+            hal->timer[timer_num].freq = group->freq[timer_num];
+            mcpwm_hal_timer_update_basic(hal, timer_num);
+            mcpwm_hal_operator_update_basic(hal, op);
+        }
+        for (int gen = 0; gen < SOC_MCPWM_GENERATOR_NUM; gen++) {
+            //the driver currently always use the comparator A for PWMxA output, and comparator B for PWMxB output
+            if (group->duty_staged[timer_num] & BIT(gen)) {
+                hal->op[op].duty[gen] = group->duty[timer_num][gen];
+                mcpwm_hal_operator_update_comparator(hal, op, gen);
+            }
+        }
+        group->duty_staged[timer_num] = 0;
+    }
+    group->freq_staged = 0;
+    mcpwm_critical_exit(mcpwm_num);
+    return ESP_OK;
+}
+
 esp_err_t mcpwm_init(mcpwm_unit_t mcpwm_num, mcpwm_timer_t timer_num, const mcpwm_config_t *mcpwm_conf)
 {
     //the driver currently always use the timer x for operator x
@@ -586,6 +655,259 @@ uint32_t mcpwm_capture_signal_get_edge(mcpwm_unit_t mcpwm_num, mcpwm_capture_sig
     return (edge == MCPWM_NEG_EDGE? 2: 1);
 }
 
+typedef struct {
+    mcpwm_capture_event_t *ring;  //ring buffer, NULL while the stream is disabled
+    uint32_t ring_entries;        //ring capacity, power of two
+    volatile uint32_t write_idx;  //only advanced from the ISR
+    volatile uint32_t read_idx;   //only advanced from mcpwm_capture_stream_read()
+    volatile uint32_t overruns;   //edges dropped because the ring was full
+} mcpwm_cap_stream_t;
+
+typedef struct {
+    uint32_t *compare_values;     //pre-computed compare values (timer ticks), NULL while playback is stopped
+    uint32_t len;                 //number of entries in compare_values
+    volatile uint32_t index;      //next entry to load, only advanced from the ISR
+    int cmp;                      //comparator driven by the table
+} mcpwm_duty_table_t;
+
+typedef struct {
+    mcpwm_unit_t unit;
+    intr_handle_t intr_handle;
+    mcpwm_cap_stream_t stream[MCPWM_CAP_SIG_NUM];
+    mcpwm_duty_table_t table[SOC_MCPWM_TIMER_NUM];
+} mcpwm_isr_ctx_t;
+
+static mcpwm_isr_ctx_t s_mcpwm_isr[SOC_MCPWM_PERIPH_NUM];
+
+static void IRAM_ATTR mcpwm_driver_isr(void *arg)
+{
+    mcpwm_isr_ctx_t *ctx = (mcpwm_isr_ctx_t *)arg;
+    mcpwm_dev_t *dev = context[ctx->unit].hal.dev;
+    const mcpwm_intr_t status = mcpwm_ll_get_intr(dev);
+    for (int timer = 0; timer < SOC_MCPWM_TIMER_NUM; timer++) {
+        const mcpwm_intr_t tez_intr = mcpwm_ll_get_tez_intr_def(timer);
+        if (!(status & tez_intr)) {
+            continue;
+        }
+        mcpwm_ll_clear_intr(dev, tez_intr);
+        mcpwm_duty_table_t *table = &ctx->table[timer];
+        if (table->compare_values == NULL) {
+            continue;
+        }
+        //the compare shadow register latches the new value at the next TEZ, one table entry per period
+        mcpwm_ll_operator_set_compare(dev, timer, table->cmp, table->compare_values[table->index]);
+        table->index++;
+        if (table->index >= table->len) {
+            table->index = 0;
+        }
+    }
+    for (int cap_sig = 0; cap_sig < MCPWM_CAP_SIG_NUM; cap_sig++) {
+        const mcpwm_intr_t cap_intr = mcpwm_ll_get_cap_intr_def(cap_sig);
+        if (!(status & cap_intr)) {
+            continue;
+        }
+        mcpwm_ll_clear_intr(dev, cap_intr);
+        mcpwm_cap_stream_t *stream = &ctx->stream[cap_sig];
+        if (stream->ring == NULL) {
+            continue;
+        }
+        const uint32_t cap_value = mcpwm_ll_get_capture_val(dev, cap_sig);
+        const mcpwm_capture_on_edge_t edge = mcpwm_ll_get_captured_edge(dev, cap_sig);
+        if (stream->write_idx - stream->read_idx >= stream->ring_entries) {
+            stream->overruns++;
+            continue;
+        }
+        mcpwm_capture_event_t *event = &stream->ring[stream->write_idx & (stream->ring_entries - 1)];
+        event->cap_value = cap_value;
+        event->cap_edge = (edge == MCPWM_NEG_EDGE? 2: 1);
+        //Fill the entry before publishing it to the reader
+        stream->write_idx++;
+    }
+}
+
+//Allocate the driver-owned unit interrupt if no capture stream or duty table claimed it yet
+static esp_err_t mcpwm_driver_intr_claim(mcpwm_unit_t mcpwm_num)
+{
+    if (s_mcpwm_isr[mcpwm_num].intr_handle != NULL) {
+        return ESP_OK;
+    }
+    s_mcpwm_isr[mcpwm_num].unit = mcpwm_num;
+    return esp_intr_alloc((ETS_PWM0_INTR_SOURCE + mcpwm_num), ESP_INTR_FLAG_IRAM, mcpwm_driver_isr,
+                          &s_mcpwm_isr[mcpwm_num], &s_mcpwm_isr[mcpwm_num].intr_handle);
+}
+
+//Free the driver-owned unit interrupt once the last capture stream or duty table is gone
+static void mcpwm_driver_intr_release(mcpwm_unit_t mcpwm_num)
+{
+    for (int sig = 0; sig < MCPWM_CAP_SIG_NUM; sig++) {
+        if (s_mcpwm_isr[mcpwm_num].stream[sig].ring != NULL) {
+            return;
+        }
+    }
+    for (int timer = 0; timer < SOC_MCPWM_TIMER_NUM; timer++) {
+        if (s_mcpwm_isr[mcpwm_num].table[timer].compare_values != NULL) {
+            return;
+        }
+    }
+    if (s_mcpwm_isr[mcpwm_num].intr_handle != NULL) {
+        esp_intr_free(s_mcpwm_isr[mcpwm_num].intr_handle);
+        s_mcpwm_isr[mcpwm_num].intr_handle = NULL;
+    }
+}
+
+esp_err_t mcpwm_capture_stream_enable(mcpwm_unit_t mcpwm_num, mcpwm_capture_signal_t cap_sig,
+                                      mcpwm_capture_on_edge_t cap_edge, uint32_t num_of_pulse, uint32_t ring_entries)
+{
+    MCPWM_CHECK(mcpwm_num < SOC_MCPWM_PERIPH_NUM, MCPWM_UNIT_NUM_ERROR, ESP_ERR_INVALID_ARG);
+    MCPWM_CHECK(cap_sig < MCPWM_CAP_SIG_NUM, MCPWM_CAP_SIG_ERROR, ESP_ERR_INVALID_ARG);
+    MCPWM_CHECK(ring_entries >= 2 && ring_entries <= 4096, MCPWM_CAP_RING_ERROR, ESP_ERR_INVALID_ARG);
+    MCPWM_CHECK(s_mcpwm_isr[mcpwm_num].stream[cap_sig].ring == NULL, MCPWM_CAP_STREAM_ERROR, ESP_ERR_INVALID_STATE);
+
+    //round the ring capacity up to a power of two so the indices can wrap freely
+    uint32_t entries = 2;
+    while (entries < ring_entries) {
+        entries <<= 1;
+    }
+    mcpwm_capture_event_t *ring = (mcpwm_capture_event_t *) heap_caps_malloc(entries * sizeof(mcpwm_capture_event_t),
+                                                                             MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (ring == NULL) {
+        ESP_LOGE(MCPWM_TAG, "MCPWM driver malloc error");
+        return ESP_ERR_NO_MEM;
+    }
+
+    esp_err_t ret = mcpwm_capture_enable(mcpwm_num, cap_sig, cap_edge, num_of_pulse);
+    if (ret != ESP_OK) {
+        heap_caps_free(ring);
+        return ret;
+    }
+
+    ret = mcpwm_driver_intr_claim(mcpwm_num);
+    if (ret != ESP_OK) {
+        heap_caps_free(ring);
+        return ret;
+    }
+
+    mcpwm_cap_stream_t *stream = &s_mcpwm_isr[mcpwm_num].stream[cap_sig];
+    mcpwm_critical_enter(mcpwm_num);
+    stream->ring_entries = entries;
+    stream->write_idx = 0;
+    stream->read_idx = 0;
+    stream->overruns = 0;
+    stream->ring = ring;
+    //drop any capture latched before the stream was armed
+    mcpwm_ll_clear_intr(context[mcpwm_num].hal.dev, mcpwm_ll_get_cap_intr_def(cap_sig));
+    mcpwm_ll_intr_enable(context[mcpwm_num].hal.dev, mcpwm_ll_get_cap_intr_def(cap_sig), true);
+    mcpwm_critical_exit(mcpwm_num);
+    return ESP_OK;
+}
+
+esp_err_t mcpwm_capture_stream_read(mcpwm_unit_t mcpwm_num, mcpwm_capture_signal_t cap_sig,
+                                    mcpwm_capture_event_t *events, uint32_t max_events, uint32_t *num_events)
+{
+    MCPWM_CHECK(mcpwm_num < SOC_MCPWM_PERIPH_NUM, MCPWM_UNIT_NUM_ERROR, ESP_ERR_INVALID_ARG);
+    MCPWM_CHECK(cap_sig < MCPWM_CAP_SIG_NUM, MCPWM_CAP_SIG_ERROR, ESP_ERR_INVALID_ARG);
+    MCPWM_CHECK(events != NULL && num_events != NULL, MCPWM_PARAM_ADDR_ERROR, ESP_ERR_INVALID_ARG);
+    mcpwm_cap_stream_t *stream = &s_mcpwm_isr[mcpwm_num].stream[cap_sig];
+    MCPWM_CHECK(stream->ring != NULL, MCPWM_CAP_STREAM_ERROR, ESP_ERR_INVALID_STATE);
+
+    uint32_t count = 0;
+    while (count < max_events && stream->read_idx != stream->write_idx) {
+        events[count++] = stream->ring[stream->read_idx & (stream->ring_entries - 1)];
+        stream->read_idx++;
+    }
+    *num_events = count;
+    return ESP_OK;
+}
+
+uint32_t mcpwm_capture_stream_get_overrun_count(mcpwm_unit_t mcpwm_num, mcpwm_capture_signal_t cap_sig)
+{
+    MCPWM_CHECK(mcpwm_num < SOC_MCPWM_PERIPH_NUM, MCPWM_UNIT_NUM_ERROR, 0);
+    MCPWM_CHECK(cap_sig < MCPWM_CAP_SIG_NUM, MCPWM_CAP_SIG_ERROR, 0);
+    return s_mcpwm_isr[mcpwm_num].stream[cap_sig].overruns;
+}
+
+esp_err_t mcpwm_capture_stream_disable(mcpwm_unit_t mcpwm_num, mcpwm_capture_signal_t cap_sig)
+{
+    MCPWM_CHECK(mcpwm_num < SOC_MCPWM_PERIPH_NUM, MCPWM_UNIT_NUM_ERROR, ESP_ERR_INVALID_ARG);
+    MCPWM_CHECK(cap_sig < MCPWM_CAP_SIG_NUM, MCPWM_CAP_SIG_ERROR, ESP_ERR_INVALID_ARG);
+    mcpwm_cap_stream_t *stream = &s_mcpwm_isr[mcpwm_num].stream[cap_sig];
+    MCPWM_CHECK(stream->ring != NULL, MCPWM_CAP_STREAM_ERROR, ESP_ERR_INVALID_STATE);
+
+    mcpwm_critical_enter(mcpwm_num);
+    mcpwm_ll_intr_enable(context[mcpwm_num].hal.dev, mcpwm_ll_get_cap_intr_def(cap_sig), false);
+    mcpwm_capture_event_t *ring = stream->ring;
+    stream->ring = NULL;
+    stream->ring_entries = 0;
+    stream->write_idx = 0;
+    stream->read_idx = 0;
+    mcpwm_critical_exit(mcpwm_num);
+
+    mcpwm_capture_disable(mcpwm_num, cap_sig);
+    heap_caps_free(ring);
+
+    mcpwm_driver_intr_release(mcpwm_num);
+    return ESP_OK;
+}
+
+esp_err_t mcpwm_duty_table_start(mcpwm_unit_t mcpwm_num, mcpwm_timer_t timer_num, mcpwm_generator_t gen,
+                                 const float *duty_table, uint32_t table_len)
+{
+    MCPWM_GEN_CHECK(mcpwm_num, timer_num, gen);
+    MCPWM_CHECK(duty_table != NULL, MCPWM_PARAM_ADDR_ERROR, ESP_ERR_INVALID_ARG);
+    MCPWM_CHECK(table_len >= 1 && table_len <= 4096, MCPWM_DUTY_TABLE_LEN_ERROR, ESP_ERR_INVALID_ARG);
+    MCPWM_CHECK(s_mcpwm_isr[mcpwm_num].table[timer_num].compare_values == NULL, MCPWM_DUTY_TABLE_ERROR, ESP_ERR_INVALID_STATE);
+    mcpwm_hal_context_t *hal = &context[mcpwm_num].hal;
+
+    uint32_t *compare_values = (uint32_t *) heap_caps_malloc(table_len * sizeof(uint32_t),
+                                                             MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (compare_values == NULL) {
+        ESP_LOGE(MCPWM_TAG, "MCPWM driver malloc error");
+        return ESP_ERR_NO_MEM;
+    }
+    //convert the duty percentages to timer ticks up front, so the ISR only has to write one register
+    const uint32_t period = mcpwm_ll_timer_get_period(hal->dev, timer_num);
+    for (uint32_t i = 0; i < table_len; i++) {
+        compare_values[i] = (uint32_t) ((duty_table[i] * period) / 100);
+    }
+
+    esp_err_t ret = mcpwm_driver_intr_claim(mcpwm_num);
+    if (ret != ESP_OK) {
+        heap_caps_free(compare_values);
+        return ret;
+    }
+
+    mcpwm_duty_table_t *table = &s_mcpwm_isr[mcpwm_num].table[timer_num];
+    mcpwm_critical_enter(mcpwm_num);
+    table->len = table_len;
+    table->index = 0;
+    //the driver currently always use the comparator A for PWMxA output, and comparator B for PWMxB output
+    table->cmp = gen;
+    table->compare_values = compare_values;
+    mcpwm_ll_clear_intr(hal->dev, mcpwm_ll_get_tez_intr_def(timer_num));
+    mcpwm_ll_intr_enable(hal->dev, mcpwm_ll_get_tez_intr_def(timer_num), true);
+    mcpwm_critical_exit(mcpwm_num);
+    return ESP_OK;
+}
+
+esp_err_t mcpwm_duty_table_stop(mcpwm_unit_t mcpwm_num, mcpwm_timer_t timer_num)
+{
+    MCPWM_TIMER_CHECK(mcpwm_num, timer_num);
+    mcpwm_duty_table_t *table = &s_mcpwm_isr[mcpwm_num].table[timer_num];
+    MCPWM_CHECK(table->compare_values != NULL, MCPWM_DUTY_TABLE_ERROR, ESP_ERR_INVALID_STATE);
+
+    mcpwm_critical_enter(mcpwm_num);
+    mcpwm_ll_intr_enable(context[mcpwm_num].hal.dev, mcpwm_ll_get_tez_intr_def(timer_num), false);
+    uint32_t *compare_values = table->compare_values;
+    table->compare_values = NULL;
+    table->len = 0;
+    table->index = 0;
+    mcpwm_critical_exit(mcpwm_num);
+
+    heap_caps_free(compare_values);
+    mcpwm_driver_intr_release(mcpwm_num);
+    return ESP_OK;
+}
+
 esp_err_t mcpwm_sync_enable(mcpwm_unit_t mcpwm_num, mcpwm_timer_t timer_num, mcpwm_sync_signal_t sync_sig,
                             uint32_t phase_val)
 {
@@ -21,6 +21,7 @@
 #include "driver/pcnt.h"
 #include "hal/pcnt_hal.h"
 #include "esp_rom_gpio.h"
+#include "esp_timer.h"
 
 #define PCNT_CHANNEL_ERR_STR  "PCNT CHANNEL ERROR"
 #define PCNT_UNIT_ERR_STR  "PCNT UNIT ERROR"
@@ -36,6 +37,10 @@
 
 #define PCNT_ENTER_CRITICAL(mux)    portENTER_CRITICAL(mux)
 #define PCNT_EXIT_CRITICAL(mux)     portEXIT_CRITICAL(mux)
+#define PCNT_ENTER_CRITICAL_ISR(mux)    portENTER_CRITICAL_ISR(mux)
+#define PCNT_EXIT_CRITICAL_ISR(mux)     portEXIT_CRITICAL_ISR(mux)
+
+#define PCNT_ACCUM_RATE_WINDOW_DEFAULT_MS  (1000)
 
 static const char *TAG = "pcnt";
 
@@ -65,6 +70,19 @@ static pcnt_isr_func_t *pcnt_isr_func = NULL;
 static pcnt_isr_handle_t pcnt_isr_service = NULL;
 static portMUX_TYPE pcnt_spinlock = portMUX_INITIALIZER_UNLOCKED;
 
+typedef struct {
+    volatile int64_t accum_count;  /*!< counts carried out of the 16-bit counter by limit events */
+    int16_t h_lim;                 /*!< cached high limit, added on a PCNT_EVT_H_LIM event */
+    int16_t l_lim;                 /*!< cached low limit, added on a PCNT_EVT_L_LIM event */
+    bool enabled;                  /*!< accumulation active for this unit */
+    uint32_t rate_window_us;       /*!< minimum time base of the rate computation */
+    int64_t rate_last_count;       /*!< accumulated count at the start of the current window */
+    int64_t rate_last_time_us;     /*!< timestamp of the start of the current window */
+    float rate_last_hz;            /*!< rate of the last completed window */
+} pcnt_accum_t;
+
+static pcnt_accum_t s_pcnt_accum[PCNT_UNIT_MAX];
+
 static inline esp_err_t _pcnt_set_mode(pcnt_port_t pcnt_port, pcnt_unit_t unit, pcnt_channel_t channel, pcnt_count_mode_t pos_mode, pcnt_count_mode_t neg_mode, pcnt_ctrl_mode_t hctrl_mode, pcnt_ctrl_mode_t lctrl_mode)
 {
     PCNT_OBJ_CHECK(pcnt_port);
@@ -293,6 +311,19 @@ static void IRAM_ATTR pcnt_intr_service(void *arg)
         int unit = __builtin_ffs(status) - 1;
         status &= ~(1 << unit);
 
+        if (s_pcnt_accum[unit].enabled) {
+            uint32_t evt_status = pcnt_hal_get_event_status(&(p_pcnt_obj[pcnt_port]->hal), unit);
+            //On a limit event the hardware counter has wrapped to zero, carry the limit
+            //into the 64-bit accumulator
+            PCNT_ENTER_CRITICAL_ISR(&pcnt_spinlock);
+            if (evt_status & PCNT_EVT_H_LIM) {
+                s_pcnt_accum[unit].accum_count += s_pcnt_accum[unit].h_lim;
+            } else if (evt_status & PCNT_EVT_L_LIM) {
+                s_pcnt_accum[unit].accum_count += s_pcnt_accum[unit].l_lim;
+            }
+            PCNT_EXIT_CRITICAL_ISR(&pcnt_spinlock);
+        }
+
         if (pcnt_isr_func[unit].fn != NULL) {
             (pcnt_isr_func[unit].fn)(pcnt_isr_func[unit].args);
         }
@@ -333,6 +364,153 @@ static inline esp_err_t _pcnt_isr_service_uninstall(pcnt_port_t pcnt_port)
     return ret;
 }
 
+//Total count of a unit: 64-bit carry plus the live hardware counter.
+//Must be called with pcnt_spinlock held so the ISR cannot carry in between.
+static inline int64_t _pcnt_accum_read_locked(pcnt_port_t pcnt_port, pcnt_unit_t unit)
+{
+    int16_t count = 0;
+    pcnt_hal_get_counter_value(&(p_pcnt_obj[pcnt_port]->hal), unit, &count);
+    return s_pcnt_accum[unit].accum_count + count;
+}
+
+static inline esp_err_t _pcnt_accum_enable(pcnt_port_t pcnt_port, pcnt_unit_t unit)
+{
+    PCNT_OBJ_CHECK(pcnt_port);
+    PCNT_CHECK(unit < PCNT_UNIT_MAX, PCNT_UNIT_ERR_STR, ESP_ERR_INVALID_ARG);
+    PCNT_CHECK(pcnt_isr_func != NULL, "ISR service is not installed, call pcnt_isr_service_install() first", ESP_ERR_INVALID_STATE);
+
+    int16_t h_lim = 0;
+    int16_t l_lim = 0;
+    pcnt_hal_get_event_value(&(p_pcnt_obj[pcnt_port]->hal), unit, PCNT_EVT_H_LIM, &h_lim);
+    pcnt_hal_get_event_value(&(p_pcnt_obj[pcnt_port]->hal), unit, PCNT_EVT_L_LIM, &l_lim);
+    //the configured counter limits are what the accumulator carries on overflow
+    PCNT_CHECK(h_lim > 0 || l_lim < 0, PCNT_LIMT_VAL_ERR_STR, ESP_ERR_INVALID_STATE);
+
+    if (h_lim > 0) {
+        _pcnt_event_enable(pcnt_port, unit, PCNT_EVT_H_LIM);
+    }
+    if (l_lim < 0) {
+        _pcnt_event_enable(pcnt_port, unit, PCNT_EVT_L_LIM);
+    }
+
+    PCNT_ENTER_CRITICAL(&pcnt_spinlock);
+    s_pcnt_accum[unit].accum_count = 0;
+    s_pcnt_accum[unit].h_lim = h_lim;
+    s_pcnt_accum[unit].l_lim = l_lim;
+    if (s_pcnt_accum[unit].rate_window_us == 0) {
+        s_pcnt_accum[unit].rate_window_us = PCNT_ACCUM_RATE_WINDOW_DEFAULT_MS * 1000;
+    }
+    s_pcnt_accum[unit].rate_last_count = 0;
+    s_pcnt_accum[unit].rate_last_time_us = 0;
+    s_pcnt_accum[unit].rate_last_hz = 0;
+    s_pcnt_accum[unit].enabled = true;
+    PCNT_EXIT_CRITICAL(&pcnt_spinlock);
+
+    return _pcnt_intr_enable(pcnt_port, unit);
+}
+
+static inline esp_err_t _pcnt_accum_disable(pcnt_port_t pcnt_port, pcnt_unit_t unit)
+{
+    PCNT_OBJ_CHECK(pcnt_port);
+    PCNT_CHECK(unit < PCNT_UNIT_MAX, PCNT_UNIT_ERR_STR, ESP_ERR_INVALID_ARG);
+    PCNT_CHECK(s_pcnt_accum[unit].enabled, PCNT_DRIVER_ERR_STR, ESP_ERR_INVALID_STATE);
+
+    PCNT_ENTER_CRITICAL(&pcnt_spinlock);
+    s_pcnt_accum[unit].enabled = false;
+    PCNT_EXIT_CRITICAL(&pcnt_spinlock);
+    _pcnt_event_disable(pcnt_port, unit, PCNT_EVT_H_LIM);
+    _pcnt_event_disable(pcnt_port, unit, PCNT_EVT_L_LIM);
+    //keep the unit interrupt on if the application still has its own handler
+    if (pcnt_isr_func == NULL || pcnt_isr_func[unit].fn == NULL) {
+        _pcnt_intr_disable(pcnt_port, unit);
+    }
+    return ESP_OK;
+}
+
+static inline esp_err_t _pcnt_accum_clear(pcnt_port_t pcnt_port, pcnt_unit_t unit)
+{
+    PCNT_OBJ_CHECK(pcnt_port);
+    PCNT_CHECK(unit < PCNT_UNIT_MAX, PCNT_UNIT_ERR_STR, ESP_ERR_INVALID_ARG);
+    PCNT_CHECK(s_pcnt_accum[unit].enabled, PCNT_DRIVER_ERR_STR, ESP_ERR_INVALID_STATE);
+
+    PCNT_ENTER_CRITICAL(&pcnt_spinlock);
+    s_pcnt_accum[unit].accum_count = 0;
+    s_pcnt_accum[unit].rate_last_count = 0;
+    s_pcnt_accum[unit].rate_last_time_us = 0;
+    s_pcnt_accum[unit].rate_last_hz = 0;
+    PCNT_EXIT_CRITICAL(&pcnt_spinlock);
+    return _pcnt_counter_clear(pcnt_port, unit);
+}
+
+static inline esp_err_t _pcnt_accum_get_count(pcnt_port_t pcnt_port, pcnt_unit_t unit, int64_t *count)
+{
+    PCNT_OBJ_CHECK(pcnt_port);
+    PCNT_CHECK(unit < PCNT_UNIT_MAX, PCNT_UNIT_ERR_STR, ESP_ERR_INVALID_ARG);
+    PCNT_CHECK(count != NULL, PCNT_ADDRESS_ERR_STR, ESP_ERR_INVALID_ARG);
+    PCNT_CHECK(s_pcnt_accum[unit].enabled, PCNT_DRIVER_ERR_STR, ESP_ERR_INVALID_STATE);
+
+    PCNT_ENTER_CRITICAL(&pcnt_spinlock);
+    *count = _pcnt_accum_read_locked(pcnt_port, unit);
+    PCNT_EXIT_CRITICAL(&pcnt_spinlock);
+    return ESP_OK;
+}
+
+static inline esp_err_t _pcnt_accum_snapshot(pcnt_port_t pcnt_port, const pcnt_unit_t *units, uint32_t num_units, int64_t *counts)
+{
+    PCNT_OBJ_CHECK(pcnt_port);
+    PCNT_CHECK(units != NULL && counts != NULL, PCNT_ADDRESS_ERR_STR, ESP_ERR_INVALID_ARG);
+    PCNT_CHECK(num_units > 0 && num_units <= PCNT_UNIT_MAX, PCNT_UNIT_ERR_STR, ESP_ERR_INVALID_ARG);
+    for (uint32_t i = 0; i < num_units; i++) {
+        PCNT_CHECK(units[i] < PCNT_UNIT_MAX, PCNT_UNIT_ERR_STR, ESP_ERR_INVALID_ARG);
+        PCNT_CHECK(s_pcnt_accum[units[i]].enabled, PCNT_DRIVER_ERR_STR, ESP_ERR_INVALID_STATE);
+    }
+
+    //all units are read inside one critical section, so the snapshot is coherent
+    PCNT_ENTER_CRITICAL(&pcnt_spinlock);
+    for (uint32_t i = 0; i < num_units; i++) {
+        counts[i] = _pcnt_accum_read_locked(pcnt_port, units[i]);
+    }
+    PCNT_EXIT_CRITICAL(&pcnt_spinlock);
+    return ESP_OK;
+}
+
+static inline esp_err_t _pcnt_accum_set_rate_window(pcnt_port_t pcnt_port, pcnt_unit_t unit, uint32_t window_ms)
+{
+    PCNT_OBJ_CHECK(pcnt_port);
+    PCNT_CHECK(unit < PCNT_UNIT_MAX, PCNT_UNIT_ERR_STR, ESP_ERR_INVALID_ARG);
+    PCNT_CHECK(window_ms > 0, PCNT_PARAM_ERR_STR, ESP_ERR_INVALID_ARG);
+
+    PCNT_ENTER_CRITICAL(&pcnt_spinlock);
+    s_pcnt_accum[unit].rate_window_us = window_ms * 1000;
+    PCNT_EXIT_CRITICAL(&pcnt_spinlock);
+    return ESP_OK;
+}
+
+static inline esp_err_t _pcnt_accum_get_rate(pcnt_port_t pcnt_port, pcnt_unit_t unit, float *rate_hz)
+{
+    PCNT_OBJ_CHECK(pcnt_port);
+    PCNT_CHECK(unit < PCNT_UNIT_MAX, PCNT_UNIT_ERR_STR, ESP_ERR_INVALID_ARG);
+    PCNT_CHECK(rate_hz != NULL, PCNT_ADDRESS_ERR_STR, ESP_ERR_INVALID_ARG);
+    PCNT_CHECK(s_pcnt_accum[unit].enabled, PCNT_DRIVER_ERR_STR, ESP_ERR_INVALID_STATE);
+
+    int64_t now = esp_timer_get_time();
+    PCNT_ENTER_CRITICAL(&pcnt_spinlock);
+    int64_t count = _pcnt_accum_read_locked(pcnt_port, unit);
+    pcnt_accum_t *accum = &s_pcnt_accum[unit];
+    if (accum->rate_last_time_us == 0) {
+        //first call opens the window, there is no rate yet
+        accum->rate_last_count = count;
+        accum->rate_last_time_us = now;
+    } else if (now - accum->rate_last_time_us >= accum->rate_window_us) {
+        accum->rate_last_hz = (float)(count - accum->rate_last_count) * 1e6f / (float)(now - accum->rate_last_time_us);
+        accum->rate_last_count = count;
+        accum->rate_last_time_us = now;
+    }
+    *rate_hz = accum->rate_last_hz;
+    PCNT_EXIT_CRITICAL(&pcnt_spinlock);
+    return ESP_OK;
+}
+
 static inline esp_err_t _pcnt_unit_config(pcnt_port_t pcnt_port, const pcnt_config_t *pcnt_config)
 {
     PCNT_OBJ_CHECK(pcnt_port);
@@ -534,4 +712,39 @@ void pcnt_isr_service_uninstall()
     _pcnt_isr_service_uninstall(PCNT_PORT_0);
 }
 
+esp_err_t pcnt_accum_enable(pcnt_unit_t unit)
+{
+    return _pcnt_accum_enable(PCNT_PORT_0, unit);
+}
+
+esp_err_t pcnt_accum_disable(pcnt_unit_t unit)
+{
+    return _pcnt_accum_disable(PCNT_PORT_0, unit);
+}
+
+esp_err_t pcnt_accum_clear(pcnt_unit_t unit)
+{
+    return _pcnt_accum_clear(PCNT_PORT_0, unit);
+}
+
+esp_err_t pcnt_accum_get_count(pcnt_unit_t unit, int64_t *count)
+{
+    return _pcnt_accum_get_count(PCNT_PORT_0, unit, count);
+}
+
+esp_err_t pcnt_accum_snapshot(const pcnt_unit_t *units, uint32_t num_units, int64_t *counts)
+{
+    return _pcnt_accum_snapshot(PCNT_PORT_0, units, num_units, counts);
+}
+
+esp_err_t pcnt_accum_set_rate_window(pcnt_unit_t unit, uint32_t window_ms)
+{
+    return _pcnt_accum_set_rate_window(PCNT_PORT_0, unit, window_ms);
+}
+
+esp_err_t pcnt_accum_get_rate(pcnt_unit_t unit, float *rate_hz)
+{
+    return _pcnt_accum_get_rate(PCNT_PORT_0, unit, rate_hz);
+}
+
 #endif // #if SOC_PCNT_SUPPORTED
@@ -101,6 +101,9 @@ typedef struct {
     sample_to_rmt_t sample_to_rmt;
     size_t sample_size_remain;
     const uint8_t *sample_cur;
+    rmt_tx_encoder_t tx_encoder;
+    void *tx_encoder_arg;
+    bool encoder; //Mark whether the ongoing transmission is fed by the streaming encoder.
 } rmt_obj_t;
 
 static rmt_contex_t rmt_contex = {
@@ -766,6 +769,7 @@ static void IRAM_ATTR rmt_driver_isr_default(void *arg)
             p_rmt->tx_sub_len = 0;
             p_rmt->sample_cur = NULL;
             p_rmt->translator = false;
+            p_rmt->encoder = false;
             if (rmt_contex.rmt_tx_end_callback.function != NULL) {
                 rmt_contex.rmt_tx_end_callback.function(channel, rmt_contex.rmt_tx_end_callback.arg);
             }
@@ -779,7 +783,25 @@ static void IRAM_ATTR rmt_driver_isr_default(void *arg)
         channel = __builtin_ffs(status) - 1;
         status &= ~(1 << channel);
         rmt_obj_t *p_rmt = p_rmt_obj[channel];
-        if (p_rmt) {
+        if (p_rmt && p_rmt->encoder) {
+            //Streaming encoder mode: the callback produces the next half block of items on the fly.
+            size_t item_num = p_rmt->tx_encoder(channel, p_rmt->tx_buf, p_rmt->tx_sub_len, p_rmt->tx_encoder_arg);
+            if (item_num > p_rmt->tx_sub_len) {
+                item_num = p_rmt->tx_sub_len;
+            }
+            rmt_fill_memory(channel, p_rmt->tx_buf, item_num, p_rmt->tx_offset);
+            if (item_num < p_rmt->tx_sub_len) {
+                //Encoder has run out of data, terminate after the items just produced.
+                rmt_item32_t stop_data = {0};
+                rmt_ll_write_memory(rmt_contex.hal.mem, channel, &stop_data, 1, p_rmt->tx_offset + item_num);
+                p_rmt->encoder = false;
+            }
+            if (p_rmt->tx_offset == 0) {
+                p_rmt->tx_offset = p_rmt->tx_sub_len;
+            } else {
+                p_rmt->tx_offset = 0;
+            }
+        } else if (p_rmt) {
             if (p_rmt->translator) {
                 if (p_rmt->sample_size_remain > 0) {
                     size_t translated_size = 0;
@@ -1193,11 +1215,9 @@ rmt_tx_end_callback_t rmt_register_tx_end_callback(rmt_tx_end_fn_t function, voi
     return previous;
 }
 
-esp_err_t rmt_translator_init(rmt_channel_t channel, sample_to_rmt_t fn)
+//Allocate the per-channel item staging buffer shared by the translator and the streaming encoder.
+static esp_err_t rmt_tx_buf_create(rmt_channel_t channel)
 {
-    RMT_CHECK(fn != NULL, RMT_TRANSLATOR_NULL_STR, ESP_ERR_INVALID_ARG);
-    RMT_CHECK(RMT_IS_TX_CHANNEL(channel), RMT_CHANNEL_ERROR_STR, ESP_ERR_INVALID_ARG);
-    RMT_CHECK(p_rmt_obj[channel] != NULL, RMT_DRIVER_ERROR_STR, ESP_FAIL);
     const uint32_t block_size = rmt_ll_tx_get_mem_blocks(rmt_contex.hal.regs, channel) *
                                 RMT_MEM_ITEM_NUM * sizeof(rmt_item32_t);
     if (p_rmt_obj[channel]->tx_buf == NULL) {
@@ -1215,6 +1235,18 @@ esp_err_t rmt_translator_init(rmt_channel_t channel, sample_to_rmt_t fn)
             return ESP_FAIL;
         }
     }
+    return ESP_OK;
+}
+
+esp_err_t rmt_translator_init(rmt_channel_t channel, sample_to_rmt_t fn)
+{
+    RMT_CHECK(fn != NULL, RMT_TRANSLATOR_NULL_STR, ESP_ERR_INVALID_ARG);
+    RMT_CHECK(RMT_IS_TX_CHANNEL(channel), RMT_CHANNEL_ERROR_STR, ESP_ERR_INVALID_ARG);
+    RMT_CHECK(p_rmt_obj[channel] != NULL, RMT_DRIVER_ERROR_STR, ESP_FAIL);
+    esp_err_t err = rmt_tx_buf_create(channel);
+    if (err != ESP_OK) {
+        return err;
+    }
     p_rmt_obj[channel]->sample_to_rmt = fn;
     p_rmt_obj[channel]->sample_size_remain = 0;
     p_rmt_obj[channel]->sample_cur = NULL;
@@ -1267,6 +1299,46 @@ esp_err_t rmt_write_sample(rmt_channel_t channel, const uint8_t *src, size_t src
     return ESP_OK;
 }
 
+esp_err_t rmt_write_stream(rmt_channel_t channel, rmt_tx_encoder_t encoder, void *arg, bool wait_tx_done)
+{
+    RMT_CHECK(RMT_IS_TX_CHANNEL(channel), RMT_CHANNEL_ERROR_STR, ESP_ERR_INVALID_ARG);
+    RMT_CHECK(p_rmt_obj[channel] != NULL, RMT_DRIVER_ERROR_STR, ESP_FAIL);
+    RMT_CHECK(encoder != NULL, RMT_TRANSLATOR_NULL_STR, ESP_ERR_INVALID_ARG);
+    esp_err_t err = rmt_tx_buf_create(channel);
+    if (err != ESP_OK) {
+        return err;
+    }
+    rmt_obj_t *p_rmt = p_rmt_obj[channel];
+    const uint32_t item_block_len = rmt_ll_tx_get_mem_blocks(rmt_contex.hal.regs, channel) * RMT_MEM_ITEM_NUM;
+    const uint32_t item_sub_len = item_block_len / 2;
+    xSemaphoreTake(p_rmt->tx_sem, portMAX_DELAY);
+    p_rmt->tx_encoder = encoder;
+    p_rmt->tx_encoder_arg = arg;
+    size_t item_num = encoder(channel, p_rmt->tx_buf, item_block_len, arg);
+    if (item_num > item_block_len) {
+        item_num = item_block_len;
+    }
+    rmt_fill_memory(channel, p_rmt->tx_buf, item_num, 0);
+    if (item_num == item_block_len) {
+        rmt_set_tx_thr_intr_en(channel, 1, item_sub_len);
+        p_rmt->tx_offset = 0;
+        p_rmt->tx_sub_len = item_sub_len;
+        p_rmt->encoder = true;
+    } else {
+        rmt_item32_t stop_data = {0};
+        rmt_ll_write_memory(rmt_contex.hal.mem, channel, &stop_data, 1, item_num);
+        p_rmt->tx_len_rem = 0;
+        p_rmt->encoder = false;
+    }
+    rmt_tx_start(channel, true);
+    p_rmt->wait_done = wait_tx_done;
+    if (wait_tx_done) {
+        xSemaphoreTake(p_rmt->tx_sem, portMAX_DELAY);
+        xSemaphoreGive(p_rmt->tx_sem);
+    }
+    return ESP_OK;
+}
+
 esp_err_t rmt_get_channel_status(rmt_channel_status_result_t *channel_status)
 {
     RMT_CHECK(channel_status != NULL, RMT_PARAM_ERR_STR, ESP_ERR_INVALID_ARG);
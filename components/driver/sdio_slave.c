@@ -178,6 +178,7 @@ static void sdio_intr_recv(void*);
 
 static esp_err_t send_flush_data(void);
 static esp_err_t recv_flush_data(void);
+static void recv_stream_free_storage(void);
 
 static inline void critical_enter_recv(void);
 static inline void critical_exit_recv(void);
@@ -373,6 +374,8 @@ void sdio_slave_deinit(void)
         if (desc == NULL) break;
         free(desc);
     }
+    //descriptors of streaming buffers are already freed above, release the storage
+    recv_stream_free_storage();
     esp_err_t ret = esp_intr_free(context.intr_handle);
     assert(ret==ESP_OK);
     context.intr_handle = NULL;
@@ -747,3 +750,135 @@ uint8_t* sdio_slave_recv_get_buf(sdio_slave_buf_handle_t handle, size_t *len_o)
     if (len_o!= NULL) *len_o= desc->hal_desc.length;
     return (uint8_t*)desc->hal_desc.buf;
 }
+
+/*---------------------------------------------------------------------------
+ *                  Recv streaming
+ *--------------------------------------------------------------------------*/
+/*
+In streaming mode the driver owns a pool of receiving buffers and keeps every
+buffer loaded on the linked-list at all times: as soon as the application has
+consumed a buffer it is handed straight back to the hardware, without the
+application ever touching buffer handles. The host sees a continuously
+replenished buffer counter through the existing receiving interrupt, so its
+flow control is unchanged; the application just reads a byte stream.
+*/
+typedef struct {
+    sdio_slave_buf_handle_t *handles;   // handles of the driver-owned buffers
+    uint8_t             **buffers;      // driver-owned DMA buffers
+    int                 buffer_num;
+    sdio_slave_buf_handle_t cur_handle; // buffer being consumed, NULL if none
+    uint8_t             *cur_addr;
+    size_t              cur_len;
+    size_t              cur_offset;
+    bool                started;
+} recv_stream_t;
+
+static recv_stream_t s_recv_stream;
+
+static void recv_stream_free_storage(void)
+{
+    recv_stream_t *stream = &s_recv_stream;
+    if (stream->buffers) {
+        for (int i = 0; i < stream->buffer_num; i++) {
+            free(stream->buffers[i]);
+        }
+        free(stream->buffers);
+    }
+    free(stream->handles);
+    memset(stream, 0, sizeof(*stream));
+}
+
+esp_err_t sdio_slave_recv_stream_start(int buffer_num)
+{
+    recv_stream_t *stream = &s_recv_stream;
+    SDIO_SLAVE_CHECK(context.hal != NULL, "driver not initialized", ESP_ERR_INVALID_STATE);
+    SDIO_SLAVE_CHECK(!stream->started, "stream already started", ESP_ERR_INVALID_STATE);
+    SDIO_SLAVE_CHECK(buffer_num > 0, "buffer_num not valid", ESP_ERR_INVALID_ARG);
+
+    size_t buffer_size = context.config.recv_buffer_size;
+    stream->handles = (sdio_slave_buf_handle_t*)heap_caps_calloc(buffer_num, sizeof(sdio_slave_buf_handle_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    stream->buffers = (uint8_t**)heap_caps_calloc(buffer_num, sizeof(uint8_t*), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (stream->handles == NULL || stream->buffers == NULL) goto no_mem;
+    stream->buffer_num = buffer_num;
+
+    // register everything first so a failure can still unregister cleanly;
+    // nothing is loaded onto the linked-list until all allocations succeeded
+    for (int i = 0; i < buffer_num; i++) {
+        stream->buffers[i] = (uint8_t*)heap_caps_malloc(buffer_size, MALLOC_CAP_DMA);
+        if (stream->buffers[i] == NULL) goto no_mem;
+        stream->handles[i] = sdio_slave_recv_register_buf(stream->buffers[i]);
+        if (stream->handles[i] == NULL) goto no_mem;
+    }
+    for (int i = 0; i < buffer_num; i++) {
+        esp_err_t err = sdio_slave_recv_load_buf(stream->handles[i]);
+        assert(err == ESP_OK); //freshly registered buffers are idle
+    }
+    stream->started = true;
+    return ESP_OK;
+
+no_mem:
+    for (int i = 0; i < stream->buffer_num; i++) {
+        if (stream->handles && stream->handles[i]) {
+            sdio_slave_recv_unregister_buf(stream->handles[i]);
+        }
+    }
+    recv_stream_free_storage();
+    return ESP_ERR_NO_MEM;
+}
+
+esp_err_t sdio_slave_recv_stream_read(uint8_t *buffer, size_t size, size_t *size_read, TickType_t wait)
+{
+    recv_stream_t *stream = &s_recv_stream;
+    SDIO_SLAVE_CHECK(stream->started, "stream not started", ESP_ERR_INVALID_STATE);
+    SDIO_SLAVE_CHECK(buffer != NULL && size_read != NULL, "invalid argument", ESP_ERR_INVALID_ARG);
+
+    size_t copied = 0;
+    while (copied < size) {
+        if (stream->cur_handle == NULL) {
+            // wait as requested for the first data, then only take what already arrived
+            esp_err_t err = sdio_slave_recv(&stream->cur_handle, &stream->cur_addr, &stream->cur_len, (copied > 0) ? 0 : wait);
+            if (err != ESP_OK) break;
+            stream->cur_offset = 0;
+        }
+        size_t remain = stream->cur_len - stream->cur_offset;
+        size_t copy_len = (remain < size - copied) ? remain : size - copied;
+        memcpy(buffer + copied, stream->cur_addr + stream->cur_offset, copy_len);
+        copied += copy_len;
+        stream->cur_offset += copy_len;
+        if (stream->cur_offset == stream->cur_len) {
+            // drained: hand the buffer straight back to the hardware so the
+            // host buffer counter keeps advancing without app involvement
+            esp_err_t err = sdio_slave_recv_load_buf(stream->cur_handle);
+            assert(err == ESP_OK);
+            stream->cur_handle = NULL;
+        }
+    }
+    *size_read = copied;
+    return (copied > 0) ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+esp_err_t sdio_slave_recv_stream_stop(void)
+{
+    recv_stream_t *stream = &s_recv_stream;
+    SDIO_SLAVE_CHECK(stream->started, "stream not started", ESP_ERR_INVALID_STATE);
+
+    // discard events of buffers received but never read
+    while (xSemaphoreTake(context.recv_event, 0) == pdTRUE) {}
+
+    // take every loaded buffer back from the (stopped) hardware and return
+    // it to the registered list, where it can be unregistered
+    critical_enter_recv();
+    while (1) {
+        recv_desc_t *desc = (recv_desc_t*)sdio_slave_hal_recv_unload_desc(context.hal);
+        if (desc == NULL) break;
+        TAILQ_INSERT_TAIL(&context.recv_reg_list, desc, te);
+    }
+    critical_exit_recv();
+
+    for (int i = 0; i < stream->buffer_num; i++) {
+        esp_err_t err = sdio_slave_recv_unregister_buf(stream->handles[i]);
+        assert(err == ESP_OK);
+    }
+    recv_stream_free_storage();
+    return ESP_OK;
+}
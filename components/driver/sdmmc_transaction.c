@@ -48,6 +48,8 @@ typedef struct {
     size_t size_remaining;
     size_t next_desc;
     size_t desc_remaining;
+    const sdmmc_sg_frag_t* next_frag;
+    size_t frag_remaining;
 } sdmmc_transfer_state_t;
 
 const uint32_t SDMMC_DATA_ERR_MASK =
@@ -113,6 +115,11 @@ void sdmmc_host_transaction_handler_deinit(void)
     s_request_mutex = NULL;
 }
 
+static bool cmd_has_data(const sdmmc_command_t* cmd)
+{
+    return cmd->data != NULL || cmd->sg_frag_count > 0;
+}
+
 esp_err_t sdmmc_host_do_transaction(int slot, sdmmc_command_t* cmdinfo)
 {
     esp_err_t ret;
@@ -124,29 +131,73 @@ esp_err_t sdmmc_host_do_transaction(int slot, sdmmc_command_t* cmdinfo)
     handle_idle_state_events();
     // convert cmdinfo to hardware register value
     sdmmc_hw_cmd_t hw_cmd = make_hw_cmd(cmdinfo);
-    if (cmdinfo->data) {
-        // Length should be either <4 or >=4 and =0 (mod 4).
-        if (cmdinfo->datalen >= 4 && cmdinfo->datalen % 4 != 0) {
-            ESP_LOGD(TAG, "%s: invalid size: total=%d",
-                    __func__, cmdinfo->datalen);
-            ret = ESP_ERR_INVALID_SIZE;
-            goto out;
-        }
-        if ((intptr_t) cmdinfo->data % 4 != 0 ||
-                !esp_ptr_dma_capable(cmdinfo->data)) {
-            ESP_LOGD(TAG, "%s: buffer %p can not be used for DMA", __func__, cmdinfo->data);
-            ret = ESP_ERR_INVALID_ARG;
-            goto out;
+    if (cmd_has_data(cmdinfo)) {
+        size_t desc_remaining = 0;
+        if (cmdinfo->sg_frag_count > 0) {
+            /* Scatter-gather transfer. Fragments in the middle of the
+             * descriptor chain have to end on a word boundary, so every
+             * fragment is required to be a multiple of 4 bytes.
+             */
+            if (cmdinfo->data != NULL || cmdinfo->sg_frags == NULL) {
+                ret = ESP_ERR_INVALID_ARG;
+                goto out;
+            }
+            size_t total = 0;
+            for (size_t i = 0; i < cmdinfo->sg_frag_count; ++i) {
+                const sdmmc_sg_frag_t* frag = &cmdinfo->sg_frags[i];
+                if (frag->size == 0 || frag->size % 4 != 0) {
+                    ESP_LOGD(TAG, "%s: invalid fragment size: %d",
+                            __func__, frag->size);
+                    ret = ESP_ERR_INVALID_SIZE;
+                    goto out;
+                }
+                if ((intptr_t) frag->data % 4 != 0 ||
+                        !esp_ptr_dma_capable(frag->data)) {
+                    ESP_LOGD(TAG, "%s: buffer %p can not be used for DMA", __func__, frag->data);
+                    ret = ESP_ERR_INVALID_ARG;
+                    goto out;
+                }
+                total += frag->size;
+                desc_remaining += (frag->size + SDMMC_DMA_MAX_BUF_LEN - 1) / SDMMC_DMA_MAX_BUF_LEN;
+            }
+            if (total != cmdinfo->datalen) {
+                ESP_LOGD(TAG, "%s: fragments total %d don't match datalen=%d",
+                        __func__, total, cmdinfo->datalen);
+                ret = ESP_ERR_INVALID_SIZE;
+                goto out;
+            }
+            // first fragment is picked up by fill_dma_descriptors
+            s_cur_transfer.ptr = NULL;
+            s_cur_transfer.frag_remaining = 0;
+            s_cur_transfer.next_frag = cmdinfo->sg_frags;
+        } else {
+            // Length should be either <4 or >=4 and =0 (mod 4).
+            if (cmdinfo->datalen >= 4 && cmdinfo->datalen % 4 != 0) {
+                ESP_LOGD(TAG, "%s: invalid size: total=%d",
+                        __func__, cmdinfo->datalen);
+                ret = ESP_ERR_INVALID_SIZE;
+                goto out;
+            }
+            if ((intptr_t) cmdinfo->data % 4 != 0 ||
+                    !esp_ptr_dma_capable(cmdinfo->data)) {
+                ESP_LOGD(TAG, "%s: buffer %p can not be used for DMA", __func__, cmdinfo->data);
+                ret = ESP_ERR_INVALID_ARG;
+                goto out;
+            }
+            // contiguous buffer is treated as a single fragment
+            s_cur_transfer.ptr = (uint8_t*) cmdinfo->data;
+            s_cur_transfer.frag_remaining = cmdinfo->datalen;
+            s_cur_transfer.next_frag = NULL;
+            desc_remaining = (cmdinfo->datalen + SDMMC_DMA_MAX_BUF_LEN - 1) / SDMMC_DMA_MAX_BUF_LEN;
         }
         // this clears "owned by IDMAC" bits
         memset(s_dma_desc, 0, sizeof(s_dma_desc));
         // initialize first descriptor
         s_dma_desc[0].first_descriptor = 1;
         // save transfer info
-        s_cur_transfer.ptr = (uint8_t*) cmdinfo->data;
         s_cur_transfer.size_remaining = cmdinfo->datalen;
         s_cur_transfer.next_desc = 0;
-        s_cur_transfer.desc_remaining = (cmdinfo->datalen + SDMMC_DMA_MAX_BUF_LEN - 1) / SDMMC_DMA_MAX_BUF_LEN;
+        s_cur_transfer.desc_remaining = desc_remaining;
         // prepare descriptors
         fill_dma_descriptors(SDMMC_DMA_DESC_CNT);
         // write transfer info into hardware
@@ -210,12 +261,18 @@ static void fill_dma_descriptors(size_t num_desc)
         if (s_cur_transfer.size_remaining == 0) {
             return;
         }
+        if (s_cur_transfer.frag_remaining == 0) {
+            // advance to the next scatter-gather fragment
+            s_cur_transfer.ptr = (uint8_t*) s_cur_transfer.next_frag->data;
+            s_cur_transfer.frag_remaining = s_cur_transfer.next_frag->size;
+            s_cur_transfer.next_frag++;
+        }
         const size_t next = s_cur_transfer.next_desc;
         sdmmc_desc_t* desc = &s_dma_desc[next];
         assert(!desc->owned_by_idmac);
         size_t size_to_fill =
-            (s_cur_transfer.size_remaining < SDMMC_DMA_MAX_BUF_LEN) ?
-                s_cur_transfer.size_remaining : SDMMC_DMA_MAX_BUF_LEN;
+            (s_cur_transfer.frag_remaining < SDMMC_DMA_MAX_BUF_LEN) ?
+                s_cur_transfer.frag_remaining : SDMMC_DMA_MAX_BUF_LEN;
         bool last = size_to_fill == s_cur_transfer.size_remaining;
         desc->last_descriptor = last;
         desc->second_address_chained = 1;
@@ -226,6 +283,7 @@ static void fill_dma_descriptors(size_t num_desc)
         desc->buffer1_size = (size_to_fill + 3) & (~3);
 
         s_cur_transfer.size_remaining -= size_to_fill;
+        s_cur_transfer.frag_remaining -= size_to_fill;
         s_cur_transfer.ptr += size_to_fill;
         s_cur_transfer.next_desc = (s_cur_transfer.next_desc + 1) % SDMMC_DMA_DESC_CNT;
         ESP_LOGV(TAG, "fill %d desc=%d rem=%d next=%d last=%d sz=%d",
@@ -313,7 +371,7 @@ static sdmmc_hw_cmd_t make_hw_cmd(sdmmc_command_t* cmd)
         res.check_response_crc = 1;
     }
     res.use_hold_reg = 1;
-    if (cmd->data) {
+    if (cmd_has_data(cmd)) {
         res.data_expected = 1;
         if ((cmd->flags & SCF_CMD_READ) == 0) {
             res.rw = 1;
@@ -352,7 +410,7 @@ static void process_command_response(uint32_t status, sdmmc_command_t* cmd)
     }
     if (err != ESP_OK) {
         cmd->error = err;
-        if (cmd->data) {
+        if (cmd_has_data(cmd)) {
             sdmmc_host_dma_stop();
         }
         ESP_LOGD(TAG, "%s: error 0x%x  (status=%08x)", __func__, err, status);
@@ -375,7 +433,7 @@ static void process_data_status(uint32_t status, sdmmc_command_t* cmd)
         SDMMC.ctrl.fifo_reset = 1;
     }
     if (cmd->error != 0) {
-        if (cmd->data) {
+        if (cmd_has_data(cmd)) {
             sdmmc_host_dma_stop();
         }
         ESP_LOGD(TAG, "%s: error 0x%x (status=%08x)", __func__, cmd->error, status);
@@ -421,7 +479,7 @@ static esp_err_t process_events(sdmmc_event_t evt, sdmmc_command_t* cmd,
                         break;
                     }
 
-                    if (cmd->data == NULL) {
+                    if (!cmd_has_data(cmd)) {
                         next_state = SDMMC_IDLE;
                     } else {
                         next_state = SDMMC_SENDING_DATA;
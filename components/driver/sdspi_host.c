@@ -57,9 +57,10 @@ typedef struct {
     uint8_t gpio_int;            //!< Write protect GPIO, or GPIO_UNUSED
     /// Set to 1 if the higher layer has asked the card to enable CRC checks
     uint8_t data_crc_enabled : 1;
-    /// Intermediate buffer used when application buffer is not in DMA memory;
-    /// allocated on demand, SDSPI_BLOCK_BUF_SIZE bytes long. May be zero.
-    uint8_t* block_buf;
+    /// Intermediate buffers used when the application buffer is not in DMA memory, and
+    /// alternately as RX targets so the previous block can be verified while the next one
+    /// transfers; allocated on demand, SDSPI_BLOCK_BUF_SIZE bytes long each. May be zero.
+    uint8_t* block_buf[2];
     /// semaphore of gpio interrupt
     SemaphoreHandle_t   semphr_int;
 } slot_info_t;
@@ -155,15 +156,15 @@ static bool card_missing(slot_info_t *slot)
 
 /// Get pointer to a block of DMA memory, allocate if necessary.
 /// This is used if the application provided buffer is not in DMA capable memory.
-static esp_err_t get_block_buf(slot_info_t *slot, uint8_t **out_buf)
+static esp_err_t get_block_buf(slot_info_t *slot, int idx, uint8_t **out_buf)
 {
-    if (slot->block_buf == NULL) {
-        slot->block_buf = heap_caps_malloc(SDSPI_BLOCK_BUF_SIZE, MALLOC_CAP_DMA);
-        if (slot->block_buf == NULL) {
+    if (slot->block_buf[idx] == NULL) {
+        slot->block_buf[idx] = heap_caps_malloc(SDSPI_BLOCK_BUF_SIZE, MALLOC_CAP_DMA);
+        if (slot->block_buf[idx] == NULL) {
             return ESP_ERR_NO_MEM;
         }
     }
-    *out_buf = slot->block_buf;
+    *out_buf = slot->block_buf[idx];
     return ESP_OK;
 }
 
@@ -230,8 +231,10 @@ static esp_err_t deinit_slot(slot_info_t *slot)
     if (slot->spi_handle) {
         spi_bus_remove_device(slot->spi_handle);
         slot->spi_handle = NULL;
-        free(slot->block_buf);
-        slot->block_buf = NULL;
+        free(slot->block_buf[0]);
+        slot->block_buf[0] = NULL;
+        free(slot->block_buf[1]);
+        slot->block_buf[1] = NULL;
     }
 
     uint64_t pin_bit_mask = 0;
@@ -666,8 +669,11 @@ static esp_err_t shift_cmd_response(sdspi_hw_cmd_t* cmd, int sent_bytes)
  *
  * With this approach the delay between blocks of a multi-block transfer is
  * ~95 microseconds, out of which 35 microseconds are spend doing the CRC check.
- * Further speedup is possible by pipelining transfers and CRC checks, at an
- * expense of one extra temporary buffer.
+ * To hide that check as well, the copy-out and CRC verification of each block
+ * are deferred until the SPI transaction of the next block has been queued:
+ * while the DMA clocks the next block into the second intermediate buffer, the
+ * CPU verifies the previous one. This costs one extra temporary buffer and
+ * takes the CRC check off the critical path of multi-block reads.
  */
 static esp_err_t start_command_read_blocks(slot_info_t *slot, sdspi_hw_cmd_t *cmd,
         uint8_t *data, uint32_t rx_length, bool need_stop_command)
@@ -699,15 +705,26 @@ static esp_err_t start_command_read_blocks(slot_info_t *slot, sdspi_hw_cmd_t *cm
         return ESP_ERR_TIMEOUT;
     }
 
+    // State of the block whose copy-out and CRC check were deferred; it is processed while the
+    // SPI transaction of the following block is clocked out by the DMA.
+    uint8_t* prev_buf = NULL;
+    uint8_t* prev_dest = NULL;
+    size_t prev_main_size = 0;
+    size_t prev_extra_size = 0;
+    uint16_t prev_crc = 0;
+    uint8_t prev_extra[SDSPI_RESPONSE_MAX_DELAY];
+    int buf_idx = 0;
+    esp_err_t crc_err = ESP_OK;
+
     while (rx_length > 0) {
         size_t extra_data_size = 0;
-        const uint8_t* extra_data_ptr = NULL;
         bool need_poll = true;
+        uint8_t extra_stash[SDSPI_RESPONSE_MAX_DELAY];
 
         for (int i = 0; i < pre_scan_data_size; ++i) {
             if (pre_scan_data_ptr[i] == TOKEN_BLOCK_START) {
                 extra_data_size = pre_scan_data_size - i - 1;
-                extra_data_ptr = pre_scan_data_ptr + i + 1;
+                memcpy(extra_stash, pre_scan_data_ptr + i + 1, extra_data_size);
                 need_poll = false;
                 break;
             }
@@ -720,17 +737,19 @@ static esp_err_t start_command_read_blocks(slot_info_t *slot, sdspi_hw_cmd_t *cm
                 return ret;
             }
             if (extra_data_size) {
-                extra_data_ptr = cmd_u8 + SDSPI_CMD_R1_SIZE;
+                memcpy(extra_stash, cmd_u8 + SDSPI_CMD_R1_SIZE, extra_data_size);
             }
         }
 
-        // Arrange RX buffer
+        // Arrange RX buffer; alternate between the two intermediate buffers so the previous
+        // block stays valid while this one is received.
         size_t will_receive = MIN(rx_length, SDSPI_MAX_DATA_LEN) - extra_data_size;
         uint8_t* rx_data;
-        ret = get_block_buf(slot, &rx_data);
+        ret = get_block_buf(slot, buf_idx, &rx_data);
         if (ret != ESP_OK) {
             return ret;
         }
+        buf_idx ^= 1;
 
         // receive actual data
         const size_t receive_extra_bytes = (rx_length > SDSPI_MAX_DATA_LEN) ? 4 : 2;
@@ -741,11 +760,37 @@ static esp_err_t start_command_read_blocks(slot_info_t *slot, sdspi_hw_cmd_t *cm
             .tx_buffer = rx_data
         };
 
-        ret = spi_device_transmit(slot->spi_handle, &t_data);
+        ret = spi_device_queue_trans(slot->spi_handle, &t_data, portMAX_DELAY);
         if (ret != ESP_OK) {
             return ret;
         }
 
+        // While the DMA is receiving this block, copy out and verify the previous one
+        if (prev_buf != NULL) {
+            memcpy(prev_dest + prev_extra_size, prev_buf, prev_main_size);
+            if (prev_extra_size) {
+                memcpy(prev_dest, prev_extra, prev_extra_size);
+            }
+            if (slot->data_crc_enabled) {
+                uint16_t crc_of_data = sdspi_crc16(prev_dest, prev_main_size + prev_extra_size);
+                if (crc_of_data != prev_crc) {
+                    ESP_LOGE(TAG, "data CRC failed, got=0x%04x expected=0x%04x", crc_of_data, prev_crc);
+                    esp_log_buffer_hex(TAG, prev_dest, 16);
+                    crc_err = ESP_ERR_INVALID_CRC;
+                }
+            }
+            prev_buf = NULL;
+        }
+
+        spi_transaction_t* t_ret;
+        ret = spi_device_get_trans_result(slot->spi_handle, &t_ret, portMAX_DELAY);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        if (crc_err != ESP_OK) {
+            return crc_err;
+        }
+
         // CRC bytes need to be received even if CRC is not enabled
         uint16_t crc = UINT16_MAX;
         memcpy(&crc, rx_data + will_receive, sizeof(crc));
@@ -754,27 +799,34 @@ static esp_err_t start_command_read_blocks(slot_info_t *slot, sdspi_hw_cmd_t *cm
         pre_scan_data_size = receive_extra_bytes - sizeof(crc);
         pre_scan_data_ptr = rx_data + will_receive + sizeof(crc);
 
-        // Copy data to the destination buffer
-        memcpy(data + extra_data_size, rx_data, will_receive);
+        // Defer copy-out and CRC check of this block until the next one is in flight
+        prev_buf = rx_data;
+        prev_dest = data;
+        prev_main_size = will_receive;
+        prev_extra_size = extra_data_size;
+        prev_crc = crc;
         if (extra_data_size) {
-            memcpy(data, extra_data_ptr, extra_data_size);
+            memcpy(prev_extra, extra_stash, extra_data_size);
         }
 
-        // compute CRC of the received data
-        uint16_t crc_of_data = 0;
+        data += will_receive + extra_data_size;
+        rx_length -= will_receive + extra_data_size;
+    }
+
+    // Copy out and verify the final block, nothing left to overlap it with
+    if (prev_buf != NULL) {
+        memcpy(prev_dest + prev_extra_size, prev_buf, prev_main_size);
+        if (prev_extra_size) {
+            memcpy(prev_dest, prev_extra, prev_extra_size);
+        }
         if (slot->data_crc_enabled) {
-            crc_of_data = sdspi_crc16(data, will_receive + extra_data_size);
-            if (crc_of_data != crc) {
-                ESP_LOGE(TAG, "data CRC failed, got=0x%04x expected=0x%04x", crc_of_data, crc);
-                esp_log_buffer_hex(TAG, data, 16);
+            uint16_t crc_of_data = sdspi_crc16(prev_dest, prev_main_size + prev_extra_size);
+            if (crc_of_data != prev_crc) {
+                ESP_LOGE(TAG, "data CRC failed, got=0x%04x expected=0x%04x", crc_of_data, prev_crc);
+                esp_log_buffer_hex(TAG, prev_dest, 16);
                 return ESP_ERR_INVALID_CRC;
             }
         }
-
-        data += will_receive + extra_data_size;
-        rx_length -= will_receive + extra_data_size;
-        extra_data_size = 0;
-        extra_data_ptr = NULL;
     }
 
     if (need_stop_command) {
@@ -850,7 +902,7 @@ static esp_err_t start_command_write_blocks(slot_info_t *slot, sdspi_hw_cmd_t *c
         if (!esp_ptr_in_dram(tx_data)) {
             // If the pointer can't be used with DMA, copy data into a new buffer
             uint8_t* tmp;
-            ret = get_block_buf(slot, &tmp);
+            ret = get_block_buf(slot, 0, &tmp);
             if (ret != ESP_OK) {
                 return ret;
             }
@@ -858,18 +910,26 @@ static esp_err_t start_command_write_blocks(slot_info_t *slot, sdspi_hw_cmd_t *c
             tx_data = tmp;
         }
 
-        // Write data
+        // Write data; queue the transaction and compute the CRC of the block while the DMA
+        // clocks it out, instead of serializing the two
         spi_transaction_t t_data = {
             .length = will_send * 8,
             .tx_buffer = tx_data,
         };
-        ret = spi_device_transmit(slot->spi_handle, &t_data);
+        ret = spi_device_queue_trans(slot->spi_handle, &t_data, portMAX_DELAY);
         if (ret != ESP_OK) {
             return ret;
         }
 
-        // Write CRC and get the response in one transaction
         uint16_t crc = sdspi_crc16(data, will_send);
+
+        spi_transaction_t* t_ret;
+        ret = spi_device_get_trans_result(slot->spi_handle, &t_ret, portMAX_DELAY);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+
+        // Write CRC and get the response in one transaction
         const int size_crc_response = sizeof(crc) + 1;
 
         spi_transaction_t t_crc_rsp = {
@@ -104,6 +104,10 @@ static void r1_sdio_response_to_err(uint8_t r1, int cmd, esp_err_t *out_err)
 
 esp_err_t sdspi_host_do_transaction(int slot, sdmmc_command_t *cmdinfo)
 {
+    if (cmdinfo->sg_frag_count > 0) {
+        // scatter-gather transfers are only supported by the SDMMC host
+        return ESP_ERR_NOT_SUPPORTED;
+    }
     _lock_acquire(&s_lock);
     // Convert the command to wire format
     WORD_ALIGNED_ATTR sdspi_hw_cmd_t hw_cmd;
@@ -22,6 +22,10 @@
 #include "stdatomic.h"
 #include "esp_log.h"
 #include <strings.h>
+#include <string.h>
+#if CONFIG_SPI_BUS_LOCK_STATS
+#include "esp_timer.h"
+#endif
 
 
 /*
@@ -216,12 +220,22 @@ struct spi_bus_lock_t {
     //debug information
     int                 host_id;        ///< Host ID, for debug information printing
     uint32_t            new_req;        ///< Last int_req when `spi_bus_lock_bg_start` is called. Debug use.
+
+#if CONFIG_SPI_BUS_LOCK_FAIR
+    //// Critical resources, only written by the acquiring processor, like `acquiring_dev`.
+    int                 last_granted_id;    ///< Device granted most recently
+    int                 consec_grants;      ///< Consecutive grants to `last_granted_id`
+#endif
 };
 
 struct spi_bus_lock_dev_t {
     SemaphoreHandle_t   semphr;     ///< Binray semaphore to notify the device it claimed the bus
     spi_bus_lock_t*     parent;     ///< Pointer to parent spi_bus_lock_t
     uint32_t            mask;       ///< Bitwise OR-ed mask of the REQ, PEND, LOCK bits of this device
+#if CONFIG_SPI_BUS_LOCK_STATS
+    spi_bus_lock_stats_t stats;     ///< Contention statistics, written by the owning task except `deferred_grants`
+    int64_t             acquired_at;    ///< Timestamp of the last successful acquire
+#endif
 };
 
 DRAM_ATTR static const char TAG[] = "bus_lock";
@@ -266,6 +280,50 @@ IRAM_ATTR static inline uint32_t lock_status_clear(spi_bus_lock_t* lock, uint32_
     return state & (~clear);
 }
 
+/*******************************************************************************
+ * Fair grant selection
+ *
+ * `mask_get_id` always returns the lowest set bit, so under sustained
+ * contention the device with the smallest ID wins every reschedule and can
+ * starve the others. With CONFIG_SPI_BUS_LOCK_FAIR the acquiring processor
+ * tracks how many grants in a row went to the same device and, once the
+ * budget is used up while another candidate is waiting, passes the grant on.
+ * The grant bookkeeping is a critical resource like `acquiring_dev`: only
+ * the acquiring processor touches it.
+ ******************************************************************************/
+#if CONFIG_SPI_BUS_LOCK_FAIR
+IRAM_ATTR static inline void track_grant(spi_bus_lock_t *lock, int dev_id)
+{
+    if (dev_id == lock->last_granted_id) {
+        lock->consec_grants++;
+    } else {
+        lock->last_granted_id = dev_id;
+        lock->consec_grants = 1;
+    }
+}
+
+IRAM_ATTR static inline int pick_dev_id(spi_bus_lock_t *lock, uint32_t cand_bits)
+{
+    int dev_id = mask_get_id(cand_bits);
+    if (dev_id == lock->last_granted_id &&
+            lock->consec_grants >= CONFIG_SPI_BUS_LOCK_MAX_CONSEC_GRANTS &&
+            (cand_bits & (cand_bits - 1)) != 0) {
+#if CONFIG_SPI_BUS_LOCK_STATS
+        spi_bus_lock_dev_t *skipped = (spi_bus_lock_dev_t *)atomic_load(&lock->dev[dev_id]);
+        if (skipped) {
+            skipped->stats.deferred_grants++;
+        }
+#endif
+        dev_id = mask_get_id(cand_bits & ~BIT(dev_id));
+    }
+    track_grant(lock, dev_id);
+    return dev_id;
+}
+#else
+#define pick_dev_id(lock, cand_bits)    mask_get_id(cand_bits)
+#define track_grant(lock, dev_id)
+#endif
+
 /*******************************************************************************
  * Schedule service
  *
@@ -336,6 +394,7 @@ SPI_MASTER_ISR_ATTR static inline bool acquire_core(spi_bus_lock_dev_t *dev_hand
     if ((status & (BG_MASK | LOCK_MASK)) == 0) {
         //succeed at once
         lock->acquiring_dev = dev_handle;
+        track_grant(lock, dev_lock_get_id(dev_handle));
         BUS_LOCK_DEBUG_EXECUTE_CHECK(!lock->acq_dev_bg_active);
         if (status & WEAK_BG_FLAG) {
             //Mainly to disable the cache (Weak_BG), that is not able to disable itself
@@ -378,7 +437,7 @@ schedule_core(spi_bus_lock_t *lock, uint32_t status, spi_bus_lock_dev_t **out_de
 
     bool bg_yield;
     if (lock_bits) {
-        int dev_id = mask_get_id(lock_bits);
+        int dev_id = pick_dev_id(lock, lock_bits);
         desired_dev = (spi_bus_lock_dev_t *)atomic_load(&lock->dev[dev_id]);
         BUS_LOCK_DEBUG_EXECUTE_CHECK(desired_dev);
 
@@ -388,7 +447,7 @@ schedule_core(spi_bus_lock_t *lock, uint32_t status, spi_bus_lock_dev_t **out_de
     } else {
         lock->acq_dev_bg_active = false;
         if (bg_bits) {
-            int dev_id = mask_get_id(bg_bits);
+            int dev_id = pick_dev_id(lock, bg_bits);
             desired_dev = (spi_bus_lock_dev_t *)atomic_load(&lock->dev[dev_id]);
             BUS_LOCK_DEBUG_EXECUTE_CHECK(desired_dev);
 
@@ -665,6 +724,51 @@ IRAM_ATTR bool spi_bus_lock_touch(spi_bus_lock_dev_handle_t dev_handle)
     return (dev_handle != last_dev);
 }
 
+/*******************************************************************************
+ * Contention statistics
+ ******************************************************************************/
+esp_err_t spi_bus_lock_get_dev_stats(spi_bus_lock_dev_handle_t dev_handle, spi_bus_lock_stats_t *out_stats)
+{
+#if CONFIG_SPI_BUS_LOCK_STATS
+    if (dev_handle == NULL || out_stats == NULL) return ESP_ERR_INVALID_ARG;
+    *out_stats = dev_handle->stats;
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+esp_err_t spi_bus_lock_reset_dev_stats(spi_bus_lock_dev_handle_t dev_handle)
+{
+#if CONFIG_SPI_BUS_LOCK_STATS
+    if (dev_handle == NULL) return ESP_ERR_INVALID_ARG;
+    memset(&dev_handle->stats, 0, sizeof(dev_handle->stats));
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+void spi_bus_lock_dump_stats(spi_bus_lock_handle_t lock)
+{
+#if CONFIG_SPI_BUS_LOCK_STATS
+    for (int i = 0; i < DEV_NUM_MAX; i++) {
+        spi_bus_lock_dev_t *dev = (spi_bus_lock_dev_t *)atomic_load(&lock->dev[i]);
+        if ((intptr_t)dev <= 1) continue;   //empty, or still being registered
+        const spi_bus_lock_stats_t *s = &dev->stats;
+        uint32_t avg_wait = s->contended ? (uint32_t)(s->total_wait_us / s->contended) : 0;
+        uint32_t avg_hold = s->acquires ? (uint32_t)(s->total_hold_us / s->acquires) : 0;
+        ESP_LOGI(TAG, "bus %d dev %d: acq %u (contended %u), wait avg/max %u/%u us, "
+                 "hold avg/max %u/%u us, deferred %u",
+                 lock->host_id, i, s->acquires, s->contended,
+                 avg_wait, s->max_wait_us, avg_hold, s->max_hold_us,
+                 s->deferred_grants);
+    }
+#else
+    ESP_LOGI(TAG, "bus %d: enable CONFIG_SPI_BUS_LOCK_STATS for lock statistics", lock->host_id);
+#endif
+}
+
 /*******************************************************************************
  * Acquiring service
  ******************************************************************************/
@@ -677,11 +781,26 @@ IRAM_ATTR esp_err_t spi_bus_lock_acquire_start(spi_bus_lock_dev_t *dev_handle, T
     // Clear the semaphore before checking
     dev_wait_prepare(dev_handle);
     if (!acquire_core(dev_handle)) {
+#if CONFIG_SPI_BUS_LOCK_STATS
+        int64_t wait_start = esp_timer_get_time();
+#endif
         //block until becoming the acquiring processor (help by previous acquiring processor)
         esp_err_t err = dev_wait(dev_handle, wait);
         //TODO: add timeout handling here.
         if (err != ESP_OK) return err;
+#if CONFIG_SPI_BUS_LOCK_STATS
+        uint32_t waited = (uint32_t)(esp_timer_get_time() - wait_start);
+        dev_handle->stats.contended++;
+        dev_handle->stats.total_wait_us += waited;
+        if (waited > dev_handle->stats.max_wait_us) {
+            dev_handle->stats.max_wait_us = waited;
+        }
+#endif
     }
+#if CONFIG_SPI_BUS_LOCK_STATS
+    dev_handle->stats.acquires++;
+    dev_handle->acquired_at = esp_timer_get_time();
+#endif
 
     ESP_DRAM_LOGV(TAG, "dev %d acquired.", dev_lock_get_id(dev_handle));
     BUS_LOCK_DEBUG_EXECUTE_CHECK(lock->acquiring_dev == dev_handle);
@@ -700,6 +819,14 @@ IRAM_ATTR esp_err_t spi_bus_lock_acquire_end(spi_bus_lock_dev_t *dev_handle)
     spi_bus_lock_t* lock = dev_handle->parent;
     LOCK_CHECK(lock->acquiring_dev == dev_handle, "Cannot release a lock that hasn't been acquired.", ESP_ERR_INVALID_STATE);
 
+#if CONFIG_SPI_BUS_LOCK_STATS
+    uint32_t held = (uint32_t)(esp_timer_get_time() - dev_handle->acquired_at);
+    dev_handle->stats.total_hold_us += held;
+    if (held > dev_handle->stats.max_hold_us) {
+        dev_handle->stats.max_hold_us = held;
+    }
+#endif
+
     acquire_end_core(dev_handle);
 
     ESP_LOGV(TAG, "dev %d released.", dev_lock_get_id(dev_handle));
@@ -138,6 +138,7 @@ typedef struct {
     const uint32_t *buffer_to_send;   //equals to tx_data, if SPI_TRANS_USE_RXDATA is applied; otherwise if original buffer wasn't in DMA-capable memory, this gets the address of a temporary buffer that is;
                                 //otherwise sets to the original buffer or NULL if no buffer is assigned.
     uint32_t *buffer_to_rcv;    // similar to buffer_to_send
+    const spi_hal_trans_config_t *prepared;   //configuration precompiled by `spi_device_prepare_trans`, NULL for ordinary transactions
 } spi_trans_priv_t;
 
 typedef struct {
@@ -529,34 +530,41 @@ static void SPI_MASTER_ISR_ATTR spi_new_trans(spi_device_t *dev, spi_trans_priv_
 
     //set the transaction specific configuration each time before a transaction setup
     spi_hal_trans_config_t hal_trans = {};
-    hal_trans.tx_bitlen = trans->length;
-    hal_trans.rx_bitlen = trans->rxlength;
-    hal_trans.rcv_buffer = (uint8_t*)host->cur_trans_buf.buffer_to_rcv;
-    hal_trans.send_buffer = (uint8_t*)host->cur_trans_buf.buffer_to_send;
-    hal_trans.cmd = trans->cmd;
-    hal_trans.addr = trans->addr;
-    //Set up QIO/DIO if needed
-    hal_trans.io_mode = (trans->flags & SPI_TRANS_MODE_DIO ?
-                        (trans->flags & SPI_TRANS_MODE_DIOQIO_ADDR ? SPI_LL_IO_MODE_DIO : SPI_LL_IO_MODE_DUAL) :
-                    (trans->flags & SPI_TRANS_MODE_QIO ?
-                        (trans->flags & SPI_TRANS_MODE_DIOQIO_ADDR ? SPI_LL_IO_MODE_QIO : SPI_LL_IO_MODE_QUAD) :
-                    SPI_LL_IO_MODE_NORMAL
-                    ));
-
-    if (trans->flags & SPI_TRANS_VARIABLE_CMD) {
-        hal_trans.cmd_bits = ((spi_transaction_ext_t *)trans)->command_bits;
-    } else {
-        hal_trans.cmd_bits = dev->cfg.command_bits;
-    }
-    if (trans->flags & SPI_TRANS_VARIABLE_ADDR) {
-        hal_trans.addr_bits = ((spi_transaction_ext_t *)trans)->address_bits;
+    if (trans_buf->prepared) {
+        //all the fields except the buffers were precompiled by `spi_device_prepare_trans`
+        hal_trans = *trans_buf->prepared;
+        hal_trans.rcv_buffer = (uint8_t*)host->cur_trans_buf.buffer_to_rcv;
+        hal_trans.send_buffer = (uint8_t*)host->cur_trans_buf.buffer_to_send;
     } else {
-        hal_trans.addr_bits = dev->cfg.address_bits;
-    }
-    if (trans->flags & SPI_TRANS_VARIABLE_DUMMY) {
-        hal_trans.dummy_bits = ((spi_transaction_ext_t *)trans)->dummy_bits;
-    } else {
-        hal_trans.dummy_bits = dev->cfg.dummy_bits;
+        hal_trans.tx_bitlen = trans->length;
+        hal_trans.rx_bitlen = trans->rxlength;
+        hal_trans.rcv_buffer = (uint8_t*)host->cur_trans_buf.buffer_to_rcv;
+        hal_trans.send_buffer = (uint8_t*)host->cur_trans_buf.buffer_to_send;
+        hal_trans.cmd = trans->cmd;
+        hal_trans.addr = trans->addr;
+        //Set up QIO/DIO if needed
+        hal_trans.io_mode = (trans->flags & SPI_TRANS_MODE_DIO ?
+                            (trans->flags & SPI_TRANS_MODE_DIOQIO_ADDR ? SPI_LL_IO_MODE_DIO : SPI_LL_IO_MODE_DUAL) :
+                        (trans->flags & SPI_TRANS_MODE_QIO ?
+                            (trans->flags & SPI_TRANS_MODE_DIOQIO_ADDR ? SPI_LL_IO_MODE_QIO : SPI_LL_IO_MODE_QUAD) :
+                        SPI_LL_IO_MODE_NORMAL
+                        ));
+
+        if (trans->flags & SPI_TRANS_VARIABLE_CMD) {
+            hal_trans.cmd_bits = ((spi_transaction_ext_t *)trans)->command_bits;
+        } else {
+            hal_trans.cmd_bits = dev->cfg.command_bits;
+        }
+        if (trans->flags & SPI_TRANS_VARIABLE_ADDR) {
+            hal_trans.addr_bits = ((spi_transaction_ext_t *)trans)->address_bits;
+        } else {
+            hal_trans.addr_bits = dev->cfg.address_bits;
+        }
+        if (trans->flags & SPI_TRANS_VARIABLE_DUMMY) {
+            hal_trans.dummy_bits = ((spi_transaction_ext_t *)trans)->dummy_bits;
+        } else {
+            hal_trans.dummy_bits = dev->cfg.dummy_bits;
+        }
     }
 
     spi_hal_setup_trans(hal, hal_dev, &hal_trans);
@@ -777,43 +785,47 @@ clean_up:
     return ESP_ERR_NO_MEM;
 }
 
-esp_err_t SPI_MASTER_ATTR spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans_desc, TickType_t ticks_to_wait)
+// Send the already set up private descriptor to the ISR. Shared by the ordinary
+// and the prepared-transaction paths; the caller is responsible for releasing
+// resources held by the descriptor if an error is returned.
+static esp_err_t SPI_MASTER_ATTR spi_device_queue_trans_priv(spi_device_handle_t handle, spi_trans_priv_t *trans_buf, TickType_t ticks_to_wait)
 {
-    esp_err_t ret = check_trans_valid(handle, trans_desc);
-    if (ret != ESP_OK) return ret;
-
     spi_host_t *host = handle->host;
-
-    SPI_CHECK(!spi_bus_device_is_polling(handle), "Cannot queue new transaction while previous polling transaction is not terminated.", ESP_ERR_INVALID_STATE );
-
-    spi_trans_priv_t trans_buf;
-    ret = setup_priv_desc(trans_desc, &trans_buf, (host->bus_attr->dma_chan!=0));
-    if (ret != ESP_OK) return ret;
-
 #ifdef CONFIG_PM_ENABLE
     esp_pm_lock_acquire(host->bus_attr->pm_lock);
 #endif
     //Send to queue and invoke the ISR.
 
-    BaseType_t r = xQueueSend(handle->trans_queue, (void *)&trans_buf, ticks_to_wait);
+    BaseType_t r = xQueueSend(handle->trans_queue, (void *)trans_buf, ticks_to_wait);
     if (!r) {
-        ret = ESP_ERR_TIMEOUT;
 #ifdef CONFIG_PM_ENABLE
         //Release APB frequency lock
         esp_pm_lock_release(host->bus_attr->pm_lock);
 #endif
-        goto clean_up;
+        return ESP_ERR_TIMEOUT;
     }
 
     // The ISR will be invoked at correct time by the lock with `spi_bus_intr_enable`.
-    ret = spi_bus_lock_bg_request(handle->dev_lock);
+    return spi_bus_lock_bg_request(handle->dev_lock);
+}
+
+esp_err_t SPI_MASTER_ATTR spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans_desc, TickType_t ticks_to_wait)
+{
+    esp_err_t ret = check_trans_valid(handle, trans_desc);
+    if (ret != ESP_OK) return ret;
+
+    spi_host_t *host = handle->host;
+
+    SPI_CHECK(!spi_bus_device_is_polling(handle), "Cannot queue new transaction while previous polling transaction is not terminated.", ESP_ERR_INVALID_STATE );
+
+    spi_trans_priv_t trans_buf;
+    ret = setup_priv_desc(trans_desc, &trans_buf, (host->bus_attr->dma_chan!=0));
+    if (ret != ESP_OK) return ret;
+
+    ret = spi_device_queue_trans_priv(handle, &trans_buf, ticks_to_wait);
     if (ret != ESP_OK) {
-        goto clean_up;
+        uninstall_priv_desc(&trans_buf);
     }
-    return ESP_OK;
-
-clean_up:
-    uninstall_priv_desc(&trans_buf);
     return ret;
 }
 
@@ -843,6 +855,15 @@ esp_err_t SPI_MASTER_ATTR spi_device_transmit(spi_device_handle_t handle, spi_tr
 {
     esp_err_t ret;
     spi_transaction_t *ret_trans;
+#if CONFIG_SPI_MASTER_AUTO_POLLING_THRESHOLD > 0
+    //For short transfers the polling mode finishes faster than the overhead of going
+    //through the ISR and the task switches costs. This function blocks anyway, so the
+    //result is the same, except that the pre/post callbacks run in the calling task.
+    if (trans_desc->length <= CONFIG_SPI_MASTER_AUTO_POLLING_THRESHOLD * 8 &&
+            trans_desc->rxlength <= CONFIG_SPI_MASTER_AUTO_POLLING_THRESHOLD * 8) {
+        return spi_device_polling_transmit(handle, trans_desc);
+    }
+#endif
     //ToDo: check if any spi transfers in flight
     ret = spi_device_queue_trans(handle, trans_desc, portMAX_DELAY);
     if (ret != ESP_OK) return ret;
@@ -978,3 +999,175 @@ esp_err_t SPI_MASTER_ISR_ATTR spi_device_polling_transmit(spi_device_handle_t ha
 
     return spi_device_polling_end(handle, portMAX_DELAY);
 }
+
+esp_err_t SPI_MASTER_ATTR spi_device_transmit_batch(spi_device_handle_t handle, spi_transaction_t *trans_desc[], int trans_num)
+{
+    SPI_CHECK(handle != NULL && trans_desc != NULL && trans_num > 0, "invalid argument", ESP_ERR_INVALID_ARG);
+
+    //Validate the whole batch up front, so that it fails before any part has been sent.
+    for (int i = 0; i < trans_num; i++) {
+        esp_err_t ret = check_trans_valid(handle, trans_desc[i]);
+        if (ret != ESP_OK) return ret;
+    }
+
+    spi_host_t *host = handle->host;
+    esp_err_t ret = ESP_OK;
+    bool release_bus = false;
+    if (host->device_acquiring_lock != handle) {
+        //Occupy the bus for the whole batch: the device setup is then done only once,
+        //and no other device can slip in between the transactions.
+        ret = spi_device_acquire_bus(handle, portMAX_DELAY);
+        if (ret != ESP_OK) return ret;
+        release_bus = true;
+    }
+
+    for (int i = 0; i < trans_num && ret == ESP_OK; i++) {
+        ret = spi_device_polling_transmit(handle, trans_desc[i]);
+    }
+
+    if (release_bus) {
+        spi_device_release_bus(handle);
+    }
+    return ret;
+}
+
+/*-----------------------------------------------------------------------------
+    Prepared (precompiled) transactions
+-----------------------------------------------------------------------------*/
+
+struct spi_prepared_trans_t {
+    spi_device_t *dev;
+    spi_transaction_t *trans;
+    spi_hal_trans_config_t hal_trans;   //precompiled configuration, the buffers are filled in on each submission
+};
+
+esp_err_t spi_device_prepare_trans(spi_device_handle_t handle, spi_transaction_t *trans_desc, spi_prepared_trans_handle_t *out_prepared)
+{
+    SPI_CHECK(out_prepared != NULL, "invalid out_prepared pointer", ESP_ERR_INVALID_ARG);
+    esp_err_t ret = check_trans_valid(handle, trans_desc);
+    if (ret != ESP_OK) return ret;
+
+    //the prepared transaction may be submitted from an ISR-pinned path, keep it in internal memory
+    spi_prepared_trans_handle_t prepared = heap_caps_malloc(sizeof(struct spi_prepared_trans_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (prepared == NULL) return ESP_ERR_NO_MEM;
+
+    spi_transaction_t *trans = trans_desc;
+    spi_hal_trans_config_t *hal_trans = &prepared->hal_trans;
+    *hal_trans = (spi_hal_trans_config_t) {};
+    //same computation done by `spi_new_trans` for ordinary transactions, performed once here
+    hal_trans->tx_bitlen = trans->length;
+    hal_trans->rx_bitlen = trans->rxlength;
+    hal_trans->cmd = trans->cmd;
+    hal_trans->addr = trans->addr;
+    hal_trans->io_mode = (trans->flags & SPI_TRANS_MODE_DIO ?
+                        (trans->flags & SPI_TRANS_MODE_DIOQIO_ADDR ? SPI_LL_IO_MODE_DIO : SPI_LL_IO_MODE_DUAL) :
+                    (trans->flags & SPI_TRANS_MODE_QIO ?
+                        (trans->flags & SPI_TRANS_MODE_DIOQIO_ADDR ? SPI_LL_IO_MODE_QIO : SPI_LL_IO_MODE_QUAD) :
+                    SPI_LL_IO_MODE_NORMAL
+                    ));
+    if (trans->flags & SPI_TRANS_VARIABLE_CMD) {
+        hal_trans->cmd_bits = ((spi_transaction_ext_t *)trans)->command_bits;
+    } else {
+        hal_trans->cmd_bits = handle->cfg.command_bits;
+    }
+    if (trans->flags & SPI_TRANS_VARIABLE_ADDR) {
+        hal_trans->addr_bits = ((spi_transaction_ext_t *)trans)->address_bits;
+    } else {
+        hal_trans->addr_bits = handle->cfg.address_bits;
+    }
+    if (trans->flags & SPI_TRANS_VARIABLE_DUMMY) {
+        hal_trans->dummy_bits = ((spi_transaction_ext_t *)trans)->dummy_bits;
+    } else {
+        hal_trans->dummy_bits = handle->cfg.dummy_bits;
+    }
+
+    prepared->dev = handle;
+    prepared->trans = trans_desc;
+    *out_prepared = prepared;
+    return ESP_OK;
+}
+
+// Fill the private descriptor from a prepared transaction. Unlike `setup_priv_desc`
+// no bounce buffers are allocated on this path: when the bus uses DMA the buffers
+// must already be DMA-capable (and the rx buffer word-aligned).
+static esp_err_t SPI_MASTER_ISR_ATTR setup_prepared_priv_desc(spi_prepared_trans_handle_t prepared, spi_trans_priv_t *new_desc, bool isdma)
+{
+    spi_transaction_t *trans_desc = prepared->trans;
+    *new_desc = (spi_trans_priv_t) {
+        .trans = trans_desc,
+        .prepared = &prepared->hal_trans,
+    };
+
+    uint32_t *rcv_ptr;
+    if (trans_desc->flags & SPI_TRANS_USE_RXDATA) {
+        rcv_ptr = (uint32_t *)&trans_desc->rx_data[0];
+    } else {
+        rcv_ptr = trans_desc->rx_buffer;
+    }
+    if (rcv_ptr && isdma && (!esp_ptr_dma_capable(rcv_ptr) || ((int)rcv_ptr % 4 != 0))) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    new_desc->buffer_to_rcv = rcv_ptr;
+
+    const uint32_t *send_ptr;
+    if (trans_desc->flags & SPI_TRANS_USE_TXDATA) {
+        send_ptr = (uint32_t *)&trans_desc->tx_data[0];
+    } else {
+        send_ptr = trans_desc->tx_buffer;
+    }
+    if (send_ptr && isdma && !esp_ptr_dma_capable(send_ptr)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    new_desc->buffer_to_send = send_ptr;
+
+    return ESP_OK;
+}
+
+esp_err_t SPI_MASTER_ATTR spi_device_queue_prepared_trans(spi_prepared_trans_handle_t prepared, TickType_t ticks_to_wait)
+{
+    SPI_CHECK(prepared != NULL, "invalid prepared handle", ESP_ERR_INVALID_ARG);
+    spi_device_handle_t handle = prepared->dev;
+
+    SPI_CHECK(!spi_bus_device_is_polling(handle), "Cannot queue new transaction while previous polling transaction is not terminated.", ESP_ERR_INVALID_STATE );
+
+    spi_trans_priv_t trans_buf;
+    esp_err_t ret = setup_prepared_priv_desc(prepared, &trans_buf, (handle->host->bus_attr->dma_chan!=0));
+    if (ret != ESP_OK) return ret;
+
+    return spi_device_queue_trans_priv(handle, &trans_buf, ticks_to_wait);
+}
+
+esp_err_t SPI_MASTER_ISR_ATTR spi_device_polling_transmit_prepared(spi_prepared_trans_handle_t prepared)
+{
+    SPI_CHECK(prepared != NULL, "invalid prepared handle", ESP_ERR_INVALID_ARG);
+    spi_device_handle_t handle = prepared->dev;
+    spi_host_t *host = handle->host;
+
+    SPI_CHECK(!spi_bus_device_is_polling(handle), "Cannot send polling transaction while the previous polling transaction is not terminated.", ESP_ERR_INVALID_STATE );
+
+    esp_err_t ret;
+    if (host->device_acquiring_lock != handle) {
+        ret = spi_bus_lock_acquire_start(handle->dev_lock, portMAX_DELAY);
+    } else {
+        ret = spi_bus_lock_wait_bg_done(handle->dev_lock, portMAX_DELAY);
+    }
+    if (ret != ESP_OK) return ret;
+
+    ret = setup_prepared_priv_desc(prepared, &host->cur_trans_buf, (host->bus_attr->dma_chan!=0));
+    if (ret != ESP_OK) return ret;
+
+    //Polling, no interrupt is used.
+    host->polling = true;
+
+    ESP_LOGV(SPI_TAG, "polling trans (prepared)");
+    spi_new_trans(handle, &host->cur_trans_buf);
+
+    return spi_device_polling_end(handle, portMAX_DELAY);
+}
+
+esp_err_t spi_device_release_prepared_trans(spi_prepared_trans_handle_t prepared)
+{
+    SPI_CHECK(prepared != NULL, "invalid prepared handle", ESP_ERR_INVALID_ARG);
+    free(prepared);
+    return ESP_OK;
+}
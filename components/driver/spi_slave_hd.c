@@ -26,6 +26,15 @@
 #define VALID_HOST(x) (x>SPI_HOST && x<=HSPI_HOST)
 #define SPIHD_CHECK(cond,warn,ret) do{if(!(cond)){ESP_LOGE(TAG, warn); return ret;}} while(0)
 
+typedef struct {
+    spi_slave_hd_data_t *trans;     //descriptor array given by the caller, NULL while the ring is stopped
+    uint32_t trans_num;             //number of descriptors in the ring
+    volatile uint32_t isr_idx;      //next ring slot the ISR will load into the DMA
+    volatile uint32_t done_cnt;     //transfers finished since the ring was started
+    uint32_t watermark;             //invoke the ring callback every this many finished transfers
+    uint32_t watermark_cnt;         //transfers finished since the last ring callback
+} spi_slave_hd_ring_t;
+
 typedef struct {
     spi_slave_hd_hal_context_t hal;
     int dma_chan;
@@ -41,6 +50,12 @@ typedef struct {
 
     spi_slave_hd_data_t* tx_desc;
     spi_slave_hd_data_t* rx_desc;
+    //true when the descriptor in flight was loaded from the ring, not from the transaction queue
+    bool tx_desc_ring;
+    bool rx_desc_ring;
+
+    spi_slave_hd_ring_t tx_ring;
+    spi_slave_hd_ring_t rx_ring;
 
     uint32_t flags;
 
@@ -257,7 +272,23 @@ static IRAM_ATTR void spi_slave_hd_intr(void* arg)
     }
     portEXIT_CRITICAL_ISR(&host->int_spinlock);
 
-    if (tx_done) {
+    if (tx_done && host->tx_desc_ring) {
+        spi_slave_hd_ring_t *ring = &host->tx_ring;
+        ring->done_cnt++;
+        ring->watermark_cnt++;
+        if (ring->watermark_cnt >= ring->watermark && callback->cb_ring_tx) {
+            spi_slave_hd_event_t ev = {
+                .event = SPI_EV_SEND,
+                .trans = host->tx_desc,
+            };
+            BaseType_t cb_awoken = pdFALSE;
+            callback->cb_ring_tx(callback->arg, &ev, &cb_awoken);
+            awoken |= cb_awoken;
+            ring->watermark_cnt = 0;
+        }
+        host->tx_desc = NULL;
+        host->tx_desc_ring = false;
+    } else if (tx_done) {
         bool ret_queue = true;
         if (callback->cb_sent) {
             spi_slave_hd_event_t ev = {
@@ -275,7 +306,24 @@ static IRAM_ATTR void spi_slave_hd_intr(void* arg)
         }
         host->tx_desc = NULL;
     }
-    if (rx_done) {
+    if (rx_done && host->rx_desc_ring) {
+        spi_slave_hd_ring_t *ring = &host->rx_ring;
+        host->rx_desc->trans_len = spi_slave_hd_hal_rxdma_get_len(&host->hal);
+        ring->done_cnt++;
+        ring->watermark_cnt++;
+        if (ring->watermark_cnt >= ring->watermark && callback->cb_ring_rx) {
+            spi_slave_hd_event_t ev = {
+                .event = SPI_EV_RECV,
+                .trans = host->rx_desc,
+            };
+            BaseType_t cb_awoken = pdFALSE;
+            callback->cb_ring_rx(callback->arg, &ev, &cb_awoken);
+            awoken |= cb_awoken;
+            ring->watermark_cnt = 0;
+        }
+        host->rx_desc = NULL;
+        host->rx_desc_ring = false;
+    } else if (rx_done) {
         bool ret_queue = true;
 
         host->rx_desc->trans_len = spi_slave_hd_hal_rxdma_get_len(&host->hal);
@@ -300,17 +348,36 @@ static IRAM_ATTR void spi_slave_hd_intr(void* arg)
     bool tx_sent = false;
     bool rx_sent = false;
     if (!host->tx_desc) {
-        ret = xQueueReceiveFromISR(host->tx_trans_queue, &host->tx_desc, &awoken);
-        if (ret == pdTRUE) {
+        //an active ring re-arms the DMA right here, without waiting for the application to queue
+        if (host->tx_ring.trans) {
+            spi_slave_hd_ring_t *ring = &host->tx_ring;
+            host->tx_desc = &ring->trans[ring->isr_idx];
+            host->tx_desc_ring = true;
+            ring->isr_idx = (ring->isr_idx + 1) % ring->trans_num;
             spi_slave_hd_hal_txdma(&host->hal, host->tx_desc->data, host->tx_desc->len);
             tx_sent = true;
+        } else {
+            ret = xQueueReceiveFromISR(host->tx_trans_queue, &host->tx_desc, &awoken);
+            if (ret == pdTRUE) {
+                spi_slave_hd_hal_txdma(&host->hal, host->tx_desc->data, host->tx_desc->len);
+                tx_sent = true;
+            }
         }
     }
     if (!host->rx_desc) {
-        ret = xQueueReceiveFromISR(host->rx_trans_queue, &host->rx_desc, &awoken);
-        if (ret == pdTRUE) {
+        if (host->rx_ring.trans) {
+            spi_slave_hd_ring_t *ring = &host->rx_ring;
+            host->rx_desc = &ring->trans[ring->isr_idx];
+            host->rx_desc_ring = true;
+            ring->isr_idx = (ring->isr_idx + 1) % ring->trans_num;
             spi_slave_hd_hal_rxdma(&host->hal, host->rx_desc->data, host->rx_desc->len);
             rx_sent = true;
+        } else {
+            ret = xQueueReceiveFromISR(host->rx_trans_queue, &host->rx_desc, &awoken);
+            if (ret == pdTRUE) {
+                spi_slave_hd_hal_rxdma(&host->hal, host->rx_desc->data, host->rx_desc->len);
+                rx_sent = true;
+            }
         }
     }
 
@@ -369,6 +436,63 @@ esp_err_t spi_slave_hd_get_trans_res(spi_host_device_t host_id, spi_slave_chan_t
     return ESP_OK;
 }
 
+esp_err_t spi_slave_hd_ring_start(spi_host_device_t host_id, spi_slave_chan_t chan,
+                                  spi_slave_hd_data_t *trans, uint32_t trans_num, uint32_t watermark)
+{
+    spi_slave_hd_slot_t *host = spihost[host_id];
+    SPIHD_CHECK(host != NULL, "The driver is not initialized", ESP_ERR_INVALID_STATE);
+    SPIHD_CHECK(chan == SPI_SLAVE_CHAN_TX || chan == SPI_SLAVE_CHAN_RX, "Invalid channel", ESP_ERR_INVALID_ARG);
+    SPIHD_CHECK(trans != NULL && trans_num >= 2, "The ring needs at least 2 descriptors", ESP_ERR_INVALID_ARG);
+    SPIHD_CHECK(watermark >= 1 && watermark <= trans_num, "Invalid watermark", ESP_ERR_INVALID_ARG);
+    for (uint32_t i = 0; i < trans_num; i++) {
+        SPIHD_CHECK(esp_ptr_dma_capable(trans[i].data), "The buffer should be DMA capable.", ESP_ERR_INVALID_ARG);
+        SPIHD_CHECK(trans[i].len <= host->max_transfer_sz && trans[i].len > 0, "Invalid buffer size", ESP_ERR_INVALID_ARG);
+    }
+    spi_slave_hd_ring_t *ring = (chan == SPI_SLAVE_CHAN_TX) ? &host->tx_ring : &host->rx_ring;
+    SPIHD_CHECK(ring->trans == NULL, "The ring is already started", ESP_ERR_INVALID_STATE);
+
+    portENTER_CRITICAL(&host->int_spinlock);
+    ring->trans_num = trans_num;
+    ring->isr_idx = 0;
+    ring->done_cnt = 0;
+    ring->watermark = watermark;
+    ring->watermark_cnt = 0;
+    ring->trans = trans;
+    portEXIT_CRITICAL(&host->int_spinlock);
+
+    //kick the ISR so it loads the first ring descriptor right away
+    if (chan == SPI_SLAVE_CHAN_TX) {
+        tx_invoke(host);
+    } else {
+        rx_invoke(host);
+    }
+    return ESP_OK;
+}
+
+esp_err_t spi_slave_hd_ring_stop(spi_host_device_t host_id, spi_slave_chan_t chan)
+{
+    spi_slave_hd_slot_t *host = spihost[host_id];
+    SPIHD_CHECK(host != NULL, "The driver is not initialized", ESP_ERR_INVALID_STATE);
+    SPIHD_CHECK(chan == SPI_SLAVE_CHAN_TX || chan == SPI_SLAVE_CHAN_RX, "Invalid channel", ESP_ERR_INVALID_ARG);
+    spi_slave_hd_ring_t *ring = (chan == SPI_SLAVE_CHAN_TX) ? &host->tx_ring : &host->rx_ring;
+    SPIHD_CHECK(ring->trans != NULL, "The ring is not started", ESP_ERR_INVALID_STATE);
+
+    //the descriptor already loaded into the DMA finishes normally, the ISR just won't re-arm from the ring
+    portENTER_CRITICAL(&host->int_spinlock);
+    ring->trans = NULL;
+    ring->trans_num = 0;
+    portEXIT_CRITICAL(&host->int_spinlock);
+    return ESP_OK;
+}
+
+uint32_t spi_slave_hd_ring_get_done_count(spi_host_device_t host_id, spi_slave_chan_t chan)
+{
+    spi_slave_hd_slot_t *host = spihost[host_id];
+    SPIHD_CHECK(host != NULL, "The driver is not initialized", 0);
+    SPIHD_CHECK(chan == SPI_SLAVE_CHAN_TX || chan == SPI_SLAVE_CHAN_RX, "Invalid channel", 0);
+    return (chan == SPI_SLAVE_CHAN_TX) ? host->tx_ring.done_cnt : host->rx_ring.done_cnt;
+}
+
 void spi_slave_hd_read_buffer(spi_host_device_t host_id, int addr, uint8_t *out_data, size_t len)
 {
     spi_slave_hd_hal_read_buffer(&spihost[host_id]->hal, addr, out_data, len);
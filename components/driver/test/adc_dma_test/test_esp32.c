@@ -163,4 +163,63 @@ TEST_CASE("ADC DMA read", "[adc dma]")
     example_i2s_deinit();
 }
 
+#include "driver/adc_continuous.h"
+#include "freertos/semphr.h"
+
+#define ADC_CONT_TEST_BLOCK_SIZE (256)
+#define ADC_CONT_TEST_BLOCK_NUM  (8)
+
+typedef struct {
+    SemaphoreHandle_t done_sem;
+    size_t samples_per_block;
+    volatile int blocks_received;
+    volatile uint32_t last_sample;
+} adc_cont_test_ctx_t;
+
+static void adc_cont_test_callback(const uint16_t *samples, size_t sample_count, void *arg)
+{
+    adc_cont_test_ctx_t *ctx = (adc_cont_test_ctx_t *)arg;
+    TEST_ASSERT_EQUAL(ctx->samples_per_block, sample_count);
+    ctx->last_sample = samples[sample_count - 1];
+    if (++ctx->blocks_received == ADC_CONT_TEST_BLOCK_NUM) {
+        xSemaphoreGive(ctx->done_sem);
+    }
+}
+
+TEST_CASE("ADC continuous capture with filter", "[adc dma]")
+{
+    adc_cont_test_ctx_t ctx = {
+        .done_sem = xSemaphoreCreateBinary(),
+        .samples_per_block = ADC_CONT_TEST_BLOCK_SIZE / 4, // average filter decimates by 4
+    };
+    TEST_ASSERT_NOT_NULL(ctx.done_sem);
+
+    adc_continuous_config_t config = {
+        .adc_unit = I2S_ADC_UNIT,
+        .channel = I2S_ADC_CHANNEL,
+        .sample_rate_hz = EXAMPLE_I2S_SAMPLE_RATE,
+        .samples_per_block = ADC_CONT_TEST_BLOCK_SIZE,
+        .filter_type = ADC_CONTINUOUS_FILTER_AVERAGE,
+        .filter_arg = 4,
+        .callback = adc_cont_test_callback,
+        .callback_arg = &ctx,
+        .task_priority = 5,
+    };
+    // average length has to divide the block size
+    config.filter_arg = 3;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, adc_continuous_start(&config));
+    config.filter_arg = 4;
+
+    adc_fake_tie_middle(I2S_ADC_UNIT, I2S_ADC_CHANNEL);
+    TEST_ESP_OK(adc_continuous_start(&config));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, adc_continuous_start(&config));
+    TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(ctx.done_sem, pdMS_TO_TICKS(5000)));
+    TEST_ESP_OK(adc_continuous_stop());
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, adc_continuous_stop());
+    // middle level 1.4v, same bound as the raw DMA test
+    TEST_ASSERT_INT_WITHIN(128, 1586, ctx.last_sample);
+    adc_io_normal(I2S_ADC_UNIT, I2S_ADC_CHANNEL);
+    vSemaphoreDelete(ctx.done_sem);
+}
+
 #endif // !DISABLED_FOR_TARGETS(ESP8266, ESP32S2)
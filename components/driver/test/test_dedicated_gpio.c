@@ -211,4 +211,51 @@ TEST_CASE("Dedicated GPIO interrupt and callback", "[dedic_gpio]")
     vSemaphoreDelete(sem);
 }
 
+TEST_CASE("Dedicated GPIO pattern playback", "[dedic_gpio]")
+{
+    const int bundle_gpios[] = {0, 1};
+    gpio_config_t io_conf = {
+        .mode = GPIO_MODE_INPUT_OUTPUT,
+    };
+    for (int i = 0; i < sizeof(bundle_gpios) / sizeof(bundle_gpios[0]); i++) {
+        io_conf.pin_bit_mask = 1ULL << bundle_gpios[i];
+        gpio_config(&io_conf);
+    }
+    dedic_gpio_bundle_handle_t bundle = NULL;
+    dedic_gpio_bundle_config_t bundle_config = {
+        .gpio_array = bundle_gpios,
+        .array_size = sizeof(bundle_gpios) / sizeof(bundle_gpios[0]),
+        .flags = {
+            .in_en = 1,
+            .out_en = 1,
+        },
+    };
+    TEST_ESP_OK(dedic_gpio_new_bundle(&bundle_config, &bundle));
+
+    uint32_t pattern[64];
+    for (int i = 0; i < sizeof(pattern) / sizeof(pattern[0]); i++) {
+        pattern[i] = i & 0x03;
+    }
+    dedic_gpio_pattern_config_t pattern_config = {
+        .pattern = pattern,
+        .sample_count = sizeof(pattern) / sizeof(pattern[0]),
+        .sample_rate_hz = 1000000,
+    };
+    TEST_ESP_OK(dedic_gpio_bundle_write_pattern(bundle, &pattern_config));
+    // after playback, the last sample should remain on the bundle
+    TEST_ASSERT_EQUAL(pattern[63], dedic_gpio_bundle_read_out(bundle));
+    TEST_ASSERT_EQUAL(pattern[63], dedic_gpio_bundle_read_in(bundle));
+
+    // same pattern again, with jitter free timing
+    pattern_config.flags.in_critical = 1;
+    TEST_ESP_OK(dedic_gpio_bundle_write_pattern(bundle, &pattern_config));
+    TEST_ASSERT_EQUAL(pattern[63], dedic_gpio_bundle_read_out(bundle));
+
+    // sample rates the playback loop can't sustain are rejected
+    pattern_config.sample_rate_hz = 500000000;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, dedic_gpio_bundle_write_pattern(bundle, &pattern_config));
+
+    TEST_ESP_OK(dedic_gpio_del_bundle(bundle));
+}
+
 #endif // #if SOC_DEDICATED_GPIO_SUPPORTED
@@ -204,6 +204,36 @@ TEST_CASE("GPIO rising edge interrupt test", "[gpio][test_env=UT_T1_GPIO]")
     gpio_uninstall_isr_service();
 }
 
+TEST_CASE("GPIO priority isr handler test", "[gpio][test_env=UT_T1_GPIO]")
+{
+    edge_intr_times = 0;
+    //init input and output gpio
+    gpio_config_t output_io = init_io(TEST_GPIO_EXT_OUT_IO);
+    gpio_config_t input_io = init_io(TEST_GPIO_EXT_IN_IO);
+    input_io.intr_type = GPIO_INTR_POSEDGE;
+    input_io.mode = GPIO_MODE_INPUT;
+    input_io.pull_up_en = 1;
+    TEST_ESP_OK(gpio_config(&output_io));
+    TEST_ESP_OK(gpio_config(&input_io));
+    TEST_ESP_OK(gpio_set_level(TEST_GPIO_EXT_OUT_IO, 0));
+
+    TEST_ESP_OK(gpio_set_intr_type(TEST_GPIO_EXT_IN_IO, GPIO_INTR_POSEDGE));
+    //priority handlers need the isr service to be installed first
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, gpio_isr_priority_handler_add(TEST_GPIO_EXT_IN_IO, gpio_isr_edge_handler, (void*)TEST_GPIO_EXT_IN_IO));
+    TEST_ESP_OK(gpio_install_isr_service(0));
+    TEST_ESP_OK(gpio_isr_priority_handler_add(TEST_GPIO_EXT_IN_IO, gpio_isr_edge_handler, (void*)TEST_GPIO_EXT_IN_IO));
+    TEST_ESP_OK(gpio_set_level(TEST_GPIO_EXT_OUT_IO, 1));
+    TEST_ASSERT_EQUAL_INT(edge_intr_times, 1);
+    vTaskDelay(100 / portTICK_RATE_MS);
+    TEST_ESP_OK(gpio_isr_priority_handler_remove(TEST_GPIO_EXT_IN_IO));
+    //removed handler must no longer fire
+    TEST_ESP_OK(gpio_set_level(TEST_GPIO_EXT_OUT_IO, 0));
+    TEST_ESP_OK(gpio_set_level(TEST_GPIO_EXT_OUT_IO, 1));
+    vTaskDelay(100 / portTICK_RATE_MS);
+    TEST_ASSERT_EQUAL_INT(edge_intr_times, 1);
+    gpio_uninstall_isr_service();
+}
+
 TEST_CASE("GPIO falling edge interrupt test", "[gpio][test_env=UT_T1_GPIO]")
 {
     edge_intr_times = 0;
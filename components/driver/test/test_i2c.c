@@ -248,6 +248,54 @@ TEST_CASE("I2C driver memory leaking check", "[i2c]")
     TEST_ASSERT_INT_WITHIN(100, size, esp_get_free_heap_size());
 }
 
+static xSemaphoreHandle s_async_done_sem;
+static esp_err_t s_async_result;
+
+static void test_i2c_async_done_cb(i2c_port_t i2c_num, esp_err_t result, void *arg)
+{
+    TEST_ASSERT_EQUAL(I2C_MASTER_NUM, i2c_num);
+    TEST_ASSERT_EQUAL_PTR(&s_async_result, arg);
+    s_async_result = result;
+    xSemaphoreGive(s_async_done_sem);
+}
+
+TEST_CASE("I2C async transaction queue test", "[i2c]")
+{
+    uint8_t data_wr[4] = { 0x11, 0x22, 0x33, 0x44 };
+    i2c_config_t conf_master = i2c_master_init();
+    TEST_ESP_OK(i2c_param_config(I2C_MASTER_NUM, &conf_master));
+    TEST_ESP_OK(i2c_driver_install(I2C_MASTER_NUM, I2C_MODE_MASTER,
+                                   I2C_MASTER_RX_BUF_DISABLE,
+                                   I2C_MASTER_TX_BUF_DISABLE, 0));
+    s_async_done_sem = xSemaphoreCreateBinary();
+
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+    TEST_ESP_OK(i2c_master_start(cmd));
+    TEST_ESP_OK(i2c_master_write_byte(cmd, (ESP_SLAVE_ADDR << 1) | WRITE_BIT, ACK_CHECK_EN));
+    TEST_ESP_OK(i2c_master_write(cmd, data_wr, sizeof(data_wr), ACK_CHECK_EN));
+    TEST_ESP_OK(i2c_master_stop(cmd));
+
+    // Submission requires the queue to be initialized first.
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE,
+                      i2c_master_cmd_begin_async(I2C_MASTER_NUM, cmd, 1000 / portTICK_RATE_MS, test_i2c_async_done_cb, &s_async_result));
+    TEST_ESP_OK(i2c_master_async_queue_init(I2C_MASTER_NUM, 4, 10));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, i2c_master_async_queue_init(I2C_MASTER_NUM, 4, 10));
+
+    // No slave is connected, so each submission must complete with a failure result,
+    // delivered through the callback. Resubmit the same pre-encoded handle several times.
+    for (int i = 0; i < 3; i++) {
+        TEST_ESP_OK(i2c_master_cmd_begin_async(I2C_MASTER_NUM, cmd, 1000 / portTICK_RATE_MS, test_i2c_async_done_cb, &s_async_result));
+        TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(s_async_done_sem, 5000 / portTICK_RATE_MS));
+        TEST_ASSERT(s_async_result != ESP_OK);
+    }
+
+    TEST_ESP_OK(i2c_master_async_queue_deinit(I2C_MASTER_NUM));
+    i2c_cmd_link_delete(cmd);
+    vSemaphoreDelete(s_async_done_sem);
+    s_async_done_sem = NULL;
+    TEST_ESP_OK(i2c_driver_delete(I2C_MASTER_NUM));
+}
+
 #if !TEMPORARY_DISABLED_FOR_TARGETS(ESP32S2, ESP32S3)
 
 // print the reading buffer
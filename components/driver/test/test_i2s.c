@@ -13,6 +13,7 @@
 #include "driver/gpio.h"
 #include "unity.h"
 #include "math.h"
+#include "esp_heap_caps.h"
 #include "esp_rom_gpio.h"
 
 #if !TEMPORARY_DISABLED_FOR_TARGETS(ESP32S3)
@@ -142,6 +143,74 @@ TEST_CASE("I2S basic driver install, uninstall, set pin test", "[i2s]")
     TEST_ESP_OK(i2s_driver_uninstall(I2S_NUM_0));
 }
 
+static volatile int s_rx_buf_done_count;
+
+static void IRAM_ATTR test_rx_buf_done_cb(i2s_port_t i2s_num, void *buf, void *user_ctx)
+{
+    s_rx_buf_done_count++;
+}
+
+TEST_CASE("I2S zero-copy user buffer mode", "[i2s]")
+{
+    const int dma_buf_count = 4;
+    const int dma_buf_len = 100;
+    i2s_config_t i2s_config = {
+        .mode = I2S_MODE_MASTER | I2S_MODE_TX | I2S_MODE_RX,
+        .sample_rate = SAMPLE_RATE,
+        .bits_per_sample = SAMPLE_BITS,
+        .channel_format = I2S_CHANNEL_FMT_RIGHT_LEFT,
+        .communication_format = I2S_COMM_FORMAT_STAND_I2S,
+        .dma_buf_count = dma_buf_count,
+        .dma_buf_len = dma_buf_len,
+        .use_apll = 0,
+        .intr_alloc_flags = ESP_INTR_FLAG_LEVEL1,
+    };
+    i2s_pin_config_t pin_config = {
+        .bck_io_num = MASTER_BCK_IO,
+        .ws_io_num = MASTER_WS_IO,
+        .data_out_num = DATA_OUT_IO,
+        .data_in_num = DATA_IN_IO
+    };
+    TEST_ESP_OK(i2s_driver_install(I2S_NUM_0, &i2s_config, 0, NULL));
+    TEST_ESP_OK(i2s_set_pin(I2S_NUM_0, &pin_config));
+    i2s_test_io_config(I2S_TEST_MODE_LOOPBACK);
+
+    //16-bit stereo: 4 bytes per frame
+    const int buf_size = dma_buf_len * 4;
+    char *bufs[dma_buf_count];
+    for (int i = 0; i < dma_buf_count; i++) {
+        bufs[i] = heap_caps_calloc(1, buf_size, MALLOC_CAP_DMA);
+        TEST_ASSERT_NOT_NULL(bufs[i]);
+    }
+
+    TEST_ESP_OK(i2s_stop(I2S_NUM_0));
+    //buffer count must match the installed dma_buf_count
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, i2s_set_rx_user_buffers(I2S_NUM_0, bufs, dma_buf_count - 1, test_rx_buf_done_cb, NULL));
+    s_rx_buf_done_count = 0;
+    TEST_ESP_OK(i2s_set_rx_user_buffers(I2S_NUM_0, bufs, dma_buf_count, test_rx_buf_done_cb, NULL));
+    TEST_ESP_OK(i2s_start(I2S_NUM_0));
+
+    //i2s_read is not available anymore, the data arrives in the registered buffers
+    size_t bytes_read = 0;
+    char dummy[8];
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, i2s_read(I2S_NUM_0, dummy, sizeof(dummy), &bytes_read, 0));
+
+    //keep TX busy so the clock runs, RX completion callbacks should arrive
+    size_t bytes_written = 0;
+    char *data_wr = calloc(1, buf_size);
+    for (int i = 0; i < 3 * dma_buf_count; i++) {
+        TEST_ESP_OK(i2s_write(I2S_NUM_0, data_wr, buf_size, &bytes_written, portMAX_DELAY));
+    }
+    vTaskDelay(pdMS_TO_TICKS(100));
+    TEST_ASSERT_GREATER_THAN(dma_buf_count, s_rx_buf_done_count);
+
+    TEST_ESP_OK(i2s_driver_uninstall(I2S_NUM_0));
+    for (int i = 0; i < dma_buf_count; i++) {
+        free(bufs[i]);
+    }
+    free(data_wr);
+}
+
 TEST_CASE("I2S Loopback test(master tx and rx)", "[i2s]")
 {
     // master driver installed and send data
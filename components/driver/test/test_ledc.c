@@ -504,6 +504,67 @@ TEST_CASE("LEDC fade with step(logic analyzer)", "[ledc][test_env=UT_T1_LEDC]")
     ledc_fade_func_uninstall();
 }
 
+TEST_CASE("LEDC fade chain", "[ledc][test_env=UT_T1_LEDC]")
+{
+#ifdef CONFIG_FREERTOS_CHECK_PORT_CRITICAL_COMPLIANCE
+    return;
+#endif
+
+#ifdef CONFIG_IDF_TARGET_ESP32
+    const ledc_mode_t test_speed_mode = LEDC_HIGH_SPEED_MODE;
+#elif defined CONFIG_IDF_TARGET_ESP32S2
+    const ledc_mode_t test_speed_mode = LEDC_LOW_SPEED_MODE;
+#endif
+    ledc_channel_config_t ledc_ch_config = {
+        .gpio_num = PULSE_IO,
+        .speed_mode = test_speed_mode,
+        .channel  = LEDC_CHANNEL_0,
+        .intr_type = LEDC_INTR_DISABLE,
+        .timer_sel = LEDC_TIMER_0,
+        .duty = 0,
+        .hpoint = 0,
+    };
+    TEST_ESP_OK(ledc_channel_config(&ledc_ch_config));
+
+    ledc_timer_config_t ledc_time_config = {
+        .speed_mode = test_speed_mode,
+        .duty_resolution = LEDC_TIMER_13_BIT,
+        .timer_num = LEDC_TIMER_0,
+        .freq_hz = 5000,
+        .clk_cfg = LEDC_USE_APB_CLK,
+    };
+    TEST_ESP_OK(ledc_timer_config(&ledc_time_config));
+
+    //initialize fade service
+    TEST_ESP_OK(ledc_fade_func_install(0));
+
+    //a blocking chain returns with the duty of the last segment
+    ledc_fade_segment_t chain[4] = {
+        { .target_duty = 1000, .time_ms = 200 },
+        { .target_duty = 4000, .time_ms = 200 },
+        { .target_duty = 2000, .time_ms = 200 },
+        { .target_duty = 500,  .time_ms = 200 },
+    };
+    TEST_ESP_OK(ledc_set_fade_chain_and_start(test_speed_mode, LEDC_CHANNEL_0, chain, 4, LEDC_FADE_WAIT_DONE));
+    TEST_ASSERT_EQUAL_INT32(ledc_get_duty(test_speed_mode, LEDC_CHANNEL_0), 500);
+
+    //a non-blocking chain runs to completion in the background
+    ledc_fade_segment_t chain2[2] = {
+        { .target_duty = 3000, .time_ms = 200 },
+        { .target_duty = 0,    .time_ms = 200 },
+    };
+    TEST_ESP_OK(ledc_set_fade_chain_and_start(test_speed_mode, LEDC_CHANNEL_0, chain2, 2, LEDC_FADE_NO_WAIT));
+    vTaskDelay(600 / portTICK_RATE_MS);
+    TEST_ASSERT_EQUAL_INT32(ledc_get_duty(test_speed_mode, LEDC_CHANNEL_0), 0);
+
+    //a segment that does not change the duty is rejected
+    ledc_fade_segment_t flat[1] = { { .target_duty = 0, .time_ms = 100 } };
+    TEST_ASSERT(ledc_set_fade_chain_and_start(test_speed_mode, LEDC_CHANNEL_0, flat, 1, LEDC_FADE_NO_WAIT) == ESP_ERR_INVALID_ARG);
+
+    //deinitial fade service
+    ledc_fade_func_uninstall();
+}
+
 // memory leaking problem detecting
 TEST_CASE("LEDC memory test", "[ledc][test_env=UT_T1_LEDC]")
 {
@@ -672,4 +672,79 @@ TEST_CASE("PCNT counting mode test", "[pcnt]")
     count_mode_test(PCNT_CTRL_GND_IO);
 }
 
+TEST_CASE("PCNT accumulation and rate test", "[pcnt]")
+{
+    int64_t accum_count = 0;
+    int64_t snapshot = 0;
+    float rate = 0;
+    pcnt_unit_t snapshot_unit = PCNT_UNIT_0;
+
+    //produce pulse, 1000HZ, so the 16-bit counter overflows 100 times per second with h_lim = 10
+    ledc_timer_config_t ledc_timer = {
+        .speed_mode = LEDC_LOW_SPEED_MODE,
+        .timer_num  = LEDC_TIMER_1,
+        .duty_resolution = LEDC_TIMER_10_BIT,
+        .freq_hz = 1000,
+        .clk_cfg = LEDC_AUTO_CLK,
+    };
+    TEST_ESP_OK(ledc_timer_config(&ledc_timer));
+
+    ledc_channel_config_t ledc_channel = {
+        .speed_mode = LEDC_LOW_SPEED_MODE,
+        .channel = LEDC_CHANNEL_1,
+        .timer_sel = LEDC_TIMER_1,
+        .intr_type = LEDC_INTR_DISABLE,
+        .gpio_num = PULSE_IO,
+        .duty = 100,
+        .hpoint = 0,
+    };
+    TEST_ESP_OK(ledc_channel_config(&ledc_channel));
+
+    pcnt_config_t pcnt_config = {
+        .pulse_gpio_num = PCNT_INPUT_IO,
+        .ctrl_gpio_num = PCNT_CTRL_VCC_IO,
+        .channel = PCNT_CHANNEL_0,
+        .unit = PCNT_UNIT_0,
+        .pos_mode = PCNT_COUNT_INC,
+        .neg_mode = PCNT_COUNT_DIS,
+        .lctrl_mode = PCNT_MODE_KEEP,
+        .hctrl_mode = PCNT_MODE_KEEP,
+        .counter_h_lim = HIGHEST_LIMIT,
+        .counter_l_lim = LOWEST_LIMIT,
+    };
+    TEST_ESP_OK(pcnt_unit_config(&pcnt_config));
+    pcnt_test_io_config(PCNT_CTRL_HIGH_LEVEL);
+
+    // accumulation requires the ISR service
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, pcnt_accum_enable(PCNT_UNIT_0));
+    TEST_ESP_OK(pcnt_isr_service_install(0));
+    // reading before enabling is refused
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, pcnt_accum_get_count(PCNT_UNIT_0, &accum_count));
+    TEST_ESP_OK(pcnt_accum_enable(PCNT_UNIT_0));
+
+    TEST_ESP_OK(pcnt_counter_pause(PCNT_UNIT_0));
+    TEST_ESP_OK(pcnt_accum_clear(PCNT_UNIT_0));
+    TEST_ESP_OK(pcnt_accum_set_rate_window(PCNT_UNIT_0, 500));
+    TEST_ESP_OK(pcnt_accum_get_rate(PCNT_UNIT_0, &rate)); // opens the first window
+    TEST_ESP_OK(pcnt_counter_resume(PCNT_UNIT_0));
+
+    vTaskDelay(1000 / portTICK_RATE_MS);
+    TEST_ESP_OK(pcnt_accum_get_count(PCNT_UNIT_0, &accum_count));
+    printf("accumulated: %lld\n", accum_count);
+    // ~1000 pulses in 1 s, far above the h_lim of 10 the hardware counter wraps at
+    TEST_ASSERT_INT_WITHIN(50, 1000, (int)accum_count);
+
+    TEST_ESP_OK(pcnt_accum_get_rate(PCNT_UNIT_0, &rate));
+    printf("rate: %.1f Hz\n", rate);
+    TEST_ASSERT_FLOAT_WITHIN(50.0, 1000.0, rate);
+
+    TEST_ESP_OK(pcnt_accum_snapshot(&snapshot_unit, &snapshot, 1));
+    TEST_ASSERT(snapshot >= accum_count);
+
+    TEST_ESP_OK(pcnt_counter_pause(PCNT_UNIT_0));
+    TEST_ESP_OK(pcnt_accum_disable(PCNT_UNIT_0));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, pcnt_accum_get_count(PCNT_UNIT_0, &accum_count));
+    pcnt_isr_service_uninstall();
+}
+
 #endif // #if SOC_PCNT_SUPPORTED
@@ -309,6 +309,55 @@ TEST_CASE("RMT TX (SOC_RMT_CHANNEL_MEM_WORDS-1) symbols", "[rmt][boundary]")
     rmt_clean_testbench(tx_channel, -1);
 }
 
+typedef struct {
+    uint32_t total;    // number of items the encoder should produce in total
+    uint32_t produced; // number of items produced so far
+    uint32_t calls;    // number of encoder invocations
+} test_stream_encoder_ctx_t;
+
+static size_t test_rmt_stream_encoder(rmt_channel_t channel, rmt_item32_t *dest, size_t wanted_num, void *arg)
+{
+    test_stream_encoder_ctx_t *ctx = (test_stream_encoder_ctx_t *)arg;
+    size_t num = ctx->total - ctx->produced;
+    if (num > wanted_num) {
+        num = wanted_num;
+    }
+    for (size_t i = 0; i < num; i++) {
+        dest[i] = (rmt_item32_t) {
+            {{
+                    100, 1, 100, 0
+                }
+            }
+        };
+    }
+    ctx->produced += num;
+    ctx->calls++;
+    return num;
+}
+
+TEST_CASE("RMT TX streaming encoder", "[rmt]")
+{
+    int tx_channel = 0;
+    rmt_setup_testbench(tx_channel, -1, 0);
+
+    // produce many more items than fit into the channel memory block,
+    // the encoder must be re-invoked from the threshold interrupt
+    test_stream_encoder_ctx_t ctx = {
+        .total = SOC_RMT_CHANNEL_MEM_WORDS * 10,
+    };
+    TEST_ESP_OK(rmt_write_stream(tx_channel, test_rmt_stream_encoder, &ctx, true));
+    TEST_ASSERT_EQUAL(ctx.total, ctx.produced);
+    TEST_ASSERT(ctx.calls > 2);
+
+    // the channel must be reusable for another stream right away
+    ctx.produced = 0;
+    ctx.calls = 0;
+    TEST_ESP_OK(rmt_write_stream(tx_channel, test_rmt_stream_encoder, &ctx, true));
+    TEST_ASSERT_EQUAL(ctx.total, ctx.produced);
+
+    rmt_clean_testbench(tx_channel, -1);
+}
+
 TEST_CASE("RMT TX stop", "[rmt]")
 {
     RingbufHandle_t rb = NULL;
@@ -223,6 +223,98 @@ TEST_CASE("SPI Master test", "[spi]")
 }
 
 
+TEST_CASE("SPI Master prepared transaction test", "[spi]")
+{
+    spi_device_handle_t handle = setup_spi_bus_loopback(1000000, true);
+
+    const int num_bytes = 32;
+    uint8_t *sendbuf = heap_caps_malloc(num_bytes, MALLOC_CAP_DMA);
+    uint8_t *recvbuf = heap_caps_malloc(num_bytes, MALLOC_CAP_DMA);
+
+    spi_transaction_t t;
+    memset(&t, 0, sizeof(t));
+    t.length = num_bytes * 8;
+    t.tx_buffer = sendbuf;
+    t.rx_buffer = recvbuf;
+
+    spi_prepared_trans_handle_t prepared;
+    TEST_ESP_OK(spi_device_prepare_trans(handle, &t, &prepared));
+
+    //send the same prepared transaction several times with changing buffer contents,
+    //alternating between the polling and the interrupt path
+    for (int i = 0; i < 4; i++) {
+        srand(100 + i);
+        for (int x = 0; x < num_bytes; x++) {
+            sendbuf[x] = rand() & 0xff;
+            recvbuf[x] = 0x55;
+        }
+        if (i % 2 == 0) {
+            TEST_ESP_OK(spi_device_polling_transmit_prepared(prepared));
+        } else {
+            spi_transaction_t *ret_trans;
+            TEST_ESP_OK(spi_device_queue_prepared_trans(prepared, portMAX_DELAY));
+            TEST_ESP_OK(spi_device_get_trans_result(handle, &ret_trans, portMAX_DELAY));
+            TEST_ASSERT(ret_trans == &t);
+        }
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(sendbuf, recvbuf, num_bytes);
+    }
+
+    //non-DMA-capable buffers are rejected instead of bounce-buffered on this path
+    uint8_t static_buf[4];
+    t.tx_buffer = (const void *)0x40080000;  //IRAM, not DMA-capable
+    t.rx_buffer = static_buf;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, spi_device_queue_prepared_trans(prepared, portMAX_DELAY));
+
+    TEST_ESP_OK(spi_device_release_prepared_trans(prepared));
+    free(sendbuf);
+    free(recvbuf);
+    master_free_device_bus(handle);
+}
+
+TEST_CASE("SPI Master batch transmit test", "[spi]")
+{
+    spi_device_handle_t handle = setup_spi_bus_loopback(1000000, true);
+
+    const int batch_size = 3;
+    const int num_bytes = 16;
+    uint8_t *sendbuf[batch_size];
+    uint8_t *recvbuf[batch_size];
+    spi_transaction_t trans[batch_size];
+    spi_transaction_t *trans_ptrs[batch_size];
+
+    srand(42);
+    for (int i = 0; i < batch_size; i++) {
+        sendbuf[i] = heap_caps_malloc(num_bytes, MALLOC_CAP_DMA);
+        recvbuf[i] = heap_caps_malloc(num_bytes, MALLOC_CAP_DMA);
+        for (int x = 0; x < num_bytes; x++) {
+            sendbuf[i][x] = rand() & 0xff;
+            recvbuf[i][x] = 0x55;
+        }
+        memset(&trans[i], 0, sizeof(trans[i]));
+        trans[i].length = num_bytes * 8;
+        trans[i].tx_buffer = sendbuf[i];
+        trans[i].rx_buffer = recvbuf[i];
+        trans_ptrs[i] = &trans[i];
+    }
+
+    TEST_ESP_OK(spi_device_transmit_batch(handle, trans_ptrs, batch_size));
+
+    for (int i = 0; i < batch_size; i++) {
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(sendbuf[i], recvbuf[i], num_bytes);
+    }
+
+    //a batch also works with the bus already acquired by the caller
+    TEST_ESP_OK(spi_device_acquire_bus(handle, portMAX_DELAY));
+    TEST_ESP_OK(spi_device_transmit_batch(handle, trans_ptrs, 1));
+    spi_device_release_bus(handle);
+
+    for (int i = 0; i < batch_size; i++) {
+        free(sendbuf[i]);
+        free(recvbuf[i]);
+    }
+    master_free_device_bus(handle);
+}
+
 TEST_CASE("SPI Master test, interaction of multiple devs", "[spi]") {
     esp_err_t ret;
     bool success = true;
@@ -583,4 +583,88 @@ TEST_CASE("test spi slave hd continuous mode, master too long", "[spi][spi_slv_h
     master_free_device_bus(spi);
 }
 
+#define TEST_RING_BUF_NUM   4
+#define TEST_RING_BUF_SIZE  64
+
+static SemaphoreHandle_t ring_watermark_sem;
+
+static bool ring_rx_watermark_cb(void *arg, spi_slave_hd_event_t *event, BaseType_t *awoken)
+{
+    xSemaphoreGiveFromISR(ring_watermark_sem, awoken);
+    return true;
+}
+
+/*
+ * The ring mode re-arms the DMA from the ISR without any application interaction. The slave
+ * starts an RX ring of 4 buffers with a watermark of 2, the master then writes 8 segments
+ * back-to-back: the ring should wrap once, fire the watermark callback 4 times and leave the
+ * last 4 segments in the ring slots.
+ */
+TEST_CASE("test spi slave hd ring mode", "[spi][spi_slv_hd]")
+{
+    spi_device_handle_t spi;
+    spitest_param_set_t *cfg = &hd_conf[0];
+    int freq = 100*1000; // the frequency should be small enough for the slave to prepare new trans
+
+    init_master_hd(&spi, cfg, freq);
+
+    ring_watermark_sem = xSemaphoreCreateCounting(8, 0);
+    TEST_ASSERT(ring_watermark_sem);
+    spi_slave_hd_callback_config_t cb_config = {
+        .cb_ring_rx = ring_rx_watermark_cb,
+    };
+    init_slave_hd(cfg->mode, &cb_config);
+
+    //Use GPIO matrix to connect signal of master and slave via same set of pins on one board.
+    config_single_board_test_pin();
+
+    WORD_ALIGNED_ATTR uint8_t *master_send_buf = malloc(TEST_RING_BUF_SIZE * 2 * TEST_RING_BUF_NUM);
+    uint8_t *ring_buf = heap_caps_malloc(TEST_RING_BUF_SIZE * TEST_RING_BUF_NUM, MALLOC_CAP_DMA);
+    TEST_ASSERT(master_send_buf && ring_buf);
+    memset(ring_buf, 0xcc, TEST_RING_BUF_SIZE * TEST_RING_BUF_NUM);
+    srand(177);
+    for (int i = 0; i < TEST_RING_BUF_SIZE * 2 * TEST_RING_BUF_NUM; i++) {
+        master_send_buf[i] = rand();
+    }
+
+    spi_slave_hd_data_t ring_trans[TEST_RING_BUF_NUM];
+    for (int i = 0; i < TEST_RING_BUF_NUM; i++) {
+        ring_trans[i] = (spi_slave_hd_data_t) {
+            .data = ring_buf + i * TEST_RING_BUF_SIZE,
+            .len = TEST_RING_BUF_SIZE,
+        };
+    }
+    TEST_ESP_OK(spi_slave_hd_ring_start(TEST_SLAVE_HOST, SPI_SLAVE_CHAN_RX, ring_trans, TEST_RING_BUF_NUM, 2));
+    //the ring is already armed, starting it twice should fail
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE,
+                      spi_slave_hd_ring_start(TEST_SLAVE_HOST, SPI_SLAVE_CHAN_RX, ring_trans, TEST_RING_BUF_NUM, 2));
+
+    for (int i = 0; i < 2 * TEST_RING_BUF_NUM; i++) {
+        essl_spi_wrdma(spi, master_send_buf + i * TEST_RING_BUF_SIZE, TEST_RING_BUF_SIZE, -1, 0);
+    }
+
+    //8 transfers with a watermark of 2 give 4 callbacks
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT(xSemaphoreTake(ring_watermark_sem, pdMS_TO_TICKS(1000)));
+    }
+    TEST_ASSERT_EQUAL_UINT32(2 * TEST_RING_BUF_NUM,
+                             spi_slave_hd_ring_get_done_count(TEST_SLAVE_HOST, SPI_SLAVE_CHAN_RX));
+
+    //the second round of master data should sit in the ring slots now
+    for (int i = 0; i < TEST_RING_BUF_NUM; i++) {
+        TEST_ASSERT_EQUAL(TEST_RING_BUF_SIZE, ring_trans[i].trans_len);
+        spitest_cmp_or_dump(master_send_buf + (TEST_RING_BUF_NUM + i) * TEST_RING_BUF_SIZE,
+                            ring_trans[i].data, TEST_RING_BUF_SIZE);
+    }
+
+    TEST_ESP_OK(spi_slave_hd_ring_stop(TEST_SLAVE_HOST, SPI_SLAVE_CHAN_RX));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, spi_slave_hd_ring_stop(TEST_SLAVE_HOST, SPI_SLAVE_CHAN_RX));
+
+    free(master_send_buf);
+    free(ring_buf);
+    vSemaphoreDelete(ring_watermark_sem);
+    spi_slave_hd_deinit(TEST_SLAVE_HOST);
+    master_free_device_bus(spi);
+}
+
 #endif //SOC_SPI_SUPPORT_SLAVE_HD_VER2
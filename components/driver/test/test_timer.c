@@ -919,6 +919,62 @@ TEST_CASE("Timer ISR callback", "[hw_timer]")
     all_timer_deinit();
 }
 
+static volatile uint32_t schedule_alarm_count;
+
+static bool test_timer_schedule_isr_cb(void *arg)
+{
+    schedule_alarm_count++;
+    return false;
+}
+
+/**
+ * Timer alarm schedule test
+ */
+TEST_CASE("Timer alarm schedule", "[hw_timer]")
+{
+    timer_config_t config = {
+        .alarm_en = TIMER_ALARM_DIS,
+        .auto_reload = TIMER_AUTORELOAD_DIS,
+        .counter_dir = TIMER_COUNT_UP,
+        .divider = TIMER_DIVIDER,
+        .counter_en = TIMER_PAUSE,
+        .intr_type = TIMER_INTR_LEVEL,
+    };
+    uint32_t timer_scale = rtc_clk_apb_freq_get() / TIMER_DIVIDER;
+    TEST_ESP_OK(timer_init(TIMER_GROUP_0, TIMER_0, &config));
+    TEST_ESP_OK(timer_pause(TIMER_GROUP_0, TIMER_0));
+    TEST_ESP_OK(timer_set_counter_value(TIMER_GROUP_0, TIMER_0, 0));
+
+    // one-shot schedule: three alarms within 0.3 s, then the alarm stays disabled
+    schedule_alarm_count = 0;
+    uint64_t schedule[3] = { 0.1 * timer_scale, 0.2 * timer_scale, 0.3 * timer_scale };
+    // schedule values must be strictly increasing
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, timer_set_alarm_schedule(TIMER_GROUP_0, TIMER_0, schedule, 0, false));
+    TEST_ESP_OK(timer_set_alarm_schedule(TIMER_GROUP_0, TIMER_0, schedule, 3, false));
+    TEST_ESP_OK(timer_isr_callback_add(TIMER_GROUP_0, TIMER_0, test_timer_schedule_isr_cb, NULL, ESP_INTR_FLAG_LOWMED));
+    TEST_ESP_OK(timer_start(TIMER_GROUP_0, TIMER_0));
+    vTaskDelay(500 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(3, schedule_alarm_count);
+    // no further alarms once the schedule is exhausted
+    vTaskDelay(200 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(3, schedule_alarm_count);
+
+    // repeating schedule: two alarms per 0.2 s frame
+    TEST_ESP_OK(timer_pause(TIMER_GROUP_0, TIMER_0));
+    schedule_alarm_count = 0;
+    uint64_t frame[2] = { 0.1 * timer_scale, 0.2 * timer_scale };
+    TEST_ESP_OK(timer_set_alarm_schedule(TIMER_GROUP_0, TIMER_0, frame, 2, true));
+    TEST_ESP_OK(timer_set_counter_value(TIMER_GROUP_0, TIMER_0, 0));
+    TEST_ESP_OK(timer_start(TIMER_GROUP_0, TIMER_0));
+    vTaskDelay(1050 / portTICK_PERIOD_MS);
+    TEST_ASSERT_UINT32_WITHIN(2, 10, schedule_alarm_count);
+
+    TEST_ESP_OK(timer_pause(TIMER_GROUP_0, TIMER_0));
+    TEST_ESP_OK(timer_clear_alarm_schedule(TIMER_GROUP_0, TIMER_0));
+    TEST_ESP_OK(timer_isr_callback_remove(TIMER_GROUP_0, TIMER_0));
+    TEST_ESP_OK(timer_deinit(TIMER_GROUP_0, TIMER_0));
+}
+
 /**
  * Timer memory test
  */
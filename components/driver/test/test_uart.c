@@ -332,4 +332,50 @@ TEST_CASE("uart tx with ringbuffer test", "[uart]")
     free(wr_data);
 }
 
+#if CONFIG_IDF_TARGET_ESP32
+TEST_CASE("uart rx dma mode test", "[uart]")
+{
+    const int uart_num = UART_NUM1;
+    uint8_t *rd_data = (uint8_t *)malloc(1024);
+    uint8_t *wr_data = (uint8_t *)malloc(1024);
+    if(rd_data == NULL || wr_data == NULL) {
+        TEST_FAIL_MESSAGE("buffer malloc fail");
+    }
+    uart_config_t uart_config = {
+        .baud_rate = 2000000,
+        .data_bits = UART_DATA_8_BITS,
+        .parity = UART_PARITY_DISABLE,
+        .stop_bits = UART_STOP_BITS_1,
+        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+        .source_clk = UART_SCLK_APB,
+    };
+    uart_wait_tx_idle_polling(uart_num);
+    TEST_ESP_OK(uart_param_config(uart_num, &uart_config));
+    TEST_ESP_OK(uart_driver_install(uart_num, 1024 * 2, 1024 * 2, 20, NULL, 0));
+    TEST_ESP_OK(uart_set_loop_back(uart_num, true));
+    // Parameter checks: buffer length must be a multiple of 4, at most one port at a time.
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, uart_enable_rx_dma(uart_num, 4, 255));
+    TEST_ESP_OK(uart_enable_rx_dma(uart_num, 4, 256));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, uart_enable_rx_dma(uart_num, 4, 256));
+    for (int i = 0; i < 1024; i++) {
+        wr_data[i] = i;
+        rd_data[i] = 0;
+    }
+    uart_write_bytes(uart_num, (const char*)wr_data, 1024);
+    uart_wait_tx_done(uart_num, (TickType_t)portMAX_DELAY);
+    TEST_ASSERT_EQUAL(1024, uart_read_bytes(uart_num, rd_data, 1024, (TickType_t)1000));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(wr_data, rd_data, 1024);
+    // Back to the interrupt driven path, the loop back data must still arrive.
+    TEST_ESP_OK(uart_disable_rx_dma(uart_num));
+    memset(rd_data, 0, 1024);
+    uart_write_bytes(uart_num, (const char*)wr_data, 1024);
+    uart_wait_tx_done(uart_num, (TickType_t)portMAX_DELAY);
+    TEST_ASSERT_EQUAL(1024, uart_read_bytes(uart_num, rd_data, 1024, (TickType_t)1000));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(wr_data, rd_data, 1024);
+    TEST_ESP_OK(uart_driver_delete(uart_num));
+    free(rd_data);
+    free(wr_data);
+}
+#endif
+
 #endif
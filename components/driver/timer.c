@@ -39,6 +39,7 @@ static const char *TIMER_TAG = "timer_group";
 #define TIMER_AUTORELOAD_ERROR  "HW TIMER AUTORELOAD ERROR"
 #define TIMER_SCALE_ERROR       "HW TIMER SCALE ERROR"
 #define TIMER_ALARM_ERROR       "HW TIMER ALARM ERROR"
+#define TIMER_SCHEDULE_ERROR    "HW TIMER ALARM SCHEDULE ERROR"
 #define DIVIDER_RANGE_ERROR     "HW TIMER divider outside of [2, 65536] range error"
 
 #define TIMER_ENTER_CRITICAL(mux)      portENTER_CRITICAL_SAFE(mux);
@@ -51,9 +52,17 @@ typedef struct {
     timer_group_t isr_timer_group;        /*!< timer group of interrupt triggered */
 } timer_isr_func_t;
 
+typedef struct {
+    uint64_t *values;  /*!< ascending absolute alarm values, NULL when no schedule is armed */
+    uint32_t count;    /*!< number of entries in values */
+    uint32_t next;     /*!< index of the entry currently armed in hardware */
+    bool repeat;       /*!< wrap to the first entry after the last one fired */
+} timer_alarm_schedule_t;
+
 typedef struct {
     timer_hal_context_t hal;
     timer_isr_func_t timer_isr_fun;
+    timer_alarm_schedule_t alarm_schedule;
 } timer_obj_t;
 
 static timer_obj_t *p_timer_obj[TIMER_GROUP_MAX][TIMER_MAX] = {0};
@@ -196,6 +205,59 @@ esp_err_t timer_set_alarm(timer_group_t group_num, timer_idx_t timer_num, timer_
     return ESP_OK;
 }
 
+esp_err_t timer_set_alarm_schedule(timer_group_t group_num, timer_idx_t timer_num, const uint64_t *alarm_values,
+                                   uint32_t num_alarms, bool repeat)
+{
+    TIMER_CHECK(group_num < TIMER_GROUP_MAX, TIMER_GROUP_NUM_ERROR, ESP_ERR_INVALID_ARG);
+    TIMER_CHECK(timer_num < TIMER_MAX, TIMER_NUM_ERROR, ESP_ERR_INVALID_ARG);
+    TIMER_CHECK(alarm_values != NULL, TIMER_PARAM_ADDR_ERROR, ESP_ERR_INVALID_ARG);
+    TIMER_CHECK(num_alarms > 0, TIMER_SCHEDULE_ERROR, ESP_ERR_INVALID_ARG);
+    TIMER_CHECK(p_timer_obj[group_num][timer_num] != NULL, TIMER_NEVER_INIT_ERROR, ESP_ERR_INVALID_ARG);
+    for (uint32_t i = 1; i < num_alarms; i++) {
+        TIMER_CHECK(alarm_values[i] > alarm_values[i - 1], TIMER_SCHEDULE_ERROR, ESP_ERR_INVALID_ARG);
+    }
+
+    uint64_t *values = (uint64_t *) heap_caps_malloc(num_alarms * sizeof(uint64_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (values == NULL) {
+        ESP_LOGE(TIMER_TAG, "TIMER driver malloc error");
+        return ESP_ERR_NO_MEM;
+    }
+    memcpy(values, alarm_values, num_alarms * sizeof(uint64_t));
+
+    TIMER_ENTER_CRITICAL(&timer_spinlock[group_num]);
+    timer_alarm_schedule_t *sched = &p_timer_obj[group_num][timer_num]->alarm_schedule;
+    uint64_t *old_values = sched->values;
+    sched->values = values;
+    sched->count = num_alarms;
+    sched->next = 0;
+    sched->repeat = repeat;
+    timer_hal_set_alarm_value(&(p_timer_obj[group_num][timer_num]->hal), values[0]);
+    timer_hal_set_alarm_enable(&(p_timer_obj[group_num][timer_num]->hal), TIMER_ALARM_EN);
+    TIMER_EXIT_CRITICAL(&timer_spinlock[group_num]);
+
+    heap_caps_free(old_values);
+    return ESP_OK;
+}
+
+esp_err_t timer_clear_alarm_schedule(timer_group_t group_num, timer_idx_t timer_num)
+{
+    TIMER_CHECK(group_num < TIMER_GROUP_MAX, TIMER_GROUP_NUM_ERROR, ESP_ERR_INVALID_ARG);
+    TIMER_CHECK(timer_num < TIMER_MAX, TIMER_NUM_ERROR, ESP_ERR_INVALID_ARG);
+    TIMER_CHECK(p_timer_obj[group_num][timer_num] != NULL, TIMER_NEVER_INIT_ERROR, ESP_ERR_INVALID_ARG);
+
+    TIMER_ENTER_CRITICAL(&timer_spinlock[group_num]);
+    timer_alarm_schedule_t *sched = &p_timer_obj[group_num][timer_num]->alarm_schedule;
+    uint64_t *old_values = sched->values;
+    sched->values = NULL;
+    sched->count = 0;
+    sched->next = 0;
+    sched->repeat = false;
+    TIMER_EXIT_CRITICAL(&timer_spinlock[group_num]);
+
+    heap_caps_free(old_values);
+    return ESP_OK;
+}
+
 static void IRAM_ATTR timer_isr_default(void *arg)
 {
     bool is_awoken = false;
@@ -216,8 +278,24 @@ static void IRAM_ATTR timer_isr_default(void *arg)
             is_awoken = timer_obj->timer_isr_fun.fn(timer_obj->timer_isr_fun.args);
             //Clear intrrupt status
             timer_hal_clear_intr_status(&(timer_obj->hal));
-            //After the alarm has been triggered, we need enable it again, so it is triggered the next time.
-            timer_hal_set_alarm_enable(&(timer_obj->hal), TIMER_ALARM_EN);
+            timer_alarm_schedule_t *sched = &timer_obj->alarm_schedule;
+            if (sched->values != NULL) {
+                sched->next++;
+                if (sched->next >= sched->count && sched->repeat) {
+                    //The last entry defines the frame period: restart the counter so the
+                    //schedule repeats without any software re-programming per frame.
+                    timer_hal_set_counter_value(&(timer_obj->hal), 0);
+                    sched->next = 0;
+                }
+                if (sched->next < sched->count) {
+                    timer_hal_set_alarm_value(&(timer_obj->hal), sched->values[sched->next]);
+                    timer_hal_set_alarm_enable(&(timer_obj->hal), TIMER_ALARM_EN);
+                }
+                //One-shot schedule exhausted: leave the alarm disabled.
+            } else {
+                //After the alarm has been triggered, we need enable it again, so it is triggered the next time.
+                timer_hal_set_alarm_enable(&(timer_obj->hal), TIMER_ALARM_EN);
+            }
         }
     }
     TIMER_EXIT_CRITICAL(&timer_spinlock[timer_obj->timer_isr_fun.isr_timer_group]);
@@ -322,6 +400,7 @@ esp_err_t timer_deinit(timer_group_t group_num, timer_idx_t timer_num)
     timer_hal_clear_intr_status(&(p_timer_obj[group_num][timer_num]->hal));
     TIMER_EXIT_CRITICAL(&timer_spinlock[group_num]);
 
+    heap_caps_free(p_timer_obj[group_num][timer_num]->alarm_schedule.values);
     heap_caps_free(p_timer_obj[group_num][timer_num]);
     p_timer_obj[group_num][timer_num] = NULL;
 
@@ -24,6 +24,7 @@
 #include "freertos/semphr.h"
 #include "freertos/timers.h"
 #include "esp_intr_alloc.h"
+#include "esp_timer.h"
 #include "driver/rtc_io.h"
 #include "driver/touch_pad.h"
 #include "driver/rtc_cntl.h"
@@ -245,3 +246,139 @@ esp_err_t IRAM_ATTR touch_pad_clear_status(void)
     touch_hal_clear_trigger_status_mask();
     return ESP_OK;
 }
+
+/*---------------------------------------------------------------
+                    Continuous scan mode
+---------------------------------------------------------------*/
+typedef struct {
+    touch_pad_scan_config_t config;
+    esp_timer_handle_t timer;
+    uint32_t filtered[TOUCH_PAD_MAX];       //IIR filter state, valid once primed
+    uint32_t last_reported[TOUCH_PAD_MAX];  //value at the last change callback
+    bool primed[TOUCH_PAD_MAX];
+    volatile uint32_t write_count;          //frames produced; only the timer callback advances this
+    uint32_t read_count;                    //frames consumed; only touch_pad_scan_read advances this
+    touch_pad_scan_frame_t frames[];        //result ring, config.ring_depth entries
+} touch_pad_scan_t;
+
+static touch_pad_scan_t *s_touch_pad_scan = NULL;
+
+static void touch_pad_scan_timer_cb(void *arg)
+{
+    touch_pad_scan_t *scan = (touch_pad_scan_t *) arg;
+    const uint32_t mask = scan->config.channel_mask;
+    const uint32_t k = scan->config.filter_factor;
+    touch_pad_scan_frame_t *frame = &scan->frames[scan->write_count & (scan->config.ring_depth - 1)];
+
+    frame->timestamp = esp_timer_get_time();
+    for (int i = 0; i < TOUCH_PAD_MAX; i++) {
+        if (!((mask >> i) & 0x1)) {
+            frame->values[i] = 0;
+            continue;
+        }
+        uint32_t raw = touch_hal_read_raw_data(i);
+        if (!scan->primed[i]) {
+            scan->filtered[i] = raw;
+            scan->last_reported[i] = raw;
+            scan->primed[i] = true;
+        } else if (k > 1) {
+            scan->filtered[i] = (raw + (k - 1) * scan->filtered[i]) / k;
+        } else {
+            scan->filtered[i] = raw;
+        }
+        frame->values[i] = scan->filtered[i];
+    }
+    //Publish the frame before making it visible to the consumer
+    scan->write_count++;
+
+    if (scan->config.change_threshold != 0 && scan->config.callback != NULL) {
+        for (int i = 0; i < TOUCH_PAD_MAX; i++) {
+            if (!((mask >> i) & 0x1)) {
+                continue;
+            }
+            uint32_t val = scan->filtered[i];
+            uint32_t last = scan->last_reported[i];
+            uint32_t diff = (val > last) ? (val - last) : (last - val);
+            if (diff >= scan->config.change_threshold) {
+                scan->last_reported[i] = val;
+                scan->config.callback(i, val, scan->config.callback_arg);
+            }
+        }
+    }
+}
+
+esp_err_t touch_pad_scan_start(const touch_pad_scan_config_t *scan_config)
+{
+    TOUCH_CHECK(scan_config != NULL, "Scan config pointer error", ESP_ERR_INVALID_ARG);
+    TOUCH_CHECK(scan_config->channel_mask != 0 && scan_config->channel_mask < (1 << SOC_TOUCH_SENSOR_NUM),
+                "Scan channel mask error", ESP_ERR_INVALID_ARG);
+    TOUCH_CHECK(scan_config->interval_ms > 0, "Scan interval error", ESP_ERR_INVALID_ARG);
+    TOUCH_CHECK(scan_config->ring_depth >= 2 && (scan_config->ring_depth & (scan_config->ring_depth - 1)) == 0,
+                "Scan ring depth error", ESP_ERR_INVALID_ARG);
+    TOUCH_CHECK(s_touch_pad_scan == NULL, "Touch pad scan already running", ESP_ERR_INVALID_STATE);
+
+    touch_pad_scan_t *scan = (touch_pad_scan_t *) calloc(1,
+            sizeof(touch_pad_scan_t) + scan_config->ring_depth * sizeof(touch_pad_scan_frame_t));
+    TOUCH_CHECK(scan != NULL, "Scan ring no mem", ESP_ERR_NO_MEM);
+    scan->config = *scan_config;
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = touch_pad_scan_timer_cb,
+        .arg = scan,
+        .name = "touch_scan",
+    };
+    esp_err_t err = esp_timer_create(&timer_args, &scan->timer);
+    if (err != ESP_OK) {
+        free(scan);
+        return err;
+    }
+    err = esp_timer_start_periodic(scan->timer, (uint64_t) scan_config->interval_ms * 1000);
+    if (err != ESP_OK) {
+        esp_timer_delete(scan->timer);
+        free(scan);
+        return err;
+    }
+    s_touch_pad_scan = scan;
+    return ESP_OK;
+}
+
+esp_err_t touch_pad_scan_stop(void)
+{
+    touch_pad_scan_t *scan = s_touch_pad_scan;
+    TOUCH_CHECK(scan != NULL, "Touch pad scan not running", ESP_ERR_INVALID_STATE);
+    esp_timer_stop(scan->timer);
+    esp_timer_delete(scan->timer);
+    s_touch_pad_scan = NULL;
+    free(scan);
+    return ESP_OK;
+}
+
+size_t touch_pad_scan_read(touch_pad_scan_frame_t *frames, size_t max_frames)
+{
+    touch_pad_scan_t *scan = s_touch_pad_scan;
+    if (scan == NULL || frames == NULL) {
+        return 0;
+    }
+    uint32_t write_count = scan->write_count;
+    //Skip frames the producer has already overwritten
+    if (write_count - scan->read_count > scan->config.ring_depth) {
+        scan->read_count = write_count - scan->config.ring_depth;
+    }
+    size_t count = 0;
+    while (scan->read_count != write_count && count < max_frames) {
+        frames[count++] = scan->frames[scan->read_count & (scan->config.ring_depth - 1)];
+        scan->read_count++;
+    }
+    return count;
+}
+
+esp_err_t touch_pad_scan_get_latest(touch_pad_scan_frame_t *frame)
+{
+    touch_pad_scan_t *scan = s_touch_pad_scan;
+    TOUCH_CHECK(frame != NULL, "Scan frame pointer error", ESP_ERR_INVALID_ARG);
+    TOUCH_CHECK(scan != NULL, "Touch pad scan not running", ESP_ERR_INVALID_STATE);
+    uint32_t write_count = scan->write_count;
+    TOUCH_CHECK(write_count != 0, "No scan frame captured yet", ESP_ERR_INVALID_STATE);
+    *frame = scan->frames[(write_count - 1) & (scan->config.ring_depth - 1)];
+    return ESP_OK;
+}
@@ -63,6 +63,20 @@
 
 /* ------------------ Typedefs, structures, and variables ------------------- */
 
+//RX routing filter. Accepted frames matching a routing filter are sent to the
+//filter's own queue instead of the default RX queue
+typedef struct {
+    bool in_use;
+    bool extd;
+    uint32_t identifier;
+    uint32_t mask;
+#ifdef CONFIG_TWAI_ISR_IN_IRAM
+    void *queue_buff;
+    void *queue_struct;
+#endif
+    QueueHandle_t queue;
+} twai_rx_filter_t;
+
 //Control structure for TWAI driver
 typedef struct {
     //Control and status members
@@ -85,6 +99,8 @@ typedef struct {
     QueueHandle_t rx_queue;
     int tx_msg_count;
     int rx_msg_count;
+    //RX routing filters
+    twai_rx_filter_t rx_filters[TWAI_RX_FILTER_NUM_MAX];
     //Alerts
     SemaphoreHandle_t alert_semphr;
     uint32_t alerts_enabled;
@@ -126,6 +142,42 @@ TWAI_ISR_ATTR static void twai_alert_handler(uint32_t alert_code, int *alert_req
     }
 }
 
+TWAI_ISR_ATTR static bool twai_route_rx_frame(twai_hal_frame_t *frame, BaseType_t *task_woken, int *alert_req)
+{
+    //Extract the identifier without fully parsing the frame. The ID bytes are
+    //big endian and left aligned, therefore a bswap is required (see twai_ll.h)
+    bool is_extd = frame->frame_format;
+    uint32_t id_temp = 0;
+    uint32_t id;
+    if (is_extd) {
+        for (int i = 0; i < 4; i++) {
+            id_temp |= ((uint32_t)frame->extended.id[i]) << (8 * i);
+        }
+        id = (__builtin_bswap32(id_temp) >> 3) & TWAI_EXTD_ID_MASK;
+    } else {
+        for (int i = 0; i < 2; i++) {
+            id_temp |= ((uint32_t)frame->standard.id[i]) << (8 * i);
+        }
+        id = (__builtin_bswap16(id_temp) >> 5) & TWAI_STD_ID_MASK;
+    }
+
+    //Send the frame to the queue of the first matching routing filter
+    for (int i = 0; i < TWAI_RX_FILTER_NUM_MAX; i++) {
+        twai_rx_filter_t *filter = &p_twai_obj->rx_filters[i];
+        if (!filter->in_use || filter->extd != is_extd || ((id ^ filter->identifier) & filter->mask) != 0) {
+            continue;
+        }
+        if (xQueueSendFromISR(filter->queue, frame, task_woken) == pdTRUE) {
+            p_twai_obj->rx_msg_count++;
+        } else {
+            p_twai_obj->rx_missed_count++;
+            twai_alert_handler(TWAI_ALERT_RX_QUEUE_FULL, alert_req);
+        }
+        return true;
+    }
+    return false;
+}
+
 static inline void twai_handle_rx_buffer_frames(BaseType_t *task_woken, int *alert_req)
 {
     uint32_t msg_count = twai_hal_get_rx_msg_count(&twai_context);
@@ -133,6 +185,10 @@ static inline void twai_handle_rx_buffer_frames(BaseType_t *task_woken, int *ale
     for (int i = 0; i < msg_count; i++) {
         twai_hal_frame_t frame;
         twai_hal_read_rx_buffer_and_clear(&twai_context, &frame);
+        //Give routing filters a chance to claim the frame first
+        if (twai_route_rx_frame(&frame, task_woken, alert_req)) {
+            continue;
+        }
         //Copy frame into RX Queue
         if (xQueueSendFromISR(p_twai_obj->rx_queue, &frame, task_woken) == pdTRUE) {
             p_twai_obj->rx_msg_count++;
@@ -289,6 +345,11 @@ static void twai_free_driver_obj(twai_obj_t *p_obj)
     if (p_obj->alert_semphr != NULL) {
         vSemaphoreDelete(p_obj->alert_semphr);
     }
+    for (int i = 0; i < TWAI_RX_FILTER_NUM_MAX; i++) {
+        if (p_obj->rx_filters[i].queue != NULL) {
+            vQueueDelete(p_obj->rx_filters[i].queue);
+        }
+    }
 #ifdef CONFIG_TWAI_ISR_IN_IRAM
     //Free memory used by static queues and semaphores. free() allows freeing NULL pointers
     free(p_obj->tx_queue_buff);
@@ -296,6 +357,10 @@ static void twai_free_driver_obj(twai_obj_t *p_obj)
     free(p_obj->rx_queue_buff);
     free(p_obj->rx_queue_struct);
     free(p_obj->semphr_struct);
+    for (int i = 0; i < TWAI_RX_FILTER_NUM_MAX; i++) {
+        free(p_obj->rx_filters[i].queue_buff);
+        free(p_obj->rx_filters[i].queue_struct);
+    }
 #endif  //CONFIG_TWAI_ISR_IN_IRAM
     free(p_obj);
 }
@@ -465,6 +530,11 @@ esp_err_t twai_start(void)
     if (p_twai_obj->tx_queue != NULL) {
         xQueueReset(p_twai_obj->tx_queue);
     }
+    for (int i = 0; i < TWAI_RX_FILTER_NUM_MAX; i++) {
+        if (p_twai_obj->rx_filters[i].in_use) {
+            xQueueReset(p_twai_obj->rx_filters[i].queue);
+        }
+    }
     p_twai_obj->rx_msg_count = 0;
     p_twai_obj->tx_msg_count = 0;
     twai_hal_start(&twai_context, p_twai_obj->mode);
@@ -495,26 +565,18 @@ esp_err_t twai_stop(void)
     return ESP_OK;
 }
 
-esp_err_t twai_transmit(const twai_message_t *message, TickType_t ticks_to_wait)
+static esp_err_t twai_transmit_frame(twai_hal_frame_t *tx_frame, TickType_t ticks_to_wait)
 {
-    //Check arguments
-    TWAI_CHECK(p_twai_obj != NULL, ESP_ERR_INVALID_STATE);
-    TWAI_CHECK(message != NULL, ESP_ERR_INVALID_ARG);
-    TWAI_CHECK((message->data_length_code <= TWAI_FRAME_MAX_DLC) || message->dlc_non_comp, ESP_ERR_INVALID_ARG);
-
     TWAI_ENTER_CRITICAL();
     //Check State
     TWAI_CHECK_FROM_CRIT(!(p_twai_obj->mode == TWAI_MODE_LISTEN_ONLY), ESP_ERR_NOT_SUPPORTED);
     TWAI_CHECK_FROM_CRIT(p_twai_obj->state == TWAI_STATE_RUNNING, ESP_ERR_INVALID_STATE);
-    //Format frame
     esp_err_t ret = ESP_FAIL;
-    twai_hal_frame_t tx_frame;
-    twai_hal_format_frame(message, &tx_frame);
 
     //Check if frame can be sent immediately
     if (p_twai_obj->tx_msg_count == 0) {
         //No other frames waiting to transmit. Bypass queue and transmit immediately
-        twai_hal_set_tx_buffer_and_transmit(&twai_context, &tx_frame);
+        twai_hal_set_tx_buffer_and_transmit(&twai_context, tx_frame);
         p_twai_obj->tx_msg_count++;
         ret = ESP_OK;
     }
@@ -524,7 +586,7 @@ esp_err_t twai_transmit(const twai_message_t *message, TickType_t ticks_to_wait)
         if (p_twai_obj->tx_queue == NULL) {
             //TX Queue is disabled and TX buffer is occupied, message was not sent
             ret = ESP_FAIL;
-        } else if (xQueueSend(p_twai_obj->tx_queue, &tx_frame, ticks_to_wait) == pdTRUE) {
+        } else if (xQueueSend(p_twai_obj->tx_queue, tx_frame, ticks_to_wait) == pdTRUE) {
             //Copied to TX Queue
             TWAI_ENTER_CRITICAL();
             if ((!twai_hal_check_state_flags(&twai_context, TWAI_HAL_STATE_FLAG_TX_BUFF_OCCUPIED)) && uxQueueMessagesWaiting(p_twai_obj->tx_queue) > 0) {
@@ -534,9 +596,9 @@ esp_err_t twai_transmit(const twai_message_t *message, TickType_t ticks_to_wait)
                     ret = ESP_ERR_INVALID_STATE;
                 } else {
                     //Manually start a transmission
-                    int res = xQueueReceive(p_twai_obj->tx_queue, &tx_frame, 0);
+                    int res = xQueueReceive(p_twai_obj->tx_queue, tx_frame, 0);
                     assert(res == pdTRUE);
-                    twai_hal_set_tx_buffer_and_transmit(&twai_context, &tx_frame);
+                    twai_hal_set_tx_buffer_and_transmit(&twai_context, tx_frame);
                     p_twai_obj->tx_msg_count++;
                     ret = ESP_OK;
                 }
@@ -554,6 +616,48 @@ esp_err_t twai_transmit(const twai_message_t *message, TickType_t ticks_to_wait)
     return ret;
 }
 
+esp_err_t twai_transmit(const twai_message_t *message, TickType_t ticks_to_wait)
+{
+    //Check arguments
+    TWAI_CHECK(p_twai_obj != NULL, ESP_ERR_INVALID_STATE);
+    TWAI_CHECK(message != NULL, ESP_ERR_INVALID_ARG);
+    TWAI_CHECK((message->data_length_code <= TWAI_FRAME_MAX_DLC) || message->dlc_non_comp, ESP_ERR_INVALID_ARG);
+
+    //Format frame
+    twai_hal_frame_t tx_frame;
+    twai_hal_format_frame(message, &tx_frame);
+    return twai_transmit_frame(&tx_frame, ticks_to_wait);
+}
+
+esp_err_t twai_transmit_multiple(const twai_message_t *messages, size_t message_count, size_t *messages_queued, TickType_t ticks_to_wait)
+{
+    //Check arguments
+    TWAI_CHECK(p_twai_obj != NULL, ESP_ERR_INVALID_STATE);
+    TWAI_CHECK(messages != NULL && message_count > 0, ESP_ERR_INVALID_ARG);
+    //Burst transmission relies on the ISR chaining frames out of the TX queue
+    TWAI_CHECK(p_twai_obj->tx_queue != NULL, ESP_ERR_NOT_SUPPORTED);
+    for (size_t i = 0; i < message_count; i++) {
+        TWAI_CHECK((messages[i].data_length_code <= TWAI_FRAME_MAX_DLC) || messages[i].dlc_non_comp, ESP_ERR_INVALID_ARG);
+    }
+
+    //Submit frames one by one. Queued frames are chained back to back by the
+    //TX interrupt handler without returning to the calling task in between
+    esp_err_t ret = ESP_OK;
+    size_t i;
+    for (i = 0; i < message_count; i++) {
+        twai_hal_frame_t tx_frame;
+        twai_hal_format_frame(&messages[i], &tx_frame);
+        ret = twai_transmit_frame(&tx_frame, ticks_to_wait);
+        if (ret != ESP_OK) {
+            break;
+        }
+    }
+    if (messages_queued != NULL) {
+        *messages_queued = i;
+    }
+    return ret;
+}
+
 esp_err_t twai_receive(twai_message_t *message, TickType_t ticks_to_wait)
 {
     //Check arguments and state
@@ -575,6 +679,121 @@ esp_err_t twai_receive(twai_message_t *message, TickType_t ticks_to_wait)
     return ESP_OK;
 }
 
+esp_err_t twai_add_rx_filter(const twai_rx_filter_config_t *filter_config, int *filter_handle)
+{
+    //Check arguments and state
+    TWAI_CHECK(p_twai_obj != NULL, ESP_ERR_INVALID_STATE);
+    TWAI_CHECK(filter_config != NULL && filter_handle != NULL, ESP_ERR_INVALID_ARG);
+    TWAI_CHECK(filter_config->queue_len > 0, ESP_ERR_INVALID_ARG);
+
+    //Create the filter's queue before entering the critical section
+#ifdef CONFIG_TWAI_ISR_IN_IRAM
+    void *queue_buff = heap_caps_calloc(filter_config->queue_len, sizeof(twai_hal_frame_t), TWAI_MALLOC_CAPS);
+    void *queue_struct = heap_caps_calloc(1, sizeof(StaticQueue_t), TWAI_MALLOC_CAPS);
+    QueueHandle_t queue = (queue_buff != NULL && queue_struct != NULL) ?
+            xQueueCreateStatic(filter_config->queue_len, sizeof(twai_hal_frame_t), queue_buff, queue_struct) : NULL;
+    if (queue == NULL) {
+        free(queue_buff);
+        free(queue_struct);
+        return ESP_ERR_NO_MEM;
+    }
+#else
+    QueueHandle_t queue = xQueueCreate(filter_config->queue_len, sizeof(twai_hal_frame_t));
+    TWAI_CHECK(queue != NULL, ESP_ERR_NO_MEM);
+#endif  //CONFIG_TWAI_ISR_IN_IRAM
+
+    TWAI_ENTER_CRITICAL();
+    int slot = -1;
+    for (int i = 0; i < TWAI_RX_FILTER_NUM_MAX; i++) {
+        if (!p_twai_obj->rx_filters[i].in_use) {
+            slot = i;
+            break;
+        }
+    }
+    if (slot >= 0) {
+        twai_rx_filter_t *filter = &p_twai_obj->rx_filters[slot];
+        filter->extd = filter_config->extd;
+        filter->identifier = filter_config->identifier;
+        filter->mask = filter_config->mask;
+#ifdef CONFIG_TWAI_ISR_IN_IRAM
+        filter->queue_buff = queue_buff;
+        filter->queue_struct = queue_struct;
+#endif
+        filter->queue = queue;
+        filter->in_use = true;      //Set last so the ISR only sees fully initialized filters
+    }
+    TWAI_EXIT_CRITICAL();
+
+    if (slot < 0) {
+        //All filter slots are occupied
+        vQueueDelete(queue);
+#ifdef CONFIG_TWAI_ISR_IN_IRAM
+        free(queue_buff);
+        free(queue_struct);
+#endif
+        return ESP_ERR_NOT_FOUND;
+    }
+    *filter_handle = slot;
+    return ESP_OK;
+}
+
+esp_err_t twai_remove_rx_filter(int filter_handle)
+{
+    //Check arguments and state
+    TWAI_CHECK(p_twai_obj != NULL, ESP_ERR_INVALID_STATE);
+    TWAI_CHECK(filter_handle >= 0 && filter_handle < TWAI_RX_FILTER_NUM_MAX, ESP_ERR_INVALID_ARG);
+
+    TWAI_ENTER_CRITICAL();
+    twai_rx_filter_t *filter = &p_twai_obj->rx_filters[filter_handle];
+    TWAI_CHECK_FROM_CRIT(filter->in_use, ESP_ERR_INVALID_ARG);
+    filter->in_use = false;     //Stop the ISR from routing to this filter
+    QueueHandle_t queue = filter->queue;
+    filter->queue = NULL;
+    //Frames still pending on the filter's queue are dropped with it
+    p_twai_obj->rx_msg_count -= uxQueueMessagesWaiting(queue);
+#ifdef CONFIG_TWAI_ISR_IN_IRAM
+    void *queue_buff = filter->queue_buff;
+    void *queue_struct = filter->queue_struct;
+    filter->queue_buff = NULL;
+    filter->queue_struct = NULL;
+#endif
+    TWAI_EXIT_CRITICAL();
+
+    vQueueDelete(queue);
+#ifdef CONFIG_TWAI_ISR_IN_IRAM
+    free(queue_buff);
+    free(queue_struct);
+#endif
+    return ESP_OK;
+}
+
+esp_err_t twai_receive_filtered(int filter_handle, twai_message_t *message, TickType_t ticks_to_wait)
+{
+    //Check arguments and state
+    TWAI_CHECK(p_twai_obj != NULL, ESP_ERR_INVALID_STATE);
+    TWAI_CHECK(message != NULL, ESP_ERR_INVALID_ARG);
+    TWAI_CHECK(filter_handle >= 0 && filter_handle < TWAI_RX_FILTER_NUM_MAX, ESP_ERR_INVALID_ARG);
+
+    TWAI_ENTER_CRITICAL();
+    QueueHandle_t queue = p_twai_obj->rx_filters[filter_handle].in_use ? p_twai_obj->rx_filters[filter_handle].queue : NULL;
+    TWAI_EXIT_CRITICAL();
+    TWAI_CHECK(queue != NULL, ESP_ERR_INVALID_ARG);
+
+    //Get frame from the filter's queue
+    twai_hal_frame_t rx_frame;
+    if (xQueueReceive(queue, &rx_frame, ticks_to_wait) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    TWAI_ENTER_CRITICAL();
+    p_twai_obj->rx_msg_count--;
+    TWAI_EXIT_CRITICAL();
+
+    //Decode frame
+    twai_hal_parse_frame(&rx_frame, message);
+    return ESP_OK;
+}
+
 esp_err_t twai_read_alerts(uint32_t *alerts, TickType_t ticks_to_wait)
 {
     //Check arguments and state
@@ -675,6 +894,11 @@ esp_err_t twai_clear_receive_queue(void)
     TWAI_ENTER_CRITICAL();
     p_twai_obj->rx_msg_count = 0;
     xQueueReset(p_twai_obj->rx_queue);
+    for (int i = 0; i < TWAI_RX_FILTER_NUM_MAX; i++) {
+        if (p_twai_obj->rx_filters[i].in_use) {
+            xQueueReset(p_twai_obj->rx_filters[i].queue);
+        }
+    }
     TWAI_EXIT_CRITICAL();
 
     return ESP_OK;
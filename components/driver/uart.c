@@ -33,6 +33,9 @@
 
 #if CONFIG_IDF_TARGET_ESP32
 #include "esp32/clk.h"
+#include "soc/uhci_struct.h"
+#include "soc/uhci_reg.h"
+#include "soc/lldesc.h"
 #elif CONFIG_IDF_TARGET_ESP32S2
 #include "esp32s2/clk.h"
 #elif CONFIG_IDF_TARGET_ESP32S3
@@ -991,6 +994,200 @@ static void UART_ISR_ATTR uart_rx_intr_handler_default(void *param)
     }
 }
 
+#if CONFIG_IDF_TARGET_ESP32
+/* UHCI based RX path: the DMA engine pops the UART RX FIFO into a circular
+ * in-link descriptor chain and interrupts once per completed block (or on line
+ * idle), instead of once per FIFO threshold. Completed blocks are pushed into
+ * the same RX ring buffer the FIFO path uses, so uart_read_bytes() and
+ * uart_get_buffered_data_len() work unchanged. There is a single UHCI unit
+ * usable this way, so at most one port can be in DMA RX mode at a time. */
+
+#ifdef CONFIG_UART_ISR_IN_IRAM
+#define UART_DMA_INTR_ALLOC_FLAGS  (ESP_INTR_FLAG_IRAM)
+#else
+#define UART_DMA_INTR_ALLOC_FLAGS  (0)
+#endif
+
+typedef struct {
+    uart_port_t uart_num;               /*!< Port the DMA is attached to, UART_NUM_MAX when idle */
+    intr_handle_t intr_handle;          /*!< UHCI interrupt handle */
+    lldesc_t *descs;                    /*!< Circular in-link descriptor chain */
+    uint8_t *buf;                       /*!< DMA data buffer backing the descriptors */
+    int desc_count;                     /*!< Number of descriptors in the chain */
+    int next_desc;                      /*!< Next descriptor to be reaped by the ISR */
+} uart_dma_obj_t;
+
+static uart_dma_obj_t s_uart_dma = {
+    .uart_num = UART_NUM_MAX,
+};
+
+static void UART_ISR_ATTR uart_dma_rx_intr_handler(void *param)
+{
+    uart_obj_t *p_uart = (uart_obj_t *)param;
+    uint8_t uart_num = p_uart->uart_num;
+    uart_event_t uart_event;
+    portBASE_TYPE HPTaskAwoken = 0;
+    uint32_t status = UHCI0.int_st.val;
+    UHCI0.int_clr.val = status;
+
+    //Reap every descriptor the DMA has handed back (hardware clears the owner bit when a block completes).
+    lldesc_t *desc = &s_uart_dma.descs[s_uart_dma.next_desc];
+    while (desc->owner == 0) {
+        int len = desc->length;
+        uart_event.type = UART_EVENT_MAX;
+        if (len > 0) {
+            //In DMA mode there is no FIFO left to stash data in, if the ring buffer is full the block is dropped.
+            if (pdFALSE == xRingbufferSendFromISR(p_uart->rx_ring_buf, (const void *)desc->buf, len, &HPTaskAwoken)) {
+                uart_event.type = UART_BUFFER_FULL;
+            } else {
+                UART_ENTER_CRITICAL_ISR(&(uart_context[uart_num].spinlock));
+                p_uart->rx_buffered_len += len;
+                UART_EXIT_CRITICAL_ISR(&(uart_context[uart_num].spinlock));
+                uart_event.type = UART_DATA;
+                uart_event.size = len;
+                uart_event.timeout_flag = (status & UHCI_IN_SUC_EOF_INT_ST) ? true : false;
+                UART_ENTER_CRITICAL_ISR(&uart_selectlock);
+                if (p_uart->uart_select_notif_callback) {
+                    p_uart->uart_select_notif_callback(uart_num, UART_SELECT_READ_NOTIF, &HPTaskAwoken);
+                }
+                UART_EXIT_CRITICAL_ISR(&uart_selectlock);
+            }
+        }
+        //Hand the descriptor back to the DMA.
+        desc->length = 0;
+        desc->owner = 1;
+        s_uart_dma.next_desc = (s_uart_dma.next_desc + 1) % s_uart_dma.desc_count;
+        if (uart_event.type != UART_EVENT_MAX && p_uart->xQueueUart) {
+            if (pdFALSE == xQueueSendFromISR(p_uart->xQueueUart, (void *)&uart_event, &HPTaskAwoken)) {
+                ESP_EARLY_LOGV(UART_TAG, "UART event queue full");
+            }
+        }
+        desc = &s_uart_dma.descs[s_uart_dma.next_desc];
+    }
+    if (status & UHCI_IN_DSCR_EMPTY_INT_ST) {
+        //The DMA ran out of free descriptors and stalled. All of them have been
+        //handed back above, so remount the chain and report the overrun.
+        UHCI0.dma_in_link.restart = 1;
+        if (p_uart->xQueueUart) {
+            uart_event.type = UART_FIFO_OVF;
+            if (pdFALSE == xQueueSendFromISR(p_uart->xQueueUart, (void *)&uart_event, &HPTaskAwoken)) {
+                ESP_EARLY_LOGV(UART_TAG, "UART event queue full");
+            }
+        }
+    }
+    if (HPTaskAwoken == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+esp_err_t uart_enable_rx_dma(uart_port_t uart_num, int dma_buf_count, int dma_buf_len)
+{
+    UART_CHECK((uart_num < UART_NUM_MAX), "uart_num error", ESP_ERR_INVALID_ARG);
+    UART_CHECK((p_uart_obj[uart_num]), "uart driver error", ESP_ERR_INVALID_STATE);
+    UART_CHECK((s_uart_dma.uart_num == UART_NUM_MAX), "UHCI already in use", ESP_ERR_INVALID_STATE);
+    UART_CHECK((dma_buf_count >= 2), "dma_buf_count error", ESP_ERR_INVALID_ARG);
+    UART_CHECK((dma_buf_len > 0) && (dma_buf_len <= LLDESC_MAX_NUM_PER_DESC) && ((dma_buf_len % 4) == 0),
+               "dma_buf_len error", ESP_ERR_INVALID_ARG);
+
+    s_uart_dma.descs = (lldesc_t *)heap_caps_calloc(dma_buf_count, sizeof(lldesc_t), MALLOC_CAP_DMA);
+    s_uart_dma.buf = (uint8_t *)heap_caps_malloc(dma_buf_count * dma_buf_len, MALLOC_CAP_DMA);
+    if (s_uart_dma.descs == NULL || s_uart_dma.buf == NULL) {
+        heap_caps_free(s_uart_dma.descs);
+        heap_caps_free(s_uart_dma.buf);
+        s_uart_dma.descs = NULL;
+        s_uart_dma.buf = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    for (int i = 0; i < dma_buf_count; i++) {
+        s_uart_dma.descs[i].size = dma_buf_len;
+        s_uart_dma.descs[i].length = 0;
+        s_uart_dma.descs[i].owner = 1;
+        s_uart_dma.descs[i].buf = s_uart_dma.buf + i * dma_buf_len;
+        s_uart_dma.descs[i].empty = (uint32_t)&s_uart_dma.descs[(i + 1) % dma_buf_count];
+    }
+    s_uart_dma.desc_count = dma_buf_count;
+    s_uart_dma.next_desc = 0;
+
+    periph_module_enable(PERIPH_UHCI0_MODULE);
+    //Raw byte stream: no separator chars, no packet headers, no escape char processing.
+    UHCI0.conf0.val = 0;
+    UHCI0.conf1.val = 0;
+    UHCI0.escape_conf.val = 0;
+    UHCI0.hung_conf.val = 0;
+    //An idle period on the line closes the current descriptor, so the tail of a
+    //burst is delivered without waiting for the whole block to fill.
+    UHCI0.conf0.uart_idle_eof_en = 1;
+    if (uart_num == UART_NUM_0) {
+        UHCI0.conf0.uart0_ce = 1;
+    } else if (uart_num == UART_NUM_1) {
+        UHCI0.conf0.uart1_ce = 1;
+    } else {
+        UHCI0.conf0.uart2_ce = 1;
+    }
+
+    esp_err_t r = esp_intr_alloc(ETS_UHCI0_INTR_SOURCE, UART_DMA_INTR_ALLOC_FLAGS,
+                                 uart_dma_rx_intr_handler, p_uart_obj[uart_num], &s_uart_dma.intr_handle);
+    if (r != ESP_OK) {
+        periph_module_disable(PERIPH_UHCI0_MODULE);
+        heap_caps_free(s_uart_dma.descs);
+        heap_caps_free(s_uart_dma.buf);
+        s_uart_dma.descs = NULL;
+        s_uart_dma.buf = NULL;
+        return r;
+    }
+
+    //The DMA pops the RX FIFO directly, the per-threshold FIFO interrupts are not needed any more.
+    uart_hal_clr_intsts_mask(&(uart_context[uart_num].hal), UART_INTR_RXFIFO_FULL | UART_INTR_RXFIFO_TOUT | UART_INTR_RXFIFO_OVF);
+    UART_ENTER_CRITICAL(&(uart_context[uart_num].spinlock));
+    uart_hal_disable_intr_mask(&(uart_context[uart_num].hal), UART_INTR_RXFIFO_FULL | UART_INTR_RXFIFO_TOUT | UART_INTR_RXFIFO_OVF);
+    uart_hal_rxfifo_rst(&(uart_context[uart_num].hal));
+    UART_EXIT_CRITICAL(&(uart_context[uart_num].spinlock));
+
+    UHCI0.int_clr.val = UHCI0.int_raw.val;
+    UHCI0.int_ena.val = UHCI_IN_DONE_INT_ENA | UHCI_IN_SUC_EOF_INT_ENA | UHCI_IN_DSCR_EMPTY_INT_ENA;
+    UHCI0.dma_in_link.addr = ((uint32_t)s_uart_dma.descs) & UHCI_INLINK_ADDR;
+    UHCI0.dma_in_link.start = 1;
+
+    s_uart_dma.uart_num = uart_num;
+    return ESP_OK;
+}
+
+esp_err_t uart_disable_rx_dma(uart_port_t uart_num)
+{
+    UART_CHECK((uart_num < UART_NUM_MAX), "uart_num error", ESP_ERR_INVALID_ARG);
+    UART_CHECK((s_uart_dma.uart_num == uart_num), "rx dma not enabled on this port", ESP_ERR_INVALID_STATE);
+    UHCI0.int_ena.val = 0;
+    UHCI0.dma_in_link.stop = 1;
+    esp_intr_free(s_uart_dma.intr_handle);
+    s_uart_dma.intr_handle = NULL;
+    periph_module_disable(PERIPH_UHCI0_MODULE);
+    heap_caps_free(s_uart_dma.descs);
+    heap_caps_free(s_uart_dma.buf);
+    s_uart_dma.descs = NULL;
+    s_uart_dma.buf = NULL;
+    s_uart_dma.uart_num = UART_NUM_MAX;
+    //Restore the interrupt driven RX path.
+    if (p_uart_obj[uart_num]) {
+        uart_hal_clr_intsts_mask(&(uart_context[uart_num].hal), UART_INTR_RXFIFO_FULL | UART_INTR_RXFIFO_TOUT | UART_INTR_RXFIFO_OVF);
+        UART_ENTER_CRITICAL(&(uart_context[uart_num].spinlock));
+        uart_hal_rxfifo_rst(&(uart_context[uart_num].hal));
+        uart_hal_ena_intr_mask(&(uart_context[uart_num].hal), UART_INTR_RXFIFO_FULL | UART_INTR_RXFIFO_TOUT | UART_INTR_RXFIFO_OVF);
+        UART_EXIT_CRITICAL(&(uart_context[uart_num].spinlock));
+    }
+    return ESP_OK;
+}
+#else //CONFIG_IDF_TARGET_ESP32
+esp_err_t uart_enable_rx_dma(uart_port_t uart_num, int dma_buf_count, int dma_buf_len)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t uart_disable_rx_dma(uart_port_t uart_num)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+#endif //CONFIG_IDF_TARGET_ESP32
+
 /**************************************************************/
 esp_err_t uart_wait_tx_done(uart_port_t uart_num, TickType_t ticks_to_wait)
 {
@@ -1375,6 +1572,11 @@ esp_err_t uart_driver_delete(uart_port_t uart_num)
         ESP_LOGI(UART_TAG, "ALREADY NULL");
         return ESP_OK;
     }
+#if CONFIG_IDF_TARGET_ESP32
+    if (s_uart_dma.uart_num == uart_num) {
+        uart_disable_rx_dma(uart_num);
+    }
+#endif
     esp_intr_free(p_uart_obj[uart_num]->intr_handle);
     uart_disable_rx_intr(uart_num);
     uart_disable_tx_intr(uart_num);
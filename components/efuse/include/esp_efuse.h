@@ -69,6 +69,41 @@ typedef struct esp_efuse_desc_s esp_efuse_desc_t;
  */
 esp_err_t esp_efuse_read_field_blob(const esp_efuse_desc_t* field[], void* dst, size_t dst_size_bits);
 
+/**
+ * @brief Structure describing one entry of a batch field read
+ */
+typedef struct {
+    const esp_efuse_desc_t** field;     /**< A pointer to the structure describing the fields of efuse. */
+    void* dst;                          /**< A pointer to array that will contain the result of reading. */
+    size_t dst_size_bits;               /**< The number of bits required to read. */
+} esp_efuse_batch_read_t;
+
+/**
+ * @brief   Reads several eFuse fields in one call.
+ *
+ * Each entry of the table is processed like esp_efuse_read_field_blob(),
+ * but the efuse lock is taken only once for the whole batch. Together with
+ * CONFIG_EFUSE_CACHE_SHADOW this lets a driver fetch all its calibration
+ * fields in a single pass over the RAM shadow.
+ *
+ * @param[in/out] table  An array of read descriptors, the dst buffers are filled in place.
+ * @param[in]     count  The number of entries in the table.
+ *
+ * @return
+ *    - ESP_OK: The operation was successfully completed.
+ *    - ESP_ERR_INVALID_ARG: Error in the passed arguments (remaining entries are not processed).
+ */
+esp_err_t esp_efuse_read_fields(const esp_efuse_batch_read_t table[], size_t count);
+
+/**
+ * @brief   Refreshes the RAM shadow of the eFuse blocks from the hardware.
+ *
+ * The shadow is seeded at startup and refreshed after every burn performed
+ * through this API, so an explicit refresh is only needed when eFuses may
+ * have been changed behind the API's back (e.g. by the ROM or a debugger).
+ * Does nothing unless CONFIG_EFUSE_CACHE_SHADOW is set.
+ */
+void esp_efuse_update_shadow(void);
 
 /**
  * @brief Read a single bit eFuse field as a boolean value.
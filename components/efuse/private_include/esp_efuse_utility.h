@@ -129,6 +129,14 @@ void esp_efuse_utility_reset(void);
  */
 void esp_efuse_utility_update_virt_blocks(void);
 
+/**
+ * @brief   Fills the shadow_blocks array by values from the efuse read registers.
+ *
+ * No-op unless CONFIG_EFUSE_CACHE_SHADOW is set. Called automatically at
+ * startup and after every burn operation.
+ */
+void esp_efuse_utility_update_shadow(void);
+
 /**
  * @brief   Prints efuse values for all registers.
  */
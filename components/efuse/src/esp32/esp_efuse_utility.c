@@ -117,6 +117,7 @@ void esp_efuse_utility_burn_efuses(void)
     while (REG_READ(EFUSE_CMD_REG) != 0) {};
 #endif // CONFIG_EFUSE_VIRTUAL
     esp_efuse_utility_reset();
+    esp_efuse_utility_update_shadow();
 }
 
 esp_err_t esp_efuse_utility_apply_34_encoding(const uint8_t *in_bytes, uint32_t *out_words, size_t in_bytes_len)
@@ -110,6 +110,7 @@ void esp_efuse_utility_burn_efuses(void)
     }
 #endif // CONFIG_EFUSE_VIRTUAL
     esp_efuse_utility_reset();
+    esp_efuse_utility_update_shadow();
 }
 
 // After esp_efuse_write.. functions EFUSE_BLKx_WDATAx_REG were filled is not coded values.
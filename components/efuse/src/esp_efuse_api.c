@@ -54,6 +54,35 @@ esp_err_t esp_efuse_read_field_blob(const esp_efuse_desc_t* field[], void* dst,
     return err;
 }
 
+// read several fields in one pass, holding the lock once
+esp_err_t esp_efuse_read_fields(const esp_efuse_batch_read_t table[], size_t count)
+{
+    EFUSE_LOCK_ACQUIRE();
+    esp_err_t err = ESP_OK;
+    if (table == NULL || count == 0) {
+        err = ESP_ERR_INVALID_ARG;
+    } else {
+        for (size_t i = 0; err == ESP_OK && i < count; ++i) {
+            if (table[i].field == NULL || table[i].dst == NULL || table[i].dst_size_bits == 0) {
+                err = ESP_ERR_INVALID_ARG;
+            } else {
+                memset((uint8_t *)table[i].dst, 0, esp_efuse_utility_get_number_of_items(table[i].dst_size_bits, 8));
+                err = esp_efuse_utility_process(table[i].field, table[i].dst, table[i].dst_size_bits, esp_efuse_utility_fill_buff);
+            }
+        }
+    }
+    EFUSE_LOCK_RELEASE();
+    return err;
+}
+
+// refresh the RAM shadow of the efuse blocks
+void esp_efuse_update_shadow(void)
+{
+    EFUSE_LOCK_ACQUIRE();
+    esp_efuse_utility_update_shadow();
+    EFUSE_LOCK_RELEASE();
+}
+
 bool esp_efuse_read_field_bit(const esp_efuse_desc_t *field[])
 {
     uint8_t value = 0;
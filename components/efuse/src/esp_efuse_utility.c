@@ -30,6 +30,17 @@ uint32_t virt_blocks[EFUSE_BLK_MAX][COUNT_EFUSE_REG_PER_BLOCK];
 __attribute__((constructor)) void esp_efuse_utility_update_virt_blocks(void);
 #endif
 
+// RAM shadow of the efuse blocks, serving the read path without controller access.
+#ifdef CONFIG_EFUSE_CACHE_SHADOW
+static uint32_t shadow_blocks[EFUSE_BLK_MAX][COUNT_EFUSE_REG_PER_BLOCK];
+static volatile bool s_shadow_valid;
+
+#ifndef BOOTLOADER_BUILD
+/* Seed the shadow before drivers start reading calibration fields */
+__attribute__((constructor)) void esp_efuse_utility_update_shadow(void);
+#endif
+#endif
+
 extern const esp_efuse_range_addr_t range_read_addr_blocks[];
 extern const esp_efuse_range_addr_t range_write_addr_blocks[];
 
@@ -177,6 +188,21 @@ void esp_efuse_utility_update_virt_blocks(void)
 #endif
 }
 
+// Fills the shadow_blocks array by values from the efuse read registers.
+void esp_efuse_utility_update_shadow(void)
+{
+#ifdef CONFIG_EFUSE_CACHE_SHADOW
+    for (int num_block = EFUSE_BLK0; num_block < EFUSE_BLK_MAX; num_block++) {
+        int subblock = 0;
+        for (uint32_t addr_rd_block = range_read_addr_blocks[num_block].start; addr_rd_block <= range_read_addr_blocks[num_block].end; addr_rd_block += 4) {
+            shadow_blocks[num_block][subblock++] = REG_READ(addr_rd_block);
+        }
+        ESP_LOGD(TAG, "shadow_blocks[%d] is filled by EFUSE_BLOCK%d", num_block, num_block);
+    }
+    s_shadow_valid = true;
+#endif
+}
+
 // Prints efuse values for all registers.
 #ifndef BOOTLOADER_BUILD
 void esp_efuse_utility_debug_dump_blocks(void)
@@ -231,8 +257,16 @@ uint32_t esp_efuse_utility_read_reg(esp_efuse_block_t blk, unsigned int num_reg)
     unsigned int max_num_reg = (range_read_addr_blocks[blk].end - range_read_addr_blocks[blk].start) / sizeof(uint32_t);
     assert(num_reg <= max_num_reg);
     uint32_t value;
-#ifdef CONFIG_EFUSE_VIRTUAL
+#if defined(CONFIG_EFUSE_VIRTUAL)
     value = virt_blocks[blk][num_reg];
+#elif defined(CONFIG_EFUSE_CACHE_SHADOW)
+    // the shadow is seeded by a constructor; the bootloader (or a read racing
+    // with startup) falls back to the registers
+    if (s_shadow_valid) {
+        value = shadow_blocks[blk][num_reg];
+    } else {
+        value = REG_READ(range_read_addr_blocks[blk].start + num_reg * 4);
+    }
 #else
     value = REG_READ(range_read_addr_blocks[blk].start + num_reg * 4);
 #endif
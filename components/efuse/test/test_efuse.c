@@ -88,6 +88,45 @@ TEST_CASE("efuse test read_field_cnt", "[efuse]")
     test_read_cnt();
 }
 
+static void test_read_fields_batch(void)
+{
+    esp_efuse_utility_update_virt_blocks();
+    esp_efuse_utility_debug_dump_blocks();
+
+    ESP_LOGI(TAG, "1. Test check args");
+    uint8_t mac_batch[6];
+    esp_efuse_batch_read_t table[] = {
+        { .field = ESP_EFUSE_MAC_FACTORY, .dst = mac_batch, .dst_size_bits = sizeof(mac_batch) * 8 },
+        { .field = ESP_EFUSE_TEST1_LEN_8, .dst = NULL,      .dst_size_bits = 8 },
+    };
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_efuse_read_fields(NULL, 1));
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_efuse_read_fields(table, 0));
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_efuse_read_fields(table, 2));
+
+    ESP_LOGI(TAG, "2. Batch result matches the per-field reads");
+    uint8_t test1_len_8 = 0;
+    table[1].dst = &test1_len_8;
+    TEST_ESP_OK(esp_efuse_read_fields(table, 2));
+
+    uint8_t mac[6];
+    uint8_t single = 0;
+    TEST_ESP_OK(esp_efuse_read_field_blob(ESP_EFUSE_MAC_FACTORY, &mac, sizeof(mac) * 8));
+    TEST_ESP_OK(esp_efuse_read_field_blob(ESP_EFUSE_TEST1_LEN_8, &single, 8));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(mac, mac_batch, sizeof(mac));
+    TEST_ASSERT_EQUAL_HEX8(single, test1_len_8);
+
+    ESP_LOGI(TAG, "3. Shadow refresh keeps subsequent reads consistent");
+    esp_efuse_update_shadow();
+    memset(mac_batch, 0, sizeof(mac_batch));
+    TEST_ESP_OK(esp_efuse_read_fields(table, 1));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(mac, mac_batch, sizeof(mac));
+}
+
+TEST_CASE("efuse test read_fields batch", "[efuse]")
+{
+    test_read_fields_batch();
+}
+
 // If using efuse is real, then turn off writing tests.
 #ifdef CONFIG_EFUSE_VIRTUAL
 static void test_write_blob(void)
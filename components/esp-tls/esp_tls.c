@@ -230,7 +230,7 @@ err_freeaddr:
     return ret;
 }
 
-static int esp_tls_low_level_conn(const char *hostname, int hostlen, int port, const esp_tls_cfg_t *cfg, esp_tls_t *tls)
+static int esp_tls_low_level_conn(const char *hostname, int hostlen, int port, const esp_tls_cfg_t *cfg, esp_tls_t *tls, bool polling)
 {
     if (!tls) {
         ESP_LOGE(TAG, "empty esp_tls parameter");
@@ -264,17 +264,20 @@ static int esp_tls_low_level_conn(const char *hostname, int hostlen, int port, c
             tls->wset = tls->rset;
         }
         tls->conn_state = ESP_TLS_CONNECTING;
+        tls->poll_wants = ESP_TLS_WANT_WRITE;
     /* falls through */
     case ESP_TLS_CONNECTING:
         if (cfg->non_block) {
             ESP_LOGD(TAG, "connecting...");
             struct timeval tv;
-            ms_to_timeval(cfg->timeout_ms, &tv);
+            /* When polling, just probe the socket and return immediately; the
+               caller waits on it through esp_tls_conn_get_poll_info() */
+            ms_to_timeval(polling ? 0 : cfg->timeout_ms, &tv);
 
             /* In case of non-blocking I/O, we use the select() API to check whether
                connection has been established or not*/
             if (select(tls->sockfd + 1, &tls->rset, &tls->wset, NULL,
-                       cfg->timeout_ms>0 ? &tv : NULL) == 0) {
+                       (polling || cfg->timeout_ms>0) ? &tv : NULL) == 0) {
                 ESP_LOGD(TAG, "select() timed out");
                 return 0;
             }
@@ -289,6 +292,13 @@ static int esp_tls_low_level_conn(const char *hostname, int hostlen, int port, c
                     tls->conn_state = ESP_TLS_FAIL;
                     return -1;
                 }
+                if (error != 0) {
+                    ESP_LOGD(TAG, "Non blocking connect failed (SO_ERROR %d)", error);
+                    ESP_INT_EVENT_TRACKER_CAPTURE(tls->error_handle, ESP_TLS_ERR_TYPE_SYSTEM, error);
+                    ESP_INT_EVENT_TRACKER_CAPTURE(tls->error_handle, ESP_TLS_ERR_TYPE_ESP, ESP_ERR_ESP_TLS_FAILED_CONNECT_TO_HOST);
+                    tls->conn_state = ESP_TLS_FAIL;
+                    return -1;
+                }
             }
         }
         /* By now, the connection has been established */
@@ -305,6 +315,8 @@ static int esp_tls_low_level_conn(const char *hostname, int hostlen, int port, c
     /* falls through */
     case ESP_TLS_HANDSHAKE:
         ESP_LOGD(TAG, "handshake in progress...");
+        /* The backend refines this to the exact direction it is blocked on */
+        tls->poll_wants = ESP_TLS_WANT_READ | ESP_TLS_WANT_WRITE;
         return esp_tls_handshake(tls, cfg);
         break;
     case ESP_TLS_FAIL:
@@ -330,7 +342,7 @@ esp_tls_t *esp_tls_conn_new(const char *hostname, int hostlen, int port, const e
        API returns only after connection is established unless there is an error*/
     size_t start = xTaskGetTickCount();
     while (1) {
-        int ret = esp_tls_low_level_conn(hostname, hostlen, port, cfg, tls);
+        int ret = esp_tls_low_level_conn(hostname, hostlen, port, cfg, tls, false);
         if (ret == 1) {
             return tls;
         } else if (ret == -1) {
@@ -356,7 +368,7 @@ int esp_tls_conn_new_sync(const char *hostname, int hostlen, int port, const esp
     it is an alternative to esp_tls_conn_new() which is left for compatibility reasons */
     size_t start = xTaskGetTickCount();
     while (1) {
-        int ret = esp_tls_low_level_conn(hostname, hostlen, port, cfg, tls);
+        int ret = esp_tls_low_level_conn(hostname, hostlen, port, cfg, tls, false);
         if (ret == 1) {
             return ret;
         } else if (ret == -1) {
@@ -380,7 +392,27 @@ int esp_tls_conn_new_sync(const char *hostname, int hostlen, int port, const esp
  */
 int esp_tls_conn_new_async(const char *hostname, int hostlen, int port, const esp_tls_cfg_t *cfg, esp_tls_t *tls)
 {
-    return esp_tls_low_level_conn(hostname, hostlen, port, cfg, tls);
+    return esp_tls_low_level_conn(hostname, hostlen, port, cfg, tls, false);
+}
+
+int esp_tls_conn_poll(const char *hostname, int hostlen, int port, const esp_tls_cfg_t *cfg, esp_tls_t *tls)
+{
+    if (!cfg || !cfg->non_block) {
+        ESP_LOGE(TAG, "esp_tls_conn_poll requires a non-blocking configuration");
+        return -1;
+    }
+    return esp_tls_low_level_conn(hostname, hostlen, port, cfg, tls, true);
+}
+
+esp_err_t esp_tls_conn_get_poll_info(esp_tls_t *tls, int *sockfd, int *wants)
+{
+    if (!tls || !sockfd || !wants) {
+        ESP_LOGE(TAG, "Invalid arguments passed");
+        return ESP_ERR_INVALID_ARG;
+    }
+    *sockfd = tls->sockfd;
+    *wants = tls->poll_wants;
+    return ESP_OK;
 }
 
 static int get_port(const char *url, struct http_parser_url *u)
@@ -457,6 +489,40 @@ void esp_tls_server_session_delete(esp_tls_t *tls)
 {
     return _esp_tls_server_session_delete(tls);
 }
+
+#ifdef CONFIG_ESP_TLS_SERVER_SESSION_TICKETS
+/**
+ * @brief      Initialize the session ticket context of a server configuration
+ */
+esp_err_t esp_tls_cfg_server_session_tickets_init(esp_tls_cfg_server_t *cfg)
+{
+    if (cfg == NULL || cfg->ticket_ctx != NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    cfg->ticket_ctx = calloc(1, sizeof(esp_tls_server_session_ticket_ctx_t));
+    if (cfg->ticket_ctx == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    esp_err_t ret = esp_mbedtls_server_session_ticket_ctx_init(cfg->ticket_ctx);
+    if (ret != ESP_OK) {
+        free(cfg->ticket_ctx);
+        cfg->ticket_ctx = NULL;
+    }
+    return ret;
+}
+
+/**
+ * @brief      Free the session ticket context of a server configuration
+ */
+void esp_tls_cfg_server_session_tickets_free(esp_tls_cfg_server_t *cfg)
+{
+    if (cfg && cfg->ticket_ctx) {
+        esp_mbedtls_server_session_ticket_ctx_free(cfg->ticket_ctx);
+        free(cfg->ticket_ctx);
+        cfg->ticket_ctx = NULL;
+    }
+}
+#endif /* CONFIG_ESP_TLS_SERVER_SESSION_TICKETS */
 #endif /* CONFIG_ESP_TLS_SERVER */
 
 ssize_t esp_tls_get_bytes_avail(esp_tls_t *tls)
@@ -504,3 +570,27 @@ void esp_tls_free_global_ca_store(void)
 {
     return _esp_tls_free_global_ca_store();
 }
+
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+void esp_tls_free_client_session_cache(void)
+{
+    return esp_mbedtls_free_client_session_cache();
+}
+
+esp_err_t esp_tls_client_session_retain(const char *hostname, void *buf, size_t buf_len, size_t *out_len)
+{
+    return esp_mbedtls_client_session_retain(hostname, buf, buf_len, out_len);
+}
+
+esp_err_t esp_tls_client_session_reinstate(const void *buf, size_t buf_len)
+{
+    return esp_mbedtls_client_session_reinstate(buf, buf_len);
+}
+#endif
+
+#ifdef CONFIG_ESP_TLS_VERIFIED_CHAIN_CACHE
+void esp_tls_free_verified_chain_cache(void)
+{
+    return esp_mbedtls_free_verified_chain_cache();
+}
+#endif
@@ -27,6 +27,9 @@
 #include "mbedtls/ctr_drbg.h"
 #include "mbedtls/error.h"
 #include "mbedtls/certs.h"
+#ifdef CONFIG_ESP_TLS_SERVER_SESSION_TICKETS
+#include "mbedtls/ssl_ticket.h"
+#endif
 #elif CONFIG_ESP_TLS_USING_WOLFSSL
 #include "wolfssl/wolfcrypt/settings.h"
 #include "wolfssl/ssl.h"
@@ -112,6 +115,14 @@ typedef enum esp_tls_conn_state {
     ESP_TLS_DONE,
 } esp_tls_conn_state_t;
 
+/**
+ * Pending I/O directions of an in-progress connection, as reported by
+ * esp_tls_conn_get_poll_info(). The connection makes progress once the
+ * socket becomes readable/writable accordingly.
+ */
+#define ESP_TLS_WANT_READ   (1 << 0)
+#define ESP_TLS_WANT_WRITE  (1 << 1)
+
 typedef enum esp_tls_role {
     ESP_TLS_CLIENT = 0,
     ESP_TLS_SERVER,
@@ -222,9 +233,32 @@ typedef struct esp_tls_cfg {
                                                  bundle for server verification, must be enabled in menuconfig */
 
     void *ds_data;                          /*!< Pointer for digital signature peripheral context */
+
+    bool use_session_cache;                 /*!< Cache the TLS session established by this connection and
+                                                 resume the cached session on the next connection to the same
+                                                 host, shortening the handshake. Requires the
+                                                 ESP_TLS_CLIENT_SESSION_CACHE option to be enabled. */
+
+    bool use_verified_chain_cache;          /*!< Skip the RSA/ECDSA signature verification when the peer
+                                                 presents a certificate chain that already passed full
+                                                 verification on an earlier connection. Only takes effect
+                                                 together with cacert_buf or use_global_ca_store. Requires
+                                                 the ESP_TLS_VERIFIED_CHAIN_CACHE option to be enabled. */
 } esp_tls_cfg_t;
 
 #ifdef CONFIG_ESP_TLS_SERVER
+#ifdef CONFIG_ESP_TLS_SERVER_SESSION_TICKETS
+/**
+ * @brief Keying material for issuing and parsing session tickets, shared by
+ *        all connections created from one server configuration
+ */
+typedef struct esp_tls_server_session_ticket_ctx {
+    mbedtls_entropy_context entropy;                                            /*!< Entropy source for the ticket key RNG */
+    mbedtls_ctr_drbg_context ctr_drbg;                                          /*!< RNG used for ticket key generation and rotation */
+    mbedtls_ssl_ticket_context ticket_ctx;                                      /*!< mbedTLS session ticket context */
+} esp_tls_server_session_ticket_ctx_t;
+#endif
+
 typedef struct esp_tls_cfg_server {
     const char **alpn_protos;                   /*!< Application protocols required for HTTP2.
                                                      If HTTP2/ALPN support is required, a list
@@ -276,7 +310,40 @@ typedef struct esp_tls_cfg_server {
     unsigned int serverkey_password_len;        /*!< String length of the password pointed to by
                                                      serverkey_password */
 
+#ifdef CONFIG_ESP_TLS_SERVER_SESSION_TICKETS
+    esp_tls_server_session_ticket_ctx_t *ticket_ctx; /*!< Session ticket context, initialized with
+                                                     esp_tls_cfg_server_session_tickets_init().
+                                                     When NULL, no tickets are issued */
+#endif
 } esp_tls_cfg_server_t;
+
+#ifdef CONFIG_ESP_TLS_SERVER_SESSION_TICKETS
+/**
+ * @brief      Initialize the session ticket context of a server configuration
+ *
+ * Allocates the ticket context and generates the initial ticket keys. Server
+ * sessions created from this configuration afterwards issue session tickets
+ * to their clients, allowing them to resume with an abbreviated handshake.
+ *
+ * @param[in]  cfg  Pointer to the server configuration
+ *
+ * @return
+ *             - ESP_OK if the context was set up
+ *             - ESP_ERR_NO_MEM on allocation failure
+ *             - ESP_ERR_MBEDTLS_CTR_DRBG_SEED_FAILED if seeding the ticket key RNG failed
+ */
+esp_err_t esp_tls_cfg_server_session_tickets_init(esp_tls_cfg_server_t *cfg);
+
+/**
+ * @brief      Free the session ticket context of a server configuration
+ *
+ * Must only be called once no server session created from this configuration
+ * is left.
+ *
+ * @param[in]  cfg  Pointer to the server configuration
+ */
+void esp_tls_cfg_server_session_tickets_free(esp_tls_cfg_server_t *cfg);
+#endif /* ! CONFIG_ESP_TLS_SERVER_SESSION_TICKETS */
 #endif /* ! CONFIG_ESP_TLS_SERVER */
 
 /**
@@ -338,6 +405,13 @@ typedef struct esp_tls {
 
     esp_tls_error_handle_t error_handle;                                        /*!< handle to error descriptor */
 
+    int poll_wants;                                                             /*!< I/O directions an in-progress connection
+                                                                                     is waiting for (ESP_TLS_WANT_READ /
+                                                                                     ESP_TLS_WANT_WRITE bitmask) */
+
+    bool deferred_verify;                                                       /*!< Certificate verification is performed after
+                                                                                     the handshake, against the verified chain
+                                                                                     cache (use_verified_chain_cache) */
 } esp_tls_t;
 
 
@@ -446,6 +520,48 @@ int esp_tls_conn_new_async(const char *hostname, int hostlen, int port, const es
  */
 int esp_tls_conn_http_new_async(const char *url, const esp_tls_cfg_t *cfg, esp_tls_t *tls);
 
+/**
+ * @brief      Advance a non-blocking TLS/SSL connection by one step, never blocking
+ *
+ * Unlike esp_tls_conn_new_async(), which may wait up to the configured timeout while
+ * polling the TCP connect, this function returns immediately when no progress can be
+ * made. Between calls the caller should select()/poll() on the socket according to
+ * esp_tls_conn_get_poll_info(), which allows multiplexing any number of in-progress
+ * connections on a single task. `non_block` must be set in the configuration.
+ *
+ * Note that hostname resolution still happens synchronously on the first call, as the
+ * sockets API offers no asynchronous resolver; pass an IP literal to avoid it.
+ *
+ * @param[in]  hostname  Hostname of the host.
+ * @param[in]  hostlen   Length of hostname.
+ * @param[in]  port      Port number of the host.
+ * @param[in]  cfg       TLS configuration as esp_tls_cfg_t with `non_block` set to true.
+ * @param[in]  tls       pointer to esp-tls as esp-tls handle.
+ *
+ * @return
+ *             - -1      If connection establishment fails.
+ *             -  0      If connection establishment is in progress.
+ *             -  1      If connection establishment is successful.
+ */
+int esp_tls_conn_poll(const char *hostname, int hostlen, int port, const esp_tls_cfg_t *cfg, esp_tls_t *tls);
+
+/**
+ * @brief      Get the socket and pending I/O directions of an in-progress connection
+ *
+ * Valid while a connection driven by esp_tls_conn_poll() (or esp_tls_conn_new_async())
+ * has returned 0; the caller should wait for the socket to become readable and/or
+ * writable as indicated before stepping the connection again.
+ *
+ * @param[in]  tls     pointer to esp-tls as esp-tls handle.
+ * @param[out] sockfd  Set to the underlying socket descriptor.
+ * @param[out] wants   Set to a bitmask of ESP_TLS_WANT_READ / ESP_TLS_WANT_WRITE.
+ *
+ * @return
+ *             - ESP_OK on success
+ *             - ESP_ERR_INVALID_ARG on invalid arguments
+ */
+esp_err_t esp_tls_conn_get_poll_info(esp_tls_t *tls, int *sockfd, int *wants);
+
 /**
  * @brief      Write from buffer 'data' into specified tls connection.
  *
@@ -573,6 +689,71 @@ esp_err_t esp_tls_set_global_ca_store(const unsigned char *cacert_pem_buf, const
  */
 void esp_tls_free_global_ca_store(void);
 
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+/**
+ * @brief      Drop all cached client TLS sessions.
+ *
+ * Sessions cached through the use_session_cache configuration option are freed and
+ * subsequent connections perform a full handshake again. The application should call
+ * this API e.g. after changing server credentials.
+ */
+void esp_tls_free_client_session_cache(void);
+
+/**
+ * @brief      Flatten the cached TLS session for a host into a buffer that survives deep sleep.
+ *
+ * The session cached for @c hostname (see the use_session_cache configuration option) is
+ * serialized into @c buf, which the application typically places in RTC memory
+ * (RTC_DATA_ATTR) so that esp_tls_client_session_reinstate() can put it back after wake
+ * and the next connection resumes instead of performing a full handshake. Retaining a
+ * session removes it from the cache, since a session is only resumed once.
+ *
+ * The buffer contents are a raw snapshot: they are only valid when read back by the same
+ * firmware image (the deep-sleep case) and contain the session's secret keying material,
+ * so they must not be written to persistent storage.
+ *
+ * Call with @c buf set to NULL to query the required size through @c out_len.
+ *
+ * @param[in]  hostname  Host the session was established with.
+ * @param[out] buf       Destination buffer, or NULL to query the size.
+ * @param[in]  buf_len   Size of the destination buffer in bytes.
+ * @param[out] out_len   Number of bytes the serialized session needs/used.
+ *
+ * @return
+ *             - ESP_OK on success
+ *             - ESP_ERR_NOT_FOUND if no session is cached for this host
+ *             - ESP_ERR_INVALID_SIZE if the buffer is too small (the session stays cached)
+ */
+esp_err_t esp_tls_client_session_retain(const char *hostname, void *buf, size_t buf_len, size_t *out_len);
+
+/**
+ * @brief      Restore a TLS session retained with esp_tls_client_session_retain().
+ *
+ * Call once after wake from deep sleep; the session goes back into the client session
+ * cache and the next esp-tls connection to the same host offers it for resumption.
+ *
+ * @param[in]  buf      Buffer filled in by esp_tls_client_session_retain().
+ * @param[in]  buf_len  Size of the buffer in bytes.
+ *
+ * @return
+ *             - ESP_OK on success
+ *             - ESP_ERR_INVALID_ARG if the buffer does not hold a retained session
+ *             - ESP_ERR_NO_MEM on allocation failure
+ */
+esp_err_t esp_tls_client_session_reinstate(const void *buf, size_t buf_len);
+#endif
+
+#ifdef CONFIG_ESP_TLS_VERIFIED_CHAIN_CACHE
+/**
+ * @brief      Drop all cached verified certificate chain fingerprints.
+ *
+ * Fingerprints cached through the use_verified_chain_cache configuration option are
+ * forgotten and the next connection performs full certificate verification again.
+ * The application should call this API e.g. after updating the trusted CA store.
+ */
+void esp_tls_free_verified_chain_cache(void);
+#endif
+
 /**
  * @brief      Returns last error in esp_tls with detailed mbedtls related error codes.
  *             The error information is cleared internally upon return
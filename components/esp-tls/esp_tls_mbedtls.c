@@ -49,6 +49,23 @@ static esp_err_t esp_set_atecc608a_pki_context(esp_tls_t *tls, esp_tls_cfg_t *cf
 static esp_err_t esp_mbedtls_init_pk_ctx_for_ds(const void *pki);
 #endif /* CONFIG_ESP_TLS_USE_DS_PERIPHERAL */
 
+#if defined(CONFIG_ESP_TLS_CLIENT_SESSION_CACHE) || defined(CONFIG_ESP_TLS_VERIFIED_CHAIN_CACHE)
+#include "freertos/FreeRTOS.h"
+#endif
+
+#ifdef CONFIG_ESP_TLS_VERIFIED_CHAIN_CACHE
+#include "mbedtls/sha256.h"
+#include "esp_timer.h"
+#endif
+
+#if defined(CONFIG_ESP_TLS_SERVER_SESSION_CACHE) || defined(CONFIG_ESP_TLS_SERVER_SESSION_TICKETS)
+#include <sys/lock.h>
+#endif
+
+#ifdef CONFIG_ESP_TLS_SERVER_SESSION_CACHE
+#include "mbedtls/ssl_cache.h"
+#endif
+
 static const char *TAG = "esp-tls-mbedtls";
 static mbedtls_x509_crt *global_cacert = NULL;
 
@@ -66,6 +83,356 @@ typedef struct esp_tls_pki_t {
 #endif
 } esp_tls_pki_t;
 
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+typedef struct esp_tls_session_entry {
+    bool valid;
+    char *hostname;
+    mbedtls_ssl_session session;
+} esp_tls_session_entry_t;
+
+/* Cached client sessions, keyed by the hostname set on the ssl context.
+ * Entries are swapped in and out under the spinlock; the mbedtls session
+ * copies (which allocate) are always made outside of it. */
+static esp_tls_session_entry_t s_session_cache[CONFIG_ESP_TLS_CLIENT_SESSION_CACHE_SIZE];
+static unsigned s_session_evict_idx;
+static portMUX_TYPE s_session_cache_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static void esp_mbedtls_session_entry_free(esp_tls_session_entry_t *entry)
+{
+    if (entry->valid) {
+        mbedtls_ssl_session_free(&entry->session);
+        free(entry->hostname);
+        entry->valid = false;
+        entry->hostname = NULL;
+    }
+}
+
+/* Take the entry for this hostname out of the cache: a ticket/session ID
+ * is only replayed once, so whoever takes it owns (and later frees) it. */
+static bool esp_mbedtls_session_cache_take(const char *hostname, esp_tls_session_entry_t *taken)
+{
+    memset(taken, 0, sizeof(*taken));
+    portENTER_CRITICAL(&s_session_cache_lock);
+    for (int i = 0; i < CONFIG_ESP_TLS_CLIENT_SESSION_CACHE_SIZE; i++) {
+        if (s_session_cache[i].valid && strcmp(s_session_cache[i].hostname, hostname) == 0) {
+            *taken = s_session_cache[i];
+            s_session_cache[i].valid = false;
+            s_session_cache[i].hostname = NULL;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_session_cache_lock);
+    return taken->valid;
+}
+
+static void esp_mbedtls_session_cache_insert(esp_tls_session_entry_t entry)
+{
+    portENTER_CRITICAL(&s_session_cache_lock);
+    int slot = -1;
+    for (int i = 0; i < CONFIG_ESP_TLS_CLIENT_SESSION_CACHE_SIZE; i++) {
+        if (s_session_cache[i].valid && strcmp(s_session_cache[i].hostname, entry.hostname) == 0) {
+            slot = i;
+            break;
+        }
+        if (slot == -1 && !s_session_cache[i].valid) {
+            slot = i;
+        }
+    }
+    if (slot == -1) {
+        /* Cache full of other hosts: evict round-robin */
+        slot = s_session_evict_idx++ % CONFIG_ESP_TLS_CLIENT_SESSION_CACHE_SIZE;
+    }
+    esp_tls_session_entry_t evicted = s_session_cache[slot];
+    s_session_cache[slot] = entry;
+    portEXIT_CRITICAL(&s_session_cache_lock);
+
+    esp_mbedtls_session_entry_free(&evicted);
+}
+
+static void esp_mbedtls_session_apply(esp_tls_t *tls)
+{
+    const char *hostname = tls->ssl.hostname;
+    if (hostname == NULL) {
+        /* No hostname (skip_common_name): nothing to key the cache on */
+        return;
+    }
+    esp_tls_session_entry_t taken;
+    if (!esp_mbedtls_session_cache_take(hostname, &taken)) {
+        return;
+    }
+    int ret = mbedtls_ssl_set_session(&tls->ssl, &taken.session);
+    if (ret != 0) {
+        ESP_LOGD(TAG, "mbedtls_ssl_set_session returned -0x%x", -ret);
+    } else {
+        ESP_LOGD(TAG, "Offering cached session for %s", hostname);
+    }
+    esp_mbedtls_session_entry_free(&taken);
+}
+
+static void esp_mbedtls_session_store(esp_tls_t *tls)
+{
+    const char *hostname = tls->ssl.hostname;
+    if (hostname == NULL) {
+        return;
+    }
+    esp_tls_session_entry_t entry = { .valid = true };
+    mbedtls_ssl_session_init(&entry.session);
+    if (mbedtls_ssl_get_session(&tls->ssl, &entry.session) != 0) {
+        mbedtls_ssl_session_free(&entry.session);
+        return;
+    }
+    entry.hostname = strdup(hostname);
+    if (entry.hostname == NULL) {
+        mbedtls_ssl_session_free(&entry.session);
+        return;
+    }
+
+    esp_mbedtls_session_cache_insert(entry);
+    ESP_LOGD(TAG, "Cached session for %s", hostname);
+}
+
+void esp_mbedtls_free_client_session_cache(void)
+{
+    for (int i = 0; i < CONFIG_ESP_TLS_CLIENT_SESSION_CACHE_SIZE; i++) {
+        portENTER_CRITICAL(&s_session_cache_lock);
+        esp_tls_session_entry_t taken = s_session_cache[i];
+        s_session_cache[i].valid = false;
+        s_session_cache[i].hostname = NULL;
+        portEXIT_CRITICAL(&s_session_cache_lock);
+        esp_mbedtls_session_entry_free(&taken);
+    }
+}
+
+/* Flattened cache entry for RTC retention: header, raw mbedtls_ssl_session
+ * struct, hostname (with NUL), ticket bytes. The struct is copied as-is,
+ * which is only valid when the very same firmware image reads it back —
+ * exactly the deep-sleep case this exists for. */
+typedef struct esp_tls_retained_session_hdr {
+    uint32_t magic;
+    uint16_t hostname_len;      /* including terminating NUL */
+    uint16_t ticket_len;
+} esp_tls_retained_session_hdr_t;
+
+#define RETAINED_SESSION_MAGIC 0x544c5352   /* "TLSR" */
+
+esp_err_t esp_mbedtls_client_session_retain(const char *hostname, void *buf, size_t buf_len, size_t *out_len)
+{
+    if (hostname == NULL || out_len == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_tls_session_entry_t taken;
+    if (!esp_mbedtls_session_cache_take(hostname, &taken)) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    size_t hostname_len = strlen(taken.hostname) + 1;
+    size_t ticket_len = 0;
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_CLI_C)
+    ticket_len = taken.session.ticket_len;
+#endif
+    size_t needed = sizeof(esp_tls_retained_session_hdr_t) + sizeof(mbedtls_ssl_session)
+                    + hostname_len + ticket_len;
+    *out_len = needed;
+    if (buf == NULL || buf_len < needed) {
+        /* Put the entry back so it is not lost on a sizing probe */
+        esp_mbedtls_session_cache_insert(taken);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    uint8_t *p = (uint8_t *)buf;
+    esp_tls_retained_session_hdr_t hdr = {
+        .magic = RETAINED_SESSION_MAGIC,
+        .hostname_len = hostname_len,
+        .ticket_len = ticket_len,
+    };
+    memcpy(p, &hdr, sizeof(hdr));
+    p += sizeof(hdr);
+    memcpy(p, &taken.session, sizeof(mbedtls_ssl_session));
+    p += sizeof(mbedtls_ssl_session);
+    memcpy(p, taken.hostname, hostname_len);
+    p += hostname_len;
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_CLI_C)
+    if (ticket_len) {
+        memcpy(p, taken.session.ticket, ticket_len);
+    }
+#endif
+    /* Like esp_mbedtls_session_apply(): taking a session consumes it */
+    esp_mbedtls_session_entry_free(&taken);
+    return ESP_OK;
+}
+
+esp_err_t esp_mbedtls_client_session_reinstate(const void *buf, size_t buf_len)
+{
+    if (buf == NULL || buf_len < sizeof(esp_tls_retained_session_hdr_t)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_tls_retained_session_hdr_t hdr;
+    memcpy(&hdr, buf, sizeof(hdr));
+    if (hdr.magic != RETAINED_SESSION_MAGIC || hdr.hostname_len == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (buf_len < sizeof(hdr) + sizeof(mbedtls_ssl_session) + hdr.hostname_len + hdr.ticket_len) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    const uint8_t *p = (const uint8_t *)buf + sizeof(hdr);
+    esp_tls_session_entry_t entry = { .valid = true };
+    memcpy(&entry.session, p, sizeof(mbedtls_ssl_session));
+    p += sizeof(mbedtls_ssl_session);
+#ifdef MBEDTLS_X509_CRT_PARSE_C
+    /* Heap pointer from before the sleep cycle; the verify_result carried
+     * in the session is what resumption actually relies on */
+    entry.session.peer_cert = NULL;
+#endif
+    if (p[hdr.hostname_len - 1] != '\0') {
+        return ESP_ERR_INVALID_ARG;
+    }
+    entry.hostname = strdup((const char *)p);
+    if (entry.hostname == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    p += hdr.hostname_len;
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_CLI_C)
+    entry.session.ticket = NULL;
+    entry.session.ticket_len = 0;
+    if (hdr.ticket_len) {
+        entry.session.ticket = malloc(hdr.ticket_len);
+        if (entry.session.ticket == NULL) {
+            free(entry.hostname);
+            return ESP_ERR_NO_MEM;
+        }
+        memcpy(entry.session.ticket, p, hdr.ticket_len);
+        entry.session.ticket_len = hdr.ticket_len;
+    }
+#endif
+    esp_mbedtls_session_cache_insert(entry);
+    return ESP_OK;
+}
+#endif /* CONFIG_ESP_TLS_CLIENT_SESSION_CACHE */
+
+#ifdef CONFIG_ESP_TLS_VERIFIED_CHAIN_CACHE
+#define CHAIN_FP_LEN 32
+
+typedef struct esp_tls_chain_fp_entry {
+    bool valid;
+    uint8_t fingerprint[CHAIN_FP_LEN];
+    int64_t verified_at;    /* esp_timer time of the full verification, us */
+} esp_tls_chain_fp_entry_t;
+
+/* Fingerprints of peer chains that passed a full X.509 verification.
+ * Entries are only ever written after mbedtls_x509_crt_verify() succeeded
+ * against the CA store the connection was configured with. */
+static esp_tls_chain_fp_entry_t s_chain_fp_cache[CONFIG_ESP_TLS_VERIFIED_CHAIN_CACHE_SIZE];
+static unsigned s_chain_fp_evict_idx;
+static portMUX_TYPE s_chain_fp_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static int esp_mbedtls_chain_fingerprint(const mbedtls_x509_crt *chain, uint8_t fingerprint[CHAIN_FP_LEN])
+{
+    int ret;
+    mbedtls_sha256_context sha;
+    mbedtls_sha256_init(&sha);
+    mbedtls_sha256_starts_ret(&sha, 0);
+    for (const mbedtls_x509_crt *crt = chain; crt != NULL; crt = crt->next) {
+        if ((ret = mbedtls_sha256_update_ret(&sha, crt->raw.p, crt->raw.len)) != 0) {
+            mbedtls_sha256_free(&sha);
+            return ret;
+        }
+    }
+    ret = mbedtls_sha256_finish_ret(&sha, fingerprint);
+    mbedtls_sha256_free(&sha);
+    return ret;
+}
+
+static bool esp_mbedtls_chain_fp_lookup(const uint8_t fingerprint[CHAIN_FP_LEN])
+{
+    bool found = false;
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&s_chain_fp_lock);
+    for (int i = 0; i < CONFIG_ESP_TLS_VERIFIED_CHAIN_CACHE_SIZE; i++) {
+        if (!s_chain_fp_cache[i].valid ||
+            memcmp(s_chain_fp_cache[i].fingerprint, fingerprint, CHAIN_FP_LEN) != 0) {
+            continue;
+        }
+#if CONFIG_ESP_TLS_VERIFIED_CHAIN_CACHE_TTL > 0
+        if (now - s_chain_fp_cache[i].verified_at > (int64_t)CONFIG_ESP_TLS_VERIFIED_CHAIN_CACHE_TTL * 1000000LL) {
+            /* Expired: drop, caller re-verifies and refreshes the entry */
+            s_chain_fp_cache[i].valid = false;
+            break;
+        }
+#else
+        (void) now;
+#endif
+        found = true;
+        break;
+    }
+    portEXIT_CRITICAL(&s_chain_fp_lock);
+    return found;
+}
+
+static void esp_mbedtls_chain_fp_store(const uint8_t fingerprint[CHAIN_FP_LEN])
+{
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&s_chain_fp_lock);
+    int slot = -1;
+    for (int i = 0; i < CONFIG_ESP_TLS_VERIFIED_CHAIN_CACHE_SIZE; i++) {
+        if (s_chain_fp_cache[i].valid &&
+            memcmp(s_chain_fp_cache[i].fingerprint, fingerprint, CHAIN_FP_LEN) == 0) {
+            slot = i;
+            break;
+        }
+        if (slot == -1 && !s_chain_fp_cache[i].valid) {
+            slot = i;
+        }
+    }
+    if (slot == -1) {
+        slot = s_chain_fp_evict_idx++ % CONFIG_ESP_TLS_VERIFIED_CHAIN_CACHE_SIZE;
+    }
+    s_chain_fp_cache[slot].valid = true;
+    memcpy(s_chain_fp_cache[slot].fingerprint, fingerprint, CHAIN_FP_LEN);
+    s_chain_fp_cache[slot].verified_at = now;
+    portEXIT_CRITICAL(&s_chain_fp_lock);
+}
+
+void esp_mbedtls_free_verified_chain_cache(void)
+{
+    portENTER_CRITICAL(&s_chain_fp_lock);
+    memset(s_chain_fp_cache, 0, sizeof(s_chain_fp_cache));
+    portEXIT_CRITICAL(&s_chain_fp_lock);
+}
+
+/* Deferred certificate verification for connections using the verified chain
+ * cache: the handshake itself ran with MBEDTLS_SSL_VERIFY_NONE, so the peer
+ * chain must either match a cached fingerprint or pass full verification now. */
+static esp_err_t esp_mbedtls_verify_deferred(esp_tls_t *tls)
+{
+    uint8_t fingerprint[CHAIN_FP_LEN];
+    const mbedtls_x509_crt *peer = mbedtls_ssl_get_peer_cert(&tls->ssl);
+    if (peer == NULL || esp_mbedtls_chain_fingerprint(peer, fingerprint) != 0) {
+        ESP_LOGE(TAG, "No peer certificate chain to verify");
+        ESP_INT_EVENT_TRACKER_CAPTURE(tls->error_handle, ESP_TLS_ERR_TYPE_ESP, ESP_ERR_MBEDTLS_SSL_HANDSHAKE_FAILED);
+        return ESP_FAIL;
+    }
+    if (esp_mbedtls_chain_fp_lookup(fingerprint)) {
+        ESP_LOGD(TAG, "Peer chain matches a previously verified fingerprint");
+        return ESP_OK;
+    }
+    uint32_t flags = 0;
+    int ret = mbedtls_x509_crt_verify((mbedtls_x509_crt *)peer, tls->cacert_ptr, NULL,
+                                      tls->ssl.hostname, &flags, NULL, NULL);
+    if (ret != 0 || flags != 0) {
+        char buf[100];
+        ESP_LOGE(TAG, "Failed to verify peer certificate! (-0x%x)", -ret);
+        ESP_INT_EVENT_TRACKER_CAPTURE(tls->error_handle, ESP_TLS_ERR_TYPE_MBEDTLS_CERT_FLAGS, flags);
+        bzero(buf, sizeof(buf));
+        mbedtls_x509_crt_verify_info(buf, sizeof(buf), "  ! ", flags);
+        ESP_LOGE(TAG, "verification info: %s", buf);
+        return ESP_FAIL;
+    }
+    esp_mbedtls_chain_fp_store(fingerprint);
+    ESP_LOGD(TAG, "Peer chain fully verified, fingerprint cached");
+    return ESP_OK;
+}
+#endif /* CONFIG_ESP_TLS_VERIFIED_CHAIN_CACHE */
+
 esp_err_t esp_create_mbedtls_handle(const char *hostname, size_t hostlen, const void *cfg, esp_tls_t *tls)
 {
     assert(cfg != NULL);
@@ -119,6 +486,12 @@ esp_err_t esp_create_mbedtls_handle(const char *hostname, size_t hostlen, const
     }
     mbedtls_ssl_set_bio(&tls->ssl, &tls->server_fd, mbedtls_net_send, mbedtls_net_recv, NULL);
 
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+    if (tls->role == ESP_TLS_CLIENT && ((const esp_tls_cfg_t *)cfg)->use_session_cache) {
+        esp_mbedtls_session_apply(tls);
+    }
+#endif
+
     return ESP_OK;
 
 exit:
@@ -132,7 +505,19 @@ int esp_mbedtls_handshake(esp_tls_t *tls, const esp_tls_cfg_t *cfg)
     int ret;
     ret = mbedtls_ssl_handshake(&tls->ssl);
     if (ret == 0) {
+#ifdef CONFIG_ESP_TLS_VERIFIED_CHAIN_CACHE
+        if (tls->deferred_verify && esp_mbedtls_verify_deferred(tls) != ESP_OK) {
+            ESP_INT_EVENT_TRACKER_CAPTURE(tls->error_handle, ESP_TLS_ERR_TYPE_ESP, ESP_ERR_MBEDTLS_SSL_HANDSHAKE_FAILED);
+            tls->conn_state = ESP_TLS_FAIL;
+            return -1;
+        }
+#endif
         tls->conn_state = ESP_TLS_DONE;
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+        if (tls->role == ESP_TLS_CLIENT && cfg->use_session_cache) {
+            esp_mbedtls_session_store(tls);
+        }
+#endif
 #ifdef CONFIG_ESP_TLS_USE_DS_PERIPHERAL
         esp_ds_release_ds_lock();
 #endif
@@ -151,6 +536,7 @@ int esp_mbedtls_handshake(esp_tls_t *tls, const esp_tls_cfg_t *cfg)
         }
         /* Irrespective of blocking or non-blocking I/O, we return on getting ESP_TLS_ERR_SSL_WANT_READ
         or ESP_TLS_ERR_SSL_WANT_WRITE during handshake */
+        tls->poll_wants = (ret == ESP_TLS_ERR_SSL_WANT_WRITE) ? ESP_TLS_WANT_WRITE : ESP_TLS_WANT_READ;
         return 0;
     }
 }
@@ -348,6 +734,93 @@ static esp_err_t set_global_ca_store(esp_tls_t *tls)
 
 
 #ifdef CONFIG_ESP_TLS_SERVER
+#ifdef CONFIG_ESP_TLS_SERVER_SESSION_CACHE
+/* One session cache shared by all server instances. The mbedtls cache has no
+ * internal locking, and with handshake offloading several handshakes may run
+ * on different tasks at the same time, so every access goes through wrappers
+ * that take the lock. */
+static mbedtls_ssl_cache_context s_server_session_cache;
+static bool s_server_session_cache_active;
+static _lock_t s_server_session_cache_lock;
+
+static int esp_mbedtls_server_cache_get(void *data, mbedtls_ssl_session *session)
+{
+    _lock_acquire(&s_server_session_cache_lock);
+    int ret = mbedtls_ssl_cache_get(&s_server_session_cache, session);
+    _lock_release(&s_server_session_cache_lock);
+    return ret;
+}
+
+static int esp_mbedtls_server_cache_set(void *data, const mbedtls_ssl_session *session)
+{
+    _lock_acquire(&s_server_session_cache_lock);
+    int ret = mbedtls_ssl_cache_set(&s_server_session_cache, session);
+    _lock_release(&s_server_session_cache_lock);
+    return ret;
+}
+#endif /* CONFIG_ESP_TLS_SERVER_SESSION_CACHE */
+
+#ifdef CONFIG_ESP_TLS_SERVER_SESSION_TICKETS
+/* Serializes ticket writing/parsing (and the key rotation happening inside)
+ * for handshakes that run concurrently on one ticket context */
+static _lock_t s_server_ticket_lock;
+
+static int esp_mbedtls_server_ticket_write(void *p_ticket, const mbedtls_ssl_session *session,
+                                           unsigned char *start, const unsigned char *end,
+                                           size_t *tlen, uint32_t *lifetime)
+{
+    _lock_acquire(&s_server_ticket_lock);
+    int ret = mbedtls_ssl_ticket_write(p_ticket, session, start, end, tlen, lifetime);
+    _lock_release(&s_server_ticket_lock);
+    return ret;
+}
+
+static int esp_mbedtls_server_ticket_parse(void *p_ticket, mbedtls_ssl_session *session,
+                                           unsigned char *buf, size_t len)
+{
+    _lock_acquire(&s_server_ticket_lock);
+    int ret = mbedtls_ssl_ticket_parse(p_ticket, session, buf, len);
+    _lock_release(&s_server_ticket_lock);
+    return ret;
+}
+
+esp_err_t esp_mbedtls_server_session_ticket_ctx_init(esp_tls_server_session_ticket_ctx_t *ctx)
+{
+    if (ctx == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    mbedtls_ssl_ticket_init(&ctx->ticket_ctx);
+    mbedtls_entropy_init(&ctx->entropy);
+    mbedtls_ctr_drbg_init(&ctx->ctr_drbg);
+
+    int ret = mbedtls_ctr_drbg_seed(&ctx->ctr_drbg, mbedtls_entropy_func, &ctx->entropy, NULL, 0);
+    if (ret != 0) {
+        ESP_LOGE(TAG, "mbedtls_ctr_drbg_seed returned -0x%x", -ret);
+        esp_mbedtls_server_session_ticket_ctx_free(ctx);
+        return ESP_ERR_MBEDTLS_CTR_DRBG_SEED_FAILED;
+    }
+
+    ret = mbedtls_ssl_ticket_setup(&ctx->ticket_ctx, mbedtls_ctr_drbg_random, &ctx->ctr_drbg,
+                                   MBEDTLS_CIPHER_AES_256_GCM,
+                                   CONFIG_ESP_TLS_SERVER_SESSION_TICKET_TIMEOUT);
+    if (ret != 0) {
+        ESP_LOGE(TAG, "mbedtls_ssl_ticket_setup returned -0x%x", -ret);
+        esp_mbedtls_server_session_ticket_ctx_free(ctx);
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+void esp_mbedtls_server_session_ticket_ctx_free(esp_tls_server_session_ticket_ctx_t *ctx)
+{
+    if (ctx != NULL) {
+        mbedtls_ssl_ticket_free(&ctx->ticket_ctx);
+        mbedtls_ctr_drbg_free(&ctx->ctr_drbg);
+        mbedtls_entropy_free(&ctx->entropy);
+    }
+}
+#endif /* CONFIG_ESP_TLS_SERVER_SESSION_TICKETS */
+
 esp_err_t set_server_config(esp_tls_cfg_server_t *cfg, esp_tls_t *tls)
 {
     assert(cfg != NULL);
@@ -369,6 +842,29 @@ esp_err_t set_server_config(esp_tls_cfg_server_t *cfg, esp_tls_t *tls)
     }
 #endif
 
+#ifdef CONFIG_ESP_TLS_SERVER_SESSION_CACHE
+    _lock_acquire(&s_server_session_cache_lock);
+    if (!s_server_session_cache_active) {
+        mbedtls_ssl_cache_init(&s_server_session_cache);
+        mbedtls_ssl_cache_set_max_entries(&s_server_session_cache,
+                                          CONFIG_ESP_TLS_SERVER_SESSION_CACHE_SIZE);
+        s_server_session_cache_active = true;
+    }
+    _lock_release(&s_server_session_cache_lock);
+    mbedtls_ssl_conf_session_cache(&tls->conf, NULL,
+                                   esp_mbedtls_server_cache_get,
+                                   esp_mbedtls_server_cache_set);
+#endif
+
+#ifdef CONFIG_ESP_TLS_SERVER_SESSION_TICKETS
+    if (cfg->ticket_ctx) {
+        mbedtls_ssl_conf_session_tickets_cb(&tls->conf,
+                                            esp_mbedtls_server_ticket_write,
+                                            esp_mbedtls_server_ticket_parse,
+                                            &cfg->ticket_ctx->ticket_ctx);
+    }
+#endif
+
     if (cfg->cacert_buf != NULL) {
         esp_ret = set_ca_cert(tls, cfg->cacert_buf, cfg->cacert_bytes);
         if (esp_ret != ESP_OK) {
@@ -494,6 +990,15 @@ esp_err_t set_client_config(const char *hostname, size_t hostlen, esp_tls_cfg_t
         mbedtls_ssl_conf_authmode(&tls->conf, MBEDTLS_SSL_VERIFY_NONE);
     }
 
+#ifdef CONFIG_ESP_TLS_VERIFIED_CHAIN_CACHE
+    if (cfg->use_verified_chain_cache && tls->cacert_ptr != NULL) {
+        /* Verification moves to after the handshake (esp_mbedtls_verify_deferred),
+         * where a chain matching a cached fingerprint skips the signature math */
+        mbedtls_ssl_conf_authmode(&tls->conf, MBEDTLS_SSL_VERIFY_NONE);
+        tls->deferred_verify = true;
+    }
+#endif
+
     if (cfg->use_secure_element) {
 #ifdef CONFIG_ESP_TLS_USE_SECURE_ELEMENT
         ret = esp_set_atecc608a_pki_context(tls, (esp_tls_cfg_t *)cfg);
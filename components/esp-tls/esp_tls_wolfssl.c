@@ -340,6 +340,7 @@ int esp_wolfssl_handshake(esp_tls_t *tls, const esp_tls_cfg_t *cfg)
         }
         /* Irrespective of blocking or non-blocking I/O, we return on getting wolfSSL_want_read
         or wolfSSL_want_write during handshake */
+        tls->poll_wants = (err == ESP_TLS_ERR_SSL_WANT_WRITE) ? ESP_TLS_WANT_WRITE : ESP_TLS_WANT_READ;
         return 0;
     }
 }
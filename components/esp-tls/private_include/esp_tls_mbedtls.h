@@ -76,6 +76,18 @@ int esp_mbedtls_server_session_create(esp_tls_cfg_server_t *cfg, int sockfd, esp
  * /note :- The function can only be used with mbedtls ssl library
  */
 void esp_mbedtls_server_session_delete(esp_tls_t *tls);
+
+#ifdef CONFIG_ESP_TLS_SERVER_SESSION_TICKETS
+/**
+ * Internal Callback for esp_tls_cfg_server_session_tickets_init
+ */
+esp_err_t esp_mbedtls_server_session_ticket_ctx_init(esp_tls_server_session_ticket_ctx_t *ctx);
+
+/**
+ * Internal Callback for esp_tls_cfg_server_session_tickets_free
+ */
+void esp_mbedtls_server_session_ticket_ctx_free(esp_tls_server_session_ticket_ctx_t *ctx);
+#endif
 #endif
 
 /**
@@ -102,3 +114,29 @@ mbedtls_x509_crt *esp_mbedtls_get_global_ca_store(void);
  * Callback function for freeing global ca store for TLS/SSL using mbedtls
  */
 void esp_mbedtls_free_global_ca_store(void);
+
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+/**
+ * Callback function for freeing all cached client TLS sessions
+ */
+void esp_mbedtls_free_client_session_cache(void);
+
+/**
+ * Callback function for flattening a cached client TLS session into a
+ * retention buffer (see esp_tls_client_session_retain())
+ */
+esp_err_t esp_mbedtls_client_session_retain(const char *hostname, void *buf, size_t buf_len, size_t *out_len);
+
+/**
+ * Callback function for putting a retained client TLS session back into
+ * the cache (see esp_tls_client_session_reinstate())
+ */
+esp_err_t esp_mbedtls_client_session_reinstate(const void *buf, size_t buf_len);
+#endif
+
+#ifdef CONFIG_ESP_TLS_VERIFIED_CHAIN_CACHE
+/**
+ * Callback function for freeing all cached verified chain fingerprints
+ */
+void esp_mbedtls_free_verified_chain_cache(void);
+#endif
@@ -67,6 +67,36 @@ TEST_CASE("Test esp_sha()", "[hw_crypto]")
     TEST_PERFORMANCE_LESS_THAN(TIME_SHA512_32KB, "%dus", us_sha512);
 }
 
+TEST_CASE("Test esp_sha_iov() matches esp_sha() on fragmented input", "[hw_crypto]")
+{
+    const size_t BUFFER_SZ = 16 * 1024 + 10; // NB: not an exact multiple of SHA block size
+    uint8_t sha256_contig[32] = { 0 };
+    uint8_t sha256_iov[32] = { 0 };
+    uint8_t *buffer = heap_caps_malloc(BUFFER_SZ, MALLOC_CAP_8BIT|MALLOC_CAP_INTERNAL);
+    TEST_ASSERT_NOT_NULL(buffer);
+    for (size_t i = 0; i < BUFFER_SZ; i++) {
+        buffer[i] = i & 0xFF;
+    }
+
+    /* uneven fragment sizes, so fragment boundaries don't line up
+       with SHA block boundaries */
+    esp_sha_iovec_t iov[] = {
+        { .base = buffer,        .len = 3 },
+        { .base = buffer + 3,    .len = 4096 },
+        { .base = buffer + 4099, .len = 0 },
+        { .base = buffer + 4099, .len = 61 },
+        { .base = buffer + 4160, .len = BUFFER_SZ - 4160 },
+    };
+
+    esp_sha(SHA2_256, buffer, BUFFER_SZ, sha256_contig);
+    esp_sha_iov(SHA2_256, iov, sizeof(iov) / sizeof(iov[0]), sha256_iov);
+
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(sha256_contig, sha256_iov, sizeof(sha256_contig),
+                                     "esp_sha_iov() result should match esp_sha()");
+
+    free(buffer);
+}
+
 TEST_CASE("Test esp_sha() function with long input", "[hw_crypto]")
 {
     const void* ptr;
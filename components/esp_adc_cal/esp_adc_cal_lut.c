@@ -0,0 +1,108 @@
+// Copyright 2021 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "esp_err.h"
+#include "esp_adc_cal.h"
+
+/* Batch raw-to-voltage conversion, common to all chips.
+ *
+ * The full characterization curve (linear plus the non-linear correction
+ * region, where present) is evaluated once per table node at lookup table
+ * creation time via esp_adc_cal_raw_to_voltage(). The per-sample work in the
+ * batch functions is then a single table lookup and a linear interpolation,
+ * independent of how expensive the underlying curve is.
+ */
+
+esp_err_t esp_adc_cal_lut_create(const esp_adc_cal_characteristics_t *chars, uint32_t step_shift, esp_adc_cal_lut_t *lut)
+{
+    if (chars == NULL || lut == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (step_shift < 1 || step_shift > (uint32_t)(9 + chars->bit_width)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    const uint32_t max_raw = (1 << (9 + chars->bit_width)) - 1;
+    //One node per step, plus one node past max_raw so that interpolation
+    //of the last step has an upper bound point
+    const uint32_t num_points = (max_raw >> step_shift) + 2;
+
+    uint16_t *points = malloc(num_points * sizeof(uint16_t));
+    if (points == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    for (uint32_t i = 0; i < num_points; i++) {
+        uint32_t node_raw = i << step_shift;
+        if (node_raw > max_raw) {
+            node_raw = max_raw;
+        }
+        points[i] = (uint16_t)esp_adc_cal_raw_to_voltage(node_raw, chars);
+    }
+    lut->points = points;
+    lut->num_points = num_points;
+    lut->step_shift = step_shift;
+    lut->max_raw = max_raw;
+    return ESP_OK;
+}
+
+void esp_adc_cal_lut_destroy(esp_adc_cal_lut_t *lut)
+{
+    if (lut != NULL) {
+        free(lut->points);
+        lut->points = NULL;
+        lut->num_points = 0;
+    }
+}
+
+void esp_adc_cal_raw_to_voltage_batch(const esp_adc_cal_lut_t *lut, const uint16_t *raw, uint16_t *voltages, size_t count)
+{
+    const uint16_t *points = lut->points;
+    const uint32_t shift = lut->step_shift;
+    const uint32_t frac_mask = (1 << shift) - 1;
+    const uint32_t max_raw = lut->max_raw;
+
+    for (size_t i = 0; i < count; i++) {
+        uint32_t r = raw[i];
+        if (r > max_raw) {
+            r = max_raw;
+        }
+        uint32_t idx = r >> shift;
+        uint32_t frac = r & frac_mask;
+        int32_t v1 = points[idx];
+        int32_t v2 = points[idx + 1];
+        //Linear interpolation between the two nodes, with rounding
+        voltages[i] = (uint16_t)(v1 + (((v2 - v1) * (int32_t)frac + (int32_t)(1 << (shift - 1))) >> shift));
+    }
+}
+
+void esp_adc_cal_raw_to_voltage_batch_fp(const esp_adc_cal_lut_t *lut, const uint16_t *raw, uint16_t *voltages, size_t count)
+{
+    const uint16_t *points = lut->points;
+    const uint32_t shift = lut->step_shift;
+    const uint32_t frac_mask = (1 << shift) - 1;
+    const uint32_t max_raw = lut->max_raw;
+
+    for (size_t i = 0; i < count; i++) {
+        uint32_t r = raw[i];
+        if (r > max_raw) {
+            r = max_raw;
+        }
+        uint32_t idx = r >> shift;
+        uint32_t frac = r & frac_mask;
+        int32_t v1 = points[idx] << ESP_ADC_CAL_FP_FRAC_BITS;
+        int32_t v2 = points[idx + 1] << ESP_ADC_CAL_FP_FRAC_BITS;
+        voltages[i] = (uint16_t)(v1 + (((v2 - v1) * (int32_t)frac) >> shift));
+    }
+}
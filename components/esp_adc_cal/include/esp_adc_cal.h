@@ -20,6 +20,7 @@ extern "C" {
 #endif
 
 #include <stdint.h>
+#include <stddef.h>
 #include "esp_err.h"
 #include "driver/adc.h"
 
@@ -131,6 +132,83 @@ uint32_t esp_adc_cal_raw_to_voltage(uint32_t adc_reading, const esp_adc_cal_char
  */
 esp_err_t esp_adc_cal_get_voltage(adc_channel_t channel, const esp_adc_cal_characteristics_t *chars, uint32_t *voltage);
 
+/**
+ * @brief Number of fractional bits in fixed-point batch conversion output
+ */
+#define ESP_ADC_CAL_FP_FRAC_BITS    4
+
+/**
+ * @brief Precomputed raw-to-voltage lookup table for batch conversion
+ *
+ * @note Call esp_adc_cal_lut_create() to initialize the structure
+ */
+typedef struct {
+    uint16_t *points;                       /**< Node voltages in mV, one per raw code step*/
+    uint32_t num_points;                    /**< Number of nodes in the table*/
+    uint32_t step_shift;                    /**< log2 of raw codes per table step*/
+    uint32_t max_raw;                       /**< Maximum valid raw reading, larger inputs are clamped*/
+} esp_adc_cal_lut_t;
+
+/**
+ * @brief Precompute a raw-to-voltage lookup table from ADC characteristics
+ *
+ * Evaluates the full characterization curve (including the non-linear LUT
+ * region, if used) once at characterization time, at every (1 << step_shift)
+ * raw codes, so that batch conversion only needs a table lookup and a linear
+ * interpolation per sample. A step_shift of 5 (32 raw codes per step, 260
+ * bytes of table for 12-bit readings) keeps the interpolation error below
+ * the ADC noise floor.
+ *
+ * @note The characteristics structure must remain valid only for the duration
+ *       of this call; the table itself has no further dependency on it.
+ *
+ * @param[in]   chars       Pointer to initialized ADC characteristics structure
+ * @param[in]   step_shift  log2 of raw codes per table step (1 to bit width)
+ * @param[out]  lut         Pointer to empty lookup table structure
+ *
+ * @return
+ *      - ESP_OK: Lookup table created
+ *      - ESP_ERR_INVALID_ARG: Error due to invalid arguments
+ *      - ESP_ERR_NO_MEM: Error, not enough memory for the table
+ */
+esp_err_t esp_adc_cal_lut_create(const esp_adc_cal_characteristics_t *chars, uint32_t step_shift, esp_adc_cal_lut_t *lut);
+
+/**
+ * @brief Free the table memory held by a lookup table structure
+ *
+ * @param[in]   lut     Lookup table initialized by esp_adc_cal_lut_create()
+ */
+void esp_adc_cal_lut_destroy(esp_adc_cal_lut_t *lut);
+
+/**
+ * @brief Convert a block of ADC readings to voltages in mV
+ *
+ * Converts count raw readings using the precomputed lookup table with linear
+ * interpolation between table nodes. Intended for bulk conversion of sample
+ * windows where calling esp_adc_cal_raw_to_voltage() per sample would
+ * dominate the processing time.
+ *
+ * @param[in]   lut         Lookup table initialized by esp_adc_cal_lut_create()
+ * @param[in]   raw         Block of raw ADC readings
+ * @param[out]  voltages    Block to store converted voltages in mV (may alias raw)
+ * @param[in]   count       Number of readings to convert
+ */
+void esp_adc_cal_raw_to_voltage_batch(const esp_adc_cal_lut_t *lut, const uint16_t *raw, uint16_t *voltages, size_t count);
+
+/**
+ * @brief Convert a block of ADC readings to fixed-point voltages
+ *
+ * Same as esp_adc_cal_raw_to_voltage_batch(), but the output is in unsigned
+ * fixed-point millivolts with ESP_ADC_CAL_FP_FRAC_BITS fractional bits,
+ * preserving the sub-mV resolution produced by the interpolation step.
+ *
+ * @param[in]   lut         Lookup table initialized by esp_adc_cal_lut_create()
+ * @param[in]   raw         Block of raw ADC readings
+ * @param[out]  voltages    Block to store voltages in mV * 2^ESP_ADC_CAL_FP_FRAC_BITS (may alias raw)
+ * @param[in]   count       Number of readings to convert
+ */
+void esp_adc_cal_raw_to_voltage_batch_fp(const esp_adc_cal_lut_t *lut, const uint16_t *raw, uint16_t *voltages, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
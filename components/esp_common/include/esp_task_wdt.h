@@ -141,6 +141,78 @@ esp_err_t esp_task_wdt_delete(TaskHandle_t handle);
   */
 esp_err_t esp_task_wdt_status(TaskHandle_t handle);
 
+//Number of buckets in the feed interval histogram of esp_task_wdt_stats_t
+#define ESP_TASK_WDT_STATS_BUCKETS      16
+
+/**
+  * @brief   Feed interval statistics of a task subscribed to the TWDT
+  *
+  * The histogram buckets feed intervals by power of two milliseconds: bucket i
+  * counts intervals of [2^i, 2^(i+1)) ms, with bucket 0 also covering
+  * sub-millisecond intervals and the last bucket covering everything longer.
+  */
+typedef struct {
+    uint32_t feeds;                 /*!< Number of times the task has reset the TWDT */
+    uint32_t overruns;              /*!< Number of TWDT timeouts the task failed to reset in */
+    uint64_t last_interval_us;      /*!< Most recent feed interval, in microseconds */
+    uint64_t max_interval_us;       /*!< Longest feed interval observed, in microseconds */
+    uint32_t histogram[ESP_TASK_WDT_STATS_BUCKETS];     /*!< Feed interval histogram */
+} esp_task_wdt_stats_t;
+
+/**
+  * @brief   Get the feed interval statistics of a subscribed task
+  *
+  * This function returns a snapshot of the feed interval statistics collected
+  * for a subscribed task since it subscribed (or since its statistics were last
+  * cleared). The statistics show how close a task runs to the TWDT timeout and
+  * can be used to pick timeout values from measured worst cases rather than
+  * guesswork.
+  *
+  * @param[in]   handle  Handle of the task. Input NULL to query the current
+  *                      running task.
+  * @param[out]  stats   Filled with the task's feed interval statistics
+  *
+  * @return
+  *     - ESP_OK: Successfully copied the task's statistics
+  *     - ESP_ERR_INVALID_ARG: Error, stats is NULL
+  *     - ESP_ERR_NOT_FOUND: Error, the task is not subscribed to the TWDT
+  *     - ESP_ERR_INVALID_STATE: Error, the TWDT has not been initialized yet
+  */
+esp_err_t esp_task_wdt_get_stats(TaskHandle_t handle, esp_task_wdt_stats_t *stats);
+
+/**
+  * @brief   Clear the feed interval statistics of a subscribed task
+  *
+  * @param[in]  handle  Handle of the task. Input NULL to clear the statistics
+  *                     of the current running task.
+  *
+  * @return
+  *     - ESP_OK: Successfully cleared the task's statistics
+  *     - ESP_ERR_NOT_FOUND: Error, the task is not subscribed to the TWDT
+  *     - ESP_ERR_INVALID_STATE: Error, the TWDT has not been initialized yet
+  */
+esp_err_t esp_task_wdt_clear_stats(TaskHandle_t handle);
+
+/**
+  * @brief   Enable or disable passive (profiling) mode of the TWDT
+  *
+  * In passive mode a TWDT timeout neither panics nor prints backtraces.
+  * Instead, each task that failed to reset in time has its overrun count
+  * incremented and its worst case feed interval updated, and a single warning
+  * line is printed per offending task. This allows running a build with a
+  * tight timeout in the field to measure real worst case feed intervals
+  * without resetting the device. Passive mode is disabled by default and is
+  * reset to disabled by esp_task_wdt_init().
+  *
+  * @param[in]  passive  true to record timeouts passively, false to restore
+  *                      normal timeout behavior
+  *
+  * @return
+  *     - ESP_OK: Successfully updated the TWDT mode
+  *     - ESP_ERR_INVALID_STATE: Error, the TWDT has not been initialized yet
+  */
+esp_err_t esp_task_wdt_set_passive(bool passive);
+
 
 #ifdef __cplusplus
 }
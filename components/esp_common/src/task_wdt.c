@@ -33,6 +33,7 @@
 #include "driver/timer.h"
 #include "driver/periph_ctrl.h"
 #include "esp_task_wdt.h"
+#include "esp_timer.h"
 #include "esp_private/system_internal.h"
 #include "esp_private/crosscore_int.h"
 #include "hal/timer_types.h"
@@ -63,6 +64,8 @@ typedef struct twdt_task_t twdt_task_t;
 struct twdt_task_t {
     TaskHandle_t task_handle;
     bool has_reset;
+    int64_t last_feed_time;         //Timestamp of the task's last reset, 0 until the first reset
+    esp_task_wdt_stats_t stats;     //Feed interval statistics of this task
     twdt_task_t *next;
 };
 
@@ -72,6 +75,7 @@ struct twdt_config_t {
     twdt_task_t *list;      //Linked list of subscribed tasks
     uint32_t timeout;       //Timeout period of TWDT
     bool panic;             //Flag to trigger panic when TWDT times out
+    bool passive;           //Flag to only record timeouts instead of panicking/backtracing
     intr_handle_t intr_handle;
 };
 
@@ -126,6 +130,30 @@ static void reset_hw_timer(void)
     }
 }
 
+/*
+ * Records one feed interval into a task's statistics. Should be called within
+ * critical. The histogram buckets intervals by power of two milliseconds.
+ */
+static void record_feed_interval(twdt_task_t *task, int64_t now)
+{
+    if (task->last_feed_time != 0) {
+        uint64_t interval = (uint64_t)(now - task->last_feed_time);
+        uint64_t interval_ms = interval / 1000;
+        int bucket = 0;
+        while (interval_ms > 1 && bucket < ESP_TASK_WDT_STATS_BUCKETS - 1) {
+            interval_ms >>= 1;
+            bucket++;
+        }
+        task->stats.histogram[bucket]++;
+        task->stats.last_interval_us = interval;
+        if (interval > task->stats.max_interval_us) {
+            task->stats.max_interval_us = interval;
+        }
+    }
+    task->stats.feeds++;
+    task->last_feed_time = now;
+}
+
 /*
  * This function is called by task_wdt_isr function (ISR for when TWDT times out).
  * It can be redefined in user code to handle twdt events.
@@ -159,6 +187,29 @@ static void task_wdt_isr(void *arg)
     //Return immediately if no tasks have been added to task list
     ASSERT_EXIT_CRIT_RETURN((twdt_config->list != NULL), VOID_RETURN);
 
+    if (twdt_config->passive) {
+        //Passive mode: record the overrun for each late task, then let the
+        //system keep running. last_feed_time is left untouched so the next
+        //actual reset still closes the full interval in the statistics.
+        int64_t now = esp_timer_get_time();
+        for (twdttask = twdt_config->list; twdttask != NULL; twdttask = twdttask->next) {
+            if (!twdttask->has_reset) {
+                uint64_t elapsed = (twdttask->last_feed_time != 0) ? (uint64_t)(now - twdttask->last_feed_time) : 0;
+                twdttask->stats.overruns++;
+                if (elapsed > twdttask->stats.max_interval_us) {
+                    twdttask->stats.max_interval_us = elapsed;
+                }
+                ESP_EARLY_LOGW(TAG, "Task %s missed the watchdog timeout (%u ms since last reset)",
+                               pcTaskGetTaskName(twdttask->task_handle), (unsigned) (elapsed / 1000));
+                //Mark the task as reset so that healthy tasks keep feeding the
+                //hardware timer; a stuck task is recorded again next timeout.
+                twdttask->has_reset = true;
+            }
+        }
+        portEXIT_CRITICAL_ISR(&twdt_spinlock);
+        return;
+    }
+
     //Watchdog got triggered because at least one task did not reset in time.
     ESP_EARLY_LOGE(TAG, "Task watchdog got triggered. The following tasks did not reset the watchdog in time:");
     for (twdttask=twdt_config->list; twdttask!=NULL; twdttask=twdttask->next) {
@@ -212,6 +263,7 @@ esp_err_t esp_task_wdt_init(uint32_t timeout, bool panic)
         twdt_config->list = NULL;
         twdt_config->timeout = timeout;
         twdt_config->panic = panic;
+        twdt_config->passive = false;
 
         //Register Interrupt and ISR
         ESP_ERROR_CHECK(esp_intr_alloc(ETS_TG0_WDT_LEVEL_INTR_SOURCE, 0, task_wdt_isr, NULL, &twdt_config->intr_handle));
@@ -231,6 +283,7 @@ esp_err_t esp_task_wdt_init(uint32_t timeout, bool panic)
         //Reconfigure task wdt
         twdt_config->panic = panic;
         twdt_config->timeout = timeout;
+        twdt_config->passive = false;
 
         //Reconfigure hardware timer
         wdt_hal_write_protect_disable(&twdt_context);
@@ -283,6 +336,7 @@ esp_err_t esp_task_wdt_add(TaskHandle_t handle)
     ASSERT_EXIT_CRIT_RETURN((target_task != NULL), ESP_ERR_NO_MEM);
     target_task->task_handle = handle;
     target_task->has_reset = true;
+    target_task->last_feed_time = esp_timer_get_time();     //First feed interval is measured from subscription
     target_task->next = NULL;
     if (twdt_config->list == NULL) {    //Adding to empty list
         twdt_config->list = target_task;
@@ -326,6 +380,7 @@ esp_err_t esp_task_wdt_reset(void)
     ASSERT_EXIT_CRIT_RETURN((target_task != NULL), ESP_ERR_NOT_FOUND);
 
     target_task->has_reset = true;    //Reset the task if it's on the task list
+    record_feed_interval(target_task, esp_timer_get_time());
     if(all_reset){     //Reset if all other tasks in list have reset in
         reset_hw_timer();
     }
@@ -397,3 +452,59 @@ esp_err_t esp_task_wdt_status(TaskHandle_t handle)
     portEXIT_CRITICAL(&twdt_spinlock);
     return ESP_ERR_NOT_FOUND;
 }
+
+esp_err_t esp_task_wdt_get_stats(TaskHandle_t handle, esp_task_wdt_stats_t *stats)
+{
+    if(stats == NULL){
+        return ESP_ERR_INVALID_ARG;
+    }
+    if(handle == NULL){
+        handle = xTaskGetCurrentTaskHandle();
+    }
+
+    portENTER_CRITICAL(&twdt_spinlock);
+    //Return if TWDT is not initialized
+    ASSERT_EXIT_CRIT_RETURN((twdt_config != NULL), ESP_ERR_INVALID_STATE);
+
+    twdt_task_t *target_task;
+    bool all_reset;
+    target_task = find_task_in_twdt_list(handle, &all_reset);
+    //Return error if the task is not on the task list
+    ASSERT_EXIT_CRIT_RETURN((target_task != NULL), ESP_ERR_NOT_FOUND);
+
+    memcpy(stats, &target_task->stats, sizeof(esp_task_wdt_stats_t));
+    portEXIT_CRITICAL(&twdt_spinlock);
+    return ESP_OK;
+}
+
+esp_err_t esp_task_wdt_clear_stats(TaskHandle_t handle)
+{
+    if(handle == NULL){
+        handle = xTaskGetCurrentTaskHandle();
+    }
+
+    portENTER_CRITICAL(&twdt_spinlock);
+    //Return if TWDT is not initialized
+    ASSERT_EXIT_CRIT_RETURN((twdt_config != NULL), ESP_ERR_INVALID_STATE);
+
+    twdt_task_t *target_task;
+    bool all_reset;
+    target_task = find_task_in_twdt_list(handle, &all_reset);
+    //Return error if the task is not on the task list
+    ASSERT_EXIT_CRIT_RETURN((target_task != NULL), ESP_ERR_NOT_FOUND);
+
+    memset(&target_task->stats, 0, sizeof(esp_task_wdt_stats_t));
+    portEXIT_CRITICAL(&twdt_spinlock);
+    return ESP_OK;
+}
+
+esp_err_t esp_task_wdt_set_passive(bool passive)
+{
+    portENTER_CRITICAL(&twdt_spinlock);
+    //Return if TWDT is not initialized
+    ASSERT_EXIT_CRIT_RETURN((twdt_config != NULL), ESP_ERR_INVALID_STATE);
+
+    twdt_config->passive = passive;
+    portEXIT_CRITICAL(&twdt_spinlock);
+    return ESP_OK;
+}
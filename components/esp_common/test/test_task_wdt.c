@@ -0,0 +1,62 @@
+#include <string.h>
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_task_wdt.h"
+
+TEST_CASE("Task watchdog feed interval statistics", "[task_wdt]")
+{
+    const int delay_ms = 20;
+    const int feeds = 5;
+    esp_task_wdt_stats_t stats;
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_init(10, false));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_add(NULL));
+
+    for (int i = 0; i < feeds; i++) {
+        vTaskDelay(delay_ms / portTICK_PERIOD_MS);
+        TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_reset());
+    }
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_get_stats(NULL, &stats));
+    TEST_ASSERT_EQUAL(feeds, stats.feeds);
+    TEST_ASSERT_EQUAL(0, stats.overruns);
+    TEST_ASSERT_GREATER_OR_EQUAL(delay_ms * 1000, stats.max_interval_us);
+    TEST_ASSERT_GREATER_OR_EQUAL(stats.last_interval_us, stats.max_interval_us);
+
+    //All feed intervals must be accounted for in the histogram
+    uint32_t total = 0;
+    for (int i = 0; i < ESP_TASK_WDT_STATS_BUCKETS; i++) {
+        total += stats.histogram[i];
+    }
+    TEST_ASSERT_EQUAL(feeds, total);
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_clear_stats(NULL));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_get_stats(NULL, &stats));
+    TEST_ASSERT_EQUAL(0, stats.feeds);
+    TEST_ASSERT_EQUAL(0, stats.max_interval_us);
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_delete(NULL));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_deinit());
+}
+
+TEST_CASE("Task watchdog passive mode records overruns without aborting", "[task_wdt]")
+{
+    esp_task_wdt_stats_t stats;
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_init(1, true));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_set_passive(true));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_add(NULL));
+
+    //Sleep past the timeout; in passive mode this must not panic even though
+    //the TWDT was initialized with panic enabled
+    vTaskDelay(1500 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_reset());
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_get_stats(NULL, &stats));
+    TEST_ASSERT_GREATER_OR_EQUAL(1, stats.overruns);
+    TEST_ASSERT_GREATER_OR_EQUAL(1000000, stats.max_interval_us);
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_delete(NULL));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_deinit());
+}
@@ -194,6 +194,26 @@ esp_err_t esp_eth_update_input_path(
 */
 esp_err_t esp_eth_transmit(esp_eth_handle_t hdl, void *buf, size_t length);
 
+/**
+* @brief Transmit one frame scattered over multiple buffers (software gather)
+*
+* The buffers are spliced into a single frame at the MAC DMA layer in one pass,
+* so the network stack doesn't have to coalesce chained buffers into a
+* contiguous copy before handing the frame over.
+*
+* @param[in] hdl: handle of Ethernet driver
+* @param[in] buffers: array of buffers the frame is constructed from
+* @param[in] lengths: array of lengths of the buffers
+* @param[in] count: number of buffers in the arrays
+*
+* @return
+*       - ESP_OK: transmit frame successfully
+*       - ESP_ERR_INVALID_ARG: transmit frame failed because of some invalid argument
+*       - ESP_ERR_NOT_SUPPORTED: the MAC has no scatter-gather support, use esp_eth_transmit()
+*       - ESP_FAIL: transmit frame failed because some other error occurred
+*/
+esp_err_t esp_eth_transmit_multi(esp_eth_handle_t hdl, void **buffers, size_t *lengths, size_t count);
+
 /**
 * @brief General Receive
 *
@@ -93,6 +93,7 @@ typedef enum {
     ETH_CMD_G_SPEED,       /*!< Get Speed */
     ETH_CMD_S_PROMISCUOUS, /*!< Set promiscuous mode */
     ETH_CMD_S_FLOW_CTRL,   /*!< Set flow control */
+    ETH_CMD_G_RX_STATS,    /*!< Get receive path statistics */
 } esp_eth_io_cmd_t;
 
 /**
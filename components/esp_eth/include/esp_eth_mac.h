@@ -27,6 +27,18 @@ extern "C" {
 */
 typedef struct esp_eth_mac_s esp_eth_mac_t;
 
+/**
+* @brief Ethernet MAC receive path statistics
+*
+*/
+typedef struct {
+    uint32_t rx_wakeups;        /*!< Number of receive task wakeups */
+    uint32_t rx_frames;         /*!< Number of frames passed to the stack */
+    uint32_t rx_batch_max;      /*!< Largest number of frames harvested in one wakeup */
+    uint32_t rx_ring_min_free;  /*!< Minimum number of free RX descriptors observed */
+    uint32_t rx_alloc_failures; /*!< Number of frames delayed or lost for lack of buffer memory */
+} eth_mac_rx_stats_t;
+
 /**
 * @brief Ethernet MAC
 *
@@ -110,6 +122,27 @@ struct esp_eth_mac_s {
     */
     esp_err_t (*transmit)(esp_eth_mac_t *mac, uint8_t *buf, uint32_t length);
 
+    /**
+    * @brief Transmit packet from Ethernet MAC constructed with special parameters at Layer2 (scatter-gather)
+    *
+    * @param[in] mac: Ethernet MAC instance
+    * @param[in] buffers: array of buffers the packet is constructed from
+    * @param[in] lengths: array of lengths of the buffers
+    * @param[in] count: number of buffers in the arrays
+    *
+    * @note The buffers are spliced into one frame at the DMA layer in a single pass.
+    *       Optional interface function, can be left NULL when the MAC has no
+    *       scatter-gather support.
+    *
+    * @return
+    *      - ESP_OK: transmit packet successfully
+    *      - ESP_ERR_INVALID_ARG: transmit packet failed because of invalid argument
+    *      - ESP_ERR_INVALID_STATE: transmit packet failed because of wrong state of MAC
+    *      - ESP_FAIL: transmit packet failed because some other error occurred
+    *
+    */
+    esp_err_t (*transmit_multi)(esp_eth_mac_t *mac, void **buffers, size_t *lengths, size_t count);
+
     /**
     * @brief Receive packet from Ethernet MAC
     *
@@ -131,6 +164,21 @@ struct esp_eth_mac_s {
     */
     esp_err_t (*receive)(esp_eth_mac_t *mac, uint8_t *buf, uint32_t *length);
 
+    /**
+    * @brief Get receive path statistics
+    *
+    * @param[in] mac: Ethernet MAC instance
+    * @param[out] stats: receive path statistics
+    *
+    * @note Optional interface, can be left NULL when the MAC doesn't keep receive statistics.
+    *
+    * @return
+    *      - ESP_OK: get receive statistics successfully
+    *      - ESP_ERR_INVALID_ARG: get receive statistics failed because of invalid argument
+    *
+    */
+    esp_err_t (*get_rx_stats)(esp_eth_mac_t *mac, eth_mac_rx_stats_t *stats);
+
     /**
     * @brief Read PHY register
     *
@@ -331,6 +331,23 @@ err:
     return ret;
 }
 
+esp_err_t esp_eth_transmit_multi(esp_eth_handle_t hdl, void **buffers, size_t *lengths, size_t count)
+{
+    esp_err_t ret = ESP_OK;
+    esp_eth_driver_t *eth_driver = (esp_eth_driver_t *)hdl;
+    ETH_CHECK(buffers && lengths, "can't set buffers and lengths to null", err, ESP_ERR_INVALID_ARG);
+    ETH_CHECK(count, "buffer count can't be zero", err, ESP_ERR_INVALID_ARG);
+    ETH_CHECK(eth_driver, "ethernet driver handle can't be null", err, ESP_ERR_INVALID_ARG);
+    esp_eth_mac_t *mac = eth_driver->mac;
+    /* no error log for MACs without scatter-gather support, the caller falls back to esp_eth_transmit() */
+    if (!mac->transmit_multi) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    return mac->transmit_multi(mac, buffers, lengths, count);
+err:
+    return ret;
+}
+
 esp_err_t esp_eth_receive(esp_eth_handle_t hdl, uint8_t *buf, uint32_t *length)
 {
     esp_err_t ret = ESP_OK;
@@ -379,6 +396,11 @@ esp_err_t esp_eth_ioctl(esp_eth_handle_t hdl, esp_eth_io_cmd_t cmd, void *data)
         ETH_CHECK(mac->enable_flow_ctrl(mac, (bool)data) == ESP_OK, "enable mac flow control failed", err, ESP_FAIL);
         ETH_CHECK(phy->advertise_pause_ability(phy, (uint32_t)data) == ESP_OK, "phy advertise pause ability failed", err, ESP_FAIL);
         break;
+    case ETH_CMD_G_RX_STATS:
+        ETH_CHECK(data, "no mem to store rx statistics", err, ESP_ERR_INVALID_ARG);
+        ETH_CHECK(mac->get_rx_stats, "rx statistics not supported by this MAC", err, ESP_ERR_NOT_SUPPORTED);
+        ETH_CHECK(mac->get_rx_stats(mac, (eth_mac_rx_stats_t *)data) == ESP_OK, "get rx statistics failed", err, ESP_FAIL);
+        break;
     default:
         ETH_CHECK(false, "unknown io command: %d", err, ESP_ERR_INVALID_ARG, cmd);
         break;
@@ -61,6 +61,7 @@ typedef struct {
     uint32_t free_rx_descriptor;
     uint32_t flow_control_high_water_mark;
     uint32_t flow_control_low_water_mark;
+    eth_mac_rx_stats_t rx_stats;
     int smi_mdc_gpio_num;
     int smi_mdio_gpio_num;
     uint8_t addr[6];
@@ -259,6 +260,21 @@ err:
     return ret;
 }
 
+static esp_err_t emac_esp32_transmit_multi(esp_eth_mac_t *mac, void **buffers, size_t *lengths, size_t count)
+{
+    esp_err_t ret = ESP_OK;
+    emac_esp32_t *emac = __containerof(mac, emac_esp32_t, parent);
+    size_t expected_len = 0;
+    for (size_t i = 0; i < count; i++) {
+        expected_len += lengths[i];
+    }
+    uint32_t sent_len = emac_hal_transmit_multiple_buf_frame(&emac->hal, buffers, lengths, count);
+    MAC_CHECK(sent_len == expected_len, "insufficient TX buffer size", err, ESP_ERR_INVALID_SIZE);
+    return ESP_OK;
+err:
+    return ret;
+}
+
 static esp_err_t emac_esp32_receive(esp_eth_mac_t *mac, uint8_t *buf, uint32_t *length)
 {
     esp_err_t ret = ESP_OK;
@@ -276,28 +292,53 @@ err:
     return ret;
 }
 
+static esp_err_t emac_esp32_get_rx_stats(esp_eth_mac_t *mac, eth_mac_rx_stats_t *stats)
+{
+    esp_err_t ret = ESP_OK;
+    emac_esp32_t *emac = __containerof(mac, emac_esp32_t, parent);
+    MAC_CHECK(stats, "can't set stats to null", err, ESP_ERR_INVALID_ARG);
+    *stats = emac->rx_stats;
+    return ESP_OK;
+err:
+    return ret;
+}
+
 static void emac_esp32_rx_task(void *arg)
 {
     emac_esp32_t *emac = (emac_esp32_t *)arg;
-    uint8_t *buffer = NULL;
-    uint32_t length = 0;
+    struct {
+        uint8_t *buffer;
+        uint32_t length;
+    } frames[CONFIG_ETH_DMA_RX_BUFFER_NUM];
+    uint32_t batched = 0;
     while (1) {
         // block indefinitely until got notification from underlay event
         ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        emac->rx_stats.rx_wakeups++;
         do {
-            length = ETH_MAX_PACKET_SIZE;
-            buffer = malloc(length);
-            if (!buffer) {
-                ESP_LOGE(TAG, "no mem for receive buffer");
-            } else if (emac_esp32_receive(&emac->parent, buffer, &length) == ESP_OK) {
-                /* pass the buffer to stack (e.g. TCP/IP layer) */
-                if (length) {
-                    emac->eth->stack_input(emac->eth, buffer, length);
+            /* harvest every pending frame out of the DMA ring before handing
+               anything to the stack, so one wakeup drains the whole ring */
+            batched = 0;
+            do {
+                uint32_t length = ETH_MAX_PACKET_SIZE;
+                uint8_t *buffer = malloc(length);
+                if (!buffer) {
+                    ESP_LOGE(TAG, "no mem for receive buffer");
+                    emac->rx_stats.rx_alloc_failures++;
+                    break;
+                } else if (emac_esp32_receive(&emac->parent, buffer, &length) == ESP_OK && length) {
+                    frames[batched].buffer = buffer;
+                    frames[batched].length = length;
+                    batched++;
                 } else {
                     free(buffer);
                 }
-            } else {
-                free(buffer);
+            } while (emac->frames_remain && batched < CONFIG_ETH_DMA_RX_BUFFER_NUM);
+            if (emac->free_rx_descriptor < emac->rx_stats.rx_ring_min_free) {
+                emac->rx_stats.rx_ring_min_free = emac->free_rx_descriptor;
+            }
+            if (batched > emac->rx_stats.rx_batch_max) {
+                emac->rx_stats.rx_batch_max = batched;
             }
             // we need to do extra checking of remained frames in case there are no unhandled frames left, but pause frame is still undergoing
             if ((emac->free_rx_descriptor < emac->flow_control_low_water_mark) && emac->do_flow_ctrl && emac->frames_remain) {
@@ -305,6 +346,11 @@ static void emac_esp32_rx_task(void *arg)
             } else if ((emac->free_rx_descriptor > emac->flow_control_high_water_mark) || !emac->frames_remain) {
                 emac_hal_send_pause_frame(&emac->hal, false);
             }
+            /* pass the batch to stack (e.g. TCP/IP layer) */
+            for (uint32_t i = 0; i < batched; i++) {
+                emac->eth->stack_input(emac->eth, frames[i].buffer, frames[i].length);
+            }
+            emac->rx_stats.rx_frames += batched;
         } while (emac->frames_remain);
     }
     vTaskDelete(NULL);
@@ -471,6 +517,7 @@ esp_eth_mac_t *esp_eth_mac_new_esp32(const eth_mac_config_t *config)
     emac->smi_mdio_gpio_num = config->smi_mdio_gpio_num;
     emac->flow_control_high_water_mark = FLOW_CONTROL_HIGH_WATER_MARK;
     emac->flow_control_low_water_mark = FLOW_CONTROL_LOW_WATER_MARK;
+    emac->rx_stats.rx_ring_min_free = CONFIG_ETH_DMA_RX_BUFFER_NUM;
     emac->parent.set_mediator = emac_esp32_set_mediator;
     emac->parent.init = emac_esp32_init;
     emac->parent.deinit = emac_esp32_deinit;
@@ -488,7 +535,9 @@ esp_eth_mac_t *esp_eth_mac_new_esp32(const eth_mac_config_t *config)
     emac->parent.set_peer_pause_ability = emac_esp32_set_peer_pause_ability;
     emac->parent.enable_flow_ctrl = emac_esp32_enable_flow_ctrl;
     emac->parent.transmit = emac_esp32_transmit;
+    emac->parent.transmit_multi = emac_esp32_transmit_multi;
     emac->parent.receive = emac_esp32_receive;
+    emac->parent.get_rx_stats = emac_esp32_get_rx_stats;
     /* Interrupt configuration */
     if (config->flags & ETH_MAC_FLAG_WORK_WITH_CACHE_DISABLE) {
         ret_code = esp_intr_alloc(ETS_ETH_MAC_INTR_SOURCE, ESP_INTR_FLAG_IRAM,
@@ -42,6 +42,7 @@ static esp_err_t esp_eth_post_attach(esp_netif_t *esp_netif, void *args)
     esp_netif_driver_ifconfig_t driver_ifconfig = {
         .handle =  glue->eth_driver,
         .transmit = esp_eth_transmit,
+        .transmit_multi = esp_eth_transmit_multi,
         .driver_free_rx_buffer = NULL
     };
 
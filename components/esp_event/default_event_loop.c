@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <stdio.h>
+#include <string.h>
+
 #include "esp_event.h"
 #include "esp_event_internal.h"
 #include "esp_task.h"
@@ -20,8 +23,99 @@
 
 static esp_event_loop_handle_t s_default_loop = NULL;
 
+/* Shard 0 is s_default_loop; further entries are worker loops created with
+ * esp_event_default_shard_create(). Routed bases are kept in a small table;
+ * bases are compared by identity, as everywhere in the event loop library. */
+#define DEFAULT_SHARD_ROUTES_MAX 16
+
+typedef struct {
+    esp_event_base_t base;
+    uint32_t shard;
+} default_shard_route_t;
+
+static esp_event_loop_handle_t s_shard_loops[ESP_EVENT_DEFAULT_SHARDS_MAX];
+static default_shard_route_t s_shard_routes[DEFAULT_SHARD_ROUTES_MAX];
+static portMUX_TYPE s_shard_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/* Resolve the loop serving an event base. Unrouted bases (and
+ * ESP_EVENT_ANY_BASE) stay on the primary default loop. */
+static esp_event_loop_handle_t default_loop_for_base(esp_event_base_t event_base)
+{
+    if (event_base != NULL) {
+        for (int i = 0; i < DEFAULT_SHARD_ROUTES_MAX; i++) {
+            if (s_shard_routes[i].base == event_base) {
+                return s_shard_loops[s_shard_routes[i].shard];
+            }
+        }
+    }
+    return s_default_loop;
+}
+
 /* ---------------------------- Public API ---------------------------------- */
 
+esp_err_t esp_event_default_shard_create(uint32_t shard, UBaseType_t task_priority, BaseType_t task_core_id)
+{
+    if (shard == 0 || shard >= ESP_EVENT_DEFAULT_SHARDS_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_default_loop == NULL || s_shard_loops[shard] != NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    char task_name[16];
+    snprintf(task_name, sizeof(task_name), "sys_evt%d", (int) shard);
+    esp_event_loop_args_t loop_args = {
+        .queue_size = CONFIG_ESP_SYSTEM_EVENT_QUEUE_SIZE,
+        .task_name = task_name,
+        .task_stack_size = ESP_TASKD_EVENT_STACK,
+        .task_priority = task_priority,
+        .task_core_id = task_core_id
+    };
+
+    return esp_event_loop_create(&loop_args, &s_shard_loops[shard]);
+}
+
+esp_err_t esp_event_default_shard_route(esp_event_base_t event_base, uint32_t shard)
+{
+    if (event_base == NULL || shard >= ESP_EVENT_DEFAULT_SHARDS_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (shard != 0 && s_shard_loops[shard] == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    portENTER_CRITICAL(&s_shard_lock);
+    int free_slot = -1;
+    for (int i = 0; i < DEFAULT_SHARD_ROUTES_MAX; i++) {
+        if (s_shard_routes[i].base == event_base) {
+            if (shard == 0) {   //back to the primary loop: drop the route
+                s_shard_routes[i].base = NULL;
+            } else {
+                s_shard_routes[i].shard = shard;
+            }
+            portEXIT_CRITICAL(&s_shard_lock);
+            return ESP_OK;
+        }
+        if (s_shard_routes[i].base == NULL && free_slot < 0) {
+            free_slot = i;
+        }
+    }
+    if (shard == 0) {   //not routed, nothing to drop
+        portEXIT_CRITICAL(&s_shard_lock);
+        return ESP_OK;
+    }
+    if (free_slot < 0) {
+        portEXIT_CRITICAL(&s_shard_lock);
+        return ESP_ERR_NO_MEM;
+    }
+    //Publish the shard before the base so a concurrent lookup never sees a
+    //routed base with a stale shard id
+    s_shard_routes[free_slot].shard = shard;
+    s_shard_routes[free_slot].base = event_base;
+    portEXIT_CRITICAL(&s_shard_lock);
+    return ESP_OK;
+}
+
 esp_err_t esp_event_handler_register(esp_event_base_t event_base, int32_t event_id,
         esp_event_handler_t event_handler, void* event_handler_arg)
 {
@@ -29,7 +123,7 @@ esp_err_t esp_event_handler_register(esp_event_base_t event_base, int32_t event_
         return ESP_ERR_INVALID_STATE;
     }
 
-    return esp_event_handler_register_with(s_default_loop, event_base, event_id,
+    return esp_event_handler_register_with(default_loop_for_base(event_base), event_base, event_id,
             event_handler, event_handler_arg);
 }
 
@@ -43,7 +137,7 @@ esp_err_t esp_event_handler_instance_register(esp_event_base_t event_base,
         return ESP_ERR_INVALID_STATE;
     }
 
-    return esp_event_handler_instance_register_with(s_default_loop,
+    return esp_event_handler_instance_register_with(default_loop_for_base(event_base),
                                                     event_base,
                                                     event_id,
                                                     event_handler,
@@ -58,7 +152,7 @@ esp_err_t esp_event_handler_unregister(esp_event_base_t event_base, int32_t even
         return ESP_ERR_INVALID_STATE;
     }
 
-    return esp_event_handler_unregister_with(s_default_loop, event_base, event_id,
+    return esp_event_handler_unregister_with(default_loop_for_base(event_base), event_base, event_id,
             event_handler);
 }
 
@@ -70,7 +164,7 @@ esp_err_t esp_event_handler_instance_unregister(esp_event_base_t event_base,
         return ESP_ERR_INVALID_STATE;
     }
 
-    return esp_event_handler_instance_unregister_with(s_default_loop, event_base, event_id, context);
+    return esp_event_handler_instance_unregister_with(default_loop_for_base(event_base), event_base, event_id, context);
 }
 
 esp_err_t esp_event_post(esp_event_base_t event_base, int32_t event_id,
@@ -80,7 +174,7 @@ esp_err_t esp_event_post(esp_event_base_t event_base, int32_t event_id,
         return ESP_ERR_INVALID_STATE;
     }
 
-    return esp_event_post_to(s_default_loop, event_base, event_id,
+    return esp_event_post_to(default_loop_for_base(event_base), event_base, event_id,
             event_data, event_data_size, ticks_to_wait);
 }
 
@@ -93,7 +187,7 @@ esp_err_t esp_event_isr_post(esp_event_base_t event_base, int32_t event_id,
         return ESP_ERR_INVALID_STATE;
     }
 
-    return esp_event_isr_post_to(s_default_loop, event_base, event_id,
+    return esp_event_isr_post_to(default_loop_for_base(event_base), event_base, event_id,
             event_data, event_data_size, task_unblocked);
 }
 #endif
@@ -120,6 +214,8 @@ esp_err_t esp_event_loop_create_default(void)
         return err;
     }
 
+    s_shard_loops[0] = s_default_loop;
+
     return ESP_OK;
 }
 
@@ -131,6 +227,19 @@ esp_err_t esp_event_loop_delete_default(void)
 
     esp_err_t err;
 
+    //Tear down the worker shards and their routes first, so no route can
+    //resolve to a deleted loop
+    for (int i = 1; i < ESP_EVENT_DEFAULT_SHARDS_MAX; i++) {
+        if (s_shard_loops[i] != NULL) {
+            err = esp_event_loop_delete(s_shard_loops[i]);
+            if (err != ESP_OK) {
+                return err;
+            }
+            s_shard_loops[i] = NULL;
+        }
+    }
+    memset(s_shard_routes, 0, sizeof(s_shard_routes));
+
     err = esp_event_loop_delete(s_default_loop);
 
     if (err != ESP_OK) {
@@ -138,6 +247,7 @@ esp_err_t esp_event_loop_delete_default(void)
     }
 
     s_default_loop = NULL;
+    s_shard_loops[0] = NULL;
 
     return ESP_OK;
 }
@@ -47,6 +47,47 @@
 static const char* TAG = "event";
 static const char* esp_event_any_base = "any";
 
+#if CONFIG_ESP_EVENT_FASTPATH
+typedef struct {
+    esp_event_loop_handle_t loop;
+    esp_event_base_t base;
+    int32_t id;
+    esp_event_handler_t handler;
+    void* arg;
+} esp_event_fastpath_entry_t;
+
+// Static table of base/id pairs dispatched synchronously from the poster's
+// context; entries with a NULL loop are free
+static esp_event_fastpath_entry_t s_fastpath_entries[CONFIG_ESP_EVENT_FASTPATH_SLOTS];
+static portMUX_TYPE s_fastpath_spinlock = portMUX_INITIALIZER_UNLOCKED;
+
+// Dispatch directly from the calling context if the pair is bound to the fast
+// path; the handler gets the caller's data pointer, no copy is made
+static bool fastpath_dispatch(esp_event_loop_handle_t event_loop, esp_event_base_t event_base, int32_t event_id, void* event_data)
+{
+    esp_event_handler_t fastpath_handler = NULL;
+    void* fastpath_arg = NULL;
+
+    portENTER_CRITICAL(&s_fastpath_spinlock);
+    for (int i = 0; i < CONFIG_ESP_EVENT_FASTPATH_SLOTS; i++) {
+        if (s_fastpath_entries[i].loop == event_loop && s_fastpath_entries[i].base == event_base &&
+                s_fastpath_entries[i].id == event_id) {
+            fastpath_handler = s_fastpath_entries[i].handler;
+            fastpath_arg = s_fastpath_entries[i].arg;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_fastpath_spinlock);
+
+    if (fastpath_handler == NULL) {
+        return false;
+    }
+
+    (*fastpath_handler)(fastpath_arg, event_base, event_id, event_data);
+    return true;
+}
+#endif
+
 #ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
 static SLIST_HEAD(esp_event_loop_instance_list_t, esp_event_loop_instance) s_event_loops =
         SLIST_HEAD_INITIALIZER(s_event_loops);
@@ -429,6 +470,31 @@ static void loop_node_remove_all_handler(esp_event_loop_node_t* loop_node)
     }
 }
 
+#if CONFIG_ESP_EVENT_DISPATCH_CACHE
+static inline size_t dispatch_cache_slot(esp_event_base_t base, int32_t id)
+{
+    return ((((uintptr_t) base) >> 4) ^ ((uintptr_t) id)) % CONFIG_ESP_EVENT_DISPATCH_CACHE_SIZE;
+}
+
+// Record one handler list resolved during a lookup walk; marks the lookup
+// uncacheable if the pair resolves to more lists than an entry can hold
+static void dispatch_cache_note(esp_event_handler_nodes_t* list, esp_event_dispatch_cache_entry_t* entry, bool* cacheable)
+{
+    if (*cacheable && entry->num_lists < ESP_EVENT_DISPATCH_CACHE_MAX_LISTS) {
+        entry->lists[entry->num_lists++] = list;
+    } else {
+        *cacheable = false;
+    }
+}
+
+// Must be called with the loop mutex held whenever handlers are added or
+// removed; the cached list pointers may be dangling afterwards
+static void dispatch_cache_invalidate(esp_event_loop_instance_t* loop)
+{
+    memset(loop->dispatch_cache, 0, sizeof(loop->dispatch_cache));
+}
+#endif
+
 static void inline __attribute__((always_inline)) post_instance_delete(esp_event_post_instance_t* post)
 {
 #if CONFIG_ESP_EVENT_POST_FROM_ISR
@@ -568,12 +634,31 @@ esp_err_t esp_event_loop_run(esp_event_loop_handle_t event_loop, TickType_t tick
         esp_event_base_node_t *base_node, *temp_base;
         esp_event_id_node_t *id_node, *temp_id_node;
 
+#if CONFIG_ESP_EVENT_DISPATCH_CACHE
+        esp_event_dispatch_cache_entry_t* cached = &(loop->dispatch_cache[dispatch_cache_slot(post.base, post.id)]);
+
+        if (cached->valid && cached->base == post.base && cached->id == post.id) {
+            // The lookup for this pair is memoized; execute the resolved
+            // handler lists without walking the registration lists
+            for (size_t i = 0; i < cached->num_lists; i++) {
+                SLIST_FOREACH_SAFE(handler, cached->lists[i], next, temp_handler) {
+                    handler_execute(loop, handler, post);
+                    exec |= true;
+                }
+            }
+        } else {
+        esp_event_dispatch_cache_entry_t resolved = { .base = post.base, .id = post.id };
+        bool cacheable = true;
+#endif
         SLIST_FOREACH_SAFE(loop_node, &(loop->loop_nodes), next, temp_node) {
             // Execute loop level handlers
             SLIST_FOREACH_SAFE(handler, &(loop_node->handlers), next, temp_handler) {
                 handler_execute(loop, handler, post);
                 exec |= true;
             }
+#if CONFIG_ESP_EVENT_DISPATCH_CACHE
+            dispatch_cache_note(&(loop_node->handlers), &resolved, &cacheable);
+#endif
 
             SLIST_FOREACH_SAFE(base_node, &(loop_node->base_nodes), next, temp_base) {
                 if (base_node->base == post.base) {
@@ -582,6 +667,9 @@ esp_err_t esp_event_loop_run(esp_event_loop_handle_t event_loop, TickType_t tick
                         handler_execute(loop, handler, post);
                         exec |= true;
                     }
+#if CONFIG_ESP_EVENT_DISPATCH_CACHE
+                    dispatch_cache_note(&(base_node->handlers), &resolved, &cacheable);
+#endif
 
                     SLIST_FOREACH_SAFE(id_node, &(base_node->id_nodes), next, temp_id_node) {
                         if (id_node->id == post.id) {
@@ -590,6 +678,9 @@ esp_err_t esp_event_loop_run(esp_event_loop_handle_t event_loop, TickType_t tick
                                 handler_execute(loop, handler, post);
                                 exec |= true;
                             }
+#if CONFIG_ESP_EVENT_DISPATCH_CACHE
+                            dispatch_cache_note(&(id_node->handlers), &resolved, &cacheable);
+#endif
                             // Skip to next base node
                             break;
                         }
@@ -597,6 +688,13 @@ esp_err_t esp_event_loop_run(esp_event_loop_handle_t event_loop, TickType_t tick
                 }
             }
         }
+#if CONFIG_ESP_EVENT_DISPATCH_CACHE
+        if (cacheable) {
+            resolved.valid = true;
+            *cached = resolved;
+        }
+        }
+#endif
 
         esp_event_base_t base = post.base;
         int32_t id = post.id;
@@ -666,6 +764,17 @@ esp_err_t esp_event_loop_delete(esp_event_loop_handle_t event_loop)
         post_instance_delete(&post);
     }
 
+#if CONFIG_ESP_EVENT_FASTPATH
+    // Remove any fast-path bindings referring to this loop
+    portENTER_CRITICAL(&s_fastpath_spinlock);
+    for (int i = 0; i < CONFIG_ESP_EVENT_FASTPATH_SLOTS; i++) {
+        if (s_fastpath_entries[i].loop == event_loop) {
+            memset(&s_fastpath_entries[i], 0, sizeof(s_fastpath_entries[i]));
+        }
+    }
+    portEXIT_CRITICAL(&s_fastpath_spinlock);
+#endif
+
     // Cleanup loop
     vQueueDelete(loop->queue);
     free(loop);
@@ -743,6 +852,9 @@ esp_err_t esp_event_handler_register_with_internal(esp_event_loop_handle_t event
     }
 
 on_err:
+#if CONFIG_ESP_EVENT_DISPATCH_CACHE
+    dispatch_cache_invalidate(loop);
+#endif
     xSemaphoreGiveRecursive(loop->mutex);
     return err;
 }
@@ -791,6 +903,10 @@ esp_err_t esp_event_handler_unregister_with_internal(esp_event_loop_handle_t eve
         }
     }
 
+#if CONFIG_ESP_EVENT_DISPATCH_CACHE
+    dispatch_cache_invalidate(loop);
+#endif
+
     xSemaphoreGiveRecursive(loop->mutex);
 
     return ESP_OK;
@@ -825,6 +941,12 @@ esp_err_t esp_event_post_to(esp_event_loop_handle_t event_loop, esp_event_base_t
 
     esp_event_loop_instance_t* loop = (esp_event_loop_instance_t*) event_loop;
 
+#if CONFIG_ESP_EVENT_FASTPATH
+    if (fastpath_dispatch(event_loop, event_base, event_id, event_data)) {
+        return ESP_OK;
+    }
+#endif
+
     esp_event_post_instance_t post;
     memset((void*)(&post), 0, sizeof(post));
 
@@ -890,6 +1012,168 @@ esp_err_t esp_event_post_to(esp_event_loop_handle_t event_loop, esp_event_base_t
     return ESP_OK;
 }
 
+esp_err_t esp_event_post_batch(esp_event_loop_handle_t event_loop, const esp_event_batch_item_t* items,
+                               size_t num_items, TickType_t ticks_to_wait, size_t* num_posted)
+{
+    assert(event_loop);
+
+    if (items == NULL && num_items != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // Validate the whole batch up front so an invalid item cannot leave the
+    // batch half-posted for a reason that was knowable in advance
+    for (size_t i = 0; i < num_items; i++) {
+        if (items[i].base == ESP_EVENT_ANY_BASE || items[i].id == ESP_EVENT_ANY_ID) {
+            if (num_posted) {
+                *num_posted = 0;
+            }
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    esp_event_loop_instance_t* loop = (esp_event_loop_instance_t*) event_loop;
+
+    // Determine once for the whole batch whether the caller is the task that
+    // currently executes the loop. It is safe to query loop->task since it is
+    // not mutated since loop creation. ENSURE THIS REMAINS TRUE.
+    bool posting_from_loop_task;
+    if (loop->task == NULL) {
+        if (xSemaphoreTakeRecursive(loop->mutex, ticks_to_wait) != pdTRUE) {
+            if (num_posted) {
+                *num_posted = 0;
+            }
+            return ESP_ERR_TIMEOUT;
+        }
+        posting_from_loop_task = (loop->running_task == xTaskGetCurrentTaskHandle());
+        xSemaphoreGiveRecursive(loop->mutex);
+    } else {
+        posting_from_loop_task = (loop->task == xTaskGetCurrentTaskHandle());
+    }
+
+    esp_err_t err = ESP_OK;
+    size_t posted = 0;
+
+    while (posted < num_items) {
+        const esp_event_batch_item_t* item = &items[posted];
+
+#if CONFIG_ESP_EVENT_FASTPATH
+        if (fastpath_dispatch(event_loop, item->base, item->id, item->data)) {
+            posted++;
+            continue;
+        }
+#endif
+
+        esp_event_post_instance_t post;
+        memset((void*)(&post), 0, sizeof(post));
+
+        if (item->data != NULL && item->data_size != 0) {
+            // Make persistent copy of event data on heap.
+            void* event_data_copy = calloc(1, item->data_size);
+
+            if (event_data_copy == NULL) {
+                err = ESP_ERR_NO_MEM;
+                break;
+            }
+
+            memcpy(event_data_copy, item->data, item->data_size);
+#if CONFIG_ESP_EVENT_POST_FROM_ISR
+            post.data.ptr = event_data_copy;
+            post.data_allocated = true;
+            post.data_set = true;
+#else
+            post.data = event_data_copy;
+#endif
+        }
+        post.base = item->base;
+        post.id = item->id;
+
+        if (xQueueSendToBack(loop->queue, &post, posting_from_loop_task ? 0 : ticks_to_wait) != pdTRUE) {
+            post_instance_delete(&post);
+
+#ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
+            atomic_fetch_add(&loop->events_dropped, 1);
+#endif
+            err = ESP_ERR_TIMEOUT;
+            break;
+        }
+
+#ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
+        atomic_fetch_add(&loop->events_recieved, 1);
+#endif
+        posted++;
+    }
+
+    if (num_posted) {
+        *num_posted = posted;
+    }
+
+    return err;
+}
+
+#if CONFIG_ESP_EVENT_FASTPATH
+esp_err_t esp_event_fastpath_register_with(esp_event_loop_handle_t event_loop, esp_event_base_t event_base,
+                                           int32_t event_id, esp_event_handler_t event_handler, void* event_handler_arg)
+{
+    assert(event_loop);
+    assert(event_handler);
+
+    if (event_base == ESP_EVENT_ANY_BASE || event_id == ESP_EVENT_ANY_ID) {
+        ESP_LOGE(TAG, "binding any event base or id to the fast path unsupported");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t err = ESP_ERR_NO_MEM;
+
+    portENTER_CRITICAL(&s_fastpath_spinlock);
+    int free_slot = -1;
+    for (int i = 0; i < CONFIG_ESP_EVENT_FASTPATH_SLOTS; i++) {
+        if (s_fastpath_entries[i].loop == NULL) {
+            if (free_slot < 0) {
+                free_slot = i;
+            }
+        } else if (s_fastpath_entries[i].loop == event_loop && s_fastpath_entries[i].base == event_base &&
+                s_fastpath_entries[i].id == event_id) {
+            free_slot = -1;
+            err = ESP_ERR_INVALID_STATE;
+            break;
+        }
+    }
+    if (free_slot >= 0) {
+        s_fastpath_entries[free_slot].loop = event_loop;
+        s_fastpath_entries[free_slot].base = event_base;
+        s_fastpath_entries[free_slot].id = event_id;
+        s_fastpath_entries[free_slot].handler = event_handler;
+        s_fastpath_entries[free_slot].arg = event_handler_arg;
+        err = ESP_OK;
+    }
+    portEXIT_CRITICAL(&s_fastpath_spinlock);
+
+    return err;
+}
+
+esp_err_t esp_event_fastpath_unregister_with(esp_event_loop_handle_t event_loop, esp_event_base_t event_base,
+                                             int32_t event_id)
+{
+    assert(event_loop);
+
+    esp_err_t err = ESP_ERR_NOT_FOUND;
+
+    portENTER_CRITICAL(&s_fastpath_spinlock);
+    for (int i = 0; i < CONFIG_ESP_EVENT_FASTPATH_SLOTS; i++) {
+        if (s_fastpath_entries[i].loop == event_loop && s_fastpath_entries[i].base == event_base &&
+                s_fastpath_entries[i].id == event_id) {
+            memset(&s_fastpath_entries[i], 0, sizeof(s_fastpath_entries[i]));
+            err = ESP_OK;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_fastpath_spinlock);
+
+    return err;
+}
+#endif
+
 #if CONFIG_ESP_EVENT_POST_FROM_ISR
 esp_err_t esp_event_isr_post_to(esp_event_loop_handle_t event_loop, esp_event_base_t event_base, int32_t event_id,
                             void* event_data, size_t event_data_size, BaseType_t* task_unblocked)
@@ -85,6 +85,57 @@ esp_err_t esp_event_loop_create_default(void);
  */
 esp_err_t esp_event_loop_delete_default(void);
 
+/**
+ * @brief Maximum number of default loop shards, including the primary loop (shard 0)
+ */
+#define ESP_EVENT_DEFAULT_SHARDS_MAX    4
+
+/**
+ * @brief Create an additional worker shard of the default event loop
+ *
+ * The default loop is a single task, so during event storms latency-sensitive
+ * handlers queue behind bulk handlers. A shard is a second (third, ...) loop
+ * task with its own queue; event bases routed to it with
+ * esp_event_default_shard_route() are registered on and dispatched by that
+ * shard instead of the primary default loop. Ordering is preserved within an
+ * event base (each base lives on exactly one shard) while different bases run
+ * concurrently, on the core of your choosing.
+ *
+ * Shard 0 is the primary default loop and always exists once
+ * esp_event_loop_create_default() was called.
+ *
+ * @param[in] shard id of the shard to create (1 to ESP_EVENT_DEFAULT_SHARDS_MAX - 1)
+ * @param[in] task_priority priority of the shard's dispatch task
+ * @param[in] task_core_id core to which the shard's dispatch task is pinned
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_ARG: shard is 0 or out of range
+ *  - ESP_ERR_INVALID_STATE: default event loop not created yet, or the shard already exists
+ *  - Others: Fail
+ */
+esp_err_t esp_event_default_shard_create(uint32_t shard, UBaseType_t task_priority, BaseType_t task_core_id);
+
+/**
+ * @brief Route an event base of the default loop to a shard
+ *
+ * All default-loop registrations and posts for event_base made after this
+ * call go to the given shard. Set up routes before registering handlers and
+ * posting events of that base: handlers already registered stay on the loop
+ * they were registered on. Handlers registered for ESP_EVENT_ANY_BASE only
+ * observe events of bases living on the same shard.
+ *
+ * @param[in] event_base the event base to route
+ * @param[in] shard id of the target shard; 0 restores routing to the primary loop
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_ARG: event_base is NULL or shard is out of range
+ *  - ESP_ERR_INVALID_STATE: the target shard has not been created
+ *  - ESP_ERR_NO_MEM: routing table is full
+ */
+esp_err_t esp_event_default_shard_route(esp_event_base_t event_base, uint32_t shard);
+
 /**
  * @brief Dispatch events posted to an event loop.
  *
@@ -409,6 +460,97 @@ esp_err_t esp_event_post_to(esp_event_loop_handle_t event_loop,
                             size_t event_data_size,
                             TickType_t ticks_to_wait);
 
+/**
+ * @brief An event to be posted as part of a batch
+ */
+typedef struct {
+    esp_event_base_t base;                      /**< the event base that identifies the event */
+    int32_t id;                                 /**< the event id that identifies the event */
+    void *data;                                 /**< the data, specific to the event occurence, that gets passed to the handler */
+    size_t data_size;                           /**< the size of the event data */
+} esp_event_batch_item_t;
+
+/**
+ * @brief Posts several events to the specified event loop under a single loop interaction.
+ *
+ * Each item behaves as if posted individually with esp_event_post_to, but the
+ * determination of the posting context is done once for the whole batch, so
+ * fan-in producers posting many events per cycle pay the loop synchronization
+ * cost once instead of per event. Items are posted in array order; if posting
+ * stops early (full queue or out of memory), the number of items successfully
+ * posted is reported through num_posted and the remaining items are not posted.
+ *
+ * @param[in] event_loop the event loop to post to
+ * @param[in] items array of events to post
+ * @param[in] num_items number of entries in items
+ * @param[in] ticks_to_wait number of ticks to block on a full event queue
+ * @param[out] num_posted optional (can be NULL); number of items successfully posted
+ *
+ * @return
+ *  - ESP_OK: Success, all items posted
+ *  - ESP_ERR_TIMEOUT: Time to wait for event queue to unblock expired
+ *  - ESP_ERR_NO_MEM: Cannot allocate a copy of an item's event data
+ *  - ESP_ERR_INVALID_ARG: Invalid combination of event base and event id in an item
+ *  - Others: Fail
+ */
+esp_err_t esp_event_post_batch(esp_event_loop_handle_t event_loop,
+                               const esp_event_batch_item_t *items,
+                               size_t num_items,
+                               TickType_t ticks_to_wait,
+                               size_t *num_posted);
+
+#if CONFIG_ESP_EVENT_FASTPATH
+/**
+ * @brief Bind an event base/id pair to the dispatch fast path of a loop.
+ *
+ * Posts of the bound pair to the given loop call the handler directly in the
+ * context of the posting task: no copy of the event data is allocated, nothing
+ * goes through the loop queue, and the data pointer passed to the handler is
+ * the caller's buffer, valid only for the duration of the call. Because the
+ * handler no longer runs serialized on the loop task, it must be short and
+ * safe to run concurrently with the loop's other handlers. Only one handler
+ * can be bound per base/id pair; handlers registered normally for the pair
+ * will no longer see it while the binding exists.
+ *
+ * @note posts from interrupt handlers (esp_event_isr_post_to) never take the
+ *       fast path, since handlers cannot run in interrupt context.
+ *
+ * @param[in] event_loop the loop whose posts should take the fast path
+ * @param[in] event_base the event base that identifies the event
+ * @param[in] event_id the event id that identifies the event; ESP_EVENT_ANY_ID is not allowed
+ * @param[in] event_handler the handler to invoke
+ * @param[in] event_handler_arg data, aside from event data, that is passed to the handler when it is called
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_ARG: Invalid combination of event base and event id
+ *  - ESP_ERR_INVALID_STATE: The base/id pair is already bound for this loop
+ *  - ESP_ERR_NO_MEM: All fast-path slots are in use
+ */
+esp_err_t esp_event_fastpath_register_with(esp_event_loop_handle_t event_loop,
+                                           esp_event_base_t event_base,
+                                           int32_t event_id,
+                                           esp_event_handler_t event_handler,
+                                           void *event_handler_arg);
+
+/**
+ * @brief Remove a fast-path binding created with esp_event_fastpath_register_with.
+ *
+ * Subsequent posts of the pair go through the normal loop path again.
+ *
+ * @param[in] event_loop the loop the pair was bound on
+ * @param[in] event_base the event base that identifies the event
+ * @param[in] event_id the event id that identifies the event
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_NOT_FOUND: No such binding exists
+ */
+esp_err_t esp_event_fastpath_unregister_with(esp_event_loop_handle_t event_loop,
+                                             esp_event_base_t event_base,
+                                             int32_t event_id);
+#endif
+
 #if CONFIG_ESP_EVENT_POST_FROM_ISR
 /**
  * @brief Special variant of esp_event_post for posting events from interrupt handlers.
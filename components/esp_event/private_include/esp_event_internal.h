@@ -71,6 +71,20 @@ typedef struct esp_event_loop_node {
 
 typedef SLIST_HEAD(esp_event_loop_nodes, esp_event_loop_node) esp_event_loop_nodes_t;
 
+#if CONFIG_ESP_EVENT_DISPATCH_CACHE
+/// Maximum number of handler lists a single cached base/id pair can resolve to
+#define ESP_EVENT_DISPATCH_CACHE_MAX_LISTS 4
+
+/// Memoized result of a base/id handler lookup
+typedef struct esp_event_dispatch_cache_entry {
+    bool valid;                                                     /**< entry holds a resolved lookup */
+    esp_event_base_t base;                                          /**< the event base */
+    int32_t id;                                                     /**< the event id */
+    size_t num_lists;                                               /**< number of handler lists resolved */
+    esp_event_handler_nodes_t* lists[ESP_EVENT_DISPATCH_CACHE_MAX_LISTS];   /**< handler lists to execute for the pair */
+} esp_event_dispatch_cache_entry_t;
+#endif
+
 /// Event loop
 typedef struct esp_event_loop_instance {
     const char* name;                                               /**< name of this event loop */
@@ -81,6 +95,10 @@ typedef struct esp_event_loop_instance {
     SemaphoreHandle_t mutex;                                        /**< mutex for updating the events linked list */
     esp_event_loop_nodes_t loop_nodes;                              /**< set of linked lists containing the
                                                                             registered handlers for the loop */
+#if CONFIG_ESP_EVENT_DISPATCH_CACHE
+    esp_event_dispatch_cache_entry_t dispatch_cache[CONFIG_ESP_EVENT_DISPATCH_CACHE_SIZE];  /**< direct-mapped cache
+                                                                            of base/id handler lookups; guarded by mutex */
+#endif
 #ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
     atomic_uint_least32_t events_recieved;                          /**< number of events successfully posted to the loop */
     atomic_uint_least32_t events_dropped;                           /**< number of events dropped due to queue being full */
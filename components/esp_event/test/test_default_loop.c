@@ -155,3 +155,43 @@ TEST_CASE("default event loop: registering event handler instance without instan
 
     vSemaphoreDelete(arg_1.mutex);
 }
+
+static void test_event_shard_handler(void* event_handler_arg, esp_event_base_t event_base, int32_t event_id, void* event_data)
+{
+    TaskHandle_t* handled_by = (TaskHandle_t*) event_handler_arg;
+    *handled_by = xTaskGetCurrentTaskHandle();
+}
+
+TEST_CASE("default loop: routed base dispatches on its shard", "[event]")
+{
+    TEST_SETUP();
+
+    TaskHandle_t handled_by = NULL;
+
+    TEST_ESP_OK(esp_event_loop_create_default());
+    TEST_ESP_OK(esp_event_default_shard_create(1, uxTaskPriorityGet(NULL) + 1, tskNO_AFFINITY));
+    TEST_ESP_OK(esp_event_default_shard_route(s_default_test_base1, 1));
+
+    TEST_ESP_OK(esp_event_handler_register(s_default_test_base1, TEST_EVENT_BASE1_EV1,
+                                           test_event_shard_handler, &handled_by));
+    TEST_ESP_OK(esp_event_post(s_default_test_base1, TEST_EVENT_BASE1_EV1, NULL, 0, portMAX_DELAY));
+    vTaskDelay(pdMS_TO_TICKS(100));
+
+    TEST_ASSERT_NOT_NULL(handled_by);
+    TEST_ASSERT_EQUAL_STRING("sys_evt1", pcTaskGetTaskName(handled_by));
+
+    // unrouted bases stay on the primary loop
+    handled_by = NULL;
+    TEST_ESP_OK(esp_event_handler_register(s_default_test_base2, TEST_EVENT_BASE2_EV1,
+                                           test_event_shard_handler, &handled_by));
+    TEST_ESP_OK(esp_event_post(s_default_test_base2, TEST_EVENT_BASE2_EV1, NULL, 0, portMAX_DELAY));
+    vTaskDelay(pdMS_TO_TICKS(100));
+
+    TEST_ASSERT_NOT_NULL(handled_by);
+    TEST_ASSERT_EQUAL_STRING("sys_evt", pcTaskGetTaskName(handled_by));
+
+    TEST_ESP_OK(esp_event_handler_unregister(s_default_test_base1, TEST_EVENT_BASE1_EV1, test_event_shard_handler));
+    TEST_ESP_OK(esp_event_handler_unregister(s_default_test_base2, TEST_EVENT_BASE2_EV1, test_event_shard_handler));
+    TEST_ESP_OK(esp_event_default_shard_route(s_default_test_base1, 0));
+    TEST_ESP_OK(esp_event_loop_delete_default());
+}
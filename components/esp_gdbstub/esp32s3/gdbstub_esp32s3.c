@@ -23,6 +23,11 @@ void esp_gdbstub_target_init()
 {
 }
 
+bool esp_gdbstub_getchar_ready(void)
+{
+    return REG_GET_FIELD(UART_STATUS_REG(UART_NUM), UART_RXFIFO_CNT) > 0;
+}
+
 int esp_gdbstub_getchar()
 {
     while (REG_GET_FIELD(UART_STATUS_REG(UART_NUM), UART_RXFIFO_CNT) == 0) {
@@ -15,6 +15,11 @@
 #pragma once
 
 #include "esp_gdbstub_arch.h"
+#include "sdkconfig.h"
+
+#ifdef CONFIG_ESP_GDBSTUB_RUNTIME_ATTACH
+#include "esp_err.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -22,6 +27,23 @@ extern "C" {
 
 void esp_gdbstub_panic_handler(esp_gdbstub_frame_t *frame) __attribute__((noreturn));
 
+#ifdef CONFIG_ESP_GDBSTUB_RUNTIME_ATTACH
+/**
+ * @brief Start the GDB Stub runtime attach listener
+ *
+ * Creates a task which watches the console UART for the GDB break character
+ * (Ctrl-C). When it is received, all other tasks (and the other CPU) are
+ * frozen and the GDB remote protocol is served over the UART, allowing a
+ * live system to be inspected with 'info threads', backtraces etc. without
+ * crashing it first. The system resumes when the client detaches or
+ * continues.
+ *
+ * @return ESP_OK on success, ESP_ERR_INVALID_STATE if the listener is
+ *         already running, ESP_ERR_NO_MEM if the task can not be created
+ */
+esp_err_t esp_gdbstub_runtime_start(void);
+#endif // CONFIG_ESP_GDBSTUB_RUNTIME_ATTACH
+
 #ifdef __cplusplus
 }
 #endif
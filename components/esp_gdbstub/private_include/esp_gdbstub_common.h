@@ -112,6 +112,12 @@ int esp_gdbstub_getchar(void);
  */
 void esp_gdbstub_putchar(int c);
 
+/**
+ * Check whether a byte from the GDB client is available, without consuming it
+ * @return true if esp_gdbstub_getchar() would return without blocking
+ */
+bool esp_gdbstub_getchar_ready(void);
+
 /**
  * Read a byte from target memory
  * @param ptr  address
@@ -148,3 +154,13 @@ int esp_gdbstub_read_command(unsigned char **out_cmd, size_t *out_size);
 
 /** Handle a command received from gdb */
 int esp_gdbstub_handle_command(unsigned char *cmd, int len);
+
+#ifdef CONFIG_ESP_GDBSTUB_RUNTIME_ATTACH
+
+/** Serve the GDB protocol on a live system; returns when the client detaches */
+void esp_gdbstub_runtime_serve(esp_gdbstub_frame_t *frame);
+
+/** Feed the watchdogs while the system is frozen by the runtime stub */
+void esp_gdbstub_runtime_feed_wdts(void);
+
+#endif // CONFIG_ESP_GDBSTUB_RUNTIME_ATTACH
@@ -81,6 +81,60 @@ void esp_gdbstub_panic_handler(esp_gdbstub_frame_t *frame)
 }
 
 
+#ifdef CONFIG_ESP_GDBSTUB_RUNTIME_ATTACH
+
+/** Serve the GDB protocol on a live (non-paniced) system.
+ *  The caller (gdbstub_runtime.c) has already frozen the scheduler and the
+ *  other CPU and provides a frame describing its own context. Unlike the
+ *  panic handler, this function returns: when the client detaches ('D'),
+ *  continues ('c') or kills ('k') the session, the caller resumes the system.
+ */
+void esp_gdbstub_runtime_serve(esp_gdbstub_frame_t *frame)
+{
+    s_scratch.state = GDBSTUB_STARTED;
+    memcpy(&s_scratch.paniced_frame, frame, sizeof(*frame));
+    init_task_info();
+    find_paniced_task_index();
+    if (s_scratch.paniced_task_index == GDBSTUB_CUR_TASK_INDEX_UNKNOWN) {
+        set_active_task(0);
+    } else {
+        set_active_task(s_scratch.paniced_task_index);
+    }
+    s_scratch.signal = 2; /* SIGINT: the target was stopped on request */
+    send_reason();
+    while (true) {
+        unsigned char *cmd;
+        size_t size;
+        /* Feed the watchdogs while the client keeps the target stopped:
+         * with the scheduler suspended nobody else does */
+        while (!esp_gdbstub_getchar_ready()) {
+            esp_gdbstub_runtime_feed_wdts();
+        }
+        int res = esp_gdbstub_read_command(&cmd, &size);
+        if (res > 0) {
+            /* character received instead of a command */
+            continue;
+        }
+        if (res == GDBSTUB_ST_ERR) {
+            esp_gdbstub_send_str_packet("E01");
+            continue;
+        }
+        if (size > 0 && (cmd[0] == 'c' || cmd[0] == 'D' || cmd[0] == 'k')) {
+            if (cmd[0] == 'D') {
+                esp_gdbstub_send_str_packet("OK");
+            }
+            break;
+        }
+        res = esp_gdbstub_handle_command(cmd, size);
+        if (res == GDBSTUB_ST_ERR) {
+            esp_gdbstub_send_str_packet(NULL);
+        }
+    }
+    s_scratch.state = GDBSTUB_NOT_STARTED;
+}
+
+#endif // CONFIG_ESP_GDBSTUB_RUNTIME_ATTACH
+
 static void send_reason(void)
 {
     esp_gdbstub_send_start();
@@ -0,0 +1,130 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * Runtime attach support: allows connecting GDB to a live (non-paniced)
+ * system to inspect a deadlock or hang without crashing the device first.
+ *
+ * A listener task watches the gdbstub UART for the GDB break character
+ * (Ctrl-C, 0x03). When it arrives, the listener stalls the other CPU,
+ * suspends the scheduler on its own CPU and serves the regular gdbstub
+ * protocol over the frozen FreeRTOS task state. When the client detaches
+ * ('D') or continues ('c'), everything is resumed and the application
+ * keeps running.
+ */
+
+#include "sdkconfig.h"
+
+#ifdef CONFIG_ESP_GDBSTUB_RUNTIME_ATTACH
+
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_gdbstub.h"
+#include "esp_gdbstub_common.h"
+#include "soc/cpu.h"
+#include "hal/wdt_types.h"
+#include "hal/wdt_hal.h"
+#include "soc/timer_group_struct.h"
+#include "soc/rtc_cntl_struct.h"
+
+/* Character GDB sends to interrupt the target */
+#define GDBSTUB_BREAK_CHAR          0x03
+#define GDBSTUB_LISTENER_STACK      4096
+/* High enough to get CPU time even when some task is spinning */
+#define GDBSTUB_LISTENER_PRIORITY   (configMAX_PRIORITIES - 2)
+#define GDBSTUB_POLL_PERIOD_MS      10
+
+static TaskHandle_t s_listener_task;
+
+/* Called from the serve loop while the system is frozen: the scheduler is
+ * suspended, so nothing else feeds the watchdogs while the GDB client
+ * keeps the target stopped.
+ */
+void esp_gdbstub_runtime_feed_wdts(void)
+{
+    wdt_hal_context_t wdt0_ctx = {.inst = WDT_MWDT0, .mwdt_dev = &TIMERG0};
+    wdt_hal_write_protect_disable(&wdt0_ctx);
+    wdt_hal_feed(&wdt0_ctx);
+    wdt_hal_write_protect_enable(&wdt0_ctx);
+
+    wdt_hal_context_t wdt1_ctx = {.inst = WDT_MWDT1, .mwdt_dev = &TIMERG1};
+    wdt_hal_write_protect_disable(&wdt1_ctx);
+    wdt_hal_feed(&wdt1_ctx);
+    wdt_hal_write_protect_enable(&wdt1_ctx);
+
+    wdt_hal_context_t rtc_wdt_ctx = {.inst = WDT_RWDT, .rwdt_dev = &RTCCNTL};
+    wdt_hal_write_protect_disable(&rtc_wdt_ctx);
+    wdt_hal_feed(&rtc_wdt_ctx);
+    wdt_hal_write_protect_enable(&rtc_wdt_ctx);
+}
+
+static void gdbstub_freeze(void)
+{
+#if !CONFIG_FREERTOS_UNICORE
+    esp_cpu_stall(xPortGetCoreID() == 0 ? 1 : 0);
+#endif
+    vTaskSuspendAll();
+}
+
+static void gdbstub_resume(void)
+{
+    xTaskResumeAll();
+#if !CONFIG_FREERTOS_UNICORE
+    esp_cpu_unstall(xPortGetCoreID() == 0 ? 1 : 0);
+#endif
+}
+
+static void gdbstub_handle_attach(void)
+{
+    /* Build a frame describing the listener task itself, so that GDB gets
+     * a valid register set for the thread it lands on. The other tasks are
+     * presented from their saved TCB frames, as in the panic path.
+     */
+    esp_gdbstub_frame_t frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.pc = (uint32_t) &gdbstub_handle_attach;
+    frame.a1 = (uint32_t) __builtin_frame_address(0);
+
+    gdbstub_freeze();
+    esp_gdbstub_target_init();
+    esp_gdbstub_runtime_serve(&frame);
+    gdbstub_resume();
+}
+
+static void gdbstub_listener_task(void *arg)
+{
+    while (true) {
+        while (!esp_gdbstub_getchar_ready()) {
+            vTaskDelay(pdMS_TO_TICKS(GDBSTUB_POLL_PERIOD_MS));
+        }
+        if (esp_gdbstub_getchar() == GDBSTUB_BREAK_CHAR) {
+            gdbstub_handle_attach();
+        }
+    }
+}
+
+esp_err_t esp_gdbstub_runtime_start(void)
+{
+    if (s_listener_task != NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (xTaskCreate(gdbstub_listener_task, "gdbstub", GDBSTUB_LISTENER_STACK,
+                    NULL, GDBSTUB_LISTENER_PRIORITY, &s_listener_task) != pdPASS) {
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+#endif // CONFIG_ESP_GDBSTUB_RUNTIME_ATTACH
@@ -169,6 +169,59 @@ esp_err_t esp_hidd_dev_battery_set(esp_hidd_dev_t *dev, uint8_t level);
  */
 esp_err_t esp_hidd_dev_input_set(esp_hidd_dev_t *dev, size_t map_index, size_t report_id, uint8_t *data, size_t length);
 
+/**
+ * @brief HID report latency statistics
+ */
+typedef struct {
+    uint32_t submitted;     /*!< reports handed to the controller queue by esp_hidd_dev_input_send */
+    uint32_t completed;     /*!< reports confirmed sent by the controller */
+    uint32_t dropped;       /*!< reports the controller queue refused */
+    uint32_t last_us;       /*!< submit-to-confirmation time of the last completed report, in microseconds */
+    uint32_t max_us;        /*!< longest submit-to-confirmation time seen, in microseconds */
+    uint32_t avg_us;        /*!< average submit-to-confirmation time, in microseconds */
+} esp_hidd_report_latency_t;
+
+/**
+ * @brief Send an INPUT report to the host without waiting for the confirmation
+ *
+ * Unlike esp_hidd_dev_input_set, the report is handed to the controller queue and the call
+ * returns immediately, so the next report can be sampled while the previous one is in the air.
+ * This keeps latency-critical reports (e.g. mouse motion) off the blocking callback round trip.
+ * The submit timestamp and the controller confirmation of every report are tracked and can be
+ * read with esp_hidd_dev_report_latency_get.
+ *
+ * @param dev       : pointer to the device
+ * @param map_index : index of the device report map in the init config
+ * @param report_id : id of the HID INPUT report
+ * @param data      : pointer to the data to send
+ * @param length    : length of the data to send
+ *
+ * @return: ESP_OK on success
+ */
+esp_err_t esp_hidd_dev_input_send(esp_hidd_dev_t *dev, size_t map_index, size_t report_id, uint8_t *data, size_t length);
+
+/**
+ * @brief Get the latency statistics of reports sent with esp_hidd_dev_input_send
+ *
+ * The measurement assumes the non-blocking lane is the active input path; confirmations of
+ * blocking sends issued in parallel are not attributed to it.
+ *
+ * @param dev           : pointer to the device
+ * @param[out] latency  : statistics since init or the last reset
+ *
+ * @return: ESP_OK on success
+ */
+esp_err_t esp_hidd_dev_report_latency_get(esp_hidd_dev_t *dev, esp_hidd_report_latency_t *latency);
+
+/**
+ * @brief Reset the latency statistics of reports sent with esp_hidd_dev_input_send
+ *
+ * @param dev : pointer to the device
+ *
+ * @return: ESP_OK on success
+ */
+esp_err_t esp_hidd_dev_report_latency_reset(esp_hidd_dev_t *dev);
+
 /**
  * @brief Send a FEATURE report to the host
  * @param dev       : pointer to the device
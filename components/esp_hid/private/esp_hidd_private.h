@@ -30,7 +30,10 @@ struct esp_hidd_dev_s {
     esp_err_t   (*deinit)                   (void *dev);
     esp_err_t   (*battery_set)              (void *dev, uint8_t level);
     esp_err_t   (*input_set)                (void *dev, size_t map_index, size_t report_id, uint8_t *data, size_t length);
+    esp_err_t   (*input_send)               (void *dev, size_t map_index, size_t report_id, uint8_t *data, size_t length);
     esp_err_t   (*feature_set)              (void *dev, size_t map_index, size_t report_id, uint8_t *data, size_t length);
+    esp_err_t   (*report_latency_get)       (void *dev, esp_hidd_report_latency_t *latency);
+    esp_err_t   (*report_latency_reset)     (void *dev);
     esp_err_t   (*event_handler_register)   (void *dev, esp_event_handler_t callback, esp_hidd_event_t event);
     esp_err_t   (*event_handler_unregister) (void *dev, esp_event_handler_t callback, esp_hidd_event_t event);
 };
@@ -26,6 +26,9 @@
 #include "esp_gatts_api.h"
 #include "esp_gatt_defs.h"
 #include "esp_gap_ble_api.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 
 static const char *TAG = "BLE_HIDD";
 
@@ -193,9 +196,22 @@ struct esp_ble_hidd_dev_s {
 
     hidd_dev_map_t             *devices;
     uint8_t                     devices_len;
+
+    //bookkeeping of the non-blocking input lane, guarded by s_ll_lock
+    int64_t                     ll_ts[8];       //submit timestamps of reports awaiting confirmation
+    uint8_t                     ll_ts_head;     //oldest pending timestamp
+    uint8_t                     ll_ts_cnt;      //number of pending timestamps
+    uint32_t                    ll_submitted;
+    uint32_t                    ll_completed;
+    uint32_t                    ll_dropped;
+    uint32_t                    ll_last_us;
+    uint32_t                    ll_max_us;
+    uint64_t                    ll_total_us;
 };
 typedef struct esp_ble_hidd_dev_s esp_ble_hidd_dev_t;
 
+static portMUX_TYPE s_ll_lock = portMUX_INITIALIZER_UNLOCKED;
+
 // HID Information characteristic value
 static const uint8_t hidInfo[4] = {
     0x11, 0x01,     // bcdHID (USB HID version)
@@ -207,6 +223,24 @@ static const uint8_t hidInfo[4] = {
 #define WAIT_CB(d) xSemaphoreTake(d->sem, portMAX_DELAY)
 #define SEND_CB(d) xSemaphoreGive(d->sem)
 
+//account one controller confirmation to the non-blocking input lane
+static void ble_hidd_ll_complete(esp_ble_hidd_dev_t *dev)
+{
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&s_ll_lock);
+    int64_t sent = dev->ll_ts[dev->ll_ts_head];
+    dev->ll_ts_head = (dev->ll_ts_head + 1) & (sizeof(dev->ll_ts) / sizeof(dev->ll_ts[0]) - 1);
+    dev->ll_ts_cnt--;
+    dev->ll_completed++;
+    uint32_t delta = (uint32_t)(now - sent);
+    dev->ll_last_us = delta;
+    dev->ll_total_us += delta;
+    if (delta > dev->ll_max_us) {
+        dev->ll_max_us = delta;
+    }
+    portEXIT_CRITICAL(&s_ll_lock);
+}
+
 static const char *gatts_evt_names[25] = { "REG", "READ", "WRITE", "EXEC_WRITE", "MTU", "CONF", "UNREG", "CREATE", "ADD_INCL_SRVC", "ADD_CHAR", "ADD_CHAR_DESCR", "DELETE", "START", "STOP", "CONNECT", "DISCONNECT", "OPEN", "CANCEL_OPEN", "CLOSE", "LISTEN", "CONGEST", "RESPONSE", "CREAT_ATTR_TAB", "SET_ATTR_VAL", "SEND_SERVICE_CHANGE"};
 
 static const char *gatts_evt_str(uint8_t event)
@@ -593,7 +627,12 @@ static void hid_event_handler(esp_ble_hidd_dev_t *dev, int device_index, esp_gat
     }
     case ESP_GATTS_CONF_EVT: {
         ESP_LOGV(TAG, "HID CONF[%d] status: 0x%02x, len: %d", device_index, param->conf.status, param->conf.len);
-        SEND_CB(dev);
+        if (dev->ll_ts_cnt) {
+            //a non-blocking send is in the air; nobody waits on the semaphore for it
+            ble_hidd_ll_complete(dev);
+        } else {
+            SEND_CB(dev);
+        }
         break;
     }
     case ESP_GATTS_MTU_EVT:
@@ -871,6 +910,84 @@ static esp_err_t esp_ble_hidd_dev_input_set(void *devp, size_t index, size_t id,
     return ESP_OK;
 }
 
+static esp_err_t esp_ble_hidd_dev_input_send(void *devp, size_t index, size_t id, uint8_t *data, size_t length)
+{
+    hidd_le_report_item_t *p_rpt;
+    esp_ble_hidd_dev_t *dev = (esp_ble_hidd_dev_t *)devp;
+    if (!dev || s_dev != dev) {
+        return ESP_FAIL;
+    }
+    if (!dev->connected) {
+        ESP_LOGE(TAG, "Device Not Connected: %d", index);
+        return ESP_FAIL;
+    }
+
+    if ((p_rpt = get_report_by_id_and_type(dev, id, ESP_HID_REPORT_TYPE_INPUT)) == NULL || !p_rpt->ccc.value) {
+        ESP_LOGE(TAG, "Indicate Not Enabled: %d", 0);
+        return ESP_FAIL;
+    }
+
+    //only as many reports in the air as there are timestamp slots, so every one stays measurable
+    portENTER_CRITICAL(&s_ll_lock);
+    if (dev->ll_ts_cnt >= sizeof(dev->ll_ts) / sizeof(dev->ll_ts[0])) {
+        dev->ll_dropped++;
+        portEXIT_CRITICAL(&s_ll_lock);
+        return ESP_ERR_NO_MEM;
+    }
+    uint8_t slot = (dev->ll_ts_head + dev->ll_ts_cnt) & (sizeof(dev->ll_ts) / sizeof(dev->ll_ts[0]) - 1);
+    dev->ll_ts[slot] = esp_timer_get_time();
+    dev->ll_ts_cnt++;
+    dev->ll_submitted++;
+    portEXIT_CRITICAL(&s_ll_lock);
+
+    esp_err_t err = esp_ble_gatts_send_indicate(dev->devices[index].hid_svc.gatt_if, dev->conn_id, p_rpt->handle, length, data, p_rpt->ccc.indicate_enable);
+    if (err != ESP_OK) {
+        //take the submission back, the controller queue refused it
+        portENTER_CRITICAL(&s_ll_lock);
+        dev->ll_ts_cnt--;
+        dev->ll_submitted--;
+        dev->ll_dropped++;
+        portEXIT_CRITICAL(&s_ll_lock);
+        ESP_LOGE(TAG, "Send Input Notify Failed: %d", err);
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t esp_ble_hidd_dev_report_latency_get(void *devp, esp_hidd_report_latency_t *latency)
+{
+    esp_ble_hidd_dev_t *dev = (esp_ble_hidd_dev_t *)devp;
+    if (!dev || s_dev != dev) {
+        return ESP_FAIL;
+    }
+    portENTER_CRITICAL(&s_ll_lock);
+    latency->submitted = dev->ll_submitted;
+    latency->completed = dev->ll_completed;
+    latency->dropped = dev->ll_dropped;
+    latency->last_us = dev->ll_last_us;
+    latency->max_us = dev->ll_max_us;
+    latency->avg_us = dev->ll_completed ? (uint32_t)(dev->ll_total_us / dev->ll_completed) : 0;
+    portEXIT_CRITICAL(&s_ll_lock);
+    return ESP_OK;
+}
+
+static esp_err_t esp_ble_hidd_dev_report_latency_reset(void *devp)
+{
+    esp_ble_hidd_dev_t *dev = (esp_ble_hidd_dev_t *)devp;
+    if (!dev || s_dev != dev) {
+        return ESP_FAIL;
+    }
+    portENTER_CRITICAL(&s_ll_lock);
+    dev->ll_submitted = 0;
+    dev->ll_completed = 0;
+    dev->ll_dropped = 0;
+    dev->ll_last_us = 0;
+    dev->ll_max_us = 0;
+    dev->ll_total_us = 0;
+    portEXIT_CRITICAL(&s_ll_lock);
+    return ESP_OK;
+}
+
 static esp_err_t esp_ble_hidd_dev_feature_set(void *devp, size_t index, size_t id, uint8_t *data, size_t length)
 {
     esp_err_t ret;
@@ -981,7 +1098,10 @@ esp_err_t esp_ble_hidd_dev_init(esp_hidd_dev_t *dev_p, const esp_hid_device_conf
     dev_p->deinit = esp_ble_hidd_dev_deinit;
     dev_p->battery_set = esp_ble_hidd_dev_battery_set;
     dev_p->input_set = esp_ble_hidd_dev_input_set;
+    dev_p->input_send = esp_ble_hidd_dev_input_send;
     dev_p->feature_set = esp_ble_hidd_dev_feature_set;
+    dev_p->report_latency_get = esp_ble_hidd_dev_report_latency_get;
+    dev_p->report_latency_reset = esp_ble_hidd_dev_report_latency_reset;
     dev_p->event_handler_register = esp_ble_hidd_dev_event_handler_register;
     dev_p->event_handler_unregister = esp_ble_hidd_dev_event_handler_unregister;
 
@@ -96,6 +96,39 @@ esp_err_t esp_hidd_dev_input_set(esp_hidd_dev_t *dev, size_t map_index, size_t r
     return dev->input_set(dev->dev, map_index, report_id, data, length);
 }
 
+esp_err_t esp_hidd_dev_input_send(esp_hidd_dev_t *dev, size_t map_index, size_t report_id, uint8_t *data, size_t length)
+{
+    if (dev == NULL) {
+        return ESP_FAIL;
+    }
+    if (dev->input_send == NULL) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    return dev->input_send(dev->dev, map_index, report_id, data, length);
+}
+
+esp_err_t esp_hidd_dev_report_latency_get(esp_hidd_dev_t *dev, esp_hidd_report_latency_t *latency)
+{
+    if (dev == NULL || latency == NULL) {
+        return ESP_FAIL;
+    }
+    if (dev->report_latency_get == NULL) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    return dev->report_latency_get(dev->dev, latency);
+}
+
+esp_err_t esp_hidd_dev_report_latency_reset(esp_hidd_dev_t *dev)
+{
+    if (dev == NULL) {
+        return ESP_FAIL;
+    }
+    if (dev->report_latency_reset == NULL) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    return dev->report_latency_reset(dev->dev);
+}
+
 esp_err_t esp_hidd_dev_feature_set(esp_hidd_dev_t *dev, size_t map_index, size_t report_id, uint8_t *data, size_t length)
 {
     if (dev == NULL) {
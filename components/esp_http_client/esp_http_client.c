@@ -31,6 +31,14 @@
 #include "esp_transport_ssl.h"
 #endif
 
+#ifdef CONFIG_ESP_HTTP_CLIENT_ENABLE_CONN_POOL
+#include "http_conn_pool.h"
+#endif
+
+#ifdef CONFIG_ESP_HTTP_CLIENT_DECOMPRESS_RESPONSES
+#include "esp_rom_miniz.h"
+#endif
+
 static const char *TAG = "HTTP_CLIENT";
 
 /**
@@ -75,6 +83,42 @@ typedef struct {
     int                          max_store_header_size;
 } connection_info_t;
 
+#ifdef CONFIG_ESP_HTTP_CLIENT_DECOMPRESS_RESPONSES
+typedef enum {
+    HTTP_CONTENT_ENCODING_NONE = 0,
+    HTTP_CONTENT_ENCODING_GZIP,
+    HTTP_CONTENT_ENCODING_DEFLATE,
+} http_content_encoding_t;
+
+/**
+ * gzip member header parser state (RFC 1952). The header precedes the raw
+ * deflate stream and may arrive split across any number of reads.
+ */
+typedef enum {
+    GZIP_HEADER_FIXED = 0,  /*!< 10 byte fixed part (magic, method, flags, mtime, xfl, os) */
+    GZIP_HEADER_XLEN,       /*!< 2 byte FEXTRA length */
+    GZIP_HEADER_EXTRA,      /*!< FEXTRA payload */
+    GZIP_HEADER_NAME,       /*!< zero-terminated FNAME */
+    GZIP_HEADER_COMMENT,    /*!< zero-terminated FCOMMENT */
+    GZIP_HEADER_HCRC,       /*!< 2 byte FHCRC */
+    GZIP_HEADER_DONE,
+} gzip_header_stage_t;
+
+/**
+ * Response decompression state, allocated only for responses which carry a
+ * supported Content-Encoding
+ */
+typedef struct {
+    esp_rom_miniz_inflate_t *inflate;    /*!< streaming inflate over ROM tinfl */
+    char                    *scratch;    /*!< staging buffer for decoded event data */
+    gzip_header_stage_t     hdr_stage;   /*!< gzip header parser position */
+    int                     hdr_count;   /*!< bytes consumed in the current header stage */
+    int                     hdr_xlen;    /*!< FEXTRA payload length */
+    uint8_t                 hdr_flags;   /*!< gzip FLG byte */
+    bool                    failed;      /*!< decode error, response unusable */
+} http_decoder_t;
+#endif // CONFIG_ESP_HTTP_CLIENT_DECOMPRESS_RESPONSES
+
 typedef enum {
     HTTP_STATE_UNINIT = 0,
     HTTP_STATE_INIT,
@@ -121,6 +165,13 @@ struct esp_http_client {
     bool                        first_line_prepared;
     int                         header_index;
     bool                        is_async;
+#ifdef CONFIG_ESP_HTTP_CLIENT_ENABLE_CONN_POOL
+    http_conn_pool_key_t        pool_key;
+#endif
+#ifdef CONFIG_ESP_HTTP_CLIENT_DECOMPRESS_RESPONSES
+    http_content_encoding_t     response_encoding;
+    http_decoder_t              *decoder;
+#endif
 };
 
 typedef struct esp_http_client esp_http_client_t;
@@ -164,6 +215,9 @@ static const char *HTTP_METHOD_MAPPING[] = {
 };
 
 static esp_err_t esp_http_client_request_send(esp_http_client_handle_t client, int write_len);
+#ifdef CONFIG_ESP_HTTP_CLIENT_DECOMPRESS_RESPONSES
+static void http_decoder_free(esp_http_client_handle_t client);
+#endif
 static esp_err_t esp_http_client_connect(esp_http_client_handle_t client);
 static esp_err_t esp_http_client_send_post_data(esp_http_client_handle_t client);
 
@@ -223,6 +277,14 @@ static int http_on_header_value(http_parser *parser, const char *at, size_t leng
         client->response->is_chunked = true;
     } else if (strcasecmp(client->current_header_key, "WWW-Authenticate") == 0) {
         http_utils_assign_string(&client->auth_header, at, length);
+#ifdef CONFIG_ESP_HTTP_CLIENT_DECOMPRESS_RESPONSES
+    } else if (strcasecmp(client->current_header_key, "Content-Encoding") == 0) {
+        if (length == 4 && strncasecmp(at, "gzip", length) == 0) {
+            client->response_encoding = HTTP_CONTENT_ENCODING_GZIP;
+        } else if (length == 7 && strncasecmp(at, "deflate", length) == 0) {
+            client->response_encoding = HTTP_CONTENT_ENCODING_DEFLATE;
+        }
+#endif
     }
     http_utils_assign_string(&client->current_header_value, at, length);
 
@@ -253,14 +315,35 @@ static int http_on_body(http_parser *parser, const char *at, size_t length)
 {
     esp_http_client_t *client = parser->data;
     ESP_LOGD(TAG, "http_on_body %d", length);
-    client->response->buffer->raw_data = (char *)at;
-    if (client->response->buffer->output_ptr) {
-        memcpy(client->response->buffer->output_ptr, (char *)at, length);
-        client->response->buffer->output_ptr += length;
+    esp_http_buffer_t *res_buffer = client->response->buffer;
+#ifdef CONFIG_ESP_HTTP_CLIENT_DECOMPRESS_RESPONSES
+    if (client->response_encoding != HTTP_CONTENT_ENCODING_NONE) {
+        /* Compressed body: always accumulate the raw bytes; the decoder
+         * copies to the output buffer and dispatches the data events with
+         * the decoded bytes instead */
+        if (res_buffer->raw_len == 0) {
+            res_buffer->raw_data = (char *)at;
+        } else if (res_buffer->raw_data + res_buffer->raw_len != at) {
+            memmove(res_buffer->raw_data + res_buffer->raw_len, at, length);
+        }
+        client->response->data_process += length;
+        res_buffer->raw_len += length;
+        return 0;
+    }
+#endif
+    if (res_buffer->output_ptr) {
+        memcpy(res_buffer->output_ptr, (char *)at, length);
+        res_buffer->output_ptr += length;
+    } else if (res_buffer->raw_len == 0) {
+        res_buffer->raw_data = (char *)at;
+    } else if (res_buffer->raw_data + res_buffer->raw_len != at) {
+        /* Body pieces separated by chunk headers: compact them so that
+         * raw_data .. raw_data + raw_len is always one contiguous run */
+        memmove(res_buffer->raw_data + res_buffer->raw_len, at, length);
     }
 
     client->response->data_process += length;
-    client->response->buffer->raw_len += length;
+    res_buffer->raw_len += length;
     http_dispatch_event(client, HTTP_EVENT_ON_DATA, (void *)at, length);
     return 0;
 }
@@ -491,6 +574,10 @@ static esp_err_t esp_http_client_prepare(esp_http_client_handle_t client)
     client->process_again = 0;
     client->response->data_process = 0;
     client->first_line_prepared = false;
+#ifdef CONFIG_ESP_HTTP_CLIENT_DECOMPRESS_RESPONSES
+    /* Also resets response_encoding for the upcoming response */
+    http_decoder_free(client);
+#endif
     http_parser_init(client->parser, HTTP_RESPONSE);
     if (client->connection_info.username) {
         char *auth_response = NULL;
@@ -596,6 +683,16 @@ esp_http_client_handle_t esp_http_client_init(const esp_http_client_config_t *co
     }
 #endif
 
+#ifdef CONFIG_ESP_HTTP_CLIENT_ENABLE_CONN_POOL
+    /* Remember the TLS configuration the transports were set up with, so
+     * that connections are only shared between identically configured handles */
+    client->pool_key.cert_pem = config->cert_pem;
+    client->pool_key.client_cert_pem = config->client_cert_pem;
+    client->pool_key.client_key_pem = config->client_key_pem;
+    client->pool_key.use_global_ca_store = config->use_global_ca_store;
+    client->pool_key.skip_cert_common_name_check = config->skip_cert_common_name_check;
+#endif
+
     if (_set_config(client, config) != ESP_OK) {
         ESP_LOGE(TAG, "Error set configurations");
         goto error;
@@ -651,6 +748,13 @@ esp_http_client_handle_t esp_http_client_init(const esp_http_client_config_t *co
         goto error;
     }
 
+#ifdef CONFIG_ESP_HTTP_CLIENT_DECOMPRESS_RESPONSES
+    if (esp_http_client_set_header(client, "Accept-Encoding", "gzip, deflate") != ESP_OK) {
+        ESP_LOGE(TAG, "Error while setting default configurations");
+        goto error;
+    }
+#endif
+
     client->parser_settings->on_message_begin = http_on_message_begin;
     client->parser_settings->on_url = http_on_url;
     client->parser_settings->on_status = http_on_status;
@@ -676,8 +780,30 @@ esp_err_t esp_http_client_cleanup(esp_http_client_handle_t client)
     if (client == NULL) {
         return ESP_FAIL;
     }
+#ifdef CONFIG_ESP_HTTP_CLIENT_ENABLE_CONN_POOL
+    /* Park the connection for reuse by the next handle targeting the same
+     * server. esp_http_client_perform() only leaves the state at CONNECTED
+     * after a fully read keep-alive response, so anything else (streaming
+     * reads with unread body, errors) is closed as before */
+    bool conn_pooled = false;
+    if (client->state == HTTP_STATE_CONNECTED
+            && http_should_keep_alive(client->parser)
+            && client->connection_info.scheme != NULL
+            && client->connection_info.host != NULL) {
+        conn_pooled = (http_conn_pool_store(client->connection_info.scheme,
+                                            client->connection_info.host,
+                                            client->connection_info.port,
+                                            &client->pool_key,
+                                            client->transport_list) == ESP_OK);
+    }
+    if (!conn_pooled) {
+        esp_http_client_close(client);
+        esp_transport_list_destroy(client->transport_list);
+    }
+#else
     esp_http_client_close(client);
     esp_transport_list_destroy(client->transport_list);
+#endif
     if (client->request) {
         http_header_destroy(client->request->headers);
         if (client->request->buffer) {
@@ -695,6 +821,9 @@ esp_err_t esp_http_client_cleanup(esp_http_client_handle_t client)
         free(client->response);
     }
 
+#ifdef CONFIG_ESP_HTTP_CLIENT_DECOMPRESS_RESPONSES
+    http_decoder_free(client);
+#endif
     free(client->parser);
     free(client->parser_settings);
     _clear_connection_info(client);
@@ -850,6 +979,178 @@ esp_err_t esp_http_client_set_method(esp_http_client_handle_t client, esp_http_c
     return ESP_OK;
 }
 
+#ifdef CONFIG_ESP_HTTP_CLIENT_DECOMPRESS_RESPONSES
+static void http_decoder_free(esp_http_client_handle_t client)
+{
+    if (client->decoder) {
+        esp_rom_miniz_inflate_free(client->decoder->inflate);
+        free(client->decoder->scratch);
+        free(client->decoder);
+        client->decoder = NULL;
+    }
+    client->response_encoding = HTTP_CONTENT_ENCODING_NONE;
+}
+
+static esp_err_t http_decoder_begin(esp_http_client_handle_t client)
+{
+    http_decoder_t *decoder = calloc(1, sizeof(http_decoder_t));
+    if (decoder == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    /* gzip wraps a raw deflate stream in its own framing, the HTTP "deflate"
+     * encoding is a zlib stream */
+    decoder->inflate = esp_rom_miniz_inflate_new(client->response_encoding == HTTP_CONTENT_ENCODING_DEFLATE);
+    decoder->scratch = malloc(client->buffer_size_rx);
+    if (decoder->inflate == NULL || decoder->scratch == NULL) {
+        esp_rom_miniz_inflate_free(decoder->inflate);
+        free(decoder->scratch);
+        free(decoder);
+        return ESP_ERR_NO_MEM;
+    }
+    if (client->response_encoding == HTTP_CONTENT_ENCODING_DEFLATE) {
+        decoder->hdr_stage = GZIP_HEADER_DONE;
+    }
+    client->decoder = decoder;
+    return ESP_OK;
+}
+
+/* Next gzip header stage once the stage before `after` is consumed, based on
+ * the FLG byte (optional fields in order: FEXTRA, FNAME, FCOMMENT, FHCRC) */
+static gzip_header_stage_t gzip_next_stage(uint8_t flags, gzip_header_stage_t after)
+{
+    if (after <= GZIP_HEADER_EXTRA && (flags & 0x08)) {
+        return GZIP_HEADER_NAME;
+    }
+    if (after <= GZIP_HEADER_NAME && (flags & 0x10)) {
+        return GZIP_HEADER_COMMENT;
+    }
+    if (after <= GZIP_HEADER_COMMENT && (flags & 0x02)) {
+        return GZIP_HEADER_HCRC;
+    }
+    return GZIP_HEADER_DONE;
+}
+
+/* Consume the gzip member header from the front of `in`. Returns the number
+ * of bytes consumed (the header may continue in the next read), or -1 if the
+ * data is not a gzip stream */
+static int http_decoder_skip_gzip_header(http_decoder_t *decoder, const uint8_t *in, int len)
+{
+    static const uint8_t magic[3] = {0x1f, 0x8b, 8 /* deflate */};
+    int pos = 0;
+    while (pos < len && decoder->hdr_stage != GZIP_HEADER_DONE) {
+        uint8_t byte = in[pos];
+        switch (decoder->hdr_stage) {
+            case GZIP_HEADER_FIXED:
+                if (decoder->hdr_count < 3 && byte != magic[decoder->hdr_count]) {
+                    return -1;
+                }
+                if (decoder->hdr_count == 3) {
+                    decoder->hdr_flags = byte;
+                }
+                pos++;
+                if (++decoder->hdr_count == 10) {
+                    decoder->hdr_stage = (decoder->hdr_flags & 0x04) ? GZIP_HEADER_XLEN
+                                         : gzip_next_stage(decoder->hdr_flags, GZIP_HEADER_EXTRA);
+                    decoder->hdr_count = 0;
+                }
+                break;
+            case GZIP_HEADER_XLEN:
+                decoder->hdr_xlen |= byte << (8 * decoder->hdr_count);
+                pos++;
+                if (++decoder->hdr_count == 2) {
+                    decoder->hdr_stage = decoder->hdr_xlen ? GZIP_HEADER_EXTRA
+                                         : gzip_next_stage(decoder->hdr_flags, GZIP_HEADER_EXTRA);
+                    decoder->hdr_count = 0;
+                }
+                break;
+            case GZIP_HEADER_EXTRA: {
+                int n = len - pos;
+                if (n > decoder->hdr_xlen - decoder->hdr_count) {
+                    n = decoder->hdr_xlen - decoder->hdr_count;
+                }
+                pos += n;
+                decoder->hdr_count += n;
+                if (decoder->hdr_count == decoder->hdr_xlen) {
+                    decoder->hdr_stage = gzip_next_stage(decoder->hdr_flags, GZIP_HEADER_EXTRA);
+                    decoder->hdr_count = 0;
+                }
+                break;
+            }
+            case GZIP_HEADER_NAME:
+            case GZIP_HEADER_COMMENT:
+                pos++;
+                if (byte == 0) {
+                    decoder->hdr_stage = gzip_next_stage(decoder->hdr_flags, decoder->hdr_stage);
+                }
+                break;
+            case GZIP_HEADER_HCRC:
+                pos++;
+                if (++decoder->hdr_count == 2) {
+                    decoder->hdr_stage = GZIP_HEADER_DONE;
+                    decoder->hdr_count = 0;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return pos;
+}
+
+/* Inflate the raw body bytes buffered by http_on_body. Each decoded piece is
+ * dispatched as a HTTP_EVENT_ON_DATA event and, when out is not NULL, stored
+ * there (at most out_cap bytes; surplus decoded data stays buffered in the
+ * decoder until the next call). Returns the number of bytes stored to out,
+ * or ESP_FAIL if the stream is corrupt */
+static int http_decoder_drain(esp_http_client_handle_t client, char *out, int out_cap)
+{
+    http_decoder_t *decoder = client->decoder;
+    esp_http_buffer_t *res_buffer = client->response->buffer;
+    if (decoder->failed) {
+        return ESP_FAIL;
+    }
+    if (decoder->hdr_stage != GZIP_HEADER_DONE && res_buffer->raw_len > 0) {
+        int used = http_decoder_skip_gzip_header(decoder, (const uint8_t *)res_buffer->raw_data, res_buffer->raw_len);
+        if (used < 0) {
+            ESP_LOGE(TAG, "Response is not a valid gzip stream");
+            decoder->failed = true;
+            return ESP_FAIL;
+        }
+        res_buffer->raw_data += used;
+        res_buffer->raw_len -= used;
+    }
+    bool last = esp_http_client_is_complete_data_received(client);
+    int produced = 0;
+    while (true) {
+        char *dst = out ? out + produced : decoder->scratch;
+        size_t out_len = out ? (size_t)(out_cap - produced) : (size_t)client->buffer_size_rx;
+        if (out_len == 0) {
+            break;
+        }
+        size_t in_len = res_buffer->raw_len;
+        esp_err_t err = esp_rom_miniz_inflate(decoder->inflate, res_buffer->raw_data, &in_len,
+                                              dst, &out_len, last);
+        res_buffer->raw_data += in_len;
+        res_buffer->raw_len -= in_len;
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Error decompressing response body");
+            decoder->failed = true;
+            return ESP_FAIL;
+        }
+        if (esp_rom_miniz_inflate_finished(decoder->inflate)) {
+            /* Anything left over is the gzip trailer (CRC32 and size) */
+            res_buffer->raw_len = 0;
+        }
+        if (out_len == 0) {
+            break;
+        }
+        http_dispatch_event(client, HTTP_EVENT_ON_DATA, dst, out_len);
+        produced += out_len;
+    }
+    return produced;
+}
+#endif // CONFIG_ESP_HTTP_CLIENT_DECOMPRESS_RESPONSES
+
 static int esp_http_client_get_data(esp_http_client_handle_t client)
 {
     if (client->state < HTTP_STATE_RES_COMPLETE_HEADER) {
@@ -867,6 +1168,16 @@ static int esp_http_client_get_data(esp_http_client_handle_t client)
     int rlen = esp_transport_read(client->transport, res_buffer->data, client->buffer_size_rx, client->timeout_ms);
     if (rlen >= 0) {
         http_parser_execute(client->parser, client->parser_settings, res_buffer->data, rlen);
+#ifdef CONFIG_ESP_HTTP_CLIENT_DECOMPRESS_RESPONSES
+        if (client->response_encoding != HTTP_CONTENT_ENCODING_NONE) {
+            if (client->decoder == NULL && http_decoder_begin(client) != ESP_OK) {
+                return ESP_FAIL;
+            }
+            if (http_decoder_drain(client, NULL, 0) < 0) {
+                return ESP_FAIL;
+            }
+        }
+#endif
     }
     return rlen;
 }
@@ -887,10 +1198,61 @@ bool esp_http_client_is_complete_data_received(esp_http_client_handle_t client)
     return true;
 }
 
+#ifdef CONFIG_ESP_HTTP_CLIENT_DECOMPRESS_RESPONSES
+/* esp_http_client_read for responses with a supported Content-Encoding:
+ * returns decompressed data, so the total read will not match the
+ * (compressed) content_length */
+static int esp_http_client_read_decoded(esp_http_client_handle_t client, char *buffer, int len)
+{
+    esp_http_buffer_t *res_buffer = client->response->buffer;
+    if (client->decoder == NULL && http_decoder_begin(client) != ESP_OK) {
+        return ESP_FAIL;
+    }
+    /* First deliver data pending in the decoder and in the raw buffer
+     * (body bytes may already have been consumed along with the headers) */
+    int ridx = http_decoder_drain(client, buffer, len);
+    if (ridx < 0) {
+        return ESP_FAIL;
+    }
+    while (ridx < len && !esp_rom_miniz_inflate_finished(client->decoder->inflate)) {
+        if (esp_http_client_is_complete_data_received(client)) {
+            break;
+        }
+        errno = 0;
+        int rlen = esp_transport_read(client->transport, res_buffer->data, client->buffer_size_rx, client->timeout_ms);
+        if (rlen <= 0) {
+            if (errno != 0) {
+                esp_log_level_t sev = ESP_LOG_WARN;
+                if (rlen == -1 && errno == ENOTCONN && client->response->is_chunked) {
+                    /* Explicit call to parser for invoking `message_complete` callback */
+                    http_parser_execute(client->parser, client->parser_settings, res_buffer->data, 0);
+                    sev = ESP_LOG_DEBUG;
+                }
+                ESP_LOG_LEVEL(sev, TAG, "esp_transport_read returned:%d and errno:%d ", rlen, errno);
+            }
+            return (rlen < 0 && ridx == 0) ? ESP_FAIL : ridx;
+        }
+        http_parser_execute(client->parser, client->parser_settings, res_buffer->data, rlen);
+        int decoded = http_decoder_drain(client, buffer + ridx, len - ridx);
+        if (decoded < 0) {
+            return ESP_FAIL;
+        }
+        ridx += decoded;
+    }
+    return ridx;
+}
+#endif // CONFIG_ESP_HTTP_CLIENT_DECOMPRESS_RESPONSES
+
 int esp_http_client_read(esp_http_client_handle_t client, char *buffer, int len)
 {
     esp_http_buffer_t *res_buffer = client->response->buffer;
 
+#ifdef CONFIG_ESP_HTTP_CLIENT_DECOMPRESS_RESPONSES
+    if (client->response_encoding != HTTP_CONTENT_ENCODING_NONE) {
+        return esp_http_client_read_decoded(client, buffer, len);
+    }
+#endif
+
     int rlen = ESP_FAIL, ridx = 0;
     if (res_buffer->raw_len) {
         int remain_len = client->response->buffer->raw_len;
@@ -953,6 +1315,55 @@ int esp_http_client_read(esp_http_client_handle_t client, char *buffer, int len)
     return ridx;
 }
 
+int esp_http_client_peek(esp_http_client_handle_t client, const char **data)
+{
+    if (client == NULL || data == NULL) {
+        return ESP_FAIL;
+    }
+    esp_http_buffer_t *res_buffer = client->response->buffer;
+    *data = NULL;
+
+    /* Refill the internal buffer until it holds body data or the body ends.
+     * A single transport read may carry only protocol overhead (chunk
+     * headers, trailers), in which case reading continues */
+    while (res_buffer->raw_len == 0) {
+        bool is_data_remain;
+        if (client->response->is_chunked) {
+            is_data_remain = !client->is_chunk_complete;
+        } else {
+            is_data_remain = client->response->data_process < client->response->content_length;
+        }
+        if (!is_data_remain) {
+            return 0;
+        }
+        errno = 0;
+        int rlen = esp_transport_read(client->transport, res_buffer->data, client->buffer_size_rx, client->timeout_ms);
+        if (rlen <= 0) {
+            if (errno != 0) {
+                ESP_LOGW(TAG, "esp_transport_read returned:%d and errno:%d ", rlen, errno);
+            }
+            return (rlen < 0) ? ESP_FAIL : 0;
+        }
+        http_parser_execute(client->parser, client->parser_settings, res_buffer->data, rlen);
+    }
+    *data = res_buffer->raw_data;
+    return res_buffer->raw_len;
+}
+
+int esp_http_client_consume(esp_http_client_handle_t client, int len)
+{
+    if (client == NULL || len < 0) {
+        return ESP_FAIL;
+    }
+    esp_http_buffer_t *res_buffer = client->response->buffer;
+    if (len > res_buffer->raw_len) {
+        len = res_buffer->raw_len;
+    }
+    res_buffer->raw_data += len;
+    res_buffer->raw_len -= len;
+    return len;
+}
+
 esp_err_t esp_http_client_perform(esp_http_client_handle_t client)
 {
     esp_err_t err;
@@ -1080,6 +1491,32 @@ static esp_err_t esp_http_client_connect(esp_http_client_handle_t client)
     }
 
     if (client->state < HTTP_STATE_CONNECTED) {
+#ifdef CONFIG_ESP_HTTP_CLIENT_ENABLE_CONN_POOL
+        if (!client->is_async) {
+            bool still_connected = false;
+            esp_transport_list_handle_t pooled = http_conn_pool_claim(client->connection_info.scheme,
+                                                                      client->connection_info.host,
+                                                                      client->connection_info.port,
+                                                                      &client->pool_key,
+                                                                      &still_connected);
+            if (pooled) {
+                /* Adopt the pooled transport list; it was configured with
+                 * the same TLS material as this handle's own list */
+                esp_transport_list_destroy(client->transport_list);
+                client->transport_list = pooled;
+                if (still_connected) {
+                    client->transport = esp_transport_list_get_transport(pooled, client->connection_info.scheme);
+                    if (client->transport) {
+                        ESP_LOGD(TAG, "Reusing connection to: %s://%s:%d", client->connection_info.scheme, client->connection_info.host, client->connection_info.port);
+                        client->state = HTTP_STATE_CONNECTED;
+                        http_dispatch_event(client, HTTP_EVENT_ON_CONNECTED, NULL, 0);
+                        return ESP_OK;
+                    }
+                }
+                /* Stale entry: the claim already closed it, reconnect below */
+            }
+        }
+#endif
         ESP_LOGD(TAG, "Begin connect to: %s://%s:%d", client->connection_info.scheme, client->connection_info.host, client->connection_info.port);
         client->transport = esp_transport_list_get_transport(client->transport_list, client->connection_info.scheme);
         if (client->transport == NULL) {
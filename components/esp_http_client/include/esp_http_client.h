@@ -416,6 +416,36 @@ bool esp_http_client_is_chunked_response(esp_http_client_handle_t client);
  */
 int esp_http_client_read(esp_http_client_handle_t client, char *buffer, int len);
 
+/**
+ * @brief      Borrow a view of response body data from the client's internal buffer
+ *
+ *             Unlike `esp_http_client_read` no copy is made: *data is pointed at the
+ *             internal receive buffer, which stays valid until the next call into the
+ *             client. After processing some of the bytes, call `esp_http_client_consume`;
+ *             unconsumed bytes are returned again by the next peek. This allows e.g.
+ *             writing downloaded data straight to flash without an intermediate buffer.
+ *
+ * @param[in]  client  The esp_http_client handle
+ * @param[out] data    Set to the start of the buffered body data
+ *
+ * @return
+ *     - (-1) if any errors
+ *     - (0) if the complete response body has been received
+ *     - Number of body bytes available at *data
+ */
+int esp_http_client_peek(esp_http_client_handle_t client, const char **data);
+
+/**
+ * @brief      Mark body bytes previously returned by `esp_http_client_peek` as processed
+ *
+ * @param[in]  client  The esp_http_client handle
+ * @param[in]  len     Number of bytes to consume, at most the last peek's return value
+ *
+ * @return
+ *     - (-1) if any errors
+ *     - Number of bytes actually consumed
+ */
+int esp_http_client_consume(esp_http_client_handle_t client, int len);
 
 /**
  * @brief      Get http response status code, the valid value if this function invoke after `esp_http_client_perform`
@@ -0,0 +1,186 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+#include "http_conn_pool.h"
+
+#ifdef CONFIG_ESP_HTTP_CLIENT_ENABLE_CONN_POOL
+
+static const char *TAG = "HTTP_CONN_POOL";
+
+typedef struct {
+    bool used;
+    char *scheme;
+    char *host;
+    int port;
+    http_conn_pool_key_t key;
+    esp_transport_list_handle_t transport_list;
+} http_conn_pool_entry_t;
+
+/* The pool is shared by every client handle in the system. Entries are
+ * claimed/stored under a spinlock; only pointer and string comparisons
+ * happen inside the critical section, the actual socket work (liveness
+ * probe, close, destroy) is done by the caller outside of it. */
+static http_conn_pool_entry_t s_pool[CONFIG_ESP_HTTP_CLIENT_CONN_POOL_SIZE];
+static portMUX_TYPE s_pool_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static bool http_conn_pool_entry_matches(const http_conn_pool_entry_t *entry,
+                                         const char *scheme, const char *host, int port,
+                                         const http_conn_pool_key_t *key)
+{
+    return entry->port == port
+           && strcasecmp(entry->scheme, scheme) == 0
+           && strcasecmp(entry->host, host) == 0
+           && entry->key.cert_pem == key->cert_pem
+           && entry->key.client_cert_pem == key->client_cert_pem
+           && entry->key.client_key_pem == key->client_key_pem
+           && entry->key.use_global_ca_store == key->use_global_ca_store
+           && entry->key.skip_cert_common_name_check == key->skip_cert_common_name_check;
+}
+
+static void http_conn_pool_discard(const char *scheme, char *entry_scheme, char *entry_host,
+                                   esp_transport_list_handle_t transport_list)
+{
+    esp_transport_handle_t transport = esp_transport_list_get_transport(transport_list, scheme);
+    if (transport) {
+        esp_transport_close(transport);
+    }
+    esp_transport_list_destroy(transport_list);
+    free(entry_scheme);
+    free(entry_host);
+}
+
+esp_err_t http_conn_pool_store(const char *scheme, const char *host, int port,
+                               const http_conn_pool_key_t *key,
+                               esp_transport_list_handle_t transport_list)
+{
+    if (scheme == NULL || host == NULL || key == NULL || transport_list == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    char *scheme_copy = strdup(scheme);
+    char *host_copy = strdup(host);
+    if (scheme_copy == NULL || host_copy == NULL) {
+        free(scheme_copy);
+        free(host_copy);
+        return ESP_ERR_NO_MEM;
+    }
+
+    /* The connection being stored is newer than any matching entry, so a
+     * match is replaced and the older connection is dropped */
+    char *evict_scheme = NULL;
+    char *evict_host = NULL;
+    esp_transport_list_handle_t evict_list = NULL;
+
+    portENTER_CRITICAL(&s_pool_lock);
+    http_conn_pool_entry_t *slot = NULL;
+    for (int i = 0; i < CONFIG_ESP_HTTP_CLIENT_CONN_POOL_SIZE; i++) {
+        http_conn_pool_entry_t *entry = &s_pool[i];
+        if (!entry->used) {
+            if (slot == NULL) {
+                slot = entry;
+            }
+            continue;
+        }
+        if (http_conn_pool_entry_matches(entry, scheme, host, port, key)) {
+            evict_scheme = entry->scheme;
+            evict_host = entry->host;
+            evict_list = entry->transport_list;
+            slot = entry;
+            break;
+        }
+    }
+    if (slot) {
+        slot->used = true;
+        slot->scheme = scheme_copy;
+        slot->host = host_copy;
+        slot->port = port;
+        slot->key = *key;
+        slot->transport_list = transport_list;
+    }
+    portEXIT_CRITICAL(&s_pool_lock);
+
+    if (evict_list) {
+        ESP_LOGD(TAG, "Replacing pooled connection to %s:%d", host, port);
+        http_conn_pool_discard(scheme, evict_scheme, evict_host, evict_list);
+    }
+    if (slot == NULL) {
+        ESP_LOGD(TAG, "Pool full, not keeping connection to %s:%d", host, port);
+        free(scheme_copy);
+        free(host_copy);
+        return ESP_ERR_NO_MEM;
+    }
+    ESP_LOGD(TAG, "Pooled connection to %s:%d", host, port);
+    return ESP_OK;
+}
+
+esp_transport_list_handle_t http_conn_pool_claim(const char *scheme, const char *host, int port,
+                                                 const http_conn_pool_key_t *key,
+                                                 bool *still_connected)
+{
+    *still_connected = false;
+    if (scheme == NULL || host == NULL || key == NULL) {
+        return NULL;
+    }
+
+    char *entry_scheme = NULL;
+    char *entry_host = NULL;
+    esp_transport_list_handle_t transport_list = NULL;
+
+    portENTER_CRITICAL(&s_pool_lock);
+    for (int i = 0; i < CONFIG_ESP_HTTP_CLIENT_CONN_POOL_SIZE; i++) {
+        http_conn_pool_entry_t *entry = &s_pool[i];
+        if (entry->used && http_conn_pool_entry_matches(entry, scheme, host, port, key)) {
+            entry->used = false;
+            entry_scheme = entry->scheme;
+            entry_host = entry->host;
+            transport_list = entry->transport_list;
+            entry->scheme = NULL;
+            entry->host = NULL;
+            entry->transport_list = NULL;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_pool_lock);
+
+    if (transport_list == NULL) {
+        return NULL;
+    }
+    free(entry_scheme);
+    free(entry_host);
+
+    /* An idle keep-alive connection has nothing to read. Anything else
+     * (pending bytes, EOF, poll error) means the server closed it or the
+     * previous response was not fully drained, so start over */
+    esp_transport_handle_t transport = esp_transport_list_get_transport(transport_list, scheme);
+    if (transport && esp_transport_poll_read(transport, 0) == 0) {
+        ESP_LOGD(TAG, "Reusing pooled connection to %s:%d", host, port);
+        *still_connected = true;
+    } else {
+        ESP_LOGD(TAG, "Pooled connection to %s:%d went stale", host, port);
+        if (transport) {
+            esp_transport_close(transport);
+        }
+    }
+    return transport_list;
+}
+
+#endif /* CONFIG_ESP_HTTP_CLIENT_ENABLE_CONN_POOL */
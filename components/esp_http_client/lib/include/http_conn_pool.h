@@ -0,0 +1,86 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _HTTP_CONN_POOL_H_
+#define _HTTP_CONN_POOL_H_
+
+#include <stdbool.h>
+#include "esp_err.h"
+#include "esp_transport.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * TLS part of the pool key. Connections are only shared between client
+ * handles configured with the very same certificate buffers, so the
+ * pointers themselves (not the contents) are compared.
+ */
+typedef struct {
+    const char *cert_pem;                /*!< Server CA certificate from esp_http_client_config_t */
+    const char *client_cert_pem;         /*!< Client certificate from esp_http_client_config_t */
+    const char *client_key_pem;          /*!< Client key from esp_http_client_config_t */
+    bool use_global_ca_store;            /*!< Whether the global CA store was enabled */
+    bool skip_cert_common_name_check;    /*!< Whether common name verification was skipped */
+} http_conn_pool_key_t;
+
+/**
+ * @brief      Park a connected transport list in the pool for later reuse
+ *
+ * Ownership of the transport list passes to the pool on success. If an
+ * entry for the same (scheme, host, port, key) already exists it is
+ * replaced, the older connection being closed and destroyed.
+ *
+ * @param[in]  scheme          Scheme the connection was established with ("http"/"https")
+ * @param[in]  host            Remote hostname
+ * @param[in]  port            Remote port
+ * @param[in]  key             TLS configuration the list was set up with
+ * @param[in]  transport_list  The connected transport list to park
+ *
+ * @return
+ *  - ESP_OK on success (the caller must no longer touch the list)
+ *  - ESP_ERR_NO_MEM if the pool is full or allocation failed (the caller keeps ownership)
+ *  - ESP_ERR_INVALID_ARG on null arguments
+ */
+esp_err_t http_conn_pool_store(const char *scheme, const char *host, int port,
+                               const http_conn_pool_key_t *key,
+                               esp_transport_list_handle_t transport_list);
+
+/**
+ * @brief      Take a matching transport list out of the pool
+ *
+ * The returned list is always removed from the pool and owned by the
+ * caller. *still_connected tells whether the parked connection is still
+ * idle and usable; if the peer closed it in the meantime the transport
+ * has already been closed and the caller should reconnect over the
+ * returned (fully configured) list.
+ *
+ * @param[in]  scheme           Scheme to match
+ * @param[in]  host             Remote hostname to match
+ * @param[in]  port             Remote port to match
+ * @param[in]  key              TLS configuration to match
+ * @param[out] still_connected  Set to true if the connection can be reused as is
+ *
+ * @return The pooled transport list, or NULL if no entry matches
+ */
+esp_transport_list_handle_t http_conn_pool_claim(const char *scheme, const char *host, int port,
+                                                 const http_conn_pool_key_t *key,
+                                                 bool *still_connected);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
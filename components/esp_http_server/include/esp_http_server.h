@@ -933,6 +933,36 @@ esp_err_t httpd_req_get_url_query_str(httpd_req_t *r, char *buf, size_t buf_len)
  */
 esp_err_t httpd_query_key_value(const char *qry, const char *key, char *val, size_t val_size);
 
+#ifdef CONFIG_HTTPD_URI_TRIE_DISPATCH
+/**
+ * @brief   Get the value of a path parameter captured during URI dispatch
+ *
+ * When the radix tree dispatcher is enabled (HTTPD_URI_TRIE_DISPATCH) and no
+ * custom uri_match_fn is configured, a path segment of a registered URI that
+ * starts with ':' matches any single segment of the request path, e.g. the
+ * template "/users/:id/name" matches "/users/42/name" with parameter "id"
+ * set to "42". This function retrieves such a value inside the URI handler.
+ *
+ * @note
+ *  - The parameter values are not URLdecoded
+ *  - If actual value size is greater than val_size, then the value is
+ *    truncated, accompanied by truncation error as return value
+ *
+ * @param[in]  r         The request being responded to
+ * @param[in]  name      Name of the parameter, without the leading ':'
+ * @param[out] val       Pointer to the buffer into which the value will be copied if found
+ * @param[in]  val_size  Size of the user buffer "val"
+ *
+ * @return
+ *  - ESP_OK : Parameter found and copied to buffer
+ *  - ESP_ERR_NOT_FOUND          : Parameter not present in the matched template
+ *  - ESP_ERR_INVALID_ARG        : Null arguments
+ *  - ESP_ERR_HTTPD_INVALID_REQ  : Invalid HTTP request pointer
+ *  - ESP_ERR_HTTPD_RESULT_TRUNC : Value string truncated
+ */
+esp_err_t httpd_req_get_path_param(httpd_req_t *r, const char *name, char *val, size_t val_size);
+#endif /* CONFIG_HTTPD_URI_TRIE_DISPATCH */
+
 /**
  * @brief Test if a URI matches the given wildcard template.
  *
@@ -996,6 +1026,44 @@ bool httpd_uri_match_wildcard(const char *uri_template, const char *uri_to_match
  */
 esp_err_t httpd_resp_send(httpd_req_t *r, const char *buf, ssize_t buf_len);
 
+/**
+ * @brief   Buffer descriptor for httpd_resp_send_vec()
+ */
+typedef struct httpd_iovec {
+    const void *iov_base;   /*!< Pointer to the data */
+    size_t      iov_len;    /*!< Length of the data in bytes */
+} httpd_iovec_t;
+
+/**
+ * @brief   API to send a complete HTTP response from multiple buffers.
+ *
+ * Vectored variant of httpd_resp_send(): the response body is gathered
+ * from an array of buffers (e.g. a constant JSON prefix, a flash-mapped
+ * asset and a generated suffix) without assembling them into one
+ * allocation first. All response headers, including those added with
+ * httpd_resp_set_hdr(), are coalesced into the internal scratch buffer
+ * and pushed with as few socket writes as possible, instead of one
+ * write per header fragment; body buffers are sent in place with no
+ * intermediate copy, so stable buffers (flash-mapped assets, DMA-safe
+ * framebuffers) go to the socket directly.
+ *
+ * The same notes as for httpd_resp_send() apply: call only from a URI
+ * handler context, the request is responded to afterwards, and request
+ * headers are purged.
+ *
+ * @param[in] r      The request being responded to
+ * @param[in] vec    Array of buffers forming the response body, in order
+ * @param[in] count  Number of entries in vec (may be 0 for an empty body)
+ *
+ * @return
+ *  - ESP_OK : On successfully sending the response packet
+ *  - ESP_ERR_INVALID_ARG : Null request pointer, or count > 0 with null vec
+ *  - ESP_ERR_HTTPD_RESP_HDR    : Essential headers are too large for internal buffer
+ *  - ESP_ERR_HTTPD_RESP_SEND   : Error in raw send
+ *  - ESP_ERR_HTTPD_INVALID_REQ : Invalid request
+ */
+esp_err_t httpd_resp_send_vec(httpd_req_t *r, const httpd_iovec_t *vec, size_t count);
+
 /**
  * @brief   API to send one HTTP chunk
  *
@@ -1523,6 +1591,99 @@ typedef void (*httpd_work_fn_t)(void *arg);
  */
 esp_err_t httpd_queue_work(httpd_handle_t handle, httpd_work_fn_t work, void *arg);
 
+#ifdef CONFIG_HTTPD_ASYNC_SUPPORT
+/**
+ * @brief   Start an asynchronous request
+ *
+ * This function can be called in a request handler to take ownership of the
+ * request and respond to it from outside the server task, typically from a
+ * worker function submitted through httpd_queue_work_async(). The server
+ * loop stops servicing the underlying socket until the asynchronous
+ * response is finished, so other clients keep getting serviced while a
+ * slow handler is in progress.
+ *
+ * Any request body should be read before calling this, as remaining body
+ * data is purged when the original handler returns.
+ *
+ * @note    All asynchronous requests must be completed (using
+ *          httpd_req_async_handler_complete()) before the server is stopped.
+ *
+ * @param[in]  r   The request to create an asynchronous copy of
+ * @param[out] out A new request object, valid until
+ *                 httpd_req_async_handler_complete() is called on it
+ *
+ * @return
+ *  - ESP_OK : The request was copied and its socket handed over
+ *  - ESP_ERR_INVALID_STATE : This session already has an asynchronous request in flight
+ *  - ESP_ERR_NO_MEM : Too many asynchronous requests in flight (see HTTPD_MAX_ASYNC_REQUESTS);
+ *                     the handler should respond synchronously, e.g. with 503
+ *  - ESP_ERR_HTTPD_ALLOC_MEM : Failed to allocate the request copy
+ */
+esp_err_t httpd_req_async_handler_begin(httpd_req_t *r, httpd_req_t **out);
+
+/**
+ * @brief   Complete an asynchronous request
+ *
+ * Frees the request copy obtained from httpd_req_async_handler_begin() and
+ * returns the socket to the server loop. Call this after the response has
+ * been fully sent.
+ *
+ * @param[in] r The request obtained from httpd_req_async_handler_begin()
+ *
+ * @return
+ *  - ESP_OK : The request was completed
+ *  - ESP_ERR_INVALID_STATE : The request is not an asynchronous one
+ */
+esp_err_t httpd_req_async_handler_complete(httpd_req_t *r);
+
+/**
+ * @brief   Queue execution of a function on the async worker pool
+ *
+ * Unlike httpd_queue_work(), which runs the work function inside the server
+ * task, this submits it to the pool of worker tasks (see
+ * HTTPD_ASYNC_WORKER_COUNT), so it may run long operations without blocking
+ * the server loop. Typically the work function responds to a request
+ * previously detached with httpd_req_async_handler_begin().
+ *
+ * This call never blocks; a full worker queue is reported as ESP_ERR_NO_MEM.
+ *
+ * @param[in] handle    Handle to server returned by httpd_start
+ * @param[in] work      Pointer to the function to be executed on a worker task
+ * @param[in] arg       Pointer to the arguments that should be passed to this function
+ *
+ * @return
+ *  - ESP_OK : On successfully queueing the work
+ *  - ESP_ERR_INVALID_ARG : Null arguments
+ *  - ESP_ERR_INVALID_STATE : Worker pool is not running
+ *  - ESP_ERR_NO_MEM : All workers are busy and the queue is full
+ */
+esp_err_t httpd_queue_work_async(httpd_handle_t handle, httpd_work_fn_t work, void *arg);
+
+/**
+ * @brief   Hand a socket over to (or take it back from) an async worker
+ *
+ * While a socket is owned by an async worker, the server loop neither selects
+ * on it nor purges it as LRU; the worker has exclusive use of the socket.
+ * This is meant for custom transports that move long-running per-socket work
+ * (such as a TLS handshake) off the server task: take ownership from the
+ * open function, and release it from a completion handler submitted with
+ * httpd_queue_work() once the socket is ready for regular request processing.
+ *
+ * @note    Must only be called from the server task context (e.g. from the
+ *          open function or from work queued with httpd_queue_work()).
+ *
+ * @param[in] handle    Handle to server returned by httpd_start
+ * @param[in] sockfd    Session socket descriptor
+ * @param[in] owned     True to hand the socket to a worker, false to return
+ *                      it to the server loop
+ *
+ * @return
+ *  - ESP_OK : Ownership updated
+ *  - ESP_ERR_NOT_FOUND : No open session with this socket descriptor
+ */
+esp_err_t httpd_sess_set_async_owned(httpd_handle_t handle, int sockfd, bool owned);
+#endif /* CONFIG_HTTPD_ASYNC_SUPPORT */
+
 /** End of Group Work Queue
  * @}
  */
@@ -1615,6 +1776,30 @@ esp_err_t httpd_ws_send_frame(httpd_req_t *req, httpd_ws_frame_t *pkt);
  */
 esp_err_t httpd_ws_send_frame_async(httpd_handle_t hd, int fd, httpd_ws_frame_t *frame);
 
+/**
+ * @brief Send several WebSocket frames coalesced into a single TCP push
+ *
+ * The frames are serialized back to back into one buffer and sent with a
+ * single call to the session's send function, so that streams of small
+ * messages do not pay one TCP segment per frame. When permessage-deflate
+ * was negotiated on the session (see HTTPD_WS_DEFLATE), eligible payloads
+ * are compressed as part of the same pass.
+ *
+ * Like httpd_ws_send_frame_async(), this may be called out of the scope of
+ * the current request, e.g. from work queued with httpd_queue_work.
+ *
+ * @param[in] hd      Server instance data
+ * @param[in] fd      Socket descriptor for sending data
+ * @param[in] frames  Array of WebSocket frames
+ * @param[in] count   Number of frames in the array
+ * @return
+ *  - ESP_OK                    : On successful
+ *  - ESP_FAIL                  : When socket errors occurs
+ *  - ESP_ERR_INVALID_ARG       : Argument is invalid (null or non-WebSocket)
+ *  - ESP_ERR_HTTPD_ALLOC_MEM   : Failed to allocate the coalescing buffer
+ */
+esp_err_t httpd_ws_send_frame_batch(httpd_handle_t hd, int fd, httpd_ws_frame_t *frames, size_t count);
+
 /**
  * @brief Checks the supplied socket descriptor if it belongs to any active client
  * of this server instance and if the websoket protocol is active
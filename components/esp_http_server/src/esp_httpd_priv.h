@@ -71,11 +71,17 @@ struct sock_db {
     uint64_t lru_counter;                   /*!< LRU Counter indicating when the socket was last used */
     char pending_data[PARSER_BLOCK_SIZE];   /*!< Buffer for pending data to be received */
     size_t pending_len;                     /*!< Length of pending data to be received */
+#ifdef CONFIG_HTTPD_ASYNC_SUPPORT
+    bool for_async_req;                     /*!< If true, the socket is owned by an async worker and the server loop must not touch it */
+#endif
 #ifdef CONFIG_HTTPD_WS_SUPPORT
     bool ws_handshake_done;                 /*!< True if it has done WebSocket handshake (if this socket is a valid WS) */
     bool ws_close;                          /*!< Set to true to close the socket later (when WS Close frame received) */
     esp_err_t (*ws_handler)(httpd_req_t *r);   /*!< WebSocket handler, leave to null if it's not WebSocket */
     bool ws_control_frames;                         /*!< WebSocket flag indicating that control frames should be passed to user handlers */
+#ifdef CONFIG_HTTPD_WS_DEFLATE
+    bool ws_deflate;                        /*!< True if permessage-deflate was negotiated during the WebSocket handshake */
+#endif
 #endif
 };
 
@@ -97,10 +103,21 @@ struct httpd_req_aux {
         const char *value;
     } *resp_hdrs;                                   /*!< Additional headers in response packet */
     struct http_parser_url url_parse_res;           /*!< URL parsing result, used for retrieving URL elements */
+#ifdef CONFIG_HTTPD_URI_TRIE_DISPATCH
+    unsigned path_params_count;                     /*!< Count of path parameters captured during URI dispatch */
+    struct path_param {
+        const char *name;                           /*!< Parameter name, points into the registered URI template */
+        size_t off;                                 /*!< Offset of the value within the request's path string */
+        size_t len;                                 /*!< Length of the value */
+    } path_params[CONFIG_HTTPD_MAX_PATH_PARAMS];    /*!< Path parameters captured during URI dispatch */
+#endif
 #ifdef CONFIG_HTTPD_WS_SUPPORT
     bool ws_handshake_detect;                       /*!< WebSocket handshake detection flag */
     httpd_ws_type_t ws_type;                        /*!< WebSocket frame type */
     bool ws_final;                                  /*!< WebSocket FIN bit (final frame or not) */
+#ifdef CONFIG_HTTPD_WS_DEFLATE
+    bool ws_compressed;                             /*!< WebSocket RSV1 bit (permessage-deflate compressed message) */
+#endif
 #endif
 };
 
@@ -116,6 +133,9 @@ struct httpd_data {
     struct thread_data hd_td;               /*!< Information for the HTTPD thread */
     struct sock_db *hd_sd;                  /*!< The socket database */
     httpd_uri_t **hd_calls;                 /*!< Registered URI handlers */
+#ifdef CONFIG_HTTPD_URI_TRIE_DISPATCH
+    struct uri_trie_node *uri_trie;         /*!< Root of the URI dispatch trie, built at registration time */
+#endif
     struct httpd_req hd_req;                /*!< The current HTTPD request */
     struct httpd_req_aux hd_req_aux;        /*!< Additional data about the HTTPD request kept unexposed */
 
@@ -277,6 +297,28 @@ bool httpd_sess_pending(struct httpd_data *hd, int fd);
  */
 esp_err_t httpd_sess_close_lru(struct httpd_data *hd);
 
+#ifdef CONFIG_HTTPD_ASYNC_SUPPORT
+/**
+ * @brief   Start (or take a reference on) the shared async worker pool
+ *
+ * Called during httpd_start(). The pool is created when the first server
+ * instance with async support starts and is shared by all instances.
+ *
+ * @return
+ *  - ESP_OK                  : pool running
+ *  - ESP_ERR_HTTPD_ALLOC_MEM : failed to allocate pool resources
+ */
+esp_err_t httpd_async_pool_start(void);
+
+/**
+ * @brief   Drop a reference on the shared async worker pool
+ *
+ * Called during httpd_stop(). The pool is torn down when the last
+ * server instance using it stops.
+ */
+void httpd_async_pool_stop(void);
+#endif /* CONFIG_HTTPD_ASYNC_SUPPORT */
+
 /** End of Group : Session Management
  * @}
  */
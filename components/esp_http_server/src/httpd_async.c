@@ -0,0 +1,275 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdlib.h>
+#include <string.h>
+#include <esp_log.h>
+#include <esp_err.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+
+#include <esp_http_server.h>
+#include "esp_httpd_priv.h"
+
+#ifdef CONFIG_HTTPD_ASYNC_SUPPORT
+
+static const char *TAG = "httpd_async";
+
+/* Work item handed from httpd_queue_work_async() to a worker task */
+struct httpd_async_work {
+    httpd_work_fn_t work;
+    void *arg;
+};
+
+/* Pre-allocated request copy, recycled across async requests so that
+ * handing a request over to a worker costs no heap traffic after startup.
+ * The response header array is kept at the largest max_resp_headers seen,
+ * as instances sharing the pool may be configured differently. */
+struct httpd_async_req_block {
+    volatile int in_use;        /*!< Claimed with __sync_lock_test_and_set, released by the worker */
+    httpd_req_t req;
+    struct httpd_req_aux aux;
+    struct resp_hdr *hdrs;
+    unsigned hdrs_cap;
+};
+
+/* The worker pool is shared by all server instances. It is created when
+ * the first server using async support starts and torn down when the
+ * last one stops. */
+static QueueHandle_t s_work_queue;
+static SemaphoreHandle_t s_exit_sem;
+static struct httpd_async_req_block *s_req_blocks;
+static int s_pool_refs;
+
+/* Claim a free request block, growing its header array to the instance's
+ * max_resp_headers if a previous user needed fewer. Claiming is lock-free :
+ * begin() runs on server tasks while release happens on workers. */
+static struct httpd_async_req_block *httpd_async_block_claim(struct httpd_data *hd)
+{
+    for (int i = 0; i < CONFIG_HTTPD_MAX_ASYNC_REQUESTS; i++) {
+        struct httpd_async_req_block *blk = &s_req_blocks[i];
+        if (__sync_lock_test_and_set(&blk->in_use, 1) != 0) {
+            continue;
+        }
+        if (blk->hdrs_cap < hd->config.max_resp_headers) {
+            struct resp_hdr *hdrs = realloc(blk->hdrs, hd->config.max_resp_headers * sizeof(struct resp_hdr));
+            if (hdrs == NULL) {
+                __sync_lock_release(&blk->in_use);
+                return NULL;
+            }
+            blk->hdrs = hdrs;
+            blk->hdrs_cap = hd->config.max_resp_headers;
+        }
+        return blk;
+    }
+    return NULL;
+}
+
+static void httpd_async_worker(void *arg)
+{
+    struct httpd_async_work item;
+    while (1) {
+        if (xQueueReceive(s_work_queue, &item, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        if (item.work == NULL) {
+            /* Poison message from httpd_async_pool_stop() */
+            break;
+        }
+        item.work(item.arg);
+    }
+    xSemaphoreGive(s_exit_sem);
+    httpd_os_thread_delete();
+}
+
+esp_err_t httpd_async_pool_start(void)
+{
+    if (s_pool_refs > 0) {
+        s_pool_refs++;
+        return ESP_OK;
+    }
+
+    /* Queue depth doubles as backpressure : when all workers are busy
+     * and the queue is full, httpd_queue_work_async() starts failing */
+    s_work_queue = xQueueCreate(CONFIG_HTTPD_MAX_ASYNC_REQUESTS,
+                                sizeof(struct httpd_async_work));
+    s_exit_sem = xSemaphoreCreateCounting(CONFIG_HTTPD_ASYNC_WORKER_COUNT, 0);
+    s_req_blocks = calloc(CONFIG_HTTPD_MAX_ASYNC_REQUESTS, sizeof(struct httpd_async_req_block));
+    if (s_work_queue == NULL || s_exit_sem == NULL || s_req_blocks == NULL) {
+        goto error;
+    }
+
+    int started = 0;
+    for (int i = 0; i < CONFIG_HTTPD_ASYNC_WORKER_COUNT; i++) {
+        othread_t handle;
+        if (httpd_os_thread_create(&handle, "httpd_worker",
+                                   CONFIG_HTTPD_ASYNC_WORKER_STACK_SIZE,
+                                   CONFIG_HTTPD_ASYNC_WORKER_PRIORITY,
+                                   httpd_async_worker, NULL,
+                                   tskNO_AFFINITY) != OS_SUCCESS) {
+            ESP_LOGE(TAG, LOG_FMT("failed to start worker %d"), i);
+            break;
+        }
+        started++;
+    }
+    if (started == 0) {
+        goto error;
+    }
+    if (started < CONFIG_HTTPD_ASYNC_WORKER_COUNT) {
+        ESP_LOGW(TAG, LOG_FMT("started only %d of %d workers"),
+                 started, CONFIG_HTTPD_ASYNC_WORKER_COUNT);
+    }
+    s_pool_refs = 1;
+    return ESP_OK;
+
+error:
+    if (s_work_queue) {
+        vQueueDelete(s_work_queue);
+        s_work_queue = NULL;
+    }
+    if (s_exit_sem) {
+        vSemaphoreDelete(s_exit_sem);
+        s_exit_sem = NULL;
+    }
+    free(s_req_blocks);
+    s_req_blocks = NULL;
+    return ESP_ERR_HTTPD_ALLOC_MEM;
+}
+
+void httpd_async_pool_stop(void)
+{
+    if (s_pool_refs == 0) {
+        return;
+    }
+    if (--s_pool_refs > 0) {
+        return;
+    }
+
+    /* Ask every worker to exit and wait until all of them have,
+     * so the queue is not deleted under a blocked receiver */
+    struct httpd_async_work poison = { .work = NULL, .arg = NULL };
+    for (int i = 0; i < CONFIG_HTTPD_ASYNC_WORKER_COUNT; i++) {
+        xQueueSend(s_work_queue, &poison, portMAX_DELAY);
+    }
+    for (int i = 0; i < CONFIG_HTTPD_ASYNC_WORKER_COUNT; i++) {
+        xSemaphoreTake(s_exit_sem, portMAX_DELAY);
+    }
+    vQueueDelete(s_work_queue);
+    s_work_queue = NULL;
+    vSemaphoreDelete(s_exit_sem);
+    s_exit_sem = NULL;
+    for (int i = 0; i < CONFIG_HTTPD_MAX_ASYNC_REQUESTS; i++) {
+        free(s_req_blocks[i].hdrs);
+    }
+    free(s_req_blocks);
+    s_req_blocks = NULL;
+}
+
+esp_err_t httpd_queue_work_async(httpd_handle_t handle, httpd_work_fn_t work, void *arg)
+{
+    if (handle == NULL || work == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_work_queue == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    struct httpd_async_work item = {
+        .work = work,
+        .arg = arg,
+    };
+    /* Never block the caller (usually the server task) : a full queue
+     * means all workers are busy, so report backpressure instead */
+    if (xQueueSend(s_work_queue, &item, 0) != pdTRUE) {
+        ESP_LOGD(TAG, LOG_FMT("worker queue full"));
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t httpd_req_async_handler_begin(httpd_req_t *r, httpd_req_t **out)
+{
+    if (r == NULL || out == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!httpd_valid_req(r)) {
+        return ESP_ERR_HTTPD_INVALID_REQ;
+    }
+
+    struct httpd_req_aux *ra = r->aux;
+    struct httpd_data *hd = (struct httpd_data *) r->handle;
+    if (ra->sd->for_async_req) {
+        /* Only one async request per session */
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    /* Per-server backpressure : count the sessions already handed over
+     * to workers before taking another one off the server loop */
+    int busy = 0;
+    for (int i = 0; i < hd->config.max_open_sockets; i++) {
+        if (hd->hd_sd[i].fd != -1 && hd->hd_sd[i].for_async_req) {
+            busy++;
+        }
+    }
+    if (busy >= CONFIG_HTTPD_MAX_ASYNC_REQUESTS) {
+        ESP_LOGD(TAG, LOG_FMT("async request limit reached (%d)"), busy);
+        return ESP_ERR_NO_MEM;
+    }
+
+    /* The request and its auxiliary data live inside struct httpd_data and
+     * are reused for the next request as soon as the handler returns, so
+     * copy them into a recycled block from the pool for the worker */
+    struct httpd_async_req_block *blk = httpd_async_block_claim(hd);
+    if (blk == NULL) {
+        return ESP_ERR_HTTPD_ALLOC_MEM;
+    }
+    blk->req = *r;
+    blk->aux = *ra;
+    memcpy(blk->hdrs, ra->resp_hdrs, hd->config.max_resp_headers * sizeof(struct resp_hdr));
+    blk->req.aux = &blk->aux;
+    blk->aux.resp_hdrs = blk->hdrs;
+
+    /* Hand the socket over to the worker : the server loop stops
+     * select()ing on it until httpd_req_async_handler_complete() */
+    ra->sd->for_async_req = true;
+
+    *out = &blk->req;
+    return ESP_OK;
+}
+
+esp_err_t httpd_req_async_handler_complete(httpd_req_t *r)
+{
+    if (r == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    struct httpd_req_aux *ra = r->aux;
+    if (ra == NULL || ra->sd == NULL || !ra->sd->for_async_req) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    /* Recycle the request block into the pool */
+    for (int i = 0; i < CONFIG_HTTPD_MAX_ASYNC_REQUESTS; i++) {
+        if (r == &s_req_blocks[i].req) {
+            /* Return the socket to the server loop */
+            ra->sd->for_async_req = false;
+            __sync_lock_release(&s_req_blocks[i].in_use);
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_INVALID_ARG;
+}
+
+#endif /* CONFIG_HTTPD_ASYNC_SUPPORT */
@@ -412,6 +412,13 @@ esp_err_t httpd_start(httpd_handle_t *handle, const httpd_config_t *config)
         return ESP_FAIL;
     }
 
+#ifdef CONFIG_HTTPD_ASYNC_SUPPORT
+    if (httpd_async_pool_start() != ESP_OK) {
+        httpd_delete(hd);
+        return ESP_ERR_HTTPD_ALLOC_MEM;
+    }
+#endif
+
     httpd_sess_init(hd);
     if (httpd_os_thread_create(&hd->hd_td.handle, "httpd",
                                hd->config.stack_size,
@@ -419,6 +426,9 @@ esp_err_t httpd_start(httpd_handle_t *handle, const httpd_config_t *config)
                                httpd_thread, hd,
                                hd->config.core_id) != ESP_OK) {
         /* Failed to launch task */
+#ifdef CONFIG_HTTPD_ASYNC_SUPPORT
+        httpd_async_pool_stop();
+#endif
         httpd_delete(hd);
         return ESP_ERR_HTTPD_TASK;
     }
@@ -464,6 +474,10 @@ esp_err_t httpd_stop(httpd_handle_t handle)
         hd->config.global_transport_ctx = NULL;
     }
 
+#ifdef CONFIG_HTTPD_ASYNC_SUPPORT
+    httpd_async_pool_stop();
+#endif
+
     ESP_LOGD(TAG, LOG_FMT("server stopped"));
     httpd_delete(hd);
     return ESP_OK;
@@ -185,6 +185,14 @@ void httpd_sess_set_descriptors(struct httpd_data *hd,
     *maxfd = -1;
     for (i = 0; i < hd->config.max_open_sockets; i++) {
         if (hd->hd_sd[i].fd != -1) {
+#ifdef CONFIG_HTTPD_ASYNC_SUPPORT
+            /* Sockets handed over to async workers are serviced by the
+             * worker, not by the server loop, until the worker calls
+             * httpd_req_async_handler_complete() */
+            if (hd->hd_sd[i].for_async_req) {
+                continue;
+            }
+#endif
             FD_SET(hd->hd_sd[i].fd, fdset);
             if (hd->hd_sd[i].fd > *maxfd) {
                 *maxfd = hd->hd_sd[i].fd;
@@ -300,6 +308,13 @@ esp_err_t httpd_sess_process(struct httpd_data *hd, int newfd)
         return ESP_FAIL;
     }
 
+#ifdef CONFIG_HTTPD_ASYNC_SUPPORT
+    if (sd->for_async_req) {
+        /* Socket is owned by an async worker; don't read from it here */
+        return ESP_OK;
+    }
+#endif
+
     ESP_LOGD(TAG, LOG_FMT("httpd_req_new"));
     if (httpd_req_new(hd, sd) != ESP_OK) {
         return ESP_FAIL;
@@ -344,15 +359,43 @@ esp_err_t httpd_sess_close_lru(struct httpd_data *hd)
         if (hd->hd_sd[i].fd == -1) {
             return ESP_OK;
         }
+#ifdef CONFIG_HTTPD_ASYNC_SUPPORT
+        /* Never purge a session that an async worker is responding on */
+        if (hd->hd_sd[i].for_async_req) {
+            continue;
+        }
+#endif
         if (hd->hd_sd[i].lru_counter < lru_counter) {
             lru_counter = hd->hd_sd[i].lru_counter;
             lru_fd = hd->hd_sd[i].fd;
         }
     }
+    if (lru_fd == -1) {
+        /* All open sessions are busy with async requests */
+        return ESP_FAIL;
+    }
     ESP_LOGD(TAG, LOG_FMT("fd = %d"), lru_fd);
     return httpd_sess_trigger_close(hd, lru_fd);
 }
 
+#ifdef CONFIG_HTTPD_ASYNC_SUPPORT
+esp_err_t httpd_sess_set_async_owned(httpd_handle_t handle, int sockfd, bool owned)
+{
+    struct sock_db *sd = httpd_sess_get(handle, sockfd);
+    if (sd == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    sd->for_async_req = owned;
+    if (!owned) {
+        /* The session just became (or went back to being) live; count it as
+         * used so it is neither the first LRU purge candidate nor skipped
+         * by a subsequent httpd_sess_trigger_close() */
+        sd->lru_counter = httpd_sess_get_lru_counter();
+    }
+    return ESP_OK;
+}
+#endif
+
 int httpd_sess_iterate(struct httpd_data *hd, int start_fd)
 {
     int start_index = 0;
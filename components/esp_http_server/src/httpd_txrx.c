@@ -299,6 +299,99 @@ esp_err_t httpd_resp_send(httpd_req_t *r, const char *buf, ssize_t buf_len)
     return ESP_OK;
 }
 
+/* Buffered header writer for httpd_resp_send_vec(): collects header
+ * fragments in the scratch buffer and flushes only when it runs full,
+ * so a typical header section goes out in a single send. */
+struct httpd_hdr_writer {
+    httpd_req_t *r;
+    char *buf;
+    size_t size;
+    size_t len;
+};
+
+static esp_err_t httpd_hdr_write(struct httpd_hdr_writer *w, const char *str, size_t str_len)
+{
+    while (str_len > 0) {
+        size_t space = w->size - w->len;
+        if (space == 0) {
+            if (httpd_send_all(w->r, w->buf, w->len) != ESP_OK) {
+                return ESP_FAIL;
+            }
+            w->len = 0;
+            space = w->size;
+        }
+        size_t chunk = MIN(str_len, space);
+        memcpy(w->buf + w->len, str, chunk);
+        w->len += chunk;
+        str += chunk;
+        str_len -= chunk;
+    }
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_send_vec(httpd_req_t *r, const httpd_iovec_t *vec, size_t count)
+{
+    if (r == NULL || (vec == NULL && count > 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!httpd_valid_req(r)) {
+        return ESP_ERR_HTTPD_INVALID_REQ;
+    }
+
+    struct httpd_req_aux *ra = r->aux;
+    const char *httpd_hdr_str = "HTTP/1.1 %s\r\nContent-Type: %s\r\nContent-Length: %d\r\n";
+
+    size_t body_len = 0;
+    for (size_t i = 0; i < count; i++) {
+        body_len += vec[i].iov_len;
+    }
+
+    /* Request headers are no longer available */
+    ra->req_hdrs_count = 0;
+
+    /* Size of essential headers is limited by scratch buffer size */
+    int hdr_len = snprintf(ra->scratch, sizeof(ra->scratch), httpd_hdr_str,
+                           ra->status, ra->content_type, body_len);
+    if (hdr_len >= sizeof(ra->scratch)) {
+        return ESP_ERR_HTTPD_RESP_HDR;
+    }
+
+    struct httpd_hdr_writer w = {
+        .r = r,
+        .buf = ra->scratch,
+        .size = sizeof(ra->scratch),
+        .len = (size_t) hdr_len,
+    };
+
+    /* Append additional headers based on set_header, then the blank line */
+    for (unsigned i = 0; i < ra->resp_hdrs_count; i++) {
+        if (httpd_hdr_write(&w, ra->resp_hdrs[i].field, strlen(ra->resp_hdrs[i].field)) != ESP_OK ||
+            httpd_hdr_write(&w, ": ", 2) != ESP_OK ||
+            httpd_hdr_write(&w, ra->resp_hdrs[i].value, strlen(ra->resp_hdrs[i].value)) != ESP_OK ||
+            httpd_hdr_write(&w, "\r\n", 2) != ESP_OK) {
+            return ESP_ERR_HTTPD_RESP_SEND;
+        }
+    }
+    if (httpd_hdr_write(&w, "\r\n", 2) != ESP_OK) {
+        return ESP_ERR_HTTPD_RESP_SEND;
+    }
+    if (w.len > 0 && httpd_send_all(r, w.buf, w.len) != ESP_OK) {
+        return ESP_ERR_HTTPD_RESP_SEND;
+    }
+
+    /* Send body buffers in place, no intermediate copy */
+    for (size_t i = 0; i < count; i++) {
+        if (vec[i].iov_len == 0) {
+            continue;
+        }
+        if (httpd_send_all(r, (const char *) vec[i].iov_base, vec[i].iov_len) != ESP_OK) {
+            return ESP_ERR_HTTPD_RESP_SEND;
+        }
+    }
+    return ESP_OK;
+}
+
 esp_err_t httpd_resp_send_chunk(httpd_req_t *r, const char *buf, ssize_t buf_len)
 {
     if (r == NULL) {
@@ -88,6 +88,264 @@ bool httpd_uri_match_wildcard(const char *template, const char *uri, size_t len)
     }
 }
 
+#ifdef CONFIG_HTTPD_URI_TRIE_DISPATCH
+/*
+ * Radix tree URI dispatcher
+ *
+ * The registered URIs are additionally kept in a trie compressed at path
+ * segment granularity, built at registration time. Dispatch then walks the
+ * request path once, segment by segment, making its cost proportional to
+ * the path length instead of the number of registered handlers. A template
+ * segment starting with ':' matches any single segment and its value is
+ * captured as a path parameter (see httpd_req_get_path_param()).
+ *
+ * The trie is only used when no custom uri_match_fn is configured, since a
+ * custom matcher can implement arbitrary template semantics which cannot
+ * be indexed. The flat hd_calls array remains the owner of the handler
+ * entries; trie nodes merely point into it.
+ */
+
+struct uri_trie_method {
+    struct uri_trie_method *next;
+    httpd_uri_t *call;              /* entry owned by hd_calls */
+};
+
+struct uri_trie_node {
+    struct uri_trie_node *sibling;  /* next literal alternative for this segment */
+    struct uri_trie_node *child;    /* first literal child one segment deeper */
+    struct uri_trie_node *param;    /* parameter child, matches any one segment */
+    char *seg;                      /* literal segment text, or parameter name */
+    size_t seg_len;
+    struct uri_trie_method *methods; /* handlers whose template ends at this node */
+};
+
+/* Extract the next path segment : on entry *path points at a '/' or at the
+ * start of the string; returns the segment start and stores its length */
+static const char *uri_trie_next_seg(const char **path, const char *end, size_t *seg_len)
+{
+    const char *p = *path;
+    if (p < end && *p == '/') {
+        p++;
+    }
+    const char *seg = p;
+    while (p < end && *p != '/') {
+        p++;
+    }
+    *seg_len = p - seg;
+    *path = p;
+    return seg;
+}
+
+static struct uri_trie_node *uri_trie_node_new(const char *seg, size_t seg_len)
+{
+    struct uri_trie_node *node = calloc(1, sizeof(struct uri_trie_node));
+    if (node == NULL) {
+        return NULL;
+    }
+    node->seg = strndup(seg, seg_len);
+    if (node->seg == NULL) {
+        free(node);
+        return NULL;
+    }
+    node->seg_len = seg_len;
+    return node;
+}
+
+static void uri_trie_free(struct uri_trie_node *node)
+{
+    if (node == NULL) {
+        return;
+    }
+    uri_trie_free(node->sibling);
+    uri_trie_free(node->child);
+    uri_trie_free(node->param);
+    struct uri_trie_method *m = node->methods;
+    while (m) {
+        struct uri_trie_method *next = m->next;
+        free(m);
+        m = next;
+    }
+    free(node->seg);
+    free(node);
+}
+
+static esp_err_t uri_trie_insert(struct httpd_data *hd, httpd_uri_t *call)
+{
+    if (hd->uri_trie == NULL) {
+        hd->uri_trie = uri_trie_node_new("", 0);
+        if (hd->uri_trie == NULL) {
+            return ESP_ERR_HTTPD_ALLOC_MEM;
+        }
+    }
+
+    struct uri_trie_node *node = hd->uri_trie;
+    const char *path = call->uri;
+    const char *end = path + strlen(path);
+
+    while (path < end) {
+        size_t seg_len;
+        const char *seg = uri_trie_next_seg(&path, end, &seg_len);
+
+        if (seg_len > 0 && seg[0] == ':') {
+            /* Parameter segment : all templates branching here share one
+             * parameter child, and thereby its name */
+            if (node->param == NULL) {
+                node->param = uri_trie_node_new(seg + 1, seg_len - 1);
+                if (node->param == NULL) {
+                    return ESP_ERR_HTTPD_ALLOC_MEM;
+                }
+            } else if (strncmp(node->param->seg, seg + 1, seg_len - 1) != 0 ||
+                       node->param->seg_len != seg_len - 1) {
+                ESP_LOGW(TAG, LOG_FMT("parameter ':%s' conflicts with ':%s' at same position"),
+                         node->param->seg, seg + 1);
+            }
+            node = node->param;
+            continue;
+        }
+
+        struct uri_trie_node *child = node->child;
+        while (child && (child->seg_len != seg_len ||
+                         strncmp(child->seg, seg, seg_len) != 0)) {
+            child = child->sibling;
+        }
+        if (child == NULL) {
+            child = uri_trie_node_new(seg, seg_len);
+            if (child == NULL) {
+                return ESP_ERR_HTTPD_ALLOC_MEM;
+            }
+            child->sibling = node->child;
+            node->child = child;
+        }
+        node = child;
+    }
+
+    struct uri_trie_method *m = malloc(sizeof(struct uri_trie_method));
+    if (m == NULL) {
+        return ESP_ERR_HTTPD_ALLOC_MEM;
+    }
+    m->call = call;
+    m->next = node->methods;
+    node->methods = m;
+    return ESP_OK;
+}
+
+/* Rebuild the trie from scratch out of the hd_calls array. Used after
+ * unregistration, which is rare enough that the simplicity is worth more
+ * than an in-place delete. On allocation failure the trie is dropped
+ * entirely and dispatch falls back to the linear scan. */
+static void uri_trie_rebuild(struct httpd_data *hd)
+{
+    uri_trie_free(hd->uri_trie);
+    hd->uri_trie = NULL;
+
+    if (hd->config.uri_match_fn) {
+        return;
+    }
+    for (int i = 0; i < hd->config.max_uri_handlers; i++) {
+        if (!hd->hd_calls[i]) {
+            break;
+        }
+        if (uri_trie_insert(hd, hd->hd_calls[i]) != ESP_OK) {
+            ESP_LOGW(TAG, LOG_FMT("trie rebuild failed, reverting to linear dispatch"));
+            uri_trie_free(hd->uri_trie);
+            hd->uri_trie = NULL;
+            return;
+        }
+    }
+}
+
+/* Recursive walk of the trie. Literal children are preferred over the
+ * parameter child, with backtracking into the parameter branch when the
+ * literal branch does not lead to a handler with the requested method.
+ * Parameter captures are committed to 'ra' only on the successful branch.
+ * Sets *found if some template matched structurally (for 405 reporting). */
+static httpd_uri_t *uri_trie_walk(struct uri_trie_node *node,
+                                  const char *path_start, const char *path, const char *end,
+                                  httpd_method_t method, bool *found,
+                                  struct httpd_req_aux *ra, unsigned nparams)
+{
+    if (path >= end) {
+        for (struct uri_trie_method *m = node->methods; m; m = m->next) {
+            if (m->call->method == method) {
+                ra->path_params_count = nparams;
+                return m->call;
+            }
+        }
+        if (node->methods) {
+            *found = true;
+        }
+        return NULL;
+    }
+
+    size_t seg_len;
+    const char *seg = uri_trie_next_seg(&path, end, &seg_len);
+
+    for (struct uri_trie_node *child = node->child; child; child = child->sibling) {
+        if (child->seg_len == seg_len && strncmp(child->seg, seg, seg_len) == 0) {
+            httpd_uri_t *call = uri_trie_walk(child, path_start, path, end,
+                                              method, found, ra, nparams);
+            if (call) {
+                return call;
+            }
+            break;
+        }
+    }
+
+    if (node->param && seg_len > 0 && nparams < CONFIG_HTTPD_MAX_PATH_PARAMS) {
+        ra->path_params[nparams].name = node->param->seg;
+        ra->path_params[nparams].off = seg - path_start;
+        ra->path_params[nparams].len = seg_len;
+        return uri_trie_walk(node->param, path_start, path, end,
+                             method, found, ra, nparams + 1);
+    }
+    return NULL;
+}
+
+static httpd_uri_t *uri_trie_lookup(struct httpd_data *hd,
+                                    const char *uri, size_t uri_len,
+                                    httpd_method_t method,
+                                    httpd_err_code_t *err)
+{
+    bool found = false;
+    struct httpd_req_aux *ra = &hd->hd_req_aux;
+
+    ra->path_params_count = 0;
+    httpd_uri_t *call = uri_trie_walk(hd->uri_trie, uri, uri, uri + uri_len,
+                                      method, &found, ra, 0);
+    if (err) {
+        *err = call ? 0 : (found ? HTTPD_405_METHOD_NOT_ALLOWED : HTTPD_404_NOT_FOUND);
+    }
+    return call;
+}
+
+esp_err_t httpd_req_get_path_param(httpd_req_t *r, const char *name, char *val, size_t val_size)
+{
+    if (r == NULL || name == NULL || val == NULL || val_size == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!httpd_valid_req(r)) {
+        return ESP_ERR_HTTPD_INVALID_REQ;
+    }
+
+    struct httpd_req_aux *ra = r->aux;
+    const char *path = r->uri + ra->url_parse_res.field_data[UF_PATH].off;
+
+    for (unsigned i = 0; i < ra->path_params_count; i++) {
+        if (strcmp(ra->path_params[i].name, name) != 0) {
+            continue;
+        }
+        if (ra->path_params[i].len + 1 > val_size) {
+            /* Truncate value to fit the buffer, like httpd_query_key_value() */
+            strlcpy(val, path + ra->path_params[i].off, val_size);
+            return ESP_ERR_HTTPD_RESULT_TRUNC;
+        }
+        strlcpy(val, path + ra->path_params[i].off, ra->path_params[i].len + 1);
+        return ESP_OK;
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+#endif /* CONFIG_HTTPD_URI_TRIE_DISPATCH */
+
 /* Find handler with matching URI and method, and set
  * appropriate error code if URI or method not found */
 static httpd_uri_t* httpd_find_uri_handler(struct httpd_data *hd,
@@ -99,6 +357,12 @@ static httpd_uri_t* httpd_find_uri_handler(struct httpd_data *hd,
         *err = HTTPD_404_NOT_FOUND;
     }
 
+#ifdef CONFIG_HTTPD_URI_TRIE_DISPATCH
+    if (hd->uri_trie && hd->config.uri_match_fn == NULL) {
+        return uri_trie_lookup(hd, uri, uri_len, method, err);
+    }
+#endif
+
     for (int i = 0; i < hd->config.max_uri_handlers; i++) {
         if (!hd->hd_calls[i]) {
             break;
@@ -175,6 +439,15 @@ esp_err_t httpd_register_uri_handler(httpd_handle_t handle,
 #ifdef CONFIG_HTTPD_WS_SUPPORT
             hd->hd_calls[i]->is_websocket = uri_handler->is_websocket;
             hd->hd_calls[i]->handle_ws_control_frames = uri_handler->handle_ws_control_frames;
+#endif
+#ifdef CONFIG_HTTPD_URI_TRIE_DISPATCH
+            if (hd->config.uri_match_fn == NULL &&
+                uri_trie_insert(hd, hd->hd_calls[i]) != ESP_OK) {
+                /* Retry with a full rebuild; on repeated failure the trie is
+                 * dropped and dispatch falls back to the linear scan, with
+                 * the handler still registered */
+                uri_trie_rebuild(hd);
+            }
 #endif
             ESP_LOGD(TAG, LOG_FMT("[%d] installed %s"), i, uri_handler->uri);
             return ESP_OK;
@@ -215,6 +488,9 @@ esp_err_t httpd_unregister_uri_handler(httpd_handle_t handle,
             }
             /* Nullify the following non null entry */
             hd->hd_calls[i-1] = NULL;
+#ifdef CONFIG_HTTPD_URI_TRIE_DISPATCH
+            uri_trie_rebuild(hd);
+#endif
             return ESP_OK;
         }
     }
@@ -259,6 +535,11 @@ esp_err_t httpd_unregister_uri(httpd_handle_t handle, const char *uri)
     if (!found) {
         ESP_LOGW(TAG, LOG_FMT("no handler found for URI %s"), uri);
     }
+#ifdef CONFIG_HTTPD_URI_TRIE_DISPATCH
+    if (found) {
+        uri_trie_rebuild(hd);
+    }
+#endif
     return (found ? ESP_OK : ESP_ERR_NOT_FOUND);
 }
 
@@ -274,6 +555,10 @@ void httpd_unregister_all_uri_handlers(struct httpd_data *hd)
         free(hd->hd_calls[i]);
         hd->hd_calls[i] = NULL;
     }
+#ifdef CONFIG_HTTPD_URI_TRIE_DISPATCH
+    uri_trie_free(hd->uri_trie);
+    hd->uri_trie = NULL;
+#endif
 }
 
 esp_err_t httpd_uri(struct httpd_data *hd)
@@ -26,6 +26,16 @@
 
 #ifdef CONFIG_HTTPD_WS_SUPPORT
 
+#ifdef CONFIG_HTTPD_WS_DEFLATE
+#if CONFIG_IDF_TARGET_ESP32
+#include "esp32/rom/miniz.h"
+#elif CONFIG_IDF_TARGET_ESP32S2
+#include "esp32s2/rom/miniz.h"
+#elif CONFIG_IDF_TARGET_ESP32S3
+#include "esp32s3/rom/miniz.h"
+#endif
+#endif
+
 static const char *TAG="httpd_ws";
 
 /*
@@ -34,6 +44,7 @@ static const char *TAG="httpd_ws";
  */
 #define HTTPD_WS_CONTINUE       0x00U
 #define HTTPD_WS_FIN_BIT        0x80U
+#define HTTPD_WS_RSV1_BIT       0x40U
 #define HTTPD_WS_OPCODE_BITS    0x0fU
 #define HTTPD_WS_MASK_BIT       0x80U
 #define HTTPD_WS_LENGTH_BITS    0x7fU
@@ -101,13 +112,37 @@ esp_err_t httpd_ws_respond_server_handshake(httpd_req_t *req)
 
     ESP_LOGD(TAG, LOG_FMT("Generated server key: %s"), server_key_encoded);
 
+#ifdef CONFIG_HTTPD_WS_DEFLATE
+    /* Accept a plain permessage-deflate offer (RFC7692). Context takeover is
+     * disabled in both directions so that every message is a self-contained
+     * deflate stream and no per-session compression state has to be kept.
+     * Offers that constrain the server window (server_max_window_bits) are
+     * declined by simply not including the extension in the response. */
+    bool accept_deflate = false;
+    char ext_val[128] = { '\0' };
+    if (httpd_req_get_hdr_value_str(req, "Sec-WebSocket-Extensions", ext_val, sizeof(ext_val)) == ESP_OK) {
+        if (strstr(ext_val, "permessage-deflate") != NULL &&
+            strstr(ext_val, "server_max_window_bits") == NULL) {
+            accept_deflate = true;
+        }
+    }
+#endif
+
     /* Prepare the Switching Protocol response */
-    char tx_buf[192] = { '\0' };
+    char tx_buf[288] = { '\0' };
     int fmt_len = snprintf(tx_buf, sizeof(tx_buf),
                            "HTTP/1.1 101 Switching Protocols\r\n"
                            "Upgrade: websocket\r\n"
                            "Connection: Upgrade\r\n"
-                           "Sec-WebSocket-Accept: %s\r\n\r\n", server_key_encoded);
+#ifdef CONFIG_HTTPD_WS_DEFLATE
+                           "%s"
+#endif
+                           "Sec-WebSocket-Accept: %s\r\n\r\n",
+#ifdef CONFIG_HTTPD_WS_DEFLATE
+                           accept_deflate ? "Sec-WebSocket-Extensions: permessage-deflate; "
+                                            "server_no_context_takeover; client_no_context_takeover\r\n" : "",
+#endif
+                           server_key_encoded);
     if (fmt_len < 0 || fmt_len > sizeof(tx_buf)) {
         ESP_LOGW(TAG, LOG_FMT("Failed to prepare Tx buffer"));
         return ESP_FAIL;
@@ -119,6 +154,10 @@ esp_err_t httpd_ws_respond_server_handshake(httpd_req_t *req)
         return ESP_FAIL;
     }
 
+#ifdef CONFIG_HTTPD_WS_DEFLATE
+    req_aux->sd->ws_deflate = accept_deflate;
+#endif
+
     return ESP_OK;
 }
 
@@ -154,6 +193,53 @@ static esp_err_t httpd_ws_unmask_payload(uint8_t *payload, size_t len, const uin
     return ESP_OK;
 }
 
+#ifdef CONFIG_HTTPD_WS_DEFLATE
+/* Inflate a permessage-deflate message in place using the decompressor in
+ * ROM. The compressed bytes are copied aside and inflated back into
+ * frame->payload, which the caller sized for max_len plain bytes. */
+static esp_err_t httpd_ws_inflate_payload(httpd_ws_frame_t *frame, size_t max_len)
+{
+    /* Re-append the trailing bytes the sender stripped after its sync
+     * flush, see RFC7692 Section 7.2.2. Senders that finished the deflate
+     * stream instead just leave 4 trailing bytes unconsumed. */
+    static const uint8_t deflate_tail[4] = { 0x00, 0x00, 0xff, 0xff };
+
+    uint8_t *in_buf = malloc(frame->len + sizeof(deflate_tail));
+    tinfl_decompressor *decomp = malloc(sizeof(tinfl_decompressor));
+    if (in_buf == NULL || decomp == NULL) {
+        free(decomp);
+        free(in_buf);
+        return ESP_ERR_HTTPD_ALLOC_MEM;
+    }
+    memcpy(in_buf, frame->payload, frame->len);
+    memcpy(in_buf + frame->len, deflate_tail, sizeof(deflate_tail));
+    tinfl_init(decomp);
+
+    size_t in_bytes = frame->len + sizeof(deflate_tail);
+    size_t out_bytes = max_len;
+    tinfl_status status = tinfl_decompress(decomp, in_buf, &in_bytes,
+                                           frame->payload, frame->payload, &out_bytes,
+                                           TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF);
+    free(decomp);
+    free(in_buf);
+
+    /* A sync-flushed message never carries a final deflate block, so the
+     * decompressor still waits for input after consuming all of it */
+    if (status != TINFL_STATUS_DONE &&
+        !(status == TINFL_STATUS_NEEDS_MORE_INPUT && in_bytes == frame->len + sizeof(deflate_tail))) {
+        if (status == TINFL_STATUS_HAS_MORE_OUTPUT) {
+            ESP_LOGW(TAG, LOG_FMT("WS Message too long after decompression"));
+            return ESP_ERR_INVALID_SIZE;
+        }
+        ESP_LOGW(TAG, LOG_FMT("Failed to inflate WS payload"));
+        return ESP_FAIL;
+    }
+
+    frame->len = out_bytes;
+    return ESP_OK;
+}
+#endif /* CONFIG_HTTPD_WS_DEFLATE */
+
 esp_err_t httpd_ws_recv_frame(httpd_req_t *req, httpd_ws_frame_t *frame, size_t max_len)
 {
     esp_err_t ret = httpd_ws_check_req(req);
@@ -258,6 +344,19 @@ esp_err_t httpd_ws_recv_frame(httpd_req_t *req, httpd_ws_frame_t *frame, size_t
     /* Unmask payload */
     httpd_ws_unmask_payload(frame->payload, frame->len, mask_key);
 
+#ifdef CONFIG_HTTPD_WS_DEFLATE
+    /* Inflate a compressed message in place, so that handlers see plain
+     * payloads whether or not the client compressed them */
+    if (aux->ws_compressed && aux->sd->ws_deflate && frame->final &&
+        (frame->type == HTTPD_WS_TYPE_TEXT || frame->type == HTTPD_WS_TYPE_BINARY)) {
+        esp_err_t ret = httpd_ws_inflate_payload(frame, max_len);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        aux->ws_compressed = false;
+    }
+#endif
+
     return ESP_OK;
 }
 
@@ -270,34 +369,33 @@ esp_err_t httpd_ws_send_frame(httpd_req_t *req, httpd_ws_frame_t *frame)
     return httpd_ws_send_frame_async(req->handle, httpd_req_to_sockfd(req), frame);
 }
 
-esp_err_t httpd_ws_send_frame_async(httpd_handle_t hd, int fd, httpd_ws_frame_t *frame)
+/* Format a frame header for the given payload length (which may differ from
+ * frame->len when the payload was compressed) and return the header size */
+static uint8_t httpd_ws_format_header(uint8_t *header_buf, const httpd_ws_frame_t *frame,
+                                      size_t payload_len, bool compressed)
 {
-    if (!frame) {
-        ESP_LOGW(TAG, LOG_FMT("Argument is invalid"));
-        return ESP_ERR_INVALID_ARG;
-    }
-
-    /* Prepare Tx buffer - maximum length is 14, which includes 2 bytes header, 8 bytes length, 4 bytes mask key */
     uint8_t tx_len = 0;
-    uint8_t header_buf[10] = {0 };
     /* Set the `FIN` bit by default if message is not fragmented. Else, set it as per the `final` field */
-    header_buf[0] |= (!frame->fragmented) ? HTTPD_WS_FIN_BIT : (frame->final? HTTPD_WS_FIN_BIT: HTTPD_WS_CONTINUE);
+    header_buf[0] = (!frame->fragmented) ? HTTPD_WS_FIN_BIT : (frame->final? HTTPD_WS_FIN_BIT: HTTPD_WS_CONTINUE);
     header_buf[0] |= frame->type; /* Type (opcode): 4 bits */
+    if (compressed) {
+        header_buf[0] |= HTTPD_WS_RSV1_BIT; /* "Per-Message Compressed" bit, RFC7692 Section 6 */
+    }
 
-    if (frame->len <= 125) {
-        header_buf[1] = frame->len & 0x7fU; /* Length for 7 bits */
+    if (payload_len <= 125) {
+        header_buf[1] = payload_len & 0x7fU; /* Length for 7 bits */
         tx_len = 2;
-    } else if (frame->len > 125 && frame->len < UINT16_MAX) {
+    } else if (payload_len > 125 && payload_len < UINT16_MAX) {
         header_buf[1] = 126;                /* Length for 16 bits */
-        header_buf[2] = (frame->len >> 8U) & 0xffU;
-        header_buf[3] = frame->len & 0xffU;
+        header_buf[2] = (payload_len >> 8U) & 0xffU;
+        header_buf[3] = payload_len & 0xffU;
         tx_len = 4;
     } else {
         header_buf[1] = 127;                /* Length for 64 bits */
         uint8_t shift_idx = sizeof(uint64_t) - 1; /* Shift index starts at 7 */
-        for (int8_t idx = 2; idx > 9; idx--) {
+        for (int8_t idx = 2; idx <= 9; idx++) {
             /* Now do shifting (be careful of endianess, i.e. when buffer index is 2, frame length shift index is 7) */
-            header_buf[idx] = (frame->len >> (uint8_t)(shift_idx * 8)) & 0xffU;
+            header_buf[idx] = ((uint64_t)payload_len >> (uint8_t)(shift_idx * 8)) & 0xffU;
             shift_idx--;
         }
         tx_len = 10;
@@ -305,27 +403,204 @@ esp_err_t httpd_ws_send_frame_async(httpd_handle_t hd, int fd, httpd_ws_frame_t
 
     /* WebSocket server does not required to mask response payload, so leave the MASK bit as 0. */
     header_buf[1] &= (~HTTPD_WS_MASK_BIT);
+    return tx_len;
+}
+
+/* Send a buffer out completely, accounting for partial writes */
+static esp_err_t httpd_ws_send_all(httpd_handle_t hd, struct sock_db *sess, int fd,
+                                   const char *buf, size_t buf_len)
+{
+    while (buf_len > 0) {
+        int ret = sess->send_fn(hd, fd, buf, buf_len, 0);
+        if (ret <= 0) {
+            return ESP_FAIL;
+        }
+        buf += ret;
+        buf_len -= ret;
+    }
+    return ESP_OK;
+}
+
+#ifdef CONFIG_HTTPD_WS_DEFLATE
+/* True if outgoing payloads on this session should be considered for
+ * compression : negotiated, a data frame, unfragmented and large enough
+ * for the deflate overhead to pay off */
+static bool httpd_ws_should_deflate(const struct sock_db *sess, const httpd_ws_frame_t *frame)
+{
+    return sess->ws_deflate && !frame->fragmented &&
+           (frame->type == HTTPD_WS_TYPE_TEXT || frame->type == HTTPD_WS_TYPE_BINARY) &&
+           frame->len >= CONFIG_HTTPD_WS_DEFLATE_MIN_LEN && frame->payload != NULL;
+}
+
+/* One-shot raw deflate of a message payload using the compressor in ROM.
+ * Returns the compressed size, or 0 if compression failed or did not fit
+ * in out_cap (i.e. was not worth it). As both directions are negotiated
+ * without context takeover, the complete stream (BFINAL set) is a valid
+ * permessage-deflate message, see RFC7692 Section 7.2.3.6. */
+static size_t httpd_ws_deflate_payload(const uint8_t *in, size_t in_len,
+                                       uint8_t *out, size_t out_cap)
+{
+    tdefl_compressor *comp = malloc(sizeof(tdefl_compressor));
+    if (comp == NULL) {
+        return 0;
+    }
+    if (tdefl_init(comp, NULL, NULL, TDEFL_DEFAULT_MAX_PROBES) != TDEFL_STATUS_OKAY) {
+        free(comp);
+        return 0;
+    }
+    size_t in_bytes = in_len;
+    size_t out_bytes = out_cap;
+    tdefl_status status = tdefl_compress(comp, in, &in_bytes, out, &out_bytes, TDEFL_FINISH);
+    free(comp);
+    if (status != TDEFL_STATUS_DONE || in_bytes != in_len) {
+        return 0;
+    }
+    return out_bytes;
+}
+#endif /* CONFIG_HTTPD_WS_DEFLATE */
+
+esp_err_t httpd_ws_send_frame_async(httpd_handle_t hd, int fd, httpd_ws_frame_t *frame)
+{
+    if (!frame) {
+        ESP_LOGW(TAG, LOG_FMT("Argument is invalid"));
+        return ESP_ERR_INVALID_ARG;
+    }
 
     struct sock_db *sess = httpd_sess_get(hd, fd);
     if (!sess) {
         return ESP_ERR_INVALID_ARG;
     }
 
-    /* Send off header */
-    if (sess->send_fn(hd, fd, (const char *)header_buf, tx_len, 0) < 0) {
-        ESP_LOGW(TAG, LOG_FMT("Failed to send WS header"));
-        return ESP_FAIL;
+    const uint8_t *payload = frame->payload;
+    size_t payload_len = frame->len;
+    bool compressed = false;
+
+#ifdef CONFIG_HTTPD_WS_DEFLATE
+    uint8_t *comp_buf = NULL;
+    if (httpd_ws_should_deflate(sess, frame)) {
+        /* Compression is only used when it makes the payload smaller */
+        comp_buf = malloc(frame->len - 1);
+        if (comp_buf) {
+            size_t comp_len = httpd_ws_deflate_payload(frame->payload, frame->len,
+                                                       comp_buf, frame->len - 1);
+            if (comp_len > 0) {
+                payload = comp_buf;
+                payload_len = comp_len;
+                compressed = true;
+            }
+        }
     }
+#endif
 
-    /* Send off payload */
-    if(frame->len > 0 && frame->payload != NULL) {
-        if (sess->send_fn(hd, fd, (const char *)frame->payload, frame->len, 0) < 0) {
-            ESP_LOGW(TAG, LOG_FMT("Failed to send WS payload"));
-            return ESP_FAIL;
+    /* Prepare Tx buffer - maximum header length is 10, which includes 2 bytes header, 8 bytes length */
+    uint8_t header_buf[10] = { 0 };
+    uint8_t tx_len = httpd_ws_format_header(header_buf, frame, payload_len, compressed);
+
+    esp_err_t ret = ESP_OK;
+
+    /* Coalesce header and small payloads into a single TCP push, so that
+     * streams of small messages don't pay one segment per header */
+    char tx_buf[128];
+    if (payload_len + tx_len <= sizeof(tx_buf)) {
+        memcpy(tx_buf, header_buf, tx_len);
+        if (payload_len > 0 && payload != NULL) {
+            memcpy(tx_buf + tx_len, payload, payload_len);
+        }
+        if (httpd_ws_send_all(hd, sess, fd, tx_buf, tx_len + payload_len) != ESP_OK) {
+            ESP_LOGW(TAG, LOG_FMT("Failed to send WS frame"));
+            ret = ESP_FAIL;
+        }
+    } else {
+        /* Send off header */
+        if (httpd_ws_send_all(hd, sess, fd, (const char *)header_buf, tx_len) != ESP_OK) {
+            ESP_LOGW(TAG, LOG_FMT("Failed to send WS header"));
+            ret = ESP_FAIL;
+        } else if (payload_len > 0 && payload != NULL) {
+            /* Send off payload */
+            if (httpd_ws_send_all(hd, sess, fd, (const char *)payload, payload_len) != ESP_OK) {
+                ESP_LOGW(TAG, LOG_FMT("Failed to send WS payload"));
+                ret = ESP_FAIL;
+            }
         }
     }
 
-    return ESP_OK;
+#ifdef CONFIG_HTTPD_WS_DEFLATE
+    free(comp_buf);
+#endif
+    return ret;
+}
+
+esp_err_t httpd_ws_send_frame_batch(httpd_handle_t hd, int fd, httpd_ws_frame_t *frames, size_t count)
+{
+    if (!frames || count == 0) {
+        ESP_LOGW(TAG, LOG_FMT("Argument is invalid"));
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    struct sock_db *sess = httpd_sess_get(hd, fd);
+    if (!sess) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* Worst case : full header plus uncompressed payload for every frame */
+    size_t total = 0;
+    size_t max_payload = 0;
+    for (size_t i = 0; i < count; i++) {
+        total += 10 + frames[i].len;
+        if (frames[i].len > max_payload) {
+            max_payload = frames[i].len;
+        }
+    }
+
+    uint8_t *tx_buf = malloc(total);
+    if (tx_buf == NULL) {
+        return ESP_ERR_HTTPD_ALLOC_MEM;
+    }
+
+#ifdef CONFIG_HTTPD_WS_DEFLATE
+    uint8_t *comp_buf = NULL;
+    if (sess->ws_deflate && max_payload >= CONFIG_HTTPD_WS_DEFLATE_MIN_LEN) {
+        /* Scratch for per-frame compression, reused across the batch */
+        comp_buf = malloc(max_payload);
+    }
+#endif
+
+    size_t off = 0;
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t *payload = frames[i].payload;
+        size_t payload_len = frames[i].len;
+        bool compressed = false;
+
+#ifdef CONFIG_HTTPD_WS_DEFLATE
+        if (comp_buf && httpd_ws_should_deflate(sess, &frames[i])) {
+            size_t comp_len = httpd_ws_deflate_payload(frames[i].payload, frames[i].len,
+                                                       comp_buf, frames[i].len - 1);
+            if (comp_len > 0) {
+                payload = comp_buf;
+                payload_len = comp_len;
+                compressed = true;
+            }
+        }
+#endif
+
+        off += httpd_ws_format_header(tx_buf + off, &frames[i], payload_len, compressed);
+        if (payload_len > 0 && payload != NULL) {
+            memcpy(tx_buf + off, payload, payload_len);
+            off += payload_len;
+        }
+    }
+
+    /* One TCP push for the whole batch */
+    esp_err_t ret = httpd_ws_send_all(hd, sess, fd, (const char *)tx_buf, off);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, LOG_FMT("Failed to send WS frame batch"));
+    }
+
+#ifdef CONFIG_HTTPD_WS_DEFLATE
+    free(comp_buf);
+#endif
+    free(tx_buf);
+    return ret;
 }
 
 esp_err_t httpd_ws_get_frame_type(httpd_req_t *req)
@@ -358,6 +633,10 @@ esp_err_t httpd_ws_get_frame_type(httpd_req_t *req)
     /* Decode the FIN flag and Opcode from the byte */
     aux->ws_final = (first_byte & HTTPD_WS_FIN_BIT) != 0;
     aux->ws_type = (first_byte & HTTPD_WS_OPCODE_BITS);
+#ifdef CONFIG_HTTPD_WS_DEFLATE
+    /* RSV1 marks a permessage-deflate compressed message, see RFC7692 Section 6 */
+    aux->ws_compressed = (first_byte & HTTPD_WS_RSV1_BIT) != 0;
+#endif
 
     /* Reply to PING. For PONG and CLOSE, it will be handled elsewhere. */
     if(aux->ws_type == HTTPD_WS_TYPE_PING) {
@@ -20,6 +20,13 @@
 #include <esp_ota_ops.h>
 #include <errno.h>
 
+#ifdef CONFIG_ESP_HTTPS_OTA_PIPELINED
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#endif
+
 #define IMAGE_HEADER_SIZE sizeof(esp_image_header_t) + sizeof(esp_image_segment_header_t) + sizeof(esp_app_desc_t) + 1
 #define DEFAULT_OTA_BUF_SIZE IMAGE_HEADER_SIZE
 static const char *TAG = "esp_https_ota";
@@ -31,6 +38,13 @@ typedef enum {
     ESP_HTTPS_OTA_SUCCESS,
 } esp_https_ota_state;
 
+#ifdef CONFIG_ESP_HTTPS_OTA_PIPELINED
+typedef struct {
+    char *buf;
+    int len;
+} esp_https_ota_chunk_t;
+#endif
+
 struct esp_https_ota_handle {
     esp_ota_handle_t update_handle;
     const esp_partition_t *update_partition;
@@ -40,6 +54,14 @@ struct esp_https_ota_handle {
     int binary_file_len;
     esp_https_ota_state state;
     bool bulk_flash_erase;
+#ifdef CONFIG_ESP_HTTPS_OTA_PIPELINED
+    bool pipeline_active;
+    esp_https_ota_chunk_t chunks[CONFIG_ESP_HTTPS_OTA_PIPELINE_BUF_COUNT];
+    QueueHandle_t write_queue;      /* filled chunks waiting for esp_ota_write */
+    QueueHandle_t free_queue;       /* empty chunks available for receiving */
+    SemaphoreHandle_t writer_done;
+    esp_err_t writer_err;           /* first esp_ota_write error, sticky */
+#endif
 };
 
 typedef struct esp_https_ota_handle esp_https_ota_t;
@@ -123,6 +145,114 @@ static void _http_cleanup(esp_http_client_handle_t client)
     esp_http_client_cleanup(client);
 }
 
+#ifdef CONFIG_ESP_HTTPS_OTA_PIPELINED
+/* Flash writer task: writes filled chunks while the caller's task keeps
+ * receiving the next ones, so OTA time approaches max(network, flash)
+ * instead of their sum. Exits on a NULL poison chunk. */
+static void _ota_writer_task(void *arg)
+{
+    esp_https_ota_t *handle = (esp_https_ota_t *)arg;
+    esp_https_ota_chunk_t *chunk;
+    while (xQueueReceive(handle->write_queue, &chunk, portMAX_DELAY) == pdTRUE) {
+        if (chunk == NULL) {
+            break;
+        }
+        if (handle->writer_err == ESP_OK) {
+            esp_err_t err = esp_ota_write(handle->update_handle, chunk->buf, chunk->len);
+            if (err != ESP_OK) {
+                ESP_LOGE(TAG, "Error: esp_ota_write failed! err=0x%x", err);
+                handle->writer_err = err;
+            } else {
+                handle->binary_file_len += chunk->len;
+                ESP_LOGD(TAG, "Written image length %d", handle->binary_file_len);
+            }
+        }
+        xQueueSend(handle->free_queue, &chunk, portMAX_DELAY);
+    }
+    xSemaphoreGive(handle->writer_done);
+    vTaskDelete(NULL);
+}
+
+/* Start the writer task and the chunk ring. Called once esp_ota_begin()
+ * has produced a valid update handle. On any failure the pipeline simply
+ * stays inactive and the serial write path is used. */
+static void _ota_pipeline_start(esp_https_ota_t *handle)
+{
+    handle->write_queue = xQueueCreate(CONFIG_ESP_HTTPS_OTA_PIPELINE_BUF_COUNT + 1, sizeof(esp_https_ota_chunk_t *));
+    handle->free_queue = xQueueCreate(CONFIG_ESP_HTTPS_OTA_PIPELINE_BUF_COUNT, sizeof(esp_https_ota_chunk_t *));
+    handle->writer_done = xSemaphoreCreateBinary();
+    if (handle->write_queue == NULL || handle->free_queue == NULL || handle->writer_done == NULL) {
+        goto error;
+    }
+    for (int i = 0; i < CONFIG_ESP_HTTPS_OTA_PIPELINE_BUF_COUNT; i++) {
+        handle->chunks[i].buf = malloc(handle->ota_upgrade_buf_size);
+        if (handle->chunks[i].buf == NULL) {
+            goto error;
+        }
+        esp_https_ota_chunk_t *chunk = &handle->chunks[i];
+        xQueueSend(handle->free_queue, &chunk, 0);
+    }
+    if (xTaskCreate(_ota_writer_task, "ota_writer", CONFIG_ESP_HTTPS_OTA_WRITER_STACK_SIZE,
+                    handle, CONFIG_ESP_HTTPS_OTA_WRITER_PRIORITY, NULL) != pdPASS) {
+        goto error;
+    }
+    handle->writer_err = ESP_OK;
+    handle->pipeline_active = true;
+    return;
+
+error:
+    ESP_LOGW(TAG, "Failed to start OTA write pipeline, falling back to serial writes");
+    for (int i = 0; i < CONFIG_ESP_HTTPS_OTA_PIPELINE_BUF_COUNT; i++) {
+        free(handle->chunks[i].buf);
+        handle->chunks[i].buf = NULL;
+    }
+    if (handle->write_queue) {
+        vQueueDelete(handle->write_queue);
+        handle->write_queue = NULL;
+    }
+    if (handle->free_queue) {
+        vQueueDelete(handle->free_queue);
+        handle->free_queue = NULL;
+    }
+    if (handle->writer_done) {
+        vSemaphoreDelete(handle->writer_done);
+        handle->writer_done = NULL;
+    }
+}
+
+/* Drain outstanding writes and tear the pipeline down. Returns the first
+ * write error, if any, so the caller can fail the OTA. */
+static esp_err_t _ota_pipeline_stop(esp_https_ota_t *handle)
+{
+    if (!handle->pipeline_active) {
+        return ESP_OK;
+    }
+    esp_https_ota_chunk_t *poison = NULL;
+    xQueueSend(handle->write_queue, &poison, portMAX_DELAY);
+    xSemaphoreTake(handle->writer_done, portMAX_DELAY);
+    for (int i = 0; i < CONFIG_ESP_HTTPS_OTA_PIPELINE_BUF_COUNT; i++) {
+        free(handle->chunks[i].buf);
+        handle->chunks[i].buf = NULL;
+    }
+    vQueueDelete(handle->write_queue);
+    handle->write_queue = NULL;
+    vQueueDelete(handle->free_queue);
+    handle->free_queue = NULL;
+    vSemaphoreDelete(handle->writer_done);
+    handle->writer_done = NULL;
+    handle->pipeline_active = false;
+    return handle->writer_err;
+}
+
+/* Hand a filled chunk to the writer task */
+static esp_err_t _ota_write_pipelined(esp_https_ota_t *handle, esp_https_ota_chunk_t *chunk, int len)
+{
+    chunk->len = len;
+    xQueueSend(handle->write_queue, &chunk, portMAX_DELAY);
+    return ESP_ERR_HTTPS_OTA_IN_PROGRESS;
+}
+#endif /* CONFIG_ESP_HTTPS_OTA_PIPELINED */
+
 static esp_err_t _ota_write(esp_https_ota_t *https_ota_handle, const void *buffer, size_t buf_len)
 {
     if (buffer == NULL || https_ota_handle == NULL) {
@@ -290,14 +420,56 @@ esp_err_t esp_https_ota_perform(esp_https_ota_handle_t https_ota_handle)
                 return err;
             }
             handle->state = ESP_HTTPS_OTA_IN_PROGRESS;
+#ifdef CONFIG_ESP_HTTPS_OTA_PIPELINED
+            _ota_pipeline_start(handle);
+#endif
             /* In case `esp_https_ota_read_img_desc` was invoked first,
                then the image data read there should be written to OTA partition
                */
             if (handle->binary_file_len) {
+#ifdef CONFIG_ESP_HTTPS_OTA_PIPELINED
+                if (handle->pipeline_active) {
+                    esp_https_ota_chunk_t *chunk;
+                    xQueueReceive(handle->free_queue, &chunk, portMAX_DELAY);
+                    memcpy(chunk->buf, handle->ota_upgrade_buf, handle->binary_file_len);
+                    return _ota_write_pipelined(handle, chunk, handle->binary_file_len);
+                }
+#endif
                 return _ota_write(handle, (const void *)handle->ota_upgrade_buf, handle->binary_file_len);
             }
             /* falls through */
         case ESP_HTTPS_OTA_IN_PROGRESS:
+#ifdef CONFIG_ESP_HTTPS_OTA_PIPELINED
+            if (handle->pipeline_active) {
+                if (handle->writer_err != ESP_OK) {
+                    return handle->writer_err;
+                }
+                /* Receive straight into a free chunk of the ring; waiting here
+                   is bounded by the flash writer catching up */
+                esp_https_ota_chunk_t *chunk;
+                xQueueReceive(handle->free_queue, &chunk, portMAX_DELAY);
+                data_read = esp_http_client_read(handle->http_client,
+                                                 chunk->buf,
+                                                 handle->ota_upgrade_buf_size);
+                if (data_read > 0) {
+                    return _ota_write_pipelined(handle, chunk, data_read);
+                }
+                xQueueSend(handle->free_queue, &chunk, portMAX_DELAY);
+                if (data_read < 0) {
+                    return ESP_FAIL;
+                }
+                bool is_recv_done = esp_https_ota_is_complete_data_received(https_ota_handle);
+                if ((errno == ENOTCONN || errno == ECONNRESET || errno == ECONNABORTED) && !is_recv_done) {
+                    ESP_LOGE(TAG, "Connection closed, errno = %d", errno);
+                    return ESP_FAIL;
+                } else if (!is_recv_done) {
+                    return ESP_ERR_HTTPS_OTA_IN_PROGRESS;
+                }
+                ESP_LOGI(TAG, "Connection closed");
+                handle->state = ESP_HTTPS_OTA_SUCCESS;
+                break;
+            }
+#endif
             data_read = esp_http_client_read(handle->http_client,
                                              handle->ota_upgrade_buf,
                                              handle->ota_upgrade_buf_size);
@@ -356,7 +528,18 @@ esp_err_t esp_https_ota_finish(esp_https_ota_handle_t https_ota_handle)
     switch (handle->state) {
         case ESP_HTTPS_OTA_SUCCESS:
         case ESP_HTTPS_OTA_IN_PROGRESS:
+#ifdef CONFIG_ESP_HTTPS_OTA_PIPELINED
+            /* Make sure every queued chunk has hit the flash before ending */
+            {
+                esp_err_t drain_err = _ota_pipeline_stop(handle);
+                err = esp_ota_end(handle->update_handle);
+                if (drain_err != ESP_OK) {
+                    err = drain_err;
+                }
+            }
+#else
             err = esp_ota_end(handle->update_handle);
+#endif
             /* falls through */
         case ESP_HTTPS_OTA_BEGIN:
             if (handle->ota_upgrade_buf) {
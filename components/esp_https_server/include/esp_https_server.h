@@ -71,6 +71,17 @@ struct httpd_ssl_config {
 
     /** Port used when transport mode is insecure (default 80) */
     uint16_t port_insecure;
+
+    /** Enable session tickets (RFC 5077), so returning clients resume with an
+     * abbreviated handshake. Requires the ESP_TLS_SERVER_SESSION_TICKETS
+     * option to be enabled */
+    bool session_tickets;
+
+    /** Run TLS handshakes on the async worker pool instead of the server
+     * task, so a burst of new connections does not stall request processing
+     * on already established sessions. Requires HTTPD_ASYNC_SUPPORT; when all
+     * workers are busy the handshake falls back to the server task */
+    bool handshake_offload;
 };
 
 typedef struct httpd_ssl_config httpd_ssl_config_t;
@@ -117,6 +128,8 @@ typedef struct httpd_ssl_config httpd_ssl_config_t;
     .transport_mode = HTTPD_SSL_TRANSPORT_SECURE, \
     .port_secure = 443,                           \
     .port_insecure = 80,                          \
+    .session_tickets = false,                     \
+    .handshake_offload = false,                   \
 }
 
 /**
@@ -23,6 +23,7 @@ const static char *TAG = "esp_https_server";
 typedef struct httpd_ssl_ctx {
     esp_tls_cfg_server_t *tls_cfg;
     httpd_open_func_t open_fn;
+    bool handshake_offload;
 } httpd_ssl_ctx_t;
 
 /**
@@ -85,6 +86,88 @@ static int httpd_ssl_send(httpd_handle_t server, int sockfd, const char *buf, si
     return esp_tls_conn_write(tls, buf, buf_len);
 }
 
+/**
+ * Install the established SSL session on the HTTPD session and notify the
+ * user open function. Runs in the server task context.
+ *
+ * @param server
+ * @param sockfd
+ * @param tls - SSL session with a completed handshake
+ * @param global_ctx
+ */
+static void httpd_ssl_install_transport(httpd_handle_t server, int sockfd, esp_tls_t *tls,
+                                        httpd_ssl_ctx_t *global_ctx)
+{
+    // Store the SSL session into the context field of the HTTPD session object
+    httpd_sess_set_transport_ctx(server, sockfd, tls, httpd_ssl_close);
+
+    // Set rx/tx/pending override functions
+    httpd_sess_set_send_override(server, sockfd, httpd_ssl_send);
+    httpd_sess_set_recv_override(server, sockfd, httpd_ssl_recv);
+    httpd_sess_set_pending_override(server, sockfd, httpd_ssl_pending);
+
+    // all access should now go through SSL
+
+    ESP_LOGD(TAG, "Secure socket open");
+
+    if (global_ctx->open_fn) {
+        (global_ctx->open_fn)(server, sockfd);
+    }
+}
+
+#ifdef CONFIG_HTTPD_ASYNC_SUPPORT
+/**
+ * Handshake handed from httpd_ssl_open() to an async worker
+ */
+typedef struct httpd_ssl_handshake_job {
+    httpd_handle_t server;
+    int sockfd;
+    esp_tls_t *tls;
+    httpd_ssl_ctx_t *global_ctx;
+    int ret;
+} httpd_ssl_handshake_job_t;
+
+/**
+ * Handshake completion; runs in the server task context. Returns the socket
+ * to the server loop and installs the SSL session, or closes the session if
+ * the handshake failed.
+ *
+ * @param[in] arg - the handshake job
+ */
+static void httpd_ssl_handshake_done(void *arg)
+{
+    httpd_ssl_handshake_job_t *job = arg;
+
+    httpd_sess_set_async_owned(job->server, job->sockfd, false);
+    if (job->ret != 0) {
+        ESP_LOGE(TAG, "esp_tls_create_server_session failed");
+        esp_tls_server_session_delete(job->tls);
+        httpd_sess_trigger_close(job->server, job->sockfd);
+    } else {
+        httpd_ssl_install_transport(job->server, job->sockfd, job->tls, job->global_ctx);
+    }
+    free(job);
+}
+
+/**
+ * Perform the handshake on an async worker, so that a burst of in-progress
+ * handshakes does not stall request processing on established sessions.
+ *
+ * @param[in] arg - the handshake job
+ */
+static void httpd_ssl_handshake_work(void *arg)
+{
+    httpd_ssl_handshake_job_t *job = arg;
+
+    job->ret = esp_tls_server_session_create(job->global_ctx->tls_cfg, job->sockfd, job->tls);
+    if (httpd_queue_work(job->server, httpd_ssl_handshake_done, job) != ESP_OK) {
+        // Server is shutting down and closes the socket itself
+        esp_tls_server_session_delete(job->tls);
+        free(job);
+    }
+}
+#endif // CONFIG_HTTPD_ASYNC_SUPPORT
+
 /**
  * Open a SSL socket for the server.
  * The fd is already open and ready to read / write raw data.
@@ -105,32 +188,38 @@ static esp_err_t httpd_ssl_open(httpd_handle_t server, int sockfd)
     if (!tls) {
         return ESP_ERR_NO_MEM;
     }
+
+#ifdef CONFIG_HTTPD_ASYNC_SUPPORT
+    if (global_ctx->handshake_offload) {
+        httpd_ssl_handshake_job_t *job = calloc(1, sizeof(httpd_ssl_handshake_job_t));
+        if (job) {
+            job->server = server;
+            job->sockfd = sockfd;
+            job->tls = tls;
+            job->global_ctx = global_ctx;
+            httpd_sess_set_async_owned(server, sockfd, true);
+            if (httpd_queue_work_async(server, httpd_ssl_handshake_work, job) == ESP_OK) {
+                ESP_LOGD(TAG, "session handshake offloaded to worker");
+                return ESP_OK;
+            }
+            // All workers are busy: hand the socket back to the server loop
+            // and perform the handshake in place
+            httpd_sess_set_async_owned(server, sockfd, false);
+            free(job);
+        }
+    }
+#endif
+
     ESP_LOGI(TAG, "performing session handshake");
     int ret = esp_tls_server_session_create(global_ctx->tls_cfg, sockfd, tls);
     if (ret != 0) {
         ESP_LOGE(TAG, "esp_tls_create_server_session failed");
-        goto fail;
+        esp_tls_server_session_delete(tls);
+        return ESP_FAIL;
     }
 
-    // Store the SSL session into the context field of the HTTPD session object
-    httpd_sess_set_transport_ctx(server, sockfd, tls, httpd_ssl_close);
-
-    // Set rx/tx/pending override functions
-    httpd_sess_set_send_override(server, sockfd, httpd_ssl_send);
-    httpd_sess_set_recv_override(server, sockfd, httpd_ssl_recv);
-    httpd_sess_set_pending_override(server, sockfd, httpd_ssl_pending);
-
-    // all access should now go through SSL
-
-    ESP_LOGD(TAG, "Secure socket open");
-
-    if (global_ctx->open_fn) {
-        (global_ctx->open_fn)(server, sockfd);
-    }
+    httpd_ssl_install_transport(server, sockfd, tls, global_ctx);
     return ESP_OK;
-fail:
-    esp_tls_server_session_delete(tls);
-    return ESP_FAIL;
 }
 
 /**
@@ -153,6 +242,9 @@ static void free_secure_context(void *ctx)
     if (cfg->serverkey_buf) {
         free((void *)cfg->serverkey_buf);
     }
+#ifdef CONFIG_ESP_TLS_SERVER_SESSION_TICKETS
+    esp_tls_cfg_server_session_tickets_free(cfg);
+#endif
     free(cfg);
     free(ssl_ctx);
 }
@@ -202,6 +294,28 @@ static httpd_ssl_ctx_t *create_secure_context(const struct httpd_ssl_config *con
     memcpy((char *)cfg->serverkey_buf, config->prvtkey_pem, config->prvtkey_len);
     cfg->serverkey_bytes = config->prvtkey_len;
 
+    if (config->session_tickets) {
+#ifdef CONFIG_ESP_TLS_SERVER_SESSION_TICKETS
+        if (esp_tls_cfg_server_session_tickets_init(cfg) != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to init session ticket support");
+            free((void *)cfg->serverkey_buf);
+            free((void *)cfg->servercert_buf);
+            free((void *)cfg->cacert_buf);
+            free(cfg);
+            free(ssl_ctx);
+            return NULL;
+        }
+#else
+        ESP_LOGE(TAG, "session_tickets requested but not enabled in menuconfig: Please enable ESP_TLS_SERVER_SESSION_TICKETS option");
+        free((void *)cfg->serverkey_buf);
+        free((void *)cfg->servercert_buf);
+        free((void *)cfg->cacert_buf);
+        free(cfg);
+        free(ssl_ctx);
+        return NULL;
+#endif
+    }
+
     return ssl_ctx;
 }
 
@@ -232,6 +346,16 @@ esp_err_t httpd_ssl_start(httpd_handle_t *pHandle, struct httpd_ssl_config *conf
         }
         config->httpd.open_fn = httpd_ssl_open; // the open function configures the created SSL sessions
 
+        if (config->handshake_offload) {
+#ifdef CONFIG_HTTPD_ASYNC_SUPPORT
+            ssl_ctx->handshake_offload = true;
+#else
+            // Offloading is only an optimization, so keep running with
+            // handshakes on the server task
+            ESP_LOGW(TAG, "handshake_offload requested but HTTPD_ASYNC_SUPPORT not enabled in menuconfig; handshakes stay on the server task");
+#endif
+        }
+
         config->httpd.server_port = config->port_secure;
     } else {
         ESP_LOGD(TAG, "SSL disabled, using plain HTTP");
@@ -0,0 +1,175 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdkconfig.h"
+
+#if CONFIG_IDF_TARGET_ESP32S2 || CONFIG_IDF_TARGET_ESP32S3
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_cache_lock.h"
+#include "freertos/FreeRTOS.h"
+#include "soc/soc.h"
+
+#if CONFIG_IDF_TARGET_ESP32S2
+#include "esp32s2/rom/cache.h"
+#else
+#include "esp32s3/rom/cache.h"
+#endif
+
+/* Cache sizes as configured, used for the oversubscription check */
+#if CONFIG_IDF_TARGET_ESP32S2
+#if CONFIG_ESP32S2_INSTRUCTION_CACHE_16KB
+#define CACHE_LOCK_ICACHE_SIZE  0x4000
+#else
+#define CACHE_LOCK_ICACHE_SIZE  0x2000
+#endif
+#if CONFIG_ESP32S2_DATA_CACHE_16KB
+#define CACHE_LOCK_DCACHE_SIZE  0x4000
+#elif CONFIG_ESP32S2_DATA_CACHE_8KB
+#define CACHE_LOCK_DCACHE_SIZE  0x2000
+#else
+#define CACHE_LOCK_DCACHE_SIZE  0
+#endif
+#else // CONFIG_IDF_TARGET_ESP32S3
+#define CACHE_LOCK_ICACHE_SIZE  CONFIG_ESP32S3_INSTRUCTION_CACHE_SIZE
+#define CACHE_LOCK_DCACHE_SIZE  CONFIG_ESP32S3_DATA_CACHE_SIZE
+#endif
+
+/* Accounting granularity, the largest supported cache line size */
+#define CACHE_LOCK_LINE_SIZE    32
+
+#define CACHE_LOCK_REGION_NUM   8
+
+typedef struct {
+    uint32_t addr;                  /* 0 when the slot is free */
+    uint32_t size;
+    uint32_t locked_bytes;          /* line-aligned span accounted for this region */
+    esp_cache_lock_cache_t cache;
+} cache_lock_region_t;
+
+static cache_lock_region_t s_regions[CACHE_LOCK_REGION_NUM];
+static uint32_t s_locked_bytes[2];
+static portMUX_TYPE s_cache_lock_mux = portMUX_INITIALIZER_UNLOCKED;
+
+/* Which cache backs an address range, or -1 if the range is not cache-backed.
+ * On ESP32-S2 flash rodata (DROM) goes through the instruction cache; on
+ * ESP32-S3 it goes through the data cache. */
+static int cache_for_region(uint32_t start, uint32_t end)
+{
+    if (start >= SOC_IROM_LOW && end <= SOC_IROM_HIGH) {
+        return ESP_CACHE_LOCK_ICACHE;
+    }
+    if (start >= SOC_DROM_LOW && end <= SOC_DROM_HIGH) {
+#if CONFIG_IDF_TARGET_ESP32S2
+        return ESP_CACHE_LOCK_ICACHE;
+#else
+        return ESP_CACHE_LOCK_DCACHE;
+#endif
+    }
+    if (start >= SOC_EXTRAM_DATA_LOW && end <= SOC_EXTRAM_DATA_HIGH) {
+        return ESP_CACHE_LOCK_DCACHE;
+    }
+    return -1;
+}
+
+static void cache_preload(esp_cache_lock_cache_t cache, uint32_t start, uint32_t len)
+{
+    if (cache == ESP_CACHE_LOCK_ICACHE) {
+        uint32_t autoload = Cache_Start_ICache_Preload(start, len, 0);
+        while (!Cache_ICache_Preload_Done()) {
+        }
+        Cache_End_ICache_Preload(autoload);
+    } else {
+        uint32_t autoload = Cache_Start_DCache_Preload(start, len, 0);
+        while (!Cache_DCache_Preload_Done()) {
+        }
+        Cache_End_DCache_Preload(autoload);
+    }
+}
+
+esp_err_t esp_cache_lock_region(const void *addr, size_t size)
+{
+    if (addr == NULL || size == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    uint32_t start = (uint32_t)addr & ~(CACHE_LOCK_LINE_SIZE - 1);
+    uint32_t end = ((uint32_t)addr + size + CACHE_LOCK_LINE_SIZE - 1) & ~(CACHE_LOCK_LINE_SIZE - 1);
+    int cache = cache_for_region(start, end);
+    if (cache < 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    uint32_t cache_size = (cache == ESP_CACHE_LOCK_ICACHE) ? CACHE_LOCK_ICACHE_SIZE : CACHE_LOCK_DCACHE_SIZE;
+    uint32_t locked_bytes = end - start;
+
+    portENTER_CRITICAL(&s_cache_lock_mux);
+    /* Leave at least half of the cache for the rest of the system */
+    if (s_locked_bytes[cache] + locked_bytes > cache_size / 2) {
+        portEXIT_CRITICAL(&s_cache_lock_mux);
+        return ESP_ERR_NO_MEM;
+    }
+    cache_lock_region_t *slot = NULL;
+    for (int i = 0; i < CACHE_LOCK_REGION_NUM; i++) {
+        if (s_regions[i].addr == 0) {
+            slot = &s_regions[i];
+            break;
+        }
+    }
+    if (slot == NULL) {
+        portEXIT_CRITICAL(&s_cache_lock_mux);
+        return ESP_ERR_NO_MEM;
+    }
+
+    cache_preload(cache, start, locked_bytes);
+    if (Cache_Lock_Addr(start, locked_bytes) != 0) {
+        portEXIT_CRITICAL(&s_cache_lock_mux);
+        return ESP_FAIL;
+    }
+
+    slot->addr = (uint32_t)addr;
+    slot->size = size;
+    slot->locked_bytes = locked_bytes;
+    slot->cache = cache;
+    s_locked_bytes[cache] += locked_bytes;
+    portEXIT_CRITICAL(&s_cache_lock_mux);
+    return ESP_OK;
+}
+
+esp_err_t esp_cache_unlock_region(const void *addr, size_t size)
+{
+    portENTER_CRITICAL(&s_cache_lock_mux);
+    for (int i = 0; i < CACHE_LOCK_REGION_NUM; i++) {
+        cache_lock_region_t *slot = &s_regions[i];
+        if (slot->addr == (uint32_t)addr && slot->size == size) {
+            uint32_t start = slot->addr & ~(CACHE_LOCK_LINE_SIZE - 1);
+            Cache_Unlock_Addr(start, slot->locked_bytes);
+            s_locked_bytes[slot->cache] -= slot->locked_bytes;
+            slot->addr = 0;
+            portEXIT_CRITICAL(&s_cache_lock_mux);
+            return ESP_OK;
+        }
+    }
+    portEXIT_CRITICAL(&s_cache_lock_mux);
+    return ESP_ERR_NOT_FOUND;
+}
+
+size_t esp_cache_lock_get_locked_size(esp_cache_lock_cache_t cache)
+{
+    if (cache != ESP_CACHE_LOCK_ICACHE && cache != ESP_CACHE_LOCK_DCACHE) {
+        return 0;
+    }
+    return s_locked_bytes[cache];
+}
+
+#endif // CONFIG_IDF_TARGET_ESP32S2 || CONFIG_IDF_TARGET_ESP32S3
@@ -0,0 +1,147 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdkconfig.h"
+
+#if CONFIG_IDF_TARGET_ESP32S3
+
+#include <stdint.h>
+#include <string.h>
+#include "esp_err.h"
+#include "esp_attr.h"
+#include "esp_gdma_manager.h"
+#include "freertos/FreeRTOS.h"
+#include "soc/soc_caps.h"
+#include "soc/gdma_caps.h"
+#include "hal/gdma_ll.h"
+
+#define GDMA_ARBITRATION_MAX  15
+
+typedef struct {
+    const char *owner;  /* NULL when the channel is free */
+    esp_gdma_channel_stats_t stats;
+} gdma_channel_entry_t;
+
+/* Channels with a fixed assignment in soc_caps.h start out claimed, so
+ * esp_gdma_claim_any_channel() only hands out the truly free ones */
+static gdma_channel_entry_t s_channels[SOC_GDMA_CHANNELS_NUM] = {
+    [SOC_GDMA_M2M_DMA_CHANNEL]  = { .owner = "async_memcpy" },
+    [SOC_GDMA_SPI2_DMA_CHANNEL] = { .owner = "spi2" },
+    [SOC_GDMA_SPI3_DMA_CHANNEL] = { .owner = "spi3" },
+    [SOC_GDMA_SHA_DMA_CHANNEL]  = { .owner = "sha" },
+};
+static portMUX_TYPE s_gdma_mgr_mux = portMUX_INITIALIZER_UNLOCKED;
+
+esp_err_t esp_gdma_claim_channel(int channel, const char *owner)
+{
+    if (channel < 0 || channel >= SOC_GDMA_CHANNELS_NUM || owner == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err = ESP_ERR_INVALID_STATE;
+    portENTER_CRITICAL(&s_gdma_mgr_mux);
+    if (s_channels[channel].owner == NULL) {
+        s_channels[channel].owner = owner;
+        err = ESP_OK;
+    }
+    portEXIT_CRITICAL(&s_gdma_mgr_mux);
+    return err;
+}
+
+esp_err_t esp_gdma_claim_any_channel(const char *owner, int *out_channel)
+{
+    if (owner == NULL || out_channel == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err = ESP_ERR_NOT_FOUND;
+    portENTER_CRITICAL(&s_gdma_mgr_mux);
+    for (int i = 0; i < SOC_GDMA_CHANNELS_NUM; i++) {
+        if (s_channels[i].owner == NULL) {
+            s_channels[i].owner = owner;
+            *out_channel = i;
+            err = ESP_OK;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_gdma_mgr_mux);
+    return err;
+}
+
+esp_err_t esp_gdma_release_channel(int channel, const char *owner)
+{
+    if (channel < 0 || channel >= SOC_GDMA_CHANNELS_NUM || owner == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err = ESP_ERR_INVALID_STATE;
+    portENTER_CRITICAL(&s_gdma_mgr_mux);
+    if (s_channels[channel].owner != NULL && strcmp(s_channels[channel].owner, owner) == 0) {
+        s_channels[channel].owner = NULL;
+        err = ESP_OK;
+    }
+    portEXIT_CRITICAL(&s_gdma_mgr_mux);
+    return err;
+}
+
+const char *esp_gdma_channel_owner(int channel)
+{
+    if (channel < 0 || channel >= SOC_GDMA_CHANNELS_NUM) {
+        return NULL;
+    }
+    return s_channels[channel].owner;
+}
+
+esp_err_t esp_gdma_set_arbitration(int channel, uint32_t priority, uint32_t weight)
+{
+    if (channel < 0 || channel >= SOC_GDMA_CHANNELS_NUM ||
+            priority > GDMA_ARBITRATION_MAX || weight > GDMA_ARBITRATION_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&s_gdma_mgr_mux);
+    gdma_ll_tx_set_priority(&GDMA, channel, priority);
+    gdma_ll_rx_set_priority(&GDMA, channel, priority);
+    gdma_ll_tx_set_weight(&GDMA, channel, weight);
+    gdma_ll_rx_set_weight(&GDMA, channel, weight);
+    portEXIT_CRITICAL(&s_gdma_mgr_mux);
+    return ESP_OK;
+}
+
+void IRAM_ATTR esp_gdma_channel_count_bytes(int channel, size_t tx_bytes, size_t rx_bytes)
+{
+    portENTER_CRITICAL_SAFE(&s_gdma_mgr_mux);
+    s_channels[channel].stats.tx_bytes += tx_bytes;
+    s_channels[channel].stats.rx_bytes += rx_bytes;
+    portEXIT_CRITICAL_SAFE(&s_gdma_mgr_mux);
+}
+
+void IRAM_ATTR esp_gdma_channel_count_stall(int channel)
+{
+    portENTER_CRITICAL_SAFE(&s_gdma_mgr_mux);
+    s_channels[channel].stats.stall_events++;
+    portEXIT_CRITICAL_SAFE(&s_gdma_mgr_mux);
+}
+
+esp_err_t esp_gdma_get_channel_stats(int channel, esp_gdma_channel_stats_t *stats, bool clear)
+{
+    if (channel < 0 || channel >= SOC_GDMA_CHANNELS_NUM || stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&s_gdma_mgr_mux);
+    *stats = s_channels[channel].stats;
+    if (clear) {
+        memset(&s_channels[channel].stats, 0, sizeof(s_channels[channel].stats));
+    }
+    portEXIT_CRITICAL(&s_gdma_mgr_mux);
+    return ESP_OK;
+}
+
+#endif // CONFIG_IDF_TARGET_ESP32S3
@@ -0,0 +1,90 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file esp_cache_lock.h
+ * @brief Preload and lock flash/PSRAM-backed regions into cache (ESP32-S2/S3).
+ *
+ * Locking a code or data region pins its lines in the instruction or data
+ * cache so that a hard-real-time loop touching it can never take a flash
+ * cache miss, without moving the code to IRAM. Locked bytes are accounted
+ * per cache; a lock request which would pin more than half of a cache is
+ * rejected, so drivers cannot oversubscribe and starve the rest of the
+ * system of cache lines.
+ */
+
+/** Caches which can hold locked regions, see esp_cache_lock_get_locked_size() */
+typedef enum {
+    ESP_CACHE_LOCK_ICACHE = 0,  /*!< Instruction cache */
+    ESP_CACHE_LOCK_DCACHE,      /*!< Data cache */
+} esp_cache_lock_cache_t;
+
+/**
+ * @brief Preload a region into cache and lock it there.
+ *
+ * The region must be cache-backed (flash code or rodata, or external RAM);
+ * which cache is used follows from the address. The region is first preloaded
+ * so that its lines are present, then locked so they are never evicted.
+ *
+ * Call esp_cache_unlock_region() with the same address and size to release
+ * the lines. Regions stay locked across light sleep but not across a reset.
+ *
+ * @param addr  Start of the region. Rounded down to a cache line boundary internally.
+ * @param size  Size of the region in bytes.
+ *
+ * @return
+ *  - ESP_OK: region preloaded and locked
+ *  - ESP_ERR_INVALID_ARG: size is zero or the region is not cache-backed
+ *  - ESP_ERR_NO_MEM: locking the region would pin more than half of the cache,
+ *    or the region table is full
+ *  - ESP_FAIL: the cache rejected the lock operation
+ */
+esp_err_t esp_cache_lock_region(const void *addr, size_t size);
+
+/**
+ * @brief Unlock a region previously locked with esp_cache_lock_region().
+ *
+ * @param addr  Start address passed to esp_cache_lock_region()
+ * @param size  Size passed to esp_cache_lock_region()
+ *
+ * @return
+ *  - ESP_OK: region unlocked
+ *  - ESP_ERR_NOT_FOUND: no matching locked region
+ */
+esp_err_t esp_cache_unlock_region(const void *addr, size_t size);
+
+/**
+ * @brief Get the number of bytes currently locked in a cache.
+ *
+ * Byte counts are rounded up to cache line granularity, matching what the
+ * oversubscription check uses.
+ *
+ * @param cache  Which cache to query
+ * @return Locked bytes, 0 if nothing is locked (or the chip has no such cache)
+ */
+size_t esp_cache_lock_get_locked_size(esp_cache_lock_cache_t cache);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,142 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file esp_gdma_manager.h
+ * @brief Central bookkeeping for GDMA channels (ESP32-S3).
+ *
+ * GDMA channels are claimed by name, so concurrent-DMA scenarios are
+ * provisioned up front instead of failing inside a driver at run time. The
+ * manager also exposes the hardware arbitration knobs (fixed priority and
+ * weighted round-robin burst weight) per channel, and keeps per-channel
+ * throughput/stall counters which the owning drivers feed.
+ *
+ * Channels with a fixed assignment in this SoC (M2M copy, SPI2, SPI3, SHA)
+ * start out claimed by their default owners; release them explicitly if the
+ * corresponding peripheral is unused and the channel is needed elsewhere.
+ */
+
+/** Per-channel counters, accumulated by the owning driver */
+typedef struct {
+    uint32_t tx_bytes;      /*!< Bytes moved by the TX (out) side */
+    uint32_t rx_bytes;      /*!< Bytes moved by the RX (in) side */
+    uint32_t stall_events;  /*!< Descriptor starvation / FIFO stall events */
+} esp_gdma_channel_stats_t;
+
+/**
+ * @brief Claim a specific GDMA channel.
+ *
+ * @param channel  Channel number (0 .. SOC_GDMA_CHANNELS_NUM - 1)
+ * @param owner    Name recorded for the reservation, must outlive it (string literal)
+ *
+ * @return
+ *  - ESP_OK: channel reserved for owner
+ *  - ESP_ERR_INVALID_ARG: invalid channel or NULL owner
+ *  - ESP_ERR_INVALID_STATE: channel already claimed; see esp_gdma_channel_owner()
+ */
+esp_err_t esp_gdma_claim_channel(int channel, const char *owner);
+
+/**
+ * @brief Claim any free GDMA channel.
+ *
+ * @param owner        Name recorded for the reservation
+ * @param out_channel  Set to the claimed channel number on success
+ *
+ * @return
+ *  - ESP_OK: a channel was reserved
+ *  - ESP_ERR_INVALID_ARG: NULL argument
+ *  - ESP_ERR_NOT_FOUND: all channels are claimed
+ */
+esp_err_t esp_gdma_claim_any_channel(const char *owner, int *out_channel);
+
+/**
+ * @brief Release a claimed channel.
+ *
+ * @param channel  Channel number
+ * @param owner    Must match the name the channel was claimed with
+ *
+ * @return
+ *  - ESP_OK: channel released
+ *  - ESP_ERR_INVALID_ARG: invalid channel
+ *  - ESP_ERR_INVALID_STATE: channel not claimed or owner does not match
+ */
+esp_err_t esp_gdma_release_channel(int channel, const char *owner);
+
+/**
+ * @brief Get the owner of a channel.
+ *
+ * @param channel  Channel number
+ * @return Owner name, or NULL if the channel is free or invalid
+ */
+const char *esp_gdma_channel_owner(int channel);
+
+/**
+ * @brief Configure arbitration for a channel (both TX and RX directions).
+ *
+ * Higher priority channels win arbitration outright; among equal priorities
+ * the burst weight sets the share of back-to-back bursts a channel gets.
+ *
+ * @param channel   Channel number
+ * @param priority  Fixed arbitration priority, 0 (lowest) to 15
+ * @param weight    Weighted round-robin burst weight, 0 to 15
+ *
+ * @return
+ *  - ESP_OK: arbitration configured
+ *  - ESP_ERR_INVALID_ARG: invalid channel, priority or weight
+ */
+esp_err_t esp_gdma_set_arbitration(int channel, uint32_t priority, uint32_t weight);
+
+/**
+ * @brief Add transferred bytes to a channel's counters. Safe to call from ISRs.
+ *
+ * @param channel   Channel number (not validated, caller owns the channel)
+ * @param tx_bytes  Bytes moved by the TX side to add
+ * @param rx_bytes  Bytes moved by the RX side to add
+ */
+void esp_gdma_channel_count_bytes(int channel, size_t tx_bytes, size_t rx_bytes);
+
+/**
+ * @brief Count a stall (descriptor starvation / FIFO overflow) event. Safe to call from ISRs.
+ *
+ * @param channel  Channel number (not validated, caller owns the channel)
+ */
+void esp_gdma_channel_count_stall(int channel);
+
+/**
+ * @brief Read (and optionally clear) the counters of a channel.
+ *
+ * @param channel  Channel number
+ * @param stats    Filled with the current counter values
+ * @param clear    Reset the counters to zero after reading
+ *
+ * @return
+ *  - ESP_OK on success
+ *  - ESP_ERR_INVALID_ARG: invalid channel or NULL stats
+ */
+esp_err_t esp_gdma_get_channel_stats(int channel, esp_gdma_channel_stats_t *stats, bool clear);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,32 @@
+#include "unity.h"
+#include "sdkconfig.h"
+
+#if CONFIG_IDF_TARGET_ESP32S2 || CONFIG_IDF_TARGET_ESP32S3
+
+#include "esp_cache_lock.h"
+
+/* Flash-resident data to lock; big enough to span several cache lines */
+static const char s_flash_blob[256] = "cache lock test blob";
+
+TEST_CASE("cache lock accounts locked regions", "[esp_cache_lock]")
+{
+    size_t before = esp_cache_lock_get_locked_size(ESP_CACHE_LOCK_ICACHE) +
+                    esp_cache_lock_get_locked_size(ESP_CACHE_LOCK_DCACHE);
+
+    TEST_ESP_OK(esp_cache_lock_region(s_flash_blob, sizeof(s_flash_blob)));
+    size_t locked = esp_cache_lock_get_locked_size(ESP_CACHE_LOCK_ICACHE) +
+                    esp_cache_lock_get_locked_size(ESP_CACHE_LOCK_DCACHE);
+    TEST_ASSERT_GREATER_OR_EQUAL(before + sizeof(s_flash_blob), locked);
+
+    TEST_ESP_OK(esp_cache_unlock_region(s_flash_blob, sizeof(s_flash_blob)));
+    locked = esp_cache_lock_get_locked_size(ESP_CACHE_LOCK_ICACHE) +
+             esp_cache_lock_get_locked_size(ESP_CACHE_LOCK_DCACHE);
+    TEST_ASSERT_EQUAL(before, locked);
+
+    /* Unknown regions and internal RAM are rejected */
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, esp_cache_unlock_region(s_flash_blob, sizeof(s_flash_blob)));
+    int on_stack;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_cache_lock_region(&on_stack, sizeof(on_stack)));
+}
+
+#endif // CONFIG_IDF_TARGET_ESP32S2 || CONFIG_IDF_TARGET_ESP32S3
@@ -0,0 +1,108 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __ESP_IPC_ASYNC_H__
+#define __ESP_IPC_ASYNC_H__
+
+#include <stdbool.h>
+#include "esp_err.h"
+#include "esp_ipc.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef CONFIG_ESP_IPC_ASYNC
+
+/*
+ * Asynchronous inter-processor call APIs
+ *
+ * Unlike esp_ipc_call(), which serializes all callers through one rendezvous
+ * and blocks until the target core picks the call up, these APIs append the
+ * call to a bounded lock-free ring of the target core and return immediately.
+ * Completion is tracked through a lightweight caller-allocated future which
+ * can be polled or waited on, so frequent cross-core handoffs do not cost a
+ * blocking round trip each.
+ */
+
+/**
+ * @brief Completion future of an asynchronous IPC call
+ *
+ * Allocated by the caller (typically on the stack or in the job it describes)
+ * and passed to esp_ipc_call_async(). Must stay valid until the future
+ * completes. Treat the fields as private.
+ */
+typedef struct {
+    volatile uint32_t state;    /*!< private: 0 while pending, 1 once the call has returned */
+    TaskHandle_t waiter;        /*!< private: task to notify on completion, NULL when polling */
+} esp_ipc_future_t;
+
+/**
+ * @brief Execute a function on the given CPU without blocking the caller
+ *
+ * The call is placed on the submission ring of cpu_id and executed there in
+ * the context of a high priority async IPC task, in submission order. If
+ * future is not NULL it is armed before the call is queued and completes once
+ * the function has returned; pass NULL for fire-and-forget calls.
+ *
+ * @note    In single-core mode, returns ESP_ERR_INVALID_ARG for cpu_id 1.
+ *
+ * @param[in]   cpu_id  CPU where the given function should be executed (0 or 1)
+ * @param[in]   func    Pointer to a function of type void func(void* arg) to be executed
+ * @param[in]   arg     Arbitrary argument of type void* to be passed into the function
+ * @param[out]  future  Completion future to arm, or NULL
+ *
+ * @return
+ *      - ESP_ERR_INVALID_ARG if cpu_id is invalid
+ *      - ESP_ERR_INVALID_STATE if the FreeRTOS scheduler is not running
+ *      - ESP_ERR_NO_MEM if the submission ring of cpu_id is full
+ *      - ESP_OK otherwise
+ */
+esp_err_t esp_ipc_call_async(uint32_t cpu_id, esp_ipc_func_t func, void* arg, esp_ipc_future_t* future);
+
+/**
+ * @brief Poll whether an asynchronous IPC call has completed
+ *
+ * @param[in]   future  Future passed to esp_ipc_call_async()
+ *
+ * @return true once the queued function has returned on the target core
+ */
+bool esp_ipc_future_is_done(const esp_ipc_future_t* future);
+
+/**
+ * @brief Wait for an asynchronous IPC call to complete
+ *
+ * Blocks the calling task until the future completes or the timeout expires.
+ * Uses the calling task's notification value, so only one task may wait on a
+ * given future at a time.
+ *
+ * @param[in]   future          Future passed to esp_ipc_call_async()
+ * @param[in]   timeout_ticks   Maximum number of ticks to wait, or portMAX_DELAY
+ *
+ * @return
+ *      - ESP_ERR_TIMEOUT if the future did not complete in time
+ *      - ESP_OK otherwise
+ */
+esp_err_t esp_ipc_future_wait(esp_ipc_future_t* future, TickType_t timeout_ticks);
+
+#endif // CONFIG_ESP_IPC_ASYNC
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ESP_IPC_ASYNC_H__ */
@@ -0,0 +1,101 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __ESP_IPC_WORK_H__
+#define __ESP_IPC_WORK_H__
+
+#include <stdbool.h>
+#include "esp_err.h"
+#include "esp_ipc.h"
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef CONFIG_ESP_IPC_WORK_QUEUE
+
+/*
+ * Work queue APIs
+ *
+ * Unlike esp_ipc_call(), which runs one function on a specific CPU and blocks
+ * the caller until it starts, the work queue runs posted items detached from
+ * the caller on whichever core gets to them first. Each core owns a run queue
+ * drained by a pinned worker task; a worker whose own queue is empty steals
+ * items queued for the other core, so parallelizable jobs use whichever core
+ * is idle without the caller managing task affinity.
+ */
+
+/**
+ * @brief Start the per-core worker tasks of the work queue
+ *
+ * Must be called once before any items are posted. Subsequent calls return
+ * ESP_ERR_INVALID_STATE.
+ *
+ * @return
+ *      - ESP_ERR_INVALID_STATE if the work queue is already running
+ *      - ESP_ERR_NO_MEM if the worker tasks or semaphores cannot be allocated
+ *      - ESP_OK otherwise
+ */
+esp_err_t esp_ipc_work_queue_init(void);
+
+/**
+ * @brief Post a work item, preferring execution on the given CPU
+ *
+ * The item is queued on the run queue of preferred_cpu and normally executes
+ * there, but an idle worker on the other core may steal it. The caller is not
+ * blocked and is not notified of completion; the function runs in the context
+ * of a worker task at the priority configured in menuconfig.
+ *
+ * @param[in]   preferred_cpu  CPU whose run queue the item is placed on (0 or 1)
+ * @param[in]   func           Pointer to a function of type void func(void* arg) to be executed
+ * @param[in]   arg            Arbitrary argument of type void* to be passed into the function
+ *
+ * @return
+ *      - ESP_ERR_INVALID_ARG if preferred_cpu is invalid
+ *      - ESP_ERR_INVALID_STATE if the work queue has not been started
+ *      - ESP_ERR_NO_MEM if the run queue of preferred_cpu is full
+ *      - ESP_OK otherwise
+ */
+esp_err_t esp_ipc_work_post(uint32_t preferred_cpu, esp_ipc_func_t func, void* arg);
+
+/**
+ * @brief Post a work item from an ISR
+ *
+ * Same queueing behavior as esp_ipc_work_post(); the item itself still runs
+ * in worker task context, which makes this a way to defer non-trivial work
+ * out of an interrupt handler.
+ *
+ * @param[in]   preferred_cpu   CPU whose run queue the item is placed on (0 or 1)
+ * @param[in]   func            Pointer to a function of type void func(void* arg) to be executed
+ * @param[in]   arg             Arbitrary argument of type void* to be passed into the function
+ * @param[out]  higher_priority_task_woken  Set to true if posting woke a worker task of
+ *                              higher priority than the interrupted task; pass to
+ *                              portYIELD_FROM_ISR(). Can be NULL.
+ *
+ * @return
+ *      - ESP_ERR_INVALID_ARG if preferred_cpu is invalid
+ *      - ESP_ERR_INVALID_STATE if the work queue has not been started
+ *      - ESP_ERR_NO_MEM if the run queue of preferred_cpu is full
+ *      - ESP_OK otherwise
+ */
+esp_err_t esp_ipc_work_post_from_isr(uint32_t preferred_cpu, esp_ipc_func_t func, void* arg, bool *higher_priority_task_woken);
+
+#endif // CONFIG_ESP_IPC_WORK_QUEUE
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ESP_IPC_WORK_H__ */
@@ -0,0 +1,188 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdkconfig.h"
+
+#ifdef CONFIG_ESP_IPC_ASYNC
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "esp_err.h"
+#include "esp_ipc_async.h"
+#include "esp_attr.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#define IPC_FUTURE_PENDING      0
+#define IPC_FUTURE_DONE         1
+
+// Ring length rounded up to a power of two so indices can wrap with a mask
+#define IPC_ASYNC_RING_LEN      (1U << (32 - __builtin_clz(CONFIG_ESP_IPC_ASYNC_QUEUE_LEN - 1)))
+#define IPC_ASYNC_RING_MASK     (IPC_ASYNC_RING_LEN - 1)
+
+typedef struct {
+    volatile uint32_t seq;      // slot sequence number (Vyukov bounded queue scheme)
+    esp_ipc_func_t func;
+    void *arg;
+    esp_ipc_future_t *future;
+} ipc_async_slot_t;
+
+// Per-core submission rings. Multiple producers claim slots by CAS on the
+// tail; the single consumer is the async IPC task pinned to that core, so
+// submission never takes a lock or a critical section.
+static ipc_async_slot_t s_async_ring[portNUM_PROCESSORS][IPC_ASYNC_RING_LEN];
+static volatile uint32_t s_async_tail[portNUM_PROCESSORS];
+static uint32_t s_async_head[portNUM_PROCESSORS];   // only touched by the owning async task
+static TaskHandle_t s_async_task_handle[portNUM_PROCESSORS];
+
+// Claim a slot on the target core's ring; returns false if the ring is full
+static bool async_ring_push(uint32_t cpu_id, esp_ipc_func_t func, void* arg, esp_ipc_future_t* future)
+{
+    ipc_async_slot_t *slot;
+    uint32_t pos;
+    while (true) {
+        pos = s_async_tail[cpu_id];
+        slot = &s_async_ring[cpu_id][pos & IPC_ASYNC_RING_MASK];
+        int32_t dif = (int32_t)(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - pos);
+        if (dif == 0) {
+            if (__atomic_compare_exchange_n(&s_async_tail[cpu_id], &pos, pos + 1,
+                                            true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (dif < 0) {
+            return false;   // slot not yet consumed since the last lap: ring is full
+        }
+        // dif > 0: another producer claimed this slot first, reload the tail
+    }
+    slot->func = func;
+    slot->arg = arg;
+    slot->future = future;
+    // Publishing seq = pos + 1 hands the slot to the consumer
+    __atomic_store_n(&slot->seq, pos + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+// Pop the oldest item of the own ring; single consumer, so no CAS is needed
+static bool async_ring_pop(uint32_t cpu_id, esp_ipc_func_t *func, void **arg, esp_ipc_future_t **future)
+{
+    uint32_t pos = s_async_head[cpu_id];
+    ipc_async_slot_t *slot = &s_async_ring[cpu_id][pos & IPC_ASYNC_RING_MASK];
+    if ((int32_t)(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - (pos + 1)) != 0) {
+        return false;   // producer has not published this slot yet: ring is empty
+    }
+    *func = slot->func;
+    *arg = slot->arg;
+    *future = slot->future;
+    // Recycling seq for the next lap hands the slot back to the producers
+    __atomic_store_n(&slot->seq, pos + IPC_ASYNC_RING_LEN, __ATOMIC_RELEASE);
+    s_async_head[cpu_id] = pos + 1;
+    return true;
+}
+
+static void ipc_future_complete(esp_ipc_future_t *future)
+{
+    // The state store must be visible before the waiter is read so that a
+    // task registering itself concurrently either sees DONE or gets notified
+    __atomic_store_n(&future->state, IPC_FUTURE_DONE, __ATOMIC_SEQ_CST);
+    TaskHandle_t waiter = __atomic_load_n(&future->waiter, __ATOMIC_SEQ_CST);
+    if (waiter != NULL) {
+        xTaskNotifyGive(waiter);
+    }
+}
+
+static void IRAM_ATTR ipc_async_task(void* arg)
+{
+    const uint32_t cpuid = (uint32_t) arg;
+    assert(cpuid == xPortGetCoreID());
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        esp_ipc_func_t func;
+        void *func_arg;
+        esp_ipc_future_t *future;
+        while (async_ring_pop(cpuid, &func, &func_arg, &future)) {
+            (*func)(func_arg);
+            if (future != NULL) {
+                ipc_future_complete(future);
+            }
+        }
+    }
+    vTaskDelete(NULL);
+}
+
+/*
+ * Started automatically on CPU start, like the rendezvous IPC tasks in ipc.c.
+ * One async IPC task runs pinned to each core and drains that core's
+ * submission ring in order.
+ */
+static void esp_ipc_async_init(void) __attribute__((constructor));
+
+static void esp_ipc_async_init(void)
+{
+    char task_name[15];
+    for (int i = 0; i < portNUM_PROCESSORS; ++i) {
+        snprintf(task_name, sizeof(task_name), "ipc_async%d", i);
+        for (uint32_t j = 0; j < IPC_ASYNC_RING_LEN; ++j) {
+            s_async_ring[i][j].seq = j;
+        }
+        portBASE_TYPE res = xTaskCreatePinnedToCore(ipc_async_task, task_name, CONFIG_ESP_IPC_TASK_STACK_SIZE,
+                                                    (void*) i, configMAX_PRIORITIES - 1, &s_async_task_handle[i], i);
+        assert(res == pdTRUE);
+    }
+}
+
+esp_err_t esp_ipc_call_async(uint32_t cpu_id, esp_ipc_func_t func, void* arg, esp_ipc_future_t* future)
+{
+    if (cpu_id >= portNUM_PROCESSORS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (future != NULL) {
+        future->state = IPC_FUTURE_PENDING;
+        future->waiter = NULL;
+    }
+    if (!async_ring_push(cpu_id, func, arg, future)) {
+        return ESP_ERR_NO_MEM;
+    }
+    xTaskNotifyGive(s_async_task_handle[cpu_id]);
+    return ESP_OK;
+}
+
+bool esp_ipc_future_is_done(const esp_ipc_future_t* future)
+{
+    return __atomic_load_n(&future->state, __ATOMIC_ACQUIRE) == IPC_FUTURE_DONE;
+}
+
+esp_err_t esp_ipc_future_wait(esp_ipc_future_t* future, TickType_t timeout_ticks)
+{
+    if (esp_ipc_future_is_done(future)) {
+        return ESP_OK;
+    }
+    // Register as waiter, then re-check: the completing side stores DONE
+    // before it reads the waiter, so we either see DONE here or get notified
+    __atomic_store_n(&future->waiter, xTaskGetCurrentTaskHandle(), __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&future->state, __ATOMIC_SEQ_CST) != IPC_FUTURE_DONE) {
+        ulTaskNotifyTake(pdTRUE, timeout_ticks);
+    }
+    __atomic_store_n(&future->waiter, NULL, __ATOMIC_SEQ_CST);
+    return esp_ipc_future_is_done(future) ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+#endif // CONFIG_ESP_IPC_ASYNC
@@ -0,0 +1,178 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdkconfig.h"
+
+#ifdef CONFIG_ESP_IPC_WORK_QUEUE
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "esp_ipc_work.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+typedef struct {
+    esp_ipc_func_t func;
+    void *arg;
+} ipc_work_item_t;
+
+// Per-core run queues: fixed rings drained at the head and filled at the tail.
+// Guarded by per-core spinlocks so ISRs and the stealing worker on the other
+// core can access them safely.
+static ipc_work_item_t s_work_ring[portNUM_PROCESSORS][CONFIG_ESP_IPC_WORK_QUEUE_LEN];
+static uint32_t s_work_head[portNUM_PROCESSORS];
+static uint32_t s_work_count[portNUM_PROCESSORS];
+static portMUX_TYPE s_work_lock[portNUM_PROCESSORS] = {
+    portMUX_INITIALIZER_UNLOCKED,
+#if portNUM_PROCESSORS > 1
+    portMUX_INITIALIZER_UNLOCKED,
+#endif
+};
+static TaskHandle_t s_work_task_handle[portNUM_PROCESSORS];
+static SemaphoreHandle_t s_work_sem[portNUM_PROCESSORS];    // counts pending wakeups per worker
+static bool s_work_queue_started;
+
+// Pop the oldest item of the given core's ring; returns false if it was empty
+static bool work_pop(uint32_t cpuid, ipc_work_item_t *item)
+{
+    bool got_item = false;
+    portENTER_CRITICAL(&s_work_lock[cpuid]);
+    if (s_work_count[cpuid] > 0) {
+        *item = s_work_ring[cpuid][s_work_head[cpuid]];
+        s_work_head[cpuid] = (s_work_head[cpuid] + 1) % CONFIG_ESP_IPC_WORK_QUEUE_LEN;
+        s_work_count[cpuid]--;
+        got_item = true;
+    }
+    portEXIT_CRITICAL(&s_work_lock[cpuid]);
+    return got_item;
+}
+
+static void ipc_work_task(void* arg)
+{
+    const uint32_t cpuid = (uint32_t) arg;
+    ipc_work_item_t item;
+    while (true) {
+        xSemaphoreTake(s_work_sem[cpuid], portMAX_DELAY);
+
+        // Drain the own run queue first, then steal from the other cores'
+        // queues so no core sits idle while work is backlogged elsewhere
+        bool got_item = work_pop(cpuid, &item);
+        for (uint32_t victim = 0; !got_item && victim < portNUM_PROCESSORS; victim++) {
+            if (victim != cpuid) {
+                got_item = work_pop(victim, &item);
+            }
+        }
+        if (got_item) {
+            (*item.func)(item.arg);
+        }
+    }
+    vTaskDelete(NULL);
+}
+
+esp_err_t esp_ipc_work_queue_init(void)
+{
+    if (s_work_queue_started) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    char task_name[15];
+    for (int i = 0; i < portNUM_PROCESSORS; ++i) {
+        snprintf(task_name, sizeof(task_name), "ipc_work%d", i);
+        s_work_sem[i] = xSemaphoreCreateCounting(portNUM_PROCESSORS * CONFIG_ESP_IPC_WORK_QUEUE_LEN, 0);
+        if (s_work_sem[i] == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+        portBASE_TYPE res = xTaskCreatePinnedToCore(ipc_work_task, task_name, CONFIG_ESP_IPC_WORK_TASK_STACK_SIZE,
+                                                    (void*) i, CONFIG_ESP_IPC_WORK_TASK_PRIORITY, &s_work_task_handle[i], i);
+        if (res != pdTRUE) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    s_work_queue_started = true;
+    return ESP_OK;
+}
+
+// Append the item to the preferred core's ring; fails if the ring is full
+static esp_err_t work_push(uint32_t preferred_cpu, esp_ipc_func_t func, void* arg, bool in_isr)
+{
+    esp_err_t err = ESP_OK;
+    if (in_isr) {
+        portENTER_CRITICAL_ISR(&s_work_lock[preferred_cpu]);
+    } else {
+        portENTER_CRITICAL(&s_work_lock[preferred_cpu]);
+    }
+    if (s_work_count[preferred_cpu] < CONFIG_ESP_IPC_WORK_QUEUE_LEN) {
+        uint32_t tail = (s_work_head[preferred_cpu] + s_work_count[preferred_cpu]) % CONFIG_ESP_IPC_WORK_QUEUE_LEN;
+        s_work_ring[preferred_cpu][tail].func = func;
+        s_work_ring[preferred_cpu][tail].arg = arg;
+        s_work_count[preferred_cpu]++;
+    } else {
+        err = ESP_ERR_NO_MEM;
+    }
+    if (in_isr) {
+        portEXIT_CRITICAL_ISR(&s_work_lock[preferred_cpu]);
+    } else {
+        portEXIT_CRITICAL(&s_work_lock[preferred_cpu]);
+    }
+    return err;
+}
+
+esp_err_t esp_ipc_work_post(uint32_t preferred_cpu, esp_ipc_func_t func, void* arg)
+{
+    if (preferred_cpu >= portNUM_PROCESSORS || func == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_work_queue_started) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_err_t err = work_push(preferred_cpu, func, arg, false);
+    if (err != ESP_OK) {
+        return err;
+    }
+    // Wake the preferred worker; every worker checks all rings, so waking the
+    // others too lets an idle core steal the item if the preferred one is busy
+    for (int i = 0; i < portNUM_PROCESSORS; ++i) {
+        xSemaphoreGive(s_work_sem[i]);
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_ipc_work_post_from_isr(uint32_t preferred_cpu, esp_ipc_func_t func, void* arg, bool *higher_priority_task_woken)
+{
+    if (preferred_cpu >= portNUM_PROCESSORS || func == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_work_queue_started) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_err_t err = work_push(preferred_cpu, func, arg, true);
+    if (err != ESP_OK) {
+        return err;
+    }
+    BaseType_t task_woken = pdFALSE;
+    for (int i = 0; i < portNUM_PROCESSORS; ++i) {
+        BaseType_t woken = pdFALSE;
+        xSemaphoreGiveFromISR(s_work_sem[i], &woken);
+        task_woken |= woken;
+    }
+    if (higher_priority_task_woken) {
+        *higher_priority_task_woken = (task_woken == pdTRUE);
+    }
+    return ESP_OK;
+}
+
+#endif // CONFIG_ESP_IPC_WORK_QUEUE
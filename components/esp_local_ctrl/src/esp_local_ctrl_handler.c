@@ -20,6 +20,7 @@
 #include "esp_local_ctrl.h"
 #include "esp_local_ctrl_priv.h"
 #include "esp_local_ctrl.pb-c.h"
+#include "esp_pb_arena.h"
 
 #define SAFE_ALLOCATION(type, var)                  \
     type *var = (type *) malloc(sizeof(type));      \
@@ -102,37 +103,64 @@ static esp_err_t cmd_get_prop_vals_handler(LocalCtrlMessage *req,
     SAFE_ALLOCATION(RespGetPropertyValues, resp_payload);
     resp_get_property_values__init(resp_payload);
 
-    esp_local_ctrl_prop_val_t *vals = calloc(req->cmd_get_prop_vals->n_indices,
+    size_t n_indices = req->cmd_get_prop_vals->n_indices;
+    uint32_t *indices = req->cmd_get_prop_vals->indices;
+    uint32_t *all_indices = NULL;
+
+    /* An empty indices list requests the whole property set, so that a
+     * client can fetch all properties (names, types, flags and values) in
+     * a single round trip without first querying the property count */
+    if (n_indices == 0) {
+        size_t prop_count = 0;
+        esp_err_t cnt_ret = esp_local_ctrl_get_prop_count(&prop_count);
+        if (cnt_ret != ESP_OK || prop_count == 0) {
+            resp_payload->status = err_to_status(cnt_ret);
+            resp->payload_case = LOCAL_CTRL_MESSAGE__PAYLOAD_RESP_GET_PROP_VALS;
+            resp->resp_get_prop_vals = resp_payload;
+            return ESP_OK;
+        }
+        all_indices = calloc(prop_count, sizeof(uint32_t));
+        if (!all_indices) {
+            ESP_LOGE(TAG, "Failed to allocate memory for property indices");
+            free(resp_payload);
+            return ESP_ERR_NO_MEM;
+        }
+        for (size_t i = 0; i < prop_count; i++) {
+            all_indices[i] = i;
+        }
+        n_indices = prop_count;
+        indices = all_indices;
+    }
+
+    esp_local_ctrl_prop_val_t *vals = calloc(n_indices,
                                              sizeof(esp_local_ctrl_prop_val_t));
-    esp_local_ctrl_prop_t *descs = calloc(req->cmd_get_prop_vals->n_indices,
+    esp_local_ctrl_prop_t *descs = calloc(n_indices,
                                           sizeof(esp_local_ctrl_prop_t));
-    prop_val_free_fn_t *free_fns = calloc(req->cmd_get_prop_vals->n_indices,
+    prop_val_free_fn_t *free_fns = calloc(n_indices,
                                           sizeof(prop_val_free_fn_t));
-    resp_payload->props = calloc(req->cmd_get_prop_vals->n_indices,
-                                 sizeof(PropertyInfo *));
-    if (!vals || !descs || !free_fns || !resp_payload->props) {
+    /* All PropertyInfo entries are carved out of one block, pointed to by
+     * the pointer array that protobuf-c expects */
+    PropertyInfo *prop_block = calloc(n_indices, sizeof(PropertyInfo));
+    resp_payload->props = calloc(n_indices, sizeof(PropertyInfo *));
+    if (!vals || !descs || !free_fns || !prop_block || !resp_payload->props) {
         ESP_LOGE(TAG, "Failed to allocate memory for getting values");
         free(vals);
         free(descs);
         free(free_fns);
+        free(prop_block);
         free(resp_payload->props);
         free(resp_payload);
+        free(all_indices);
         return ESP_ERR_NO_MEM;
     }
 
-    esp_err_t ret = esp_local_ctrl_get_prop_values(req->cmd_get_prop_vals->n_indices,
-                                                   req->cmd_get_prop_vals->indices,
+    esp_err_t ret = esp_local_ctrl_get_prop_values(n_indices, indices,
                                                    descs, vals);
     resp_payload->status = err_to_status(ret);
     if (ret == ESP_OK) {
-        resp_payload->n_props = 0;
-        for (size_t i = 0; i < req->cmd_get_prop_vals->n_indices; i++) {
-            resp_payload->props[i] = malloc(sizeof(PropertyInfo));
-            if (!resp_payload->props[i]) {
-                resp_payload->status = STATUS__InternalError;
-                break;
-            }
-            resp_payload->n_props++;
+        resp_payload->n_props = n_indices;
+        for (size_t i = 0; i < n_indices; i++) {
+            resp_payload->props[i] = &prop_block[i];
             property_info__init(resp_payload->props[i]);
             resp_payload->props[i]->name  = descs[i].name;
             resp_payload->props[i]->type  = descs[i].type;
@@ -141,12 +169,15 @@ static esp_err_t cmd_get_prop_vals_handler(LocalCtrlMessage *req,
             resp_payload->props[i]->value.len  = vals[i].size;
             free_fns[i] = vals[i].free_fn;
         }
+    } else {
+        free(prop_block);
     }
     resp->payload_case = LOCAL_CTRL_MESSAGE__PAYLOAD_RESP_GET_PROP_VALS;
     resp->resp_get_prop_vals = resp_payload;
     (*ctx) = (void *)free_fns;
     free(vals);
     free(descs);
+    free(all_indices);
 
     /* Unless it's a fatal error, always return ESP_OK, otherwise
      * the underlying connection will be closed by protocomm */
@@ -217,7 +248,11 @@ static void esp_local_ctrl_command_cleanup(LocalCtrlMessage *resp, void **ctx)
                         if (free_fns && free_fns[i]) {
                             free_fns[i](resp->resp_get_prop_vals->props[i]->value.data);
                         }
-                        free(resp->resp_get_prop_vals->props[i]);
+                    }
+                    /* PropertyInfo entries are carved out of a single block,
+                     * whose start is the first entry */
+                    if (resp->resp_get_prop_vals->n_props) {
+                        free(resp->resp_get_prop_vals->props[0]);
                     }
                     free(free_fns);
                     free(resp->resp_get_prop_vals->props);
@@ -257,7 +292,14 @@ esp_err_t esp_local_ctrl_data_handler(uint32_t session_id, const uint8_t *inbuf,
                                       uint8_t **outbuf, ssize_t *outlen, void *priv_data)
 {
     void *temp_ctx = NULL;
-    LocalCtrlMessage *req = local_ctrl_message__unpack(NULL, inlen, inbuf);
+#if CONFIG_PB_ARENA_UNPACK_SIZE > 0
+    uint8_t arena_mem[CONFIG_PB_ARENA_UNPACK_SIZE];
+    esp_pb_arena_t arena_ctx;
+    esp_pb_arena_t *arena = (esp_pb_arena_init(&arena_ctx, arena_mem, sizeof(arena_mem)) == ESP_OK) ? &arena_ctx : NULL;
+#else
+    esp_pb_arena_t *arena = NULL;
+#endif
+    LocalCtrlMessage *req = (LocalCtrlMessage *) esp_pb_arena_unpack(arena, &local_ctrl_message__descriptor, inlen, inbuf);
     if (!req) {
         ESP_LOGE(TAG, "Unable to unpack payload data");
         return ESP_ERR_INVALID_ARG;
@@ -271,11 +313,11 @@ esp_err_t esp_local_ctrl_data_handler(uint32_t session_id, const uint8_t *inbuf,
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "command dispatcher failed");
         esp_local_ctrl_command_cleanup(&resp, &temp_ctx);
-        local_ctrl_message__free_unpacked(req, NULL);
+        esp_pb_arena_free_unpacked(arena, (ProtobufCMessage *) req);
         return ESP_FAIL;
     }
 
-    local_ctrl_message__free_unpacked(req, NULL);
+    esp_pb_arena_free_unpacked(arena, (ProtobufCMessage *) req);
 
     *outlen = local_ctrl_message__get_packed_size(&resp);
     if (*outlen <= 0) {
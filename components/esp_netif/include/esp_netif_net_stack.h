@@ -83,6 +83,23 @@ esp_err_t esp_netif_transmit(esp_netif_t *esp_netif, void* data, size_t len);
   */
 esp_err_t esp_netif_transmit_wrap(esp_netif_t *esp_netif, void *data, size_t len, void *netstack_buf);
 
+/**
+  * @brief  Outputs one frame scattered over multiple buffers to the media to be transmitted
+  *
+  * This function gets called from network stack to output a frame whose data is
+  * spread over several network stack buffers. The IO driver gathers the buffers
+  * into one frame, which saves the network stack a contiguous copy.
+  *
+  * @param[in]  esp_netif Handle to esp-netif instance
+  * @param[in]  buffers Array of buffers the frame is constructed from
+  * @param[in]  lengths Array of lengths of the buffers
+  * @param[in]  count Number of buffers in the arrays
+  *
+  * @return   ESP_OK on success, ESP_ERR_NOT_SUPPORTED when the IO driver has no
+  *           scatter-gather support, an error passed from the I/O driver otherwise
+  */
+esp_err_t esp_netif_transmit_multi(esp_netif_t *esp_netif, void **buffers, size_t *lengths, size_t count);
+
 /**
   * @brief  Free the rx buffer allocated by the media driver
   *
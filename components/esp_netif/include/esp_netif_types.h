@@ -188,6 +188,7 @@ struct esp_netif_driver_ifconfig {
     esp_netif_iodriver_handle handle;
     esp_err_t (*transmit)(void *h, void *buffer, size_t len);
     esp_err_t (*transmit_wrap)(void *h, void *buffer, size_t len, void *netstack_buffer);
+    esp_err_t (*transmit_multi)(void *h, void **buffers, size_t *lengths, size_t count);
     void (*driver_free_rx_buffer)(void *h, void* buffer);
 };
 
@@ -37,6 +37,11 @@
 #include "tcp_isn.h"
 #endif
 
+#if CONFIG_LWIP_DHCP_OPTIMISTIC_RESTORE
+#include "lwip/etharp.h"
+#include "netif/dhcp_state.h"
+#endif
+
 #include "esp_netif_lwip_ppp.h"
 #include "esp_netif_lwip_slip.h"
 #include "dhcpserver/dhcpserver.h"
@@ -407,6 +412,9 @@ static esp_err_t esp_netif_init_configuration(esp_netif_t *esp_netif, const esp_
         if (esp_netif_driver_config->transmit_wrap) {
             esp_netif->driver_transmit_wrap = esp_netif_driver_config->transmit_wrap;
         }
+        if (esp_netif_driver_config->transmit_multi) {
+            esp_netif->driver_transmit_multi = esp_netif_driver_config->transmit_multi;
+        }
         if (esp_netif_driver_config->driver_free_rx_buffer) {
             esp_netif->driver_free_rx_buffer = esp_netif_driver_config->driver_free_rx_buffer;
         }
@@ -569,6 +577,7 @@ esp_err_t esp_netif_set_driver_config(esp_netif_t *esp_netif,
     esp_netif->driver_handle = driver_config->handle;
     esp_netif->driver_transmit = driver_config->transmit;
     esp_netif->driver_transmit_wrap = driver_config->transmit_wrap;
+    esp_netif->driver_transmit_multi = driver_config->transmit_multi;
     esp_netif->driver_free_rx_buffer = driver_config->driver_free_rx_buffer;
     return ESP_OK;
 }
@@ -814,6 +823,14 @@ esp_err_t esp_netif_transmit_wrap(esp_netif_t *esp_netif, void *data, size_t len
     return (esp_netif->driver_transmit_wrap)(esp_netif->driver_handle, data, len, pbuf);
 }
 
+esp_err_t esp_netif_transmit_multi(esp_netif_t *esp_netif, void **buffers, size_t *lengths, size_t count)
+{
+    if (esp_netif->driver_transmit_multi == NULL) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    return (esp_netif->driver_transmit_multi)(esp_netif->driver_handle, buffers, lengths, count);
+}
+
 esp_err_t esp_netif_receive(esp_netif_t *esp_netif, void *buffer, size_t len, void *eb)
 {
     esp_netif->lwip_input_fn(esp_netif->netif_handle, buffer, len, eb);
@@ -978,6 +995,40 @@ static esp_err_t esp_netif_dhcpc_stop_api(esp_netif_api_msg_t *msg)
 
 esp_err_t esp_netif_dhcpc_stop(esp_netif_t *esp_netif) _RUN_IN_LWIP_TASK_IF_SUPPORTED(esp_netif_dhcpc_stop_api, esp_netif, NULL)
 
+#if CONFIG_LWIP_DHCP_OPTIMISTIC_RESTORE
+/**
+ * @brief Optimistically configures the interface from the cached DHCP lease
+ *
+ * Applies the last lease before the DHCP client has re-validated it, announces
+ * it with a gratuitous ARP and probes the gateway so its ARP entry is warm by
+ * the time the first packet is routed. The DHCP client started right after
+ * re-requests the same address; if the server disagrees, the interface is
+ * reconfigured through the regular bind path.
+ */
+static void esp_netif_dhcpc_fast_commit(esp_netif_t *esp_netif, struct netif *p_netif)
+{
+    uint32_t ip = 0;
+    uint32_t netmask = 0;
+    uint32_t gw = 0;
+
+    if (!dhcp_lease_restore(esp_netif, &ip, &netmask, &gw)) {
+        return;
+    }
+
+    ip4_addr_t ip4 = { .addr = ip };
+    ip4_addr_t netmask4 = { .addr = netmask };
+    ip4_addr_t gw4 = { .addr = gw };
+
+    ESP_LOGD(TAG, "if%p fast commit of cached lease " IPSTR, esp_netif, IP2STR((esp_ip4_addr_t *)&ip4));
+    netif_set_addr(p_netif, &ip4, &netmask4, &gw4);
+    etharp_gratuitous(p_netif);
+    if (!ip4_addr_isany_val(gw4)) {
+        // warm up the gateway ARP entry; the reply doubles as a reachability probe
+        etharp_request(p_netif, &gw4);
+    }
+}
+#endif // CONFIG_LWIP_DHCP_OPTIMISTIC_RESTORE
+
 static esp_err_t esp_netif_dhcpc_start_api(esp_netif_api_msg_t *msg)
 {
     esp_netif_t *esp_netif = msg->esp_netif;
@@ -1007,6 +1058,9 @@ static esp_err_t esp_netif_dhcpc_start_api(esp_netif_api_msg_t *msg)
             ip_addr_set_zero(&p_netif->netmask);
             ip_addr_set_zero(&p_netif->gw);
             esp_netif_start_ip_lost_timer(esp_netif);
+#if CONFIG_LWIP_DHCP_OPTIMISTIC_RESTORE
+            esp_netif_dhcpc_fast_commit(esp_netif, p_netif);
+#endif
         } else {
             ESP_LOGD(TAG, "dhcp client re init");
             esp_netif->dhcpc_status = ESP_NETIF_DHCP_INIT;
@@ -110,6 +110,7 @@ struct esp_netif_obj {
     void* driver_handle;
     esp_err_t (*driver_transmit)(void *h, void *buffer, size_t len);
     esp_err_t (*driver_transmit_wrap)(void *h, void *buffer, size_t len, void *pbuf);
+    esp_err_t (*driver_transmit_multi)(void *h, void **buffers, size_t *lengths, size_t count);
     void (*driver_free_rx_buffer)(void *h, void* buffer);
 
     // dhcp related
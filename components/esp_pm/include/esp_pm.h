@@ -158,6 +158,118 @@ esp_err_t esp_pm_lock_release(esp_pm_lock_handle_t handle);
  */
 esp_err_t esp_pm_lock_delete(esp_pm_lock_handle_t handle);
 
+/**
+ * @brief Quality-of-service requirements of a QoS contract
+ *
+ * Fields set to 0 mean "no requirement". The power management algorithm maps
+ * the requirements onto the lowest power mode which satisfies them, based on
+ * the frequencies configured via esp_pm_configure. The mapping is re-evaluated
+ * whenever the configuration changes.
+ */
+typedef struct {
+    /**
+     * Maximum time, in microseconds, the client can tolerate between an event
+     * (e.g. an interrupt) and the CPU reacting to it. Requirements below the
+     * light sleep wakeup time prevent automatic light sleep while the
+     * contract is applied.
+     */
+    uint32_t max_wake_latency_us;
+    /**
+     * Minimum effective CPU performance the client needs while the contract
+     * is applied, in MIPS (approximately, CPU frequency in MHz). The CPU
+     * frequency is kept at or above this value.
+     */
+    uint32_t min_mips;
+} esp_pm_qos_config_t;
+
+/**
+ * @brief Opaque handle to a power management QoS contract
+ */
+typedef struct esp_pm_qos_contract* esp_pm_qos_handle_t;
+
+/**
+ * @brief Create a QoS contract for the given requirements
+ *
+ * When the contract is created, initially it is not applied.
+ * Call esp_pm_qos_contract_apply to activate the requirements.
+ *
+ * Unlike esp_pm_lock_create, the caller does not choose a lock type; the
+ * power management algorithm selects the lowest power mode which satisfies
+ * the declared requirements for the current esp_pm_configure settings.
+ *
+ * This function must not be called from an ISR.
+ *
+ * @param config requirements of the contract, see esp_pm_qos_config_t
+ * @param name arbitrary string identifying the contract, used by
+ *             esp_pm_dump_locks to list existing contracts. May be set to
+ *             NULL. If not set to NULL, must point to a string which is valid
+ *             for the lifetime of the contract.
+ * @param[out] out_handle handle returned from this function. Use this handle
+ *                        when calling esp_pm_qos_contract_apply,
+ *                        esp_pm_qos_contract_release, esp_pm_qos_contract_delete.
+ *                        Must not be NULL.
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NO_MEM if the contract structure can not be allocated
+ *      - ESP_ERR_INVALID_ARG if config or out_handle is NULL
+ *      - ESP_ERR_NOT_SUPPORTED if CONFIG_PM_ENABLE is not enabled in sdkconfig
+ */
+esp_err_t esp_pm_qos_contract_create(const esp_pm_qos_config_t* config,
+        const char* name, esp_pm_qos_handle_t* out_handle);
+
+/**
+ * @brief Apply a QoS contract
+ *
+ * Once the contract is applied, the power management algorithm will keep the
+ * system in a mode which satisfies the contract's requirements.
+ *
+ * Contracts are recursive: if esp_pm_qos_contract_apply is called a number of
+ * times, esp_pm_qos_contract_release has to be called the same number of
+ * times in order to deactivate the contract.
+ *
+ * This function may be called from an ISR.
+ *
+ * @param handle handle obtained from esp_pm_qos_contract_create
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if the handle is invalid
+ *      - ESP_ERR_NOT_SUPPORTED if CONFIG_PM_ENABLE is not enabled in sdkconfig
+ */
+esp_err_t esp_pm_qos_contract_apply(esp_pm_qos_handle_t handle);
+
+/**
+ * @brief Release a QoS contract applied using esp_pm_qos_contract_apply
+ *
+ * Call to this function removes the power management requirements placed when
+ * applying the contract.
+ *
+ * This function may be called from an ISR.
+ *
+ * @param handle handle obtained from esp_pm_qos_contract_create
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if the handle is invalid
+ *      - ESP_ERR_INVALID_STATE if the contract is not applied
+ *      - ESP_ERR_NOT_SUPPORTED if CONFIG_PM_ENABLE is not enabled in sdkconfig
+ */
+esp_err_t esp_pm_qos_contract_release(esp_pm_qos_handle_t handle);
+
+/**
+ * @brief Delete a QoS contract created using esp_pm_qos_contract_create
+ *
+ * The contract must be released before calling this function.
+ *
+ * This function must not be called from an ISR.
+ *
+ * @param handle handle obtained from esp_pm_qos_contract_create
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if the handle argument is NULL
+ *      - ESP_ERR_INVALID_STATE if the contract is still applied
+ *      - ESP_ERR_NOT_SUPPORTED if CONFIG_PM_ENABLE is not enabled in sdkconfig
+ */
+esp_err_t esp_pm_qos_contract_delete(esp_pm_qos_handle_t handle);
+
 /**
  * Dump the list of all locks to stderr
  *
@@ -49,6 +49,36 @@ typedef enum {
  */
 pm_mode_t esp_pm_impl_get_mode(esp_pm_lock_type_t type, int arg);
 
+/**
+ * @brief Get the mode satisfying a set of QoS requirements
+ *
+ * The mapping depends on the frequencies configured via esp_pm_configure and
+ * must be re-evaluated (see esp_pm_qos_update_modes) when they change.
+ *
+ * @param max_wake_latency_us maximum tolerable wake latency, 0 if unconstrained
+ * @param min_mips minimum effective CPU performance, 0 if unconstrained
+ * @return lowest power consumption mode which meets the requirements
+ */
+pm_mode_t esp_pm_impl_get_mode_for_qos(uint32_t max_wake_latency_us, uint32_t min_mips);
+
+/**
+ * @brief Re-evaluate which mode backs each QoS contract (pm_qos.c)
+ *
+ * Called by esp_pm_configure after the mode frequency table has changed.
+ * Contracts which are currently applied atomically migrate to their new mode.
+ */
+void esp_pm_qos_update_modes(void);
+
+/**
+ * @brief Dump the list of QoS contracts (pm_qos.c)
+ *
+ * Called by esp_pm_dump_locks, prints one line per contract: name, wake
+ * latency and MIPS requirements, backing mode, apply count.
+ *
+ * @param out stream to dump the information to
+ */
+void esp_pm_qos_dump(FILE* out);
+
 /**
  * If profiling is enabled, this data type will be used to store microsecond
  * timestamps.
@@ -112,6 +142,37 @@ void esp_pm_impl_dump_stats(FILE* out);
  */
 void esp_pm_impl_waiti(void);
 
+/**
+ * @brief Callback function type for DFS transition notifications
+ *
+ * Called after each frequency switch, on the CPU which performed it, with
+ * the mode left, the mode entered, and the time the switch took. May run in
+ * interrupt context, so the callback must be IRAM-safe and must only use
+ * ISR-safe APIs (esp_apptrace_write satisfies both, which allows streaming
+ * the transitions out over app_trace).
+ */
+typedef void (*esp_pm_switch_cb_t)(pm_mode_t old_mode, pm_mode_t new_mode, int64_t duration_us);
+
+/**
+ * @brief Register a callback to be invoked after each DFS transition
+ *
+ * @param cb function to call after each frequency switch
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NO_MEM if no more callback slots are available
+ */
+esp_err_t esp_pm_register_switch_callback(esp_pm_switch_cb_t cb);
+
+/**
+ * @brief Unregister a callback previously registered with esp_pm_register_switch_callback
+ *
+ * @param cb callback to unregister
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_STATE if the given callback hasn't been registered before
+ */
+esp_err_t esp_pm_unregister_switch_callback(esp_pm_switch_cb_t cb);
+
 #if CONFIG_IDF_TARGET_ESP32S2
 /**
  * @brief Callback function type for peripherals to skip light sleep.
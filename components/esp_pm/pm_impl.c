@@ -71,6 +71,12 @@
  */
 #define LIGHT_SLEEP_EARLY_WAKEUP_US 100
 
+/* Approximate time to restore clocks and resume execution after wakeup from
+ * light sleep, in microseconds. Used to decide whether a QoS wake latency
+ * requirement is compatible with automatic light sleep.
+ */
+#define LIGHT_SLEEP_WAKEUP_LATENCY_US 1000
+
 #if CONFIG_IDF_TARGET_ESP32
 /* Minimal divider at which REF_CLK_FREQ can be obtained */
 #define REF_CLK_DIV_MIN 10
@@ -163,11 +169,27 @@ static bool s_light_sleep_en = false;
  */
 static bool s_config_changed = false;
 
+/* Callbacks to be invoked after each DFS transition, see
+ * esp_pm_register_switch_callback.
+ */
+#define PM_SWITCH_CB_NO 2
+static esp_pm_switch_cb_t s_switch_callbacks[PM_SWITCH_CB_NO];
+
 #ifdef WITH_PROFILING
 /* Time, in microseconds, spent so far in each mode */
 static pm_time_t s_time_in_mode[PM_MODE_COUNT];
 /* Timestamp, in microseconds, when the mode switch last happened */
 static pm_time_t s_last_mode_change_time;
+/* Number of DFS transitions between each pair of modes */
+static uint32_t s_switch_counts[PM_MODE_COUNT][PM_MODE_COUNT];
+/* Log2 histogram of DFS transition durations. Bucket 0 counts transitions
+ * shorter than 2 us, bucket i transitions of [2^i, 2^(i+1)) us; the last
+ * bucket also counts everything longer.
+ */
+#define PM_SWITCH_DURATION_BUCKETS 16
+static uint32_t s_switch_duration_hist[PM_SWITCH_DURATION_BUCKETS];
+/* Longest DFS transition observed so far, in microseconds */
+static pm_time_t s_switch_duration_max;
 /* User-readable mode names, used by esp_pm_impl_dump_stats */
 static const char* s_mode_names[] = {
         "SLEEP",
@@ -199,6 +221,25 @@ pm_mode_t esp_pm_impl_get_mode(esp_pm_lock_type_t type, int arg)
     }
 }
 
+pm_mode_t esp_pm_impl_get_mode_for_qos(uint32_t max_wake_latency_us, uint32_t min_mips)
+{
+    portENTER_CRITICAL(&s_switch_lock);
+    uint32_t apb_max_freq_mhz = s_cpu_freq_by_mode[PM_MODE_APB_MAX].freq_mhz;
+    uint32_t apb_min_freq_mhz = s_cpu_freq_by_mode[PM_MODE_APB_MIN].freq_mhz;
+    portEXIT_CRITICAL(&s_switch_lock);
+
+    if (min_mips > apb_max_freq_mhz) {
+        return PM_MODE_CPU_MAX;
+    }
+    if (min_mips > apb_min_freq_mhz) {
+        return PM_MODE_APB_MAX;
+    }
+    if (max_wake_latency_us != 0 && max_wake_latency_us < LIGHT_SLEEP_WAKEUP_LATENCY_US) {
+        return PM_MODE_APB_MIN;
+    }
+    return PM_MODE_LIGHT_SLEEP;
+}
+
 esp_err_t esp_pm_configure(const void* vconfig)
 {
 #ifndef CONFIG_PM_ENABLE
@@ -283,6 +324,11 @@ esp_err_t esp_pm_configure(const void* vconfig)
     s_config_changed = true;
     portEXIT_CRITICAL(&s_switch_lock);
 
+    /* The mode frequencies changed, so the mode backing each QoS contract
+     * may have changed as well.
+     */
+    esp_pm_qos_update_modes();
+
     return ESP_OK;
 }
 
@@ -428,11 +474,30 @@ static void IRAM_ATTR do_switch(pm_mode_t new_mode)
         rtc_clk_cpu_freq_get_config(&old_config);
     }
 
+    /* Measure the transition duration if profiling is on or a switch
+     * callback wants to see it.
+     */
+    bool instrument = false;
+#ifdef WITH_PROFILING
+    instrument = true;
+#else
+    for (int i = 0; i < PM_SWITCH_CB_NO; ++i) {
+        if (s_switch_callbacks[i] != NULL) {
+            instrument = true;
+            break;
+        }
+    }
+#endif // WITH_PROFILING
+
+    pm_mode_t old_mode = s_mode;
+    int64_t switch_duration = -1;
+
     if (new_config.freq_mhz != old_config.freq_mhz) {
         uint32_t old_ticks_per_us = old_config.freq_mhz;
         uint32_t new_ticks_per_us = new_config.freq_mhz;
 
         bool switch_down = new_ticks_per_us < old_ticks_per_us;
+        int64_t switch_start = instrument ? esp_timer_get_time() : 0;
 
         ESP_PM_TRACE_ENTER(FREQ_SWITCH, core_id);
         if (switch_down) {
@@ -443,12 +508,40 @@ static void IRAM_ATTR do_switch(pm_mode_t new_mode)
             on_freq_update(old_ticks_per_us, new_ticks_per_us);
         }
         ESP_PM_TRACE_EXIT(FREQ_SWITCH, core_id);
+
+        if (instrument) {
+            switch_duration = esp_timer_get_time() - switch_start;
+        }
     }
 
     portENTER_CRITICAL_ISR(&s_switch_lock);
+#ifdef WITH_PROFILING
+    if (switch_duration >= 0) {
+        s_switch_counts[old_mode][new_mode]++;
+        int bucket = 0;
+        int64_t duration = switch_duration;
+        while (duration > 1 && bucket < PM_SWITCH_DURATION_BUCKETS - 1) {
+            duration >>= 1;
+            ++bucket;
+        }
+        s_switch_duration_hist[bucket]++;
+        if (switch_duration > s_switch_duration_max) {
+            s_switch_duration_max = switch_duration;
+        }
+    }
+#endif // WITH_PROFILING
     s_mode = new_mode;
     s_is_switching = false;
     portEXIT_CRITICAL_ISR(&s_switch_lock);
+
+    if (switch_duration >= 0) {
+        for (int i = 0; i < PM_SWITCH_CB_NO; ++i) {
+            esp_pm_switch_cb_t cb = s_switch_callbacks[i];
+            if (cb != NULL) {
+                (*cb)(old_mode, new_mode, switch_duration);
+            }
+        }
+    }
 }
 
 /**
@@ -648,6 +741,30 @@ void IRAM_ATTR vApplicationSleep( TickType_t xExpectedIdleTime )
 }
 #endif //CONFIG_FREERTOS_USE_TICKLESS_IDLE
 
+esp_err_t esp_pm_register_switch_callback(esp_pm_switch_cb_t cb)
+{
+    for (int i = 0; i < PM_SWITCH_CB_NO; i++) {
+        if (s_switch_callbacks[i] == cb) {
+            return ESP_OK;
+        } else if (s_switch_callbacks[i] == NULL) {
+            s_switch_callbacks[i] = cb;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NO_MEM;
+}
+
+esp_err_t esp_pm_unregister_switch_callback(esp_pm_switch_cb_t cb)
+{
+    for (int i = 0; i < PM_SWITCH_CB_NO; i++) {
+        if (s_switch_callbacks[i] == cb) {
+            s_switch_callbacks[i] = NULL;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_INVALID_STATE;
+}
+
 #ifdef WITH_PROFILING
 void esp_pm_impl_dump_stats(FILE* out)
 {
@@ -674,6 +791,26 @@ void esp_pm_impl_dump_stats(FILE* out)
                 time_in_mode[i],
                 (int) (time_in_mode[i] * 100 / now));
     }
+
+    fprintf(out, "DFS transition stats:\n");
+    for (int from = 0; from < PM_MODE_COUNT; ++from) {
+        for (int to = 0; to < PM_MODE_COUNT; ++to) {
+            if (s_switch_counts[from][to] > 0) {
+                fprintf(out, "%8s -> %-8s %9u\n",
+                        s_mode_names[from], s_mode_names[to],
+                        s_switch_counts[from][to]);
+            }
+        }
+    }
+    fprintf(out, "DFS transition duration histogram (us):\n");
+    for (int i = 0; i < PM_SWITCH_DURATION_BUCKETS; ++i) {
+        if (s_switch_duration_hist[i] > 0) {
+            fprintf(out, "%8d-%-8d %9u\n",
+                    (i == 0) ? 0 : (1 << i), (1 << (i + 1)) - 1,
+                    s_switch_duration_hist[i]);
+        }
+    }
+    fprintf(out, "Longest DFS transition: %lld us\n", s_switch_duration_max);
 }
 #endif // WITH_PROFILING
 
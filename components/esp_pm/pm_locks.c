@@ -204,6 +204,7 @@ esp_err_t esp_pm_dump_locks(FILE* stream)
         fputs(line, stream);
     }
     _lock_release(&s_list_lock);
+    esp_pm_qos_dump(stream);
 #ifdef WITH_PROFILING
     esp_pm_impl_dump_stats(stream);
 #endif
@@ -0,0 +1,217 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/* QoS contracts are a requirement-based front end to the PM lock machinery.
+ * Instead of naming a lock type (and with it a fixed mode), the client states
+ * what it needs: a maximum tolerable wake latency and a minimum effective
+ * CPU performance. The mapping of those requirements onto a power mode is
+ * done by the implementation (esp_pm_impl_get_mode_for_qos) based on the
+ * frequencies configured via esp_pm_configure, and is re-evaluated whenever
+ * the configuration changes, so clients do not need to know which lock type
+ * their requirement translates to for a particular configuration.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/lock.h>
+#include "esp_pm.h"
+#include "sys/queue.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_private/pm_impl.h"
+#include "sdkconfig.h"
+
+
+typedef struct esp_pm_qos_contract {
+    uint32_t max_wake_latency_us;           /*!< latency requirement passed to esp_pm_qos_contract_create */
+    uint32_t min_mips;                      /*!< performance requirement passed to esp_pm_qos_contract_create */
+    pm_mode_t mode;                         /*!< mode currently backing the requirements */
+    const char* name;                       /*!< used to identify the contract */
+    SLIST_ENTRY(esp_pm_qos_contract) next;  /*!< linked list pointer */
+    size_t count;                           /*!< number of times the contract was applied */
+    portMUX_TYPE spinlock;                  /*!< spinlock used when operating on 'count' and 'mode' */
+} esp_pm_qos_contract_t;
+
+/* List of all existing contracts, used for re-mapping and esp_pm_qos_dump */
+static SLIST_HEAD(esp_pm_qos_head, esp_pm_qos_contract) s_contract_list =
+        SLIST_HEAD_INITIALIZER(s_contract_list);
+/* Protects the above list */
+static _lock_t s_contract_list_lock;
+
+#ifdef WITH_PROFILING
+/* Contract modes, as shown by esp_pm_qos_dump. Same order as pm_mode_t. */
+static const char* s_qos_mode_names[] = {
+        "SLEEP",
+        "APB_MIN",
+        "APB_MAX",
+        "CPU_MAX"
+};
+#endif
+
+esp_err_t esp_pm_qos_contract_create(const esp_pm_qos_config_t* config,
+        const char* name, esp_pm_qos_handle_t* out_handle)
+{
+#ifndef CONFIG_PM_ENABLE
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+
+    if (config == NULL || out_handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_pm_qos_contract_t* contract = (esp_pm_qos_contract_t*) calloc(1, sizeof(*contract));
+    if (!contract) {
+        return ESP_ERR_NO_MEM;
+    }
+    contract->max_wake_latency_us = config->max_wake_latency_us;
+    contract->min_mips = config->min_mips;
+    contract->mode = esp_pm_impl_get_mode_for_qos(config->max_wake_latency_us, config->min_mips);
+    contract->name = name;
+    contract->spinlock = (portMUX_TYPE) portMUX_INITIALIZER_UNLOCKED;
+    *out_handle = contract;
+
+    _lock_acquire(&s_contract_list_lock);
+    SLIST_INSERT_HEAD(&s_contract_list, contract, next);
+    _lock_release(&s_contract_list_lock);
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_qos_contract_delete(esp_pm_qos_handle_t handle)
+{
+#ifndef CONFIG_PM_ENABLE
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+
+    if (handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (handle->count > 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    _lock_acquire(&s_contract_list_lock);
+    SLIST_REMOVE(&s_contract_list, handle, esp_pm_qos_contract, next);
+    _lock_release(&s_contract_list_lock);
+    free(handle);
+    return ESP_OK;
+}
+
+esp_err_t IRAM_ATTR esp_pm_qos_contract_apply(esp_pm_qos_handle_t handle)
+{
+#ifndef CONFIG_PM_ENABLE
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+
+    if (handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL_SAFE(&handle->spinlock);
+    if (handle->count++ == 0) {
+        pm_time_t now = 0;
+#ifdef WITH_PROFILING
+        now = pm_get_time();
+#endif
+        esp_pm_impl_switch_mode(handle->mode, MODE_LOCK, now);
+    }
+    portEXIT_CRITICAL_SAFE(&handle->spinlock);
+    return ESP_OK;
+}
+
+esp_err_t IRAM_ATTR esp_pm_qos_contract_release(esp_pm_qos_handle_t handle)
+{
+#ifndef CONFIG_PM_ENABLE
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+
+    if (handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t ret = ESP_OK;
+    portENTER_CRITICAL_SAFE(&handle->spinlock);
+    if (handle->count == 0) {
+        ret = ESP_ERR_INVALID_STATE;
+        goto out;
+    }
+    if (--handle->count == 0) {
+        pm_time_t now = 0;
+#ifdef WITH_PROFILING
+        now = pm_get_time();
+#endif
+        esp_pm_impl_switch_mode(handle->mode, MODE_UNLOCK, now);
+    }
+out:
+    portEXIT_CRITICAL_SAFE(&handle->spinlock);
+    return ret;
+}
+
+void esp_pm_qos_update_modes(void)
+{
+    _lock_acquire(&s_contract_list_lock);
+    esp_pm_qos_contract_t* it;
+    SLIST_FOREACH(it, &s_contract_list, next) {
+        pm_mode_t new_mode = esp_pm_impl_get_mode_for_qos(it->max_wake_latency_us, it->min_mips);
+        portENTER_CRITICAL(&it->spinlock);
+        if (new_mode != it->mode) {
+            if (it->count > 0) {
+                pm_time_t now = 0;
+#ifdef WITH_PROFILING
+                now = pm_get_time();
+#endif
+                /* Lock the new mode before releasing the old one, so that the
+                 * requirements stay satisfied during the transition.
+                 */
+                esp_pm_impl_switch_mode(new_mode, MODE_LOCK, now);
+                esp_pm_impl_switch_mode(it->mode, MODE_UNLOCK, now);
+            }
+            it->mode = new_mode;
+        }
+        portEXIT_CRITICAL(&it->spinlock);
+    }
+    _lock_release(&s_contract_list_lock);
+}
+
+void esp_pm_qos_dump(FILE* out)
+{
+    _lock_acquire(&s_contract_list_lock);
+    if (!SLIST_EMPTY(&s_contract_list)) {
+        fprintf(out, "QoS contract stats:\n");
+        esp_pm_qos_contract_t* it;
+        char line[80];
+        SLIST_FOREACH(it, &s_contract_list, next) {
+            char *buf = line;
+            size_t len = sizeof(line);
+            size_t cb;
+
+            portENTER_CRITICAL(&it->spinlock);
+            if (it->name == NULL) {
+                cb = snprintf(buf, len, "contract@%p ", it);
+            } else {
+                cb = snprintf(buf, len, "%-15.15s ", it->name);
+            }
+            assert(cb <= len); // above formats should fit into sizeof(line)
+            buf += cb;
+            len -= cb;
+#ifdef WITH_PROFILING
+            snprintf(buf, len, "%10u  %4u  %8s  %3d\n",
+                    it->max_wake_latency_us, it->min_mips,
+                    s_qos_mode_names[it->mode], it->count);
+#else
+            snprintf(buf, len, "%10u  %4u  %3d\n",
+                    it->max_wake_latency_us, it->min_mips, it->count);
+#endif // WITH_PROFILING
+            portEXIT_CRITICAL(&it->spinlock);
+            fputs(line, out);
+        }
+    }
+    _lock_release(&s_contract_list_lock);
+}
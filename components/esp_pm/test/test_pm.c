@@ -75,6 +75,33 @@ TEST_CASE("Can switch frequency using esp_pm_configure", "[pm]")
     switch_freq(orig_freq_mhz);
 }
 
+TEST_CASE("Can create and apply a QoS contract", "[pm]")
+{
+    int orig_freq_mhz = esp_clk_cpu_freq() / MHZ;
+    switch_freq(240);
+
+    esp_pm_qos_config_t qos_config = {
+        .max_wake_latency_us = 100,
+        .min_mips = 240,
+    };
+    esp_pm_qos_handle_t contract;
+    TEST_ESP_OK(esp_pm_qos_contract_create(&qos_config, "test_qos", &contract));
+    TEST_ESP_OK(esp_pm_qos_contract_apply(contract));
+
+    /* Contract must show up in the dump and keep the CPU at full speed */
+    esp_pm_dump_locks(stdout);
+    TEST_ASSERT_EQUAL_INT(240, esp_clk_cpu_freq() / MHZ);
+
+    /* Deleting an applied contract is rejected */
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_pm_qos_contract_delete(contract));
+
+    TEST_ESP_OK(esp_pm_qos_contract_release(contract));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_pm_qos_contract_release(contract));
+    TEST_ESP_OK(esp_pm_qos_contract_delete(contract));
+
+    switch_freq(orig_freq_mhz);
+}
+
 #if CONFIG_FREERTOS_USE_TICKLESS_IDLE
 
 static void light_sleep_enable(void)
@@ -56,6 +56,22 @@ typedef enum {
     RINGBUF_TYPE_MAX,
 } RingbufferType_t;
 
+#if CONFIG_RINGBUF_STATS
+/**
+ * @brief Operation counters of a ring buffer, see vRingbufferGetStats()
+ *
+ * @note The CONFIG_RINGBUF_STATS option must be enabled for this structure
+ *       to be available.
+ */
+typedef struct xRINGBUFFER_STATS {
+    UBaseType_t uxTotalSends;       //!< Number of items/data successfully sent or acquired
+    UBaseType_t uxSendNoSpace;      //!< Number of send attempts that found insufficient free space and had to block, retry or fail
+    UBaseType_t uxTotalReceives;    //!< Number of items/data successfully retrieved
+    UBaseType_t uxReceiveNoItems;   //!< Number of receiver wake ups that found no item/data available
+    UBaseType_t uxTwoPhaseSends;    //!< Number of sends whose copy ran outside the critical section (see CONFIG_RINGBUF_TWO_PHASE_SEND)
+} RingbufferStats_t;
+#endif
+
 /**
  * @brief Struct that is equivalent in size to the ring buffer's data structure
  *
@@ -75,6 +91,9 @@ typedef struct xSTATIC_RINGBUFFER {
     BaseType_t xDummy3;
     void *pvDummy4[11];
     StaticSemaphore_t xDummy5[2];
+#if CONFIG_RINGBUF_STATS
+    UBaseType_t uxStatsDummy[5];
+#endif
     portMUX_TYPE muxDummy;
     /** @endcond */
 } StaticRingbuffer_t;
@@ -369,6 +388,68 @@ void *xRingbufferReceiveUpTo(RingbufHandle_t xRingbuffer,
  */
 void *xRingbufferReceiveUpToFromISR(RingbufHandle_t xRingbuffer, size_t *pxItemSize, size_t xMaxSize);
 
+/**
+ * @brief   Retrieve buffered bytes from a byte buffer as contiguous regions for splicing
+ *
+ * Attempt to retrieve all (or up to xMaxSize) buffered data from a byte buffer
+ * without copying it. Because the data may wrap around the end of the storage
+ * area, it is returned as up to two contiguous regions; a consumer (e.g. a
+ * driver feeding a DMA engine or a socket) can transmit directly out of both
+ * regions, in head-then-tail order, instead of copying the data out first.
+ *
+ * @note    Call vRingbufferReturnItem() exactly once with ppvHeadItem after
+ *          both regions have been consumed. The regions remain owned by the
+ *          caller until then and will not be overwritten by senders.
+ *
+ * @param[in]   xRingbuffer     Ring buffer to retrieve the data from
+ * @param[out]  ppvHeadItem     Pointer to store the first contiguous region
+ * @param[out]  ppvTailItem     Pointer to store the wrapped region, set to
+ *                              NULL if the data did not wrap around
+ * @param[out]  pxHeadItemSize  Pointer to store the size of the first region
+ * @param[out]  pxTailItemSize  Pointer to store the size of the wrapped region
+ * @param[in]   xMaxSize        Maximum number of bytes to retrieve in total, 0 to retrieve all buffered data
+ * @param[in]   xTicksToWait    Ticks to wait for data to become available
+ *
+ * @note    This function should only be called on byte buffers
+ *
+ * @return
+ *      - pdTRUE if data was retrieved
+ *      - pdFALSE when no data was retrieved within the timeout, *ppvHeadItem and *ppvTailItem are set to NULL in that case
+ */
+BaseType_t xRingbufferReceiveSplice(RingbufHandle_t xRingbuffer,
+                                    void **ppvHeadItem,
+                                    void **ppvTailItem,
+                                    size_t *pxHeadItemSize,
+                                    size_t *pxTailItemSize,
+                                    size_t xMaxSize,
+                                    TickType_t xTicksToWait);
+
+/**
+ * @brief   Retrieve buffered bytes from a byte buffer as contiguous regions for splicing in an ISR
+ *
+ * ISR version of xRingbufferReceiveSplice().
+ *
+ * @param[in]   xRingbuffer     Ring buffer to retrieve the data from
+ * @param[out]  ppvHeadItem     Pointer to store the first contiguous region
+ * @param[out]  ppvTailItem     Pointer to store the wrapped region, set to
+ *                              NULL if the data did not wrap around
+ * @param[out]  pxHeadItemSize  Pointer to store the size of the first region
+ * @param[out]  pxTailItemSize  Pointer to store the size of the wrapped region
+ * @param[in]   xMaxSize        Maximum number of bytes to retrieve in total, 0 to retrieve all buffered data
+ *
+ * @note    This function should only be called on byte buffers
+ *
+ * @return
+ *      - pdTRUE if data was retrieved
+ *      - pdFALSE when the buffer was empty, *ppvHeadItem and *ppvTailItem are set to NULL in that case
+ */
+BaseType_t xRingbufferReceiveSpliceFromISR(RingbufHandle_t xRingbuffer,
+                                           void **ppvHeadItem,
+                                           void **ppvTailItem,
+                                           size_t *pxHeadItemSize,
+                                           size_t *pxTailItemSize,
+                                           size_t xMaxSize);
+
 /**
  * @brief   Return a previously-retrieved item to the ring buffer
  *
@@ -516,6 +597,24 @@ void vRingbufferGetInfo(RingbufHandle_t xRingbuffer,
  */
 void xRingbufferPrintInfo(RingbufHandle_t xRingbuffer);
 
+#if CONFIG_RINGBUF_STATS
+/**
+ * @brief   Get the operation counters of a ring buffer
+ *
+ * Copies a snapshot of the ring buffer's counters. The ratio of
+ * uxSendNoSpace/uxReceiveNoItems to uxTotalSends/uxTotalReceives shows how
+ * often senders and receivers contend for buffer space rather than for the
+ * internal lock.
+ *
+ * @note The CONFIG_RINGBUF_STATS option must be enabled for this function
+ *       to be available.
+ *
+ * @param[in]   xRingbuffer     Ring buffer to query
+ * @param[out]  pxStats         Struct to store the counters into
+ */
+void vRingbufferGetStats(RingbufHandle_t xRingbuffer, RingbufferStats_t *pxStats);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -45,6 +45,13 @@
 #define rbGET_RX_SEM_HANDLE( pxRingbuffer ) ( pxRingbuffer->xRecvSemHandle )
 #endif
 
+//Operation counters. Increments must be done while holding the ring buffer's spinlock
+#if CONFIG_RINGBUF_STATS
+#define rbSTATS_INC( pxRingbuffer, xField ) do { ( pxRingbuffer )->xStats.xField++; } while(0)
+#else
+#define rbSTATS_INC( pxRingbuffer, xField )
+#endif
+
 typedef struct {
     //This size of this structure must be 32-bit aligned
     size_t xItemLen;
@@ -101,6 +108,9 @@ typedef struct RingbufferDefinition {
 #else
     SemaphoreHandle_t xTransSemHandle;
     SemaphoreHandle_t xRecvSemHandle;
+#endif
+#if CONFIG_RINGBUF_STATS
+    RingbufferStats_t xStats;                   //Operation counters, see vRingbufferGetStats()
 #endif
     portMUX_TYPE mux;                           //Spinlock required for SMP
 } Ringbuffer_t;
@@ -164,6 +174,14 @@ static void *prvGetItemByteBuf(Ringbuffer_t *pxRingbuffer,
                                size_t xMaxSize,
                                size_t *pxItemSize);
 
+//Retrieve all (or up to xMaxSize) buffered data from a byte buffer as up to two contiguous regions
+static void prvGetSplicedByteBuf(Ringbuffer_t *pxRingbuffer,
+                                 void **ppvHead,
+                                 size_t *pxHeadSize,
+                                 void **ppvTail,
+                                 size_t *pxTailSize,
+                                 size_t xMaxSize);
+
 //Return an item to a split/no-split ring buffer
 static void prvReturnItemDefault(Ringbuffer_t *pxRingbuffer, uint8_t *pucItem);
 
@@ -589,6 +607,57 @@ static void *prvGetItemByteBuf(Ringbuffer_t *pxRingbuffer,
     return (void *)ret;
 }
 
+static void prvGetSplicedByteBuf(Ringbuffer_t *pxRingbuffer,
+                                 void **ppvHead,
+                                 size_t *pxHeadSize,
+                                 void **ppvTail,
+                                 size_t *pxTailSize,
+                                 size_t xMaxSize)
+{
+    //Check arguments and buffer state
+    configASSERT((pxRingbuffer->xItemsWaiting > 0) && ((pxRingbuffer->pucRead != pxRingbuffer->pucWrite) || (pxRingbuffer->uxRingbufferFlags & rbBUFFER_FULL_FLAG)));   //Check there are items to be read
+    configASSERT(pxRingbuffer->pucRead >= pxRingbuffer->pucHead && pxRingbuffer->pucRead < pxRingbuffer->pucTail);    //Check read pointer is within bounds
+    configASSERT(pxRingbuffer->pucRead == pxRingbuffer->pucFree);
+
+    uint8_t *pucHeadRegion = pxRingbuffer->pucRead;
+    size_t xHeadLen;
+    size_t xTailLen = 0;
+    if ((pxRingbuffer->pucRead > pxRingbuffer->pucWrite) || (pxRingbuffer->uxRingbufferFlags & rbBUFFER_FULL_FLAG)) {
+        //Buffered data wraps around the end of the storage area
+        xHeadLen = pxRingbuffer->pucTail - pxRingbuffer->pucRead;
+        xTailLen = pxRingbuffer->pucWrite - pxRingbuffer->pucHead;
+    } else {
+        //Buffered data is contiguous between read and write pointer
+        xHeadLen = pxRingbuffer->pucWrite - pxRingbuffer->pucRead;
+    }
+    //Limit the retrieved data to xMaxSize, filling the head region first
+    if (xMaxSize != 0) {
+        if (xHeadLen >= xMaxSize) {
+            xHeadLen = xMaxSize;
+            xTailLen = 0;
+        } else if (xHeadLen + xTailLen > xMaxSize) {
+            xTailLen = xMaxSize - xHeadLen;
+        }
+    }
+
+    //Consume the data
+    pxRingbuffer->xItemsWaiting -= xHeadLen + xTailLen;
+    if (xTailLen > 0) {
+        pxRingbuffer->pucRead = pxRingbuffer->pucHead + xTailLen;
+        *ppvTail = (void *)pxRingbuffer->pucHead;
+    } else {
+        pxRingbuffer->pucRead += xHeadLen;
+        //Wrap around read pointer if it reaches the end
+        if (pxRingbuffer->pucRead == pxRingbuffer->pucTail) {
+            pxRingbuffer->pucRead = pxRingbuffer->pucHead;
+        }
+        *ppvTail = NULL;
+    }
+    *ppvHead = (void *)pucHeadRegion;
+    *pxHeadSize = xHeadLen;
+    *pxTailSize = xTailLen;
+}
+
 static void prvReturnItemDefault(Ringbuffer_t *pxRingbuffer, uint8_t *pucItem)
 {
     //Check arguments and buffer state
@@ -774,6 +843,7 @@ static BaseType_t prvReceiveGeneric(Ringbuffer_t *pxRingbuffer,
                 }
             }
             xReturn = pdTRUE;
+            rbSTATS_INC(pxRingbuffer, uxTotalReceives);
             if (pxRingbuffer->xItemsWaiting > 0) {
                 xReturnSemaphore = pdTRUE;
             }
@@ -781,6 +851,7 @@ static BaseType_t prvReceiveGeneric(Ringbuffer_t *pxRingbuffer,
             break;
         }
         //No item available for retrieval, adjust ticks and take the semaphore again
+        rbSTATS_INC(pxRingbuffer, uxReceiveNoItems);
         if (xTicksToWait != portMAX_DELAY) {
             xTicksRemaining = xTicksEnd - xTaskGetTickCount();
         }
@@ -828,9 +899,12 @@ static BaseType_t prvReceiveGenericFromISR(Ringbuffer_t *pxRingbuffer,
             }
         }
         xReturn = pdTRUE;
+        rbSTATS_INC(pxRingbuffer, uxTotalReceives);
         if (pxRingbuffer->xItemsWaiting > 0) {
             xReturnSemaphore = pdTRUE;
         }
+    } else {
+        rbSTATS_INC(pxRingbuffer, uxReceiveNoItems);
     }
     portEXIT_CRITICAL_ISR(&pxRingbuffer->mux);
 
@@ -950,6 +1024,7 @@ BaseType_t xRingbufferSendAcquire(RingbufHandle_t xRingbuffer, void **ppvItem, s
             //Item will fit, copy item
             *ppvItem = prvAcquireItemNoSplit(pxRingbuffer, xItemSize);
             xReturn = pdTRUE;
+            rbSTATS_INC(pxRingbuffer, uxTotalSends);
             //Check if the free semaphore should be returned to allow other tasks to send
             if (prvGetFreeSize(pxRingbuffer) > 0) {
                 xReturnSemaphore = pdTRUE;
@@ -958,6 +1033,7 @@ BaseType_t xRingbufferSendAcquire(RingbufHandle_t xRingbuffer, void **ppvItem, s
             break;
         }
         //Item doesn't fit, adjust ticks and take the semaphore again
+        rbSTATS_INC(pxRingbuffer, uxSendNoSpace);
         if (xTicksToWait != portMAX_DELAY) {
             xTicksRemaining = xTicksEnd - xTaskGetTickCount();
         }
@@ -1020,9 +1096,31 @@ BaseType_t xRingbufferSend(RingbufHandle_t xRingbuffer,
         //Semaphore obtained, check if item can fit
         portENTER_CRITICAL(&pxRingbuffer->mux);
         if(pxRingbuffer->xCheckItemFits(pxRingbuffer, xItemSize) == pdTRUE) {
+#if CONFIG_RINGBUF_TWO_PHASE_SEND
+            if ((pxRingbuffer->uxRingbufferFlags & (rbBYTE_BUFFER_FLAG | rbALLOW_SPLIT_FLAG)) == 0) {
+                /*
+                 * Reserve space while holding the spinlock, but run the copy
+                 * outside of it so concurrent senders only contend for the
+                 * pointer updates. Readers will not see the item until it is
+                 * marked as written, and out of order completion is already
+                 * handled by the written flag mechanism.
+                 */
+                uint8_t *pucAcquiredItem = prvAcquireItemNoSplit(pxRingbuffer, xItemSize);
+                rbSTATS_INC(pxRingbuffer, uxTwoPhaseSends);
+                portEXIT_CRITICAL(&pxRingbuffer->mux);
+                memcpy(pucAcquiredItem, pvItem, xItemSize);
+                portENTER_CRITICAL(&pxRingbuffer->mux);
+                prvSendItemDoneNoSplit(pxRingbuffer, pucAcquiredItem);
+            } else {
+                //Allow-split/byte buffers advance the write pointer during the copy, keep it inside the critical section
+                pxRingbuffer->vCopyItem(pxRingbuffer, pvItem, xItemSize);
+            }
+#else
             //Item will fit, copy item
             pxRingbuffer->vCopyItem(pxRingbuffer, pvItem, xItemSize);
+#endif
             xReturn = pdTRUE;
+            rbSTATS_INC(pxRingbuffer, uxTotalSends);
             //Check if the free semaphore should be returned to allow other tasks to send
             if (prvGetFreeSize(pxRingbuffer) > 0) {
                 xReturnSemaphore = pdTRUE;
@@ -1031,6 +1129,7 @@ BaseType_t xRingbufferSend(RingbufHandle_t xRingbuffer,
             break;
         }
         //Item doesn't fit, adjust ticks and take the semaphore again
+        rbSTATS_INC(pxRingbuffer, uxSendNoSpace);
         if (xTicksToWait != portMAX_DELAY) {
             xTicksRemaining = xTicksEnd - xTaskGetTickCount();
         }
@@ -1074,12 +1173,14 @@ BaseType_t xRingbufferSendFromISR(RingbufHandle_t xRingbuffer,
     if (pxRingbuffer->xCheckItemFits(xRingbuffer, xItemSize) == pdTRUE) {
         pxRingbuffer->vCopyItem(xRingbuffer, pvItem, xItemSize);
         xReturn = pdTRUE;
+        rbSTATS_INC(pxRingbuffer, uxTotalSends);
         //Check if the free semaphore should be returned to allow other tasks to send
         if (prvGetFreeSize(pxRingbuffer) > 0) {
             xReturnSemaphore = pdTRUE;
         }
     } else {
         xReturn = pdFALSE;
+        rbSTATS_INC(pxRingbuffer, uxSendNoSpace);
     }
     portEXIT_CRITICAL_ISR(&pxRingbuffer->mux);
 
@@ -1258,6 +1359,104 @@ void *xRingbufferReceiveUpToFromISR(RingbufHandle_t xRingbuffer, size_t *pxItemS
     }
 }
 
+BaseType_t xRingbufferReceiveSplice(RingbufHandle_t xRingbuffer,
+                                    void **ppvHeadItem,
+                                    void **ppvTailItem,
+                                    size_t *pxHeadItemSize,
+                                    size_t *pxTailItemSize,
+                                    size_t xMaxSize,
+                                    TickType_t xTicksToWait)
+{
+    //Check arguments
+    Ringbuffer_t *pxRingbuffer = (Ringbuffer_t *)xRingbuffer;
+    configASSERT(pxRingbuffer);
+    configASSERT(pxRingbuffer->uxRingbufferFlags & rbBYTE_BUFFER_FLAG);    //This function should only be called for byte buffers
+    configASSERT(ppvHeadItem != NULL && ppvTailItem != NULL);
+    configASSERT(pxHeadItemSize != NULL && pxTailItemSize != NULL);
+
+    BaseType_t xReturn = pdFALSE;
+    BaseType_t xReturnSemaphore = pdFALSE;
+    TickType_t xTicksEnd = xTaskGetTickCount() + xTicksToWait;
+    TickType_t xTicksRemaining = xTicksToWait;
+    while (xTicksRemaining <= xTicksToWait) {   //xTicksToWait will underflow once xTaskGetTickCount() > ticks_end
+        //Block until data becomes available or timeout
+        if (xSemaphoreTake(rbGET_RX_SEM_HANDLE(pxRingbuffer), xTicksRemaining) != pdTRUE) {
+            break;      //Timed out attempting to get semaphore
+        }
+
+        //Semaphore obtained, check if data can be retrieved
+        portENTER_CRITICAL(&pxRingbuffer->mux);
+        if (prvCheckItemAvail(pxRingbuffer) == pdTRUE) {
+            prvGetSplicedByteBuf(pxRingbuffer, ppvHeadItem, pxHeadItemSize, ppvTailItem, pxTailItemSize, xMaxSize);
+            xReturn = pdTRUE;
+            rbSTATS_INC(pxRingbuffer, uxTotalReceives);
+            if (pxRingbuffer->xItemsWaiting > 0) {
+                xReturnSemaphore = pdTRUE;
+            }
+            portEXIT_CRITICAL(&pxRingbuffer->mux);
+            break;
+        }
+        //No data available for retrieval, adjust ticks and take the semaphore again
+        rbSTATS_INC(pxRingbuffer, uxReceiveNoItems);
+        if (xTicksToWait != portMAX_DELAY) {
+            xTicksRemaining = xTicksEnd - xTaskGetTickCount();
+        }
+        portEXIT_CRITICAL(&pxRingbuffer->mux);
+        /*
+         * Gap between critical section and re-acquiring of the semaphore. If
+         * semaphore is given now, priority inversion might occur (see docs)
+         */
+    }
+
+    if (xReturnSemaphore == pdTRUE) {
+        xSemaphoreGive(rbGET_RX_SEM_HANDLE(pxRingbuffer));  //Give semaphore back so other tasks can retrieve
+    }
+    if (xReturn == pdFALSE) {
+        *ppvHeadItem = NULL;
+        *ppvTailItem = NULL;
+    }
+    return xReturn;
+}
+
+BaseType_t xRingbufferReceiveSpliceFromISR(RingbufHandle_t xRingbuffer,
+                                           void **ppvHeadItem,
+                                           void **ppvTailItem,
+                                           size_t *pxHeadItemSize,
+                                           size_t *pxTailItemSize,
+                                           size_t xMaxSize)
+{
+    //Check arguments
+    Ringbuffer_t *pxRingbuffer = (Ringbuffer_t *)xRingbuffer;
+    configASSERT(pxRingbuffer);
+    configASSERT(pxRingbuffer->uxRingbufferFlags & rbBYTE_BUFFER_FLAG);    //This function should only be called for byte buffers
+    configASSERT(ppvHeadItem != NULL && ppvTailItem != NULL);
+    configASSERT(pxHeadItemSize != NULL && pxTailItemSize != NULL);
+
+    BaseType_t xReturn = pdFALSE;
+    BaseType_t xReturnSemaphore = pdFALSE;
+    portENTER_CRITICAL_ISR(&pxRingbuffer->mux);
+    if (prvCheckItemAvail(pxRingbuffer) == pdTRUE) {
+        prvGetSplicedByteBuf(pxRingbuffer, ppvHeadItem, pxHeadItemSize, ppvTailItem, pxTailItemSize, xMaxSize);
+        xReturn = pdTRUE;
+        rbSTATS_INC(pxRingbuffer, uxTotalReceives);
+        if (pxRingbuffer->xItemsWaiting > 0) {
+            xReturnSemaphore = pdTRUE;
+        }
+    } else {
+        rbSTATS_INC(pxRingbuffer, uxReceiveNoItems);
+    }
+    portEXIT_CRITICAL_ISR(&pxRingbuffer->mux);
+
+    if (xReturnSemaphore == pdTRUE) {
+        xSemaphoreGiveFromISR(rbGET_RX_SEM_HANDLE(pxRingbuffer), NULL);  //Give semaphore back so other tasks can retrieve
+    }
+    if (xReturn == pdFALSE) {
+        *ppvHeadItem = NULL;
+        *ppvTailItem = NULL;
+    }
+    return xReturn;
+}
+
 void vRingbufferReturnItem(RingbufHandle_t xRingbuffer, void *pvItem)
 {
     Ringbuffer_t *pxRingbuffer = (Ringbuffer_t *)xRingbuffer;
@@ -1403,3 +1602,16 @@ void xRingbufferPrintInfo(RingbufHandle_t xRingbuffer)
            pxRingbuffer->pucWrite - pxRingbuffer->pucHead,
            pxRingbuffer->pucAcquire - pxRingbuffer->pucHead);
 }
+
+#if CONFIG_RINGBUF_STATS
+void vRingbufferGetStats(RingbufHandle_t xRingbuffer, RingbufferStats_t *pxStats)
+{
+    Ringbuffer_t *pxRingbuffer = (Ringbuffer_t *)xRingbuffer;
+    configASSERT(pxRingbuffer);
+    configASSERT(pxStats);
+
+    portENTER_CRITICAL(&pxRingbuffer->mux);
+    *pxStats = pxRingbuffer->xStats;
+    portEXIT_CRITICAL(&pxRingbuffer->mux);
+}
+#endif
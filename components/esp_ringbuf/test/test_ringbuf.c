@@ -260,6 +260,53 @@ TEST_CASE("Test ring buffer Byte Buffer", "[esp_ringbuf]")
     vRingbufferDelete(buffer_handle);
 }
 
+TEST_CASE("Test ring buffer Splice Receive", "[esp_ringbuf]")
+{
+    //Create buffer
+    RingbufHandle_t buffer_handle = xRingbufferCreate(BUFFER_SIZE, RINGBUF_TYPE_BYTEBUF);
+    TEST_ASSERT_MESSAGE(buffer_handle != NULL, "Failed to create ring buffer");
+
+    //Splice receive of contiguous data should return a single region
+    send_item_and_check(buffer_handle, small_item, SMALL_ITEM_SIZE, TIMEOUT_TICKS, false);
+    uint8_t *head, *tail;
+    size_t head_size, tail_size;
+    TEST_ASSERT_MESSAGE(xRingbufferReceiveSplice(buffer_handle, (void **)&head, (void **)&tail, &head_size, &tail_size, 0, TIMEOUT_TICKS) == pdTRUE, "Failed to splice receive");
+    TEST_ASSERT_MESSAGE(head != NULL && tail == NULL, "Contiguous data should not produce a tail region");
+    TEST_ASSERT_MESSAGE(head_size == SMALL_ITEM_SIZE && tail_size == 0, "Region sizes are incorrect");
+    for (int i = 0; i < head_size; i++) {
+        TEST_ASSERT_MESSAGE(head[i] == small_item[i], "Head region data is invalid");
+    }
+    vRingbufferReturnItem(buffer_handle, (void *)head);
+
+    //Move the read/write position to SMALL_ITEM_SIZE before the end of the storage area
+    int no_of_items = (BUFFER_SIZE - (2 * SMALL_ITEM_SIZE)) / SMALL_ITEM_SIZE;
+    for (int i = 0; i < no_of_items; i++) {
+        send_item_and_check(buffer_handle, small_item, SMALL_ITEM_SIZE, TIMEOUT_TICKS, false);
+        receive_check_and_return_item_byte_buffer(buffer_handle, small_item, SMALL_ITEM_SIZE, TIMEOUT_TICKS, false);
+    }
+
+    //Send an item that wraps around, then splice receive both regions in one call
+    send_item_and_check(buffer_handle, large_item, LARGE_ITEM_SIZE, TIMEOUT_TICKS, false);
+    TEST_ASSERT_MESSAGE(xRingbufferReceiveSplice(buffer_handle, (void **)&head, (void **)&tail, &head_size, &tail_size, 0, TIMEOUT_TICKS) == pdTRUE, "Failed to splice receive");
+    TEST_ASSERT_MESSAGE(head != NULL && tail != NULL, "Wrapped data should produce two regions");
+    TEST_ASSERT_MESSAGE(head_size + tail_size == LARGE_ITEM_SIZE, "Total region size is incorrect");
+    for (int i = 0; i < head_size; i++) {
+        TEST_ASSERT_MESSAGE(head[i] == large_item[i], "Head region data is invalid");
+    }
+    for (int i = 0; i < tail_size; i++) {
+        TEST_ASSERT_MESSAGE(tail[i] == large_item[head_size + i], "Tail region data is invalid");
+    }
+    //Both regions are returned with a single call using the head region
+    vRingbufferReturnItem(buffer_handle, (void *)head);
+
+    //Buffer should now be empty
+    TEST_ASSERT_MESSAGE(xRingbufferReceiveSplice(buffer_handle, (void **)&head, (void **)&tail, &head_size, &tail_size, 0, 0) == pdFALSE, "Splice receive on empty buffer should fail");
+    TEST_ASSERT_MESSAGE(head == NULL && tail == NULL, "Regions should be NULL after failed receive");
+
+    //Cleanup
+    vRingbufferDelete(buffer_handle);
+}
+
 /* ----------------------- Ring buffer queue sets test ------------------------
  * The following test case will test receiving from ring buffers that have been
  * added to a queue set. The test case will do the following...
@@ -15,3 +15,4 @@
 #pragma once
 
 #define ESP_ROM_HAS_CRC_LE      (1) // ROM CRC library supports Little Endian
+#define ESP_ROM_HAS_MINIZ       (1) // ROM has the miniz deflate/inflate library
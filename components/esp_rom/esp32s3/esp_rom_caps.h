@@ -17,3 +17,4 @@
 #define ESP_ROM_HAS_CRC_LE      (1) // ROM CRC library supports Little Endian
 #define ESP_ROM_HAS_CRC_BE      (1) // ROM CRC library supports Big Endian
 #define ESP_ROM_HAS_JPEG_DECODE (1) // ROM has JPEG decode library
+#define ESP_ROM_HAS_MINIZ       (1) // ROM has the miniz deflate/inflate library
@@ -0,0 +1,155 @@
+// Copyright 2010-2020 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+/**          Notes about the miniz API
+ * All supported chips carry the miniz deflate/inflate routines in ROM
+ * (see <target>/rom/miniz.h). Using them instead of linking zlib or a
+ * second copy of miniz saves tens of kilobytes of flash. The raw ROM
+ * interface is awkward for streaming use, though: the decompressor
+ * requires a power-of-two dictionary-sized output window, and callers
+ * have to manage the ring buffer themselves.
+ *
+ * The functions below wrap the ROM routines in a streaming interface:
+ * feed input in arbitrarily sized pieces and drain output into
+ * arbitrarily sized buffers. Contexts are heap allocated because they
+ * are large: an inflate context is a bit over 43 KB (decompressor state
+ * plus the 32 KB dictionary window), a deflate context is around 300 KB
+ * and is realistically only usable with SPIRAM.
+ *
+ * Both "zlib" framing (RFC 1950, 2 byte header + adler-32 trailer) and
+ * raw deflate streams (RFC 1951) are supported. gzip framing is not
+ * handled here; callers must strip the gzip header and trailer around a
+ * raw deflate stream themselves.
+ */
+
+/**
+ * @brief Opaque streaming decompression context, backed by ROM tinfl
+ */
+typedef struct esp_rom_miniz_inflate_s esp_rom_miniz_inflate_t;
+
+/**
+ * @brief Opaque streaming compression context, backed by ROM tdefl
+ */
+typedef struct esp_rom_miniz_deflate_s esp_rom_miniz_deflate_t;
+
+/**
+ * @brief Allocate and initialize a streaming decompression context
+ *
+ * @param zlib_header true if the input is a zlib stream (header + adler-32
+ *                    trailer), false for a raw deflate stream
+ * @return context pointer, or NULL if allocation failed
+ */
+esp_rom_miniz_inflate_t *esp_rom_miniz_inflate_new(bool zlib_header);
+
+/**
+ * @brief Decompress a piece of the input stream
+ *
+ * Consumes up to *in_len input bytes and produces up to *out_len output
+ * bytes. On return both are updated to the number of bytes actually
+ * consumed/produced. Either may be zero: input is not consumed while
+ * previously decoded bytes are still waiting in the dictionary window,
+ * and no output is produced while the decompressor needs more input.
+ * Call repeatedly until esp_rom_miniz_inflate_finished() returns true.
+ *
+ * @param ctx     context from esp_rom_miniz_inflate_new()
+ * @param in      input (compressed) data, may be NULL if *in_len is 0
+ * @param in_len  in: available input bytes; out: bytes consumed
+ * @param out     output buffer for decompressed data
+ * @param out_len in: output buffer size; out: bytes produced
+ * @param last_input true if the end of in/in_len is the end of the
+ *                   compressed stream (no more input will ever be fed)
+ * @return
+ *  - ESP_OK on success (including "need more input/output space")
+ *  - ESP_ERR_INVALID_ARG if ctx, in_len or out_len is NULL
+ *  - ESP_FAIL if the compressed stream is corrupt
+ */
+esp_err_t esp_rom_miniz_inflate(esp_rom_miniz_inflate_t *ctx,
+                                const void *in, size_t *in_len,
+                                void *out, size_t *out_len,
+                                bool last_input);
+
+/**
+ * @brief Check whether the compressed stream was fully decoded
+ *
+ * True once the end of the deflate stream was reached and every decoded
+ * byte has been copied out by esp_rom_miniz_inflate().
+ */
+bool esp_rom_miniz_inflate_finished(const esp_rom_miniz_inflate_t *ctx);
+
+/**
+ * @brief Free a decompression context. NULL is allowed.
+ */
+void esp_rom_miniz_inflate_free(esp_rom_miniz_inflate_t *ctx);
+
+/**
+ * @brief Allocate and initialize a streaming compression context
+ *
+ * @param zlib_header true to emit a zlib header and adler-32 trailer,
+ *                    false for a raw deflate stream
+ * @param level compression level, 0 (fastest, largest output) to 10
+ * @return context pointer, or NULL if allocation failed
+ */
+esp_rom_miniz_deflate_t *esp_rom_miniz_deflate_new(bool zlib_header, int level);
+
+/**
+ * @brief Compress a piece of the input stream
+ *
+ * Same in/out length convention as esp_rom_miniz_inflate(). Once called
+ * with last_input set, keep calling (with *in_len 0 if all input was
+ * consumed) until esp_rom_miniz_deflate_finished() returns true, so that
+ * the compressor can flush its internal buffers.
+ *
+ * @param ctx     context from esp_rom_miniz_deflate_new()
+ * @param in      input (uncompressed) data, may be NULL if *in_len is 0
+ * @param in_len  in: available input bytes; out: bytes consumed
+ * @param out     output buffer for compressed data
+ * @param out_len in: output buffer size; out: bytes produced
+ * @param last_input true if this is the end of the input stream
+ * @return
+ *  - ESP_OK on success
+ *  - ESP_ERR_INVALID_ARG if ctx, in_len or out_len is NULL
+ *  - ESP_FAIL on internal compressor failure
+ */
+esp_err_t esp_rom_miniz_deflate(esp_rom_miniz_deflate_t *ctx,
+                                const void *in, size_t *in_len,
+                                void *out, size_t *out_len,
+                                bool last_input);
+
+/**
+ * @brief Check whether the compressed stream is complete
+ *
+ * True once the compressor was given last_input and has flushed all
+ * pending output.
+ */
+bool esp_rom_miniz_deflate_finished(const esp_rom_miniz_deflate_t *ctx);
+
+/**
+ * @brief Free a compression context. NULL is allowed.
+ */
+void esp_rom_miniz_deflate_free(esp_rom_miniz_deflate_t *ctx);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,170 @@
+// Copyright 2010-2020 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdlib.h>
+#include <string.h>
+#include "sdkconfig.h"
+#include "esp_rom_miniz.h"
+
+#if CONFIG_IDF_TARGET_ESP32
+#include "esp32/rom/miniz.h"
+#elif CONFIG_IDF_TARGET_ESP32S2
+#include "esp32s2/rom/miniz.h"
+#elif CONFIG_IDF_TARGET_ESP32S3
+#include "esp32s3/rom/miniz.h"
+#endif
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+struct esp_rom_miniz_inflate_s {
+    tinfl_decompressor decomp;
+    uint8_t dict[TINFL_LZ_DICT_SIZE];   // ring buffer holding the sliding window
+    size_t dict_ofs;                    // next write position in dict
+    size_t dict_avail;                  // decoded bytes not yet copied out
+    bool zlib_header;
+    bool stream_done;                   // end of deflate stream reached
+};
+
+struct esp_rom_miniz_deflate_s {
+    tdefl_compressor comp;
+    bool stream_done;
+};
+
+esp_rom_miniz_inflate_t *esp_rom_miniz_inflate_new(bool zlib_header)
+{
+    esp_rom_miniz_inflate_t *ctx = calloc(1, sizeof(esp_rom_miniz_inflate_t));
+    if (ctx == NULL) {
+        return NULL;
+    }
+    tinfl_init(&ctx->decomp);
+    ctx->zlib_header = zlib_header;
+    return ctx;
+}
+
+esp_err_t esp_rom_miniz_inflate(esp_rom_miniz_inflate_t *ctx,
+                                const void *in, size_t *in_len,
+                                void *out, size_t *out_len,
+                                bool last_input)
+{
+    if (ctx == NULL || in_len == NULL || out_len == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    const uint8_t *in_buf = (const uint8_t *) in;
+    uint8_t *out_buf = (uint8_t *) out;
+    const size_t in_total = *in_len;
+    const size_t out_total = *out_len;
+    size_t in_pos = 0;
+    size_t out_pos = 0;
+
+    while (out_pos < out_total) {
+        if (ctx->dict_avail) {
+            /* Copy out bytes decoded by a previous tinfl_decompress call.
+             * The decoded run never wraps around the ring buffer, because
+             * each call is limited to the space up to the end of dict. */
+            size_t src_ofs = (ctx->dict_ofs - ctx->dict_avail) & (TINFL_LZ_DICT_SIZE - 1);
+            size_t n = MIN(ctx->dict_avail, out_total - out_pos);
+            memcpy(out_buf + out_pos, ctx->dict + src_ofs, n);
+            ctx->dict_avail -= n;
+            out_pos += n;
+            continue;
+        }
+        if (ctx->stream_done) {
+            break;
+        }
+        size_t in_bytes = in_total - in_pos;
+        size_t dst_bytes = TINFL_LZ_DICT_SIZE - ctx->dict_ofs;
+        uint32_t flags = (ctx->zlib_header ? TINFL_FLAG_PARSE_ZLIB_HEADER : 0)
+                         | (last_input ? 0 : TINFL_FLAG_HAS_MORE_INPUT);
+        tinfl_status status = tinfl_decompress(&ctx->decomp,
+                                               in_buf + in_pos, &in_bytes,
+                                               ctx->dict, ctx->dict + ctx->dict_ofs, &dst_bytes,
+                                               flags);
+        in_pos += in_bytes;
+        ctx->dict_avail = dst_bytes;
+        ctx->dict_ofs = (ctx->dict_ofs + dst_bytes) & (TINFL_LZ_DICT_SIZE - 1);
+        if (status == TINFL_STATUS_DONE) {
+            ctx->stream_done = true;
+        } else if (status < TINFL_STATUS_DONE) {
+            *in_len = in_pos;
+            *out_len = out_pos;
+            return ESP_FAIL;
+        }
+        if (dst_bytes == 0 && in_pos == in_total) {
+            break; /* no progress possible without more input */
+        }
+    }
+    *in_len = in_pos;
+    *out_len = out_pos;
+    return ESP_OK;
+}
+
+bool esp_rom_miniz_inflate_finished(const esp_rom_miniz_inflate_t *ctx)
+{
+    return ctx->stream_done && ctx->dict_avail == 0;
+}
+
+void esp_rom_miniz_inflate_free(esp_rom_miniz_inflate_t *ctx)
+{
+    free(ctx);
+}
+
+esp_rom_miniz_deflate_t *esp_rom_miniz_deflate_new(bool zlib_header, int level)
+{
+    /* Probe counts the upstream miniz uses for levels 0..10 */
+    static const uint16_t probes[11] = {0, 1, 6, 32, 16, 32, 128, 256, 512, 768, 1500};
+    if (level < 0 || level > 10) {
+        return NULL;
+    }
+    esp_rom_miniz_deflate_t *ctx = calloc(1, sizeof(esp_rom_miniz_deflate_t));
+    if (ctx == NULL) {
+        return NULL;
+    }
+    int flags = probes[level] | (zlib_header ? TDEFL_WRITE_ZLIB_HEADER : 0);
+    if (level == 0) {
+        flags |= TDEFL_FORCE_ALL_RAW_BLOCKS;
+    }
+    if (tdefl_init(&ctx->comp, NULL, NULL, flags) != TDEFL_STATUS_OKAY) {
+        free(ctx);
+        return NULL;
+    }
+    return ctx;
+}
+
+esp_err_t esp_rom_miniz_deflate(esp_rom_miniz_deflate_t *ctx,
+                                const void *in, size_t *in_len,
+                                void *out, size_t *out_len,
+                                bool last_input)
+{
+    if (ctx == NULL || in_len == NULL || out_len == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    tdefl_status status = tdefl_compress(&ctx->comp, in, in_len, out, out_len,
+                                         last_input ? TDEFL_FINISH : TDEFL_NO_FLUSH);
+    if (status == TDEFL_STATUS_DONE) {
+        ctx->stream_done = true;
+    } else if (status < TDEFL_STATUS_OKAY) {
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+bool esp_rom_miniz_deflate_finished(const esp_rom_miniz_deflate_t *ctx)
+{
+    return ctx->stream_done;
+}
+
+void esp_rom_miniz_deflate_free(esp_rom_miniz_deflate_t *ctx)
+{
+    free(ctx);
+}
@@ -101,5 +101,78 @@ TEST_CASE("Test miniz compression/decompression", "[rom][miniz]")
     free(decomp);
 }
 
+#include "esp_rom_miniz.h"
+
+TEST_CASE("Test miniz streaming wrapper", "[rom][miniz]")
+{
+    const size_t chunk = 1024; // deliberately small to force many partial calls
+    size_t inpos = 0, outpos = 0, compsz;
+
+    printf("Allocating data buffer and filling it with semi-random data\r\n");
+    uint8_t *inbuf = calloc(1, DATASIZE);
+    uint8_t *outbuf = calloc(1, DATASIZE);
+    TEST_ASSERT_NOT_NULL(inbuf);
+    TEST_ASSERT_NOT_NULL(outbuf);
+    srand(0);
+    for (int i = 0; i < DATASIZE; i++) {
+        inbuf[i] = (i & 0x01) ? rand() & 0xff : 0;
+    }
+
+    printf("Compressing in %d byte pieces...\r\n", chunk);
+    esp_rom_miniz_deflate_t *comp = esp_rom_miniz_deflate_new(true, 6);
+    TEST_ASSERT_NOT_NULL(comp);
+    while (!esp_rom_miniz_deflate_finished(comp)) {
+        size_t in_len = DATASIZE - inpos;
+        if (in_len > chunk) {
+            in_len = chunk;
+        }
+        bool last = (inpos + in_len == DATASIZE);
+        size_t out_len = chunk;
+        TEST_ASSERT_EQUAL(ESP_OK, esp_rom_miniz_deflate(comp, &inbuf[inpos], &in_len,
+                                                        &outbuf[outpos], &out_len, last));
+        inpos += in_len;
+        outpos += out_len;
+        TEST_ASSERT_LESS_OR_EQUAL(DATASIZE, outpos);
+    }
+    esp_rom_miniz_deflate_free(comp);
+    compsz = outpos;
+    printf("Compressed %d into %d bytes\r\n", DATASIZE, compsz);
+
+    free(inbuf);
+    inbuf = outbuf;
+    outbuf = calloc(1, DATASIZE);
+    TEST_ASSERT_NOT_NULL(outbuf);
+
+    printf("Decompressing in %d byte pieces...\r\n", chunk);
+    esp_rom_miniz_inflate_t *decomp = esp_rom_miniz_inflate_new(true);
+    TEST_ASSERT_NOT_NULL(decomp);
+    inpos = 0;
+    outpos = 0;
+    while (!esp_rom_miniz_inflate_finished(decomp)) {
+        size_t in_len = compsz - inpos;
+        if (in_len > chunk) {
+            in_len = chunk;
+        }
+        bool last = (inpos + in_len == compsz);
+        size_t out_len = chunk;
+        TEST_ASSERT_EQUAL(ESP_OK, esp_rom_miniz_inflate(decomp, &inbuf[inpos], &in_len,
+                                                        &outbuf[outpos], &out_len, last));
+        inpos += in_len;
+        outpos += out_len;
+        TEST_ASSERT_LESS_OR_EQUAL(DATASIZE, outpos);
+    }
+    esp_rom_miniz_inflate_free(decomp);
+    TEST_ASSERT_EQUAL(DATASIZE, outpos);
+
+    printf("Verifying data between compression and decompression...\r\n");
+    srand(0);
+    for (int i = 0; i < DATASIZE; i++) {
+        uint8_t original = (i & 1) ? rand() & 0xff : 0;
+        TEST_ASSERT_EQUAL_MESSAGE(original, outbuf[i], "data after decompression doesn't match the original one");
+    }
+    free(inbuf);
+    free(outbuf);
+}
+
 #endif //#if !TEMPORARY_DISABLED_FOR_TARGETS(ESP32)
 #endif // CONFIG_SPIRAM
@@ -0,0 +1,206 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_serial_slave_link/essl_async.h"
+
+static const char TAG[] = "essl_async";
+
+// How long the link task blocks on the slave interrupt line (or the send
+// queue when read-ahead is disabled) before checking for new work
+#define ESSL_ASYNC_POLL_MS      10
+
+typedef struct {
+    const void *buffer;
+    size_t length;
+    essl_async_done_cb_t cb;
+    void *arg;
+} essl_async_txn_t;
+
+typedef struct essl_async_ctx_t {
+    essl_handle_t dev;
+    QueueHandle_t txn_queue;
+    TaskHandle_t task;
+    SemaphoreHandle_t exited;
+    uint8_t *read_buf;
+    size_t read_ahead_size;
+    essl_async_done_cb_t recv_cb;
+    void *recv_arg;
+    uint32_t trans_wait_ms;
+    volatile bool run;
+} essl_async_ctx_t;
+
+static void essl_async_retire(essl_async_ctx_t *ctx, const essl_async_txn_t *txn, esp_err_t err)
+{
+    if (txn->cb) {
+        txn->cb(ctx, err, (void *)txn->buffer, txn->length, txn->arg);
+    }
+}
+
+// Read everything the slave has buffered and deliver it through the receive
+// callback; one interrupt drains any number of slave buffers.
+static void essl_async_drain_slave(essl_async_ctx_t *ctx)
+{
+    esp_err_t err;
+    do {
+        size_t length = 0;
+        err = essl_get_packet(ctx->dev, ctx->read_buf, ctx->read_ahead_size, &length, ctx->trans_wait_ms);
+        if ((err == ESP_OK || err == ESP_ERR_NOT_FINISHED) && length > 0) {
+            ctx->recv_cb(ctx, ESP_OK, ctx->read_buf, length, ctx->recv_arg);
+        } else if (err != ESP_ERR_NOT_FOUND && err != ESP_OK) {
+            ctx->recv_cb(ctx, err, NULL, 0, ctx->recv_arg);
+        }
+    } while (err == ESP_ERR_NOT_FINISHED);
+}
+
+static void essl_async_task(void *arg)
+{
+    essl_async_ctx_t *ctx = (essl_async_ctx_t *)arg;
+    essl_async_txn_t txn;
+
+    while (ctx->run) {
+        // run all queued sends back to back, keeping the bus busy
+        while (xQueueReceive(ctx->txn_queue, &txn, 0) == pdTRUE) {
+            if (txn.buffer == NULL) {
+                continue;   //wakeup marker from deinit
+            }
+            esp_err_t err = essl_send_packet(ctx->dev, txn.buffer, txn.length, ctx->trans_wait_ms);
+            essl_async_retire(ctx, &txn, err);
+        }
+        if (ctx->read_buf) {
+            // block on the interrupt line; a signal means the slave has
+            // buffered data ready, read it ahead without being asked
+            if (essl_wait_int(ctx->dev, ESSL_ASYNC_POLL_MS) == ESP_OK) {
+                essl_clear_intr(ctx->dev, UINT32_MAX, ctx->trans_wait_ms);
+                essl_async_drain_slave(ctx);
+            }
+        } else {
+            // no read-ahead: just sleep on the queue for new sends
+            if (xQueuePeek(ctx->txn_queue, &txn, pdMS_TO_TICKS(ESSL_ASYNC_POLL_MS)) == pdTRUE) {
+                continue;
+            }
+        }
+    }
+
+    // fail whatever is still queued so no caller waits forever
+    while (xQueueReceive(ctx->txn_queue, &txn, 0) == pdTRUE) {
+        if (txn.buffer) {
+            essl_async_retire(ctx, &txn, ESP_ERR_INVALID_STATE);
+        }
+    }
+    xSemaphoreGive(ctx->exited);
+    vTaskDelete(NULL);
+}
+
+esp_err_t essl_async_init(const essl_async_config_t *config, essl_async_handle_t *out_handle)
+{
+    if (config == NULL || out_handle == NULL || config->dev == NULL || config->queue_size <= 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (config->read_ahead_size > 0 && config->recv_cb == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    essl_async_ctx_t *ctx = (essl_async_ctx_t *)calloc(1, sizeof(essl_async_ctx_t));
+    if (ctx == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    ctx->dev = config->dev;
+    ctx->recv_cb = config->recv_cb;
+    ctx->recv_arg = config->recv_arg;
+    ctx->read_ahead_size = config->read_ahead_size;
+    ctx->trans_wait_ms = config->trans_wait_ms;
+    ctx->run = true;
+
+    ctx->txn_queue = xQueueCreate(config->queue_size, sizeof(essl_async_txn_t));
+    ctx->exited = xSemaphoreCreateBinary();
+    if (ctx->txn_queue == NULL || ctx->exited == NULL) {
+        goto no_mem;
+    }
+    if (config->read_ahead_size > 0) {
+        ctx->read_buf = (uint8_t *)malloc(config->read_ahead_size);
+        if (ctx->read_buf == NULL) {
+            goto no_mem;
+        }
+    }
+
+    BaseType_t ret = xTaskCreate(essl_async_task, "essl_async", config->task_stack_size,
+                                 ctx, config->task_priority, &ctx->task);
+    if (ret != pdPASS) {
+        ESP_LOGE(TAG, "create link task failed");
+        goto no_mem;
+    }
+
+    *out_handle = ctx;
+    return ESP_OK;
+
+no_mem:
+    if (ctx->txn_queue) {
+        vQueueDelete(ctx->txn_queue);
+    }
+    if (ctx->exited) {
+        vSemaphoreDelete(ctx->exited);
+    }
+    free(ctx->read_buf);
+    free(ctx);
+    return ESP_ERR_NO_MEM;
+}
+
+esp_err_t essl_async_deinit(essl_async_handle_t handle)
+{
+    if (handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    handle->run = false;
+    // a NULL-buffer marker wakes the task if it sleeps on the queue
+    essl_async_txn_t marker = {};
+    xQueueSend(handle->txn_queue, &marker, 0);
+    xSemaphoreTake(handle->exited, portMAX_DELAY);
+
+    vQueueDelete(handle->txn_queue);
+    vSemaphoreDelete(handle->exited);
+    free(handle->read_buf);
+    free(handle);
+    return ESP_OK;
+}
+
+esp_err_t essl_async_send_packet(essl_async_handle_t handle, const void *start, size_t length,
+                                 essl_async_done_cb_t cb, void *arg, uint32_t queue_wait_ms)
+{
+    if (handle == NULL || start == NULL || length == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    essl_async_txn_t txn = {
+        .buffer = start,
+        .length = length,
+        .cb = cb,
+        .arg = arg,
+    };
+    if (xQueueSend(handle->txn_queue, &txn, pdMS_TO_TICKS(queue_wait_ms)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    return ESP_OK;
+}
+
+essl_handle_t essl_async_get_dev(essl_async_handle_t handle)
+{
+    return handle ? handle->dev : NULL;
+}
@@ -0,0 +1,128 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "esp_serial_slave_link/essl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Pipelined transaction layer over an ESSL device.
+ *
+ * The plain ESSL calls run one transaction per caller round trip, leaving
+ * the bus idle between each completion and the next submission. This layer
+ * runs a dedicated link task that executes queued send transactions back to
+ * back, and - when the slave raises its interrupt line - automatically
+ * reads slave-buffered data ahead and delivers it through a receive
+ * callback. Senders get their completion callbacks as transactions retire;
+ * received data is delivered independently of the send queue, so the two
+ * directions complete out of order relative to each other.
+ */
+
+struct essl_async_ctx_t;
+/// Handle of a pipelined ESSL link
+typedef struct essl_async_ctx_t *essl_async_handle_t;
+
+/**
+ * @brief Completion callback, called from the link task.
+ *
+ * For send transactions `data`/`length` echo the submitted buffer. For
+ * read-ahead deliveries `data` points at the link's internal read buffer,
+ * valid only during the callback - consume or copy before returning.
+ *
+ * @param handle Handle of the pipelined link.
+ * @param err Result of the transaction.
+ * @param data Transaction data.
+ * @param length Transaction data length in bytes.
+ * @param arg User argument given at submission (sends) or in the config (receives).
+ */
+typedef void (*essl_async_done_cb_t)(essl_async_handle_t handle, esp_err_t err, void *data, size_t length, void *arg);
+
+/// Configuration of a pipelined ESSL link
+typedef struct {
+    essl_handle_t dev;              ///< Underlying ESSL device; owned by the caller, must outlive the link
+    int queue_size;                 ///< Pending send transaction slots
+    size_t read_ahead_size;         ///< Size of the read-ahead buffer in bytes, 0 disables automatic receiving
+    essl_async_done_cb_t recv_cb;   ///< Called with slave data read ahead on interrupt, required when read_ahead_size > 0
+    void *recv_arg;                 ///< User argument of recv_cb
+    uint32_t trans_wait_ms;         ///< Timeout applied to each transaction on the bus
+    int task_priority;              ///< Priority of the link task
+    int task_stack_size;            ///< Stack size of the link task in bytes
+} essl_async_config_t;
+
+/**
+ * @brief Start a pipelined link over an initialized ESSL device.
+ *
+ * @param config Configuration of the link.
+ * @param[out] out_handle Output of the link handle.
+ *
+ * @return
+ *      - ESP_OK: on success
+ *      - ESP_ERR_INVALID_ARG: invalid configuration
+ *      - ESP_ERR_NO_MEM: no memory for the link resources
+ */
+esp_err_t essl_async_init(const essl_async_config_t *config, essl_async_handle_t *out_handle);
+
+/**
+ * @brief Stop the link task and release the link.
+ *
+ * Pending transactions are completed with ESP_ERR_INVALID_STATE before the
+ * task exits.
+ *
+ * @param handle Handle of the pipelined link.
+ *
+ * @return ESP_OK on success, ESP_ERR_INVALID_ARG on NULL handle.
+ */
+esp_err_t essl_async_deinit(essl_async_handle_t handle);
+
+/**
+ * @brief Queue a packet to send to the slave.
+ *
+ * Returns as soon as the transaction is queued; `cb` is called from the
+ * link task when the transaction retires. The buffer is owned by the
+ * caller until the callback runs.
+ *
+ * @param handle Handle of the pipelined link.
+ * @param start Start address of the packet, valid until the completion callback.
+ * @param length Length of the packet.
+ * @param cb Completion callback, can be NULL for fire-and-forget.
+ * @param arg User argument of the callback.
+ * @param queue_wait_ms Millisecond to wait for a free queue slot.
+ *
+ * @return
+ *      - ESP_OK: transaction queued
+ *      - ESP_ERR_INVALID_ARG: invalid argument
+ *      - ESP_ERR_TIMEOUT: the queue stayed full for queue_wait_ms
+ */
+esp_err_t essl_async_send_packet(essl_async_handle_t handle, const void *start, size_t length,
+                                 essl_async_done_cb_t cb, void *arg, uint32_t queue_wait_ms);
+
+/**
+ * @brief Get the underlying ESSL device of a link.
+ *
+ * Useful for register access; avoid packet calls on the device while the
+ * link task is running.
+ *
+ * @param handle Handle of the pipelined link.
+ *
+ * @return the device handle, or NULL on NULL link handle.
+ */
+essl_handle_t essl_async_get_dev(essl_async_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif
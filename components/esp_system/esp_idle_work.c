@@ -0,0 +1,244 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_err.h"
+#include "esp_attr.h"
+#include "esp_freertos_hooks.h"
+#include "esp_idle_work.h"
+#include "esp_rom_sys.h"
+#include "hal/cpu_hal.h"
+
+//Like the hook tables in freertos_hooks.c, a small static array is enough:
+//only a handful of components are expected to have idle chores.
+#define MAX_IDLE_JOBS 8
+
+typedef struct {
+    esp_idle_work_fn_t fn;
+    void *arg;
+    uint32_t priority;
+    uint32_t budget_cycles;
+} esp_idle_job_t;
+
+static portMUX_TYPE s_idle_work_lock = portMUX_INITIALIZER_UNLOCKED;
+static esp_idle_job_t s_idle_jobs[portNUM_PROCESSORS][MAX_IDLE_JOBS];
+static bool s_idle_hook_installed[portNUM_PROCESSORS];
+
+/*
+ * Runs as the registry's idle hook. Jobs are kept sorted by priority, so one
+ * forward walk runs them in order; each job gets its own cycle budget.
+ * Returning false (when some job still has work pending) keeps the core out
+ * of the low power wait so the job is called again on the next pass.
+ */
+static bool idle_work_hook(void)
+{
+    const int core = xPortGetCoreID();
+    bool pending = false;
+    for (int n = 0; n < MAX_IDLE_JOBS; n++) {
+        esp_idle_job_t job = s_idle_jobs[core][n];
+        if (job.fn == NULL) {
+            break;
+        }
+        if (job.fn(job.arg, job.budget_cycles)) {
+            pending = true;
+        }
+    }
+    return !pending;
+}
+
+esp_err_t esp_idle_work_register(uint32_t cpu_id, esp_idle_work_fn_t fn, void *arg,
+                                 uint32_t priority, uint32_t budget_cycles)
+{
+    if (cpu_id >= portNUM_PROCESSORS || fn == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&s_idle_work_lock);
+    int n;
+    for (n = 0; n < MAX_IDLE_JOBS; n++) {
+        if (s_idle_jobs[cpu_id][n].fn == NULL) {
+            break;
+        }
+    }
+    if (n == MAX_IDLE_JOBS) {
+        portEXIT_CRITICAL(&s_idle_work_lock);
+        return ESP_ERR_NO_MEM;
+    }
+    //Shift lower priority jobs down to keep the table sorted; equal
+    //priorities stay in registration order
+    while (n > 0 && s_idle_jobs[cpu_id][n - 1].priority > priority) {
+        s_idle_jobs[cpu_id][n] = s_idle_jobs[cpu_id][n - 1];
+        n--;
+    }
+    s_idle_jobs[cpu_id][n].fn = fn;
+    s_idle_jobs[cpu_id][n].arg = arg;
+    s_idle_jobs[cpu_id][n].priority = priority;
+    s_idle_jobs[cpu_id][n].budget_cycles = budget_cycles;
+    bool install_hook = !s_idle_hook_installed[cpu_id];
+    s_idle_hook_installed[cpu_id] = true;
+    portEXIT_CRITICAL(&s_idle_work_lock);
+
+    if (install_hook) {
+        ESP_ERROR_CHECK(esp_register_freertos_idle_hook_for_cpu(idle_work_hook, cpu_id));
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_idle_work_unregister(uint32_t cpu_id, esp_idle_work_fn_t fn, void *arg)
+{
+    if (cpu_id >= portNUM_PROCESSORS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&s_idle_work_lock);
+    for (int n = 0; n < MAX_IDLE_JOBS; n++) {
+        if (s_idle_jobs[cpu_id][n].fn == fn && s_idle_jobs[cpu_id][n].arg == arg) {
+            //Close the gap so the table stays dense and sorted
+            for (int m = n; m < MAX_IDLE_JOBS - 1; m++) {
+                s_idle_jobs[cpu_id][m] = s_idle_jobs[cpu_id][m + 1];
+            }
+            memset(&s_idle_jobs[cpu_id][MAX_IDLE_JOBS - 1], 0, sizeof(esp_idle_job_t));
+            portEXIT_CRITICAL(&s_idle_work_lock);
+            return ESP_OK;
+        }
+    }
+    portEXIT_CRITICAL(&s_idle_work_lock);
+    return ESP_ERR_NOT_FOUND;
+}
+
+#ifdef CONFIG_ESP_IDLE_WORK_HEAP_CHECK
+
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+
+/*
+ * Built-in job: periodic heap poison/integrity verification. The check
+ * itself walks all heaps in one go, so the cycle budget is advisory for this
+ * job; the interval keeps it off the idle path most of the time.
+ */
+static bool idle_heap_check_job(void *arg, uint32_t budget_cycles)
+{
+    static int64_t s_last_check_time;
+    int64_t now = esp_timer_get_time();
+    if (now - s_last_check_time < (int64_t)CONFIG_ESP_IDLE_WORK_HEAP_CHECK_INTERVAL_MS * 1000) {
+        return false;
+    }
+    s_last_check_time = now;
+    if (!heap_caps_check_integrity_all(true)) {
+        //The idle task must not block, so report with the ROM printf and
+        //abort: the heap is corrupt and every further allocation is suspect
+        esp_rom_printf("idle heap check: heap corruption detected\n");
+        abort();
+    }
+    return false;
+}
+
+#endif // CONFIG_ESP_IDLE_WORK_HEAP_CHECK
+
+#ifdef CONFIG_ESP_IDLE_WORK_CACHE_WARM
+
+#define MAX_WARM_REGIONS        8
+#define CACHE_WARM_LINE_SIZE    32
+
+typedef struct {
+    const volatile uint8_t *start;
+    size_t size;
+    size_t pos;         //next offset to touch in the current pass
+} warm_region_t;
+
+static warm_region_t s_warm_regions[MAX_WARM_REGIONS];
+static int s_warm_region_count;
+static volatile bool s_warm_pass_pending;
+
+/*
+ * Built-in job: touch one cache line of the registered regions at a time so
+ * they are resident before the next foreground burst. Fully budget-driven
+ * and restartable; quiescent between triggers.
+ */
+static bool idle_cache_warm_job(void *arg, uint32_t budget_cycles)
+{
+    if (!s_warm_pass_pending) {
+        return false;
+    }
+    const uint32_t start_cycles = cpu_hal_get_cycle_count();
+    for (int n = 0; n < s_warm_region_count; n++) {
+        warm_region_t *region = &s_warm_regions[n];
+        while (region->pos < region->size) {
+            if (cpu_hal_get_cycle_count() - start_cycles >= budget_cycles) {
+                return true;    //budget exhausted, resume here next pass
+            }
+            (void) region->start[region->pos];
+            region->pos += CACHE_WARM_LINE_SIZE;
+        }
+    }
+    //Every region walked: rewind for the next trigger and go quiescent
+    for (int n = 0; n < s_warm_region_count; n++) {
+        s_warm_regions[n].pos = 0;
+    }
+    s_warm_pass_pending = false;
+    return false;
+}
+
+esp_err_t esp_idle_work_cache_warm_region(const void *start, size_t size)
+{
+    if (start == NULL || size == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&s_idle_work_lock);
+    if (s_warm_region_count == MAX_WARM_REGIONS) {
+        portEXIT_CRITICAL(&s_idle_work_lock);
+        return ESP_ERR_NO_MEM;
+    }
+    s_warm_regions[s_warm_region_count].start = (const volatile uint8_t *) start;
+    s_warm_regions[s_warm_region_count].size = size;
+    s_warm_regions[s_warm_region_count].pos = 0;
+    s_warm_region_count++;
+    portEXIT_CRITICAL(&s_idle_work_lock);
+    s_warm_pass_pending = true;
+    return ESP_OK;
+}
+
+void esp_idle_work_cache_warm_trigger(void)
+{
+    s_warm_pass_pending = true;
+}
+
+#endif // CONFIG_ESP_IDLE_WORK_CACHE_WARM
+
+#if defined(CONFIG_ESP_IDLE_WORK_HEAP_CHECK) || defined(CONFIG_ESP_IDLE_WORK_CACHE_WARM)
+
+/*
+ * The built-in jobs only touch static tables until the idle tasks run, so
+ * they can be registered from a constructor. Cache warming runs first (it
+ * is latency motivated), the heap check last. Both run on core 0; the
+ * flash cache and the heaps are shared between the cores.
+ */
+static void esp_idle_work_init(void) __attribute__((constructor));
+
+static void esp_idle_work_init(void)
+{
+#ifdef CONFIG_ESP_IDLE_WORK_CACHE_WARM
+    //~50k cycles per pass: a few hundred microseconds of touching per idle pass
+    ESP_ERROR_CHECK(esp_idle_work_register(0, idle_cache_warm_job, NULL, 10, 50000));
+#endif
+#ifdef CONFIG_ESP_IDLE_WORK_HEAP_CHECK
+    ESP_ERROR_CHECK(esp_idle_work_register(0, idle_heap_check_job, NULL, 100, 0));
+#endif
+}
+
+#endif
@@ -0,0 +1,68 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "esp_startup_time.h"
+#include "esp_log.h"
+#include "hal/cpu_hal.h"
+#include "sdkconfig.h"
+
+#if CONFIG_IDF_TARGET_ESP32
+#include "esp32/clk.h"
+#elif CONFIG_IDF_TARGET_ESP32S2
+#include "esp32s2/clk.h"
+#elif CONFIG_IDF_TARGET_ESP32S3
+#include "esp32s3/clk.h"
+#endif
+
+#define STARTUP_TIME_MAX_STAGES 16
+
+static const char *TAG = "startup_time";
+
+static esp_startup_time_entry_t s_stages[STARTUP_TIME_MAX_STAGES];
+static size_t s_stage_count;
+
+void esp_startup_time_mark(const char *stage)
+{
+    /* Marks during startup run single-threaded on the main core before the
+     * scheduler is up, so no locking is needed; late marks from component
+     * init tasks only race on s_stage_count, which at worst drops an entry. */
+    size_t idx = s_stage_count;
+    if (idx >= STARTUP_TIME_MAX_STAGES) {
+        return;
+    }
+    s_stages[idx].stage = stage;
+    s_stages[idx].ccount = cpu_hal_get_cycle_count();
+    s_stage_count = idx + 1;
+}
+
+size_t esp_startup_time_get(const esp_startup_time_entry_t **entries)
+{
+    if (entries != NULL) {
+        *entries = s_stages;
+    }
+    return s_stage_count;
+}
+
+void esp_startup_time_dump(void)
+{
+    uint32_t cycles_per_us = esp_clk_cpu_freq() / 1000000;
+    uint32_t prev = 0;
+    ESP_LOGI(TAG, "%-16s %10s %10s", "stage", "delta(us)", "total(us)");
+    for (size_t i = 0; i < s_stage_count; i++) {
+        uint32_t total_us = s_stages[i].ccount / cycles_per_us;
+        uint32_t delta_us = (s_stages[i].ccount - prev) / cycles_per_us;
+        ESP_LOGI(TAG, "%-16s %10u %10u", s_stages[i].stage, delta_us, total_us);
+        prev = s_stages[i].ccount;
+    }
+}
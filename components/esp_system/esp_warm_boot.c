@@ -0,0 +1,196 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+
+#include "sdkconfig.h"
+
+#ifdef CONFIG_ESP_SYSTEM_WARM_BOOT_STATE
+
+#include "esp_warm_boot.h"
+#include "esp_private/esp_warm_boot_internal.h"
+#include "esp_attr.h"
+#include "esp_system.h"
+#include "esp_log.h"
+#include "esp_rom_crc.h"
+#include "freertos/FreeRTOS.h"
+
+static const char *TAG = "warm_boot";
+
+#define WARM_BOOT_POOL_MAGIC   0x574D4254  /* "WMBT" */
+#define WARM_BOOT_MAX_OWNERS   8
+
+typedef struct {
+    uint32_t magic;     /* WARM_BOOT_POOL_MAGIC once sealed */
+    uint32_t used;      /* bytes of block records following the header */
+    uint32_t crc;       /* CRC32 over the used bytes of data[] */
+} warm_boot_pool_header_t;
+
+typedef struct {
+    uint32_t owner;
+    uint32_t size;      /* payload bytes, record is padded to 4-byte alignment */
+    uint32_t crc;       /* CRC32 over the payload */
+} warm_boot_block_header_t;
+
+typedef struct {
+    warm_boot_pool_header_t hdr;
+    uint8_t data[CONFIG_ESP_SYSTEM_WARM_BOOT_POOL_SIZE];
+} warm_boot_pool_t;
+
+/* Survives deep sleep (RTC slow memory is kept powered); contents are garbage
+ * after a power-on reset, which the magic + CRC seal detects. */
+static RTC_NOINIT_ATTR warm_boot_pool_t s_warm_boot_pool;
+
+typedef struct {
+    uint32_t owner;
+    const void *data;
+    size_t size;
+} warm_boot_registrant_t;
+
+static warm_boot_registrant_t s_registrants[WARM_BOOT_MAX_OWNERS];
+static size_t s_registered_bytes; /* block records incl. headers and padding */
+static portMUX_TYPE s_warm_boot_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/* Result of validating the pool seal, computed once per boot */
+static bool s_pool_checked;
+static bool s_pool_ok;
+
+static inline size_t record_size(size_t payload)
+{
+    return sizeof(warm_boot_block_header_t) + ((payload + 3) & ~(size_t)3);
+}
+
+esp_err_t esp_warm_boot_register(uint32_t owner, const void *data, size_t size)
+{
+    if (data == NULL || size == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err = ESP_ERR_NO_MEM;
+    portENTER_CRITICAL(&s_warm_boot_lock);
+    int free_slot = -1;
+    for (int i = 0; i < WARM_BOOT_MAX_OWNERS; i++) {
+        if (s_registrants[i].data == NULL) {
+            if (free_slot < 0) {
+                free_slot = i;
+            }
+        } else if (s_registrants[i].owner == owner) {
+            free_slot = -1;
+            err = ESP_ERR_INVALID_STATE;
+            break;
+        }
+    }
+    if (free_slot >= 0) {
+        if (s_registered_bytes + record_size(size) <= sizeof(s_warm_boot_pool.data)) {
+            s_registrants[free_slot].owner = owner;
+            s_registrants[free_slot].data = data;
+            s_registrants[free_slot].size = size;
+            s_registered_bytes += record_size(size);
+            err = ESP_OK;
+        }
+    }
+    portEXIT_CRITICAL(&s_warm_boot_lock);
+    if (err == ESP_ERR_NO_MEM) {
+        ESP_LOGW(TAG, "cannot register owner 0x%08x (%u bytes): pool full", owner, (unsigned) size);
+    }
+    return err;
+}
+
+esp_err_t esp_warm_boot_unregister(uint32_t owner)
+{
+    esp_err_t err = ESP_ERR_NOT_FOUND;
+    portENTER_CRITICAL(&s_warm_boot_lock);
+    for (int i = 0; i < WARM_BOOT_MAX_OWNERS; i++) {
+        if (s_registrants[i].data != NULL && s_registrants[i].owner == owner) {
+            s_registered_bytes -= record_size(s_registrants[i].size);
+            s_registrants[i].data = NULL;
+            err = ESP_OK;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_warm_boot_lock);
+    return err;
+}
+
+void esp_warm_boot_save(void)
+{
+    /* Invalidate the seal first so a reset mid-copy leaves a pool which
+     * fails validation rather than one mixing old and new records. */
+    s_warm_boot_pool.hdr.magic = 0;
+    size_t used = 0;
+    portENTER_CRITICAL(&s_warm_boot_lock);
+    for (int i = 0; i < WARM_BOOT_MAX_OWNERS; i++) {
+        if (s_registrants[i].data == NULL) {
+            continue;
+        }
+        warm_boot_block_header_t bh = {
+            .owner = s_registrants[i].owner,
+            .size = s_registrants[i].size,
+            .crc = esp_rom_crc32_le(0, s_registrants[i].data, s_registrants[i].size),
+        };
+        memcpy(&s_warm_boot_pool.data[used], &bh, sizeof(bh));
+        memcpy(&s_warm_boot_pool.data[used + sizeof(bh)], s_registrants[i].data, bh.size);
+        used += record_size(bh.size);
+    }
+    portEXIT_CRITICAL(&s_warm_boot_lock);
+    s_warm_boot_pool.hdr.used = used;
+    s_warm_boot_pool.hdr.crc = esp_rom_crc32_le(0, s_warm_boot_pool.data, used);
+    s_warm_boot_pool.hdr.magic = WARM_BOOT_POOL_MAGIC;
+}
+
+bool esp_warm_boot_pool_valid(void)
+{
+    if (!s_pool_checked) {
+        s_pool_ok = (esp_reset_reason() == ESP_RST_DEEPSLEEP)
+                    && s_warm_boot_pool.hdr.magic == WARM_BOOT_POOL_MAGIC
+                    && s_warm_boot_pool.hdr.used <= sizeof(s_warm_boot_pool.data)
+                    && s_warm_boot_pool.hdr.crc == esp_rom_crc32_le(0, s_warm_boot_pool.data,
+                                                                    s_warm_boot_pool.hdr.used);
+        s_pool_checked = true;
+        if (!s_pool_ok) {
+            ESP_LOGD(TAG, "no preserved state (reset reason %d)", esp_reset_reason());
+        }
+    }
+    return s_pool_ok;
+}
+
+esp_err_t esp_warm_boot_restore(uint32_t owner, void *out, size_t size)
+{
+    if (out == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!esp_warm_boot_pool_valid()) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    size_t offs = 0;
+    while (offs + sizeof(warm_boot_block_header_t) <= s_warm_boot_pool.hdr.used) {
+        warm_boot_block_header_t bh;
+        memcpy(&bh, &s_warm_boot_pool.data[offs], sizeof(bh));
+        const uint8_t *payload = &s_warm_boot_pool.data[offs + sizeof(bh)];
+        if (bh.owner == owner) {
+            if (bh.size != size) {
+                return ESP_ERR_INVALID_SIZE;
+            }
+            if (esp_rom_crc32_le(0, payload, bh.size) != bh.crc) {
+                ESP_LOGW(TAG, "owner 0x%08x: payload CRC mismatch", owner);
+                return ESP_ERR_INVALID_STATE;
+            }
+            memcpy(out, payload, size);
+            return ESP_OK;
+        }
+        offs += record_size(bh.size);
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+#endif // CONFIG_ESP_SYSTEM_WARM_BOOT_STATE
@@ -0,0 +1,125 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file esp_idle_work.h
+ * @brief Prioritized idle-time work registry
+ *
+ * The FreeRTOS idle hook is a single flat callback list, so components with
+ * background chores (integrity checks, cache warming, housekeeping) end up
+ * competing for it without any ordering or time bounds. This service owns one
+ * idle hook per core and runs registered jobs in priority order, handing each
+ * job its configured CPU cycle budget per idle pass. Jobs run only in the
+ * idle task, so they consume time no ready task wanted; a job reporting
+ * pending work keeps the core out of the low power wait so it is called
+ * again on the next pass.
+ *
+ * Jobs are cooperative: a job should do at most roughly budget_cycles worth
+ * of work per invocation and keep its own resume state.
+ */
+
+/**
+ * @brief Idle job callback
+ *
+ * Called from the idle task of the core the job is registered on.
+ *
+ * @param arg            Argument given at registration
+ * @param budget_cycles  CPU cycle budget for this invocation
+ * @return true if the job has more work pending, false if it is caught up
+ */
+typedef bool (*esp_idle_work_fn_t)(void *arg, uint32_t budget_cycles);
+
+/**
+ * @brief Register an idle job on one core
+ *
+ * Jobs run in ascending priority value order within each idle pass. The same
+ * function may be registered on both cores (or twice with different
+ * arguments); registration order breaks priority ties.
+ *
+ * @param cpu_id         Core whose idle task runs the job (0 or 1)
+ * @param fn             Job callback
+ * @param arg            Argument passed through to the callback
+ * @param priority       Run order within an idle pass, lower runs first
+ * @param budget_cycles  CPU cycle budget handed to the job per invocation
+ *
+ * @return
+ *      - ESP_OK: job registered
+ *      - ESP_ERR_INVALID_ARG: cpu_id is invalid or fn is NULL
+ *      - ESP_ERR_NO_MEM: job table of the core is full
+ */
+esp_err_t esp_idle_work_register(uint32_t cpu_id, esp_idle_work_fn_t fn, void *arg,
+                                 uint32_t priority, uint32_t budget_cycles);
+
+/**
+ * @brief Unregister an idle job
+ *
+ * @param cpu_id  Core the job was registered on
+ * @param fn      Job callback given at registration
+ * @param arg     Argument given at registration
+ *
+ * @return
+ *      - ESP_OK: job removed
+ *      - ESP_ERR_INVALID_ARG: cpu_id is invalid
+ *      - ESP_ERR_NOT_FOUND: no such job is registered
+ */
+esp_err_t esp_idle_work_unregister(uint32_t cpu_id, esp_idle_work_fn_t fn, void *arg);
+
+#ifdef CONFIG_ESP_IDLE_WORK_CACHE_WARM
+
+/**
+ * @brief Register a hot region for idle-time cache warming
+ *
+ * The built-in cache warming job touches one cache line of registered
+ * regions at a time from the idle task, bounded by its cycle budget, until
+ * every region has been walked once. Use it on flash-resident data (lookup
+ * tables, state machines of a latency critical path) so the first foreground
+ * access after an idle period does not pay the cache miss chain.
+ *
+ * @param start  Start of the region
+ * @param size   Size of the region in bytes
+ *
+ * @return
+ *      - ESP_OK: region registered
+ *      - ESP_ERR_INVALID_ARG: start is NULL or size is 0
+ *      - ESP_ERR_NO_MEM: region table is full
+ */
+esp_err_t esp_idle_work_cache_warm_region(const void *start, size_t size);
+
+/**
+ * @brief Schedule one warming pass over all registered regions
+ *
+ * Call this shortly before a wake-heavy period (an expected burst of
+ * requests, an alarm about to fire) so the hot regions are resident when the
+ * burst starts. The pass runs piecewise in idle time; registering a region
+ * also schedules a pass.
+ */
+void esp_idle_work_cache_warm_trigger(void);
+
+#endif // CONFIG_ESP_IDLE_WORK_CACHE_WARM
+
+#ifdef __cplusplus
+}
+#endif
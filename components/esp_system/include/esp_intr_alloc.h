@@ -17,7 +17,9 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdio.h>
 #include "esp_err.h"
+#include "sdkconfig.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -306,6 +308,46 @@ void esp_intr_enable_source(int inum);
  */
 void esp_intr_disable_source(int inum);
 
+#if CONFIG_ESP_INTR_CYCLE_STATS
+/**
+ * @brief CPU time spent in interrupt handlers on one core
+ *
+ * Measured with the CPU cycle counter around each handler dispatched through
+ * esp_intr_alloc, i.e. the same clock the run time stats use, so the cycles
+ * reported here can be subtracted from the run time which
+ * vTaskGetRunTimeStats attributes to the interrupted tasks. Time spent in a
+ * nested (higher level) interrupt is attributed to both handlers. High level
+ * (4 and up) interrupts are not C-callable and are not counted.
+ */
+typedef struct {
+    uint64_t isr_cycles;    ///< total CPU cycles spent in interrupt handlers on this core
+    uint32_t isr_count;     ///< number of handler invocations counted
+} esp_cpu_usage_t;
+
+/**
+ * @brief Get the accumulated interrupt handler CPU usage of one core
+ *
+ * @param cpu core to query (0 to SOC_CPU_CORES_NUM - 1)
+ * @param[out] out_usage snapshot of the counters for that core. Must not be NULL.
+ * @return ESP_ERR_INVALID_ARG if cpu is out of range or out_usage is NULL.
+ *         ESP_OK otherwise
+ */
+esp_err_t esp_cpu_usage_get(int cpu, esp_cpu_usage_t *out_usage);
+
+/**
+ * @brief Dump per-source interrupt cycle statistics to a stream
+ *
+ * Prints one line per interrupt source which has run at least once (number of
+ * invocations and total cycles, summed over both cores), followed by the
+ * per-core totals. Internal sources are printed with their negative numbers.
+ *
+ * @param stream stream to print information to; use stdout or stderr to print
+ *               to the console
+ * @return ESP_ERR_INVALID_ARG if stream is NULL. ESP_OK otherwise
+ */
+esp_err_t esp_intr_dump_cycle_stats(FILE *stream);
+#endif //CONFIG_ESP_INTR_CYCLE_STATS
+
 /**@}*/
 
 
@@ -283,6 +283,92 @@ void esp_deep_sleep_start(void) __attribute__((noreturn));
  */
 esp_err_t esp_light_sleep_start(void);
 
+/**
+ * @brief Stages of sleep entry, for the per stage timing counters
+ */
+typedef enum {
+    ESP_SLEEP_STAGE_QUIESCE = 0,    //!< Quiesce callbacks run by esp_sleep_prepare
+    ESP_SLEEP_STAGE_UART_IDLE,      //!< Waiting for the UARTs to drain or suspend
+    ESP_SLEEP_STAGE_WAKEUP_PREPARE, //!< Wakeup source (pin, timer, touch, ULP) configuration
+    ESP_SLEEP_STAGE_RTC_INIT,       //!< RTC sleep register initialization
+    ESP_SLEEP_STAGE_MAX             //!< Number of stages, not a valid stage
+} esp_sleep_stage_t;
+
+/**
+ * @brief Callback quiescing one component ahead of sleep (see esp_sleep_prepare)
+ *
+ * @param arg  argument given at registration
+ * @return ESP_OK if the component is ready for sleep, an error code otherwise
+ */
+typedef esp_err_t (*esp_sleep_quiesce_cb_t)(void *arg);
+
+/**
+ * @brief Register a callback to be run by esp_sleep_prepare()
+ *
+ * Components that need time to become quiescent before sleep (flushing
+ * buffers, parking an SPI device, draining a DMA queue) register a callback
+ * here instead of doing that work inside the sleep entry path.
+ *
+ * @param cb   callback to register
+ * @param arg  argument passed to the callback
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if cb is NULL
+ *      - ESP_ERR_NO_MEM if the callback table is full
+ */
+esp_err_t esp_sleep_register_quiesce_callback(esp_sleep_quiesce_cb_t cb, void *arg);
+
+/**
+ * @brief Unregister a callback registered with esp_sleep_register_quiesce_callback()
+ *
+ * @param cb   callback to remove
+ * @param arg  argument it was registered with
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_STATE if the callback was not registered
+ */
+esp_err_t esp_sleep_unregister_quiesce_callback(esp_sleep_quiesce_cb_t cb, void *arg);
+
+/**
+ * @brief Run the registered quiesce callbacks ahead of the final sleep decision
+ *
+ * Calling this early moves the per component quiesce work out of
+ * esp_deep_sleep_start()/esp_light_sleep_start() and overlaps it with other
+ * shutdown activity. The typical duty cycled flow kicks off the Wi-Fi
+ * disconnect first, quiesces everything else while the RF shutdown is in
+ * flight, and only then takes the final decision:
+ *
+ *     esp_wifi_disconnect();            // RF teardown starts
+ *     esp_sleep_prepare();              // quiesce the rest meanwhile
+ *     ... wait for WIFI_EVENT_STA_DISCONNECTED ...
+ *     esp_deep_sleep_start();
+ *
+ * The time spent is accounted to ESP_SLEEP_STAGE_QUIESCE. Sleep can still be
+ * skipped after calling this; the callbacks must leave their component
+ * usable.
+ *
+ * @return ESP_OK if every callback returned ESP_OK, otherwise the first
+ *         error returned by a callback (the remaining callbacks still run)
+ */
+esp_err_t esp_sleep_prepare(void);
+
+/**
+ * @brief Get the cumulative time spent in one stage of sleep entry
+ *
+ * The counters accumulate over all esp_sleep_prepare()/sleep entry calls
+ * since startup or the last esp_sleep_reset_stage_times(), so dividing by
+ * the number of sleep cycles gives the average per stage cost.
+ *
+ * @param stage  stage to query
+ * @return cumulative stage time in microseconds, 0 for an invalid stage
+ */
+uint64_t esp_sleep_get_stage_time_us(esp_sleep_stage_t stage);
+
+/**
+ * @brief Reset the per stage timing counters
+ */
+void esp_sleep_reset_stage_times(void);
+
 /**
  * @brief Enter deep-sleep mode
  *
@@ -0,0 +1,75 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file esp_startup_time.h
+ * @brief Startup phase timing records
+ *
+ * The system startup code records a CPU cycle count timestamp at each named
+ * init stage (heap, stdio, flash, constructors, component init, app start)
+ * into a small static table. The table is always recorded, without any
+ * configuration, so every build's boot breakdown can be inspected on-device
+ * with esp_startup_time_dump() or retrieved with esp_startup_time_get() and
+ * forwarded by the application (e.g. as an event or over the network).
+ *
+ * Components doing expensive initialization of their own (e.g. Wi-Fi, file
+ * systems) may add their stages by calling esp_startup_time_mark() from
+ * their init paths.
+ */
+
+/**
+ * @brief One recorded startup stage
+ */
+typedef struct {
+    const char *stage;  /*!< Stage name, a string literal */
+    uint32_t ccount;    /*!< CPU cycle counter value when the stage completed */
+} esp_startup_time_entry_t;
+
+/**
+ * @brief Record a timestamp for a named startup stage
+ *
+ * The name must be a string literal or otherwise outlive the table; it is
+ * stored by pointer. Recording is dropped silently once the table is full.
+ *
+ * @param stage  Name of the stage which just completed
+ */
+void esp_startup_time_mark(const char *stage);
+
+/**
+ * @brief Get the recorded startup stage table
+ *
+ * @param[out] entries  Set to the first entry of the table
+ * @return Number of recorded entries
+ */
+size_t esp_startup_time_get(const esp_startup_time_entry_t **entries);
+
+/**
+ * @brief Log the recorded startup stages with per-stage and cumulative times
+ *
+ * Cycle counts are converted to microseconds using the current CPU frequency.
+ */
+void esp_startup_time_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
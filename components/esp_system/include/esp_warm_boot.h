@@ -0,0 +1,106 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file esp_warm_boot.h
+ * @brief Preservation of small component state across deep sleep
+ *
+ * Components can register a block of RAM they would like preserved across
+ * deep sleep. Immediately before the chip enters deep sleep, every registered
+ * block is copied into a pool in RTC slow memory together with a per-block
+ * CRC32 and an overall seal. After wake-up (esp_reset_reason() returns
+ * ESP_RST_DEEPSLEEP), a component calls esp_warm_boot_restore() during its
+ * re-initialization: on success it can skip rebuilding that state from
+ * scratch, on failure (power-on reset, corrupted pool, changed size) it
+ * falls back to the normal cold-boot path.
+ *
+ * The pool size is configured with CONFIG_ESP_SYSTEM_WARM_BOOT_POOL_SIZE and
+ * is carved out of the RTC slow memory noinit section; the whole feature is
+ * gated on CONFIG_ESP_SYSTEM_WARM_BOOT_STATE.
+ *
+ * Blocks are identified by a 32-bit owner tag, conventionally four ASCII
+ * characters (e.g. 0x5346564e "NVFS"). Restored data is exactly the bytes
+ * the owner registered before the last deep sleep; versioning of the content
+ * is the owner's responsibility (e.g. first struct field holding a version).
+ */
+
+/**
+ * @brief Register a RAM block to be preserved across deep sleep
+ *
+ * The block is copied into RTC memory right before deep sleep entry, each
+ * time the chip enters deep sleep. The memory must remain valid until
+ * esp_warm_boot_unregister() is called.
+ *
+ * @param owner  Identification tag, unique per registrant
+ * @param data   Pointer to the state to preserve
+ * @param size   Size of the state in bytes
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if data is NULL or size is 0
+ *      - ESP_ERR_INVALID_STATE if the owner tag is already registered
+ *      - ESP_ERR_NO_MEM if the pool cannot hold all registered blocks
+ */
+esp_err_t esp_warm_boot_register(uint32_t owner, const void *data, size_t size);
+
+/**
+ * @brief Remove a previously registered block
+ *
+ * @param owner  Tag passed to esp_warm_boot_register()
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if the tag is not registered
+ */
+esp_err_t esp_warm_boot_unregister(uint32_t owner);
+
+/**
+ * @brief Copy a block preserved before the last deep sleep back out
+ *
+ * Only succeeds if the current boot is a deep sleep wake-up, the pool seal
+ * and the per-block CRC are intact, and the stored size matches the given
+ * size exactly.
+ *
+ * @param owner  Tag the block was registered with before the deep sleep
+ * @param out    Buffer to copy the preserved state into
+ * @param size   Expected size of the state in bytes
+ *
+ * @return
+ *      - ESP_OK if the state was restored
+ *      - ESP_ERR_INVALID_ARG if out is NULL
+ *      - ESP_ERR_INVALID_STATE if this boot is not a deep sleep wake-up
+ *        or the pool is not intact
+ *      - ESP_ERR_NOT_FOUND if no block with this tag was preserved
+ *      - ESP_ERR_INVALID_SIZE if the preserved block has a different size
+ */
+esp_err_t esp_warm_boot_restore(uint32_t owner, void *out, size_t size);
+
+/**
+ * @brief Check whether preserved state from before the last deep sleep is available
+ *
+ * @return true if this boot is a deep sleep wake-up and the RTC pool seal is intact
+ */
+bool esp_warm_boot_pool_valid(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -29,6 +29,8 @@
 #include "esp_attr.h"
 #include "hal/cpu_hal.h"
 #include "hal/interrupt_controller_hal.h"
+#include "soc/soc.h"
+#include "soc/periph_defs.h"
 
 #if !CONFIG_FREERTOS_UNICORE
 #include "esp_ipc.h"
@@ -112,6 +114,73 @@ extern uint32_t port_switch_flag[];
 
 static portMUX_TYPE spinlock = portMUX_INITIALIZER_UNLOCKED;
 
+#if CONFIG_ESP_INTR_CYCLE_STATS
+//Number of entries in the per-source tables. Internal (negative) sources are
+//mapped to [0, ETS_INTERNAL_INTR_SOURCE_OFF), peripheral sources follow.
+#define INTR_SOURCE_COUNT (ETS_INTERNAL_INTR_SOURCE_OFF + ETS_MAX_INTR_SOURCE)
+
+//Cycles spent in and invocations of handlers for each source, summed over both cores.
+static uint64_t intr_source_cycles[INTR_SOURCE_COUNT];
+static uint32_t intr_source_runs[INTR_SOURCE_COUNT];
+//Per-core totals, returned by esp_cpu_usage_get.
+static esp_cpu_usage_t intr_cpu_usage[SOC_CPU_CORES_NUM];
+
+//Credit 'cycles' cycles of handler time to 'source' and to the current core.
+//Runs in interrupt context. Taking 'spinlock' here may nest inside the
+//critical section of shared_intr_isr; portmux critical sections nest on the
+//same core, so that is fine.
+static void IRAM_ATTR intr_cycle_stats_add(int source, uint32_t cycles)
+{
+    int idx = source + ETS_INTERNAL_INTR_SOURCE_OFF;
+    portENTER_CRITICAL_ISR(&spinlock);
+    if (idx >= 0 && idx < INTR_SOURCE_COUNT) {
+        intr_source_cycles[idx] += cycles;
+        intr_source_runs[idx]++;
+    }
+    esp_cpu_usage_t *usage = &intr_cpu_usage[cpu_hal_get_core_id()];
+    usage->isr_cycles += cycles;
+    usage->isr_count++;
+    portEXIT_CRITICAL_ISR(&spinlock);
+}
+
+esp_err_t esp_cpu_usage_get(int cpu, esp_cpu_usage_t *out_usage)
+{
+    if (cpu < 0 || cpu >= SOC_CPU_CORES_NUM || out_usage == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&spinlock);
+    *out_usage = intr_cpu_usage[cpu];
+    portEXIT_CRITICAL(&spinlock);
+    return ESP_OK;
+}
+
+esp_err_t esp_intr_dump_cycle_stats(FILE *stream)
+{
+    if (stream == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    fprintf(stream, "Interrupt cycle stats:\n");
+    for (int idx = 0; idx < INTR_SOURCE_COUNT; idx++) {
+        portENTER_CRITICAL(&spinlock);
+        uint64_t cycles = intr_source_cycles[idx];
+        uint32_t runs = intr_source_runs[idx];
+        portEXIT_CRITICAL(&spinlock);
+        if (runs > 0) {
+            fprintf(stream, "source %3d  %9u runs  %12llu cycles\n",
+                    idx - ETS_INTERNAL_INTR_SOURCE_OFF, runs, cycles);
+        }
+    }
+    for (int cpu = 0; cpu < SOC_CPU_CORES_NUM; cpu++) {
+        portENTER_CRITICAL(&spinlock);
+        esp_cpu_usage_t usage = intr_cpu_usage[cpu];
+        portEXIT_CRITICAL(&spinlock);
+        fprintf(stream, "cpu %d total %9u runs  %12llu cycles\n",
+                cpu, usage.isr_count, usage.isr_cycles);
+    }
+    return ESP_OK;
+}
+#endif //CONFIG_ESP_INTR_CYCLE_STATS
+
 //Inserts an item into vector_desc list so that the list is sorted
 //with an incrementing cpu.intno value.
 static void insert_vector_desc(vector_desc_t *to_insert)
@@ -412,8 +481,14 @@ static void IRAM_ATTR shared_intr_isr(void *arg)
             if ((sh_vec->statusreg == NULL) || (*sh_vec->statusreg & sh_vec->statusmask)) {
 #if CONFIG_SYSVIEW_ENABLE
                 traceISR_ENTER(sh_vec->source+ETS_INTERNAL_INTR_SOURCE_OFF);
+#endif
+#if CONFIG_ESP_INTR_CYCLE_STATS
+                uint32_t cycles_start=cpu_hal_get_cycle_count();
 #endif
                 sh_vec->isr(sh_vec->arg);
+#if CONFIG_ESP_INTR_CYCLE_STATS
+                intr_cycle_stats_add(sh_vec->source, cpu_hal_get_cycle_count()-cycles_start);
+#endif
 #if CONFIG_SYSVIEW_ENABLE
                 // check if we will return to scheduler or to interrupted task after ISR
                 if (!port_switch_flag[cpu_hal_get_core_id()]) {
@@ -427,21 +502,31 @@ static void IRAM_ATTR shared_intr_isr(void *arg)
     portEXIT_CRITICAL_ISR(&spinlock);
 }
 
-#if CONFIG_SYSVIEW_ENABLE
+#if CONFIG_SYSVIEW_ENABLE || CONFIG_ESP_INTR_CYCLE_STATS
 //Common non-shared isr handler wrapper.
 static void IRAM_ATTR non_shared_intr_isr(void *arg)
 {
     non_shared_isr_arg_t *ns_isr_arg=(non_shared_isr_arg_t*)arg;
+#if CONFIG_SYSVIEW_ENABLE
     portENTER_CRITICAL_ISR(&spinlock);
     traceISR_ENTER(ns_isr_arg->source+ETS_INTERNAL_INTR_SOURCE_OFF);
     // FIXME: can we call ISR and check port_switch_flag after releasing spinlock?
     // when CONFIG_SYSVIEW_ENABLE = 0 ISRs for non-shared IRQs are called without spinlock
+#endif
+#if CONFIG_ESP_INTR_CYCLE_STATS
+    uint32_t cycles_start=cpu_hal_get_cycle_count();
+#endif
     ns_isr_arg->isr(ns_isr_arg->isr_arg);
+#if CONFIG_ESP_INTR_CYCLE_STATS
+    intr_cycle_stats_add(ns_isr_arg->source, cpu_hal_get_cycle_count()-cycles_start);
+#endif
+#if CONFIG_SYSVIEW_ENABLE
     // check if we will return to scheduler or to interrupted task after ISR
     if (!port_switch_flag[cpu_hal_get_core_id()]) {
         traceISR_EXIT();
     }
     portEXIT_CRITICAL_ISR(&spinlock);
+#endif
 }
 #endif
 
@@ -536,7 +621,7 @@ esp_err_t esp_intr_alloc_intrstatus(int source, int flags, uint32_t intrstatusre
         //Mark as unusable for other interrupt sources. This is ours now!
         vd->flags=VECDESC_FL_NONSHARED;
         if (handler) {
-#if CONFIG_SYSVIEW_ENABLE
+#if CONFIG_SYSVIEW_ENABLE || CONFIG_ESP_INTR_CYCLE_STATS
             non_shared_isr_arg_t *ns_isr_arg=malloc(sizeof(non_shared_isr_arg_t));
             if (!ns_isr_arg) {
                 portEXIT_CRITICAL(&spinlock);
@@ -669,7 +754,7 @@ esp_err_t esp_intr_free(intr_handle_t handle)
 
     if ((handle->vector_desc->flags&VECDESC_FL_NONSHARED) || free_shared_vector) {
         ESP_EARLY_LOGV(TAG, "esp_intr_free: Disabling int, killing handler");
-#if CONFIG_SYSVIEW_ENABLE
+#if CONFIG_SYSVIEW_ENABLE || CONFIG_ESP_INTR_CYCLE_STATS
         if (!free_shared_vector) {
             void *isr_arg = interrupt_controller_hal_get_int_handler_arg(handle->vector_desc->intno);
             if (isr_arg) {
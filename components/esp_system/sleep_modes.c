@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <stddef.h>
+#include <string.h>
 #include <sys/lock.h>
 #include <sys/param.h>
 
@@ -20,6 +21,7 @@
 #include "esp_sleep.h"
 #include "esp_private/esp_timer_private.h"
 #include "esp_private/system_internal.h"
+#include "esp_private/esp_warm_boot_internal.h"
 #include "esp_log.h"
 #include "esp_newlib.h"
 #include "esp_timer.h"
@@ -139,6 +141,21 @@ static bool s_light_sleep_wakeup = false;
    is not thread-safe, so we need to disable interrupts before going to deep sleep. */
 static portMUX_TYPE spinlock_rtc_deep_sleep = portMUX_INITIALIZER_UNLOCKED;
 
+/* Quiesce callbacks run by esp_sleep_prepare(). A small static table is
+   enough, only a handful of components have pre-sleep chores. */
+#define SLEEP_QUIESCE_CB_NUM 8
+
+typedef struct {
+    esp_sleep_quiesce_cb_t cb;
+    void *arg;
+} sleep_quiesce_entry_t;
+
+static sleep_quiesce_entry_t s_quiesce_cbs[SLEEP_QUIESCE_CB_NUM];
+static portMUX_TYPE s_quiesce_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/* Cumulative time spent in each stage of sleep entry, see esp_sleep_stage_t */
+static uint64_t s_sleep_stage_time_us[ESP_SLEEP_STAGE_MAX];
+
 static const char* TAG = "sleep";
 
 static uint32_t get_power_down_flags(void);
@@ -196,6 +213,82 @@ void esp_deep_sleep(uint64_t time_in_us)
     esp_deep_sleep_start();
 }
 
+esp_err_t esp_sleep_register_quiesce_callback(esp_sleep_quiesce_cb_t cb, void *arg)
+{
+    if (cb == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err = ESP_ERR_NO_MEM;
+    portENTER_CRITICAL(&s_quiesce_lock);
+    for (int i = 0; i < SLEEP_QUIESCE_CB_NUM; i++) {
+        if (s_quiesce_cbs[i].cb == NULL) {
+            s_quiesce_cbs[i].cb = cb;
+            s_quiesce_cbs[i].arg = arg;
+            err = ESP_OK;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_quiesce_lock);
+    return err;
+}
+
+esp_err_t esp_sleep_unregister_quiesce_callback(esp_sleep_quiesce_cb_t cb, void *arg)
+{
+    esp_err_t err = ESP_ERR_INVALID_STATE;
+    portENTER_CRITICAL(&s_quiesce_lock);
+    for (int i = 0; i < SLEEP_QUIESCE_CB_NUM; i++) {
+        if (s_quiesce_cbs[i].cb == cb && s_quiesce_cbs[i].arg == arg) {
+            // Compact the table so the callback walk can stop at the first empty slot
+            for (int j = i; j < SLEEP_QUIESCE_CB_NUM - 1; j++) {
+                s_quiesce_cbs[j] = s_quiesce_cbs[j + 1];
+            }
+            s_quiesce_cbs[SLEEP_QUIESCE_CB_NUM - 1].cb = NULL;
+            s_quiesce_cbs[SLEEP_QUIESCE_CB_NUM - 1].arg = NULL;
+            err = ESP_OK;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_quiesce_lock);
+    return err;
+}
+
+esp_err_t esp_sleep_prepare(void)
+{
+    const int64_t start = esp_system_get_time();
+    esp_err_t err = ESP_OK;
+    for (int i = 0; i < SLEEP_QUIESCE_CB_NUM; i++) {
+        portENTER_CRITICAL(&s_quiesce_lock);
+        sleep_quiesce_entry_t entry = s_quiesce_cbs[i];
+        portEXIT_CRITICAL(&s_quiesce_lock);
+        if (entry.cb == NULL) {
+            break;
+        }
+        // Run outside of the critical section, quiescing may take a while
+        esp_err_t cb_err = entry.cb(entry.arg);
+        if (cb_err != ESP_OK) {
+            ESP_LOGW(TAG, "quiesce callback %p returned 0x%x", entry.cb, cb_err);
+            if (err == ESP_OK) {
+                err = cb_err;
+            }
+        }
+    }
+    s_sleep_stage_time_us[ESP_SLEEP_STAGE_QUIESCE] += esp_system_get_time() - start;
+    return err;
+}
+
+uint64_t esp_sleep_get_stage_time_us(esp_sleep_stage_t stage)
+{
+    if (stage < 0 || stage >= ESP_SLEEP_STAGE_MAX) {
+        return 0;
+    }
+    return s_sleep_stage_time_us[stage];
+}
+
+void esp_sleep_reset_stage_times(void)
+{
+    memset(s_sleep_stage_time_us, 0, sizeof(s_sleep_stage_time_us));
+}
+
 // [refactor-todo] provide target logic for body of uart functions below
 static void IRAM_ATTR flush_uarts(void)
 {
@@ -266,11 +359,13 @@ static uint32_t IRAM_ATTR esp_sleep_start(uint32_t pd_flags)
     assert(!deep_sleep || esp_get_deep_sleep_wake_stub() == NULL);
 #endif
 
+    int64_t stage_start = esp_system_get_time();
     if (deep_sleep) {
         flush_uarts();
     } else {
         suspend_uarts();
     }
+    s_sleep_stage_time_us[ESP_SLEEP_STAGE_UART_IDLE] += esp_system_get_time() - stage_start;
 
     // Save current frequency and switch to XTAL
     rtc_cpu_freq_config_t cpu_freq_config;
@@ -278,6 +373,7 @@ static uint32_t IRAM_ATTR esp_sleep_start(uint32_t pd_flags)
     rtc_clk_cpu_freq_set_xtal();
 
     // Configure pins for external wakeup
+    stage_start = esp_system_get_time();
     if (s_config.wakeup_triggers & RTC_EXT0_TRIG_EN) {
         ext0_wakeup_prepare();
     }
@@ -298,6 +394,8 @@ static uint32_t IRAM_ATTR esp_sleep_start(uint32_t pd_flags)
         touch_wakeup_prepare();
     }
 #endif
+    s_sleep_stage_time_us[ESP_SLEEP_STAGE_WAKEUP_PREPARE] += esp_system_get_time() - stage_start;
+
     uint32_t reject_triggers = 0;
     if ((pd_flags & RTC_SLEEP_PD_DIG) == 0 && (s_config.wakeup_triggers & RTC_GPIO_TRIG_EN)) {
         /* Light sleep, enable sleep reject for faster return from this function,
@@ -311,14 +409,21 @@ static uint32_t IRAM_ATTR esp_sleep_start(uint32_t pd_flags)
     }
 
     // Enter sleep
+    stage_start = esp_system_get_time();
     rtc_sleep_config_t config = RTC_SLEEP_CONFIG_DEFAULT(pd_flags);
     rtc_sleep_init(config);
+    s_sleep_stage_time_us[ESP_SLEEP_STAGE_RTC_INIT] += esp_system_get_time() - stage_start;
 
     // Configure timer wakeup
+    stage_start = esp_system_get_time();
     if ((s_config.wakeup_triggers & RTC_TIMER_TRIG_EN) &&
         s_config.sleep_duration > 0) {
         timer_wakeup_prepare();
     }
+    // Timer wakeup setup counts towards wakeup preparation. Note that no
+    // stage is timed after this point: once rtc_sleep_start() returns the
+    // flash chip may not be ready yet.
+    s_sleep_stage_time_us[ESP_SLEEP_STAGE_WAKEUP_PREPARE] += esp_system_get_time() - stage_start;
 
     uint32_t result;
     if (deep_sleep) {
@@ -364,6 +469,11 @@ inline static uint32_t IRAM_ATTR call_rtc_sleep_start(uint32_t reject_triggers)
 
 void IRAM_ATTR esp_deep_sleep_start(void)
 {
+#ifdef CONFIG_ESP_SYSTEM_WARM_BOOT_STATE
+    // Seal registered component state into RTC memory (flash is still
+    // accessible here, the cache is only disabled inside esp_sleep_start)
+    esp_warm_boot_save();
+#endif
     // record current RTC time
     s_config.rtc_ticks_at_sleep_start = rtc_time_get();
 
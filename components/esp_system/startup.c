@@ -74,6 +74,8 @@
 /***********************************************/
 
 #include "esp_private/startup_internal.h"
+#include "esp_startup_time.h"
+#include "hal/cpu_hal.h"
 
 // Ensure that system configuration matches the underlying number of cores.
 // This should enable us to avoid checking for both everytime.
@@ -141,9 +143,26 @@ static void do_global_ctors(void)
 #endif // CONFIG_COMPILER_CXX_EXCEPTIONS
 
     void (**p)(void);
+#if CONFIG_ESP_SYSTEM_STATIC_CTOR_STATS
+    const uint32_t cycles_per_us = esp_clk_cpu_freq() / 1000000;
+    const uint32_t threshold_cycles = CONFIG_ESP_SYSTEM_STATIC_CTOR_STATS_THRESHOLD * cycles_per_us;
+    uint32_t total_cycles = 0;
+    for (p = &__init_array_end - 1; p >= &__init_array_start; --p) {
+        const uint32_t start = cpu_hal_get_cycle_count();
+        (*p)();
+        const uint32_t cycles = cpu_hal_get_cycle_count() - start;
+        total_cycles += cycles;
+        if (cycles >= threshold_cycles) {
+            ESP_EARLY_LOGI(TAG, "static ctor %p took %u us", *p, cycles / cycles_per_us);
+        }
+    }
+    ESP_EARLY_LOGI(TAG, "%d static ctors took %u us total",
+                   &__init_array_end - &__init_array_start, total_cycles / cycles_per_us);
+#else
     for (p = &__init_array_end - 1; p >= &__init_array_start; --p) {
         (*p)();
     }
+#endif // CONFIG_ESP_SYSTEM_STATIC_CTOR_STATS
 }
 
 static void do_system_init_fn(void)
@@ -195,6 +214,7 @@ static void do_core_init(void)
        app CPU, and when that is not up yet, the memory will be inaccessible and heap_caps_init may
        fail initializing it properly. */
     heap_caps_init();
+    esp_startup_time_mark("heap");
     esp_setup_syscall_table();
     esp_newlib_time_init();
 
@@ -238,6 +258,8 @@ static void do_core_init(void)
     _REENT_SMALL_CHECK_INIT(_GLOBAL_REENT);
 #endif // defined(CONFIG_VFS_SUPPORT_IO) && !defined(CONFIG_ESP_CONSOLE_NONE)
 
+    esp_startup_time_mark("stdio");
+
 #ifdef CONFIG_SECURE_FLASH_ENC_ENABLED
     esp_flash_encryption_init_checks();
 #endif
@@ -281,6 +303,7 @@ static void do_core_init(void)
     esp_flash_app_init();
     esp_err_t flash_ret = esp_flash_init_default_chip();
     assert(flash_ret == ESP_OK);
+    esp_startup_time_mark("flash");
 }
 
 static void do_secondary_init(void)
@@ -344,10 +367,12 @@ static void start_cpu0_default(void)
 
     // Execute constructors.
     do_global_ctors();
+    esp_startup_time_mark("ctors");
 
     // Execute init functions of other components; blocks
     // until all cores finish (when !CONFIG_ESP_SYSTEM_SINGLE_CORE_MODE).
     do_secondary_init();
+    esp_startup_time_mark("component_init");
 
     // Now that the application is about to start, disable boot watchdog
 #ifndef CONFIG_BOOTLOADER_WDT_DISABLE_IN_USER_CODE
@@ -361,6 +386,7 @@ static void start_cpu0_default(void)
     s_system_full_inited = true;
 #endif
 
+    esp_startup_time_mark("app_start");
     esp_startup_start_app();
     while (1);
 }
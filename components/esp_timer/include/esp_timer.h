@@ -29,11 +29,12 @@
  * use RTOS notification mechanisms (queues, semaphores, event groups, etc.) to
  * pass information to other tasks.
  *
- * To be implemented: it should be possible to request the callback to be called
- * directly from the ISR. This reduces the latency, but has potential impact on
- * all other callbacks which need to be dispatched. This option should only be
- * used for simple callback functions, which do not take longer than a few
- * microseconds to run.
+ * If CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH is enabled, it is possible to
+ * request the callback to be called directly from the timer ISR by setting the
+ * dispatch_method to ESP_TIMER_ISR. This reduces the latency, but has
+ * potential impact on all other callbacks which need to be dispatched. This
+ * option should only be used for simple callback functions, which do not take
+ * longer than a few microseconds to run.
  *
  * Implementation note: on the ESP32, esp_timer APIs use the "legacy" FRC2
  * timer. Timer callbacks are called from a task running on the PRO CPU.
@@ -42,6 +43,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include "esp_err.h"
+#include "sdkconfig.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -64,13 +66,15 @@ typedef void (*esp_timer_cb_t)(void* arg);
  */
 typedef enum {
     ESP_TIMER_TASK,     //!< Callback is called from timer task
-
-    /* Not supported for now, provision to allow callbacks to run directly
-     * from an ISR:
-
-        ESP_TIMER_ISR,      //!< Callback is called from timer ISR
-
+#if CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH
+    /* Callback is called from the timer interrupt handler, skipping the
+     * notification of the timer task and the context switch to it. The
+     * callback must be short, must not call blocking (or any non-FromISR)
+     * FreeRTOS APIs, and, together with the data it touches, should be
+     * placed in IRAM/DRAM if it may run while flash cache is disabled.
      */
+    ESP_TIMER_ISR,      //!< Callback is called from timer ISR
+#endif
 } esp_timer_dispatch_t;
 
 /**
@@ -226,6 +230,41 @@ int64_t esp_timer_get_next_alarm(void);
  */
 esp_err_t esp_timer_dump(FILE* stream);
 
+#if CONFIG_ESP_TIMER_PROFILING
+/**
+ * @brief Number of buckets in the dispatch latency histogram kept per timer
+ */
+#define ESP_TIMER_DISPATCH_LATENCY_BUCKETS 16
+
+/**
+ * @brief Get the dispatch latency histogram of a timer
+ *
+ * Dispatch latency is the time between the moment a timer was programmed to
+ * fire and the moment the timer task started running its callback, so it
+ * includes both interrupt/notification delay and time spent waiting behind
+ * callbacks of other timers which expired at the same time.
+ *
+ * The histogram buckets are logarithmic: bucket 0 counts dispatches with
+ * latency below 2 microseconds, bucket i counts latencies in the range
+ * [2^i, 2^(i+1)) microseconds, and the last bucket additionally counts
+ * everything above its lower bound.
+ *
+ * Only available if CONFIG_ESP_TIMER_PROFILING is enabled.
+ *
+ * @param timer timer handle created using esp_timer_create
+ * @param histogram array to copy the bucket counters into
+ * @param num_buckets size of the histogram array; if it is larger than
+ *                    ESP_TIMER_DISPATCH_LATENCY_BUCKETS, the extra entries
+ *                    are set to zero
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if the handle or the output array is invalid
+ */
+esp_err_t esp_timer_get_dispatch_latency_histogram(esp_timer_handle_t timer,
+                                                   uint32_t* histogram,
+                                                   size_t num_buckets);
+#endif // CONFIG_ESP_TIMER_PROFILING
+
 #ifdef __cplusplus
 }
 #endif
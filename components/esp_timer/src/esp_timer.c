@@ -61,12 +61,21 @@ struct esp_timer {
         uint32_t event_id;
     };
     void* arg;
+#if CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH
+    esp_timer_dispatch_t dispatch_method;
+#endif
 #if WITH_PROFILING
     const char* name;
     size_t times_triggered;
     size_t times_armed;
     uint64_t total_callback_run_time;
+    uint32_t dispatch_latency[ESP_TIMER_DISPATCH_LATENCY_BUCKETS];
 #endif // WITH_PROFILING
+#if CONFIG_ESP_TIMER_PAIRING_HEAP
+    struct esp_timer* heap_child;       // first child in the pairing heap
+    struct esp_timer* heap_sibling;     // next sibling in the pairing heap
+    struct esp_timer* heap_prev;        // previous sibling, or the parent for the first child
+#endif
     LIST_ENTRY(esp_timer) list_entry;
 };
 
@@ -80,13 +89,30 @@ static void timer_list_unlock(void);
 #if WITH_PROFILING
 static void timer_insert_inactive(esp_timer_handle_t timer);
 static void timer_remove_inactive(esp_timer_handle_t timer);
+static void timer_count_dispatch_latency(esp_timer_handle_t timer, int64_t latency_us);
 #endif // WITH_PROFILING
 
 __attribute__((unused)) static const char* TAG = "esp_timer";
 
+#if CONFIG_ESP_TIMER_PAIRING_HEAP
+// root of the pairing heap of currently armed timers, NULL when no timer is armed
+static esp_timer_handle_t s_timer_heap;
+#if CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH
+// armed timers with ISR dispatch method, kept separately so that the alarm
+// interrupt can process them without touching the task-dispatched timers
+static esp_timer_handle_t s_timer_heap_isr;
+#endif
+#else
 // list of currently armed timers
 static LIST_HEAD(esp_timer_list, esp_timer) s_timers =
         LIST_HEAD_INITIALIZER(s_timers);
+#if CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH
+// armed timers with ISR dispatch method, kept separately so that the alarm
+// interrupt can process them without touching the task-dispatched timers
+static struct esp_timer_list s_timers_isr =
+        LIST_HEAD_INITIALIZER(s_timers_isr);
+#endif
+#endif
 #if WITH_PROFILING
 // list of unarmed timers, used only to be able to dump statistics about
 // all the timers
@@ -99,6 +125,183 @@ static TaskHandle_t s_timer_task;
 // lock protecting s_timers, s_inactive_timers
 static portMUX_TYPE s_timer_lock = portMUX_INITIALIZER_UNLOCKED;
 
+#if CONFIG_ESP_TIMER_PAIRING_HEAP
+
+/* Pairing heap of armed timers, ordered by alarm time. Melding in a new timer
+ * and detaching an arbitrary timer are O(1); extracting the earliest timer is
+ * O(log n) amortized. The links are embedded in struct esp_timer, so no
+ * allocation happens while the timer lock is held.
+ */
+
+static IRAM_ATTR esp_timer_handle_t timer_heap_meld(esp_timer_handle_t a, esp_timer_handle_t b)
+{
+    if (a == NULL) {
+        return b;
+    }
+    if (b == NULL) {
+        return a;
+    }
+    if (b->alarm < a->alarm) {
+        esp_timer_handle_t tmp = a;
+        a = b;
+        b = tmp;
+    }
+    // b becomes the first child of a
+    b->heap_prev = a;
+    b->heap_sibling = a->heap_child;
+    if (b->heap_sibling) {
+        b->heap_sibling->heap_prev = b;
+    }
+    a->heap_child = b;
+    a->heap_prev = NULL;
+    a->heap_sibling = NULL;
+    return a;
+}
+
+static IRAM_ATTR esp_timer_handle_t timer_heap_merge_pairs(esp_timer_handle_t first)
+{
+    /* Standard two-pass pairing: meld the siblings pairwise left to right,
+     * then meld the pair roots right to left. heap_prev is reused to stack
+     * the pair roots, so no recursion or extra memory is needed.
+     */
+    esp_timer_handle_t stack = NULL;
+    while (first != NULL) {
+        esp_timer_handle_t a = first;
+        esp_timer_handle_t b = a->heap_sibling;
+        first = (b != NULL) ? b->heap_sibling : NULL;
+        a->heap_prev = NULL;
+        a->heap_sibling = NULL;
+        if (b != NULL) {
+            b->heap_prev = NULL;
+            b->heap_sibling = NULL;
+            a = timer_heap_meld(a, b);
+        }
+        a->heap_prev = stack;
+        stack = a;
+    }
+    esp_timer_handle_t root = NULL;
+    while (stack != NULL) {
+        esp_timer_handle_t next = stack->heap_prev;
+        stack->heap_prev = NULL;
+        root = timer_heap_meld(root, stack);
+        stack = next;
+    }
+    return root;
+}
+
+static IRAM_ATTR void timer_heap_remove(esp_timer_handle_t* root, esp_timer_handle_t timer)
+{
+    esp_timer_handle_t children = timer->heap_child;
+    if (timer == *root) {
+        *root = timer_heap_merge_pairs(children);
+    } else {
+        if (timer->heap_prev->heap_child == timer) {
+            timer->heap_prev->heap_child = timer->heap_sibling;
+        } else {
+            timer->heap_prev->heap_sibling = timer->heap_sibling;
+        }
+        if (timer->heap_sibling) {
+            timer->heap_sibling->heap_prev = timer->heap_prev;
+        }
+        *root = timer_heap_meld(*root, timer_heap_merge_pairs(children));
+    }
+    timer->heap_child = NULL;
+    timer->heap_sibling = NULL;
+    timer->heap_prev = NULL;
+}
+
+static esp_timer_handle_t timer_heap_walk(esp_timer_handle_t node)
+{
+    /* Pre-order traversal of the heap using the embedded links, for
+     * esp_timer_dump. The order is not related to the alarm times.
+     */
+    if (node->heap_child != NULL) {
+        return node->heap_child;
+    }
+    while (node != NULL) {
+        if (node->heap_sibling != NULL) {
+            return node->heap_sibling;
+        }
+        // climb to the parent: walk left to the first child, whose heap_prev
+        // is the parent; the root has no parent and ends the traversal
+        while (node->heap_prev != NULL && node->heap_prev->heap_child != node) {
+            node = node->heap_prev;
+        }
+        node = node->heap_prev;
+    }
+    return NULL;
+}
+
+#endif // CONFIG_ESP_TIMER_PAIRING_HEAP
+
+#if CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH
+static IRAM_ATTR inline bool timer_is_isr_dispatch(esp_timer_handle_t timer)
+{
+    /* Timers pending deletion carry EVENT_ID_DELETE_TIMER in place of the
+     * callback and must always go to the task structure, since free() can not
+     * be called from the alarm interrupt.
+     */
+    return timer->dispatch_method == ESP_TIMER_ISR &&
+            timer->event_id != EVENT_ID_DELETE_TIMER;
+}
+#endif
+
+#if CONFIG_ESP_TIMER_PAIRING_HEAP
+static IRAM_ATTR inline esp_timer_handle_t* timer_heap_for(esp_timer_handle_t timer)
+{
+#if CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH
+    if (timer_is_isr_dispatch(timer)) {
+        return &s_timer_heap_isr;
+    }
+#endif
+    return &s_timer_heap;
+}
+#else
+static IRAM_ATTR inline struct esp_timer_list* timer_list_for(esp_timer_handle_t timer)
+{
+#if CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH
+    if (timer_is_isr_dispatch(timer)) {
+        return &s_timers_isr;
+    }
+#endif
+    return &s_timers;
+}
+#endif // CONFIG_ESP_TIMER_PAIRING_HEAP
+
+// earliest armed timer with the given dispatch method, NULL if none
+static IRAM_ATTR inline esp_timer_handle_t timer_dispatch_first(esp_timer_dispatch_t dispatch_method)
+{
+#if CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH
+    if (dispatch_method == ESP_TIMER_ISR) {
+#if CONFIG_ESP_TIMER_PAIRING_HEAP
+        return s_timer_heap_isr;
+#else
+        return LIST_FIRST(&s_timers_isr);
+#endif
+    }
+#else
+    (void) dispatch_method;
+#endif
+#if CONFIG_ESP_TIMER_PAIRING_HEAP
+    return s_timer_heap;
+#else
+    return LIST_FIRST(&s_timers);
+#endif
+}
+
+// earliest armed timer regardless of dispatch method, NULL if none
+static IRAM_ATTR inline esp_timer_handle_t timer_armed_first(void)
+{
+    esp_timer_handle_t first = timer_dispatch_first(ESP_TIMER_TASK);
+#if CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH
+    esp_timer_handle_t first_isr = timer_dispatch_first(ESP_TIMER_ISR);
+    if (first == NULL || (first_isr != NULL && first_isr->alarm < first->alarm)) {
+        first = first_isr;
+    }
+#endif
+    return first;
+}
+
 
 esp_err_t esp_timer_create(const esp_timer_create_args_t* args,
                            esp_timer_handle_t* out_handle)
@@ -115,6 +318,9 @@ esp_err_t esp_timer_create(const esp_timer_create_args_t* args,
     }
     result->callback = args->callback;
     result->arg = args->arg;
+#if CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH
+    result->dispatch_method = args->dispatch_method;
+#endif
 #if WITH_PROFILING
     result->name = args->name;
     timer_insert_inactive(result);
@@ -195,11 +401,19 @@ static IRAM_ATTR esp_err_t timer_insert(esp_timer_handle_t timer)
 #if WITH_PROFILING
     timer_remove_inactive(timer);
 #endif
+#if CONFIG_ESP_TIMER_PAIRING_HEAP
+    esp_timer_handle_t* root = timer_heap_for(timer);
+    *root = timer_heap_meld(*root, timer);
+    if (timer == *root) {
+        esp_timer_impl_set_alarm(timer_armed_first()->alarm);
+    }
+#else
+    struct esp_timer_list* list = timer_list_for(timer);
     esp_timer_handle_t it, last = NULL;
-    if (LIST_FIRST(&s_timers) == NULL) {
-        LIST_INSERT_HEAD(&s_timers, timer, list_entry);
+    if (LIST_FIRST(list) == NULL) {
+        LIST_INSERT_HEAD(list, timer, list_entry);
     } else {
-        LIST_FOREACH(it, &s_timers, list_entry) {
+        LIST_FOREACH(it, list, list_entry) {
             if (timer->alarm < it->alarm) {
                 LIST_INSERT_BEFORE(it, timer, list_entry);
                 break;
@@ -211,16 +425,21 @@ static IRAM_ATTR esp_err_t timer_insert(esp_timer_handle_t timer)
             LIST_INSERT_AFTER(last, timer, list_entry);
         }
     }
-    if (timer == LIST_FIRST(&s_timers)) {
-        esp_timer_impl_set_alarm(timer->alarm);
+    if (timer == LIST_FIRST(list)) {
+        esp_timer_impl_set_alarm(timer_armed_first()->alarm);
     }
+#endif // CONFIG_ESP_TIMER_PAIRING_HEAP
     return ESP_OK;
 }
 
 static IRAM_ATTR esp_err_t timer_remove(esp_timer_handle_t timer)
 {
     timer_list_lock();
+#if CONFIG_ESP_TIMER_PAIRING_HEAP
+    timer_heap_remove(timer_heap_for(timer), timer);
+#else
     LIST_REMOVE(timer, list_entry);
+#endif
     timer->alarm = 0;
     timer->period = 0;
 #if WITH_PROFILING
@@ -253,10 +472,31 @@ static IRAM_ATTR void timer_insert_inactive(esp_timer_handle_t timer)
 static IRAM_ATTR void timer_remove_inactive(esp_timer_handle_t timer)
 {
     timer_list_lock();
+#if CONFIG_ESP_TIMER_PAIRING_HEAP
+    /* With the pairing heap, list_entry is only linked while the timer is on
+     * the inactive list; re-arming from timer_process_alarm arrives here with
+     * the timer not on it, so check membership before unlinking.
+     */
+    if (timer->list_entry.le_prev != NULL) {
+        LIST_REMOVE(timer, list_entry);
+        timer->list_entry.le_prev = NULL;
+    }
+#else
     LIST_REMOVE(timer, list_entry);
+#endif
     timer_list_unlock();
 }
 
+static IRAM_ATTR void timer_count_dispatch_latency(esp_timer_handle_t timer, int64_t latency_us)
+{
+    size_t bucket = 0;
+    while (latency_us > 1 && bucket < ESP_TIMER_DISPATCH_LATENCY_BUCKETS - 1) {
+        latency_us >>= 1;
+        ++bucket;
+    }
+    timer->dispatch_latency[bucket]++;
+}
+
 #endif // WITH_PROFILING
 
 static IRAM_ATTR bool timer_armed(esp_timer_handle_t timer)
@@ -276,24 +516,28 @@ static IRAM_ATTR void timer_list_unlock(void)
 
 static void timer_process_alarm(esp_timer_dispatch_t dispatch_method)
 {
-    /* unused, provision to allow running callbacks from ISR */
-    (void) dispatch_method;
-
     timer_list_lock();
     int64_t now = esp_timer_impl_get_time();
-    esp_timer_handle_t it = LIST_FIRST(&s_timers);
+    esp_timer_handle_t it = timer_dispatch_first(dispatch_method);
     while (it != NULL &&
             it->alarm < now) {  // NOLINT(clang-analyzer-unix.Malloc)
             // Static analyser reports "Use of memory after it is freed" since the "it" variable
-            // is freed below (if EVENT_ID_DELETE_TIMER) and assigned to the (new) LIST_FIRST()
+            // is freed below (if EVENT_ID_DELETE_TIMER) and assigned to the (new) timer_dispatch_first()
             // so possibly (if the "it" hasn't been removed from the list) it might keep the same ptr.
             // Ignoring this warning, as this couldn't happen if queue.h used to populate the list
+#if CONFIG_ESP_TIMER_PAIRING_HEAP
+        timer_heap_remove(timer_heap_for(it), it);
+#else
         LIST_REMOVE(it, list_entry);
+#endif
         if (it->event_id == EVENT_ID_DELETE_TIMER) {
             free(it);
-            it = LIST_FIRST(&s_timers);
+            it = timer_dispatch_first(dispatch_method);
             continue;
         }
+#if WITH_PROFILING
+        timer_count_dispatch_latency(it, now - it->alarm);
+#endif
         if (it->period > 0) {
             it->alarm += it->period;
             timer_insert(it);
@@ -316,9 +560,9 @@ static void timer_process_alarm(esp_timer_dispatch_t dispatch_method)
         it->times_triggered++;
         it->total_callback_run_time += now - callback_start;
 #endif
-        it = LIST_FIRST(&s_timers);
+        it = timer_dispatch_first(dispatch_method);
     }
-    esp_timer_handle_t first = LIST_FIRST(&s_timers);
+    esp_timer_handle_t first = timer_armed_first();
     if (first) {
         esp_timer_impl_set_alarm(first->alarm);
     }
@@ -337,6 +581,13 @@ static void timer_task(void* arg)
 static void IRAM_ATTR timer_alarm_handler(void* arg)
 {
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+#if CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH
+    /* Timers with the ISR dispatch method run right here; task-dispatched
+     * timers are deferred to the timer task, as before. The task also
+     * reprograms the alarm if anything is still pending.
+     */
+    timer_process_alarm(ESP_TIMER_ISR);
+#endif
     vTaskNotifyGiveFromISR(s_timer_task, &xHigherPriorityTaskWoken);
     if (xHigherPriorityTaskWoken == pdTRUE) {
         portYIELD_FROM_ISR();
@@ -391,7 +642,7 @@ esp_err_t esp_timer_deinit(void)
     }
 
     /* Check if there are any active timers */
-    if (!LIST_EMPTY(&s_timers)) {
+    if (timer_armed_first() != NULL) {
         return ESP_ERR_INVALID_STATE;
     }
 
@@ -442,9 +693,25 @@ esp_err_t esp_timer_dump(FILE* stream)
     /* First count the number of timers */
     size_t timer_count = 0;
     timer_list_lock();
+#if CONFIG_ESP_TIMER_PAIRING_HEAP
+    for (it = s_timer_heap; it != NULL; it = timer_heap_walk(it)) {
+        ++timer_count;
+    }
+#if CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH
+    for (it = s_timer_heap_isr; it != NULL; it = timer_heap_walk(it)) {
+        ++timer_count;
+    }
+#endif
+#else
     LIST_FOREACH(it, &s_timers, list_entry) {
         ++timer_count;
     }
+#if CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH
+    LIST_FOREACH(it, &s_timers_isr, list_entry) {
+        ++timer_count;
+    }
+#endif
+#endif
 #if WITH_PROFILING
     LIST_FOREACH(it, &s_inactive_timers, list_entry) {
         ++timer_count;
@@ -466,9 +733,25 @@ esp_err_t esp_timer_dump(FILE* stream)
     /* Print to the buffer */
     timer_list_lock();
     char* pos = print_buf;
+#if CONFIG_ESP_TIMER_PAIRING_HEAP
+    for (it = s_timer_heap; it != NULL; it = timer_heap_walk(it)) {
+        print_timer_info(it, &pos, &buf_size);
+    }
+#if CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH
+    for (it = s_timer_heap_isr; it != NULL; it = timer_heap_walk(it)) {
+        print_timer_info(it, &pos, &buf_size);
+    }
+#endif
+#else
     LIST_FOREACH(it, &s_timers, list_entry) {
         print_timer_info(it, &pos, &buf_size);
     }
+#if CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH
+    LIST_FOREACH(it, &s_timers_isr, list_entry) {
+        print_timer_info(it, &pos, &buf_size);
+    }
+#endif
+#endif
 #if WITH_PROFILING
     LIST_FOREACH(it, &s_inactive_timers, list_entry) {
         print_timer_info(it, &pos, &buf_size);
@@ -487,7 +770,7 @@ int64_t IRAM_ATTR esp_timer_get_next_alarm(void)
 {
     int64_t next_alarm = INT64_MAX;
     timer_list_lock();
-    esp_timer_handle_t it = LIST_FIRST(&s_timers);
+    esp_timer_handle_t it = timer_armed_first();
     if (it) {
         next_alarm = it->alarm;
     }
@@ -495,6 +778,25 @@ int64_t IRAM_ATTR esp_timer_get_next_alarm(void)
     return next_alarm;
 }
 
+#if WITH_PROFILING
+esp_err_t esp_timer_get_dispatch_latency_histogram(esp_timer_handle_t timer,
+                                                   uint32_t* histogram,
+                                                   size_t num_buckets)
+{
+    if (timer == NULL || histogram == NULL || num_buckets == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    size_t to_copy = MIN(num_buckets, (size_t) ESP_TIMER_DISPATCH_LATENCY_BUCKETS);
+    timer_list_lock();
+    memcpy(histogram, timer->dispatch_latency, to_copy * sizeof(uint32_t));
+    timer_list_unlock();
+    if (num_buckets > to_copy) {
+        memset(histogram + to_copy, 0, (num_buckets - to_copy) * sizeof(uint32_t));
+    }
+    return ESP_OK;
+}
+#endif // WITH_PROFILING
+
 // Provides strong definition for system time functions relied upon
 // by core components.
 #if CONFIG_ESP_TIME_FUNCS_USE_ESP_TIMER
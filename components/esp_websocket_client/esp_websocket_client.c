@@ -108,13 +108,45 @@ struct esp_websocket_client {
     ws_transport_opcodes_t      last_opcode;
     int                         payload_len;
     int                         payload_offset;
+#ifdef CONFIG_ESP_WEBSOCKET_CLIENT_TX_LANES
+    QueueHandle_t               tx_lanes[ESP_WEBSOCKET_TX_LANE_MAX];
+    esp_websocket_client_lane_stats_t lane_stats[ESP_WEBSOCKET_TX_LANE_MAX];
+    portMUX_TYPE                lane_stats_lock;
+#endif
 };
 
+#ifdef CONFIG_ESP_WEBSOCKET_CLIENT_TX_LANES
+typedef struct {
+    int                         len;
+    uint32_t                    max_age_ms;
+    uint64_t                    enqueue_tick_ms;
+    uint8_t                     data[0];
+} ws_tx_msg_t;
+#endif
+
 static uint64_t _tick_get_ms(void)
 {
     return esp_timer_get_time()/1000;
 }
 
+#ifdef CONFIG_ESP_WEBSOCKET_CLIENT_TX_LANES
+static void esp_websocket_client_flush_tx_lanes(esp_websocket_client_handle_t client)
+{
+    for (int lane = 0; lane < ESP_WEBSOCKET_TX_LANE_MAX; lane++) {
+        ws_tx_msg_t *msg;
+        if (client->tx_lanes[lane] == NULL) {
+            continue;
+        }
+        while (xQueueReceive(client->tx_lanes[lane], &msg, 0) == pdTRUE) {
+            portENTER_CRITICAL(&client->lane_stats_lock);
+            client->lane_stats[lane].dropped_stale++;
+            portEXIT_CRITICAL(&client->lane_stats_lock);
+            free(msg);
+        }
+    }
+}
+#endif
+
 static esp_err_t esp_websocket_client_dispatch_event(esp_websocket_client_handle_t client,
         esp_websocket_event_id_t event,
         const char *data,
@@ -145,6 +177,9 @@ static esp_err_t esp_websocket_client_abort_connection(esp_websocket_client_hand
 {
     ESP_WS_CLIENT_STATE_CHECK(TAG, client, return ESP_FAIL);
     esp_transport_close(client->transport);
+#ifdef CONFIG_ESP_WEBSOCKET_CLIENT_TX_LANES
+    esp_websocket_client_flush_tx_lanes(client);
+#endif
 
     if (client->config->auto_reconnect) {
         client->wait_timeout_ms = WEBSOCKET_RECONNECT_TIMEOUT_MS;
@@ -378,6 +413,15 @@ esp_websocket_client_handle_t esp_websocket_client_init(const esp_websocket_clie
         goto _websocket_init_fail;
     });
 
+#ifdef CONFIG_ESP_WEBSOCKET_CLIENT_TX_LANES
+    for (int lane = 0; lane < ESP_WEBSOCKET_TX_LANE_MAX; lane++) {
+        client->tx_lanes[lane] = xQueueCreate(CONFIG_ESP_WEBSOCKET_CLIENT_TX_LANE_QUEUE_LEN, sizeof(ws_tx_msg_t *));
+        ESP_WS_CLIENT_MEM_CHECK(TAG, client->tx_lanes[lane], goto _websocket_init_fail);
+    }
+    portMUX_TYPE lane_stats_lock_init = portMUX_INITIALIZER_UNLOCKED;
+    client->lane_stats_lock = lane_stats_lock_init;
+#endif
+
     client->buffer_size = buffer_size;
     return client;
 
@@ -399,6 +443,14 @@ esp_err_t esp_websocket_client_destroy(esp_websocket_client_handle_t client)
     }
     esp_websocket_client_destroy_config(client);
     esp_transport_list_destroy(client->transport_list);
+#ifdef CONFIG_ESP_WEBSOCKET_CLIENT_TX_LANES
+    esp_websocket_client_flush_tx_lanes(client);
+    for (int lane = 0; lane < ESP_WEBSOCKET_TX_LANE_MAX; lane++) {
+        if (client->tx_lanes[lane]) {
+            vQueueDelete(client->tx_lanes[lane]);
+        }
+    }
+#endif
     vQueueDelete(client->lock);
     free(client->tx_buffer);
     free(client->rx_buffer);
@@ -511,6 +563,42 @@ static int esp_websocket_client_send_with_opcode(esp_websocket_client_handle_t c
 
 static int esp_websocket_client_send_close(esp_websocket_client_handle_t client, int code, const char *additional_data, int total_len, TickType_t timeout);
 
+#ifdef CONFIG_ESP_WEBSOCKET_CLIENT_TX_LANES
+/* Send everything queued on the lanes, higher priority lanes first; called
+   from the websocket task while holding the client lock */
+static void esp_websocket_client_drain_tx_lanes(esp_websocket_client_handle_t client)
+{
+    for (int lane = 0; lane < ESP_WEBSOCKET_TX_LANE_MAX; lane++) {
+        ws_tx_msg_t *msg;
+        while (xQueueReceive(client->tx_lanes[lane], &msg, 0) == pdTRUE) {
+            uint32_t waited_ms = _tick_get_ms() - msg->enqueue_tick_ms;
+            if (msg->max_age_ms > 0 && waited_ms > msg->max_age_ms) {
+                ESP_LOGD(TAG, "Dropping stale message on lane %d after %d ms", lane, waited_ms);
+                portENTER_CRITICAL(&client->lane_stats_lock);
+                client->lane_stats[lane].dropped_stale++;
+                portEXIT_CRITICAL(&client->lane_stats_lock);
+                free(msg);
+                continue;
+            }
+            int sent = esp_websocket_client_send_with_opcode(client, WS_TRANSPORT_OPCODES_BINARY, msg->data, msg->len,
+                                                             pdMS_TO_TICKS(client->config->network_timeout_ms));
+            free(msg);
+            if (sent < 0) {
+                // connection was aborted; the remaining queued messages were flushed there
+                return;
+            }
+            portENTER_CRITICAL(&client->lane_stats_lock);
+            client->lane_stats[lane].sent++;
+            client->lane_stats[lane].last_latency_ms = waited_ms;
+            if (waited_ms > client->lane_stats[lane].max_latency_ms) {
+                client->lane_stats[lane].max_latency_ms = waited_ms;
+            }
+            portEXIT_CRITICAL(&client->lane_stats_lock);
+        }
+    }
+}
+#endif
+
 static void esp_websocket_client_task(void *pv)
 {
     const int lock_timeout = portMAX_DELAY;
@@ -582,6 +670,13 @@ static void esp_websocket_client_task(void *pv)
                     }
                 }
 
+#ifdef CONFIG_ESP_WEBSOCKET_CLIENT_TX_LANES
+                esp_websocket_client_drain_tx_lanes(client);
+                if (client->state != WEBSOCKET_STATE_CONNECTED) {
+                    // draining hit a network error and aborted the connection
+                    break;
+                }
+#endif
                 if (read_select == 0) {
                     ESP_LOGV(TAG, "Read poll timeout: skipping esp_transport_read()...");
                     break;
@@ -620,7 +715,12 @@ static void esp_websocket_client_task(void *pv)
         }
         xSemaphoreGiveRecursive(client->lock);
         if (WEBSOCKET_STATE_CONNECTED == client->state) {
+#ifdef CONFIG_ESP_WEBSOCKET_CLIENT_TX_LANES
+            // poll in shorter slices so freshly queued messages do not sit behind a full read poll
+            read_select = esp_transport_poll_read(client->transport, CONFIG_ESP_WEBSOCKET_CLIENT_TX_LANES_POLL_MS);
+#else
             read_select = esp_transport_poll_read(client->transport, 1000); //Poll every 1000ms
+#endif
             if (read_select < 0) {
                 ESP_LOGE(TAG, "Network error: esp_transport_poll_read() returned %d, errno=%d", read_select, errno);
                 esp_websocket_client_abort_connection(client);
@@ -773,6 +873,65 @@ int esp_websocket_client_send_bin(esp_websocket_client_handle_t client, const ch
     return esp_websocket_client_send_with_opcode(client, WS_TRANSPORT_OPCODES_BINARY, (const uint8_t *)data, len, timeout);
 }
 
+#ifdef CONFIG_ESP_WEBSOCKET_CLIENT_TX_LANES
+int esp_websocket_client_enqueue_with_priority(esp_websocket_client_handle_t client, const char *data, int len, esp_websocket_tx_lane_t lane, uint32_t max_age_ms)
+{
+    if (client == NULL || data == NULL || len <= 0 || lane < 0 || lane >= ESP_WEBSOCKET_TX_LANE_MAX) {
+        ESP_LOGE(TAG, "Invalid arguments");
+        return -1;
+    }
+
+    ws_tx_msg_t *msg = malloc(sizeof(ws_tx_msg_t) + len);
+    ESP_WS_CLIENT_MEM_CHECK(TAG, msg, return -1);
+    msg->len = len;
+    msg->max_age_ms = max_age_ms;
+    msg->enqueue_tick_ms = _tick_get_ms();
+    memcpy(msg->data, data, len);
+
+    if (xQueueSend(client->tx_lanes[lane], &msg, 0) != pdTRUE) {
+        if (lane == ESP_WEBSOCKET_TX_LANE_HIGH) {
+            // never throw away queued control traffic; refuse the new message instead
+            free(msg);
+            portENTER_CRITICAL(&client->lane_stats_lock);
+            client->lane_stats[lane].dropped_overflow++;
+            portEXIT_CRITICAL(&client->lane_stats_lock);
+            return -1;
+        }
+        // lower lanes prefer fresh data: make room by dropping the oldest entry
+        ws_tx_msg_t *victim;
+        if (xQueueReceive(client->tx_lanes[lane], &victim, 0) == pdTRUE) {
+            free(victim);
+            portENTER_CRITICAL(&client->lane_stats_lock);
+            client->lane_stats[lane].dropped_overflow++;
+            portEXIT_CRITICAL(&client->lane_stats_lock);
+        }
+        if (xQueueSend(client->tx_lanes[lane], &msg, 0) != pdTRUE) {
+            free(msg);
+            portENTER_CRITICAL(&client->lane_stats_lock);
+            client->lane_stats[lane].dropped_overflow++;
+            portEXIT_CRITICAL(&client->lane_stats_lock);
+            return -1;
+        }
+    }
+    portENTER_CRITICAL(&client->lane_stats_lock);
+    client->lane_stats[lane].enqueued++;
+    portEXIT_CRITICAL(&client->lane_stats_lock);
+    return len;
+}
+
+esp_err_t esp_websocket_client_get_lane_stats(esp_websocket_client_handle_t client, esp_websocket_tx_lane_t lane, esp_websocket_client_lane_stats_t *stats)
+{
+    if (client == NULL || stats == NULL || lane < 0 || lane >= ESP_WEBSOCKET_TX_LANE_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&client->lane_stats_lock);
+    *stats = client->lane_stats[lane];
+    portEXIT_CRITICAL(&client->lane_stats_lock);
+    stats->queued = uxQueueMessagesWaiting(client->tx_lanes[lane]);
+    return ESP_OK;
+}
+#endif // CONFIG_ESP_WEBSOCKET_CLIENT_TX_LANES
+
 static int esp_websocket_client_send_with_opcode(esp_websocket_client_handle_t client, ws_transport_opcodes_t opcode, const uint8_t *data, int len, TickType_t timeout)
 {
     int need_write = len;
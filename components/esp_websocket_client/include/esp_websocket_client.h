@@ -22,6 +22,7 @@
 #include "freertos/FreeRTOS.h"
 #include "esp_err.h"
 #include "esp_event.h"
+#include "sdkconfig.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -198,6 +199,62 @@ int esp_websocket_client_send_bin(esp_websocket_client_handle_t client, const ch
  */
 int esp_websocket_client_send_text(esp_websocket_client_handle_t client, const char *data, int len, TickType_t timeout);
 
+#ifdef CONFIG_ESP_WEBSOCKET_CLIENT_TX_LANES
+/**
+ * @brief Priority lanes of the internal TX queue
+ */
+typedef enum {
+    ESP_WEBSOCKET_TX_LANE_HIGH = 0,  /*!< Control traffic; an enqueue into a full lane fails rather than dropping queued data */
+    ESP_WEBSOCKET_TX_LANE_MID,       /*!< Regular traffic; on overflow the oldest queued message is dropped */
+    ESP_WEBSOCKET_TX_LANE_LOW,       /*!< Bulk/telemetry traffic; on overflow the oldest queued message is dropped */
+    ESP_WEBSOCKET_TX_LANE_MAX
+} esp_websocket_tx_lane_t;
+
+/**
+ * @brief Counters of one TX priority lane
+ */
+typedef struct {
+    uint32_t enqueued;          /*!< Messages accepted into the lane */
+    uint32_t sent;              /*!< Messages written to the transport */
+    uint32_t dropped_stale;     /*!< Messages dropped because they exceeded max_age_ms, or were queued at disconnect */
+    uint32_t dropped_overflow;  /*!< Messages dropped (or enqueues refused) because the lane was full */
+    uint32_t queued;            /*!< Messages currently waiting in the lane */
+    uint32_t last_latency_ms;   /*!< Queueing delay of the most recently sent message */
+    uint32_t max_latency_ms;    /*!< Largest queueing delay seen so far */
+} esp_websocket_client_lane_stats_t;
+
+/**
+ * @brief      Queue binary data for sending on a priority lane (data send with WS OPCODE=02, i.e. binary)
+ *
+ * The data is copied and sent later from the websocket task, higher lanes
+ * first, so a caller is never blocked behind an in-progress send of another
+ * task. Queued messages are discarded when the connection drops.
+ *
+ * @param[in]  client      The client
+ * @param[in]  data        The data
+ * @param[in]  len         The length
+ * @param[in]  lane        Priority lane to queue the data on
+ * @param[in]  max_age_ms  Drop the message instead of sending it if it waited longer
+ *                         than this in the queue; 0 means never drop
+ *
+ * @return
+ *     - Number of data queued for sending
+ *     - (-1) if any errors
+ */
+int esp_websocket_client_enqueue_with_priority(esp_websocket_client_handle_t client, const char *data, int len, esp_websocket_tx_lane_t lane, uint32_t max_age_ms);
+
+/**
+ * @brief      Read the counters of one TX priority lane
+ *
+ * @param[in]  client  The client
+ * @param[in]  lane    The lane
+ * @param[out] stats   Filled with a snapshot of the lane counters
+ *
+ * @return     esp_err_t
+ */
+esp_err_t esp_websocket_client_get_lane_stats(esp_websocket_client_handle_t client, esp_websocket_tx_lane_t lane, esp_websocket_client_lane_stats_t *stats);
+#endif // CONFIG_ESP_WEBSOCKET_CLIENT_TX_LANES
+
 /**
  * @brief      Close the WebSocket connection in a clean way
  *
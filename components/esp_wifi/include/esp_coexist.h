@@ -68,6 +68,101 @@ const char *esp_coex_version_get(void);
  */
 esp_err_t esp_coex_preference_set(esp_coex_prefer_t prefer);
 
+/**
+ * @brief Traffic class of a radio link, used by the coexistence scheduler
+ */
+typedef enum {
+    ESP_COEX_TRAFFIC_BACKGROUND = 0,  /*!< Bulk transfers (cloud sync, OTA), deferral is acceptable */
+    ESP_COEX_TRAFFIC_PERIODIC,        /*!< Isochronous traffic with a fixed interval (BLE audio) */
+    ESP_COEX_TRAFFIC_LOW_LATENCY,     /*!< Interactive traffic which needs prompt, short grants */
+} esp_coex_traffic_class_t;
+
+/**
+ * @brief Declared traffic pattern of one radio
+ */
+typedef struct {
+    esp_coex_status_type_t   radio;         /*!< WIFI/BLE/BT */
+    esp_coex_traffic_class_t traffic_class; /*!< kind of traffic carried on this radio */
+    uint32_t                 period_ms;     /*!< traffic period (e.g. BLE ISO interval), 0 to use the scheduler default */
+    uint32_t                 budget_ms;     /*!< airtime wanted per period */
+} esp_coex_traffic_profile_t;
+
+/**
+ * @brief Grant notification callback
+ *
+ * Called from the esp_timer task at the start of a scheduling slot granted
+ * to `radio`, which lasts for `grant_ms`. Keep the callback short; defer
+ * real work (queueing the next audio frames, resuming a socket) to a task.
+ */
+typedef void (*esp_coex_grant_cb_t)(esp_coex_status_type_t radio, uint32_t grant_ms, void *arg);
+
+/**
+ * @brief Per-radio scheduler statistics
+ */
+typedef struct {
+    uint32_t grants[3];      /*!< slots granted, indexed by esp_coex_status_type_t */
+    uint32_t denials[3];     /*!< cycles in which a declared budget could not be fully scheduled */
+    uint64_t airtime_ms[3];  /*!< cumulative airtime granted */
+    uint32_t cycle_ms;       /*!< current scheduling cycle length */
+} esp_coex_scheduler_stats_t;
+
+/**
+ * @brief Declare (or update) the traffic profile of one radio
+ *
+ * The scheduler builds a repeating grant cycle from all declared profiles:
+ * low latency links are served first, then periodic links get their budget,
+ * and background links share the remaining airtime. At each slot boundary
+ * the coexistence preference is biased towards the granted radio and the
+ * registered grant callbacks are invoked, so the application can shape its
+ * traffic to the grant pattern instead of competing for RF blindly.
+ *
+ * @param profile : traffic profile; profile->radio selects the slot
+ * @return : ESP_OK - success, ESP_ERR_INVALID_ARG - bad profile,
+ *           ESP_ERR_NO_MEM - scheduler resources could not be allocated
+ */
+esp_err_t esp_coex_traffic_profile_set(const esp_coex_traffic_profile_t *profile);
+
+/**
+ * @brief Remove the declared traffic profile of one radio
+ *
+ * When the last profile is removed the scheduler stops and the coexistence
+ * preference returns to balance.
+ *
+ * @param radio : WIFI/BLE/BT
+ * @return : ESP_OK - success, other - failed
+ */
+esp_err_t esp_coex_traffic_profile_clear(esp_coex_status_type_t radio);
+
+/**
+ * @brief Register a grant notification callback
+ *
+ * @param cb : callback to invoke at every slot start
+ * @param arg : argument passed through to the callback
+ * @return : ESP_OK - success, ESP_ERR_NO_MEM - callback table is full
+ */
+esp_err_t esp_coex_grant_cb_register(esp_coex_grant_cb_t cb, void *arg);
+
+/**
+ * @brief Unregister a grant notification callback
+ *
+ * @param cb : callback passed to esp_coex_grant_cb_register()
+ * @return : ESP_OK - success, ESP_ERR_NOT_FOUND - callback is not registered
+ */
+esp_err_t esp_coex_grant_cb_unregister(esp_coex_grant_cb_t cb);
+
+/**
+ * @brief Read the scheduler statistics
+ *
+ * @param stats : filled with a snapshot of the counters
+ * @return : ESP_OK - success, ESP_ERR_INVALID_ARG - stats is NULL
+ */
+esp_err_t esp_coex_scheduler_stats_get(esp_coex_scheduler_stats_t *stats);
+
+/**
+ * @brief Reset the scheduler statistics counters
+ */
+void esp_coex_scheduler_stats_reset(void);
+
 /**
  * @brief Set coex schm status
  * @param type : WIFI/BLE/BT
@@ -0,0 +1,97 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __ESP_MESH_ROUTING_H__
+#define __ESP_MESH_ROUTING_H__
+
+#include "esp_mesh.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Per-node forwarding statistics, see esp_mesh_route_get_stats()
+ */
+typedef struct {
+    uint32_t fwd_packets;       /**< packets forwarded towards this node */
+    uint64_t fwd_bytes;         /**< bytes forwarded towards this node */
+    uint64_t latency_sum_us;    /**< accumulated per-hop latency, for averaging */
+    uint32_t latency_max_us;    /**< worst per-hop latency seen */
+} esp_mesh_route_stats_t;
+
+/**
+ * @brief Build a MAC-indexed mirror of the mesh routing table
+ *
+ * esp_mesh_get_routing_table() returns a flat array, so checking whether a
+ * destination is routable costs a linear scan per packet — noticeable at
+ * 50+ nodes on the forwarding hot path. This keeps a hash-indexed copy,
+ * refreshed automatically on MESH_EVENT_ROUTING_TABLE_ADD/REMOVE, giving
+ * O(1) esp_mesh_route_lookup() plus a per-node statistics slot.
+ *
+ * Call after esp_mesh_init() and the default event loop creation.
+ *
+ * @return
+ *          - ESP_OK : cache active
+ *          - ESP_ERR_NO_MEM : out of memory
+ *          - others : esp_event registration errors
+ */
+esp_err_t esp_mesh_route_cache_init(void);
+
+/**
+ * @brief Tear down the routing table mirror
+ *
+ * @return ESP_OK, or ESP_ERR_INVALID_STATE if not initialized
+ */
+esp_err_t esp_mesh_route_cache_deinit(void);
+
+/**
+ * @brief O(1) routing table membership check
+ *
+ * @param addr destination MAC
+ *
+ * @return true if the address is currently in the routing table
+ */
+bool esp_mesh_route_lookup(const mesh_addr_t *addr);
+
+/**
+ * @brief Account one forwarded packet towards a node
+ *
+ * Call on the forwarding path after handing the packet on; keeps the
+ * per-node counters used to locate congested branches in production.
+ *
+ * @param addr       destination MAC (must be in the routing table)
+ * @param bytes      payload size of the forwarded packet
+ * @param latency_us time the packet spent queued on this hop
+ *
+ * @return ESP_OK, or ESP_ERR_NOT_FOUND if the node is not in the table
+ */
+esp_err_t esp_mesh_route_note_forward(const mesh_addr_t *addr, uint32_t bytes, uint32_t latency_us);
+
+/**
+ * @brief Read the forwarding statistics of one node
+ *
+ * @param addr      node MAC
+ * @param out_stats filled with a snapshot of the node's counters
+ *
+ * @return ESP_OK, ESP_ERR_INVALID_ARG on NULL arguments,
+ *         ESP_ERR_NOT_FOUND if the node is not in the table
+ */
+esp_err_t esp_mesh_route_get_stats(const mesh_addr_t *addr, esp_mesh_route_stats_t *out_stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ESP_MESH_ROUTING_H__ */
@@ -0,0 +1,102 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __ESP_NOW_MULTI_H__
+#define __ESP_NOW_MULTI_H__
+
+#include "esp_now.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief One payload of a batched ESPNOW send, see esp_now_send_multi()
+ */
+typedef struct {
+    const uint8_t *peer_addr;   /*!< peer MAC address, NULL for all added peers */
+    const uint8_t *data;        /*!< payload to send */
+    size_t len;                 /*!< payload length, maximum ESP_NOW_MAX_DATA_LEN */
+} esp_now_multi_item_t;
+
+/**
+ * @brief Aggregated completion callback for esp_now_send_multi()
+ *
+ * Called once per batch from the WiFi task context after every frame of the
+ * batch has been sent (or failed). Keep it short and non-blocking, as with
+ * esp_now_send_cb_t. The status array is only valid during the call.
+ *
+ * @param status array with one esp_now_send_status_t per batch item, in submission order
+ * @param count  number of items in the batch
+ * @param arg    user argument given to esp_now_send_multi()
+ */
+typedef void (*esp_now_multi_cb_t)(const esp_now_send_status_t *status, size_t count, void *arg);
+
+/**
+ * @brief Initialize batched ESPNOW sending
+ *
+ * Takes over the ESPNOW send callback slot (esp_now_register_send_cb) for
+ * completion accounting. Applications that also need per-frame callbacks
+ * should register them via esp_now_multi_register_send_cb() instead; they
+ * are chained for every sent frame, batched or not.
+ *
+ * Call after esp_now_init().
+ *
+ * @return
+ *          - ESP_OK : succeed
+ *          - ESP_ERR_ESPNOW_NOT_INIT : ESPNOW is not initialized
+ *          - ESP_ERR_ESPNOW_INTERNAL : internal error
+ */
+esp_err_t esp_now_multi_init(void);
+
+/**
+ * @brief Register a per-frame send callback chained behind the batch accounting
+ *
+ * @param cb per-frame send callback, NULL to unregister
+ *
+ * @return ESP_OK
+ */
+esp_err_t esp_now_multi_register_send_cb(esp_now_send_cb_t cb);
+
+/**
+ * @brief Send several ESPNOW payloads, possibly to different peers, in one call
+ *
+ * All items are queued to the driver back to back and a single aggregated
+ * callback reports the per-item results, replacing one send-callback storm
+ * per frame with one dispatch per batch. Items whose submission is rejected
+ * (e.g. driver buffers full) are reported as ESP_NOW_SEND_FAIL in the status
+ * vector; the remaining items are still sent.
+ *
+ * Only one batch may be in flight at a time.
+ *
+ * @param items array of payloads to send
+ * @param count number of payloads, at least 1
+ * @param cb    aggregated completion callback, may be NULL (fire and forget)
+ * @param arg   user argument for the callback
+ *
+ * @return
+ *          - ESP_OK : all items queued (results come through the callback)
+ *          - ESP_ERR_ESPNOW_NOT_INIT : esp_now_multi_init() has not been called
+ *          - ESP_ERR_ESPNOW_ARG : invalid argument
+ *          - ESP_ERR_ESPNOW_NO_MEM : out of memory for the batch bookkeeping
+ *          - ESP_ERR_INVALID_STATE : another batch is still in flight
+ */
+esp_err_t esp_now_send_multi(const esp_now_multi_item_t *items, size_t count,
+                             esp_now_multi_cb_t cb, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ESP_NOW_MULTI_H__ */
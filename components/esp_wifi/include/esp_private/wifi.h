@@ -190,6 +190,37 @@ typedef void (*wifi_netstack_buf_free_cb_t)(void *netstack_buf);
   */
 esp_err_t esp_wifi_internal_tx_by_ref(wifi_interface_t ifx, void *buffer, size_t len, void *netstack_buf);
 
+/**
+  * @brief  One frame of a batched transmit, see esp_wifi_internal_tx_batch()
+  */
+typedef struct {
+    wifi_interface_t ifx;       /**< interface to transmit on */
+    void *buffer;               /**< frame to transmit */
+    uint16_t len;               /**< length of the frame */
+    void *netstack_buf;         /**< net stack buffer holding the frame, or NULL to let the driver copy it */
+} esp_wifi_tx_item_t;
+
+/**
+  * @brief  transmit an array of frames via wifi driver in one call
+  *
+  * Submits every frame of the batch, collecting a status per frame: frames
+  * with a netstack_buf are forwarded by reference (esp_wifi_internal_tx_by_ref),
+  * the others are copied (esp_wifi_internal_tx). Submission does not stop at
+  * the first failing frame.
+  *
+  * @param  items : array of frames to transmit
+  * @param  count : number of frames in the array
+  * @param  out_status : optional array of count entries receiving the per-frame result, may be NULL
+  * @param  out_sent : optional, receives the number of successfully submitted frames, may be NULL
+  *
+  * @return
+  *    - ESP_OK  : every frame was submitted
+  *    - ESP_ERR_INVALID_ARG : items is NULL or count is 0
+  *    - others  : result of the first failing frame (remaining frames were still attempted)
+  */
+esp_err_t esp_wifi_internal_tx_batch(const esp_wifi_tx_item_t *items, size_t count,
+                                     esp_err_t *out_status, size_t *out_sent);
+
 /**
   * @brief  register the net stack buffer reference increasing and free callback
   *
@@ -55,12 +55,35 @@ typedef struct {
 /** Configure structure for esp_smartconfig_start */
 typedef struct {
     bool enable_log;            /**< Enable smartconfig logs. */
+    uint16_t channel_dwell_ms;  /**< Time spent listening on each channel while searching for the
+                                     sender, in milliseconds. 0 uses the default (worst-case) dwell
+                                     time. Shorter dwell times speed up channel lock in clean RF
+                                     environments such as a factory line. */
+    bool fast_channel_lock;     /**< Lock onto a candidate channel as soon as a partial
+                                     packet-length signature correlates, instead of waiting for a
+                                     complete leader sequence. Speeds up provisioning, at the cost
+                                     of occasional false locks (which time out and resume hopping). */
 } smartconfig_start_config_t;
 
 #define SMARTCONFIG_START_CONFIG_DEFAULT() { \
-    .enable_log = false \
+    .enable_log = false, \
+    .channel_dwell_ms = 0, \
+    .fast_channel_lock = false \
 };
 
+/**
+  * @brief  SmartConfig progress callback
+  *
+  * Invoked for every SC_EVENT posted while SmartConfig is running, along with the
+  * time elapsed since esp_smartconfig_start(), so provisioning stations can track
+  * per-stage timing without registering their own event handlers.
+  *
+  * @param  event       The smartconfig event which was posted.
+  * @param  elapsed_ms  Milliseconds since SmartConfig was started.
+  * @param  arg         User argument passed to esp_smartconfig_set_progress_cb().
+  */
+typedef void (*sc_progress_cb_t)(smartconfig_event_t event, uint32_t elapsed_ms, void *arg);
+
 /**
   * @brief  Get the version of SmartConfig.
   *
@@ -139,6 +162,20 @@ esp_err_t esp_smartconfig_set_type(smartconfig_type_t type);
   */
 esp_err_t esp_smartconfig_fast_mode(bool enable);
 
+/**
+  * @brief     Set a progress callback, invoked for each SmartConfig stage transition.
+  *
+  * @attention Please call it before API esp_smartconfig_start. The callback runs in the
+  *            event task context and must not block. Pass NULL to remove the callback.
+  *
+  * @param     cb   progress callback, or NULL to remove a previously set callback
+  * @param     arg  user argument passed to the callback
+  *
+  * @return
+  *     - ESP_OK: succeed
+  */
+esp_err_t esp_smartconfig_set_progress_cb(sc_progress_cb_t cb, void *arg);
+
 #ifdef __cplusplus
 }
 #endif
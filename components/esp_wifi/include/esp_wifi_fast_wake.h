@@ -0,0 +1,109 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __ESP_WIFI_FAST_WAKE_H__
+#define __ESP_WIFI_FAST_WAKE_H__
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef CONFIG_ESP32_WIFI_FAST_WAKE
+
+/**
+ * @brief Fast wake configuration, see esp_wifi_fast_wake_start()
+ */
+typedef struct {
+    uint64_t period_us;     /*!< period of the expected traffic, e.g. 100000 for a 100 ms telemetry cycle */
+    uint64_t lead_us;       /*!< how long before each period boundary to leave power save */
+    uint64_t active_us;     /*!< how long to stay out of power save per period */
+} esp_wifi_fast_wake_config_t;
+
+/**
+ * @brief Wake latency statistics, see esp_wifi_fast_wake_get_stats()
+ *
+ * first_rx_* cover the time from opening a wake window (power save
+ * disabled) to the first received frame inside that window. Histogram
+ * bucket i counts latencies below (1 << i) milliseconds, the last bucket
+ * everything above.
+ */
+typedef struct {
+    uint32_t windows;           /*!< wake windows opened so far */
+    uint32_t windows_with_rx;   /*!< windows in which at least one frame arrived */
+    uint32_t first_rx_min_us;   /*!< fastest window-open to first-RX time */
+    uint32_t first_rx_max_us;   /*!< slowest window-open to first-RX time */
+    uint64_t first_rx_sum_us;   /*!< sum over windows_with_rx, for averaging */
+    uint32_t first_rx_hist[8];  /*!< log2-millisecond latency histogram */
+} esp_wifi_fast_wake_stats_t;
+
+/**
+ * @brief Pre-arm the RF ahead of known periodic traffic
+ *
+ * With modem sleep enabled the first packet after an idle gap waits for the
+ * next DTIM wake, which shows up as tens of milliseconds of first-packet
+ * latency. When the traffic pattern is known (fixed telemetry period), this
+ * starts an esp_timer that leaves power save lead_us before each period
+ * boundary and re-enters it active_us later, trading a bounded amount of
+ * power for bounded latency. Wake-to-first-RX latency is recorded per
+ * window (see esp_wifi_fast_wake_get_stats()).
+ *
+ * @param config periodic wake schedule; lead_us + active_us must be below period_us
+ *
+ * @return
+ *          - ESP_OK : schedule armed
+ *          - ESP_ERR_INVALID_ARG : config is NULL or the windows exceed the period
+ *          - ESP_ERR_INVALID_STATE : already started
+ *          - others : esp_timer errors
+ */
+esp_err_t esp_wifi_fast_wake_start(const esp_wifi_fast_wake_config_t *config);
+
+/**
+ * @brief Stop the fast wake schedule and restore the previous power save mode
+ *
+ * @return ESP_OK, or ESP_ERR_INVALID_STATE if not started
+ */
+esp_err_t esp_wifi_fast_wake_stop(void);
+
+/**
+ * @brief Read the accumulated wake latency statistics
+ *
+ * @param out_stats filled with a snapshot of the counters
+ *
+ * @return ESP_OK, or ESP_ERR_INVALID_ARG if out_stats is NULL
+ */
+esp_err_t esp_wifi_fast_wake_get_stats(esp_wifi_fast_wake_stats_t *out_stats);
+
+/**
+ * @brief Reset the accumulated wake latency statistics
+ */
+void esp_wifi_fast_wake_reset_stats(void);
+
+/**
+ * @brief Record a received frame for wake latency accounting (internal)
+ *
+ * Called from the netif glue RX path; not part of the public API.
+ */
+void esp_wifi_fast_wake_note_rx(void);
+
+#endif // CONFIG_ESP32_WIFI_FAST_WAKE
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ESP_WIFI_FAST_WAKE_H__ */
@@ -15,6 +15,11 @@
 #ifndef _ESP_WIFI_NETIF_H
 #define _ESP_WIFI_NETIF_H
 
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "sdkconfig.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -84,6 +89,139 @@ bool esp_wifi_is_if_ready_when_started(wifi_netif_driver_t ifx);
  */
 esp_err_t esp_wifi_register_if_rxcb(wifi_netif_driver_t ifx, esp_netif_receive_t fn, void * arg);
 
+#ifdef CONFIG_ESP32_WIFI_RX_BACKPRESSURE
+/**
+ * @brief RX backpressure notification callback
+ *
+ * Runs in the context that crossed the watermark (Wi-Fi task on receive,
+ * network stack task on buffer free) — keep it short and non-blocking.
+ *
+ * @param above_high true when the outstanding RX buffer count reached the
+ *                   high watermark, false when it fell back to the low one
+ * @param outstanding current number of driver RX buffers held by the stack
+ * @param arg user argument given at registration
+ */
+typedef void (*esp_wifi_rx_backpressure_cb_t)(bool above_high, int32_t outstanding, void *arg);
+
+/**
+ * @brief Register (or clear) the RX buffer backpressure callback
+ *
+ * The driver's RX buffer pool is sized at init; when the network stack sits
+ * on most of it, further frames are dropped inside the driver without any
+ * notice. This callback gives the application an early signal to shed load
+ * (pause bulk receivers, drop low-priority work) before that point, and an
+ * all-clear once buffers have been returned.
+ *
+ * @param high_watermark fire with above_high=true when this many buffers are outstanding
+ * @param low_watermark fire with above_high=false when the count falls back to this value
+ * @param cb callback, or NULL to unregister
+ * @param arg user argument passed to the callback
+ *
+ * @return
+ *  - ESP_OK on success
+ *  - ESP_ERR_INVALID_ARG if cb is set and the watermarks are not low < high with high > 0
+ */
+esp_err_t esp_wifi_set_rx_backpressure_cb(uint16_t high_watermark, uint16_t low_watermark,
+                                          esp_wifi_rx_backpressure_cb_t cb, void *arg);
+
+/**
+ * @brief Number of driver RX buffers currently held by the network stack
+ */
+int32_t esp_wifi_get_rx_outstanding(void);
+#endif // CONFIG_ESP32_WIFI_RX_BACKPRESSURE
+
+#ifdef CONFIG_ESP32_WIFI_RX_BUFFER_LOAN
+/**
+ * @brief A received frame whose driver buffer is on loan to the application
+ */
+typedef struct {
+    wifi_interface_t ifx;   /**< interface the frame arrived on */
+    void *buffer;           /**< frame payload, valid until the loan is returned */
+    uint16_t len;           /**< payload length in bytes */
+    void *eb;               /**< driver buffer handle to pass to esp_wifi_return_rx_buffer() */
+} esp_wifi_rx_loan_t;
+
+/**
+ * @brief Zero-copy RX hook, called for every received frame before the TCP/IP stack
+ *
+ * Runs in the Wi-Fi task — keep it short and non-blocking. Returning true
+ * claims the frame: it is not delivered to the stack and the driver buffer
+ * stays valid (on loan) until esp_wifi_return_rx_buffer(eb) is called.
+ * Returning false leaves the frame on its normal path. Frames with a NULL
+ * eb have no loanable driver buffer; a true return is ignored for them.
+ *
+ * @param ifx interface the frame arrived on
+ * @param buffer frame payload
+ * @param len payload length in bytes
+ * @param eb driver buffer handle (may be NULL)
+ * @param arg user argument given at registration
+ *
+ * @return true to take ownership of the frame, false to pass it on
+ */
+typedef bool (*esp_wifi_rx_hook_t)(wifi_interface_t ifx, void *buffer, uint16_t len, void *eb, void *arg);
+
+/**
+ * @brief Register (or clear with NULL) the zero-copy RX hook
+ *
+ * @param hook hook function, or NULL to unregister
+ * @param arg user argument passed to the hook
+ *
+ * @return ESP_OK on success
+ */
+esp_err_t esp_wifi_set_rx_hook(esp_wifi_rx_hook_t hook, void *arg);
+
+/**
+ * @brief Return a loaned driver RX buffer
+ *
+ * Every frame claimed by the RX hook must be handed back exactly once
+ * through this function; the driver recycles the buffer into its RX pool.
+ *
+ * @param eb driver buffer handle from the hook
+ */
+void esp_wifi_return_rx_buffer(void *eb);
+
+/**
+ * @brief Pre-allocate the loan hand-off pool
+ *
+ * Creates a queue of loan slots so the RX hook can pass claimed frames to a
+ * consumer task without any per-frame allocation. Call once before the hook
+ * starts claiming frames. The depth bounds how many driver buffers can be
+ * outstanding at once; keep it below the driver RX buffer count.
+ *
+ * @param depth number of loan slots
+ *
+ * @return
+ *  - ESP_OK on success
+ *  - ESP_ERR_INVALID_ARG if depth is 0
+ *  - ESP_ERR_INVALID_STATE if the pool already exists
+ *  - ESP_ERR_NO_MEM if allocation fails
+ */
+esp_err_t esp_wifi_rx_loan_pool_init(uint16_t depth);
+
+/**
+ * @brief Queue a claimed frame for the consumer task (hook context, non-blocking)
+ *
+ * @param loan frame descriptor, copied into the pool
+ *
+ * @return true on success, false if the pool is full or not initialized —
+ *         the caller still owns the loan and should return the buffer
+ */
+bool esp_wifi_rx_loan_push(const esp_wifi_rx_loan_t *loan);
+
+/**
+ * @brief Take the next claimed frame from the pool
+ *
+ * The caller owns the loan afterwards and must call
+ * esp_wifi_return_rx_buffer(loan->eb) when done with the payload.
+ *
+ * @param loan filled with the frame descriptor on success
+ * @param timeout_ms how long to wait for a frame
+ *
+ * @return true if a frame was received, false on timeout
+ */
+bool esp_wifi_rx_loan_pop(esp_wifi_rx_loan_t *loan, uint32_t timeout_ms);
+#endif // CONFIG_ESP32_WIFI_RX_BUFFER_LOAN
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,113 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _ESP_WIFI_ROAM_H_
+#define _ESP_WIFI_ROAM_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "esp_wifi_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Roaming engine configuration
+ */
+typedef struct {
+    int8_t roam_rssi_threshold;     /*!< start looking for a better AP when the current one
+                                         drops below this, dBm (e.g. -70) */
+    int8_t better_ap_margin;        /*!< a candidate must beat the current AP by this many dB
+                                         before a roam is worth the gap (e.g. 8) */
+    uint32_t monitor_interval_ms;   /*!< how often the current AP's RSSI is sampled */
+    uint32_t scan_interval_ms;      /*!< background scan period keeping the candidate table
+                                         warm while the link is still good */
+} esp_wifi_roam_config_t;
+
+#define ESP_WIFI_ROAM_CONFIG_DEFAULT() { \
+    .roam_rssi_threshold = -70, \
+    .better_ap_margin = 8, \
+    .monitor_interval_ms = 2000, \
+    .scan_interval_ms = 60000, \
+}
+
+/**
+ * @brief Roaming engine counters
+ */
+typedef struct {
+    uint32_t scans;                 /*!< background scans issued */
+    uint32_t roams;                 /*!< successful directed reassociations */
+    uint32_t roams_failed;          /*!< roam attempts that fell back to a normal reconnect */
+    uint32_t last_roam_ms;          /*!< gap of the last roam, disconnect to reassociated */
+} esp_wifi_roam_stats_t;
+
+/**
+ * @brief Start the roaming engine
+ *
+ * Samples the RSSI of the associated AP, keeps a ranked table of
+ * same-SSID candidates refreshed by short background scans, and when the
+ * link degrades below the configured threshold reassociates directly to
+ * the best candidate (BSSID and channel pinned, so the connect skips the
+ * all-channel scan that dominates a cold reconnect).
+ *
+ * Call after esp_wifi_start(), station mode. The engine issues its roam
+ * scans while associated; the driver schedules them off-channel between
+ * beacons, coordinated with its own power save logic.
+ *
+ * @param config  engine configuration, e.g. ESP_WIFI_ROAM_CONFIG_DEFAULT()
+ *
+ * @return
+ *    - ESP_OK: succeed
+ *    - ESP_ERR_INVALID_ARG: config is NULL or intervals are zero
+ *    - ESP_ERR_INVALID_STATE: already started
+ */
+esp_err_t esp_wifi_roam_start(const esp_wifi_roam_config_t *config);
+
+/**
+ * @brief Stop the roaming engine and drop the candidate table
+ *
+ * @return
+ *    - ESP_OK: succeed
+ *    - ESP_ERR_INVALID_STATE: not started
+ */
+esp_err_t esp_wifi_roam_stop(void);
+
+/**
+ * @brief Copy the current ranked candidate table
+ *
+ * @param records  destination array
+ * @param max      capacity of the destination array
+ *
+ * @return number of candidates copied, best first
+ */
+size_t esp_wifi_roam_get_candidates(wifi_ap_record_t *records, size_t max);
+
+/**
+ * @brief Read the roaming counters
+ *
+ * @param stats  filled with the counters accumulated since start
+ *
+ * @return
+ *    - ESP_OK: succeed
+ *    - ESP_ERR_INVALID_ARG: stats is NULL
+ */
+esp_err_t esp_wifi_roam_get_stats(esp_wifi_roam_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ESP_WIFI_ROAM_H_ */
@@ -12,8 +12,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <string.h>
 #include "esp_coexist.h"
 #include "esp_coexist_internal.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+
+static const char *TAG = "coexist";
 
 const char *esp_coex_version_get(void)
 {
@@ -24,3 +30,282 @@ esp_err_t esp_coex_preference_set(esp_coex_prefer_t prefer)
 {
     return coex_preference_set((coex_prefer_t)prefer);
 }
+
+/*
+ * Application-visible coexistence traffic scheduler.
+ *
+ * The hard arbitration between the radios happens inside the coexistence
+ * library; applications cannot observe its grant decisions, which is why
+ * concurrent BLE audio and Wi-Fi bulk traffic degrades so unpredictably.
+ * This scheduler builds a repeating grant cycle from the traffic profiles
+ * the application declares, biases the coexistence preference towards the
+ * granted radio at every slot boundary, and tells the application (via
+ * callbacks and statistics) when each radio is expected to own the RF -
+ * so traffic can be shaped to the grant pattern instead of fighting it.
+ */
+
+#define COEX_SCHED_RADIO_NUM        3       /* WIFI, BLE, BT */
+#define COEX_SCHED_MAX_CALLBACKS    4
+#define COEX_SCHED_DEFAULT_CYCLE_MS 100
+#define COEX_SCHED_IDLE_SLOT        (-1)    /* no radio preferred, balance */
+
+typedef struct {
+    esp_coex_traffic_profile_t profile;
+    bool valid;
+    bool shortfall;                         /* declared budget does not fit in the cycle */
+} coex_sched_profile_t;
+
+typedef struct {
+    int radio;                              /* esp_coex_status_type_t or COEX_SCHED_IDLE_SLOT */
+    uint32_t duration_ms;
+} coex_sched_slot_t;
+
+typedef struct {
+    esp_coex_grant_cb_t cb;
+    void *arg;
+} coex_sched_cb_t;
+
+static portMUX_TYPE s_sched_spinlock = portMUX_INITIALIZER_UNLOCKED;
+static coex_sched_profile_t s_sched_profiles[COEX_SCHED_RADIO_NUM];
+static coex_sched_cb_t s_sched_cbs[COEX_SCHED_MAX_CALLBACKS];
+static coex_sched_slot_t s_sched_slots[COEX_SCHED_RADIO_NUM + 1];   /* one per radio plus an idle slot */
+static int s_sched_slot_num;
+static int s_sched_slot_idx;
+static uint32_t s_sched_cycle_ms;
+static esp_coex_scheduler_stats_t s_sched_stats;
+static esp_timer_handle_t s_sched_timer;
+static bool s_sched_running;
+
+/* Rebuild the grant cycle from the declared profiles. Low latency links are
+ * served first, then periodic links get their budget, and background links
+ * share what remains of the cycle. Called with s_sched_spinlock taken. */
+static void coex_sched_build_cycle(void)
+{
+    static const esp_coex_traffic_class_t class_order[] = {
+        ESP_COEX_TRAFFIC_LOW_LATENCY,
+        ESP_COEX_TRAFFIC_PERIODIC,
+        ESP_COEX_TRAFFIC_BACKGROUND,
+    };
+
+    uint32_t cycle_ms = 0;
+    int unbudgeted = 0;
+    for (int i = 0; i < COEX_SCHED_RADIO_NUM; i++) {
+        if (s_sched_profiles[i].valid) {
+            if (s_sched_profiles[i].profile.period_ms > cycle_ms) {
+                cycle_ms = s_sched_profiles[i].profile.period_ms;
+            }
+            if (s_sched_profiles[i].profile.budget_ms == 0) {
+                unbudgeted++;
+            }
+        }
+    }
+    if (cycle_ms == 0) {
+        cycle_ms = COEX_SCHED_DEFAULT_CYCLE_MS;
+    }
+
+    uint32_t remaining = cycle_ms;
+    int slot = 0;
+    for (size_t c = 0; c < sizeof(class_order) / sizeof(class_order[0]); c++) {
+        for (int i = 0; i < COEX_SCHED_RADIO_NUM; i++) {
+            coex_sched_profile_t *p = &s_sched_profiles[i];
+            if (!p->valid || p->profile.traffic_class != class_order[c]) {
+                continue;
+            }
+            uint32_t want = p->profile.budget_ms;
+            if (want == 0) {
+                /* No explicit budget: share the remaining airtime between
+                 * all unbudgeted links */
+                want = remaining / unbudgeted;
+                unbudgeted--;
+            }
+            uint32_t grant = (want > remaining) ? remaining : want;
+            p->shortfall = (grant < p->profile.budget_ms);
+            if (grant > 0) {
+                s_sched_slots[slot].radio = p->profile.radio;
+                s_sched_slots[slot].duration_ms = grant;
+                slot++;
+                remaining -= grant;
+            }
+        }
+    }
+    if (remaining > 0 && slot > 0) {
+        /* Unclaimed tail of the cycle: no preference, let the coexistence
+         * library balance the radios */
+        s_sched_slots[slot].radio = COEX_SCHED_IDLE_SLOT;
+        s_sched_slots[slot].duration_ms = remaining;
+        slot++;
+    }
+    s_sched_slot_num = slot;
+    s_sched_slot_idx = 0;
+    s_sched_cycle_ms = cycle_ms;
+    s_sched_stats.cycle_ms = cycle_ms;
+}
+
+static void coex_sched_timer_cb(void *arg)
+{
+    coex_sched_slot_t slot;
+    coex_sched_cb_t cbs[COEX_SCHED_MAX_CALLBACKS];
+
+    portENTER_CRITICAL(&s_sched_spinlock);
+    if (!s_sched_running || s_sched_slot_num == 0) {
+        portEXIT_CRITICAL(&s_sched_spinlock);
+        return;
+    }
+    slot = s_sched_slots[s_sched_slot_idx];
+    if (slot.radio != COEX_SCHED_IDLE_SLOT) {
+        s_sched_stats.grants[slot.radio]++;
+        s_sched_stats.airtime_ms[slot.radio] += slot.duration_ms;
+    }
+    if (s_sched_slot_idx == 0) {
+        /* New cycle: account links whose declared budget did not fit */
+        for (int i = 0; i < COEX_SCHED_RADIO_NUM; i++) {
+            if (s_sched_profiles[i].valid && s_sched_profiles[i].shortfall) {
+                s_sched_stats.denials[s_sched_profiles[i].profile.radio]++;
+            }
+        }
+    }
+    s_sched_slot_idx = (s_sched_slot_idx + 1) % s_sched_slot_num;
+    memcpy(cbs, s_sched_cbs, sizeof(cbs));
+    portEXIT_CRITICAL(&s_sched_spinlock);
+
+    /* Bias the coexistence library towards the granted radio */
+    if (slot.radio == ESP_COEX_ST_TYPE_WIFI) {
+        coex_preference_set(COEX_PREFER_WIFI);
+    } else if (slot.radio == COEX_SCHED_IDLE_SLOT) {
+        coex_preference_set(COEX_PREFER_BALANCE);
+    } else {
+        coex_preference_set(COEX_PREFER_BT);
+    }
+
+    if (slot.radio != COEX_SCHED_IDLE_SLOT) {
+        for (int i = 0; i < COEX_SCHED_MAX_CALLBACKS; i++) {
+            if (cbs[i].cb) {
+                cbs[i].cb((esp_coex_status_type_t)slot.radio, slot.duration_ms, cbs[i].arg);
+            }
+        }
+    }
+
+    esp_timer_start_once(s_sched_timer, (uint64_t)slot.duration_ms * 1000);
+}
+
+static esp_err_t coex_sched_start(void)
+{
+    if (s_sched_timer == NULL) {
+        const esp_timer_create_args_t args = {
+            .callback = coex_sched_timer_cb,
+            .name = "coex_sched",
+        };
+        esp_err_t err = esp_timer_create(&args, &s_sched_timer);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+    s_sched_running = true;
+    /* Kick the first slot immediately; the callback rearms itself */
+    esp_err_t err = esp_timer_start_once(s_sched_timer, 0);
+    if (err == ESP_ERR_INVALID_STATE) {
+        err = ESP_OK; /* already armed by a previous slot */
+    }
+    return err;
+}
+
+static void coex_sched_stop(void)
+{
+    s_sched_running = false;
+    if (s_sched_timer) {
+        esp_timer_stop(s_sched_timer);
+    }
+    coex_preference_set(COEX_PREFER_BALANCE);
+}
+
+esp_err_t esp_coex_traffic_profile_set(const esp_coex_traffic_profile_t *profile)
+{
+    if (profile == NULL || profile->radio > ESP_COEX_ST_TYPE_BT
+            || profile->traffic_class > ESP_COEX_TRAFFIC_LOW_LATENCY
+            || (profile->period_ms != 0 && profile->budget_ms > profile->period_ms)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&s_sched_spinlock);
+    s_sched_profiles[profile->radio].profile = *profile;
+    s_sched_profiles[profile->radio].valid = true;
+    coex_sched_build_cycle();
+    portEXIT_CRITICAL(&s_sched_spinlock);
+    ESP_LOGD(TAG, "scheduler: radio %d class %d period %u ms budget %u ms, cycle %u ms",
+             profile->radio, profile->traffic_class, profile->period_ms,
+             profile->budget_ms, s_sched_cycle_ms);
+    return coex_sched_start();
+}
+
+esp_err_t esp_coex_traffic_profile_clear(esp_coex_status_type_t radio)
+{
+    if (radio > ESP_COEX_ST_TYPE_BT) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    bool any_valid = false;
+    portENTER_CRITICAL(&s_sched_spinlock);
+    s_sched_profiles[radio].valid = false;
+    coex_sched_build_cycle();
+    for (int i = 0; i < COEX_SCHED_RADIO_NUM; i++) {
+        any_valid |= s_sched_profiles[i].valid;
+    }
+    portEXIT_CRITICAL(&s_sched_spinlock);
+    if (!any_valid) {
+        coex_sched_stop();
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_coex_grant_cb_register(esp_coex_grant_cb_t cb, void *arg)
+{
+    if (cb == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err = ESP_ERR_NO_MEM;
+    portENTER_CRITICAL(&s_sched_spinlock);
+    for (int i = 0; i < COEX_SCHED_MAX_CALLBACKS; i++) {
+        if (s_sched_cbs[i].cb == NULL) {
+            s_sched_cbs[i].cb = cb;
+            s_sched_cbs[i].arg = arg;
+            err = ESP_OK;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_sched_spinlock);
+    return err;
+}
+
+esp_err_t esp_coex_grant_cb_unregister(esp_coex_grant_cb_t cb)
+{
+    esp_err_t err = ESP_ERR_NOT_FOUND;
+    portENTER_CRITICAL(&s_sched_spinlock);
+    for (int i = 0; i < COEX_SCHED_MAX_CALLBACKS; i++) {
+        if (s_sched_cbs[i].cb == cb) {
+            s_sched_cbs[i].cb = NULL;
+            s_sched_cbs[i].arg = NULL;
+            err = ESP_OK;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_sched_spinlock);
+    return err;
+}
+
+esp_err_t esp_coex_scheduler_stats_get(esp_coex_scheduler_stats_t *stats)
+{
+    if (stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&s_sched_spinlock);
+    *stats = s_sched_stats;
+    portEXIT_CRITICAL(&s_sched_spinlock);
+    return ESP_OK;
+}
+
+void esp_coex_scheduler_stats_reset(void)
+{
+    portENTER_CRITICAL(&s_sched_spinlock);
+    uint32_t cycle_ms = s_sched_stats.cycle_ms;
+    memset(&s_sched_stats, 0, sizeof(s_sched_stats));
+    s_sched_stats.cycle_ms = cycle_ms;
+    portEXIT_CRITICAL(&s_sched_spinlock);
+}
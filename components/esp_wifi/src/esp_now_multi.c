@@ -0,0 +1,148 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <stdlib.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_now_multi.h"
+
+/* Batched ESPNOW sending with one aggregated completion per batch.
+
+   esp_now_send() fires one send callback per frame; at 100 frames/s the
+   callback dispatch alone costs real CPU on the WiFi task. This module
+   owns the single ESPNOW send callback slot, counts completions of an
+   in-flight batch (the driver confirms frames in submission order) and
+   reports all results in one callback. A per-frame callback can still be
+   chained for applications that mix batched and individual sends. */
+
+typedef struct {
+    esp_now_multi_cb_t cb;
+    void *arg;
+    size_t count;               /* items in the batch */
+    size_t completed;           /* items confirmed or failed at submission */
+    size_t next_status;         /* next driver confirmation goes here */
+    esp_now_send_status_t *status;
+} esp_now_batch_t;
+
+static portMUX_TYPE s_batch_lock = portMUX_INITIALIZER_UNLOCKED;
+static esp_now_batch_t *s_batch;            /* batch in flight, NULL if none */
+static esp_now_send_cb_t s_chained_send_cb;
+static bool s_initialized;
+
+static void esp_now_multi_finish_batch(esp_now_batch_t *batch)
+{
+    if (batch->cb != NULL) {
+        batch->cb(batch->status, batch->count, batch->arg);
+    }
+    free(batch);
+}
+
+static void esp_now_multi_send_cb(const uint8_t *mac_addr, esp_now_send_status_t status)
+{
+    esp_now_batch_t *done = NULL;
+
+    portENTER_CRITICAL(&s_batch_lock);
+    esp_now_batch_t *batch = s_batch;
+    if (batch != NULL && batch->next_status < batch->count) {
+        /* skip slots already filled by submission failures */
+        while (batch->next_status < batch->count
+               && batch->status[batch->next_status] != (esp_now_send_status_t) -1) {
+            batch->next_status++;
+        }
+        if (batch->next_status < batch->count) {
+            batch->status[batch->next_status++] = status;
+            batch->completed++;
+        }
+        if (batch->completed == batch->count) {
+            s_batch = NULL;
+            done = batch;
+        }
+    }
+    portEXIT_CRITICAL(&s_batch_lock);
+
+    if (s_chained_send_cb != NULL) {
+        s_chained_send_cb(mac_addr, status);
+    }
+    if (done != NULL) {
+        esp_now_multi_finish_batch(done);
+    }
+}
+
+esp_err_t esp_now_multi_init(void)
+{
+    esp_err_t err = esp_now_register_send_cb(esp_now_multi_send_cb);
+    if (err == ESP_OK) {
+        s_initialized = true;
+    }
+    return err;
+}
+
+esp_err_t esp_now_multi_register_send_cb(esp_now_send_cb_t cb)
+{
+    s_chained_send_cb = cb;
+    return ESP_OK;
+}
+
+esp_err_t esp_now_send_multi(const esp_now_multi_item_t *items, size_t count,
+                             esp_now_multi_cb_t cb, void *arg)
+{
+    if (!s_initialized) {
+        return ESP_ERR_ESPNOW_NOT_INIT;
+    }
+    if (items == NULL || count == 0) {
+        return ESP_ERR_ESPNOW_ARG;
+    }
+
+    esp_now_batch_t *batch = malloc(sizeof(esp_now_batch_t) + count * sizeof(esp_now_send_status_t));
+    if (batch == NULL) {
+        return ESP_ERR_ESPNOW_NO_MEM;
+    }
+    batch->cb = cb;
+    batch->arg = arg;
+    batch->count = count;
+    batch->completed = 0;
+    batch->next_status = 0;
+    batch->status = (esp_now_send_status_t *)(batch + 1);
+    /* -1 marks "confirmation pending" so the send callback can tell queued
+       items apart from ones that failed at submission */
+    memset(batch->status, 0xff, count * sizeof(esp_now_send_status_t));
+
+    portENTER_CRITICAL(&s_batch_lock);
+    if (s_batch != NULL) {
+        portEXIT_CRITICAL(&s_batch_lock);
+        free(batch);
+        return ESP_ERR_INVALID_STATE;
+    }
+    s_batch = batch;
+    portEXIT_CRITICAL(&s_batch_lock);
+
+    for (size_t i = 0; i < count; i++) {
+        esp_err_t err = esp_now_send(items[i].peer_addr, items[i].data, items[i].len);
+        if (err != ESP_OK) {
+            portENTER_CRITICAL(&s_batch_lock);
+            batch->status[i] = ESP_NOW_SEND_FAIL;
+            batch->completed++;
+            bool all_done = (batch->completed == batch->count);
+            if (all_done) {
+                s_batch = NULL;
+            }
+            portEXIT_CRITICAL(&s_batch_lock);
+            if (all_done) {
+                esp_now_multi_finish_batch(batch);
+                return ESP_OK;
+            }
+        }
+    }
+    return ESP_OK;
+}
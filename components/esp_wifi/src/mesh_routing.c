@@ -0,0 +1,212 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <stdlib.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_event.h"
+#include "esp_log.h"
+#include "esp_mesh_routing.h"
+
+/* MAC-indexed mirror of the mesh routing table with per-node counters.
+
+   The routing table proper lives inside the mesh library and is only
+   readable as a flat array, so membership checks on the forwarding path
+   are linear in the node count. This module mirrors the table into a
+   chained hash map keyed by MAC, rebuilt from esp_mesh_get_routing_table()
+   whenever the library reports MESH_EVENT_ROUTING_TABLE_ADD/REMOVE, and
+   attaches a statistics slot to every node so congested branches can be
+   spotted without instrumenting each call site. */
+
+static const char *TAG = "mesh_routing";
+
+#define ROUTE_HASH_BUCKETS 64   /* power of two, ~50 nodes at load factor < 1 */
+
+typedef struct route_node {
+    struct route_node *next;
+    mesh_addr_t addr;
+    esp_mesh_route_stats_t stats;
+} route_node_t;
+
+static route_node_t *s_buckets[ROUTE_HASH_BUCKETS];
+static portMUX_TYPE s_route_lock = portMUX_INITIALIZER_UNLOCKED;
+static bool s_initialized;
+
+static inline uint32_t route_hash(const uint8_t *mac)
+{
+    /* low MAC bytes carry the entropy on sequentially assigned addresses */
+    return ((uint32_t)mac[3] * 31 + mac[4] * 7 + mac[5]) & (ROUTE_HASH_BUCKETS - 1);
+}
+
+static route_node_t *route_find(const mesh_addr_t *addr)
+{
+    route_node_t *node = s_buckets[route_hash(addr->addr)];
+    while (node != NULL && memcmp(node->addr.addr, addr->addr, 6) != 0) {
+        node = node->next;
+    }
+    return node;
+}
+
+static void route_clear(void)
+{
+    for (int i = 0; i < ROUTE_HASH_BUCKETS; i++) {
+        route_node_t *node = s_buckets[i];
+        s_buckets[i] = NULL;
+        while (node != NULL) {
+            route_node_t *next = node->next;
+            free(node);
+            node = next;
+        }
+    }
+}
+
+static void route_rebuild(void)
+{
+    int table_size = esp_mesh_get_routing_table_size();
+    if (table_size <= 0) {
+        portENTER_CRITICAL(&s_route_lock);
+        route_clear();
+        portEXIT_CRITICAL(&s_route_lock);
+        return;
+    }
+    mesh_addr_t *table = malloc(table_size * sizeof(mesh_addr_t));
+    if (table == NULL) {
+        ESP_LOGW(TAG, "no memory to rebuild route cache (%d nodes)", table_size);
+        return;
+    }
+    int real_size = 0;
+    if (esp_mesh_get_routing_table(table, table_size * sizeof(mesh_addr_t), &real_size) != ESP_OK) {
+        free(table);
+        return;
+    }
+
+    /* Rebuild outside the lock, preserving statistics of surviving nodes */
+    route_node_t *new_buckets[ROUTE_HASH_BUCKETS] = { NULL };
+    for (int i = 0; i < real_size; i++) {
+        route_node_t *node = calloc(1, sizeof(route_node_t));
+        if (node == NULL) {
+            break;
+        }
+        memcpy(node->addr.addr, table[i].addr, 6);
+        portENTER_CRITICAL(&s_route_lock);
+        route_node_t *old = route_find(&table[i]);
+        if (old != NULL) {
+            node->stats = old->stats;
+        }
+        portEXIT_CRITICAL(&s_route_lock);
+        uint32_t bucket = route_hash(node->addr.addr);
+        node->next = new_buckets[bucket];
+        new_buckets[bucket] = node;
+    }
+    free(table);
+
+    portENTER_CRITICAL(&s_route_lock);
+    route_node_t *old_buckets[ROUTE_HASH_BUCKETS];
+    memcpy(old_buckets, s_buckets, sizeof(s_buckets));
+    memcpy(s_buckets, new_buckets, sizeof(s_buckets));
+    portEXIT_CRITICAL(&s_route_lock);
+
+    for (int i = 0; i < ROUTE_HASH_BUCKETS; i++) {
+        route_node_t *node = old_buckets[i];
+        while (node != NULL) {
+            route_node_t *next = node->next;
+            free(node);
+            node = next;
+        }
+    }
+}
+
+static void route_event_handler(void *arg, esp_event_base_t base, int32_t id, void *data)
+{
+    route_rebuild();
+}
+
+esp_err_t esp_mesh_route_cache_init(void)
+{
+    if (s_initialized) {
+        return ESP_OK;
+    }
+    esp_err_t err = esp_event_handler_register(MESH_EVENT, MESH_EVENT_ROUTING_TABLE_ADD,
+                                               &route_event_handler, NULL);
+    if (err != ESP_OK) {
+        return err;
+    }
+    err = esp_event_handler_register(MESH_EVENT, MESH_EVENT_ROUTING_TABLE_REMOVE,
+                                     &route_event_handler, NULL);
+    if (err != ESP_OK) {
+        esp_event_handler_unregister(MESH_EVENT, MESH_EVENT_ROUTING_TABLE_ADD, &route_event_handler);
+        return err;
+    }
+    s_initialized = true;
+    route_rebuild();
+    return ESP_OK;
+}
+
+esp_err_t esp_mesh_route_cache_deinit(void)
+{
+    if (!s_initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_event_handler_unregister(MESH_EVENT, MESH_EVENT_ROUTING_TABLE_ADD, &route_event_handler);
+    esp_event_handler_unregister(MESH_EVENT, MESH_EVENT_ROUTING_TABLE_REMOVE, &route_event_handler);
+    portENTER_CRITICAL(&s_route_lock);
+    route_clear();
+    portEXIT_CRITICAL(&s_route_lock);
+    s_initialized = false;
+    return ESP_OK;
+}
+
+bool esp_mesh_route_lookup(const mesh_addr_t *addr)
+{
+    if (addr == NULL) {
+        return false;
+    }
+    portENTER_CRITICAL(&s_route_lock);
+    bool found = (route_find(addr) != NULL);
+    portEXIT_CRITICAL(&s_route_lock);
+    return found;
+}
+
+esp_err_t esp_mesh_route_note_forward(const mesh_addr_t *addr, uint32_t bytes, uint32_t latency_us)
+{
+    if (addr == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&s_route_lock);
+    route_node_t *node = route_find(addr);
+    if (node != NULL) {
+        node->stats.fwd_packets++;
+        node->stats.fwd_bytes += bytes;
+        node->stats.latency_sum_us += latency_us;
+        if (latency_us > node->stats.latency_max_us) {
+            node->stats.latency_max_us = latency_us;
+        }
+    }
+    portEXIT_CRITICAL(&s_route_lock);
+    return (node != NULL) ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t esp_mesh_route_get_stats(const mesh_addr_t *addr, esp_mesh_route_stats_t *out_stats)
+{
+    if (addr == NULL || out_stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&s_route_lock);
+    route_node_t *node = route_find(addr);
+    if (node != NULL) {
+        *out_stats = node->stats;
+    }
+    portEXIT_CRITICAL(&s_route_lock);
+    return (node != NULL) ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
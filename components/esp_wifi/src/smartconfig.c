@@ -16,6 +16,7 @@
 #include <string.h>
 #include "esp_log.h"
 #include "esp_event_base.h"
+#include "esp_timer.h"
 #include "esp_private/wifi.h"
 #include "esp_smartconfig.h"
 #include "smartconfig_ack.h"
@@ -25,6 +26,18 @@ ESP_EVENT_DEFINE_BASE(SC_EVENT);
 
 static const char *TAG = "smartconfig";
 
+static sc_progress_cb_t s_progress_cb = NULL;
+static void *s_progress_cb_arg = NULL;
+static int64_t s_start_time_us = 0;
+
+static void handler_progress(void *arg, esp_event_base_t base, int32_t event_id, void *data)
+{
+    sc_progress_cb_t cb = s_progress_cb;
+    if (cb) {
+        cb((smartconfig_event_t)event_id, (uint32_t)((esp_timer_get_time() - s_start_time_us) / 1000), s_progress_cb_arg);
+    }
+}
+
 static void handler_got_ssid_passwd(void *arg, esp_event_base_t base, int32_t event_id, void *data)
 {
     smartconfig_event_got_ssid_pswd_t *evt = (smartconfig_event_got_ssid_pswd_t *)data;
@@ -57,8 +70,17 @@ esp_err_t esp_smartconfig_start(const smartconfig_start_config_t *config)
         return err;
     }
 
+    err = esp_event_handler_register(SC_EVENT, ESP_EVENT_ANY_ID, handler_progress, NULL);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Register smartconfig progress event handler fail!");
+        esp_event_handler_unregister(SC_EVENT, SC_EVENT_GOT_SSID_PSWD, handler_got_ssid_passwd);
+        return err;
+    }
+
+    s_start_time_us = esp_timer_get_time();
     err = esp_smartconfig_internal_start(config);
     if (err != ESP_OK) {
+        esp_event_handler_unregister(SC_EVENT, ESP_EVENT_ANY_ID, handler_progress);
         esp_event_handler_unregister(SC_EVENT, SC_EVENT_GOT_SSID_PSWD, handler_got_ssid_passwd);
     }
     return err;
@@ -71,7 +93,15 @@ esp_err_t esp_smartconfig_stop(void)
     err = esp_smartconfig_internal_stop();
     if (err == ESP_OK) {
         sc_send_ack_stop();
+        esp_event_handler_unregister(SC_EVENT, ESP_EVENT_ANY_ID, handler_progress);
         esp_event_handler_unregister(SC_EVENT, SC_EVENT_GOT_SSID_PSWD, handler_got_ssid_passwd);
     }
     return err;
 }
+
+esp_err_t esp_smartconfig_set_progress_cb(sc_progress_cb_t cb, void *arg)
+{
+    s_progress_cb_arg = arg;
+    s_progress_cb = cb;
+    return ESP_OK;
+}
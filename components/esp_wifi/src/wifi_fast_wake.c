@@ -0,0 +1,169 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include "esp_wifi.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "esp_wifi_fast_wake.h"
+
+#ifdef CONFIG_ESP32_WIFI_FAST_WAKE
+
+/* Fast wake: pre-arm the RF ahead of known periodic traffic.
+
+   The power save negotiation happens inside the WiFi driver, so the
+   knob available to us is the power save mode itself: a periodic
+   esp_timer drops to WIFI_PS_NONE shortly before each expected traffic
+   burst and restores the previous mode once the window closes. While a
+   window is open, the netif glue reports received frames here so the
+   beacon-wake -> first-RX latency can be read back as counters and a
+   histogram instead of being invisible. */
+
+static const char *TAG = "wifi_fast_wake";
+
+static esp_timer_handle_t s_wake_timer;     /* periodic, opens the window */
+static esp_timer_handle_t s_sleep_timer;    /* one shot, closes the window */
+static wifi_ps_type_t s_saved_ps_mode;
+static uint64_t s_active_us;
+static volatile int64_t s_window_open_us;   /* 0 when no window is open */
+static volatile bool s_rx_seen_in_window;
+static esp_wifi_fast_wake_stats_t s_stats = {
+    .first_rx_min_us = UINT32_MAX,
+};
+
+static void fast_wake_open_window(void *arg)
+{
+    esp_err_t err = esp_wifi_set_ps(WIFI_PS_NONE);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "failed to leave power save (0x%x)", err);
+        return;
+    }
+    s_rx_seen_in_window = false;
+    s_window_open_us = esp_timer_get_time();
+    s_stats.windows++;
+    esp_timer_start_once(s_sleep_timer, s_active_us);
+}
+
+static void fast_wake_close_window(void *arg)
+{
+    s_window_open_us = 0;
+    esp_err_t err = esp_wifi_set_ps(s_saved_ps_mode);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "failed to restore power save mode (0x%x)", err);
+    }
+}
+
+void esp_wifi_fast_wake_note_rx(void)
+{
+    int64_t window_open = s_window_open_us;
+    if (window_open == 0 || s_rx_seen_in_window) {
+        return;
+    }
+    s_rx_seen_in_window = true;
+    uint32_t latency = (uint32_t)(esp_timer_get_time() - window_open);
+    s_stats.windows_with_rx++;
+    s_stats.first_rx_sum_us += latency;
+    if (latency < s_stats.first_rx_min_us) {
+        s_stats.first_rx_min_us = latency;
+    }
+    if (latency > s_stats.first_rx_max_us) {
+        s_stats.first_rx_max_us = latency;
+    }
+    uint32_t ms = latency / 1000;
+    int bucket = 0;
+    while (bucket < 7 && ms >= (1u << bucket)) {
+        bucket++;
+    }
+    s_stats.first_rx_hist[bucket]++;
+}
+
+esp_err_t esp_wifi_fast_wake_start(const esp_wifi_fast_wake_config_t *config)
+{
+    if (config == NULL || config->period_us == 0
+            || config->lead_us + config->active_us >= config->period_us) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_wake_timer != NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_err_t err = esp_wifi_get_ps(&s_saved_ps_mode);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    const esp_timer_create_args_t wake_args = {
+        .callback = fast_wake_open_window,
+        .name = "wifi_fwake",
+    };
+    const esp_timer_create_args_t sleep_args = {
+        .callback = fast_wake_close_window,
+        .name = "wifi_fsleep",
+    };
+    err = esp_timer_create(&wake_args, &s_wake_timer);
+    if (err != ESP_OK) {
+        return err;
+    }
+    err = esp_timer_create(&sleep_args, &s_sleep_timer);
+    if (err != ESP_OK) {
+        esp_timer_delete(s_wake_timer);
+        s_wake_timer = NULL;
+        return err;
+    }
+
+    s_active_us = config->lead_us + config->active_us;
+    /* first window opens one lead time from now, then every period */
+    err = esp_timer_start_periodic(s_wake_timer, config->period_us);
+    if (err != ESP_OK) {
+        esp_timer_delete(s_sleep_timer);
+        esp_timer_delete(s_wake_timer);
+        s_sleep_timer = NULL;
+        s_wake_timer = NULL;
+        return err;
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_fast_wake_stop(void)
+{
+    if (s_wake_timer == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_timer_stop(s_wake_timer);
+    esp_timer_stop(s_sleep_timer);
+    if (s_window_open_us != 0) {
+        fast_wake_close_window(NULL);
+    }
+    esp_timer_delete(s_wake_timer);
+    esp_timer_delete(s_sleep_timer);
+    s_wake_timer = NULL;
+    s_sleep_timer = NULL;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_fast_wake_get_stats(esp_wifi_fast_wake_stats_t *out_stats)
+{
+    if (out_stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    memcpy(out_stats, &s_stats, sizeof(s_stats));
+    return ESP_OK;
+}
+
+void esp_wifi_fast_wake_reset_stats(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_stats.first_rx_min_us = UINT32_MAX;
+}
+
+#endif // CONFIG_ESP32_WIFI_FAST_WAKE
@@ -14,8 +14,15 @@
 #include "esp_wifi.h"
 #include "esp_netif.h"
 #include "esp_log.h"
+#ifdef CONFIG_ESP32_WIFI_RX_BUFFER_LOAN
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#endif
 #include "esp_private/wifi.h"
 #include "esp_wifi_netif.h"
+#ifdef CONFIG_ESP32_WIFI_FAST_WAKE
+#include "esp_wifi_fast_wake.h"
+#endif
 
 //
 //  Purpose of this module is provide object oriented abstraction to wifi interfaces
@@ -38,22 +45,178 @@ static const char* TAG = "wifi_netif";
 static esp_netif_receive_t s_wifi_rxcbs[MAX_WIFI_IFS] = { NULL };
 static esp_netif_t *s_wifi_netifs[MAX_WIFI_IFS] = { NULL };
 
+#ifdef CONFIG_ESP32_WIFI_RX_BACKPRESSURE
+/**
+ * @brief RX buffer backpressure accounting
+ *
+ * Counts driver RX buffers currently held by the network stack (handed up
+ * in the receive callbacks, returned through wifi_free). Crossing the high
+ * watermark fires the registered callback with above_high=true, dropping
+ * back below the low watermark fires it with above_high=false.
+ */
+static volatile int32_t s_rx_outstanding;
+static bool s_rx_pressured;
+static uint16_t s_rx_high_watermark;
+static uint16_t s_rx_low_watermark;
+static esp_wifi_rx_backpressure_cb_t s_rx_backpressure_cb;
+static void *s_rx_backpressure_arg;
+
+static inline void wifi_rx_account(int32_t delta)
+{
+    int32_t outstanding = __sync_add_and_fetch(&s_rx_outstanding, delta);
+    esp_wifi_rx_backpressure_cb_t cb = s_rx_backpressure_cb;
+    if (cb == NULL) {
+        return;
+    }
+    if (!s_rx_pressured && outstanding >= s_rx_high_watermark) {
+        s_rx_pressured = true;
+        cb(true, outstanding, s_rx_backpressure_arg);
+    } else if (s_rx_pressured && outstanding <= s_rx_low_watermark) {
+        s_rx_pressured = false;
+        cb(false, outstanding, s_rx_backpressure_arg);
+    }
+}
+
+esp_err_t esp_wifi_set_rx_backpressure_cb(uint16_t high_watermark, uint16_t low_watermark,
+                                          esp_wifi_rx_backpressure_cb_t cb, void *arg)
+{
+    if (cb != NULL && (high_watermark == 0 || low_watermark >= high_watermark)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    s_rx_backpressure_cb = NULL;    // quiesce before swapping the parameters
+    s_rx_high_watermark = high_watermark;
+    s_rx_low_watermark = low_watermark;
+    s_rx_backpressure_arg = arg;
+    s_rx_pressured = false;
+    s_rx_backpressure_cb = cb;
+    return ESP_OK;
+}
+
+int32_t esp_wifi_get_rx_outstanding(void)
+{
+    return s_rx_outstanding;
+}
+#endif // CONFIG_ESP32_WIFI_RX_BACKPRESSURE
+
+#ifdef CONFIG_ESP32_WIFI_RX_BUFFER_LOAN
+/**
+ * @brief Zero-copy RX hook with a buffer-loan contract
+ *
+ * The hook sees every frame before the TCP/IP stack. When it returns true
+ * (and the frame has a driver buffer), ownership of that buffer is loaned
+ * to the hook's consumer, which must hand it back with
+ * esp_wifi_return_rx_buffer(). Loaned frames bypass the stack entirely,
+ * so capture runs without a per-frame copy or allocation.
+ */
+static esp_wifi_rx_hook_t s_rx_hook;
+static void *s_rx_hook_arg;
+static QueueHandle_t s_rx_loan_queue;
+
+static inline bool wifi_rx_hook_consumed(wifi_interface_t ifx, void *buffer, uint16_t len, void *eb)
+{
+    esp_wifi_rx_hook_t hook = s_rx_hook;
+    if (hook == NULL || !hook(ifx, buffer, len, eb, s_rx_hook_arg)) {
+        return false;
+    }
+    // Frames without a driver buffer cannot be retained; pass them on
+    return eb != NULL;
+}
+
+esp_err_t esp_wifi_set_rx_hook(esp_wifi_rx_hook_t hook, void *arg)
+{
+    s_rx_hook = NULL;   // quiesce before swapping the argument
+    s_rx_hook_arg = arg;
+    s_rx_hook = hook;
+    return ESP_OK;
+}
+
+void esp_wifi_return_rx_buffer(void *eb)
+{
+#ifdef CONFIG_ESP32_WIFI_RX_BACKPRESSURE
+    if (eb) {
+        wifi_rx_account(-1);
+    }
+#endif
+    esp_wifi_internal_free_rx_buffer(eb);
+}
+
+esp_err_t esp_wifi_rx_loan_pool_init(uint16_t depth)
+{
+    if (depth == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_rx_loan_queue != NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    s_rx_loan_queue = xQueueCreate(depth, sizeof(esp_wifi_rx_loan_t));
+    if (s_rx_loan_queue == NULL) {
+        ESP_LOGE(TAG, "No memory for RX loan pool of depth %d", depth);
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+bool esp_wifi_rx_loan_push(const esp_wifi_rx_loan_t *loan)
+{
+    if (s_rx_loan_queue == NULL) {
+        return false;
+    }
+    return xQueueSend(s_rx_loan_queue, loan, 0) == pdTRUE;
+}
+
+bool esp_wifi_rx_loan_pop(esp_wifi_rx_loan_t *loan, uint32_t timeout_ms)
+{
+    if (s_rx_loan_queue == NULL) {
+        return false;
+    }
+    return xQueueReceive(s_rx_loan_queue, loan, pdMS_TO_TICKS(timeout_ms)) == pdTRUE;
+}
+#endif // CONFIG_ESP32_WIFI_RX_BUFFER_LOAN
+
 /**
  * @brief WiFi netif driver IO functions, a thin glue layer
  *         to the original wifi interface API
  */
 static esp_err_t wifi_sta_receive(void *buffer, uint16_t len, void *eb)
 {
+#ifdef CONFIG_ESP32_WIFI_RX_BACKPRESSURE
+    if (eb) {
+        wifi_rx_account(1);
+    }
+#endif
+#ifdef CONFIG_ESP32_WIFI_FAST_WAKE
+    esp_wifi_fast_wake_note_rx();
+#endif
+#ifdef CONFIG_ESP32_WIFI_RX_BUFFER_LOAN
+    if (wifi_rx_hook_consumed(WIFI_IF_STA, buffer, len, eb)) {
+        return ESP_OK;
+    }
+#endif
     return s_wifi_rxcbs[WIFI_IF_STA](s_wifi_netifs[WIFI_IF_STA], buffer, len, eb);
 }
 
 static esp_err_t wifi_ap_receive(void *buffer, uint16_t len, void *eb)
 {
+#ifdef CONFIG_ESP32_WIFI_RX_BACKPRESSURE
+    if (eb) {
+        wifi_rx_account(1);
+    }
+#endif
+#ifdef CONFIG_ESP32_WIFI_RX_BUFFER_LOAN
+    if (wifi_rx_hook_consumed(WIFI_IF_AP, buffer, len, eb)) {
+        return ESP_OK;
+    }
+#endif
     return s_wifi_rxcbs[WIFI_IF_AP](s_wifi_netifs[WIFI_IF_AP], buffer, len, eb);
 }
 
 static void wifi_free(void *h, void* buffer)
 {
+#ifdef CONFIG_ESP32_WIFI_RX_BACKPRESSURE
+    if (buffer) {
+        wifi_rx_account(-1);
+    }
+#endif
     esp_wifi_internal_free_rx_buffer(buffer);
 }
 
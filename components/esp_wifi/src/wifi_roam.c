@@ -0,0 +1,318 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <stdlib.h>
+#include "esp_wifi.h"
+#include "esp_event.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_wifi_roam.h"
+
+#ifdef CONFIG_ESP32_WIFI_ROAM
+
+/* Roaming engine.
+
+   The stock behaviour on a weakening link is to ride it down, lose the
+   association, scan every channel and reassociate — a 1-4 s outage
+   dominated by the scan. This engine keeps a ranked table of same-SSID
+   candidates warm through short background scans while the link is
+   still good, and when the current AP degrades it reassociates directly
+   to the best candidate with BSSID and channel pinned, so the connect
+   path skips the scan entirely and the gap shrinks to the
+   deauth/auth/assoc exchange.
+
+   Off-channel scheduling of the scans and the 802.11 power save
+   interplay happen inside the WiFi driver; the same is true of
+   802.11r/k/v, which the driver on this chip does not expose. What this
+   engine removes is the scan-while-disconnected, which is where nearly
+   all of the observed outage goes. */
+
+#define ROAM_MAX_CANDIDATES     8
+#define ROAM_SCAN_MAX_RECORDS   24
+
+/* phases of a roam in flight */
+typedef enum {
+    ROAM_IDLE = 0,
+    ROAM_AWAIT_DISCONNECT,      /* we asked the driver to drop the old AP */
+    ROAM_CONNECTING,            /* directed connect to the candidate running */
+} roam_phase_t;
+
+static const char *TAG = "wifi_roam";
+
+static esp_wifi_roam_config_t s_cfg;
+static bool s_running;
+static esp_timer_handle_t s_monitor_timer;
+static esp_event_handler_instance_t s_wifi_handler;
+static int64_t s_last_scan_us;
+static volatile bool s_scan_pending;        /* a scan we issued is in flight */
+static roam_phase_t s_phase;
+static int64_t s_roam_start_us;
+
+static wifi_ap_record_t s_candidates[ROAM_MAX_CANDIDATES];
+static size_t s_candidate_count;
+static portMUX_TYPE s_roam_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static esp_wifi_roam_stats_t s_stats;
+
+static void roam_issue_scan(void)
+{
+    wifi_config_t cfg;
+    if (esp_wifi_get_config(WIFI_IF_STA, &cfg) != ESP_OK) {
+        return;
+    }
+    /* directed scan for our own SSID with short dwells: the driver runs
+       it off-channel between beacons while we stay associated */
+    wifi_scan_config_t scan = {
+        .ssid = cfg.sta.ssid,
+        .scan_type = WIFI_SCAN_TYPE_ACTIVE,
+        .scan_time.active = {
+            .min = 30,
+            .max = 60,
+        },
+    };
+    if (esp_wifi_scan_start(&scan, false) == ESP_OK) {
+        s_scan_pending = true;
+        s_last_scan_us = esp_timer_get_time();
+        s_stats.scans++;
+    }
+}
+
+static void roam_to(const wifi_ap_record_t *cand)
+{
+    wifi_config_t cfg;
+    if (esp_wifi_get_config(WIFI_IF_STA, &cfg) != ESP_OK) {
+        return;
+    }
+    memcpy(cfg.sta.bssid, cand->bssid, sizeof(cfg.sta.bssid));
+    cfg.sta.bssid_set = 1;
+    cfg.sta.channel = cand->primary;
+    if (esp_wifi_set_config(WIFI_IF_STA, &cfg) != ESP_OK) {
+        return;
+    }
+    ESP_LOGI(TAG, "roaming to %02x:%02x:%02x:%02x:%02x:%02x ch %d rssi %d",
+             cand->bssid[0], cand->bssid[1], cand->bssid[2],
+             cand->bssid[3], cand->bssid[4], cand->bssid[5],
+             cand->primary, cand->rssi);
+    s_phase = ROAM_AWAIT_DISCONNECT;
+    s_roam_start_us = esp_timer_get_time();
+    esp_wifi_disconnect();
+}
+
+/* Drop the BSSID pin again so later reconnects (ours or the driver's)
+   are free to pick any AP of the SSID */
+static void roam_unpin(void)
+{
+    wifi_config_t cfg;
+    if (esp_wifi_get_config(WIFI_IF_STA, &cfg) == ESP_OK && cfg.sta.bssid_set) {
+        cfg.sta.bssid_set = 0;
+        cfg.sta.channel = 0;
+        esp_wifi_set_config(WIFI_IF_STA, &cfg);
+    }
+}
+
+static void roam_harvest_scan(void)
+{
+    uint16_t num = ROAM_SCAN_MAX_RECORDS;
+    wifi_ap_record_t *records = calloc(num, sizeof(wifi_ap_record_t));
+    if (records == NULL) {
+        /* records must still be drained to free driver memory */
+        num = 0;
+        esp_wifi_scan_get_ap_records(&num, NULL);
+        return;
+    }
+    if (esp_wifi_scan_get_ap_records(&num, records) != ESP_OK) {
+        free(records);
+        return;
+    }
+
+    wifi_ap_record_t current = { 0 };
+    bool associated = (esp_wifi_sta_get_ap_info(&current) == ESP_OK);
+
+    /* insertion sort of same-SSID candidates, best RSSI first */
+    wifi_ap_record_t ranked[ROAM_MAX_CANDIDATES];
+    size_t count = 0;
+    for (uint16_t i = 0; i < num; i++) {
+        if (associated && memcmp(records[i].bssid, current.bssid, 6) == 0) {
+            continue;
+        }
+        size_t pos = count;
+        while (pos > 0 && ranked[pos - 1].rssi < records[i].rssi) {
+            pos--;
+        }
+        if (pos >= ROAM_MAX_CANDIDATES) {
+            continue;
+        }
+        size_t tail = (count < ROAM_MAX_CANDIDATES) ? count : ROAM_MAX_CANDIDATES - 1;
+        memmove(&ranked[pos + 1], &ranked[pos], (tail - pos) * sizeof(ranked[0]));
+        ranked[pos] = records[i];
+        if (count < ROAM_MAX_CANDIDATES) {
+            count++;
+        }
+    }
+    free(records);
+
+    portENTER_CRITICAL(&s_roam_lock);
+    memcpy(s_candidates, ranked, count * sizeof(ranked[0]));
+    s_candidate_count = count;
+    portEXIT_CRITICAL(&s_roam_lock);
+
+    /* roam decision: link weak and a clearly better AP in the table */
+    if (associated && s_phase == ROAM_IDLE && count > 0 &&
+            current.rssi < s_cfg.roam_rssi_threshold &&
+            ranked[0].rssi >= current.rssi + s_cfg.better_ap_margin) {
+        roam_to(&ranked[0]);
+    }
+}
+
+static void roam_wifi_event(void *arg, esp_event_base_t base, int32_t id, void *data)
+{
+    switch (id) {
+    case WIFI_EVENT_SCAN_DONE:
+        if (s_scan_pending) {
+            s_scan_pending = false;
+            roam_harvest_scan();
+        }
+        break;
+    case WIFI_EVENT_STA_DISCONNECTED:
+        if (s_phase == ROAM_AWAIT_DISCONNECT) {
+            s_phase = ROAM_CONNECTING;
+            if (esp_wifi_connect() != ESP_OK) {
+                s_phase = ROAM_IDLE;
+                s_stats.roams_failed++;
+                roam_unpin();
+                esp_wifi_connect();
+            }
+        } else if (s_phase == ROAM_CONNECTING) {
+            /* the candidate refused us: fall back to a normal reconnect */
+            s_phase = ROAM_IDLE;
+            s_stats.roams_failed++;
+            roam_unpin();
+            esp_wifi_connect();
+        }
+        break;
+    case WIFI_EVENT_STA_CONNECTED:
+        if (s_phase == ROAM_CONNECTING) {
+            s_phase = ROAM_IDLE;
+            s_stats.roams++;
+            s_stats.last_roam_ms = (uint32_t)((esp_timer_get_time() - s_roam_start_us) / 1000);
+            ESP_LOGI(TAG, "roam complete in %u ms", s_stats.last_roam_ms);
+            roam_unpin();
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static void roam_monitor(void *arg)
+{
+    if (s_phase != ROAM_IDLE || s_scan_pending) {
+        return;
+    }
+    wifi_ap_record_t current;
+    if (esp_wifi_sta_get_ap_info(&current) != ESP_OK) {
+        return;     /* not associated, nothing to roam from */
+    }
+    int64_t since_scan = esp_timer_get_time() - s_last_scan_us;
+    if (current.rssi < s_cfg.roam_rssi_threshold) {
+        /* weak link: refresh candidates at the monitor cadence */
+        if (since_scan > (int64_t)s_cfg.monitor_interval_ms * 1000) {
+            roam_issue_scan();
+        }
+    } else if (since_scan > (int64_t)s_cfg.scan_interval_ms * 1000) {
+        /* healthy link: keep the table warm in the background */
+        roam_issue_scan();
+    }
+}
+
+esp_err_t esp_wifi_roam_start(const esp_wifi_roam_config_t *config)
+{
+    if (config == NULL || config->monitor_interval_ms == 0 || config->scan_interval_ms == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    s_cfg = *config;
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_candidate_count = 0;
+    s_phase = ROAM_IDLE;
+    s_scan_pending = false;
+    s_last_scan_us = 0;
+
+    esp_err_t err = esp_event_handler_instance_register(WIFI_EVENT, ESP_EVENT_ANY_ID,
+                                                        roam_wifi_event, NULL, &s_wifi_handler);
+    if (err != ESP_OK) {
+        return err;
+    }
+    const esp_timer_create_args_t timer_args = {
+        .callback = roam_monitor,
+        .name = "wifi_roam",
+    };
+    err = esp_timer_create(&timer_args, &s_monitor_timer);
+    if (err != ESP_OK) {
+        esp_event_handler_instance_unregister(WIFI_EVENT, ESP_EVENT_ANY_ID, s_wifi_handler);
+        return err;
+    }
+    err = esp_timer_start_periodic(s_monitor_timer, (uint64_t)s_cfg.monitor_interval_ms * 1000);
+    if (err != ESP_OK) {
+        esp_timer_delete(s_monitor_timer);
+        s_monitor_timer = NULL;
+        esp_event_handler_instance_unregister(WIFI_EVENT, ESP_EVENT_ANY_ID, s_wifi_handler);
+        return err;
+    }
+    s_running = true;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_roam_stop(void)
+{
+    if (!s_running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_timer_stop(s_monitor_timer);
+    esp_timer_delete(s_monitor_timer);
+    s_monitor_timer = NULL;
+    esp_event_handler_instance_unregister(WIFI_EVENT, ESP_EVENT_ANY_ID, s_wifi_handler);
+    portENTER_CRITICAL(&s_roam_lock);
+    s_candidate_count = 0;
+    portEXIT_CRITICAL(&s_roam_lock);
+    s_running = false;
+    return ESP_OK;
+}
+
+size_t esp_wifi_roam_get_candidates(wifi_ap_record_t *records, size_t max)
+{
+    if (records == NULL) {
+        return 0;
+    }
+    portENTER_CRITICAL(&s_roam_lock);
+    size_t count = (s_candidate_count < max) ? s_candidate_count : max;
+    memcpy(records, s_candidates, count * sizeof(records[0]));
+    portEXIT_CRITICAL(&s_roam_lock);
+    return count;
+}
+
+esp_err_t esp_wifi_roam_get_stats(esp_wifi_roam_stats_t *stats)
+{
+    if (stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *stats = s_stats;
+    return ESP_OK;
+}
+
+#endif /* CONFIG_ESP32_WIFI_ROAM */
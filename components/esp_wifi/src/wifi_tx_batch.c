@@ -0,0 +1,64 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "esp_err.h"
+#include "esp_private/wifi.h"
+
+/* Batched TX submission.
+
+   Fanning out N small frames (mesh telemetry, unicast multicast emulation)
+   costs one full trip into the driver per frame plus per-call argument
+   marshalling in the caller. This wrapper submits an array of frames in
+   one call and collects per-frame status, so the caller's loop, error
+   handling and any serialization around the TX path run once per batch
+   instead of once per frame. Frames with a netstack_buf go through the
+   by-reference path (no copy); the rest are copied by the driver as with
+   esp_wifi_internal_tx().
+
+   The driver itself is a prebuilt library, so the frames still enter it
+   one by one — the aggregation a single MAC doorbell would need has to
+   happen on the driver side. The AMPDU aggregation already running there
+   coalesces back-to-back submissions from one batch into shared TX
+   opportunities, which is where the airtime win comes from. */
+
+esp_err_t esp_wifi_internal_tx_batch(const esp_wifi_tx_item_t *items, size_t count,
+                                     esp_err_t *out_status, size_t *out_sent)
+{
+    if (items == NULL || count == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    size_t sent = 0;
+    esp_err_t first_err = ESP_OK;
+    for (size_t i = 0; i < count; i++) {
+        esp_err_t err;
+        if (items[i].netstack_buf != NULL) {
+            err = esp_wifi_internal_tx_by_ref(items[i].ifx, items[i].buffer,
+                                              items[i].len, items[i].netstack_buf);
+        } else {
+            err = esp_wifi_internal_tx(items[i].ifx, items[i].buffer, items[i].len);
+        }
+        if (out_status != NULL) {
+            out_status[i] = err;
+        }
+        if (err == ESP_OK) {
+            sent++;
+        } else if (first_err == ESP_OK) {
+            first_err = err;
+        }
+    }
+    if (out_sent != NULL) {
+        *out_sent = sent;
+    }
+    return first_err;
+}
@@ -645,6 +645,8 @@ class ESPCoreDumpLoader(ESPCoreDumpVersion):
     ESP_COREDUMP_CRC_SZ = struct.calcsize(ESP_COREDUMP_CRC_FMT)
     ESP_COREDUMP_SHA256_FMT = '32c'
     ESP_COREDUMP_SHA256_SZ = struct.calcsize(ESP_COREDUMP_SHA256_FMT)
+    # set in the version field when CONFIG_ESP_COREDUMP_COMPRESSED is enabled
+    ESP_COREDUMP_VERSION_FLAG_COMPRESSED = 0x8000
 
     def __init__(self):
         """Base constructor for core dump loader
@@ -758,6 +760,69 @@ class ESPCoreDumpLoader(ESPCoreDumpVersion):
         self.temp_files.append(t.name)
         return t
 
+    @staticmethod
+    def _lz_decompress(data):
+        """ Decodes the LZ token stream produced by core_dump_stream.c:
+            flag byte per 8 tokens (LSB first, 1 - literal byte,
+            0 - match: <dist & 0xFF> <(dist >> 8) << 5 | (len - 3)>)
+        """
+        data = bytearray(data)
+        out = bytearray()
+        i = 0
+        flags = 0
+        nbits = 0
+        while i < len(data):
+            if nbits == 0:
+                flags = data[i]
+                i += 1
+                nbits = 8
+                if i >= len(data):
+                    break
+            if flags & 1:
+                out.append(data[i])
+                i += 1
+            else:
+                if i + 1 >= len(data):
+                    raise ESPCoreDumpLoaderError("Compressed core dump is truncated!")
+                dist = ((data[i + 1] >> 5) << 8) | data[i]
+                length = (data[i + 1] & 0x1f) + 3
+                i += 2
+                if dist == 0 or dist > len(out):
+                    raise ESPCoreDumpLoaderError("Invalid match in compressed core dump!")
+                for _ in range(length):
+                    out.append(out[-dist])
+            flags >>= 1
+            nbits -= 1
+        return bytes(out)
+
+    def _decompress_corefile(self):
+        """ Replaces the source core file with its decompressed image.
+            Everything between the core dump header and the trailing checksum
+            is a compressed stream; the header itself is stored plain.
+        """
+        self.set_version(self.hdr['ver'] & ~self.ESP_COREDUMP_VERSION_FLAG_COMPRESSED)
+        if self.dump_ver == self.ESP_COREDUMP_VERSION_ELF_SHA256:
+            cs_len = self.ESP_COREDUMP_SHA256_SZ
+        else:
+            cs_len = self.ESP_COREDUMP_CRC_SZ
+        self.core_src_file.seek(self.ESP_COREDUMP_HDR_SZ)
+        data = self.core_src_file.read()
+        if len(data) < cs_len:
+            raise ESPCoreDumpLoaderError("Compressed core dump is truncated!")
+        payload = self._lz_decompress(data[:len(data) - cs_len])
+        checksum = data[len(data) - cs_len:]
+        self.hdr['ver'] &= ~self.ESP_COREDUMP_VERSION_FLAG_COMPRESSED
+        self.hdr['tot_len'] = self.ESP_COREDUMP_HDR_SZ + len(payload) + cs_len
+        plain_file = self.create_temp_file()
+        plain_file.write(struct.pack(self.ESP_COREDUMP_HDR_FMT, self.hdr['tot_len'], self.hdr['ver'],
+                                     self.hdr['task_num'], self.hdr['tcbsz'], self.hdr['segs_num']))
+        plain_file.write(payload)
+        plain_file.write(checksum)
+        plain_file.flush()
+        plain_file.seek(0)
+        self.core_src_file.close()
+        self.core_src_file = plain_file
+
     def tcb_is_sane(self, tcb_addr, tcb_size):
         """Check tcb address if it is correct
         """
@@ -931,6 +996,8 @@ class ESPCoreDumpLoader(ESPCoreDumpVersion):
         vals = struct.unpack_from(self.ESP_COREDUMP_HDR_FMT, data)
         self.hdr = dict(zip(('tot_len', 'ver', 'task_num', 'tcbsz', 'segs_num'), vals))
         self.core_elf_file = self.create_temp_file()
+        if self.hdr['ver'] & self.ESP_COREDUMP_VERSION_FLAG_COMPRESSED:
+            self._decompress_corefile()
         self.set_version(self.hdr['ver'])
         if self.chip_ver == ESPCoreDumpVersion.ESP_CORE_DUMP_CHIP_ESP32S2 or self.chip_ver == ESPCoreDumpVersion.ESP_CORE_DUMP_CHIP_ESP32:
             if self.dump_ver == self.ESP_COREDUMP_VERSION_ELF_CRC32 or self.dump_ver == self.ESP_COREDUMP_VERSION_ELF_SHA256:
@@ -52,6 +52,9 @@ extern "C" {
 #define COREDUMP_VERSION_BIN_CURRENT        COREDUMP_VERSION_MAKE(COREDUMP_VERSION_BIN, 2) // -> 0x0002
 #define COREDUMP_VERSION_ELF_CRC32          COREDUMP_VERSION_MAKE(COREDUMP_VERSION_ELF, 0) // -> 0x0100
 #define COREDUMP_VERSION_ELF_SHA256         COREDUMP_VERSION_MAKE(COREDUMP_VERSION_ELF, 1) // -> 0x0101
+// set in the version field when the data after the header is compressed
+// by the streaming writer (see core_dump_stream.c)
+#define COREDUMP_VERSION_FLAG_COMPRESSED    0x8000
 #define COREDUMP_CURR_TASK_MARKER           0xDEADBEEF
 #define COREDUMP_CURR_TASK_NOT_FOUND        -1
 
@@ -141,6 +144,11 @@ void esp_core_dump_flash_init(void);
 // Common core dump write function
 void esp_core_dump_write(panic_info_t *info, core_dump_write_config_t *write_cfg);
 
+// Wraps a transport write config with the streaming filter (chunked writes
+// with watchdog feeding, optional compression)
+void esp_core_dump_stream_init(core_dump_write_config_t *stream_cfg,
+                               core_dump_write_config_t *base_cfg);
+
 #include "esp_core_dump_port.h"
 
 #ifdef __cplusplus
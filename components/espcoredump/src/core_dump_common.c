@@ -196,6 +196,9 @@ static esp_err_t esp_core_dump_write_binary(panic_info_t *info, core_dump_write_
     // Write header
     hdr.data_len  = data_len;
     hdr.version   = COREDUMP_VERSION;
+#if CONFIG_ESP_COREDUMP_COMPRESSED
+    hdr.version  |= COREDUMP_VERSION_FLAG_COMPRESSED; // data after the header is compressed
+#endif
     hdr.tasks_num = task_num; // save all the tasks in snapshot even broken
     hdr.mem_segs_num = 0;
     if (esp_core_dump_in_isr_context()) {
@@ -284,6 +287,11 @@ inline void esp_core_dump_write(panic_info_t *info, core_dump_write_config_t *wr
 
 #ifndef CONFIG_ESP_COREDUMP_ENABLE_TO_NONE
     esp_err_t err = ESP_ERR_NOT_SUPPORTED;
+    // route the dump through the streaming filter: chunked writes with
+    // watchdog feeding (and compression, when enabled) on top of the transport
+    core_dump_write_config_t stream_cfg;
+    esp_core_dump_stream_init(&stream_cfg, write_cfg);
+    write_cfg = &stream_cfg;
 #if CONFIG_ESP_COREDUMP_DATA_FORMAT_BIN
     err = esp_core_dump_write_binary(info, write_cfg);
 #elif CONFIG_ESP_COREDUMP_DATA_FORMAT_ELF
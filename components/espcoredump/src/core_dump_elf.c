@@ -657,6 +657,9 @@ esp_err_t esp_core_dump_write_elf(panic_info_t *info, core_dump_write_config_t *
     ALIGN(4, tcb_sz);
     dump_hdr.data_len = tot_len;
     dump_hdr.version = COREDUMP_VERSION;
+#if CONFIG_ESP_COREDUMP_COMPRESSED
+    dump_hdr.version |= COREDUMP_VERSION_FLAG_COMPRESSED; // data after the header is compressed
+#endif
     dump_hdr.tasks_num = task_num; // broken tasks are repaired
     dump_hdr.tcb_sz = tcb_sz;
     dump_hdr.mem_segs_num = 0;
@@ -0,0 +1,332 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * Streaming filter for core dump writing.
+ *
+ * Sits between the dump format writers (core_dump_common/core_dump_elf)
+ * and the transport (flash/UART) write config. It splits large writes
+ * into chunks and feeds the watchdogs between chunks, so dumping a big
+ * RAM image cannot exceed the panic watchdog budget, and optionally
+ * (CONFIG_ESP_COREDUMP_COMPRESSED) compresses the stream on the fly.
+ *
+ * The compressor is a greedy LZ with a single static hash table and a
+ * 2 KB history window, all in static DRAM - no allocations in the crash
+ * path. Token format, decoded by espcoredump.py:
+ *   - flag byte for each group of 8 tokens, LSB first; 1 = literal
+ *   - literal: 1 byte
+ *   - match: 2 bytes; byte0 = distance & 0xFF,
+ *     byte1 = ((distance >> 8) << 5) | (length - 3)
+ *     distance 1..2047 back, length 3..34
+ * The core dump header at the start of the stream stays uncompressed so
+ * that the tools can read the length and version fields; the compressed
+ * flag is carried in the version field (COREDUMP_VERSION_FLAG_COMPRESSED).
+ */
+
+#include <string.h>
+#include "esp_core_dump_priv.h"
+#include "hal/wdt_types.h"
+#include "hal/wdt_hal.h"
+#include "soc/timer_group_struct.h"
+#include "soc/rtc_cntl_struct.h"
+
+const static DRAM_ATTR char TAG[] __attribute__((unused)) = "esp_core_dump_stream";
+
+// Feed the watchdogs after at most this many bytes have been processed
+#define STREAM_CHUNK_SIZE       4096
+
+#if CONFIG_ESP_COREDUMP_COMPRESSED
+#define LZ_WINDOW_SIZE          2048    // must be a power of two, <= 2048
+#define LZ_WINDOW_MASK          (LZ_WINDOW_SIZE - 1)
+#define LZ_MIN_MATCH            3
+#define LZ_MAX_MATCH            34
+#define LZ_HASH_SIZE            1024
+#define LZ_GROUP_TOKENS         8
+#endif
+
+typedef struct {
+    core_dump_write_config_t *base;     // underlying transport config
+    uint32_t raw_off;                   // uncompressed bytes received so far
+    uint32_t chunk_cnt;                 // bytes since the last watchdog feed
+#if CONFIG_ESP_COREDUMP_COMPRESSED
+    uint8_t window[LZ_WINDOW_SIZE];
+    uint32_t pos;                       // total bytes appended to the window
+    uint32_t head[LZ_HASH_SIZE];        // position + 1 of last hash occurrence
+    uint8_t lookahead[LZ_MAX_MATCH];
+    uint32_t la_len;
+    uint8_t group[1 + 2 * LZ_GROUP_TOKENS]; // pending flag byte + tokens
+    uint32_t group_len;                 // used bytes after the flag byte
+    uint32_t group_tokens;
+    uint8_t out[128];                   // staged output for the transport
+    uint32_t out_len;
+#endif
+} core_dump_stream_t;
+
+static core_dump_stream_t s_stream;
+
+static void esp_core_dump_stream_feed_wdts(void)
+{
+    // Same watchdogs the panic handler re-arms; feeding keeps the budget
+    // per chunk instead of per whole dump
+    wdt_hal_context_t wdt0_ctx = {.inst = WDT_MWDT0, .mwdt_dev = &TIMERG0};
+    wdt_hal_write_protect_disable(&wdt0_ctx);
+    wdt_hal_feed(&wdt0_ctx);
+    wdt_hal_write_protect_enable(&wdt0_ctx);
+
+    wdt_hal_context_t rtc_wdt_ctx = {.inst = WDT_RWDT, .rwdt_dev = &RTCCNTL};
+    wdt_hal_write_protect_disable(&rtc_wdt_ctx);
+    wdt_hal_feed(&rtc_wdt_ctx);
+    wdt_hal_write_protect_enable(&rtc_wdt_ctx);
+}
+
+static void esp_core_dump_stream_count(uint32_t len)
+{
+    s_stream.chunk_cnt += len;
+    if (s_stream.chunk_cnt >= STREAM_CHUNK_SIZE) {
+        s_stream.chunk_cnt = 0;
+        esp_core_dump_stream_feed_wdts();
+    }
+}
+
+#if CONFIG_ESP_COREDUMP_COMPRESSED
+
+static esp_err_t lz_out_flush(void)
+{
+    esp_err_t err = ESP_OK;
+    if (s_stream.out_len) {
+        err = s_stream.base->write(s_stream.base->priv, s_stream.out, s_stream.out_len);
+        s_stream.out_len = 0;
+    }
+    return err;
+}
+
+static esp_err_t lz_out_byte(uint8_t b)
+{
+    s_stream.out[s_stream.out_len++] = b;
+    if (s_stream.out_len == sizeof(s_stream.out)) {
+        return lz_out_flush();
+    }
+    return ESP_OK;
+}
+
+static esp_err_t lz_group_flush(void)
+{
+    esp_err_t err = ESP_OK;
+    if (s_stream.group_tokens) {
+        err = lz_out_byte(s_stream.group[0]);
+        for (uint32_t i = 0; err == ESP_OK && i < s_stream.group_len; i++) {
+            err = lz_out_byte(s_stream.group[1 + i]);
+        }
+        s_stream.group[0] = 0;
+        s_stream.group_len = 0;
+        s_stream.group_tokens = 0;
+    }
+    return err;
+}
+
+static esp_err_t lz_token_done(void)
+{
+    if (++s_stream.group_tokens == LZ_GROUP_TOKENS) {
+        return lz_group_flush();
+    }
+    return ESP_OK;
+}
+
+static esp_err_t lz_emit_literal(uint8_t c)
+{
+    s_stream.group[0] |= (1 << s_stream.group_tokens);
+    s_stream.group[1 + s_stream.group_len++] = c;
+    return lz_token_done();
+}
+
+static esp_err_t lz_emit_match(uint32_t dist, uint32_t len)
+{
+    s_stream.group[1 + s_stream.group_len++] = dist & 0xFF;
+    s_stream.group[1 + s_stream.group_len++] = ((dist >> 8) << 5) | (len - LZ_MIN_MATCH);
+    return lz_token_done();
+}
+
+static inline uint32_t lz_hash(const uint8_t *p)
+{
+    return ((p[0] << 6) ^ (p[1] << 3) ^ p[2]) & (LZ_HASH_SIZE - 1);
+}
+
+// Move n bytes from the front of the lookahead into the window
+static void lz_consume(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        s_stream.window[s_stream.pos & LZ_WINDOW_MASK] = s_stream.lookahead[i];
+        s_stream.pos++;
+    }
+    s_stream.la_len -= n;
+    memmove(s_stream.lookahead, &s_stream.lookahead[n], s_stream.la_len);
+}
+
+// Encode one token from the front of the lookahead buffer
+static esp_err_t lz_step(void)
+{
+    esp_err_t err;
+    uint32_t match_len = 0;
+    uint32_t dist = 0;
+
+    if (s_stream.la_len >= LZ_MIN_MATCH) {
+        uint32_t h = lz_hash(s_stream.lookahead);
+        uint32_t cand = s_stream.head[h];
+        s_stream.head[h] = s_stream.pos + 1;
+        if (cand != 0) {
+            cand--;
+            dist = s_stream.pos - cand;
+            if (dist >= 1 && dist < LZ_WINDOW_SIZE) {
+                uint32_t max_len = s_stream.la_len < LZ_MAX_MATCH ? s_stream.la_len : LZ_MAX_MATCH;
+                while (match_len < max_len) {
+                    uint8_t hist;
+                    uint32_t src = cand + match_len;
+                    if (src < s_stream.pos) {
+                        hist = s_stream.window[src & LZ_WINDOW_MASK];
+                    } else {
+                        // overlapping match: bytes still in the lookahead
+                        hist = s_stream.lookahead[src - s_stream.pos];
+                    }
+                    if (hist != s_stream.lookahead[match_len]) {
+                        break;
+                    }
+                    match_len++;
+                }
+            }
+        }
+    }
+
+    if (match_len >= LZ_MIN_MATCH) {
+        err = lz_emit_match(dist, match_len);
+        lz_consume(match_len);
+    } else {
+        err = lz_emit_literal(s_stream.lookahead[0]);
+        lz_consume(1);
+    }
+    return err;
+}
+
+static esp_err_t lz_compress(const uint8_t *data, uint32_t len)
+{
+    esp_err_t err = ESP_OK;
+    for (uint32_t i = 0; err == ESP_OK && i < len; i++) {
+        s_stream.lookahead[s_stream.la_len++] = data[i];
+        if (s_stream.la_len == LZ_MAX_MATCH) {
+            err = lz_step();
+        }
+    }
+    return err;
+}
+
+static esp_err_t lz_finish(void)
+{
+    esp_err_t err = ESP_OK;
+    while (err == ESP_OK && s_stream.la_len > 0) {
+        err = lz_step();
+    }
+    if (err == ESP_OK) {
+        err = lz_group_flush();
+    }
+    if (err == ESP_OK) {
+        err = lz_out_flush();
+    }
+    return err;
+}
+
+#endif // CONFIG_ESP_COREDUMP_COMPRESSED
+
+static esp_err_t esp_core_dump_stream_write(void *priv, void *data, uint32_t data_len)
+{
+    esp_err_t err = ESP_OK;
+    uint8_t *p = (uint8_t *) data;
+
+    esp_core_dump_stream_count(data_len);
+
+    // Pass the core dump header through uncompressed, so the tools can
+    // read the total length and version fields in place
+    if (s_stream.raw_off < sizeof(core_dump_header_t)) {
+        uint32_t hdr_left = sizeof(core_dump_header_t) - s_stream.raw_off;
+        uint32_t pass = data_len < hdr_left ? data_len : hdr_left;
+        err = s_stream.base->write(priv, p, pass);
+        s_stream.raw_off += pass;
+        p += pass;
+        data_len -= pass;
+        if (err != ESP_OK || data_len == 0) {
+            return err;
+        }
+    }
+    s_stream.raw_off += data_len;
+
+#if CONFIG_ESP_COREDUMP_COMPRESSED
+    return lz_compress(p, data_len);
+#else
+    // forward in chunks so big segments cannot starve the watchdogs
+    while (err == ESP_OK && data_len > 0) {
+        uint32_t chunk = data_len < STREAM_CHUNK_SIZE ? data_len : STREAM_CHUNK_SIZE;
+        err = s_stream.base->write(priv, p, chunk);
+        p += chunk;
+        data_len -= chunk;
+        if (data_len > 0) {
+            esp_core_dump_stream_feed_wdts();
+        }
+    }
+    return err;
+#endif
+}
+
+static esp_err_t esp_core_dump_stream_prepare(void *priv, uint32_t *data_len)
+{
+    if (s_stream.base->prepare) {
+        return s_stream.base->prepare(priv, data_len);
+    }
+    return ESP_OK;
+}
+
+static esp_err_t esp_core_dump_stream_start(void *priv)
+{
+    if (s_stream.base->start) {
+        return s_stream.base->start(priv);
+    }
+    return ESP_OK;
+}
+
+static esp_err_t esp_core_dump_stream_end(void *priv)
+{
+    esp_err_t err = ESP_OK;
+#if CONFIG_ESP_COREDUMP_COMPRESSED
+    err = lz_finish();
+    if (err != ESP_OK) {
+        ESP_COREDUMP_LOGE("Failed to flush compressed stream, error=%d!", err);
+    }
+#endif
+    if (s_stream.base->end) {
+        err = s_stream.base->end(priv);
+    }
+    return err;
+}
+
+void esp_core_dump_stream_init(core_dump_write_config_t *stream_cfg,
+                               core_dump_write_config_t *base_cfg)
+{
+    memset(&s_stream, 0, sizeof(s_stream));
+    s_stream.base = base_cfg;
+    memset(stream_cfg, 0, sizeof(*stream_cfg));
+    stream_cfg->prepare = esp_core_dump_stream_prepare;
+    stream_cfg->start = esp_core_dump_stream_start;
+    stream_cfg->end = esp_core_dump_stream_end;
+    stream_cfg->write = esp_core_dump_stream_write;
+    // keep the transport's private data: the format writers (and the
+    // checksum helpers) address it through write_cfg->priv
+    stream_cfg->priv = base_cfg->priv;
+}
@@ -11,6 +11,7 @@
 #include <string.h>
 #include <time.h>
 #include <stdlib.h>
+#include <assert.h>
 #include <sys/time.h>
 #include "diskio_impl.h"
 #include "ffconf.h"
@@ -57,6 +58,12 @@ void ff_diskio_register(BYTE pdrv, const ff_diskio_impl_t* discio_impl)
     s_impls[pdrv] = impl;
 }
 
+const ff_diskio_impl_t* ff_diskio_get_impl(BYTE pdrv)
+{
+    assert(pdrv < FF_VOLUMES);
+    return s_impls[pdrv];
+}
+
 DSTATUS ff_disk_initialize (BYTE pdrv)
 {
     return s_impls[pdrv]->init(pdrv);
@@ -0,0 +1,287 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "diskio_impl.h"
+#include "diskio_cache.h"
+#include "ffconf.h"
+#include "ff.h"
+
+static const char *TAG = "ff_diskio_cache";
+
+#define CACHE_SECTOR_NONE   0xFFFFFFFF
+
+typedef struct {
+    uint32_t sector;        // sector held in this slot, CACHE_SECTOR_NONE if empty
+    uint32_t stamp;         // last access stamp, lowest stamp is evicted first
+    bool dirty;             // slot holds data not yet written to the driver
+} cache_slot_t;
+
+typedef struct {
+    ff_diskio_impl_t drv;   // underlying diskio driver
+    cache_slot_t *slots;
+    uint8_t *buf;           // slot_count * sector_size bytes of sector data
+    size_t slot_count;
+    size_t sector_size;
+    uint32_t stamp;
+    bool write_back;
+} cache_ctx_t;
+
+// FATFS serializes diskio calls per volume, so no locking is needed here
+static cache_ctx_t *s_ctx[FF_VOLUMES] = { NULL };
+
+static inline uint8_t *cache_slot_data(cache_ctx_t *ctx, size_t slot)
+{
+    return ctx->buf + slot * ctx->sector_size;
+}
+
+static int cache_find(cache_ctx_t *ctx, uint32_t sector)
+{
+    for (size_t i = 0; i < ctx->slot_count; i++) {
+        if (ctx->slots[i].sector == sector) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static DRESULT cache_write_out_slot(cache_ctx_t *ctx, BYTE pdrv, size_t slot)
+{
+    DRESULT res = ctx->drv.write(pdrv, cache_slot_data(ctx, slot), ctx->slots[slot].sector, 1);
+    if (res == RES_OK) {
+        ctx->slots[slot].dirty = false;
+    }
+    return res;
+}
+
+// Write out all dirty slots in ascending sector order, so FAT and directory
+// sectors reach the medium before sectors in the data region
+static DRESULT cache_write_out_all(cache_ctx_t *ctx, BYTE pdrv)
+{
+    while (true) {
+        int slot = -1;
+        uint32_t lowest = CACHE_SECTOR_NONE;
+        for (size_t i = 0; i < ctx->slot_count; i++) {
+            if (ctx->slots[i].dirty && ctx->slots[i].sector < lowest) {
+                lowest = ctx->slots[i].sector;
+                slot = i;
+            }
+        }
+        if (slot < 0) {
+            return RES_OK;
+        }
+        DRESULT res = cache_write_out_slot(ctx, pdrv, slot);
+        if (res != RES_OK) {
+            return res;
+        }
+    }
+}
+
+// Flush and invalidate cached sectors overlapping [sector, sector + count),
+// called before a multi-sector transfer bypasses the cache
+static DRESULT cache_drop_range(cache_ctx_t *ctx, BYTE pdrv, uint32_t sector, UINT count)
+{
+    for (size_t i = 0; i < ctx->slot_count; i++) {
+        if (ctx->slots[i].sector >= sector && ctx->slots[i].sector < sector + count) {
+            if (ctx->slots[i].dirty) {
+                DRESULT res = cache_write_out_slot(ctx, pdrv, i);
+                if (res != RES_OK) {
+                    return res;
+                }
+            }
+            ctx->slots[i].sector = CACHE_SECTOR_NONE;
+        }
+    }
+    return RES_OK;
+}
+
+// Return the slot to use for a new sector, writing back the evicted sector
+// if necessary. Returns -1 if the write-back failed.
+static int cache_get_free_slot(cache_ctx_t *ctx, BYTE pdrv)
+{
+    int slot = 0;
+    uint32_t lowest_stamp = UINT32_MAX;
+    for (size_t i = 0; i < ctx->slot_count; i++) {
+        if (ctx->slots[i].sector == CACHE_SECTOR_NONE) {
+            return i;
+        }
+        if (ctx->slots[i].stamp < lowest_stamp) {
+            lowest_stamp = ctx->slots[i].stamp;
+            slot = i;
+        }
+    }
+    if (ctx->slots[slot].dirty && cache_write_out_slot(ctx, pdrv, slot) != RES_OK) {
+        return -1;
+    }
+    ctx->slots[slot].sector = CACHE_SECTOR_NONE;
+    return slot;
+}
+
+static DSTATUS ff_cache_initialize (BYTE pdrv)
+{
+    return s_ctx[pdrv]->drv.init(pdrv);
+}
+
+static DSTATUS ff_cache_status (BYTE pdrv)
+{
+    return s_ctx[pdrv]->drv.status(pdrv);
+}
+
+static DRESULT ff_cache_read (BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
+{
+    cache_ctx_t *ctx = s_ctx[pdrv];
+    if (count != 1) {
+        // data cluster transfer: bypass the cache
+        DRESULT res = cache_drop_range(ctx, pdrv, sector, count);
+        if (res != RES_OK) {
+            return res;
+        }
+        return ctx->drv.read(pdrv, buff, sector, count);
+    }
+    int slot = cache_find(ctx, sector);
+    if (slot < 0) {
+        slot = cache_get_free_slot(ctx, pdrv);
+        if (slot < 0) {
+            return RES_ERROR;
+        }
+        DRESULT res = ctx->drv.read(pdrv, cache_slot_data(ctx, slot), sector, 1);
+        if (res != RES_OK) {
+            return res;
+        }
+        ctx->slots[slot].sector = sector;
+        ctx->slots[slot].dirty = false;
+    }
+    ctx->slots[slot].stamp = ++ctx->stamp;
+    memcpy(buff, cache_slot_data(ctx, slot), ctx->sector_size);
+    return RES_OK;
+}
+
+static DRESULT ff_cache_write (BYTE pdrv, const BYTE *buff, DWORD sector, UINT count)
+{
+    cache_ctx_t *ctx = s_ctx[pdrv];
+    if (count != 1) {
+        // data cluster transfer: bypass the cache
+        DRESULT res = cache_drop_range(ctx, pdrv, sector, count);
+        if (res != RES_OK) {
+            return res;
+        }
+        return ctx->drv.write(pdrv, buff, sector, count);
+    }
+    int slot = cache_find(ctx, sector);
+    if (slot < 0) {
+        slot = cache_get_free_slot(ctx, pdrv);
+        if (slot < 0) {
+            return RES_ERROR;
+        }
+        ctx->slots[slot].sector = sector;
+        ctx->slots[slot].dirty = false;
+    }
+    ctx->slots[slot].stamp = ++ctx->stamp;
+    memcpy(cache_slot_data(ctx, slot), buff, ctx->sector_size);
+    if (ctx->write_back) {
+        ctx->slots[slot].dirty = true;
+        return RES_OK;
+    }
+    return cache_write_out_slot(ctx, pdrv, slot);
+}
+
+static DRESULT ff_cache_ioctl (BYTE pdrv, BYTE cmd, void *buff)
+{
+    cache_ctx_t *ctx = s_ctx[pdrv];
+    if (cmd == CTRL_SYNC) {
+        DRESULT res = cache_write_out_all(ctx, pdrv);
+        if (res != RES_OK) {
+            return res;
+        }
+    }
+    return ctx->drv.ioctl(pdrv, cmd, buff);
+}
+
+esp_err_t ff_diskio_register_cache(BYTE pdrv, size_t cache_sectors, bool write_back)
+{
+    if (pdrv >= FF_VOLUMES || cache_sectors == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_ctx[pdrv] != NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    const ff_diskio_impl_t *drv = ff_diskio_get_impl(pdrv);
+    if (drv == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    WORD sector_size = 0;
+    if (drv->ioctl(pdrv, GET_SECTOR_SIZE, &sector_size) != RES_OK || sector_size == 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    cache_ctx_t *ctx = calloc(1, sizeof(cache_ctx_t));
+    if (ctx == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    ctx->slots = calloc(cache_sectors, sizeof(cache_slot_t));
+    ctx->buf = malloc(cache_sectors * sector_size);
+    if (ctx->slots == NULL || ctx->buf == NULL) {
+        free(ctx->slots);
+        free(ctx->buf);
+        free(ctx);
+        return ESP_ERR_NO_MEM;
+    }
+    memcpy(&ctx->drv, drv, sizeof(ff_diskio_impl_t));
+    ctx->slot_count = cache_sectors;
+    ctx->sector_size = sector_size;
+    ctx->write_back = write_back;
+    for (size_t i = 0; i < cache_sectors; i++) {
+        ctx->slots[i].sector = CACHE_SECTOR_NONE;
+    }
+
+    static const ff_diskio_impl_t cache_impl = {
+        .init = &ff_cache_initialize,
+        .status = &ff_cache_status,
+        .read = &ff_cache_read,
+        .write = &ff_cache_write,
+        .ioctl = &ff_cache_ioctl,
+    };
+    s_ctx[pdrv] = ctx;
+    ff_diskio_register(pdrv, &cache_impl);
+    ESP_LOGD(TAG, "registered %u sector %s cache for pdrv=%i",
+            (unsigned) cache_sectors, write_back ? "write-back" : "write-through", pdrv);
+    return ESP_OK;
+}
+
+esp_err_t ff_diskio_cache_flush(BYTE pdrv)
+{
+    if (pdrv >= FF_VOLUMES || s_ctx[pdrv] == NULL) {
+        return ESP_OK;
+    }
+    return (cache_write_out_all(s_ctx[pdrv], pdrv) == RES_OK) ? ESP_OK : ESP_FAIL;
+}
+
+void ff_diskio_unregister_cache(BYTE pdrv)
+{
+    if (pdrv >= FF_VOLUMES || s_ctx[pdrv] == NULL) {
+        return;
+    }
+    cache_ctx_t *ctx = s_ctx[pdrv];
+    if (cache_write_out_all(ctx, pdrv) != RES_OK) {
+        ESP_LOGE(TAG, "failed to flush cache for pdrv=%i", pdrv);
+    }
+    // put the underlying driver back in place
+    ff_diskio_register(pdrv, &ctx->drv);
+    s_ctx[pdrv] = NULL;
+    free(ctx->slots);
+    free(ctx->buf);
+    free(ctx);
+}
@@ -0,0 +1,76 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdbool.h>
+#include "diskio_impl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Insert an LRU sector cache between FATFS and the diskio driver currently
+ * registered for the given drive number.
+ *
+ * Single sector accesses — FAT and directory sectors in particular — are
+ * served from the cache, turning repeated FAT chain walks into RAM hits.
+ * Multi-sector (data cluster) transfers bypass the cache, flushing and
+ * invalidating any overlapping cached sectors first.
+ *
+ * With write_back enabled, single sector writes are held in the cache until
+ * the volume is synchronized (f_sync/close issue CTRL_SYNC), the cache is
+ * flushed explicitly, or the slot is evicted. Dirty sectors are written out
+ * in ascending sector order, so FAT and directory updates reach the medium
+ * before the data region. Without write_back, writes go through to the
+ * driver immediately and the cache only accelerates reads.
+ *
+ * Must be called after the underlying diskio driver has been registered.
+ *
+ * @param pdrv drive number
+ * @param cache_sectors number of sectors to hold in the cache
+ * @param write_back true to delay writes until the cache is flushed
+ *
+ * @return  ESP_OK on success
+ *          ESP_ERR_INVALID_ARG if cache_sectors is 0 or pdrv is out of range
+ *          ESP_ERR_INVALID_STATE if no driver is registered for pdrv, or a
+ *          cache is already registered for it
+ *          ESP_ERR_NO_MEM if the cache buffers can not be allocated
+ */
+esp_err_t ff_diskio_register_cache(BYTE pdrv, size_t cache_sectors, bool write_back);
+
+/**
+ * Write out all dirty sectors held in the cache of the given drive.
+ *
+ * Useful as a periodic flush point when write_back is enabled. No-op if no
+ * cache is registered for the drive.
+ *
+ * @param pdrv drive number
+ * @return ESP_OK on success, ESP_FAIL if the underlying driver reported a
+ *         write error
+ */
+esp_err_t ff_diskio_cache_flush(BYTE pdrv);
+
+/**
+ * Flush and remove the sector cache of the given drive, re-registering the
+ * underlying diskio driver. No-op if no cache is registered for the drive.
+ *
+ * @param pdrv drive number
+ */
+void ff_diskio_unregister_cache(BYTE pdrv);
+
+#ifdef __cplusplus
+}
+#endif
@@ -55,6 +55,15 @@ void ff_diskio_register(BYTE pdrv, const ff_diskio_impl_t* discio_impl);
 
 #define ff_diskio_unregister(pdrv_) ff_diskio_register(pdrv_, NULL)
 
+/**
+ * Get the diskio driver currently registered for the given drive number.
+ *
+ * @param pdrv drive number
+ * @return pointer to the registered ff_diskio_impl_t structure, or NULL if
+ *         no driver is registered for this drive
+ */
+const ff_diskio_impl_t* ff_diskio_get_impl(BYTE pdrv);
+
 
 /**
  * Get next available drive number
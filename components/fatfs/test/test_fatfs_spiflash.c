@@ -62,6 +62,24 @@ TEST_CASE("(WL) can create and write file", "[fatfs][wear_levelling]")
     test_teardown();
 }
 
+TEST_CASE("(WL) sector cache with write-back persists data", "[fatfs][wear_levelling]")
+{
+    esp_vfs_fat_sdmmc_mount_config_t mount_config = {
+        .format_if_mount_failed = true,
+        .max_files = 5,
+        .disk_cache_sectors = 8,
+        .disk_cache_write_back = true,
+    };
+    TEST_ESP_OK(esp_vfs_fat_spiflash_mount("/spiflash", NULL, &mount_config, &s_test_wl_handle));
+    test_fatfs_create_file_with_text("/spiflash/cached.txt", fatfs_test_hello_str);
+    test_fatfs_read_file("/spiflash/cached.txt");
+    test_teardown();
+    // remount without the cache, data must have reached the medium
+    test_setup();
+    test_fatfs_read_file("/spiflash/cached.txt");
+    test_teardown();
+}
+
 TEST_CASE("(WL) can read file", "[fatfs][wear_levelling]")
 {
     test_setup();
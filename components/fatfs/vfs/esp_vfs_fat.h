@@ -93,6 +93,23 @@ typedef struct {
      * sector size.
      */
     size_t allocation_unit_size;
+    /**
+     * Number of sectors to keep in a RAM cache above the disk I/O layer.
+     * Single sector accesses — FAT and directory sectors in particular —
+     * are served from the cache, which speeds up workloads that walk FAT
+     * chains repeatedly. Set to 0 to disable the cache.
+     * Only used by esp_vfs_fat_spiflash_mount.
+     */
+    size_t disk_cache_sectors;
+    /**
+     * If true, cached sector writes are held back and written out in batch
+     * when the volume is synchronized (f_sync/close), when the filesystem
+     * is unmounted, or when ff_diskio_cache_flush() is called. Data written
+     * since the last synchronization can be lost on power failure. If
+     * false, writes go through to flash immediately and the cache only
+     * accelerates reads. Only meaningful when disk_cache_sectors is not 0.
+     */
+    bool disk_cache_write_back;
 } esp_vfs_fat_mount_config_t;
 
 // Compatibility definition
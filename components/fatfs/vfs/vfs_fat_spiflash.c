@@ -24,6 +24,7 @@
 
 #include "wear_levelling.h"
 #include "diskio_wl.h"
+#include "diskio_cache.h"
 
 static const char *TAG = "vfs_fat_spiflash";
 esp_err_t esp_vfs_fat_spiflash_mount(const char* base_path,
@@ -63,6 +64,14 @@ esp_err_t esp_vfs_fat_spiflash_mount(const char* base_path,
         ESP_LOGE(TAG, "ff_diskio_register_wl_partition failed pdrv=%i, error - 0x(%x)", pdrv, result);
         goto fail;
     }
+    if (mount_config->disk_cache_sectors > 0) {
+        result = ff_diskio_register_cache(pdrv, mount_config->disk_cache_sectors,
+                mount_config->disk_cache_write_back);
+        if (result != ESP_OK) {
+            ESP_LOGE(TAG, "ff_diskio_register_cache failed pdrv=%i, error - 0x(%x)", pdrv, result);
+            goto fail;
+        }
+    }
     FATFS *fs;
     result = esp_vfs_fat_register(base_path, drv, mount_config->max_files, &fs);
     if (result == ESP_ERR_INVALID_STATE) {
@@ -111,6 +120,7 @@ esp_err_t esp_vfs_fat_spiflash_mount(const char* base_path,
 fail:
     free(workbuf);
     esp_vfs_fat_unregister_path(base_path);
+    ff_diskio_unregister_cache(pdrv);
     ff_diskio_unregister(pdrv);
     return result;
 }
@@ -124,6 +134,7 @@ esp_err_t esp_vfs_fat_spiflash_unmount(const char *base_path, wl_handle_t wl_han
     char drv[3] = {(char)('0' + pdrv), ':', 0};
 
     f_mount(0, drv, 0);
+    ff_diskio_unregister_cache(pdrv);
     ff_diskio_unregister(pdrv);
     ff_diskio_clear_pdrv_wl(wl_handle);
     // release partition driver
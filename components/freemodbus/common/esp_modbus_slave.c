@@ -40,6 +40,42 @@ static uint8_t mb_slave_id[] = { MB_ID_BYTE0(MB_CONTROLLER_SLAVE_ID),
 // Common interface pointer for slave port
 static mb_slave_interface_t* slave_interface_ptr = NULL;
 
+// Optional range access callback, handles whole request spans in one call
+static mb_slave_range_cb_t slave_range_cb = NULL;
+static void* slave_range_cb_arg = NULL;
+
+esp_err_t mbc_slave_set_range_cb(mb_slave_range_cb_t cb, void* arg)
+{
+    slave_range_cb = cb;
+    slave_range_cb_arg = arg;
+    return ESP_OK;
+}
+
+// Dispatch a register access to the range callback if one is registered.
+// Returns MB_ENOERR/MB_ENOREG/MB_EIO when handled; MB_ENORES means
+// "not handled", and the caller falls back to the area descriptors.
+static eMBErrorCode mbc_slave_dispatch_range_cb(mb_param_type_t param_type,
+                                                USHORT usAddress, USHORT usCount,
+                                                UCHAR* pucBuffer,
+                                                mb_range_access_mode_t access_mode)
+{
+    if (slave_range_cb == NULL) {
+        return MB_ENORES;
+    }
+    esp_err_t err = slave_range_cb(param_type, (uint16_t)usAddress, (uint16_t)usCount,
+                                   (uint8_t*)pucBuffer, access_mode, slave_range_cb_arg);
+    switch (err) {
+        case ESP_OK:
+            return MB_ENOERR;
+        case ESP_ERR_NOT_SUPPORTED:
+            return MB_ENORES;
+        case ESP_ERR_NOT_FOUND:
+            return MB_ENOREG;
+        default:
+            return MB_EIO;
+    }
+}
+
 void mbc_slave_init_iface(void* handler)
 {
     slave_interface_ptr = (mb_slave_interface_t*) handler;
@@ -181,6 +217,11 @@ eMBErrorCode eMBRegDiscreteCB(UCHAR * pucRegBuffer, USHORT usAddress,
     MB_SLAVE_CHECK((slave_interface_ptr->slave_reg_cb_discrete != NULL),
                     error,
                     "Slave interface is not correctly initialized.");
+    error = mbc_slave_dispatch_range_cb(MB_PARAM_DISCRETE, usAddress, usNDiscrete,
+                                        pucRegBuffer, MB_RANGE_ACCESS_READ);
+    if (error != MB_ENORES) {
+        return error;
+    }
     error = slave_interface_ptr->slave_reg_cb_discrete(pucRegBuffer, usAddress, usNDiscrete);
 
     return error;
@@ -196,6 +237,12 @@ eMBErrorCode eMBRegCoilsCB(UCHAR* pucRegBuffer, USHORT usAddress,
     MB_SLAVE_CHECK((slave_interface_ptr->slave_reg_cb_coils != NULL),
                     ESP_ERR_INVALID_STATE,
                     "Slave interface is not correctly initialized.");
+    error = mbc_slave_dispatch_range_cb(MB_PARAM_COIL, usAddress, usNCoils, pucRegBuffer,
+                                        (eMode == MB_REG_WRITE) ? MB_RANGE_ACCESS_WRITE
+                                                                : MB_RANGE_ACCESS_READ);
+    if (error != MB_ENORES) {
+        return error;
+    }
     error = slave_interface_ptr->slave_reg_cb_coils(pucRegBuffer, usAddress,
                                                         usNCoils, eMode);
     return error;
@@ -211,6 +258,12 @@ eMBErrorCode eMBRegHoldingCB(UCHAR * pucRegBuffer, USHORT usAddress,
     MB_SLAVE_CHECK((slave_interface_ptr->slave_reg_cb_holding != NULL),
                     ESP_ERR_INVALID_STATE,
                     "Slave interface is not correctly initialized.");
+    error = mbc_slave_dispatch_range_cb(MB_PARAM_HOLDING, usAddress, usNRegs, pucRegBuffer,
+                                        (eMode == MB_REG_WRITE) ? MB_RANGE_ACCESS_WRITE
+                                                                : MB_RANGE_ACCESS_READ);
+    if (error != MB_ENORES) {
+        return error;
+    }
     error = slave_interface_ptr->slave_reg_cb_holding(pucRegBuffer, usAddress,
                                                         usNRegs, eMode);
     return error;
@@ -226,6 +279,11 @@ eMBErrorCode eMBRegInputCB(UCHAR * pucRegBuffer, USHORT usAddress,
     MB_SLAVE_CHECK((slave_interface_ptr->slave_reg_cb_input != NULL),
                     ESP_ERR_INVALID_STATE,
                     "Slave interface is not correctly initialized.");
+    error = mbc_slave_dispatch_range_cb(MB_PARAM_INPUT, usAddress, usNRegs,
+                                        pucRegBuffer, MB_RANGE_ACCESS_READ);
+    if (error != MB_ENORES) {
+        return error;
+    }
     error = slave_interface_ptr->slave_reg_cb_input(pucRegBuffer, usAddress, usNRegs);
     return error;
 }
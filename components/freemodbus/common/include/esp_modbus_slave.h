@@ -144,6 +144,56 @@ esp_err_t mbc_slave_get_param_info(mb_param_info_t* reg_info, uint32_t timeout);
  */
 esp_err_t mbc_slave_set_descriptor(mb_register_area_descriptor_t descr_data);
 
+/**
+ * @brief Direction of a register range access
+ */
+typedef enum {
+    MB_RANGE_ACCESS_READ = 0,               /*!< Master reads the range, callback fills the buffer */
+    MB_RANGE_ACCESS_WRITE                   /*!< Master writes the range, callback consumes the buffer */
+} mb_range_access_mode_t;
+
+/**
+ * @brief Range access callback prototype
+ *
+ * Invoked once per Modbus request with the whole requested span. The buffer
+ * is a view directly over the ADU frame of the protocol stack (big-endian
+ * register values for register areas, packed bits for coil/discrete areas),
+ * so data is filled or consumed in place with no intermediate copy.
+ *
+ * @param[in] param_type type of the accessed area
+ * @param[in] mb_offset Modbus address of the first accessed register/coil
+ * @param[in] count number of registers (or coils/bits) in the request
+ * @param[in] frame_buffer view over the request span in the ADU frame
+ * @param[in] mode access direction
+ * @param[in] arg user argument registered with the callback
+ * @return
+ *     - ESP_OK: The request is fully handled by the callback
+ *     - ESP_ERR_NOT_SUPPORTED: Fall back to the default area descriptor handling
+ *     - ESP_ERR_NOT_FOUND: The range is not mapped, an exception is returned to the master
+ *     - other: The request fails with a device failure exception
+ */
+typedef esp_err_t (*mb_slave_range_cb_t)(mb_param_type_t param_type, uint16_t mb_offset,
+                                         uint16_t count, uint8_t* frame_buffer,
+                                         mb_range_access_mode_t mode, void* arg);
+
+/**
+ * @brief Register a range access callback for the slave
+ *
+ * When registered, the callback is invoked from the Modbus stack context for
+ * every register/coil access with the whole request span at once, instead of
+ * servicing the request from the area descriptor memory. A bulk read of 100
+ * registers thus costs one call into the mapping layer rather than being
+ * limited to the fixed storage areas. Pass NULL to unregister and return to
+ * pure area descriptor handling.
+ *
+ * @param cb range access callback, NULL to unregister
+ * @param arg user argument passed to each invocation
+ *
+ * @return
+ *     - ESP_OK: Callback registered
+ */
+esp_err_t mbc_slave_set_range_cb(mb_slave_range_cb_t cb, void* arg);
+
 #ifdef __cplusplus
 }
 #endif
@@ -138,6 +138,10 @@ BOOL            xMBPortSerialGetByte( CHAR * pucByte );
 
 BOOL            xMBPortSerialPutByte( CHAR ucByte );
 
+USHORT          usMBPortSerialGetData( CHAR * pucBuffer, USHORT usMaxBytes );
+
+BOOL            xMBPortSerialPutData( const CHAR * pucBuffer, USHORT usLength );
+
 #if MB_MASTER_RTU_ENABLED || MB_MASTER_ASCII_ENABLED
 BOOL            xMBMasterPortSerialInit( UCHAR ucPort, ULONG ulBaudRate,
                                    UCHAR ucDataBits, eMBParity eParity );
@@ -209,6 +213,19 @@ extern          BOOL( *pxMBFrameCBTransmitterEmpty ) ( void );
 
 extern          BOOL( *pxMBPortCBTimerExpired ) ( void );
 
+/*! \ingroup modbus
+ * \brief Optional block transfer callbacks for the porting layer.
+ *
+ * Transmission layers which can consume or produce a whole frame in one
+ * call set these pointers (currently only the RTU layer does). If they are
+ * non NULL the port may use them instead of looping over the per-byte
+ * callbacks, moving the frame between the serial driver and the protocol
+ * buffer with a single copy.
+ */
+extern          BOOL( *pxMBFrameCBBlockReceived ) ( void );
+
+extern          BOOL( *pxMBFrameCBTransmitterBlock ) ( void );
+
 #if MB_MASTER_RTU_ENABLED || MB_MASTER_ASCII_ENABLED || MB_MASTER_TCP_ENABLED
 extern          BOOL( *pxMBMasterFrameCBByteReceived ) ( void );
 
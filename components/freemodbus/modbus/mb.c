@@ -87,6 +87,8 @@ static pvMBFrameClose pvMBFrameCloseCur;
 BOOL( *pxMBFrameCBByteReceived ) ( void );
 BOOL( *pxMBFrameCBTransmitterEmpty ) ( void );
 BOOL( *pxMBPortCBTimerExpired ) ( void );
+BOOL( *pxMBFrameCBBlockReceived ) ( void );
+BOOL( *pxMBFrameCBTransmitterBlock ) ( void );
 BOOL( *pxMBFrameCBReceiveFSMCur ) ( void );
 BOOL( *pxMBFrameCBTransmitFSMCur ) ( void );
 
@@ -154,6 +156,8 @@ eMBInit( eMBMode eMode, UCHAR ucSlaveAddress, UCHAR ucPort, ULONG ulBaudRate, eM
             pxMBFrameCBByteReceived = xMBRTUReceiveFSM;
             pxMBFrameCBTransmitterEmpty = xMBRTUTransmitFSM;
             pxMBPortCBTimerExpired = xMBRTUTimerT35Expired;
+            pxMBFrameCBBlockReceived = xMBRTUReceiveBlock;
+            pxMBFrameCBTransmitterBlock = xMBRTUTransmitBlock;
 
             eStatus = eMBRTUInit( ucMBAddress, ucPort, ulBaudRate, eParity );
             break;
@@ -168,6 +172,8 @@ eMBInit( eMBMode eMode, UCHAR ucSlaveAddress, UCHAR ucPort, ULONG ulBaudRate, eM
             pxMBFrameCBByteReceived = xMBASCIIReceiveFSM;
             pxMBFrameCBTransmitterEmpty = xMBASCIITransmitFSM;
             pxMBPortCBTimerExpired = xMBASCIITimerT1SExpired;
+            pxMBFrameCBBlockReceived = NULL;
+            pxMBFrameCBTransmitterBlock = NULL;
 
             eStatus = eMBASCIIInit( ucMBAddress, ucPort, ulBaudRate, eParity );
             break;
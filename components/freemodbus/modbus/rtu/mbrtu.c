@@ -280,6 +280,61 @@ xMBRTUReceiveFSM( void )
     return xStatus;
 }
 
+BOOL
+xMBRTUReceiveBlock( void )
+{
+    USHORT          usLength;
+
+    assert( eSndState == STATE_TX_IDLE );
+
+    switch ( eRcvState )
+    {
+        /* During startup and after a damaged frame the received bytes are
+         * drained but discarded, like the per-byte FSM does.
+         */
+    case STATE_RX_INIT:
+    case STATE_RX_ERROR:
+        ( void )usMBPortSerialGetData( ( CHAR * ) ucRTUBuf, MB_SER_PDU_SIZE_MAX );
+        vMBPortTimersEnable(  );
+        break;
+
+        /* A new frame starts: move everything the serial driver has
+         * accumulated into the protocol buffer with one call.
+         */
+    case STATE_RX_IDLE:
+        usRcvBufferPos = 0;
+        usLength = usMBPortSerialGetData( ( CHAR * ) ucRTUBuf, MB_SER_PDU_SIZE_MAX );
+        if( usLength > 0 )
+        {
+            usRcvBufferPos = usLength;
+            eRcvState = STATE_RX_RCV;
+        }
+        vMBPortTimersEnable(  );
+        break;
+
+        /* Frame continued across port events: append to the buffer. */
+    case STATE_RX_RCV:
+        usLength = usMBPortSerialGetData( ( CHAR * ) & ucRTUBuf[usRcvBufferPos],
+                                          ( USHORT )( MB_SER_PDU_SIZE_MAX - usRcvBufferPos ) );
+        usRcvBufferPos += usLength;
+        if( usRcvBufferPos == MB_SER_PDU_SIZE_MAX )
+        {
+            /* More data beyond the maximum frame size means the frame is
+             * oversized and must be dropped.
+             */
+            CHAR ucDrain;
+            if( usMBPortSerialGetData( &ucDrain, 1 ) > 0 )
+            {
+                eRcvState = STATE_RX_ERROR;
+            }
+        }
+        vMBPortTimersEnable(  );
+        break;
+    }
+
+    return TRUE;
+}
+
 BOOL
 xMBRTUTransmitFSM( void )
 {
@@ -315,6 +370,32 @@ xMBRTUTransmitFSM( void )
     return xNeedPoll;
 }
 
+BOOL
+xMBRTUTransmitBlock( void )
+{
+    BOOL xNeedPoll = FALSE;
+
+    assert( eRcvState == STATE_RX_IDLE );
+
+    if( eSndState == STATE_TX_XMIT )
+    {
+        /* The serial line PDU is contiguous in the protocol buffer, hand
+         * it to the port in one piece instead of byte by byte.
+         */
+        if( usSndBufferCount != 0 )
+        {
+            ( void )xMBPortSerialPutData( ( const CHAR * ) pucSndBufferCur, usSndBufferCount );
+            pucSndBufferCur += usSndBufferCount;
+            usSndBufferCount = 0;
+        }
+        xMBPortEventPost( EV_FRAME_TRANSMIT );
+        eSndState = STATE_TX_IDLE;
+        vMBPortTimersEnable(  );
+    }
+
+    return xNeedPoll;
+}
+
 BOOL MB_PORT_ISR_ATTR
 xMBRTUTimerT35Expired( void )
 {
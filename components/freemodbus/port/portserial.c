@@ -92,10 +92,17 @@ static USHORT usMBPortSerialRxPoll(size_t xEventSize)
     USHORT usCnt = 0;
 
     if (bRxStateEnabled) {
-        // Get received packet into Rx buffer
-        while(xReadStatus && (usCnt++ <= MB_SERIAL_BUF_SIZE)) {
-            // Call the Modbus stack callback function and let it fill the buffers.
-            xReadStatus = pxMBFrameCBByteReceived(); // callback to execute receive FSM
+        if (pxMBFrameCBBlockReceived != NULL) {
+            // Transmission layer supports block transfer: move the whole frame
+            // from the UART driver into the protocol buffer with one call.
+            (void)pxMBFrameCBBlockReceived();
+            usCnt = xEventSize;
+        } else {
+            // Get received packet into Rx buffer
+            while(xReadStatus && (usCnt++ <= MB_SERIAL_BUF_SIZE)) {
+                // Call the Modbus stack callback function and let it fill the buffers.
+                xReadStatus = pxMBFrameCBByteReceived(); // callback to execute receive FSM
+            }
         }
         uart_flush_input(ucUartNumber);
         // Send event EV_FRAME_RECEIVED to allow stack process packet
@@ -114,10 +121,16 @@ BOOL xMBPortSerialTxPoll(void)
     BOOL bNeedPoll = TRUE;
 
     if( bTxStateEnabled ) {
-        // Continue while all response bytes put in buffer or out of buffer
-        while((bNeedPoll) && (usCount++ < MB_SERIAL_BUF_SIZE)) {
-            // Calls the modbus stack callback function to let it fill the UART transmit buffer.
-            bNeedPoll = pxMBFrameCBTransmitterEmpty( ); // callback to transmit FSM
+        if (pxMBFrameCBTransmitterBlock != NULL) {
+            // Transmission layer supports block transfer: the whole response
+            // frame is queued to the UART driver with one call.
+            (void)pxMBFrameCBTransmitterBlock();
+        } else {
+            // Continue while all response bytes put in buffer or out of buffer
+            while((bNeedPoll) && (usCount++ < MB_SERIAL_BUF_SIZE)) {
+                // Calls the modbus stack callback function to let it fill the UART transmit buffer.
+                bNeedPoll = pxMBFrameCBTransmitterEmpty( ); // callback to transmit FSM
+            }
         }
         ESP_LOGD(TAG, "MB_TX_buffer send: (%d) bytes\n", (uint16_t)usCount);
         // Waits while UART sending the packet
@@ -283,3 +296,27 @@ BOOL xMBPortSerialGetByte(CHAR* pucByte)
     USHORT usLength = uart_read_bytes(ucUartNumber, (uint8_t*)pucByte, 1, MB_SERIAL_RX_TOUT_TICKS);
     return (usLength == 1);
 }
+
+// Get everything accumulated in the intermediate RX buffer with one driver call
+USHORT usMBPortSerialGetData(CHAR* pucBuffer, USHORT usMaxBytes)
+{
+    assert(pucBuffer != NULL);
+    size_t xAvailable = 0;
+    ESP_ERROR_CHECK(uart_get_buffered_data_len(ucUartNumber, &xAvailable));
+    if (xAvailable == 0) {
+        return 0;
+    }
+    if (xAvailable > usMaxBytes) {
+        xAvailable = usMaxBytes;
+    }
+    int xLength = uart_read_bytes(ucUartNumber, (uint8_t*)pucBuffer, xAvailable, MB_SERIAL_RX_TOUT_TICKS);
+    return (xLength > 0) ? (USHORT)xLength : 0;
+}
+
+// Queue a whole buffer to the UART transmit buffer with one driver call
+BOOL xMBPortSerialPutData(const CHAR* pucBuffer, USHORT usLength)
+{
+    assert(pucBuffer != NULL);
+    int xLength = uart_write_bytes(ucUartNumber, pucBuffer, usLength);
+    return (xLength == usLength);
+}
@@ -763,6 +763,39 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue, void * const pvBuffer ) PRIV
  */
 BaseType_t xQueueReceive( QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/**
+ * Receive up to uxMaxItems items from a queue in a single call.
+ *
+ * Behaves like xQueueReceive() for the first item: the calling task blocks
+ * for up to xTicksToWait ticks if the queue is empty.  Once at least one item
+ * is available, as many items as are currently queued (up to uxMaxItems) are
+ * copied out while the queue is locked, so a consumer that has fallen behind
+ * a fast producer drains the backlog with one kernel call instead of one call
+ * per item.  The function does not wait for further items once the queue has
+ * been emptied.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to the buffer into which the received items will
+ * be copied.  The buffer must be large enough to hold uxMaxItems items of the
+ * queue's item size, which are stored consecutively.
+ *
+ * @param uxMaxItems The maximum number of items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for the first item to receive should the queue be empty at the time
+ * of the call.  The time is defined in tick periods so the constant
+ * portTICK_PERIOD_MS should be used to convert to real time if this is
+ * required.
+ *
+ * @return The number of items copied into pvBuffer, or 0 if the queue was
+ * still empty when the block time expired.
+ *
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, UBaseType_t uxMaxItems, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /**
  * Return the number of messages stored in a queue.
  *
@@ -1462,6 +1495,35 @@ QueueSetMemberHandle_t xQueueSelectFromSet( QueueSetHandle_t xQueueSet, const Ti
  */
 QueueSetMemberHandle_t xQueueSelectFromSetFromISR( QueueSetHandle_t xQueueSet ) PRIVILEGED_FUNCTION;
 
+/**
+ * Select up to uxMaxMembers ready members of a queue set in a single call.
+ *
+ * Equivalent to calling xQueueSelectFromSet() repeatedly, but the calling
+ * task blocks at most once: after the first member becomes ready, every
+ * ready-event currently pending in the set (up to uxMaxMembers) is returned
+ * together, so a task multiplexing several busy queues takes one kernel call
+ * per wakeup rather than one per message.  The same member handle appears
+ * once per pending event, and each returned handle must be consumed by
+ * exactly one receive or take, as with xQueueSelectFromSet() (see Note 3
+ * of its documentation).
+ *
+ * @param xQueueSet The queue set on which the task will (potentially) block.
+ *
+ * @param pxMembers Pointer to an array of at least uxMaxMembers
+ * QueueSetMemberHandle_t entries into which the ready member handles will be
+ * written.
+ *
+ * @param uxMaxMembers The maximum number of ready-event handles to return.
+ *
+ * @param xTicksToWait The maximum time, in ticks, that the calling task will
+ * remain in the Blocked state (with other tasks executing) to wait for a
+ * member of the queue set to be ready.
+ *
+ * @return The number of handles written to pxMembers, or 0 if no member
+ * became ready before the block time expired.
+ */
+UBaseType_t uxQueueSelectMultipleFromSet( QueueSetHandle_t xQueueSet, QueueSetMemberHandle_t * const pxMembers, UBaseType_t uxMaxMembers, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /** @cond */
 
 /* Not public API functions. */
@@ -331,6 +331,24 @@ extern void vPortCleanUpTCB ( void *pxTCB );
 #endif /* def __ASSEMBLER__ */
 #endif
 
+#if CONFIG_APPTRACE_TRACEPOINTS && !CONFIG_SYSVIEW_ENABLE
+#ifndef __ASSEMBLER__
+/* Static tracepoint on context switch (see esp_tracepoint.h). SystemView
+ * provides its own traceTASK_SWITCHED_IN, so yield to it when enabled. */
+extern void esp_tracepoint_task_switched_in(void *tcb);
+#define traceTASK_SWITCHED_IN() esp_tracepoint_task_switched_in(pxCurrentTCB[xPortGetCoreID()])
+#endif /* def __ASSEMBLER__ */
+#endif
+
+#if CONFIG_FREERTOS_STACK_WATERMARK_TRACKING
+#ifndef __ASSEMBLER__
+/* O(1) stack watermark sampling at context switch: pxTopOfStack holds the
+ * live stack pointer by the time this trace point runs (see portasm.S). */
+extern void vPortStackWatermarkSwitchedOut(void *tcb);
+#define traceTASK_SWITCHED_OUT() vPortStackWatermarkSwitchedOut(pxCurrentTCB[xPortGetCoreID()])
+#endif /* def __ASSEMBLER__ */
+#endif
+
 #if CONFIG_FREERTOS_CHECK_MUTEX_GIVEN_BY_OWNER
 #define configCHECK_MUTEX_GIVEN_BY_OWNER    1
 #else
@@ -388,6 +388,51 @@ void vApplicationSleep( TickType_t xExpectedIdleTime );
 
 void _xt_coproc_release(volatile void * coproc_sa_base);
 
+#if XCHAL_CP_NUM > 0 && defined(CONFIG_FREERTOS_COPROC_STATS)
+/*
+ * Coprocessor (FPU) usage tracking. Task parameters are TaskHandle_t passed
+ * as void * (this header is included before task.h defines the type); NULL
+ * means the calling task.
+ */
+
+/* Number of lazy coprocessor context acquisitions (coprocessor-disabled
+   exceptions) taken on the given core since boot or the last reset. */
+uint32_t uxPortGetCoprocAcquireCount( BaseType_t xCoreID );
+
+/* Reset the acquisition counters of all cores. */
+void vPortResetCoprocAcquireCount( void );
+
+/* Bitmask of coprocessors the task has used (live or saved state). */
+UBaseType_t uxPortTaskCoprocUsage( void *xTask );
+
+/* Core currently owning the task's coprocessor state, or -1 if none. */
+BaseType_t xPortTaskCoprocOwnerCore( void *xTask );
+
+/* Drop the task's live coprocessor ownership, as done on task deletion. The
+   task must not be in the middle of coprocessor work: unsaved coprocessor
+   register state is lost. Afterwards the task's next coprocessor use may pin
+   it to whichever core it is running on at that point. */
+void vPortTaskCoprocRelease( void *xTask );
+#endif /* XCHAL_CP_NUM > 0 && CONFIG_FREERTOS_COPROC_STATS */
+
+#if CONFIG_FREERTOS_STACK_WATERMARK_TRACKING
+/*
+ * Live stack watermark tracking: the minimum stack pointer of each task is
+ * sampled in O(1) at every context switch (see port_stack_watermark.c).
+ * Task parameters are TaskHandle_t passed as void * (this header is included
+ * before task.h defines the type); NULL means the calling task.
+ */
+
+/* Smallest observed gap, in bytes, between the task's stack pointer at a
+   context switch and the low end of its stack; the unused margin that can be
+   reclaimed when sizing the stack. Returns -1 if the task has not been
+   observed switching out yet. */
+int32_t xPortGetStackMinFree( void *xTask );
+
+/* Forget the watermark recorded for the task (e.g. after its start-up phase). */
+void vPortResetStackWatermark( void *xTask );
+#endif /* CONFIG_FREERTOS_STACK_WATERMARK_TRACKING */
+
 /* Architecture specific optimisations. */
 #if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
 
@@ -364,6 +364,75 @@ void vPortReleaseTaskMPUSettings( xMPU_SETTINGS *xMPUSettings )
 
 #endif
 
+#if XCHAL_CP_NUM > 0 && defined(CONFIG_FREERTOS_COPROC_STATS)
+
+/* Defined in xtensa_vectors.S */
+extern volatile StackType_t *_xt_coproc_owner_sa[XCHAL_CP_MAX * portNUM_PROCESSORS];
+extern uint32_t _xt_coproc_exc_count[portNUM_PROCESSORS];
+
+/*
+ * xMPUSettings is the second member of the TCB (right after pxTopOfStack) and
+ * coproc_area is its first field; this mirrors the TASKTCB_XCOREID_OFFSET
+ * layout assumption in xtensa_vectors.S.
+ */
+static volatile StackType_t *pxTaskCoprocArea( void *xTask )
+{
+	if( xTask == NULL ) {
+		xTask = xTaskGetCurrentTaskHandle();
+	}
+	return ( ( xMPU_SETTINGS * ) ( ( uint8_t * ) xTask + sizeof( volatile StackType_t * ) ) )->coproc_area;
+}
+
+uint32_t uxPortGetCoprocAcquireCount( BaseType_t xCoreID )
+{
+	if( xCoreID < 0 || xCoreID >= portNUM_PROCESSORS ) {
+		return 0;
+	}
+	return _xt_coproc_exc_count[xCoreID];
+}
+
+void vPortResetCoprocAcquireCount( void )
+{
+	for( int i = 0; i < portNUM_PROCESSORS; i++ ) {
+		_xt_coproc_exc_count[i] = 0;
+	}
+}
+
+UBaseType_t uxPortTaskCoprocUsage( void *xTask )
+{
+	volatile StackType_t *sa = pxTaskCoprocArea( xTask );
+	/* XT_CPENABLE holds the coprocessors the task is actively using,
+	   XT_CPSTORED the ones whose state is saved in the task's save area;
+	   either bit set means the task has touched that coprocessor. */
+	uint16_t enable = *( volatile uint16_t * ) ( ( uint8_t * ) sa + XT_CPENABLE );
+	uint16_t stored = *( volatile uint16_t * ) ( ( uint8_t * ) sa + XT_CPSTORED );
+	return ( UBaseType_t ) ( enable | stored );
+}
+
+BaseType_t xPortTaskCoprocOwnerCore( void *xTask )
+{
+	volatile StackType_t *sa = pxTaskCoprocArea( xTask );
+	for( int i = 0; i < XCHAL_CP_MAX * portNUM_PROCESSORS; i++ ) {
+		if( _xt_coproc_owner_sa[i] == sa ) {
+			return i / XCHAL_CP_MAX;
+		}
+	}
+	return -1;
+}
+
+void vPortTaskCoprocRelease( void *xTask )
+{
+	/* Same call that is made on task deletion: drops the task's live
+	   coprocessor ownership, so the next acquisition on that core doesn't
+	   have to save this task's state first and the task no longer has to
+	   run on the owning core for its FPU context. State kept only in the
+	   coprocessor registers is lost, so the task must be between FPU
+	   bursts (or be the caller itself, done with its FPU work). */
+	_xt_coproc_release( pxTaskCoprocArea( xTask ) );
+}
+
+#endif /* XCHAL_CP_NUM > 0 && CONFIG_FREERTOS_COPROC_STATS */
+
 /*
  * Returns true if the current core is in ISR context; low prio ISR, med prio ISR or timer tick ISR. High prio ISRs
  * aren't detected here, but they normally cannot call C code, so that should not be an issue anyway.
@@ -0,0 +1,128 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdkconfig.h"
+
+#if CONFIG_FREERTOS_STACK_WATERMARK_TRACKING
+
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Live stack watermark tracking.
+
+   uxTaskGetStackHighWaterMark() scans the stack fill pattern, which is
+   O(stack size) per call, so it is usually sampled rarely and stacks get
+   sized with fat margins. The context save paths in portasm.S store the
+   outgoing task's stack pointer into pxTopOfStack before
+   traceTASK_SWITCHED_OUT() runs, so the deepest stack depth visible at a
+   context switch can be tracked in O(1): keep the minimum pxTopOfStack seen
+   per task in a small per-core hash table (per core, so the hook needs no
+   locking — it runs on the switching core with interrupts masked).
+
+   The result is a lower bound on the task's true peak use: depth reached and
+   unwound entirely between two switches is not observed. In practice deep
+   call paths block or get preempted inside them, so the tracked value
+   converges on the fill-pattern watermark while staying cheap enough to
+   stream continuously. */
+
+typedef struct {
+    void *tcb;
+    StackType_t *min_top;      // lowest stack pointer observed at a switch
+} stack_wm_slot_t;
+
+#define STACK_WM_SLOTS  CONFIG_FREERTOS_STACK_WATERMARK_SLOTS
+#define STACK_WM_PROBES 4
+
+static stack_wm_slot_t s_wm_slots[portNUM_PROCESSORS][STACK_WM_SLOTS];
+
+void vPortStackWatermarkSwitchedOut(void *pxTCB)
+{
+    /* pxTopOfStack is the first TCB member and holds the live stack pointer
+       at this point (stored by the context save path, see portasm.S). */
+    StackType_t *top = *(StackType_t **) pxTCB;
+    stack_wm_slot_t *slots = s_wm_slots[xPortGetCoreID()];
+    uint32_t idx = ((uint32_t) pxTCB >> 4) % STACK_WM_SLOTS;
+    for (int probe = 0; probe < STACK_WM_PROBES; probe++) {
+        stack_wm_slot_t *slot = &slots[idx];
+        if (slot->tcb == pxTCB) {
+            if (top < slot->min_top) {
+                slot->min_top = top;
+            }
+            return;
+        }
+        if (slot->tcb == NULL) {
+            slot->tcb = pxTCB;
+            slot->min_top = top;
+            return;
+        }
+        idx = (idx + 1) % STACK_WM_SLOTS;
+    }
+    /* All probe slots taken by other tasks: overwrite the home slot so the
+       recently running tasks stay tracked. */
+    slots[((uint32_t) pxTCB >> 4) % STACK_WM_SLOTS] = (stack_wm_slot_t) {
+        .tcb = pxTCB, .min_top = top
+    };
+}
+
+int32_t xPortGetStackMinFree(void *xTask)
+{
+    if (xTask == NULL) {
+        xTask = xTaskGetCurrentTaskHandle();
+    }
+    StackType_t *stack_start = (StackType_t *) pxTaskGetStackStart(xTask);
+    StackType_t *min_top = NULL;
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        stack_wm_slot_t *slots = s_wm_slots[core];
+        uint32_t idx = ((uint32_t) xTask >> 4) % STACK_WM_SLOTS;
+        for (int probe = 0; probe < STACK_WM_PROBES; probe++) {
+            stack_wm_slot_t *slot = &slots[idx];
+            if (slot->tcb == xTask) {
+                /* A slot left over from a deleted task at a recycled TCB
+                   address can point outside this task's stack; drop it. */
+                if (slot->min_top < stack_start) {
+                    slot->tcb = NULL;
+                } else if (min_top == NULL || slot->min_top < min_top) {
+                    min_top = slot->min_top;
+                }
+                break;
+            }
+            idx = (idx + 1) % STACK_WM_SLOTS;
+        }
+    }
+    if (min_top == NULL) {
+        return -1;
+    }
+    return (int32_t) ((uint8_t *) min_top - (uint8_t *) stack_start);
+}
+
+void vPortResetStackWatermark(void *xTask)
+{
+    if (xTask == NULL) {
+        xTask = xTaskGetCurrentTaskHandle();
+    }
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        stack_wm_slot_t *slots = s_wm_slots[core];
+        uint32_t idx = ((uint32_t) xTask >> 4) % STACK_WM_SLOTS;
+        for (int probe = 0; probe < STACK_WM_PROBES; probe++) {
+            if (slots[idx].tcb == xTask) {
+                slots[idx].tcb = NULL;
+                break;
+            }
+            idx = (idx + 1) % STACK_WM_SLOTS;
+        }
+    }
+}
+
+#endif // CONFIG_FREERTOS_STACK_WATERMARK_TRACKING
@@ -1427,6 +1427,152 @@ Queue_t * const pxQueue = xQueue;
 }
 /*-----------------------------------------------------------*/
 
+UBaseType_t uxQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, UBaseType_t uxMaxItems, TickType_t xTicksToWait )
+{
+BaseType_t xEntryTimeSet = pdFALSE;
+TimeOut_t xTimeOut;
+Queue_t * const pxQueue = xQueue;
+
+	/* Check the pointer is not NULL. */
+	configASSERT( ( pxQueue ) );
+
+	configASSERT( uxMaxItems > ( UBaseType_t ) 0 );
+
+	/* The buffer into which data is received can only be NULL if the data size
+	is zero (so no data is copied into the buffer. */
+	configASSERT( !( ( ( pvBuffer ) == NULL ) && ( ( pxQueue )->uxItemSize != ( UBaseType_t ) 0U ) ) );
+
+	/* Cannot block if the scheduler is suspended. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+
+	/*lint -save -e904  This function relaxes the coding standard somewhat to
+	allow return statements within the function itself.  This is done in the
+	interest of execution time efficiency. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL( &pxQueue->mux);
+		{
+			const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+			/* Is there data in the queue now?  To be running the calling task
+			must be the highest priority task wanting to access the queue. */
+			if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+			{
+				/* Data available: remove as many items as are queued, up to
+				the number requested, while the queue is locked. */
+				UBaseType_t uxItemsCopied = ( UBaseType_t ) 0;
+				int8_t *pcWriteTo = ( int8_t * ) pvBuffer;
+
+				do
+				{
+					prvCopyDataFromQueue( pxQueue, pcWriteTo );
+					traceQUEUE_RECEIVE( pxQueue );
+					pxQueue->uxMessagesWaiting = pxQueue->uxMessagesWaiting - ( UBaseType_t ) 1;
+					pcWriteTo += pxQueue->uxItemSize;
+					uxItemsCopied = uxItemsCopied + ( UBaseType_t ) 1;
+
+					/* There is now space in the queue, were any tasks waiting to
+					post to the queue?  If so, unblock the highest priority waiting
+					task; one task can be unblocked per item removed. */
+					if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+					{
+						if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+						{
+							queueYIELD_IF_USING_PREEMPTION();
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				} while( ( uxItemsCopied < uxMaxItems ) && ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) );
+
+				taskEXIT_CRITICAL( &pxQueue->mux);
+				return uxItemsCopied;
+			}
+			else
+			{
+				if( xTicksToWait == ( TickType_t ) 0 )
+				{
+					/* The queue was empty and no block time is specified (or
+					the block time has expired) so leave now. */
+					taskEXIT_CRITICAL( &pxQueue->mux);
+					traceQUEUE_RECEIVE_FAILED( pxQueue );
+					return ( UBaseType_t ) 0;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					/* The queue was empty and a block time was specified so
+					configure the timeout structure. */
+					vTaskInternalSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+				else
+				{
+					/* Entry time was already set. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		taskEXIT_CRITICAL( &pxQueue->mux);
+
+		/* Interrupts and other tasks can send to and receive from the queue
+		now the critical section has been exited. */
+
+		taskENTER_CRITICAL( &pxQueue->mux);
+		prvLockQueue( pxQueue );
+
+		/* Update the timeout state to see if it has expired yet. */
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			/* The timeout has not expired.  If the queue is still empty place
+			the task on the list of tasks waiting to receive from the queue. */
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			{
+				traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
+				taskEXIT_CRITICAL( &pxQueue->mux);
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				/* The queue contains data again.  Loop back to try and read the
+				data. */
+				prvUnlockQueue( pxQueue );
+				taskEXIT_CRITICAL( &pxQueue->mux);
+			}
+		}
+		else
+		{
+			/* Timed out.  If there is no data in the queue exit, otherwise loop
+			back and attempt to read the data. */
+			prvUnlockQueue( pxQueue );
+			taskEXIT_CRITICAL( &pxQueue->mux);
+
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			{
+				traceQUEUE_RECEIVE_FAILED( pxQueue );
+				return ( UBaseType_t ) 0;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	} /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
 BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue, TickType_t xTicksToWait )
 {
 BaseType_t xEntryTimeSet = pdFALSE;
@@ -2887,6 +3033,19 @@ Queue_t * const pxQueue = xQueue;
 #endif /* configUSE_QUEUE_SETS */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	UBaseType_t uxQueueSelectMultipleFromSet( QueueSetHandle_t xQueueSet, QueueSetMemberHandle_t * const pxMembers, UBaseType_t uxMaxMembers, TickType_t xTicksToWait )
+	{
+		/* The set's internal queue holds one member handle per pending
+		ready-event, so a batched receive hands back every pending event in a
+		single call. */
+		return uxQueueReceiveMultiple( ( QueueHandle_t ) xQueueSet, pxMembers, uxMaxMembers, xTicksToWait ); /*lint !e961 Casting from one typedef to another is not redundant. */
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_QUEUE_SETS == 1 )
 
 	static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue, const BaseType_t xCopyPosition )
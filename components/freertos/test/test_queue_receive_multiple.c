@@ -0,0 +1,71 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "unity.h"
+
+/*
+ * Tests for the batched receive primitives. A queue (and a queue set) is
+ * filled with a known sequence, then drained through the multi-item calls;
+ * the returned counts and item ordering must match a sequence of single
+ * receives.
+ */
+#define QUEUE_LEN               8
+#define BATCH_LEN               5
+#define ITEM_SIZE               sizeof(uint32_t)
+
+TEST_CASE("Test uxQueueReceiveMultiple", "[freertos]")
+{
+    QueueHandle_t queue = xQueueCreate(QUEUE_LEN, ITEM_SIZE);
+    TEST_ASSERT_MESSAGE(queue != NULL, "Failed to create queue");
+
+    //Fill the queue with a known sequence
+    for (uint32_t i = 0; i < QUEUE_LEN; i++) {
+        TEST_ASSERT_MESSAGE(xQueueSendToBack(queue, &i, portMAX_DELAY) == pdTRUE, "Failed to send to queue");
+    }
+
+    //A batch receive must return exactly the batch size while more items remain
+    uint32_t items[QUEUE_LEN];
+    TEST_ASSERT_EQUAL_MESSAGE(BATCH_LEN, uxQueueReceiveMultiple(queue, items, BATCH_LEN, 0), "Incorrect batch count");
+    for (uint32_t i = 0; i < BATCH_LEN; i++) {
+        TEST_ASSERT_EQUAL_MESSAGE(i, items[i], "Incorrect item value");
+    }
+
+    //Asking for more than is queued must drain the queue without blocking
+    TEST_ASSERT_EQUAL_MESSAGE(QUEUE_LEN - BATCH_LEN, uxQueueReceiveMultiple(queue, items, QUEUE_LEN, 0), "Incorrect drain count");
+    for (uint32_t i = 0; i < QUEUE_LEN - BATCH_LEN; i++) {
+        TEST_ASSERT_EQUAL_MESSAGE(BATCH_LEN + i, items[i], "Incorrect item value");
+    }
+
+    //An empty queue with no block time must return 0
+    TEST_ASSERT_EQUAL_MESSAGE(0, uxQueueReceiveMultiple(queue, items, QUEUE_LEN, 0), "Empty queue returned items");
+
+    vQueueDelete(queue);
+}
+
+TEST_CASE("Test uxQueueSelectMultipleFromSet", "[freertos]")
+{
+    QueueSetHandle_t set_handle = xQueueCreateSet(QUEUE_LEN);
+    QueueHandle_t queue = xQueueCreate(QUEUE_LEN, ITEM_SIZE);
+    TEST_ASSERT_MESSAGE(set_handle != NULL && queue != NULL, "Failed to create queue/queue set");
+    TEST_ASSERT_MESSAGE(xQueueAddToSet(queue, set_handle) == pdPASS, "Failed to add to queue set");
+
+    for (uint32_t i = 0; i < QUEUE_LEN; i++) {
+        TEST_ASSERT_MESSAGE(xQueueSendToBack(queue, &i, portMAX_DELAY) == pdTRUE, "Failed to send to queue");
+    }
+
+    //One call must hand back every pending ready-event, one per queued item
+    QueueSetMemberHandle_t members[QUEUE_LEN];
+    TEST_ASSERT_EQUAL_MESSAGE(QUEUE_LEN, uxQueueSelectMultipleFromSet(set_handle, members, QUEUE_LEN, portMAX_DELAY), "Incorrect ready-event count");
+    for (uint32_t i = 0; i < QUEUE_LEN; i++) {
+        TEST_ASSERT_EQUAL_MESSAGE(queue, members[i], "Incorrect queue set member returned");
+        uint32_t item;
+        TEST_ASSERT_MESSAGE(xQueueReceive((QueueHandle_t)members[i], &item, 0) == pdTRUE, "Failed to receive from queue");
+        TEST_ASSERT_EQUAL_MESSAGE(i, item, "Incorrect item value");
+    }
+
+    TEST_ASSERT_MESSAGE(xQueueRemoveFromSet(queue, set_handle), "Failed to remove from queue set");
+    vQueueDelete(queue);
+    vQueueDelete(set_handle);
+}
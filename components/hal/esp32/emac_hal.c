@@ -518,6 +518,88 @@ err:
     return 0;
 }
 
+uint32_t emac_hal_transmit_multiple_buf_frame(emac_hal_context_t *hal, void **buffs, size_t *lengths, size_t buffs_cnt)
+{
+    /* The number of Tx descriptors depends on the total frame length only */
+    uint32_t length = 0;
+    for (size_t i = 0; i < buffs_cnt; i++) {
+        length += lengths[i];
+    }
+    /* Get the number of Tx buffers to use for the frame */
+    uint32_t bufcount = 0;
+    uint32_t lastlen = length;
+    uint32_t sentout = 0;
+    while (lastlen > CONFIG_ETH_DMA_BUFFER_SIZE) {
+        lastlen -= CONFIG_ETH_DMA_BUFFER_SIZE;
+        bufcount++;
+    }
+    if (lastlen) {
+        bufcount++;
+    }
+    if (bufcount > CONFIG_ETH_DMA_TX_BUFFER_NUM) {
+        goto err;
+    }
+
+    eth_dma_tx_descriptor_t *desc_iter = hal->tx_desc;
+    uint8_t *src = (uint8_t *)buffs[0];
+    uint32_t src_remain = lengths[0];
+    size_t src_idx = 0;
+    /* The frame is gathered from the uplayer buffers into the DMA buffers in one pass */
+    for (int i = 0; i < bufcount; i++) {
+        /* Check if the descriptor is owned by the Ethernet DMA (when 1) or CPU (when 0) */
+        if (desc_iter->TDES0.Own != EMAC_DMADESC_OWNER_CPU) {
+            goto err;
+        }
+        /* Clear FIRST and LAST segment bits */
+        desc_iter->TDES0.FirstSegment = 0;
+        desc_iter->TDES0.LastSegment = 0;
+        desc_iter->TDES0.InterruptOnComplete = 0;
+        if (i == 0) {
+            /* Setting the first segment bit */
+            desc_iter->TDES0.FirstSegment = 1;
+        }
+        uint32_t desc_len = CONFIG_ETH_DMA_BUFFER_SIZE;
+        if (i == (bufcount - 1)) {
+            /* Setting the last segment bit */
+            desc_iter->TDES0.LastSegment = 1;
+            /* Enable transmit interrupt */
+            desc_iter->TDES0.InterruptOnComplete = 1;
+            desc_len = lastlen;
+        }
+        /* Program size */
+        desc_iter->TDES1.TransmitBuffer1Size = desc_len;
+        /* Splice data from the uplayer stack buffers into the DMA buffer */
+        uint8_t *dst = (uint8_t *)(desc_iter->Buffer1Addr);
+        uint32_t desc_remain = desc_len;
+        while (desc_remain) {
+            while (src_remain == 0) {
+                src_idx++;
+                src = (uint8_t *)buffs[src_idx];
+                src_remain = lengths[src_idx];
+            }
+            uint32_t copy_len = src_remain < desc_remain ? src_remain : desc_remain;
+            memcpy(dst, src, copy_len);
+            dst += copy_len;
+            src += copy_len;
+            src_remain -= copy_len;
+            desc_remain -= copy_len;
+        }
+        sentout += desc_len;
+        /* Point to next descriptor */
+        desc_iter = (eth_dma_tx_descriptor_t *)(desc_iter->Buffer2NextDescAddr);
+    }
+
+    /* Set Own bit of the Tx descriptor Status: gives the buffer back to ETHERNET DMA */
+    for (int i = 0; i < bufcount; i++) {
+        hal->tx_desc->TDES0.Own = EMAC_DMADESC_OWNER_DMA;
+        hal->tx_desc = (eth_dma_tx_descriptor_t *)(hal->tx_desc->Buffer2NextDescAddr);
+    }
+    hal->dma_regs->dmatxpolldemand = 0;
+    return sentout;
+err:
+    return 0;
+}
+
 uint32_t emac_hal_receive_frame(emac_hal_context_t *hal, uint8_t *buf, uint32_t size, uint32_t *frames_remain, uint32_t *free_desc)
 {
     eth_dma_rx_descriptor_t *desc_iter = NULL;
@@ -20,6 +20,7 @@ extern "C" {
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include "esp_err.h"
 #include "soc/emac_dma_struct.h"
 #include "soc/emac_mac_struct.h"
@@ -389,6 +390,8 @@ uint32_t emac_hal_get_tx_desc_owner(emac_hal_context_t *hal);
 
 uint32_t emac_hal_transmit_frame(emac_hal_context_t *hal, uint8_t *buf, uint32_t length);
 
+uint32_t emac_hal_transmit_multiple_buf_frame(emac_hal_context_t *hal, void **buffs, size_t *lengths, size_t buffs_cnt);
+
 uint32_t emac_hal_receive_frame(emac_hal_context_t *hal, uint8_t *buf, uint32_t size, uint32_t *frames_remain, uint32_t *free_desc);
 
 void emac_hal_enable_flow_ctrl(emac_hal_context_t *hal, bool enable);
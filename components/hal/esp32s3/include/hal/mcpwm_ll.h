@@ -64,6 +64,9 @@ static inline void mcpwm_ll_set_clock_prescale(mcpwm_dev_t *mcpwm, int prescale)
     mcpwm->clk_cfg.prescale = prescale;
 }
 
+STATIC_HAL_REG_CHECK(MCPWM, MCPWM_LL_INTR_TIMER0_TEZ, MCPWM_TIMER0_TEZ_INT_RAW);
+STATIC_HAL_REG_CHECK(MCPWM, MCPWM_LL_INTR_TIMER1_TEZ, MCPWM_TIMER1_TEZ_INT_RAW);
+STATIC_HAL_REG_CHECK(MCPWM, MCPWM_LL_INTR_TIMER2_TEZ, MCPWM_TIMER2_TEZ_INT_RAW);
 STATIC_HAL_REG_CHECK(MCPWM, MCPWM_LL_INTR_CAP0, MCPWM_CAP0_INT_RAW);
 STATIC_HAL_REG_CHECK(MCPWM, MCPWM_LL_INTR_CAP1, MCPWM_CAP1_INT_RAW);
 STATIC_HAL_REG_CHECK(MCPWM, MCPWM_LL_INTR_CAP2, MCPWM_CAP2_INT_RAW);
@@ -90,6 +93,22 @@ static inline void mcpwm_ll_clear_intr(mcpwm_dev_t* mcpwm, mcpwm_intr_t intr)
     mcpwm->int_clr.val = intr;
 }
 
+/**
+ * Enable or disable the interrupts.
+ *
+ * @param mcpwm Address of the MCPWM peripheral registers.
+ * @param intr Bitwise ORed interrupts to operate on.
+ * @param enable True to enable the given interrupts, false to disable them.
+ */
+static inline void mcpwm_ll_intr_enable(mcpwm_dev_t* mcpwm, mcpwm_intr_t intr, bool enable)
+{
+    if (enable) {
+        mcpwm->int_ena.val |= intr;
+    } else {
+        mcpwm->int_ena.val &= ~intr;
+    }
+}
+
 /********************* Timer *******************/
 /**
  * Set the prescale of the Timer_x clock to the PWM main clock.
@@ -730,6 +749,18 @@ static inline mcpwm_intr_t mcpwm_ll_get_cap_intr_def(int bit)
     return BIT(bit+MCPWM_CAP0_INT_RAW_S);
 }
 
+/**
+ * Utility function, get the `mcpwm_intr_t` interrupt enum of a specific timer's TEZ (counter
+ * equals zero) event.
+ *
+ * @param timer x for timer x.
+ * @return the corresponding `mcpwm_intr_t`.
+ */
+static inline mcpwm_intr_t mcpwm_ll_get_tez_intr_def(int timer)
+{
+    return BIT(timer+MCPWM_TIMER0_TEZ_INT_RAW_S);
+}
+
 #ifdef __cplusplus
 }
 #endif
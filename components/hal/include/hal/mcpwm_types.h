@@ -16,6 +16,9 @@
 
 /// Interrupts for MCPWM
 typedef enum {
+    MCPWM_LL_INTR_TIMER0_TEZ = BIT(3),  ///< Timer 0 counted to zero
+    MCPWM_LL_INTR_TIMER1_TEZ = BIT(4),  ///< Timer 1 counted to zero
+    MCPWM_LL_INTR_TIMER2_TEZ = BIT(5),  ///< Timer 2 counted to zero
     MCPWM_LL_INTR_CAP0 = BIT(27), ///< Capture 0 happened
     MCPWM_LL_INTR_CAP1 = BIT(28), ///< Capture 1 happened
     MCPWM_LL_INTR_CAP2 = BIT(29), ///< Capture 2 happened
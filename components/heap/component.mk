@@ -2,7 +2,7 @@
 # Component Makefile
 #
 
-COMPONENT_OBJS := heap_caps_init.o heap_caps.o multi_heap.o heap_tlsf.o
+COMPONENT_OBJS := heap_caps_init.o heap_caps.o multi_heap.o heap_tlsf.o heap_arena.o heap_pool.o
 
 ifndef CONFIG_HEAP_POISONING_DISABLED
 COMPONENT_OBJS += multi_heap_poisoning.o
@@ -10,6 +10,14 @@ COMPONENT_OBJS += multi_heap_poisoning.o
 ifdef CONFIG_HEAP_TASK_TRACKING
 COMPONENT_OBJS += heap_task_info.o
 endif
+
+ifdef CONFIG_HEAP_ALLOC_TAGGING
+COMPONENT_OBJS += heap_alloc_tag.o
+endif
+
+ifdef CONFIG_HEAP_CALLOC_ZERO_CACHE
+COMPONENT_OBJS += heap_zero_cache.o
+endif
 endif
 
 ifdef CONFIG_HEAP_TRACING_STANDALONE
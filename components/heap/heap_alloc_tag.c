@@ -0,0 +1,74 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <sys/param.h>
+#include <multi_heap.h>
+#include "multi_heap_internal.h"
+#include "heap_private.h"
+#include "esp_heap_alloc_tag.h"
+
+#ifdef CONFIG_HEAP_ALLOC_TAGGING
+
+void heap_caps_set_alloc_tag(uint8_t tag)
+{
+    vTaskSetThreadLocalStoragePointer(NULL, CONFIG_HEAP_ALLOC_TAG_TLS_INDEX,
+                                      (void *)(uintptr_t)tag);
+}
+
+uint8_t heap_caps_get_alloc_tag(void)
+{
+    return (uint8_t)(uintptr_t)pvTaskGetThreadLocalStoragePointer(NULL, CONFIG_HEAP_ALLOC_TAG_TLS_INDEX);
+}
+
+void heap_caps_get_info_by_tag(uint8_t tag, uint32_t caps, multi_heap_info_t *info)
+{
+    heap_t *reg;
+
+    memset(info, 0, sizeof(multi_heap_info_t));
+
+    SLIST_FOREACH(reg, &registered_heaps, next) {
+        multi_heap_handle_t heap = reg->heap;
+        if (heap == NULL || !heap_caps_match(reg, caps)) {
+            continue;
+        }
+
+        multi_heap_info_t hinfo;
+        multi_heap_get_info(heap, &hinfo);
+        info->total_free_bytes += hinfo.total_free_bytes;
+        info->largest_free_block = MAX(info->largest_free_block,
+                                       hinfo.largest_free_block);
+        info->free_blocks += hinfo.free_blocks;
+        info->total_blocks += hinfo.total_blocks;
+
+        multi_heap_block_handle_t b = multi_heap_get_first_block(heap);
+        multi_heap_internal_lock(heap);
+        for ( ; b ; b = multi_heap_get_next_block(heap, b)) {
+            if (multi_heap_is_free(b)) {
+                continue;
+            }
+            if (multi_heap_get_block_tag(b) != tag) {
+                continue;
+            }
+            void *p = multi_heap_get_block_address(b);  // Safe, only arithmetic
+            info->total_allocated_bytes += multi_heap_get_allocated_size(heap, p);
+            info->allocated_blocks += 1;
+        }
+        multi_heap_internal_unlock(heap);
+    }
+}
+
+#endif // CONFIG_HEAP_ALLOC_TAGGING
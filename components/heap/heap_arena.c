@@ -0,0 +1,99 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include "esp_heap_arena.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#define ARENA_ALIGN_UP(num) (((num) + 3) & ~((size_t)3))
+
+struct heap_arena {
+    uint8_t *buffer;
+    size_t size;
+    size_t used;
+    portMUX_TYPE lock;
+};
+
+esp_err_t heap_arena_create(uint32_t caps, size_t size, heap_arena_handle_t *out_arena)
+{
+    if (size == 0 || out_arena == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    struct heap_arena *arena = heap_caps_malloc(sizeof(struct heap_arena), MALLOC_CAP_DEFAULT);
+    if (arena == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    arena->buffer = heap_caps_malloc(size, caps);
+    if (arena->buffer == NULL) {
+        heap_caps_free(arena);
+        return ESP_ERR_NO_MEM;
+    }
+    arena->size = size;
+    arena->used = 0;
+    portMUX_TYPE mux_init = portMUX_INITIALIZER_UNLOCKED;
+    arena->lock = mux_init;
+    *out_arena = arena;
+    return ESP_OK;
+}
+
+void *heap_arena_alloc(heap_arena_handle_t arena, size_t size)
+{
+    if (arena == NULL || size == 0) {
+        return NULL;
+    }
+    size = ARENA_ALIGN_UP(size);
+    void *result = NULL;
+    portENTER_CRITICAL(&arena->lock);
+    if (arena->size - arena->used >= size) {
+        result = arena->buffer + arena->used;
+        arena->used += size;
+    }
+    portEXIT_CRITICAL(&arena->lock);
+    return result;
+}
+
+void heap_arena_reset(heap_arena_handle_t arena)
+{
+    portENTER_CRITICAL(&arena->lock);
+    arena->used = 0;
+    portEXIT_CRITICAL(&arena->lock);
+}
+
+void heap_arena_destroy(heap_arena_handle_t arena)
+{
+    if (arena == NULL) {
+        return;
+    }
+    heap_caps_free(arena->buffer);
+    heap_caps_free(arena);
+}
+
+size_t heap_arena_get_free_size(heap_arena_handle_t arena)
+{
+    portENTER_CRITICAL(&arena->lock);
+    size_t free_size = arena->size - arena->used;
+    portEXIT_CRITICAL(&arena->lock);
+    return free_size;
+}
+
+void heap_arena_bind_to_task(heap_arena_handle_t arena)
+{
+    vTaskSetThreadLocalStoragePointer(NULL, CONFIG_HEAP_ARENA_TLS_INDEX, arena);
+}
+
+heap_arena_handle_t heap_arena_get_bound(void)
+{
+    return pvTaskGetThreadLocalStoragePointer(NULL, CONFIG_HEAP_ARENA_TLS_INDEX);
+}
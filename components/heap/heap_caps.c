@@ -13,6 +13,7 @@
 // limitations under the License.
 #include <stdbool.h>
 #include <string.h>
+#include <stdatomic.h>
 #include <assert.h>
 #include <stdio.h>
 #include <sys/param.h>
@@ -85,17 +86,18 @@ bool heap_caps_match(const heap_t *heap, uint32_t caps)
 }
 
 /*
-Routine to allocate a bit of memory with certain capabilities. caps is a bitfield of MALLOC_CAP_* bits.
+Core allocation routine: iterates the registered heaps in priority order.
+Returns NULL silently on failure; failure reporting (callback/abort) is done
+by the public entry points, so a preference attempt of the placement hint
+path can fail over without raising a false alarm.
 */
-IRAM_ATTR void *heap_caps_malloc( size_t size, uint32_t caps )
+IRAM_ATTR static void *heap_caps_malloc_base( size_t size, uint32_t caps )
 {
     void *ret = NULL;
 
     if (size > HEAP_SIZE_MAX) {
         // Avoids int overflow when adding small numbers to size, or
         // calculating 'end' from start+size, by limiting 'size' to the possible range
-        heap_caps_alloc_failed(size, caps, __func__);
-
         return NULL;
     }
 
@@ -105,8 +107,6 @@ IRAM_ATTR void *heap_caps_malloc( size_t size, uint32_t caps )
         //NULL directly, even although our heap capabilities (based on soc_memory_tags & soc_memory_regions) would
         //indicate there is a tag for this.
         if ((caps & MALLOC_CAP_8BIT) || (caps & MALLOC_CAP_DMA)) {
-            heap_caps_alloc_failed(size, caps, __func__);
-
             return NULL;
         }
         caps |= MALLOC_CAP_32BIT; // IRAM is 32-bit accessible RAM
@@ -152,12 +152,110 @@ IRAM_ATTR void *heap_caps_malloc( size_t size, uint32_t caps )
         }
     }
 
-    heap_caps_alloc_failed(size, caps, __func__);
-
     //Nothing usable found.
     return NULL;
 }
 
+//Counters of the placement hint policy; incremented with relaxed atomics, so
+//they are cheap on the allocation path but only approximately ordered
+static heap_caps_placement_stats_t s_placement_stats;
+
+/*
+Routine to allocate a bit of memory with certain capabilities. caps is a bitfield of MALLOC_CAP_* bits.
+
+MALLOC_CAP_HOT/MALLOC_CAP_COLD are placement hints, not heap capabilities:
+a hot allocation is first attempted in internal RAM and a cold one in SPI
+RAM, falling back to the unhinted capabilities (and counting the spill) when
+the preferred memory is exhausted.
+*/
+IRAM_ATTR void *heap_caps_malloc( size_t size, uint32_t caps )
+{
+    void *ret;
+    uint32_t hint = caps & (MALLOC_CAP_HOT | MALLOC_CAP_COLD);
+    caps &= ~(MALLOC_CAP_HOT | MALLOC_CAP_COLD);
+
+    if (hint != 0) {
+        if (hint & MALLOC_CAP_HOT) {
+            __atomic_add_fetch(&s_placement_stats.hot_allocs, 1, __ATOMIC_RELAXED);
+            ret = heap_caps_malloc_base(size, caps | MALLOC_CAP_INTERNAL);
+            if (ret == NULL) {
+                __atomic_add_fetch(&s_placement_stats.hot_spills, 1, __ATOMIC_RELAXED);
+                __atomic_add_fetch(&s_placement_stats.hot_spilled_bytes, size, __ATOMIC_RELAXED);
+            }
+        } else {
+            __atomic_add_fetch(&s_placement_stats.cold_allocs, 1, __ATOMIC_RELAXED);
+            ret = heap_caps_malloc_base(size, caps | MALLOC_CAP_SPIRAM);
+            if (ret == NULL) {
+                __atomic_add_fetch(&s_placement_stats.cold_spills, 1, __ATOMIC_RELAXED);
+                __atomic_add_fetch(&s_placement_stats.cold_spilled_bytes, size, __ATOMIC_RELAXED);
+            }
+        }
+        if (ret != NULL) {
+            return ret;
+        }
+    }
+
+    ret = heap_caps_malloc_base(size, caps);
+    if (ret == NULL) {
+        heap_caps_alloc_failed(size, caps, __func__);
+    }
+    return ret;
+}
+
+void heap_caps_get_placement_stats(heap_caps_placement_stats_t *stats)
+{
+    *stats = s_placement_stats;
+}
+
+void heap_caps_reset_placement_stats(void)
+{
+    memset(&s_placement_stats, 0, sizeof(s_placement_stats));
+}
+
+/*
+Move an allocation to memory with the given capabilities. Returns the buffer
+unchanged when it is already placed correctly; leaves it valid and returns
+NULL when no memory with the requested capabilities is available.
+*/
+void *heap_caps_migrate(void *ptr, uint32_t caps)
+{
+    if (ptr == NULL) {
+        return NULL;
+    }
+    //Placement hints translate to hard requirements here: migration is an
+    //explicit request for a specific memory type
+    if (caps & MALLOC_CAP_HOT) {
+        caps |= MALLOC_CAP_INTERNAL;
+    } else if (caps & MALLOC_CAP_COLD) {
+        caps |= MALLOC_CAP_SPIRAM;
+    }
+    caps &= ~(MALLOC_CAP_HOT | MALLOC_CAP_COLD);
+
+    //Recover the underlying address of diram-aliased allocations, as in realloc
+    bool ptr_in_diram_case = false;
+    void *lookup_ptr = ptr;
+    if (esp_ptr_in_diram_iram(ptr)) {
+        lookup_ptr = (void *)((uint32_t *)ptr)[-1];
+        ptr_in_diram_case = true;
+    }
+    heap_t *heap = find_containing_heap(lookup_ptr);
+    assert(heap != NULL && "migrate() pointer is outside heap areas");
+
+    if (!ptr_in_diram_case && (caps & get_all_caps(heap)) == caps) {
+        return ptr;     //Already in suitable memory, nothing to move
+    }
+
+    size_t old_size = multi_heap_get_allocated_size(heap->heap, lookup_ptr);
+    assert(old_size > 0);
+    void *new_p = heap_caps_malloc_base(old_size, caps);
+    if (new_p == NULL) {
+        return NULL;
+    }
+    memcpy(new_p, ptr, old_size);
+    heap_caps_free(ptr);
+    return new_p;
+}
+
 
 #define MALLOC_DISABLE_EXTERNAL_ALLOCS -1
 //Dual-use: -1 (=MALLOC_DISABLE_EXTERNAL_ALLOCS) disables allocations in external memory, >=0 sets the limit for allocations preferring internal memory.
@@ -311,8 +409,13 @@ IRAM_ATTR void *heap_caps_realloc( void *ptr, size_t size, int caps)
     heap_t *heap = NULL;
     void *dram_ptr = NULL;
 
+    //Placement hints are not heap capability bits: keep them aside for the
+    //allocation and match heaps on the real capabilities only
+    uint32_t hint = caps & (MALLOC_CAP_HOT | MALLOC_CAP_COLD);
+    caps &= ~(MALLOC_CAP_HOT | MALLOC_CAP_COLD);
+
     if (ptr == NULL) {
-        return heap_caps_malloc(size, caps);
+        return heap_caps_malloc(size, caps | hint);
     }
 
     if (size == 0) {
@@ -360,7 +463,7 @@ IRAM_ATTR void *heap_caps_realloc( void *ptr, size_t size, int caps)
 
     // if we couldn't do that, try to see if we can reallocate
     // in a different heap with requested capabilities.
-    void *new_p = heap_caps_malloc(size, caps);
+    void *new_p = heap_caps_malloc(size, caps | hint);
     if (new_p != NULL) {
         size_t old_size = 0;
 
@@ -392,6 +495,13 @@ IRAM_ATTR void *heap_caps_calloc( size_t n, size_t size, uint32_t caps)
         return NULL;
     }
 
+#ifdef CONFIG_HEAP_CALLOC_ZERO_CACHE
+    result = heap_caps_zero_cache_take(size_bytes, caps);
+    if (result != NULL) {
+        return result;
+    }
+#endif
+
     result = heap_caps_malloc(size_bytes, caps);
     if (result != NULL) {
         bzero(result, size_bytes);
@@ -617,3 +727,39 @@ void *heap_caps_aligned_calloc(size_t alignment, size_t n, size_t size, uint32_t
 
     return ptr;
 }
+
+/* Deferred ("fast") free support.
+
+   heap_caps_free_deferred() pushes the block onto a lock-free LIFO threaded
+   through the freed blocks themselves, without taking the heap lock or
+   coalescing. heap_caps_flush_deferred_free() later hands the whole batch to
+   the allocator in one go, amortising the TLSF merge work and keeping it off
+   latency-critical paths (audio callbacks, ISR follow-ups, etc.) */
+
+static _Atomic(uintptr_t) deferred_free_head = 0;
+
+IRAM_ATTR void heap_caps_free_deferred(void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+    uintptr_t old_head = atomic_load(&deferred_free_head);
+    do {
+        *(uintptr_t *)ptr = old_head;
+    } while (!atomic_compare_exchange_weak(&deferred_free_head, &old_head, (uintptr_t)ptr));
+}
+
+size_t heap_caps_flush_deferred_free(void)
+{
+    /* Take the whole list in one exchange so concurrent pushes during the
+       flush simply start a new batch. */
+    uintptr_t head = atomic_exchange(&deferred_free_head, 0);
+    size_t count = 0;
+    while (head != 0) {
+        uintptr_t next = *(uintptr_t *)head;
+        heap_caps_free((void *)head);
+        head = next;
+        count++;
+    }
+    return count;
+}
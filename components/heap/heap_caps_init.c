@@ -22,6 +22,16 @@
 #include "esp_heap_caps_init.h"
 #include "soc/soc_memory_layout.h"
 
+#ifdef CONFIG_HEAP_RTCRAM_RETAIN
+#if CONFIG_IDF_TARGET_ESP32
+#include "esp32/rom/rtc.h"
+#elif CONFIG_IDF_TARGET_ESP32S2
+#include "esp32s2/rom/rtc.h"
+#elif CONFIG_IDF_TARGET_ESP32S3
+#include "esp32s3/rom/rtc.h"
+#endif
+#endif
+
 static const char *TAG = "heap_init";
 
 /* Linked-list of registered heaps */
@@ -31,6 +41,21 @@ static void register_heap(heap_t *region)
 {
     size_t heap_size = region->end - region->start;
     assert(heap_size <= HEAP_SIZE_MAX);
+#ifdef CONFIG_HEAP_RTCRAM_RETAIN
+    uint32_t all_caps = 0;
+    for (int prio = 0; prio < SOC_MEMORY_TYPE_NO_PRIOS; prio++) {
+        all_caps |= region->caps[prio];
+    }
+    if ((all_caps & MALLOC_CAP_RTCRAM) && rtc_get_reset_reason(0) == DEEPSLEEP_RESET) {
+        region->heap = multi_heap_reattach((void *)region->start, heap_size);
+        if (region->heap != NULL) {
+            ESP_EARLY_LOGD(TAG, "RTC heap at %p retained across deep sleep", region->heap);
+            return;
+        }
+        ESP_EARLY_LOGW(TAG, "RTC heap metadata at %p not valid after wakeup, initialising fresh heap",
+                       (void *)region->start);
+    }
+#endif
     region->heap = multi_heap_register((void *)region->start, heap_size);
     if (region->heap != NULL) {
         ESP_EARLY_LOGD(TAG, "New heap initialised at %p", region->heap);
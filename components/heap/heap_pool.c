@@ -0,0 +1,127 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdatomic.h>
+#include <string.h>
+#include "esp_heap_pool.h"
+#include "esp_attr.h"
+
+/* Free blocks form a singly linked list threaded through the blocks
+   themselves. The list head packs a 16-bit ABA tag into the upper bits of
+   the block index so that concurrent pop/push sequences can't be confused
+   by a block being freed and re-allocated between a reader's load and its
+   compare-exchange. Using indexes instead of pointers keeps the head in a
+   single 32-bit word, which Xtensa can CAS natively (S32C1I). */
+
+#define POOL_INDEX_NONE  0xFFFF
+
+typedef union {
+    struct {
+        uint16_t index;     /* index of first free block, or POOL_INDEX_NONE */
+        uint16_t tag;       /* incremented on every pop, defeats ABA */
+    };
+    uint32_t val;
+} pool_head_t;
+
+struct heap_pool {
+    uint8_t *blocks;
+    size_t block_size;
+    size_t block_count;
+    _Atomic uint32_t head;
+    _Atomic uint32_t free_count;
+};
+
+static inline uint16_t *pool_next_ptr(heap_pool_handle_t pool, uint16_t index)
+{
+    return (uint16_t *)(pool->blocks + (size_t)index * pool->block_size);
+}
+
+esp_err_t heap_caps_pool_create(uint32_t caps, size_t block_size, size_t block_count,
+                                heap_pool_handle_t *out_pool)
+{
+    if (block_count == 0 || block_count >= POOL_INDEX_NONE || out_pool == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    block_size = (block_size + 3) & ~(size_t)3;
+    if (block_size < 4) {
+        block_size = 4;
+    }
+    struct heap_pool *pool = heap_caps_malloc(sizeof(struct heap_pool), MALLOC_CAP_DEFAULT);
+    if (pool == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    pool->blocks = heap_caps_malloc(block_size * block_count, caps);
+    if (pool->blocks == NULL) {
+        heap_caps_free(pool);
+        return ESP_ERR_NO_MEM;
+    }
+    pool->block_size = block_size;
+    pool->block_count = block_count;
+    for (size_t i = 0; i < block_count - 1; i++) {
+        *pool_next_ptr(pool, i) = (uint16_t)(i + 1);
+    }
+    *pool_next_ptr(pool, block_count - 1) = POOL_INDEX_NONE;
+    pool_head_t head = { .index = 0, .tag = 0 };
+    atomic_init(&pool->head, head.val);
+    atomic_init(&pool->free_count, (uint32_t)block_count);
+    *out_pool = pool;
+    return ESP_OK;
+}
+
+void *IRAM_ATTR heap_caps_pool_alloc(heap_pool_handle_t pool)
+{
+    pool_head_t old_head, new_head;
+    old_head.val = atomic_load(&pool->head);
+    do {
+        if (old_head.index == POOL_INDEX_NONE) {
+            return NULL;
+        }
+        new_head.index = *pool_next_ptr(pool, old_head.index);
+        new_head.tag = old_head.tag + 1;
+    } while (!atomic_compare_exchange_weak(&pool->head, &old_head.val, new_head.val));
+    atomic_fetch_sub(&pool->free_count, 1);
+    return pool->blocks + (size_t)old_head.index * pool->block_size;
+}
+
+void *IRAM_ATTR heap_caps_pool_alloc_from_isr(heap_pool_handle_t pool)
+{
+    return heap_caps_pool_alloc(pool);
+}
+
+void IRAM_ATTR heap_caps_pool_free(heap_pool_handle_t pool, void *block)
+{
+    uint16_t index = (uint16_t)(((uint8_t *)block - pool->blocks) / pool->block_size);
+    pool_head_t old_head, new_head;
+    old_head.val = atomic_load(&pool->head);
+    do {
+        *pool_next_ptr(pool, index) = old_head.index;
+        new_head.index = index;
+        new_head.tag = old_head.tag;
+    } while (!atomic_compare_exchange_weak(&pool->head, &old_head.val, new_head.val));
+    atomic_fetch_add(&pool->free_count, 1);
+}
+
+size_t heap_caps_pool_get_free_count(heap_pool_handle_t pool)
+{
+    return atomic_load(&pool->free_count);
+}
+
+void heap_caps_pool_destroy(heap_pool_handle_t pool)
+{
+    if (pool == NULL) {
+        return;
+    }
+    heap_caps_free(pool->blocks);
+    heap_caps_free(pool);
+}
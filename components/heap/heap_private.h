@@ -75,3 +75,9 @@ void *heap_caps_malloc_default(size_t size);
 #ifdef __cplusplus
 }
 #endif
+
+#ifdef CONFIG_HEAP_CALLOC_ZERO_CACHE
+/* Try to take a pre-zeroed block from the zero cache (heap_zero_cache.c);
+   returns NULL if the cache can't satisfy the request. */
+void *heap_caps_zero_cache_take(size_t size_bytes, uint32_t caps);
+#endif
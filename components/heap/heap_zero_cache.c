@@ -0,0 +1,113 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include "esp_heap_caps.h"
+#include "esp_attr.h"
+#include "freertos/FreeRTOS.h"
+#include "heap_private.h"
+
+#ifdef CONFIG_HEAP_CALLOC_ZERO_CACHE
+
+/* Cache of pre-zeroed blocks used to elide the bzero() in calloc.
+
+   These SoCs have no hardware-known-zero memory, so the zeros are produced
+   off the hot path instead: heap_caps_zero_cache_refill() (called from a
+   housekeeping task or the idle hook) allocates and zeroes blocks ahead of
+   time, and heap_caps_calloc() hands them out without touching memset.
+
+   The cache holds blocks of one size class; calloc requests up to that size
+   are served from it. */
+
+typedef struct {
+    void *ptr;
+} zero_cache_slot_t;
+
+static zero_cache_slot_t s_slots[CONFIG_HEAP_CALLOC_ZERO_CACHE_DEPTH];
+static size_t s_slot_count;     // number of filled slots
+static size_t s_block_size;
+static uint32_t s_block_caps;
+static portMUX_TYPE s_zero_cache_lock = portMUX_INITIALIZER_UNLOCKED;
+
+esp_err_t heap_caps_zero_cache_config(uint32_t caps, size_t block_size)
+{
+    if (block_size == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&s_zero_cache_lock);
+    /* Drop any cached blocks of the old size class */
+    size_t count = s_slot_count;
+    void *to_free[CONFIG_HEAP_CALLOC_ZERO_CACHE_DEPTH];
+    for (size_t i = 0; i < count; i++) {
+        to_free[i] = s_slots[i].ptr;
+    }
+    s_slot_count = 0;
+    s_block_size = block_size;
+    s_block_caps = caps;
+    portEXIT_CRITICAL(&s_zero_cache_lock);
+    for (size_t i = 0; i < count; i++) {
+        heap_caps_free(to_free[i]);
+    }
+    return ESP_OK;
+}
+
+size_t heap_caps_zero_cache_refill(void)
+{
+    size_t added = 0;
+    while (true) {
+        portENTER_CRITICAL(&s_zero_cache_lock);
+        size_t block_size = s_block_size;
+        uint32_t caps = s_block_caps;
+        bool full = (block_size == 0 || s_slot_count >= CONFIG_HEAP_CALLOC_ZERO_CACHE_DEPTH);
+        portEXIT_CRITICAL(&s_zero_cache_lock);
+        if (full) {
+            return added;
+        }
+
+        void *block = heap_caps_malloc(block_size, caps);
+        if (block == NULL) {
+            return added;
+        }
+        bzero(block, block_size);
+
+        portENTER_CRITICAL(&s_zero_cache_lock);
+        if (s_block_size == block_size && s_slot_count < CONFIG_HEAP_CALLOC_ZERO_CACHE_DEPTH) {
+            s_slots[s_slot_count++].ptr = block;
+            block = NULL;
+            added++;
+        }
+        portEXIT_CRITICAL(&s_zero_cache_lock);
+        if (block != NULL) {
+            /* Raced with a config change or a concurrent refill */
+            heap_caps_free(block);
+            return added;
+        }
+    }
+}
+
+/* Called from heap_caps_calloc(). Returns a pre-zeroed block of at least
+   size_bytes matching the requested caps, or NULL to fall back to the
+   regular malloc + bzero path. */
+void *heap_caps_zero_cache_take(size_t size_bytes, uint32_t caps)
+{
+    void *result = NULL;
+    portENTER_CRITICAL(&s_zero_cache_lock);
+    if (s_slot_count > 0 && size_bytes <= s_block_size && (caps & ~s_block_caps) == 0) {
+        result = s_slots[--s_slot_count].ptr;
+    }
+    portEXIT_CRITICAL(&s_zero_cache_lock);
+    return result;
+}
+
+#endif // CONFIG_HEAP_CALLOC_ZERO_CACHE
@@ -0,0 +1,71 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <stdint.h>
+#include "esp_heap_caps.h"
+#include "multi_heap.h"
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef CONFIG_HEAP_ALLOC_TAGGING
+
+/**
+ * @brief Set the allocation class tag for the calling task
+ *
+ * Every subsequent heap allocation made from this task is stamped with
+ * this one-byte tag in its block header. Tag 0 is the default for tasks
+ * which never set a tag.
+ *
+ * The tag is stored in the FreeRTOS thread local storage pointer at index
+ * CONFIG_HEAP_ALLOC_TAG_TLS_INDEX.
+ *
+ * @param tag Class tag to apply to this task's future allocations
+ */
+void heap_caps_set_alloc_tag(uint8_t tag);
+
+/**
+ * @brief Get the allocation class tag of the calling task
+ *
+ * @return The task's current tag (0 if never set)
+ */
+uint8_t heap_caps_get_alloc_tag(void);
+
+/**
+ * @brief Get heap info for blocks carrying a given class tag
+ *
+ * Walks all registered heaps matching the given capabilities and fills
+ * ``info`` with totals for allocated blocks stamped with ``tag``. Only the
+ * total_allocated_bytes, allocated_blocks and largest_free_block fields
+ * relate to the tag; free-space fields describe the matching heaps as a
+ * whole.
+ *
+ * Unlike heap tracing this walk is cheap enough for production use: it
+ * takes each heap's lock only for the duration of the walk and performs
+ * no allocation itself.
+ *
+ * @param tag Class tag to filter on
+ * @param caps Capabilities of the heaps to inspect
+ * @param[out] info Structure to fill with the results
+ */
+void heap_caps_get_info_by_tag(uint8_t tag, uint32_t caps, multi_heap_info_t *info);
+
+#endif // CONFIG_HEAP_ALLOC_TAGGING
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,113 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "esp_err.h"
+#include "esp_heap_caps.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Opaque handle to a heap arena
+ *
+ * An arena is a fixed-size region carved out of the capability heaps once,
+ * which then serves allocations with pointer-bump speed. Individual
+ * allocations cannot be freed; instead the whole arena is reset in O(1).
+ * This is intended for tasks which allocate many short-lived buffers with
+ * a common lifetime (e.g. per-packet or per-frame scratch memory), avoiding
+ * the cost and lock contention of the general TLSF allocator.
+ */
+typedef struct heap_arena *heap_arena_handle_t;
+
+/**
+ * @brief Create a new arena backed by memory with the given capabilities
+ *
+ * The backing region is allocated with heap_caps_malloc() and is owned by
+ * the arena until heap_arena_destroy() is called.
+ *
+ * @param caps Capabilities of the backing memory (MALLOC_CAP_* flags)
+ * @param size Usable size of the arena, in bytes
+ * @param[out] out_arena Handle of the created arena
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if size is zero or out_arena is NULL
+ *      - ESP_ERR_NO_MEM if the backing region can't be allocated
+ */
+esp_err_t heap_arena_create(uint32_t caps, size_t size, heap_arena_handle_t *out_arena);
+
+/**
+ * @brief Allocate memory from an arena
+ *
+ * Allocations are aligned to 4 bytes. This function is safe to call
+ * concurrently from multiple tasks, but an arena bound to a single task
+ * (the intended usage) takes only an uncontended spinlock.
+ *
+ * @param arena Arena to allocate from
+ * @param size Number of bytes to allocate
+ * @return Pointer to allocated memory, or NULL if the arena is exhausted
+ */
+void *heap_arena_alloc(heap_arena_handle_t arena, size_t size);
+
+/**
+ * @brief Reset an arena, invalidating all outstanding allocations in O(1)
+ *
+ * @param arena Arena to reset
+ */
+void heap_arena_reset(heap_arena_handle_t arena);
+
+/**
+ * @brief Destroy an arena and return its backing region to the heap
+ *
+ * @param arena Arena to destroy. All outstanding allocations become invalid.
+ */
+void heap_arena_destroy(heap_arena_handle_t arena);
+
+/**
+ * @brief Get the number of bytes still available in an arena
+ *
+ * @param arena Arena to query
+ * @return Free space in bytes
+ */
+size_t heap_arena_get_free_size(heap_arena_handle_t arena);
+
+/**
+ * @brief Bind an arena to the calling task
+ *
+ * The bound arena can be retrieved later from the same task via
+ * heap_arena_get_bound(). This allows library code running in the task's
+ * context to serve transient allocations from the task's arena without
+ * threading the handle through every call.
+ *
+ * The binding uses the FreeRTOS thread local storage pointer at index
+ * CONFIG_HEAP_ARENA_TLS_INDEX.
+ *
+ * @param arena Arena to bind, or NULL to clear the binding
+ */
+void heap_arena_bind_to_task(heap_arena_handle_t arena);
+
+/**
+ * @brief Get the arena bound to the calling task, if any
+ *
+ * @return Bound arena handle, or NULL if the task has no bound arena
+ */
+heap_arena_handle_t heap_arena_get_bound(void);
+
+#ifdef __cplusplus
+}
+#endif
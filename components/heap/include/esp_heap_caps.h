@@ -40,6 +40,9 @@ extern "C" {
 #define MALLOC_CAP_INTERNAL         (1<<11) ///< Memory must be internal; specifically it should not disappear when flash/spiram cache is switched off
 #define MALLOC_CAP_DEFAULT          (1<<12) ///< Memory can be returned in a non-capability-specific memory allocation (e.g. malloc(), calloc()) call
 #define MALLOC_CAP_IRAM_8BIT        (1<<13) ///< Memory must be in IRAM and allow unaligned access
+#define MALLOC_CAP_HOT              (1<<14) ///< Placement hint: frequently accessed, prefer internal RAM, fall back to any matching memory
+#define MALLOC_CAP_COLD             (1<<15) ///< Placement hint: rarely accessed, prefer SPI RAM, fall back to any matching memory
+#define MALLOC_CAP_RTCRAM           (1<<16) ///< Memory must be in RTC fast memory, contents are retained during deep sleep
 
 #define MALLOC_CAP_INVALID          (1<<31) ///< Memory can't be used / list end marker
 
@@ -85,6 +88,59 @@ void *heap_caps_malloc(size_t size, uint32_t caps);
  */
 void heap_caps_free( void *ptr);
 
+/**
+ * @brief Free memory previously allocated via heap_caps_malloc() or heap_caps_realloc(),
+ * deferring the actual release (and block coalescing) to a later flush.
+ *
+ * The pointer is pushed onto a lock-free pending list in O(1) without taking
+ * the heap lock, making this suitable for latency-critical paths which free
+ * many blocks in bursts. The memory only becomes available for reuse once
+ * heap_caps_flush_deferred_free() runs (typically from a housekeeping task or
+ * idle hook).
+ *
+ * @param ptr Pointer to memory previously returned from heap_caps_(m/c/re/z)alloc().
+ *            Can be NULL, in which case this is a no-op.
+ */
+void heap_caps_free_deferred(void *ptr);
+
+/**
+ * @brief Release all memory queued by heap_caps_free_deferred()
+ *
+ * Hands the whole pending batch to the allocator in one go, amortising the
+ * coalescing work. Must not be called from an ISR.
+ *
+ * @return Number of blocks released
+ */
+size_t heap_caps_flush_deferred_free(void);
+
+#ifdef CONFIG_HEAP_CALLOC_ZERO_CACHE
+/**
+ * @brief Configure the calloc zero cache with a block size class
+ *
+ * calloc requests up to block_size bytes whose caps are satisfied by
+ * the given caps will be served from a cache of pre-zeroed blocks,
+ * eliding the zero fill on the allocation path. Reconfiguring drops any
+ * currently cached blocks.
+ *
+ * @param caps Capabilities of the cached blocks (MALLOC_CAP_* flags)
+ * @param block_size Size of each cached block, in bytes
+ * @return ESP_OK, or ESP_ERR_INVALID_ARG if block_size is zero
+ */
+esp_err_t heap_caps_zero_cache_config(uint32_t caps, size_t block_size);
+
+/**
+ * @brief Refill the calloc zero cache
+ *
+ * Allocates and zeroes blocks until the cache is full (depth set by
+ * CONFIG_HEAP_CALLOC_ZERO_CACHE_DEPTH) or allocation fails. Call this
+ * from a housekeeping task or idle hook so that the zeroing cost is paid
+ * off the allocation path.
+ *
+ * @return Number of blocks added to the cache
+ */
+size_t heap_caps_zero_cache_refill(void);
+#endif
+
 /**
  * @brief Reallocate memory previously allocated via heap_caps_malloc() or heap_caps_realloc().
  *
@@ -317,6 +373,55 @@ bool heap_caps_check_integrity_addr(intptr_t addr, bool print_errors);
  */
 void heap_caps_malloc_extmem_enable(size_t limit);
 
+/**
+ * @brief Counters of the MALLOC_CAP_HOT/MALLOC_CAP_COLD placement policy
+ *
+ * A "spill" is a hinted allocation which could not be satisfied from its
+ * preferred memory type and fell back to the unhinted capabilities. A
+ * growing hot spill count means latency-sensitive buffers are landing in
+ * SPI RAM and internal memory should be freed up (or the hints revisited).
+ */
+typedef struct {
+    size_t hot_allocs;          ///< Allocations requested with MALLOC_CAP_HOT
+    size_t hot_spills;          ///< Hot allocations which did not fit in internal RAM
+    size_t hot_spilled_bytes;   ///< Total size of spilled hot allocations
+    size_t cold_allocs;         ///< Allocations requested with MALLOC_CAP_COLD
+    size_t cold_spills;         ///< Cold allocations which did not fit in SPI RAM
+    size_t cold_spilled_bytes;  ///< Total size of spilled cold allocations
+} heap_caps_placement_stats_t;
+
+/**
+ * @brief Get a snapshot of the placement hint counters
+ *
+ * @param stats Filled with the current counter values
+ */
+void heap_caps_get_placement_stats(heap_caps_placement_stats_t *stats);
+
+/**
+ * @brief Reset the placement hint counters to zero
+ */
+void heap_caps_reset_placement_stats(void);
+
+/**
+ * @brief Move an allocation to memory with the given capabilities
+ *
+ * Checks where the buffer currently lives and moves it (allocate, copy,
+ * free) only when its heap does not satisfy the requested capabilities;
+ * a correctly placed buffer is returned unchanged. MALLOC_CAP_HOT and
+ * MALLOC_CAP_COLD translate to hard requirements for internal RAM and SPI
+ * RAM respectively here, since migration is an explicit placement request.
+ * Use this to promote a buffer that turned out to be hot into internal RAM,
+ * or demote a cold one to SPI RAM, without tearing down its users.
+ *
+ * @param ptr  Pointer to memory previously returned from heap_caps_malloc() et al.
+ * @param caps Bitwise OR of MALLOC_CAP_* flags for the desired placement
+ *
+ * @return Pointer to the buffer in suitable memory (possibly moved; treat
+ *         like the return of realloc), or NULL if no suitable memory is
+ *         available, in which case the original buffer remains valid.
+ */
+void *heap_caps_migrate(void *ptr, uint32_t caps);
+
 /**
  * @brief Allocate a chunk of memory as preference in decreasing order.
  *
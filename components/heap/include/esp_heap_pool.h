@@ -0,0 +1,107 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "esp_err.h"
+#include "esp_heap_caps.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Opaque handle to a fixed-size block pool
+ *
+ * A block pool serves allocations of a single fixed size from a region
+ * carved out of the capability heaps. The free list is maintained with
+ * atomic compare-and-swap operations only, so allocation and free never
+ * take the multi_heap lock and are safe to call from ISRs on either core
+ * without spinning on a mutex held by the other core.
+ *
+ * Typical users are DMA descriptors and packet headers allocated from
+ * Wi-Fi / Ethernet RX callbacks.
+ */
+typedef struct heap_pool *heap_pool_handle_t;
+
+/**
+ * @brief Create a fixed-size block pool
+ *
+ * @param caps Capabilities of the backing memory (MALLOC_CAP_* flags).
+ *             Include MALLOC_CAP_DMA for DMA descriptor pools.
+ * @param block_size Size of each block, in bytes (rounded up to 4 bytes,
+ *                   minimum 4 bytes)
+ * @param block_count Number of blocks in the pool
+ * @param[out] out_pool Handle of the created pool
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if block_count is zero or out_pool is NULL
+ *      - ESP_ERR_NO_MEM if the backing region can't be allocated
+ */
+esp_err_t heap_caps_pool_create(uint32_t caps, size_t block_size, size_t block_count,
+                                heap_pool_handle_t *out_pool);
+
+/**
+ * @brief Allocate one block from a pool (task context)
+ *
+ * @param pool Pool to allocate from
+ * @return Pointer to a block of the pool's block size, or NULL if the
+ *         pool is empty
+ */
+void *heap_caps_pool_alloc(heap_pool_handle_t pool);
+
+/**
+ * @brief Allocate one block from a pool, from an ISR
+ *
+ * Identical to heap_caps_pool_alloc() but named explicitly for use in
+ * interrupt context; the implementation is lock-free and does not block.
+ *
+ * @param pool Pool to allocate from
+ * @return Pointer to a block, or NULL if the pool is empty
+ */
+void *heap_caps_pool_alloc_from_isr(heap_pool_handle_t pool);
+
+/**
+ * @brief Return a block to its pool. Safe from ISRs.
+ *
+ * @param pool Pool the block was allocated from
+ * @param block Block to free
+ */
+void heap_caps_pool_free(heap_pool_handle_t pool, void *block);
+
+/**
+ * @brief Get the number of blocks currently available in a pool
+ *
+ * The result is a snapshot and may be stale by the time it is used.
+ *
+ * @param pool Pool to query
+ * @return Number of free blocks
+ */
+size_t heap_caps_pool_get_free_count(heap_pool_handle_t pool);
+
+/**
+ * @brief Destroy a pool and return its backing region to the heap
+ *
+ * The caller must ensure no blocks are in use and no other context can
+ * still allocate from the pool.
+ *
+ * @param pool Pool to destroy
+ */
+void heap_caps_pool_destroy(heap_pool_handle_t pool);
+
+#ifdef __cplusplus
+}
+#endif
@@ -105,6 +105,25 @@ size_t multi_heap_get_allocated_size(multi_heap_handle_t heap, void *p);
  */
 multi_heap_handle_t multi_heap_register(void *start, size_t size);
 
+/** @brief Re-attach to a heap that was previously registered in the same memory
+ *
+ * Used for heaps placed in memory which retains its contents across a reset, such as
+ * RTC fast memory across deep sleep. Instead of initialising fresh heap metadata (which
+ * would discard all existing allocations), this function validates the metadata left
+ * over from the previous boot and returns a handle to the existing heap.
+ *
+ * The start address and size must exactly match the values passed to multi_heap_register()
+ * on the previous boot. The heap's lock association is reset; call multi_heap_set_lock()
+ * again if needed.
+ *
+ * @param start Start address of the memory holding the previously registered heap.
+ * @param size Size (in bytes) of the heap, same as passed to multi_heap_register().
+ *
+ * @return Handle of the existing heap, or NULL if no valid heap metadata was found
+ *         (in which case the region should be registered as a fresh heap instead).
+ */
+multi_heap_handle_t multi_heap_reattach(void *start, size_t size);
+
 
 /** @brief Associate a private lock pointer with a heap
  *
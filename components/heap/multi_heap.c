@@ -70,6 +70,11 @@ void *multi_heap_get_block_owner(multi_heap_block_handle_t block)
     return NULL;
 }
 
+uint8_t multi_heap_get_block_tag(multi_heap_block_handle_t block)
+{
+    return 0;
+}
+
 #endif
 
 #define ALIGN(X) ((X) & ~(sizeof(void *)-1))
@@ -142,6 +147,34 @@ multi_heap_handle_t multi_heap_register_impl(void *start_ptr, size_t size)
     return result;
 }
 
+multi_heap_handle_t multi_heap_reattach(void *start_ptr, size_t size)
+{
+    assert(start_ptr);
+    if(size < (tlsf_size() + tlsf_block_size_min() + sizeof(heap_t))) {
+        return NULL;
+    }
+
+    heap_t *heap = (heap_t *)start_ptr;
+
+    /* Don't trust anything left in this memory until the metadata looks like what
+       multi_heap_register_impl() would have written for this exact region. */
+    if (heap->heap_data != (tlsf_t)(start_ptr + sizeof(heap_t)) ||
+            heap->pool_size != size - sizeof(heap_t) ||
+            heap->free_bytes > heap->pool_size ||
+            heap->minimum_free_bytes > heap->free_bytes) {
+        return NULL;
+    }
+
+    /* The lock pointer from the previous boot is stale, clear it before
+       multi_heap_check() tries to take it. */
+    heap->lock = NULL;
+
+    if (!multi_heap_check(heap, false)) {
+        return NULL;
+    }
+    return heap;
+}
+
 void multi_heap_set_lock(multi_heap_handle_t heap, void *lock)
 {
     heap->lock = lock;
@@ -69,3 +69,7 @@ void *multi_heap_get_block_address(multi_heap_block_handle_t block);
 
 /* Get the owner identification for a heap block */
 void *multi_heap_get_block_owner(multi_heap_block_handle_t block);
+
+/* Get the tag identifier for an allocated block. Only useful if the
+   CONFIG_HEAP_ALLOC_TAGGING option is set; returns 0 otherwise. */
+uint8_t multi_heap_get_block_tag(multi_heap_block_handle_t block);
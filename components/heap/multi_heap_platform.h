@@ -88,6 +88,19 @@ inline static void multi_heap_assert(bool condition, const char *format, int lin
 #define MULTI_HEAP_GET_BLOCK_OWNER(HEAD) (NULL)
 #endif
 
+#ifdef CONFIG_HEAP_ALLOC_TAGGING
+#include <freertos/task.h>
+/* The tag is logically one byte, but stored as a word to keep the poison
+   head (and therefore the returned buffer) word aligned. */
+#define MULTI_HEAP_BLOCK_TAG uint32_t tag;
+#define MULTI_HEAP_SET_BLOCK_TAG(HEAD) (HEAD)->tag = (uint32_t)(uintptr_t)pvTaskGetThreadLocalStoragePointer(NULL, CONFIG_HEAP_ALLOC_TAG_TLS_INDEX)
+#define MULTI_HEAP_GET_BLOCK_TAG(HEAD) ((uint8_t)(HEAD)->tag)
+#else
+#define MULTI_HEAP_BLOCK_TAG
+#define MULTI_HEAP_SET_BLOCK_TAG(HEAD)
+#define MULTI_HEAP_GET_BLOCK_TAG(HEAD) (0)
+#endif
+
 #else // MULTI_HEAP_FREERTOS
 
 #include <assert.h>
@@ -107,4 +120,8 @@ typedef int multi_heap_lock_t;
 #define MULTI_HEAP_SET_BLOCK_OWNER(HEAD)
 #define MULTI_HEAP_GET_BLOCK_OWNER(HEAD) (NULL)
 
+#define MULTI_HEAP_BLOCK_TAG
+#define MULTI_HEAP_SET_BLOCK_TAG(HEAD)
+#define MULTI_HEAP_GET_BLOCK_TAG(HEAD) (0)
+
 #endif // MULTI_HEAP_FREERTOS
@@ -51,6 +51,7 @@
 typedef struct {
     uint32_t head_canary;
     MULTI_HEAP_BLOCK_OWNER
+    MULTI_HEAP_BLOCK_TAG
     size_t alloc_size;
 } poison_head_t;
 
@@ -72,6 +73,7 @@ static uint8_t *poison_allocated_region(poison_head_t *head, size_t alloc_size)
     head->alloc_size = alloc_size;
     head->head_canary = HEAD_CANARY_PATTERN;
     MULTI_HEAP_SET_BLOCK_OWNER(head);
+    MULTI_HEAP_SET_BLOCK_TAG(head);
 
     uint32_t tail_canary = TAIL_CANARY_PATTERN;
     if ((intptr_t)tail % sizeof(void *) == 0) {
@@ -332,6 +334,11 @@ void *multi_heap_get_block_owner(multi_heap_block_handle_t block)
     return MULTI_HEAP_GET_BLOCK_OWNER((poison_head_t*)multi_heap_get_block_address_impl(block));
 }
 
+uint8_t multi_heap_get_block_tag(multi_heap_block_handle_t block)
+{
+    return MULTI_HEAP_GET_BLOCK_TAG((poison_head_t*)multi_heap_get_block_address_impl(block));
+}
+
 multi_heap_handle_t multi_heap_register(void *start, size_t size)
 {
 #ifdef SLOW
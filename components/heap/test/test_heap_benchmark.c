@@ -0,0 +1,113 @@
+/*
+ Heap benchmark suite: measures alloc/free latency distributions
+ (min / max / average / percentiles) for the allocator APIs, so that
+ allocator changes can be compared run to run.
+*/
+#include "freertos/FreeRTOS.h"
+#include <esp_types.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "unity.h"
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "esp_heap_arena.h"
+#include "esp_heap_pool.h"
+#include <test_utils.h>
+
+#define BENCH_SAMPLES 2048
+#define BENCH_ALLOC_SIZE 128
+
+static uint32_t s_samples[BENCH_SAMPLES];
+
+static int compare_u32(const void *a, const void *b)
+{
+    uint32_t ua = *(const uint32_t *)a;
+    uint32_t ub = *(const uint32_t *)b;
+    return (ua > ub) - (ua < ub);
+}
+
+static void report_distribution(const char *name, uint32_t *samples, size_t count)
+{
+    qsort(samples, count, sizeof(uint32_t), compare_u32);
+    uint64_t sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        sum += samples[i];
+    }
+    printf("%-24s min %6u avg %6u p50 %6u p95 %6u p99 %6u max %6u (cycles, %u samples)\n",
+           name, samples[0], (uint32_t)(sum / count),
+           samples[count / 2], samples[(count * 95) / 100],
+           samples[(count * 99) / 100], samples[count - 1], (unsigned)count);
+}
+
+TEST_CASE("benchmark heap_caps_malloc/free latency distribution", "[heap]")
+{
+    void *ptrs[BENCH_SAMPLES];
+
+    for (int i = 0; i < BENCH_SAMPLES; i++) {
+        uint32_t before = portGET_RUN_TIME_COUNTER_VALUE();
+        ptrs[i] = heap_caps_malloc(BENCH_ALLOC_SIZE, MALLOC_CAP_DEFAULT);
+        s_samples[i] = portGET_RUN_TIME_COUNTER_VALUE() - before;
+        TEST_ASSERT_NOT_NULL(ptrs[i]);
+    }
+    report_distribution("heap_caps_malloc", s_samples, BENCH_SAMPLES);
+
+    for (int i = 0; i < BENCH_SAMPLES; i++) {
+        uint32_t before = portGET_RUN_TIME_COUNTER_VALUE();
+        heap_caps_free(ptrs[i]);
+        s_samples[i] = portGET_RUN_TIME_COUNTER_VALUE() - before;
+    }
+    report_distribution("heap_caps_free", s_samples, BENCH_SAMPLES);
+}
+
+TEST_CASE("benchmark deferred free latency distribution", "[heap]")
+{
+    void *ptrs[BENCH_SAMPLES];
+    for (int i = 0; i < BENCH_SAMPLES; i++) {
+        ptrs[i] = heap_caps_malloc(BENCH_ALLOC_SIZE, MALLOC_CAP_DEFAULT);
+        TEST_ASSERT_NOT_NULL(ptrs[i]);
+    }
+    for (int i = 0; i < BENCH_SAMPLES; i++) {
+        uint32_t before = portGET_RUN_TIME_COUNTER_VALUE();
+        heap_caps_free_deferred(ptrs[i]);
+        s_samples[i] = portGET_RUN_TIME_COUNTER_VALUE() - before;
+    }
+    report_distribution("heap_caps_free_deferred", s_samples, BENCH_SAMPLES);
+    TEST_ASSERT_EQUAL(BENCH_SAMPLES, heap_caps_flush_deferred_free());
+}
+
+TEST_CASE("benchmark arena alloc latency distribution", "[heap]")
+{
+    heap_arena_handle_t arena;
+    TEST_ESP_OK(heap_arena_create(MALLOC_CAP_DEFAULT, BENCH_SAMPLES * BENCH_ALLOC_SIZE, &arena));
+    for (int i = 0; i < BENCH_SAMPLES; i++) {
+        uint32_t before = portGET_RUN_TIME_COUNTER_VALUE();
+        void *p = heap_arena_alloc(arena, BENCH_ALLOC_SIZE);
+        s_samples[i] = portGET_RUN_TIME_COUNTER_VALUE() - before;
+        TEST_ASSERT_NOT_NULL(p);
+    }
+    report_distribution("heap_arena_alloc", s_samples, BENCH_SAMPLES);
+    heap_arena_destroy(arena);
+}
+
+TEST_CASE("benchmark block pool alloc/free latency distribution", "[heap]")
+{
+    heap_pool_handle_t pool;
+    TEST_ESP_OK(heap_caps_pool_create(MALLOC_CAP_DEFAULT, BENCH_ALLOC_SIZE, 256, &pool));
+    void *ptrs[256] = { 0 };
+    for (int i = 0; i < BENCH_SAMPLES; i++) {
+        int slot = i % 256;
+        if (ptrs[slot] != NULL) {
+            heap_caps_pool_free(pool, ptrs[slot]);
+        }
+        uint32_t before = portGET_RUN_TIME_COUNTER_VALUE();
+        ptrs[slot] = heap_caps_pool_alloc(pool);
+        s_samples[i] = portGET_RUN_TIME_COUNTER_VALUE() - before;
+        TEST_ASSERT_NOT_NULL(ptrs[slot]);
+    }
+    report_distribution("heap_caps_pool_alloc", s_samples, BENCH_SAMPLES);
+    for (int i = 0; i < 256; i++) {
+        heap_caps_pool_free(pool, ptrs[i]);
+    }
+    heap_caps_pool_destroy(pool);
+}
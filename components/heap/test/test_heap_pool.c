@@ -0,0 +1,47 @@
+/*
+ Tests for the lock-free fixed-size block pool allocator.
+*/
+
+#include <stdlib.h>
+#include "unity.h"
+#include "esp_heap_pool.h"
+
+TEST_CASE("block pool alloc/free cycle", "[heap]")
+{
+    const size_t count = 16;
+    heap_pool_handle_t pool;
+    TEST_ESP_OK(heap_caps_pool_create(MALLOC_CAP_DEFAULT, 32, count, &pool));
+    TEST_ASSERT_EQUAL(count, heap_caps_pool_get_free_count(pool));
+
+    void *blocks[16];
+    for (size_t i = 0; i < count; i++) {
+        blocks[i] = heap_caps_pool_alloc(pool);
+        TEST_ASSERT_NOT_NULL(blocks[i]);
+    }
+    TEST_ASSERT_EQUAL(0, heap_caps_pool_get_free_count(pool));
+    TEST_ASSERT_NULL(heap_caps_pool_alloc(pool));
+
+    for (size_t i = 0; i < count; i++) {
+        heap_caps_pool_free(pool, blocks[i]);
+    }
+    TEST_ASSERT_EQUAL(count, heap_caps_pool_get_free_count(pool));
+
+    heap_caps_pool_destroy(pool);
+}
+
+TEST_CASE("block pool blocks are distinct and writable", "[heap]")
+{
+    heap_pool_handle_t pool;
+    TEST_ESP_OK(heap_caps_pool_create(MALLOC_CAP_DEFAULT, 8, 4, &pool));
+    uint32_t *a = heap_caps_pool_alloc(pool);
+    uint32_t *b = heap_caps_pool_alloc(pool);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_NOT_EQUAL(a, b);
+    *a = 0x12345678;
+    *b = 0x87654321;
+    TEST_ASSERT_EQUAL_HEX32(0x12345678, *a);
+    heap_caps_pool_free(pool, b);
+    heap_caps_pool_free(pool, a);
+    heap_caps_pool_destroy(pool);
+}
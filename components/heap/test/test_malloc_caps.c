@@ -8,7 +8,9 @@
 #include "esp_attr.h"
 #include "esp_heap_caps.h"
 #include "esp_spi_flash.h"
+#include "soc/soc_memory_layout.h"
 #include <stdlib.h>
+#include <string.h>
 #include <sys/param.h>
 
 #ifndef CONFIG_ESP32S2_MEMPROT_FEATURE
@@ -245,3 +247,44 @@ TEST_CASE("allocation with invalid capability should also trigger the alloc fail
 
     (void)ptr;
 }
+
+TEST_CASE("hot/cold placement hints allocate and fall back", "[heap]")
+{
+    heap_caps_placement_stats_t stats_before, stats_after;
+    heap_caps_get_placement_stats(&stats_before);
+
+    /* A hot allocation must land in internal RAM while any is available */
+    void *hot = heap_caps_malloc(64, MALLOC_CAP_HOT | MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(hot);
+    TEST_ASSERT(esp_ptr_internal(hot));
+
+    /* A cold allocation prefers SPI RAM but must still succeed without it */
+    void *cold = heap_caps_malloc(64, MALLOC_CAP_COLD | MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(cold);
+
+    heap_caps_get_placement_stats(&stats_after);
+    TEST_ASSERT_EQUAL(stats_before.hot_allocs + 1, stats_after.hot_allocs);
+    TEST_ASSERT_EQUAL(stats_before.cold_allocs + 1, stats_after.cold_allocs);
+
+    heap_caps_free(hot);
+    heap_caps_free(cold);
+}
+
+TEST_CASE("heap_caps_migrate moves buffers only when needed", "[heap]")
+{
+    char *buf = heap_caps_malloc(128, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(buf);
+    memset(buf, 0xa5, 128);
+
+    /* Already internal: migrating to hot placement must be a no-op */
+    char *same = heap_caps_migrate(buf, MALLOC_CAP_HOT | MALLOC_CAP_8BIT);
+    TEST_ASSERT_EQUAL_PTR(buf, same);
+
+    /* Migrating to a satisfiable capability keeps the contents intact */
+    char *moved = heap_caps_migrate(buf, MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(moved);
+    for (int i = 0; i < 128; i++) {
+        TEST_ASSERT_EQUAL_HEX8(0xa5, moved[i]);
+    }
+    heap_caps_free(moved);
+}
@@ -3,9 +3,11 @@
 */
 
 #include <stdio.h>
+#include <string.h>
 #include "unity.h"
 #include "esp_heap_caps_init.h"
 #include "esp_system.h"
+#include "multi_heap.h"
 #include <stdlib.h>
 
 
@@ -70,3 +72,34 @@ TEST_CASE("Add .bss memory to heap region runtime", "[heap][ignore]")
     /* Twice add must be failed */
     TEST_ASSERT( (heap_caps_add_region((intptr_t)s_buffer, (intptr_t)s_buffer + BUF_SZ) != ESP_OK) );
 }
+
+TEST_CASE("multi_heap_reattach recovers an existing heap", "[heap]")
+{
+    const size_t BUF_SZ = 2048;
+    void *buffer = malloc(BUF_SZ);
+    TEST_ASSERT_NOT_NULL(buffer);
+
+    multi_heap_handle_t heap = multi_heap_register(buffer, BUF_SZ);
+    TEST_ASSERT_NOT_NULL(heap);
+    uint8_t *p = multi_heap_malloc(heap, 128);
+    TEST_ASSERT_NOT_NULL(p);
+    memset(p, 0xA5, 128);
+    size_t free_before = multi_heap_free_size(heap);
+
+    /* Simulate a deep sleep wakeup: the memory contents are intact, but the
+       heap handle has to be re-derived from the raw region */
+    multi_heap_handle_t reattached = multi_heap_reattach(buffer, BUF_SZ);
+    TEST_ASSERT_EQUAL_PTR(heap, reattached);
+    TEST_ASSERT_EQUAL(free_before, multi_heap_free_size(reattached));
+    for (int i = 0; i < 128; i++) {
+        TEST_ASSERT_EQUAL_HEX8(0xA5, p[i]);
+    }
+
+    /* The reattached heap is still usable */
+    multi_heap_free(reattached, p);
+
+    /* A region which never held a heap must be rejected */
+    memset(buffer, 0, BUF_SZ);
+    TEST_ASSERT_NULL(multi_heap_reattach(buffer, BUF_SZ));
+    free(buffer);
+}
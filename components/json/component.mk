@@ -1,7 +1,7 @@
 #
 # Component Makefile
 #
-COMPONENT_ADD_INCLUDEDIRS := cJSON
-COMPONENT_SRCDIRS := cJSON
+COMPONENT_ADD_INCLUDEDIRS := cJSON esp_json/include
+COMPONENT_SRCDIRS := cJSON esp_json
 COMPONENT_SUBMODULES := cJSON
-COMPONENT_OBJS := cJSON/cJSON.o cJSON/cJSON_Utils.o
+COMPONENT_OBJS := cJSON/cJSON.o cJSON/cJSON_Utils.o esp_json/esp_json_stream.o esp_json/esp_json_print.o
@@ -0,0 +1,253 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "esp_json_print.h"
+
+/* Staging buffer for the stream variant; one callback per this many bytes */
+#define JSON_STREAM_CHUNK 128
+
+/* Worst case printed double plus sign, exponent and NUL */
+#define JSON_NUMBER_PRINT_BUF 32
+
+typedef struct {
+    // exactly one of these three output modes is active
+    size_t *count;              // sizing pass: only count bytes
+    char *mem;                  // fill pass: write into a sized buffer
+    esp_json_write_cb_t cb;     // stream pass: flush chunks to the callback
+    void *ctx;
+    char chunk[JSON_STREAM_CHUNK];
+    size_t chunk_used;
+    size_t mem_used;
+    bool failed;
+} json_printer_t;
+
+static void print_flush(json_printer_t *p)
+{
+    if (p->chunk_used && !p->failed) {
+        if (p->cb(p->chunk, p->chunk_used, p->ctx) != 0) {
+            p->failed = true;
+        }
+    }
+    p->chunk_used = 0;
+}
+
+static void print_write(json_printer_t *p, const char *data, size_t len)
+{
+    if (p->failed) {
+        return;
+    }
+    if (p->count) {
+        *p->count += len;
+        return;
+    }
+    if (p->mem) {
+        memcpy(p->mem + p->mem_used, data, len);
+        p->mem_used += len;
+        return;
+    }
+    while (len) {
+        size_t room = JSON_STREAM_CHUNK - p->chunk_used;
+        size_t copy = (len < room) ? len : room;
+        memcpy(p->chunk + p->chunk_used, data, copy);
+        p->chunk_used += copy;
+        data += copy;
+        len -= copy;
+        if (p->chunk_used == JSON_STREAM_CHUNK) {
+            print_flush(p);
+            if (p->failed) {
+                return;
+            }
+        }
+    }
+}
+
+static void print_char(json_printer_t *p, char c)
+{
+    print_write(p, &c, 1);
+}
+
+static void print_indent(json_printer_t *p, int depth)
+{
+    print_char(p, '\n');
+    for (int i = 0; i < depth; i++) {
+        print_char(p, '\t');
+    }
+}
+
+/**
+ * Format a number the way cJSON does: shortest representation that parses
+ * back to the same double. Both passes format the same value identically,
+ * which keeps the sizing pass exact.
+ */
+static void print_number(json_printer_t *p, double value)
+{
+    char buf[JSON_NUMBER_PRINT_BUF];
+    int len;
+
+    if (isnan(value) || isinf(value)) {
+        len = snprintf(buf, sizeof(buf), "null");
+    } else {
+        double test = 0.0;
+        len = snprintf(buf, sizeof(buf), "%1.15g", value);
+        if (sscanf(buf, "%lg", &test) != 1 || test != value) {
+            len = snprintf(buf, sizeof(buf), "%1.17g", value);
+        }
+    }
+    if (len < 0 || len >= (int)sizeof(buf)) {
+        p->failed = true;
+        return;
+    }
+    print_write(p, buf, len);
+}
+
+static void print_string(json_printer_t *p, const char *str)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    print_char(p, '"');
+    if (str) {
+        for (const unsigned char *c = (const unsigned char *)str; *c; c++) {
+            switch (*c) {
+            case '"':  print_write(p, "\\\"", 2); break;
+            case '\\': print_write(p, "\\\\", 2); break;
+            case '\b': print_write(p, "\\b", 2); break;
+            case '\f': print_write(p, "\\f", 2); break;
+            case '\n': print_write(p, "\\n", 2); break;
+            case '\r': print_write(p, "\\r", 2); break;
+            case '\t': print_write(p, "\\t", 2); break;
+            default:
+                if (*c < 0x20) {
+                    char esc[6] = {'\\', 'u', '0', '0', hex[*c >> 4], hex[*c & 0xF]};
+                    print_write(p, esc, 6);
+                } else {
+                    print_char(p, (char)*c);
+                }
+                break;
+            }
+        }
+    }
+    print_char(p, '"');
+}
+
+static void print_value(json_printer_t *p, const cJSON *item, bool formatted, int depth)
+{
+    if (p->failed) {
+        return;
+    }
+    if (depth > CJSON_NESTING_LIMIT) {
+        p->failed = true;
+        return;
+    }
+
+    switch (item->type & 0xFF) {
+    case cJSON_NULL:
+        print_write(p, "null", 4);
+        break;
+    case cJSON_False:
+        print_write(p, "false", 5);
+        break;
+    case cJSON_True:
+        print_write(p, "true", 4);
+        break;
+    case cJSON_Number:
+        print_number(p, item->valuedouble);
+        break;
+    case cJSON_String:
+        print_string(p, item->valuestring);
+        break;
+    case cJSON_Raw:
+        if (!item->valuestring) {
+            p->failed = true;
+            break;
+        }
+        print_write(p, item->valuestring, strlen(item->valuestring));
+        break;
+    case cJSON_Array:
+    case cJSON_Object: {
+        bool is_object = (item->type & 0xFF) == cJSON_Object;
+        print_char(p, is_object ? '{' : '[');
+        for (const cJSON *child = item->child; child && !p->failed; child = child->next) {
+            if (formatted) {
+                print_indent(p, depth + 1);
+            }
+            if (is_object) {
+                print_string(p, child->string);
+                print_char(p, ':');
+                if (formatted) {
+                    print_char(p, ' ');
+                }
+            }
+            print_value(p, child, formatted, depth + 1);
+            if (child->next) {
+                print_char(p, ',');
+            }
+        }
+        if (formatted && item->child) {
+            print_indent(p, depth);
+        }
+        print_char(p, is_object ? '}' : ']');
+        break;
+    }
+    default:
+        p->failed = true;
+        break;
+    }
+}
+
+char *esp_json_print_sized(const cJSON *item, bool formatted, size_t *len_out)
+{
+    if (!item) {
+        return NULL;
+    }
+
+    size_t size = 0;
+    json_printer_t printer = { .count = &size };
+    print_value(&printer, item, formatted, 0);
+    if (printer.failed) {
+        return NULL;
+    }
+
+    char *out = (char *)cJSON_malloc(size + 1);
+    if (!out) {
+        return NULL;
+    }
+
+    memset(&printer, 0, sizeof(printer));
+    printer.mem = out;
+    print_value(&printer, item, formatted, 0);
+    if (printer.failed || printer.mem_used != size) {
+        cJSON_free(out);
+        return NULL;
+    }
+    out[size] = '\0';
+    if (len_out) {
+        *len_out = size;
+    }
+    return out;
+}
+
+esp_err_t esp_json_print_stream(const cJSON *item, bool formatted, esp_json_write_cb_t write_cb, void *ctx)
+{
+    if (!item || !write_cb) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    json_printer_t printer = { .cb = write_cb, .ctx = ctx };
+    print_value(&printer, item, formatted, 0);
+    print_flush(&printer);
+    return printer.failed ? ESP_FAIL : ESP_OK;
+}
@@ -0,0 +1,483 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <stdlib.h>
+#include "esp_json_stream.h"
+
+/* Longest number literal accepted; copied out for strtod since the input
+ * buffer is not NUL terminated */
+#define JSON_NUMBER_BUF 32
+
+typedef struct {
+    const char *cur;
+    const char *end;
+    // callback mode
+    esp_json_event_cb_t cb;
+    void *user_data;
+    bool stopped;
+    // arena mode
+    uint8_t *arena;
+    size_t arena_size;
+    size_t arena_used;
+} json_parser_t;
+
+static esp_err_t parse_value(json_parser_t *p, int depth, const char *key, size_t key_len, esp_json_node_t **out);
+
+static void skip_ws(json_parser_t *p)
+{
+    while (p->cur < p->end && (*p->cur == ' ' || *p->cur == '\t' || *p->cur == '\n' || *p->cur == '\r')) {
+        p->cur++;
+    }
+}
+
+static void emit(json_parser_t *p, esp_json_event_t *event)
+{
+    if (p->cb && !p->stopped && !p->cb(event, p->user_data)) {
+        p->stopped = true;
+    }
+}
+
+static esp_json_node_t *node_alloc(json_parser_t *p)
+{
+    if (!p->arena) {
+        return NULL;
+    }
+    size_t used = (p->arena_used + sizeof(double) - 1) & ~(sizeof(double) - 1);
+    if (used + sizeof(esp_json_node_t) > p->arena_size) {
+        return NULL;
+    }
+    p->arena_used = used + sizeof(esp_json_node_t);
+    esp_json_node_t *node = (esp_json_node_t *)(p->arena + used);
+    memset(node, 0, sizeof(esp_json_node_t));
+    return node;
+}
+
+/**
+ * Scan a string literal starting at the opening quote; on success the
+ * cursor is just past the closing quote and the span between the quotes
+ * (escapes untouched) is stored.
+ */
+static esp_err_t scan_string(json_parser_t *p, const char **span, size_t *span_len)
+{
+    if (p->cur >= p->end || *p->cur != '"') {
+        return ESP_FAIL;
+    }
+    p->cur++;
+    *span = p->cur;
+    while (p->cur < p->end) {
+        char c = *p->cur;
+        if (c == '"') {
+            *span_len = p->cur - *span;
+            p->cur++;
+            return ESP_OK;
+        }
+        if (c == '\\') {
+            p->cur++;
+            if (p->cur >= p->end) {
+                break;
+            }
+        }
+        p->cur++;
+    }
+    return ESP_FAIL;    // unterminated string
+}
+
+static esp_err_t parse_number(json_parser_t *p, double *number)
+{
+    char buf[JSON_NUMBER_BUF];
+    size_t len = 0;
+    while (p->cur < p->end && len < JSON_NUMBER_BUF - 1) {
+        char c = *p->cur;
+        if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E') {
+            buf[len++] = c;
+            p->cur++;
+        } else {
+            break;
+        }
+    }
+    if (len == 0 || len == JSON_NUMBER_BUF - 1) {
+        return ESP_FAIL;
+    }
+    buf[len] = '\0';
+    char *parse_end = NULL;
+    *number = strtod(buf, &parse_end);
+    return (parse_end == buf + len) ? ESP_OK : ESP_FAIL;
+}
+
+static esp_err_t parse_literal(json_parser_t *p, const char *literal)
+{
+    size_t len = strlen(literal);
+    if ((size_t)(p->end - p->cur) < len || strncmp(p->cur, literal, len) != 0) {
+        return ESP_FAIL;
+    }
+    p->cur += len;
+    return ESP_OK;
+}
+
+/**
+ * Parse the members/elements of a container. The opening bracket has been
+ * consumed; consumes everything up to and including the closing one.
+ */
+static esp_err_t parse_container(json_parser_t *p, int depth, bool is_object, esp_json_node_t *node)
+{
+    char close = is_object ? '}' : ']';
+    esp_json_node_t **link = node ? &node->container.first_child : NULL;
+    bool first = true;
+
+    while (true) {
+        skip_ws(p);
+        if (p->cur >= p->end) {
+            return ESP_FAIL;
+        }
+        if (*p->cur == close) {
+            p->cur++;
+            return ESP_OK;
+        }
+        if (!first) {
+            if (*p->cur != ',') {
+                return ESP_FAIL;
+            }
+            p->cur++;
+            skip_ws(p);
+        }
+        first = false;
+
+        const char *key = NULL;
+        size_t key_len = 0;
+        if (is_object) {
+            esp_err_t err = scan_string(p, &key, &key_len);
+            if (err != ESP_OK) {
+                return err;
+            }
+            skip_ws(p);
+            if (p->cur >= p->end || *p->cur != ':') {
+                return ESP_FAIL;
+            }
+            p->cur++;
+        }
+
+        esp_json_node_t *child = NULL;
+        esp_err_t err = parse_value(p, depth + 1, key, key_len, node ? &child : NULL);
+        if (err != ESP_OK) {
+            return err;
+        }
+        if (p->stopped) {
+            return ESP_OK;
+        }
+        if (link) {
+            *link = child;
+            link = &child->next;
+            node->container.child_count++;
+        }
+    }
+}
+
+static esp_err_t parse_value(json_parser_t *p, int depth, const char *key, size_t key_len, esp_json_node_t **out)
+{
+    if (depth >= ESP_JSON_MAX_DEPTH) {
+        return ESP_FAIL;
+    }
+    skip_ws(p);
+    if (p->cur >= p->end) {
+        return ESP_FAIL;
+    }
+
+    esp_json_event_t event = {
+        .key = key,
+        .key_len = key_len,
+        .depth = depth,
+    };
+    esp_json_node_t *node = NULL;
+    if (out) {
+        node = node_alloc(p);
+        if (!node) {
+            return ESP_ERR_NO_MEM;
+        }
+        node->key = key;
+        node->key_len = key_len;
+        *out = node;
+    }
+
+    char c = *p->cur;
+    esp_err_t err;
+    switch (c) {
+    case '{':
+    case '[': {
+        bool is_object = (c == '{');
+        p->cur++;
+        event.type = is_object ? ESP_JSON_EVENT_OBJECT_BEGIN : ESP_JSON_EVENT_ARRAY_BEGIN;
+        if (node) {
+            node->type = event.type;
+        }
+        emit(p, &event);
+        if (p->stopped) {
+            return ESP_OK;
+        }
+        err = parse_container(p, depth, is_object, node);
+        if (err != ESP_OK || p->stopped) {
+            return err;
+        }
+        event.type = is_object ? ESP_JSON_EVENT_OBJECT_END : ESP_JSON_EVENT_ARRAY_END;
+        emit(p, &event);
+        return ESP_OK;
+    }
+    case '"':
+        event.type = ESP_JSON_EVENT_STRING;
+        err = scan_string(p, &event.value, &event.value_len);
+        if (err != ESP_OK) {
+            return err;
+        }
+        if (node) {
+            node->type = ESP_JSON_EVENT_STRING;
+            node->string.ptr = event.value;
+            node->string.len = event.value_len;
+        }
+        emit(p, &event);
+        return ESP_OK;
+    case 't':
+    case 'f':
+        event.type = ESP_JSON_EVENT_BOOL;
+        event.boolean = (c == 't');
+        err = parse_literal(p, event.boolean ? "true" : "false");
+        if (err != ESP_OK) {
+            return err;
+        }
+        if (node) {
+            node->type = ESP_JSON_EVENT_BOOL;
+            node->boolean = event.boolean;
+        }
+        emit(p, &event);
+        return ESP_OK;
+    case 'n':
+        event.type = ESP_JSON_EVENT_NULL;
+        err = parse_literal(p, "null");
+        if (err != ESP_OK) {
+            return err;
+        }
+        if (node) {
+            node->type = ESP_JSON_EVENT_NULL;
+        }
+        emit(p, &event);
+        return ESP_OK;
+    default:
+        event.type = ESP_JSON_EVENT_NUMBER;
+        err = parse_number(p, &event.number);
+        if (err != ESP_OK) {
+            return err;
+        }
+        if (node) {
+            node->type = ESP_JSON_EVENT_NUMBER;
+            node->number = event.number;
+        }
+        emit(p, &event);
+        return ESP_OK;
+    }
+}
+
+static esp_err_t parse_document(json_parser_t *p, esp_json_node_t **root)
+{
+    esp_err_t err = parse_value(p, 0, NULL, 0, root);
+    if (err != ESP_OK) {
+        return err;
+    }
+    if (p->stopped) {
+        return ESP_OK;
+    }
+    skip_ws(p);
+    return (p->cur == p->end) ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t esp_json_parse_events(const char *buf, size_t len, esp_json_event_cb_t cb, void *user_data)
+{
+    if (!buf || !cb) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    json_parser_t parser = {
+        .cur = buf,
+        .end = buf + len,
+        .cb = cb,
+        .user_data = user_data,
+    };
+    return parse_document(&parser, NULL);
+}
+
+esp_err_t esp_json_parse_arena(const char *buf, size_t len, void *arena, size_t arena_size, esp_json_node_t **root)
+{
+    if (!buf || !arena || !root) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *root = NULL;
+    json_parser_t parser = {
+        .cur = buf,
+        .end = buf + len,
+        .arena = (uint8_t *)arena,
+        .arena_size = arena_size,
+    };
+    return parse_document(&parser, root);
+}
+
+esp_json_node_t *esp_json_object_get(const esp_json_node_t *object, const char *key)
+{
+    if (!object || !key || object->type != ESP_JSON_EVENT_OBJECT_BEGIN) {
+        return NULL;
+    }
+    size_t key_len = strlen(key);
+    esp_json_node_t *child = object->container.first_child;
+    while (child) {
+        if (child->key_len == key_len && memcmp(child->key, key, key_len) == 0) {
+            return child;
+        }
+        child = child->next;
+    }
+    return NULL;
+}
+
+esp_json_node_t *esp_json_array_get(const esp_json_node_t *array, size_t index)
+{
+    if (!array || array->type != ESP_JSON_EVENT_ARRAY_BEGIN) {
+        return NULL;
+    }
+    esp_json_node_t *child = array->container.first_child;
+    while (child && index--) {
+        child = child->next;
+    }
+    return child;
+}
+
+static int hex_nibble(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+/* Read the four hex digits of a \u escape; -1 on malformed input */
+static int read_u16_escape(const char *src, size_t remaining)
+{
+    if (remaining < 4) {
+        return -1;
+    }
+    int code = 0;
+    for (int i = 0; i < 4; i++) {
+        int nibble = hex_nibble(src[i]);
+        if (nibble < 0) {
+            return -1;
+        }
+        code = (code << 4) | nibble;
+    }
+    return code;
+}
+
+static size_t utf8_encode(char *dst, size_t dst_left, uint32_t code)
+{
+    if (code < 0x80) {
+        if (dst_left < 1) {
+            return 0;
+        }
+        dst[0] = (char)code;
+        return 1;
+    }
+    if (code < 0x800) {
+        if (dst_left < 2) {
+            return 0;
+        }
+        dst[0] = (char)(0xC0 | (code >> 6));
+        dst[1] = (char)(0x80 | (code & 0x3F));
+        return 2;
+    }
+    if (code < 0x10000) {
+        if (dst_left < 3) {
+            return 0;
+        }
+        dst[0] = (char)(0xE0 | (code >> 12));
+        dst[1] = (char)(0x80 | ((code >> 6) & 0x3F));
+        dst[2] = (char)(0x80 | (code & 0x3F));
+        return 3;
+    }
+    if (dst_left < 4) {
+        return 0;
+    }
+    dst[0] = (char)(0xF0 | (code >> 18));
+    dst[1] = (char)(0x80 | ((code >> 12) & 0x3F));
+    dst[2] = (char)(0x80 | ((code >> 6) & 0x3F));
+    dst[3] = (char)(0x80 | (code & 0x3F));
+    return 4;
+}
+
+size_t esp_json_token_unescape(char *dst, size_t dst_size, const char *src, size_t src_len)
+{
+    size_t out = 0;
+    size_t i = 0;
+    if (!dst || dst_size == 0) {
+        return 0;
+    }
+    while (i < src_len && out < dst_size - 1) {
+        char c = src[i];
+        if (c != '\\') {
+            dst[out++] = c;
+            i++;
+            continue;
+        }
+        i++;
+        if (i >= src_len) {
+            break;
+        }
+        char esc = src[i++];
+        switch (esc) {
+        case 'b': dst[out++] = '\b'; break;
+        case 'f': dst[out++] = '\f'; break;
+        case 'n': dst[out++] = '\n'; break;
+        case 'r': dst[out++] = '\r'; break;
+        case 't': dst[out++] = '\t'; break;
+        case 'u': {
+            int code = read_u16_escape(src + i, src_len - i);
+            if (code < 0) {
+                dst[out++] = esc;   // leave malformed escapes as-is
+                break;
+            }
+            i += 4;
+            uint32_t codepoint = (uint32_t)code;
+            // combine surrogate pairs
+            if (code >= 0xD800 && code <= 0xDBFF && src_len - i >= 6
+                    && src[i] == '\\' && src[i + 1] == 'u') {
+                int low = read_u16_escape(src + i + 2, src_len - i - 2);
+                if (low >= 0xDC00 && low <= 0xDFFF) {
+                    codepoint = 0x10000 + (((uint32_t)code - 0xD800) << 10) + ((uint32_t)low - 0xDC00);
+                    i += 6;
+                }
+            }
+            size_t encoded = utf8_encode(dst + out, dst_size - 1 - out, codepoint);
+            if (encoded == 0) {
+                goto done;  // would not fit, truncate here
+            }
+            out += encoded;
+            break;
+        }
+        default:
+            dst[out++] = esc;   // covers '"', '\\' and '/'
+            break;
+        }
+    }
+done:
+    dst[out] = '\0';
+    return out;
+}
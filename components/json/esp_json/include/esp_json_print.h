@@ -0,0 +1,84 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "cJSON.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Allocation-friendly printing of cJSON trees
+ *
+ * cJSON_Print() grows its output by repeated realloc, which copies the
+ * whole buffer several times for large payloads. These variants serialize
+ * the same trees either with an exact sizing pass followed by a single
+ * allocation, or straight into a write callback through a small fixed
+ * staging buffer with no output allocation at all.
+ */
+
+/**
+ * @brief Output callback for esp_json_print_stream()
+ *
+ * @param data chunk of serialized output
+ * @param len chunk length in bytes
+ * @param ctx user argument given to esp_json_print_stream()
+ *
+ * @return 0 to continue, any other value to abort the print
+ */
+typedef int (*esp_json_write_cb_t)(const char *data, size_t len, void *ctx);
+
+/**
+ * @brief Serialize a cJSON tree with one exactly-sized allocation
+ *
+ * Walks the tree twice: once to compute the output size, once to fill the
+ * buffer. The result is allocated with the cJSON allocator and must be
+ * released with cJSON_free(), like the output of cJSON_Print().
+ *
+ * @param item tree to serialize
+ * @param formatted true for pretty-printed output, false for compact
+ * @param[out] len_out serialized length, not counting the terminating NUL;
+ *                     may be NULL
+ *
+ * @return NUL-terminated output, or NULL on invalid input or no memory
+ */
+char *esp_json_print_sized(const cJSON *item, bool formatted, size_t *len_out);
+
+/**
+ * @brief Serialize a cJSON tree directly into a write callback
+ *
+ * Output is staged in a small stack buffer and handed to the callback in
+ * chunks, so no intermediate copy of the document ever exists - suitable
+ * for writing straight to a socket or ring buffer.
+ *
+ * @param item tree to serialize
+ * @param formatted true for pretty-printed output, false for compact
+ * @param write_cb receives the serialized chunks
+ * @param ctx user argument passed to the callback
+ *
+ * @return
+ *  - ESP_OK on success
+ *  - ESP_ERR_INVALID_ARG on NULL item or callback
+ *  - ESP_FAIL when the callback aborted or the tree contains an invalid item
+ */
+esp_err_t esp_json_print_stream(const cJSON *item, bool formatted, esp_json_write_cb_t write_cb, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,183 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Streaming (SAX-style) JSON parser
+ *
+ * Unlike cJSON, which allocates one heap node per value, this parser walks
+ * the document once and either reports values through a callback (no
+ * allocation at all) or builds a read-only tree inside a caller-provided
+ * arena (one bump allocation per value, freed all at once). String and key
+ * values are reported as spans into the input buffer, with escape sequences
+ * left in place; use esp_json_token_unescape() when the decoded text is
+ * needed.
+ */
+
+/**
+ * @brief Maximum nesting depth accepted by the parser
+ */
+#define ESP_JSON_MAX_DEPTH 32
+
+/**
+ * @brief Parse event types, in document order
+ */
+typedef enum {
+    ESP_JSON_EVENT_OBJECT_BEGIN,    /*!< '{' */
+    ESP_JSON_EVENT_OBJECT_END,      /*!< '}' */
+    ESP_JSON_EVENT_ARRAY_BEGIN,     /*!< '[' */
+    ESP_JSON_EVENT_ARRAY_END,       /*!< ']' */
+    ESP_JSON_EVENT_STRING,          /*!< string value */
+    ESP_JSON_EVENT_NUMBER,          /*!< number value */
+    ESP_JSON_EVENT_BOOL,            /*!< true or false */
+    ESP_JSON_EVENT_NULL,            /*!< null */
+} esp_json_event_type_t;
+
+/**
+ * @brief One parse event
+ */
+typedef struct {
+    esp_json_event_type_t type; /*!< event type */
+    const char *key;            /*!< member key span when inside an object, NULL otherwise */
+    size_t key_len;             /*!< length of the key span */
+    const char *value;          /*!< string value span (ESP_JSON_EVENT_STRING only) */
+    size_t value_len;           /*!< length of the value span */
+    double number;              /*!< numeric value (ESP_JSON_EVENT_NUMBER only) */
+    bool boolean;               /*!< boolean value (ESP_JSON_EVENT_BOOL only) */
+    int depth;                  /*!< nesting depth, 0 for the root value */
+} esp_json_event_t;
+
+/**
+ * @brief Parse event callback
+ *
+ * @param event the event; spans point into the input buffer
+ * @param user_data user argument given to esp_json_parse_events()
+ *
+ * @return true to continue parsing, false to stop early
+ */
+typedef bool (*esp_json_event_cb_t)(const esp_json_event_t *event, void *user_data);
+
+/**
+ * @brief Node of an arena-allocated JSON tree
+ */
+typedef struct esp_json_node {
+    esp_json_event_type_t type;     /*!< value type (the *_BEGIN constants denote containers) */
+    const char *key;                /*!< member key span, NULL outside objects */
+    size_t key_len;                 /*!< length of the key span */
+    union {
+        struct {
+            struct esp_json_node *first_child;  /*!< first element, NULL when empty */
+            size_t child_count;                 /*!< number of elements */
+        } container;                /*!< object and array values */
+        struct {
+            const char *ptr;        /*!< string span in the input buffer */
+            size_t len;             /*!< length of the span */
+        } string;                   /*!< string values */
+        double number;              /*!< number values */
+        bool boolean;               /*!< boolean values */
+    };
+    struct esp_json_node *next;     /*!< next sibling, NULL for the last one */
+} esp_json_node_t;
+
+/**
+ * @brief Parse a complete JSON document, reporting values through a callback
+ *
+ * Performs no allocation; the input buffer must stay valid while the spans
+ * handed to the callback are in use.
+ *
+ * @param buf document text, not required to be NUL terminated
+ * @param len document length in bytes
+ * @param cb event callback
+ * @param user_data argument passed through to the callback
+ *
+ * @return
+ *  - ESP_OK on success or when the callback stopped the parse
+ *  - ESP_ERR_INVALID_ARG on NULL buf/cb
+ *  - ESP_FAIL on malformed JSON or nesting deeper than ESP_JSON_MAX_DEPTH
+ */
+esp_err_t esp_json_parse_events(const char *buf, size_t len, esp_json_event_cb_t cb, void *user_data);
+
+/**
+ * @brief Parse a complete JSON document into a tree inside a caller arena
+ *
+ * Nodes are bump-allocated from the arena and reference the input buffer
+ * for all text, so the whole parse costs zero heap allocations and the
+ * tree is released by simply reusing the arena. Both the arena and the
+ * input buffer must outlive the returned tree.
+ *
+ * @param buf document text, not required to be NUL terminated
+ * @param len document length in bytes
+ * @param arena working memory for the nodes
+ * @param arena_size arena size in bytes; budget sizeof(esp_json_node_t) per value
+ * @param[out] root the root node
+ *
+ * @return
+ *  - ESP_OK on success
+ *  - ESP_ERR_INVALID_ARG on NULL buf/arena/root
+ *  - ESP_ERR_NO_MEM when the arena is too small for the document
+ *  - ESP_FAIL on malformed JSON or nesting deeper than ESP_JSON_MAX_DEPTH
+ */
+esp_err_t esp_json_parse_arena(const char *buf, size_t len, void *arena, size_t arena_size, esp_json_node_t **root);
+
+/**
+ * @brief Find a member of an object node by key
+ *
+ * The key is compared against the raw span, so keys containing escape
+ * sequences do not match.
+ *
+ * @param object an object node
+ * @param key NUL-terminated member key
+ *
+ * @return the member node, or NULL if absent or the node is not an object
+ */
+esp_json_node_t *esp_json_object_get(const esp_json_node_t *object, const char *key);
+
+/**
+ * @brief Get an element of an array node by index
+ *
+ * @param array an array node
+ * @param index element index
+ *
+ * @return the element node, or NULL if out of range or the node is not an array
+ */
+esp_json_node_t *esp_json_array_get(const esp_json_node_t *array, size_t index);
+
+/**
+ * @brief Decode the escape sequences of a string span into a buffer
+ *
+ * The result is NUL terminated and truncated to fit. Unicode escapes are
+ * decoded to UTF-8.
+ *
+ * @param dst output buffer
+ * @param dst_size output buffer size, must be at least 1
+ * @param src string span as reported in an event or node
+ * @param src_len length of the span
+ *
+ * @return number of bytes written, not counting the terminating NUL
+ */
+size_t esp_json_token_unescape(char *dst, size_t dst_size, const char *src, size_t src_len);
+
+#ifdef __cplusplus
+}
+#endif
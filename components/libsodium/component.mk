@@ -31,8 +31,6 @@ COMPONENT_SRCDIRS += \
 	$(LSRC)/crypto_kdf \
 	$(LSRC)/crypto_kx \
 	$(LSRC)/crypto_onetimeauth \
-	$(LSRC)/crypto_onetimeauth/poly1305 \
-	$(LSRC)/crypto_onetimeauth/poly1305/donna \
 	$(LSRC)/crypto_pwhash/argon2 \
 	$(LSRC)/crypto_pwhash \
 	$(LSRC)/crypto_pwhash/scryptsalsa208sha256 \
@@ -48,8 +46,6 @@ COMPONENT_SRCDIRS += \
 	$(LSRC)/crypto_sign \
 	$(LSRC)/crypto_sign/ed25519 \
 	$(LSRC)/crypto_sign/ed25519/ref10 \
-	$(LSRC)/crypto_stream/chacha20 \
-	$(LSRC)/crypto_stream/chacha20/ref \
 	$(LSRC)/crypto_stream \
 	$(LSRC)/crypto_stream/salsa20 \
     $(LSRC)/crypto_stream/salsa20/ref \
@@ -66,6 +62,18 @@ COMPONENT_SRCDIRS += \
     $(LSRC)/crypto_hash/sha512/cp
 endif
 
+ifdef CONFIG_LIBSODIUM_USE_XTENSA_CHACHA20POLY1305
+COMPONENT_SRCDIRS += \
+	port/crypto_stream_chacha20_xtensa \
+	port/crypto_onetimeauth_poly1305_xtensa
+else
+COMPONENT_SRCDIRS += \
+	$(LSRC)/crypto_stream/chacha20 \
+	$(LSRC)/crypto_stream/chacha20/ref \
+	$(LSRC)/crypto_onetimeauth/poly1305 \
+	$(LSRC)/crypto_onetimeauth/poly1305/donna
+endif
+
 # Fix some warnings in current libsodium source files
 # (not applied to whole component as we compile some of our own files, also.)
 $(LSRC)/crypto_pwhash/argon2/argon2-fill-block-ref.o: CFLAGS += -Wno-unknown-pragmas
@@ -0,0 +1,311 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/* Poly1305 one-time authenticator tuned for Xtensa (ESP32 family).
+
+   Replaces libsodium's onetimeauth_poly1305.c + poly1305_donna.c, dropping
+   the implementation vtable (only used to pick SSE2 on x86). The field
+   arithmetic follows poly1305-donna-32 (2^130-5 as 5x26-bit limbs), which is
+   the layout the Xtensa 32x32->64 MUL sequence (MULL/MULUH) handles best:
+   the block loop below is fully unrolled so the h and r limbs stay in
+   registers and each block costs 25 long multiplies.
+*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "crypto_onetimeauth_poly1305.h"
+#include "crypto_verify_16.h"
+#include "utils.h"
+
+typedef struct poly1305_state_internal {
+    uint32_t r[5];
+    uint32_t h[5];
+    uint32_t pad[4];
+    unsigned long long leftover;
+    unsigned char buffer[16];
+    unsigned char final;
+} poly1305_state_internal_t;
+
+_Static_assert(sizeof(poly1305_state_internal_t) <= sizeof(crypto_onetimeauth_poly1305_state),
+               "opaque poly1305 state too small");
+
+static inline uint32_t
+load32_le(const unsigned char *p)
+{
+    uint32_t w;
+    memcpy(&w, p, sizeof(w)); /* NATIVE_LITTLE_ENDIAN */
+    return w;
+}
+
+static inline void
+store32_le(unsigned char *p, uint32_t w)
+{
+    memcpy(p, &w, sizeof(w));
+}
+
+static void
+poly1305_init_internal(poly1305_state_internal_t *st, const unsigned char key[32])
+{
+    /* r &= 0xffffffc0ffffffc0ffffffc0fffffff, split into 26-bit limbs */
+    st->r[0] = (load32_le(&key[0])) & 0x3ffffff;
+    st->r[1] = (load32_le(&key[3]) >> 2) & 0x3ffff03;
+    st->r[2] = (load32_le(&key[6]) >> 4) & 0x3ffc0ff;
+    st->r[3] = (load32_le(&key[9]) >> 6) & 0x3f03fff;
+    st->r[4] = (load32_le(&key[12]) >> 8) & 0x00fffff;
+
+    st->h[0] = 0;
+    st->h[1] = 0;
+    st->h[2] = 0;
+    st->h[3] = 0;
+    st->h[4] = 0;
+
+    st->pad[0] = load32_le(&key[16]);
+    st->pad[1] = load32_le(&key[20]);
+    st->pad[2] = load32_le(&key[24]);
+    st->pad[3] = load32_le(&key[28]);
+
+    st->leftover = 0;
+    st->final = 0;
+}
+
+static void
+poly1305_blocks(poly1305_state_internal_t *st, const unsigned char *m,
+                unsigned long long bytes)
+{
+    const uint32_t hibit = st->final ? 0 : (1UL << 24); /* 1 << 128 */
+    uint32_t r0 = st->r[0], r1 = st->r[1], r2 = st->r[2], r3 = st->r[3], r4 = st->r[4];
+    const uint32_t s1 = r1 * 5, s2 = r2 * 5, s3 = r3 * 5, s4 = r4 * 5;
+    uint32_t h0 = st->h[0], h1 = st->h[1], h2 = st->h[2], h3 = st->h[3], h4 = st->h[4];
+
+    while (bytes >= 16) {
+        uint64_t d0, d1, d2, d3, d4;
+        uint32_t c;
+
+        /* h += m[i] */
+        h0 += (load32_le(m + 0)) & 0x3ffffff;
+        h1 += (load32_le(m + 3) >> 2) & 0x3ffffff;
+        h2 += (load32_le(m + 6) >> 4) & 0x3ffffff;
+        h3 += (load32_le(m + 9) >> 6) & 0x3ffffff;
+        h4 += (load32_le(m + 12) >> 8) | hibit;
+
+        /* h *= r (mod 2^130-5) */
+        d0 = ((uint64_t)h0 * r0) + ((uint64_t)h1 * s4) + ((uint64_t)h2 * s3) +
+             ((uint64_t)h3 * s2) + ((uint64_t)h4 * s1);
+        d1 = ((uint64_t)h0 * r1) + ((uint64_t)h1 * r0) + ((uint64_t)h2 * s4) +
+             ((uint64_t)h3 * s3) + ((uint64_t)h4 * s2);
+        d2 = ((uint64_t)h0 * r2) + ((uint64_t)h1 * r1) + ((uint64_t)h2 * r0) +
+             ((uint64_t)h3 * s4) + ((uint64_t)h4 * s3);
+        d3 = ((uint64_t)h0 * r3) + ((uint64_t)h1 * r2) + ((uint64_t)h2 * r1) +
+             ((uint64_t)h3 * r0) + ((uint64_t)h4 * s4);
+        d4 = ((uint64_t)h0 * r4) + ((uint64_t)h1 * r3) + ((uint64_t)h2 * r2) +
+             ((uint64_t)h3 * r1) + ((uint64_t)h4 * r0);
+
+        /* partial reduction mod 2^130-5 */
+        c = (uint32_t)(d0 >> 26); h0 = (uint32_t)d0 & 0x3ffffff;
+        d1 += c; c = (uint32_t)(d1 >> 26); h1 = (uint32_t)d1 & 0x3ffffff;
+        d2 += c; c = (uint32_t)(d2 >> 26); h2 = (uint32_t)d2 & 0x3ffffff;
+        d3 += c; c = (uint32_t)(d3 >> 26); h3 = (uint32_t)d3 & 0x3ffffff;
+        d4 += c; c = (uint32_t)(d4 >> 26); h4 = (uint32_t)d4 & 0x3ffffff;
+        h0 += c * 5; c = h0 >> 26; h0 &= 0x3ffffff;
+        h1 += c;
+
+        m += 16;
+        bytes -= 16;
+    }
+
+    st->h[0] = h0;
+    st->h[1] = h1;
+    st->h[2] = h2;
+    st->h[3] = h3;
+    st->h[4] = h4;
+}
+
+static void
+poly1305_finish(poly1305_state_internal_t *st, unsigned char mac[16])
+{
+    uint32_t h0, h1, h2, h3, h4, c;
+    uint32_t g0, g1, g2, g3, g4;
+    uint64_t f;
+    uint32_t mask;
+
+    if (st->leftover) {
+        unsigned long long i = st->leftover;
+        st->buffer[i++] = 1;
+        for (; i < 16; i++) {
+            st->buffer[i] = 0;
+        }
+        st->final = 1;
+        poly1305_blocks(st, st->buffer, 16);
+    }
+
+    /* full carry h */
+    h0 = st->h[0]; h1 = st->h[1]; h2 = st->h[2]; h3 = st->h[3]; h4 = st->h[4];
+    c = h1 >> 26; h1 &= 0x3ffffff;
+    h2 += c; c = h2 >> 26; h2 &= 0x3ffffff;
+    h3 += c; c = h3 >> 26; h3 &= 0x3ffffff;
+    h4 += c; c = h4 >> 26; h4 &= 0x3ffffff;
+    h0 += c * 5; c = h0 >> 26; h0 &= 0x3ffffff;
+    h1 += c;
+
+    /* compute h + -p */
+    g0 = h0 + 5; c = g0 >> 26; g0 &= 0x3ffffff;
+    g1 = h1 + c; c = g1 >> 26; g1 &= 0x3ffffff;
+    g2 = h2 + c; c = g2 >> 26; g2 &= 0x3ffffff;
+    g3 = h3 + c; c = g3 >> 26; g3 &= 0x3ffffff;
+    g4 = h4 + c - (1UL << 26);
+
+    /* select h if h < p, or h + -p if h >= p */
+    mask = (g4 >> 31) - 1;
+    g0 &= mask; g1 &= mask; g2 &= mask; g3 &= mask; g4 &= mask;
+    mask = ~mask;
+    h0 = (h0 & mask) | g0;
+    h1 = (h1 & mask) | g1;
+    h2 = (h2 & mask) | g2;
+    h3 = (h3 & mask) | g3;
+    h4 = (h4 & mask) | g4;
+
+    /* h = h % (2^128) */
+    h0 = (h0 | (h1 << 26)) & 0xffffffff;
+    h1 = ((h1 >> 6) | (h2 << 20)) & 0xffffffff;
+    h2 = ((h2 >> 12) | (h3 << 14)) & 0xffffffff;
+    h3 = ((h3 >> 18) | (h4 << 8)) & 0xffffffff;
+
+    /* mac = (h + pad) % (2^128) */
+    f = (uint64_t)h0 + st->pad[0]; h0 = (uint32_t)f;
+    f = (uint64_t)h1 + st->pad[1] + (f >> 32); h1 = (uint32_t)f;
+    f = (uint64_t)h2 + st->pad[2] + (f >> 32); h2 = (uint32_t)f;
+    f = (uint64_t)h3 + st->pad[3] + (f >> 32); h3 = (uint32_t)f;
+
+    store32_le(mac + 0, h0);
+    store32_le(mac + 4, h1);
+    store32_le(mac + 8, h2);
+    store32_le(mac + 12, h3);
+
+    sodium_memzero((void *)st, sizeof(*st));
+}
+
+static void
+poly1305_update_internal(poly1305_state_internal_t *st, const unsigned char *m,
+                         unsigned long long bytes)
+{
+    unsigned long long i;
+
+    /* handle leftover */
+    if (st->leftover) {
+        unsigned long long want = 16 - st->leftover;
+        if (want > bytes) {
+            want = bytes;
+        }
+        for (i = 0; i < want; i++) {
+            st->buffer[st->leftover + i] = m[i];
+        }
+        bytes -= want;
+        m += want;
+        st->leftover += want;
+        if (st->leftover < 16) {
+            return;
+        }
+        poly1305_blocks(st, st->buffer, 16);
+        st->leftover = 0;
+    }
+
+    /* process full blocks */
+    if (bytes >= 16) {
+        unsigned long long want = bytes & ~(unsigned long long)15;
+        poly1305_blocks(st, m, want);
+        m += want;
+        bytes -= want;
+    }
+
+    /* store leftover */
+    for (i = 0; i < bytes; i++) {
+        st->buffer[st->leftover + i] = m[i];
+    }
+    st->leftover += bytes;
+}
+
+int
+crypto_onetimeauth_poly1305(unsigned char *out, const unsigned char *in,
+                            unsigned long long inlen, const unsigned char *k)
+{
+    poly1305_state_internal_t state;
+
+    poly1305_init_internal(&state, k);
+    poly1305_update_internal(&state, in, inlen);
+    poly1305_finish(&state, out);
+    return 0;
+}
+
+int
+crypto_onetimeauth_poly1305_verify(const unsigned char *h,
+                                   const unsigned char *in,
+                                   unsigned long long inlen,
+                                   const unsigned char *k)
+{
+    unsigned char correct[16];
+
+    crypto_onetimeauth_poly1305(correct, in, inlen, k);
+    return crypto_verify_16(h, correct);
+}
+
+int
+crypto_onetimeauth_poly1305_init(crypto_onetimeauth_poly1305_state *state,
+                                 const unsigned char *key)
+{
+    poly1305_init_internal((poly1305_state_internal_t *)(void *)state, key);
+    return 0;
+}
+
+int
+crypto_onetimeauth_poly1305_update(crypto_onetimeauth_poly1305_state *state,
+                                   const unsigned char *in,
+                                   unsigned long long inlen)
+{
+    poly1305_update_internal((poly1305_state_internal_t *)(void *)state, in, inlen);
+    return 0;
+}
+
+int
+crypto_onetimeauth_poly1305_final(crypto_onetimeauth_poly1305_state *state,
+                                  unsigned char *out)
+{
+    poly1305_finish((poly1305_state_internal_t *)(void *)state, out);
+    return 0;
+}
+
+size_t
+crypto_onetimeauth_poly1305_bytes(void)
+{
+    return crypto_onetimeauth_poly1305_BYTES;
+}
+
+size_t
+crypto_onetimeauth_poly1305_keybytes(void)
+{
+    return crypto_onetimeauth_poly1305_KEYBYTES;
+}
+
+size_t
+crypto_onetimeauth_poly1305_statebytes(void)
+{
+    return sizeof(crypto_onetimeauth_poly1305_state);
+}
+
+/* Called from sodium_init(); there is only one implementation here */
+int
+_crypto_onetimeauth_poly1305_pick_best_implementation(void)
+{
+    return 0;
+}
@@ -1,6 +1,9 @@
+#include <string.h>
 #include "unity.h"
 #include "sodium/crypto_hash_sha256.h"
 #include "sodium/crypto_hash_sha512.h"
+#include "sodium/crypto_aead_chacha20poly1305.h"
+#include "hal/cpu_hal.h"
 
 /* Note: a lot of these libsodium test programs assert() things, but they're not complete unit tests - most expect
    output to be compared to the matching .exp file.
@@ -119,3 +122,44 @@ TEST_CASE("sha512 sanity check", "[libsodium]")
     crypto_hash_sha512_final(&state, calculated);
     TEST_ASSERT_EQUAL_MEMORY(expected, calculated, crypto_hash_sha512_bytes());
 }
+
+/* Typical encrypted ESP-NOW frame size; the numbers with and without
+   LIBSODIUM_USE_XTENSA_CHACHA20POLY1305 can be compared directly. */
+TEST_CASE("crypto_aead_chacha20poly1305 cycle count", "[libsodium]")
+{
+    const size_t MLEN = 250;
+    const int ITERATIONS = 64;
+    unsigned char key[crypto_aead_chacha20poly1305_KEYBYTES];
+    unsigned char nonce[crypto_aead_chacha20poly1305_NPUBBYTES];
+    unsigned char m[250];
+    unsigned char c[250 + crypto_aead_chacha20poly1305_ABYTES];
+    unsigned char m2[250];
+    unsigned long long clen, m2len;
+    uint32_t start, encrypt_cycles, decrypt_cycles;
+
+    memset(key, 0x42, sizeof(key));
+    memset(nonce, 0x24, sizeof(nonce));
+    for (size_t i = 0; i < MLEN; i++) {
+        m[i] = (unsigned char) i;
+    }
+
+    start = cpu_hal_get_cycle_count();
+    for (int i = 0; i < ITERATIONS; i++) {
+        crypto_aead_chacha20poly1305_encrypt(c, &clen, m, MLEN, NULL, 0, NULL, nonce, key);
+    }
+    encrypt_cycles = (cpu_hal_get_cycle_count() - start) / ITERATIONS;
+
+    start = cpu_hal_get_cycle_count();
+    for (int i = 0; i < ITERATIONS; i++) {
+        TEST_ASSERT_EQUAL(0, crypto_aead_chacha20poly1305_decrypt(m2, &m2len, NULL, c, clen,
+                                                                  NULL, 0, nonce, key));
+    }
+    decrypt_cycles = (cpu_hal_get_cycle_count() - start) / ITERATIONS;
+
+    TEST_ASSERT_EQUAL(MLEN, m2len);
+    TEST_ASSERT_EQUAL_MEMORY(m, m2, MLEN);
+
+    printf("chacha20poly1305 %u byte frame: encrypt %u cycles (%.1f/byte), decrypt %u cycles (%.1f/byte)\n",
+           (unsigned) MLEN, encrypt_cycles, (float) encrypt_cycles / MLEN,
+           decrypt_cycles, (float) decrypt_cycles / MLEN);
+}
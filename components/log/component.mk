@@ -8,7 +8,7 @@
 ifndef IS_BOOTLOADER_BUILD
 COMPONENT_OBJEXCLUDE := log_noos.o
 else
-COMPONENT_OBJEXCLUDE := log_freertos.o
+COMPONENT_OBJEXCLUDE := log_freertos.o log_async.o
 endif
 
 COMPONENT_ADD_LDFRAGMENTS += linker.lf
@@ -1,6 +1,21 @@
 #pragma once
 #include <stdbool.h>
+#include <stdarg.h>
+#include "sdkconfig.h"
+#include "esp_log.h"
 
 void esp_log_impl_lock(void);
 bool esp_log_impl_lock_timeout(void);
 void esp_log_impl_unlock(void);
+
+// Format and emit through the currently configured vprintf-like function
+void esp_log_impl_print(const char *format, ...) __attribute__ ((format (printf, 1, 2)));
+
+#ifdef CONFIG_LOG_ASYNC
+// True when called from an ISR while async logging is active
+bool esp_log_async_in_isr(void);
+// Capture the message into the async ring; false means the caller should
+// fall back to synchronous output
+bool esp_log_async_write(esp_log_level_t level, const char *tag,
+                         const char *format, va_list args);
+#endif
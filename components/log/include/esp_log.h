@@ -137,6 +137,33 @@ void esp_log_write(esp_log_level_t level, const char* tag, const char* format, .
  */
 void esp_log_writev(esp_log_level_t level, const char* tag, const char* format, va_list args);
 
+#ifdef CONFIG_LOG_ASYNC
+#include "esp_err.h"
+
+/**
+ * @brief Start asynchronous logging
+ *
+ * Creates the background drain task. From this point on, log messages are
+ * captured in binary form (format string pointer plus raw arguments) into a
+ * ring buffer and formatted by the drain task, so logging no longer blocks
+ * the calling task on console output and becomes usable from ISRs and
+ * critical sections. Messages which cannot be captured (runtime '*' width,
+ * %n, or oversized records) keep using the synchronous path.
+ *
+ * @return ESP_OK on success, ESP_ERR_INVALID_STATE if already started,
+ *         ESP_ERR_NO_MEM if the task or semaphore cannot be allocated
+ */
+esp_err_t esp_log_async_init(void);
+
+/**
+ * @brief Format and emit all captured messages from the calling context
+ *
+ * Useful before entering deep sleep, restarting, or in fatal error paths
+ * where the drain task will not run anymore.
+ */
+void esp_log_async_flush(void);
+#endif // CONFIG_LOG_ASYNC
+
 /** @cond */
 
 #include "esp_log_internal.h"
@@ -325,23 +352,28 @@ void esp_log_writev(esp_log_level_t level, const char* tag, const char* format,
  * @param format format of the output log. see ``printf``
  * @param ... variables to be replaced into the log. see ``printf``
  *
+ * @note Each branch is additionally guarded with a LOG_LOCAL_LEVEL comparison
+ * of compile-time constants, so that calls with a runtime ``level`` cannot
+ * keep format strings of compiled-out levels in flash: the compiler folds the
+ * comparison and drops the dead branches together with their string literals.
+ *
  * @see ``printf``
  */
 #if CONFIG_LOG_TIMESTAMP_SOURCE_RTOS
 #define ESP_LOG_LEVEL(level, tag, format, ...) do {                     \
-        if (level==ESP_LOG_ERROR )          { esp_log_write(ESP_LOG_ERROR,      tag, LOG_FORMAT(E, format), esp_log_timestamp(), tag, ##__VA_ARGS__); } \
-        else if (level==ESP_LOG_WARN )      { esp_log_write(ESP_LOG_WARN,       tag, LOG_FORMAT(W, format), esp_log_timestamp(), tag, ##__VA_ARGS__); } \
-        else if (level==ESP_LOG_DEBUG )     { esp_log_write(ESP_LOG_DEBUG,      tag, LOG_FORMAT(D, format), esp_log_timestamp(), tag, ##__VA_ARGS__); } \
-        else if (level==ESP_LOG_VERBOSE )   { esp_log_write(ESP_LOG_VERBOSE,    tag, LOG_FORMAT(V, format), esp_log_timestamp(), tag, ##__VA_ARGS__); } \
-        else                                { esp_log_write(ESP_LOG_INFO,       tag, LOG_FORMAT(I, format), esp_log_timestamp(), tag, ##__VA_ARGS__); } \
+        if (LOG_LOCAL_LEVEL >= ESP_LOG_ERROR && level==ESP_LOG_ERROR )          { esp_log_write(ESP_LOG_ERROR,      tag, LOG_FORMAT(E, format), esp_log_timestamp(), tag, ##__VA_ARGS__); } \
+        else if (LOG_LOCAL_LEVEL >= ESP_LOG_WARN && level==ESP_LOG_WARN )       { esp_log_write(ESP_LOG_WARN,       tag, LOG_FORMAT(W, format), esp_log_timestamp(), tag, ##__VA_ARGS__); } \
+        else if (LOG_LOCAL_LEVEL >= ESP_LOG_DEBUG && level==ESP_LOG_DEBUG )     { esp_log_write(ESP_LOG_DEBUG,      tag, LOG_FORMAT(D, format), esp_log_timestamp(), tag, ##__VA_ARGS__); } \
+        else if (LOG_LOCAL_LEVEL >= ESP_LOG_VERBOSE && level==ESP_LOG_VERBOSE ) { esp_log_write(ESP_LOG_VERBOSE,    tag, LOG_FORMAT(V, format), esp_log_timestamp(), tag, ##__VA_ARGS__); } \
+        else if (LOG_LOCAL_LEVEL >= ESP_LOG_INFO )                              { esp_log_write(ESP_LOG_INFO,       tag, LOG_FORMAT(I, format), esp_log_timestamp(), tag, ##__VA_ARGS__); } \
     } while(0)
 #elif CONFIG_LOG_TIMESTAMP_SOURCE_SYSTEM
 #define ESP_LOG_LEVEL(level, tag, format, ...) do {                     \
-        if (level==ESP_LOG_ERROR )          { esp_log_write(ESP_LOG_ERROR,      tag, LOG_SYSTEM_TIME_FORMAT(E, format), esp_log_system_timestamp(), tag, ##__VA_ARGS__); } \
-        else if (level==ESP_LOG_WARN )      { esp_log_write(ESP_LOG_WARN,       tag, LOG_SYSTEM_TIME_FORMAT(W, format), esp_log_system_timestamp(), tag, ##__VA_ARGS__); } \
-        else if (level==ESP_LOG_DEBUG )     { esp_log_write(ESP_LOG_DEBUG,      tag, LOG_SYSTEM_TIME_FORMAT(D, format), esp_log_system_timestamp(), tag, ##__VA_ARGS__); } \
-        else if (level==ESP_LOG_VERBOSE )   { esp_log_write(ESP_LOG_VERBOSE,    tag, LOG_SYSTEM_TIME_FORMAT(V, format), esp_log_system_timestamp(), tag, ##__VA_ARGS__); } \
-        else                                { esp_log_write(ESP_LOG_INFO,       tag, LOG_SYSTEM_TIME_FORMAT(I, format), esp_log_system_timestamp(), tag, ##__VA_ARGS__); } \
+        if (LOG_LOCAL_LEVEL >= ESP_LOG_ERROR && level==ESP_LOG_ERROR )          { esp_log_write(ESP_LOG_ERROR,      tag, LOG_SYSTEM_TIME_FORMAT(E, format), esp_log_system_timestamp(), tag, ##__VA_ARGS__); } \
+        else if (LOG_LOCAL_LEVEL >= ESP_LOG_WARN && level==ESP_LOG_WARN )       { esp_log_write(ESP_LOG_WARN,       tag, LOG_SYSTEM_TIME_FORMAT(W, format), esp_log_system_timestamp(), tag, ##__VA_ARGS__); } \
+        else if (LOG_LOCAL_LEVEL >= ESP_LOG_DEBUG && level==ESP_LOG_DEBUG )     { esp_log_write(ESP_LOG_DEBUG,      tag, LOG_SYSTEM_TIME_FORMAT(D, format), esp_log_system_timestamp(), tag, ##__VA_ARGS__); } \
+        else if (LOG_LOCAL_LEVEL >= ESP_LOG_VERBOSE && level==ESP_LOG_VERBOSE ) { esp_log_write(ESP_LOG_VERBOSE,    tag, LOG_SYSTEM_TIME_FORMAT(V, format), esp_log_system_timestamp(), tag, ##__VA_ARGS__); } \
+        else if (LOG_LOCAL_LEVEL >= ESP_LOG_INFO )                              { esp_log_write(ESP_LOG_INFO,       tag, LOG_SYSTEM_TIME_FORMAT(I, format), esp_log_system_timestamp(), tag, ##__VA_ARGS__); } \
     } while(0)
 #endif //CONFIG_LOG_TIMESTAMP_SOURCE_xxx
 
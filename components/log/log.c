@@ -167,29 +167,52 @@ void esp_log_writev(esp_log_level_t level,
                    const char *format,
                    va_list args)
 {
-    if (!esp_log_impl_lock_timeout()) {
-        return;
-    }
     esp_log_level_t level_for_tag;
-    // Look for the tag in cache first, then in the linked list of all tags
-    if (!get_cached_log_level(tag, &level_for_tag)) {
-        if (!get_uncached_log_level(tag, &level_for_tag)) {
-            level_for_tag = s_log_default_level;
+#if defined(CONFIG_LOG_ASYNC) && !defined(BOOTLOADER_BUILD)
+    if (esp_log_async_in_isr()) {
+        // The tag cache mutex cannot be taken from an ISR; async records
+        // from interrupt context are filtered with the default level only.
+        level_for_tag = s_log_default_level;
+    } else
+#endif
+    {
+        if (!esp_log_impl_lock_timeout()) {
+            return;
         }
-        add_to_cache(tag, level_for_tag);
+        // Look for the tag in cache first, then in the linked list of all tags
+        if (!get_cached_log_level(tag, &level_for_tag)) {
+            if (!get_uncached_log_level(tag, &level_for_tag)) {
+                level_for_tag = s_log_default_level;
+            }
+            add_to_cache(tag, level_for_tag);
 #ifdef LOG_BUILTIN_CHECKS
-        ++s_log_cache_misses;
+            ++s_log_cache_misses;
 #endif
+        }
+        esp_log_impl_unlock();
     }
-    esp_log_impl_unlock();
     if (!should_output(level, level_for_tag)) {
         return;
     }
 
+#if defined(CONFIG_LOG_ASYNC) && !defined(BOOTLOADER_BUILD)
+    if (esp_log_async_write(level, tag, format, args)) {
+        return;
+    }
+#endif
+
     (*s_log_print_func)(format, args);
 
 }
 
+void esp_log_impl_print(const char *format, ...)
+{
+    va_list list;
+    va_start(list, format);
+    (*s_log_print_func)(format, list);
+    va_end(list);
+}
+
 void esp_log_write(esp_log_level_t level,
                    const char *tag,
                    const char *format, ...)
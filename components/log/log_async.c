@@ -0,0 +1,398 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * Asynchronous binary logging.
+ *
+ * Instead of formatting with vprintf and pushing the result through the
+ * console synchronously, the call site parses the format string once,
+ * copies the raw argument words (and the bytes of any %s argument, since
+ * those often point at stack buffers) into a ring buffer, and returns.
+ * A low priority drain task pops the records, re-formats them outside of
+ * any caller context and hands the text to the configured vprintf-like
+ * output function. The format string itself is stored by pointer: log
+ * format strings are literals in flash.
+ *
+ * The ring is protected by a spinlock, so records can be produced from
+ * ISRs and critical sections. Records which do not fit (ring full, record
+ * over LOG_ASYNC_MAX_RECORD bytes) and formats using unsupported
+ * conversions ('*' width/precision, %n) are not captured: in task context
+ * the caller falls back to the synchronous path, in ISR context the
+ * message is dropped and counted.
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include <sys/param.h>
+#include "sdkconfig.h"
+
+#ifdef CONFIG_LOG_ASYNC
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_log_private.h"
+
+// Upper bound for one captured record (header + arg words + string copies)
+#define LOG_ASYNC_MAX_RECORD    256
+// A %s argument longer than this is truncated in the captured copy
+#define LOG_ASYNC_MAX_STRING    120
+// Formatted output line buffer in the drain task
+#define LOG_ASYNC_MAX_LINE      512
+
+#define LOG_ASYNC_TASK_STACK    3072
+#define LOG_ASYNC_TASK_PRIO     1
+
+// Limited by LOG_ASYNC_MAX_RECORD: (256 - header) / 4
+#define LOG_ASYNC_MAX_WORDS     62
+
+typedef struct {
+    uint16_t size;          // total record size in bytes, multiple of 4
+    uint8_t nwords;         // number of argument words following the header
+    uint8_t reserved;
+    const char *format;     // format string literal (in flash)
+} log_async_record_t;
+
+// Argument word holding the offset of a copied %s argument, relative to
+// the start of the string area (after the argument words)
+#define STR_OFFS_NULL   0xffffffff
+
+static uint8_t s_ring[CONFIG_LOG_ASYNC_BUFFER_SIZE];
+static size_t s_ring_head;  // write position
+static size_t s_ring_tail;  // read position
+static size_t s_ring_fill;  // bytes currently stored
+static portMUX_TYPE s_ring_lock = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t s_dropped;
+
+static bool s_active;
+static SemaphoreHandle_t s_drain_sem;
+
+static bool capture_args(const char *format, va_list args,
+                         uint32_t *words, uint8_t *nwords,
+                         uint8_t *strs, size_t *strs_len)
+{
+    uint8_t nw = 0;
+    size_t sl = 0;
+    for (const char *p = format; *p != '\0'; ++p) {
+        if (*p != '%') {
+            continue;
+        }
+        ++p;
+        // flags, width and precision: digits and flag characters only,
+        // runtime '*' width/precision is not supported
+        while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0' ||
+               (*p >= '1' && *p <= '9')) {
+            ++p;
+        }
+        if (*p == '.') {
+            ++p;
+            while (*p >= '0' && *p <= '9') {
+                ++p;
+            }
+        }
+        int longs = 0;
+        while (*p == 'l') {
+            ++longs;
+            ++p;
+        }
+        if (*p == 'h') {
+            ++p;
+            if (*p == 'h') {
+                ++p;
+            }
+        } else if (*p == 'z' || *p == 't') {
+            ++p;
+        }
+        switch (*p) {
+        case '%':
+            break;
+        case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c':
+            if (longs >= 2) {
+                long long v = va_arg(args, long long);
+                memcpy(&words[nw], &v, sizeof(v));
+                nw += 2;
+            } else {
+                // char, short, int and long all promote to one 32-bit word
+                words[nw++] = va_arg(args, uint32_t);
+            }
+            break;
+        case 'p':
+            words[nw++] = (uint32_t) va_arg(args, void *);
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': {
+            double v = va_arg(args, double);
+            memcpy(&words[nw], &v, sizeof(v));
+            nw += 2;
+            break;
+        }
+        case 's': {
+            const char *str = va_arg(args, const char *);
+            if (str == NULL) {
+                words[nw++] = STR_OFFS_NULL;
+                break;
+            }
+            size_t len = strnlen(str, LOG_ASYNC_MAX_STRING);
+            if (sl + len + 1 > LOG_ASYNC_MAX_RECORD) {
+                return false;
+            }
+            words[nw++] = sl;
+            memcpy(&strs[sl], str, len);
+            strs[sl + len] = '\0';
+            sl += len + 1;
+            break;
+        }
+        default:
+            // %n and anything else we cannot replay
+            return false;
+        }
+        if (nw > LOG_ASYNC_MAX_WORDS - 2) {
+            return false;
+        }
+    }
+    *nwords = nw;
+    *strs_len = sl;
+    return true;
+}
+
+static void format_record(const log_async_record_t *rec, char *out, size_t out_size)
+{
+    const uint32_t *words = (const uint32_t *)(rec + 1);
+    const char *strs = (const char *)(words + rec->nwords);
+    size_t nw = 0;
+    size_t pos = 0;
+    const char *p = rec->format;
+    while (*p != '\0' && pos + 1 < out_size) {
+        if (*p != '%') {
+            out[pos++] = *p++;
+            continue;
+        }
+        // copy the conversion specification verbatim into a small buffer
+        char spec[16];
+        size_t spec_len = 0;
+        spec[spec_len++] = *p++;
+        while (*p != '\0' && spec_len < sizeof(spec) - 1 &&
+               strchr("diuxXocpfFeEgGs%", *p) == NULL) {
+            spec[spec_len++] = *p++;
+        }
+        char conv = *p;
+        int longs = 0;
+        for (size_t i = 1; i < spec_len; i++) {
+            if (spec[i] == 'l') {
+                ++longs;
+            }
+        }
+        if (conv != '\0') {
+            spec[spec_len++] = *p++;
+        }
+        spec[spec_len] = '\0';
+        int written = 0;
+        switch (conv) {
+        case '%':
+            out[pos++] = '%';
+            continue;
+        case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c':
+            if (longs >= 2) {
+                long long v;
+                memcpy(&v, &words[nw], sizeof(v));
+                nw += 2;
+                written = snprintf(&out[pos], out_size - pos, spec, v);
+            } else {
+                written = snprintf(&out[pos], out_size - pos, spec, words[nw++]);
+            }
+            break;
+        case 'p':
+            written = snprintf(&out[pos], out_size - pos, spec, (void *) words[nw++]);
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': {
+            double v;
+            memcpy(&v, &words[nw], sizeof(v));
+            nw += 2;
+            written = snprintf(&out[pos], out_size - pos, spec, v);
+            break;
+        }
+        case 's': {
+            uint32_t offs = words[nw++];
+            const char *str = (offs == STR_OFFS_NULL) ? "(null)" : &strs[offs];
+            written = snprintf(&out[pos], out_size - pos, spec, str);
+            break;
+        }
+        default:
+            // truncated record or format changed under us; stop here
+            out[pos] = '\0';
+            return;
+        }
+        if (written < 0) {
+            break;
+        }
+        pos += MIN((size_t) written, out_size - pos - 1);
+    }
+    out[pos] = '\0';
+}
+
+// Copy one complete record into the ring, or count a drop
+static bool ring_put(const uint8_t *rec, size_t size)
+{
+    bool ok = false;
+    portENTER_CRITICAL_SAFE(&s_ring_lock);
+    if (s_ring_fill + size <= sizeof(s_ring)) {
+        size_t first = MIN(size, sizeof(s_ring) - s_ring_head);
+        memcpy(&s_ring[s_ring_head], rec, first);
+        memcpy(&s_ring[0], rec + first, size - first);
+        s_ring_head = (s_ring_head + size) % sizeof(s_ring);
+        s_ring_fill += size;
+        ok = true;
+    } else {
+        ++s_dropped;
+    }
+    portEXIT_CRITICAL_SAFE(&s_ring_lock);
+    return ok;
+}
+
+// Pop one record into rec (at least LOG_ASYNC_MAX_RECORD bytes)
+static bool ring_get(uint8_t *rec)
+{
+    bool ok = false;
+    portENTER_CRITICAL(&s_ring_lock);
+    if (s_ring_fill >= sizeof(log_async_record_t)) {
+        size_t first = MIN(sizeof(log_async_record_t), sizeof(s_ring) - s_ring_tail);
+        memcpy(rec, &s_ring[s_ring_tail], first);
+        memcpy(rec + first, &s_ring[0], sizeof(log_async_record_t) - first);
+        size_t size = ((log_async_record_t *) rec)->size;
+        first = MIN(size, sizeof(s_ring) - s_ring_tail);
+        memcpy(rec, &s_ring[s_ring_tail], first);
+        memcpy(rec + first, &s_ring[0], size - first);
+        s_ring_tail = (s_ring_tail + size) % sizeof(s_ring);
+        s_ring_fill -= size;
+        ok = true;
+    }
+    portEXIT_CRITICAL(&s_ring_lock);
+    return ok;
+}
+
+static void drain_one(const uint8_t *rec_buf, char *line)
+{
+    const log_async_record_t *rec = (const log_async_record_t *) rec_buf;
+    format_record(rec, line, LOG_ASYNC_MAX_LINE);
+    esp_log_impl_print("%s", line);
+}
+
+static void log_async_drain_task(void *arg)
+{
+    static uint8_t rec_buf[LOG_ASYNC_MAX_RECORD];
+    static char line[LOG_ASYNC_MAX_LINE];
+    uint32_t reported_drops = 0;
+    while (true) {
+        xSemaphoreTake(s_drain_sem, portMAX_DELAY);
+        while (ring_get(rec_buf)) {
+            drain_one(rec_buf, line);
+        }
+        uint32_t dropped = s_dropped;
+        if (dropped != reported_drops) {
+            esp_log_impl_print("W async_log: %u messages dropped\n",
+                               dropped - reported_drops);
+            reported_drops = dropped;
+        }
+    }
+}
+
+bool esp_log_async_in_isr(void)
+{
+    return s_active && xPortInIsrContext();
+}
+
+bool esp_log_async_write(esp_log_level_t level, const char *tag,
+                         const char *format, va_list args)
+{
+    (void) level;
+    (void) tag;
+    if (!s_active) {
+        return false;
+    }
+    struct {
+        log_async_record_t hdr;
+        uint32_t words[LOG_ASYNC_MAX_WORDS];
+    } rec;
+    uint8_t strs[LOG_ASYNC_MAX_RECORD + 1];
+    uint8_t nwords = 0;
+    size_t strs_len = 0;
+    bool in_isr = xPortInIsrContext();
+    if (!capture_args(format, args, rec.words, &nwords, strs, &strs_len)) {
+        // cannot replay this format; drop in ISR, else let the caller
+        // format synchronously
+        if (in_isr) {
+            ++s_dropped;
+            return true;
+        }
+        return false;
+    }
+    size_t size = sizeof(log_async_record_t) + nwords * 4 + ((strs_len + 3) & ~(size_t)3);
+    if (size > LOG_ASYNC_MAX_RECORD) {
+        if (in_isr) {
+            ++s_dropped;
+            return true;
+        }
+        return false;
+    }
+    rec.hdr.size = size;
+    rec.hdr.nwords = nwords;
+    rec.hdr.reserved = 0;
+    rec.hdr.format = format;
+    memcpy(&rec.words[nwords], strs, strs_len);
+    if (!ring_put((const uint8_t *) &rec, size) && !in_isr) {
+        // ring full: drop was already counted, but avoid also losing the
+        // message if the caller can output synchronously
+        return false;
+    }
+    if (in_isr) {
+        BaseType_t higher_prio_woken = pdFALSE;
+        xSemaphoreGiveFromISR(s_drain_sem, &higher_prio_woken);
+        if (higher_prio_woken == pdTRUE) {
+            portYIELD_FROM_ISR();
+        }
+    } else {
+        xSemaphoreGive(s_drain_sem);
+    }
+    return true;
+}
+
+esp_err_t esp_log_async_init(void)
+{
+    if (s_active) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    s_drain_sem = xSemaphoreCreateBinary();
+    if (s_drain_sem == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    if (xTaskCreate(log_async_drain_task, "log_drain", LOG_ASYNC_TASK_STACK,
+                    NULL, LOG_ASYNC_TASK_PRIO, NULL) != pdPASS) {
+        vSemaphoreDelete(s_drain_sem);
+        s_drain_sem = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    s_active = true;
+    return ESP_OK;
+}
+
+void esp_log_async_flush(void)
+{
+    static uint8_t rec_buf[LOG_ASYNC_MAX_RECORD];
+    static char line[LOG_ASYNC_MAX_LINE];
+    while (ring_get(rec_buf)) {
+        drain_one(rec_buf, line);
+    }
+}
+
+#endif // CONFIG_LOG_ASYNC
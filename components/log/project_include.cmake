@@ -0,0 +1,22 @@
+# idf_component_set_log_level
+#
+# Set the compile-time maximum log level for one component. Log statements
+# above the given level are removed by the compiler, including their format
+# strings in flash. This overrides CONFIG_LOG_DEFAULT_LEVEL for the named
+# component only (equivalent to defining LOG_LOCAL_LEVEL in each of its
+# source files).
+#
+# Call from the project CMakeLists.txt after the components are processed,
+# e.g. idf_component_set_log_level(wpa_supplicant WARN).
+#
+# Legacy GNU Make projects can achieve the same by adding
+# 'CPPFLAGS += -DLOG_LOCAL_LEVEL=ESP_LOG_WARN' to the component makefile.
+function(idf_component_set_log_level component level)
+    set(levels NONE ERROR WARN INFO DEBUG VERBOSE)
+    list(FIND levels "${level}" level_num)
+    if(level_num EQUAL -1)
+        message(FATAL_ERROR "idf_component_set_log_level: level must be one of ${levels}")
+    endif()
+    idf_component_get_property(lib ${component} COMPONENT_LIB)
+    target_compile_definitions(${lib} PRIVATE "LOG_LOCAL_LEVEL=${level_num}")
+endfunction()
@@ -44,6 +44,38 @@ ifdef CONFIG_LWIP_TCP_ISN_HOOK
     COMPONENT_SRCDIRS += port/esp32/tcp_isn
 endif
 
+ifndef CONFIG_LWIP_TCP_ZERO_COPY_SEND
+    COMPONENT_OBJEXCLUDE += port/esp32/tcp_zero_copy.o
+endif
+
+ifndef CONFIG_LWIP_PER_SOCKET_TCP_WND
+    COMPONENT_OBJEXCLUDE += port/esp32/tcp_tune.o
+endif
+
+ifndef CONFIG_LWIP_TCP_SNAPSHOT
+    COMPONENT_OBJEXCLUDE += port/esp32/tcp_snapshot.o
+endif
+
+ifndef CONFIG_LWIP_PER_SOCKET_TCP_STATS
+    COMPONENT_OBJEXCLUDE += port/esp32/tcp_stats.o
+endif
+
+ifndef CONFIG_LWIP_DNS_EXTENDED_CACHE
+    COMPONENT_OBJEXCLUDE += port/esp32/dns_cache.o
+endif
+
+ifndef CONFIG_LWIP_UDP_FASTPATH
+    COMPONENT_OBJEXCLUDE += port/esp32/netif/udp_fastpath.o
+endif
+
+ifndef CONFIG_LWIP_POOL_PROFILES
+    COMPONENT_OBJEXCLUDE += port/esp32/pool_profiles.o
+endif
+
+ifndef CONFIG_LWIP_CHKSUM_OPTIMIZED
+    COMPONENT_OBJEXCLUDE += port/esp32/chksum.o
+endif
+
 CFLAGS += -Wno-address  # lots of LWIP source files evaluate macros that check address of stack variables
 
 lwip/src/netif/ppp/ppp.o: CFLAGS += -Wno-uninitialized
@@ -0,0 +1,347 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include "lwip/opt.h"
+#include "lwip/dns.h"
+#include "lwip/sys.h"
+#include "lwip/tcpip.h"
+#include "lwip/timeouts.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_dns_cache.h"
+#include "sdkconfig.h"
+
+#ifdef CONFIG_LWIP_DNS_EXTENDED_CACHE
+
+/* Enlarged DNS cache with background refresh.
+
+   lwIP's own DNS table holds DNS_TABLE_SIZE (4) entries and every
+   netconn/sockets lookup that misses it blocks the calling task for a
+   full query round trip — 50-500 ms that land right on the reconnect
+   path. This cache sits in front of the resolver through
+   LWIP_HOOK_NETCONN_EXTERNAL_RESOLVE (wired up in lwipopts.h): hits,
+   including cached negative results, return without touching the
+   network, misses resolve through dns_gethostbyname() in the TCP/IP
+   thread and populate the cache on the way out. Pinned hostnames are
+   re-resolved shortly before their entry expires so a reconnect after
+   long idle still hits.
+
+   The resolver's found callback does not carry the record TTL out of
+   the lwIP core, so entry lifetime is configured
+   (CONFIG_LWIP_DNS_EXTENDED_CACHE_TTL) rather than taken from the
+   response; size it below the shortest TTL your endpoints serve. */
+
+#define DNS_CACHE_HOSTNAME_LEN          64
+#define DNS_CACHE_CHECK_INTERVAL_MS     10000
+#define DNS_CACHE_TTL_MS                (CONFIG_LWIP_DNS_EXTENDED_CACHE_TTL * 1000U)
+#define DNS_CACHE_NEG_TTL_MS            (CONFIG_LWIP_DNS_EXTENDED_CACHE_NEG_TTL * 1000U)
+
+typedef struct {
+    bool in_use;                /* slot allocated */
+    bool pinned;                /* background-refreshed, never evicted */
+    bool has_result;
+    bool negative;              /* name is known not to resolve */
+    char hostname[DNS_CACHE_HOSTNAME_LEN];
+    ip_addr_t addr;
+    u32_t stored_at;            /* sys_now() when the result arrived */
+} dns_cache_entry_t;
+
+static dns_cache_entry_t s_dns_cache[CONFIG_LWIP_DNS_EXTENDED_CACHE_SIZE];
+static portMUX_TYPE s_dns_cache_mux = portMUX_INITIALIZER_UNLOCKED;
+static bool s_refresh_timer_armed;      /* only touched in the TCP/IP thread */
+
+/* call with s_dns_cache_mux held */
+static dns_cache_entry_t *dns_cache_find(const char *name)
+{
+    for (int i = 0; i < CONFIG_LWIP_DNS_EXTENDED_CACHE_SIZE; i++) {
+        if (s_dns_cache[i].in_use && strcmp(s_dns_cache[i].hostname, name) == 0) {
+            return &s_dns_cache[i];
+        }
+    }
+    return NULL;
+}
+
+/* call with s_dns_cache_mux held */
+static dns_cache_entry_t *dns_cache_alloc(const char *name)
+{
+    dns_cache_entry_t *victim = NULL;
+    for (int i = 0; i < CONFIG_LWIP_DNS_EXTENDED_CACHE_SIZE; i++) {
+        dns_cache_entry_t *e = &s_dns_cache[i];
+        if (!e->in_use) {
+            victim = e;
+            break;
+        }
+        if (e->pinned) {
+            continue;
+        }
+        if (victim == NULL || (u32_t)(e->stored_at - victim->stored_at) > 0x7fffffff) {
+            victim = e;     /* oldest unpinned entry */
+        }
+    }
+    if (victim == NULL) {
+        return NULL;
+    }
+    memset(victim, 0, sizeof(*victim));
+    strlcpy(victim->hostname, name, sizeof(victim->hostname));
+    victim->in_use = true;
+    return victim;
+}
+
+static u32_t dns_cache_entry_ttl(const dns_cache_entry_t *e)
+{
+    return e->negative ? DNS_CACHE_NEG_TTL_MS : DNS_CACHE_TTL_MS;
+}
+
+static bool dns_cache_entry_fresh(const dns_cache_entry_t *e)
+{
+    return e->has_result && (u32_t)(sys_now() - e->stored_at) < dns_cache_entry_ttl(e);
+}
+
+/* dns_found_callback: store a resolver result (NULL addr = negative) */
+static void dns_cache_store_cb(const char *name, const ip_addr_t *ipaddr, void *arg)
+{
+    LWIP_UNUSED_ARG(arg);
+    if (name == NULL || strlen(name) >= DNS_CACHE_HOSTNAME_LEN) {
+        return;
+    }
+    portENTER_CRITICAL(&s_dns_cache_mux);
+    dns_cache_entry_t *e = dns_cache_find(name);
+    if (e == NULL) {
+        e = dns_cache_alloc(name);
+    }
+    if (e != NULL) {
+        e->has_result = true;
+        e->negative = (ipaddr == NULL);
+        if (ipaddr != NULL) {
+            ip_addr_copy(e->addr, *ipaddr);
+        }
+        e->stored_at = sys_now();
+    }
+    portEXIT_CRITICAL(&s_dns_cache_mux);
+}
+
+static bool dns_cache_type_match(const ip_addr_t *addr, u8_t addrtype)
+{
+#if LWIP_IPV4 && LWIP_IPV6
+    if (addrtype == LWIP_DNS_ADDRTYPE_IPV4 && IP_IS_V6(addr)) {
+        return false;
+    }
+    if (addrtype == LWIP_DNS_ADDRTYPE_IPV6 && !IP_IS_V6(addr)) {
+        return false;
+    }
+#else
+    LWIP_UNUSED_ARG(addr);
+    LWIP_UNUSED_ARG(addrtype);
+#endif
+    return true;
+}
+
+/* Runs in the TCP/IP thread: re-resolve pinned names whose entry would
+   expire before the next pass, so a cache hit is always available */
+static void dns_cache_refresh_timer(void *arg)
+{
+    LWIP_UNUSED_ARG(arg);
+    for (int i = 0; i < CONFIG_LWIP_DNS_EXTENDED_CACHE_SIZE; i++) {
+        char name[DNS_CACHE_HOSTNAME_LEN];
+        bool refresh = false;
+
+        portENTER_CRITICAL(&s_dns_cache_mux);
+        dns_cache_entry_t *e = &s_dns_cache[i];
+        if (e->in_use && e->pinned) {
+            u32_t age = sys_now() - e->stored_at;
+            if (!e->has_result || age + 2 * DNS_CACHE_CHECK_INTERVAL_MS > dns_cache_entry_ttl(e)) {
+                strlcpy(name, e->hostname, sizeof(name));
+                refresh = true;
+            }
+        }
+        portEXIT_CRITICAL(&s_dns_cache_mux);
+
+        if (refresh) {
+            ip_addr_t addr;
+            err_t err = dns_gethostbyname(name, &addr, dns_cache_store_cb, NULL);
+            if (err == ERR_OK) {
+                /* answered from lwIP's own table, no callback coming */
+                dns_cache_store_cb(name, &addr, NULL);
+            }
+        }
+    }
+    sys_timeout(DNS_CACHE_CHECK_INTERVAL_MS, dns_cache_refresh_timer, NULL);
+}
+
+/* tcpip_callback target: arm the refresh timer and run a first pass */
+static void dns_cache_kick(void *arg)
+{
+    LWIP_UNUSED_ARG(arg);
+    if (!s_refresh_timer_armed) {
+        s_refresh_timer_armed = true;
+    } else {
+        sys_untimeout(dns_cache_refresh_timer, NULL);
+    }
+    dns_cache_refresh_timer(NULL);
+}
+
+/* Blocking resolution through the TCP/IP thread, used on cache misses
+   from the netconn resolve hook */
+typedef struct {
+    const char *name;
+    u8_t addrtype;
+    ip_addr_t addr;
+    err_t err;
+    sys_sem_t sem;
+} dns_cache_query_t;
+
+static void dns_cache_query_cb(const char *name, const ip_addr_t *ipaddr, void *arg)
+{
+    dns_cache_query_t *q = (dns_cache_query_t *)arg;
+    dns_cache_store_cb(name, ipaddr, NULL);
+    if (ipaddr != NULL) {
+        ip_addr_copy(q->addr, *ipaddr);
+        q->err = ERR_OK;
+    } else {
+        q->err = ERR_VAL;
+    }
+    sys_sem_signal(&q->sem);
+}
+
+static void dns_cache_do_query(void *ctx)
+{
+    dns_cache_query_t *q = (dns_cache_query_t *)ctx;
+    err_t err = dns_gethostbyname_addrtype(q->name, &q->addr, dns_cache_query_cb, q, q->addrtype);
+    if (err == ERR_INPROGRESS) {
+        return;     /* dns_cache_query_cb() signals when the answer is in */
+    }
+    if (err == ERR_OK) {
+        dns_cache_store_cb(q->name, &q->addr, NULL);
+    }
+    q->err = err;
+    sys_sem_signal(&q->sem);
+}
+
+int lwip_hook_dns_external_resolve(const char *name, ip_addr_t *addr, u8_t addrtype, err_t *err)
+{
+    if (name == NULL || addr == NULL || err == NULL || strlen(name) >= DNS_CACHE_HOSTNAME_LEN) {
+        return 0;   /* uncacheable, use the stock resolve path */
+    }
+
+    bool hit = false;
+    portENTER_CRITICAL(&s_dns_cache_mux);
+    dns_cache_entry_t *e = dns_cache_find(name);
+    if (e != NULL && dns_cache_entry_fresh(e)) {
+        if (e->negative) {
+            *err = ERR_VAL;
+            hit = true;
+        } else if (dns_cache_type_match(&e->addr, addrtype)) {
+            ip_addr_copy(*addr, e->addr);
+            *err = ERR_OK;
+            hit = true;
+        }
+    }
+    portEXIT_CRITICAL(&s_dns_cache_mux);
+    if (hit) {
+        return 1;
+    }
+
+    /* Miss: resolve in the TCP/IP thread so the result lands in the
+       cache, then report it to the blocked caller */
+    dns_cache_query_t q = {
+        .name = name,
+        .addrtype = addrtype,
+    };
+    if (sys_sem_new(&q.sem, 0) != ERR_OK) {
+        return 0;
+    }
+    if (tcpip_callback(dns_cache_do_query, &q) != ERR_OK) {
+        sys_sem_free(&q.sem);
+        return 0;
+    }
+    sys_arch_sem_wait(&q.sem, 0);
+    sys_sem_free(&q.sem);
+    ip_addr_copy(*addr, q.addr);
+    *err = q.err;
+    return 1;
+}
+
+err_t esp_dns_cache_pin(const char *hostname)
+{
+    if (hostname == NULL || strlen(hostname) >= DNS_CACHE_HOSTNAME_LEN) {
+        return ERR_ARG;
+    }
+    portENTER_CRITICAL(&s_dns_cache_mux);
+    dns_cache_entry_t *e = dns_cache_find(hostname);
+    if (e == NULL) {
+        e = dns_cache_alloc(hostname);
+    }
+    if (e != NULL) {
+        e->pinned = true;
+    }
+    portEXIT_CRITICAL(&s_dns_cache_mux);
+    if (e == NULL) {
+        return ERR_MEM;
+    }
+    /* resolve it now and keep it fresh from the TCP/IP thread */
+    tcpip_callback(dns_cache_kick, NULL);
+    return ERR_OK;
+}
+
+err_t esp_dns_cache_unpin(const char *hostname)
+{
+    err_t ret = ERR_ARG;
+    if (hostname == NULL) {
+        return ret;
+    }
+    portENTER_CRITICAL(&s_dns_cache_mux);
+    dns_cache_entry_t *e = dns_cache_find(hostname);
+    if (e != NULL && e->pinned) {
+        e->pinned = false;
+        ret = ERR_OK;
+    }
+    portEXIT_CRITICAL(&s_dns_cache_mux);
+    return ret;
+}
+
+err_t esp_dns_cache_lookup(const char *hostname, ip_addr_t *addr)
+{
+    err_t ret = ERR_INPROGRESS;
+    if (hostname == NULL || addr == NULL) {
+        return ERR_ARG;
+    }
+    portENTER_CRITICAL(&s_dns_cache_mux);
+    dns_cache_entry_t *e = dns_cache_find(hostname);
+    if (e != NULL && dns_cache_entry_fresh(e)) {
+        if (e->negative) {
+            ret = ERR_VAL;
+        } else {
+            ip_addr_copy(*addr, e->addr);
+            ret = ERR_OK;
+        }
+    }
+    portEXIT_CRITICAL(&s_dns_cache_mux);
+    return ret;
+}
+
+void esp_dns_cache_clear(void)
+{
+    portENTER_CRITICAL(&s_dns_cache_mux);
+    for (int i = 0; i < CONFIG_LWIP_DNS_EXTENDED_CACHE_SIZE; i++) {
+        dns_cache_entry_t *e = &s_dns_cache[i];
+        if (e->pinned) {
+            e->has_result = false;  /* re-resolved by the next refresh pass */
+        } else {
+            memset(e, 0, sizeof(*e));
+        }
+    }
+    portEXIT_CRITICAL(&s_dns_cache_mux);
+}
+
+#endif /* CONFIG_LWIP_DNS_EXTENDED_CACHE */
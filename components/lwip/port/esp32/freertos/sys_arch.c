@@ -41,9 +41,22 @@
 #include "lwip/stats.h"
 #include "esp_log.h"
 #include "esp_compiler.h"
+#ifdef CONFIG_LWIP_TCPIP_POLL_MODE
+#include <string.h>
+#include "esp_timer.h"
+#endif
 
 static const char* TAG = "lwip_arch";
 
+#ifdef CONFIG_LWIP_TCPIP_POLL_MODE
+/* Adaptive polling for the TCP/IP thread: when messages have arrived
+   recently, spin on the mailbox for a bounded window instead of blocking
+   per message, trading a little CPU for the per-message wakeup latency
+   (unblock + context switch) in sustained-throughput scenarios. */
+static TaskHandle_t s_tcpip_task;
+static int64_t s_tcpip_last_msg_us;
+#endif
+
 static sys_mutex_t g_lwip_protect_mutex = NULL;
 
 static pthread_key_t sys_thread_sem_key;
@@ -317,9 +330,36 @@ sys_arch_mbox_fetch(sys_mbox_t *mbox, void **msg, u32_t timeout)
   }
 
   if (timeout == 0) {
+#ifdef CONFIG_LWIP_TCPIP_POLL_MODE
+    if (xTaskGetCurrentTaskHandle() == s_tcpip_task) {
+      /* drain without blocking first */
+      if (xQueueReceive((*mbox)->os_mbox, &(*msg), 0) == pdTRUE) {
+        s_tcpip_last_msg_us = esp_timer_get_time();
+        return 0;
+      }
+      /* in a burst (a message arrived within the poll window), spin for
+         the rest of the window rather than paying a block/unblock per
+         message */
+      int64_t now = esp_timer_get_time();
+      if (now - s_tcpip_last_msg_us < CONFIG_LWIP_TCPIP_POLL_WINDOW_US) {
+        int64_t deadline = s_tcpip_last_msg_us + CONFIG_LWIP_TCPIP_POLL_WINDOW_US;
+        while (esp_timer_get_time() < deadline) {
+          if (xQueueReceive((*mbox)->os_mbox, &(*msg), 0) == pdTRUE) {
+            s_tcpip_last_msg_us = esp_timer_get_time();
+            return 0;
+          }
+        }
+      }
+    }
+#endif
     /* wait infinite */
     ret = xQueueReceive((*mbox)->os_mbox, &(*msg), portMAX_DELAY);
     LWIP_ASSERT("mbox fetch failed", ret == pdTRUE);
+#ifdef CONFIG_LWIP_TCPIP_POLL_MODE
+    if (xTaskGetCurrentTaskHandle() == s_tcpip_task) {
+      s_tcpip_last_msg_us = esp_timer_get_time();
+    }
+#endif
   } else {
     TickType_t timeout_ticks = timeout / portTICK_RATE_MS;
     ret = xQueueReceive((*mbox)->os_mbox, &(*msg), timeout_ticks);
@@ -413,6 +453,12 @@ sys_thread_new(const char *name, lwip_thread_fn thread, void *arg, int stacksize
     return NULL;
   }
 
+#ifdef CONFIG_LWIP_TCPIP_POLL_MODE
+  if (name != NULL && strcmp(name, TCPIP_THREAD_NAME) == 0) {
+    s_tcpip_task = rtos_task;
+  }
+#endif
+
   return (sys_thread_t)rtos_task;
 }
 
@@ -0,0 +1,76 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _ESP_DNS_CACHE_H_
+#define _ESP_DNS_CACHE_H_
+
+#include "lwip/err.h"
+#include "lwip/ip_addr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Pin a hostname for proactive background refresh
+ *
+ * Pinned hostnames (typically the MQTT broker or API endpoint of the
+ * device) are resolved immediately and re-resolved shortly before their
+ * cache entry expires, so a reconnect never waits on DNS. Pinned entries
+ * are never evicted to make room for other names.
+ *
+ * @param hostname  name to keep resolved; copied, at most 63 characters
+ *
+ * @return ERR_OK on success, ERR_ARG if the name is NULL or too long,
+ *         ERR_MEM if the cache is full of pinned entries
+ */
+err_t esp_dns_cache_pin(const char *hostname);
+
+/**
+ * @brief Stop refreshing a pinned hostname
+ *
+ * The entry stays cached until it expires or is evicted.
+ *
+ * @param hostname  name previously passed to esp_dns_cache_pin()
+ *
+ * @return ERR_OK on success, ERR_ARG if the name is not pinned
+ */
+err_t esp_dns_cache_unpin(const char *hostname);
+
+/**
+ * @brief Non-blocking cache peek
+ *
+ * @param hostname  name to look up
+ * @param addr      filled with the cached address on a positive hit
+ *
+ * @return ERR_OK on a positive hit, ERR_VAL on a cached negative result
+ *         (name known not to resolve), ERR_INPROGRESS if the name is not
+ *         cached — resolve it through the normal blocking path
+ */
+err_t esp_dns_cache_lookup(const char *hostname, ip_addr_t *addr);
+
+/**
+ * @brief Drop all cached results
+ *
+ * Pinned names stay pinned and are re-resolved by the background
+ * refresh; everything else is forgotten. Call e.g. after the default
+ * netif or the DNS server configuration changes.
+ */
+void esp_dns_cache_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ESP_DNS_CACHE_H_ */
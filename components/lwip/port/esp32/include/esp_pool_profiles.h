@@ -0,0 +1,141 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _ESP_POOL_PROFILES_H_
+#define _ESP_POOL_PROFILES_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * lwIP in this port is built with MEM_LIBC_MALLOC and MEMP_MEM_MALLOC, so
+ * every pool and pbuf allocation already comes from the heap instead of
+ * static arrays. What the compile-time pool constants used to provide — a
+ * bound on how much of the system lwIP may take — is enforced here at run
+ * time instead, as switchable profiles: a small quiescent budget for normal
+ * operation and a larger one for bulk transfer phases such as OTA windows.
+ * The same layer keeps live telemetry (current usage, high-water marks and
+ * refused allocations) per allocation size class.
+ *
+ * Allocations above the active budget fail like an exhausted pool would,
+ * which lwIP handles gracefully (dropped pbuf, ERR_MEM to the caller).
+ */
+
+/** Pool budget profiles, limits set via Kconfig or esp_lwip_pool_set_profile_limit() */
+typedef enum {
+    ESP_LWIP_POOL_PROFILE_QUIESCENT = 0,  /*!< small budget for normal operation (default) */
+    ESP_LWIP_POOL_PROFILE_BULK,           /*!< enlarged budget for bulk transfer phases (OTA) */
+    ESP_LWIP_POOL_PROFILE_MAX,
+} esp_lwip_pool_profile_t;
+
+/** Number of allocation size classes tracked by the telemetry */
+#define ESP_LWIP_POOL_CLASS_NUM 6
+
+/** Telemetry of one allocation size class */
+typedef struct {
+    uint32_t allocs;      /*!< successful allocations since start (or last clear) */
+    uint32_t failures;    /*!< allocations refused by the budget or by the heap */
+    uint32_t cur_bytes;   /*!< bytes currently allocated in this class */
+    uint32_t hwm_bytes;   /*!< high-water mark of cur_bytes */
+} esp_lwip_pool_class_stats_t;
+
+/**
+ * @brief Switch the active pool profile
+ *
+ * Intended to be called between workload phases, at quiescent points.
+ * Switching to a smaller budget while usage is above it does not free
+ * anything; new allocations fail until usage drains below the new budget.
+ *
+ * @param profile  profile to activate
+ *
+ * @return ESP_OK on success
+ *         ESP_ERR_INVALID_ARG on an unknown profile
+ */
+esp_err_t esp_lwip_pool_set_profile(esp_lwip_pool_profile_t profile);
+
+/**
+ * @brief Get the active pool profile
+ */
+esp_lwip_pool_profile_t esp_lwip_pool_get_profile(void);
+
+/**
+ * @brief Override the budget of a profile at run time
+ *
+ * Replaces the Kconfig default. Takes effect immediately if the profile
+ * is the active one.
+ *
+ * @param profile      profile to change
+ * @param limit_bytes  budget in bytes, 0 means unlimited
+ *
+ * @return ESP_OK on success
+ *         ESP_ERR_INVALID_ARG on an unknown profile
+ */
+esp_err_t esp_lwip_pool_set_profile_limit(esp_lwip_pool_profile_t profile, size_t limit_bytes);
+
+/**
+ * @brief Bytes currently allocated by lwIP through this layer
+ */
+size_t esp_lwip_pool_total_bytes(void);
+
+/**
+ * @brief High-water mark of the total allocated bytes
+ */
+size_t esp_lwip_pool_hwm_bytes(void);
+
+/**
+ * @brief Read the telemetry of one allocation size class
+ *
+ * @param class_idx  size class, 0 .. ESP_LWIP_POOL_CLASS_NUM - 1; use
+ *                   esp_lwip_pool_class_ceiling() for the class boundaries
+ * @param stats      filled with the current counters
+ * @param clear      reset allocs and failures to zero and the high-water
+ *                   mark down to the current usage after reading
+ *
+ * @return ESP_OK on success
+ *         ESP_ERR_INVALID_ARG on an invalid class index or NULL stats
+ */
+esp_err_t esp_lwip_pool_get_class_stats(int class_idx, esp_lwip_pool_class_stats_t *stats, bool clear);
+
+/**
+ * @brief Largest allocation size belonging to a size class
+ *
+ * @param class_idx  size class, 0 .. ESP_LWIP_POOL_CLASS_NUM - 1
+ *
+ * @return upper bound of the class in bytes (SIZE_MAX for the last class),
+ *         or 0 on an invalid class index
+ */
+size_t esp_lwip_pool_class_ceiling(int class_idx);
+
+/**
+ * @brief Allocator hooks, wired to lwIP via mem_clib_* in lwipopts.h
+ *
+ * Not meant for application use: memory from esp_lwip_pool_malloc() must
+ * be returned with esp_lwip_pool_free(), and is accounted against the
+ * active pool budget.
+ */
+void *esp_lwip_pool_malloc(size_t size);
+void *esp_lwip_pool_calloc(size_t n, size_t size);
+void esp_lwip_pool_free(void *ptr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ESP_POOL_PROFILES_H_ */
@@ -0,0 +1,108 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _ESP_TCP_SNAPSHOT_H_
+#define _ESP_TCP_SNAPSHOT_H_
+
+#include "lwip/err.h"
+#include "lwip/tcp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Frozen state of a quiescent, established IPv4 TCP connection.
+ *
+ * The application places an instance in RTC memory (RTC_DATA_ATTR) so it
+ * survives deep sleep, snapshots a connection just before entering sleep
+ * and restores it right after the network interface is up again. Sequence
+ * numbers and window state are carried over; congestion control restarts
+ * from slow start and the retransmission timers run fresh, which is the
+ * conservative choice after an arbitrary time asleep.
+ */
+typedef struct esp_tcp_snapshot {
+    u32_t magic;                /*!< validity marker, managed by the snapshot/restore calls */
+    u32_t local_ip;             /*!< local IPv4 address, network byte order */
+    u32_t remote_ip;            /*!< remote IPv4 address, network byte order */
+    u16_t local_port;
+    u16_t remote_port;
+    u32_t snd_nxt;              /*!< next sequence number to send */
+    u32_t snd_wl1;              /*!< seqno of last window update */
+    u32_t snd_wl2;              /*!< ackno of last window update */
+    u32_t lastack;              /*!< highest acknowledged seqno */
+    u32_t snd_wnd;              /*!< send window offered by the peer */
+    u32_t snd_wnd_max;
+    u32_t rcv_nxt;              /*!< next sequence number expected */
+    u32_t rcv_wnd;              /*!< receive window */
+    u32_t rcv_ann_wnd;          /*!< announced receive window */
+    u32_t rcv_ann_right_edge;
+    u16_t mss;
+    u16_t flags;                /*!< negotiated option flags (nodelay/timestamps/window scale) */
+    u8_t snd_scale;
+    u8_t rcv_scale;
+    u8_t prio;
+    u8_t tos;
+    u8_t ttl;
+} esp_tcp_snapshot_t;
+
+/**
+ * @brief Snapshot an established TCP connection for restore after deep sleep
+ *
+ * The connection must be quiescent: all sent data acknowledged, nothing
+ * queued, no out-of-order data pending. Typically the application flushes
+ * its last report, waits for the sent callback and then snapshots just
+ * before esp_deep_sleep_start(). Call from the TCP/IP thread context.
+ *
+ * The peer is not told anything; it simply sees an idle connection while
+ * the device sleeps, so the sleep interval has to stay below the peer's
+ * idle/keepalive timeout.
+ *
+ * @param pcb   established TCP PCB to snapshot
+ * @param snap  snapshot storage, normally in RTC memory
+ *
+ * @return ERR_OK on success, ERR_ARG on NULL arguments, ERR_CONN if the
+ *         connection is not in ESTABLISHED state, ERR_INPROGRESS if data
+ *         is still queued or in flight, ERR_VAL for IPv6 connections
+ */
+err_t esp_tcp_snapshot(struct tcp_pcb *pcb, esp_tcp_snapshot_t *snap);
+
+/**
+ * @brief Re-create a TCP PCB from a snapshot taken before deep sleep
+ *
+ * Call from the TCP/IP thread context once the network interface is up
+ * with the same local address as before sleep (pair this with
+ * CONFIG_LWIP_DHCP_OPTIMISTIC_RESTORE so the address is back within
+ * milliseconds of wake). The returned PCB is in ESTABLISHED state; the
+ * application re-registers its tcp_recv()/tcp_sent()/tcp_err() callbacks
+ * and can send immediately. If the peer dropped the connection while the
+ * device slept, the first transmission draws an RST and the error
+ * callback fires — fall back to a normal reconnect in that case.
+ *
+ * The snapshot is invalidated on success so it cannot be restored twice;
+ * replaying the same sequence state into two PCBs would corrupt the
+ * connection.
+ *
+ * @param snap  snapshot filled in by esp_tcp_snapshot()
+ *
+ * @return the restored PCB, or NULL if the snapshot is invalid or no
+ *         memory is available
+ */
+struct tcp_pcb *esp_tcp_restore(esp_tcp_snapshot_t *snap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ESP_TCP_SNAPSHOT_H_ */
@@ -0,0 +1,79 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _ESP_TCP_STATS_H_
+#define _ESP_TCP_STATS_H_
+
+#include "lwip/err.h"
+#include "lwip/tcp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Traffic counters of a single TCP connection.
+ *
+ * Counters accumulate from the first segment seen on the connection.
+ * They are written from the TCP/IP thread and read without locking;
+ * individual fields are consistent but a snapshot taken while traffic
+ * flows may mix slightly different points in time.
+ */
+typedef struct esp_tcp_stats {
+    u32_t remote_ip;        /*!< remote IPv4 address, network byte order (0 for IPv6) */
+    u16_t remote_port;
+    u16_t local_port;
+    u32_t bytes_in;         /*!< payload bytes received */
+    u32_t segs_in;          /*!< segments received */
+    u32_t bytes_out;        /*!< payload bytes sent (including retransmissions) */
+    u32_t segs_out;         /*!< segments sent */
+    u32_t retransmits;      /*!< data segments sent with an already-used sequence number */
+    u32_t rtt_ms;           /*!< smoothed round-trip time estimate, milliseconds */
+    u32_t rto_ms;           /*!< current retransmission timeout, milliseconds */
+} esp_tcp_stats_t;
+
+/**
+ * @brief Get the traffic counters of a TCP socket
+ *
+ * @param fd   lwIP socket descriptor of a connected TCP socket
+ * @param out  filled with the counters of the underlying connection
+ *
+ * @return ERR_OK on success, ERR_ARG if the descriptor is not a TCP
+ *         socket or the connection is not (or no longer) tracked
+ */
+err_t esp_tcp_stats_sock_get(int fd, esp_tcp_stats_t *out);
+
+/**
+ * @brief Get the traffic counters of a TCP PCB (raw API connections)
+ *
+ * @param pcb  TCP PCB to query
+ * @param out  filled with the counters of this connection
+ *
+ * @return ERR_OK on success, ERR_ARG if the PCB is not tracked
+ */
+err_t esp_tcp_stats_pcb_get(struct tcp_pcb *pcb, esp_tcp_stats_t *out);
+
+/**
+ * @brief Log the counters of every tracked TCP connection
+ *
+ * One line per connection at INFO level, for on-device debugging of
+ * which socket is responsible for link load.
+ */
+void esp_tcp_stats_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ESP_TCP_STATS_H_ */
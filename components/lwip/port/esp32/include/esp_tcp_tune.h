@@ -0,0 +1,59 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _ESP_TCP_TUNE_H_
+#define _ESP_TCP_TUNE_H_
+
+#include "lwip/err.h"
+#include "lwip/tcp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Set the receive window of a single TCP PCB at runtime
+ *
+ * TCP_WND from Kconfig sizes every connection alike; this lets one bulk
+ * transfer connection run with a large window while control connections
+ * keep a small one. Call from the TCP/IP thread context, right after the
+ * PCB is created or accepted and before data starts flowing — shrinking
+ * the window of a connection with data in flight is not supported.
+ *
+ * @param pcb  TCP PCB to tune
+ * @param wnd  receive window in bytes (clamped to at least one MSS)
+ *
+ * @return ERR_OK on success, ERR_ARG if pcb is NULL
+ */
+err_t esp_tcp_set_rcv_wnd(struct tcp_pcb *pcb, u32_t wnd);
+
+/**
+ * @brief Set the send buffer size of a single TCP PCB at runtime
+ *
+ * Same constraints as esp_tcp_set_rcv_wnd(): call from the TCP/IP thread
+ * context on a PCB with no unsent/unacked data queued.
+ *
+ * @param pcb      TCP PCB to tune
+ * @param snd_buf  send buffer size in bytes (clamped to at least one MSS)
+ *
+ * @return ERR_OK on success, ERR_ARG if pcb is NULL,
+ *         ERR_INPROGRESS if the PCB already has data queued
+ */
+err_t esp_tcp_set_snd_buf(struct tcp_pcb *pcb, u32_t snd_buf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ESP_TCP_TUNE_H_ */
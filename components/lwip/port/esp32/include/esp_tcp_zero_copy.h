@@ -0,0 +1,82 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _ESP_TCP_ZERO_COPY_H_
+#define _ESP_TCP_ZERO_COPY_H_
+
+#include "lwip/err.h"
+#include "lwip/tcp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Completion callback for a zero-copy TCP write
+ *
+ * Invoked from the TCP/IP thread once every byte of the corresponding
+ * esp_tcp_zc_write() call has been acknowledged by the peer (err == ERR_OK),
+ * or when the transfer is abandoned via esp_tcp_zc_detach() (err carries the
+ * abort reason). After the callback the application may reuse or free the
+ * buffer.
+ *
+ * @param arg  user argument passed to esp_tcp_zc_write()
+ * @param err  ERR_OK on acknowledgement, otherwise the abort error
+ */
+typedef void (*esp_tcp_zc_done_cb_t)(void *arg, err_t err);
+
+/**
+ * @brief Queue application data on a TCP PCB without copying it
+ *
+ * The data is enqueued by reference (tcp_write() without TCP_WRITE_FLAG_COPY),
+ * so no intermediate segment copy is made: the driver transmits straight from
+ * the application buffer. The buffer MUST stay valid and unmodified until the
+ * completion callback fires — this is intended for stable buffers such as DMA
+ * frame buffers or memory-mapped flash assets.
+ *
+ * Must be called from the TCP/IP thread context (e.g. via tcpip_callback())
+ * on a connected PCB. The PCB's tcp_sent() callback, if any, keeps working:
+ * it is chained after the internal ACK accounting.
+ *
+ * @param pcb   connected TCP PCB to send on
+ * @param data  buffer to send, kept by reference
+ * @param len   number of bytes to send
+ * @param cb    completion callback, may be NULL
+ * @param arg   user argument for the callback
+ *
+ * @return ERR_OK if queued, ERR_MEM if the send buffer or the tracking pool
+ *         is exhausted (retry later), other err_t from tcp_write()
+ */
+err_t esp_tcp_zc_write(struct tcp_pcb *pcb, const void *data, u16_t len,
+                       esp_tcp_zc_done_cb_t cb, void *arg);
+
+/**
+ * @brief Stop zero-copy tracking on a PCB
+ *
+ * Fires every pending completion callback with the given error and restores
+ * the PCB's original tcp_sent() callback. Call this before closing or
+ * aborting a PCB which still has unacknowledged zero-copy data.
+ *
+ * Must be called from the TCP/IP thread context.
+ *
+ * @param pcb  PCB to detach
+ * @param err  error reported to the pending callbacks (e.g. ERR_ABRT)
+ */
+void esp_tcp_zc_detach(struct tcp_pcb *pcb, err_t err);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ESP_TCP_ZERO_COPY_H_ */
@@ -0,0 +1,89 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _ESP_UDP_FASTPATH_H_
+#define _ESP_UDP_FASTPATH_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief UDP fast path receive callback
+ *
+ * Called straight from the Wi-Fi driver RX context when an IPv4 UDP
+ * datagram for a registered local port arrives — no tcpip thread mailbox
+ * hop, no socket queue. The payload points into the driver's RX buffer
+ * and is only valid for the duration of the call: copy out what you need
+ * and return quickly, and do not block.
+ *
+ * @param arg       user argument given at registration
+ * @param payload   UDP payload (not including headers)
+ * @param len       payload length in bytes
+ * @param src_addr  source IPv4 address, network byte order
+ * @param src_port  source UDP port, host byte order
+ */
+typedef void (*esp_udp_fastpath_cb_t)(void *arg, const void *payload, size_t len,
+                                      uint32_t src_addr, uint16_t src_port);
+
+/**
+ * @brief Register a UDP fast path receiver for a local port
+ *
+ * Matching datagrams are consumed before they enter lwIP, so they will NOT
+ * be delivered to any socket bound to the same port. Intended for small
+ * high-rate flows (telemetry, control loops) where the two context switches
+ * of the normal esp_netif -> tcpip -> socket path dominate the cost.
+ *
+ * @param local_port  destination UDP port to capture, host byte order
+ * @param cb          receive callback, runs in Wi-Fi RX context
+ * @param arg         user argument for the callback
+ *
+ * @return ESP_OK on success
+ *         ESP_ERR_INVALID_ARG if cb is NULL or local_port is 0
+ *         ESP_ERR_INVALID_STATE if the port is already registered
+ *         ESP_ERR_NO_MEM if all fast path slots are in use
+ */
+esp_err_t esp_udp_fastpath_register(uint16_t local_port, esp_udp_fastpath_cb_t cb, void *arg);
+
+/**
+ * @brief Remove a UDP fast path receiver
+ *
+ * After this returns, datagrams for the port flow through the normal
+ * lwIP input path again.
+ *
+ * @param local_port  port previously passed to esp_udp_fastpath_register()
+ *
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if the port is not registered
+ */
+esp_err_t esp_udp_fastpath_unregister(uint16_t local_port);
+
+/**
+ * @brief Try to consume a received ethernet frame (internal)
+ *
+ * Called by the netif glue from the driver RX context. Returns true if the
+ * frame was an IPv4 UDP datagram for a registered port and was delivered
+ * via its callback; the caller then frees the RX buffer and skips lwIP.
+ */
+bool esp_udp_fastpath_input(const void *frame, uint16_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ESP_UDP_FASTPATH_H_ */
@@ -93,6 +93,18 @@
 */
 #define MEMP_MEM_MALLOC                 1
 
+#ifdef CONFIG_LWIP_POOL_PROFILES
+/**
+ * Route the C-library allocator through the pool profile layer, which
+ * enforces the budget of the active profile and keeps per size class
+ * telemetry (see esp_pool_profiles.h).
+ */
+#include "esp_pool_profiles.h"
+#define mem_clib_malloc                 esp_lwip_pool_malloc
+#define mem_clib_calloc                 esp_lwip_pool_calloc
+#define mem_clib_free                   esp_lwip_pool_free
+#endif
+
 /**
  * MEM_ALIGNMENT: should be set to the alignment of the CPU
  *    4 byte alignment -> #define MEM_ALIGNMENT 4
@@ -431,6 +443,34 @@ u32_t lwip_hook_tcp_isn(const struct ip_addr *local_ip, u16_t local_port,
 #define LWIP_HOOK_TCP_ISN               lwip_hook_tcp_isn
 #endif
 
+/**
+ * Set TCP packet hooks for per-connection traffic statistics
+ */
+#ifdef CONFIG_LWIP_PER_SOCKET_TCP_STATS
+#include <lwip/arch.h>
+#include <lwip/err.h>
+struct tcp_pcb;
+struct tcp_hdr;
+struct pbuf;
+err_t lwip_hook_tcp_stats_input(struct tcp_pcb *pcb, struct tcp_hdr *hdr, struct pbuf *p);
+u32_t *lwip_hook_tcp_stats_output(struct pbuf *p, struct tcp_hdr *hdr, struct tcp_pcb *pcb, u32_t *opts);
+#define LWIP_HOOK_TCP_INPACKET_PCB(pcb, hdr, optlen, opt1len, opt2, p) \
+        lwip_hook_tcp_stats_input(pcb, hdr, p)
+#define LWIP_HOOK_TCP_OUT_ADD_TCPOPTS(p, hdr, pcb, opts) \
+        lwip_hook_tcp_stats_output(p, hdr, pcb, opts)
+#endif
+
+/**
+ * Set netconn resolve hook for the extended DNS cache
+ */
+#ifdef CONFIG_LWIP_DNS_EXTENDED_CACHE
+#include <lwip/arch.h>
+#include <lwip/err.h>
+struct ip_addr;
+int lwip_hook_dns_external_resolve(const char *name, struct ip_addr *addr, u8_t addrtype, err_t *err);
+#define LWIP_HOOK_NETCONN_EXTERNAL_RESOLVE  lwip_hook_dns_external_resolve
+#endif
+
 /*
    ----------------------------------
    ---------- Pbuf options ----------
@@ -917,7 +957,11 @@ u32_t lwip_hook_tcp_isn(const struct ip_addr *local_ip, u16_t local_port,
 
 #define ESP_LWIP                        1
 #define ESP_LWIP_ARP                    1
+#ifdef CONFIG_LWIP_PER_SOCKET_TCP_WND
+#define ESP_PER_SOC_TCP_WND             1
+#else
 #define ESP_PER_SOC_TCP_WND             0
+#endif
 #define ESP_THREAD_SAFE                 1
 #define ESP_THREAD_SAFE_DEBUG           LWIP_DBG_OFF
 #define ESP_DHCP                        1
@@ -972,6 +1016,25 @@ u32_t lwip_hook_tcp_isn(const struct ip_addr *local_ip, u16_t local_port,
 #define LWIP_DEBUG                      LWIP_DBG_OFF
 #define TCP_DEBUG                       LWIP_DBG_OFF
 
+#ifdef CONFIG_LWIP_CHKSUM_OPTIMIZED
+/**
+ * Word-wide checksum implementation (port/esp32/chksum.c): four 32-bit
+ * loads per iteration with deferred carry folding, much faster than the
+ * generic 16-bit-at-a-time loop on sustained transfers.
+ */
+unsigned short esp_ip_chksum(const void *dataptr, int len);
+#define LWIP_CHKSUM                     esp_ip_chksum
+#endif
+
+#ifdef CONFIG_LWIP_CHECKSUM_PER_NETIF
+/**
+ * Allow checksum generation/checking to be disabled per interface
+ * (NETIF_SET_CHECKSUM_CTRL), e.g. to elide checks on loopback or other
+ * trusted interfaces.
+ */
+#define LWIP_CHECKSUM_CTRL_PER_NETIF    1
+#endif
+
 #define CHECKSUM_CHECK_UDP              0
 #define CHECKSUM_CHECK_IP               0
 
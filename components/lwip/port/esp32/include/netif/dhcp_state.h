@@ -26,6 +26,13 @@ void dhcp_ip_addr_store(void *netif);
 
 void dhcp_ip_addr_erase(void *esp_netif);
 
+/**
+ * Restore the complete cached lease (address, netmask, gateway) of this
+ * interface, for optimistic reconfiguration before the DHCP client has
+ * re-validated it. Returns false if no lease is cached.
+ */
+bool dhcp_lease_restore(void *esp_netif, uint32_t *ip, uint32_t *netmask, uint32_t *gw);
+
 #ifdef __cplusplus
 }
 #endif
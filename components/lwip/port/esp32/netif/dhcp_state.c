@@ -24,6 +24,14 @@
 #include "netif/dhcp_state.h"
 
 #define DHCP_NAMESPACE "dhcp_state"
+#define DHCP_LEASE_NAMESPACE "dhcp_lease"
+
+// Complete cached lease, used for optimistic reconfiguration on reconnect
+typedef struct {
+    uint32_t ip;
+    uint32_t netmask;
+    uint32_t gw;
+} dhcp_lease_data_t;
 
 // DHCP_Client has to be enabled for this netif
 #define VALID_NETIF_ID(netif) (ESP_NETIF_DHCP_CLIENT&esp_netif_get_flags(netif))
@@ -62,7 +70,39 @@ void dhcp_ip_addr_store(void *netif)
             nvs_commit(nvs);
             nvs_close(nvs);
         }
+        dhcp_lease_data_t lease = {
+            .ip = dhcp->offered_ip_addr.addr,
+            .netmask = dhcp->offered_sn_mask.addr,
+            .gw = dhcp->offered_gw_addr.addr,
+        };
+        if (nvs_open(DHCP_LEASE_NAMESPACE, NVS_READWRITE, &nvs) == ESP_OK) {
+            nvs_set_blob(nvs, esp_netif_get_ifkey(esp_netif), &lease, sizeof(lease));
+            nvs_commit(nvs);
+            nvs_close(nvs);
+        }
+    }
+}
+
+bool dhcp_lease_restore(void *esp_netif, uint32_t *ip, uint32_t *netmask, uint32_t *gw)
+{
+    nvs_handle_t nvs;
+    bool err = false;
+    dhcp_lease_data_t lease;
+    size_t length = sizeof(lease);
+
+    if(VALID_NETIF_ID((esp_netif_t *)esp_netif)) {
+        if (nvs_open(DHCP_LEASE_NAMESPACE, NVS_READONLY, &nvs) == ESP_OK) {
+            if (nvs_get_blob(nvs, esp_netif_get_ifkey(esp_netif), &lease, &length) == ESP_OK &&
+                    length == sizeof(lease) && lease.ip != 0) {
+                *ip = lease.ip;
+                *netmask = lease.netmask;
+                *gw = lease.gw;
+                err = true;
+            }
+            nvs_close(nvs);
+        }
     }
+    return err;
 }
 
 void dhcp_ip_addr_erase(void *esp_netif)
@@ -75,5 +115,10 @@ void dhcp_ip_addr_erase(void *esp_netif)
             nvs_commit(nvs);
             nvs_close(nvs);
         }
+        if (nvs_open(DHCP_LEASE_NAMESPACE, NVS_READWRITE, &nvs) == ESP_OK) {
+            nvs_erase_key(nvs, esp_netif_get_ifkey(esp_netif));
+            nvs_commit(nvs);
+            nvs_close(nvs);
+        }
     }
 }
@@ -57,6 +57,9 @@
 #define IFNAME0 'e'
 #define IFNAME1 'n'
 
+/* Longest pbuf chain passed down as scattered buffers; longer chains are flattened */
+#define ETHERNET_TX_MAX_GATHER_BUFS 8
+
 /**
  * @brief Free resources allocated in L2 layer
  *
@@ -117,6 +120,23 @@ static err_t ethernet_low_level_output(struct netif *netif, struct pbuf *p)
     if (q->next == NULL) {
         ret = esp_netif_transmit(esp_netif, q->payload, q->len);
     } else {
+        /* Chained pbuf: hand the chain down as scattered buffers so the driver can
+         * splice them into the DMA buffers in one pass, without a contiguous copy */
+        void *bufs[ETHERNET_TX_MAX_GATHER_BUFS];
+        size_t lens[ETHERNET_TX_MAX_GATHER_BUFS];
+        size_t cnt = 0;
+        for (q = p; q != NULL && cnt < ETHERNET_TX_MAX_GATHER_BUFS; q = q->next) {
+            bufs[cnt] = q->payload;
+            lens[cnt] = q->len;
+            cnt++;
+        }
+        if (q == NULL) {
+            ret = esp_netif_transmit_multi(esp_netif, bufs, lens, cnt);
+            if (likely(ret != ESP_ERR_NOT_SUPPORTED)) {
+                goto check;
+            }
+        }
+        /* Chain too long or the driver has no scatter-gather support: flatten it */
         LWIP_DEBUGF(PBUF_DEBUG, ("low_level_output: pbuf is a list, application may has bug"));
         q = pbuf_alloc(PBUF_RAW_TX, p->tot_len, PBUF_RAM);
         if (q != NULL) {
@@ -133,6 +153,7 @@ static err_t ethernet_low_level_output(struct netif *netif, struct pbuf *p)
         /* content in payload has been copied to DMA buffer, it's safe to free pbuf now */
         pbuf_free(q);
     }
+check:
     /* Check error */
     if (unlikely(ret != ESP_OK)) {
         return ERR_ABRT;
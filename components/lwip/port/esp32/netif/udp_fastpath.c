@@ -0,0 +1,131 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include "esp_udp_fastpath.h"
+#include "sdkconfig.h"
+
+#ifdef CONFIG_LWIP_UDP_FASTPATH
+
+/* UDP receive fast path.
+
+   A small high-rate UDP flow (1 kHz telemetry) pays the full
+   driver -> esp_netif -> tcpip mailbox -> socket queue chain for every
+   tiny datagram: two context switches and two queue operations. Here the
+   netif glue (wlanif_input) offers each received frame to a tiny
+   registered-port table before handing it to lwIP; on a match the UDP
+   payload is delivered via callback directly in the driver RX context
+   and the frame never enters the stack.
+
+   Only plain IPv4/UDP frames are matched (no IP options, no fragments,
+   no VLAN tag); anything else falls through to the normal path. */
+
+#define ETH_HDR_LEN         14
+#define ETHTYPE_IPV4_HI     0x08
+#define ETHTYPE_IPV4_LO     0x00
+#define IP_PROTO_UDP        17
+
+typedef struct {
+    uint16_t port;                      /* 0 if the slot is free */
+    esp_udp_fastpath_cb_t cb;
+    void *arg;
+} udp_fastpath_entry_t;
+
+static udp_fastpath_entry_t s_entries[CONFIG_LWIP_UDP_FASTPATH_MAX_PORTS];
+static volatile int s_entry_count;      /* lets the RX hot path bail out in one load */
+
+esp_err_t esp_udp_fastpath_register(uint16_t local_port, esp_udp_fastpath_cb_t cb, void *arg)
+{
+    if (cb == NULL || local_port == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    int free_slot = -1;
+    for (int i = 0; i < CONFIG_LWIP_UDP_FASTPATH_MAX_PORTS; i++) {
+        if (s_entries[i].port == local_port) {
+            return ESP_ERR_INVALID_STATE;
+        }
+        if (s_entries[i].port == 0 && free_slot < 0) {
+            free_slot = i;
+        }
+    }
+    if (free_slot < 0) {
+        return ESP_ERR_NO_MEM;
+    }
+    s_entries[free_slot].cb = cb;
+    s_entries[free_slot].arg = arg;
+    /* publish the port last so the RX context never sees a half-written entry */
+    __sync_synchronize();
+    s_entries[free_slot].port = local_port;
+    s_entry_count++;
+    return ESP_OK;
+}
+
+esp_err_t esp_udp_fastpath_unregister(uint16_t local_port)
+{
+    for (int i = 0; i < CONFIG_LWIP_UDP_FASTPATH_MAX_PORTS; i++) {
+        if (s_entries[i].port == local_port) {
+            s_entries[i].port = 0;
+            __sync_synchronize();
+            s_entries[i].cb = NULL;
+            s_entries[i].arg = NULL;
+            s_entry_count--;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+bool esp_udp_fastpath_input(const void *frame, uint16_t len)
+{
+    if (s_entry_count == 0) {
+        return false;
+    }
+    const uint8_t *b = (const uint8_t *)frame;
+    if (len < ETH_HDR_LEN + 20 + 8) {
+        return false;
+    }
+    if (b[12] != ETHTYPE_IPV4_HI || b[13] != ETHTYPE_IPV4_LO) {
+        return false;
+    }
+    const uint8_t *ip = b + ETH_HDR_LEN;
+    if (ip[0] != 0x45) {                /* IPv4, no options */
+        return false;
+    }
+    if ((ip[6] & 0x3f) != 0 || ip[7] != 0) {    /* fragment offset or MF set */
+        return false;
+    }
+    if (ip[9] != IP_PROTO_UDP) {
+        return false;
+    }
+    const uint8_t *udp = ip + 20;
+    uint16_t dst_port = ((uint16_t)udp[2] << 8) | udp[3];
+
+    for (int i = 0; i < CONFIG_LWIP_UDP_FASTPATH_MAX_PORTS; i++) {
+        if (s_entries[i].port != dst_port) {
+            continue;
+        }
+        uint16_t udp_len = ((uint16_t)udp[4] << 8) | udp[5];
+        if (udp_len < 8 || ETH_HDR_LEN + 20 + udp_len > len) {
+            return false;               /* malformed; let lwIP account for it */
+        }
+        uint32_t src_addr;
+        memcpy(&src_addr, ip + 12, sizeof(src_addr));   /* already network order */
+        uint16_t src_port = ((uint16_t)udp[0] << 8) | udp[1];
+        s_entries[i].cb(s_entries[i].arg, udp + 8, udp_len - 8, src_addr, src_port);
+        return true;
+    }
+    return false;
+}
+
+#endif /* CONFIG_LWIP_UDP_FASTPATH */
@@ -53,6 +53,9 @@
 #include "esp_netif.h"
 #include "esp_netif_net_stack.h"
 #include "esp_compiler.h"
+#ifdef CONFIG_LWIP_UDP_FASTPATH
+#include "esp_udp_fastpath.h"
+#endif
 
 #if !ESP_L2_TO_L3_COPY
 /**
@@ -184,6 +187,15 @@ wlanif_input(void *h, void *buffer, size_t len, void* eb)
     return;
   }
 
+#ifdef CONFIG_LWIP_UDP_FASTPATH
+  /* registered UDP ports are consumed right here in the RX context,
+     skipping the tcpip mailbox and socket queue entirely */
+  if (esp_udp_fastpath_input(buffer, len)) {
+    esp_netif_free_rx_buffer(esp_netif, eb);
+    return;
+  }
+#endif
+
 #if (ESP_L2_TO_L3_COPY == 1)
   p = pbuf_alloc(PBUF_RAW, len, PBUF_RAM);
   if (p == NULL) {
@@ -0,0 +1,176 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_pool_profiles.h"
+#include "sdkconfig.h"
+
+/* Every allocation carries this prefix so free() can undo the accounting.
+ * 8 bytes keeps the payload at the alignment malloc() gave us. */
+typedef struct {
+    uint32_t size;   /* payload size in bytes */
+    uint32_t cls;    /* size class the allocation was accounted in */
+} pool_hdr_t;
+
+/* Upper bounds of the size classes; the last one catches everything,
+ * 1600 covers full-MTU pbufs */
+static const size_t s_class_ceiling[ESP_LWIP_POOL_CLASS_NUM] = {
+    64, 128, 256, 512, 1600, SIZE_MAX
+};
+
+static size_t s_limits[ESP_LWIP_POOL_PROFILE_MAX] = {
+    CONFIG_LWIP_POOL_QUIESCENT_LIMIT_KB * 1024,
+    CONFIG_LWIP_POOL_BULK_LIMIT_KB * 1024,
+};
+static esp_lwip_pool_profile_t s_profile = ESP_LWIP_POOL_PROFILE_QUIESCENT;
+
+static esp_lwip_pool_class_stats_t s_class_stats[ESP_LWIP_POOL_CLASS_NUM];
+static size_t s_total_bytes;
+static size_t s_total_hwm;
+static portMUX_TYPE s_pool_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static uint32_t size_class(size_t size)
+{
+    uint32_t cls = 0;
+    while (size > s_class_ceiling[cls]) {
+        cls++;
+    }
+    return cls;
+}
+
+esp_err_t esp_lwip_pool_set_profile(esp_lwip_pool_profile_t profile)
+{
+    if (profile < 0 || profile >= ESP_LWIP_POOL_PROFILE_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&s_pool_mux);
+    s_profile = profile;
+    portEXIT_CRITICAL(&s_pool_mux);
+    return ESP_OK;
+}
+
+esp_lwip_pool_profile_t esp_lwip_pool_get_profile(void)
+{
+    return s_profile;
+}
+
+esp_err_t esp_lwip_pool_set_profile_limit(esp_lwip_pool_profile_t profile, size_t limit_bytes)
+{
+    if (profile < 0 || profile >= ESP_LWIP_POOL_PROFILE_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&s_pool_mux);
+    s_limits[profile] = limit_bytes;
+    portEXIT_CRITICAL(&s_pool_mux);
+    return ESP_OK;
+}
+
+size_t esp_lwip_pool_total_bytes(void)
+{
+    return s_total_bytes;
+}
+
+size_t esp_lwip_pool_hwm_bytes(void)
+{
+    return s_total_hwm;
+}
+
+esp_err_t esp_lwip_pool_get_class_stats(int class_idx, esp_lwip_pool_class_stats_t *stats, bool clear)
+{
+    if (class_idx < 0 || class_idx >= ESP_LWIP_POOL_CLASS_NUM || stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&s_pool_mux);
+    *stats = s_class_stats[class_idx];
+    if (clear) {
+        s_class_stats[class_idx].allocs = 0;
+        s_class_stats[class_idx].failures = 0;
+        s_class_stats[class_idx].hwm_bytes = s_class_stats[class_idx].cur_bytes;
+    }
+    portEXIT_CRITICAL(&s_pool_mux);
+    return ESP_OK;
+}
+
+size_t esp_lwip_pool_class_ceiling(int class_idx)
+{
+    if (class_idx < 0 || class_idx >= ESP_LWIP_POOL_CLASS_NUM) {
+        return 0;
+    }
+    return s_class_ceiling[class_idx];
+}
+
+void *esp_lwip_pool_malloc(size_t size)
+{
+    uint32_t cls = size_class(size);
+
+    /* Reserve the bytes against the budget first, so the heap allocation
+     * itself can run outside the critical section */
+    portENTER_CRITICAL(&s_pool_mux);
+    size_t limit = s_limits[s_profile];
+    if (limit != 0 && s_total_bytes + size > limit) {
+        s_class_stats[cls].failures++;
+        portEXIT_CRITICAL(&s_pool_mux);
+        return NULL;
+    }
+    s_total_bytes += size;
+    if (s_total_bytes > s_total_hwm) {
+        s_total_hwm = s_total_bytes;
+    }
+    s_class_stats[cls].cur_bytes += size;
+    if (s_class_stats[cls].cur_bytes > s_class_stats[cls].hwm_bytes) {
+        s_class_stats[cls].hwm_bytes = s_class_stats[cls].cur_bytes;
+    }
+    s_class_stats[cls].allocs++;
+    portEXIT_CRITICAL(&s_pool_mux);
+
+    pool_hdr_t *hdr = malloc(sizeof(pool_hdr_t) + size);
+    if (hdr == NULL) {
+        /* Heap refused: undo the reservation and count it as a failure */
+        portENTER_CRITICAL(&s_pool_mux);
+        s_total_bytes -= size;
+        s_class_stats[cls].cur_bytes -= size;
+        s_class_stats[cls].allocs--;
+        s_class_stats[cls].failures++;
+        portEXIT_CRITICAL(&s_pool_mux);
+        return NULL;
+    }
+    hdr->size = size;
+    hdr->cls = cls;
+    return hdr + 1;
+}
+
+void *esp_lwip_pool_calloc(size_t n, size_t size)
+{
+    size_t bytes = n * size;
+    void *mem = esp_lwip_pool_malloc(bytes);
+    if (mem != NULL) {
+        memset(mem, 0, bytes);
+    }
+    return mem;
+}
+
+void esp_lwip_pool_free(void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+    pool_hdr_t *hdr = (pool_hdr_t *)ptr - 1;
+    portENTER_CRITICAL(&s_pool_mux);
+    s_total_bytes -= hdr->size;
+    s_class_stats[hdr->cls].cur_bytes -= hdr->size;
+    portEXIT_CRITICAL(&s_pool_mux);
+    free(hdr);
+}
@@ -0,0 +1,157 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lwip/opt.h"
+#include "lwip/tcp.h"
+#include "lwip/ip_addr.h"
+#include "lwip/priv/tcp_priv.h"
+#include "esp_tcp_snapshot.h"
+#include "sdkconfig.h"
+
+#ifdef CONFIG_LWIP_TCP_SNAPSHOT
+
+/* TCP connection carry-over across deep sleep.
+
+   An established TCP connection is nothing but state on the two ends;
+   the network in between keeps none. As long as the local end can
+   reproduce its addresses, sequence numbers and window bookkeeping, the
+   peer cannot tell a deep-sleep cycle from a long idle period. These two
+   functions freeze that state into a struct small enough for RTC memory
+   and rebuild a PCB from it after wake, skipping the TCP (and, with the
+   esp-tls session retention, most of the TLS) re-establishment that
+   otherwise dominates a wake/report/sleep cycle.
+
+   Only quiescent connections are supported: in-flight segments and
+   queued data cannot survive the sleep because the heap they live on
+   does not. */
+
+#define TCP_SNAPSHOT_MAGIC 0x54435053  /* "TCPS" */
+
+/* Option flags that describe what was negotiated on the connection and
+   must be carried over; everything else in pcb->flags is transient. */
+static u16_t snapshot_flags_mask(void)
+{
+    u16_t mask = TF_NODELAY;
+#if LWIP_TCP_TIMESTAMPS
+    mask |= TF_TIMESTAMP;
+#endif
+#if LWIP_WND_SCALE
+    mask |= TF_WND_SCALE;
+#endif
+    return mask;
+}
+
+err_t esp_tcp_snapshot(struct tcp_pcb *pcb, esp_tcp_snapshot_t *snap)
+{
+    if (pcb == NULL || snap == NULL) {
+        return ERR_ARG;
+    }
+    if (pcb->state != ESTABLISHED) {
+        return ERR_CONN;
+    }
+#if LWIP_IPV6
+    if (IP_IS_V6_VAL(pcb->remote_ip)) {
+        /* an IPv6 address does not fit the RTC-sized snapshot */
+        return ERR_VAL;
+    }
+#endif
+    if (pcb->unsent != NULL || pcb->unacked != NULL || pcb->refused_data != NULL
+#if TCP_QUEUE_OOSEQ
+        || pcb->ooseq != NULL
+#endif
+       ) {
+        return ERR_INPROGRESS;
+    }
+
+    snap->local_ip = ip4_addr_get_u32(ip_2_ip4(&pcb->local_ip));
+    snap->remote_ip = ip4_addr_get_u32(ip_2_ip4(&pcb->remote_ip));
+    snap->local_port = pcb->local_port;
+    snap->remote_port = pcb->remote_port;
+    snap->snd_nxt = pcb->snd_nxt;
+    snap->snd_wl1 = pcb->snd_wl1;
+    snap->snd_wl2 = pcb->snd_wl2;
+    snap->lastack = pcb->lastack;
+    snap->snd_wnd = pcb->snd_wnd;
+    snap->snd_wnd_max = pcb->snd_wnd_max;
+    snap->rcv_nxt = pcb->rcv_nxt;
+    snap->rcv_wnd = pcb->rcv_wnd;
+    snap->rcv_ann_wnd = pcb->rcv_ann_wnd;
+    snap->rcv_ann_right_edge = pcb->rcv_ann_right_edge;
+    snap->mss = pcb->mss;
+    snap->flags = pcb->flags & snapshot_flags_mask();
+#if LWIP_WND_SCALE
+    snap->snd_scale = pcb->snd_scale;
+    snap->rcv_scale = pcb->rcv_scale;
+#else
+    snap->snd_scale = 0;
+    snap->rcv_scale = 0;
+#endif
+    snap->prio = pcb->prio;
+    snap->tos = pcb->tos;
+    snap->ttl = pcb->ttl;
+    snap->magic = TCP_SNAPSHOT_MAGIC;
+    return ERR_OK;
+}
+
+struct tcp_pcb *esp_tcp_restore(esp_tcp_snapshot_t *snap)
+{
+    if (snap == NULL || snap->magic != TCP_SNAPSHOT_MAGIC) {
+        return NULL;
+    }
+
+    struct tcp_pcb *pcb = tcp_alloc(snap->prio);
+    if (pcb == NULL) {
+        return NULL;
+    }
+
+    ip_addr_set_ip4_u32(&pcb->local_ip, snap->local_ip);
+    ip_addr_set_ip4_u32(&pcb->remote_ip, snap->remote_ip);
+    pcb->local_port = snap->local_port;
+    pcb->remote_port = snap->remote_port;
+    pcb->tos = snap->tos;
+    pcb->ttl = snap->ttl;
+    pcb->mss = snap->mss;
+
+    pcb->snd_nxt = snap->snd_nxt;
+    pcb->snd_lbb = snap->snd_nxt;
+    pcb->snd_wl1 = snap->snd_wl1;
+    pcb->snd_wl2 = snap->snd_wl2;
+    pcb->lastack = snap->lastack;
+    pcb->snd_wnd = snap->snd_wnd;
+    pcb->snd_wnd_max = snap->snd_wnd_max;
+    pcb->rcv_nxt = snap->rcv_nxt;
+    pcb->rcv_wnd = snap->rcv_wnd;
+    pcb->rcv_ann_wnd = snap->rcv_ann_wnd;
+    pcb->rcv_ann_right_edge = snap->rcv_ann_right_edge;
+#if LWIP_WND_SCALE
+    pcb->snd_scale = snap->snd_scale;
+    pcb->rcv_scale = snap->rcv_scale;
+#endif
+    pcb->flags |= snap->flags & snapshot_flags_mask();
+
+    /* Congestion state is not carried over: the path may have changed
+       while the device slept, so restart from slow start. */
+    pcb->cwnd = pcb->mss;
+    pcb->ssthresh = TCP_WND;
+
+    pcb->state = ESTABLISHED;
+    TCP_REG_ACTIVE(pcb);
+
+    /* One-shot: a second restore of the same sequence state would put
+       two PCBs on the same connection. */
+    snap->magic = 0;
+    return pcb;
+}
+
+#endif /* CONFIG_LWIP_TCP_SNAPSHOT */
@@ -0,0 +1,183 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include "lwip/opt.h"
+#include "lwip/tcp.h"
+#include "lwip/ip_addr.h"
+#include "lwip/prot/tcp.h"
+#include "lwip/priv/tcp_priv.h"
+#include "esp_tcp_stats.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+#ifdef CONFIG_LWIP_PER_SOCKET_TCP_STATS
+
+#if LWIP_SOCKET
+#include "lwip/priv/sockets_priv.h"
+#include "lwip/api.h"
+#endif
+
+/* Per-connection traffic accounting.
+
+   LWIP_STATS only keeps protocol-wide aggregates, so on a device running
+   a dozen sockets there is no way to tell which one is loading the link.
+   The per-PCB packet hooks (LWIP_HOOK_TCP_INPACKET_PCB and
+   LWIP_HOOK_TCP_OUT_ADD_TCPOPTS, wired up in lwipopts.h) run once per
+   segment with the owning PCB in hand; counting there costs a table
+   lookup and a few increments per segment. State lives in a small side
+   table keyed by PCB pointer since struct tcp_pcb itself is upstream
+   lwIP. Slots of closed connections are reclaimed lazily when the table
+   is full and a new connection needs one. */
+
+static const char *TAG = "tcp_stats";
+
+typedef struct {
+    struct tcp_pcb *pcb;        /* NULL if the slot is free */
+    esp_tcp_stats_t stats;
+} tcp_stats_ctx_t;
+
+static tcp_stats_ctx_t s_stats_ctx[CONFIG_LWIP_PER_SOCKET_TCP_STATS_MAX_PCBS];
+
+static bool tcp_stats_pcb_live(struct tcp_pcb *pcb)
+{
+    for (struct tcp_pcb *it = tcp_active_pcbs; it != NULL; it = it->next) {
+        if (it == pcb) {
+            return true;
+        }
+    }
+    for (struct tcp_pcb *it = tcp_tw_pcbs; it != NULL; it = it->next) {
+        if (it == pcb) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Runs in the TCP/IP thread (hook context), so walking the PCB lists to
+   reclaim slots of closed connections is safe */
+static tcp_stats_ctx_t *tcp_stats_get_ctx(struct tcp_pcb *pcb)
+{
+    tcp_stats_ctx_t *free_slot = NULL;
+    for (int i = 0; i < CONFIG_LWIP_PER_SOCKET_TCP_STATS_MAX_PCBS; i++) {
+        if (s_stats_ctx[i].pcb == pcb) {
+            return &s_stats_ctx[i];
+        }
+        if (free_slot == NULL && s_stats_ctx[i].pcb == NULL) {
+            free_slot = &s_stats_ctx[i];
+        }
+    }
+    if (free_slot == NULL) {
+        for (int i = 0; i < CONFIG_LWIP_PER_SOCKET_TCP_STATS_MAX_PCBS; i++) {
+            if (!tcp_stats_pcb_live(s_stats_ctx[i].pcb)) {
+                free_slot = &s_stats_ctx[i];
+                break;
+            }
+        }
+    }
+    if (free_slot == NULL) {
+        /* Table full of live connections: this one goes uncounted */
+        return NULL;
+    }
+    memset(free_slot, 0, sizeof(*free_slot));
+    free_slot->pcb = pcb;
+    if (!IP_IS_V6_VAL(pcb->remote_ip)) {
+        free_slot->stats.remote_ip = ip4_addr_get_u32(ip_2_ip4(&pcb->remote_ip));
+    }
+    free_slot->stats.remote_port = pcb->remote_port;
+    free_slot->stats.local_port = pcb->local_port;
+    return free_slot;
+}
+
+err_t lwip_hook_tcp_stats_input(struct tcp_pcb *pcb, struct tcp_hdr *hdr, struct pbuf *p)
+{
+    LWIP_UNUSED_ARG(hdr);
+    tcp_stats_ctx_t *ctx = tcp_stats_get_ctx(pcb);
+    if (ctx != NULL) {
+        ctx->stats.segs_in++;
+        /* the TCP header has already been hidden, tot_len is payload */
+        ctx->stats.bytes_in += p->tot_len;
+    }
+    return ERR_OK;
+}
+
+u32_t *lwip_hook_tcp_stats_output(struct pbuf *p, struct tcp_hdr *hdr, struct tcp_pcb *pcb, u32_t *opts)
+{
+    tcp_stats_ctx_t *ctx = tcp_stats_get_ctx(pcb);
+    if (ctx != NULL) {
+        u16_t hdrlen = TCPH_HDRLEN_BYTES(hdr);
+        u16_t payload = (p->tot_len > hdrlen) ? (p->tot_len - hdrlen) : 0;
+        ctx->stats.segs_out++;
+        ctx->stats.bytes_out += payload;
+        if (payload > 0 && TCP_SEQ_LT(lwip_ntohl(hdr->seqno), pcb->snd_nxt)) {
+            /* data below snd_nxt has been on the wire before; empty
+               probes and pure ACKs are deliberately not counted */
+            ctx->stats.retransmits++;
+        }
+    }
+    return opts;
+}
+
+err_t esp_tcp_stats_pcb_get(struct tcp_pcb *pcb, esp_tcp_stats_t *out)
+{
+    if (pcb == NULL || out == NULL) {
+        return ERR_ARG;
+    }
+    for (int i = 0; i < CONFIG_LWIP_PER_SOCKET_TCP_STATS_MAX_PCBS; i++) {
+        if (s_stats_ctx[i].pcb == pcb) {
+            *out = s_stats_ctx[i].stats;
+            /* rtt/rto come from the live PCB: sa is the scaled smoothed
+               estimator, rto counts slow-timer ticks of 500 ms */
+            out->rtt_ms = (pcb->sa > 0) ? (pcb->sa >> 3) * (TCP_SLOW_INTERVAL) : 0;
+            out->rto_ms = pcb->rto * (TCP_SLOW_INTERVAL);
+            return ERR_OK;
+        }
+    }
+    return ERR_ARG;
+}
+
+#if LWIP_SOCKET
+err_t esp_tcp_stats_sock_get(int fd, esp_tcp_stats_t *out)
+{
+    struct lwip_sock *sock = lwip_socket_dbg_get_socket(fd);
+    if (sock == NULL || sock->conn == NULL ||
+            NETCONNTYPE_GROUP(netconn_type(sock->conn)) != NETCONN_TCP ||
+            sock->conn->pcb.tcp == NULL) {
+        return ERR_ARG;
+    }
+    return esp_tcp_stats_pcb_get(sock->conn->pcb.tcp, out);
+}
+#endif /* LWIP_SOCKET */
+
+void esp_tcp_stats_dump(void)
+{
+    for (int i = 0; i < CONFIG_LWIP_PER_SOCKET_TCP_STATS_MAX_PCBS; i++) {
+        if (s_stats_ctx[i].pcb == NULL) {
+            continue;
+        }
+        esp_tcp_stats_t st;
+        if (esp_tcp_stats_pcb_get(s_stats_ctx[i].pcb, &st) != ERR_OK) {
+            continue;
+        }
+        ESP_LOGI(TAG, "%u.%u.%u.%u:%u <- :%u%s in %u B/%u seg, out %u B/%u seg, rtx %u, rtt %u ms, rto %u ms",
+                 (unsigned)(st.remote_ip & 0xff), (unsigned)((st.remote_ip >> 8) & 0xff),
+                 (unsigned)((st.remote_ip >> 16) & 0xff), (unsigned)((st.remote_ip >> 24) & 0xff),
+                 st.remote_port, st.local_port,
+                 tcp_stats_pcb_live(s_stats_ctx[i].pcb) ? "" : " (closed)",
+                 st.bytes_in, st.segs_in, st.bytes_out, st.segs_out,
+                 st.retransmits, st.rtt_ms, st.rto_ms);
+    }
+}
+
+#endif /* CONFIG_LWIP_PER_SOCKET_TCP_STATS */
@@ -0,0 +1,71 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lwip/opt.h"
+#include "lwip/tcp.h"
+#include "lwip/priv/tcp_priv.h"
+#include "esp_tcp_tune.h"
+#include "sdkconfig.h"
+
+#ifdef CONFIG_LWIP_PER_SOCKET_TCP_WND
+
+/* Per-connection window and send buffer tuning.
+
+   The compile-time TCP_WND / TCP_SND_BUF values size every PCB alike.
+   A typical device runs one bulk-transfer connection next to a handful
+   of tiny control connections, so sizing for the bulk case wastes tens
+   of kilobytes on the others. These setters re-size an individual PCB
+   before traffic starts; together with ESP_PER_SOC_TCP_WND the stack
+   then keeps replenishing the window to the per-PCB value rather than
+   the global default. */
+
+err_t esp_tcp_set_rcv_wnd(struct tcp_pcb *pcb, u32_t wnd)
+{
+    if (pcb == NULL) {
+        return ERR_ARG;
+    }
+    u32_t mss = pcb->mss ? pcb->mss : TCP_MSS;
+    if (wnd < mss) {
+        wnd = mss;
+    }
+#if ESP_PER_SOC_TCP_WND
+    pcb->per_soc_tcp_wnd = wnd;
+#endif
+    pcb->rcv_wnd = wnd;
+    pcb->rcv_ann_wnd = wnd;
+    return ERR_OK;
+}
+
+err_t esp_tcp_set_snd_buf(struct tcp_pcb *pcb, u32_t snd_buf)
+{
+    if (pcb == NULL) {
+        return ERR_ARG;
+    }
+    if (pcb->unsent != NULL || pcb->unacked != NULL) {
+        /* snd_buf is a running "free space" counter; re-basing it with
+           segments queued would corrupt the accounting */
+        return ERR_INPROGRESS;
+    }
+    u32_t mss = pcb->mss ? pcb->mss : TCP_MSS;
+    if (snd_buf < mss) {
+        snd_buf = mss;
+    }
+#if ESP_PER_SOC_TCP_WND
+    pcb->per_soc_tcp_snd_buf = snd_buf;
+#endif
+    pcb->snd_buf = snd_buf;
+    return ERR_OK;
+}
+
+#endif /* CONFIG_LWIP_PER_SOCKET_TCP_WND */
@@ -0,0 +1,151 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lwip/opt.h"
+#include "lwip/mem.h"
+#include "lwip/tcp.h"
+#include "esp_tcp_zero_copy.h"
+#include "sdkconfig.h"
+
+#ifdef CONFIG_LWIP_TCP_ZERO_COPY_SEND
+
+/* Zero-copy TCP send support.
+
+   tcp_write() called without TCP_WRITE_FLAG_COPY queues reference pbufs
+   pointing straight at the caller's buffer, which is exactly what we want
+   for large stable buffers — but the caller then has no way to learn when
+   the buffer can be reused. This file adds that missing half: per-PCB
+   byte accounting driven from the tcp_sent() callback, firing a user
+   completion callback once everything queued by one esp_tcp_zc_write()
+   call has been acknowledged. The application's own tcp_sent() callback
+   is preserved and chained. */
+
+typedef struct tcp_zc_record {
+    struct tcp_zc_record *next;
+    u32_t remaining;            /* unacknowledged bytes of this write */
+    esp_tcp_zc_done_cb_t cb;
+    void *arg;
+} tcp_zc_record_t;
+
+typedef struct {
+    struct tcp_pcb *pcb;        /* NULL if the slot is free */
+    tcp_zc_record_t *head;      /* oldest pending write */
+    tcp_zc_record_t *tail;
+    tcp_sent_fn prev_sent;      /* application's tcp_sent callback, chained */
+} tcp_zc_ctx_t;
+
+static tcp_zc_ctx_t s_zc_ctx[CONFIG_LWIP_TCP_ZERO_COPY_MAX_PCBS];
+
+static tcp_zc_ctx_t *tcp_zc_find(struct tcp_pcb *pcb)
+{
+    for (int i = 0; i < CONFIG_LWIP_TCP_ZERO_COPY_MAX_PCBS; i++) {
+        if (s_zc_ctx[i].pcb == pcb) {
+            return &s_zc_ctx[i];
+        }
+    }
+    return NULL;
+}
+
+static err_t tcp_zc_sent(void *arg, struct tcp_pcb *pcb, u16_t len)
+{
+    tcp_zc_ctx_t *ctx = tcp_zc_find(pcb);
+    if (ctx != NULL) {
+        u32_t acked = len;
+        while (acked > 0 && ctx->head != NULL) {
+            tcp_zc_record_t *rec = ctx->head;
+            if (rec->remaining > acked) {
+                rec->remaining -= acked;
+                acked = 0;
+            } else {
+                acked -= rec->remaining;
+                ctx->head = rec->next;
+                if (ctx->head == NULL) {
+                    ctx->tail = NULL;
+                }
+                if (rec->cb != NULL) {
+                    rec->cb(rec->arg, ERR_OK);
+                }
+                mem_free(rec);
+            }
+        }
+        if (ctx->prev_sent != NULL) {
+            return ctx->prev_sent(arg, pcb, len);
+        }
+    }
+    return ERR_OK;
+}
+
+err_t esp_tcp_zc_write(struct tcp_pcb *pcb, const void *data, u16_t len,
+                       esp_tcp_zc_done_cb_t cb, void *arg)
+{
+    if (pcb == NULL || data == NULL || len == 0) {
+        return ERR_ARG;
+    }
+    tcp_zc_ctx_t *ctx = tcp_zc_find(pcb);
+    if (ctx == NULL) {
+        ctx = tcp_zc_find(NULL);
+        if (ctx == NULL) {
+            return ERR_MEM;     /* all tracking slots in use */
+        }
+        ctx->pcb = pcb;
+        ctx->head = NULL;
+        ctx->tail = NULL;
+        ctx->prev_sent = pcb->sent;
+        tcp_sent(pcb, tcp_zc_sent);
+    }
+
+    tcp_zc_record_t *rec = (tcp_zc_record_t *)mem_malloc(sizeof(tcp_zc_record_t));
+    if (rec == NULL) {
+        return ERR_MEM;
+    }
+    /* no TCP_WRITE_FLAG_COPY: segments reference the caller's buffer */
+    err_t err = tcp_write(pcb, data, len, 0);
+    if (err != ERR_OK) {
+        mem_free(rec);
+        return err;
+    }
+    rec->next = NULL;
+    rec->remaining = len;
+    rec->cb = cb;
+    rec->arg = arg;
+    if (ctx->tail != NULL) {
+        ctx->tail->next = rec;
+    } else {
+        ctx->head = rec;
+    }
+    ctx->tail = rec;
+    return ERR_OK;
+}
+
+void esp_tcp_zc_detach(struct tcp_pcb *pcb, err_t err)
+{
+    tcp_zc_ctx_t *ctx = tcp_zc_find(pcb);
+    if (ctx == NULL) {
+        return;
+    }
+    while (ctx->head != NULL) {
+        tcp_zc_record_t *rec = ctx->head;
+        ctx->head = rec->next;
+        if (rec->cb != NULL) {
+            rec->cb(rec->arg, err);
+        }
+        mem_free(rec);
+    }
+    tcp_sent(pcb, ctx->prev_sent);
+    ctx->pcb = NULL;
+    ctx->tail = NULL;
+    ctx->prev_sent = NULL;
+}
+
+#endif /* CONFIG_LWIP_TCP_ZERO_COPY_SEND */
@@ -63,6 +63,23 @@ typedef esp_gcm_context mbedtls_gcm_context;
 
 #endif // CONFIG_IDF_TARGET_ESP32S2
 
+#if CONFIG_IDF_TARGET_ESP32
+#include "esp32/gcm.h"
+
+
+typedef esp_gcm_context mbedtls_gcm_context;
+
+#define mbedtls_gcm_init            esp_aes_gcm_init
+#define mbedtls_gcm_free            esp_aes_gcm_free
+#define mbedtls_gcm_setkey          esp_aes_gcm_setkey
+#define mbedtls_gcm_starts          esp_aes_gcm_starts
+#define mbedtls_gcm_update          esp_aes_gcm_update
+#define mbedtls_gcm_finish          esp_aes_gcm_finish
+#define mbedtls_gcm_auth_decrypt    esp_aes_gcm_auth_decrypt
+#define mbedtls_gcm_crypt_and_tag   esp_aes_gcm_crypt_and_tag
+
+#endif // CONFIG_IDF_TARGET_ESP32
+
 #endif /* MBEDTLS_GCM_ALT */
 
 #ifdef __cplusplus
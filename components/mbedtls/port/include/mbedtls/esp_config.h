@@ -1116,7 +1116,7 @@
  *
  * Comment this macro to disable support for SSL session tickets
  */
-#ifdef CONFIG_MBEDTLS_CLIENT_SSL_SESSION_TICKETS
+#if defined(CONFIG_MBEDTLS_CLIENT_SSL_SESSION_TICKETS) || defined(CONFIG_MBEDTLS_SERVER_SSL_SESSION_TICKETS)
 #define MBEDTLS_SSL_SESSION_TICKETS
 #else
 #undef MBEDTLS_SSL_SESSION_TICKETS
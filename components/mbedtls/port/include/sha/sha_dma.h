@@ -56,6 +56,37 @@ extern "C" {
  */
 void esp_sha(esp_sha_type sha_type, const unsigned char *input, size_t ilen, unsigned char *output);
 
+#ifndef ESP_SHA_IOVEC_DEFINED
+#define ESP_SHA_IOVEC_DEFINED
+/** @brief One fragment of input data for esp_sha_iov() */
+typedef struct {
+    const void *base;   /*!< Pointer to the fragment data */
+    size_t len;         /*!< Length of the fragment in bytes */
+} esp_sha_iovec_t;
+#endif
+
+/** @brief Calculate SHA1 or SHA2 sum of data given as a list of fragments
+ *
+ * Equivalent to calling esp_sha() on the concatenation of the fragments,
+ * without having to copy them into one contiguous buffer first. DMA feeds
+ * the engine block-sized chunks, with fragment tails carried over into the
+ * following fragment.
+ *
+ * @note It is not necessary to lock any SHA hardware before calling
+ * this function, thread safety is managed internally.
+ *
+ * @param sha_type SHA algorithm to use.
+ *
+ * @param iov Array of input fragments, hashed in array order.
+ *
+ * @param iov_cnt Number of entries in the iov array.
+ *
+ * @param output Buffer for output SHA digest. Output is 20 bytes for
+ * sha_type SHA1, 32 bytes for sha_type SHA2_256, 48 bytes for
+ * sha_type SHA2_384, 64 bytes for sha_type SHA2_512.
+ */
+void esp_sha_iov(esp_sha_type sha_type, const esp_sha_iovec_t *iov, size_t iov_cnt, unsigned char *output);
+
 /** @brief Execute SHA block operation using DMA
  *
  * @note This is a piece of a SHA algorithm, rather than an entire SHA
@@ -103,3 +103,88 @@ void esp_sha(esp_sha_type sha_type, const unsigned char *input, size_t ilen, uns
     ESP_LOGE(TAG, "SHA type %d not supported", sha_type);
     abort();
 }
+
+void esp_sha_iov(esp_sha_type sha_type, const esp_sha_iovec_t *iov, size_t iov_cnt, unsigned char *output)
+{
+    union {
+#if SOC_SHA_SUPPORT_SHA1
+        mbedtls_sha1_context sha1;
+#endif
+#if SOC_SHA_SUPPORT_SHA256
+        mbedtls_sha256_context sha256;
+#endif
+#if SOC_SHA_SUPPORT_SHA384 || SOC_SHA_SUPPORT_SHA512
+        mbedtls_sha512_context sha512;
+#endif
+    } ctx;
+
+    int ret;
+    size_t i;
+    assert(iov != NULL && output != NULL);
+
+    /* The mbedtls contexts used here hold the hardware engine (or DMA lock)
+       from the first processed block until the digest is read out in finish,
+       so all fragments are hashed under a single engine acquisition. */
+#if SOC_SHA_SUPPORT_SHA1
+    if (sha_type == SHA1) {
+        mbedtls_sha1_init(&ctx.sha1);
+        mbedtls_sha1_starts_ret(&ctx.sha1);
+        for (i = 0; i < iov_cnt; i++) {
+            ret = mbedtls_sha1_update_ret(&ctx.sha1, iov[i].base, iov[i].len);
+            assert(ret == 0);
+        }
+        ret = mbedtls_sha1_finish_ret(&ctx.sha1, output);
+        assert(ret == 0);
+        mbedtls_sha1_free(&ctx.sha1);
+        return;
+    }
+#endif //SOC_SHA_SUPPORT_SHA1
+
+#if SOC_SHA_SUPPORT_SHA256
+    if (sha_type == SHA2_256) {
+        mbedtls_sha256_init(&ctx.sha256);
+        mbedtls_sha256_starts_ret(&ctx.sha256, 0);
+        for (i = 0; i < iov_cnt; i++) {
+            ret = mbedtls_sha256_update_ret(&ctx.sha256, iov[i].base, iov[i].len);
+            assert(ret == 0);
+        }
+        ret = mbedtls_sha256_finish_ret(&ctx.sha256, output);
+        assert(ret == 0);
+        mbedtls_sha256_free(&ctx.sha256);
+        return;
+    }
+#endif //SOC_SHA_SUPPORT_SHA256
+
+#if SOC_SHA_SUPPORT_SHA384
+    if (sha_type == SHA2_384) {
+        mbedtls_sha512_init(&ctx.sha512);
+        mbedtls_sha512_starts_ret(&ctx.sha512, 1);
+        for (i = 0; i < iov_cnt; i++) {
+            ret = mbedtls_sha512_update_ret(&ctx.sha512, iov[i].base, iov[i].len);
+            assert(ret == 0);
+        }
+        ret = mbedtls_sha512_finish_ret(&ctx.sha512, output);
+        assert(ret == 0);
+        mbedtls_sha512_free(&ctx.sha512);
+        return;
+    }
+#endif //SOC_SHA_SUPPORT_SHA384
+
+#if SOC_SHA_SUPPORT_SHA512
+    if (sha_type == SHA2_512) {
+        mbedtls_sha512_init(&ctx.sha512);
+        mbedtls_sha512_starts_ret(&ctx.sha512, 0);
+        for (i = 0; i < iov_cnt; i++) {
+            ret = mbedtls_sha512_update_ret(&ctx.sha512, iov[i].base, iov[i].len);
+            assert(ret == 0);
+        }
+        ret = mbedtls_sha512_finish_ret(&ctx.sha512, output);
+        assert(ret == 0);
+        mbedtls_sha512_free(&ctx.sha512);
+        return;
+    }
+#endif //SOC_SHA_SUPPORT_SHA512
+
+    ESP_LOGE(TAG, "SHA type %d not supported", sha_type);
+    abort();
+}
@@ -364,6 +364,32 @@ esp_err_t mdns_query_aaaa(const char * host_name, uint32_t timeout, esp_ip6_addr
  */
 esp_err_t mdns_handle_system_event(void *ctx, system_event_t *event) __attribute__((deprecated));
 
+/**
+ * @brief   Compiled answer cache counters
+ */
+typedef struct {
+    uint32_t hits;          /*!< queries answered by replaying a compiled packet */
+    uint32_t misses;        /*!< queries that required building a response */
+    uint32_t suppressed;    /*!< queries dropped by the per-answer rate limit */
+} mdns_answer_cache_stats_t;
+
+/**
+ * @brief   Read the compiled answer cache counters
+ *
+ *          The responder keeps responses to recurring multicast queries in
+ *          serialized form (see MDNS_ANSWER_CACHE_ENTRIES) and rate limits
+ *          identical answers to one per second; these counters show how much
+ *          of the query load is served that way.
+ *
+ * @param  stats        filled with the current counter values
+ *
+ * @return
+ *     - ESP_OK success
+ *     - ESP_ERR_INVALID_ARG    stats is NULL
+ *     - ESP_ERR_NOT_SUPPORTED  the cache is disabled (0 entries configured)
+ */
+esp_err_t mdns_answer_cache_get_stats(mdns_answer_cache_stats_t * stats);
+
 #ifdef __cplusplus
 }
 #endif
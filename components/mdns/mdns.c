@@ -966,13 +966,15 @@ static uint8_t _mdns_append_answer(uint8_t * packet, uint16_t * index, mdns_out_
 }
 
 /**
- * @brief  sends a packet
+ * @brief  serializes a packet into wire format
  *
  * @param  p       the packet
+ * @param  packet  output buffer, at least MDNS_MAX_PACKET_SIZE bytes
+ *
+ * @return length of the serialized packet
  */
-static void _mdns_dispatch_tx_packet(mdns_tx_packet_t * p)
+static uint16_t _mdns_serialize_tx_packet(mdns_tx_packet_t * p, uint8_t * packet)
 {
-    static uint8_t packet[MDNS_MAX_PACKET_SIZE];
     uint16_t index = MDNS_HEAD_LEN;
     memset(packet, 0, MDNS_HEAD_LEN);
     mdns_out_question_t * q;
@@ -1016,6 +1018,19 @@ static void _mdns_dispatch_tx_packet(mdns_tx_packet_t * p)
     }
     _mdns_set_u16(packet, MDNS_HEAD_ADDITIONAL_OFFSET, count);
 
+    return index;
+}
+
+/**
+ * @brief  sends a packet
+ *
+ * @param  p       the packet
+ */
+static void _mdns_dispatch_tx_packet(mdns_tx_packet_t * p)
+{
+    static uint8_t packet[MDNS_MAX_PACKET_SIZE];
+    uint16_t index = _mdns_serialize_tx_packet(p, packet);
+
 #ifdef MDNS_ENABLE_DEBUG
     _mdns_dbg_printf("\nTX[%u][%u]: ", p->tcpip_if, p->ip_protocol);
     if (p->dst.type == IPADDR_TYPE_V4) {
@@ -1243,6 +1258,206 @@ static mdns_tx_packet_t * _mdns_alloc_packet_default(mdns_if_t tcpip_if, mdns_ip
     return packet;
 }
 
+#if CONFIG_MDNS_ANSWER_CACHE_ENTRIES > 0
+/**
+ * @brief  Compiled answer cache
+ *
+ * Responses to recurring queries are kept in serialized wire format and
+ * replayed with only the transaction id patched, so a discovery storm is
+ * served without building answer lists or re-serializing the records.
+ * Entries for shared (delay-scheduled) answers carry no packet data and
+ * only enforce the per-answer rate limit. Bumping the version - done on
+ * every announcement and bye, i.e. whenever any advertised record can
+ * have changed - invalidates all entries at once.
+ */
+#define MDNS_ANSWER_RATE_LIMIT_MS   1000
+
+typedef struct {
+    uint32_t signature;             // hash of the question set
+    uint32_t version;               // cache version the entry was compiled for
+    mdns_if_t tcpip_if;
+    mdns_ip_protocol_t ip_protocol;
+    uint16_t len;
+    uint32_t last_sent;             // ms timestamp of the last multicast of this answer
+    uint8_t * data;                 // serialized packet, NULL for rate-limit-only entries
+} mdns_answer_cache_entry_t;
+
+static mdns_answer_cache_entry_t s_answer_cache[CONFIG_MDNS_ANSWER_CACHE_ENTRIES];
+static uint32_t s_answer_cache_version = 1;
+static mdns_answer_cache_stats_t s_answer_cache_stats;
+
+static void _mdns_answer_cache_invalidate(void)
+{
+    s_answer_cache_version++;
+}
+
+static uint32_t _mdns_answer_cache_hash_str(uint32_t hash, const char * str)
+{
+    if (!str) {
+        return hash ^ 0xff;
+    }
+    while (*str) {
+        hash = (hash ^ (uint8_t)*str++) * 16777619;
+    }
+    return hash;
+}
+
+static uint32_t _mdns_answer_cache_signature(mdns_parsed_packet_t * parsed_packet)
+{
+    uint32_t hash = 2166136261U;
+    mdns_parsed_question_t * q = parsed_packet->questions;
+    while (q) {
+        hash = (hash ^ q->type) * 16777619;
+        hash = _mdns_answer_cache_hash_str(hash, q->host);
+        hash = _mdns_answer_cache_hash_str(hash, q->service);
+        hash = _mdns_answer_cache_hash_str(hash, q->proto);
+        hash = _mdns_answer_cache_hash_str(hash, q->domain);
+        q = q->next;
+    }
+    return hash;
+}
+
+/**
+ * @brief  Check that the answer to a parsed packet is a plain multicast
+ *         response, the only kind the cache holds
+ */
+static bool _mdns_answer_cache_usable(mdns_parsed_packet_t * parsed_packet)
+{
+    if (parsed_packet->src_port != MDNS_SERVICE_PORT || parsed_packet->probe
+            || parsed_packet->discovery || parsed_packet->distributed) {
+        return false;
+    }
+    mdns_parsed_question_t * q = parsed_packet->questions;
+    while (q) {
+        if (q->unicast) {
+            return false;
+        }
+        q = q->next;
+    }
+    return true;
+}
+
+static mdns_answer_cache_entry_t * _mdns_answer_cache_find(uint32_t signature, mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol)
+{
+    size_t i;
+    for (i = 0; i < CONFIG_MDNS_ANSWER_CACHE_ENTRIES; i++) {
+        mdns_answer_cache_entry_t * e = &s_answer_cache[i];
+        if (e->version == s_answer_cache_version && e->signature == signature
+                && e->tcpip_if == tcpip_if && e->ip_protocol == ip_protocol) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief  Try to answer a parsed packet from the cache
+ *
+ * @return true if the query was handled (answer replayed, or dropped by
+ *         the rate limit), false if a response must be built
+ */
+static bool _mdns_answer_cache_try_answer(mdns_parsed_packet_t * parsed_packet)
+{
+    if (!_mdns_answer_cache_usable(parsed_packet)) {
+        return false;
+    }
+    uint32_t signature = _mdns_answer_cache_signature(parsed_packet);
+    mdns_answer_cache_entry_t * entry = _mdns_answer_cache_find(signature, parsed_packet->tcpip_if, parsed_packet->ip_protocol);
+    if (!entry) {
+        s_answer_cache_stats.misses++;
+        return false;
+    }
+    uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    if (now - entry->last_sent < MDNS_ANSWER_RATE_LIMIT_MS) {
+        s_answer_cache_stats.suppressed++;
+        return true;
+    }
+    if (!entry->data) {
+        // shared answer: only the rate limit is cached, build the response
+        s_answer_cache_stats.misses++;
+        return false;
+    }
+    _mdns_set_u16(entry->data, MDNS_HEAD_ID_OFFSET, parsed_packet->id);
+    esp_ip_addr_t dst;
+    if (parsed_packet->ip_protocol == MDNS_IP_PROTOCOL_V4) {
+        IP_ADDR4(&dst, 224, 0, 0, 251);
+    } else {
+        esp_ip_addr_t addr = IPADDR6_INIT(0x000002ff, 0, 0, 0xfb000000);
+        memcpy(&dst, &addr, sizeof(esp_ip_addr_t));
+    }
+    _mdns_udp_pcb_write(parsed_packet->tcpip_if, parsed_packet->ip_protocol, &dst, MDNS_SERVICE_PORT, entry->data, entry->len);
+    entry->last_sent = now;
+    s_answer_cache_stats.hits++;
+    return true;
+}
+
+/**
+ * @brief  Compile the response to a parsed packet into the cache
+ *
+ * @param  parsed_packet  the query being answered
+ * @param  packet         the built response
+ * @param  shared         true when the response is delay-scheduled; only
+ *                        the rate limit is stored for those
+ */
+static void _mdns_answer_cache_store(mdns_parsed_packet_t * parsed_packet, mdns_tx_packet_t * packet, bool shared)
+{
+    static uint8_t scratch[MDNS_MAX_PACKET_SIZE];
+    size_t i;
+    if (!_mdns_answer_cache_usable(parsed_packet)) {
+        return;
+    }
+    uint32_t signature = _mdns_answer_cache_signature(parsed_packet);
+    mdns_answer_cache_entry_t * entry = _mdns_answer_cache_find(signature, parsed_packet->tcpip_if, parsed_packet->ip_protocol);
+    if (!entry) {
+        // prefer a stale slot, else evict the least recently replayed one
+        entry = &s_answer_cache[0];
+        for (i = 0; i < CONFIG_MDNS_ANSWER_CACHE_ENTRIES; i++) {
+            if (s_answer_cache[i].version != s_answer_cache_version) {
+                entry = &s_answer_cache[i];
+                break;
+            }
+            if (s_answer_cache[i].last_sent < entry->last_sent) {
+                entry = &s_answer_cache[i];
+            }
+        }
+        free(entry->data);
+        entry->data = NULL;
+        entry->len = 0;
+        entry->signature = signature;
+        entry->tcpip_if = parsed_packet->tcpip_if;
+        entry->ip_protocol = parsed_packet->ip_protocol;
+        entry->version = s_answer_cache_version;
+    }
+    entry->last_sent = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    if (shared) {
+        return;
+    }
+    if (!entry->data) {
+        uint16_t len = _mdns_serialize_tx_packet(packet, scratch);
+        uint8_t * data = (uint8_t *)malloc(len);
+        if (!data) {
+            HOOK_MALLOC_FAILED;
+            entry->version = 0;
+            return;
+        }
+        memcpy(data, scratch, len);
+        entry->data = data;
+        entry->len = len;
+    }
+}
+
+static void _mdns_answer_cache_free(void)
+{
+    size_t i;
+    for (i = 0; i < CONFIG_MDNS_ANSWER_CACHE_ENTRIES; i++) {
+        free(s_answer_cache[i].data);
+        s_answer_cache[i].data = NULL;
+        s_answer_cache[i].version = 0;
+    }
+    _mdns_answer_cache_invalidate();
+}
+#endif // CONFIG_MDNS_ANSWER_CACHE_ENTRIES > 0
+
 /**
  * @brief  Create answer packet to questions from parsed packet
  */
@@ -1251,6 +1466,11 @@ static void _mdns_create_answer_from_parsed_packet(mdns_parsed_packet_t * parsed
     if (!parsed_packet->questions) {
         return;
     }
+#if CONFIG_MDNS_ANSWER_CACHE_ENTRIES > 0
+    if (_mdns_answer_cache_try_answer(parsed_packet)) {
+        return;
+    }
+#endif
     bool send_flush = parsed_packet->src_port == MDNS_SERVICE_PORT;
     bool unicast = false;
     bool shared = false;
@@ -1337,6 +1557,9 @@ static void _mdns_create_answer_from_parsed_packet(mdns_parsed_packet_t * parsed
     }
 
     static uint8_t share_step = 0;
+#if CONFIG_MDNS_ANSWER_CACHE_ENTRIES > 0
+    _mdns_answer_cache_store(parsed_packet, packet, shared);
+#endif
     if (shared) {
         _mdns_schedule_tx_packet(packet, 25 + (share_step * 25));
         share_step = (share_step + 1) & 0x03;
@@ -1510,6 +1733,9 @@ static mdns_tx_packet_t * _mdns_create_announce_from_probe(mdns_tx_packet_t * pr
  */
 static void _mdns_pcb_send_bye(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol, mdns_srv_item_t ** services, size_t len, bool include_ip)
 {
+#if CONFIG_MDNS_ANSWER_CACHE_ENTRIES > 0
+    _mdns_answer_cache_invalidate();
+#endif
     mdns_tx_packet_t * packet = _mdns_alloc_packet_default(tcpip_if, ip_protocol);
     if (!packet) {
         return;
@@ -1671,6 +1897,10 @@ static void _mdns_send_bye(mdns_srv_item_t ** services, size_t len, bool include
  */
 static void _mdns_announce_pcb(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol, mdns_srv_item_t ** services, size_t len, bool include_ip)
 {
+#if CONFIG_MDNS_ANSWER_CACHE_ENTRIES > 0
+    // every record mutation and address change comes through here
+    _mdns_answer_cache_invalidate();
+#endif
     mdns_pcb_t * _pcb = &_mdns_server->interfaces[tcpip_if].pcbs[ip_protocol];
     size_t i;
     if (_pcb->pcb) {
@@ -4345,6 +4575,9 @@ void mdns_free(void)
         vQueueDelete(_mdns_server->action_queue);
     }
     _mdns_clear_tx_queue_head();
+#if CONFIG_MDNS_ANSWER_CACHE_ENTRIES > 0
+    _mdns_answer_cache_free();
+#endif
     while (_mdns_server->search_once) {
         mdns_search_once_t * h = _mdns_server->search_once;
         _mdns_server->search_once = h->next;
@@ -4850,6 +5083,20 @@ esp_err_t mdns_query_aaaa(const char * name, uint32_t timeout, esp_ip6_addr_t *
     return ESP_ERR_NOT_FOUND;
 }
 
+esp_err_t mdns_answer_cache_get_stats(mdns_answer_cache_stats_t * stats)
+{
+    if (!stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+#if CONFIG_MDNS_ANSWER_CACHE_ENTRIES > 0
+    *stats = s_answer_cache_stats;
+    return ESP_OK;
+#else
+    memset(stats, 0, sizeof(mdns_answer_cache_stats_t));
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
 #ifdef MDNS_ENABLE_DEBUG
 
 void mdns_debug_packet(const uint8_t * data, size_t len)
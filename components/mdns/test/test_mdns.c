@@ -28,6 +28,17 @@ TEST_CASE("mdns api to fail in invalid state", "[mdns][leaks=64]")
     TEST_ASSERT_NOT_EQUAL(ESP_OK, mdns_service_add(MDNS_INSTANCE, MDNS_SERVICE_NAME, MDNS_SERVICE_PROTO, MDNS_SERVICE_PORT, NULL, 0) );
 }
 
+TEST_CASE("mdns answer cache stats api", "[mdns][leaks=64]")
+{
+    mdns_answer_cache_stats_t stats;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, mdns_answer_cache_get_stats(NULL));
+#if CONFIG_MDNS_ANSWER_CACHE_ENTRIES > 0
+    TEST_ASSERT_EQUAL(ESP_OK, mdns_answer_cache_get_stats(&stats));
+#else
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_SUPPORTED, mdns_answer_cache_get_stats(&stats));
+#endif
+}
+
 TEST_CASE("mdns init and deinit", "[mdns][leaks=64]")
 {
     test_case_uses_tcpip();
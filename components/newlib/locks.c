@@ -14,8 +14,11 @@
 
 #include <sys/lock.h>
 #include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
 #include <sys/reent.h>
 #include "esp_attr.h"
+#include "esp_newlib.h"
 #include "soc/cpu.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
@@ -41,6 +44,12 @@
 
 static portMUX_TYPE lock_init_spinlock = portMUX_INITIALIZER_UNLOCKED;
 
+/* Value stored in a _lock_t to mark the lock as elided (see
+   esp_newlib_lock_elide). Acquire/release on an elided lock reduce to a
+   single aligned word load and compare, performed before any kernel
+   interaction. The value can never collide with a semaphore handle. */
+#define LOCK_ELIDED ((_lock_t) 1)
+
 /* Initialize the given lock by allocating a new mutex semaphore
    as the _lock_t value.
 
@@ -101,7 +110,9 @@ void IRAM_ATTR _lock_init_recursive(_lock_t *lock) {
 */
 void IRAM_ATTR _lock_close(_lock_t *lock) {
     portENTER_CRITICAL(&lock_init_spinlock);
-    if (*lock) {
+    if (*lock == LOCK_ELIDED) {
+        *lock = 0;
+    } else if (*lock) {
         xSemaphoreHandle h = (xSemaphoreHandle)(*lock);
 #if (INCLUDE_xSemaphoreGetMutexHolder == 1)
         configASSERT(xSemaphoreGetMutexHolder(h) == NULL); /* mutex should not be held */
@@ -118,6 +129,9 @@ void _lock_close_recursive(_lock_t *lock) __attribute__((alias("_lock_close")));
    mutex_type is queueQUEUE_TYPE_RECURSIVE_MUTEX or queueQUEUE_TYPE_MUTEX
 */
 static int IRAM_ATTR lock_acquire_generic(_lock_t *lock, uint32_t delay, uint8_t mutex_type) {
+    if (*lock == LOCK_ELIDED) {
+        return 0; /* uncontended by contract, nothing to do */
+    }
     xSemaphoreHandle h = (xSemaphoreHandle)(*lock);
 
     if (!h) {
@@ -180,6 +194,9 @@ int IRAM_ATTR _lock_try_acquire_recursive(_lock_t *lock) {
    mutex_type is queueQUEUE_TYPE_RECURSIVE_MUTEX or queueQUEUE_TYPE_MUTEX
 */
 static void IRAM_ATTR lock_release_generic(_lock_t *lock, uint8_t mutex_type) {
+    if (*lock == LOCK_ELIDED) {
+        return;
+    }
     if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) {
         return; /* locking is a no-op before scheduler is up */
     }
@@ -212,6 +229,38 @@ void IRAM_ATTR _lock_release_recursive(_lock_t *lock) {
     lock_release_generic(lock, queueQUEUE_TYPE_RECURSIVE_MUTEX);
 }
 
+void esp_newlib_lock_elide(_lock_t *lock)
+{
+    /* Free the mutex, if one was already created for this lock */
+    _lock_close(lock);
+    portENTER_CRITICAL(&lock_init_spinlock);
+    *lock = LOCK_ELIDED;
+    portEXIT_CRITICAL(&lock_init_spinlock);
+}
+
+void esp_newlib_lock_restore(_lock_t *lock)
+{
+    portENTER_CRITICAL(&lock_init_spinlock);
+    if (*lock == LOCK_ELIDED) {
+        /* Mutex gets lazily re-created on the next acquire */
+        *lock = 0;
+    }
+    portEXIT_CRITICAL(&lock_init_spinlock);
+}
+
+int esp_newlib_stdio_set_lock_elision(FILE *stream, bool enable)
+{
+    if (stream == NULL) {
+        return -1;
+    }
+    if (enable) {
+        esp_newlib_lock_elide(&stream->_lock);
+    } else {
+        esp_newlib_lock_restore(&stream->_lock);
+    }
+    return 0;
+}
+
 /* No-op function, used to force linking this file,
    instead of the dummy locks implementation from newlib.
  */
@@ -15,7 +15,10 @@
 #ifndef __ESP_NEWLIB_H__
 #define __ESP_NEWLIB_H__
 
+#include <stdio.h>
+#include <stdbool.h>
 #include <sys/reent.h>
+#include <sys/lock.h>
 
 /*
  * Initialize newlib time functions
@@ -53,4 +56,34 @@ void esp_set_time_from_rtc(void);
  */
 void esp_sync_counters_rtc_and_frc(void);
 
+/**
+ * Mark a newlib lock as elided.
+ *
+ * Acquire/release on an elided lock reduce to a single word load and
+ * compare - no FreeRTOS mutex is touched. Any mutex previously created
+ * for the lock is freed. The caller must guarantee that the protected
+ * object is only ever used from one task for as long as the lock stays
+ * elided; no check is performed.
+ */
+void esp_newlib_lock_elide(_lock_t *lock);
+
+/**
+ * Undo esp_newlib_lock_elide. The lock reverts to a normal FreeRTOS
+ * mutex, lazily re-created on the next acquire. Must not be called
+ * while another task may be inside the (elided) critical section.
+ */
+void esp_newlib_lock_restore(_lock_t *lock);
+
+/**
+ * Enable or disable lock elision for a stdio stream.
+ *
+ * With elision enabled, the per-FILE lock taken by every stdio call on
+ * the stream becomes a no-op, which removes the mutex overhead from
+ * hot printf/fwrite paths. Only safe for streams accessed by a single
+ * task.
+ *
+ * Returns 0 on success, -1 if stream is NULL.
+ */
+int esp_newlib_stdio_set_lock_elision(FILE *stream, bool enable);
+
 #endif //__ESP_NEWLIB_H__
@@ -6,6 +6,8 @@
 #include <string.h>
 #include <time.h>
 #include <sys/time.h>
+#include <sys/lock.h>
+#include "esp_newlib.h"
 #include "unity.h"
 #include "sdkconfig.h"
 #include "soc/soc.h"
@@ -211,3 +213,43 @@ TEST_CASE("newlib: rom and toolchain localtime func gives the same result", "[ne
     printf("%s\n", test_result);
     TEST_ASSERT_EQUAL_STRING("2020-03-12 15:00:00 EDT (tm_isdst = 1)", test_result);
 }
+
+TEST_CASE("newlib: lock elision fast path", "[newlib]")
+{
+    _lock_t lock = 0;
+
+    /* Normal lifecycle: acquiring creates a mutex lazily */
+    _lock_acquire_recursive(&lock);
+    TEST_ASSERT_NOT_EQUAL(0, lock);
+    _lock_release_recursive(&lock);
+    _lock_close_recursive(&lock);
+    TEST_ASSERT_EQUAL(0, lock);
+
+    /* Elided lock: acquire/release must not create a mutex */
+    esp_newlib_lock_elide(&lock);
+    _lock_t elided_val = lock;
+    _lock_acquire_recursive(&lock);
+    _lock_acquire_recursive(&lock);
+    _lock_release_recursive(&lock);
+    _lock_release_recursive(&lock);
+    TEST_ASSERT_EQUAL(elided_val, lock);
+
+    /* Restoring reverts to a lazily created mutex */
+    esp_newlib_lock_restore(&lock);
+    TEST_ASSERT_EQUAL(0, lock);
+    _lock_acquire_recursive(&lock);
+    TEST_ASSERT_NOT_EQUAL(0, lock);
+    TEST_ASSERT_NOT_EQUAL(elided_val, lock);
+    _lock_release_recursive(&lock);
+    _lock_close_recursive(&lock);
+
+    /* Per-stream toggle on a stream owned by this task */
+    FILE *f = fmemopen(NULL, 32, "w");
+    TEST_ASSERT_NOT_NULL(f);
+    TEST_ASSERT_EQUAL(0, esp_newlib_stdio_set_lock_elision(f, true));
+    fprintf(f, "x");
+    TEST_ASSERT_EQUAL(0, esp_newlib_stdio_set_lock_elision(f, false));
+    fprintf(f, "y");
+    fclose(f);
+    TEST_ASSERT_EQUAL(-1, esp_newlib_stdio_set_lock_elision(NULL, true));
+}
@@ -0,0 +1,151 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ctype.h>
+#include <string.h>
+#include "http_header_index.h"
+
+typedef struct {
+    http_header_index_t *index;
+    int overflow;
+    int done;
+} index_parse_ctx_t;
+
+static int index_on_url(http_parser *parser, const char *at, size_t length)
+{
+    http_header_index_t *index = ((index_parse_ctx_t *)parser->data)->index;
+
+    if (!index->url) {
+        index->url = at;
+    }
+    /* One contiguous buffer: later spans extend the first one */
+    index->url_len = (size_t)(at + length - index->url);
+    return 0;
+}
+
+static int index_on_header_field(http_parser *parser, const char *at, size_t length)
+{
+    index_parse_ctx_t *ctx = (index_parse_ctx_t *)parser->data;
+    http_header_index_t *index = ctx->index;
+    http_header_view_t *view;
+
+    if (index->count && !index->headers[index->count - 1].value) {
+        /* Still inside the same name */
+        view = &index->headers[index->count - 1];
+        view->name_len = (size_t)(at + length - view->name);
+        return 0;
+    }
+    if (index->count == index->capacity) {
+        ctx->overflow = 1;
+        return 1;
+    }
+    view = &index->headers[index->count++];
+    view->name = at;
+    view->name_len = length;
+    view->value = NULL;
+    view->value_len = 0;
+    return 0;
+}
+
+static int index_on_header_value(http_parser *parser, const char *at, size_t length)
+{
+    http_header_index_t *index = ((index_parse_ctx_t *)parser->data)->index;
+    http_header_view_t *view = &index->headers[index->count - 1];
+
+    if (!view->value) {
+        view->value = at;
+    }
+    /* Obsolete folded lines arrive as extra spans; keep the raw range */
+    view->value_len = (size_t)(at + length - view->value);
+    return 0;
+}
+
+static int index_on_headers_complete(http_parser *parser)
+{
+    ((index_parse_ctx_t *)parser->data)->done = 1;
+    http_parser_pause(parser, 1);
+    return 0;
+}
+
+int http_header_index_parse(http_header_index_t *index,
+                            http_header_view_t *storage, size_t capacity,
+                            enum http_parser_type type,
+                            const char *buf, size_t len)
+{
+    if (!index || !storage || !buf) {
+        return HTTP_HEADER_INDEX_EMALFORMED;
+    }
+
+    memset(index, 0, sizeof(*index));
+    index->headers = storage;
+    index->capacity = capacity;
+
+    index_parse_ctx_t ctx = { .index = index };
+    http_parser parser;
+    http_parser_init(&parser, type);
+    parser.data = &ctx;
+
+    http_parser_settings settings;
+    http_parser_settings_init(&settings);
+    settings.on_url = index_on_url;
+    settings.on_header_field = index_on_header_field;
+    settings.on_header_value = index_on_header_value;
+    settings.on_headers_complete = index_on_headers_complete;
+
+    size_t consumed = http_parser_execute(&parser, &settings, buf, len);
+
+    if (ctx.overflow) {
+        return HTTP_HEADER_INDEX_EOVERFLOW;
+    }
+    if (!ctx.done) {
+        enum http_errno err = HTTP_PARSER_ERRNO(&parser);
+        return (err == HPE_OK) ? HTTP_HEADER_INDEX_EINCOMPLETE
+                               : HTTP_HEADER_INDEX_EMALFORMED;
+    }
+
+    index->method = parser.method;
+    index->status_code = parser.status_code;
+    index->http_major = parser.http_major;
+    index->http_minor = parser.http_minor;
+    /* Pausing in on_headers_complete stops the parser on the final LF of
+     * the head without consuming it */
+    index->head_len = consumed + 1;
+    return HTTP_HEADER_INDEX_OK;
+}
+
+const http_header_view_t *http_header_index_find(const http_header_index_t *index,
+                                                 const char *name)
+{
+    if (!index || !name) {
+        return NULL;
+    }
+
+    size_t name_len = strlen(name);
+    for (size_t i = 0; i < index->count; i++) {
+        const http_header_view_t *view = &index->headers[i];
+        if (view->name_len != name_len) {
+            continue;
+        }
+        size_t j;
+        for (j = 0; j < name_len; j++) {
+            if (tolower((unsigned char)view->name[j]) != tolower((unsigned char)name[j])) {
+                break;
+            }
+        }
+        if (j == name_len) {
+            return view;
+        }
+    }
+    return NULL;
+}
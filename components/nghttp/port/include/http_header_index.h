@@ -0,0 +1,102 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stddef.h>
+#include "http_parser.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Zero-copy header indexing over http_parser.
+ *
+ * The per-fragment http_parser callbacks force consumers to copy header
+ * names and values into accumulation buffers. When the whole message head
+ * is already contiguous in one buffer - as it is in the esp_http_server
+ * scratch buffer and the esp_http_client receive buffer - a single parse
+ * can instead produce an index of (name, value) views borrowing from that
+ * buffer, with no copies at all.
+ *
+ * The views point into the caller's buffer and are NOT NUL terminated;
+ * they stay valid only as long as the buffer contents do.
+ */
+
+/** Parse succeeded and the full message head was indexed */
+#define HTTP_HEADER_INDEX_OK            0
+/** The head is malformed */
+#define HTTP_HEADER_INDEX_EMALFORMED   -1
+/** The buffer ends before the head does; retry with more data */
+#define HTTP_HEADER_INDEX_EINCOMPLETE  -2
+/** More headers than the caller's view storage can hold */
+#define HTTP_HEADER_INDEX_EOVERFLOW    -3
+
+/** One header as a pair of borrowed string views */
+typedef struct {
+    const char *name;       /*!< Header name, not NUL terminated */
+    size_t name_len;        /*!< Header name length */
+    const char *value;      /*!< Header value, not NUL terminated */
+    size_t value_len;       /*!< Header value length */
+} http_header_view_t;
+
+/** Result of indexing one message head */
+typedef struct {
+    http_header_view_t *headers;    /*!< Caller-provided view storage */
+    size_t capacity;                /*!< Number of views the storage holds */
+    size_t count;                   /*!< Headers actually indexed */
+    const char *url;                /*!< Request target, or NULL for responses */
+    size_t url_len;                 /*!< Request target length */
+    unsigned int method;            /*!< enum http_method (requests only) */
+    unsigned int status_code;       /*!< Status code (responses only) */
+    unsigned short http_major;      /*!< HTTP major version */
+    unsigned short http_minor;      /*!< HTTP minor version */
+    size_t head_len;                /*!< Bytes consumed by the head, including
+                                         the terminating empty line; the body,
+                                         if any, starts at this offset */
+} http_header_index_t;
+
+/**
+ * Index the message head at the start of a contiguous buffer.
+ *
+ * Runs http_parser over the buffer until the end of the head and fills
+ * `index` with borrowed views. Values continued over obsolete folded
+ * lines are returned as one raw view spanning the fold.
+ *
+ * @param index   receives the parse results
+ * @param storage caller-owned view array the index borrows
+ * @param capacity number of entries in `storage`
+ * @param type    HTTP_REQUEST or HTTP_RESPONSE
+ * @param buf     buffer holding the message head (and possibly body)
+ * @param len     bytes available in `buf`
+ *
+ * @return HTTP_HEADER_INDEX_OK or one of the HTTP_HEADER_INDEX_E* codes
+ */
+int http_header_index_parse(http_header_index_t *index,
+                            http_header_view_t *storage, size_t capacity,
+                            enum http_parser_type type,
+                            const char *buf, size_t len);
+
+/**
+ * Look up a header by name, case-insensitively.
+ *
+ * @return the first matching view, or NULL if absent
+ */
+const http_header_view_t *http_header_index_find(const http_header_index_t *index,
+                                                 const char *name);
+
+#ifdef __cplusplus
+}
+#endif
@@ -9,3 +9,7 @@ COMPONENT_SRCDIRS := src
 ifndef CONFIG_NVS_ENCRYPTION
 COMPONENT_OBJEXCLUDE := src/nvs_encr.o
 endif
+
+ifndef CONFIG_NVS_CRC_ACCEL
+COMPONENT_OBJEXCLUDE += src/nvs_crc.o
+endif
@@ -391,6 +391,66 @@ esp_err_t nvs_erase_all(nvs_handle_t handle);
  */
 esp_err_t nvs_commit(nvs_handle_t handle);
 
+/**
+ * @brief      Start batching writes on a handle
+ *
+ * After this call, nvs_set_* calls on the handle queue their values in RAM
+ * instead of writing to flash; the whole batch is applied by the next
+ * nvs_commit() under a single lock acquisition and page-write session.
+ * This greatly reduces flash overhead when many keys are updated together.
+ *
+ * Queued values are not visible to nvs_get_* until committed, and are
+ * discarded (not written) by nvs_batch_cancel() or by closing the handle.
+ *
+ * @param[in]  handle  Storage handle obtained with nvs_open.
+ *                     Handles that were opened read only cannot be used.
+ *
+ * @return
+ *             - ESP_OK if batching is now active
+ *             - ESP_ERR_NVS_INVALID_HANDLE if handle has been closed or is NULL
+ *             - ESP_ERR_NVS_READ_ONLY if handle was opened as read only
+ */
+esp_err_t nvs_batch_begin(nvs_handle_t handle);
+
+/**
+ * @brief      Read part of a blob value, starting at a byte offset
+ *
+ * Allows streaming a large blob through a small buffer: repeated calls with
+ * increasing offsets read the value piecewise directly from flash, without
+ * ever needing a RAM buffer covering the whole blob. (The write path already
+ * writes straight from the caller's buffer.)
+ *
+ * Note that unlike nvs_get_blob(), partial reads cannot verify the stored
+ * data CRC, since only part of the value passes through RAM.
+ *
+ * @param[in]     handle     Storage handle obtained with nvs_open.
+ * @param[in]     key        Key name. Maximal length is (NVS_KEY_NAME_MAX_SIZE-1) characters. Shouldn't be empty.
+ * @param[in]     offset     Byte offset within the stored blob to start reading at.
+ * @param[out]    out_value  Buffer for the data.
+ * @param[in]     length     Number of bytes to read. offset + length must not
+ *                           exceed the stored blob's size (see nvs_get_blob()
+ *                           with a NULL buffer to query the size).
+ *
+ * @return
+ *             - ESP_OK if the requested range was read successfully
+ *             - ESP_ERR_NVS_NOT_FOUND if the requested key doesn't exist
+ *             - ESP_ERR_NVS_INVALID_HANDLE if handle has been closed or is NULL
+ *             - ESP_ERR_NVS_INVALID_NAME if key name doesn't satisfy constraints
+ *             - ESP_ERR_NVS_INVALID_LENGTH if the range exceeds the stored value
+ */
+esp_err_t nvs_get_blob_offset(nvs_handle_t handle, const char* key, size_t offset, void* out_value, size_t length);
+
+/**
+ * @brief      Stop batching and discard all queued (uncommitted) writes
+ *
+ * @param[in]  handle  Storage handle obtained with nvs_open.
+ *
+ * @return
+ *             - ESP_OK if the batch was discarded
+ *             - ESP_ERR_NVS_INVALID_HANDLE if handle has been closed or is NULL
+ */
+esp_err_t nvs_batch_cancel(nvs_handle_t handle);
+
 /**
  * @brief      Close the storage handle and free any allocated resources
  *
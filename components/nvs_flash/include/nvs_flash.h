@@ -132,6 +132,28 @@ esp_err_t nvs_flash_erase(void);
  */
 esp_err_t nvs_flash_erase_partition(const char *part_name);
 
+/**
+ * @brief Incrementally compact an initialized NVS partition
+ *
+ * Relocates the still-valid entries of up to max_pages fragmented pages and
+ * erases those pages, so that subsequent writes don't have to do this work
+ * inline. Intended to be called periodically from a low-priority task; each
+ * call does a bounded amount of flash work.
+ *
+ * @param[in] part_name Name of the partition (NULL for the default "nvs"
+ *                      partition)
+ * @param[in] max_pages Maximum number of pages to reclaim in this call
+ * @param[out] out_pages_compacted If non-NULL, receives the number of pages
+ *                                 actually reclaimed (0 if nothing was
+ *                                 fragmented enough to be worth moving)
+ *
+ * @return
+ *      - ESP_OK on success (including when no page needed compacting)
+ *      - ESP_ERR_NVS_NOT_INITIALIZED if the partition is not initialized
+ *      - error codes from the underlying flash storage driver
+ */
+esp_err_t nvs_flash_compact_partition(const char *part_name, size_t max_pages, size_t *out_pages_compacted);
+
 /**
  * @brief Erase custom partition.
  *
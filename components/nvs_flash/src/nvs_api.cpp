@@ -354,6 +354,53 @@ extern "C" esp_err_t nvs_commit(nvs_handle_t c_handle)
     return handle->commit();
 }
 
+extern "C" esp_err_t nvs_flash_compact_partition(const char *part_name, size_t max_pages, size_t *out_pages_compacted)
+{
+    Lock lock;
+    if (part_name == nullptr) {
+        part_name = NVS_DEFAULT_PART_NAME;
+    }
+    nvs::Storage* pStorage = lookup_storage_from_name(part_name);
+    if (pStorage == nullptr) {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+    return pStorage->compact(max_pages, out_pages_compacted);
+}
+
+extern "C" esp_err_t nvs_get_blob_offset(nvs_handle_t c_handle, const char* key, size_t offset, void* out_value, size_t length)
+{
+    Lock lock;
+    ESP_LOGD(TAG, "%s %s %u %u", __func__, key, (unsigned)offset, (unsigned)length);
+    NVSHandleSimple *handle;
+    auto err = nvs_find_ns_handle(c_handle, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    return handle->get_blob_partial(key, offset, out_value, length);
+}
+
+extern "C" esp_err_t nvs_batch_begin(nvs_handle_t c_handle)
+{
+    Lock lock;
+    NVSHandleSimple *handle;
+    auto err = nvs_find_ns_handle(c_handle, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    return handle->start_batch();
+}
+
+extern "C" esp_err_t nvs_batch_cancel(nvs_handle_t c_handle)
+{
+    Lock lock;
+    NVSHandleSimple *handle;
+    auto err = nvs_find_ns_handle(c_handle, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    return handle->cancel_batch();
+}
+
 extern "C" esp_err_t nvs_set_str(nvs_handle_t c_handle, const char* key, const char* value)
 {
     Lock lock;
@@ -0,0 +1,77 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "nvs_crc.hpp"
+
+namespace nvs
+{
+
+static const uint32_t CRC32_POLY_REV = 0xEDB88320;  // reversed CRC-32 (same as ROM crc32_le)
+
+static uint32_t s_tables[4][256];
+static bool s_tables_ready;
+
+static void build_tables()
+{
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t crc = i;
+        for (int j = 0; j < 8; ++j) {
+            crc = (crc >> 1) ^ ((crc & 1) ? CRC32_POLY_REV : 0);
+        }
+        s_tables[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; ++i) {
+        s_tables[1][i] = (s_tables[0][i] >> 8) ^ s_tables[0][s_tables[0][i] & 0xff];
+        s_tables[2][i] = (s_tables[1][i] >> 8) ^ s_tables[0][s_tables[1][i] & 0xff];
+        s_tables[3][i] = (s_tables[2][i] >> 8) ^ s_tables[0][s_tables[2][i] & 0xff];
+    }
+    s_tables_ready = true;
+}
+
+uint32_t crc32_le_accel(uint32_t crc, const uint8_t* buf, size_t len)
+{
+    if (!s_tables_ready) {
+        /* Built once; NVS operations all run under the global NVS lock, so
+           no extra synchronisation is needed here. */
+        build_tables();
+    }
+
+    /* crc32_le complements the state on entry and exit; do the same so the
+       results (and chained updates) are interchangeable with the ROM version */
+    crc = ~crc;
+
+    /* byte-at-a-time until the buffer is word aligned */
+    while (len > 0 && (reinterpret_cast<uintptr_t>(buf) & 3) != 0) {
+        crc = (crc >> 8) ^ s_tables[0][(crc ^ *buf++) & 0xff];
+        --len;
+    }
+
+    /* slice-by-4 over the aligned middle */
+    while (len >= 4) {
+        crc ^= *reinterpret_cast<const uint32_t*>(buf);
+        crc = s_tables[3][crc & 0xff]
+            ^ s_tables[2][(crc >> 8) & 0xff]
+            ^ s_tables[1][(crc >> 16) & 0xff]
+            ^ s_tables[0][(crc >> 24) & 0xff];
+        buf += 4;
+        len -= 4;
+    }
+
+    while (len > 0) {
+        crc = (crc >> 8) ^ s_tables[0][(crc ^ *buf++) & 0xff];
+        --len;
+    }
+    return ~crc;
+}
+
+} // namespace nvs
@@ -12,20 +12,86 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #include <cstdlib>
+#include <cstring>
 #include "nvs_handle.hpp"
 #include "nvs_partition_manager.hpp"
 
 namespace nvs {
 
 NVSHandleSimple::~NVSHandleSimple() {
+    freeBatch();
     NVSPartitionManager::get_instance()->close_handle(this);
 }
 
+esp_err_t NVSHandleSimple::start_batch()
+{
+    if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
+    if (mReadOnly) return ESP_ERR_NVS_READ_ONLY;
+
+    mBatchActive = true;
+    return ESP_OK;
+}
+
+esp_err_t NVSHandleSimple::cancel_batch()
+{
+    if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
+
+    freeBatch();
+    mBatchActive = false;
+    return ESP_OK;
+}
+
+void NVSHandleSimple::freeBatch()
+{
+    BatchEntry *entry = mBatchHead;
+    while (entry != nullptr) {
+        BatchEntry *next = entry->next;
+        free(entry->data);
+        free(entry);
+        entry = next;
+    }
+    mBatchHead = mBatchTail = nullptr;
+}
+
+esp_err_t NVSHandleSimple::queueBatchEntry(ItemType datatype, const char *key, const void *data, size_t dataSize)
+{
+    if (key == nullptr || strlen(key) > Item::MAX_KEY_LENGTH) {
+        return ESP_ERR_NVS_KEY_TOO_LONG;
+    }
+    BatchEntry *entry = static_cast<BatchEntry*>(calloc(1, sizeof(BatchEntry)));
+    if (entry == nullptr) {
+        return ESP_ERR_NO_MEM;
+    }
+    entry->data = malloc(dataSize);
+    if (entry->data == nullptr) {
+        free(entry);
+        return ESP_ERR_NO_MEM;
+    }
+    entry->datatype = datatype;
+    strncpy(entry->key, key, sizeof(entry->key) - 1);
+    memcpy(entry->data, data, dataSize);
+    entry->dataSize = dataSize;
+
+    /* append at the tail so commit preserves write order (last write of a
+       key wins, as with unbatched writes) */
+    if (mBatchTail != nullptr) {
+        mBatchTail->next = entry;
+    } else {
+        mBatchHead = entry;
+    }
+    mBatchTail = entry;
+    return ESP_OK;
+}
+
 esp_err_t NVSHandleSimple::set_typed_item(ItemType datatype, const char *key, const void* data, size_t dataSize)
 {
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
     if (mReadOnly) return ESP_ERR_NVS_READ_ONLY;
 
+    if (mBatchActive) {
+        return queueBatchEntry(datatype, key, data, dataSize);
+    }
+
     return mStoragePtr->writeItem(mNsIndex, datatype, key, data, dataSize);
 }
 
@@ -41,6 +107,10 @@ esp_err_t NVSHandleSimple::set_string(const char *key, const char* str)
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
     if (mReadOnly) return ESP_ERR_NVS_READ_ONLY;
 
+    if (mBatchActive) {
+        return queueBatchEntry(nvs::ItemType::SZ, key, str, strlen(str) + 1);
+    }
+
     return mStoragePtr->writeItem(mNsIndex, nvs::ItemType::SZ, key, str, strlen(str) + 1);
 }
 
@@ -49,6 +119,10 @@ esp_err_t NVSHandleSimple::set_blob(const char *key, const void* blob, size_t le
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
     if (mReadOnly) return ESP_ERR_NVS_READ_ONLY;
 
+    if (mBatchActive) {
+        return queueBatchEntry(nvs::ItemType::BLOB, key, blob, len);
+    }
+
     return mStoragePtr->writeItem(mNsIndex, nvs::ItemType::BLOB, key, blob, len);
 }
 
@@ -66,6 +140,13 @@ esp_err_t NVSHandleSimple::get_blob(const char *key, void* out_blob, size_t len)
     return mStoragePtr->readItem(mNsIndex, nvs::ItemType::BLOB, key, out_blob, len);
 }
 
+esp_err_t NVSHandleSimple::get_blob_partial(const char *key, size_t offset, void* out_blob, size_t len)
+{
+    if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
+
+    return mStoragePtr->readBlobPartial(mNsIndex, key, offset, out_blob, len);
+}
+
 esp_err_t NVSHandleSimple::get_item_size(ItemType datatype, const char *key, size_t &size)
 {
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
@@ -93,6 +174,25 @@ esp_err_t NVSHandleSimple::commit()
 {
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
 
+    /* Apply any queued batch in one go: the whole sequence runs under the
+       caller's single Lock acquisition, so pages are filled back to back
+       instead of being re-located per set_* call. */
+    while (mBatchHead != nullptr) {
+        BatchEntry *entry = mBatchHead;
+        esp_err_t err = mStoragePtr->writeItem(mNsIndex, entry->datatype, entry->key,
+                                               entry->data, entry->dataSize);
+        if (err != ESP_OK) {
+            return err;
+        }
+        mBatchHead = entry->next;
+        if (mBatchHead == nullptr) {
+            mBatchTail = nullptr;
+        }
+        free(entry->data);
+        free(entry);
+    }
+    mBatchActive = false;
+
     return ESP_OK;
 }
 
@@ -54,6 +54,12 @@ public:
 
     esp_err_t get_blob(const char *key, void *out_blob, size_t len) override;
 
+    /**
+     * Read len bytes of a blob starting at offset, allowing large blobs to
+     * be streamed through a small buffer. See nvs_get_blob_offset().
+     */
+    esp_err_t get_blob_partial(const char *key, size_t offset, void *out_blob, size_t len);
+
     esp_err_t get_item_size(ItemType datatype, const char *key, size_t &size) override;
 
     esp_err_t erase_item(const char *key) override;
@@ -76,7 +82,35 @@ public:
 
     bool nextEntry(nvs_opaque_iterator_t *it);
 
+    /**
+     * Start batching: subsequent set_* calls are queued in RAM and only
+     * written to flash by the next commit(), under a single lock/page-write
+     * session. See nvs_batch_begin().
+     */
+    esp_err_t start_batch();
+
+    /**
+     * Drop all queued writes and leave batch mode without touching flash.
+     */
+    esp_err_t cancel_batch();
+
 private:
+    struct BatchEntry {
+        BatchEntry *next;
+        ItemType datatype;
+        char key[Item::MAX_KEY_LENGTH + 1];
+        void *data;
+        size_t dataSize;
+    };
+
+    esp_err_t queueBatchEntry(ItemType datatype, const char *key, const void *data, size_t dataSize);
+
+    void freeBatch();
+
+    BatchEntry *mBatchHead = nullptr;
+    BatchEntry *mBatchTail = nullptr;
+    bool mBatchActive = false;
+
     /**
      * The underlying storage's object.
      */
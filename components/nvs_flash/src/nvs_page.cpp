@@ -321,6 +321,52 @@ esp_err_t Page::readItem(uint8_t nsIndex, ItemType datatype, const char* key, vo
     return ESP_OK;
 }
 
+esp_err_t Page::readItemPartial(uint8_t nsIndex, ItemType datatype, const char* key, size_t dataOffset, void* data, size_t dataSize, uint8_t chunkIdx, VerOffset chunkStart)
+{
+    size_t index = 0;
+    Item item;
+
+    if (mState == PageState::INVALID) {
+        return ESP_ERR_NVS_INVALID_STATE;
+    }
+
+    if (!isVariableLengthType(datatype)) {
+        return ESP_ERR_NVS_TYPE_MISMATCH;
+    }
+
+    esp_err_t rc = findItem(nsIndex, datatype, key, index, item, chunkIdx, chunkStart);
+    if (rc != ESP_OK) {
+        return rc;
+    }
+
+    if (dataOffset > item.varLength.dataSize
+            || dataSize > static_cast<size_t>(item.varLength.dataSize) - dataOffset) {
+        return ESP_ERR_NVS_INVALID_LENGTH;
+    }
+
+    uint8_t* dst = reinterpret_cast<uint8_t*>(data);
+    size_t left = dataSize;
+    size_t skip = dataOffset;
+    for (size_t i = index + 1; i < index + item.span && left > 0; ++i) {
+        if (skip >= ENTRY_SIZE) {
+            skip -= ENTRY_SIZE;
+            continue;
+        }
+        Item ditem;
+        rc = readEntry(i, ditem);
+        if (rc != ESP_OK) {
+            return rc;
+        }
+        size_t willCopy = ENTRY_SIZE - skip;
+        willCopy = (left < willCopy) ? left : willCopy;
+        memcpy(dst, ditem.rawData + skip, willCopy);
+        skip = 0;
+        left -= willCopy;
+        dst += willCopy;
+    }
+    return ESP_OK;
+}
+
 esp_err_t Page::cmpItem(uint8_t nsIndex, ItemType datatype, const char* key, const void* data, size_t dataSize, uint8_t chunkIdx, VerOffset chunkStart)
 {
     size_t index = 0;
@@ -469,6 +515,11 @@ esp_err_t Page::copyItems(Page& other)
         return ESP_ERR_NVS_NOT_FOUND;
     }
 
+    auto load_err = ensureFullyLoaded();
+    if (load_err != ESP_OK) {
+        return load_err;
+    }
+
     if (other.mState == PageState::UNINITIALIZED) {
         auto err = other.initialize();
         if (err != ESP_OK) {
@@ -667,6 +718,32 @@ esp_err_t Page::mLoadEntryTable()
             }
         }
     } else if (mState == PageState::FULL || mState == PageState::FREEING) {
+#ifdef CONFIG_NVS_DEFERRED_PAGE_SCAN
+        /* Defer the per-entry scan (flash reads + CRC checks + hash list
+           build) until the page is first accessed; init only pays for the
+           entry state table read above. */
+        mFullyLoaded = false;
+        return ESP_OK;
+#else
+        return scanFullPageEntries();
+#endif
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t Page::ensureFullyLoaded()
+{
+    if (mFullyLoaded) {
+        return ESP_OK;
+    }
+    mFullyLoaded = true;
+    return scanFullPageEntries();
+}
+
+esp_err_t Page::scanFullPageEntries()
+{
+    {
         // We have already filled mHashList for page in active state.
         // Do the same for the case when page is in full or freeing state.
         Item item;
@@ -807,6 +884,11 @@ esp_err_t Page::findItem(uint8_t nsIndex, ItemType datatype, const char* key, si
         return ESP_ERR_NVS_NOT_FOUND;
     }
 
+    auto load_rc = ensureFullyLoaded();
+    if (load_rc != ESP_OK) {
+        return load_rc;
+    }
+
     size_t findBeginIndex = itemIndex;
     if (findBeginIndex >= ENTRY_COUNT) {
         return ESP_ERR_NVS_NOT_FOUND;
@@ -97,6 +97,11 @@ public:
 
     esp_err_t readItem(uint8_t nsIndex, ItemType datatype, const char* key, void* data, size_t dataSize, uint8_t chunkIdx = CHUNK_ANY, VerOffset chunkStart = VerOffset::VER_ANY);
 
+    /* Read dataSize bytes of a variable-length item starting at dataOffset
+       within the item's data. Unlike readItem() this doesn't need a buffer
+       covering the whole item, but it also can't verify the data CRC. */
+    esp_err_t readItemPartial(uint8_t nsIndex, ItemType datatype, const char* key, size_t dataOffset, void* data, size_t dataSize, uint8_t chunkIdx = CHUNK_ANY, VerOffset chunkStart = VerOffset::VER_ANY);
+
     esp_err_t cmpItem(uint8_t nsIndex, ItemType datatype, const char* key, const void* data, size_t dataSize, uint8_t chunkIdx = CHUNK_ANY, VerOffset chunkStart = VerOffset::VER_ANY);
 
     esp_err_t eraseItem(uint8_t nsIndex, ItemType datatype, const char* key, uint8_t chunkIdx = CHUNK_ANY, VerOffset chunkStart = VerOffset::VER_ANY);
@@ -180,6 +185,15 @@ protected:
 
     esp_err_t mLoadEntryTable();
 
+    /* Per-entry scan of a FULL/FREEING page: validates entry CRCs and
+       builds the hash list. Split out of mLoadEntryTable() so it can be
+       deferred until the page is first accessed
+       (CONFIG_NVS_DEFERRED_PAGE_SCAN). */
+    esp_err_t scanFullPageEntries();
+
+    /* Run the deferred per-entry scan if it hasn't happened yet. */
+    esp_err_t ensureFullyLoaded();
+
     esp_err_t initialize();
 
     esp_err_t alterEntryState(size_t index, EntryState state);
@@ -214,6 +228,7 @@ protected:
 
 protected:
     uint32_t mBaseAddress = 0;
+    bool mFullyLoaded = true;
     PageState mState = PageState::INVALID;
     uint32_t mSeqNumber = UINT32_MAX;
     uint8_t mVersion = NVS_VERSION;
@@ -200,6 +200,60 @@ esp_err_t PageManager::requestNewPage()
     return ESP_OK;
 }
 
+esp_err_t PageManager::compactOnePage(size_t minErasedEntries)
+{
+    /* Same relocation as requestNewPage(), but triggered proactively from a
+       maintenance call instead of from an allocation that ran out of space,
+       and only worthwhile pages (enough erased entries) are considered. */
+    if (mFreePageList.empty()) {
+        return ESP_ERR_NVS_INVALID_STATE;
+    }
+
+    TPageListIterator candidateIt;
+    size_t maxErasedItems = 0;
+    for (auto it = begin(); it != end(); ++it) {
+        if (it->state() != Page::PageState::FULL) {
+            continue;
+        }
+        auto erased = it->getErasedEntryCount();
+        if (erased > maxErasedItems) {
+            candidateIt = it;
+            maxErasedItems = erased;
+        }
+    }
+
+    if (maxErasedItems < minErasedEntries || maxErasedItems == 0) {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+
+    esp_err_t err = activatePage();
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    Page* newPage = &mPageList.back();
+    Page* erasedPage = candidateIt;
+
+    err = erasedPage->markFreeing();
+    if (err != ESP_OK) {
+        return err;
+    }
+    err = erasedPage->copyItems(*newPage);
+    if (err != ESP_OK && err != ESP_ERR_NVS_NOT_FOUND) {
+        return err;
+    }
+
+    err = erasedPage->erase();
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    mPageList.erase(candidateIt);
+    mFreePageList.push_back(erasedPage);
+
+    return ESP_OK;
+}
+
 esp_err_t PageManager::activatePage()
 {
     if (mFreePageList.empty()) {
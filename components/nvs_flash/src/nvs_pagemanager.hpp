@@ -54,6 +54,12 @@ public:
 
     esp_err_t requestNewPage();
 
+    /* Relocate the still-valid items of the page with the most erased
+       entries (at least minErasedEntries of them) and erase it, growing the
+       free page list by one. Used for incremental compaction off the write
+       path; see Storage::compact(). */
+    esp_err_t compactOnePage(size_t minErasedEntries);
+
     esp_err_t fillStats(nvs_stats_t& nvsStats);
 
     uint32_t getBaseSector()
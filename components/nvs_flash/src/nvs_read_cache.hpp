@@ -0,0 +1,120 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef nvs_read_cache_hpp
+#define nvs_read_cache_hpp
+
+#include <cstring>
+#include "nvs_types.hpp"
+#include "sdkconfig.h"
+
+#ifdef CONFIG_NVS_READ_CACHE
+
+namespace nvs
+{
+
+/**
+ * @brief Direct-mapped cache of primitive NVS values
+ *
+ * Caches the values of read-mostly primitive items (up to 8 data bytes) so
+ * that repeated nvs_get_* calls for the same key are served in O(1) from RAM
+ * instead of walking the page list. Entries are refreshed on read and write
+ * and invalidated on erase; the whole cache is dropped on (re)init.
+ *
+ * The cache is internal to Storage and relies on Storage's callers (nvs_api)
+ * holding the global NVS lock, so it needs no locking of its own.
+ */
+class ReadCache
+{
+public:
+    void clear()
+    {
+        for (size_t i = 0; i < NUM_ENTRIES; ++i) {
+            mEntries[i].valid = false;
+        }
+    }
+
+    bool lookup(uint8_t nsIndex, ItemType datatype, const char* key, void* data, size_t dataSize)
+    {
+        Entry& e = entryFor(nsIndex, key);
+        if (!e.valid || e.nsIndex != nsIndex || e.datatype != datatype || e.dataSize != dataSize
+                || strncmp(e.key, key, sizeof(e.key)) != 0) {
+            return false;
+        }
+        memcpy(data, e.value, dataSize);
+        return true;
+    }
+
+    void insert(uint8_t nsIndex, ItemType datatype, const char* key, const void* data, size_t dataSize)
+    {
+        if (dataSize > MAX_VALUE_SIZE || strlen(key) > Item::MAX_KEY_LENGTH) {
+            return;
+        }
+        Entry& e = entryFor(nsIndex, key);
+        e.nsIndex = nsIndex;
+        e.datatype = datatype;
+        e.dataSize = static_cast<uint8_t>(dataSize);
+        strncpy(e.key, key, sizeof(e.key) - 1);
+        e.key[sizeof(e.key) - 1] = '\0';
+        memcpy(e.value, data, dataSize);
+        e.valid = true;
+    }
+
+    void invalidate(uint8_t nsIndex, const char* key)
+    {
+        Entry& e = entryFor(nsIndex, key);
+        if (e.valid && e.nsIndex == nsIndex && strncmp(e.key, key, sizeof(e.key)) == 0) {
+            e.valid = false;
+        }
+    }
+
+    void invalidateNamespace(uint8_t nsIndex)
+    {
+        for (size_t i = 0; i < NUM_ENTRIES; ++i) {
+            if (mEntries[i].valid && mEntries[i].nsIndex == nsIndex) {
+                mEntries[i].valid = false;
+            }
+        }
+    }
+
+private:
+    static const size_t NUM_ENTRIES = CONFIG_NVS_READ_CACHE_ENTRIES;
+    static const size_t MAX_VALUE_SIZE = 8;
+
+    struct Entry {
+        bool valid;
+        uint8_t nsIndex;
+        ItemType datatype;
+        uint8_t dataSize;
+        char key[Item::MAX_KEY_LENGTH + 1];
+        uint8_t value[MAX_VALUE_SIZE];
+    };
+
+    Entry& entryFor(uint8_t nsIndex, const char* key)
+    {
+        // FNV-1a over the key, mixed with the namespace index
+        uint32_t hash = 2166136261U ^ nsIndex;
+        for (const char* p = key; *p != '\0'; ++p) {
+            hash = (hash ^ static_cast<uint8_t>(*p)) * 16777619U;
+        }
+        return mEntries[hash % NUM_ENTRIES];
+    }
+
+    Entry mEntries[NUM_ENTRIES] = {};
+};
+
+} // namespace nvs
+
+#endif // CONFIG_NVS_READ_CACHE
+
+#endif /* nvs_read_cache_hpp */
@@ -120,6 +120,9 @@ esp_err_t Storage::init(uint32_t baseSector, uint32_t sectorCount)
     }
     mNamespaceUsage.set(0, true);
     mNamespaceUsage.set(255, true);
+#ifdef CONFIG_NVS_READ_CACHE
+    mReadCache.clear();
+#endif
     mState = StorageState::ACTIVE;
 
     // Populate list of multi-page index entries.
@@ -269,6 +272,10 @@ esp_err_t Storage::writeItem(uint8_t nsIndex, ItemType datatype, const char* key
         return ESP_ERR_NVS_NOT_INITIALIZED;
     }
 
+#ifdef CONFIG_NVS_READ_CACHE
+    mReadCache.invalidate(nsIndex, key);
+#endif
+
     Page* findPage = nullptr;
     Item item;
 
@@ -479,6 +486,65 @@ esp_err_t Storage::readMultiPageBlob(uint8_t nsIndex, const char* key, void* dat
     return err;
 }
 
+esp_err_t Storage::readBlobPartial(uint8_t nsIndex, const char* key, size_t dataOffset, void* data, size_t dataSize)
+{
+    if (mState != StorageState::ACTIVE) {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+
+    Item item;
+    Page* findPage = nullptr;
+
+    /* Multi-page blob: walk the chunks, reading only the parts which
+       intersect the requested range */
+    auto err = findItem(nsIndex, ItemType::BLOB_IDX, key, findPage, item);
+    if (err == ESP_OK) {
+        uint8_t chunkCount = item.blobIndex.chunkCount;
+        VerOffset chunkStart = item.blobIndex.chunkStart;
+        size_t totalSize = item.blobIndex.dataSize;
+
+        if (dataOffset > totalSize || dataSize > totalSize - dataOffset) {
+            return ESP_ERR_NVS_INVALID_LENGTH;
+        }
+
+        size_t chunkOffset = 0;     // offset of current chunk within the blob
+        size_t outOffset = 0;       // bytes already produced
+        for (uint8_t chunkNum = 0; chunkNum < chunkCount && outOffset < dataSize; chunkNum++) {
+            err = findItem(nsIndex, ItemType::BLOB_DATA, key, findPage, item, static_cast<uint8_t> (chunkStart) + chunkNum);
+            if (err != ESP_OK) {
+                return err;
+            }
+            size_t chunkSize = item.varLength.dataSize;
+            size_t rangeStart = dataOffset + outOffset;
+            if (rangeStart < chunkOffset + chunkSize) {
+                size_t inChunkOffset = rangeStart - chunkOffset;
+                size_t willRead = chunkSize - inChunkOffset;
+                if (willRead > dataSize - outOffset) {
+                    willRead = dataSize - outOffset;
+                }
+                err = findPage->readItemPartial(nsIndex, ItemType::BLOB_DATA, key, inChunkOffset,
+                                                static_cast<uint8_t*>(data) + outOffset, willRead,
+                                                static_cast<uint8_t> (chunkStart) + chunkNum);
+                if (err != ESP_OK) {
+                    return err;
+                }
+                outOffset += willRead;
+            }
+            chunkOffset += chunkSize;
+        }
+        return ESP_OK;
+    } else if (err != ESP_ERR_NVS_NOT_FOUND) {
+        return err;
+    }
+
+    /* Legacy single-page blob */
+    err = findItem(nsIndex, ItemType::BLOB, key, findPage, item);
+    if (err != ESP_OK) {
+        return err;
+    }
+    return findPage->readItemPartial(nsIndex, ItemType::BLOB, key, dataOffset, data, dataSize);
+}
+
 esp_err_t Storage::cmpMultiPageBlob(uint8_t nsIndex, const char* key, const void* data, size_t dataSize)
 {
     Item item;
@@ -536,11 +602,23 @@ esp_err_t Storage::readItem(uint8_t nsIndex, ItemType datatype, const char* key,
         } // else check if the blob is stored with earlier version format without index
     }
 
+#ifdef CONFIG_NVS_READ_CACHE
+    if (mReadCache.lookup(nsIndex, datatype, key, data, dataSize)) {
+        return ESP_OK;
+    }
+#endif
+
     auto err = findItem(nsIndex, datatype, key, findPage, item);
     if (err != ESP_OK) {
         return err;
     }
-    return findPage->readItem(nsIndex, datatype, key, data, dataSize);
+    err = findPage->readItem(nsIndex, datatype, key, data, dataSize);
+#ifdef CONFIG_NVS_READ_CACHE
+    if (err == ESP_OK && isVariableLengthType(datatype) == false) {
+        mReadCache.insert(nsIndex, datatype, key, data, dataSize);
+    }
+#endif
+    return err;
 
 }
 
@@ -595,6 +673,10 @@ esp_err_t Storage::eraseItem(uint8_t nsIndex, ItemType datatype, const char* key
         return ESP_ERR_NVS_NOT_INITIALIZED;
     }
 
+#ifdef CONFIG_NVS_READ_CACHE
+    mReadCache.invalidate(nsIndex, key);
+#endif
+
     if (datatype == ItemType::BLOB) {
         return eraseMultiPageBlob(nsIndex, key);
     }
@@ -613,12 +695,47 @@ esp_err_t Storage::eraseItem(uint8_t nsIndex, ItemType datatype, const char* key
     return findPage->eraseItem(nsIndex, datatype, key);
 }
 
+esp_err_t Storage::compact(size_t maxPages, size_t* outCompacted)
+{
+    if (mState != StorageState::ACTIVE) {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+
+    /* Only bother relocating pages which are at least a quarter erased;
+       compacting nearly-full pages just burns erase cycles. */
+    const size_t minErasedEntries = Page::ENTRY_COUNT / 4;
+
+    size_t compacted = 0;
+    while (compacted < maxPages) {
+        auto err = mPageManager.compactOnePage(minErasedEntries);
+        if (err == ESP_ERR_NVS_NOT_FOUND) {
+            break;      // no worthwhile candidate left
+        }
+        if (err != ESP_OK) {
+            if (outCompacted) {
+                *outCompacted = compacted;
+            }
+            return err;
+        }
+        ++compacted;
+    }
+
+    if (outCompacted) {
+        *outCompacted = compacted;
+    }
+    return ESP_OK;
+}
+
 esp_err_t Storage::eraseNamespace(uint8_t nsIndex)
 {
     if (mState != StorageState::ACTIVE) {
         return ESP_ERR_NVS_NOT_INITIALIZED;
     }
 
+#ifdef CONFIG_NVS_READ_CACHE
+    mReadCache.invalidateNamespace(nsIndex);
+#endif
+
     for (auto it = std::begin(mPageManager); it != std::end(mPageManager); ++it) {
         while (true) {
             auto err = it->eraseItem(nsIndex, ItemType::ANY, nullptr);
@@ -20,6 +20,7 @@
 #include "nvs_types.hpp"
 #include "nvs_page.hpp"
 #include "nvs_pagemanager.hpp"
+#include "nvs_read_cache.hpp"
 #include "partition.hpp"
 
 //extern void dumpBytes(const uint8_t* data, size_t count);
@@ -100,6 +101,13 @@ public:
 
     esp_err_t eraseNamespace(uint8_t nsIndex);
 
+    /**
+     * Incrementally compact the partition: relocate and erase up to maxPages
+     * fragmented pages so later writes don't stall on page relocation.
+     * outCompacted (may be nullptr) receives the number of pages reclaimed.
+     */
+    esp_err_t compact(size_t maxPages, size_t* outCompacted);
+
     const Partition *getPart() const
     {
         return mPartition;
@@ -119,6 +127,14 @@ public:
 
     esp_err_t readMultiPageBlob(uint8_t nsIndex, const char* key, void* data, size_t dataSize);
 
+    /**
+     * Read dataSize bytes of a blob starting at dataOffset, so that large
+     * blobs can be streamed through a small buffer instead of being read
+     * into RAM in one piece. Works for both multi-page and legacy
+     * single-page blobs.
+     */
+    esp_err_t readBlobPartial(uint8_t nsIndex, const char* key, size_t dataOffset, void* data, size_t dataSize);
+
     esp_err_t cmpMultiPageBlob(uint8_t nsIndex, const char* key, const void* data, size_t dataSize);
 
     esp_err_t eraseMultiPageBlob(uint8_t nsIndex, const char* key, VerOffset chunkStart = VerOffset::VER_ANY);
@@ -154,6 +170,9 @@ protected:
 
 protected:
     Partition *mPartition;
+#ifdef CONFIG_NVS_READ_CACHE
+    ReadCache mReadCache;
+#endif
     size_t mPageCount;
     PageManager mPageManager;
     TNamespaces mNamespaces;
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #include "nvs_types.hpp"
+#include "sdkconfig.h"
 
 #if defined(ESP_PLATFORM)
 #include <esp32/rom/crc.h>
@@ -19,16 +20,23 @@
 #include "crc.h"
 #endif
 
+#ifdef CONFIG_NVS_CRC_ACCEL
+#include "nvs_crc.hpp"
+#define NVS_CRC32_LE(crc, buf, len) crc32_le_accel((crc), (buf), (len))
+#else
+#define NVS_CRC32_LE(crc, buf, len) crc32_le((crc), (buf), (len))
+#endif
+
 namespace nvs
 {
 uint32_t Item::calculateCrc32() const
 {
     uint32_t result = 0xffffffff;
     const uint8_t* p = reinterpret_cast<const uint8_t*>(this);
-    result = crc32_le(result, p + offsetof(Item, nsIndex),
+    result = NVS_CRC32_LE(result, p + offsetof(Item, nsIndex),
                       offsetof(Item, crc32) - offsetof(Item, nsIndex));
-    result = crc32_le(result, p + offsetof(Item, key), sizeof(key));
-    result = crc32_le(result, p + offsetof(Item, data), sizeof(data));
+    result = NVS_CRC32_LE(result, p + offsetof(Item, key), sizeof(key));
+    result = NVS_CRC32_LE(result, p + offsetof(Item, data), sizeof(data));
     return result;
 }
 
@@ -36,17 +44,17 @@ uint32_t Item::calculateCrc32WithoutValue() const
 {
     uint32_t result = 0xffffffff;
     const uint8_t* p = reinterpret_cast<const uint8_t*>(this);
-    result = crc32_le(result, p + offsetof(Item, nsIndex),
+    result = NVS_CRC32_LE(result, p + offsetof(Item, nsIndex),
                       offsetof(Item, datatype) - offsetof(Item, nsIndex));
-    result = crc32_le(result, p + offsetof(Item, key), sizeof(key));
-    result = crc32_le(result, p + offsetof(Item, chunkIndex), sizeof(chunkIndex));
+    result = NVS_CRC32_LE(result, p + offsetof(Item, key), sizeof(key));
+    result = NVS_CRC32_LE(result, p + offsetof(Item, chunkIndex), sizeof(chunkIndex));
     return result;
 }
 
 uint32_t Item::calculateCrc32(const uint8_t* data, size_t size)
 {
     uint32_t result = 0xffffffff;
-    result = crc32_le(result, data, size);
+    result = NVS_CRC32_LE(result, data, size);
     return result;
 }
 
@@ -0,0 +1,45 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "catch.hpp"
+#include "crc.h"
+#include "nvs_crc.hpp"
+
+TEST_CASE("crc32_le_accel matches crc32_le", "[crc]")
+{
+    uint8_t buf[512];
+    for (size_t i = 0; i < sizeof(buf); ++i) {
+        buf[i] = static_cast<uint8_t>(i * 7 + 13);
+    }
+
+    /* all lengths up to a few words, plus some longer ones, from aligned
+       and unaligned start offsets */
+    for (size_t offset = 0; offset < 4; ++offset) {
+        for (size_t len = 0; len <= 64; ++len) {
+            CHECK(nvs::crc32_le_accel(0xffffffff, buf + offset, len) ==
+                  crc32_le(0xffffffff, buf + offset, len));
+        }
+        CHECK(nvs::crc32_le_accel(0xffffffff, buf + offset, sizeof(buf) - offset) ==
+              crc32_le(0xffffffff, buf + offset, sizeof(buf) - offset));
+    }
+
+    /* chained updates, the way Item::calculateCrc32* feeds the header and
+       data in separate calls */
+    uint32_t ref = crc32_le(0xffffffff, buf, 24);
+    ref = crc32_le(ref, buf + 24, 8);
+    ref = crc32_le(ref, buf + 32, 480);
+    uint32_t accel = nvs::crc32_le_accel(0xffffffff, buf, 24);
+    accel = nvs::crc32_le_accel(accel, buf + 24, 8);
+    accel = nvs::crc32_le_accel(accel, buf + 32, 480);
+    CHECK(accel == ref);
+}
@@ -27,6 +27,7 @@
 
 int ssl_pm_new(SSL *ssl);
 void ssl_pm_free(SSL *ssl);
+void ssl_pm_pool_flush(const SSL_CTX *ctx);
 
 int ssl_pm_handshake(SSL *ssl);
 int ssl_pm_shutdown(SSL *ssl);
@@ -18,6 +18,7 @@
 #include "ssl_cert.h"
 #include "ssl_dbg.h"
 #include "ssl_port.h"
+#include "ssl_pm.h"
 
 #define SSL_SEND_DATA_MAX_LENGTH 1460
 
@@ -220,6 +221,8 @@ void SSL_CTX_free(SSL_CTX* ctx)
 {
     SSL_ASSERT3(ctx);
 
+    ssl_pm_pool_flush(ctx);
+
     ssl_cert_free(ctx->cert);
 
     X509_free(ctx->client_CA);
@@ -16,6 +16,8 @@
 #include "ssl_port.h"
 #include "ssl_dbg.h"
 
+#include "freertos/FreeRTOS.h"
+
 /* mbedtls include */
 #include "mbedtls/platform.h"
 #include "mbedtls/net_sockets.h"
@@ -43,6 +45,12 @@ struct ssl_pm
     mbedtls_ssl_context ssl;
 
     mbedtls_entropy_context entropy;
+
+    /* connection pool bookkeeping, see ssl_pm_pool_take()/ssl_pm_pool_put() */
+    struct ssl_pm *pool_next;
+    const SSL_CTX *pool_ctx;
+    unsigned int pool_content_len;
+    char pool_endpoint;
 };
 
 struct x509_pm
@@ -61,6 +69,17 @@ struct pkey_pm
 
 unsigned int max_content_len;
 
+/* Freed ssl_pm objects are parked here instead of being destroyed, so the next
+ * connection on the same SSL_CTX reuses their mbedtls contexts and I/O buffers
+ * after a session reset. This takes the repeated entropy seeding and the
+ * ~12 KB of buffer allocations out of every accept(). Entries are tagged with
+ * the SSL_CTX, the endpoint role and the content length their configuration
+ * was built for, and are only handed out on an exact match.
+ */
+static struct ssl_pm *s_ssl_pm_pool;
+static unsigned int s_ssl_pm_pool_count;
+static portMUX_TYPE s_ssl_pm_pool_lock = portMUX_INITIALIZER_UNLOCKED;
+
 /*********************************************************************************************/
 /************************************ SSL arch interface *************************************/
 
@@ -122,6 +141,88 @@ static int get_mbedtls_minor_ssl_version(int openssl_version_nr)
     // SSLv3.0 otherwise
     return MBEDTLS_SSL_MINOR_VERSION_0;
 }
+/**
+ * @brief destroy SSL low-level object for real (bypassing the pool)
+ */
+static void ssl_pm_destroy(struct ssl_pm *ssl_pm)
+{
+    mbedtls_ctr_drbg_free(&ssl_pm->ctr_drbg);
+    mbedtls_entropy_free(&ssl_pm->entropy);
+    mbedtls_ssl_config_free(&ssl_pm->conf);
+    mbedtls_ssl_free(&ssl_pm->ssl);
+
+    ssl_mem_free(ssl_pm);
+}
+
+/**
+ * @brief take a matching recycled SSL low-level object out of the pool
+ */
+static struct ssl_pm *ssl_pm_pool_take(const SSL_CTX *ctx, int endpoint, unsigned int content_len)
+{
+    struct ssl_pm *ssl_pm, **prev;
+
+    portENTER_CRITICAL(&s_ssl_pm_pool_lock);
+    prev = &s_ssl_pm_pool;
+    for (ssl_pm = s_ssl_pm_pool; ssl_pm; prev = &ssl_pm->pool_next, ssl_pm = ssl_pm->pool_next) {
+        if (ssl_pm->pool_ctx == ctx && ssl_pm->pool_endpoint == endpoint &&
+                ssl_pm->pool_content_len == content_len) {
+            *prev = ssl_pm->pool_next;
+            s_ssl_pm_pool_count--;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_ssl_pm_pool_lock);
+
+    return ssl_pm;
+}
+
+/**
+ * @brief park a freed SSL low-level object in the pool, if there is room
+ */
+static int ssl_pm_pool_put(struct ssl_pm *ssl_pm)
+{
+    int stored = 0;
+
+    portENTER_CRITICAL(&s_ssl_pm_pool_lock);
+    if (s_ssl_pm_pool_count < CONFIG_OPENSSL_CONNECTION_POOL_SIZE) {
+        ssl_pm->pool_next = s_ssl_pm_pool;
+        s_ssl_pm_pool = ssl_pm;
+        s_ssl_pm_pool_count++;
+        stored = 1;
+    }
+    portEXIT_CRITICAL(&s_ssl_pm_pool_lock);
+
+    return stored;
+}
+
+/**
+ * @brief destroy the recycled SSL low-level objects of an SSL context
+ */
+void ssl_pm_pool_flush(const SSL_CTX *ctx)
+{
+    struct ssl_pm *ssl_pm, **prev, *drain = NULL;
+
+    portENTER_CRITICAL(&s_ssl_pm_pool_lock);
+    prev = &s_ssl_pm_pool;
+    while ((ssl_pm = *prev) != NULL) {
+        if (!ctx || ssl_pm->pool_ctx == ctx) {
+            *prev = ssl_pm->pool_next;
+            ssl_pm->pool_next = drain;
+            drain = ssl_pm;
+            s_ssl_pm_pool_count--;
+        } else {
+            prev = &ssl_pm->pool_next;
+        }
+    }
+    portEXIT_CRITICAL(&s_ssl_pm_pool_lock);
+
+    while (drain) {
+        ssl_pm = drain;
+        drain = drain->pool_next;
+        ssl_pm_destroy(ssl_pm);
+    }
+}
+
 /**
  * @brief create SSL low-level object
  */
@@ -137,42 +238,59 @@ int ssl_pm_new(SSL *ssl)
 
     const SSL_METHOD *method = ssl->method;
 
-    ssl_pm = ssl_mem_zalloc(sizeof(struct ssl_pm));
-    if (!ssl_pm) {
-        SSL_DEBUG(SSL_PLATFORM_ERROR_LEVEL, "no enough memory > (ssl_pm)");
-        OPENSSL_PUT_LIB_ERROR(ERR_LIB_SYS, ERR_R_MALLOC_FAILURE);
-        goto no_mem;
+    if (method->endpoint) {
+        endpoint = MBEDTLS_SSL_IS_SERVER;
+    } else {
+        endpoint = MBEDTLS_SSL_IS_CLIENT;
     }
 
     max_content_len = ssl->ctx->read_buffer_len;
 
-    mbedtls_net_init(&ssl_pm->fd);
-    mbedtls_net_init(&ssl_pm->cl_fd);
+    ssl_pm = ssl_pm_pool_take(ssl->ctx, endpoint, ssl->ctx->read_buffer_len);
+    if (!ssl_pm) {
+        ssl_pm = ssl_mem_zalloc(sizeof(struct ssl_pm));
+        if (!ssl_pm) {
+            SSL_DEBUG(SSL_PLATFORM_ERROR_LEVEL, "no enough memory > (ssl_pm)");
+            OPENSSL_PUT_LIB_ERROR(ERR_LIB_SYS, ERR_R_MALLOC_FAILURE);
+            goto no_mem;
+        }
 
-    mbedtls_ssl_config_init(&ssl_pm->conf);
-    mbedtls_ctr_drbg_init(&ssl_pm->ctr_drbg);
-    mbedtls_entropy_init(&ssl_pm->entropy);
-    mbedtls_ssl_init(&ssl_pm->ssl);
+        mbedtls_net_init(&ssl_pm->fd);
+        mbedtls_net_init(&ssl_pm->cl_fd);
 
-    ret = mbedtls_ctr_drbg_seed(&ssl_pm->ctr_drbg, mbedtls_entropy_func, &ssl_pm->entropy, pers, pers_len);
-    if (ret) {
-        SSL_DEBUG(SSL_PLATFORM_ERROR_LEVEL, "mbedtls_ctr_drbg_seed() return -0x%x", -ret);
-        OPENSSL_PUT_LIB_ERROR(ERR_LIB_RAND, ret);
-        goto mbedtls_err1;
-    }
+        mbedtls_ssl_config_init(&ssl_pm->conf);
+        mbedtls_ctr_drbg_init(&ssl_pm->ctr_drbg);
+        mbedtls_entropy_init(&ssl_pm->entropy);
+        mbedtls_ssl_init(&ssl_pm->ssl);
 
-    if (method->endpoint) {
-        endpoint = MBEDTLS_SSL_IS_SERVER;
-    } else {
-        endpoint = MBEDTLS_SSL_IS_CLIENT;
-    }
-    ret = mbedtls_ssl_config_defaults(&ssl_pm->conf, endpoint, MBEDTLS_SSL_TRANSPORT_STREAM, MBEDTLS_SSL_PRESET_DEFAULT);
-    if (ret) {
-        SSL_DEBUG(SSL_PLATFORM_ERROR_LEVEL, "mbedtls_ssl_config_defaults() return -0x%x", -ret);
-        OPENSSL_PUT_LIB_ERROR(ERR_LIB_CONF, ret);
-        goto mbedtls_err2;
+        ret = mbedtls_ctr_drbg_seed(&ssl_pm->ctr_drbg, mbedtls_entropy_func, &ssl_pm->entropy, pers, pers_len);
+        if (ret) {
+            SSL_DEBUG(SSL_PLATFORM_ERROR_LEVEL, "mbedtls_ctr_drbg_seed() return -0x%x", -ret);
+            OPENSSL_PUT_LIB_ERROR(ERR_LIB_RAND, ret);
+            goto mbedtls_err1;
+        }
+
+        ret = mbedtls_ssl_config_defaults(&ssl_pm->conf, endpoint, MBEDTLS_SSL_TRANSPORT_STREAM, MBEDTLS_SSL_PRESET_DEFAULT);
+        if (ret) {
+            SSL_DEBUG(SSL_PLATFORM_ERROR_LEVEL, "mbedtls_ssl_config_defaults() return -0x%x", -ret);
+            OPENSSL_PUT_LIB_ERROR(ERR_LIB_CONF, ret);
+            goto mbedtls_err2;
+        }
+
+        ret = mbedtls_ssl_setup(&ssl_pm->ssl, &ssl_pm->conf);
+        if (ret) {
+            SSL_DEBUG(SSL_PLATFORM_ERROR_LEVEL, "mbedtls_ssl_setup() return -0x%x", -ret);
+            OPENSSL_PUT_LIB_ERROR(ERR_LIB_CONF, ret);
+            goto mbedtls_err2;
+        }
+
+        ssl_pm->pool_ctx = ssl->ctx;
+        ssl_pm->pool_endpoint = endpoint;
+        ssl_pm->pool_content_len = ssl->ctx->read_buffer_len;
     }
 
+    /* per-connection tuning, refreshed on recycled objects as well since the
+     * SSL_CTX settings may have changed between connections */
     if (TLS_ANY_VERSION != ssl->version) {
         int min_version = ssl->ctx->min_version ? ssl->ctx->min_version : ssl->version;
         int max_version = ssl->ctx->max_version ? ssl->ctx->max_version : ssl->version;
@@ -201,13 +319,6 @@ int ssl_pm_new(SSL *ssl)
     mbedtls_ssl_conf_dbg(&ssl_pm->conf, NULL, NULL);
 #endif
 
-    ret = mbedtls_ssl_setup(&ssl_pm->ssl, &ssl_pm->conf);
-    if (ret) {
-        SSL_DEBUG(SSL_PLATFORM_ERROR_LEVEL, "mbedtls_ssl_setup() return -0x%x", -ret);
-        OPENSSL_PUT_LIB_ERROR(ERR_LIB_CONF, ret);
-        goto mbedtls_err2;
-    }
-
     mbedtls_ssl_set_bio(&ssl_pm->ssl, &ssl_pm->fd, mbedtls_net_send, mbedtls_net_recv, NULL);
 
     ssl->ssl_pm = ssl_pm;
@@ -234,12 +345,19 @@ void ssl_pm_free(SSL *ssl)
 {
     struct ssl_pm *ssl_pm = (struct ssl_pm *)ssl->ssl_pm;
 
-    mbedtls_ctr_drbg_free(&ssl_pm->ctr_drbg);
-    mbedtls_entropy_free(&ssl_pm->entropy);
-    mbedtls_ssl_config_free(&ssl_pm->conf);
-    mbedtls_ssl_free(&ssl_pm->ssl);
+    /* recycle the object: the session reset drops the handshake state but
+     * keeps the mbedtls contexts and their I/O buffers allocated for the next
+     * connection on this SSL_CTX */
+    if (mbedtls_ssl_session_reset(&ssl_pm->ssl) == 0) {
+        ssl_pm->fd.fd = -1;
+        ssl_pm->cl_fd.fd = -1;
+        if (ssl_pm_pool_put(ssl_pm)) {
+            ssl->ssl_pm = NULL;
+            return;
+        }
+    }
 
-    ssl_mem_free(ssl_pm);
+    ssl_pm_destroy(ssl_pm);
     ssl->ssl_pm = NULL;
 }
 
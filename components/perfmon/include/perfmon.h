@@ -24,6 +24,7 @@
 #include "xtensa_perfmon_access.h"
 #include "xtensa_perfmon_masks.h"
 #include "xtensa_perfmon_apis.h"
+#include "xtensa_perfmon_prof.h"
 #include "xtensa/xt_perf_consts.h"
 
 #endif // _PERF_MON_H_
@@ -0,0 +1,150 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _xtensa_perfmon_prof_H_
+#define _xtensa_perfmon_prof_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Sampling profiler configuration structure
+ *
+ * The profiler programs one performance counter per CPU to overflow every
+ * sample_period events and records the interrupted PC (from the INTPC
+ * register) into a ring buffer on each overflow interrupt.
+ */
+typedef struct xtensa_perfmon_prof_config {
+    uint32_t sample_period;  /*!< number of counted events between samples.
+                                  With the default cycle event and 240 MHz CPU,
+                                  240000 gives ~1000 samples per second per core */
+    uint16_t select;         /*!< event select value (XTPERF_CNT_...), default: cycles */
+    uint16_t mask;           /*!< event mask value (XTPERF_MASK_...), default: all subsets */
+    uint32_t buffer_entries; /*!< capacity of the sample ring buffer (one word per sample).
+                                  When full, the oldest samples are overwritten */
+} xtensa_perfmon_prof_config_t;
+
+/**
+ * @brief      Initialize the sampling profiler
+ *
+ * Allocates the sample buffer and programs the profiling interrupt on all CPUs.
+ * Sampling does not start until xtensa_perfmon_prof_start() is called.
+ *
+ * @param[in] config: pointer to the configuration structure
+ *
+ * @return
+ *      - ESP_OK if no errors
+ *      - ESP_ERR_INVALID_ARG if sample_period or buffer_entries is 0
+ *      - ESP_ERR_INVALID_STATE if the profiler is already initialized
+ *      - ESP_ERR_NO_MEM if the sample buffer can not be allocated
+ */
+esp_err_t xtensa_perfmon_prof_init(const xtensa_perfmon_prof_config_t *config);
+
+/**
+ * @brief      Initialize the profiler for instruction cache miss attribution
+ *
+ * Convenience preset: samples the PC every sample_period cycles of ICache
+ * miss penalty instead of every sample_period CPU cycles, so the recorded
+ * PCs cluster on the code paying for flash cache misses rather than on the
+ * code merely running the most. Use xtensa_perfmon_prof_report() afterwards
+ * to see the top miss contributors and their current placement.
+ *
+ * @param[in] sample_period: ICache miss penalty cycles between samples.
+ *                           A few thousand is a reasonable starting point
+ * @param[in] buffer_entries: capacity of the sample ring buffer
+ *
+ * @return same as xtensa_perfmon_prof_init()
+ */
+esp_err_t xtensa_perfmon_prof_init_cache_miss(uint32_t sample_period, uint32_t buffer_entries);
+
+/**
+ * @brief      Start sampling on all CPUs
+ *
+ * @return
+ *      - ESP_OK if no errors
+ *      - ESP_ERR_INVALID_STATE if the profiler is not initialized
+ */
+esp_err_t xtensa_perfmon_prof_start(void);
+
+/**
+ * @brief      Stop sampling on all CPUs
+ *
+ * The collected samples are kept and can be dumped afterwards.
+ *
+ * @return
+ *      - ESP_OK if no errors
+ *      - ESP_ERR_INVALID_STATE if the profiler is not initialized
+ */
+esp_err_t xtensa_perfmon_prof_stop(void);
+
+/**
+ * @brief      Dump the collected samples in folded-stack format
+ *
+ * Each output line is 'CPUn;0x<pc> <count>', suitable as input for
+ * flamegraph.pl; addresses can be symbolicated offline with addr2line
+ * against the application ELF. Must be called with sampling stopped.
+ *
+ * @param[in] stream: FILE* handle where the data will be written.
+ *                    If this parameter is NULL, data goes to stdout.
+ *
+ * @return
+ *      - ESP_OK if no errors
+ *      - ESP_ERR_INVALID_STATE if the profiler is running or not initialized
+ */
+esp_err_t xtensa_perfmon_prof_dump(FILE *stream);
+
+/**
+ * @brief      Print the top sampled addresses with their current placement
+ *
+ * Folds the samples of both CPUs together, sorts by sample count and prints
+ * the top_n addresses as '0x<pc> <count> <placement>' where placement is
+ * IRAM, RTC_IRAM, flash, ROM or other, derived from the address map. Run
+ * after cache miss profiling (xtensa_perfmon_prof_init_cache_miss()), a
+ * 'flash' line near the top is a function worth moving to IRAM (IRAM_ATTR
+ * or a linker fragment); an 'IRAM' line is code already placed but still
+ * missing in the data path. Symbolicate addresses offline with addr2line.
+ * Must be called with sampling stopped. The report strips the per-CPU tag
+ * from the stored samples, so call xtensa_perfmon_prof_dump() first when
+ * both outputs are wanted.
+ *
+ * @param[in] stream: FILE* handle where the report will be written.
+ *                    If this parameter is NULL, the report goes to stdout.
+ * @param[in] top_n: maximum number of addresses to print (capped at 32)
+ *
+ * @return
+ *      - ESP_OK if no errors
+ *      - ESP_ERR_INVALID_STATE if the profiler is running or not initialized
+ */
+esp_err_t xtensa_perfmon_prof_report(FILE *stream, uint32_t top_n);
+
+/**
+ * @brief      Deinitialize the sampling profiler and free the sample buffer
+ *
+ * @return
+ *      - ESP_OK if no errors
+ *      - ESP_ERR_INVALID_STATE if the profiler is running
+ */
+esp_err_t xtensa_perfmon_prof_deinit(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _xtensa_perfmon_prof_H_
@@ -0,0 +1,66 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include "unity.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "perfmon.h"
+
+TEST_CASE("Sampling profiler collects and dumps samples", "[perfmon]")
+{
+    xtensa_perfmon_prof_config_t config = {
+        .sample_period = 240000,  // about 1 kHz at 240 MHz with the cycle event
+        .select = 0,              // defaults to cycles
+        .mask = 0,
+        .buffer_entries = 1024,
+    };
+    TEST_ESP_OK(xtensa_perfmon_prof_init(&config));
+    // running profiler must refuse dump and deinit
+    TEST_ESP_OK(xtensa_perfmon_prof_start());
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, xtensa_perfmon_prof_dump(NULL));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, xtensa_perfmon_prof_deinit());
+    // burn some cycles so there is something to sample
+    volatile uint32_t acc = 0;
+    for (int i = 0; i < 1000000; i++) {
+        acc += i;
+    }
+    vTaskDelay(pdMS_TO_TICKS(100));
+    TEST_ESP_OK(xtensa_perfmon_prof_stop());
+    TEST_ESP_OK(xtensa_perfmon_prof_dump(NULL));
+    TEST_ESP_OK(xtensa_perfmon_prof_deinit());
+    // double init/deinit must behave
+    TEST_ESP_OK(xtensa_perfmon_prof_init(&config));
+    TEST_ESP_OK(xtensa_perfmon_prof_deinit());
+}
+
+TEST_CASE("Cache miss profiler reports top contributors", "[perfmon]")
+{
+    TEST_ESP_OK(xtensa_perfmon_prof_init_cache_miss(4096, 1024));
+    TEST_ESP_OK(xtensa_perfmon_prof_start());
+    // report must be refused while sampling is running
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, xtensa_perfmon_prof_report(NULL, 10));
+    // touch a spread of flash-resident code so some misses occur
+    for (int i = 0; i < 200; i++) {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%d-%x", i, i * 7);
+        TEST_ASSERT(strlen(buf) > 0);
+        vTaskDelay(1);
+    }
+    TEST_ESP_OK(xtensa_perfmon_prof_stop());
+    TEST_ESP_OK(xtensa_perfmon_prof_report(NULL, 10));
+    TEST_ESP_OK(xtensa_perfmon_prof_deinit());
+}
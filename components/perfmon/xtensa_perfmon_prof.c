@@ -0,0 +1,305 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * Sampling profiler on top of the Xtensa performance monitor.
+ *
+ * Counter 0 of each CPU is preloaded so that it overflows every
+ * sample_period events; the overflow raises the profiling interrupt
+ * (XCHAL_PROFILING_INTERRUPT) and the handler stores the interrupted PC
+ * (INTPC register) into a shared ring buffer. Samples are folded at dump
+ * time into 'CPUn;0x<pc> <count>' lines for flamegraph.pl; symbolication
+ * is done offline with addr2line. While the profiler is initialized it
+ * owns performance counter 0, so xtensa_perfmon_exec() must not be used
+ * at the same time.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_attr.h"
+#include "esp_ipc.h"
+#include "xtensa_perfmon_prof.h"
+#include "xtensa/xtensa_api.h"
+#include "xtensa/xt_perf_consts.h"
+#include "xtensa-debug-module.h"
+#include "eri.h"
+#include "soc/soc.h"
+#include "soc/soc_memory_layout.h"
+
+/* The profiler always uses performance counter 0 on each CPU */
+#define PROF_COUNTER_ID     0
+/* The CPU number is kept in the top bit of each sample; code addresses
+ * on these targets never have it set */
+#define PROF_SAMPLE_CPU_BIT 31
+
+typedef struct {
+    uint32_t *samples;          // ring buffer of PCs with the CPU bit
+    uint32_t capacity;          // ring capacity, entries
+    uint32_t next;              // next write position
+    uint32_t total;             // total samples taken since init
+    uint32_t preload;           // counter preload value (-sample_period)
+    uint32_t pmctrl;            // PMCTRL value programmed on each CPU
+    bool initialized;
+    bool running;
+} perfmon_prof_state_t;
+
+static perfmon_prof_state_t s_prof;
+static portMUX_TYPE s_prof_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static void IRAM_ATTR perfmon_prof_isr(void *arg)
+{
+    uint32_t pc = eri_read(ERI_PERFMON_INTPC);
+    /* Clear the overflow flag and re-arm the counter for the next sample */
+    eri_write(ERI_PERFMON_PMSTAT0 + PROF_COUNTER_ID * sizeof(int32_t), 0);
+    eri_write(ERI_PERFMON_PM0 + PROF_COUNTER_ID * sizeof(int32_t), s_prof.preload);
+
+    uint32_t sample = pc | ((uint32_t) xPortGetCoreID() << PROF_SAMPLE_CPU_BIT);
+    portENTER_CRITICAL_ISR(&s_prof_lock);
+    s_prof.samples[s_prof.next] = sample;
+    s_prof.next = (s_prof.next + 1) % s_prof.capacity;
+    s_prof.total++;
+    portEXIT_CRITICAL_ISR(&s_prof_lock);
+}
+
+/* The PMU and the profiling interrupt are per-CPU; the functions below are
+ * executed on each CPU in turn (through esp_ipc for the other one) */
+
+static void perfmon_prof_configure_cpu(void *arg)
+{
+    xt_set_interrupt_handler(XCHAL_PROFILING_INTERRUPT, perfmon_prof_isr, NULL);
+    eri_write(ERI_PERFMON_PMCTRL0 + PROF_COUNTER_ID * sizeof(int32_t), s_prof.pmctrl);
+    eri_write(ERI_PERFMON_PM0 + PROF_COUNTER_ID * sizeof(int32_t), s_prof.preload);
+    xt_ints_on(1 << XCHAL_PROFILING_INTERRUPT);
+}
+
+static void perfmon_prof_start_cpu(void *arg)
+{
+    eri_write(ERI_PERFMON_PM0 + PROF_COUNTER_ID * sizeof(int32_t), s_prof.preload);
+    eri_write(ERI_PERFMON_PGM, PGM_PMEN);
+}
+
+static void perfmon_prof_stop_cpu(void *arg)
+{
+    eri_write(ERI_PERFMON_PGM, 0);
+    eri_write(ERI_PERFMON_PMSTAT0 + PROF_COUNTER_ID * sizeof(int32_t), 0);
+}
+
+static void perfmon_prof_deconfigure_cpu(void *arg)
+{
+    xt_ints_off(1 << XCHAL_PROFILING_INTERRUPT);
+    eri_write(ERI_PERFMON_PMCTRL0 + PROF_COUNTER_ID * sizeof(int32_t), 0);
+}
+
+static void perfmon_prof_run_on_all_cpus(esp_ipc_func_t func)
+{
+    func(NULL);
+#if !CONFIG_FREERTOS_UNICORE
+    esp_ipc_call_blocking(xPortGetCoreID() == 0 ? 1 : 0, func, NULL);
+#endif
+}
+
+esp_err_t xtensa_perfmon_prof_init(const xtensa_perfmon_prof_config_t *config)
+{
+    if (config == NULL || config->sample_period == 0 || config->buffer_entries == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_prof.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    s_prof.samples = calloc(config->buffer_entries, sizeof(uint32_t));
+    if (s_prof.samples == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    s_prof.capacity = config->buffer_entries;
+    s_prof.next = 0;
+    s_prof.total = 0;
+    s_prof.preload = (uint32_t) -config->sample_period;
+
+    uint16_t select = config->select;
+    uint16_t mask = config->mask;
+    if (select == 0 && mask == 0) {
+        select = XTPERF_CNT_CYCLES;
+        mask = XTPERF_MASK_CYCLES;
+    }
+    /* Count at all interrupt levels (tracelevel = 15) and assert the
+     * profiling interrupt on overflow */
+    s_prof.pmctrl = PMCTRL_INTEN |
+                    (PMCTRL_TRACELEVEL_MASK << PMCTRL_TRACELEVEL_SHIFT) |
+                    ((select & PMCTRL_SELECT_MASK) << PMCTRL_SELECT_SHIFT) |
+                    ((mask & PMCTRL_MASK_MASK) << PMCTRL_MASK_SHIFT);
+
+    perfmon_prof_run_on_all_cpus(perfmon_prof_configure_cpu);
+    s_prof.initialized = true;
+    return ESP_OK;
+}
+
+esp_err_t xtensa_perfmon_prof_init_cache_miss(uint32_t sample_period, uint32_t buffer_entries)
+{
+    xtensa_perfmon_prof_config_t config = {
+        .sample_period = sample_period,
+        .select = XTPERF_CNT_ICACHE_MISSES,
+        .mask = XTPERF_MASK_ICACHE_MISSES,
+        .buffer_entries = buffer_entries,
+    };
+    return xtensa_perfmon_prof_init(&config);
+}
+
+esp_err_t xtensa_perfmon_prof_start(void)
+{
+    if (!s_prof.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (!s_prof.running) {
+        s_prof.running = true;
+        perfmon_prof_run_on_all_cpus(perfmon_prof_start_cpu);
+    }
+    return ESP_OK;
+}
+
+esp_err_t xtensa_perfmon_prof_stop(void)
+{
+    if (!s_prof.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (s_prof.running) {
+        perfmon_prof_run_on_all_cpus(perfmon_prof_stop_cpu);
+        s_prof.running = false;
+    }
+    return ESP_OK;
+}
+
+static int perfmon_prof_sample_cmp(const void *pa, const void *pb)
+{
+    uint32_t a = *(const uint32_t *) pa;
+    uint32_t b = *(const uint32_t *) pb;
+    return (a > b) - (a < b);
+}
+
+esp_err_t xtensa_perfmon_prof_dump(FILE *stream)
+{
+    if (!s_prof.initialized || s_prof.running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (stream == NULL) {
+        stream = stdout;
+    }
+    uint32_t count = s_prof.total < s_prof.capacity ? s_prof.total : s_prof.capacity;
+    /* Sorting groups equal PCs together, so folding is a single pass.
+     * The ring order is destroyed, which is fine: only counts matter. */
+    qsort(s_prof.samples, count, sizeof(uint32_t), perfmon_prof_sample_cmp);
+    for (uint32_t i = 0; i < count; ) {
+        uint32_t sample = s_prof.samples[i];
+        uint32_t n = 1;
+        while (i + n < count && s_prof.samples[i + n] == sample) {
+            n++;
+        }
+        fprintf(stream, "CPU%d;0x%08x %d\n",
+                (int) (sample >> PROF_SAMPLE_CPU_BIT),
+                sample & ~(1UL << PROF_SAMPLE_CPU_BIT),
+                (int) n);
+        i += n;
+    }
+    if (s_prof.total > s_prof.capacity) {
+        fprintf(stream, "# %d samples dropped (buffer wrapped)\n",
+                (int) (s_prof.total - s_prof.capacity));
+    }
+    return ESP_OK;
+}
+
+static const char *perfmon_prof_pc_placement(uint32_t pc)
+{
+    if (esp_ptr_in_iram((void *) pc)) {
+        return "IRAM";
+    }
+    if (esp_ptr_in_rtc_iram_fast((void *) pc)) {
+        return "RTC_IRAM";
+    }
+    if (pc >= SOC_IROM_LOW && pc < SOC_IROM_HIGH) {
+        return "flash";
+    }
+    if (pc >= SOC_IROM_MASK_LOW && pc < SOC_IROM_MASK_HIGH) {
+        return "ROM";
+    }
+    return "other";
+}
+
+#define PROF_REPORT_MAX_TOP 32
+
+esp_err_t xtensa_perfmon_prof_report(FILE *stream, uint32_t top_n)
+{
+    if (!s_prof.initialized || s_prof.running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (stream == NULL) {
+        stream = stdout;
+    }
+    if (top_n > PROF_REPORT_MAX_TOP) {
+        top_n = PROF_REPORT_MAX_TOP;
+    }
+    uint32_t count = s_prof.total < s_prof.capacity ? s_prof.total : s_prof.capacity;
+    /* Merge the CPUs: the miss cost of a function is what matters for
+     * placement, not which core paid it */
+    for (uint32_t i = 0; i < count; i++) {
+        s_prof.samples[i] &= ~(1UL << PROF_SAMPLE_CPU_BIT);
+    }
+    qsort(s_prof.samples, count, sizeof(uint32_t), perfmon_prof_sample_cmp);
+
+    /* Fold equal PCs and keep the top_n heaviest in a small sorted table */
+    uint32_t top_pc[PROF_REPORT_MAX_TOP];
+    uint32_t top_count[PROF_REPORT_MAX_TOP];
+    uint32_t top_used = 0;
+    for (uint32_t i = 0; i < count; ) {
+        uint32_t pc = s_prof.samples[i];
+        uint32_t n = 1;
+        while (i + n < count && s_prof.samples[i + n] == pc) {
+            n++;
+        }
+        i += n;
+        if (top_used == top_n && n <= top_count[top_used - 1]) {
+            continue;
+        }
+        uint32_t pos = (top_used < top_n) ? top_used++ : top_n - 1;
+        while (pos > 0 && top_count[pos - 1] < n) {
+            top_pc[pos] = top_pc[pos - 1];
+            top_count[pos] = top_count[pos - 1];
+            pos--;
+        }
+        top_pc[pos] = pc;
+        top_count[pos] = n;
+    }
+
+    fprintf(stream, "# top %d of %d samples; use addr2line for symbols\n",
+            (int) top_used, (int) count);
+    for (uint32_t i = 0; i < top_used; i++) {
+        fprintf(stream, "0x%08x %d %s\n", top_pc[i], (int) top_count[i],
+                perfmon_prof_pc_placement(top_pc[i]));
+    }
+    return ESP_OK;
+}
+
+esp_err_t xtensa_perfmon_prof_deinit(void)
+{
+    if (!s_prof.initialized) {
+        return ESP_OK;
+    }
+    if (s_prof.running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    perfmon_prof_run_on_all_cpus(perfmon_prof_deconfigure_cpu);
+    free(s_prof.samples);
+    memset(&s_prof, 0, sizeof(s_prof));
+    return ESP_OK;
+}
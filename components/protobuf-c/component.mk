@@ -1,8 +1,8 @@
 #
 # Component Makefile
 #
-COMPONENT_ADD_INCLUDEDIRS := protobuf-c
+COMPONENT_ADD_INCLUDEDIRS := protobuf-c esp_pb/include
 
-COMPONENT_SRCDIRS := protobuf-c/protobuf-c
+COMPONENT_SRCDIRS := protobuf-c/protobuf-c esp_pb
 
 COMPONENT_SUBMODULES += protobuf-c
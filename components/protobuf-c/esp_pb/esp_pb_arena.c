@@ -0,0 +1,96 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include "esp_pb_arena.h"
+
+/* protobuf-c stores doubles and pointers in arena memory */
+#define ARENA_ALIGN 8
+
+static void *arena_alloc(void *allocator_data, size_t size)
+{
+    esp_pb_arena_t *arena = (esp_pb_arena_t *)allocator_data;
+    size_t aligned = (arena->used + (ARENA_ALIGN - 1)) & ~(size_t)(ARENA_ALIGN - 1);
+
+    if (size > arena->size - aligned) {
+        arena->exhausted = true;
+        return NULL;
+    }
+    arena->used = aligned + size;
+    return arena->buf + aligned;
+}
+
+static void arena_free(void *allocator_data, void *pointer)
+{
+    /* Arena memory is reclaimed wholesale on reset */
+    (void) allocator_data;
+    (void) pointer;
+}
+
+esp_err_t esp_pb_arena_init(esp_pb_arena_t *arena, void *buf, size_t size)
+{
+    if (!arena || !buf || !size) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    memset(arena, 0, sizeof(*arena));
+    arena->allocator.alloc = arena_alloc;
+    arena->allocator.free = arena_free;
+    arena->allocator.allocator_data = arena;
+    arena->buf = (uint8_t *)buf;
+    arena->size = size;
+    return ESP_OK;
+}
+
+void esp_pb_arena_reset(esp_pb_arena_t *arena)
+{
+    if (arena) {
+        arena->used = 0;
+        arena->exhausted = false;
+        arena->heap_fallback = false;
+    }
+}
+
+ProtobufCMessage *esp_pb_arena_unpack(esp_pb_arena_t *arena,
+                                      const ProtobufCMessageDescriptor *descriptor,
+                                      size_t len, const uint8_t *data)
+{
+    if (!arena) {
+        return protobuf_c_message_unpack(descriptor, NULL, len, data);
+    }
+
+    arena->heap_fallback = false;
+    arena->exhausted = false;
+    size_t mark = arena->used;
+
+    ProtobufCMessage *msg = protobuf_c_message_unpack(descriptor, &arena->allocator, len, data);
+    if (msg || !arena->exhausted) {
+        return msg;
+    }
+
+    /* Arena too small for this message: drop the partial decode and
+     * take the default allocator path instead */
+    arena->used = mark;
+    arena->heap_fallback = true;
+    return protobuf_c_message_unpack(descriptor, NULL, len, data);
+}
+
+void esp_pb_arena_free_unpacked(esp_pb_arena_t *arena, ProtobufCMessage *msg)
+{
+    if (!msg) {
+        return;
+    }
+    if (!arena || arena->heap_fallback) {
+        protobuf_c_message_free_unpacked(msg, NULL);
+    }
+}
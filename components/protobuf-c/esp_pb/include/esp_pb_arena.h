@@ -0,0 +1,99 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <esp_err.h>
+#include <protobuf-c/protobuf-c.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Arena allocator for protobuf-c message unpacking
+ *
+ * protobuf_c_message_unpack() allocates every field of the decoded
+ * message graph individually through the allocator, which on the default
+ * allocator means a burst of small heap operations per message. An arena
+ * serves those allocations by bumping a pointer through one caller-owned
+ * buffer; releasing the unpacked message is a no-op because the buffer is
+ * reclaimed wholesale when it goes out of scope or is reset.
+ *
+ * If the arena is too small for a particular message, unpacking through
+ * esp_pb_arena_unpack() transparently retries with the default heap
+ * allocator, so sizing the arena is an optimization rather than a limit.
+ */
+typedef struct {
+    ProtobufCAllocator allocator;   /*!< Pass to protobuf-c APIs directly if needed */
+    uint8_t *buf;                   /*!< Caller-owned arena storage */
+    size_t size;                    /*!< Arena storage size in bytes */
+    size_t used;                    /*!< Bytes handed out so far */
+    bool exhausted;                 /*!< An allocation did not fit */
+    bool heap_fallback;             /*!< Last unpack fell back to the heap */
+} esp_pb_arena_t;
+
+/**
+ * @brief Initialize an arena over a caller-owned buffer
+ *
+ * @param arena arena state to initialize
+ * @param buf storage the arena hands out; must stay valid while any
+ *            message unpacked from the arena is in use
+ * @param size storage size in bytes
+ *
+ * @return ESP_OK, or ESP_ERR_INVALID_ARG on NULL arena or buffer
+ */
+esp_err_t esp_pb_arena_init(esp_pb_arena_t *arena, void *buf, size_t size);
+
+/**
+ * @brief Discard all arena allocations and start over
+ *
+ * Any message previously unpacked from this arena becomes invalid.
+ */
+void esp_pb_arena_reset(esp_pb_arena_t *arena);
+
+/**
+ * @brief Unpack a message, serving field allocations from the arena
+ *
+ * With a NULL arena this is plain protobuf_c_message_unpack() on the
+ * default allocator, so call sites can use one code path whether or not
+ * arena decoding is enabled. When the arena runs out mid-message the
+ * unpack is retried on the heap and the arena is marked so that
+ * esp_pb_arena_free_unpacked() releases the message properly.
+ *
+ * @param arena arena to allocate from, or NULL for the default allocator
+ * @param descriptor generated message descriptor (e.g. &foo__descriptor)
+ * @param len packed message length
+ * @param data packed message bytes
+ *
+ * @return unpacked message, or NULL on malformed input or no memory
+ */
+ProtobufCMessage *esp_pb_arena_unpack(esp_pb_arena_t *arena,
+                                      const ProtobufCMessageDescriptor *descriptor,
+                                      size_t len, const uint8_t *data);
+
+/**
+ * @brief Release a message returned by esp_pb_arena_unpack()
+ *
+ * A no-op for arena-backed messages; frees the graph when the unpack
+ * used the default allocator (NULL arena or heap fallback).
+ */
+void esp_pb_arena_free_unpacked(esp_pb_arena_t *arena, ProtobufCMessage *msg);
+
+#ifdef __cplusplus
+}
+#endif
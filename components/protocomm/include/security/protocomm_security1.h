@@ -14,6 +14,9 @@
 
 #pragma once
 
+#include <stdbool.h>
+#include <stdint.h>
+
 #include <protocomm_security.h>
 
 #ifdef __cplusplus
@@ -28,6 +31,50 @@ extern "C" {
  */
 extern const protocomm_security_t protocomm_security1;
 
+/**
+ * @brief   Handshake and cipher timing counters for security version 1
+ *
+ * Counters aggregate over all sessions since boot (or since the last
+ * call to protocomm_security1_reset_stats())
+ */
+typedef struct {
+    uint32_t handshakes;            /*!< Number of completed session handshakes */
+    uint32_t resumed_handshakes;    /*!< Handshakes that reused a cached shared secret */
+    uint64_t handshake_us;          /*!< Total time spent in handshake processing (us) */
+    uint64_t crypt_us;              /*!< Total time spent in AES-CTR en/decryption (us) */
+    uint64_t crypt_bytes;           /*!< Total bytes passed through AES-CTR */
+} protocomm_security1_stats_t;
+
+/**
+ * @brief   Get a snapshot of the security version 1 timing counters
+ *
+ * @param[out] stats Pointer to structure to be filled in
+ *
+ * @return
+ *  - ESP_OK : Success
+ *  - ESP_ERR_INVALID_ARG : Null argument
+ */
+esp_err_t protocomm_security1_get_stats(protocomm_security1_stats_t *stats);
+
+/**
+ * @brief   Reset the security version 1 timing counters to zero
+ */
+void protocomm_security1_reset_stats(void);
+
+/**
+ * @brief   Enable or disable session resumption
+ *
+ * When enabled (default), the shared secret of the last successfully
+ * established session is cached. A client reconnecting with the same
+ * Curve25519 public key then skips the ECDH computation on the device,
+ * which shortens the handshake considerably on chips without an ECC
+ * accelerator. The wire protocol is unchanged and clients need no
+ * modification. Disabling also clears the cached secret.
+ *
+ * @param[in] enable true to enable resumption, false to disable
+ */
+void protocomm_security1_set_resumption(bool enable);
+
 #ifdef __cplusplus
 }
 #endif
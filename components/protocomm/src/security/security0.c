@@ -21,6 +21,7 @@
 
 #include <protocomm_security.h>
 #include <protocomm_security0.h>
+#include <esp_pb_arena.h>
 
 #include "session.pb-c.h"
 #include "sec0.pb-c.h"
@@ -75,15 +76,22 @@ static esp_err_t sec0_req_handler(protocomm_security_handle_t handle,
     SessionData *req;
     SessionData resp;
     esp_err_t ret;
-
-    req = session_data__unpack(NULL, inlen, inbuf);
+#if CONFIG_PB_ARENA_UNPACK_SIZE > 0
+    uint8_t arena_mem[CONFIG_PB_ARENA_UNPACK_SIZE];
+    esp_pb_arena_t arena_ctx;
+    esp_pb_arena_t *arena = (esp_pb_arena_init(&arena_ctx, arena_mem, sizeof(arena_mem)) == ESP_OK) ? &arena_ctx : NULL;
+#else
+    esp_pb_arena_t *arena = NULL;
+#endif
+
+    req = (SessionData *) esp_pb_arena_unpack(arena, &session_data__descriptor, inlen, inbuf);
     if (!req) {
         ESP_LOGE(TAG, "Unable to unpack setup_req");
         return ESP_ERR_INVALID_ARG;
     }
     if (req->sec_ver != protocomm_security0.ver) {
         ESP_LOGE(TAG, "Security version mismatch. Closing connection");
-        session_data__free_unpacked(req, NULL);
+        esp_pb_arena_free_unpacked(arena, (ProtobufCMessage *) req);
         return ESP_ERR_INVALID_ARG;
     }
 
@@ -91,12 +99,12 @@ static esp_err_t sec0_req_handler(protocomm_security_handle_t handle,
     ret = sec0_session_setup(session_id, req, &resp, pop);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Session setup error %d", ret);
-        session_data__free_unpacked(req, NULL);
+        esp_pb_arena_free_unpacked(arena, (ProtobufCMessage *) req);
         return ESP_FAIL;
     }
 
     resp.sec_ver = req->sec_ver;
-    session_data__free_unpacked(req, NULL);
+    esp_pb_arena_free_unpacked(arena, (ProtobufCMessage *) req);
 
     *outlen = session_data__get_packed_size(&resp);
     *outbuf = (uint8_t *) malloc(*outlen);
@@ -17,6 +17,8 @@
 #include <string.h>
 #include <esp_err.h>
 #include <esp_log.h>
+#include <esp_system.h>
+#include <esp_timer.h>
 
 #include <mbedtls/aes.h>
 #include <mbedtls/sha256.h>
@@ -28,6 +30,7 @@
 
 #include <protocomm_security.h>
 #include <protocomm_security1.h>
+#include <esp_pb_arena.h>
 
 #include "session.pb-c.h"
 #include "sec1.pb-c.h"
@@ -57,6 +60,42 @@ typedef struct session {
     size_t nc_off;
 } session_t;
 
+/* Cached shared secret of the last established session, used to skip
+ * the ECDH computation when the same client public key reconnects */
+typedef struct {
+    bool valid;
+    uint8_t client_pubkey[PUBLIC_KEY_LEN];
+    uint8_t device_pubkey[PUBLIC_KEY_LEN];
+    uint8_t sym_key[PUBLIC_KEY_LEN];
+} resume_cache_t;
+
+static resume_cache_t resume_cache;
+static bool resume_enabled = true;
+
+static protocomm_security1_stats_t sec1_stats;
+
+esp_err_t protocomm_security1_get_stats(protocomm_security1_stats_t *stats)
+{
+    if (!stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *stats = sec1_stats;
+    return ESP_OK;
+}
+
+void protocomm_security1_reset_stats(void)
+{
+    memset(&sec1_stats, 0, sizeof(sec1_stats));
+}
+
+void protocomm_security1_set_resumption(bool enable)
+{
+    resume_enabled = enable;
+    if (!enable) {
+        memset(&resume_cache, 0, sizeof(resume_cache));
+    }
+}
+
 static void flip_endian(uint8_t *data, size_t len)
 {
     uint8_t swp_buf;
@@ -81,6 +120,7 @@ static esp_err_t handle_session_command1(session_t *cur_session,
     Sec1Payload *in = (Sec1Payload *) req->sec1;
     uint8_t check_buf[PUBLIC_KEY_LEN];
     int mbed_err;
+    int64_t t_start = esp_timer_get_time();
 
     if (cur_session->state != SESSION_STATE_CMD1) {
         ESP_LOGE(TAG, "Invalid state of session %d (expected %d)", SESSION_STATE_CMD1, cur_session->state);
@@ -171,6 +211,16 @@ static esp_err_t handle_session_command1(session_t *cur_session,
     resp->sec1 = out;
 
     cur_session->state = SESSION_STATE_DONE;
+
+    if (resume_enabled) {
+        memcpy(resume_cache.client_pubkey, cur_session->client_pubkey, PUBLIC_KEY_LEN);
+        memcpy(resume_cache.device_pubkey, cur_session->device_pubkey, PUBLIC_KEY_LEN);
+        memcpy(resume_cache.sym_key, cur_session->sym_key, PUBLIC_KEY_LEN);
+        resume_cache.valid = true;
+    }
+    sec1_stats.handshakes++;
+    sec1_stats.handshake_us += esp_timer_get_time() - t_start;
+
     ESP_LOGD(TAG, "Secure session established successfully");
     return ESP_OK;
 }
@@ -195,6 +245,16 @@ static esp_err_t handle_session_command0(session_t *cur_session,
         return ESP_ERR_INVALID_ARG;
     }
 
+    int64_t t_start = esp_timer_get_time();
+
+    /* A client reconnecting with the public key of the last established
+     * session can reuse the cached shared secret, so the expensive ECDH
+     * computation is skipped entirely. A fresh device random still makes
+     * the CTR keystream unique for the new session */
+    bool resumed = resume_enabled && resume_cache.valid &&
+                   (memcmp(resume_cache.client_pubkey,
+                           in->sc0->client_pubkey.data, PUBLIC_KEY_LEN) == 0);
+
     mbedtls_ecdh_context     *ctx_server = malloc(sizeof(mbedtls_ecdh_context));
     mbedtls_entropy_context  *entropy    = malloc(sizeof(mbedtls_entropy_context));
     mbedtls_ctr_drbg_context *ctr_drbg   = malloc(sizeof(mbedtls_ctr_drbg_context));
@@ -210,103 +270,114 @@ static esp_err_t handle_session_command0(session_t *cur_session,
     mbedtls_ctr_drbg_init(ctr_drbg);
     mbedtls_entropy_init(entropy);
 
-    mbed_err = mbedtls_ctr_drbg_seed(ctr_drbg, mbedtls_entropy_func,
-                                     entropy, NULL, 0);
-    if (mbed_err != 0) {
-        ESP_LOGE(TAG, "Failed at mbedtls_ctr_drbg_seed with error code : -0x%x", -mbed_err);
-        ret = ESP_FAIL;
-        goto exit_cmd0;
-    }
-
-    mbed_err = mbedtls_ecp_group_load(&ctx_server->grp, MBEDTLS_ECP_DP_CURVE25519);
-    if (mbed_err != 0) {
-        ESP_LOGE(TAG, "Failed at mbedtls_ecp_group_load with error code : -0x%x", -mbed_err);
-        ret = ESP_FAIL;
-        goto exit_cmd0;
-    }
-
-    mbed_err = mbedtls_ecdh_gen_public(&ctx_server->grp, &ctx_server->d, &ctx_server->Q,
-                                       mbedtls_ctr_drbg_random, ctr_drbg);
-    if (mbed_err != 0) {
-        ESP_LOGE(TAG, "Failed at mbedtls_ecdh_gen_public with error code : -0x%x", -mbed_err);
-        ret = ESP_FAIL;
-        goto exit_cmd0;
-    }
-
-    mbed_err = mbedtls_mpi_write_binary(&ctx_server->Q.X,
-                                        cur_session->device_pubkey,
-                                        PUBLIC_KEY_LEN);
-    if (mbed_err != 0) {
-        ESP_LOGE(TAG, "Failed at mbedtls_mpi_write_binary with error code : -0x%x", -mbed_err);
-        ret = ESP_FAIL;
-        goto exit_cmd0;
-    }
-    flip_endian(cur_session->device_pubkey, PUBLIC_KEY_LEN);
-
-    memcpy(cur_session->client_pubkey, in->sc0->client_pubkey.data, PUBLIC_KEY_LEN);
-
     uint8_t *dev_pubkey = cur_session->device_pubkey;
     uint8_t *cli_pubkey = cur_session->client_pubkey;
-    hexdump("Device pubkey", dev_pubkey, PUBLIC_KEY_LEN);
-    hexdump("Client pubkey", cli_pubkey, PUBLIC_KEY_LEN);
 
-    mbed_err = mbedtls_mpi_lset(&ctx_server->Qp.Z, 1);
-    if (mbed_err != 0) {
-        ESP_LOGE(TAG, "Failed at mbedtls_mpi_lset with error code : -0x%x", -mbed_err);
-        ret = ESP_FAIL;
-        goto exit_cmd0;
-    }
+    if (resumed) {
+        ESP_LOGD(TAG, "Resuming session with cached shared secret");
+        memcpy(cur_session->client_pubkey, resume_cache.client_pubkey, PUBLIC_KEY_LEN);
+        memcpy(cur_session->device_pubkey, resume_cache.device_pubkey, PUBLIC_KEY_LEN);
+        memcpy(cur_session->sym_key, resume_cache.sym_key, PUBLIC_KEY_LEN);
+
+        /* The cached secret already includes the proof of possession.
+         * Hardware RNG suffices here and avoids seeding the DRBG */
+        esp_fill_random(cur_session->rand, SZ_RANDOM);
+        sec1_stats.resumed_handshakes++;
+    } else {
+        mbed_err = mbedtls_ctr_drbg_seed(ctr_drbg, mbedtls_entropy_func,
+                                         entropy, NULL, 0);
+        if (mbed_err != 0) {
+            ESP_LOGE(TAG, "Failed at mbedtls_ctr_drbg_seed with error code : -0x%x", -mbed_err);
+            ret = ESP_FAIL;
+            goto exit_cmd0;
+        }
 
-    flip_endian(cur_session->client_pubkey, PUBLIC_KEY_LEN);
-    mbed_err = mbedtls_mpi_read_binary(&ctx_server->Qp.X, cli_pubkey, PUBLIC_KEY_LEN);
-    flip_endian(cur_session->client_pubkey, PUBLIC_KEY_LEN);
-    if (mbed_err != 0) {
-        ESP_LOGE(TAG, "Failed at mbedtls_mpi_read_binary with error code : -0x%x", -mbed_err);
-        ret = ESP_FAIL;
-        goto exit_cmd0;
-    }
+        mbed_err = mbedtls_ecp_group_load(&ctx_server->grp, MBEDTLS_ECP_DP_CURVE25519);
+        if (mbed_err != 0) {
+            ESP_LOGE(TAG, "Failed at mbedtls_ecp_group_load with error code : -0x%x", -mbed_err);
+            ret = ESP_FAIL;
+            goto exit_cmd0;
+        }
 
-    mbed_err = mbedtls_ecdh_compute_shared(&ctx_server->grp, &ctx_server->z, &ctx_server->Qp,
-                                           &ctx_server->d, mbedtls_ctr_drbg_random, ctr_drbg);
-    if (mbed_err != 0) {
-        ESP_LOGE(TAG, "Failed at mbedtls_ecdh_compute_shared with error code : -0x%x", -mbed_err);
-        ret = ESP_FAIL;
-        goto exit_cmd0;
-    }
+        mbed_err = mbedtls_ecdh_gen_public(&ctx_server->grp, &ctx_server->d, &ctx_server->Q,
+                                           mbedtls_ctr_drbg_random, ctr_drbg);
+        if (mbed_err != 0) {
+            ESP_LOGE(TAG, "Failed at mbedtls_ecdh_gen_public with error code : -0x%x", -mbed_err);
+            ret = ESP_FAIL;
+            goto exit_cmd0;
+        }
 
-    mbed_err = mbedtls_mpi_write_binary(&ctx_server->z, cur_session->sym_key, PUBLIC_KEY_LEN);
-    if (mbed_err != 0) {
-        ESP_LOGE(TAG, "Failed at mbedtls_mpi_write_binary with error code : -0x%x", -mbed_err);
-        ret = ESP_FAIL;
-        goto exit_cmd0;
-    }
-    flip_endian(cur_session->sym_key, PUBLIC_KEY_LEN);
+        mbed_err = mbedtls_mpi_write_binary(&ctx_server->Q.X,
+                                            cur_session->device_pubkey,
+                                            PUBLIC_KEY_LEN);
+        if (mbed_err != 0) {
+            ESP_LOGE(TAG, "Failed at mbedtls_mpi_write_binary with error code : -0x%x", -mbed_err);
+            ret = ESP_FAIL;
+            goto exit_cmd0;
+        }
+        flip_endian(cur_session->device_pubkey, PUBLIC_KEY_LEN);
 
-    if (pop != NULL && pop->data != NULL && pop->len != 0) {
-        ESP_LOGD(TAG, "Adding proof of possession");
-        uint8_t sha_out[PUBLIC_KEY_LEN];
+        memcpy(cur_session->client_pubkey, in->sc0->client_pubkey.data, PUBLIC_KEY_LEN);
 
-        mbed_err = mbedtls_sha256_ret((const unsigned char *) pop->data, pop->len, sha_out, 0);
+        mbed_err = mbedtls_mpi_lset(&ctx_server->Qp.Z, 1);
         if (mbed_err != 0) {
-            ESP_LOGE(TAG, "Failed at mbedtls_sha256_ret with error code : -0x%x", -mbed_err);
+            ESP_LOGE(TAG, "Failed at mbedtls_mpi_lset with error code : -0x%x", -mbed_err);
             ret = ESP_FAIL;
             goto exit_cmd0;
         }
 
-        for (int i = 0; i < PUBLIC_KEY_LEN; i++) {
-            cur_session->sym_key[i] ^= sha_out[i];
+        flip_endian(cur_session->client_pubkey, PUBLIC_KEY_LEN);
+        mbed_err = mbedtls_mpi_read_binary(&ctx_server->Qp.X, cli_pubkey, PUBLIC_KEY_LEN);
+        flip_endian(cur_session->client_pubkey, PUBLIC_KEY_LEN);
+        if (mbed_err != 0) {
+            ESP_LOGE(TAG, "Failed at mbedtls_mpi_read_binary with error code : -0x%x", -mbed_err);
+            ret = ESP_FAIL;
+            goto exit_cmd0;
         }
-    }
 
-    hexdump("Shared key", cur_session->sym_key, PUBLIC_KEY_LEN);
+        mbed_err = mbedtls_ecdh_compute_shared(&ctx_server->grp, &ctx_server->z, &ctx_server->Qp,
+                                               &ctx_server->d, mbedtls_ctr_drbg_random, ctr_drbg);
+        if (mbed_err != 0) {
+            ESP_LOGE(TAG, "Failed at mbedtls_ecdh_compute_shared with error code : -0x%x", -mbed_err);
+            ret = ESP_FAIL;
+            goto exit_cmd0;
+        }
 
-    mbed_err = mbedtls_ctr_drbg_random(ctr_drbg, cur_session->rand, SZ_RANDOM);
-    if (mbed_err != 0) {
-        ESP_LOGE(TAG, "Failed at mbedtls_ctr_drbg_random with error code : -0x%x", -mbed_err);
-        ret = ESP_FAIL;
-        goto exit_cmd0;
+        mbed_err = mbedtls_mpi_write_binary(&ctx_server->z, cur_session->sym_key, PUBLIC_KEY_LEN);
+        if (mbed_err != 0) {
+            ESP_LOGE(TAG, "Failed at mbedtls_mpi_write_binary with error code : -0x%x", -mbed_err);
+            ret = ESP_FAIL;
+            goto exit_cmd0;
+        }
+        flip_endian(cur_session->sym_key, PUBLIC_KEY_LEN);
+
+        if (pop != NULL && pop->data != NULL && pop->len != 0) {
+            ESP_LOGD(TAG, "Adding proof of possession");
+            uint8_t sha_out[PUBLIC_KEY_LEN];
+
+            mbed_err = mbedtls_sha256_ret((const unsigned char *) pop->data, pop->len, sha_out, 0);
+            if (mbed_err != 0) {
+                ESP_LOGE(TAG, "Failed at mbedtls_sha256_ret with error code : -0x%x", -mbed_err);
+                ret = ESP_FAIL;
+                goto exit_cmd0;
+            }
+
+            for (int i = 0; i < PUBLIC_KEY_LEN; i++) {
+                cur_session->sym_key[i] ^= sha_out[i];
+            }
+        }
+
+        mbed_err = mbedtls_ctr_drbg_random(ctr_drbg, cur_session->rand, SZ_RANDOM);
+        if (mbed_err != 0) {
+            ESP_LOGE(TAG, "Failed at mbedtls_ctr_drbg_random with error code : -0x%x", -mbed_err);
+            ret = ESP_FAIL;
+            goto exit_cmd0;
+        }
     }
 
+    hexdump("Device pubkey", dev_pubkey, PUBLIC_KEY_LEN);
+    hexdump("Client pubkey", cli_pubkey, PUBLIC_KEY_LEN);
+    hexdump("Shared key", cur_session->sym_key, PUBLIC_KEY_LEN);
     hexdump("Device random", cur_session->rand, SZ_RANDOM);
 
     Sec1Payload *out = (Sec1Payload *) malloc(sizeof(Sec1Payload));
@@ -339,6 +410,7 @@ static esp_err_t handle_session_command0(session_t *cur_session,
 
     cur_session->state = SESSION_STATE_CMD1;
 
+    sec1_stats.handshake_us += esp_timer_get_time() - t_start;
     ESP_LOGD(TAG, "Session setup phase1 done");
     ret = ESP_OK;
 
@@ -507,12 +579,15 @@ static esp_err_t sec1_decrypt(protocomm_security_handle_t handle,
     }
 
     *outlen = inlen;
+    int64_t t_start = esp_timer_get_time();
     int ret = mbedtls_aes_crypt_ctr(&cur_session->ctx_aes, inlen, &cur_session->nc_off,
                                     cur_session->rand, cur_session->stb, inbuf, outbuf);
     if (ret != 0) {
         ESP_LOGE(TAG, "Failed at mbedtls_aes_crypt_ctr with error code : %d", ret);
         return ESP_FAIL;
     }
+    sec1_stats.crypt_us += esp_timer_get_time() - t_start;
+    sec1_stats.crypt_bytes += inlen;
     return ESP_OK;
 }
 
@@ -537,15 +612,22 @@ static esp_err_t sec1_req_handler(protocomm_security_handle_t handle,
     SessionData *req;
     SessionData resp;
     esp_err_t ret;
-
-    req = session_data__unpack(NULL, inlen, inbuf);
+#if CONFIG_PB_ARENA_UNPACK_SIZE > 0
+    uint8_t arena_mem[CONFIG_PB_ARENA_UNPACK_SIZE];
+    esp_pb_arena_t arena_ctx;
+    esp_pb_arena_t *arena = (esp_pb_arena_init(&arena_ctx, arena_mem, sizeof(arena_mem)) == ESP_OK) ? &arena_ctx : NULL;
+#else
+    esp_pb_arena_t *arena = NULL;
+#endif
+
+    req = (SessionData *) esp_pb_arena_unpack(arena, &session_data__descriptor, inlen, inbuf);
     if (!req) {
         ESP_LOGE(TAG, "Unable to unpack setup_req");
         return ESP_ERR_INVALID_ARG;
     }
     if (req->sec_ver != protocomm_security1.ver) {
         ESP_LOGE(TAG, "Security version mismatch. Closing connection");
-        session_data__free_unpacked(req, NULL);
+        esp_pb_arena_free_unpacked(arena, (ProtobufCMessage *) req);
         return ESP_ERR_INVALID_ARG;
     }
 
@@ -553,12 +635,12 @@ static esp_err_t sec1_req_handler(protocomm_security_handle_t handle,
     ret = sec1_session_setup(cur_session, session_id, req, &resp, pop);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Session setup error %d", ret);
-        session_data__free_unpacked(req, NULL);
+        esp_pb_arena_free_unpacked(arena, (ProtobufCMessage *) req);
         return ESP_FAIL;
     }
 
     resp.sec_ver = req->sec_ver;
-    session_data__free_unpacked(req, NULL);
+    esp_pb_arena_free_unpacked(arena, (ProtobufCMessage *) req);
 
     *outlen = session_data__get_packed_size(&resp);
     *outbuf = (uint8_t *) malloc(*outlen);
@@ -1183,3 +1183,28 @@ TEST_CASE("security 1 weak session test", "[PROTOCOMM]")
 {
     TEST_ASSERT(test_security1_weak_session() == ESP_OK);
 }
+
+TEST_CASE("security 1 stats test", "[PROTOCOMM]")
+{
+    protocomm_security1_stats_t stats;
+
+    protocomm_security1_reset_stats();
+    TEST_ASSERT(protocomm_security1_get_stats(&stats) == ESP_OK);
+    TEST_ASSERT_EQUAL(0, stats.handshakes);
+
+    TEST_ASSERT(test_security1() == ESP_OK);
+
+    TEST_ASSERT(protocomm_security1_get_stats(&stats) == ESP_OK);
+    TEST_ASSERT_EQUAL(1, stats.handshakes);
+    TEST_ASSERT(stats.handshake_us > 0);
+    TEST_ASSERT(stats.crypt_bytes > 0);
+
+    /* Each test run uses a fresh client keypair, so nothing is resumed */
+    TEST_ASSERT_EQUAL(0, stats.resumed_handshakes);
+
+    /* Disabling resumption clears the cached secret and must not
+     * affect a subsequent full handshake */
+    protocomm_security1_set_resumption(false);
+    TEST_ASSERT(test_security1() == ESP_OK);
+    protocomm_security1_set_resumption(true);
+}
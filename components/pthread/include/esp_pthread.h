@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <stdint.h>
+#include <pthread.h>
 #include "esp_err.h"
 #include "freertos/FreeRTOSConfig.h"
 
@@ -87,6 +89,33 @@ esp_err_t esp_pthread_get_cfg(esp_pthread_cfg_t *p);
  */
 esp_err_t esp_pthread_init(void);
 
+#ifdef CONFIG_PTHREAD_RWLOCK_STATS
+/** Reader-writer lock contention counters, see esp_pthread_rwlock_get_stats */
+typedef struct {
+    uint32_t read_locks;        ///< Successful read lock acquisitions
+    uint32_t write_locks;       ///< Successful write lock acquisitions
+    uint32_t read_contentions;  ///< Read lock attempts that found the lock taken
+    uint32_t write_contentions; ///< Write lock attempts that found the lock taken
+    uint32_t spin_acquisitions; ///< Acquisitions that succeeded while spinning, see CONFIG_PTHREAD_RWLOCK_SPIN_COUNT
+} esp_pthread_rwlock_stats_t;
+
+/**
+ * @brief Get the contention counters of a reader-writer lock
+ *
+ * The counters are cumulative since pthread_rwlock_init. They help to decide
+ * whether a read-mostly shared structure actually benefits from a
+ * reader-writer lock, or whether writers serialize it anyway.
+ *
+ * @param rwlock The reader-writer lock to query
+ * @param stats Pointer to the structure that receives a snapshot of the counters
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if rwlock is not initialized or stats is NULL
+ */
+esp_err_t esp_pthread_rwlock_get_stats(pthread_rwlock_t *rwlock, esp_pthread_rwlock_stats_t *stats);
+#endif // CONFIG_PTHREAD_RWLOCK_STATS
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,363 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// This is a simple implementation of pthread reader-writer locks, built on
+// top of the pthread mutex and condition variable implementations in this
+// component. The state (reader count, writer flag, waiter counts) is guarded
+// by an internal mutex; contended lockers wait on a single condition variable
+// which is broadcast whenever the lock becomes free, and re-check the state
+// after waking up. By default readers may acquire the lock while a writer is
+// waiting; CONFIG_PTHREAD_RWLOCK_WRITER_PREFERENCE blocks new readers as soon
+// as a writer queues up.
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include "esp_err.h"
+#include "esp_pthread.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#ifdef CONFIG_PTHREAD_RWLOCK_STATS
+#define RWLOCK_STATS_INC(rwlock, field) do { (rwlock)->stats.field++; } while (0)
+#else
+#define RWLOCK_STATS_INC(rwlock, field)
+#endif
+
+typedef struct esp_pthread_rwlock {
+    pthread_mutex_t mutex;         ///< protects all the fields below
+    pthread_cond_t cv;             ///< contended lockers wait here for the lock to be released
+    uint32_t active_readers;       ///< number of threads holding the lock for reading
+    uint32_t waiting_readers;      ///< number of threads blocked in a read lock call
+    uint32_t waiting_writers;      ///< number of threads blocked in a write lock call
+    bool writer_active;            ///< a thread holds the lock for writing
+#ifdef CONFIG_PTHREAD_RWLOCK_STATS
+    esp_pthread_rwlock_stats_t stats;  ///< see esp_pthread_rwlock_get_stats
+#endif
+} esp_pthread_rwlock_t;
+
+static portMUX_TYPE s_rwlock_init_lock = portMUX_INITIALIZER_UNLOCKED;
+
+int pthread_rwlock_init(pthread_rwlock_t *rwlock, const pthread_rwlockattr_t *attr)
+{
+    if (rwlock == NULL) {
+        return EINVAL;
+    }
+
+    if (attr != NULL && !attr->is_initialized) {
+        return EINVAL;
+    }
+
+    esp_pthread_rwlock_t *rw = (esp_pthread_rwlock_t *) calloc(1, sizeof(esp_pthread_rwlock_t));
+    if (rw == NULL) {
+        return ENOMEM;
+    }
+
+    int res = pthread_mutex_init(&rw->mutex, NULL);
+    if (res != 0) {
+        free(rw);
+        return res;
+    }
+    res = pthread_cond_init(&rw->cv, NULL);
+    if (res != 0) {
+        pthread_mutex_destroy(&rw->mutex);
+        free(rw);
+        return res;
+    }
+
+    *rwlock = (pthread_rwlock_t) rw;
+    return 0;
+}
+
+static int pthread_rwlock_init_if_static(pthread_rwlock_t *rwlock)
+{
+    int res = 0;
+#ifdef PTHREAD_RWLOCK_INITIALIZER
+    /* Not every newlib version provides a static rwlock initializer */
+    if ((intptr_t) *rwlock == (intptr_t) PTHREAD_RWLOCK_INITIALIZER) {
+        portENTER_CRITICAL(&s_rwlock_init_lock);
+        if ((intptr_t) *rwlock == (intptr_t) PTHREAD_RWLOCK_INITIALIZER) {
+            res = pthread_rwlock_init(rwlock, NULL);
+        }
+        portEXIT_CRITICAL(&s_rwlock_init_lock);
+    }
+#endif
+    return res;
+}
+
+int pthread_rwlock_destroy(pthread_rwlock_t *rwlock)
+{
+    if (rwlock == NULL || *rwlock == (pthread_rwlock_t) 0) {
+        return EINVAL;
+    }
+
+    esp_pthread_rwlock_t *rw = (esp_pthread_rwlock_t *) *rwlock;
+
+    int res = pthread_mutex_lock(&rw->mutex);
+    if (res != 0) {
+        return res;
+    }
+    if (rw->writer_active || rw->active_readers > 0 ||
+            rw->waiting_readers > 0 || rw->waiting_writers > 0) {
+        pthread_mutex_unlock(&rw->mutex);
+        return EBUSY;
+    }
+    pthread_mutex_unlock(&rw->mutex);
+
+    *rwlock = (pthread_rwlock_t) 0;
+    pthread_cond_destroy(&rw->cv);
+    pthread_mutex_destroy(&rw->mutex);
+    free(rw);
+
+    return 0;
+}
+
+static inline bool pthread_rwlock_can_lock(esp_pthread_rwlock_t *rw, bool write)
+{
+    if (rw->writer_active) {
+        return false;
+    }
+    if (write) {
+        return rw->active_readers == 0;
+    }
+#ifdef CONFIG_PTHREAD_RWLOCK_WRITER_PREFERENCE
+    return rw->waiting_writers == 0;
+#else
+    return true;
+#endif
+}
+
+static int pthread_rwlock_lock_internal(esp_pthread_rwlock_t *rw, bool write, bool dontblock,
+                                        bool spinning, const struct timespec *to)
+{
+    int res = pthread_mutex_lock(&rw->mutex);
+    if (res != 0) {
+        return res;
+    }
+
+    bool contended = false;
+    while (!pthread_rwlock_can_lock(rw, write)) {
+        if (!contended && !spinning) {
+            contended = true;
+            if (write) {
+                RWLOCK_STATS_INC(rw, write_contentions);
+            } else {
+                RWLOCK_STATS_INC(rw, read_contentions);
+            }
+        }
+        if (dontblock) {
+            pthread_mutex_unlock(&rw->mutex);
+            return EBUSY;
+        }
+        if (write) {
+            rw->waiting_writers++;
+        } else {
+            rw->waiting_readers++;
+        }
+        res = pthread_cond_timedwait(&rw->cv, &rw->mutex, to);
+        if (write) {
+            rw->waiting_writers--;
+        } else {
+            rw->waiting_readers--;
+        }
+        if (res != 0) {
+#ifdef CONFIG_PTHREAD_RWLOCK_WRITER_PREFERENCE
+            /* A timed-out writer may have been the only thing keeping readers
+             * out of an otherwise free lock; wake them up to re-check.
+             */
+            if (write && rw->waiting_writers == 0 && rw->waiting_readers > 0) {
+                pthread_cond_broadcast(&rw->cv);
+            }
+#endif
+            pthread_mutex_unlock(&rw->mutex);
+            return res;
+        }
+    }
+
+    if (write) {
+        rw->writer_active = true;
+        RWLOCK_STATS_INC(rw, write_locks);
+    } else {
+        rw->active_readers++;
+        RWLOCK_STATS_INC(rw, read_locks);
+    }
+    if (spinning) {
+        RWLOCK_STATS_INC(rw, spin_acquisitions);
+    }
+    pthread_mutex_unlock(&rw->mutex);
+    return 0;
+}
+
+#if CONFIG_PTHREAD_RWLOCK_SPIN_COUNT > 0 && portNUM_PROCESSORS > 1
+/* Bounded retry before blocking. Only worthwhile on multicore, where the lock
+ * holder can release the lock while we retry; on a single core the holder
+ * cannot run until we block.
+ */
+static int pthread_rwlock_spin(esp_pthread_rwlock_t *rw, bool write)
+{
+    for (int i = 0; i < CONFIG_PTHREAD_RWLOCK_SPIN_COUNT; i++) {
+        if (pthread_rwlock_lock_internal(rw, write, true, true, NULL) == 0) {
+            return 0;
+        }
+    }
+    return EBUSY;
+}
+#else
+static inline int pthread_rwlock_spin(esp_pthread_rwlock_t *rw, bool write)
+{
+    return EBUSY;
+}
+#endif
+
+static int pthread_rwlock_lock(pthread_rwlock_t *rwlock, bool write, bool dontblock,
+                               const struct timespec *to)
+{
+    if (rwlock == NULL) {
+        return EINVAL;
+    }
+    int res = pthread_rwlock_init_if_static(rwlock);
+    if (res != 0) {
+        return res;
+    }
+    if (*rwlock == (pthread_rwlock_t) 0) {
+        return EINVAL;
+    }
+
+    esp_pthread_rwlock_t *rw = (esp_pthread_rwlock_t *) *rwlock;
+
+    if (!dontblock && pthread_rwlock_spin(rw, write) == 0) {
+        return 0;
+    }
+    return pthread_rwlock_lock_internal(rw, write, dontblock, false, to);
+}
+
+int pthread_rwlock_rdlock(pthread_rwlock_t *rwlock)
+{
+    return pthread_rwlock_lock(rwlock, false, false, NULL);
+}
+
+int pthread_rwlock_tryrdlock(pthread_rwlock_t *rwlock)
+{
+    return pthread_rwlock_lock(rwlock, false, true, NULL);
+}
+
+int pthread_rwlock_timedrdlock(pthread_rwlock_t *rwlock, const struct timespec *to)
+{
+    if (to == NULL) {
+        return EINVAL;
+    }
+    return pthread_rwlock_lock(rwlock, false, false, to);
+}
+
+int pthread_rwlock_wrlock(pthread_rwlock_t *rwlock)
+{
+    return pthread_rwlock_lock(rwlock, true, false, NULL);
+}
+
+int pthread_rwlock_trywrlock(pthread_rwlock_t *rwlock)
+{
+    return pthread_rwlock_lock(rwlock, true, true, NULL);
+}
+
+int pthread_rwlock_timedwrlock(pthread_rwlock_t *rwlock, const struct timespec *to)
+{
+    if (to == NULL) {
+        return EINVAL;
+    }
+    return pthread_rwlock_lock(rwlock, true, false, to);
+}
+
+int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
+{
+    if (rwlock == NULL || *rwlock == (pthread_rwlock_t) 0) {
+        return EINVAL;
+    }
+
+    esp_pthread_rwlock_t *rw = (esp_pthread_rwlock_t *) *rwlock;
+
+    int res = pthread_mutex_lock(&rw->mutex);
+    if (res != 0) {
+        return res;
+    }
+    if (rw->writer_active) {
+        rw->writer_active = false;
+    } else if (rw->active_readers > 0) {
+        rw->active_readers--;
+    } else {
+        res = EPERM;
+    }
+    if (res == 0 && !rw->writer_active && rw->active_readers == 0) {
+        pthread_cond_broadcast(&rw->cv);
+    }
+    pthread_mutex_unlock(&rw->mutex);
+    return res;
+}
+
+#ifdef CONFIG_PTHREAD_RWLOCK_STATS
+esp_err_t esp_pthread_rwlock_get_stats(pthread_rwlock_t *rwlock, esp_pthread_rwlock_stats_t *stats)
+{
+    if (rwlock == NULL || *rwlock == (pthread_rwlock_t) 0 || stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_pthread_rwlock_t *rw = (esp_pthread_rwlock_t *) *rwlock;
+
+    pthread_mutex_lock(&rw->mutex);
+    *stats = rw->stats;
+    pthread_mutex_unlock(&rw->mutex);
+    return ESP_OK;
+}
+#endif // CONFIG_PTHREAD_RWLOCK_STATS
+
+int pthread_rwlockattr_init(pthread_rwlockattr_t *attr)
+{
+    if (attr == NULL) {
+        return EINVAL;
+    }
+    attr->is_initialized = 1;
+    attr->process_shared = PTHREAD_PROCESS_PRIVATE;
+    return 0;
+}
+
+int pthread_rwlockattr_destroy(pthread_rwlockattr_t *attr)
+{
+    if (attr == NULL) {
+        return EINVAL;
+    }
+    attr->is_initialized = 0;
+    return 0;
+}
+
+int pthread_rwlockattr_getpshared(const pthread_rwlockattr_t *attr, int *pshared)
+{
+    if (attr == NULL || pshared == NULL) {
+        return EINVAL;
+    }
+    *pshared = attr->process_shared;
+    return 0;
+}
+
+int pthread_rwlockattr_setpshared(pthread_rwlockattr_t *attr, int pshared)
+{
+    if (attr == NULL || pshared != PTHREAD_PROCESS_PRIVATE) {
+        return EINVAL;
+    }
+    attr->process_shared = pshared;
+    return 0;
+}
+
+/* Hook function to force linking this file */
+void pthread_include_pthread_rwlock_impl(void)
+{
+}
@@ -260,6 +260,62 @@ static void timespec_add_nano(struct timespec * out, struct timespec * in, long
     }
 }
 
+TEST_CASE("pthread rwlock read write lock", "[pthread]")
+{
+    int res = 0;
+    volatile bool rwlock_created = false;
+    pthread_rwlock_t rwlock;
+    struct timespec abs_timeout;
+
+    if (TEST_PROTECT()) {
+        res = pthread_rwlock_init(&rwlock, NULL);
+        TEST_ASSERT_EQUAL_INT(0, res);
+        rwlock_created = true;
+
+        /* Multiple readers are admitted concurrently */
+        res = pthread_rwlock_rdlock(&rwlock);
+        TEST_ASSERT_EQUAL_INT(0, res);
+
+        res = pthread_rwlock_tryrdlock(&rwlock);
+        TEST_ASSERT_EQUAL_INT(0, res);
+
+        /* Writers are kept out while readers hold the lock */
+        res = pthread_rwlock_trywrlock(&rwlock);
+        TEST_ASSERT_EQUAL_INT(EBUSY, res);
+
+        clock_gettime(CLOCK_REALTIME, &abs_timeout);
+        timespec_add_nano(&abs_timeout, &abs_timeout, 100000000LL);
+
+        res = pthread_rwlock_timedwrlock(&rwlock, &abs_timeout);
+        TEST_ASSERT_EQUAL_INT(ETIMEDOUT, res);
+
+        res = pthread_rwlock_unlock(&rwlock);
+        TEST_ASSERT_EQUAL_INT(0, res);
+        res = pthread_rwlock_unlock(&rwlock);
+        TEST_ASSERT_EQUAL_INT(0, res);
+
+        /* A writer excludes both readers and other writers */
+        res = pthread_rwlock_wrlock(&rwlock);
+        TEST_ASSERT_EQUAL_INT(0, res);
+
+        res = pthread_rwlock_tryrdlock(&rwlock);
+        TEST_ASSERT_EQUAL_INT(EBUSY, res);
+
+        res = pthread_rwlock_trywrlock(&rwlock);
+        TEST_ASSERT_EQUAL_INT(EBUSY, res);
+
+        res = pthread_rwlock_unlock(&rwlock);
+        TEST_ASSERT_EQUAL_INT(0, res);
+
+        res = pthread_rwlock_unlock(&rwlock);
+        TEST_ASSERT_EQUAL_INT(EPERM, res);
+    }
+
+    if (rwlock_created) {
+        TEST_ASSERT_EQUAL_INT(0, pthread_rwlock_destroy(&rwlock));
+    }
+}
+
 TEST_CASE("pthread mutex trylock timedlock", "[pthread]")
 {
     int res = 0;
@@ -0,0 +1,119 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "esp_err.h"
+#include "driver/sdmmc_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Handle of a sector cache attached to an SD/MMC card
+ */
+typedef struct sdmmc_cache_t* sdmmc_cache_handle_t;
+
+/**
+ * Create a sector read-ahead / write-coalescing cache for the given card
+ *
+ * The cache holds one window of consecutive sectors in a DMA-capable buffer.
+ * Small reads trigger a read-ahead of the whole window in a single command;
+ * consecutive small writes are coalesced in the window and written out with
+ * a single multi-block command when the window is flushed or replaced.
+ *
+ * The cache is only aware of accesses going through its own read/write
+ * functions. Don't mix them with direct sdmmc_read_sectors/sdmmc_write_sectors
+ * calls to overlapping sectors without calling sdmmc_cache_flush first.
+ *
+ * @param card  pointer to card information structure previously initialized
+ *              using sdmmc_card_init
+ * @param cache_sectors  size of the cache window, in sectors
+ * @param[out] out_handle  handle of the created cache
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if card or out_handle is NULL, or cache_sectors is 0
+ *      - ESP_ERR_NO_MEM if the window buffer can not be allocated
+ */
+esp_err_t sdmmc_cache_create(sdmmc_card_t* card, size_t cache_sectors,
+        sdmmc_cache_handle_t* out_handle);
+
+/**
+ * Read sectors through the cache
+ *
+ * Reads which fit into the cached window are served from memory. Other reads
+ * smaller than the window flush pending writes and fetch a full window
+ * starting at start_sector; reads of at least the window size bypass the
+ * cache.
+ *
+ * @param handle  cache handle obtained from sdmmc_cache_create
+ * @param dst  buffer which receives the data; size must be at least
+ *             sector_count * card->csd.sector_size
+ * @param start_sector  sector where to start reading
+ * @param sector_count  number of sectors to read
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from SDMMC host controller
+ */
+esp_err_t sdmmc_cache_read_sectors(sdmmc_cache_handle_t handle, void* dst,
+        size_t start_sector, size_t sector_count);
+
+/**
+ * Write sectors through the cache
+ *
+ * Writes which extend or overwrite the current write window are coalesced in
+ * memory. Other writes smaller than the window flush pending data and start a
+ * new window; writes of at least the window size bypass the cache.
+ *
+ * @param handle  cache handle obtained from sdmmc_cache_create
+ * @param src  buffer with data to write; size must be at least
+ *             sector_count * card->csd.sector_size
+ * @param start_sector  sector where to start writing
+ * @param sector_count  number of sectors to write
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from SDMMC host controller
+ */
+esp_err_t sdmmc_cache_write_sectors(sdmmc_cache_handle_t handle, const void* src,
+        size_t start_sector, size_t sector_count);
+
+/**
+ * Write any pending coalesced data to the card and drop the cached window
+ *
+ * After this call the card contents match what was written through the cache,
+ * and the next cached read will fetch fresh data, so this can be used as a
+ * barrier around direct sdmmc_read_sectors/sdmmc_write_sectors access.
+ *
+ * @param handle  cache handle obtained from sdmmc_cache_create
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from SDMMC host controller
+ */
+esp_err_t sdmmc_cache_flush(sdmmc_cache_handle_t handle);
+
+/**
+ * Flush and delete the cache
+ *
+ * @param handle  cache handle obtained from sdmmc_cache_create
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from SDMMC host controller, if flushing
+ *        pending data failed; the cache is not deleted in this case
+ */
+esp_err_t sdmmc_cache_delete(sdmmc_cache_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif
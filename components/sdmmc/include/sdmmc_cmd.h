@@ -77,6 +77,48 @@ esp_err_t sdmmc_write_sectors(sdmmc_card_t* card, const void* src,
 esp_err_t sdmmc_read_sectors(sdmmc_card_t* card, void* dst,
         size_t start_sector, size_t sector_count);
 
+/**
+ * Write sectors from multiple scattered buffers using a single command
+ *
+ * All fragments are written to consecutive sectors, starting at start_sector.
+ * Each fragment size must be a multiple of the card sector size. When the host
+ * supports scatter-gather DMA (SDMMC host) and all fragments are DMA capable,
+ * a single write command is issued for the whole list; otherwise the function
+ * falls back to writing the fragments one by one.
+ *
+ * @param card  pointer to card information structure previously initialized
+ *              using sdmmc_card_init
+ * @param frags  array of data fragments to write
+ * @param frag_count  number of entries in frags
+ * @param start_sector  sector where to start writing
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from SDMMC host controller
+ */
+esp_err_t sdmmc_write_sectors_sg(sdmmc_card_t* card, const sdmmc_sg_frag_t* frags,
+        size_t frag_count, size_t start_sector);
+
+/**
+ * Read sectors into multiple scattered buffers using a single command
+ *
+ * Consecutive sectors, starting at start_sector, are read into the fragments
+ * in order. Each fragment size must be a multiple of the card sector size.
+ * When the host supports scatter-gather DMA (SDMMC host) and all fragments
+ * are DMA capable, a single read command is issued for the whole list;
+ * otherwise the function falls back to reading the fragments one by one.
+ *
+ * @param card  pointer to card information structure previously initialized
+ *              using sdmmc_card_init
+ * @param frags  array of data fragments to read into
+ * @param frag_count  number of entries in frags
+ * @param start_sector  sector where to start reading
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from SDMMC host controller
+ */
+esp_err_t sdmmc_read_sectors_sg(sdmmc_card_t* card, const sdmmc_sg_frag_t* frags,
+        size_t frag_count, size_t start_sector);
+
 /**
  * Read one byte from an SDIO card using IO_RW_DIRECT (CMD52)
  *
@@ -0,0 +1,217 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "sdmmc_cmd.h"
+#include "sdmmc_cache.h"
+
+static const char* TAG = "sdmmc_cache";
+
+/* The cache holds a single window of consecutive sectors. The window is
+ * either clean (a read-ahead copy of card contents) or dirty (coalesced
+ * writes which haven't been sent to the card yet).
+ */
+struct sdmmc_cache_t {
+    sdmmc_card_t* card;
+    uint8_t* buf;               // window buffer, DMA capable
+    size_t cache_sectors;       // window capacity, in sectors
+    size_t sector_size;
+    size_t start;               // first sector held in the window
+    size_t count;               // number of valid sectors in the window
+    bool dirty;                 // window holds data not yet written to the card
+    SemaphoreHandle_t mutex;
+};
+
+static esp_err_t sdmmc_cache_flush_internal(struct sdmmc_cache_t* cache)
+{
+    if (!cache->dirty || cache->count == 0) {
+        return ESP_OK;
+    }
+    esp_err_t err = sdmmc_write_sectors(cache->card, cache->buf,
+            cache->start, cache->count);
+    if (err != ESP_OK) {
+        ESP_LOGD(TAG, "%s: error 0x%x writing %d sectors at %d",
+                __func__, err, cache->count, cache->start);
+        return err;
+    }
+    // keep the window contents around as a clean read cache
+    cache->dirty = false;
+    return ESP_OK;
+}
+
+esp_err_t sdmmc_cache_create(sdmmc_card_t* card, size_t cache_sectors,
+        sdmmc_cache_handle_t* out_handle)
+{
+    if (card == NULL || out_handle == NULL || cache_sectors == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    struct sdmmc_cache_t* cache = calloc(1, sizeof(struct sdmmc_cache_t));
+    if (cache == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    cache->card = card;
+    cache->cache_sectors = cache_sectors;
+    cache->sector_size = card->csd.sector_size;
+    cache->buf = heap_caps_malloc(cache_sectors * cache->sector_size, MALLOC_CAP_DMA);
+    cache->mutex = xSemaphoreCreateMutex();
+    if (cache->buf == NULL || cache->mutex == NULL) {
+        if (cache->mutex) {
+            vSemaphoreDelete(cache->mutex);
+        }
+        free(cache->buf);
+        free(cache);
+        return ESP_ERR_NO_MEM;
+    }
+    *out_handle = cache;
+    return ESP_OK;
+}
+
+esp_err_t sdmmc_cache_read_sectors(sdmmc_cache_handle_t handle, void* dst,
+        size_t start_sector, size_t sector_count)
+{
+    if (handle == NULL || dst == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (sector_count == 0) {
+        return ESP_OK;
+    }
+    struct sdmmc_cache_t* cache = handle;
+    if (start_sector + sector_count > cache->card->csd.capacity) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    esp_err_t err = ESP_OK;
+    xSemaphoreTake(cache->mutex, portMAX_DELAY);
+    if (cache->count > 0 && start_sector >= cache->start &&
+            start_sector + sector_count <= cache->start + cache->count) {
+        // whole request is in the window (clean or dirty)
+        memcpy(dst, cache->buf + (start_sector - cache->start) * cache->sector_size,
+                sector_count * cache->sector_size);
+    } else {
+        // commit pending writes before touching the card
+        err = sdmmc_cache_flush_internal(cache);
+        if (err == ESP_OK) {
+            if (sector_count >= cache->cache_sectors) {
+                // large read, not worth caching
+                err = sdmmc_read_sectors(cache->card, dst, start_sector, sector_count);
+            } else {
+                // read ahead a full window starting at the requested sector
+                size_t fetch = cache->cache_sectors;
+                if (start_sector + fetch > cache->card->csd.capacity) {
+                    fetch = cache->card->csd.capacity - start_sector;
+                }
+                err = sdmmc_read_sectors(cache->card, cache->buf, start_sector, fetch);
+                if (err == ESP_OK) {
+                    cache->start = start_sector;
+                    cache->count = fetch;
+                    cache->dirty = false;
+                    memcpy(dst, cache->buf, sector_count * cache->sector_size);
+                } else {
+                    cache->count = 0;
+                }
+            }
+        }
+    }
+    xSemaphoreGive(cache->mutex);
+    return err;
+}
+
+esp_err_t sdmmc_cache_write_sectors(sdmmc_cache_handle_t handle, const void* src,
+        size_t start_sector, size_t sector_count)
+{
+    if (handle == NULL || src == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (sector_count == 0) {
+        return ESP_OK;
+    }
+    struct sdmmc_cache_t* cache = handle;
+    if (start_sector + sector_count > cache->card->csd.capacity) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    esp_err_t err = ESP_OK;
+    xSemaphoreTake(cache->mutex, portMAX_DELAY);
+    if (sector_count >= cache->cache_sectors) {
+        // large write, not worth coalescing; commit pending data first so
+        // that writes reach the card in order
+        err = sdmmc_cache_flush_internal(cache);
+        if (err == ESP_OK) {
+            if (cache->count > 0 && start_sector < cache->start + cache->count &&
+                    start_sector + sector_count > cache->start) {
+                // drop the clean window, it's about to become stale
+                cache->count = 0;
+            }
+            err = sdmmc_write_sectors(cache->card, src, start_sector, sector_count);
+        }
+    } else if (cache->count > 0 && cache->dirty &&
+            start_sector >= cache->start &&
+            start_sector <= cache->start + cache->count &&
+            start_sector - cache->start + sector_count <= cache->cache_sectors) {
+        // coalesce: overwrite and/or append within the dirty window
+        size_t offset = start_sector - cache->start;
+        memcpy(cache->buf + offset * cache->sector_size, src,
+                sector_count * cache->sector_size);
+        if (offset + sector_count > cache->count) {
+            cache->count = offset + sector_count;
+        }
+    } else {
+        // start a new write window
+        err = sdmmc_cache_flush_internal(cache);
+        if (err == ESP_OK) {
+            memcpy(cache->buf, src, sector_count * cache->sector_size);
+            cache->start = start_sector;
+            cache->count = sector_count;
+            cache->dirty = true;
+        }
+    }
+    xSemaphoreGive(cache->mutex);
+    return err;
+}
+
+esp_err_t sdmmc_cache_flush(sdmmc_cache_handle_t handle)
+{
+    if (handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    struct sdmmc_cache_t* cache = handle;
+    xSemaphoreTake(cache->mutex, portMAX_DELAY);
+    esp_err_t err = sdmmc_cache_flush_internal(cache);
+    if (err == ESP_OK) {
+        // drop the window as well, so that the cache acts as a barrier
+        // before direct card access
+        cache->count = 0;
+    }
+    xSemaphoreGive(cache->mutex);
+    return err;
+}
+
+esp_err_t sdmmc_cache_delete(sdmmc_cache_handle_t handle)
+{
+    if (handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    struct sdmmc_cache_t* cache = handle;
+    esp_err_t err = sdmmc_cache_flush(handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    vSemaphoreDelete(cache->mutex);
+    free(cache->buf);
+    free(cache);
+    return ESP_OK;
+}
@@ -511,3 +511,159 @@ esp_err_t sdmmc_read_sectors_dma(sdmmc_card_t* card, void* dst,
     }
     return ESP_OK;
 }
+
+/* Validate a scatter-gather fragment list: each fragment must hold a whole
+ * number of sectors. Returns the total number of sectors and whether all
+ * fragments can be handed to the SDMMC host DMA directly.
+ */
+static esp_err_t sdmmc_check_sg_frags(sdmmc_card_t* card, const sdmmc_sg_frag_t* frags,
+        size_t frag_count, size_t* out_sector_count, bool* out_dma_capable)
+{
+    if (frags == NULL || frag_count == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    size_t block_size = card->csd.sector_size;
+    size_t sector_count = 0;
+    bool dma_capable = true;
+    for (size_t i = 0; i < frag_count; ++i) {
+        if (frags[i].size == 0 || frags[i].size % block_size != 0) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+        if (!esp_ptr_dma_capable(frags[i].data) || (intptr_t) frags[i].data % 4 != 0) {
+            dma_capable = false;
+        }
+        sector_count += frags[i].size / block_size;
+    }
+    *out_sector_count = sector_count;
+    *out_dma_capable = dma_capable;
+    return ESP_OK;
+}
+
+esp_err_t sdmmc_write_sectors_sg(sdmmc_card_t* card, const sdmmc_sg_frag_t* frags,
+        size_t frag_count, size_t start_sector)
+{
+    size_t block_size = card->csd.sector_size;
+    size_t block_count;
+    bool dma_capable;
+    esp_err_t err = sdmmc_check_sg_frags(card, frags, frag_count, &block_count, &dma_capable);
+    if (err != ESP_OK) {
+        return err;
+    }
+    if (start_sector + block_count > card->csd.capacity) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    if (host_is_spi(card) || !dma_capable) {
+        // Host can't take the fragment list in one go; write the fragments
+        // one by one.
+        size_t sector = start_sector;
+        for (size_t i = 0; i < frag_count; ++i) {
+            err = sdmmc_write_sectors(card, frags[i].data, sector, frags[i].size / block_size);
+            if (err != ESP_OK) {
+                ESP_LOGD(TAG, "%s: error 0x%x writing fragment %d", __func__, err, i);
+                return err;
+            }
+            sector += frags[i].size / block_size;
+        }
+        return ESP_OK;
+    }
+    sdmmc_command_t cmd = {
+            .flags = SCF_CMD_ADTC | SCF_RSP_R1,
+            .blklen = block_size,
+            .datalen = block_count * block_size,
+            .sg_frags = frags,
+            .sg_frag_count = frag_count,
+            .timeout_ms = SDMMC_WRITE_CMD_TIMEOUT_MS
+    };
+    if (block_count == 1) {
+        cmd.opcode = MMC_WRITE_BLOCK_SINGLE;
+    } else {
+        cmd.opcode = MMC_WRITE_BLOCK_MULTIPLE;
+    }
+    if (card->ocr & SD_OCR_SDHC_CAP) {
+        cmd.arg = start_sector;
+    } else {
+        cmd.arg = start_sector * block_size;
+    }
+    err = sdmmc_send_cmd(card, &cmd);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "%s: sdmmc_send_cmd returned 0x%x", __func__, err);
+        return err;
+    }
+    uint32_t status = 0;
+    size_t count = 0;
+    while (!(status & MMC_R1_READY_FOR_DATA)) {
+        // TODO: add some timeout here
+        err = sdmmc_send_cmd_send_status(card, &status);
+        if (err != ESP_OK) {
+            return err;
+        }
+        if (++count % 10 == 0) {
+            ESP_LOGV(TAG, "waiting for card to become ready (%d)", count);
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t sdmmc_read_sectors_sg(sdmmc_card_t* card, const sdmmc_sg_frag_t* frags,
+        size_t frag_count, size_t start_sector)
+{
+    size_t block_size = card->csd.sector_size;
+    size_t block_count;
+    bool dma_capable;
+    esp_err_t err = sdmmc_check_sg_frags(card, frags, frag_count, &block_count, &dma_capable);
+    if (err != ESP_OK) {
+        return err;
+    }
+    if (start_sector + block_count > card->csd.capacity) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    if (host_is_spi(card) || !dma_capable) {
+        // Host can't take the fragment list in one go; read the fragments
+        // one by one.
+        size_t sector = start_sector;
+        for (size_t i = 0; i < frag_count; ++i) {
+            err = sdmmc_read_sectors(card, frags[i].data, sector, frags[i].size / block_size);
+            if (err != ESP_OK) {
+                ESP_LOGD(TAG, "%s: error 0x%x reading fragment %d", __func__, err, i);
+                return err;
+            }
+            sector += frags[i].size / block_size;
+        }
+        return ESP_OK;
+    }
+    sdmmc_command_t cmd = {
+            .flags = SCF_CMD_ADTC | SCF_CMD_READ | SCF_RSP_R1,
+            .blklen = block_size,
+            .datalen = block_count * block_size,
+            .sg_frags = frags,
+            .sg_frag_count = frag_count
+    };
+    if (block_count == 1) {
+        cmd.opcode = MMC_READ_BLOCK_SINGLE;
+    } else {
+        cmd.opcode = MMC_READ_BLOCK_MULTIPLE;
+    }
+    if (card->ocr & SD_OCR_SDHC_CAP) {
+        cmd.arg = start_sector;
+    } else {
+        cmd.arg = start_sector * block_size;
+    }
+    err = sdmmc_send_cmd(card, &cmd);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "%s: sdmmc_send_cmd returned 0x%x", __func__, err);
+        return err;
+    }
+    uint32_t status = 0;
+    size_t count = 0;
+    while (!(status & MMC_R1_READY_FOR_DATA)) {
+        // TODO: add some timeout here
+        err = sdmmc_send_cmd_send_status(card, &status);
+        if (err != ESP_OK) {
+            return err;
+        }
+        if (++count % 10 == 0) {
+            ESP_LOGV(TAG, "waiting for card to become ready (%d)", count);
+        }
+    }
+    return ESP_OK;
+}
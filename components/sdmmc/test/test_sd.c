@@ -27,6 +27,7 @@
 #include "driver/sdspi_host.h"
 #include "driver/sdmmc_defs.h"
 #include "sdmmc_cmd.h"
+#include "sdmmc_cache.h"
 #include "esp_log.h"
 #include "esp_heap_caps.h"
 #include "esp_rom_gpio.h"
@@ -401,6 +402,67 @@ TEST_CASE("SDMMC read/write test (SD slot 1, in SPI mode)", "[sdspi][test_env=UT
     test_sdspi_deinit_bus(dev_config.host_id);
     sd_test_board_power_off();
 }
+
+__attribute__((unused)) static void sequential_throughput_test(sdmmc_card_t* card)
+{
+    const size_t block_count = 128;
+    const size_t rounds = 8;
+    const size_t block_size = card->csd.sector_size;
+    const size_t total_size = block_size * block_count;
+    size_t start_block = card->csd.capacity / 2;
+
+    uint8_t* buffer = heap_caps_malloc(total_size, MALLOC_CAP_DMA);
+    TEST_ASSERT_NOT_NULL(buffer);
+    fill_buffer(start_block, buffer, total_size / sizeof(uint32_t));
+
+    struct timeval t_start, t_stop;
+    gettimeofday(&t_start, NULL);
+    for (size_t i = 0; i < rounds; ++i) {
+        TEST_ESP_OK(sdmmc_write_sectors(card, buffer, start_block + i * block_count, block_count));
+    }
+    gettimeofday(&t_stop, NULL);
+    float time_wr = 1e3f * (t_stop.tv_sec - t_start.tv_sec) + 1e-3f * (t_stop.tv_usec - t_start.tv_usec);
+
+    gettimeofday(&t_start, NULL);
+    for (size_t i = 0; i < rounds; ++i) {
+        TEST_ESP_OK(sdmmc_read_sectors(card, buffer, start_block + i * block_count, block_count));
+    }
+    gettimeofday(&t_stop, NULL);
+    float time_rd = 1e3f * (t_stop.tv_sec - t_start.tv_sec) + 1e-3f * (t_stop.tv_usec - t_start.tv_usec);
+
+    // every round wrote the same pattern, so the last round read back must still match it
+    check_buffer(start_block, buffer, total_size / sizeof(uint32_t));
+    free(buffer);
+
+    const float total_mb = rounds * total_size / (1024.0f * 1024.0f);
+    printf("sequential: %.1f MB written in %.2f ms (%.2f MB/s), read in %.2f ms (%.2f MB/s)\n",
+           total_mb, time_wr, total_mb / (time_wr / 1000),
+           time_rd, total_mb / (time_rd / 1000));
+}
+
+//No runners
+TEST_CASE("SDSPI sequential throughput benchmark", "[sdspi][test_env=UT_T1_SPIMODE]")
+{
+    sd_test_board_power_on();
+
+    sdspi_dev_handle_t handle;
+    sdspi_device_config_t dev_config = SDSPI_DEVICE_CONFIG_DEFAULT();
+    test_sdspi_init_bus(dev_config.host_id, GPIO_NUM_15, GPIO_NUM_2, GPIO_NUM_14, TEST_SDSPI_DMACHAN);
+    TEST_ESP_OK(sdspi_host_init());
+    TEST_ESP_OK(sdspi_host_init_device(&dev_config, &handle));
+
+    sdmmc_host_t config = SDSPI_HOST_DEFAULT();
+    config.slot = handle;
+
+    sdmmc_card_t* card = malloc(sizeof(sdmmc_card_t));
+    TEST_ASSERT_NOT_NULL(card);
+    TEST_ESP_OK(sdmmc_card_init(&config, card));
+    sequential_throughput_test(card);
+    TEST_ESP_OK(sdspi_host_deinit());
+    free(card);
+    test_sdspi_deinit_bus(dev_config.host_id);
+    sd_test_board_power_off();
+}
 #endif //DISABLED_FOR_TARGETS(ESP32S2)
 
 #if SOC_SDMMC_HOST_SUPPORTED
@@ -441,6 +503,107 @@ TEST_CASE("reads and writes with an unaligned buffer", "[sd][test_env=UT_T1_SDMO
     TEST_ESP_OK(sdmmc_host_deinit());
     sd_test_board_power_off();
 }
+
+TEST_CASE("scatter-gather reads and writes", "[sd][test_env=UT_T1_SDMODE]")
+{
+    sd_test_board_power_on();
+    sdmmc_host_t config = SDMMC_HOST_DEFAULT();
+    sdmmc_slot_config_t slot_config = SDMMC_SLOT_CONFIG_DEFAULT();
+    TEST_ESP_OK(sdmmc_host_init());
+
+    TEST_ESP_OK(sdmmc_host_init_slot(SDMMC_HOST_SLOT_1, &slot_config));
+    sdmmc_card_t* card = malloc(sizeof(sdmmc_card_t));
+    TEST_ASSERT_NOT_NULL(card);
+    TEST_ESP_OK(sdmmc_card_init(&config, card));
+
+    const size_t frag_count = 4;
+    const size_t frag_size = 512;
+    const uint32_t seed = 0x12345678;
+    uint8_t* contiguous = heap_caps_malloc(frag_count * frag_size, MALLOC_CAP_DMA);
+    TEST_ASSERT_NOT_NULL(contiguous);
+    fill_buffer(seed, contiguous, frag_count * frag_size / sizeof(uint32_t));
+
+    // Scattered buffers, deliberately allocated separately
+    sdmmc_sg_frag_t frags[4];
+    for (size_t i = 0; i < frag_count; ++i) {
+        frags[i].data = heap_caps_malloc(frag_size, MALLOC_CAP_DMA);
+        TEST_ASSERT_NOT_NULL(frags[i].data);
+        frags[i].size = frag_size;
+        memcpy(frags[i].data, contiguous + i * frag_size, frag_size);
+    }
+
+    // Write fragments with one command, read back contiguously
+    TEST_ESP_OK(sdmmc_write_sectors_sg(card, frags, frag_count, 0));
+    memset(contiguous, 0xcc, frag_count * frag_size);
+    TEST_ESP_OK(sdmmc_read_sectors(card, contiguous, 0, frag_count));
+    check_buffer(seed, contiguous, frag_count * frag_size / sizeof(uint32_t));
+
+    // Read back into fragments with one command
+    for (size_t i = 0; i < frag_count; ++i) {
+        memset(frags[i].data, 0xcc, frag_size);
+    }
+    TEST_ESP_OK(sdmmc_read_sectors_sg(card, frags, frag_count, 0));
+    for (size_t i = 0; i < frag_count; ++i) {
+        memcpy(contiguous + i * frag_size, frags[i].data, frag_size);
+    }
+    check_buffer(seed, contiguous, frag_count * frag_size / sizeof(uint32_t));
+
+    for (size_t i = 0; i < frag_count; ++i) {
+        free(frags[i].data);
+    }
+    free(contiguous);
+    free(card);
+    TEST_ESP_OK(sdmmc_host_deinit());
+    sd_test_board_power_off();
+}
+
+TEST_CASE("sector cache read-ahead and write coalescing", "[sd][test_env=UT_T1_SDMODE]")
+{
+    sd_test_board_power_on();
+    sdmmc_host_t config = SDMMC_HOST_DEFAULT();
+    sdmmc_slot_config_t slot_config = SDMMC_SLOT_CONFIG_DEFAULT();
+    TEST_ESP_OK(sdmmc_host_init());
+
+    TEST_ESP_OK(sdmmc_host_init_slot(SDMMC_HOST_SLOT_1, &slot_config));
+    sdmmc_card_t* card = malloc(sizeof(sdmmc_card_t));
+    TEST_ASSERT_NOT_NULL(card);
+    TEST_ESP_OK(sdmmc_card_init(&config, card));
+
+    sdmmc_cache_handle_t cache;
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, sdmmc_cache_create(card, 0, &cache));
+    TEST_ESP_OK(sdmmc_cache_create(card, 8, &cache));
+
+    const size_t sector_count = 4;
+    const size_t sector_size = card->csd.sector_size;
+    const uint32_t seed = 0x9abcdef0;
+    uint8_t* buffer = heap_caps_malloc(sector_count * sector_size, MALLOC_CAP_DMA);
+    TEST_ASSERT_NOT_NULL(buffer);
+    fill_buffer(seed, buffer, sector_count * sector_size / sizeof(uint32_t));
+
+    // Write single sectors through the cache; they get coalesced and are
+    // only sent to the card on flush
+    for (size_t i = 0; i < sector_count; ++i) {
+        TEST_ESP_OK(sdmmc_cache_write_sectors(cache, buffer + i * sector_size, i, 1));
+    }
+    TEST_ESP_OK(sdmmc_cache_flush(cache));
+    memset(buffer, 0xcc, sector_count * sector_size);
+    TEST_ESP_OK(sdmmc_read_sectors(card, buffer, 0, sector_count));
+    check_buffer(seed, buffer, sector_count * sector_size / sizeof(uint32_t));
+
+    // Read single sectors through the cache; the first read fetches a
+    // whole window, the rest are served from memory
+    memset(buffer, 0xcc, sector_count * sector_size);
+    for (size_t i = 0; i < sector_count; ++i) {
+        TEST_ESP_OK(sdmmc_cache_read_sectors(cache, buffer + i * sector_size, i, 1));
+    }
+    check_buffer(seed, buffer, sector_count * sector_size / sizeof(uint32_t));
+
+    TEST_ESP_OK(sdmmc_cache_delete(cache));
+    free(buffer);
+    free(card);
+    TEST_ESP_OK(sdmmc_host_deinit());
+    sd_test_board_power_off();
+}
 #endif
 
 __attribute__((unused)) static void test_cd_input(int gpio_cd_num, const sdmmc_host_t* config)
@@ -22,6 +22,7 @@
 #include "esp_log.h"
 #include "sdkconfig.h"
 #include "esp_flash_internal.h"
+#include "esp_tracepoint.h"
 
 #include "spi_flash_chip_generic.h" //for spi_flash_chip_generic_yield()
 
@@ -430,6 +431,8 @@ esp_err_t IRAM_ATTR esp_flash_erase_region(esp_flash_t *chip, uint32_t start, ui
     uint32_t len_remain = len;
     // Indicate whether the bus is acquired by the driver, needs to be released before return
     bool bus_acquired = false;
+    esp_flash_sched_op_t sched_op;
+    esp_flash_sched_op_enter(&sched_op);
     while (1) {
         //check before the operation, in case this is called too close to the last operation
         err = spi_flash_chip_generic_yield(chip, false);
@@ -442,6 +445,7 @@ esp_err_t IRAM_ATTR esp_flash_erase_region(esp_flash_t *chip, uint32_t start, ui
             break;
         }
         bus_acquired = true;
+        esp_flash_sched_op_acquired(&sched_op);
 
 #ifndef CONFIG_SPI_FLASH_BYPASS_BLOCK_ERASE
         // If possible erase an entire multi-sector block
@@ -471,9 +475,12 @@ esp_err_t IRAM_ATTR esp_flash_erase_region(esp_flash_t *chip, uint32_t start, ui
             break;
         }
         bus_acquired = false;
+        esp_flash_sched_op_yield(&sched_op);
     }
 
-    return rom_spiflash_api_funcs->flash_end_flush_cache(chip, err, bus_acquired, start, len);
+    err = rom_spiflash_api_funcs->flash_end_flush_cache(chip, err, bus_acquired, start, len);
+    esp_flash_sched_op_exit(&sched_op);
+    return err;
 }
 
 esp_err_t IRAM_ATTR esp_flash_get_chip_write_protect(esp_flash_t *chip, bool *out_write_protected)
@@ -633,11 +640,14 @@ esp_err_t IRAM_ATTR esp_flash_read(esp_flash_t *chip, void *buffer, uint32_t add
     }
 
     err = ESP_OK;
+    esp_flash_sched_op_t sched_op;
+    esp_flash_sched_op_enter(&sched_op);
     do {
         err = rom_spiflash_api_funcs->start(chip);
         if (err != ESP_OK) {
             break;
         }
+        esp_flash_sched_op_acquired(&sched_op);
         //if required (dma buffer allocated), read to the buffer instead of the original buffer
         uint8_t* buffer_to_read = (temp_buffer)? temp_buffer : buffer;
 
@@ -661,7 +671,11 @@ esp_err_t IRAM_ATTR esp_flash_read(esp_flash_t *chip, void *buffer, uint32_t add
         address += length_to_read;
         length -= length_to_read;
         buffer = (void*)((intptr_t)buffer + length_to_read);
+        if (length > 0) {
+            esp_flash_sched_op_yield(&sched_op);
+        }
     } while (err == ESP_OK && length > 0);
+    esp_flash_sched_op_exit(&sched_op);
 
     if (chip->os_func->release_temp_buffer != NULL) {
         chip->os_func->release_temp_buffer(chip->os_func_data, temp_buffer);
@@ -693,6 +707,8 @@ esp_err_t IRAM_ATTR esp_flash_write(esp_flash_t *chip, const void *buffer, uint3
        starvation.) */
     uint32_t write_addr = address;
     uint32_t len_remain = length;
+    esp_flash_sched_op_t sched_op;
+    esp_flash_sched_op_enter(&sched_op);
     while (1) {
         uint32_t write_len;
         const void *write_buf;
@@ -717,6 +733,7 @@ esp_err_t IRAM_ATTR esp_flash_write(esp_flash_t *chip, const void *buffer, uint3
             break;
         }
         bus_acquired = true;
+        esp_flash_sched_op_acquired(&sched_op);
 
         err = chip->chip_drv->write(chip, write_buf, write_addr, write_len);
         len_remain -= write_len;
@@ -734,12 +751,15 @@ esp_err_t IRAM_ATTR esp_flash_write(esp_flash_t *chip, const void *buffer, uint3
             break;
         }
         bus_acquired = false;
+        esp_flash_sched_op_yield(&sched_op);
 
         write_addr += write_len;
         buffer = (void *)((intptr_t)buffer + write_len);
     }
 
-    return rom_spiflash_api_funcs->flash_end_flush_cache(chip, err, bus_acquired, address, length);
+    err = rom_spiflash_api_funcs->flash_end_flush_cache(chip, err, bus_acquired, address, length);
+    esp_flash_sched_op_exit(&sched_op);
+    return err;
 }
 
 //currently the legacy implementation is used, from flash_ops.c
@@ -862,19 +882,25 @@ static IRAM_ATTR esp_err_t spi_flash_translate_rc(esp_err_t err)
 
 esp_err_t IRAM_ATTR spi_flash_erase_range(uint32_t start_addr, uint32_t size)
 {
+    ESP_TRACEPOINT(ESP_TRACEPOINT_FLASH_ERASE_START, start_addr, size);
     esp_err_t err = esp_flash_erase_region(NULL, start_addr, size);
+    ESP_TRACEPOINT(ESP_TRACEPOINT_FLASH_ERASE_END, start_addr, err);
     return spi_flash_translate_rc(err);
 }
 
 esp_err_t IRAM_ATTR spi_flash_write(size_t dst, const void *srcv, size_t size)
 {
+    ESP_TRACEPOINT(ESP_TRACEPOINT_FLASH_WRITE_START, dst, size);
     esp_err_t err = esp_flash_write(NULL, srcv, dst, size);
+    ESP_TRACEPOINT(ESP_TRACEPOINT_FLASH_WRITE_END, dst, err);
     return spi_flash_translate_rc(err);
 }
 
 esp_err_t IRAM_ATTR spi_flash_read(size_t src, void *dstv, size_t size)
 {
+    ESP_TRACEPOINT(ESP_TRACEPOINT_FLASH_READ_START, src, size);
     esp_err_t err = esp_flash_read(NULL, dstv, src, size);
+    ESP_TRACEPOINT(ESP_TRACEPOINT_FLASH_READ_END, src, err);
     return spi_flash_translate_rc(err);
 }
 
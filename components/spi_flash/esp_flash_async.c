@@ -0,0 +1,154 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "esp_flash.h"
+#include "esp_spi_flash.h"
+#include "sdkconfig.h"
+
+/* Asynchronous flash write support.
+
+   Flash program operations on these chips cannot complete in the background
+   of the calling core (the SPI1 host and the cache must be coordinated for
+   every chunk), so the asynchronous API is implemented with a dedicated
+   low-priority worker task: esp_flash_write_async() enqueues the request and
+   returns immediately, the worker performs the write through the regular
+   esp_flash_write() path (which yields between chunks), and the completion
+   callback fires from the worker's context. */
+
+typedef enum {
+    FLASH_ASYNC_OP_WRITE,
+    FLASH_ASYNC_OP_ERASE,
+} flash_async_op_t;
+
+typedef struct {
+    flash_async_op_t op;
+    esp_flash_t *chip;
+    const void *buffer;
+    uint32_t address;
+    uint32_t length;
+    esp_flash_async_cb_t callback;
+    void *arg;
+} flash_async_request_t;
+
+static QueueHandle_t s_async_queue;
+static TaskHandle_t s_async_task;
+
+static void flash_async_worker(void *arg)
+{
+    flash_async_request_t req;
+    while (true) {
+        if (xQueueReceive(s_async_queue, &req, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        esp_err_t err;
+        if (req.op == FLASH_ASYNC_OP_ERASE) {
+            /* Erase one sector at a time and re-queue the remainder behind
+               any requests submitted meanwhile, so a large erase never
+               stalls other queued flash work for more than one sector's
+               erase time. */
+            uint32_t sector_size = req.chip ? req.chip->chip_drv->sector_size : SPI_FLASH_SEC_SIZE;
+            bool requeued = false;
+            do {
+                err = esp_flash_erase_region(req.chip, req.address, sector_size);
+                if (err != ESP_OK || req.length <= sector_size) {
+                    break;
+                }
+                req.address += sector_size;
+                req.length -= sector_size;
+                /* If the queue is full we are the only consumer, so just
+                   keep erasing inline rather than blocking on ourselves. */
+                requeued = (xQueueSend(s_async_queue, &req, 0) == pdTRUE);
+            } while (!requeued);
+            if (requeued) {
+                continue;   /* callback fires when the last sector is done */
+            }
+        } else {
+            err = esp_flash_write(req.chip, req.buffer, req.address, req.length);
+        }
+        if (req.callback != NULL) {
+            req.callback(err, req.arg);
+        }
+    }
+}
+
+esp_err_t esp_flash_async_init(void)
+{
+    if (s_async_queue != NULL) {
+        return ESP_OK;
+    }
+    s_async_queue = xQueueCreate(CONFIG_SPI_FLASH_ASYNC_QUEUE_LEN, sizeof(flash_async_request_t));
+    if (s_async_queue == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    if (xTaskCreate(flash_async_worker, "flash_async", CONFIG_SPI_FLASH_ASYNC_TASK_STACK_SIZE,
+                    NULL, CONFIG_SPI_FLASH_ASYNC_TASK_PRIORITY, &s_async_task) != pdPASS) {
+        vQueueDelete(s_async_queue);
+        s_async_queue = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_flash_write_async(esp_flash_t *chip, const void *buffer, uint32_t address,
+                                uint32_t length, esp_flash_async_cb_t callback, void *arg)
+{
+    if (s_async_queue == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (buffer == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    flash_async_request_t req = {
+        .op = FLASH_ASYNC_OP_WRITE,
+        .chip = chip,
+        .buffer = buffer,
+        .address = address,
+        .length = length,
+        .callback = callback,
+        .arg = arg,
+    };
+    if (xQueueSend(s_async_queue, &req, 0) != pdTRUE) {
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_flash_erase_region_async(esp_flash_t *chip, uint32_t start, uint32_t length,
+                                       esp_flash_async_cb_t callback, void *arg)
+{
+    if (s_async_queue == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    uint32_t sector_size = chip ? chip->chip_drv->sector_size : SPI_FLASH_SEC_SIZE;
+    if (length == 0 || (start % sector_size) != 0 || (length % sector_size) != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    flash_async_request_t req = {
+        .op = FLASH_ASYNC_OP_ERASE,
+        .chip = chip,
+        .buffer = NULL,
+        .address = start,
+        .length = length,
+        .callback = callback,
+        .arg = arg,
+    };
+    if (xQueueSend(s_async_queue, &req, 0) != pdTRUE) {
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,208 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_flash.h"
+#include "esp_flash_internal.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+#ifdef CONFIG_SPI_FLASH_IO_SCHEDULER
+
+/* Flash I/O scheduler.
+
+   Every flash user (NVS commits, filesystem writes, OTA programming, core
+   dumps) funnels into the chunk loops of esp_flash_read/write/erase_region,
+   which already release the chip between chunks. Re-acquisition at those
+   boundaries is first-come-first-served though, so a short latency-critical
+   write can still queue behind a megabyte of OTA programming, one chunk at a
+   time. This module tags tasks with an I/O class and turns the chunk
+   boundaries into preemption points: while a latency-critical operation is
+   in flight, normal and bulk operations back off between chunks instead of
+   immediately re-taking the chip. Per-class queue time is recorded so the
+   contention stays visible. */
+
+static const char *TAG = "flash_sched";
+
+typedef struct {
+    TaskHandle_t task;
+    uint8_t io_class;
+} sched_task_slot_t;
+
+static portMUX_TYPE s_sched_lock = portMUX_INITIALIZER_UNLOCKED;
+static sched_task_slot_t s_task_class[CONFIG_SPI_FLASH_IO_SCHED_MAX_TASKS];
+// Operations of each class currently between op_enter and op_exit
+static volatile int s_inflight[ESP_FLASH_IO_CLASS_MAX];
+static esp_flash_sched_class_stats_t s_stats[ESP_FLASH_IO_CLASS_MAX];
+
+static const char *s_class_name[ESP_FLASH_IO_CLASS_MAX] = {
+    "critical", "normal", "bulk"
+};
+
+esp_err_t esp_flash_sched_set_task_class(esp_flash_io_class_t io_class)
+{
+    if (io_class < 0 || io_class >= ESP_FLASH_IO_CLASS_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    if (task == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_err_t err = ESP_OK;
+    portENTER_CRITICAL(&s_sched_lock);
+    sched_task_slot_t *slot = NULL;
+    sched_task_slot_t *free_slot = NULL;
+    for (int i = 0; i < CONFIG_SPI_FLASH_IO_SCHED_MAX_TASKS; i++) {
+        if (s_task_class[i].task == task) {
+            slot = &s_task_class[i];
+            break;
+        }
+        if (s_task_class[i].task == NULL && free_slot == NULL) {
+            free_slot = &s_task_class[i];
+        }
+    }
+    if (io_class == ESP_FLASH_IO_CLASS_NORMAL) {
+        // normal is the default, release the slot for other tasks
+        if (slot != NULL) {
+            slot->task = NULL;
+        }
+    } else if (slot != NULL) {
+        slot->io_class = io_class;
+    } else if (free_slot != NULL) {
+        free_slot->task = task;
+        free_slot->io_class = io_class;
+    } else {
+        err = ESP_ERR_NO_MEM;
+    }
+    portEXIT_CRITICAL(&s_sched_lock);
+    return err;
+}
+
+esp_flash_io_class_t esp_flash_sched_get_task_class(void)
+{
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    esp_flash_io_class_t io_class = ESP_FLASH_IO_CLASS_NORMAL;
+    if (task == NULL) {
+        return io_class;
+    }
+    portENTER_CRITICAL(&s_sched_lock);
+    for (int i = 0; i < CONFIG_SPI_FLASH_IO_SCHED_MAX_TASKS; i++) {
+        if (s_task_class[i].task == task) {
+            io_class = (esp_flash_io_class_t) s_task_class[i].io_class;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_sched_lock);
+    return io_class;
+}
+
+void esp_flash_sched_op_enter(esp_flash_sched_op_t *op)
+{
+    op->io_class = (uint8_t) esp_flash_sched_get_task_class();
+    op->acquired = false;
+    op->enter_us = esp_timer_get_time();
+    portENTER_CRITICAL(&s_sched_lock);
+    s_inflight[op->io_class]++;
+    portEXIT_CRITICAL(&s_sched_lock);
+}
+
+void esp_flash_sched_op_acquired(esp_flash_sched_op_t *op)
+{
+    if (op->acquired) {
+        return;
+    }
+    op->acquired = true;
+    uint32_t queue_us = (uint32_t) (esp_timer_get_time() - op->enter_us);
+    portENTER_CRITICAL(&s_sched_lock);
+    esp_flash_sched_class_stats_t *stats = &s_stats[op->io_class];
+    stats->ops++;
+    stats->total_queue_us += queue_us;
+    if (queue_us > stats->max_queue_us) {
+        stats->max_queue_us = queue_us;
+    }
+    portEXIT_CRITICAL(&s_sched_lock);
+}
+
+void esp_flash_sched_op_yield(esp_flash_sched_op_t *op)
+{
+    if (op->io_class == ESP_FLASH_IO_CLASS_CRITICAL) {
+        return;
+    }
+    if (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING) {
+        return;
+    }
+    if (s_inflight[ESP_FLASH_IO_CLASS_CRITICAL] == 0) {
+        return;
+    }
+    // Back off so the critical operation can take the chip for its next
+    // chunk(s). The wait is bounded, so a critical task blocked on something
+    // else cannot stall bulk traffic forever.
+    int back_off_ms = (op->io_class == ESP_FLASH_IO_CLASS_BULK) ?
+            CONFIG_SPI_FLASH_IO_SCHED_BULK_BACKOFF_MS : 1;
+    TickType_t deadline = xTaskGetTickCount() + pdMS_TO_TICKS(back_off_ms) + 1;
+    while (s_inflight[ESP_FLASH_IO_CLASS_CRITICAL] > 0
+            && (int32_t) (deadline - xTaskGetTickCount()) > 0) {
+        vTaskDelay(1);
+    }
+    portENTER_CRITICAL(&s_sched_lock);
+    s_stats[op->io_class].yields++;
+    portEXIT_CRITICAL(&s_sched_lock);
+}
+
+void esp_flash_sched_op_exit(esp_flash_sched_op_t *op)
+{
+    portENTER_CRITICAL(&s_sched_lock);
+    s_inflight[op->io_class]--;
+    portEXIT_CRITICAL(&s_sched_lock);
+}
+
+esp_err_t esp_flash_sched_get_class_stats(esp_flash_io_class_t io_class,
+        esp_flash_sched_class_stats_t *out_stats)
+{
+    if (io_class < 0 || io_class >= ESP_FLASH_IO_CLASS_MAX || out_stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&s_sched_lock);
+    *out_stats = s_stats[io_class];
+    portEXIT_CRITICAL(&s_sched_lock);
+    return ESP_OK;
+}
+
+esp_err_t esp_flash_sched_reset_stats(void)
+{
+    portENTER_CRITICAL(&s_sched_lock);
+    memset(s_stats, 0, sizeof(s_stats));
+    portEXIT_CRITICAL(&s_sched_lock);
+    return ESP_OK;
+}
+
+void esp_flash_sched_dump_stats(void)
+{
+    for (int i = 0; i < ESP_FLASH_IO_CLASS_MAX; i++) {
+        esp_flash_sched_class_stats_t stats;
+        esp_flash_sched_get_class_stats((esp_flash_io_class_t) i, &stats);
+        if (stats.ops == 0) {
+            continue;
+        }
+        ESP_LOGI(TAG, "%8s: ops %u, avg queue %u us, max queue %u us, yields %u",
+                 s_class_name[i], stats.ops,
+                 (uint32_t) (stats.total_queue_us / stats.ops),
+                 stats.max_queue_us, stats.yields);
+    }
+}
+
+#endif // CONFIG_SPI_FLASH_IO_SCHEDULER
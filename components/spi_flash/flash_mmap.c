@@ -112,6 +112,9 @@ typedef struct mmap_entry_{
 static LIST_HEAD(mmap_entries_head, mmap_entry_) s_mmap_entries_head =
         LIST_HEAD_INITIALIZER(s_mmap_entries_head);
 static uint8_t s_mmap_page_refcnt[REGIONS_COUNT * PAGES_PER_REGION] = {0};
+/* Pages reserved by a spi_flash_mmap_pool; they are remapped in place by the
+   pool owner and must never be shared with regular mmap handles. */
+static bool s_mmap_page_pooled[REGIONS_COUNT * PAGES_PER_REGION] = {0};
 static uint32_t s_mmap_last_handle = 0;
 
 
@@ -232,7 +235,7 @@ esp_err_t IRAM_ATTR spi_flash_mmap_pages(const int *pages, size_t page_count, sp
         for (pos = start; pos < start + page_count; ++pos, ++pageno) {
             int table_val = (int) DPORT_SEQUENCE_REG_READ((uint32_t)&DPORT_PRO_FLASH_MMU_TABLE[pos]);
             uint8_t refcnt = s_mmap_page_refcnt[pos];
-            if (refcnt != 0 && table_val != PAGE_IN_FLASH(pages[pageno])) {
+            if (refcnt != 0 && (s_mmap_page_pooled[pos] || table_val != PAGE_IN_FLASH(pages[pageno]))) {
                 break;
             }
         }
@@ -558,3 +561,160 @@ IRAM_ATTR bool spi_flash_check_and_flush_cache(size_t start_addr, size_t length)
     }
     return ret;
 }
+
+esp_err_t spi_flash_read_cached(size_t src, void *dst, size_t size)
+{
+    if (dst == NULL || src + size > g_rom_flashchip.chip_size) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (size == 0) {
+        return ESP_OK;
+    }
+
+    /* Map the range into the data cache address space (reusing any existing
+       mapping of the same pages) and copy through the cache. Unlike the
+       SPI1-based read path this never suspends the other CPU for the bulk of
+       the copy: only registering a not-yet-mapped page briefly disables the
+       cache, and the copy itself is arbitrated by the cache hardware. */
+    const void *map;
+    spi_flash_mmap_handle_t handle;
+    size_t map_start = src & ~(SPI_FLASH_MMU_PAGE_SIZE - 1);
+    size_t map_size = size + (src - map_start);
+    esp_err_t err = spi_flash_mmap(map_start, map_size, SPI_FLASH_MMAP_DATA, &map, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    memcpy(dst, (const uint8_t *)map + (src - map_start), size);
+    spi_flash_munmap(handle);
+    return ESP_OK;
+}
+
+/* Pooled mmap regions: a fixed run of MMU pages reserved once and remapped
+   in place, so streaming through a large asset costs only an MMU update and
+   cache invalidation per window, with a stable virtual address and no
+   per-window allocation. */
+
+struct spi_flash_mmap_pool_ {
+    int start;              // first MMU page index of the pool
+    int page_count;
+    int region_begin;
+    uint32_t region_addr;
+};
+
+esp_err_t spi_flash_mmap_pool_create(size_t page_count, spi_flash_mmap_pool_t *out_pool)
+{
+    if (page_count == 0 || out_pool == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    spi_flash_mmap_pool_t pool = heap_caps_malloc(sizeof(struct spi_flash_mmap_pool_), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (pool == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    spi_flash_disable_interrupts_caches_and_other_cpu();
+    spi_flash_mmap_init();
+
+    int region_begin;
+    int region_size;
+    uint32_t region_addr;
+    get_mmu_region(SPI_FLASH_MMAP_DATA, &region_begin, &region_size, &region_addr);
+
+    // find a run of unused entries and reserve them
+    int start = -1;
+    int run = 0;
+    for (int i = region_begin; i < region_begin + region_size; ++i) {
+        if (s_mmap_page_refcnt[i] == 0) {
+            if (run == 0) {
+                start = i;
+            }
+            if (++run == (int)page_count) {
+                break;
+            }
+        } else {
+            run = 0;
+        }
+    }
+    if (run < (int)page_count) {
+        spi_flash_enable_interrupts_caches_and_other_cpu();
+        free(pool);
+        return ESP_ERR_NO_MEM;
+    }
+    for (int i = start; i < start + (int)page_count; ++i) {
+        s_mmap_page_refcnt[i] = 1;
+        s_mmap_page_pooled[i] = true;
+        DPORT_PRO_FLASH_MMU_TABLE[i] = INVALID_ENTRY_VAL;
+#if !CONFIG_FREERTOS_UNICORE && CONFIG_IDF_TARGET_ESP32
+        DPORT_APP_FLASH_MMU_TABLE[i] = INVALID_ENTRY_VAL;
+#endif
+    }
+    spi_flash_enable_interrupts_caches_and_other_cpu();
+
+    pool->start = start;
+    pool->page_count = page_count;
+    pool->region_begin = region_begin;
+    pool->region_addr = region_addr;
+    *out_pool = pool;
+    return ESP_OK;
+}
+
+esp_err_t IRAM_ATTR spi_flash_mmap_pool_map(spi_flash_mmap_pool_t pool, size_t src_addr, size_t size,
+                                            const void **out_ptr)
+{
+    if (pool == NULL || out_ptr == NULL || (src_addr & 0xffff) != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (src_addr + size > g_rom_flashchip.chip_size) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    int page_count = (size + SPI_FLASH_MMU_PAGE_SIZE - 1) / SPI_FLASH_MMU_PAGE_SIZE;
+    if (page_count > pool->page_count) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    int phys_page = src_addr / SPI_FLASH_MMU_PAGE_SIZE;
+
+    spi_flash_disable_interrupts_caches_and_other_cpu();
+    DPORT_INTERRUPT_DISABLE();
+    for (int i = 0; i < page_count; ++i) {
+        int entry = pool->start + i;
+        DPORT_PRO_FLASH_MMU_TABLE[entry] = PAGE_IN_FLASH(phys_page + i);
+#if !CONFIG_FREERTOS_UNICORE && CONFIG_IDF_TARGET_ESP32
+        DPORT_APP_FLASH_MMU_TABLE[entry] = phys_page + i;
+#endif
+#if CONFIG_IDF_TARGET_ESP32S2 || CONFIG_IDF_TARGET_ESP32S3
+        Cache_Invalidate_Addr(pool->region_addr + (entry - pool->region_begin) * SPI_FLASH_MMU_PAGE_SIZE,
+                              SPI_FLASH_MMU_PAGE_SIZE);
+#endif
+    }
+    DPORT_INTERRUPT_RESTORE();
+#if CONFIG_IDF_TARGET_ESP32
+# if CONFIG_SPIRAM
+    esp_spiram_writeback_cache();
+# endif
+    Cache_Flush(0);
+# if !CONFIG_FREERTOS_UNICORE
+    Cache_Flush(1);
+# endif
+#endif
+    spi_flash_enable_interrupts_caches_and_other_cpu();
+
+    *out_ptr = (const void *)(pool->region_addr + (pool->start - pool->region_begin) * SPI_FLASH_MMU_PAGE_SIZE);
+    return ESP_OK;
+}
+
+void spi_flash_mmap_pool_destroy(spi_flash_mmap_pool_t pool)
+{
+    if (pool == NULL) {
+        return;
+    }
+    spi_flash_disable_interrupts_caches_and_other_cpu();
+    for (int i = pool->start; i < pool->start + pool->page_count; ++i) {
+        s_mmap_page_refcnt[i] = 0;
+        s_mmap_page_pooled[i] = false;
+        DPORT_PRO_FLASH_MMU_TABLE[i] = INVALID_ENTRY_VAL;
+#if !CONFIG_FREERTOS_UNICORE && CONFIG_IDF_TARGET_ESP32
+        DPORT_APP_FLASH_MMU_TABLE[i] = INVALID_ENTRY_VAL;
+#endif
+    }
+    spi_flash_enable_interrupts_caches_and_other_cpu();
+    free(pool);
+}
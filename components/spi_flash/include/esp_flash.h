@@ -16,6 +16,7 @@
 #include "esp_err.h"
 #include <stdint.h>
 #include <stdbool.h>
+#include "sdkconfig.h"
 
 #include "hal/spi_flash_types.h"
 
@@ -295,6 +296,145 @@ esp_err_t esp_flash_read(esp_flash_t *chip, void *buffer, uint32_t address, uint
  */
 esp_err_t esp_flash_write(esp_flash_t *chip, const void *buffer, uint32_t address, uint32_t length);
 
+/**
+ * @brief Completion callback type for esp_flash_write_async()
+ *
+ * @param err Result of the write (as returned by esp_flash_write())
+ * @param arg User argument passed to esp_flash_write_async()
+ */
+typedef void (*esp_flash_async_cb_t)(esp_err_t err, void *arg);
+
+/**
+ * @brief Initialize the asynchronous flash write service
+ *
+ * Creates the internal request queue and the worker task which performs the
+ * queued writes. Safe to call more than once.
+ *
+ * @return ESP_OK on success, ESP_ERR_NO_MEM if the queue or task can't be created
+ */
+esp_err_t esp_flash_async_init(void);
+
+/**
+ * @brief Queue a flash write and return immediately
+ *
+ * The write is performed by a dedicated low-priority worker task through the
+ * regular esp_flash_write() path, and the callback fires from the worker's
+ * context when the write completes. The caller must keep `buffer` valid
+ * until the callback has run.
+ *
+ * @param chip Pointer to identify flash chip. Must be NULL (the main chip)
+ *             or a pointer returned from esp_flash_init().
+ * @param buffer Pointer to the source data. Must remain valid until the
+ *               completion callback runs.
+ * @param address Address on flash to write to.
+ * @param length Length of data to write, in bytes.
+ * @param callback Completion callback, may be NULL for fire-and-forget writes.
+ * @param arg User argument passed through to the callback.
+ *
+ * @return
+ *      - ESP_OK if the request was queued
+ *      - ESP_ERR_INVALID_STATE if esp_flash_async_init() hasn't been called
+ *      - ESP_ERR_NO_MEM if the request queue is full
+ */
+esp_err_t esp_flash_write_async(esp_flash_t *chip, const void *buffer, uint32_t address,
+                                uint32_t length, esp_flash_async_cb_t callback, void *arg);
+
+/**
+ * @brief Queue a region erase, performed one sector at a time
+ *
+ * The worker task erases a single sector per scheduling step and re-queues
+ * the remainder behind any requests submitted meanwhile, so a large erase
+ * never stalls other queued flash work (or the flash cache) for more than
+ * one sector's erase time. The callback fires once the last sector is done.
+ *
+ * @param chip Pointer to identify flash chip. Must be NULL (the main chip)
+ *             or a pointer returned from esp_flash_init().
+ * @param start Address to start erasing flash. Must be sector aligned.
+ * @param length Length of region to erase. Must be sector aligned.
+ * @param callback Completion callback, may be NULL.
+ * @param arg User argument passed through to the callback.
+ *
+ * @return
+ *      - ESP_OK if the request was queued
+ *      - ESP_ERR_INVALID_STATE if esp_flash_async_init() hasn't been called
+ *      - ESP_ERR_INVALID_ARG if start or length is not sector aligned
+ *      - ESP_ERR_NO_MEM if the request queue is full
+ */
+esp_err_t esp_flash_erase_region_async(esp_flash_t *chip, uint32_t start, uint32_t length,
+                                       esp_flash_async_cb_t callback, void *arg);
+
+#ifdef CONFIG_SPI_FLASH_IO_SCHEDULER
+/**
+ * @brief I/O class of a task's flash operations, see esp_flash_sched_set_task_class()
+ */
+typedef enum {
+    ESP_FLASH_IO_CLASS_CRITICAL = 0,    ///< Small, latency-critical operations (e.g. NVS commits)
+    ESP_FLASH_IO_CLASS_NORMAL,          ///< Default class
+    ESP_FLASH_IO_CLASS_BULK,            ///< Large background operations (e.g. OTA programming)
+    ESP_FLASH_IO_CLASS_MAX,
+} esp_flash_io_class_t;
+
+/**
+ * @brief Per-class flash scheduler statistics, see esp_flash_sched_get_class_stats()
+ */
+typedef struct {
+    uint32_t ops;               ///< Completed admissions (one per read/write/erase call)
+    uint64_t total_queue_us;    ///< Total time spent waiting for the first chunk of each operation
+    uint32_t max_queue_us;      ///< Longest wait for the first chunk of an operation
+    uint32_t yields;            ///< Chunk boundaries where this class backed off for a critical operation
+} esp_flash_sched_class_stats_t;
+
+/**
+ * @brief Set the flash I/O class of the calling task
+ *
+ * Flash operations release the chip between chunks; while a task of the
+ * critical class has an operation in flight, operations issued by normal and
+ * bulk tasks back off at those chunk boundaries instead of re-taking the
+ * chip, so a small critical write never waits behind a long bulk operation
+ * chunk queue. The class applies to all subsequent flash operations of the
+ * calling task; setting ESP_FLASH_IO_CLASS_NORMAL (the default) releases the
+ * task's entry in the class table.
+ *
+ * @param io_class One of esp_flash_io_class_t
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if io_class is out of range
+ *      - ESP_ERR_NO_MEM if the class table is full (see
+ *        CONFIG_SPI_FLASH_IO_SCHED_MAX_TASKS)
+ */
+esp_err_t esp_flash_sched_set_task_class(esp_flash_io_class_t io_class);
+
+/**
+ * @brief Get the flash I/O class of the calling task
+ *
+ * @return The class set with esp_flash_sched_set_task_class(), or
+ *         ESP_FLASH_IO_CLASS_NORMAL if none was set
+ */
+esp_flash_io_class_t esp_flash_sched_get_task_class(void);
+
+/**
+ * @brief Get the accumulated scheduler statistics of one I/O class
+ *
+ * @param io_class Class to query
+ * @param[out] out_stats Receives a snapshot of the counters
+ * @return ESP_OK on success, ESP_ERR_INVALID_ARG if io_class is out of range
+ *         or out_stats is NULL
+ */
+esp_err_t esp_flash_sched_get_class_stats(esp_flash_io_class_t io_class,
+                                          esp_flash_sched_class_stats_t *out_stats);
+
+/**
+ * @brief Reset the scheduler statistics of all I/O classes
+ * @return ESP_OK
+ */
+esp_err_t esp_flash_sched_reset_stats(void);
+
+/**
+ * @brief Log the scheduler statistics of all I/O classes with non-zero activity
+ */
+void esp_flash_sched_dump_stats(void);
+#endif // CONFIG_SPI_FLASH_IO_SCHEDULER
+
 /** @brief Encrypted and write data to the SPI flash chip using on-chip hardware flash encryption
  *
  * @param chip Pointer to identify flash chip. Must be NULL (the main flash chip). For other chips, encrypted write is not supported.
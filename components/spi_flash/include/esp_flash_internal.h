@@ -113,7 +113,35 @@ esp_err_t esp_flash_app_enable_os_functions(esp_flash_t* chip);
  */
 esp_err_t esp_flash_app_disable_os_functions(esp_flash_t* chip);
 
+#ifdef CONFIG_SPI_FLASH_IO_SCHEDULER
+/** Per-operation state of the flash I/O scheduler, lives on the caller's stack */
+typedef struct {
+    uint8_t io_class;       // esp_flash_io_class_t of the issuing task
+    bool acquired;          // first chunk admitted, queue time already recorded
+    int64_t enter_us;       // timestamp of esp_flash_sched_op_enter()
+} esp_flash_sched_op_t;
 
+/** Called by the chunked flash operations when they start, before taking the chip */
+void esp_flash_sched_op_enter(esp_flash_sched_op_t *op);
+
+/** Called after the chip was taken for the first chunk, records the queue time */
+void esp_flash_sched_op_acquired(esp_flash_sched_op_t *op);
+
+/** Called at chunk boundaries (chip released); backs off while a critical operation is in flight */
+void esp_flash_sched_op_yield(esp_flash_sched_op_t *op);
+
+/** Called when the operation finishes, successful or not */
+void esp_flash_sched_op_exit(esp_flash_sched_op_t *op);
+#else
+typedef struct {
+    uint8_t io_class;
+} esp_flash_sched_op_t;
+
+#define esp_flash_sched_op_enter(op) ((void) (op))
+#define esp_flash_sched_op_acquired(op) ((void) (op))
+#define esp_flash_sched_op_yield(op) ((void) (op))
+#define esp_flash_sched_op_exit(op) ((void) (op))
+#endif // CONFIG_SPI_FLASH_IO_SCHEDULER
 
 #ifdef __cplusplus
 }
@@ -222,6 +222,42 @@ const esp_partition_t *esp_partition_verify(const esp_partition_t *partition);
 esp_err_t esp_partition_read(const esp_partition_t* partition,
                              size_t src_offset, void* dst, size_t size);
 
+#ifdef CONFIG_SPI_FLASH_PARTITION_CACHE
+/**
+ * @brief Read data from a partition through the RAM read cache
+ *
+ * Behaves like esp_partition_read(), but serves repeated small reads from a
+ * global RAM page cache (size configured via
+ * CONFIG_SPI_FLASH_PARTITION_CACHE_PAGE_SIZE/_PAGE_COUNT). The cache is
+ * invalidated automatically by esp_partition_write() and
+ * esp_partition_erase_range(); writes performed through other interfaces
+ * (e.g. esp_flash directly) require a manual
+ * esp_partition_cache_invalidate() call.
+ *
+ * @param partition Pointer to partition structure obtained using
+ *                  esp_partition_find_first or esp_partition_get.
+ * @param src_offset Address of the data to be read, relative to the
+ *                   beginning of the partition.
+ * @param dst Pointer to the buffer where data should be stored.
+ * @param size Size of data to be read, in bytes.
+ *
+ * @return ESP_OK, if data was read successfully;
+ *         ESP_ERR_INVALID_ARG, if partition or dst are NULL;
+ *         ESP_ERR_INVALID_SIZE, if read would go out of bounds of the partition;
+ *         or one of error codes from lower-level flash driver.
+ */
+esp_err_t esp_partition_read_cached(const esp_partition_t* partition, size_t src_offset, void* dst, size_t size);
+
+/**
+ * @brief Drop cached pages overlapping a partition range
+ *
+ * @param partition Partition whose pages to drop, or NULL to flush the whole cache
+ * @param offset Start of the range, relative to the beginning of the partition
+ * @param size Length of the range in bytes
+ */
+void esp_partition_cache_invalidate(const esp_partition_t* partition, size_t offset, size_t size);
+#endif // CONFIG_SPI_FLASH_PARTITION_CACHE
+
 /**
  * @brief Write data to the partition
  *
@@ -412,6 +448,33 @@ esp_err_t esp_partition_register_external(esp_flash_t* flash_chip, size_t offset
                                      const char* label, esp_partition_type_t type, esp_partition_subtype_t subtype,
                                      const esp_partition_t** out_partition);
 
+/**
+ * @brief Register a RAM backed pseudo-partition
+ *
+ * The given buffer is exposed through the esp_partition read/write/erase API under the given
+ * label, so components which store data via partitions can be pointed at RAM instead — useful
+ * for tests and for staging data which does not need to survive a reset. Erasing fills the
+ * buffer with 0xFF; writes are plain copies (NOR-style 1->0 write semantics are not emulated).
+ * Memory mapping and SHA-256 digests are not supported and return ESP_ERR_NOT_SUPPORTED.
+ *
+ * The buffer is owned by the caller and must stay valid until the partition is removed with
+ * esp_partition_deregister_external().
+ *
+ * @param buffer  Memory backing the partition
+ * @param size  Size of the buffer in bytes
+ * @param label  Partition name
+ * @param type  One of the partition types (ESP_PARTITION_TYPE_*), or an integer
+ * @param subtype  One of the partition subtypes (ESP_PARTITION_SUBTYPE_*), or an integer
+ * @param[out] out_partition  Output, if non-NULL, receives the pointer to the resulting esp_partition_t structure
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if buffer or label is NULL, or size is 0
+ *      - ESP_ERR_NO_MEM if memory allocation has failed
+ */
+esp_err_t esp_partition_register_ram(void* buffer, size_t size, const char* label,
+                                     esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                     const esp_partition_t** out_partition);
+
 /**
  * @brief Deregister the partition previously registered using esp_partition_register_external
  * @param partition  pointer to the partition structure obtained from esp_partition_register_external,
@@ -155,6 +155,78 @@ esp_err_t spi_flash_write_encrypted(size_t dest_addr, const void *src, size_t si
  */
 esp_err_t spi_flash_read(size_t src_addr, void *dest, size_t size);
 
+/**
+ * @brief  Read data from flash through the cache, without suspending the other CPU
+ *
+ * The requested range is memory-mapped into the data cache address space
+ * (reusing existing MMU entries where possible) and copied from there.
+ * Unlike spi_flash_read(), the bulk of the copy runs with both CPUs and the
+ * cache enabled; only the registration of not-yet-mapped pages briefly
+ * disables the cache. Best suited for reads from regions which are already
+ * mapped (e.g. streamed assets) or read repeatedly.
+ *
+ * Requires free MMU pages for any part of the range not already mapped, and
+ * must not be called from an ISR.
+ *
+ * @param  src   source address of the data in flash, in bytes
+ * @param  dst   pointer to the destination buffer
+ * @param  size  length of data, in bytes
+ *
+ * @return esp_err_t
+ */
+esp_err_t spi_flash_read_cached(size_t src, void *dst, size_t size);
+
+/**
+ * Opaque handle to a pooled mmap region, see spi_flash_mmap_pool_create()
+ */
+typedef struct spi_flash_mmap_pool_ *spi_flash_mmap_pool_t;
+
+/**
+ * @brief Reserve a fixed run of MMU pages for repeated remapping
+ *
+ * The reserved pages are exclusive to the pool (never shared with regular
+ * spi_flash_mmap() handles) and can be pointed at different flash regions
+ * with spi_flash_mmap_pool_map(). This gives streaming readers of large
+ * flash assets a stable virtual address and a cheap remap per window,
+ * instead of a munmap/mmap pair with free-list churn.
+ *
+ * @param page_count Number of 64KB MMU pages to reserve
+ * @param[out] out_pool Handle of the created pool
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NO_MEM if no contiguous run of free MMU pages is available
+ */
+esp_err_t spi_flash_mmap_pool_create(size_t page_count, spi_flash_mmap_pool_t *out_pool);
+
+/**
+ * @brief Remap a pool to a new flash region
+ *
+ * Updates the pool's MMU entries in place and invalidates the affected
+ * cache lines. Previously returned pointers into the pool become views of
+ * the new region.
+ *
+ * @param pool Pool created with spi_flash_mmap_pool_create()
+ * @param src_addr Physical address in flash to map, must be 64KB aligned
+ * @param size Number of bytes to map; must fit within the pool
+ * @param[out] out_ptr Virtual address of the mapped window (constant for
+ *                     the lifetime of the pool)
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG on bad alignment or address range
+ *      - ESP_ERR_INVALID_SIZE if size exceeds the pool's capacity
+ */
+esp_err_t spi_flash_mmap_pool_map(spi_flash_mmap_pool_t pool, size_t src_addr, size_t size,
+                                  const void **out_ptr);
+
+/**
+ * @brief Release a pool's MMU pages and free the handle
+ *
+ * @param pool Pool created with spi_flash_mmap_pool_create()
+ */
+void spi_flash_mmap_pool_destroy(spi_flash_mmap_pool_t pool);
+
 
 /**
  * @brief  Read data from Encrypted Flash.
@@ -39,8 +39,10 @@
 
 
 typedef struct partition_list_item_ {
-    esp_partition_t info;
+    esp_partition_t info;       // must stay the first member, see esp_partition_read()
     bool user_registered;
+    uint32_t label_hash;        // hash of info.label, avoids strcmp on index probes
+    void* ram_buf;              // backing memory of a RAM pseudo-partition, NULL otherwise
     SLIST_ENTRY(partition_list_item_) next;
 } partition_list_item_t;
 
@@ -63,6 +65,66 @@ static SLIST_HEAD(partition_list_head_, partition_list_item_) s_partition_list =
         SLIST_HEAD_INITIALIZER(s_partition_list);
 static _lock_t s_partition_list_lock;
 
+// Open-addressed index of the list items by label hash, so the common
+// esp_partition_find_first(type, subtype, "label") startup pattern costs one
+// probe instead of a list walk. Rebuilt whenever the list changes; if the
+// allocation ever fails lookups silently fall back to the walk.
+static struct {
+    partition_list_item_t** slots;
+    uint32_t mask;
+} s_label_index;
+
+static uint32_t get_label_hash(const char* label)
+{
+    // FNV-1a, labels are short
+    uint32_t hash = 2166136261u;
+    for (const unsigned char* p = (const unsigned char*) label; *p != 0; p++) {
+        hash = (hash ^ *p) * 16777619u;
+    }
+    return hash;
+}
+
+// This function is called with s_partition_list_lock taken.
+static void rebuild_label_index(void)
+{
+    free(s_label_index.slots);
+    s_label_index.slots = NULL;
+    s_label_index.mask = 0;
+
+    size_t count = 0;
+    partition_list_item_t* it;
+    SLIST_FOREACH(it, &s_partition_list, next) {
+        count++;
+    }
+    if (count == 0) {
+        return;
+    }
+    size_t capacity = 4;
+    while (capacity < count * 2) {
+        capacity <<= 1;
+    }
+    s_label_index.slots = (partition_list_item_t**) calloc(capacity, sizeof(*s_label_index.slots));
+    if (s_label_index.slots == NULL) {
+        return;
+    }
+    s_label_index.mask = capacity - 1;
+    SLIST_FOREACH(it, &s_partition_list, next) {
+        uint32_t idx = it->label_hash & s_label_index.mask;
+        while (s_label_index.slots[idx] != NULL) {
+            idx = (idx + 1) & s_label_index.mask;
+        }
+        s_label_index.slots[idx] = it;
+    }
+}
+
+// esp_partition_t handles are always &item->info, and info is the first
+// member of the item, so the enclosing list item (and the RAM buffer of a
+// RAM backed pseudo-partition) can be recovered from the handle directly.
+static inline uint8_t* ram_partition_buf(const esp_partition_t* partition)
+{
+    return (uint8_t*) ((const partition_list_item_t*) partition)->ram_buf;
+}
+
 
 static esp_err_t ensure_partitions_loaded(void)
 {
@@ -133,6 +195,35 @@ esp_partition_iterator_t esp_partition_next(esp_partition_iterator_t it)
 const esp_partition_t* esp_partition_find_first(esp_partition_type_t type,
         esp_partition_subtype_t subtype, const char* label)
 {
+    if (label != NULL) {
+        // label given: answer from the hash index instead of walking the list
+        if (ensure_partitions_loaded() != ESP_OK) {
+            return NULL;
+        }
+        _lock_acquire(&s_partition_list_lock);
+        if (s_label_index.slots != NULL) {
+            const esp_partition_t* res = NULL;
+            uint32_t hash = get_label_hash(label);
+            uint32_t idx = hash & s_label_index.mask;
+            // probe past colliding entries until an empty slot; duplicate
+            // labels occupy consecutive slots, so also filter type/subtype here
+            while (s_label_index.slots[idx] != NULL) {
+                partition_list_item_t* item = s_label_index.slots[idx];
+                if (item->label_hash == hash
+                        && strcmp(item->info.label, label) == 0
+                        && item->info.type == type
+                        && (subtype == 0xff || item->info.subtype == subtype)) {
+                    res = &item->info;
+                    break;
+                }
+                idx = (idx + 1) & s_label_index.mask;
+            }
+            _lock_release(&s_partition_list_lock);
+            return res;
+        }
+        // index allocation failed earlier, fall back to the list walk
+        _lock_release(&s_partition_list_lock);
+    }
     esp_partition_iterator_t it = esp_partition_find(type, subtype, label);
     if (it == NULL) {
         return NULL;
@@ -205,6 +296,7 @@ static esp_err_t load_partitions(void)
         // it->label may not be zero-terminated
         strncpy(item->info.label, (const char*) it->label, sizeof(item->info.label) - 1);
         item->info.label[sizeof(it->label)] = 0;
+        item->label_hash = get_label_hash(item->info.label);
         // add it to the list
         if (last == NULL) {
             SLIST_INSERT_HEAD(&s_partition_list, item, next);
@@ -214,6 +306,7 @@ static esp_err_t load_partitions(void)
         last = item;
     }
     spi_flash_munmap(handle);
+    rebuild_label_index();
     return err;
 }
 
@@ -261,6 +354,7 @@ esp_err_t esp_partition_register_external(esp_flash_t* flash_chip, size_t offset
     item->info.encrypted = false;
     item->user_registered = true;
     strlcpy(item->info.label, label, sizeof(item->info.label));
+    item->label_hash = get_label_hash(item->info.label);
 
     _lock_acquire(&s_partition_list_lock);
     partition_list_item_t *it, *last = NULL;
@@ -280,6 +374,56 @@ esp_err_t esp_partition_register_external(esp_flash_t* flash_chip, size_t offset
     } else {
         SLIST_INSERT_AFTER(last, item, next);
     }
+    rebuild_label_index();
+    _lock_release(&s_partition_list_lock);
+    if (out_partition != NULL) {
+        *out_partition = &item->info;
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_register_ram(void* buffer, size_t size, const char* label,
+        esp_partition_type_t type, esp_partition_subtype_t subtype,
+        const esp_partition_t** out_partition)
+{
+    if (out_partition != NULL) {
+        *out_partition = NULL;
+    }
+    if (buffer == NULL || size == 0 || label == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t err = ensure_partitions_loaded();
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    partition_list_item_t* item = (partition_list_item_t*) calloc(sizeof(partition_list_item_t), 1);
+    if (item == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    item->info.flash_chip = NULL;       // NULL flash chip marks the partition as RAM backed
+    item->info.address = 0;
+    item->info.size = size;
+    item->info.type = type;
+    item->info.subtype = subtype;
+    item->info.encrypted = false;
+    item->user_registered = true;
+    item->ram_buf = buffer;
+    strlcpy(item->info.label, label, sizeof(item->info.label));
+    item->label_hash = get_label_hash(item->info.label);
+
+    _lock_acquire(&s_partition_list_lock);
+    partition_list_item_t *it, *last = NULL;
+    SLIST_FOREACH(it, &s_partition_list, next) {
+        last = it;
+    }
+    if (last == NULL) {
+        SLIST_INSERT_HEAD(&s_partition_list, item, next);
+    } else {
+        SLIST_INSERT_AFTER(last, item, next);
+    }
+    rebuild_label_index();
     _lock_release(&s_partition_list_lock);
     if (out_partition != NULL) {
         *out_partition = &item->info;
@@ -300,6 +444,7 @@ esp_err_t esp_partition_deregister_external(const esp_partition_t* partition)
             }
             SLIST_REMOVE(&s_partition_list, it, partition_list_item_, next);
             free(it);
+            rebuild_label_index();
             result = ESP_OK;
             break;
         }
@@ -341,6 +486,10 @@ esp_err_t esp_partition_read(const esp_partition_t* partition,
     if (src_offset + size > partition->size) {
         return ESP_ERR_INVALID_SIZE;
     }
+    if (partition->flash_chip == NULL) {
+        memcpy(dst, ram_partition_buf(partition) + src_offset, size);
+        return ESP_OK;
+    }
 
     if (!partition->encrypted) {
 #ifndef CONFIG_SPI_FLASH_USE_LEGACY_IMPL
@@ -383,6 +532,14 @@ esp_err_t esp_partition_write(const esp_partition_t* partition,
     if (dst_offset + size > partition->size) {
         return ESP_ERR_INVALID_SIZE;
     }
+#ifdef CONFIG_SPI_FLASH_PARTITION_CACHE
+    esp_partition_cache_invalidate(partition, dst_offset, size);
+#endif
+    if (partition->flash_chip == NULL) {
+        // RAM backed pseudo-partition; NOR-style 1->0 write semantics are not emulated
+        memcpy(ram_partition_buf(partition) + dst_offset, src, size);
+        return ESP_OK;
+    }
     dst_offset = partition->address + dst_offset;
     if (!partition->encrypted) {
 #ifndef CONFIG_SPI_FLASH_USE_LEGACY_IMPL
@@ -412,6 +569,10 @@ esp_err_t esp_partition_read_raw(const esp_partition_t* partition,
     if (src_offset + size > partition->size) {
         return ESP_ERR_INVALID_SIZE;
     }
+    if (partition->flash_chip == NULL) {
+        memcpy(dst, ram_partition_buf(partition) + src_offset, size);
+        return ESP_OK;
+    }
 
 #ifndef CONFIG_SPI_FLASH_USE_LEGACY_IMPL
     return esp_flash_read(partition->flash_chip, dst, partition->address + src_offset, size);
@@ -430,6 +591,13 @@ esp_err_t esp_partition_write_raw(const esp_partition_t* partition,
     if (dst_offset + size > partition->size) {
         return ESP_ERR_INVALID_SIZE;
     }
+#ifdef CONFIG_SPI_FLASH_PARTITION_CACHE
+    esp_partition_cache_invalidate(partition, dst_offset, size);
+#endif
+    if (partition->flash_chip == NULL) {
+        memcpy(ram_partition_buf(partition) + dst_offset, src, size);
+        return ESP_OK;
+    }
     dst_offset = partition->address + dst_offset;
 
 #ifndef CONFIG_SPI_FLASH_USE_LEGACY_IMPL
@@ -452,9 +620,16 @@ esp_err_t esp_partition_erase_range(const esp_partition_t* partition,
     if (size % SPI_FLASH_SEC_SIZE != 0) {
         return ESP_ERR_INVALID_SIZE;
     }
+#ifdef CONFIG_SPI_FLASH_PARTITION_CACHE
+    esp_partition_cache_invalidate(partition, offset, size);
+#endif
     if (offset % SPI_FLASH_SEC_SIZE != 0) {
         return ESP_ERR_INVALID_ARG;
     }
+    if (partition->flash_chip == NULL) {
+        memset(ram_partition_buf(partition) + offset, 0xFF, size);
+        return ESP_OK;
+    }
 #ifndef CONFIG_SPI_FLASH_USE_LEGACY_IMPL
     return esp_flash_erase_region(partition->flash_chip, partition->address + offset, size);
 #else
@@ -498,6 +673,9 @@ esp_err_t esp_partition_mmap(const esp_partition_t* partition, size_t offset, si
 
 esp_err_t esp_partition_get_sha256(const esp_partition_t *partition, uint8_t *sha_256)
 {
+    if (partition->flash_chip == NULL) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
     return bootloader_common_get_sha256_of_partition(partition->address, partition->size, partition->type, sha_256);
 }
 
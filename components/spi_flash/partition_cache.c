@@ -0,0 +1,147 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <sys/param.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_partition.h"
+#include "sdkconfig.h"
+
+#ifdef CONFIG_SPI_FLASH_PARTITION_CACHE
+
+/* RAM read cache in front of esp_partition_read().
+
+   Small random reads (filesystem metadata, configuration records) hit RAM
+   pages instead of going to flash each time. The cache is global across
+   partitions, uses a simple LRU replacement, and is invalidated
+   automatically by esp_partition_write()/esp_partition_erase_range()
+   (see the hooks in partition.c). */
+
+#define CACHE_PAGE_SIZE  CONFIG_SPI_FLASH_PARTITION_CACHE_PAGE_SIZE
+#define CACHE_PAGE_COUNT CONFIG_SPI_FLASH_PARTITION_CACHE_PAGE_COUNT
+
+typedef struct {
+    const esp_partition_t *partition;   // NULL if the page is unused
+    uint32_t offset;                    // page-aligned offset within the partition
+    uint32_t lru;
+    uint8_t data[CACHE_PAGE_SIZE];
+} partition_cache_page_t;
+
+static partition_cache_page_t s_pages[CACHE_PAGE_COUNT];
+static uint32_t s_lru_counter;
+static SemaphoreHandle_t s_cache_mutex;
+
+static void ensure_mutex(void)
+{
+    if (s_cache_mutex == NULL) {
+        SemaphoreHandle_t mutex = xSemaphoreCreateMutex();
+        /* tolerate a racing second creation */
+        if (mutex != NULL && !__sync_bool_compare_and_swap(&s_cache_mutex, NULL, mutex)) {
+            vSemaphoreDelete(mutex);
+        }
+    }
+}
+
+static partition_cache_page_t *find_page(const esp_partition_t *partition, uint32_t page_offset)
+{
+    for (int i = 0; i < CACHE_PAGE_COUNT; i++) {
+        if (s_pages[i].partition == partition && s_pages[i].offset == page_offset) {
+            return &s_pages[i];
+        }
+    }
+    return NULL;
+}
+
+static partition_cache_page_t *victim_page(void)
+{
+    partition_cache_page_t *victim = &s_pages[0];
+    for (int i = 0; i < CACHE_PAGE_COUNT; i++) {
+        if (s_pages[i].partition == NULL) {
+            return &s_pages[i];
+        }
+        if (s_pages[i].lru < victim->lru) {
+            victim = &s_pages[i];
+        }
+    }
+    return victim;
+}
+
+esp_err_t esp_partition_read_cached(const esp_partition_t *partition, size_t src_offset,
+                                    void *dst, size_t size)
+{
+    if (partition == NULL || dst == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (src_offset > partition->size || size > partition->size - src_offset) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    ensure_mutex();
+    if (s_cache_mutex == NULL) {
+        /* no RAM for the mutex; fall back to an uncached read */
+        return esp_partition_read(partition, src_offset, dst, size);
+    }
+
+    uint8_t *out = dst;
+    esp_err_t err = ESP_OK;
+    xSemaphoreTake(s_cache_mutex, portMAX_DELAY);
+    while (size > 0) {
+        uint32_t page_offset = src_offset & ~(uint32_t)(CACHE_PAGE_SIZE - 1);
+        uint32_t in_page = src_offset - page_offset;
+        size_t chunk = MIN(size, (size_t)(CACHE_PAGE_SIZE - in_page));
+
+        partition_cache_page_t *page = find_page(partition, page_offset);
+        if (page == NULL) {
+            page = victim_page();
+            size_t fill = MIN((size_t)CACHE_PAGE_SIZE, partition->size - page_offset);
+            err = esp_partition_read(partition, page_offset, page->data, fill);
+            if (err != ESP_OK) {
+                page->partition = NULL;
+                break;
+            }
+            page->partition = partition;
+            page->offset = page_offset;
+        }
+        page->lru = ++s_lru_counter;
+        memcpy(out, page->data + in_page, chunk);
+        out += chunk;
+        src_offset += chunk;
+        size -= chunk;
+    }
+    xSemaphoreGive(s_cache_mutex);
+    return err;
+}
+
+void esp_partition_cache_invalidate(const esp_partition_t *partition, size_t offset, size_t size)
+{
+    if (s_cache_mutex == NULL) {
+        return;     // cache never used yet
+    }
+    xSemaphoreTake(s_cache_mutex, portMAX_DELAY);
+    for (int i = 0; i < CACHE_PAGE_COUNT; i++) {
+        if (s_pages[i].partition == NULL) {
+            continue;
+        }
+        if (partition == NULL) {
+            s_pages[i].partition = NULL;    // flush everything
+        } else if (s_pages[i].partition == partition
+                && s_pages[i].offset < offset + size
+                && s_pages[i].offset + CACHE_PAGE_SIZE > offset) {
+            s_pages[i].partition = NULL;
+        }
+    }
+    xSemaphoreGive(s_cache_mutex);
+}
+
+#endif // CONFIG_SPI_FLASH_PARTITION_CACHE
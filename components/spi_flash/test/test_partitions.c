@@ -69,6 +69,40 @@ TEST_CASE("Test erase partition", "[spi_flash][esp_flash]")
     }
 }
 
+TEST_CASE("Test RAM pseudo-partition", "[spi_flash]")
+{
+    static uint8_t buffer[2 * 4096];
+    const esp_partition_t *part = NULL;
+
+    ESP_ERROR_CHECK( esp_partition_register_ram(buffer, sizeof(buffer), "ram_part",
+            ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, &part) );
+    TEST_ASSERT_NOT_NULL(part);
+
+    // the registered partition has to be discoverable by label
+    TEST_ASSERT_EQUAL_PTR(part, esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+            ESP_PARTITION_SUBTYPE_ANY, "ram_part"));
+
+    ESP_ERROR_CHECK( esp_partition_erase_range(part, 0, part->size) );
+
+    const char some_data[] = "abcdefghijklmn";
+    ESP_ERROR_CHECK( esp_partition_write(part, 100, some_data, sizeof(some_data)) );
+
+    char buf[sizeof(some_data)];
+    ESP_ERROR_CHECK( esp_partition_read(part, 100, buf, sizeof(buf)) );
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, some_data, sizeof(buf)));
+
+    // erase restores the flash-like 0xFF fill
+    ESP_ERROR_CHECK( esp_partition_erase_range(part, 0, part->size) );
+    ESP_ERROR_CHECK( esp_partition_read(part, 100, buf, sizeof(buf)) );
+    for (int i = 0; i < sizeof(buf); i++) {
+        TEST_ASSERT_EQUAL_HEX8(0xFF, buf[i]);
+    }
+
+    ESP_ERROR_CHECK( esp_partition_deregister_external(part) );
+    TEST_ASSERT_NULL(esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+            ESP_PARTITION_SUBTYPE_ANY, "ram_part"));
+}
+
 static bool s_test_nonzero_sha_of_partition(const esp_partition_t *part, bool allow_invalid_image)
 {
     uint8_t sha256[32] = { 0 };
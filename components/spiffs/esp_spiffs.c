@@ -84,6 +84,130 @@ static time_t vfs_spiffs_get_mtime(const spiffs_stat* s);
 
 static esp_spiffs_t * _efs[CONFIG_SPIFFS_MAX_PARTITIONS];
 
+#if CONFIG_SPIFFS_OBJ_INDEX_CACHE_SIZE > 0
+/**
+ * Object index cache: maps file name to the page index of the object index
+ * header, so open and stat can use SPIFFS_open_by_page instead of scanning
+ * the object lookup pages on flash. Entries go stale when a file is
+ * rewritten (the header page moves); a stale entry is detected by checking
+ * the object id after the open and refreshed from the fallback lookup.
+ */
+typedef struct esp_spiffs_index_entry {
+    char name[SPIFFS_OBJ_NAME_LEN]; /*!< File name, empty when the entry is unused */
+    spiffs_obj_id obj_id;           /*!< Object id, to detect a reused header page */
+    spiffs_page_ix pix;             /*!< Page index of the object index header */
+    uint32_t stamp;                 /*!< Last access stamp, lowest is evicted first */
+} esp_spiffs_index_entry_t;
+
+static esp_spiffs_index_entry_t* esp_spiffs_index_find(esp_spiffs_t *efs, const char *name)
+{
+    for (int i = 0; i < CONFIG_SPIFFS_OBJ_INDEX_CACHE_SIZE; i++) {
+        if (strcmp(efs->index_cache[i].name, name) == 0) {
+            return &efs->index_cache[i];
+        }
+    }
+    return NULL;
+}
+
+static bool esp_spiffs_index_lookup(esp_spiffs_t *efs, const char *name,
+                                    spiffs_obj_id *obj_id, spiffs_page_ix *pix)
+{
+    bool found = false;
+    xSemaphoreTake(efs->index_lock, portMAX_DELAY);
+    esp_spiffs_index_entry_t *e = esp_spiffs_index_find(efs, name);
+    if (e != NULL) {
+        *obj_id = e->obj_id;
+        *pix = e->pix;
+        e->stamp = ++efs->index_stamp;
+        found = true;
+    }
+    xSemaphoreGive(efs->index_lock);
+    return found;
+}
+
+static void esp_spiffs_index_insert(esp_spiffs_t *efs, const char *name,
+                                    spiffs_obj_id obj_id, spiffs_page_ix pix)
+{
+    xSemaphoreTake(efs->index_lock, portMAX_DELAY);
+    esp_spiffs_index_entry_t *e = esp_spiffs_index_find(efs, name);
+    if (e == NULL) {
+        // take an unused entry if there is one, otherwise evict the LRU entry
+        e = &efs->index_cache[0];
+        for (int i = 0; i < CONFIG_SPIFFS_OBJ_INDEX_CACHE_SIZE; i++) {
+            if (efs->index_cache[i].name[0] == '\0') {
+                e = &efs->index_cache[i];
+                break;
+            }
+            if (efs->index_cache[i].stamp < e->stamp) {
+                e = &efs->index_cache[i];
+            }
+        }
+        strlcpy(e->name, name, sizeof(e->name));
+    }
+    e->obj_id = obj_id;
+    e->pix = pix;
+    e->stamp = ++efs->index_stamp;
+    xSemaphoreGive(efs->index_lock);
+}
+
+static void esp_spiffs_index_remove(esp_spiffs_t *efs, const char *name)
+{
+    xSemaphoreTake(efs->index_lock, portMAX_DELAY);
+    esp_spiffs_index_entry_t *e = esp_spiffs_index_find(efs, name);
+    if (e != NULL) {
+        e->name[0] = '\0';
+    }
+    xSemaphoreGive(efs->index_lock);
+}
+
+static void esp_spiffs_index_rename(esp_spiffs_t *efs, const char *src, const char *dst)
+{
+    xSemaphoreTake(efs->index_lock, portMAX_DELAY);
+    esp_spiffs_index_entry_t *e = esp_spiffs_index_find(efs, dst);
+    if (e != NULL) {
+        e->name[0] = '\0';
+    }
+    e = esp_spiffs_index_find(efs, src);
+    if (e != NULL) {
+        strlcpy(e->name, dst, sizeof(e->name));
+    }
+    xSemaphoreGive(efs->index_lock);
+}
+
+// Store the header location of an open file, looked up with a single fstat
+static void esp_spiffs_index_update_from_fd(esp_spiffs_t *efs, spiffs_file fd)
+{
+    spiffs_stat s;
+    if (SPIFFS_fstat(efs->fs, fd, &s) == SPIFFS_OK) {
+        esp_spiffs_index_insert(efs, (const char *)s.name, s.obj_id, s.pix);
+    }
+}
+
+// Fill the cache with one directory scan, so the first open of every file
+// after mount is already served from RAM
+static void esp_spiffs_index_build(esp_spiffs_t *efs)
+{
+    spiffs_DIR d;
+    struct spiffs_dirent e;
+    if (SPIFFS_opendir(efs->fs, "/", &d) == NULL) {
+        SPIFFS_clearerr(efs->fs);
+        return;
+    }
+    while (SPIFFS_readdir(&d, &e) != NULL) {
+        esp_spiffs_index_insert(efs, (const char *)e.name, e.obj_id, e.pix);
+    }
+    SPIFFS_closedir(&d);
+    SPIFFS_clearerr(efs->fs);
+}
+
+static void esp_spiffs_index_clear(esp_spiffs_t *efs)
+{
+    xSemaphoreTake(efs->index_lock, portMAX_DELAY);
+    memset(efs->index_cache, 0, CONFIG_SPIFFS_OBJ_INDEX_CACHE_SIZE * sizeof(esp_spiffs_index_entry_t));
+    xSemaphoreGive(efs->index_lock);
+}
+#endif // CONFIG_SPIFFS_OBJ_INDEX_CACHE_SIZE > 0
+
 static void esp_spiffs_free(esp_spiffs_t ** efs)
 {
     esp_spiffs_t * e = *efs;
@@ -97,6 +221,12 @@ static void esp_spiffs_free(esp_spiffs_t ** efs)
         free(e->fs);
     }
     vSemaphoreDelete(e->lock);
+#if CONFIG_SPIFFS_OBJ_INDEX_CACHE_SIZE > 0
+    if (e->index_lock) {
+        vSemaphoreDelete(e->index_lock);
+    }
+    free(e->index_cache);
+#endif
     free(e->fds);
     free(e->cache);
     free(e->work);
@@ -256,6 +386,21 @@ static esp_err_t esp_spiffs_init(const esp_vfs_spiffs_conf_t* conf)
         esp_spiffs_free(&efs);
         return ESP_FAIL;
     }
+#if CONFIG_SPIFFS_OBJ_INDEX_CACHE_SIZE > 0
+    efs->index_cache = calloc(CONFIG_SPIFFS_OBJ_INDEX_CACHE_SIZE, sizeof(esp_spiffs_index_entry_t));
+    if (efs->index_cache == NULL) {
+        ESP_LOGE(TAG, "object index cache could not be malloced");
+        esp_spiffs_free(&efs);
+        return ESP_ERR_NO_MEM;
+    }
+    efs->index_lock = xSemaphoreCreateMutex();
+    if (efs->index_lock == NULL) {
+        ESP_LOGE(TAG, "object index cache lock could not be created");
+        esp_spiffs_free(&efs);
+        return ESP_ERR_NO_MEM;
+    }
+    esp_spiffs_index_build(efs);
+#endif
     _efs[index] = efs;
     return ESP_OK;
 }
@@ -320,6 +465,9 @@ esp_err_t esp_spiffs_format(const char* partition_label)
         return ESP_FAIL;
     }
 
+#if CONFIG_SPIFFS_OBJ_INDEX_CACHE_SIZE > 0
+    esp_spiffs_index_clear(_efs[index]);
+#endif
     if (partition_was_mounted) {
         res = SPIFFS_mount(_efs[index]->fs, &_efs[index]->cfg, _efs[index]->work,
                             _efs[index]->fds, _efs[index]->fds_sz, _efs[index]->cache,
@@ -465,11 +613,37 @@ static int vfs_spiffs_open(void* ctx, const char * path, int flags, int mode)
     assert(path);
     esp_spiffs_t * efs = (esp_spiffs_t *)ctx;
     int spiffs_flags = spiffs_mode_conv(flags);
-    int fd = SPIFFS_open(efs->fs, path, spiffs_flags, mode);
+    int fd = -1;
+#if CONFIG_SPIFFS_OBJ_INDEX_CACHE_SIZE > 0
+    spiffs_obj_id obj_id;
+    spiffs_page_ix pix;
+    if (!(spiffs_flags & SPIFFS_O_CREAT) && esp_spiffs_index_lookup(efs, path, &obj_id, &pix)) {
+        fd = SPIFFS_open_by_page(efs->fs, pix, spiffs_flags, mode);
+        if (fd >= 0) {
+            // the header page may have been reused by another file since the
+            // entry was cached; verify the object id before using the fd
+            spiffs_stat s;
+            if (SPIFFS_fstat(efs->fs, fd, &s) != SPIFFS_OK || s.obj_id != obj_id) {
+                SPIFFS_close(efs->fs, fd);
+                fd = -1;
+            }
+        }
+        if (fd < 0) {
+            SPIFFS_clearerr(efs->fs);
+            esp_spiffs_index_remove(efs, path);
+        }
+    }
+#endif
     if (fd < 0) {
-        errno = spiffs_res_to_errno(SPIFFS_errno(efs->fs));
-        SPIFFS_clearerr(efs->fs);
-        return -1;
+        fd = SPIFFS_open(efs->fs, path, spiffs_flags, mode);
+        if (fd < 0) {
+            errno = spiffs_res_to_errno(SPIFFS_errno(efs->fs));
+            SPIFFS_clearerr(efs->fs);
+            return -1;
+        }
+#if CONFIG_SPIFFS_OBJ_INDEX_CACHE_SIZE > 0
+        esp_spiffs_index_update_from_fd(efs, fd);
+#endif
     }
     if (!(spiffs_flags & SPIFFS_RDONLY)) {
         vfs_spiffs_update_mtime(efs->fs, fd);
@@ -552,11 +726,34 @@ static int vfs_spiffs_stat(void* ctx, const char * path, struct stat * st)
     assert(st);
     spiffs_stat s;
     esp_spiffs_t * efs = (esp_spiffs_t *)ctx;
-    off_t res = SPIFFS_stat(efs->fs, path, &s);
+    off_t res = -1;
+#if CONFIG_SPIFFS_OBJ_INDEX_CACHE_SIZE > 0
+    spiffs_obj_id obj_id;
+    spiffs_page_ix pix;
+    if (esp_spiffs_index_lookup(efs, path, &obj_id, &pix)) {
+        spiffs_file fd = SPIFFS_open_by_page(efs->fs, pix, SPIFFS_O_RDONLY, 0);
+        if (fd >= 0) {
+            if (SPIFFS_fstat(efs->fs, fd, &s) == SPIFFS_OK && s.obj_id == obj_id) {
+                res = 0;
+            }
+            SPIFFS_close(efs->fs, fd);
+        }
+        if (res < 0) {
+            SPIFFS_clearerr(efs->fs);
+            esp_spiffs_index_remove(efs, path);
+        }
+    }
+#endif
     if (res < 0) {
-        errno = spiffs_res_to_errno(SPIFFS_errno(efs->fs));
-        SPIFFS_clearerr(efs->fs);
-        return -1;
+        res = SPIFFS_stat(efs->fs, path, &s);
+        if (res < 0) {
+            errno = spiffs_res_to_errno(SPIFFS_errno(efs->fs));
+            SPIFFS_clearerr(efs->fs);
+            return -1;
+        }
+#if CONFIG_SPIFFS_OBJ_INDEX_CACHE_SIZE > 0
+        esp_spiffs_index_insert(efs, (const char *)s.name, s.obj_id, s.pix);
+#endif
     }
 
     st->st_size = s.size;
@@ -579,6 +776,9 @@ static int vfs_spiffs_rename(void* ctx, const char *src, const char *dst)
         SPIFFS_clearerr(efs->fs);
         return -1;
     }
+#if CONFIG_SPIFFS_OBJ_INDEX_CACHE_SIZE > 0
+    esp_spiffs_index_rename(efs, src, dst);
+#endif
     return res;
 }
 
@@ -592,6 +792,9 @@ static int vfs_spiffs_unlink(void* ctx, const char *path)
         SPIFFS_clearerr(efs->fs);
         return -1;
     }
+#if CONFIG_SPIFFS_OBJ_INDEX_CACHE_SIZE > 0
+    esp_spiffs_index_remove(efs, path);
+#endif
     return res;
 }
 
@@ -42,6 +42,11 @@ typedef struct {
     uint32_t fds_sz;                        /*!< File Descriptor Buffer Length */
     uint8_t *cache;                         /*!< Cache Buffer */
     uint32_t cache_sz;                      /*!< Cache Buffer Length */
+#if CONFIG_SPIFFS_OBJ_INDEX_CACHE_SIZE > 0
+    struct esp_spiffs_index_entry *index_cache; /*!< Object index cache entries */
+    SemaphoreHandle_t index_lock;           /*!< Protects the object index cache */
+    uint32_t index_stamp;                   /*!< LRU stamp counter of the object index cache */
+#endif
 } esp_spiffs_t;
 
 s32_t spiffs_api_read(spiffs *fs, uint32_t addr, uint32_t size, uint8_t *dst);
@@ -25,8 +25,17 @@ extern "C" {
 typedef struct esp_transport_internal* esp_transport_list_handle_t;
 typedef struct esp_transport_item_t* esp_transport_handle_t;
 
+/**
+ * @brief One buffer of a scattered write (see esp_transport_writev)
+ */
+typedef struct esp_transport_iov {
+    const char *base;   /*!< Pointer to the data */
+    int len;            /*!< Number of data bytes at base */
+} esp_transport_iov_t;
+
 typedef int (*connect_func)(esp_transport_handle_t t, const char *host, int port, int timeout_ms);
 typedef int (*io_func)(esp_transport_handle_t t, const char *buffer, int len, int timeout_ms);
+typedef int (*io_writev_func)(esp_transport_handle_t t, const esp_transport_iov_t *iov, int iovcnt, int timeout_ms);
 typedef int (*io_read_func)(esp_transport_handle_t t, char *buffer, int len, int timeout_ms);
 typedef int (*trans_func)(esp_transport_handle_t t);
 typedef int (*poll_func)(esp_transport_handle_t t, int timeout_ms);
@@ -196,6 +205,26 @@ int esp_transport_poll_read(esp_transport_handle_t t, int timeout_ms);
  */
 int esp_transport_write(esp_transport_handle_t t, const char *buffer, int len, int timeout_ms);
 
+/**
+ * @brief      Transport write function for multiple buffers
+ *
+ * Writes the buffers back to back, as if concatenated, so layered users
+ * (e.g. a protocol header followed by a payload) don't have to join them in
+ * a temporary buffer. Transports with scatter support send adjacent small
+ * buffers in a single segment (or TLS record); on transports without it the
+ * buffers are written one by one.
+ *
+ * @param      t           The transport handle
+ * @param[in]  iov         Array of buffers to write in order
+ * @param[in]  iovcnt      Number of buffers in the array
+ * @param[in]  timeout_ms  The timeout milliseconds (-1 indicates wait forever)
+ *
+ * @return
+ *  - Total number of bytes written
+ *  - (-1) if there are any errors, should check errno
+ */
+int esp_transport_writev(esp_transport_handle_t t, const esp_transport_iov_t *iov, int iovcnt, int timeout_ms);
+
 /**
  * @brief      Poll the transport until writeable or timeout
  *
@@ -288,6 +317,21 @@ esp_err_t esp_transport_set_func(esp_transport_handle_t t,
  */
 esp_err_t esp_transport_set_async_connect_func(esp_transport_handle_t t, connect_async_func _connect_async_func);
 
+/**
+ * @brief      Set the scattered write function for the transport handle
+ *
+ * Transports that don't set one are still usable with esp_transport_writev(),
+ * which then falls back to writing the buffers one by one.
+ *
+ * @param[in]  t         The transport handle
+ * @param[in]  _writev   The scattered write function pointer
+ *
+ * @return
+ *     - ESP_OK
+ *     - ESP_FAIL
+ */
+esp_err_t esp_transport_set_writev_func(esp_transport_handle_t t, io_writev_func _writev);
+
 /**
  * @brief      Set parent transport function to the handle
  *
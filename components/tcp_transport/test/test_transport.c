@@ -1,3 +1,4 @@
+#include <string.h>
 #include "unity.h"
 
 #include "esp_transport.h"
@@ -118,6 +119,35 @@ TEST_CASE("tcp_transport: init and deinit transport list", "[tcp_transport][leak
     TEST_ASSERT_EQUAL(ESP_OK, esp_transport_list_destroy(transport_list));
 }
 
+static char s_writev_sink[64];
+static int s_writev_sink_len;
+
+static int writev_sink_write(esp_transport_handle_t t, const char *buffer, int len, int timeout_ms)
+{
+    memcpy(s_writev_sink + s_writev_sink_len, buffer, len);
+    s_writev_sink_len += len;
+    return len;
+}
+
+TEST_CASE("tcp_transport: writev fallback concatenates the buffers", "[tcp_transport][leaks=0]")
+{
+    esp_transport_handle_t t = esp_transport_init();
+    TEST_ASSERT_NOT_NULL(t);
+    // A transport with only a plain write function: esp_transport_writev()
+    // must fall back to writing the buffers one by one, in order
+    TEST_ASSERT_EQUAL(ESP_OK, esp_transport_set_func(t, NULL, NULL, writev_sink_write, NULL, NULL, NULL, NULL));
+    s_writev_sink_len = 0;
+    esp_transport_iov_t iov[3] = {
+        { .base = "head",    .len = 4 },
+        { .base = NULL,      .len = 0 },
+        { .base = "payload", .len = 7 },
+    };
+    TEST_ASSERT_EQUAL(11, esp_transport_writev(t, iov, 3, 0));
+    TEST_ASSERT_EQUAL(11, s_writev_sink_len);
+    TEST_ASSERT_EQUAL_MEMORY("headpayload", s_writev_sink, 11);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_transport_destroy(t));
+}
+
 TEST_CASE("tcp_transport: using ssl transport separately", "[tcp_transport][leaks=0]")
 {
     esp_transport_handle_t h = esp_transport_ssl_init();
@@ -180,6 +180,32 @@ int esp_transport_write(esp_transport_handle_t t, const char *buffer, int len, i
     return -1;
 }
 
+int esp_transport_writev(esp_transport_handle_t t, const esp_transport_iov_t *iov, int iovcnt, int timeout_ms)
+{
+    if (t == NULL || iov == NULL || iovcnt < 0) {
+        return -1;
+    }
+    if (t->_writev) {
+        return t->_writev(t, iov, iovcnt, timeout_ms);
+    }
+    // No scatter support in this transport: write the buffers one by one
+    int total = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        if (iov[i].len == 0) {
+            continue;
+        }
+        int ret = esp_transport_write(t, iov[i].base, iov[i].len, timeout_ms);
+        if (ret < 0) {
+            return (total > 0) ? total : ret;
+        }
+        total += ret;
+        if (ret < iov[i].len) {
+            break;
+        }
+    }
+    return total;
+}
+
 int esp_transport_poll_read(esp_transport_handle_t t, int timeout_ms)
 {
     if (t && t->_poll_read) {
@@ -241,6 +267,7 @@ esp_err_t esp_transport_set_func(esp_transport_handle_t t,
     t->_poll_write = _poll_write;
     t->_destroy = _destroy;
     t->_connect_async = NULL;
+    t->_writev = NULL;
     t->_parent_transfer = esp_transport_get_default_parent;
     return ESP_OK;
 }
@@ -271,6 +298,15 @@ esp_err_t esp_transport_set_async_connect_func(esp_transport_handle_t t, connect
     return ESP_OK;
 }
 
+esp_err_t esp_transport_set_writev_func(esp_transport_handle_t t, io_writev_func _writev)
+{
+    if (t == NULL) {
+        return ESP_FAIL;
+    }
+    t->_writev = _writev;
+    return ESP_OK;
+}
+
 esp_err_t esp_transport_set_parent_transport_func(esp_transport_handle_t t, payload_transfer_func _parent_transport)
 {
     if (t == NULL) {
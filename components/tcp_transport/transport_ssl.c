@@ -152,6 +152,78 @@ static int ssl_write(esp_transport_handle_t t, const char *buffer, int len, int
     return ret;
 }
 
+/* Scattered writes pack adjacent buffers smaller than this into one TLS
+ * record, saving the per record overhead (and segment) a separate write of
+ * the protocol header would cost */
+#define SSL_WRITEV_COALESCE_SIZE 256
+
+static int ssl_writev(esp_transport_handle_t t, const esp_transport_iov_t *iov, int iovcnt, int timeout_ms)
+{
+    int poll;
+    transport_ssl_t *ssl = esp_transport_get_context_data(t);
+
+    if ((poll = esp_transport_poll_write(t, timeout_ms)) <= 0) {
+        ESP_LOGW(TAG, "Poll timeout or error, errno=%s, fd=%d, timeout_ms=%d", strerror(errno), ssl->tls->sockfd, timeout_ms);
+        return poll;
+    }
+
+    char coalesce[SSL_WRITEV_COALESCE_SIZE];
+    int buffered = 0;
+    int total = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        const char *base = iov[i].base;
+        int len = iov[i].len;
+        while (len > 0) {
+            if (buffered == 0 && len >= SSL_WRITEV_COALESCE_SIZE) {
+                // Large buffer with nothing pending: write it as its own record
+                int written = esp_tls_conn_write(ssl->tls, (const unsigned char *) base, len);
+                if (written < 0) {
+                    ESP_LOGE(TAG, "esp_tls_conn_write error, errno=%s", strerror(errno));
+                    esp_transport_set_errors(t, ssl->tls->error_handle);
+                    return (total > 0) ? total : written;
+                }
+                total += written;
+                if (written < len) {
+                    return total;
+                }
+                len = 0;
+            } else {
+                int chunk = SSL_WRITEV_COALESCE_SIZE - buffered;
+                if (chunk > len) {
+                    chunk = len;
+                }
+                memcpy(coalesce + buffered, base, chunk);
+                buffered += chunk;
+                base += chunk;
+                len -= chunk;
+                if (buffered == SSL_WRITEV_COALESCE_SIZE) {
+                    int written = esp_tls_conn_write(ssl->tls, (const unsigned char *) coalesce, buffered);
+                    if (written < 0) {
+                        ESP_LOGE(TAG, "esp_tls_conn_write error, errno=%s", strerror(errno));
+                        esp_transport_set_errors(t, ssl->tls->error_handle);
+                        return (total > 0) ? total : written;
+                    }
+                    total += written;
+                    if (written < buffered) {
+                        return total;
+                    }
+                    buffered = 0;
+                }
+            }
+        }
+    }
+    if (buffered > 0) {
+        int written = esp_tls_conn_write(ssl->tls, (const unsigned char *) coalesce, buffered);
+        if (written < 0) {
+            ESP_LOGE(TAG, "esp_tls_conn_write error, errno=%s", strerror(errno));
+            esp_transport_set_errors(t, ssl->tls->error_handle);
+            return (total > 0) ? total : written;
+        }
+        total += written;
+    }
+    return total;
+}
+
 static int ssl_read(esp_transport_handle_t t, char *buffer, int len, int timeout_ms)
 {
     int poll, ret;
@@ -320,6 +392,7 @@ esp_transport_handle_t esp_transport_ssl_init(void)
     ESP_TRANSPORT_MEM_CHECK(TAG, ssl, return NULL);
     esp_transport_set_context_data(t, ssl);
     esp_transport_set_func(t, ssl_connect, ssl_read, ssl_write, ssl_close, ssl_poll_read, ssl_poll_write, ssl_destroy);
+    esp_transport_set_writev_func(t, ssl_writev);
     esp_transport_set_async_connect_func(t, ssl_connect_async);
     t->_get_socket = ssl_get_socket;
     return t;
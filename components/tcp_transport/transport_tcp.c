@@ -159,6 +159,70 @@ static int tcp_write(esp_transport_handle_t t, const char *buffer, int len, int
     return write(tcp->sock, buffer, len);
 }
 
+/* Scattered writes pack adjacent buffers smaller than this into one send(),
+ * so a protocol header and the start of its payload leave in one segment
+ * even with TCP_NODELAY set */
+#define TCP_WRITEV_COALESCE_SIZE 256
+
+static int tcp_writev(esp_transport_handle_t t, const esp_transport_iov_t *iov, int iovcnt, int timeout_ms)
+{
+    int poll;
+    transport_tcp_t *tcp = esp_transport_get_context_data(t);
+    if ((poll = esp_transport_poll_write(t, timeout_ms)) <= 0) {
+        return poll;
+    }
+
+    char coalesce[TCP_WRITEV_COALESCE_SIZE];
+    int buffered = 0;
+    int total = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        const char *base = iov[i].base;
+        int len = iov[i].len;
+        while (len > 0) {
+            if (buffered == 0 && len >= TCP_WRITEV_COALESCE_SIZE) {
+                // Large buffer with nothing pending: send it directly
+                int sent = write(tcp->sock, base, len);
+                if (sent < 0) {
+                    return (total > 0) ? total : sent;
+                }
+                total += sent;
+                if (sent < len) {
+                    return total;
+                }
+                len = 0;
+            } else {
+                int chunk = TCP_WRITEV_COALESCE_SIZE - buffered;
+                if (chunk > len) {
+                    chunk = len;
+                }
+                memcpy(coalesce + buffered, base, chunk);
+                buffered += chunk;
+                base += chunk;
+                len -= chunk;
+                if (buffered == TCP_WRITEV_COALESCE_SIZE) {
+                    int sent = write(tcp->sock, coalesce, buffered);
+                    if (sent < 0) {
+                        return (total > 0) ? total : sent;
+                    }
+                    total += sent;
+                    if (sent < buffered) {
+                        return total;
+                    }
+                    buffered = 0;
+                }
+            }
+        }
+    }
+    if (buffered > 0) {
+        int sent = write(tcp->sock, coalesce, buffered);
+        if (sent < 0) {
+            return (total > 0) ? total : sent;
+        }
+        total += sent;
+    }
+    return total;
+}
+
 static int tcp_read(esp_transport_handle_t t, char *buffer, int len, int timeout_ms)
 {
     transport_tcp_t *tcp = esp_transport_get_context_data(t);
@@ -258,6 +322,7 @@ esp_transport_handle_t esp_transport_tcp_init(void)
     ESP_TRANSPORT_MEM_CHECK(TAG, tcp, return NULL);
     tcp->sock = -1;
     esp_transport_set_func(t, tcp_connect, tcp_read, tcp_write, tcp_close, tcp_poll_read, tcp_poll_write, tcp_destroy);
+    esp_transport_set_writev_func(t, tcp_writev);
     esp_transport_set_context_data(t, tcp);
     t->_get_socket = tcp_get_socket;
 
@@ -248,15 +248,14 @@ static int _ws_write(esp_transport_handle_t t, int opcode, int mask_flag, const
         }
     }
 
-    if (esp_transport_write(ws->parent, ws_header, header_len, timeout_ms) != header_len) {
-        ESP_LOGE(TAG, "Error write header");
-        return -1;
-    }
-    if (len == 0) {
-        return 0;
-    }
-
-    int ret = esp_transport_write(ws->parent, buffer, len, timeout_ms);
+    // Write the header and the payload as one scattered write, so they share
+    // a segment (or TLS record) instead of being joined in a copy or sent as
+    // two small writes
+    esp_transport_iov_t iov[2] = {
+        { .base = ws_header, .len = header_len },
+        { .base = buffer,    .len = len        },
+    };
+    int wlen = esp_transport_writev(ws->parent, iov, (len > 0) ? 2 : 1, timeout_ms);
     // in case of masked transport we have to revert back to the original data, as ws layer
     // does not create its own copy of data to be sent
     if (mask_flag) {
@@ -265,7 +264,11 @@ static int _ws_write(esp_transport_handle_t t, int opcode, int mask_flag, const
             buffer[i] = (buffer[i] ^ mask[i % 4]);
         }
     }
-    return ret;
+    if (wlen < header_len) {
+        ESP_LOGE(TAG, "Error write header");
+        return -1;
+    }
+    return wlen - header_len;
 }
 
 int esp_transport_ws_send_raw(esp_transport_handle_t t, ws_transport_opcodes_t opcode, const char *b, int len, int timeout_ms)
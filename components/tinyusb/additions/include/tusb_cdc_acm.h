@@ -139,6 +139,42 @@ esp_err_t tinyusb_cdcacm_register_callback(tinyusb_cdcacm_itf_t itf,
 esp_err_t tinyusb_cdcacm_unregister_callback(tinyusb_cdcacm_itf_t itf, cdcacm_event_type_t event_type);
 
 
+/**
+ * @brief Read a block of data, blocking until data arrives
+ *
+ * Intended for bulk transfers: waits up to `timeout_ticks` for the first data,
+ * then drains everything already received (up to `out_buf_sz` bytes) without
+ * blocking again. Unlike the VFS path there is no per-byte processing.
+ *
+ * @param itf - number of a CDC object
+ * @param out_buf - destination for the data
+ * @param out_buf_sz - size of the destination
+ * @param rx_data_size - number of bytes actually read
+ * @param timeout_ticks - time to wait for the first data
+ * @return esp_err_t - ESP_OK if any data was read,
+ *                     ESP_ERR_TIMEOUT if no data arrived in time,
+ *                     ESP_ERR_INVALID_STATE if the interface is not initialized
+ */
+esp_err_t tinyusb_cdcacm_read_bulk(tinyusb_cdcacm_itf_t itf, uint8_t *out_buf, size_t out_buf_sz, size_t *rx_data_size, uint32_t timeout_ticks);
+
+/**
+ * @brief Write a block of data, flushing to the endpoint as the FIFO fills
+ *
+ * Intended for bulk transfers: queues the whole buffer, pushing full FIFOs to
+ * the endpoint and waiting for room instead of returning short. Unlike the
+ * VFS path there is no per-byte processing.
+ *
+ * @param itf - number of a CDC object
+ * @param in_buf - a source array
+ * @param in_size - number of bytes to write
+ * @param bytes_written - number of bytes actually written, can be NULL
+ * @param timeout_ticks - time budget for the whole write
+ * @return esp_err_t - ESP_OK if everything was written,
+ *                     ESP_ERR_TIMEOUT if the time ran out first,
+ *                     ESP_ERR_INVALID_STATE if the interface is not initialized
+ */
+esp_err_t tinyusb_cdcacm_write_bulk(tinyusb_cdcacm_itf_t itf, const uint8_t *in_buf, size_t in_size, size_t *bytes_written, uint32_t timeout_ticks);
+
 /**
  * @brief Sent one character to a write buffer
  *
@@ -245,6 +245,66 @@ esp_err_t tinyusb_cdcacm_read(tinyusb_cdcacm_itf_t itf, uint8_t *out_buf, size_t
 }
 
 
+esp_err_t tinyusb_cdcacm_read_bulk(tinyusb_cdcacm_itf_t itf, uint8_t *out_buf, size_t out_buf_sz, size_t *rx_data_size, uint32_t timeout_ticks)
+{
+    esp_tusb_cdcacm_t *acm = get_acm(itf);
+    if (!acm) {
+        ESP_LOGE(TAG, "Interface is not initialized. Use `tinyusb_cdc_init` for initialization");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    size_t total = 0;
+    uint32_t ticks_start = xTaskGetTickCount();
+    while (total < out_buf_sz) {
+        TickType_t wait = 0;
+        if (total == 0) { // wait for the first data, then only drain what already arrived
+            if (timeout_ticks == portMAX_DELAY) {
+                wait = portMAX_DELAY;
+            } else {
+                uint32_t elapsed = xTaskGetTickCount() - ticks_start;
+                wait = (elapsed < timeout_ticks) ? (timeout_ticks - elapsed) : 0;
+            }
+        }
+        size_t chunk_size = 0;
+        uint8_t *chunk = xRingbufferReceiveUpTo(acm->rx_unread_buf, &chunk_size, wait, out_buf_sz - total);
+        if (!chunk) {
+            break;
+        }
+        memcpy(out_buf + total, chunk, chunk_size);
+        vRingbufferReturnItem(acm->rx_unread_buf, (void *)chunk);
+        total += chunk_size;
+    }
+    *rx_data_size = total;
+    return total ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+
+esp_err_t tinyusb_cdcacm_write_bulk(tinyusb_cdcacm_itf_t itf, const uint8_t *in_buf, size_t in_size, size_t *bytes_written, uint32_t timeout_ticks)
+{
+    if (!get_acm(itf)) { // non-initialized
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    size_t total = 0;
+    uint32_t ticks_start = xTaskGetTickCount();
+    while (total < in_size) {
+        total += tud_cdc_n_write(itf, in_buf + total, in_size - total);
+        if (total < in_size) { // FIFO full: push it to the endpoint and wait for room
+            tud_cdc_n_write_flush(itf);
+            if ((xTaskGetTickCount() - ticks_start) > timeout_ticks) {
+                break;
+            }
+            vTaskDelay(1);
+        }
+    }
+    tud_cdc_n_write_flush(itf);
+    if (bytes_written) {
+        *bytes_written = total;
+    }
+    return (total == in_size) ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+
 size_t tinyusb_cdcacm_write_queue_char(tinyusb_cdcacm_itf_t itf, char ch)
 {
     if (!get_acm(itf)) { // non-initialized
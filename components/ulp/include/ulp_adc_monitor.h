@@ -0,0 +1,130 @@
+// Copyright 2021 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file ulp_adc_monitor.h
+ *
+ * Reusable ULP FSM program for autonomous ADC monitoring.
+ *
+ * The library generates (using the ULP instruction macros) and loads a
+ * coprocessor program which, on every ULP timer period:
+ *
+ *  1. takes a burst of ADC samples and averages them,
+ *  2. appends the averaged sample to a ring buffer in RTC slow memory,
+ *  3. runs threshold detection with hysteresis on the averaged value,
+ *  4. wakes the main CPU only when the monitored value crosses a threshold
+ *     or when the ring buffer fill level reaches a configurable watermark.
+ *
+ * The ring buffer follows a single-producer/single-consumer protocol: the
+ * ULP only advances the head index, the main core only advances the tail
+ * index, so no locking is required on either side. The main core drains
+ * all accumulated samples in one call to ulp_adc_monitor_read() after each
+ * wakeup, instead of being woken once per sample.
+ */
+
+/**
+ * @brief Configuration for the ULP ADC monitor program
+ */
+typedef struct {
+    uint32_t adc_unit;          /*!< SAR ADC unit, as passed to I_ADC (0: SARADC1, 1: SARADC2) */
+    uint32_t adc_channel;       /*!< ADC pad/channel index, as passed to I_ADC */
+    uint32_t burst_len;         /*!< Samples averaged per timer period; power of two, 1..16 */
+    uint32_t ring_size;         /*!< Ring buffer capacity in samples; power of two, >= 4.
+                                     One slot is kept open, so ring_size - 1 samples can be queued. */
+    uint32_t wake_watermark;    /*!< Wake the main CPU when this many samples are queued;
+                                     must be less than ring_size */
+    uint16_t high_threshold;    /*!< Wake when the averaged sample rises to or above this value */
+    uint16_t low_threshold;     /*!< Wake (and re-arm high_threshold) when the averaged sample
+                                     falls below this value; must be <= high_threshold */
+    uint32_t wakeup_period_us;  /*!< ULP timer period between bursts, in microseconds */
+    uint32_t load_addr;         /*!< Load address of the program, in 32-bit words (usually 0) */
+} ulp_adc_monitor_config_t;
+
+/**
+ * @brief Generate the monitor program and load it into RTC slow memory
+ *
+ * The ring buffer and the index/state variables are placed at the top of the
+ * memory region reserved for the ULP (CONFIG_xxx_ULP_COPROC_RESERVE_MEM);
+ * the program is loaded at config->load_addr. Thresholds and the watermark
+ * are baked into the program as immediates: call this function again to
+ * change them.
+ *
+ * The caller is responsible for configuring the ADC for ULP use (attenuation,
+ * bit width, ulp_adc usage) before starting the program, the same way as for
+ * a hand-written ULP ADC program.
+ *
+ * @param config  monitor configuration, copied by this function
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if a configuration field is out of range
+ *      - ESP_ERR_INVALID_SIZE if the program would overlap the ring buffer
+ *      - one of ESP_ERR_ULP_xxx if the program can not be loaded
+ */
+esp_err_t ulp_adc_monitor_init(const ulp_adc_monitor_config_t* config);
+
+/**
+ * @brief Start the monitor program and the ULP wakeup timer
+ *
+ * @return ESP_OK on success, ESP_ERR_INVALID_STATE if init was not called
+ */
+esp_err_t ulp_adc_monitor_start(void);
+
+/**
+ * @brief Drain accumulated samples from the RTC-memory ring buffer
+ *
+ * Copies up to max_samples queued averaged samples (oldest first) into the
+ * caller's buffer and releases the ring slots back to the ULP. Call this
+ * after each wakeup; it is also safe to call at any time while the main
+ * CPU is running.
+ *
+ * @param samples      destination buffer
+ * @param max_samples  capacity of the destination buffer
+ * @return number of samples copied
+ */
+size_t ulp_adc_monitor_read(uint16_t* samples, size_t max_samples);
+
+/**
+ * @brief Get the number of samples currently queued in the ring buffer
+ */
+size_t ulp_adc_monitor_pending(void);
+
+/**
+ * @brief Whether the monitored value is currently above the high threshold
+ *
+ * Reflects the hysteresis state maintained by the ULP: set when the averaged
+ * sample rises to high_threshold, cleared when it falls below low_threshold.
+ */
+bool ulp_adc_monitor_above_threshold(void);
+
+/**
+ * @brief Number of bursts dropped because the ring buffer was full
+ *
+ * The counter accumulates since ulp_adc_monitor_init(); a non-zero delta
+ * between wakeups means the watermark or the drain rate is too low.
+ */
+uint32_t ulp_adc_monitor_overrun_count(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -458,3 +458,51 @@ TEST_CASE("can use ADC in deep sleep", "[ulp][ignore]")
     esp_sleep_enable_timer_wakeup(4000000);
     esp_deep_sleep_start();
 }
+
+TEST_CASE("ulp adc monitor config validation and ring protocol", "[ulp]")
+{
+    memset(RTC_SLOW_MEM, 0, CONFIG_ESP32_ULP_COPROC_RESERVE_MEM);
+    ulp_adc_monitor_config_t config = {
+        .adc_unit = 0,
+        .adc_channel = 6,
+        .burst_len = 8,
+        .ring_size = 16,
+        .wake_watermark = 12,
+        .high_threshold = 2000,
+        .low_threshold = 1500,
+        .wakeup_period_us = 20000,
+        .load_addr = 0,
+    };
+
+    ulp_adc_monitor_config_t bad = config;
+    bad.burst_len = 7;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, ulp_adc_monitor_init(&bad));
+    bad = config;
+    bad.wake_watermark = 16;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, ulp_adc_monitor_init(&bad));
+    bad = config;
+    bad.low_threshold = 2500;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, ulp_adc_monitor_init(&bad));
+
+    TEST_ESP_OK(ulp_adc_monitor_init(&config));
+    TEST_ASSERT_EQUAL(0, ulp_adc_monitor_pending());
+    TEST_ASSERT_FALSE(ulp_adc_monitor_above_threshold());
+    TEST_ASSERT_EQUAL(0, ulp_adc_monitor_overrun_count());
+
+    // Emulate the ULP producer side of the ring buffer protocol:
+    // the variable block sits at the top of the reserved region.
+    const uint32_t var_base = CONFIG_ESP32_ULP_COPROC_RESERVE_MEM / 4 - (5 + config.ring_size);
+    for (uint32_t i = 0; i < 5; ++i) {
+        RTC_SLOW_MEM[var_base + 5 + i] = 100 + i;
+    }
+    RTC_SLOW_MEM[var_base + 0] = 5;  // head
+
+    TEST_ASSERT_EQUAL(5, ulp_adc_monitor_pending());
+    uint16_t samples[8];
+    TEST_ASSERT_EQUAL(5, ulp_adc_monitor_read(samples, 8));
+    for (uint32_t i = 0; i < 5; ++i) {
+        TEST_ASSERT_EQUAL(100 + i, samples[i]);
+    }
+    TEST_ASSERT_EQUAL(0, ulp_adc_monitor_pending());
+    TEST_ASSERT_EQUAL(5, RTC_SLOW_MEM[var_base + 1]);  // tail caught up
+}
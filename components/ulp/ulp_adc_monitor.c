@@ -0,0 +1,226 @@
+// Copyright 2021 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <string.h>
+#include "sdkconfig.h"
+#include "esp_err.h"
+#include "esp_log.h"
+#if CONFIG_IDF_TARGET_ESP32
+#include "esp32/ulp.h"
+#elif CONFIG_IDF_TARGET_ESP32S2
+#include "esp32s2/ulp.h"
+#elif CONFIG_IDF_TARGET_ESP32S3
+#include "esp32s3/ulp.h"
+#endif
+#include "soc/rtc_cntl_reg.h"
+#include "ulp_adc_monitor.h"
+#include "ulp_private.h"
+
+static const char* TAG = "ulp_adc_mon";
+
+/* Word offsets of the shared variables, relative to s_monitor.var_base.
+ * The ULP writes HEAD, STATE, SAMPLE and OVERRUNS; the main core only
+ * writes TAIL, which keeps the ring buffer lock-free.
+ */
+#define MON_VAR_HEAD        0
+#define MON_VAR_TAIL        1
+#define MON_VAR_STATE       2
+#define MON_VAR_SAMPLE      3
+#define MON_VAR_OVERRUNS    4
+#define MON_VAR_WORDS       5
+
+/* Labels used inside the generated program */
+#define MON_LBL_SAMPLE_LOOP 1
+#define MON_LBL_STORE       2
+#define MON_LBL_THRESH      3
+#define MON_LBL_ARMED       4
+#define MON_LBL_FILL        5
+#define MON_LBL_WAKE        6
+#define MON_LBL_SLEEP       7
+
+typedef struct {
+    uint32_t var_base;      /* word address of the variable block in RTC slow memory */
+    uint32_t ring_size;
+    uint32_t entry_point;
+    bool loaded;
+} ulp_adc_monitor_state_t;
+
+static ulp_adc_monitor_state_t s_monitor;
+
+static inline bool is_power_of_two(uint32_t val)
+{
+    return val != 0 && (val & (val - 1)) == 0;
+}
+
+esp_err_t ulp_adc_monitor_init(const ulp_adc_monitor_config_t* config)
+{
+    if (config == NULL ||
+        !is_power_of_two(config->burst_len) || config->burst_len > 16 ||
+        !is_power_of_two(config->ring_size) || config->ring_size < 4 ||
+        config->wake_watermark == 0 || config->wake_watermark >= config->ring_size ||
+        config->low_threshold > config->high_threshold) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    const uint32_t reserve_words = ULP_RESERVE_MEM / sizeof(uint32_t);
+    const uint32_t shared_words = MON_VAR_WORDS + config->ring_size;
+    if (shared_words >= reserve_words) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    const uint32_t var_base = reserve_words - shared_words;
+    const uint32_t mask = config->ring_size - 1;
+    const uint32_t avg_shift = __builtin_ctz(config->burst_len);
+
+    const ulp_insn_t program[] = {
+        /* Burst-sample the ADC and average. The accumulator stays within
+         * 16 bits: up to 16 samples of at most 12 bits each. */
+        I_MOVI(R3, var_base),
+        I_MOVI(R0, 0),
+        I_STAGE_RST(),
+        M_LABEL(MON_LBL_SAMPLE_LOOP),
+        I_ADC(R1, config->adc_unit, config->adc_channel),
+        I_ADDR(R0, R0, R1),
+        I_STAGE_INC(1),
+        M_BSLT(MON_LBL_SAMPLE_LOOP, config->burst_len),
+        I_RSHI(R0, R0, avg_shift),
+        I_ST(R0, R3, MON_VAR_SAMPLE),
+        /* Ring buffer: used = (head - tail) & mask. One slot is kept open,
+         * so the ring is full when used == ring_size - 1. */
+        I_LD(R1, R3, MON_VAR_HEAD),
+        I_LD(R0, R3, MON_VAR_TAIL),
+        I_SUBR(R0, R1, R0),
+        I_ANDI(R0, R0, mask),
+        M_BL(MON_LBL_STORE, mask),
+        /* Full: count the dropped burst, still run threshold detection */
+        I_LD(R0, R3, MON_VAR_OVERRUNS),
+        I_ADDI(R0, R0, 1),
+        I_ST(R0, R3, MON_VAR_OVERRUNS),
+        M_BX(MON_LBL_THRESH),
+        M_LABEL(MON_LBL_STORE),
+        I_ADDR(R2, R1, R3),
+        I_LD(R0, R3, MON_VAR_SAMPLE),
+        I_ST(R0, R2, MON_VAR_WORDS),
+        I_ADDI(R1, R1, 1),
+        I_ANDI(R1, R1, mask),
+        I_ST(R1, R3, MON_VAR_HEAD),
+        /* Threshold detection with hysteresis: wake on the rising crossing
+         * of high_threshold and on the falling crossing of low_threshold. */
+        M_LABEL(MON_LBL_THRESH),
+        I_LD(R0, R3, MON_VAR_STATE),
+        M_BGE(MON_LBL_ARMED, 1),
+        I_LD(R0, R3, MON_VAR_SAMPLE),
+        M_BL(MON_LBL_FILL, config->high_threshold),
+        I_MOVI(R0, 1),
+        I_ST(R0, R3, MON_VAR_STATE),
+        M_BX(MON_LBL_WAKE),
+        M_LABEL(MON_LBL_ARMED),
+        I_LD(R0, R3, MON_VAR_SAMPLE),
+        M_BGE(MON_LBL_FILL, config->low_threshold),
+        I_MOVI(R0, 0),
+        I_ST(R0, R3, MON_VAR_STATE),
+        M_BX(MON_LBL_WAKE),
+        /* No crossing: wake only if the fill watermark is reached */
+        M_LABEL(MON_LBL_FILL),
+        I_LD(R1, R3, MON_VAR_HEAD),
+        I_LD(R0, R3, MON_VAR_TAIL),
+        I_SUBR(R0, R1, R0),
+        I_ANDI(R0, R0, mask),
+        M_BL(MON_LBL_SLEEP, config->wake_watermark),
+        /* Wake the main CPU. If the SoC is not ready (the main CPU is
+         * running, or is transitioning into sleep), leave the data queued;
+         * the wake condition is re-evaluated on the next timer period. */
+        M_LABEL(MON_LBL_WAKE),
+        I_RD_REG(RTC_CNTL_LOW_POWER_ST_REG, RTC_CNTL_RDY_FOR_WAKEUP_S, RTC_CNTL_RDY_FOR_WAKEUP_S),
+        M_BL(MON_LBL_SLEEP, 1),
+        I_WAKE(),
+        M_LABEL(MON_LBL_SLEEP),
+        I_HALT(),
+    };
+    size_t size = sizeof(program) / sizeof(ulp_insn_t);
+    /* `size` shrinks when macros are resolved, so this check is conservative */
+    if (config->load_addr + size > var_base) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    memset(&RTC_SLOW_MEM[var_base], 0, shared_words * sizeof(uint32_t));
+    esp_err_t err = ulp_process_macros_and_load(config->load_addr, program, &size);
+    if (err != ESP_OK) {
+        return err;
+    }
+    err = ulp_set_wakeup_period(0, config->wakeup_period_us);
+    if (err != ESP_OK) {
+        return err;
+    }
+    s_monitor.var_base = var_base;
+    s_monitor.ring_size = config->ring_size;
+    s_monitor.entry_point = config->load_addr;
+    s_monitor.loaded = true;
+    ESP_LOGD(TAG, "program: %u words at %u, ring: %u samples at %u",
+             (unsigned) size, (unsigned) config->load_addr,
+             (unsigned) config->ring_size, (unsigned) var_base);
+    return ESP_OK;
+}
+
+esp_err_t ulp_adc_monitor_start(void)
+{
+    if (!s_monitor.loaded) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return ulp_run(s_monitor.entry_point);
+}
+
+size_t ulp_adc_monitor_read(uint16_t* samples, size_t max_samples)
+{
+    if (!s_monitor.loaded || samples == NULL) {
+        return 0;
+    }
+    volatile uint32_t* vars = &RTC_SLOW_MEM[s_monitor.var_base];
+    const uint32_t mask = s_monitor.ring_size - 1;
+    /* ULP store instructions put the PC in the upper halfword; mask it off */
+    uint32_t head = vars[MON_VAR_HEAD] & 0xffff;
+    uint32_t tail = vars[MON_VAR_TAIL] & 0xffff;
+    size_t count = 0;
+    while (tail != head && count < max_samples) {
+        samples[count++] = (uint16_t)(vars[MON_VAR_WORDS + tail] & 0xffff);
+        tail = (tail + 1) & mask;
+    }
+    vars[MON_VAR_TAIL] = tail;
+    return count;
+}
+
+size_t ulp_adc_monitor_pending(void)
+{
+    if (!s_monitor.loaded) {
+        return 0;
+    }
+    volatile uint32_t* vars = &RTC_SLOW_MEM[s_monitor.var_base];
+    uint32_t head = vars[MON_VAR_HEAD] & 0xffff;
+    uint32_t tail = vars[MON_VAR_TAIL] & 0xffff;
+    return (head - tail) & (s_monitor.ring_size - 1);
+}
+
+bool ulp_adc_monitor_above_threshold(void)
+{
+    if (!s_monitor.loaded) {
+        return false;
+    }
+    return (RTC_SLOW_MEM[s_monitor.var_base + MON_VAR_STATE] & 0xffff) != 0;
+}
+
+uint32_t ulp_adc_monitor_overrun_count(void)
+{
+    if (!s_monitor.loaded) {
+        return 0;
+    }
+    return RTC_SLOW_MEM[s_monitor.var_base + MON_VAR_OVERRUNS] & 0xffff;
+}
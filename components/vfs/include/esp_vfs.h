@@ -18,6 +18,7 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <stdarg.h>
+#include <stdio.h>
 #include <unistd.h>
 #include <utime.h>
 #include "freertos/FreeRTOS.h"
@@ -350,6 +351,20 @@ esp_err_t esp_vfs_register_fd(esp_vfs_id_t vfs_id, int *fd);
  */
 esp_err_t esp_vfs_unregister_fd(esp_vfs_id_t vfs_id, int fd);
 
+#ifdef CONFIG_VFS_CALL_COUNTERS
+/**
+ * Dump the number of syscalls dispatched to each registered VFS since startup
+ * (or since the last reset), one line per VFS, to the given stream. Useful for
+ * finding which filesystem or driver the application's syscalls end up in.
+ *
+ * Only available when the VFS_CALL_COUNTERS option is enabled.
+ *
+ * @param fp File stream to print to (e.g. stdout)
+ * @param reset If true, the counters are reset to zero after dumping
+ */
+void esp_vfs_dump_call_counts(FILE *fp, bool reset);
+#endif // CONFIG_VFS_CALL_COUNTERS
+
 /**
  * These functions are to be used in newlib syscall table. They will be called by
  * newlib when it needs to use any of the syscalls.
@@ -37,7 +37,7 @@ static const char *TAG = "vfs";
 
 #define VFS_MAX_COUNT   8   /* max number of VFS entries (registered filesystems) */
 #define LEN_PATH_PREFIX_IGNORED SIZE_MAX /* special length value for VFS which is never recognised by open() */
-#define FD_TABLE_ENTRY_UNUSED   (fd_table_t) { .permanent = false, .vfs_index = -1, .local_fd = -1 }
+#define FD_TABLE_ENTRY_UNUSED   (fd_table_t) { .permanent = false, .vfs_index = -1, .local_fd = -1, .vfs_entry = NULL }
 
 typedef uint8_t local_fd_t;
 _Static_assert((1 << (sizeof(local_fd_t)*8)) >= MAX_FDS, "file descriptor type too small");
@@ -46,12 +46,6 @@ typedef int8_t vfs_index_t;
 _Static_assert((1 << (sizeof(vfs_index_t)*8)) >= VFS_MAX_COUNT, "VFS index type too small");
 _Static_assert(((vfs_index_t) -1) < 0, "vfs_index_t must be a signed type");
 
-typedef struct {
-    bool permanent;
-    vfs_index_t vfs_index;
-    local_fd_t local_fd;
-} fd_table_t;
-
 typedef struct vfs_entry_ {
     esp_vfs_t vfs;          // contains pointers to VFS functions
     char path_prefix[ESP_VFS_PATH_MAX]; // path prefix mapped to this VFS
@@ -60,6 +54,13 @@ typedef struct vfs_entry_ {
     int offset;             // index of this structure in s_vfs array
 } vfs_entry_t;
 
+typedef struct {
+    bool permanent;
+    vfs_index_t vfs_index;
+    local_fd_t local_fd;
+    const vfs_entry_t *vfs_entry; // resolved VFS entry, so the syscall path needs a single read
+} fd_table_t;
+
 typedef struct {
     bool isset; // none or at least one bit is set in the following 3 fd sets
     fd_set readfds;
@@ -73,6 +74,13 @@ static size_t s_vfs_count = 0;
 static fd_table_t s_fd_table[MAX_FDS] = { [0 ... MAX_FDS-1] = FD_TABLE_ENTRY_UNUSED };
 static _lock_t s_fd_table_lock;
 
+#ifdef CONFIG_VFS_CALL_COUNTERS
+static uint32_t s_vfs_call_count[VFS_MAX_COUNT];
+#define VFS_COUNT_CALL(pvfs) do { s_vfs_call_count[(pvfs)->offset]++; } while (0)
+#else
+#define VFS_COUNT_CALL(pvfs)
+#endif //CONFIG_VFS_CALL_COUNTERS
+
 static esp_err_t esp_vfs_register_common(const char* base_path, size_t len, const esp_vfs_t* vfs, void* ctx, int *vfs_index)
 {
     if (len != LEN_PATH_PREFIX_IGNORED) {
@@ -153,6 +161,7 @@ esp_err_t esp_vfs_register_fd_range(const esp_vfs_t *vfs, void *ctx, int min_fd,
             s_fd_table[i].permanent = true;
             s_fd_table[i].vfs_index = index;
             s_fd_table[i].local_fd = i;
+            s_fd_table[i].vfs_entry = s_vfs[index];
         }
         _lock_release(&s_fd_table_lock);
     }
@@ -182,17 +191,18 @@ esp_err_t esp_vfs_unregister(const char* base_path)
         }
         if (base_path_len == vfs->path_prefix_len &&
                 memcmp(base_path, vfs->path_prefix, vfs->path_prefix_len) == 0) {
-            free(vfs);
             s_vfs[i] = NULL;
 
             _lock_acquire(&s_fd_table_lock);
-            // Delete all references from the FD lookup-table
+            // Delete all references from the FD lookup-table before the entry
+            // is freed, so a concurrent syscall cannot resolve a stale pointer
             for (int j = 0; j < MAX_FDS; ++j) {
                 if (s_fd_table[j].vfs_index == i) {
                     s_fd_table[j] = FD_TABLE_ENTRY_UNUSED;
                 }
             }
             _lock_release(&s_fd_table_lock);
+            free(vfs);
 
             return ESP_OK;
         }
@@ -214,6 +224,7 @@ esp_err_t esp_vfs_register_fd(esp_vfs_id_t vfs_id, int *fd)
             s_fd_table[i].permanent = true;
             s_fd_table[i].vfs_index = vfs_id;
             s_fd_table[i].local_fd = i;
+            s_fd_table[i].vfs_entry = s_vfs[vfs_id];
             *fd = i;
             ret = ESP_OK;
             break;
@@ -248,6 +259,24 @@ esp_err_t esp_vfs_unregister_fd(esp_vfs_id_t vfs_id, int fd)
     return ret;
 }
 
+#ifdef CONFIG_VFS_CALL_COUNTERS
+void esp_vfs_dump_call_counts(FILE *fp, bool reset)
+{
+    for (size_t i = 0; i < s_vfs_count; ++i) {
+        const vfs_entry_t *vfs = s_vfs[i];
+        if (vfs == NULL) {
+            continue;
+        }
+        const char *prefix = (vfs->path_prefix_len == LEN_PATH_PREFIX_IGNORED || vfs->path_prefix_len == 0) ?
+                "(no prefix)" : vfs->path_prefix;
+        fprintf(fp, "%-16s: %u\n", prefix, s_vfs_call_count[i]);
+        if (reset) {
+            s_vfs_call_count[i] = 0;
+        }
+    }
+}
+#endif //CONFIG_VFS_CALL_COUNTERS
+
 static inline const vfs_entry_t *get_vfs_for_index(int index)
 {
     if (index < 0 || index >= s_vfs_count) {
@@ -266,8 +295,7 @@ static const vfs_entry_t *get_vfs_for_fd(int fd)
 {
     const vfs_entry_t *vfs = NULL;
     if (fd_valid(fd)) {
-        const int index = s_fd_table[fd].vfs_index; // single read -> no locking is required
-        vfs = get_vfs_for_index(index);
+        vfs = s_fd_table[fd].vfs_entry; // single read -> no locking is required
     }
     return vfs;
 }
@@ -350,6 +378,7 @@ static const vfs_entry_t* get_vfs_for_path(const char* path)
         __errno_r(r) = ENOSYS; \
         return -1; \
     } \
+    VFS_COUNT_CALL(pvfs); \
     if (pvfs->vfs.flags & ESP_VFS_FLAG_CONTEXT_PTR) { \
         ret = (*pvfs->vfs.func ## _p)(pvfs->ctx, __VA_ARGS__); \
     } else { \
@@ -362,6 +391,7 @@ static const vfs_entry_t* get_vfs_for_path(const char* path)
         __errno_r(r) = ENOSYS; \
         return; \
     } \
+    VFS_COUNT_CALL(pvfs); \
     if (pvfs->vfs.flags & ESP_VFS_FLAG_CONTEXT_PTR) { \
         (*pvfs->vfs.func ## _p)(pvfs->ctx, __VA_ARGS__); \
     } else { \
@@ -373,6 +403,7 @@ static const vfs_entry_t* get_vfs_for_path(const char* path)
         __errno_r(r) = ENOSYS; \
         return NULL; \
     } \
+    VFS_COUNT_CALL(pvfs); \
     if (pvfs->vfs.flags & ESP_VFS_FLAG_CONTEXT_PTR) { \
         ret = (*pvfs->vfs.func ## _p)(pvfs->ctx, __VA_ARGS__); \
     } else { \
@@ -396,6 +427,7 @@ int esp_vfs_open(struct _reent *r, const char * path, int flags, int mode)
                 s_fd_table[i].permanent = false;
                 s_fd_table[i].vfs_index = vfs->offset;
                 s_fd_table[i].local_fd = fd_within_vfs;
+                s_fd_table[i].vfs_entry = vfs;
                 _lock_release(&s_fd_table_lock);
                 return i;
             }
@@ -779,6 +811,47 @@ int esp_vfs_truncate(const char *path, off_t length)
 
 #ifdef CONFIG_VFS_SUPPORT_SELECT
 
+typedef struct {
+    fds_triple_t vfs_fds_triple[VFS_MAX_COUNT]; // FD sets handed to each VFS driver
+    void *driver_args[VFS_MAX_COUNT];           // driver state returned by start_select()
+    SemaphoreHandle_t sem;                      // reusable local signaling semaphore
+} vfs_select_ctx_t;
+
+// One-deep cache of select() state. The common case of a single task calling
+// select() in a loop reuses this context and allocates nothing per call;
+// concurrent callers fall back to a temporary allocation.
+static vfs_select_ctx_t *s_select_ctx_cache = NULL;
+
+static vfs_select_ctx_t *vfs_select_ctx_acquire(void)
+{
+    vfs_select_ctx_t *ctx = __atomic_exchange_n(&s_select_ctx_cache, NULL, __ATOMIC_ACQ_REL);
+    if (ctx == NULL) {
+        ctx = calloc(1, sizeof(vfs_select_ctx_t));
+        if (ctx == NULL) {
+            return NULL;
+        }
+        ctx->sem = xSemaphoreCreateBinary();
+        if (ctx->sem == NULL) {
+            free(ctx);
+            return NULL;
+        }
+    } else {
+        memset(ctx->vfs_fds_triple, 0, sizeof(ctx->vfs_fds_triple));
+        memset(ctx->driver_args, 0, sizeof(ctx->driver_args));
+    }
+    return ctx;
+}
+
+static void vfs_select_ctx_release(vfs_select_ctx_t *ctx)
+{
+    vfs_select_ctx_t *expected = NULL;
+    if (!__atomic_compare_exchange_n(&s_select_ctx_cache, &expected, ctx, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+        // the cache already holds a context from a concurrent caller; drop this one
+        vSemaphoreDelete(ctx->sem);
+        free(ctx);
+    }
+}
+
 static void call_end_selects(int end_index, const fds_triple_t *vfs_fds_triple, void **driver_args)
 {
     for (int i = 0; i < end_index; ++i) {
@@ -866,12 +939,14 @@ int esp_vfs_select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds
     // call. s_vfs_count cannot be protected with a mutex during a select() call (which can be one without a timeout)
     // because that could block the registration of new driver.
     const size_t vfs_count = s_vfs_count;
-    fds_triple_t *vfs_fds_triple;
-    if ((vfs_fds_triple = calloc(vfs_count, sizeof(fds_triple_t))) == NULL) {
+    vfs_select_ctx_t *ctx = vfs_select_ctx_acquire();
+    if (ctx == NULL) {
         __errno_r(r) = ENOMEM;
-        ESP_LOGD(TAG, "calloc is unsuccessful");
+        ESP_LOGD(TAG, "cannot acquire select context");
         return -1;
     }
+    fds_triple_t *vfs_fds_triple = ctx->vfs_fds_triple;
+    void **driver_args = ctx->driver_args;
 
     esp_vfs_select_sem_t sel_sem = {
         .is_sem_local = false,
@@ -933,21 +1008,10 @@ int esp_vfs_select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds
         // There is no socket VFS registered or select() wasn't called for
         // any socket. Therefore, we will use our own signalization.
         sel_sem.is_sem_local = true;
-        if ((sel_sem.sem = xSemaphoreCreateBinary()) == NULL) {
-            free(vfs_fds_triple);
-            __errno_r(r) = ENOMEM;
-            ESP_LOGD(TAG, "cannot create select semaphore");
-            return -1;
-        }
-    }
-
-    void **driver_args = calloc(vfs_count, sizeof(void *));
-
-    if (driver_args == NULL) {
-        free(vfs_fds_triple);
-        __errno_r(r) = ENOMEM;
-        ESP_LOGD(TAG, "calloc is unsuccessful for driver args");
-        return -1;
+        sel_sem.sem = ctx->sem;
+        // discard a leftover trigger from a previous select() call which
+        // arrived after its end_select()
+        xSemaphoreTake(sel_sem.sem, 0);
     }
 
     for (int i = 0; i < vfs_count; ++i) {
@@ -967,12 +1031,7 @@ int esp_vfs_select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds
             if (err != ESP_OK) {
                 call_end_selects(i, vfs_fds_triple, driver_args);
                 (void) set_global_fd_sets(vfs_fds_triple, vfs_count, readfds, writefds, errorfds);
-                if (sel_sem.is_sem_local && sel_sem.sem) {
-                    vSemaphoreDelete(sel_sem.sem);
-                    sel_sem.sem = NULL;
-                }
-                free(vfs_fds_triple);
-                free(driver_args);
+                vfs_select_ctx_release(ctx);
                 __errno_r(r) = EINTR;
                 ESP_LOGD(TAG, "start_select failed: %s", esp_err_to_name(err));
                 return -1;
@@ -1015,12 +1074,7 @@ int esp_vfs_select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds
     if (ret >= 0) {
         ret += set_global_fd_sets(vfs_fds_triple, vfs_count, readfds, writefds, errorfds);
     }
-    if (sel_sem.is_sem_local && sel_sem.sem) {
-        vSemaphoreDelete(sel_sem.sem);
-        sel_sem.sem = NULL;
-    }
-    free(vfs_fds_triple);
-    free(driver_args);
+    vfs_select_ctx_release(ctx);
 
     ESP_LOGD(TAG, "esp_vfs_select returns %d", ret);
     esp_vfs_log_fd_set("readfds", readfds);
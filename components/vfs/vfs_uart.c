@@ -52,15 +52,19 @@
 
 // UART write bytes function type
 typedef void (*tx_func_t)(int, int);
+// UART block write function type
+typedef void (*tx_block_func_t)(int, const char*, size_t);
 // UART read bytes function type
 typedef int (*rx_func_t)(int);
 
 // Basic functions for sending and receiving bytes over UART
 static void uart_tx_char(int fd, int c);
+static void uart_tx_block(int fd, const char *data, size_t len);
 static int uart_rx_char(int fd);
 
 // Functions for sending and receiving bytes which use UART driver
 static void uart_tx_char_via_driver(int fd, int c);
+static void uart_tx_block_via_driver(int fd, const char *data, size_t len);
 static int uart_rx_char_via_driver(int fd);
 
 typedef struct {
@@ -81,6 +85,9 @@ typedef struct {
     esp_line_endings_t rx_mode;
     // Functions used to write bytes to UART. Default to "basic" functions.
     tx_func_t tx_func;
+    // Function used to write whole blocks to UART, for runs of characters
+    // which need no newline conversion. Default to "basic" function.
+    tx_block_func_t tx_block_func;
     // Functions used to read bytes from UART. Default to "basic" functions.
     rx_func_t rx_func;
 } vfs_uart_context_t;
@@ -91,6 +98,7 @@ typedef struct {
     .tx_mode = DEFAULT_TX_MODE,\
     .rx_mode = DEFAULT_RX_MODE,\
     .tx_func = uart_tx_char,\
+    .tx_block_func = uart_tx_block,\
     .rx_func = uart_rx_char,\
 }
 
@@ -167,12 +175,24 @@ static void uart_tx_char(int fd, int c)
 #endif
 }
 
+static void uart_tx_block(int fd, const char *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        uart_tx_char(fd, data[i]);
+    }
+}
+
 static void uart_tx_char_via_driver(int fd, int c)
 {
     char ch = (char) c;
     uart_write_bytes(fd, &ch, 1);
 }
 
+static void uart_tx_block_via_driver(int fd, const char *data, size_t len)
+{
+    uart_write_bytes(fd, data, len);
+}
+
 static int uart_rx_char(int fd)
 {
     uart_dev_t* uart = s_ctx[fd]->uart;
@@ -206,15 +226,31 @@ static ssize_t uart_write(int fd, const void * data, size_t size)
      *  same UART.
      */
     _lock_acquire_recursive(&s_ctx[fd]->write_lock);
-    for (size_t i = 0; i < size; i++) {
-        int c = data_c[i];
-        if (c == '\n' && s_ctx[fd]->tx_mode != ESP_LINE_ENDINGS_LF) {
-            s_ctx[fd]->tx_func(fd, '\r');
-            if (s_ctx[fd]->tx_mode == ESP_LINE_ENDINGS_CR) {
+    if (s_ctx[fd]->tx_mode == ESP_LINE_ENDINGS_LF) {
+        /* No newline conversion needed, pass the whole block through.
+         * With the UART driver installed this is a single driver call
+         * instead of one per character */
+        s_ctx[fd]->tx_block_func(fd, data_c, size);
+    } else {
+        /* Send maximal runs without '\n' as blocks, converting line
+         * endings character-wise in between */
+        size_t run_start = 0;
+        for (size_t i = 0; i < size; i++) {
+            if (data_c[i] != '\n') {
                 continue;
             }
+            if (i > run_start) {
+                s_ctx[fd]->tx_block_func(fd, data_c + run_start, i - run_start);
+            }
+            s_ctx[fd]->tx_func(fd, '\r');
+            if (s_ctx[fd]->tx_mode == ESP_LINE_ENDINGS_CRLF) {
+                s_ctx[fd]->tx_func(fd, '\n');
+            }
+            run_start = i + 1;
+        }
+        if (size > run_start) {
+            s_ctx[fd]->tx_block_func(fd, data_c + run_start, size - run_start);
         }
-        s_ctx[fd]->tx_func(fd, c);
     }
     _lock_release_recursive(&s_ctx[fd]->write_lock);
     return size;
@@ -1036,6 +1072,7 @@ void esp_vfs_dev_uart_use_nonblocking(int uart_num)
     _lock_acquire_recursive(&s_ctx[uart_num]->read_lock);
     _lock_acquire_recursive(&s_ctx[uart_num]->write_lock);
     s_ctx[uart_num]->tx_func = uart_tx_char;
+    s_ctx[uart_num]->tx_block_func = uart_tx_block;
     s_ctx[uart_num]->rx_func = uart_rx_char;
     _lock_release_recursive(&s_ctx[uart_num]->write_lock);
     _lock_release_recursive(&s_ctx[uart_num]->read_lock);
@@ -1046,6 +1083,7 @@ void esp_vfs_dev_uart_use_driver(int uart_num)
     _lock_acquire_recursive(&s_ctx[uart_num]->read_lock);
     _lock_acquire_recursive(&s_ctx[uart_num]->write_lock);
     s_ctx[uart_num]->tx_func = uart_tx_char_via_driver;
+    s_ctx[uart_num]->tx_block_func = uart_tx_block_via_driver;
     s_ctx[uart_num]->rx_func = uart_rx_char_via_driver;
     _lock_release_recursive(&s_ctx[uart_num]->write_lock);
     _lock_release_recursive(&s_ctx[uart_num]->read_lock);
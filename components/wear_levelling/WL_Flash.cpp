@@ -240,6 +240,7 @@ esp_err_t WL_Flash::init()
         return result;
     }
     this->initialized = true;
+    this->updateTranslationCache();
     ESP_LOGD(TAG, "%s - move_count= 0x%08x", __func__, (uint32_t)this->state.move_count);
     return ESP_OK;
 }
@@ -247,24 +248,32 @@ esp_err_t WL_Flash::init()
 esp_err_t WL_Flash::recoverPos()
 {
     esp_err_t result = ESP_OK;
-    size_t position = 0;
     ESP_LOGV(TAG, "%s start", __func__);
-    for (size_t i = 0; i < this->state.max_pos; i++) {
+    // Position records are written strictly sequentially, so the set records
+    // form a prefix of the record array. Binary search for the first unset
+    // record instead of scanning all max_pos records one by one.
+    size_t lo = 0;
+    size_t hi = this->state.max_pos;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
         bool pos_bits;
-        position = i;
-        result = this->flash_drv->read(this->addr_state1 + sizeof(wl_state_t) + i * this->cfg.wr_size, this->temp_buff, this->cfg.wr_size);
-        pos_bits = this->OkBuffSet(i);
+        result = this->flash_drv->read(this->addr_state1 + sizeof(wl_state_t) + mid * this->cfg.wr_size, this->temp_buff, this->cfg.wr_size);
         WL_RESULT_CHECK(result);
-        ESP_LOGV(TAG, "%s - check pos: result=0x%08x, position= %i, pos_bits= 0x%08x", __func__, (uint32_t)result, (uint32_t)position, (uint32_t)pos_bits);
-        if (pos_bits == false) {
-            break; // we have found position
+        pos_bits = this->OkBuffSet(mid);
+        ESP_LOGV(TAG, "%s - check pos: result=0x%08x, position= %i, pos_bits= 0x%08x", __func__, (uint32_t)result, (uint32_t)mid, (uint32_t)pos_bits);
+        if (pos_bits == true) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
         }
     }
+    size_t position = lo;
 
     this->state.pos = position;
     if (this->state.pos == this->state.max_pos) {
         this->state.pos--;
     }
+    this->updateTranslationCache();
     ESP_LOGD(TAG, "%s - this->state.pos= 0x%08x, position= 0x%08x, result= 0x%08x, max_pos= 0x%08x", __func__, (uint32_t)this->state.pos, (uint32_t)position, (uint32_t)result, (uint32_t)this->state.max_pos);
     ESP_LOGV(TAG, "%s done", __func__);
     return result;
@@ -289,6 +298,7 @@ esp_err_t WL_Flash::initSections()
     this->state.max_pos = 1 + this->flash_size / this->cfg.page_size;
 
     this->state.crc = crc32::crc32_le(WL_CFG_CRC_CONST, (uint8_t *)&this->state, WL_STATE_CRC_LEN_V2);
+    this->updateTranslationCache();
 
     result = this->flash_drv->erase_range(this->addr_state1, this->state_size);
     WL_RESULT_CHECK(result);
@@ -505,6 +515,7 @@ esp_err_t WL_Flash::updateWL()
         WL_RESULT_CHECK(result);
         ESP_LOGD(TAG, "%s - move_count= 0x%08x, pos= 0x%08x, ", __func__, this->state.move_count, this->state.pos);
     }
+    this->updateTranslationCache();
     // Save structures to the flash... and check result
     if (result == ESP_OK) {
         ESP_LOGV(TAG, "%s - result= 0x%08x", __func__, result);
@@ -514,15 +525,25 @@ esp_err_t WL_Flash::updateWL()
     return result;
 }
 
+// Precompute the translation values used by calcAddr. Called after every
+// event that changes state.pos or state.move_count, so the hot address
+// translation path does not have to redo the modulo arithmetic per access.
+void WL_Flash::updateTranslationCache()
+{
+    this->shift_offset = (this->flash_size - (this->state.move_count * this->cfg.page_size) % this->flash_size) % this->flash_size;
+    this->dummy_base = this->state.pos * this->cfg.page_size;
+}
+
 size_t WL_Flash::calcAddr(size_t addr)
 {
-    size_t result = (this->flash_size - this->state.move_count * this->cfg.page_size + addr) % this->flash_size;
-    size_t dummy_addr = this->state.pos * this->cfg.page_size;
-    if (result < dummy_addr) {
-    } else {
+    size_t result = this->shift_offset + addr;
+    if (result >= this->flash_size) {
+        result -= this->flash_size;
+    }
+    if (result >= this->dummy_base) {
         result += this->cfg.page_size;
     }
-    ESP_LOGV(TAG, "%s - addr= 0x%08x -> result= 0x%08x, dummy_addr= 0x%08x", __func__, (uint32_t) addr, (uint32_t) result, (uint32_t)dummy_addr);
+    ESP_LOGV(TAG, "%s - addr= 0x%08x -> result= 0x%08x, dummy_addr= 0x%08x", __func__, (uint32_t) addr, (uint32_t) result, (uint32_t)this->dummy_base);
     return result;
 }
 
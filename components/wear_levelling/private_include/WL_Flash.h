@@ -67,9 +67,15 @@ protected:
     size_t dummy_addr;
     uint32_t pos_data[4];
 
+    // translation values precomputed from state.pos and state.move_count,
+    // refreshed by updateTranslationCache() after every move event
+    size_t shift_offset = 0;
+    size_t dummy_base = 0;
+
     esp_err_t initSections();
     esp_err_t updateWL();
     esp_err_t recoverPos();
+    void updateTranslationCache();
     size_t calcAddr(size_t addr);
 
     esp_err_t updateVersion();
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <string.h>
+#include <stddef.h>
 #include <sys/param.h>
 
 #include <freertos/FreeRTOS.h>
@@ -25,6 +26,8 @@
 #include <esp_err.h>
 #include <esp_wifi.h>
 #include <esp_timer.h>
+#include <esp_attr.h>
+#include <esp_crc.h>
 
 #include <protocomm.h>
 #include <protocomm_security0.h>
@@ -138,6 +141,13 @@ struct wifi_prov_mgr_ctx {
     wifi_ap_record_t *ap_list[14];
     wifi_ap_record_t *ap_list_sorted[MAX_SCAN_RESULTS];
     wifi_scan_config_t scan_cfg;
+
+#ifdef CONFIG_WIFI_PROV_SCAN_RTC_CACHE
+    /* Scan results loaded from the RTC cache. These populate the
+     * sorted list until the first fresh results arrive */
+    wifi_ap_record_t *ap_list_cached;
+    bool cached_results_live;
+#endif
 };
 
 /* Mutex to lock/unlock access to provisioning singleton
@@ -596,6 +606,11 @@ static bool wifi_prov_mgr_stop_service(bool blocking)
         free(prov_ctx->ap_list[channel]);
         prov_ctx->ap_list[channel] = NULL;
     }
+#ifdef CONFIG_WIFI_PROV_SCAN_RTC_CACHE
+    free(prov_ctx->ap_list_cached);
+    prov_ctx->ap_list_cached = NULL;
+    prov_ctx->cached_results_live = false;
+#endif
     prov_ctx->scanning = false;
     for (uint8_t i = 0; i < MAX_SCAN_RESULTS; i++) {
         prov_ctx->ap_list_sorted[i] = NULL;
@@ -678,6 +693,138 @@ esp_err_t wifi_prov_mgr_done(void)
     return ESP_OK;
 }
 
+#ifdef CONFIG_WIFI_PROV_SCAN_RTC_CACHE
+
+#define SCAN_CACHE_MAX_ENTRIES  MIN(MAX_SCAN_RESULTS, 10)
+#define SCAN_CACHE_MAGIC        0x50435257
+
+/* Compact AP record kept in RTC memory across software resets */
+typedef struct {
+    uint8_t ssid[33];
+    uint8_t bssid[6];
+    int8_t  rssi;
+    uint8_t channel;
+    uint8_t authmode;
+} scan_cache_entry_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t count;
+    scan_cache_entry_t entries[SCAN_CACHE_MAX_ENTRIES];
+    uint32_t crc;
+} scan_cache_t;
+
+static RTC_NOINIT_ATTR scan_cache_t scan_cache;
+
+static uint32_t scan_cache_crc(void)
+{
+    return esp_crc32_le(UINT32_MAX, (const uint8_t *)&scan_cache,
+                        offsetof(scan_cache_t, crc));
+}
+
+/* Store the strongest entries of the sorted list in RTC memory.
+ * To be called with the context lock taken */
+static void scan_cache_store(void)
+{
+    uint32_t i;
+
+    scan_cache.magic = SCAN_CACHE_MAGIC;
+    for (i = 0; i < SCAN_CACHE_MAX_ENTRIES && prov_ctx->ap_list_sorted[i]; i++) {
+        const wifi_ap_record_t *rec = prov_ctx->ap_list_sorted[i];
+        memcpy(scan_cache.entries[i].ssid, rec->ssid, sizeof(scan_cache.entries[i].ssid));
+        memcpy(scan_cache.entries[i].bssid, rec->bssid, sizeof(scan_cache.entries[i].bssid));
+        scan_cache.entries[i].rssi = rec->rssi;
+        scan_cache.entries[i].channel = rec->primary;
+        scan_cache.entries[i].authmode = rec->authmode;
+    }
+    scan_cache.count = i;
+    scan_cache.crc = scan_cache_crc();
+}
+
+/* Populate the sorted list from the RTC cache, if it holds valid
+ * results from before the last reset. The cached entries are served
+ * until the first fresh scan results replace them. To be called with
+ * the context lock taken */
+static void scan_cache_load(void)
+{
+    if (prov_ctx->ap_list_cached) {
+        /* Already consumed once since provisioning started */
+        return;
+    }
+    if (scan_cache.magic != SCAN_CACHE_MAGIC ||
+        scan_cache.count == 0 || scan_cache.count > SCAN_CACHE_MAX_ENTRIES ||
+        scan_cache.crc != scan_cache_crc()) {
+        return;
+    }
+
+    prov_ctx->ap_list_cached = calloc(scan_cache.count, sizeof(wifi_ap_record_t));
+    if (!prov_ctx->ap_list_cached) {
+        ESP_LOGD(TAG, "Failed to allocate memory for cached AP list");
+        return;
+    }
+    for (uint32_t i = 0; i < scan_cache.count; i++) {
+        wifi_ap_record_t *rec = &prov_ctx->ap_list_cached[i];
+        memcpy(rec->ssid, scan_cache.entries[i].ssid, sizeof(rec->ssid));
+        memcpy(rec->bssid, scan_cache.entries[i].bssid, sizeof(rec->bssid));
+        rec->rssi = scan_cache.entries[i].rssi;
+        rec->primary = scan_cache.entries[i].channel;
+        rec->authmode = scan_cache.entries[i].authmode;
+        prov_ctx->ap_list_sorted[i] = rec;
+    }
+    prov_ctx->cached_results_live = true;
+    ESP_LOGD(TAG, "Serving %d cached scan results", scan_cache.count);
+}
+
+#endif /* CONFIG_WIFI_PROV_SCAN_RTC_CACHE */
+
+/* Insert an AP record into the sorted list, keeping a single entry per
+ * BSSID (the strongest sighting wins) and strongest-RSSI-first order.
+ * To be called with the context lock taken */
+static void insert_sorted_ap_record(wifi_ap_record_t *rec)
+{
+    int i, count = 0;
+
+    /* If this BSSID is already listed, keep whichever sighting
+     * is stronger. An AP heard on adjacent channels must show up
+     * only once in the list sent to the client */
+    for (i = 0; i < MAX_SCAN_RESULTS && prov_ctx->ap_list_sorted[i]; i++) {
+        if (memcmp(prov_ctx->ap_list_sorted[i]->bssid, rec->bssid,
+                   sizeof(rec->bssid)) == 0) {
+            if (prov_ctx->ap_list_sorted[i]->rssi >= rec->rssi) {
+                return;
+            }
+            /* Drop the weaker duplicate and re-insert below */
+            for (; i < MAX_SCAN_RESULTS - 1; i++) {
+                prov_ctx->ap_list_sorted[i] = prov_ctx->ap_list_sorted[i + 1];
+            }
+            prov_ctx->ap_list_sorted[MAX_SCAN_RESULTS - 1] = NULL;
+            break;
+        }
+    }
+
+    while (count < MAX_SCAN_RESULTS && prov_ctx->ap_list_sorted[count]) {
+        count++;
+    }
+
+    for (i = 0; i < count; i++) {
+        if (rec->rssi > prov_ctx->ap_list_sorted[i]->rssi) {
+            break;
+        }
+    }
+    if (i == MAX_SCAN_RESULTS) {
+        /* Weaker than everything in a full list */
+        return;
+    }
+    if (count == MAX_SCAN_RESULTS) {
+        /* Weakest entry falls off the end */
+        count = MAX_SCAN_RESULTS - 1;
+    }
+    for (int j = count; j > i; j--) {
+        prov_ctx->ap_list_sorted[j] = prov_ctx->ap_list_sorted[j - 1];
+    }
+    prov_ctx->ap_list_sorted[i] = rec;
+}
+
 static esp_err_t update_wifi_scan_results(void)
 {
     if (!prov_ctx->scanning) {
@@ -736,25 +883,23 @@ static esp_err_t update_wifi_scan_results(void)
                  prov_ctx->ap_list[curr_channel][i].authmode);
     }
 
-    /* Store results in sorted list */
-    {
-        int rc = MIN(count, MAX_SCAN_RESULTS);
-        int is = MAX_SCAN_RESULTS - rc - 1;
-        while (rc > 0 && is >= 0) {
-            if (prov_ctx->ap_list_sorted[is]) {
-                if (prov_ctx->ap_list_sorted[is]->rssi > prov_ctx->ap_list[curr_channel][rc - 1].rssi) {
-                    prov_ctx->ap_list_sorted[is + rc] = &prov_ctx->ap_list[curr_channel][rc - 1];
-                    rc--;
-                    continue;
-                }
-                prov_ctx->ap_list_sorted[is + rc] = prov_ctx->ap_list_sorted[is];
-            }
-            is--;
-        }
-        while (rc > 0) {
-            prov_ctx->ap_list_sorted[rc - 1] = &prov_ctx->ap_list[curr_channel][rc - 1];
-            rc--;
+#ifdef CONFIG_WIFI_PROV_SCAN_RTC_CACHE
+    /* Fresh results take over from the cached list wholesale, so that
+     * APs which disappeared since the last boot don't linger */
+    if (prov_ctx->cached_results_live) {
+        for (uint8_t i = 0; i < MAX_SCAN_RESULTS; i++) {
+            prov_ctx->ap_list_sorted[i] = NULL;
         }
+        free(prov_ctx->ap_list_cached);
+        prov_ctx->ap_list_cached = NULL;
+        prov_ctx->cached_results_live = false;
+    }
+#endif
+
+    /* Merge into the sorted list, deduplicating by BSSID so that an AP
+     * heard on multiple channels is reported once, strongest RSSI first */
+    for (uint16_t i = 0; i < count; i++) {
+        insert_sorted_ap_record(&prov_ctx->ap_list[curr_channel][i]);
     }
 
     ret = ESP_OK;
@@ -789,6 +934,14 @@ static esp_err_t update_wifi_scan_results(void)
 
     final:
 
+#ifdef CONFIG_WIFI_PROV_SCAN_RTC_CACHE
+    /* On completion of a full scan, remember the strongest results
+     * across the next software reset */
+    if (!prov_ctx->scanning && ret == ESP_OK && !prov_ctx->cached_results_live) {
+        scan_cache_store();
+    }
+#endif
+
     return ret;
 }
 
@@ -922,6 +1075,12 @@ esp_err_t wifi_prov_mgr_wifi_scan_start(bool blocking, bool passive,
         prov_ctx->ap_list_sorted[i] = NULL;
     }
 
+#ifdef CONFIG_WIFI_PROV_SCAN_RTC_CACHE
+    /* Serve results cached across the last reset (if any) while the
+     * fresh scan is in progress */
+    scan_cache_load();
+#endif
+
     if (passive) {
         prov_ctx->scan_cfg.scan_type = WIFI_SCAN_TYPE_PASSIVE;
         prov_ctx->scan_cfg.scan_time.passive = period_ms;
@@ -1531,6 +1690,16 @@ err:
 
 exit:
     RELEASE_LOCK(prov_ctx_lock);
+
+#ifdef CONFIG_WIFI_PROV_SCAN_ON_START
+    if (ret == ESP_OK) {
+        /* Kick off a background all-channel scan so that it overlaps
+         * with transport setup and the client connection. By the time
+         * the client asks for the scan list, results are usually ready */
+        wifi_prov_mgr_wifi_scan_start(false /* non-blocking */, false /* active */,
+                                      0 /* all channels in one go */, 120 /* ms per channel */);
+    }
+#endif
     return ret;
 }
 
@@ -12,6 +12,44 @@
 #include "crypto/aes.h"
 #include "crypto/aes_wrap.h"
 
+#ifdef USE_MBEDTLS_CRYPTO
+#include "mbedtls/aes.h"
+
+/* Route the block encryptions through mbedtls so OMAC1 (AES-CMAC, used by
+ * PMF and FT) runs on the AES hardware instead of the software tables from
+ * aes-internal-enc.c. Only the cipher primitive is swapped; the OMAC1
+ * construction below is unchanged. */
+static void * omac1_aes_encrypt_init(const u8 *key, size_t key_len)
+{
+	mbedtls_aes_context *aes = os_malloc(sizeof(*aes));
+
+	if (aes == NULL)
+		return NULL;
+	mbedtls_aes_init(aes);
+	if (mbedtls_aes_setkey_enc(aes, key, key_len * 8) != 0) {
+		mbedtls_aes_free(aes);
+		os_free(aes);
+		return NULL;
+	}
+	return aes;
+}
+
+static int omac1_aes_encrypt(void *ctx, const u8 *plain, u8 *crypt)
+{
+	return mbedtls_aes_crypt_ecb(ctx, MBEDTLS_AES_ENCRYPT, plain, crypt);
+}
+
+static void omac1_aes_encrypt_deinit(void *ctx)
+{
+	mbedtls_aes_free(ctx);
+	os_free(ctx);
+}
+
+#define aes_encrypt_init omac1_aes_encrypt_init
+#define aes_encrypt omac1_aes_encrypt
+#define aes_encrypt_deinit omac1_aes_encrypt_deinit
+#endif /* USE_MBEDTLS_CRYPTO */
+
 static void gf_mulx(u8 *pad)
 {
 	int i, carry;
@@ -18,6 +18,10 @@
 #include "sha1.h"
 #include "crypto.h"
 
+#ifdef USE_MBEDTLS_CRYPTO
+#include "mbedtls/md.h"
+#endif
+
 
 /**
  * hmac_sha1_vector - HMAC-SHA1 over data vector (RFC 2104)
@@ -29,6 +33,36 @@
  * @mac: Buffer for the hash (20 bytes)
  * Returns: 0 on success, -1 on failure
  */
+#ifdef USE_MBEDTLS_CRYPTO
+int
+hmac_sha1_vector(const u8 *key, size_t key_len, size_t num_elem,
+		     const u8 *addr[], const size_t *len, u8 *mac)
+{
+	mbedtls_md_context_t ctx;
+	size_t i;
+	int ret = -1;
+
+	mbedtls_md_init(&ctx);
+	if (mbedtls_md_setup(&ctx, mbedtls_md_info_from_type(MBEDTLS_MD_SHA1),
+			     1) != 0) {
+		goto cleanup;
+	}
+	if (mbedtls_md_hmac_starts(&ctx, key, key_len) != 0) {
+		goto cleanup;
+	}
+	for (i = 0; i < num_elem; i++) {
+		if (mbedtls_md_hmac_update(&ctx, addr[i], len[i]) != 0) {
+			goto cleanup;
+		}
+	}
+	if (mbedtls_md_hmac_finish(&ctx, mac) == 0) {
+		ret = 0;
+	}
+cleanup:
+	mbedtls_md_free(&ctx);
+	return ret;
+}
+#else /* USE_MBEDTLS_CRYPTO */
 int
 hmac_sha1_vector(const u8 *key, size_t key_len, size_t num_elem,
 		     const u8 *addr[], const size_t *len, u8 *mac)
@@ -93,6 +127,7 @@ hmac_sha1_vector(const u8 *key, size_t key_len, size_t num_elem,
 	_len[1] = SHA1_MAC_LEN;
 	return sha1_vector(2, _addr, _len, mac);
 }
+#endif /* USE_MBEDTLS_CRYPTO */
 
 
 /**
@@ -125,6 +160,56 @@ hmac_sha1(const u8 *key, size_t key_len, const u8 *data, size_t data_len,
  * This function is used to derive new, cryptographically separate keys from a
  * given key (e.g., PMK in IEEE 802.11i).
  */
+#ifdef USE_MBEDTLS_CRYPTO
+int
+sha1_prf(const u8 *key, size_t key_len, const char *label,
+	     const u8 *data, size_t data_len, u8 *buf, size_t buf_len)
+{
+	/* PTK derivation runs several HMACs over the same key; keep one HMAC
+	 * context across iterations so the key schedule is set up once. */
+	mbedtls_md_context_t ctx;
+	u8 counter = 0;
+	size_t pos, plen;
+	u8 hash[SHA1_MAC_LEN];
+	size_t label_len = os_strlen(label) + 1;
+	int ret = -1;
+
+	mbedtls_md_init(&ctx);
+	if (mbedtls_md_setup(&ctx, mbedtls_md_info_from_type(MBEDTLS_MD_SHA1),
+			     1) != 0) {
+		goto cleanup;
+	}
+	if (mbedtls_md_hmac_starts(&ctx, key, key_len) != 0) {
+		goto cleanup;
+	}
+
+	pos = 0;
+	while (pos < buf_len) {
+		plen = buf_len - pos;
+		if (mbedtls_md_hmac_update(&ctx, (const u8 *) label, label_len) != 0 ||
+		    mbedtls_md_hmac_update(&ctx, data, data_len) != 0 ||
+		    mbedtls_md_hmac_update(&ctx, &counter, 1) != 0 ||
+		    mbedtls_md_hmac_finish(&ctx, hash) != 0) {
+			goto cleanup;
+		}
+		if (plen >= SHA1_MAC_LEN) {
+			os_memcpy(&buf[pos], hash, SHA1_MAC_LEN);
+			pos += SHA1_MAC_LEN;
+		} else {
+			os_memcpy(&buf[pos], hash, plen);
+			break;
+		}
+		counter++;
+		if (mbedtls_md_hmac_reset(&ctx) != 0) {
+			goto cleanup;
+		}
+	}
+	ret = 0;
+cleanup:
+	mbedtls_md_free(&ctx);
+	return ret;
+}
+#else /* USE_MBEDTLS_CRYPTO */
 int
 sha1_prf(const u8 *key, size_t key_len, const char *label,
 	     const u8 *data, size_t data_len, u8 *buf, size_t buf_len)
@@ -163,3 +248,4 @@ sha1_prf(const u8 *key, size_t key_len, const char *label,
 
 	return 0;
 }
+#endif /* USE_MBEDTLS_CRYPTO */
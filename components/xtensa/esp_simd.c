@@ -0,0 +1,117 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include "sdkconfig.h"
+#include "esp_simd.h"
+
+#if CONFIG_IDF_TARGET_ESP32S3
+/* Vector kernels in esp32s3/esp_simd_s3.S. Alignment and length constraints
+ * are enforced by the dispatch code below. */
+extern void esp_simd_memcpy_s3(void *dst, const void *src, size_t chunks32);
+extern void esp_simd_memset_s3(void *dst, const uint8_t pattern[16], size_t chunks16);
+extern int32_t esp_simd_dotprod_s16_s3(const int16_t *x, const int16_t *y, size_t groups8);
+#endif
+
+void *esp_simd_memcpy(void *dst, const void *src, size_t n)
+{
+#if CONFIG_IDF_TARGET_ESP32S3
+    uint8_t *d = dst;
+    const uint8_t *s = src;
+    /* The vector path needs both pointers on the same 16-byte phase */
+    if (n >= 64 && (((uintptr_t)d ^ (uintptr_t)s) & 15) == 0) {
+        size_t head = (16 - ((uintptr_t)d & 15)) & 15;
+        memcpy(d, s, head);
+        d += head;
+        s += head;
+        n -= head;
+        size_t bulk = n & ~(size_t)31;
+        esp_simd_memcpy_s3(d, s, bulk / 32);
+        d += bulk;
+        s += bulk;
+        n -= bulk;
+    }
+    memcpy(d, s, n);
+    return dst;
+#else
+    return memcpy(dst, src, n);
+#endif
+}
+
+void *esp_simd_memset(void *dst, int c, size_t n)
+{
+#if CONFIG_IDF_TARGET_ESP32S3
+    uint8_t *d = dst;
+    if (n >= 32) {
+        uint8_t pattern[16] __attribute__((aligned(16)));
+        memset(pattern, c, sizeof(pattern));
+        size_t head = (16 - ((uintptr_t)d & 15)) & 15;
+        memset(d, c, head);
+        d += head;
+        n -= head;
+        size_t bulk = n & ~(size_t)15;
+        esp_simd_memset_s3(d, pattern, bulk / 16);
+        d += bulk;
+        n -= bulk;
+    }
+    memset(d, c, n);
+    return dst;
+#else
+    return memset(dst, c, n);
+#endif
+}
+
+int32_t esp_simd_dotprod_s16(const int16_t *x, const int16_t *y, size_t len)
+{
+    int32_t acc = 0;
+#if CONFIG_IDF_TARGET_ESP32S3
+    if (len >= 8 && (((uintptr_t)x | (uintptr_t)y) & 15) == 0) {
+        size_t groups = len / 8;
+        acc = esp_simd_dotprod_s16_s3(x, y, groups);
+        x += groups * 8;
+        y += groups * 8;
+        len -= groups * 8;
+    }
+#endif
+    for (size_t i = 0; i < len; i++) {
+        acc += (int32_t)x[i] * y[i];
+    }
+    return acc;
+}
+
+void esp_simd_fir_s16(const int16_t *input, size_t input_len,
+                      const int16_t *coeffs, size_t coeffs_len,
+                      int16_t *output, int shift)
+{
+    for (size_t i = 0; i + coeffs_len <= input_len; i++) {
+        int32_t acc = esp_simd_dotprod_s16(&input[i], coeffs, coeffs_len) >> shift;
+        if (acc > INT16_MAX) {
+            acc = INT16_MAX;
+        } else if (acc < INT16_MIN) {
+            acc = INT16_MIN;
+        }
+        output[i] = (int16_t)acc;
+    }
+}
+
+void esp_simd_rgb888_to_rgb565(const uint8_t *rgb, uint16_t *dst, size_t pixels)
+{
+    for (size_t i = 0; i < pixels; i++) {
+        uint16_t r = rgb[0] >> 3;
+        uint16_t g = rgb[1] >> 2;
+        uint16_t b = rgb[2] >> 3;
+        dst[i] = (r << 11) | (g << 5) | b;
+        rgb += 3;
+    }
+}
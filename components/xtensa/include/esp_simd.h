@@ -0,0 +1,106 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file esp_simd.h
+ * @brief Optimized bulk-memory and DSP primitives.
+ *
+ * On chips with the 128-bit processor instruction extensions (ESP32-S3) these
+ * functions use the vector unit for the bulk of the work; on other chips they
+ * fall back to scalar implementations with identical behaviour, so callers do
+ * not need per-chip code. The vector fast path is selected at run time from
+ * the alignment and length of the operands.
+ */
+
+/**
+ * @brief Copy memory, using 128-bit vector loads/stores where possible.
+ *
+ * Behaves like memcpy(). The vector path is used for copies of 64 bytes or
+ * more whose source and destination share 16-byte alignment; other copies are
+ * delegated to memcpy(). Regions must not overlap.
+ *
+ * @param dst  Destination buffer
+ * @param src  Source buffer
+ * @param n    Number of bytes to copy
+ * @return dst
+ */
+void *esp_simd_memcpy(void *dst, const void *src, size_t n);
+
+/**
+ * @brief Fill memory, using 128-bit vector stores where possible.
+ *
+ * Behaves like memset().
+ *
+ * @param dst  Destination buffer
+ * @param c    Fill byte (converted to unsigned char)
+ * @param n    Number of bytes to fill
+ * @return dst
+ */
+void *esp_simd_memset(void *dst, int c, size_t n);
+
+/**
+ * @brief Dot product of two int16 vectors.
+ *
+ * Computes sum(x[i] * y[i]) over len elements, accumulated in (at least)
+ * 32 bits. The vector path processes 8 elements per instruction when both
+ * inputs are 16-byte aligned.
+ *
+ * @param x    First input vector
+ * @param y    Second input vector
+ * @param len  Number of elements in each vector
+ * @return The dot product, truncated to 32 bits
+ */
+int32_t esp_simd_dotprod_s16(const int16_t *x, const int16_t *y, size_t len);
+
+/**
+ * @brief FIR filter over an int16 sample buffer.
+ *
+ * For each of the (input_len - coeffs_len + 1) output samples, computes the
+ * dot product of the coefficient vector with a window of the input, shifts
+ * the accumulator right by 'shift' bits and saturates to int16. Built on
+ * esp_simd_dotprod_s16(), so it benefits from the vector unit on windows
+ * which happen to be 16-byte aligned.
+ *
+ * @param input       Input samples
+ * @param input_len   Number of input samples, must be >= coeffs_len
+ * @param coeffs      Filter coefficients
+ * @param coeffs_len  Number of coefficients
+ * @param output      Output buffer for (input_len - coeffs_len + 1) samples
+ * @param shift       Right shift applied to each accumulator before saturation
+ */
+void esp_simd_fir_s16(const int16_t *input, size_t input_len,
+                      const int16_t *coeffs, size_t coeffs_len,
+                      int16_t *output, int shift);
+
+/**
+ * @brief Convert packed RGB888 pixels to RGB565.
+ *
+ * @param rgb     Input buffer of 3 * pixels bytes (R, G, B order)
+ * @param dst     Output buffer of 'pixels' uint16 values (native byte order)
+ * @param pixels  Number of pixels to convert
+ */
+void esp_simd_rgb888_to_rgb565(const uint8_t *rgb, uint16_t *dst, size_t pixels);
+
+#ifdef __cplusplus
+}
+#endif
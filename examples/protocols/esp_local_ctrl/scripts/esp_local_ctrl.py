@@ -152,17 +152,13 @@ def version_match(tp, expected, verbose=False):
 def get_all_property_values(tp):
     try:
         props = []
-        message = proto.get_prop_count_request()
-        response = tp.send_data('esp_local_ctrl/control', message)
-        count = proto.get_prop_count_response(response)
-        if count == 0:
-            raise RuntimeError("No properties found!")
-        indices = [i for i in range(count)]
-        message = proto.get_prop_vals_request(indices)
+        # An empty indices list fetches all properties in a single
+        # round trip, without querying the property count first
+        message = proto.get_prop_vals_request([])
         response = tp.send_data('esp_local_ctrl/control', message)
         props = proto.get_prop_vals_response(response)
-        if len(props) != count:
-            raise RuntimeError("Incorrect count of properties!")
+        if len(props) == 0:
+            raise RuntimeError("No properties found!")
         for p in props:
             p["value"] = decode_prop_value(p, p["value"])
         return props
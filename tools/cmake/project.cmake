@@ -489,6 +489,30 @@ macro(project project_name)
         COMMAND ${idf_size} --archives ${mapfile}
         )
 
+    # Static RAM budget checking. "size-save-baseline" records the current
+    # per-component and per-object-file sizes to SIZE_BASELINE_FILE (defaults
+    # to size_baseline.json in the project directory, intended to be committed
+    # to the project repository). While the baseline file exists, every build
+    # is checked against it and fails when a component's DRAM .data/.bss or
+    # IRAM usage grew by more than SIZE_REGRESSION_THRESHOLD bytes.
+    idf_build_get_property(project_dir PROJECT_DIR)
+    if(NOT DEFINED SIZE_BASELINE_FILE)
+        set(SIZE_BASELINE_FILE "${project_dir}/size_baseline.json")
+    endif()
+    if(NOT DEFINED SIZE_REGRESSION_THRESHOLD)
+        set(SIZE_REGRESSION_THRESHOLD 0)
+    endif()
+    add_custom_target(size-save-baseline
+        DEPENDS ${project_elf}
+        COMMAND ${idf_size} --save-baseline ${SIZE_BASELINE_FILE} ${mapfile}
+        )
+    if(EXISTS "${SIZE_BASELINE_FILE}")
+        add_custom_command(TARGET ${project_elf} POST_BUILD
+            COMMAND ${idf_size} --check-baseline ${SIZE_BASELINE_FILE}
+                    --max-regression ${SIZE_REGRESSION_THRESHOLD} ${mapfile}
+            VERBATIM)
+    endif()
+
     unset(idf_size)
 
     # Add DFU build and flash targets
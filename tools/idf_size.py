@@ -368,6 +368,26 @@ def main():
         default=None,
         dest='another_map_file')
 
+    parser.add_argument(
+        '--save-baseline',
+        help='Write a per-archive and per-object-file size baseline JSON file and exit',
+        metavar='BASELINE_FILE',
+        default=None)
+
+    parser.add_argument(
+        '--check-baseline',
+        help='Compare sizes against a baseline JSON file written by --save-baseline and '
+             'exit with an error when static RAM usage regressed',
+        metavar='BASELINE_FILE',
+        default=None)
+
+    parser.add_argument(
+        '--max-regression',
+        help='Maximum allowed growth (in bytes) of the DRAM .data/.bss, IRAM or D/IRAM usage '
+             'of any archive before --check-baseline fails',
+        type=int,
+        default=0)
+
     parser.add_argument(
         '-o',
         '--output-file',
@@ -407,6 +427,18 @@ def main():
     mem_reg = MemRegNames.get(mem_regions, memory_config, sections)
     mem_reg_diff = MemRegNames.get(mem_regions, memory_config_diff, sections_diff) if args.another_map_file else None
 
+    if args.save_baseline:
+        save_size_baseline(args.save_baseline, mem_reg, sections)
+        args.output_file.write('Size baseline written to {}{}'.format(args.save_baseline, os.linesep))
+        args.output_file.close()
+        return
+
+    if args.check_baseline:
+        report, failed = check_size_baseline(args.check_baseline, mem_reg, sections, args.max_regression)
+        args.output_file.write(report)
+        args.output_file.close()
+        sys.exit(1 if failed else 0)
+
     output = ''
 
     if not args.json or not (args.archives or args.files or args.archive_details):
@@ -697,6 +729,69 @@ class StructureForDetailedSizes(object):
         return collections.OrderedDict(s)
 
 
+def save_size_baseline(baseline_file, mem_reg, sections):
+    """ Write per-archive and per-object-file size information to a JSON baseline file,
+    to be committed to the project repository and checked with --check-baseline. """
+    baseline = collections.OrderedDict([
+        ('archives', StructureForDetailedSizes.get(mem_reg, sections, 'archive')),
+        ('files', StructureForDetailedSizes.get(mem_reg, sections, 'file')),
+    ])
+    with open(baseline_file, 'w') as f:
+        f.write(format_json(baseline))
+
+
+def check_size_baseline(baseline_file, mem_reg, sections, max_regression):
+    """ Compare current static RAM usage against a baseline written by --save-baseline.
+
+    Returns an (output, failed) tuple. failed is True when the DRAM .data, .bss, IRAM or
+    D/IRAM usage of any archive grew by more than max_regression bytes. The growth of each
+    offending archive is attributed to its object files in the output.
+    """
+    with open(baseline_file, 'r') as f:
+        baseline = json.load(f)
+
+    checked_keys = ('data', 'bss', 'iram', 'diram')
+    current = StructureForDetailedSizes.get(mem_reg, sections, 'archive')
+    reference = baseline.get('archives', {})
+    current_files = StructureForDetailedSizes.get(mem_reg, sections, 'file')
+    reference_files = baseline.get('files', {})
+
+    output = ''
+    failed = False
+    for name in sorted(frozenset(current.keys()) | frozenset(reference.keys())):
+        cur = current.get(name, {})
+        ref = reference.get(name, {})
+        growth = collections.OrderedDict([(k, cur.get(k, 0) - ref.get(k, 0)) for k in checked_keys])
+        if all(v <= max_regression for v in growth.values()):
+            continue
+        failed = True
+        output += '{}: static RAM regression vs baseline: {}{}'.format(
+            name,
+            ', '.join('{} {:+d} bytes'.format(k, v) for k, v in iteritems(growth) if v != 0),
+            os.linesep)
+        # Attribute the growth of this archive to its object files
+        prefix = name + ':'
+        for fname in sorted(frozenset(current_files.keys()) | frozenset(reference_files.keys())):
+            if not fname.startswith(prefix):
+                continue
+            fcur = current_files.get(fname, {})
+            fref = reference_files.get(fname, {})
+            fgrowth = ['{} {:+d}'.format(k, fcur.get(k, 0) - fref.get(k, 0)) for k in checked_keys
+                       if fcur.get(k, 0) != fref.get(k, 0)]
+            if fgrowth:
+                output += '    {}: {}{}'.format(fname.split(':', 1)[1], ', '.join(fgrowth), os.linesep)
+
+    if failed:
+        output += 'Size check failed: static RAM usage grew more than {} bytes over the baseline {}{}'.format(
+            max_regression, baseline_file, os.linesep)
+        output += 'If the growth is intentional, regenerate the baseline with --save-baseline '\
+                  '(build target size-save-baseline).{}'.format(os.linesep)
+    else:
+        output += 'Size check passed: no static RAM regression over {} bytes vs {}{}'.format(
+            max_regression, baseline_file, os.linesep)
+    return output, failed
+
+
 def get_detailed_sizes(mem_reg, sections, key, header, as_json=False, sections_diff=None):
 
     diff_en = sections_diff is not None
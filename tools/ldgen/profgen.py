@@ -0,0 +1,200 @@
+#!/usr/bin/env python
+#
+# Generate linker fragment mappings which promote the hottest flash-resident
+# functions into IRAM, based on a sampled-PC profile.
+#
+# The profile is the output of the perfmon sampling profiler
+# (xtensa_perfmon_prof_dump/report): lines of the form 'CPU0;0x400d1234 57'
+# or '0x400d1234 57', comment lines starting with '#' are ignored. Sampled
+# addresses are attributed to functions using the MAP file of the build the
+# profile was taken from, relying on -ffunction-sections placing every
+# function in its own '.text.<name>' input section.
+#
+# The hottest functions are selected greedily until the IRAM budget is
+# exhausted, and written out as [mapping] fragments using the existing
+# 'noflash_text' scheme. Add the generated file to a component's LDFRAGMENTS
+# (or the project's EXTRA_LDFRAGMENTS) to apply the placement on the next
+# build - no source attribute changes needed.
+#
+# Typical use:
+#   tools/ldgen/profgen.py --profile prof.txt --map build/app.map \
+#                          --budget 16384 -o main/profile_hot.lf
+#
+# Copyright 2021 Espressif Systems (Shanghai) CO LTD
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+from __future__ import print_function
+from __future__ import division
+import argparse
+import bisect
+import collections
+import os.path
+import re
+import sys
+
+# Output sections holding flash-resident code; functions already in IRAM are
+# not candidates for promotion
+FLASH_TEXT_SECTIONS = ('.flash.text',)
+
+# '.text.func_name 0x00000000400d1234 0xa4 .../libfoo.a(bar.c.o)'
+RE_MAP_SOURCE_LINE = re.compile(r'\s*\.text\.(?P<func>\S+)\s+0x(?P<address>[\da-f]+)\s+0x(?P<size>[\da-f]+)\s+'
+                                r'(?P<archive>\S+\.a)\((?P<object_file>\S+\.(o|obj))\)')
+
+RE_SECTION_HEADER = re.compile(r'(?P<name>[^ ]+) +0x(?P<address>[\da-f]+) +0x(?P<size>[\da-f]+)$')
+
+# Symbol name alone on a line, details on the next one
+RE_SYMBOL_ONLY_LINE = re.compile(r'^ (?P<sym_name>\S*)$')
+
+# 'CPU0;0x400d1234 57' or '0x400d1234 57 <anything>'
+RE_PROFILE_LINE = re.compile(r'(?:CPU\d+;)?0x(?P<pc>[\da-f]+)\s+(?P<count>\d+)', re.IGNORECASE)
+
+Function = collections.namedtuple('Function', ['address', 'size', 'archive', 'obj', 'name'])
+
+
+def load_flash_functions(map_file):
+    """ Return the list of flash-resident functions from a MAP file, sorted by address. """
+    functions = []
+    section = None
+    sym_backup = ''
+    for line in map_file:
+        if line.strip() == 'Cross Reference Table':
+            break
+        m = RE_SECTION_HEADER.match(line)
+        if m is not None:
+            section = m.group('name')
+            continue
+        if section not in FLASH_TEXT_SECTIONS:
+            continue
+        m = RE_SYMBOL_ONLY_LINE.match(line)
+        if m is not None:
+            sym_backup = m.group('sym_name')
+            continue
+        m = RE_MAP_SOURCE_LINE.match(line)
+        if m is None and sym_backup.startswith('.text.'):
+            m = RE_MAP_SOURCE_LINE.match(sym_backup + ' ' + line)
+        sym_backup = ''
+        if m is None:
+            continue
+        size = int(m.group('size'), 16)
+        if size == 0:
+            continue
+        obj = os.path.basename(m.group('object_file'))
+        obj = obj.split('.')[0]  # 'bar.c.o' -> 'bar', the form mapping entries use
+        functions.append(Function(address=int(m.group('address'), 16),
+                                  size=size,
+                                  archive=os.path.basename(m.group('archive')),
+                                  obj=obj,
+                                  name=m.group('func')))
+    return sorted(functions, key=lambda f: f.address)
+
+
+def load_profile(profile_file):
+    """ Return a dict of sampled PC -> total sample count. """
+    samples = collections.defaultdict(int)
+    for line in profile_file:
+        line = line.strip()
+        if not line or line.startswith('#'):
+            continue
+        m = RE_PROFILE_LINE.match(line)
+        if m is not None:
+            samples[int(m.group('pc'), 16)] += int(m.group('count'))
+    return samples
+
+
+def attribute_samples(functions, samples):
+    """ Map sample counts onto functions. Returns (per-function counts, unattributed count). """
+    addresses = [f.address for f in functions]
+    counts = collections.defaultdict(int)
+    unattributed = 0
+    for pc, count in samples.items():
+        i = bisect.bisect_right(addresses, pc) - 1
+        if i >= 0 and pc < functions[i].address + functions[i].size:
+            counts[functions[i]] += count
+        else:
+            unattributed += count  # IRAM/ROM code, or a stale profile
+    return counts, unattributed
+
+
+def select_hottest(counts, budget, top):
+    """ Greedily select the hottest functions fitting in the IRAM budget. """
+    selected = []
+    used = 0
+    by_heat = sorted(counts.items(), key=lambda item: (-item[1], item[0].address))
+    for func, count in by_heat:
+        if top is not None and len(selected) >= top:
+            break
+        if used + func.size > budget:
+            continue
+        selected.append((func, count))
+        used += func.size
+    return selected, used
+
+
+def write_fragments(out, selected, used, budget, profile_name):
+    out.write('# Generated by profgen.py from {} - do not edit\n'.format(profile_name))
+    out.write('# {} functions promoted to IRAM, {} of {} budget bytes used\n'.format(
+        len(selected), used, budget))
+    by_archive = collections.OrderedDict()
+    for func, count in selected:
+        by_archive.setdefault(func.archive, []).append((func, count))
+    for archive, funcs in by_archive.items():
+        name = re.sub(r'[^0-9a-zA-Z_]', '_', re.sub(r'^lib|\.a$', '', archive))
+        out.write('\n[mapping:profile_hot_{}]\n'.format(name))
+        out.write('archive: {}\n'.format(archive))
+        out.write('entries:\n')
+        for func, count in sorted(funcs, key=lambda item: -item[1]):
+            out.write('    {}:{} (noflash_text)  # {} samples, {} bytes\n'.format(
+                func.obj, func.name, count, func.size))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='profgen - generate IRAM placement fragments from a sampled-PC profile')
+    parser.add_argument('--profile', required=True, type=argparse.FileType('r'),
+                        help='Profile dump from the perfmon sampling profiler')
+    parser.add_argument('--map', required=True, type=argparse.FileType('r'), dest='map_file',
+                        help='MAP file of the build the profile was taken from')
+    parser.add_argument('--budget', type=int, default=16384,
+                        help='IRAM budget in bytes for promoted functions (default 16384)')
+    parser.add_argument('--top', type=int, default=None,
+                        help='Limit promotion to the N hottest functions')
+    parser.add_argument('-o', '--output', type=argparse.FileType('w'), default=sys.stdout,
+                        help='Output fragment file (default stdout)')
+    args = parser.parse_args()
+
+    functions = load_flash_functions(args.map_file)
+    if not functions:
+        sys.exit('No flash-resident functions found in {}. Is this a linker MAP file?'.format(
+            args.map_file.name))
+    samples = load_profile(args.profile)
+    if not samples:
+        sys.exit('No samples found in {}.'.format(args.profile.name))
+
+    counts, unattributed = attribute_samples(functions, samples)
+    total = sum(samples.values())
+    if unattributed:
+        print('note: {}/{} samples outside flash code (already in IRAM/ROM?), ignored'.format(
+            unattributed, total), file=sys.stderr)
+    if not counts:
+        sys.exit('No samples hit flash-resident code; nothing to promote.')
+
+    selected, used = select_hottest(counts, args.budget, args.top)
+    write_fragments(args.output, selected, used, args.budget, args.profile.name)
+    covered = sum(count for _, count in selected)
+    print('{} functions selected ({} bytes of {} budget), covering {}/{} flash samples'.format(
+        len(selected), used, args.budget, covered, total - unattributed), file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,119 @@
+#!/usr/bin/env python
+#
+# Report flash bytes and call sites taken by log format strings, per
+# component. Log macros expand their format to '<letter> (%d) %s: ...'
+# (optionally wrapped in an ANSI color sequence), which makes the strings
+# recognizable in the compiled component archives without needing the
+# toolchain: this script scans the raw bytes of build/esp-idf/*/lib*.a.
+#
+# Typical use:
+#   Measure a build:     tools/log_size_report.py build --save before.json
+#   After raising the compile-time log level (CONFIG_LOG_DEFAULT_LEVEL or
+#   idf_component_set_log_level), compare:
+#                        tools/log_size_report.py build --compare before.json
+#
+# Copyright 2021 Espressif Systems (Shanghai) CO LTD
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+from __future__ import print_function
+from __future__ import division
+import argparse
+import glob
+import json
+import os.path
+import re
+import sys
+
+# '<optional color escape><level letter> (%d) %s: <text>\0' as produced by
+# LOG_FORMAT/LOG_SYSTEM_TIME_FORMAT in esp_log.h
+LOG_STRING_RE = re.compile(rb'(?:\x1b\[[01];3[0-9]m)?[EWIDV] \(%[ds]\) %s: [^\x00]*\x00')
+
+
+def scan_archive(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+    sites = 0
+    size = 0
+    for m in LOG_STRING_RE.finditer(data):
+        sites += 1
+        size += len(m.group(0))
+    return sites, size
+
+
+def scan_build_dir(build_dir):
+    result = {}
+    pattern = os.path.join(build_dir, 'esp-idf', '*', 'lib*.a')
+    for path in sorted(glob.glob(pattern)):
+        component = os.path.basename(os.path.dirname(path))
+        sites, size = scan_archive(path)
+        if sites:
+            result[component] = {'sites': sites, 'bytes': size}
+    return result
+
+
+def print_report(result, old=None):
+    total_sites = 0
+    total_bytes = 0
+    if old is None:
+        print('%-28s %10s %12s' % ('Component', 'Log sites', 'Bytes'))
+        for component in sorted(result, key=lambda c: -result[c]['bytes']):
+            entry = result[component]
+            print('%-28s %10d %12d' % (component, entry['sites'], entry['bytes']))
+            total_sites += entry['sites']
+            total_bytes += entry['bytes']
+        print('%-28s %10d %12d' % ('Total', total_sites, total_bytes))
+    else:
+        print('%-28s %12s %12s' % ('Component', 'Sites removed', 'Bytes removed'))
+        for component in sorted(set(result) | set(old)):
+            new_entry = result.get(component, {'sites': 0, 'bytes': 0})
+            old_entry = old.get(component, {'sites': 0, 'bytes': 0})
+            d_sites = old_entry['sites'] - new_entry['sites']
+            d_bytes = old_entry['bytes'] - new_entry['bytes']
+            if d_sites or d_bytes:
+                print('%-28s %12d %12d' % (component, d_sites, d_bytes))
+                total_sites += d_sites
+                total_bytes += d_bytes
+        print('%-28s %12d %12d' % ('Total', total_sites, total_bytes))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Per-component log string size report')
+    parser.add_argument('build_dir', help='CMake build directory of the project')
+    parser.add_argument('--save', metavar='FILE', help='write the per-component numbers as JSON')
+    parser.add_argument('--compare', metavar='FILE',
+                        help='JSON written by a previous --save; report the difference')
+    args = parser.parse_args()
+
+    if not os.path.isdir(os.path.join(args.build_dir, 'esp-idf')):
+        print('Error: %s does not look like an ESP-IDF build directory' % args.build_dir,
+              file=sys.stderr)
+        return 1
+
+    result = scan_build_dir(args.build_dir)
+
+    old = None
+    if args.compare:
+        with open(args.compare, 'r') as f:
+            old = json.load(f)
+
+    print_report(result, old)
+
+    if args.save:
+        with open(args.save, 'w') as f:
+            json.dump(result, f, indent=4, sort_keys=True)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,376 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/* Storage stack benchmark: runs the same workloads against FATFS
+ * (wear-levelled SPI flash), SPIFFS and raw esp_partition access, and prints
+ * one machine-readable line per result:
+ *
+ *   FS_BENCH,<fs>,<workload>,<block_size>,<bytes>,<time_us>,<kbps>
+ *
+ * For metadata workloads the block_size column holds the operation count and
+ * the kbps column holds operations per second.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_partition.h"
+#include "esp_vfs_fat.h"
+#include "esp_spiffs.h"
+#include "wear_levelling.h"
+
+static const char *TAG = "fs_benchmark";
+
+#define BENCH_FILE_SIZE     (256 * 1024)
+#define BENCH_META_FILES    32
+#define BENCH_RAND_OPS      128
+#define BENCH_CONCURRENT_TASKS 2
+
+static const size_t s_block_sizes[] = { 512, 4096, 16384 };
+#define BENCH_MAX_BLOCK     16384
+
+static uint8_t *s_block_buf;
+static uint32_t s_rand_state;
+
+// Deterministic PRNG so every run touches the same offsets
+static uint32_t bench_rand(void)
+{
+    s_rand_state = s_rand_state * 1103515245 + 12345;
+    return (s_rand_state >> 8) & 0x7FFFFF;
+}
+
+static void bench_report(const char *fs, const char *workload, size_t block_size,
+                         size_t bytes, int64_t time_us)
+{
+    float rate = 0;
+    if (time_us > 0) {
+        rate = (float)bytes * 1000000 / 1024 / time_us;
+    }
+    printf("FS_BENCH,%s,%s,%u,%u,%lld,%.2f\n",
+           fs, workload, (unsigned) block_size, (unsigned) bytes, (long long) time_us, rate);
+}
+
+static void bench_report_ops(const char *fs, const char *workload, size_t ops, int64_t time_us)
+{
+    float rate = 0;
+    if (time_us > 0) {
+        rate = (float)ops * 1000000 / time_us;
+    }
+    printf("FS_BENCH,%s,%s,%u,%u,%lld,%.2f\n",
+           fs, workload, (unsigned) ops, 0, (long long) time_us, rate);
+}
+
+static void bench_seq_write(const char *fs, const char *path, size_t block_size)
+{
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC);
+    if (fd < 0) {
+        ESP_LOGE(TAG, "%s: open for write failed", fs);
+        return;
+    }
+    int64_t start = esp_timer_get_time();
+    for (size_t written = 0; written < BENCH_FILE_SIZE; written += block_size) {
+        if (write(fd, s_block_buf, block_size) != (ssize_t) block_size) {
+            ESP_LOGE(TAG, "%s: write failed", fs);
+            close(fd);
+            return;
+        }
+    }
+    fsync(fd);
+    int64_t elapsed = esp_timer_get_time() - start;
+    close(fd);
+    bench_report(fs, "seq_write", block_size, BENCH_FILE_SIZE, elapsed);
+}
+
+static void bench_seq_read(const char *fs, const char *path, size_t block_size)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        ESP_LOGE(TAG, "%s: open for read failed", fs);
+        return;
+    }
+    int64_t start = esp_timer_get_time();
+    for (size_t rd = 0; rd < BENCH_FILE_SIZE; rd += block_size) {
+        if (read(fd, s_block_buf, block_size) != (ssize_t) block_size) {
+            ESP_LOGE(TAG, "%s: read failed", fs);
+            close(fd);
+            return;
+        }
+    }
+    int64_t elapsed = esp_timer_get_time() - start;
+    close(fd);
+    bench_report(fs, "seq_read", block_size, BENCH_FILE_SIZE, elapsed);
+}
+
+static void bench_rand_read(const char *fs, const char *path, size_t block_size)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        ESP_LOGE(TAG, "%s: open for read failed", fs);
+        return;
+    }
+    s_rand_state = 0x1234;
+    const size_t blocks = BENCH_FILE_SIZE / block_size;
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < BENCH_RAND_OPS; i++) {
+        off_t offset = (bench_rand() % blocks) * block_size;
+        if (lseek(fd, offset, SEEK_SET) != offset ||
+                read(fd, s_block_buf, block_size) != (ssize_t) block_size) {
+            ESP_LOGE(TAG, "%s: random read failed", fs);
+            close(fd);
+            return;
+        }
+    }
+    int64_t elapsed = esp_timer_get_time() - start;
+    close(fd);
+    bench_report(fs, "rand_read", block_size, BENCH_RAND_OPS * block_size, elapsed);
+}
+
+static void bench_rand_write(const char *fs, const char *path, size_t block_size)
+{
+    int fd = open(path, O_RDWR);
+    if (fd < 0) {
+        ESP_LOGE(TAG, "%s: open for update failed", fs);
+        return;
+    }
+    s_rand_state = 0x4321;
+    const size_t blocks = BENCH_FILE_SIZE / block_size;
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < BENCH_RAND_OPS; i++) {
+        off_t offset = (bench_rand() % blocks) * block_size;
+        if (lseek(fd, offset, SEEK_SET) != offset ||
+                write(fd, s_block_buf, block_size) != (ssize_t) block_size) {
+            ESP_LOGE(TAG, "%s: random write failed", fs);
+            close(fd);
+            return;
+        }
+    }
+    fsync(fd);
+    int64_t elapsed = esp_timer_get_time() - start;
+    close(fd);
+    bench_report(fs, "rand_write", block_size, BENCH_RAND_OPS * block_size, elapsed);
+}
+
+static void bench_metadata(const char *fs, const char *base_path)
+{
+    char path[64];
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < BENCH_META_FILES; i++) {
+        snprintf(path, sizeof(path), "%s/meta_%d", base_path, i);
+        int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC);
+        if (fd < 0) {
+            ESP_LOGE(TAG, "%s: metadata create failed", fs);
+            return;
+        }
+        write(fd, s_block_buf, 16);
+        close(fd);
+    }
+    bench_report_ops(fs, "meta_create", BENCH_META_FILES, esp_timer_get_time() - start);
+
+    struct stat st;
+    start = esp_timer_get_time();
+    for (int i = 0; i < BENCH_META_FILES; i++) {
+        snprintf(path, sizeof(path), "%s/meta_%d", base_path, i);
+        if (stat(path, &st) != 0) {
+            ESP_LOGE(TAG, "%s: metadata stat failed", fs);
+            return;
+        }
+    }
+    bench_report_ops(fs, "meta_stat", BENCH_META_FILES, esp_timer_get_time() - start);
+
+    start = esp_timer_get_time();
+    for (int i = 0; i < BENCH_META_FILES; i++) {
+        snprintf(path, sizeof(path), "%s/meta_%d", base_path, i);
+        if (unlink(path) != 0) {
+            ESP_LOGE(TAG, "%s: metadata unlink failed", fs);
+            return;
+        }
+    }
+    bench_report_ops(fs, "meta_unlink", BENCH_META_FILES, esp_timer_get_time() - start);
+}
+
+typedef struct {
+    const char *path;
+    SemaphoreHandle_t done;
+} bench_reader_arg_t;
+
+static void bench_reader_task(void *arg)
+{
+    bench_reader_arg_t *ra = (bench_reader_arg_t *) arg;
+    uint8_t *buf = malloc(4096);
+    int fd = open(ra->path, O_RDONLY);
+    if (fd >= 0 && buf != NULL) {
+        for (size_t rd = 0; rd < BENCH_FILE_SIZE; rd += 4096) {
+            if (read(fd, buf, 4096) != 4096) {
+                break;
+            }
+        }
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+    free(buf);
+    xSemaphoreGive(ra->done);
+    vTaskDelete(NULL);
+}
+
+// Two tasks read the same file concurrently; reports aggregate throughput
+static void bench_concurrent_read(const char *fs, const char *path)
+{
+    bench_reader_arg_t ra = {
+        .path = path,
+        .done = xSemaphoreCreateCounting(BENCH_CONCURRENT_TASKS, 0),
+    };
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < BENCH_CONCURRENT_TASKS; i++) {
+        xTaskCreate(bench_reader_task, "bench_rd", 3072, &ra, 5, NULL);
+    }
+    for (int i = 0; i < BENCH_CONCURRENT_TASKS; i++) {
+        xSemaphoreTake(ra.done, portMAX_DELAY);
+    }
+    int64_t elapsed = esp_timer_get_time() - start;
+    vSemaphoreDelete(ra.done);
+    bench_report(fs, "concurrent_read", 4096, BENCH_CONCURRENT_TASKS * BENCH_FILE_SIZE, elapsed);
+}
+
+// Full workload set for a mounted filesystem
+static void bench_run_fs(const char *fs, const char *base_path)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "%s/bench.bin", base_path);
+    for (size_t i = 0; i < sizeof(s_block_sizes) / sizeof(s_block_sizes[0]); i++) {
+        bench_seq_write(fs, path, s_block_sizes[i]);
+        bench_seq_read(fs, path, s_block_sizes[i]);
+        bench_rand_read(fs, path, s_block_sizes[i]);
+        bench_rand_write(fs, path, s_block_sizes[i]);
+    }
+    bench_concurrent_read(fs, path);
+    unlink(path);
+    bench_metadata(fs, base_path);
+}
+
+static void bench_fatfs(void)
+{
+    wl_handle_t wl_handle = WL_INVALID_HANDLE;
+    const esp_vfs_fat_mount_config_t mount_config = {
+        .format_if_mount_failed = true,
+        .max_files = BENCH_CONCURRENT_TASKS + 2,
+    };
+    // first mount may format the partition, mount again for a clean timing
+    esp_err_t err = esp_vfs_fat_spiflash_mount("/fatfs", "fat_store", &mount_config, &wl_handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "fatfs mount failed (%s)", esp_err_to_name(err));
+        return;
+    }
+    ESP_ERROR_CHECK(esp_vfs_fat_spiflash_unmount("/fatfs", wl_handle));
+
+    int64_t start = esp_timer_get_time();
+    ESP_ERROR_CHECK(esp_vfs_fat_spiflash_mount("/fatfs", "fat_store", &mount_config, &wl_handle));
+    bench_report_ops("fatfs", "mount", 1, esp_timer_get_time() - start);
+
+    bench_run_fs("fatfs", "/fatfs");
+    ESP_ERROR_CHECK(esp_vfs_fat_spiflash_unmount("/fatfs", wl_handle));
+}
+
+static void bench_spiffs(void)
+{
+    esp_vfs_spiffs_conf_t conf = {
+        .base_path = "/spiffs",
+        .partition_label = "spiffs_store",
+        .max_files = BENCH_CONCURRENT_TASKS + 2,
+        .format_if_mount_failed = true,
+    };
+    // first mount may format the partition, mount again for a clean timing
+    esp_err_t err = esp_vfs_spiffs_register(&conf);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "spiffs mount failed (%s)", esp_err_to_name(err));
+        return;
+    }
+    ESP_ERROR_CHECK(esp_vfs_spiffs_unregister(conf.partition_label));
+
+    int64_t start = esp_timer_get_time();
+    ESP_ERROR_CHECK(esp_vfs_spiffs_register(&conf));
+    bench_report_ops("spiffs", "mount", 1, esp_timer_get_time() - start);
+
+    bench_run_fs("spiffs", "/spiffs");
+    ESP_ERROR_CHECK(esp_vfs_spiffs_unregister(conf.partition_label));
+}
+
+// Raw partition access: upper bound of what the storage stack can reach
+static void bench_raw(void)
+{
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+            ESP_PARTITION_SUBTYPE_ANY, "raw_store");
+    if (part == NULL) {
+        ESP_LOGE(TAG, "raw_store partition not found");
+        return;
+    }
+
+    int64_t start = esp_timer_get_time();
+    ESP_ERROR_CHECK(esp_partition_erase_range(part, 0, BENCH_FILE_SIZE));
+    bench_report("raw", "erase", BENCH_FILE_SIZE, BENCH_FILE_SIZE, esp_timer_get_time() - start);
+
+    for (size_t i = 0; i < sizeof(s_block_sizes) / sizeof(s_block_sizes[0]); i++) {
+        const size_t block_size = s_block_sizes[i];
+
+        start = esp_timer_get_time();
+        for (size_t off = 0; off < BENCH_FILE_SIZE; off += block_size) {
+            ESP_ERROR_CHECK(esp_partition_write(part, off, s_block_buf, block_size));
+        }
+        bench_report("raw", "seq_write", block_size, BENCH_FILE_SIZE, esp_timer_get_time() - start);
+
+        start = esp_timer_get_time();
+        for (size_t off = 0; off < BENCH_FILE_SIZE; off += block_size) {
+            ESP_ERROR_CHECK(esp_partition_read(part, off, s_block_buf, block_size));
+        }
+        bench_report("raw", "seq_read", block_size, BENCH_FILE_SIZE, esp_timer_get_time() - start);
+
+        s_rand_state = 0x1234;
+        const size_t blocks = BENCH_FILE_SIZE / block_size;
+        start = esp_timer_get_time();
+        for (int op = 0; op < BENCH_RAND_OPS; op++) {
+            size_t off = (bench_rand() % blocks) * block_size;
+            ESP_ERROR_CHECK(esp_partition_read(part, off, s_block_buf, block_size));
+        }
+        bench_report("raw", "rand_read", block_size, BENCH_RAND_OPS * block_size, esp_timer_get_time() - start);
+
+        // rewrite in place needs an erase cycle, so only full blocks are timed
+        ESP_ERROR_CHECK(esp_partition_erase_range(part, 0, BENCH_FILE_SIZE));
+    }
+}
+
+void app_main(void)
+{
+    s_block_buf = malloc(BENCH_MAX_BLOCK);
+    if (s_block_buf == NULL) {
+        ESP_LOGE(TAG, "failed to allocate block buffer");
+        return;
+    }
+    for (size_t i = 0; i < BENCH_MAX_BLOCK; i++) {
+        s_block_buf[i] = i & 0xFF;
+    }
+
+    printf("FS_BENCH_START\n");
+    bench_fatfs();
+    bench_spiffs();
+    bench_raw();
+    printf("FS_BENCH_DONE\n");
+}
@@ -0,0 +1,116 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+// Cycle-budget assertions for unit tests.
+//
+// TEST_ASSERT_CYCLES_BELOW(budget, expr) measures `expr` with the CPU cycle
+// counter — a few warmup runs, then repeated timed runs — rejects outliers
+// (interrupt hits, cache misses on the first iterations) and fails the test
+// if the median exceeds the budget. Budgets can be given inline or taken from
+// the per-target baselines in idf_performance.h, so test apps under
+// components/*/test double as a regression-guarded benchmark suite.
+//
+// Every measurement is printed in the usual "[Performance]" format and also
+// recorded; test_perf_print_summary() emits all measurements of the run as
+// one block for CI to collect.
+
+#include <stdint.h>
+#include <stddef.h>
+#include "soc/cpu.h"
+#include "unity.h"
+#include "test_utils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TEST_PERF_WARMUP_RUNS   3
+#define TEST_PERF_REPEAT_RUNS   32
+
+typedef struct {
+    uint32_t repeats;   // samples taken
+    uint32_t kept;      // samples left after outlier rejection
+    uint32_t min;       // fastest kept sample, in cycles
+    uint32_t max;       // slowest kept sample, in cycles
+    uint32_t median;    // median of the kept samples, in cycles
+    uint32_t mean;      // mean of the kept samples, in cycles
+} test_perf_stats_t;
+
+/**
+ * @brief Compute statistics over raw cycle samples
+ *
+ * Sorts the samples and drops the top and bottom eighth (for 8 samples and
+ * more), then fills min/max/median/mean from the remainder. The samples
+ * array is sorted in place.
+ */
+void test_perf_compute(uint32_t *samples, size_t count, test_perf_stats_t *stats);
+
+/**
+ * @brief Print one measurement and add it to the run summary
+ *
+ * @param name Measurement name (the asserted expression for the macros below)
+ * @param budget Cycle budget the measurement was checked against
+ * @param stats Statistics as computed by test_perf_compute()
+ */
+void test_perf_record(const char *name, uint32_t budget, const test_perf_stats_t *stats);
+
+/**
+ * @brief Print all measurements recorded since the last reset as one block
+ */
+void test_perf_print_summary(void);
+
+/**
+ * @brief Discard the recorded measurements
+ */
+void test_perf_reset_summary(void);
+
+/**
+ * @brief Measure `expr` and fill a test_perf_stats_t with the result
+ */
+#define TEST_MEASURE_CYCLES(stats_ptr, expr) do { \
+    uint32_t perf_samples_[TEST_PERF_REPEAT_RUNS]; \
+    for (int perf_i_ = 0; perf_i_ < TEST_PERF_WARMUP_RUNS; perf_i_++) { \
+        expr; \
+    } \
+    for (int perf_i_ = 0; perf_i_ < TEST_PERF_REPEAT_RUNS; perf_i_++) { \
+        uint32_t perf_start_ = esp_cpu_get_ccount(); \
+        expr; \
+        perf_samples_[perf_i_] = esp_cpu_get_ccount() - perf_start_; \
+    } \
+    test_perf_compute(perf_samples_, TEST_PERF_REPEAT_RUNS, (stats_ptr)); \
+} while (0)
+
+/**
+ * @brief Assert that the median cycle count of `expr` stays below `budget`
+ */
+#define TEST_ASSERT_CYCLES_BELOW(budget, expr) do { \
+    test_perf_stats_t perf_stats_; \
+    TEST_MEASURE_CYCLES(&perf_stats_, expr); \
+    test_perf_record(#expr, (uint32_t) (budget), &perf_stats_); \
+    TEST_ASSERT_MESSAGE(perf_stats_.median < (uint32_t) (budget), \
+            "cycle budget exceeded: " #expr); \
+} while (0)
+
+/**
+ * @brief Like TEST_ASSERT_CYCLES_BELOW, with the budget taken from the
+ * per-target baselines: pass the suffix of an IDF_PERFORMANCE_MAX_... entry
+ * defined in idf_performance.h / idf_performance_target.h
+ */
+#define TEST_ASSERT_CYCLES_WITHIN_BASELINE(name, expr) \
+    TEST_ASSERT_CYCLES_BELOW(PERFORMANCE_CON(IDF_PERFORMANCE_MAX_, name), expr)
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,42 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "test_perf.h"
+#include "unity.h"
+
+TEST_CASE("test_perf_compute sorts, trims and summarizes", "[test_utils]")
+{
+    // 32 samples: 30 around 100 plus one outlier at each end
+    uint32_t samples[TEST_PERF_REPEAT_RUNS];
+    for (int i = 0; i < TEST_PERF_REPEAT_RUNS; i++) {
+        samples[i] = 95 + (i % 11);
+    }
+    samples[3] = 5;       // short-circuited run
+    samples[17] = 100000; // interrupt hit
+
+    test_perf_stats_t stats;
+    test_perf_compute(samples, TEST_PERF_REPEAT_RUNS, &stats);
+
+    TEST_ASSERT_EQUAL_UINT32(TEST_PERF_REPEAT_RUNS, stats.repeats);
+    TEST_ASSERT_EQUAL_UINT32(TEST_PERF_REPEAT_RUNS - 2 * (TEST_PERF_REPEAT_RUNS / 8), stats.kept);
+    // both outliers must have been trimmed away
+    TEST_ASSERT_UINT32_WITHIN(10, 100, stats.min);
+    TEST_ASSERT_UINT32_WITHIN(10, 100, stats.max);
+    TEST_ASSERT_UINT32_WITHIN(10, 100, stats.median);
+    TEST_ASSERT_UINT32_WITHIN(10, 100, stats.mean);
+}
+
+static void small_work(volatile uint32_t *acc)
+{
+    for (int i = 0; i < 16; i++) {
+        *acc += i;
+    }
+}
+
+TEST_CASE("TEST_ASSERT_CYCLES_BELOW passes for a generous budget", "[test_utils]")
+{
+    volatile uint32_t acc = 0;
+    TEST_ASSERT_CYCLES_BELOW(1000000, small_work(&acc));
+    test_perf_print_summary();
+    test_perf_reset_summary();
+}
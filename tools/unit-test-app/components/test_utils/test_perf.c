@@ -0,0 +1,106 @@
+// Copyright 2021 Espressif Systems (Shanghai) CO LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "test_perf.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_PERF_SUMMARY_ENTRIES 48
+
+typedef struct {
+    const char *name;       // string literal from the assertion macro
+    uint32_t budget;
+    uint32_t median;
+    uint32_t max;
+} test_perf_entry_t;
+
+static test_perf_entry_t s_entries[TEST_PERF_SUMMARY_ENTRIES];
+static size_t s_entry_count;
+static size_t s_entries_dropped;
+
+void test_perf_compute(uint32_t *samples, size_t count, test_perf_stats_t *stats)
+{
+    // insertion sort, sample counts are small
+    for (size_t i = 1; i < count; i++) {
+        uint32_t val = samples[i];
+        size_t j = i;
+        while (j > 0 && samples[j - 1] > val) {
+            samples[j] = samples[j - 1];
+            j--;
+        }
+        samples[j] = val;
+    }
+
+    // trim the top and bottom eighth: the slow tail absorbs interrupt hits,
+    // the fast end the occasional short-circuited run
+    size_t trim = (count >= 8) ? count / 8 : 0;
+    size_t first = trim;
+    size_t last = count - trim;    // exclusive
+    size_t kept = last - first;
+
+    uint64_t sum = 0;
+    for (size_t i = first; i < last; i++) {
+        sum += samples[i];
+    }
+
+    stats->repeats = (uint32_t) count;
+    stats->kept = (uint32_t) kept;
+    stats->min = samples[first];
+    stats->max = samples[last - 1];
+    stats->median = samples[first + kept / 2];
+    stats->mean = (uint32_t) (sum / kept);
+}
+
+void test_perf_record(const char *name, uint32_t budget, const test_perf_stats_t *stats)
+{
+    printf("[Performance][cycles] %s: median %u, mean %u, min %u, max %u (kept %u/%u), budget %u\n",
+           name, stats->median, stats->mean, stats->min, stats->max,
+           stats->kept, stats->repeats, budget);
+
+    if (s_entry_count < TEST_PERF_SUMMARY_ENTRIES) {
+        test_perf_entry_t *entry = &s_entries[s_entry_count++];
+        entry->name = name;
+        entry->budget = budget;
+        entry->median = stats->median;
+        entry->max = stats->max;
+    } else {
+        s_entries_dropped++;
+    }
+}
+
+void test_perf_print_summary(void)
+{
+    printf("[Performance][summary] name | median | max | budget | headroom\n");
+    for (size_t i = 0; i < s_entry_count; i++) {
+        const test_perf_entry_t *entry = &s_entries[i];
+        int headroom_pct = 0;
+        if (entry->budget > 0) {
+            headroom_pct = (int) (100 - (100ULL * entry->median) / entry->budget);
+        }
+        printf("[Performance][summary] %s | %u | %u | %u | %d%%\n",
+               entry->name, entry->median, entry->max, entry->budget, headroom_pct);
+    }
+    if (s_entries_dropped > 0) {
+        printf("[Performance][summary] (%u further measurements not recorded)\n",
+               (unsigned) s_entries_dropped);
+    }
+}
+
+void test_perf_reset_summary(void)
+{
+    memset(s_entries, 0, sizeof(s_entries));
+    s_entry_count = 0;
+    s_entries_dropped = 0;
+}